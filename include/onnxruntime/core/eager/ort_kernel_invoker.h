@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -24,11 +27,9 @@ class ORTInvoker {
  public:
   ORTInvoker(std::shared_ptr<IExecutionProvider> execution_provider,
              const logging::Logger& logger,
-             const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries) : execution_provider_(std::move(execution_provider)), logger_(logger), custom_op_registries_(custom_op_registries) {
-    if (!execution_provider_) {
-      ORT_THROW("Execution provider is nullptr");
-    }
-  }
+             const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries);
+
+  ~ORTInvoker();
 
   IExecutionProvider& GetCurrentExecutionProvider() {
     return *execution_provider_;
@@ -43,11 +44,26 @@ class ORTInvoker {
                         const int version = -1);
 
  private:
+  // the one node model and the kernel created for an op invocation, reused by the invocations with the same op,
+  // attributes and input types
+  struct CachedKernel;
+
+  common::Status CreateCachedKernel(const std::string& op_name,
+                                    const std::vector<OrtValue>& inputs,
+                                    size_t output_count,
+                                    const NodeAttributes* attributes,
+                                    const std::string& domain,
+                                    const int version,
+                                    std::unique_ptr<CachedKernel>& cached_kernel) const;
+
   std::shared_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
   // custom ops for current execution provider
   // we need the op schema to resolve the output type during invoke
   const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries_;
+
+  std::mutex kernel_cache_mutex_;
+  std::unordered_map<std::string, std::unique_ptr<CachedKernel>> kernel_cache_;
 };
 
 #ifdef __GNUC__
@@ -18,16 +18,18 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  thread_cache_max_bytes(0) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
-              int64_t max_power_of_two_extend_bytes)
+              int64_t max_power_of_two_extend_bytes, size_t thread_cache_max_bytes = 0)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        thread_cache_max_bytes(thread_cache_max_bytes) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -35,6 +37,7 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  size_t thread_cache_max_bytes;          // use 0 to disable the per-thread caches of free chunks
 };
 
 namespace onnxruntime {
@@ -82,11 +85,25 @@ class IAllocator {
   // By default, the base implementation  just calls Alloc().
   virtual void* Reserve(size_t size) { return Alloc(size); }
 
+  // Whether the allocator orders its allocations with the work enqueued on a stream, e.g. a stream ordered memory
+  // pool of the device. Such an allocator gets the stream a buffer is used on through AllocOnStream().
+  // The arenas are not, they are handled through StreamAwareArena.
+  virtual bool IsStreamOrdered() const { return false; }
+
+  // Allocate a buffer used by the work enqueued on `stream`. Only called if IsStreamOrdered() returns true.
+  virtual void* AllocOnStream(size_t size, Stream* /*stream*/) { return Alloc(size); }
+
   const OrtMemoryInfo& Info() const { return memory_info_; };
 
   // Each implementation of IAllocator can override and provide their own implementation
   virtual void GetStats(AllocatorStats* /*stats*/) { return; }
 
+  // Collect the detailed metrics of the allocator. Allocators that don't track them only report their stats.
+  virtual void GetMetrics(AllocatorMetrics* metrics) {
+    *metrics = AllocatorMetrics{};
+    GetStats(&metrics->stats);
+  }
+
   static bool CalcMemSizeForArray(size_t nmemb, size_t size, size_t* out) noexcept {
     return CalcMemSizeForArrayWithAlignment(nmemb, size, 0, out);
   }
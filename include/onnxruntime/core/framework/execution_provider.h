@@ -215,6 +215,14 @@ class IExecutionProvider {
    */
   virtual common::Status ReplayGraph() { return Status::OK(); }
 
+  /**
+     Select the graph that IsGraphCaptured(), ReplayGraph() and the graph capture of the
+     next run refer to. The session calls it before each Run() with a key describing the
+     input shapes of the run, so that a provider can keep one captured graph per set of
+     input shapes. Currently only CUDA execution provider supports it.
+   */
+  virtual void SetGraphCaptureKey(const std::string& /*key*/) {}
+
   /**
      Called when session creation is complete
      This provides an opportunity for execution providers to optionally synchronize and
@@ -264,6 +272,15 @@ class IExecutionProvider {
   virtual common::Status Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                                  std::vector<NodeComputeInfo>& node_compute_funcs);
 
+  /**
+  Does the EP support concurrent calls to Compile, each with a single fused node, from multiple threads.
+  If so, the fused nodes of a graph are compiled in parallel on the intra-op thread pool of the session, with one call
+  to Compile per fused node, unless "session.disable_parallel_compilation" is set.
+  @remarks Any state the EP updates in Compile, e.g. a map from the fused node name to the compiled model, must be
+           synchronized. The calls get distinct fused nodes, and the order of the calls is not defined.
+  */
+  virtual bool ConcurrentCompileSupported() const { return false; }
+
 #endif
 
   void SetLogger(const logging::Logger* logger) {
@@ -83,6 +83,10 @@ class KernelDef {
 
   bool HasExternalOutputs() const { return external_outputs_; }
 
+  const std::vector<std::pair<int, int>>& MayViewOutput() const { return may_view_output_map_; }
+
+  const std::optional<int>& VariadicMayViewOutput() const { return variadic_may_view_input_; }
+
 #ifdef ENABLE_STRIDED_TENSORS
   const std::vector<int>& MayStridedInput() const { return may_strided_inputs_; }
   const std::vector<std::pair<int, int>>& MayStridedOutput() const { return may_strided_output_map_; }
@@ -141,6 +145,12 @@ class KernelDef {
   // Whether the outputs are from external.
   bool external_outputs_ = false;
 
+  // An element <i, j> means that output j may be a view of a contiguous part of input i.
+  std::vector<std::pair<int, int>> may_view_output_map_;
+
+  // Every output may be a view of a contiguous part of this input.
+  std::optional<int> variadic_may_view_input_;
+
 #ifdef ENABLE_STRIDED_TENSORS
   // An element i means i-th input can be strided tensor.
   std::vector<int> may_strided_inputs_;
@@ -259,6 +269,19 @@ class KernelDefBuilder {
     return *this;
   }
 
+  /**
+     Specify that the output_index-th output may be a view of a contiguous part of the input_index-th input,
+     such as a split along the outermost axis. The allocation planner then lets the output share the buffer of
+     the input, and the kernel either makes the output a view with OpKernelContext::OutputView, or falls back
+     to OpKernelContext::Output for an output with a buffer of its own.
+  */
+  KernelDefBuilder& MayViewOutput(int input_index, int output_index);
+
+  /**
+     Apply MayViewOutput(input_index, i) to every output i.
+  */
+  KernelDefBuilder& VariadicMayViewOutput(int input_index);
+
 #ifdef ENABLE_STRIDED_TENSORS
   /**
      Specify that the input_index-th input can be strided tensor.
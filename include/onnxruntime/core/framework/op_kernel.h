@@ -129,6 +129,26 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed buffers restored from a persistent cache instead of calling PrePack().
+  // Unlike UseSharedPrePackedBuffers(), PrePack() is not called first, so the kernel must set up the metadata
+  // PrePack() derives from the tensor, e.g. its shape.
+  // @param tensor: The initialized constant tensor the buffers were pre-packed from. Only its type and shape should
+  //                be read, as reading the data may page it in.
+  // @param prepacked_buffers: The buffers PrePack() stored in PrePackedWeights for the same tensor on a host with the
+  //                           same CPU features. As with UseSharedPrePackedBuffers() the deleters are NULL.
+  // @param prepacked_buffer_sizes: The sizes of the buffers in bytes.
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param used_cached_buffers: Set it to true if the kernel uses the buffers, in which case it is treated as if
+  //                             PrePack() had packed the tensor. Otherwise PrePack() is called.
+  virtual Status UseCachedPrePackedBuffers(const Tensor& /*tensor*/,
+                                           std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                           gsl::span<const size_t> /*prepacked_buffer_sizes*/,
+                                           int /*input_idx*/,
+                                           /*out*/ bool& used_cached_buffers) {
+    used_cached_buffers = false;
+    return Status::OK();
+  }
+
   const OrtDevice GetDevice(OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
@@ -68,6 +68,12 @@ class OpKernelContext {
   Tensor* Output(int index, const std::vector<int64_t>& shape);
   Tensor* Output(int index, const std::initializer_list<int64_t>& shape);
 
+  // Make the output a view of the given shape into the data of the input at input_index, starting byte_offset
+  // bytes into the input, so the output data doesn't need to be copied. The view must be inside the input.
+  // Return nullptr if the allocation plan doesn't allow the output to be a view of that input
+  // (see KernelDefBuilder::MayViewOutput). The kernel then calls Output() and copies the data as usual.
+  Tensor* OutputView(int index, int input_index, const TensorShape& shape, ptrdiff_t byte_offset);
+
   // Fetch a required tensor output, enforcing that it is present.
   Tensor& RequiredOutput(int index, const TensorShape& shape) {
     Tensor* output_ptr = Output(index, shape);
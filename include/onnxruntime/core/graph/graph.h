@@ -5,6 +5,7 @@
 
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -176,7 +177,10 @@ class Node {
   @remarks Used during layout transformation for setting since version for layout transformed nodes with
   domain kMSNHWC.
   */
-  void SetSinceVersion(int since_version) noexcept { since_version_ = since_version; }
+  void SetSinceVersion(int since_version) noexcept {
+    since_version_ = since_version;
+    inferred_def_versions_.clear();
+  }
 
 #if !defined(ORT_MINIMAL_BUILD)
   /** Gets the Node's OpSchema.
@@ -263,7 +267,10 @@ class Node {
   /** Gets a modifiable count of arguments for each of the Node's explicit inputs.
   @todo This should be removed in favor of a method that updates the input args and the count.
         Currently these operations are separate which is not a good setup. */
-  std::vector<int>& MutableInputArgsCount() { return definitions_.input_arg_count; }
+  std::vector<int>& MutableInputArgsCount() {
+    inferred_def_versions_.clear();
+    return definitions_.input_arg_count;
+  }
 
   /** Gets a modifiable collection of the Node's input definitions. */
   std::vector<NodeArg*>& MutableInputDefs() noexcept {
@@ -410,7 +417,10 @@ class Node {
 
 #if !defined(ORT_MINIMAL_BUILD)
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    inferred_def_versions_.clear();
+    return attributes_;
+  }
 
   /** Gets the Graph instance that is instantiated from a GraphProto attribute during Graph::Resolve.
   @param attr_name Attribute name for the GraphProto attribute.
@@ -655,6 +665,10 @@ class Node {
 
   // Can be saved? The node cannot be saved anymore if removable attributes have been cleared.
   bool can_be_saved_;
+
+  // Versions of the input and output NodeArgs after the last type and shape inference of this node.
+  // Empty if the node needs type and shape inference in the next Graph::Resolve.
+  InlinedVector<uint64_t> inferred_def_versions_;
 };
 
 /**
@@ -1257,6 +1271,12 @@ class Graph {
     // Whether to set that no proto sync is required after resolving.
     // Useful for resolving right after loading from a GraphProto.
     bool no_proto_sync_required = false;
+    // Whether to run type and shape inference on all nodes. By default it only runs on the nodes whose attributes,
+    // inputs or outputs changed since the previous Resolve.
+    bool full_type_inference = false;
+    // Whether to run type and shape inference on the unchanged nodes as well and fail if it changes their outputs.
+    // Checks that the changes to the graph were tracked, for debugging.
+    bool verify_incremental_type_inference = false;
   };
 
   /**
@@ -1452,6 +1472,9 @@ class Graph {
   // Initialize overridable initializers container
   void ComputeOverridableInitializers();
 
+  // Run type and shape inference of the nodes that read the initializer in the next Resolve
+  void MarkInitializerChanged(const std::string& name);
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Build and verify node connection (edges).
   // Verify NodeArg name/type/shape matching correctly.
@@ -1499,6 +1522,10 @@ class Graph {
   // so they can be used to resolve outer scope dependencies when running BuildConnections for the subgraphs.
   common::Status SetOuterScopeNodeArgs(const std::unordered_set<std::string>& outer_scope_node_args);
 
+  // Get the function body to inline for the node. The bodies that schemas build for the attributes and input types
+  // of a node are cached, so call sites with the same signature only copy them.
+  bool TryGetFunctionProtoForInlining(const Node& node, ONNX_NAMESPACE::FunctionProto& function_proto);
+
   // Implementation for initializer replacement
   Status ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initializer, bool is_external);
 
@@ -1594,6 +1621,9 @@ class Graph {
   // in some case, a fused sub-graph will happens multiple times in one model, we use a map
   // to store reusable-schema in lookup.
   InlinedHashMap<std::string, std::reference_wrapper<ONNX_NAMESPACE::OpSchema>> reusable_fused_schema_map_;
+  // the function bodies built by schemas with context dependent functions for the nodes being inlined, by the
+  // attributes and input types of the node. only used in the top level graph.
+  InlinedHashMap<std::string, std::optional<ONNX_NAMESPACE::FunctionProto>> context_dependent_function_bodies_;
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
   // Graph nodes.
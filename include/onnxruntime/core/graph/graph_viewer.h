@@ -5,6 +5,7 @@
 
 #include "core/graph/graph.h"
 #include "core/framework/session_options.h"
+#include <mutex>
 #include <unordered_set>
 
 namespace onnxruntime {
@@ -112,6 +113,7 @@ class GraphViewer {
 
   /** Gets the NodeIndex values for the Graph nodes, sorted into topological order.
   @remarks Filtered using filter_info_ if set.
+  The ExecutionOrder::MEMORY_EFFICIENT order is computed on first use.
   */
   const std::vector<NodeIndex>& GetNodesInTopologicalOrder(ExecutionOrder order = ExecutionOrder::DEFAULT) const;
 
@@ -204,6 +206,12 @@ class GraphViewer {
 #if !defined(ORT_MINIMAL_BUILD)
   // The NodeIndex values of the graph nodes sorted in topological order with priority.
   std::vector<NodeIndex> nodes_in_topological_order_with_priority_;
+
+  // The NodeIndex values of the graph nodes sorted in memory efficient topological order.
+  mutable std::once_flag memory_efficient_order_flag_;
+  mutable std::vector<NodeIndex> nodes_in_memory_efficient_topological_order_;
+
+  void ComputeMemoryEfficientTopologicalOrder() const;
 #endif
 
   // Graph root nodes.
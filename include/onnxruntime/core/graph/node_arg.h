@@ -122,6 +122,10 @@ class NodeArg {
   void SetType(const ONNX_NAMESPACE::TypeProto& type_proto);
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
+  // Gives this NodeArg a new version, so the nodes that read or write it run type and shape inference in the next
+  // Graph::Resolve.
+  void MarkChanged() noexcept;
+
   // Node arg PType.
   const std::string* type_;
 
@@ -130,5 +134,8 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+  // Changes whenever the type or shape may have changed. Unique across all NodeArg instances.
+  uint64_t version_;
 };
 }  // namespace onnxruntime
@@ -19,7 +19,8 @@ and an API to apply all applicable rules to a Graph.
 Represents an IGraphTransformer determined by a set of rewrite rules.
 The transformer will apply all the rewrite rules iteratively as determined by the underlying rewriting strategy.
 Several rewriting-strategies are possible when traversing the graph and applying rewrite rules,
-each with different trade offs. At the moment, we define one that performs top-down traversal of nodes.
+each with different trade offs. At the moment, we define one that performs top-down traversal of nodes,
+followed by passes over the nodes around the rewrites until no rule applies to them.
 
 @TODO: Is a bottom-up traversal more efficient?
 @TODO: Is it worth adding the max number of passes a rule should be applied for?
@@ -75,7 +76,14 @@ class RuleBasedGraphTransformer : public GraphTransformer {
   // Rules that will be evaluated regardless of the op type of the node.
   InlinedVector<std::reference_wrapper<const RewriteRule>> any_op_type_rules_;
 
-  // Performs a single top-down traversal of the graph and applies all registered rules.
+  // Applies the registered rules on the given nodes, and collects the nodes that rules may apply to after the
+  // rewrites in nodes_to_revisit.
+  common::Status ApplyRulesOnNodes(Graph& graph, gsl::span<const NodeIndex> node_indices, bool recurse,
+                                   bool& modified, int graph_level, InlinedHashSet<NodeIndex>& nodes_to_revisit,
+                                   const logging::Logger& logger) const;
+
+  // Performs a top-down traversal of the graph and applies all registered rules, then revisits the nodes around
+  // the rewrites until no rule applies to them.
   common::Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -39,7 +39,10 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <vector>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
 #if defined(__GNUC__)
@@ -176,6 +179,69 @@ enum class PushResult {
   ACCEPTED_BUSY
 };
 
+// Decides how long an idle worker spins before blocking when adaptive
+// spinning is enabled.  Each worker keeps a decaying histogram of the
+// idle gaps it observed (from running out of work to finding work
+// again) and an estimate of how long it takes to wake it up once it
+// blocked.  Spinning only pays off if the next gap is likely shorter
+// than the wake-up cost, so the worker spins (for at most the wake-up
+// cost) if the median gap is shorter than that, and otherwise blocks
+// right away.
+//
+// An AdaptiveSpinPolicy is only used by the worker it belongs to.
+class AdaptiveSpinPolicy {
+ public:
+  // Maximum time to spin for, or 0 to block right away.
+  uint64_t SpinLimitMicros() const {
+    if (num_gaps_ == 0) {
+      return wake_latency_us_;
+    }
+
+    uint32_t num_short_gaps = 0;
+    for (int bucket = 0; bucket < kNumBuckets && BucketUpperBound(bucket) <= wake_latency_us_; bucket++) {
+      num_short_gaps += gap_counts_[bucket];
+    }
+    return 2 * num_short_gaps >= num_gaps_ ? wake_latency_us_ : 0;
+  }
+
+  void RecordIdleGap(uint64_t gap_us) {
+    int bucket = 0;
+    while (bucket < kNumBuckets - 1 && BucketUpperBound(bucket) <= gap_us) {
+      bucket++;
+    }
+    gap_counts_[bucket]++;
+    num_gaps_++;
+
+    // halve the counts periodically, so the histogram follows changes in the load
+    if (num_gaps_ >= kDecayInterval) {
+      num_gaps_ = 0;
+      for (auto& count : gap_counts_) {
+        count /= 2;
+        num_gaps_ += count;
+      }
+    }
+  }
+
+  void RecordWakeLatency(uint64_t latency_us) {
+    // exponentially weighted moving average, with a weight of 1/8 for the new value
+    wake_latency_us_ = std::max<uint64_t>((7 * wake_latency_us_ + latency_us) / 8, 1);
+  }
+
+ private:
+  // bucket 0 counts the gaps below 2us and bucket i those in [2^i, 2^(i+1)) us.
+  static constexpr int kNumBuckets = 24;
+  static constexpr uint32_t kDecayInterval = 256;
+  static constexpr uint64_t kInitialWakeLatencyUs = 50;
+
+  static constexpr uint64_t BucketUpperBound(int bucket) {
+    return uint64_t{2} << bucket;
+  }
+
+  uint32_t gap_counts_[kNumBuckets]{};
+  uint32_t num_gaps_{0};
+  uint64_t wake_latency_us_{kInitialWakeLatencyUs};
+};
+
 // Align to avoid false sharing with prior fields.  If required,
 // alignment or padding must be added subsequently to avoid false
 // sharing with later fields.  Note that:
@@ -231,6 +297,10 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int){};
   void LogRun(int){};
+  void LogTasks(unsigned){};
+  void LogSteal(int){};
+  void LogSpinWake(int){};
+  void LogBlock(int){};
   std::string DumpChildThreadStat() { return {}; }
 };
 #else
@@ -257,15 +327,30 @@ class ThreadPoolProfiler {
   void LogCoreAndBlock(std::ptrdiff_t block_size);  // called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 // called in child thread to log its id
   void LogRun(int thread_idx);                      // called in child thread to log num of run
+  void LogTasks(unsigned num_tasks);                // called in main thread to log the work items of a loop
+  void LogSteal(int thread_idx);                    // called in child thread to log a task stolen from another
+  void LogSpinWake(int thread_idx);                 // called in child thread to log a task found while spinning
+  void LogBlock(int thread_idx);                    // called in child thread to log a wake up after blocking
   std::string DumpChildThreadStat();                // return all child statitics collected so far
 
  private:
   static const char* GetEventName(ThreadPoolEvent);
+
+  // Counters of a child thread reported as the difference between Start and Stop.
+  struct ChildThreadCounters {
+    uint64_t num_steal_ = 0;
+    uint64_t num_spin_wake_ = 0;
+    uint64_t num_block_ = 0;
+  };
+
   struct MainThreadStat {
     uint64_t events_[MAX_EVENT] = {};
     int32_t core_ = -1;
     std::vector<std::ptrdiff_t> blocks_;  // block size determined by cost model
     std::vector<onnxruntime::TimePoint> points_;
+    uint64_t num_tasks_ = 0;  // work items of the parallel loops, including the main thread's
+    uint64_t max_wait_ = 0;   // longest WAIT of a single loop, the extra time of its slowest worker
+    std::vector<ChildThreadCounters> child_counters_at_start_;
     void LogCore();
     void LogBlockSize(std::ptrdiff_t block_size);
     void LogStart();
@@ -286,6 +371,7 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;  // core that the child thread is running on
+    ChildThreadCounters counters_;
   };
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -385,6 +471,11 @@ class ThreadPoolParallelSection {
   std::atomic<ThreadPoolLoop*> current_loop{nullptr};
   std::atomic<unsigned> workers_in_loop{0};
 
+  // Tag of the work items of the section.  Nested sections of a thread
+  // get a tag of their own, so that ending one doesn't revoke the work
+  // items of the others.
+  uint32_t tag{0};
+
   // Members to track asynchronous dispatching
   int dispatch_q_idx = -1;      // index of thread that dispatch work to all other threads
   unsigned dispatch_w_idx = 0;  // index of enqueued work
@@ -700,6 +791,12 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
  private:
   struct PerThread;
 
+  // A slice [begin, begin + size) of workers_by_node_.
+  struct NodeRange {
+    unsigned begin;
+    unsigned size;
+  };
+
   static unsigned WorkerLoop(int id, Eigen::ThreadPoolInterface* param) {
     // unsafe downcast
     ThreadPoolTempl* this_ptr = (ThreadPoolTempl*)param;
@@ -773,6 +870,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -790,6 +888,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    InitializeNumaNodes(thread_options);
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
@@ -846,12 +946,12 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   void StartParallelSectionInternal(PerThread& pt,
                                     ThreadPoolParallelSection& ps) {
-    assert((!pt.leading_par_section) && "Nested parallelism not supported");
     assert((!ps.active) && "Starting parallel section, but active already");
-    pt.leading_par_section = true;
     if (!pt.tag.Get()) {
       pt.tag = Tag::GetNext();
     }
+    ps.tag = pt.par_section_depth == 0 ? pt.tag.Get() : Tag::GetNext().Get();
+    pt.par_section_depth++;
     ps.dispatch_q_idx = -1;
     ps.dispatch_started = false;
     ps.dispatch_done = false;
@@ -871,9 +971,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // can be dealloacted.
   void EndParallelSectionInternal(PerThread& pt,
                                   ThreadPoolParallelSection& ps) {
-    assert((pt.leading_par_section) && "Ending parallel section, but none started");
+    assert((pt.par_section_depth > 0) && "Ending parallel section, but none started");
     assert((ps.active) && "Ending parallel section, but not active");
-    pt.leading_par_section = false;
+    pt.par_section_depth--;
 
     // Notify workers to exit from the section
     ps.active = false;
@@ -886,7 +986,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // then it cannot have pushed tasks.
     if (ps.dispatch_q_idx != -1) {
       Queue& q = worker_data_[ps.dispatch_q_idx].queue;
-      if (q.RevokeWithTag(pt.tag, ps.dispatch_w_idx)) {
+      if (q.RevokeWithTag(Tag(ps.tag), ps.dispatch_w_idx)) {
         if (!ps.dispatch_started.load(std::memory_order_acquire)) {
           // We successfully revoked a task, and saw the dispatch task
           // not started.  Hence we know we revoked the dispatch task.
@@ -922,7 +1022,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     while (!ps.tasks.empty()) {
       const auto& item = ps.tasks.back();
       Queue& q = worker_data_[item.first].queue;
-      if (q.RevokeWithTag(pt.tag, item.second)) {
+      if (q.RevokeWithTag(Tag(ps.tag), item.second)) {
         ps.tasks_revoked++;
       }
       ps.tasks.pop_back();
@@ -966,6 +1066,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // workers.  For simple workloads with 1 main thread this means we
   // will distribute work across the pool of workers.  For workers
   // with multiple main threads it attempts to balance the load.
+  // The workers are visited grouped by NUMA node, so consecutive
+  // par_idx values (and hence the blocks of a loop that
+  // LoopCounter assigns to them) tend to run on the same node.
   //
   // These hints are just used as a starting point, and are updated by
   // the worker thread that actually claims an item (e.g., if an item
@@ -1066,7 +1169,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // preferred_workers maps from a par_idx to a q_idx, hence we
     // initialize slots in the range [0,num_threads_]
     while (preferred_workers.size() <= num_threads_) {
-      preferred_workers.push_back(next_worker++ % num_threads_);
+      preferred_workers.push_back(workers_by_node_[next_worker++ % num_threads_]);
     }
   }
 
@@ -1107,7 +1210,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         worker_fn(par_idx);
         ps.tasks_finished++;
       },
-                                           pt.tag, w_idx);
+                                           Tag(ps.tag), w_idx);
 
       // Queue accepted the task; wake the thread that owns the queue.
       // In addition, if the queue was non-empty, attempt to wake
@@ -1116,7 +1219,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         ps.tasks.push_back({q_idx, w_idx});
         td.EnsureAwake();
         if (push_status == PushResult::ACCEPTED_BUSY) {
-          worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+          worker_data_[RandomWorkerNear(q_idx, pt)].EnsureAwake();
         }
       }
     }
@@ -1212,14 +1315,14 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         Queue& dispatch_que = dispatch_td.queue;
 
         // assign dispatch task to selected dispatcher
-        auto push_status = dispatch_que.PushBackWithTag(dispatch_task, pt.tag, ps.dispatch_w_idx);
+        auto push_status = dispatch_que.PushBackWithTag(dispatch_task, Tag(ps.tag), ps.dispatch_w_idx);
         // Queue accepted the task; wake the thread that owns the queue.
         // In addition, if the queue was non-empty, attempt to wake
         // another thread (which may then steal the task).
         if (push_status == PushResult::ACCEPTED_IDLE || push_status == PushResult::ACCEPTED_BUSY) {
           dispatch_td.EnsureAwake();
           if (push_status == PushResult::ACCEPTED_BUSY) {
-            worker_data_[Rand(&pt.rand) % num_threads_].EnsureAwake();
+            worker_data_[RandomWorkerNear(static_cast<unsigned>(ps.dispatch_q_idx), pt)].EnsureAwake();
           }
         } else {
           ps.dispatch_q_idx = -1;  // failed to enqueue dispatch_task
@@ -1243,8 +1346,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
                             std::ptrdiff_t block_size) override {
     ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
     profiler_.LogStartAndCoreAndBlock(block_size);
+    profiler_.LogTasks(n);
     PerThread* pt = GetPerThread();
-    assert(pt->leading_par_section && "RunInParallel, but not in parallel section");
+    assert((pt->par_section_depth > 0) && "RunInParallel, but not in parallel section");
     assert((n > 1) && "Trivial parallel section; should be avoided by caller");
 
     // Publish the work to any existing workers in the parallel
@@ -1301,6 +1405,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) override {
     ORT_ENFORCE(n <= num_threads_ + 1, "More work items than threads");
     profiler_.LogStartAndCoreAndBlock(block_size);
+    profiler_.LogTasks(n);
     PerThread* pt = GetPerThread();
     ThreadPoolParallelSection ps;
     StartParallelSectionInternal(*pt, ps);
@@ -1332,7 +1437,64 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     spin_loop_status_ = SpinLoopStatus::kIdle;
   }
 
+  // Total time the worker threads have spent running work items since the
+  // pool was created.
+  uint64_t BusyNanoseconds() const {
+    uint64_t total = 0;
+    for (unsigned i = 0; i < num_threads_; i++) {
+      total += worker_data_[i].busy_ns.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
  private:
+  // Group the workers by the NUMA node of their affinity.  Workers
+  // without an affinity, or whose node can't be determined, leave the
+  // pool topology-unaware.
+  void InitializeNumaNodes(const ThreadOptions& thread_options) {
+    workers_by_node_.resize(num_threads_);
+    for (unsigned i = 0; i < num_threads_; i++) {
+      workers_by_node_[i] = i;
+    }
+
+    if (thread_options.affinities.size() < num_threads_) {
+      return;
+    }
+
+    std::vector<int> numa_nodes(num_threads_);
+    for (unsigned i = 0; i < num_threads_; i++) {
+      numa_nodes[i] = env_.GetNumaNodeOfProcessors(thread_options.affinities[i]);
+      if (numa_nodes[i] < 0) {
+        return;
+      }
+    }
+
+    std::stable_sort(workers_by_node_.begin(), workers_by_node_.end(),
+                     [&numa_nodes](unsigned a, unsigned b) { return numa_nodes[a] < numa_nodes[b]; });
+    if (numa_nodes[workers_by_node_.front()] == numa_nodes[workers_by_node_.back()]) {
+      return;
+    }
+
+    node_of_worker_.resize(num_threads_);
+    for (unsigned i = 0; i < num_threads_; i++) {
+      const unsigned worker = workers_by_node_[i];
+      if (i == 0 || numa_nodes[worker] != numa_nodes[workers_by_node_[i - 1]]) {
+        node_ranges_.push_back({i, 0});
+      }
+      node_ranges_.back().size++;
+      node_of_worker_[worker] = static_cast<unsigned>(node_ranges_.size() - 1);
+    }
+  }
+
+  // Pick a random worker, preferring the NUMA node of worker q_idx.
+  unsigned RandomWorkerNear(unsigned q_idx, PerThread& pt) {
+    if (node_of_worker_.empty()) {
+      return Rand(&pt.rand) % num_threads_;
+    }
+    const NodeRange& range = node_ranges_[node_of_worker_[q_idx]];
+    return workers_by_node_[range.begin + Rand(&pt.rand) % range.size];
+  }
+
   void ComputeCoprimes(int N, Eigen::MaxSizeVector<unsigned>* coprimes) {
     for (int i = 1; i <= N; i++) {
       unsigned a = i;
@@ -1375,7 +1537,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     uint64_t rand{0};                 // Random generator state.
     int thread_id{-1};                // Worker thread index in pool.
     Tag tag{};                        // Work item tag used to identify this thread.
-    bool leading_par_section{false};  // Leading a parallel section (used only for asserts)
+    unsigned par_section_depth{0};    // Number of nested parallel sections led by the thread
 
     // When this thread is entering a parallel section, it will
     // initially push work to this set of workers.  The aim is to
@@ -1449,6 +1611,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         assert(seen != ThreadStatus::Blocking);
         if (seen == ThreadStatus::Blocked) {
           status.store(ThreadStatus::Waking, std::memory_order_relaxed);
+          wake_requested_ = std::chrono::steady_clock::now();
           lk.unlock();
           cv.notify_one();
         }
@@ -1483,18 +1646,41 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       status.store(ThreadStatus::Spinning, std::memory_order_relaxed);
     }
 
+    // Time it took the thread to wake up after EnsureAwake.  Only
+    // valid in the post_block callback of SetBlocked.
+    uint64_t MicrosSinceWakeRequested() const {
+      return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - wake_requested_)
+                                       .count());
+    }
+
+    // Time spent running work items.  Only written by the worker thread.
+    std::atomic<uint64_t> busy_ns{0};
+
    private:
     std::atomic<ThreadStatus> status{ThreadStatus::Spinning};
     OrtMutex mutex;
     OrtCondVar cv;
+    std::chrono::steady_clock::time_point wake_requested_;  // GUARDED_BY(mutex)
   };
 
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
+
+  // NUMA topology of the workers.  workers_by_node_ lists the worker
+  // indices grouped by node (the identity if the topology is unknown).
+  // If the workers span more than one node, node_of_worker_ maps each
+  // worker to its entry in node_ranges_, the slice of workers_by_node_
+  // holding the workers of that node.  Otherwise it is empty.
+  std::vector<unsigned> workers_by_node_;
+  std::vector<unsigned> node_of_worker_;
+  std::vector<NodeRange> node_ranges_;
+
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
@@ -1533,27 +1719,51 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     assert(td.GetStatus() == WorkerData::ThreadStatus::Spinning);
 
     constexpr int log2_spin = 20;
-    const int spin_count = allow_spinning_ ? (1ull << log2_spin) : 0;
+    const int spin_count = (allow_spinning_ || adaptive_spinning_) ? (1ull << log2_spin) : 0;
     const int steal_count = spin_count / 100;
 
+    // With adaptive spinning, the time spent spinning is checked every
+    // this many iterations.
+    constexpr int spin_clock_interval = 64;
+    AdaptiveSpinPolicy spin_policy;
+
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
     while (!should_exit) {
       Task t = q.PopFront();
       if (!t) {
+        std::chrono::steady_clock::time_point idle_start;
+        std::chrono::microseconds spin_limit{0};
+        int max_spins = spin_count;
+        if (adaptive_spinning_) {
+          idle_start = std::chrono::steady_clock::now();
+          spin_limit = std::chrono::microseconds(spin_policy.SpinLimitMicros());
+          if (spin_limit.count() == 0) {
+            max_spins = 0;
+          }
+        }
+
         // Spin waiting for work.
-        for (int i = 0; i < spin_count && !done_; i++) {
+        for (int i = 0; i < max_spins && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
+            if (t) profiler_.LogSteal(thread_id);
           } else {
             t = q.PopFront();
           }
-          if (t) break;
+          if (t) {
+            profiler_.LogSpinWake(thread_id);
+            break;
+          }
 
           if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
             break;
           }
+          if (adaptive_spinning_ && (i + 1) % spin_clock_interval == 0 &&
+              std::chrono::steady_clock::now() - idle_start >= spin_limit) {
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         }
 
@@ -1614,18 +1824,36 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
               // Post-block update (executed only if we blocked)
               [&]() {
                 blocked_--;
+                profiler_.LogBlock(thread_id);
+                if (adaptive_spinning_) {
+                  spin_policy.RecordWakeLatency(td.MicrosSinceWakeRequested());
+                }
               });
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
           if (!t) t = q.PopFront();
-          if (!t) t = Steal(StealAttemptKind::TRY_ALL);
+          if (!t) {
+            t = Steal(StealAttemptKind::TRY_ALL);
+            if (t) profiler_.LogSteal(thread_id);
+          }
+        }
+
+        if (adaptive_spinning_ && t) {
+          spin_policy.RecordIdleGap(static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - idle_start)
+                  .count()));
         }
       }
 
       if (t) {
         td.SetActive();
+        const auto run_start = std::chrono::steady_clock::now();
         t();
+        const auto run_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                      std::chrono::steady_clock::now() - run_start)
+                                                      .count());
+        td.busy_ns.store(td.busy_ns.load(std::memory_order_relaxed) + run_ns, std::memory_order_relaxed);
         profiler_.LogRun(thread_id);
         td.SetSpinning();
       }
@@ -1645,18 +1873,39 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // "snatching" work from a thread which is just about to notice the
   // work itself.
 
+  //
+  // On hosts with several NUMA nodes, the workers on the thief's own
+  // node are tried first, so that work (and the data it touches) only
+  // moves across nodes when the local node has nothing to give.
+
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
-    unsigned size = num_threads_;
-    unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
-    unsigned r = Rand(&pt->rand);
+    if (!node_of_worker_.empty() && pt->pool == this) {
+      const NodeRange& local = node_ranges_[node_of_worker_[pt->thread_id]];
+      unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? local.size : 1;
+      Task t = StealFrom(local, num_attempts, Rand(&pt->rand));
+      if (t) {
+        return t;
+      }
+    }
+
+    const NodeRange all{0, num_threads_};
+    unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? num_threads_ : 1;
+    return StealFrom(all, num_attempts, Rand(&pt->rand));
+  }
+
+  // Try to steal from up to num_attempts of the workers in `range`,
+  // visited in a random order.
+  Task StealFrom(const NodeRange& range, unsigned num_attempts, unsigned r) {
+    unsigned size = range.size;
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
 
     for (unsigned i = 0; i < num_attempts; i++) {
       assert(victim < size);
-      if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
-        Task t = worker_data_[victim].queue.PopBack();
+      WorkerData& td = worker_data_[workers_by_node_[range.begin + victim]];
+      if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+        Task t = td.queue.PopBack();
         if (t) {
           return t;
         }
@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -134,6 +135,7 @@ class ThreadPoolTempl;
 
 class ExtendedThreadPoolInterface;
 class LoopCounter;
+class ParallelForCalibration;
 class ThreadPoolParallelSection;
 
 class ThreadPool {
@@ -192,8 +194,11 @@ class ThreadPool {
   // Parallel sections are only implemented with the Eigen threadpool.
   // They have no effect when using OpenMP.
   //
-  // Parallel sections may not be nested, and may not be used inside
-  // parallel loops.
+  // Parallel sections may be nested, and may be used inside parallel
+  // loops, for instance by the kernels of control-flow subgraphs.  A
+  // nested section, or a loop started from the body of a loop of the
+  // section the thread leads, enlists the workers not already busy
+  // with the enclosing section.
 
   class ParallelSection {
    public:
@@ -210,9 +215,46 @@ class ThreadPool {
     // point to avoid a dependence on the Eigen headers.
     ThreadPoolParallelSection* ps_{nullptr};
     ThreadPool* tp_;
+
+    // The section this section is nested in, or nullptr.  Nested
+    // sections are heap allocated and owned through ps_.
+    ThreadPoolParallelSection* outer_ps_{nullptr};
     ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelSection);
   };
 
+  // Share of the threads of a pool used by the parallel loops of one of
+  // the sessions sharing the pool.
+  //
+  // While work share scopes of a pool are active, a parallel loop started
+  // by a thread inside one of them runs on at most
+  // max(min_threads, (NumThreads() + 1) * weight / total active weight)
+  // threads, so a session running long loops can't take all the workers
+  // of a pool from the other sessions.  Only the scopes that are active
+  // count, so a session running alone gets the whole pool.
+  struct WorkShare {
+    int weight = 1;
+    int min_threads = 0;
+  };
+
+  // Counts the weight of `share` as active in `tp` and applies the share
+  // to the parallel loops run by the calling thread on `tp` until the
+  // scope is destroyed.  A scope nested in a scope of the same pool has
+  // no effect.
+  class WorkShareScope {
+   public:
+    WorkShareScope(ThreadPool* tp, const WorkShare& share);
+    ~WorkShareScope();
+
+   private:
+    friend class ThreadPool;
+
+    // nullptr if the scope has no effect
+    ThreadPool* tp_{nullptr};
+    WorkShare share_;
+    const WorkShareScope* previous_{nullptr};
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WorkShareScope);
+  };
+
   // The below API allows to disable spinning
   // This is used to support real-time scenarios where
   // spinning between relatively infrequent requests
@@ -221,6 +263,11 @@ class ThreadPool {
 
   void DisableSpinning();
 
+  // Number of threads created by the pool and the total time they have spent
+  // running work items since it was created, for utilization metrics.  Both
+  // are 0 for a pool without threads of its own.
+  static void GetBusyTime(const ThreadPool* tp, int& num_threads, uint64_t& busy_ns);
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -407,8 +454,16 @@ class ThreadPool {
   void ParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                    const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn);
 
+  // ParallelFor with the cost estimate replaced by the cost measured by cost_calibration_, timing the loop if the
+  // calibration asks for it.
+  void CalibratedParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn);
+
   void SimpleParallelFor(std::ptrdiff_t total, const std::function<void(std::ptrdiff_t)>& fn);
 
+  // Limit the number of work items of a parallel loop to the work share of the calling thread, if any.
+  int NumWorkItemsInShare(int num_work_items) const;
+
   void Schedule(std::function<void()> fn);
 
   void StartProfiling();
@@ -426,8 +481,17 @@ class ThreadPool {
   // If used, underlying_threadpool_ is instantiated and owned by the ThreadPool.
   std::unique_ptr<ThreadPoolTempl<Env> > extended_eigen_threadpool_;
 
+  // If used, underlying_threadpool_ delegates the work to the custom scheduler of thread_options_.
+  std::unique_ptr<ExtendedThreadPoolInterface> custom_scheduler_threadpool_;
+
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
+
+  // Measured costs of the ParallelFor call sites, if cost calibration is enabled.
+  ParallelForCalibration* cost_calibration_ = nullptr;
+
+  // Sum of the weights of the active work share scopes of the pool.
+  std::atomic<int> active_work_share_weight_{0};
 };
 
 }  // namespace concurrency
@@ -32,4 +32,10 @@ struct OrtCUDAProviderOptionsV2 {
   int tunable_op_max_tuning_duration_ms = 0;                                                                   // Max tuning duration time limit for TunableOp.
   int enable_skip_layer_norm_strict_mode = 0;                                                                  // flag specifying if SkipLayerNorm is in strict mode. If true, use LayerNormalization kernel.
                                                                                                                // The strict mode has better accuracy but lower performance.
+  size_t pinned_staging_pool_max_bytes = 0;                                                                    // Max total size of the pinned buffers staging copies of pageable host memory. 0 disables staging.
+  int enable_cross_stream_buffer_reuse = 0;                                                                    // flag specifying if a buffer freed on one stream can be reused by another stream after an event wait.
+  int cuda_graph_max_captures = 0;                                                                             // Max number of CUDA graphs captured per distinct set of input shapes. 0 captures a single graph regardless of shapes.
+  int use_cuda_mem_pool = 0;                                                                                   // flag specifying if the device memory is allocated from a stream ordered memory pool shared by the sessions instead of an arena.
+  size_t cuda_mem_pool_release_threshold = std::numeric_limits<size_t>::max();                                 // Bytes the shared memory pool keeps when it is idle, the rest is released at synchronization.
+  int enable_profiling_kernel_metrics = 0;                                                                     // flag specifying if the profile adds the occupancy and resource usage of the kernels to their events and nodes.
 };
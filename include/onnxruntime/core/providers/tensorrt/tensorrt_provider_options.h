@@ -45,4 +45,6 @@ struct OrtTensorRTProviderOptionsV2 {
   const char* trt_profile_max_shapes;           // Specify the range of the input shapes to build the engine with
   const char* trt_profile_opt_shapes;           // Specify the range of the input shapes to build the engine with
   int trt_cuda_graph_enable;                    // Enable CUDA graph in ORT TRT
+  const char* trt_profile_shapes_trace;         // Generate explicit profiles from the input shapes observed in this file, one "input1:dim1xdim2...,input2:..." per line
+  int trt_num_auto_profiles;                    // Maximum number of profiles generated from trt_profile_shapes_trace. Default 3.
 };
@@ -694,6 +694,38 @@ typedef OrtCustomThreadHandle (*OrtCustomCreateThreadFn)(void* ort_custom_thread
  */
 typedef void (*OrtCustomJoinThreadFn)(OrtCustomThreadHandle ort_custom_thread_handle);
 
+/** \brief Task run by an OrtCustomScheduler
+ *
+ * Argument ort_task_param is the value onnxruntime passed along with the task.
+ * Argument task_index is the index of the task in its batch, or 0 for a task submitted with OrtCustomScheduler::Schedule.
+ */
+typedef void (*OrtCustomSchedulerTaskFn)(void* ort_task_param, size_t task_index);
+
+/** \brief Scheduler of an application the intra-op thread pool delegates its work to
+ *
+ * When set, onnxruntime doesn't create intra-op threads. The parallel loops of the kernels are split into batches of
+ * tasks run with RunTasks, and other work is submitted with Schedule.
+ * The structure is copied, but scheduler_state must stay valid as long as the thread pool using it.
+ */
+typedef struct OrtCustomScheduler {
+  uint32_t version;  ///< Must be initialized to ORT_API_VERSION
+
+  /// Passed to RunTasks and Schedule.
+  void* scheduler_state;
+
+  /// Number of tasks of a batch that can run at the same time, including the calling thread.
+  /// A value of 1 or less runs the parallel loops in the calling thread.
+  int degree_of_parallelism;
+
+  /// Run task_fn(ort_task_param, i) for each i in [0, num_tasks) and return once all the tasks have completed.
+  /// The tasks may run in any order and in the calling thread. They don't throw.
+  void(ORT_API_CALL* RunTasks)(void* scheduler_state, OrtCustomSchedulerTaskFn task_fn, void* ort_task_param,
+                               size_t num_tasks);
+
+  /// Run task_fn(ort_task_param, 0) asynchronously. The task must run exactly once.
+  void(ORT_API_CALL* Schedule)(void* scheduler_state, OrtCustomSchedulerTaskFn task_fn, void* ort_task_param);
+} OrtCustomScheduler;
+
 typedef OrtStatus*(ORT_API_CALL* RegisterCustomOpsFn)(OrtSessionOptions* options, const OrtApiBase* api);
 
 /** \brief Callback function for RunAsync
@@ -2762,6 +2794,10 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "thread_cache_max_bytes": Allocations of up to this many bytes (at most 1MB) are served from per-thread caches
+   *  of free chunks, so concurrent Run calls sharing the arena rarely contend on its lock. The caches are refilled
+   *  from and flushed to the arena in batches. Cached allocations are rounded up to a power of two and free chunks
+   *  held by the caches count as in use. Default is 0, which disables the caches.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -3586,7 +3622,8 @@ struct OrtApi {
    * QNN supported keys:
    *   "backend_path": file path to QNN backend library.
    *   "qnn_context_cache_enable": 1 to enable QNN graph creation from cached QNN context file. If it's enabled: QNN EP will
-   *    load from cached QNN context binary if it exist. It will generate a context binary file if it's not exist
+   *    load from cached QNN context binary if it exist. It will generate a context binary file if it's not exist, or if it
+   *    was generated with a different QNN backend build. The graphs of all the partitions are cached in one QNN context.
    *   "qnn_context_cache_path": explicitly provide the QNN context cache file. Default to model_file.onnx.bin if not provided.
    *   "profiling_level": QNN profiling level, options: "off", "basic", "detailed". Default to off.
    *   "rpc_control_latency": QNN RPC control latency.
@@ -4325,6 +4362,10 @@ struct OrtApi {
                   _In_reads_(num_keys) const char* const* provider_options_keys, _In_reads_(num_keys) const char* const* provider_options_values, _In_ size_t num_keys);
 
   /** \brief Run the model asynchronously in a thread owned by intra op thread pool
+   *
+   * If the session config entry "session.run_async.num_threads" is set, the run is queued and executed by threads
+   * owned by the session instead, and the intra op thread pool is free to be used for the kernels of the run.
+   * The call fails without invoking run_async_callback if "session.run_async.max_queue_size" runs are already waiting.
    *
    * \param[in] session
    * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
@@ -4424,6 +4465,127 @@ struct OrtApi {
   */
   ORT_API2_STATUS(SessionOptionsAppendExecutionProvider_Hailo,
                   _In_ OrtSessionOptions* options, _In_ int use_arena); // TODO: HRT-8414
+
+  /** \brief Get the metrics of the allocators used by a session
+   *
+   * The metrics are returned as a JSON array with an object per allocator holding its "name", "device" and
+   * "metrics". The metrics include the bytes in use and allocated, the in use and free chunks per arena bin, the
+   * largest free chunk, and histograms of the requested allocation sizes in bytes and of the allocation lifetimes
+   * in microseconds. Histogram bucket 0 counts the values below 2 and bucket i the values in [2^i, 2^(i+1)).
+   * Allocators other than arenas only report their counters.
+   *
+   * Collecting the metrics locks each arena for a time proportional to its number of chunks, so it is cheap
+   * enough to be polled periodically while the session is running.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out Null terminated JSON string. Must be freed with `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   */
+  ORT_API2_STATUS(SessionGetAllocatorMetrics, _In_ const OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Restrict the global intra-op thread pool to the performance cores of a hybrid CPU
+   *
+   * Sets global thread pool options to be used in the call to OrtApi::CreateEnvWithGlobalThreadPools.
+   * Unless an affinity is set with OrtApi::SetGlobalIntraOpThreadAffinity, each intra-op thread is bound to a
+   * performance core (P-core). If the number of intra-op threads is not set, a thread is created per performance
+   * core. This avoids parallel sections waiting on the slower efficiency cores, which matters most for
+   * latency-critical workloads.
+   * The option has no effect on CPUs that aren't hybrid, or if there are fewer performance cores than threads.
+   *
+   * \param[in] tp_options
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   */
+  ORT_API2_STATUS(SetGlobalIntraOpPerformanceCoresOnly, _Inout_ OrtThreadingOptions* tp_options);
+
+  /** \brief Run the work of the global intra-op thread pool on a scheduler of the application
+   *
+   * Sets global thread pool options to be used in the call to OrtApi::CreateEnvWithGlobalThreadPools.
+   * No intra-op threads are created: the parallel loops of the kernels run on the scheduler instead, with
+   * OrtCustomScheduler::degree_of_parallelism as the number of threads. This avoids oversubscribing the cores
+   * when the application runs its own executor.
+   * The options of the intra-op threads, such as their number, affinities and custom thread creation functions,
+   * are ignored.
+   *
+   * \param[in] tp_options
+   * \param[in] scheduler Copied. Its scheduler_state must outlive the environment.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   */
+  ORT_API2_STATUS(SetGlobalIntraOpCustomScheduler, _Inout_ OrtThreadingOptions* tp_options,
+                  _In_ const OrtCustomScheduler* scheduler);
+
+  /** \brief Run the work of the intra-op thread pool of the session on a scheduler of the application
+   *
+   * Same as OrtApi::SetGlobalIntraOpCustomScheduler for the thread pool of a session using per session threads.
+   *
+   * \param[in] options Session options
+   * \param[in] scheduler Copied. Its scheduler_state must outlive the sessions created with the options.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   */
+  ORT_API2_STATUS(SessionOptionsSetIntraOpCustomScheduler, _Inout_ OrtSessionOptions* options,
+                  _In_ const OrtCustomScheduler* scheduler);
+
+  /** \brief Create a session that runs the model of an existing session
+   *
+   * The new session is created without loading, optimizing, partitioning or pre-packing the model again. It shares
+   * the graph, kernels, initializers, pre-packed weights, execution providers, allocators and thread pools of
+   * `session`, and has its own logger, run statistics, profiler for the session level events, RunAsync threads and
+   * dynamic batching. Only the settings of `options` for those apply.
+   * The new session can be run concurrently with `session` and its other clones.
+   *
+   * \param[in] session An initialized session. Must outlive the new session.
+   * \param[in] options
+   * \param[out] out Returned newly created OrtSession. Must be freed with OrtApi::ReleaseSession
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   */
+  ORT_API2_STATUS(CreateSessionFromSession, _In_ const OrtSession* session, _In_ const OrtSessionOptions* options,
+                  _Outptr_ OrtSession** out);
+
+  /** \brief Get the summary of the events of the runs sampled by the profiler of a session
+   *
+   * Only available while the session is profiling with sampling, see the "session.profiling_sample_rate" and
+   * "session.profiling_sample_interval_ms" session configuration entries. The summary is a JSON object holding the
+   * number of "sampled_runs" and an array of "events" with the statistics of each event since the summary was last
+   * flushed: its "count", "mean_us", "p50_us", "p99_us" and "max_us" durations in microseconds, and the
+   * "output_size_mean" in bytes. The summary isn't reset.
+   *
+   * \param[in] session
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out Null terminated JSON string. Must be freed with `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   */
+  ORT_API2_STATUS(SessionGetProfilingSummary, _In_ OrtSession* session, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /** \brief Get a snapshot of the metrics of a session
+   *
+   * The metrics are always collected, at the cost of a few atomic increments per run, and are cumulative since the
+   * session was created. They include the number of runs and failed runs, histograms of the run latency and of the
+   * time RunAsync requests waited before running, the number of CUDA graph replays, the hits and misses of the
+   * memory pattern cache, the threads and busy time of the thread pools used by the session, and the bytes in use
+   * and allocated of each allocator.
+   *
+   * With the "json" format the snapshot is a JSON object. Histograms hold a "count", a "sum_seconds" and
+   * "buckets", where bucket i counts the durations in (2^(i-1), 2^i] microseconds and the last bucket the longer
+   * ones. With the "prometheus" format the snapshot is in the Prometheus text exposition format, with metrics named
+   * ort_session_* and labeled with the session id, so it can be served as is to a Prometheus scraper.
+   *
+   * \param[in] session
+   * \param[in] format "json" or "prometheus"
+   * \param[in] allocator Allocator used to allocate the returned string
+   * \param[out] out Null terminated string. Must be freed with `allocator`.
+   *
+   * \snippet{doc} snippets.dox OrtStatus Return Value
+   */
+  ORT_API2_STATUS(SessionGetMetrics, _In_ const OrtSession* session, _In_ const char* format,
+                  _Inout_ OrtAllocator* allocator, _Outptr_ char** out);
 };
 
 /*
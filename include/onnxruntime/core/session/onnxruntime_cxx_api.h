@@ -679,6 +679,12 @@ struct ThreadingOptions : detail::Base<OrtThreadingOptions> {
   /// \brief Wraps OrtApi::SetGlobalDenormalAsZero
   ThreadingOptions& SetGlobalDenormalAsZero();
 
+  /// \brief Wraps OrtApi::SetGlobalIntraOpPerformanceCoresOnly
+  ThreadingOptions& SetGlobalIntraOpPerformanceCoresOnly();
+
+  /// \brief Wraps OrtApi::SetGlobalIntraOpCustomScheduler
+  ThreadingOptions& SetGlobalIntraOpCustomScheduler(const OrtCustomScheduler& scheduler);
+
   /// \brief Wraps OrtApi::SetGlobalCustomCreateThreadFn
   ThreadingOptions& SetGlobalCustomCreateThreadFn(OrtCustomCreateThreadFn ort_custom_create_thread_fn);
 
@@ -893,6 +899,7 @@ struct SessionOptionsImpl : ConstSessionOptionsImpl<T> {
   SessionOptionsImpl& SetCustomCreateThreadFn(OrtCustomCreateThreadFn ort_custom_create_thread_fn);  ///< Wraps OrtApi::SessionOptionsSetCustomCreateThreadFn
   SessionOptionsImpl& SetCustomThreadCreationOptions(void* ort_custom_thread_creation_options);      ///< Wraps OrtApi::SessionOptionsSetCustomThreadCreationOptions
   SessionOptionsImpl& SetCustomJoinThreadFn(OrtCustomJoinThreadFn ort_custom_join_thread_fn);        ///< Wraps OrtApi::SessionOptionsSetCustomJoinThreadFn
+  SessionOptionsImpl& SetIntraOpCustomScheduler(const OrtCustomScheduler& scheduler);                 ///< Wraps OrtApi::SessionOptionsSetIntraOpCustomScheduler
 
   ///< Registers the custom operator from the specified shared library via OrtApi::RegisterCustomOpsLibrary_V2.
   ///< The custom operator configurations are optional. If provided, custom operator configs are set via
@@ -1031,6 +1038,23 @@ struct ConstSessionImpl : Base<T> {
   uint64_t GetProfilingStartTimeNs() const;  ///< Wraps OrtApi::SessionGetProfilingStartTimeNs
   ModelMetadata GetModelMetadata() const;    ///< Wraps OrtApi::SessionGetModelMetadata
 
+  /** \brief Returns a copy of the allocator metrics of the session as a JSON string.
+   *
+   * \param allocator to allocate memory for the returned string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetAllocatorMetricsAllocated(OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetAllocatorMetrics
+
+  /** \brief Returns a snapshot of the metrics of the session, e.g. its run count and latency histogram.
+   *
+   * \param format "json" or "prometheus"
+   * \param allocator to allocate memory for the returned string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetMetricsAllocated(const char* format, OrtAllocator* allocator) const;  ///< Wraps OrtApi::SessionGetMetrics
+
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
   TypeInfo GetOutputTypeInfo(size_t index) const;                  ///< Wraps OrtApi::SessionGetOutputTypeInfo
   TypeInfo GetOverridableInitializerTypeInfo(size_t index) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerTypeInfo
@@ -1098,6 +1122,14 @@ struct SessionImpl : ConstSessionImpl<T> {
    *  The OrtAllocator instances must be valid at the point of memory release.
    */
   AllocatedStringPtr EndProfilingAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionEndProfiling
+
+  /** \brief Returns the summary of the events of the runs sampled by the profiler as a JSON string.
+   *
+   * \param allocator to allocate memory for the returned string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   *  The OrtAllocator instances must be valid at the point of memory release.
+   */
+  AllocatedStringPtr GetProfilingSummaryAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionGetProfilingSummary
 };
 
 }  // namespace detail
@@ -1116,6 +1148,7 @@ struct Session : detail::SessionImpl<OrtSession> {
   Session(const Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options);  ///< Wraps OrtApi::CreateSessionFromArray
   Session(const Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options,
           OrtPrepackedWeightsContainer* prepacked_weights_container);  ///< Wraps OrtApi::CreateSessionFromArrayWithPrepackedWeightsContainer
+  Session(const ConstSession& session, const SessionOptions& options);  ///< Wraps OrtApi::CreateSessionFromSession
 
   ConstSession GetConst() const { return ConstSession{this->p_}; }
   UnownedSession GetUnowned() const { return UnownedSession{this->p_}; }
@@ -443,6 +443,16 @@ inline ThreadingOptions& ThreadingOptions::SetGlobalDenormalAsZero() {
   return *this;
 }
 
+inline ThreadingOptions& ThreadingOptions::SetGlobalIntraOpPerformanceCoresOnly() {
+  ThrowOnError(GetApi().SetGlobalIntraOpPerformanceCoresOnly(p_));
+  return *this;
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalIntraOpCustomScheduler(const OrtCustomScheduler& scheduler) {
+  ThrowOnError(GetApi().SetGlobalIntraOpCustomScheduler(p_, &scheduler));
+  return *this;
+}
+
 inline ThreadingOptions& ThreadingOptions::SetGlobalCustomCreateThreadFn(OrtCustomCreateThreadFn ort_custom_create_thread_fn) {
   ThrowOnError(GetApi().SetGlobalCustomCreateThreadFn(p_, ort_custom_create_thread_fn));
   return *this;
@@ -850,6 +860,12 @@ inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::SetCustomJoinThreadFn(OrtCu
   return *this;
 }
 
+template <typename T>
+inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::SetIntraOpCustomScheduler(const OrtCustomScheduler& scheduler) {
+  ThrowOnError(GetApi().SessionOptionsSetIntraOpCustomScheduler(this->p_, &scheduler));
+  return *this;
+}
+
 template <typename T>
 inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::AppendExecutionProvider_OpenVINO(const OrtOpenVINOProviderOptions& provider_options) {
   ThrowOnError(GetApi().SessionOptionsAppendExecutionProvider_OpenVINO(this->p_, &provider_options));
@@ -925,6 +941,21 @@ inline uint64_t ConstSessionImpl<T>::GetProfilingStartTimeNs() const {
   return out;
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetAllocatorMetricsAllocated(OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetAllocatorMetrics(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::GetMetricsAllocated(const char* format,
+                                                                   OrtAllocator* allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetMetrics(this->p_, format, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 template <typename T>
 inline ModelMetadata ConstSessionImpl<T>::GetModelMetadata() const {
   OrtModelMetadata* out;
@@ -995,6 +1026,13 @@ inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* al
   return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
 }
 
+template <typename T>
+inline AllocatedStringPtr SessionImpl<T>::GetProfilingSummaryAllocated(OrtAllocator* allocator) {
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionGetProfilingSummary(this->p_, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 }  // namespace detail
 
 inline SessionOptions::SessionOptions() {
@@ -1041,6 +1079,10 @@ inline Session::Session(const Env& env, const void* model_data, size_t model_dat
                                                                             prepacked_weights_container, &this->p_));
 }
 
+inline Session::Session(const ConstSession& session, const SessionOptions& options) {
+  ThrowOnError(GetApi().CreateSessionFromSession(session, options, &this->p_));
+}
+
 inline AllocatedStringPtr ModelMetadata::GetProducerNameAllocated(OrtAllocator* allocator) const {
   char* out;
   ThrowOnError(GetApi().ModelMetadataGetProducerName(p_, allocator, &out));
@@ -30,3 +30,19 @@ static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memor
 // Per default it will be set to '0'
 // Taking CUDA EP as an example, it omit triggering cudaStreamSynchronize on the compute stream.
 static const char* const kOrtRunOptionsConfigDisableSynchronizeExecutionProviders = "disable_synchronize_execution_providers";
+
+// Address of a callback receiving the tokens generated by the BeamSearch, GreedySearch and Sampling operators after
+// each generation step, as a decimal string. The callback has the signature
+//   int callback(void* user_data, const int32_t* next_tokens, const int32_t* beam_indices, size_t count,
+//                int64_t sequence_length)
+// next_tokens holds the token appended to each of the `count` (batch_size x num_beams) sequences, which now have
+// `sequence_length` tokens. BeamSearch reorders the beams at each step: beam_indices holds the index of the sequence
+// continued by each token. It is nullptr for GreedySearch and Sampling.
+// A nonzero return value stops the generation, and the operator outputs the sequences generated so far.
+// BeamSearch only invokes the callback on CPU.
+// By default no callback is invoked.
+static const char* const kOrtRunOptionsConfigGenerationStreamCallback = "generation.stream_callback";
+
+// Address of the user_data passed to the callback set by kOrtRunOptionsConfigGenerationStreamCallback,
+// as a decimal string. Defaults to nullptr.
+static const char* const kOrtRunOptionsConfigGenerationStreamCallbackUserData = "generation.stream_callback_user_data";
@@ -20,6 +20,20 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Key for disabling the parallel creation of kernels and pre-packing of weights during session initialization.
+// By default kernels of the CPU EP for the built-in operator domains are created, and their weights pre-packed, on the
+// intra-op thread pool. The sharing of pre-packed weights through a PrepackedWeightsContainer is deterministic either
+// way. If the config value is set to "1" all kernels are created and pre-packed on the calling thread.
+static const char* const kOrtSessionOptionsConfigDisableParallelKernelCreation =
+    "session.disable_parallel_kernel_creation";
+
+// Key for disabling the parallel compilation of the fused nodes of compiling execution providers during graph
+// partitioning. By default the fused nodes of an EP that supports concurrent calls to Compile, see
+// IExecutionProvider::ConcurrentCompileSupported, are compiled on the intra-op thread pool, one Compile call per
+// fused node. Other EPs compile all their fused nodes in one call. If the config value is set to "1" the fused nodes
+// of every EP are compiled on the calling thread.
+static const char* const kOrtSessionOptionsConfigDisableParallelCompilation = "session.disable_parallel_compilation";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
@@ -67,6 +81,58 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable fusing chains of float element-wise ops into one ElementwiseChain node on the CPU EP.
+// "0": disable; "1": enable. The default is "0".
+// The fusion runs in level 2 and takes the Add and Relu nodes that the level 3 Conv fusions would fold into a Conv,
+// so it is best enabled for models where the chains don't follow a Conv.
+static const char* const kOrtSessionOptionsEnableElementwiseChainFusion =
+    "optimization.enable_elementwise_chain_fusion";
+
+// Replace ZipMap nodes producing a graph output with a passthrough of their float tensor of probabilities, and add the
+// class labels as a 1D graph output named after the ZipMap output with a "_labels" suffix.
+// "0": disable; "1": enable. The default is "0".
+// This avoids building one map per row, but changes the type of the model outputs, so it is disabled by default.
+static const char* const kOrtSessionOptionsEnableZipMapColumnar = "optimization.enable_zipmap_columnar";
+
+// Enable or disable fusing chains of float Imputer, Scaler, Binarizer and Normalizer nodes into one MLPreprocessing
+// node on the CPU EP, and folding a Scaler that feeds a LinearClassifier or LinearRegressor into its coefficients.
+// "0": disable; "1": enable. The default is "0".
+// The folded coefficients round differently from the two separate steps, so the outputs can change in the last bits.
+static const char* const kOrtSessionOptionsEnableMLPreprocessingFusion = "optimization.enable_ml_preprocessing_fusion";
+
+// Enable or disable the cost model of the NCHWc layout transformer of level 3. With it, each connected region of
+// nodes the transformer would convert to the NCHWc layout stays in NCHW layout if the ReorderInput and ReorderOutput
+// nodes at its boundaries are predicted to take longer than the NCHWc convolutions save.
+// "0": disable; "1": enable. The default is "0".
+static const char* const kOrtSessionOptionsEnableNchwcCostModel = "optimization.enable_nchwc_cost_model";
+
+// Enable or disable replacing the subgraphs that compute the shape input of Reshape and Expand nodes from the dims of
+// other tensors, like Shape -> Gather -> Unsqueeze -> Concat, with one ShapeExpression node on the CPU and CUDA EPs.
+// "0": disable; "1": enable. The default is "0".
+// The optimized model needs the ShapeExpression contrib op, so it is disabled by default.
+static const char* const kOrtSessionOptionsEnableShapeExpressionFusion = "optimization.enable_shape_expression_fusion";
+
+// Quantize the large float tables of Gather nodes on the CPU EP, like embedding tables, blockwise with 4 or 8 bits,
+// and gather from them with GatherBlockQuantized, which dequantizes only the gathered rows.
+// "0": disable; "4": 4 bits; "8": 8 bits. The default is "0".
+// The tables are quantized in blocks of 32 elements with a scale and zero point each. Tables with fewer than 2^20
+// elements are left as they are. This changes the values of the gathered rows, so it is disabled by default.
+static const char* const kOrtSessionOptionsGatherBlockQuantizationBits = "optimization.gather_block_quantization_bits";
+
+// Enable or disable choosing float or float16 for each connected region of nodes that can run in either, after the
+// nodes are assigned to EPs, so that the fewest Cast nodes are needed at the boundaries of the regions. A region only
+// switches to a type its EP has kernels for. "0": disable; "1": enable. The default is "0".
+// Regions with data movement and selection ops like Transpose, Concat, Relu and Max give the same values in both
+// types. Regions with arithmetic ops may be computed in float instead of float16, but only switch from float to float16
+// if all of their arithmetic op types are listed in kOrtSessionOptionsCastPrecisionPropagationFp16Ops.
+static const char* const kOrtSessionOptionsEnableCastPrecisionPropagation =
+    "optimization.enable_cast_precision_propagation";
+
+// Comma separated list of the arithmetic op types, like "Add,Mul,Sigmoid", that the cast precision propagation may
+// compute in float16 instead of float. The default is "", so only computations in float16 are moved to float.
+static const char* const kOrtSessionOptionsCastPrecisionPropagationFp16Ops =
+    "optimization.cast_precision_propagation_fp16_ops";
+
 #ifdef ENABLE_TRAINING
 // Specifies a list of op types for memory footprint reduction.
 // The value should be a ","-delimited list of pair of
@@ -81,6 +147,13 @@ static const char* const kOrtSessionOptionsMemoryOptimizerEnabler = "optimizatio
 // Specifies the level for detecting subgraphs for memory footprint reduction.
 // The value should be an integer. The default value is 0.
 static const char* const kOrtSessionOptionsMemoryOptimizerProbeLevel = "optimization.enable_memory_probe_recompute_level";
+
+// Specifies a memory budget in bytes for the activations stashed for the backward pass.
+// If set, the memory optimizer recomputes the subgraphs not listed in "optimization.enable_memory_optimizer" as
+// needed to fit the budget, choosing those with the least recompute FLOPs per saved byte. The sizes and FLOPs are
+// estimated from static shapes. The default is "", which disables the budget.
+static const char* const kOrtSessionOptionsMemoryOptimizerRecomputeBudget =
+    "optimization.memory_optimizer_recompute_budget_bytes";
 #endif
 
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
@@ -93,12 +166,45 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Let the intra_op threads decide whether to spin from the gaps they observe between parallel sections and runs.
+// A thread spins only if the gap is expected to be shorter than the time it takes to wake it up once it blocked,
+// and then spins for at most that time. Otherwise it blocks right away. This keeps most of the latency benefit of
+// spinning at a fraction of its CPU cost when requests are sparse.
+// "0": disabled (default). "1": enabled, in which case "session.intra_op.allow_spinning" is ignored.
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
+// Replace the hand-written cost estimates of the parallel loops of the kernels by their costs measured at run time,
+// so that the loops are split into blocks of the right size over time. Some calls of each loop are timed to keep
+// the measurements up to date.
+// "0": disabled (default). "1": enabled. Only applies to per-session intra_op thread pools and requires RTTI.
+static const char* const kOrtSessionOptionsConfigIntraOpCalibrateParallelForCosts =
+    "session.intra_op.calibrate_parallel_for_costs";
+
+// Path of a file the measured costs of the parallel loops are loaded from when the session is created, if it exists,
+// and saved to when the session is destroyed. Setting it enables "session.intra_op.calibrate_parallel_for_costs".
+// The file is only valid for the build of onnxruntime that wrote it.
+static const char* const kOrtSessionOptionsConfigParallelForCalibrationFile =
+    "session.intra_op.parallel_for_calibration_file";
+
+// Share of the global intra_op thread pool used by the session, relative to the other sessions running at the same
+// time. While kernels of several sessions run, the parallel loops of a session run on at most
+// weight / (sum of the weights of the running sessions) of the threads of the pool, so a session running long loops
+// leaves threads to the others. A session running alone uses the whole pool.
+// Positive integer, "1" by default. Only applies to sessions using the global thread pools.
+static const char* const kOrtSessionOptionsConfigIntraOpWorkShareWeight = "session.intra_op.work_share_weight";
+
+// Minimum number of threads of the global intra_op thread pool the parallel loops of the session may run on,
+// whatever the weights of the other running sessions. "0" by default.
+static const char* const kOrtSessionOptionsConfigIntraOpWorkShareMinThreads = "session.intra_op.work_share_min_threads";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
 // buffer is valid.
 // Setting this option to "1" will disable copy the model bytes, and use the model bytes directly. The caller
 // has to guarantee that the model bytes are valid until the ORT session using the model bytes is destroyed.
+// If the session is created from the path of an ORT format model, setting this option to "1" maps the file into memory
+// instead of reading it.
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "session.use_ort_model_bytes_directly";
 
 /// <summary>
@@ -107,6 +213,8 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 /// Requires `session.use_ort_model_bytes_directly` to be true.
 /// If set, the flatbuffer bytes provided when creating the InferenceSession MUST remain valid for the entire
 /// duration of the InferenceSession.
+/// The raw data of the initializers is 64-byte aligned in ORT format models, so the initializers of a model file
+/// mapped this way use the pages of the file, which are shared by all the processes that load the model.
 /// </summary>
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
@@ -142,6 +250,20 @@ static const char* const kOrtSessionOptionsConfigMinimalBuildOptimizations =
 // exclusion, set the value to "".
 static const char* const kOrtSessionOptionsConfigNnapiEpPartitioningStopOps = "ep.nnapi.partitioning_stop_ops";
 
+// Specifies the minimum size of a partition taken by the NNAPI EP, counted in nodes that do compute, i.e. not counting
+// nodes which only reshape, cast or (de)quantize data. Smaller partitions are left to the CPU EP, as their NNAPI
+// compilation and the copies to and from the accelerator can cost more than running them on CPU saves.
+// The partitions left to the CPU EP are reported in the session creation log.
+// The value should be a non-negative integer. If not specified or "0", all partitions are taken.
+static const char* const kOrtSessionOptionsConfigNnapiEpMinPartitionSize = "ep.nnapi.min_partition_size";
+
+// Specifies a directory, e.g. in the caches directory of the app, in which the CoreML EP keeps the compiled CoreML
+// models (.mlmodelc) of the partitions it takes, so that sessions created on later launches load them instead of
+// compiling the models again. The compiled models are keyed by the content of the partition, the CoreML flags and
+// the OS version, and a compiled model which fails to load is compiled again and replaced.
+// If not specified, the models are compiled for every session and not kept.
+static const char* const kOrtSessionOptionsConfigCoreMLEpModelCacheDir = "ep.coreml.model_cache_dir";
+
 // Enabling dynamic block-sizing for multithreading.
 // With a positive value, thread pool will split a task of N iterations to blocks of size starting from:
 // N / (num_of_threads * dynamic_block_base)
@@ -190,6 +312,31 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
 
+// Bind the intra op threads to the performance cores (P-cores) of a hybrid CPU, so that parallel sections of
+// latency-critical sessions don't wait on the slower efficiency cores.
+// "0": disabled (default). "1": enabled.
+// If the number of intra op threads is not set, a thread is created per performance core. The option is ignored if
+// "session.intra_op_thread_affinities" is set, on CPUs that aren't hybrid and if there are fewer performance cores
+// than intra op threads.
+static const char* const kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly = "session.intra_op.performance_cores_only";
+
+// Bind the intra op threads to cores selected from the CPU topology reported by the OS, instead of spelling out the
+// processors with "session.intra_op_thread_affinities". A ","-delimited list of presets:
+// "physical_cores": a thread per physical core, bound to the logical processors of the core.
+// "skip_smt": also bind each thread to the first logical processor of its core only, leaving its SMT siblings idle.
+// "one_socket": only use the cores of the CPU package (socket) of the first core, or of its NUMA node if the
+//               packages are unknown.
+// "performance_cores": only use the performance cores of a hybrid CPU.
+// e.g. "one_socket,skip_smt". The calling thread is expected to run on the first selected core. If the number of intra
+// op threads is not set, a thread is created per selected core. The default is "", which doesn't apply a preset.
+// The option is ignored if "session.intra_op_thread_affinities" is set.
+static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinityPreset = "session.intra_op_thread_affinity_preset";
+
+// Bind the inter op threads to cores selected by a preset, see "session.intra_op_thread_affinity_preset".
+// If the intra op threads use the same preset, the inter op threads are bound to the selected cores after theirs,
+// so the two thread pools don't share cores. The default is "", which doesn't apply a preset.
+static const char* const kOrtSessionOptionsConfigInterOpThreadAffinityPreset = "session.inter_op_thread_affinity_preset";
+
 // This option will dump out the model to assist debugging any issues with layout transformation,
 // and is primarily intended for developer usage. It is only relevant if an execution provider that requests
 // NHWC layout is enabled such as NNAPI, XNNPACK or QNN.
@@ -218,6 +365,18 @@ static const char* const kDebugLayoutTransformation = "session.debug_layout_tran
 // - "1": CPU EP fallback is disabled.
 static const char* const kOrtSessionOptionsDisableCPUEPFallback = "session.disable_cpu_ep_fallback";
 
+// Enables cost aware graph partitioning. Execution providers still claim nodes in priority order, but the nodes a
+// device execution provider such as CUDA claims with individual kernels are grouped into islands of connected nodes,
+// and an island is left to the CPU EP when the copies of the tensors crossing its boundary are estimated to cost more
+// than running it on the device saves. Islands with compute bound nodes, e.g. Conv or MatMul, stay on the device.
+// The estimate uses the inferred tensor shapes. The islands left to the CPU EP are reported in the session log.
+// Compiling execution providers such as TensorRT are not affected.
+//
+// Option values:
+// - "0": Nodes are assigned to the first execution provider that claims them. [DEFAULT]
+// - "1": Cost aware partitioning is enabled.
+static const char* const kOrtSessionOptionsConfigCostAwarePartitioning = "session.cost_aware_partitioning";
+
 // Use this config when serializing a large model after optimization to specify an external initializers file
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFileName =
     "session.optimized_model_external_initializers_file_name";
@@ -225,3 +384,380 @@ static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersFil
 // Use this config to control the minimum size of the initializer when externalizing it during serialization
 static const char* const kOrtSessionOptionsOptimizedModelExternalInitializersMinSizeInBytes =
     "session.optimized_model_external_initializers_min_size_in_bytes";
+
+// Directory of a cache of optimized models. When set, a session that loads an ONNX model from a file or from bytes
+// looks for an ORT format model optimized from the same model bytes with the same session configuration in the
+// directory and loads it instead of running the graph optimizations. On a miss the model is optimized as usual and
+// saved to the directory. Sessions can share the directory, also from concurrent processes.
+// The cache is only used with the CPU, CUDA and ROCm EPs, and not with optimized_model_filepath, shared or external
+// initializers. The key includes the CPU features, so the directory should not be shared across different machines.
+// Graph transformers registered with the session are not part of the key, nor are external data files of the model.
+static const char* const kOrtSessionOptionsOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
+// Maximum total size in bytes of the models in the optimized model cache directory. After saving a model, the least
+// recently used models are removed until the others fit. The default is "0", which means no limit.
+static const char* const kOrtSessionOptionsOptimizedModelCacheMaxSizeInBytes =
+    "session.optimized_model_cache_max_size_in_bytes";
+
+// Enables server-side dynamic batching of concurrent Run() calls.
+// Concurrent Run() calls that use the same input and output names, whose inputs are CPU tensors with matching shapes
+// apart from the batch axis, and that don't provide pre-allocated outputs are merged into a single execution.
+// The outputs of the merged execution are split along the batch axis and returned to the individual callers, so every
+// model output must have the batch axis.
+// The value is the maximum total size of the batch axis for a merged execution. "0" or "1" disables batching.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize =
+    "session.dynamic_batching.max_batch_size";
+
+// The maximum time in microseconds the first Run() call of a batch waits for more calls to join it before executing.
+// Only applies when dynamic batching is enabled. The default is "500".
+static const char* const kOrtSessionOptionsConfigDynamicBatchingMaxWaitUs = "session.dynamic_batching.max_wait_us";
+
+// The axis along which inputs are concatenated and outputs are split when dynamic batching is enabled.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigDynamicBatchingBatchAxis = "session.dynamic_batching.batch_axis";
+
+// Share memory patterns between input shapes that round up to the same bucket.
+// By default a memory pattern is only reused for the exact input shapes it was generated with, which rarely hits
+// for inputs with dynamic dims such as the sequence length.
+// "pow2": free dims of the graph inputs are rounded up to the next power of two to select the memory pattern, and a
+//         pattern generated for a larger shape in the bucket replaces the one generated for a smaller shape.
+// "": disabled. The default.
+// Only applies if the memory pattern optimization is enabled.
+static const char* const kOrtSessionOptionsConfigMemoryPatternShapeBucketing =
+    "session.memory_pattern.shape_bucketing";
+
+// A ","-delimited list of dim params whose graph input dims are bucketed, e.g. "batch,sequence".
+// If empty, all free dims of the graph inputs are bucketed. The default is "".
+static const char* const kOrtSessionOptionsConfigMemoryPatternBucketedDims = "session.memory_pattern.bucketed_dims";
+
+// The maximum total peak size in bytes of the memory patterns cached by a session.
+// The least recently used patterns are evicted once the limit is exceeded. "0" means unbounded. The default is "0".
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheMaxBytes = "session.memory_pattern.cache_max_bytes";
+
+// How a memory pattern places the tensors of a run in its buffer.
+// "online": each tensor is placed in the smallest free gap when it is allocated. The default.
+// "greedy_by_size": once the run completes, the tensors are placed in order of decreasing size, each in the smallest
+//                   gap left by the tensors whose lifetimes overlap with it. The online placement is kept if it is
+//                   smaller. The planned peak and the lower bound given by the tensor lifetimes are logged at INFO
+//                   level for both algorithms.
+// Only applies if the memory pattern optimization is enabled.
+static const char* const kOrtSessionOptionsConfigMemoryPatternAlgorithm = "session.memory_pattern.algorithm";
+
+// Save the execution plan and allocation plan of the main graph when saving an ORT format model.
+// A session loading the model skips the planning step if its graph, execution providers and planner related session
+// options match the ones the plan was created with. Otherwise the plan is ignored and a new one is created.
+// "0": the plan is not saved. The default.
+// "1": the plan is saved.
+static const char* const kOrtSessionOptionsConfigSaveExecutionPlanInOrtFormat =
+    "session.save_execution_plan_in_ort_format";
+
+// Use the execution plan saved in an ORT format model if it matches the session.
+// "0": always create a new plan.
+// "1": use the saved plan if possible. The default.
+static const char* const kOrtSessionOptionsConfigUseSavedExecutionPlan = "session.use_saved_execution_plan";
+
+// The number of dedicated threads that execute RunAsync() requests.
+// "0": requests are scheduled on the intra-op thread pool, which must have at least two threads. The default.
+// n > 0: requests are queued and executed by n threads owned by the session, so a pending request never occupies
+//        an intra-op worker and RunAsync() can be used with a single-threaded intra-op thread pool.
+static const char* const kOrtSessionOptionsConfigRunAsyncNumThreads = "session.run_async.num_threads";
+
+// The maximum number of RunAsync() requests waiting for a dedicated thread. RunAsync() fails without invoking the
+// callback once the limit is reached so the caller can apply backpressure.
+// Only applies if "session.run_async.num_threads" is > 0. "0" means unbounded. The default is "0".
+static const char* const kOrtSessionOptionsConfigRunAsyncMaxQueueSize = "session.run_async.max_queue_size";
+
+// Path of a file holding the initializers of the model so that processes running the same model can share one copy.
+// If the file does not exist the session writes the initializers of the optimized main graph to it. Otherwise the
+// session maps the file read-only and uses it for every initializer whose type, shape and data fingerprint match,
+// so the memory is backed by the OS page cache and shared between processes.
+// Pre-packed weights of the CPU EP are shared the same way through "<path>.prepacked", which is written by the first
+// session that pre-packs the weights.
+// Initializers with external data and string initializers are not included, and the file is specific to the host.
+// The default is "", which disables this.
+static const char* const kOrtSessionOptionsConfigSharedWeightsFile = "session.shared_weights_file";
+
+// Set to "1" to share the initializers of the session with the other sessions of the same env that enabled this, by
+// content: the initializers are hashed when the session is initialized, and an initializer with the same type, shape
+// and data as one already loaded by another session uses the same buffer, e.g. the layers that fine-tuned variants of
+// a model have in common. A buffer is released with the last session using it. The sessions also share the
+// pre-packed weights of the CPU EP through a PrepackedWeightsContainer of the env, unless one was added to the
+// session options. Only initializers of at least 1 KB placed in CPU memory are shared, and initializers with external
+// data and string initializers are not. The default is "0".
+static const char* const kOrtSessionOptionsConfigShareInitializersByContent = "session.share_initializers_by_content";
+
+// A directory holding a persistent cache of the pre-packed weights of CPU kernels, e.g. of MatMul and Gemm.
+// A file per model and host CPU features is written once the weights are pre-packed, and on later starts the file is
+// mapped and its weights handed to the kernels instead of pre-packing the initializers again.
+// Only kernels implementing OpKernel::UseCachedPrePackedBuffers restore their weights from the cache, and weights
+// shared through a PrepackedWeightsContainer are not cached. The default is "", which disables the cache.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheDir = "session.prepacked_weights_cache_dir";
+
+// Write the pre-packed weights of CPU kernels next to the optimized model when saving an ORT format model, to
+// "<optimized_model_filepath>.<key>.prepacked". The key identifies the nodes, their EPs, the ORT version and the host
+// CPU features, as the pre-packed layouts (e.g. the MLAS packed GEMM formats) depend on the kernel and the instruction
+// set. Sessions loading the ORT format model from a path on a matching host hand these weights to the kernels
+// instead of pre-packing the initializers again. Files for other keys are ignored.
+// Only kernels implementing OpKernel::UseCachedPrePackedBuffers restore their weights, and
+// "session.prepacked_weights_cache_dir" takes precedence.
+// "0": disabled (default). "1": enabled.
+static const char* const kOrtSessionOptionsConfigSavePrepackedWeightsWithOrtModel =
+    "session.save_prepacked_weights_with_ort_model";
+
+// Keep the initializers with external data in a file that the CPU kernels read lazily from the mapped file.
+// These initializers are not pre-packed, so creating the session does not read them, and their pages are read
+// from the file when the kernels first read them. The OS is asked to read them in the background in the execution
+// order of their nodes once the session is created. As the pages are not modified, the OS can drop them under memory
+// pressure and read them again when needed.
+// "0": disabled (default). "1": enabled. "2": enabled, and the OS is told after each Run that the pages are cold, so
+// they are reclaimed before other memory when memory is low.
+// The kernels that pre-pack their weights run slower with these initializers, and the first Run waits for the pages
+// that have not been read yet.
+static const char* const kOrtSessionOptionsConfigLazyExternalInitializers = "session.lazy_external_initializers";
+
+// Number of initializers with external data in a file that are read, and copied to their device, at the same time
+// on the intra-op thread pool while the session is initialized. Reading several files, or several parts of a file, at
+// once uses more of the bandwidth of NVMe arrays and network file systems than one reader.
+// The data transfers of the EPs of the session must be thread-safe to use a value larger than 1.
+// "1": one at a time (default). "N": up to N at a time, limited by the number of intra-op threads.
+static const char* const kOrtSessionOptionsConfigExternalInitializersLoadConcurrency =
+    "session.external_initializers_load_concurrency";
+
+// A ","-delimited list of graph inputs whose values rarely change between Run() calls, e.g. "attention_mask".
+// The outputs of the nodes that only depend on these inputs and on constant initializers are cached, keyed by the
+// values of the inputs, and the nodes are skipped when a Run is fed values that are in the cache.
+// Only applies to the main graph and to inputs fed as CPU tensors. The default is "", which disables memoization.
+static const char* const kOrtSessionOptionsConfigMemoizationInputs = "session.memoization.inputs";
+
+// The maximum number of distinct input values whose memoized outputs are cached. The least recently used entries are
+// evicted first. The default is "4".
+static const char* const kOrtSessionOptionsConfigMemoizationMaxEntries = "session.memoization.max_entries";
+
+// The maximum number of streams the CPU nodes of the main graph are partitioned into, so that independent branches
+// of the graph run concurrently on the inter-op thread pool. The partition is derived from the estimated cost of
+// each node and the critical path of the graph, and is not used if "session.node_partition_config_file" is set.
+// Only applies if the execution mode is ORT_PARALLEL and the execution order is the default one. A value close to
+// the number of inter-op threads is a good choice. The default is "0", which keeps all the CPU nodes on one stream.
+static const char* const kOrtSessionOptionsConfigMaxCpuStreams = "session.max_cpu_streams";
+
+// EXPERIMENTAL: Run the kernels of the main graph as a task graph on the intra-op thread pool instead of one after the
+// other. A kernel is scheduled as soon as the kernels producing its inputs completed, so small independent kernels run
+// on idle threads while a large kernel finishes. Buffers are not reused between values and memory patterns are
+// disabled, as the order of the kernels isn't known in advance.
+// Only applies to sequential execution of plans with a single CPU stream, and an intra-op thread pool with more than
+// one thread. "0": disabled. "1": enabled. The default is "0".
+static const char* const kOrtSessionOptionsConfigTaskGraphExecution = "session.experimental_task_graph_execution";
+
+// Allow the allocation planner to reuse a freed buffer that is larger than an output, or that held elements of a
+// different size, when no freed buffer has exactly the required size. The smallest buffer that is large enough is
+// used, which is only known if the shapes of both values are static. Otherwise the shapes must match symbolically.
+// This reduces the peak memory of long chains of element-wise ops and casts that change the element type.
+// "0": only reuse buffers of exactly the required size. [DEFAULT]
+// "1": also reuse larger buffers.
+static const char* const kOrtSessionOptionsConfigAllowLargerBufferReuse = "session.memory_reuse.allow_larger_buffers";
+
+// The size in bytes the planned peak memory of the tensors allocated by the main graph should stay under.
+// It is checked against the allocation plan, so it only applies if the shapes of all the allocated tensors are
+// static. If the plan exceeds the budget with the default execution order, the nodes are reordered to keep the size
+// of the live tensors small, which is used if it lowers the peak. A warning is logged if the budget is still exceeded.
+// The reorder is not done with parallel execution, multiple CPU streams or a node partition config file.
+// The default is "0", which sets no budget.
+static const char* const kOrtSessionOptionsConfigMemoryBudgetBytes = "session.memory_budget_bytes";
+
+// How often, in milliseconds, a background thread of the session evaluates the shrink policy of its memory arenas.
+// Only regions of an arena in which no memory is in use are released. The policy is configured with the
+// "session.arena_shrink.*" keys below, and releases the regions selected by any of them.
+// The default is "0", which disables background shrinking.
+static const char* const kOrtSessionOptionsConfigArenaShrinkIntervalMs = "session.arena_shrink.interval_ms";
+
+// Release arena regions that have not been used for at least this many milliseconds.
+// Only applies if "session.arena_shrink.interval_ms" is > 0. The default is "0", which disables the check.
+static const char* const kOrtSessionOptionsConfigArenaShrinkIdleTimeoutMs = "session.arena_shrink.idle_timeout_ms";
+
+// Keep enough memory in an arena for the peak usage during this many milliseconds, and release unused regions
+// beyond that. Also limits what the other criteria release, so memory that was needed recently stays cached.
+// Only applies if "session.arena_shrink.interval_ms" is > 0. The default is "0", which disables the check.
+static const char* const kOrtSessionOptionsConfigArenaShrinkHighWaterMarkWindowMs =
+    "session.arena_shrink.high_water_mark_window_ms";
+
+// Release unused arena regions, least recently used first, while an arena holds more than this many bytes.
+// Only applies if "session.arena_shrink.interval_ms" is > 0. The default is "0", which disables the check.
+static const char* const kOrtSessionOptionsConfigArenaShrinkSoftLimitBytes = "session.arena_shrink.soft_limit_bytes";
+
+// Record every allocation, reservation and free of the memory arenas of the session into this binary file, with the
+// size, arena, stream, node and time of each, so the workload can be replayed offline against other arena
+// configurations with onnxruntime_allocation_replay. The file is written until the session is destroyed.
+// The default is "", which records nothing.
+static const char* const kOrtSessionOptionsConfigAllocationTraceFile = "session.allocation_trace_file";
+
+// Back the large allocations of the CPU execution provider, e.g. arena regions and initializers, with huge pages.
+// "0": regular pages. "1": transparent huge pages. "2": explicit huge pages from the pool configured by the OS,
+// falling back to transparent huge pages once the pool is exhausted.
+// Only supported on Linux. The default is "0".
+static const char* const kOrtSessionOptionsConfigCpuAllocatorHugePages = "session.cpu_allocator.huge_pages";
+
+// Bind the large allocations of the CPU execution provider to a NUMA node.
+// "-1": don't bind them. "<n>": bind them to node n. "auto": bind them to the node that most of the processors in
+// "session.intra_op_thread_affinities" belong to.
+// Only supported on Linux. The default is "-1".
+static const char* const kOrtSessionOptionsConfigCpuAllocatorNumaNode = "session.cpu_allocator.numa_node";
+
+// Compute the float MatMul and Gemm nodes of the CPU execution provider that have a constant B in bfloat16 with fp32
+// accumulation, using AMX-BF16 or AVX512-BF16. B is converted to bfloat16 when the session is initialized, A when
+// the node runs, which trades accuracy for throughput.
+// "0": disabled. "1": enabled on processors that support it.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigCpuBf16Gemm = "session.cpu.enable_bf16_gemm";
+
+// Run the compute heavy float nodes of the CPU execution provider in bfloat16 with fp32 accumulation, using AMX-BF16
+// or AVX512-BF16: the MatMul and Gemm nodes covered by "session.cpu.enable_bf16_gemm", the MatMul nodes with a B
+// that isn't constant, like the products of an attention, and the Conv nodes. The kernels round their inputs to
+// bfloat16 as they read them, so the tensors between nodes stay fp32 and the numerically sensitive nodes, like Softmax,
+// LayerNormalization and the reductions, run in fp32 without inserting any Cast node. Products with few rows stay in
+// fp32 as converting B would cost more than it saves.
+// "0": disabled. "1": enabled on processors that support it.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigCpuBf16MixedPrecision = "session.cpu.enable_bf16_mixed_precision";
+
+// Compute the float Conv nodes of the CPU execution provider that have a constant 3x3 filter, unit strides and
+// dilations and at least 16 input and output channels per group with the Winograd F(4x4, 3x3) algorithm. It takes
+// a quarter of the multiplies, but its transforms add rounding error, so results differ slightly from the direct
+// algorithm.
+// "0": disabled. "1": enabled.
+// The default is "1".
+static const char* const kOrtSessionOptionsConfigCpuWinogradConv = "session.cpu.enable_winograd_conv";
+
+// Quantize the input A of the DynamicQuantizeMatMul nodes of the CPU execution provider with a scale and zero point
+// per row (i.e. per token) instead of one for the whole tensor. The range of each row is found right before the row
+// is quantized, so A is read from memory once. It is more accurate when the rows have different ranges, but the
+// results differ from the per tensor quantization of the ONNX specification.
+// Only applies to nodes with a 2D B and an A of rank 2 or more.
+// "0": disabled. "1": enabled.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigCpuDynamicQuantizeMatMulPerRow =
+    "session.cpu.dynamic_quantize_matmul_per_row";
+
+// Compute the attention core of the QAttention nodes of the CPU execution provider in int8: Q x K' and the
+// probabilities x V run as int8 gemms on Q, K and V quantized per head, and the softmax uses a lookup table of
+// exponentials and yields 8 bit probabilities. The results differ from the float attention core, mostly for the
+// smallest probabilities. Only applies to nodes without past state and with a mask of rank 2 or less.
+// "0": disabled. "1": enabled.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigCpuQAttentionInt8Core = "session.cpu.qattention_int8_core";
+
+// Compute the float MatMul and Gemm nodes of the CPU execution provider whose constant B has 2:4 structured sparsity,
+// i.e. at most two nonzero values in every group of 4 consecutive rows of each column, with B compressed to its
+// nonzero values. The check runs when B is pre-packed at session initialization, other nodes are unaffected.
+// "0": disabled. "1": enabled.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigCpuSparse24Gemm = "session.cpu.enable_sparse24_gemm";
+
+// Store the trees of the TreeEnsembleRegressor and TreeEnsembleClassifier nodes of the CPU execution provider
+// compactly: the thresholds of each feature are replaced by 16 bit codes, their ranks among the distinct thresholds of
+// the feature, and the leaf weights are stored in fp16. Each row is binned once into the codes of its features, so
+// the trees compare integers and take about a third of the memory. The codes keep the comparisons exact, only the
+// fp16 leaf weights may change the results. Only applies to ensembles whose nodes all use the same comparison among
+// BRANCH_LEQ, BRANCH_LT, BRANCH_GTE and BRANCH_GT, with less than 65535 features.
+// "0": disabled. "1": enabled. "exact": enabled, but the leaf weights of a node stay in full precision unless fp16
+// represents them all exactly, so the results are the same as with "0".
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigCpuTreeEnsembleQuantization =
+    "session.cpu.tree_ensemble_quantization";
+
+// The maximum total size in bytes of the prompt past state cached by each GreedySearch node of a GPT model on the
+// CPU execution provider. A call whose prompt starts with the tokens of an earlier prompt, e.g. a shared
+// system prompt, reuses the cached past state of those tokens and only computes the rest of the prompt.
+// The least recently used prompts are evicted once the limit is exceeded. Only applies to calls without padding in the
+// attention mask, and to subgraphs that don't share the past and present buffers or use an init decoder.
+// "0" disables the cache. The default is "0".
+static const char* const kOrtSessionOptionsConfigGenerationPrefixCacheMaxBytes =
+    "session.generation.prefix_cache_max_bytes";
+
+// Set to "1" to store the float past state cached by kOrtSessionOptionsConfigGenerationPrefixCacheMaxBytes as int8,
+// with a scale per block of 32 tokens of each head. The cache then holds about 4 times as many prompts, and the
+// reused past state has the quantization error. The default is "0".
+static const char* const kOrtSessionOptionsConfigGenerationPrefixCacheInt8 = "session.generation.prefix_cache_int8";
+
+// Collect statistics of the float tensors computed by the session to calibrate the quantization of the model,
+// without adding the tensors to the graph outputs. The statistics of the graph inputs and of the outputs of all nodes
+// in CPU memory accumulate over all runs, and are saved to kOrtSessionOptionsConfigCalibrationOutputFile when the
+// session is destroyed. Not available in minimal builds.
+// "": disabled. "minmax": the minimum and maximum of each tensor. "histogram": also a histogram of each tensor over a
+// range symmetric around 0, for the entropy, percentile and distribution calibration methods.
+// The default is "".
+static const char* const kOrtSessionOptionsConfigCalibrationMethod = "session.calibration.method";
+
+// The initial number of bins of the histograms collected by kOrtSessionOptionsConfigCalibrationMethod "histogram".
+// The default is "2048".
+static const char* const kOrtSessionOptionsConfigCalibrationNumBins = "session.calibration.num_bins";
+
+// Path of the JSON file the statistics collected by kOrtSessionOptionsConfigCalibrationMethod are saved to when the
+// session is destroyed. The default is "", which doesn't save them.
+static const char* const kOrtSessionOptionsConfigCalibrationOutputFile = "session.calibration.output_file";
+
+// The number of sets of device streams, e.g. CUDA streams with their cuBLAS and cuDNN handles, created when the session
+// is initialized. Each concurrent Run() call uses a set of its own, and the sets are pooled and reused by later calls.
+// Creating the sets ahead lets up to this many concurrent Run() calls overlap on the device without creating streams
+// and handles in the first calls. Only applies to EPs creating a stream per Run(), e.g. not the CUDA EP with a user
+// compute stream or CUDA graphs. The default is "0", which creates the sets in the Run() calls needing them.
+static const char* const kOrtSessionOptionsConfigDeviceStreamPoolSize = "session.device_stream_pool_size";
+
+// Path of a JSON file holding a list of TunableOp tuning results, in the format returned by
+// InferenceSession::GetTuningResults, that is shared by the sessions of different models and processes.
+// When the session is initialized, the results in the file that match an EP of the session and pass its validators
+// (the ORT version, and for the CUDA and ROCm EPs the runtime version and the device model) are loaded, and TunableOp
+// is enabled for that EP. Results for other devices and versions are ignored, so one file can serve a fleet.
+// Unless kOrtSessionOptionsConfigTuningResultsFileReadOnly is "1", the results tuned by the session are merged into
+// the file when the session is destroyed. The file is replaced atomically, so readers never see a partial file.
+// Not available in minimal builds. The default is "", which uses no file.
+static const char* const kOrtSessionOptionsConfigTuningResultsFile = "session.tuning_results_file";
+
+// "1": only read kOrtSessionOptionsConfigTuningResultsFile, e.g. in production with a file filled offline.
+// "0": also merge the results tuned by the session into the file. The default is "0".
+static const char* const kOrtSessionOptionsConfigTuningResultsFileReadOnly = "session.tuning_results_file_read_only";
+
+// The number of ranks, each with its own device and process, that run a transformer model with tensor parallelism.
+// Each rank keeps 1/world_size of the weights of the MLP blocks, i.e. MatMul -> [Add] -> [activation] -> MatMul, and of
+// the Attention blocks, i.e. the Attention contrib op -> MatMul, and an AllReduce node sums the outputs of each block
+// over the ranks with NCCL. The ranks need to be the ranks of an MPI job, e.g. started with mpirun, and the session of
+// each rank uses its own CUDA device, e.g. the device_id of the CUDA EP set to the local rank.
+// Only applies to the nodes assigned to the CUDA EP, with graph optimization level ORT_ENABLE_EXTENDED or higher.
+// The default is "1", which disables tensor parallelism.
+static const char* const kOrtSessionOptionsTensorParallelWorldSize = "optimization.tensor_parallel_world_size";
+
+// The rank of the session among kOrtSessionOptionsTensorParallelWorldSize ranks, i.e. its MPI rank, in
+// [0, world_size). The default is "0".
+static const char* const kOrtSessionOptionsTensorParallelRank = "optimization.tensor_parallel_rank";
+
+// Set to "1" to copy the graph inputs that are not on the device of the nodes using them, e.g. CPU inputs of a model
+// running on the CUDA EP, on a separate stream of that device, one input after the other. The nodes using an input only
+// wait for the copy of that input, so the copies of the later inputs overlap with the nodes using the earlier ones.
+// Only applies to EPs creating a stream per Run(), and not with CUDA graphs. Copies from pageable CPU memory only
+// overlap with the device when they are staged in pinned memory, e.g. by the CUDA EP. The default is "0".
+static const char* const kOrtSessionOptionsConfigUseInputCopyStreams = "session.use_input_copy_streams";
+
+// Profile 1 in N executions of the graph, e.g. "100", instead of every execution, when profiling is enabled.
+// Setting this or kOrtSessionOptionsConfigProfilingSampleIntervalMs switches the profiler to the sampling mode: the
+// profiler aggregates the statistics of each event (count, mean, p50 and p99 durations, mean output size) in memory
+// instead of recording every event, so profiling can stay enabled in production. The session events, e.g. model_run,
+// are aggregated for every run. The profile file then holds a JSON object per flush of the summary, one per line.
+// The default is "0", which doesn't sample by count.
+static const char* const kOrtSessionOptionsConfigProfilingSampleRate = "session.profiling_sample_rate";
+
+// Profile an execution of the graph if none was profiled in the last N milliseconds, in the sampling mode.
+// The default is "0", which doesn't sample by time.
+static const char* const kOrtSessionOptionsConfigProfilingSampleIntervalMs = "session.profiling_sample_interval_ms";
+
+// Write the summary of the sampled events to the profile every N milliseconds, and reset the statistics.
+// The default is "0", which only writes the summary when profiling ends.
+static const char* const kOrtSessionOptionsConfigProfilingSummaryFlushIntervalMs =
+    "session.profiling_summary_flush_interval_ms";
+
+// Set to "1" to add a roofline analysis of the nodes to the profile. The peak compute throughput and memory bandwidth
+// of the CPU are measured when the session is initialized, and the operations of each node are estimated from the
+// shapes of its inputs and outputs. The "roofline" event written when profiling ends, or the summary when sampling,
+// lists per node and per op type the achieved GFLOP/s and GB/s, the operations per byte, whether the node is compute
+// or memory bound and the achieved fraction of the bounding peak. Only the nodes assigned to the CPU EP are analyzed.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigProfilingRoofline = "session.profiling_roofline";
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Microsoft Corporation. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include <string.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtSession_IOBinding.h"
+
+/*
+ * The inputs and outputs of an IOBinding are OnnxTensors, typically created over direct ByteBuffers so that ORT reads
+ * and writes the Java memory in place. The binding holds its own references to the bound values, so they can be reused
+ * across runs without being bound again.
+ */
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    createIOBinding
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_createIOBinding
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong sessionHandle) {
+    (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtIoBinding* binding = NULL;
+    checkOrtStatus(jniEnv, api, api->CreateIoBinding((OrtSession*) sessionHandle, &binding));
+    return (jlong) binding;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    bindInput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_bindInput
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv, api, api->BindInput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    bindOutput
+ * Signature: (JJLjava/lang/String;J)V
+ * Binds a preallocated tensor the output is written into.
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_bindOutput
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv, api, api->BindOutput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    bindOutputToAllocator
+ * Signature: (JJLjava/lang/String;J)V
+ * Binds an output of unknown shape, allocated by ORT on the device of the allocator during the run.
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_bindOutputToAllocator
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong allocatorHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    const OrtMemoryInfo* memoryInfo = NULL;
+    OrtErrorCode code = checkOrtStatus(jniEnv, api, api->AllocatorGetInfo((OrtAllocator*) allocatorHandle, &memoryInfo));
+    if (code != ORT_OK) {
+      return;
+    }
+    const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+    checkOrtStatus(jniEnv, api, api->BindOutputToDevice((OrtIoBinding*) nativeHandle, nameStr, memoryInfo));
+    (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    clearBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_clearBoundInputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ClearBoundInputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    clearBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_clearBoundOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ClearBoundOutputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    synchronizeInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_synchronizeInputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    checkOrtStatus(jniEnv, api, api->SynchronizeBoundInputs((OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    synchronizeOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_synchronizeOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    checkOrtStatus(jniEnv, api, api->SynchronizeBoundOutputs((OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    run
+ * Signature: (JJJJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_run
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong nativeHandle, jlong runOptionsHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    checkOrtStatus(jniEnv, api, api->RunWithBinding((OrtSession*) sessionHandle, (const OrtRunOptions*) runOptionsHandle,
+                                                    (const OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    getOutputs
+ * Signature: (JJJ)[Lai/onnxruntime/OnnxValue;
+ * Returns the outputs of the last run in the order they were bound. The tensors of the outputs bound to preallocated
+ * tensors share their memory, so their buffers are views of the bound memory rather than copies.
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_getOutputs
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+    OrtValue** outputValues = NULL;
+    size_t numOutputs = 0;
+    OrtErrorCode code = checkOrtStatus(jniEnv, api, api->GetBoundOutputValues((const OrtIoBinding*) nativeHandle, allocator,
+                                                                            &outputValues, &numOutputs));
+    if (code != ORT_OK) {
+      return NULL;
+    }
+
+    jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, "ai/onnxruntime/OnnxValue");
+    jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(numOutputs), onnxValueClass, NULL);
+
+    // The Java objects own the values they are created from, the values not converted are released here.
+    size_t converted = 0;
+    for (; converted < numOutputs; converted++) {
+      jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, outputValues[converted]);
+      if (onnxValue == NULL) {
+        outputArray = NULL;
+        break;  // exception thrown
+      }
+      (*jniEnv)->SetObjectArrayElement(jniEnv, outputArray, safecast_size_t_to_jsize(converted), onnxValue);
+    }
+    for (size_t i = converted; i < numOutputs; i++) {
+      api->ReleaseValue(outputValues[i]);
+    }
+
+    if (outputValues != NULL) {
+      checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, outputValues));
+    }
+    return outputArray;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession_IOBinding
+ * Method:    closeIOBinding
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_00024IOBinding_closeIOBinding
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+    (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    api->ReleaseIoBinding((OrtIoBinding*) nativeHandle);
+}
@@ -130,6 +130,70 @@ Napi::Value InferenceSessionWrap::GetOutputNames(const Napi::CallbackInfo &info)
   return scope.Escape(CreateNapiArrayFrom(env, outputNames_));
 }
 
+namespace {
+
+// runs a session on a thread of the libuv thread pool and settles a promise with the outputs.
+class RunWorker : public Napi::AsyncWorker {
+public:
+  RunWorker(Napi::Env env, Ort::Session &session, const Ort::RunOptions &defaultRunOptions)
+      : Napi::AsyncWorker(env, "onnxruntime-run"), deferred_(Napi::Promise::Deferred::New(env)), session_(session),
+        defaultRunOptions_(defaultRunOptions), runOptions_(nullptr) {}
+
+  Napi::Promise Promise() const { return deferred_.Promise(); }
+
+  // the session wrap, inputs and outputs have to outlive the run.
+  Napi::ObjectReference sessionRef;
+  Napi::ObjectReference feedRef;
+  Napi::ObjectReference fetchRef;
+
+  std::vector<const char *> inputNames;
+  std::vector<Ort::Value> inputValues;
+  std::vector<const char *> outputNames;
+  std::vector<Ort::Value> outputValues;
+  std::vector<bool> reuseOutput;
+
+  void SetRunOptions(Ort::RunOptions &&runOptions) { runOptions_ = std::move(runOptions); }
+
+protected:
+  void Execute() override {
+    try {
+      session_.Run(runOptions_ == nullptr ? defaultRunOptions_ : runOptions_,
+                   inputNames.empty() ? nullptr : &inputNames[0], inputValues.empty() ? nullptr : &inputValues[0],
+                   inputNames.size(), outputNames.empty() ? nullptr : &outputNames[0],
+                   outputValues.empty() ? nullptr : &outputValues[0], outputNames.size());
+    } catch (std::exception const &e) {
+      SetError(e.what());
+    }
+  }
+
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    try {
+      Napi::Object fetch = fetchRef.Value();
+      Napi::Object result = Napi::Object::New(env);
+      for (size_t i = 0; i < outputNames.size(); i++) {
+        // an output written into the tensor given for it is resolved with that tensor
+        result.Set(outputNames[i],
+                   reuseOutput[i] ? fetch.Get(outputNames[i]) : OrtValueToNapiValue(env, std::move(outputValues[i])));
+      }
+      deferred_.Resolve(result);
+    } catch (Napi::Error const &e) {
+      deferred_.Reject(e.Value());
+    }
+  }
+
+  void OnError(Napi::Error const &e) override { deferred_.Reject(e.Value()); }
+
+private:
+  Napi::Promise::Deferred deferred_;
+  Ort::Session &session_;
+  const Ort::RunOptions &defaultRunOptions_;
+  Ort::RunOptions runOptions_;
+};
+
+} // namespace
+
 Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
@@ -144,54 +208,45 @@ Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
   auto feed = info[0].As<Napi::Object>();
   auto fetch = info[1].As<Napi::Object>();
 
-  std::vector<const char *> inputNames_cstr;
-  std::vector<Ort::Value> inputValues;
-  std::vector<const char *> outputNames_cstr;
-  std::vector<Ort::Value> outputValues;
-  std::vector<bool> reuseOutput;
-  size_t inputIndex = 0;
-  size_t outputIndex = 0;
+  // deleted by node-addon-api once the promise is settled
+  auto worker = new RunWorker(env, *session_, *defaultRunOptions_);
 
   try {
     for (auto &name : inputNames_) {
       if (feed.Has(name)) {
-        inputIndex++;
-        inputNames_cstr.push_back(name.c_str());
+        worker->inputNames.push_back(name.c_str());
         auto value = feed.Get(name);
-        inputValues.push_back(NapiValueToOrtValue(env, value));
+        worker->inputValues.push_back(NapiValueToOrtValue(env, value));
       }
     }
     for (auto &name : outputNames_) {
       if (fetch.Has(name)) {
-        outputIndex++;
-        outputNames_cstr.push_back(name.c_str());
+        worker->outputNames.push_back(name.c_str());
         auto value = fetch.Get(name);
-        reuseOutput.push_back(!value.IsNull());
-        outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value));
+        worker->reuseOutput.push_back(!value.IsNull());
+        worker->outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value));
       }
     }
 
-    Ort::RunOptions runOptions{nullptr};
     if (info.Length() > 2) {
-      runOptions = Ort::RunOptions{};
+      Ort::RunOptions runOptions;
       ParseRunOptions(info[2].As<Napi::Object>(), runOptions);
+      worker->SetRunOptions(std::move(runOptions));
     }
-
-    session_->Run(runOptions == nullptr ? *defaultRunOptions_.get() : runOptions,
-                  inputIndex == 0 ? nullptr : &inputNames_cstr[0], inputIndex == 0 ? nullptr : &inputValues[0],
-                  inputIndex, outputIndex == 0 ? nullptr : &outputNames_cstr[0],
-                  outputIndex == 0 ? nullptr : &outputValues[0], outputIndex);
-
-    Napi::Object result = Napi::Object::New(env);
-
-    for (size_t i = 0; i < outputIndex; i++) {
-      result.Set(outputNames_[i], OrtValueToNapiValue(env, outputValues[i]));
-    }
-
-    return scope.Escape(result);
   } catch (Napi::Error const &e) {
+    delete worker;
     throw e;
   } catch (std::exception const &e) {
+    delete worker;
     ORT_NAPI_THROW_ERROR(env, e.what());
   }
+
+  // the tensors created from the inputs and outputs point at the memory of their typed arrays
+  worker->sessionRef = Napi::Persistent(info.This().As<Napi::Object>());
+  worker->feedRef = Napi::Persistent(feed);
+  worker->fetchRef = Napi::Persistent(fetch);
+
+  auto promise = worker->Promise();
+  worker->Queue();
+  return scope.Escape(promise);
 }
@@ -41,11 +41,15 @@ private:
   Napi::Value GetOutputNames(const Napi::CallbackInfo &info);
 
   /**
-   * [sync] run the model.
+   * [async] run the model on a thread of the libuv thread pool, so that the event loop is not blocked and runs of
+   * the session can overlap.
    * @param arg0 input object: all keys must present, value is object
    * @param arg1 output object: at least one key must present, value can be null.
-   * @returns an object that every output specified will present and value must be object
-   * @throw error if status code != 0
+   * @param arg2 optional run options object.
+   * @returns a promise resolved with an object that every output specified will present and value must be object.
+   *          outputs that were given a tensor are written into it and resolved with the same object. the data of the
+   *          other outputs is backed by the memory of ONNX Runtime rather than copied.
+   * @throw error if the arguments are invalid. the promise is rejected if status code != 0
    */
   Napi::Value Run(const Napi::CallbackInfo &info);
 
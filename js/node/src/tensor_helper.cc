@@ -191,7 +191,7 @@ Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value) {
   }
 }
 
-Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
+Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &&value) {
   Napi::EscapableHandleScope scope(env);
   auto returnValue = Napi::Object::New(env);
 
@@ -246,10 +246,30 @@ Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
     returnValue.Set("data", Napi::Value(env, stringArray));
   } else {
     // number data
-    // TODO: optimize memory
-    auto arrayBuffer = Napi::ArrayBuffer::New(env, size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
-    if (size > 0) {
-      memcpy(arrayBuffer.Data(), value.GetTensorRawData(), size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+    const size_t byteLength = size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
+    napi_value arrayBuffer = nullptr;
+    if (byteLength > 0) {
+      // hand the tensor over to the ArrayBuffer, which releases it when collected
+      auto owner = std::make_unique<Ort::Value>(std::move(value));
+      void *data = owner->GetTensorMutableRawData();
+      napi_status status = napi_create_external_arraybuffer(
+          env, data, byteLength,
+          [](napi_env /*env*/, void * /*data*/, void *hint) { delete static_cast<Ort::Value *>(hint); }, owner.get(),
+          &arrayBuffer);
+      if (status == napi_ok) {
+        owner.release();
+      } else {
+        // e.g. Electron doesn't allow external buffers
+        arrayBuffer = nullptr;
+        value = std::move(*owner);
+      }
+    }
+    if (arrayBuffer == nullptr) {
+      auto copy = Napi::ArrayBuffer::New(env, byteLength);
+      if (byteLength > 0) {
+        memcpy(copy.Data(), value.GetTensorRawData(), byteLength);
+      }
+      arrayBuffer = copy;
     }
     napi_value typedArrayData;
     napi_status status =
@@ -11,5 +11,7 @@
 // convert a Javascript OnnxValue object to an OrtValue object
 Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value);
 
-// convert an OrtValue object to a Javascript OnnxValue object
-Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value);
+// convert an OrtValue object to a Javascript OnnxValue object. the value is moved into the returned object: the data
+// of a numeric tensor is exposed as an external ArrayBuffer that keeps the OrtValue alive, or copied if the runtime
+// does not allow external buffers.
+Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &&value);
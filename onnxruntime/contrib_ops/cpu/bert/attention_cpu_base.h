@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -36,7 +37,8 @@ class AttentionCPUBase : public AttentionBase {
                         int v_head_size,                       // head size of V (H_v)
                         int v_hidden_size,                     // hidden size of V (D_v)
                         const Tensor* relative_position_bias,  // bias addition in QK. Its size is BxNxSxT
-                        OpKernelContext* context) const {
+                        OpKernelContext* context,              // op kernel context
+                        int kv_batch_group_size = 1) const {   // consecutive batches sharing K and V
     AllocatorPtr allocator;
     ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
@@ -53,21 +55,8 @@ class AttentionCPUBase : public AttentionBase {
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
 
-    // Compute the attention score.
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
-
     bool causal = (is_unidirectional_ && sequence_length > 1);
 
-    void* mask_data = nullptr;
-    if (mask_index != nullptr || causal) {
-      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
-      mask_data = allocator->Alloc(mask_data_bytes);
-      memset(mask_data, 0, mask_data_bytes);
-    }
-    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
-
     const int32_t* mask_index_data = mask_index != nullptr ? mask_index->Data<int32_t>() : nullptr;
     gsl::span<const int64_t> mask_index_dims = mask_index != nullptr
                                                    ? mask_index->Shape().GetDims()
@@ -84,31 +73,257 @@ class AttentionCPUBase : public AttentionBase {
       relative_position_bias_data = relative_position_bias->Data<T>();
     }
 
+    // Long sequences are computed block by block, without materializing the attention probs.
+    // Masks with a query dimension are only supported by the attention probs.
+    if (static_cast<int64_t>(sequence_length) * total_sequence_length >= kTiledAttentionMinScores &&
+        mask_index_dims.size() <= 2) {
+      void* key_mask = nullptr;
+      if (mask_index != nullptr) {
+        // The mask only depends on the key, so it's prepared as BxT additive mask: PrepareMask yields that for a
+        // single query at the end of the total sequence.
+        size_t key_mask_bytes = SafeInt<size_t>(batch_size) * total_sequence_length * sizeof(T);
+        key_mask = allocator->Alloc(key_mask_bytes);
+        memset(key_mask, 0, key_mask_bytes);
+        PrepareMask(mask_index_data, mask_index_dims, static_cast<T*>(key_mask),
+                    false, batch_size, 1, total_sequence_length - 1, mask_filter_value_);
+      }
+      BufferUniquePtr key_mask_buffer(key_mask, BufferDeleter(allocator));
+
+      ComputeTiledAttention<T>(output->MutableData<T>(), Q, K, V, static_cast<const T*>(key_mask), causal,
+                               batch_size, sequence_length, kv_sequence_length, past_sequence_length,
+                               qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size, v_hidden_size,
+                               past_data, past_key_data, past_value_data,
+                               present_data, present_key_data, present_value_data,
+                               relative_position_bias_data, tp, kv_batch_group_size);
+      return Status::OK();
+    }
+
+    // Compute the attention score.
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+
+    void* mask_data = nullptr;
+    if (mask_index != nullptr || causal) {
+      size_t mask_data_bytes = SafeInt<size_t>(batch_size) * sequence_length * total_sequence_length * sizeof(T);
+      mask_data = allocator->Alloc(mask_data_bytes);
+      memset(mask_data, 0, mask_data_bytes);
+    }
+    BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+
     ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, K,
                              mask_index_data, mask_index_dims, static_cast<T*>(mask_data), causal,
                              batch_size, sequence_length, kv_sequence_length, past_sequence_length,
                              qk_head_size == 0 ? v_head_size : qk_head_size, past_data, past_key_data,
-                             present_data, present_key_data, tp, relative_position_bias_data);
+                             present_data, present_key_data, tp, relative_position_bias_data, kv_batch_group_size);
 
-    // Compute the attentionScore * Value: out_tmp(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-    auto out_tmp_data =
-        allocator->Alloc(SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * v_head_size * sizeof(T));
-    BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(std::move(allocator)));
-
-    ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(out_tmp_data),
-                            static_cast<T*>(attention_probs), V,
+    // Compute the attentionScore * Value: out(B, S, N, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
+    ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(attention_probs), V,
                             batch_size, sequence_length, kv_sequence_length, past_sequence_length,
                             v_head_size, v_hidden_size, past_data, past_value_data,
-                            present_data, present_value_data, tp);
+                            present_data, present_value_data, tp, kv_batch_group_size);
 
     return Status::OK();
   }
 
  private:
+  // The minimum number of attention scores per head (S x T) to compute the attention block by block.
+  static constexpr int64_t kTiledAttentionMinScores = 256 * 1024;
+  // The number of queries and keys of a block. A block of keys and values stays in L2 for common head sizes.
+  static constexpr int kTiledAttentionQueryBlock = 64;
+  static constexpr int kTiledAttentionKeyBlock = 256;
+
+  // Returns the index of the (batch, head) of K and V used by the (batch, head) `i` of Q, when each group of
+  // `kv_batch_group_size` consecutive batches of Q shares the K and V of one batch, like the beams of a batch
+  // attending the encoder output in cross attention.
+  std::ptrdiff_t KVHeadIndex(std::ptrdiff_t i, int kv_batch_group_size) const {
+    return kv_batch_group_size == 1
+               ? i
+               : (i / num_heads_) / kv_batch_group_size * num_heads_ + i % num_heads_;
+  }
+
+  // Computes out(B, S, N, H_v) = Softmax(1/sqrt(H) x Q x K' + mask + bias) x V like ComputeAttentionProbs and
+  // ComputeVxAttentionScore, without the attention probs of size BxNxSxT.
+  // Each block of queries goes over the blocks of keys and values with an online softmax: the scores of a block
+  // are exponentiated relative to the running maximum of each query, and the sum of the exponentials and the output
+  // computed so far are rescaled when the maximum grows. Blocks of keys after the last query of a causal block are
+  // skipped.
+  template <typename T>
+  void ComputeTiledAttention(T* output,                                // buffer for the result with size BxSxNxH_v
+                             const T* Q,                               // Q data. Its size is BxNxSxH
+                             const T* K,                               // K data. Its size is BxNxLxH
+                             const T* V,                               // V value with size BxNxLxH_v
+                             const T* key_mask,                        // additive mask with size BxT, or nullptr
+                             bool causal,                              // has causal (unidirectional) mask
+                             int batch_size,                           // batch size
+                             int sequence_length,                      // sequence length of Q (S)
+                             int kv_sequence_length,                   // sequence length of K or V (L)
+                             int past_sequence_length,                 // sequence length of past state (P)
+                             int head_size,                            // head size of Q or K (H)
+                             int v_head_size,                          // head size of V (H_v)
+                             int v_hidden_size,                        // hidden size of V (D_v)
+                             const T* past,                            // past state
+                             const T* past_key,                        // past key only (if not using past state)
+                             const T* past_value,                      // past value only (if not using past state)
+                             T* present,                               // present state
+                             T* present_key,                           // present key only (if not using present state)
+                             T* present_value,                         // present value (if not using present state)
+                             const T* relative_position_bias_data,     // bias addition matrix with shape BxNxSxT
+                             ThreadPool* tp,
+                             int kv_batch_group_size) const {          // consecutive batches sharing K and V
+    const int total_sequence_length = past_sequence_length + kv_sequence_length;  // T = P + L
+    const int loop_len = batch_size * num_heads_;
+
+    // Concatenate the past and present state of each head first, as all blocks of queries of a head read them.
+    // The V part of the past and present state follows the K part of all heads.
+    const size_t k_past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;
+    const size_t k_present_chunk_length = static_cast<size_t>(total_sequence_length) * head_size;
+    const size_t v_past_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;
+    const size_t v_present_chunk_length = static_cast<size_t>(total_sequence_length) * v_head_size;
+    const T* past_v = past != nullptr ? past + SafeInt<ptrdiff_t>(loop_len) * k_past_chunk_length : nullptr;
+    T* present_v = present != nullptr ? present + SafeInt<ptrdiff_t>(loop_len) * k_present_chunk_length : nullptr;
+
+    std::vector<const T*> keys(loop_len);
+    std::vector<const T*> values(loop_len);
+    ThreadPool::TryParallelFor(tp, loop_len, static_cast<double>(k_present_chunk_length + v_present_chunk_length),
+                               [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                                 for (std::ptrdiff_t i = begin; i != end; ++i) {
+                                   const std::ptrdiff_t kv_i = KVHeadIndex(i, kv_batch_group_size);
+                                   const T* k = K + (k_present_chunk_length - k_past_chunk_length) * kv_i;
+                                   const T* v = V + (v_present_chunk_length - v_past_chunk_length) * kv_i;
+                                   if (nullptr != present) {
+                                     k = ConcatStateChunk(past, k, present, k_past_chunk_length,
+                                                          k_present_chunk_length, i);
+                                     v = ConcatStateChunk(past_v, v, present_v, v_past_chunk_length,
+                                                          v_present_chunk_length, i);
+                                   } else {
+                                     if (nullptr != present_key) {
+                                       k = ConcatStateChunk(past_key, k, present_key, k_past_chunk_length,
+                                                            k_present_chunk_length, i);
+                                     }
+                                     if (nullptr != present_value) {
+                                       v = ConcatStateChunk(past_value, v, present_value, v_past_chunk_length,
+                                                            v_present_chunk_length, i);
+                                     }
+                                   }
+                                   keys[i] = k;
+                                   values[i] = v;
+                                 }
+                               });
+
+    const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+    const int num_query_blocks = (sequence_length + kTiledAttentionQueryBlock - 1) / kTiledAttentionQueryBlock;
+    const double cost = static_cast<double>(kTiledAttentionQueryBlock) * total_sequence_length *
+                        (head_size + v_head_size) * 2;
+
+    ThreadPool::TryParallelFor(tp, static_cast<std::ptrdiff_t>(loop_len) * num_query_blocks, cost,
+                               [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      std::vector<float> scores(static_cast<size_t>(kTiledAttentionQueryBlock) * kTiledAttentionKeyBlock);
+      std::vector<float> out(static_cast<size_t>(kTiledAttentionQueryBlock) * v_head_size);
+      std::vector<float> row_max(kTiledAttentionQueryBlock);
+      std::vector<float> row_sum(kTiledAttentionQueryBlock);
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const int head = static_cast<int>(i / num_query_blocks);  // index of (batch, head)
+        const int batch_index = head / num_heads_;
+        const int head_index = head % num_heads_;
+        const int query_start = static_cast<int>(i % num_query_blocks) * kTiledAttentionQueryBlock;
+        const int query_rows = std::min(kTiledAttentionQueryBlock, sequence_length - query_start);
+        const T* q = Q + (SafeInt<ptrdiff_t>(head) * sequence_length + query_start) * head_size;
+
+        // Keys after the last query of the block are masked by the causal mask.
+        const int key_end = causal ? std::min(total_sequence_length, past_sequence_length + query_start + query_rows)
+                                   : total_sequence_length;
+
+        std::fill_n(row_max.begin(), query_rows, -std::numeric_limits<float>::infinity());
+        std::fill_n(row_sum.begin(), query_rows, 0.0f);
+        std::fill_n(out.begin(), static_cast<size_t>(query_rows) * v_head_size, 0.0f);
+
+        for (int key_start = 0; key_start < key_end; key_start += kTiledAttentionKeyBlock) {
+          const int key_cols = std::min(kTiledAttentionKeyBlock, key_end - key_start);
+
+          // scores = 1/sqrt(H) x Q x K' of the block
+          MlasGemm(CblasNoTrans, CblasTrans, query_rows, key_cols, head_size, alpha,
+                   q, head_size, keys[head] + static_cast<size_t>(key_start) * head_size, head_size,
+                   0.0f, scores.data(), key_cols, nullptr);
+
+          for (int r = 0; r < query_rows; r++) {
+            float* x = scores.data() + static_cast<size_t>(r) * key_cols;
+            if (key_mask != nullptr) {
+              const T* mask = key_mask + static_cast<size_t>(batch_index) * total_sequence_length + key_start;
+              for (int j = 0; j < key_cols; j++) {
+                x[j] += mask[j];
+              }
+            }
+            if (relative_position_bias_data != nullptr) {
+              const T* bias = relative_position_bias_data +
+                              (SafeInt<ptrdiff_t>(head) * sequence_length + query_start + r) * total_sequence_length +
+                              key_start;
+              for (int j = 0; j < key_cols; j++) {
+                x[j] += bias[j];
+              }
+            }
+
+            int cols = key_cols;
+            if (causal) {
+              cols = std::clamp(past_sequence_length + query_start + r + 1 - key_start, 0, key_cols);
+              std::fill(x + cols, x + key_cols, 0.0f);
+            }
+            if (cols == 0) {
+              continue;
+            }
+
+            float block_max = x[0];
+            for (int j = 1; j < cols; j++) {
+              block_max = std::max(block_max, x[j]);
+            }
+            const float new_max = std::max(row_max[r], block_max);
+            for (int j = 0; j < cols; j++) {
+              x[j] -= new_max;
+            }
+            MlasComputeExp(x, x, static_cast<size_t>(cols));
+            float block_sum = 0.0f;
+            for (int j = 0; j < cols; j++) {
+              block_sum += x[j];
+            }
+
+            // Rescale what was computed relative to the previous maximum.
+            const float correction = std::exp(row_max[r] - new_max);
+            if (correction != 1.0f) {
+              float* o = out.data() + static_cast<size_t>(r) * v_head_size;
+              for (int j = 0; j < v_head_size; j++) {
+                o[j] *= correction;
+              }
+            }
+            row_sum[r] = row_sum[r] * correction + block_sum;
+            row_max[r] = new_max;
+          }
+
+          // out += exp(scores - max) x V of the block
+          MlasGemm(CblasNoTrans, CblasNoTrans, query_rows, v_head_size, key_cols, 1.0f,
+                   scores.data(), key_cols, values[head] + static_cast<size_t>(key_start) * v_head_size, v_head_size,
+                   1.0f, out.data(), v_head_size, nullptr);
+        }
+
+        // The result of each query is written to its columns of out(B, S, N, H_v).
+        for (int r = 0; r < query_rows; r++) {
+          T* dest = output + (SafeInt<ptrdiff_t>(batch_index) * sequence_length + query_start + r) * v_hidden_size +
+                    static_cast<ptrdiff_t>(head_index) * v_head_size;
+          const float* o = out.data() + static_cast<size_t>(r) * v_head_size;
+          const float inverse_sum = 1.0f / row_sum[r];
+          for (int j = 0; j < v_head_size; j++) {
+            dest[j] = o[j] * inverse_sum;
+          }
+        }
+      }
+    });
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
+  // The per head products are small, so they run as one batch of MLAS GEMMs that schedules whole heads per thread.
   template <typename T>
   void ComputeAttentionProbs(T* attention_probs,                        // output buffer with size BxNxSxT
                              const T* Q,                                // Q data. Its size is BxNxSxH
@@ -127,7 +342,8 @@ class AttentionCPUBase : public AttentionBase {
                              T* present,                                // present state
                              T* present_key,                            // present key only (if not using present state)
                              ThreadPool* tp,                            // thread pool
-                             const T* relative_position_bias_data       // bias addition matrix with shape BxNxSxT
+                             const T* relative_position_bias_data,      // bias addition matrix with shape BxNxSxT
+                             int kv_batch_group_size                    // consecutive batches sharing K
   ) const {
     const int total_sequence_length = past_sequence_length + kv_sequence_length;               // T = P + L
     const size_t past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;    // P x H
@@ -140,24 +356,17 @@ class AttentionCPUBase : public AttentionBase {
       if (mask_data != nullptr) {
         PrepareMask(mask_index, mask_index_dims, mask_data,
                     causal, batch_size, sequence_length, past_sequence_length, mask_filter_value_);
-      } else {  // no any mask
-        const int memset_loop_len = batch_size * num_heads_;
-        const double memset_cost = static_cast<double>(sequence_length) * total_sequence_length;
-
-        ThreadPool::TryParallelFor(tp, memset_loop_len, memset_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
-          for (std::ptrdiff_t i = begin; i != end; ++i) {
-            const int output_offset = static_cast<int>(i) * sequence_length * total_sequence_length;
-            T* output = attention_probs + output_offset;
-            memset(output, 0, static_cast<size_t>(sequence_length) * total_sequence_length * sizeof(T));
-          }
-        });
       }
 
       const int loop_len = batch_size * num_heads_;
       const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
 
-      // The cost of Gemm
-      const double cost = static_cast<double>(head_size) * sequence_length * total_sequence_length;
+      std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(loop_len);
+      std::vector<MLAS_SGEMM_EPILOGUE> gemm_epilogues(loop_len);
+
+      // The cost of the mask copy and the concatenation of the past state
+      const double cost = static_cast<double>(present_chunk_length) +
+                          static_cast<double>(sequence_length) * total_sequence_length;
 
       ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
         for (std::ptrdiff_t i = begin; i != end; ++i) {
@@ -167,14 +376,23 @@ class AttentionCPUBase : public AttentionBase {
           const int mask_offset = batch_index * sequence_length * total_sequence_length;
           T* output = attention_probs + output_offset;
 
-          // Broadcast mask data: (Bx)SxT -> (BxNx)SxT
+          // The GEMM adds one of the mask and the relative position bias to its result. The mask is broadcast
+          // into the output first when both are given: (Bx)SxT -> (BxNx)SxT
+          const T* addend = relative_position_bias_data != nullptr ? relative_position_bias_data + output_offset
+                                                                   : nullptr;
+          float beta = 0.0f;
           if (mask_data != nullptr) {
-            memcpy(output,
-                   mask_data + mask_offset,
-                   static_cast<size_t>(sequence_length) * total_sequence_length * sizeof(T));
+            if (addend != nullptr) {
+              memcpy(output,
+                     mask_data + mask_offset,
+                     static_cast<size_t>(sequence_length) * total_sequence_length * sizeof(T));
+              beta = 1.0f;
+            } else {
+              addend = mask_data + mask_offset;
+            }
           }
 
-          const T* k = K + kv_input_chunk_length * i;
+          const T* k = K + kv_input_chunk_length * KVHeadIndex(i, kv_batch_group_size);
           if (nullptr != present) {
             // Concatenate past_K and K : (BxNx)PxH, (BxNx)LxH -> (BxNx)TxH
             k = ConcatStateChunk(past, k, present, past_chunk_length, present_chunk_length, i);
@@ -187,17 +405,27 @@ class AttentionCPUBase : public AttentionBase {
           // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
           // B: K'               (B x N x) T x H          (B x N x) H x T        H x T
           // C: attention_probs  (B x N x) S x T          (B x N x) S x T        S x T
-          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_sequence_length, head_size, alpha,
-                                    Q + q_input_chunk_length * i, k, 1.0,
-                                    output, nullptr);
-
-          if (relative_position_bias_data != nullptr) {
-            for (int j = 0; j < sequence_length * total_sequence_length; j++) {
-              output[j] += relative_position_bias_data[output_offset + j];
-            }
+          MLAS_SGEMM_DATA_PARAMS& params = gemm_params[i];
+          params.A = Q + q_input_chunk_length * i;
+          params.lda = static_cast<size_t>(head_size);
+          params.B = k;
+          params.ldb = static_cast<size_t>(head_size);
+          params.C = output;
+          params.ldc = static_cast<size_t>(total_sequence_length);
+          params.alpha = alpha;
+          params.beta = beta;
+
+          if (addend != nullptr) {
+            MLAS_SGEMM_EPILOGUE& epilogue = gemm_epilogues[i];
+            epilogue.Addend = addend;
+            epilogue.ldaddend = static_cast<size_t>(total_sequence_length);
+            params.Epilogue = &epilogue;
           }
         }
       });
+
+      MlasGemmBatch(CblasNoTrans, CblasTrans, sequence_length, total_sequence_length, head_size,
+                    gemm_params.data(), gemm_params.size(), tp);
     }
 
     // attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -210,7 +438,6 @@ class AttentionCPUBase : public AttentionBase {
 
   template <typename T>
   void ComputeVxAttentionScore(T* output,                 // buffer for the result with size BxSxNxH_v
-                               T* tmp_buffer,             // buffer for temp use with size is BxNxSxH_v
                                const T* attention_probs,  // Attention probs with size BxNxSxT
                                const T* V,                // V value with size BxNxLxH_v
                                int batch_size,            // batch size
@@ -223,10 +450,10 @@ class AttentionCPUBase : public AttentionBase {
                                const T* past_value,       // past value only (if not using past state)
                                T* present,                // present state
                                T* present_value,          // present value only (if not using present state)
-                               ThreadPool* tp) const {
+                               ThreadPool* tp,
+                               int kv_batch_group_size) const {  // consecutive batches sharing V
     const int total_sequence_length = past_sequence_length + kv_sequence_length;                   // T = P + L
     const ptrdiff_t past_chunk_length = SafeInt<ptrdiff_t>(past_sequence_length) * v_head_size;    // P x H_v
-    const ptrdiff_t q_input_chunk_length = SafeInt<ptrdiff_t>(sequence_length) * v_head_size;      // S x H_v
     const ptrdiff_t kv_input_chunk_length = SafeInt<ptrdiff_t>(kv_sequence_length) * v_head_size;  // L x H_v
     const ptrdiff_t present_chunk_length = past_chunk_length + kv_input_chunk_length;              // T x H_v
 
@@ -238,12 +465,16 @@ class AttentionCPUBase : public AttentionBase {
       present += SafeInt<ptrdiff_t>(batch_size) * num_heads_ * total_sequence_length * v_head_size;
     }
 
-    const double cost =
-        static_cast<double>(sequence_length) * static_cast<double>(v_head_size) * static_cast<double>(sequence_length);
+    const int loop_len = batch_size * num_heads_;
 
-    ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(batch_size) * num_heads_, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(loop_len);
+
+    // The cost of the concatenation of the past state
+    const double cost = static_cast<double>(present_chunk_length);
+
+    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
-        const T* v = V + kv_input_chunk_length * i;
+        const T* v = V + kv_input_chunk_length * KVHeadIndex(i, kv_batch_group_size);
         if (nullptr != present) {
           // Concatenate past_V and V: (BxNx)PxH_v, (BxNx)LxH_v -> (BxNx)TxH_v
           v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
@@ -251,26 +482,25 @@ class AttentionCPUBase : public AttentionBase {
           v = ConcatStateChunk(past_value, v, present_value, past_chunk_length, present_chunk_length, i);
         }
 
-        T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + q_input_chunk_length * i;
-        ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
-        math::MatMul<T>(sequence_length, v_head_size, total_sequence_length,
-                        attention_probs + attention_probs_offset,
-                        v, current_tmp_data, nullptr);
-
-        // Transpose: out(B, S, N, H_v) -> out_tmp(B, N, S, H_v)
+        // The result of each head is written to its columns of out(B, S, N, H_v), which transposes
+        // out_tmp(B, N, S, H_v) without a copy.
         const int batch_index = static_cast<int>(i / num_heads_);
         const int head_index = static_cast<int>(i % num_heads_);
-        T* src = current_tmp_data;
         ptrdiff_t dest_offset = (SafeInt<ptrdiff_t>(batch_index) * sequence_length * num_heads_ + head_index) * v_head_size;
-        T* dest = output + dest_offset;
-        const auto bytes_to_copy = SafeInt<size_t>(v_head_size) * sizeof(T);
-        for (int j = 0; j < sequence_length; j++) {
-          memcpy(dest, src, bytes_to_copy);
-          src += v_head_size;
-          dest += v_hidden_size;
-        }
+        ptrdiff_t attention_probs_offset = SafeInt<ptrdiff_t>(sequence_length) * total_sequence_length * i;
+
+        MLAS_SGEMM_DATA_PARAMS& params = gemm_params[i];
+        params.A = attention_probs + attention_probs_offset;
+        params.lda = static_cast<size_t>(total_sequence_length);
+        params.B = v;
+        params.ldb = static_cast<size_t>(v_head_size);
+        params.C = output + dest_offset;
+        params.ldc = static_cast<size_t>(v_hidden_size);
       }
     });
+
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, sequence_length, v_head_size, total_sequence_length,
+                  gemm_params.data(), gemm_params.size(), tp);
   }
 };
 
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel.h"
@@ -69,36 +72,53 @@ class BifurcationDetector : public OpKernel {
     // Return the index of the start of the n-gram in source tokens.
     // No matching if found if src tokens contain multiple or zero matching n-grams.
     // Return -1.
+    // The source positions where the last (n+1)-gram ends are the positions where the last n-gram ends and the
+    // token before that n-gram also matches, so the source tokens are scanned once for the shortest n-gram and
+    // the matches of the longer n-grams are found by filtering the previous ones.
     int64_t tokens_len = out_tokens->Shape().GetDims()[0];
     int64_t min_gram = min_ngram_size_;
     int64_t max_gram = max_ngram_size_;
     int64_t suffix_idx = -1;
     const auto* tokens_data = static_cast<const int64_t*>(out_tokens->DataRaw());
+    std::vector<int64_t> match_ends;  // in increasing order
     for (int64_t i = min_gram; i < max_gram + 1; ++i) {
       if (i > tokens_len) {
         break;
       }
-      auto it = std::search(
-          src_tokens_data,
-          src_tokens_data + src_tokens_len,
-          tokens_data + tokens_len - i,
-          tokens_data + tokens_len);
-      if (it == (src_tokens_data + src_tokens_len)) {
-        break;
-      } else {
-        suffix_idx = it - src_tokens_data + i;
-        if (suffix_idx >= src_tokens_len) {
-          break;
-        }
-        auto it_2 = std::search(
-            src_tokens_data + suffix_idx - i + 1,
-            src_tokens_data + src_tokens_len,
-            tokens_data + tokens_len - i,
-            tokens_data + tokens_len);
-        if (it_2 != (src_tokens_data + src_tokens_len)) {
-          suffix_idx = -1;
-          continue;
+      if (i == min_gram) {
+        const int64_t* search_from = src_tokens_data;
+        while (true) {
+          auto it = std::search(
+              search_from,
+              src_tokens_data + src_tokens_len,
+              tokens_data + tokens_len - i,
+              tokens_data + tokens_len);
+          if (it == (src_tokens_data + src_tokens_len)) {
+            break;
+          }
+          match_ends.push_back(it - src_tokens_data + i);
+          search_from = it + 1;
         }
+      } else {
+        const int64_t token = tokens_data[tokens_len - i];
+        match_ends.erase(std::remove_if(match_ends.begin(), match_ends.end(),
+                                        [&](int64_t end) {
+                                          return end - i < 0 || src_tokens_data[end - i] != token;
+                                        }),
+                         match_ends.end());
+      }
+
+      if (match_ends.empty()) {
+        break;
+      }
+      suffix_idx = match_ends.front();
+      if (suffix_idx >= src_tokens_len) {
+        break;
+      }
+      if (match_ends.size() > 1) {
+        // not unique
+        suffix_idx = -1;
+        continue;
       }
     }
 
@@ -286,7 +286,8 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
                                                                       scale,
                                                                       mask_filter_value_,
                                                                       past_present_share_buffer,
-                                                                      false));
+                                                                      false,
+                                                                      true /* broadcast_kv_batch */));
 
   const int batch_size = parameters.batch_size;
   const int q_sequence_length = parameters.sequence_length;
@@ -331,12 +332,15 @@ Status MultiHeadAttention<T>::Compute(OpKernelContext* context) const {
       context, allocator, batch_size, num_heads_, q_sequence_length, qk_head_size, query, bias, q_bias_offset, Q));
 
   if (kv_BNSH) {
-    // No bias add needed for K/V, key already of shape BxNxLxH, value already of shape BxNxLxH_v
+    // No bias add needed for K/V, key already of shape BxNxLxH, value already of shape BxNxLxH_v.
+    // Their batch size may divide that of the query, as for the cross attention keys and values shared by the beams.
+    const int64_t kv_batch_size = key->Shape()[0];
+    const int kv_batch_group_size = kv_batch_size > 0 ? static_cast<int>(batch_size / kv_batch_size) : 1;
     return ApplyAttention(Q.GetMutable<Tensor>()->MutableData<T>(), key->Data<T>(), value->Data<T>(),
                           key_padding_mask, nullptr /* past */, nullptr /* past_k */, nullptr /* past_v */,
                           output, present_k, present_v,
                           batch_size, q_sequence_length, kv_sequence_length,
-                          qk_head_size, v_head_size, v_hidden_size, extra_add_qk, context);
+                          qk_head_size, v_head_size, v_hidden_size, extra_add_qk, context, kv_batch_group_size);
   }
 
   OrtValue K;
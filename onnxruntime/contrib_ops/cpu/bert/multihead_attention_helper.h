@@ -26,7 +26,8 @@ Status CheckInputs(const T* query,
                    float mask_filter_value,
                    float scale,
                    bool past_present_share_buffer,
-                   bool dmmha_packing) {
+                   bool dmmha_packing,
+                   bool broadcast_kv_batch = false) {
   //     key_padding_mask (K/V)     : (B) or (2*B + 1) or (B, L) or None
   //     relative_position_bias     : (B, 1, S, L)
   //     past_key                   : (B, N, S*, H)
@@ -46,6 +47,8 @@ Status CheckInputs(const T* query,
   //     key              (K)       : None
   //     value            (V)       : None
   //     bias             (Q/K/V)   : None or (D + D + D_v)
+  // When broadcast_kv_batch is true, key and value of shape (B', N, S*, H) may have a batch size B' dividing B. Each
+  // group of B / B' consecutive batches of query then attends the same batch of key and value.
 
   AttentionQkvFormat qkv_format;
 
@@ -55,6 +58,13 @@ Status CheckInputs(const T* query,
                            query_dims.size());
   }
 
+  if (broadcast_kv_batch) {
+    broadcast_kv_batch = key != nullptr && value != nullptr &&
+                         key->Shape().NumDimensions() == 4 && value->Shape().NumDimensions() == 4 &&
+                         key->Shape()[0] > 0 && key->Shape()[0] == value->Shape()[0] &&
+                         query_dims[0] % key->Shape()[0] == 0;
+  }
+
   int batch_size = static_cast<int>(query_dims[0]);
   int sequence_length = static_cast<int>(query_dims[1]);
   int hidden_size = (query_dims.size() == 3)
@@ -140,7 +150,7 @@ Status CheckInputs(const T* query,
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'key' is expected to have 3, 4, or 5 dimensions, got ",
                              key_dims.size());
     }
-    if (query_dims[0] != key_dims[0]) {
+    if (query_dims[0] != key_dims[0] && !broadcast_kv_batch) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "Input 'query' and 'key' shall have same dim 0 (batch size)");
     }
@@ -244,7 +254,7 @@ Status CheckInputs(const T* query,
                              value_dims.size());
     }
 
-    if (query_dims[0] != value_dims[0]) {
+    if (query_dims[0] != value_dims[0] && !broadcast_kv_batch) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "Input 'query' and 'value' shall have same dim 0 (batch_size)");
     }
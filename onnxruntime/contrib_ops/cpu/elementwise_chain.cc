@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/element_wise_ranged_transform.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// The number of elements a thread takes through the whole chain at a time, so the block of the output and of
+// the operands stays in the cache between the steps.
+constexpr std::ptrdiff_t kChainBlockSize = 4096;
+
+enum class ChainBinaryOp {
+  kAdd,
+  kSub,
+  kMul,
+  kDiv,
+};
+
+bool GetChainBinaryOp(const std::string& op_type, ChainBinaryOp& op) {
+  if (op_type == "Add") {
+    op = ChainBinaryOp::kAdd;
+  } else if (op_type == "Sub") {
+    op = ChainBinaryOp::kSub;
+  } else if (op_type == "Mul") {
+    op = ChainBinaryOp::kMul;
+  } else if (op_type == "Div") {
+    op = ChainBinaryOp::kDiv;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+template <typename TOperand>
+void ApplyChainBinaryOp(ChainBinaryOp op, bool operand_first, const ConstEigenVectorArrayMap<float>& input,
+                        const TOperand& operand, EigenVectorArrayMap<float>& output) {
+  switch (op) {
+    case ChainBinaryOp::kAdd:
+      output = input + operand;
+      break;
+    case ChainBinaryOp::kSub:
+      if (operand_first) {
+        output = operand - input;
+      } else {
+        output = input - operand;
+      }
+      break;
+    case ChainBinaryOp::kMul:
+      output = input * operand;
+      break;
+    case ChainBinaryOp::kDiv:
+      if (operand_first) {
+        output = operand / input;
+      } else {
+        output = input / operand;
+      }
+      break;
+  }
+}
+
+}  // namespace
+
+// Applies a chain of element-wise ops to its first input, taking each block of the output through all the steps
+// before moving on to the next block, so the tensor is read and written once rather than once per op.
+class ElementwiseChain final : public OpKernel {
+ public:
+  explicit ElementwiseChain(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<std::string> ops;
+    ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(),
+                "ElementwiseChain requires a non-empty 'ops' attribute.");
+    const auto operand_first = info.GetAttrsOrDefault<int64_t>("operand_first");
+    ORT_ENFORCE(operand_first.empty() || operand_first.size() == ops.size(),
+                "'operand_first' must have one value per step.");
+
+    int next_operand = 1;
+    steps_.resize(ops.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+      Step& step = steps_[i];
+      if (GetChainBinaryOp(ops[i], step.binary_op)) {
+        step.operand_index = next_operand++;
+        step.operand_first = !operand_first.empty() && operand_first[i] != 0;
+        cost_ += 1.0f;
+      } else {
+        ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<float>::Create(ops[i], {}, step.unary));
+        cost_ += step.unary->Cost();
+      }
+    }
+
+    ORT_ENFORCE(next_operand == static_cast<int>(info.GetInputCount()),
+                "ElementwiseChain has ", info.GetInputCount(), " inputs but its steps take ", next_operand);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Step {
+    // set for the activation steps
+    std::unique_ptr<functors::ElementWiseRangedTransform<float>> unary;
+
+    // the op, and the input index of the operand, of the binary steps
+    ChainBinaryOp binary_op{ChainBinaryOp::kAdd};
+    int operand_index{-1};
+    bool operand_first{false};
+  };
+
+  std::vector<Step> steps_;
+  float cost_{0.0f};
+};
+
+Status ElementwiseChain::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const TensorShape& shape = X.Shape();
+  Tensor& Y = *context->Output(0, shape);
+
+  const std::ptrdiff_t size = narrow<std::ptrdiff_t>(shape.Size());
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  const float* x = X.Data<float>();
+  float* y = Y.MutableData<float>();
+
+  // the operand data of the binary steps, and the copies of the activations of this run, which read the input
+  // for the first step and transform the output in place for the others
+  const size_t num_steps = steps_.size();
+  InlinedVector<const float*> operands(num_steps, nullptr);
+  InlinedVector<bool> scalar_operands(num_steps, false);
+  std::vector<std::unique_ptr<functors::ElementWiseRangedTransform<float>>> unary(num_steps);
+  for (size_t i = 0; i < num_steps; ++i) {
+    const Step& step = steps_[i];
+    if (step.unary) {
+      unary[i].reset(step.unary->Copy());
+      unary[i]->input = i == 0 ? x : y;
+      unary[i]->output = y;
+      continue;
+    }
+
+    const Tensor& operand = *context->Input<Tensor>(step.operand_index);
+    const TensorShape& operand_shape = operand.Shape();
+    const bool is_scalar = operand_shape.Size() == 1 && operand_shape.NumDimensions() <= shape.NumDimensions();
+    if (!is_scalar && operand_shape != shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ElementwiseChain operand ", step.operand_index,
+                             " has shape ", operand_shape, " which is neither ", shape, " nor a single element.");
+    }
+
+    operands[i] = operand.Data<float>();
+    scalar_operands[i] = is_scalar;
+  }
+
+  const double bytes_per_element = static_cast<double>(sizeof(float));
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), size,
+      TensorOpCost{bytes_per_element, bytes_per_element, static_cast<double>(cost_)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t begin = first; begin < last; begin += kChainBlockSize) {
+          const std::ptrdiff_t end = std::min(begin + kChainBlockSize, last);
+          const std::ptrdiff_t length = end - begin;
+          EigenVectorArrayMap<float> output(y + begin, length);
+
+          for (size_t i = 0; i < num_steps; ++i) {
+            if (unary[i]) {
+              (*unary[i])(begin, end);
+              continue;
+            }
+
+            const Step& step = steps_[i];
+            const ConstEigenVectorArrayMap<float> input((i == 0 ? x : y) + begin, length);
+            if (scalar_operands[i]) {
+              ApplyChainBinaryOp(step.binary_op, step.operand_first, input, *operands[i], output);
+            } else {
+              const ConstEigenVectorArrayMap<float> operand(operands[i] + begin, length);
+              ApplyChainBinaryOp(step.binary_op, step.operand_first, input, operand, output);
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    ElementwiseChain,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    ElementwiseChain);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,270 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// The number of elements a thread takes through all the stages at a time, so the rows stay in the cache between
+// the stages.
+constexpr std::ptrdiff_t kPreprocessingBlockSize = 4096;
+
+enum class PreprocessingStage {
+  kImputer,
+  kScaler,
+  kBinarizer,
+  kNormalizer,
+};
+
+enum class PreprocessingNorm {
+  kMax,
+  kL1,
+  kL2,
+};
+
+// The normalizations of the Normalizer kernel, on one row.
+void NormalizeRow(PreprocessingNorm norm, float* row, size_t size) {
+  switch (norm) {
+    case PreprocessingNorm::kMax: {
+      float max = std::numeric_limits<float>::lowest();
+      for (size_t i = 0; i < size; ++i) {
+        max = std::max(max, row[i]);
+      }
+      if (max != 0.f) {
+        for (size_t i = 0; i < size; ++i) {
+          row[i] /= max;
+        }
+      }
+    } break;
+    case PreprocessingNorm::kL1: {
+      float sum = 0.f;
+      for (size_t i = 0; i < size; ++i) {
+        sum += std::abs(row[i]);
+      }
+      if (sum != 0.f) {
+        for (size_t i = 0; i < size; ++i) {
+          row[i] /= sum;
+        }
+      }
+    } break;
+    case PreprocessingNorm::kL2: {
+      float sum = 0.f;
+      for (size_t i = 0; i < size; ++i) {
+        sum += row[i] * row[i];
+      }
+      if (sum != 0.f) {
+        for (size_t i = 0; i < size; ++i) {
+          const float x = row[i];
+          row[i] = (x < 0) ? std::sqrt((x * x) / sum) * -1 : std::sqrt((x * x) / sum);
+        }
+      }
+    } break;
+  }
+}
+
+}  // namespace
+
+// Applies a chain of Imputer, Scaler, Binarizer and Normalizer stages to the rows of its input, taking each block of
+// rows through all the stages before moving on to the next block, so the tensor is read and written once rather than
+// once per stage.
+class MLPreprocessing final : public OpKernel {
+ public:
+  explicit MLPreprocessing(const OpKernelInfo& info) : OpKernel(info) {
+    std::vector<std::string> stages;
+    ORT_ENFORCE(info.GetAttrs<std::string>("stages", stages).IsOK() && !stages.empty(),
+                "MLPreprocessing requires a non-empty 'stages' attribute.");
+    const auto value_counts = info.GetAttrsOrDefault<int64_t>("value_counts");
+    ORT_ENFORCE(value_counts.size() == stages.size(), "'value_counts' must have one value per stage.");
+    const auto values = info.GetAttrsOrDefault<float>("values");
+    const auto norms = info.GetAttrsOrDefault<std::string>("norms");
+
+    size_t next_value = 0;
+    size_t next_norm = 0;
+    steps_.resize(stages.size());
+    for (size_t i = 0; i < stages.size(); ++i) {
+      Step& step = steps_[i];
+      const size_t count = narrow<size_t>(value_counts[i]);
+      ORT_ENFORCE(next_value + count <= values.size(), "'values' is too short for the stages.");
+      const float* stage_values = values.data() + next_value;
+      next_value += count;
+
+      if (stages[i] == "Imputer") {
+        ORT_ENFORCE(count >= 2, "An Imputer stage takes its replaced value and at least one imputed value.");
+        step.stage = PreprocessingStage::kImputer;
+        step.threshold = stage_values[0];
+        step.a.assign(stage_values + 1, stage_values + count);
+      } else if (stages[i] == "Scaler") {
+        ORT_ENFORCE(count >= 2 && count % 2 == 0, "A Scaler stage takes as many offsets as scales.");
+        step.stage = PreprocessingStage::kScaler;
+        step.a.assign(stage_values, stage_values + count / 2);
+        step.b.assign(stage_values + count / 2, stage_values + count);
+      } else if (stages[i] == "Binarizer") {
+        ORT_ENFORCE(count == 1, "A Binarizer stage takes its threshold.");
+        step.stage = PreprocessingStage::kBinarizer;
+        step.threshold = stage_values[0];
+      } else if (stages[i] == "Normalizer") {
+        ORT_ENFORCE(count == 0 && next_norm < norms.size(), "A Normalizer stage takes the next of 'norms'.");
+        step.stage = PreprocessingStage::kNormalizer;
+        const std::string& norm = norms[next_norm++];
+        if (norm == "MAX") {
+          step.norm = PreprocessingNorm::kMax;
+        } else if (norm == "L1") {
+          step.norm = PreprocessingNorm::kL1;
+        } else {
+          ORT_ENFORCE(norm == "L2", "Unexpected norm of a Normalizer stage: ", norm);
+          step.norm = PreprocessingNorm::kL2;
+        }
+      } else {
+        ORT_THROW("Unexpected MLPreprocessing stage: ", stages[i]);
+      }
+    }
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Step {
+    PreprocessingStage stage{PreprocessingStage::kImputer};
+    // the replaced value of an Imputer, the threshold of a Binarizer
+    float threshold{0.f};
+    // the imputed values of an Imputer, the offsets of a Scaler
+    std::vector<float> a;
+    // the scales of a Scaler
+    std::vector<float> b;
+    PreprocessingNorm norm{PreprocessingNorm::kMax};
+  };
+
+  std::vector<Step> steps_;
+};
+
+Status MLPreprocessing::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const TensorShape& shape = X.Shape();
+  if (shape.NumDimensions() < 1 || shape.NumDimensions() > 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "MLPreprocessing input must be of shape [N, C] or [C]. Got ",
+                           shape);
+  }
+
+  Tensor& Y = *context->Output(0, shape);
+  const size_t num_rows = shape.NumDimensions() == 1 ? 1 : narrow<size_t>(shape[0]);
+  const size_t num_features = narrow<size_t>(shape[shape.NumDimensions() - 1]);
+  if (num_rows == 0 || num_features == 0) {
+    return Status::OK();
+  }
+
+  // the values of each feature, with the Imputer values of any other size than the number of features reduced to
+  // their first one like the Imputer kernel does, and the Scaler values of size 1 broadcast
+  const size_t num_steps = steps_.size();
+  std::vector<std::vector<float>> feature_a(num_steps);
+  std::vector<std::vector<float>> feature_b(num_steps);
+  for (size_t i = 0; i < num_steps; ++i) {
+    const Step& step = steps_[i];
+    if (step.stage == PreprocessingStage::kImputer) {
+      feature_a[i] = step.a.size() == num_features ? step.a : std::vector<float>(num_features, step.a[0]);
+    } else if (step.stage == PreprocessingStage::kScaler) {
+      if (step.a.size() == num_features) {
+        feature_a[i] = step.a;
+        feature_b[i] = step.b;
+      } else if (step.a.size() == 1) {
+        feature_a[i].assign(num_features, step.a[0]);
+        feature_b[i].assign(num_features, step.b[0]);
+      } else {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Either both scale and offset can be of feature size (",
+                               num_features, ") or 1");
+      }
+    }
+  }
+
+  const float* x = X.Data<float>();
+  float* y = Y.MutableData<float>();
+  const size_t rows_per_block = std::max<size_t>(1, narrow<size_t>(kPreprocessingBlockSize) / num_features);
+  const std::ptrdiff_t num_blocks = narrow<std::ptrdiff_t>((num_rows + rows_per_block - 1) / rows_per_block);
+  std::atomic<bool> binarizer_nan{false};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_blocks,
+      TensorOpCost{static_cast<double>(rows_per_block * num_features * sizeof(float)),
+                   static_cast<double>(rows_per_block * num_features * sizeof(float)),
+                   static_cast<double>(rows_per_block * num_features * num_steps) * 2.0},
+      [&](std::ptrdiff_t first_block, std::ptrdiff_t last_block) {
+        const size_t first_row = narrow<size_t>(first_block) * rows_per_block;
+        const size_t last_row = std::min(num_rows, narrow<size_t>(last_block) * rows_per_block);
+        for (size_t block_row = first_row; block_row < last_row; block_row += rows_per_block) {
+          const size_t block_rows = std::min(rows_per_block, last_row - block_row);
+          const size_t offset = block_row * num_features;
+          const size_t size = block_rows * num_features;
+          if (x != y) {
+            std::copy_n(x + offset, size, y + offset);
+          }
+
+          for (size_t i = 0; i < num_steps; ++i) {
+            const Step& step = steps_[i];
+            float* block = y + offset;
+            switch (step.stage) {
+              case PreprocessingStage::kImputer: {
+                const float* imputed = feature_a[i].data();
+                const bool replace_nan = std::isnan(step.threshold);
+                for (size_t r = 0; r < block_rows; ++r, block += num_features) {
+                  for (size_t f = 0; f < num_features; ++f) {
+                    if (replace_nan ? std::isnan(block[f]) : block[f] == step.threshold) {
+                      block[f] = imputed[f];
+                    }
+                  }
+                }
+              } break;
+              case PreprocessingStage::kScaler: {
+                const float* offsets = feature_a[i].data();
+                const float* scales = feature_b[i].data();
+                for (size_t r = 0; r < block_rows; ++r, block += num_features) {
+                  for (size_t f = 0; f < num_features; ++f) {
+                    block[f] = (block[f] - offsets[f]) * scales[f];
+                  }
+                }
+              } break;
+              case PreprocessingStage::kBinarizer: {
+                for (size_t j = 0; j < size; ++j) {
+                  if (std::isnan(block[j])) {
+                    binarizer_nan = true;
+                  }
+                  block[j] = block[j] > step.threshold ? 1.f : 0.f;
+                }
+              } break;
+              case PreprocessingStage::kNormalizer: {
+                for (size_t r = 0; r < block_rows; ++r, block += num_features) {
+                  NormalizeRow(step.norm, block, num_features);
+                }
+              } break;
+            }
+          }
+        }
+      });
+
+  if (binarizer_nan) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input data of a Binarizer stage is NaN");
+  }
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MLPreprocessing,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    MLPreprocessing);
+
+}  // namespace contrib
+}  // namespace onnxruntime
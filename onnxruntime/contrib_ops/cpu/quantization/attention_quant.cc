@@ -10,12 +10,73 @@
 #include "core/common/safeint.h"
 #include "core/platform/threadpool.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+
+#include <array>
 
 using onnxruntime::concurrency::ThreadPool;
 
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+// The int8 attention core computes the probabilities of a row of scores from the distance d of each score to the
+// maximum of the row, in steps of kSoftmaxTableStep: they are kSoftmaxTable[d] / sum_t kSoftmaxTable[d_t] with
+// kSoftmaxTable[d] = round(255 * exp(-d * kSoftmaxTableStep)), so they are exactly the 8 bit values multiplied
+// with V. Scores more than 255 steps below the maximum get a probability of 0.
+constexpr float kSoftmaxTableStep = 1.0f / 32.0f;
+
+std::array<uint8_t, 256> BuildSoftmaxTable() {
+  std::array<uint8_t, 256> table;
+  for (size_t d = 0; d < table.size(); d++) {
+    table[d] = static_cast<uint8_t>(std::nearbyint(255.0f * std::exp(-static_cast<float>(d) * kSoftmaxTableStep)));
+  }
+  return table;
+}
+
+// Quantizes n values to int8 with a symmetric scale, and returns the scale.
+float QuantizeSymmetric(const float* values, size_t n, int8_t* quantized) {
+  float min_value;
+  float max_value;
+  MlasFindMinMaxElement(values, &min_value, &max_value, n);
+  float scale = std::max(std::fabs(min_value), std::fabs(max_value)) / 127.0f;
+  if (scale == 0.0f) {
+    scale = 1.0f;
+  }
+  MlasQuantizeLinear<int8_t>(values, quantized, n, scale, 0);
+  return scale;
+}
+
+// Converts the int32 output of the gemm of the 8 bit probabilities and the int8 V to float:
+// y[m, n] = c[m, n] * row_scales[m], where row_scales[m] holds the scale of V divided by the sum of row m of the
+// probabilities.
+class RowScaleOutputProcessor : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  RowScaleOutputProcessor(float* output, size_t ldo, const float* row_scales)
+      : output_(output), ldo_(ldo), row_scales_(row_scales) {
+  }
+
+  void Process(const int32_t* C, size_t StartM, size_t StartN, size_t CountM, size_t CountN,
+               size_t ldc) const override {
+    for (size_t m = StartM; m < StartM + CountM; m++) {
+      const int32_t* c = C + m * ldc;
+      float* y = output_ + m * ldo_;
+      const float row_scale = row_scales_[m];
+      for (size_t n = StartN; n < StartN + CountN; n++) {
+        y[n] = static_cast<float>(c[n]) * row_scale;
+      }
+    }
+  }
+
+ private:
+  float* output_;
+  size_t ldo_;
+  const float* row_scales_;
+};
+
+}  // namespace
+
 template <typename T>
 class QAttention : public OpKernel, public AttentionCPUBase {
  public:
@@ -32,10 +93,16 @@ class QAttention : public OpKernel, public AttentionCPUBase {
                                    /*out*/ bool& used_shared_buffers) override;
 
  private:
+  // Computes output(B, S, N, H) = Softmax(scale x Q x K' + mask) x V with int8 gemms and a lookup table softmax.
+  Status ApplyInt8Attention(const T* Q, const T* K, const T* V, const Tensor* mask_index, Tensor* output,
+                            int batch_size, int sequence_length, int head_size, int hidden_size,
+                            OpKernelContext* context) const;
+
   IAllocatorUniquePtr<void> packed_weights_;
   size_t packed_weights_size_;
   TensorShape weight_shape_;
   bool weights_is_signed_;
+  bool use_int8_core_;
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -54,6 +121,9 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
 
 template <typename T>
 QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info, true) {
+  const auto* ep = info.GetExecutionProvider();
+  use_int8_core_ = ep->Type() == kCpuExecutionProvider &&
+                   static_cast<const CPUExecutionProvider*>(ep)->GetInfo().qattention_int8_core;
 }
 
 template <typename T>
@@ -287,6 +357,13 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
     MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
   }
 
+  // The int8 core doesn't produce the present state
+  if (use_int8_core_ && past_tensor == nullptr && context->OutputCount() == 1 &&
+      (mask_index == nullptr || mask_index->Shape().NumDimensions() <= 2)) {
+    return ApplyInt8Attention(Q, K, V, mask_index, output, batch_size, sequence_length, head_size, hidden_size,
+                              context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past_tensor, nullptr /* past_key */, nullptr /* past_value*/,
                         output, nullptr /* present_key */, nullptr /* present_value */,
@@ -294,5 +371,144 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
                         head_size, head_size, hidden_size, nullptr /* rel_pos_bias */, context);
 }
 
+template <typename T>
+Status QAttention<T>::ApplyInt8Attention(const T* Q, const T* K, const T* V, const Tensor* mask_index,
+                                         Tensor* output, int batch_size, int sequence_length, int head_size,
+                                         int hidden_size, OpKernelContext* context) const {
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  const size_t S = static_cast<size_t>(sequence_length);
+  const size_t H = static_cast<size_t>(head_size);
+
+  // The mask only depends on the key without a 3D mask, so it's prepared as BxS additive mask: PrepareMask yields
+  // that for a single query at the end of the sequence.
+  void* key_mask = nullptr;
+  if (mask_index != nullptr) {
+    size_t key_mask_bytes = SafeInt<size_t>(batch_size) * S * sizeof(T);
+    key_mask = allocator->Alloc(key_mask_bytes);
+    memset(key_mask, 0, key_mask_bytes);
+    PrepareMask(mask_index->Data<int32_t>(), mask_index->Shape().GetDims(), static_cast<T*>(key_mask),
+                false, batch_size, 1, sequence_length - 1, mask_filter_value_);
+  }
+  BufferUniquePtr key_mask_buffer(key_mask, BufferDeleter(allocator));
+  const T* key_mask_data = static_cast<const T*>(key_mask);
+
+  static const std::array<uint8_t, 256> softmax_table = BuildSoftmaxTable();
+  const bool causal = is_unidirectional_ && sequence_length > 1;
+  const float alpha = scale_ == 0.0f ? 1.0f / sqrt(static_cast<float>(head_size)) : scale_;
+  T* output_data = output->MutableData<T>();
+
+  // Scratch of a head: quantized Q (SxH), K' (HxS) and V (SxH), the int32 and then float scores (SxS) reused for
+  // the int32 output (SxH), the 8 bit probabilities (SxS) and the scales of the rows of the output (S).
+  const size_t head_elements = S * H;
+  const size_t scores_elements = S * std::max(S, H);
+  const size_t scratch_bytes = SafeInt<size_t>(head_elements) * 3 + scores_elements * sizeof(float) + S * S +
+                               S * sizeof(float);
+
+  auto compute_heads = [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    auto scratch = IAllocator::MakeUniquePtr<uint8_t>(allocator, scratch_bytes);
+    float* scores = reinterpret_cast<float*>(scratch.get());
+    float* row_scales = scores + scores_elements;
+    uint8_t* q_quant = reinterpret_cast<uint8_t*>(row_scales + S);
+    int8_t* k_transposed = reinterpret_cast<int8_t*>(q_quant + head_elements);
+    int8_t* v_quant = k_transposed + head_elements;
+    uint8_t* probs = reinterpret_cast<uint8_t*>(v_quant + head_elements);
+    const uint8_t zero_point = 0;
+
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i) / num_heads_;
+      const int head_index = static_cast<int>(i) % num_heads_;
+
+      // K is quantized to the V buffer, then transposed.
+      const T* q = Q + static_cast<size_t>(i) * head_elements;
+      const T* k = K + static_cast<size_t>(i) * head_elements;
+      const T* v = V + static_cast<size_t>(i) * head_elements;
+      float q_scale;
+      uint8_t q_zero_point;
+      GetQuantizationParameter(q, static_cast<int64_t>(head_elements), q_scale, q_zero_point, nullptr);
+      MlasQuantizeLinear(q, q_quant, head_elements, q_scale, q_zero_point);
+      const float k_scale = QuantizeSymmetric(k, head_elements, v_quant);
+      for (size_t s = 0; s < S; s++) {
+        for (size_t h = 0; h < H; h++) {
+          k_transposed[h * S + s] = v_quant[s * H + h];
+        }
+      }
+      const float v_scale = QuantizeSymmetric(v, head_elements, v_quant);
+
+      // scores(S, S) = alpha x Q x K'
+      const float score_scale = alpha * q_scale * k_scale;
+      MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR score_processor(scores, S, &score_scale, nullptr);
+      MLAS_GEMM_QUANT_SHAPE_PARAMS score_shape;
+      score_shape.M = S;
+      score_shape.N = S;
+      score_shape.K = H;
+      score_shape.BIsSigned = true;
+      MLAS_GEMM_QUANT_DATA_PARAMS score_params;
+      score_params.A = q_quant;
+      score_params.lda = H;
+      score_params.ZeroPointA = q_zero_point;
+      score_params.B = k_transposed;
+      score_params.ldb = S;
+      score_params.ZeroPointB = &zero_point;
+      score_params.C = reinterpret_cast<int32_t*>(scores);
+      score_params.ldc = S;
+      score_params.OutputProcessor = &score_processor;
+      MlasGemm(score_shape, score_params, nullptr);
+
+      // probs(S, S) from the softmax table, with the mask added to the scores
+      const T* mask = key_mask_data != nullptr ? key_mask_data + static_cast<size_t>(batch_index) * S : nullptr;
+      for (size_t s = 0; s < S; s++) {
+        float* row = scores + s * S;
+        uint8_t* p = probs + s * S;
+        const size_t keys = causal ? s + 1 : S;
+        float max_score = std::numeric_limits<float>::lowest();
+        for (size_t t = 0; t < keys; t++) {
+          if (mask != nullptr) {
+            row[t] += mask[t];
+          }
+          max_score = std::max(max_score, row[t]);
+        }
+
+        int32_t sum = 0;
+        for (size_t t = 0; t < keys; t++) {
+          const float steps = std::min(255.0f, (max_score - row[t]) * (1.0f / kSoftmaxTableStep) + 0.5f);
+          p[t] = softmax_table[static_cast<size_t>(steps)];
+          sum += p[t];
+        }
+        std::fill(p + keys, p + S, static_cast<uint8_t>(0));
+        row_scales[s] = v_scale / static_cast<float>(sum);
+      }
+
+      // output(S, H) = probs x V, written to the head of output(B, S, N, H)
+      RowScaleOutputProcessor output_processor(
+          output_data + static_cast<size_t>(batch_index) * S * hidden_size + static_cast<size_t>(head_index) * H,
+          static_cast<size_t>(hidden_size), row_scales);
+      MLAS_GEMM_QUANT_SHAPE_PARAMS output_shape;
+      output_shape.M = S;
+      output_shape.N = H;
+      output_shape.K = S;
+      output_shape.BIsSigned = true;
+      MLAS_GEMM_QUANT_DATA_PARAMS output_params;
+      output_params.A = probs;
+      output_params.lda = S;
+      output_params.ZeroPointA = 0;
+      output_params.B = v_quant;
+      output_params.ldb = H;
+      output_params.ZeroPointB = &zero_point;
+      output_params.C = reinterpret_cast<int32_t*>(scores);
+      output_params.ldc = H;
+      output_params.OutputProcessor = &output_processor;
+      MlasGemm(output_shape, output_params, nullptr);
+    }
+  };
+
+  const int loop_len = batch_size * num_heads_;
+  const double cost = static_cast<double>(head_elements) * S * 2;
+  ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, cost, compute_heads);
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -4,6 +4,8 @@
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/cpu/quantization/matmul_integer_base.h"
@@ -35,6 +37,101 @@ void ScaleOutput(const Tensor& scale, Tensor& output) {
 
   BroadcastLooper(broadcast_helper, funcs);
 }
+
+// Quantizes each row of the M x K matrix A to uint8 with its own scale and zero point. The range of a row is found
+// right before the row is quantized, while it is still in cache, so A is only read from memory once.
+void QuantizeRows(const float* a, size_t M, size_t K, uint8_t* a_quant, float* scales, uint8_t* zero_points,
+                  concurrency::ThreadPool* thread_pool) {
+  const TensorOpCost unit_cost{static_cast<double>(K) * sizeof(float), static_cast<double>(K) * sizeof(uint8_t),
+                               static_cast<double>(K) * 4.0};
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(M), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t m = begin; m < end; m++) {
+          const float* row = a + m * K;
+          float min;
+          float max;
+          MlasFindMinMaxElement(row, &min, &max, K);
+          // ensure the input range includes zero
+          min = std::min(min, 0.0f);
+          max = std::max(max, 0.0f);
+
+          constexpr float qmin = static_cast<float>(std::numeric_limits<uint8_t>::min());
+          constexpr float qmax = static_cast<float>(std::numeric_limits<uint8_t>::max());
+          const float scale = max == min ? 1.0f : (max - min) / (qmax - qmin);
+          const uint8_t zero_point =
+              static_cast<uint8_t>(RoundHalfToEven(std::max(qmin, std::min(qmax, qmin - min / scale))));
+          MlasQuantizeLinear(row, a_quant + m * K, K, scale, zero_point);
+          scales[m] = scale;
+          zero_points[m] = zero_point;
+        }
+      });
+}
+
+// Returns the sum of each column of the K x N matrix B.
+template <typename T>
+std::vector<int32_t> ComputeColumnSums(const T* b, size_t K, size_t N) {
+  std::vector<int32_t> sums(N, 0);
+  for (size_t k = 0; k < K; k++) {
+    for (size_t n = 0; n < N; n++) {
+      sums[n] += static_cast<int32_t>(b[k * N + n]);
+    }
+  }
+  return sums;
+}
+
+std::vector<int32_t> ComputeColumnSums(const Tensor& b) {
+  const auto K = static_cast<size_t>(b.Shape()[0]);
+  const auto N = static_cast<size_t>(b.Shape()[1]);
+  return b.IsDataType<int8_t>() ? ComputeColumnSums(b.Data<int8_t>(), K, N)
+                                : ComputeColumnSums(b.Data<uint8_t>(), K, N);
+}
+
+// Converts the int32 output of a gemm of an A quantized per row, run with a zero point of 0 for A, to float:
+// y[m, n] = (c[m, n] - a_zp[m] * (sum_k b[k, n] - K * b_zp[n])) * a_scale[m] * b_scale[n] + bias[n]
+// b_column_offsets holds sum_k b[k, n] - K * b_zp[n].
+class PerRowScaleBiasOutputProcessor : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  PerRowScaleBiasOutputProcessor(float* output, size_t ldo, const float* a_scales, const uint8_t* a_zero_points,
+                                 const int32_t* b_column_offsets, const float* b_scales, bool is_b_scale_per_column,
+                                 const float* bias)
+      : output_(output),
+        ldo_(ldo),
+        a_scales_(a_scales),
+        a_zero_points_(a_zero_points),
+        b_column_offsets_(b_column_offsets),
+        b_scales_(b_scales),
+        is_b_scale_per_column_(is_b_scale_per_column),
+        bias_(bias) {
+  }
+
+  void Process(const int32_t* C, size_t StartM, size_t StartN, size_t CountM, size_t CountN,
+               size_t ldc) const override {
+    for (size_t m = StartM; m < StartM + CountM; m++) {
+      const int32_t* c = C + m * ldc;
+      float* y = output_ + m * ldo_;
+      const float a_scale = a_scales_[m];
+      const int32_t a_zero_point = a_zero_points_[m];
+      for (size_t n = StartN; n < StartN + CountN; n++) {
+        const float b_scale = b_scales_[is_b_scale_per_column_ ? n : 0];
+        float value = static_cast<float>(c[n] - a_zero_point * b_column_offsets_[n]) * (a_scale * b_scale);
+        if (bias_ != nullptr) {
+          value += bias_[n];
+        }
+        y[n] = value;
+      }
+    }
+  }
+
+ private:
+  float* output_;
+  size_t ldo_;
+  const float* a_scales_;
+  const uint8_t* a_zero_points_;
+  const int32_t* b_column_offsets_;
+  const float* b_scales_;
+  bool is_b_scale_per_column_;
+  const float* bias_;
+};
 }  // namespace
 
 class MatMulIntegerToFloatBase : public MatMulIntegerBase {
@@ -157,7 +254,15 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+    const auto* ep = info.GetExecutionProvider();
+    quantize_per_row_ = ep->Type() == kCpuExecutionProvider &&
+                        static_cast<const CPUExecutionProvider*>(ep)->GetInfo().dynamic_quantize_matmul_per_row;
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -171,6 +276,15 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  // Quantizes A with a scale and zero point per row. Only used for a 2D B.
+  Status ComputePerRow(OpKernelContext* ctx, const Tensor& a, const Tensor* b, const Tensor& b_scale_tensor,
+                       const Tensor* b_zp_tensor) const;
+
+  bool quantize_per_row_{false};
+  // the column sums of the packed B when quantizing A per row
+  std::vector<int32_t> b_column_sums_;
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -198,6 +312,84 @@ class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
   static void FixupScaleTensor(const Tensor*& a_scale_tensor, const Tensor*& b_scale_tensor);
 };
 
+Status DynamicQuantizeMatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                      /*out*/ bool& is_packed,
+                                      /*out*/ PrePackedWeights* prepacked_weights) {
+  ORT_RETURN_IF_ERROR(MatMulIntegerToFloatBase::PrePack(tensor, input_idx, alloc, is_packed, prepacked_weights));
+  if (is_packed && quantize_per_row_ && input_idx == IN_B) {
+    b_column_sums_ = ComputeColumnSums(tensor);
+  }
+  return Status::OK();
+}
+
+Status DynamicQuantizeMatMul::ComputePerRow(OpKernelContext* ctx, const Tensor& a, const Tensor* b,
+                                            const Tensor& b_scale_tensor, const Tensor* b_zp_tensor) const {
+  const TensorShape& b_shape = b ? b->Shape() : b_shape_;
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a.Shape(), b_shape, &b_scale_tensor.Shape(),
+                                     b_zp_tensor ? &b_zp_tensor->Shape() : nullptr));
+  Tensor* y = ctx->Output(OUT_Y, helper.OutputShape());
+  if (y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // A is flattened to a single M x K matrix since B is 2D
+  const auto M = static_cast<size_t>(helper.M());
+  const auto N = static_cast<size_t>(helper.N());
+  const auto K = static_cast<size_t>(helper.K());
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+  auto a_quant = IAllocator::MakeUniquePtr<uint8_t>(allocator, SafeInt<size_t>(M) * K);
+  std::vector<float> a_scales(M);
+  std::vector<uint8_t> a_zero_points(M);
+  QuantizeRows(a.Data<float>(), M, K, a_quant.get(), a_scales.data(), a_zero_points.data(), thread_pool);
+
+  const bool b_is_signed = b ? b->IsDataType<int8_t>() : b_is_signed_;
+  const bool is_b_zp_per_column = b_zp_tensor != nullptr && !IsScalarOr1ElementVector(b_zp_tensor);
+  const uint8_t b_zp_default = 0;
+  const uint8_t* b_zp_ptr = b_zp_tensor ? static_cast<const uint8_t*>(b_zp_tensor->DataRaw()) : &b_zp_default;
+
+  std::vector<int32_t> b_column_offsets = b ? ComputeColumnSums(*b) : b_column_sums_;
+  for (size_t n = 0; n < N; n++) {
+    const uint8_t zp = b_zp_ptr[is_b_zp_per_column ? n : 0];
+    const int32_t b_zp = b_is_signed ? static_cast<int32_t>(static_cast<int8_t>(zp)) : static_cast<int32_t>(zp);
+    b_column_offsets[n] -= static_cast<int32_t>(K) * b_zp;
+  }
+
+  const Tensor* bias_tensor = ctx->Input<Tensor>(IN_BIAS);
+  float* y_data = y->MutableData<float>();
+  PerRowScaleBiasOutputProcessor output_processor(y_data, N, a_scales.data(), a_zero_points.data(),
+                                                  b_column_offsets.data(), b_scale_tensor.Data<float>(),
+                                                  !IsScalarOr1ElementVector(&b_scale_tensor),
+                                                  bias_tensor ? bias_tensor->Data<float>() : nullptr);
+
+  MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+  gemm_shape.M = M;
+  gemm_shape.N = N;
+  gemm_shape.K = K;
+  gemm_shape.AIsSigned = false;
+  gemm_shape.BIsSigned = b_is_signed;
+
+  MLAS_GEMM_QUANT_DATA_PARAMS gemm_params;
+  gemm_params.OutputProcessor = &output_processor;
+  gemm_params.A = a_quant.get();
+  gemm_params.lda = K;
+  gemm_params.ZeroPointA = 0;
+  gemm_params.BIsPacked = bool(packed_b_);
+  gemm_params.B = b ? static_cast<const uint8_t*>(b->DataRaw()) : packed_b_.get();
+  gemm_params.ldb = N;
+  gemm_params.ZeroPointB = b_zp_ptr;
+  gemm_params.PerColumnZeroPoints = is_b_zp_per_column;
+  gemm_params.C = reinterpret_cast<int32_t*>(y_data);
+  gemm_params.ldc = N;
+
+  MlasGemmBatch(gemm_shape, &gemm_params, 1, thread_pool);
+
+  return Status::OK();
+}
+
 Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const Tensor* a = ctx->Input<Tensor>(IN_A);
   const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
@@ -205,6 +397,15 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const Tensor* b_scale_tensor = ctx->Input<Tensor>(IN_B_SCALE);
   const Tensor* b_zp_tensor = ctx->Input<Tensor>(IN_B_ZERO_POINT);
 
+  if (quantize_per_row_) {
+    const TensorShape& b_shape = b ? b->Shape() : b_shape_;
+    if ((b != nullptr || !b_column_sums_.empty()) && a->Shape().NumDimensions() >= 2 &&
+        b_shape.NumDimensions() == 2 && IsBQuantParamSupported(b_scale_tensor->Shape(), b_shape) &&
+        (b_zp_tensor == nullptr || IsBQuantParamSupported(b_zp_tensor->Shape(), b_shape))) {
+      return ComputePerRow(ctx, *a, b, *b_scale_tensor, b_zp_tensor);
+    }
+  }
+
   // calculate quantization parameter of a
   const float* a_data = a->Data<float>();
   int64_t num_of_elements = a->Shape().Size();
@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// Dequantizes row `row` of the table, in the format of input B of MatMulNBits, to `dst`.
+template <int64_t bits>
+void DequantizeRow(const uint8_t* data, const float* scales, const uint8_t* zero_points, int64_t row,
+                   int64_t block_size, int64_t blocks_per_row, int64_t K, float* dst) {
+  constexpr uint8_t default_zp = 1 << (bits - 1);
+  const int64_t blob_size = block_size / 8 * bits;
+  const uint8_t* blob = data + SafeInt<size_t>(row) * blocks_per_row * blob_size;
+
+  for (int64_t b = 0; b < blocks_per_row; b++, blob += blob_size) {
+    const int64_t block_idx = row * blocks_per_row + b;
+    const float scale = scales[block_idx];
+    uint8_t zp = default_zp;
+    if (zero_points != nullptr) {
+      if constexpr (bits == 4) {
+        zp = zero_points[block_idx / 2];
+        zp = (block_idx & 1) ? (zp >> 4) : (zp & 0xf);
+      } else {
+        zp = zero_points[block_idx];
+      }
+    }
+    const float zp_f = static_cast<float>(zp);
+
+    const int64_t k = b * block_size;
+    const int64_t len = std::min(block_size, K - k);
+    float* d = dst + k;
+    if constexpr (bits == 4) {
+      for (int64_t i = 0; i < len; i++) {
+        const uint8_t q = (i & 1) ? (blob[i / 2] >> 4) : (blob[i / 2] & 0xf);
+        d[i] = scale * (static_cast<float>(q) - zp_f);
+      }
+    } else {
+      for (int64_t i = 0; i < len; i++) {
+        d[i] = scale * (static_cast<float>(blob[i]) - zp_f);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+class GatherBlockQuantized final : public OpKernel {
+ public:
+  GatherBlockQuantized(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("K", &K_));
+    bits_ = info.GetAttrOrDefault<int64_t>("bits", 4);
+    block_size_ = info.GetAttrOrDefault<int64_t>("block_size", 128);
+    ORT_ENFORCE(K_ > 0, "K must be positive.");
+    ORT_ENFORCE(bits_ == 4 || bits_ == 8, "Only 4 and 8 bits are supported.");
+    ORT_ENFORCE(block_size_ >= 16 && ((block_size_ - 1) & block_size_) == 0,
+                "block_size must be a power of 2 and not smaller than 16.");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename Tind>
+  Status ComputeImpl(OpKernelContext* context, const Tensor& indices) const;
+
+  int64_t K_;
+  int64_t bits_;
+  int64_t block_size_;
+};
+
+template <typename Tind>
+Status GatherBlockQuantized::ComputeImpl(OpKernelContext* ctx, const Tensor& indices) const {
+  const Tensor* data = ctx->Input<Tensor>(0);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+
+  const int64_t blocks_per_row = (K_ + block_size_ - 1) / block_size_;
+  const int64_t blob_size = block_size_ / 8 * bits_;
+  const auto& data_shape = data->Shape();
+  ORT_RETURN_IF_NOT(data_shape.NumDimensions() == 3 && data_shape[1] == blocks_per_row && data_shape[2] == blob_size,
+                    "data must have shape [N, n_blocks_per_row, blob_size].");
+  const int64_t N = data_shape[0];
+  ORT_RETURN_IF_NOT(scales->Shape().Size() == N * blocks_per_row, "scales must have N * n_blocks_per_row elements.");
+  ORT_RETURN_IF_NOT(zero_points == nullptr ||
+                        zero_points->Shape().Size() == (bits_ == 4 ? (N * blocks_per_row + 1) / 2 : N * blocks_per_row),
+                    "zero_points has the wrong number of elements.");
+
+  TensorShapeVector output_dims = indices.Shape().AsShapeVector();
+  output_dims.push_back(K_);
+  Tensor* output = ctx->Output(0, TensorShape(output_dims));
+
+  const int64_t num_indices = indices.Shape().Size();
+  // Bail out early if the output is going to be empty
+  if (num_indices == 0) return Status::OK();
+
+  const Tind* indices_data = indices.Data<Tind>();
+  for (int64_t i = 0; i < num_indices; i++) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    if (idx < -N || idx >= N) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -N, ",", N - 1, "]");
+    }
+  }
+
+  const uint8_t* data_data = data->Data<uint8_t>();
+  const float* scales_data = scales->Data<float>();
+  const uint8_t* zero_points_data = zero_points == nullptr ? nullptr : zero_points->Data<uint8_t>();
+  float* output_data = output->MutableData<float>();
+
+  const auto dequantize_row = bits_ == 4 ? DequantizeRow<4> : DequantizeRow<8>;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_indices),
+      TensorOpCost{static_cast<double>(K_ * bits_ / 8), static_cast<double>(K_ * sizeof(float)),
+                   static_cast<double>(K_ * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; i++) {
+          int64_t idx = static_cast<int64_t>(indices_data[i]);
+          if (idx < 0) idx += N;
+          dequantize_row(data_data, scales_data, zero_points_data, idx, block_size_, blocks_per_row, K_,
+                         output_data + SafeInt<size_t>(i) * K_);
+        }
+      });
+
+  return Status::OK();
+}
+
+Status GatherBlockQuantized::Compute(OpKernelContext* ctx) const {
+  const Tensor* indices = ctx->Input<Tensor>(1);
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(ctx, *indices);
+  }
+  return ComputeImpl<int64_t>(ctx, *indices);
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    GatherBlockQuantized,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    GatherBlockQuantized);
+
+}  // namespace contrib
+}  // namespace onnxruntime
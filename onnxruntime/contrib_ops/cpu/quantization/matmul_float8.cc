@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(DISABLE_FLOAT8_TYPES)
+
+#include <algorithm>
+
+#include "core/common/safeint.h"
+#include "core/framework/float8.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+// B is decoded to float one tile of kTileK x kTileN elements at a time, small enough to stay in L2 while MLAS
+// multiplies it, so the float copy of B is never materialized.
+constexpr size_t kTileK = 256;
+constexpr size_t kTileN = 128;
+
+// Rows are split across threads only in blocks of at least this many rows, as each block decodes its own copy of
+// the tiles of B.
+constexpr size_t kMinRowsPerBlock = 16;
+
+template <typename T>
+void BuildDecodeTable(float scale, float* table) {
+  for (int bits = 0; bits < 256; bits++) {
+    table[bits] = T(static_cast<uint8_t>(bits), T::FromBits()).ToFloat() * scale;
+  }
+}
+
+}  // namespace
+
+class MatMulFloat8 final : public OpKernel {
+ public:
+  MatMulFloat8(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("K", &K_));
+    ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("N", &N_));
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t K_;
+  int64_t N_;
+};
+
+Status MatMulFloat8::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* b_scale = ctx->Input<Tensor>(2);
+  const Tensor* bias = ctx->Input<Tensor>(3);
+
+  const auto& a_shape = a->Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 1 && a_shape[a_shape.NumDimensions() - 1] == K_,
+                    "The last dimension of A must be K.");
+  ORT_RETURN_IF_NOT(b->Shape() == TensorShape({K_, N_}), "B must have shape [K, N].");
+  const bool per_column_scale = b_scale->Shape().Size() != 1;
+  ORT_RETURN_IF_NOT(!per_column_scale || b_scale->Shape() == TensorShape({N_}),
+                    "B_scale must be a scalar or have shape [N].");
+  ORT_RETURN_IF_NOT(bias == nullptr || bias->Shape() == TensorShape({N_}), "bias must have shape [N].");
+
+  TensorShapeVector y_dims = a_shape.AsShapeVector();
+  y_dims.back() = N_;
+  Tensor* y = ctx->Output(0, TensorShape(y_dims));
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0) return Status::OK();
+
+  // A per tensor scale is folded into the decode table, a per column scale is applied to the output.
+  const float* scale_data = b_scale->Data<float>();
+  float table[256];
+  const float table_scale = per_column_scale ? 1.0f : scale_data[0];
+  if (b->IsDataType<Float8E4M3FN>()) {
+    BuildDecodeTable<Float8E4M3FN>(table_scale, table);
+  } else if (b->IsDataType<Float8E4M3FNUZ>()) {
+    BuildDecodeTable<Float8E4M3FNUZ>(table_scale, table);
+  } else if (b->IsDataType<Float8E5M2>()) {
+    BuildDecodeTable<Float8E5M2>(table_scale, table);
+  } else {
+    BuildDecodeTable<Float8E5M2FNUZ>(table_scale, table);
+  }
+
+  const size_t M = static_cast<size_t>(a_shape.SizeToDimension(a_shape.NumDimensions() - 1));
+  const size_t N = static_cast<size_t>(N_);
+  const size_t K = static_cast<size_t>(K_);
+  const float* a_data = a->Data<float>();
+  const uint8_t* b_data = static_cast<const uint8_t*>(b->DataRaw());
+  const float* bias_data = bias == nullptr ? nullptr : bias->Data<float>();
+  float* y_data = y->MutableData<float>();
+
+  const size_t n_tiles = (N + kTileN - 1) / kTileN;
+  const size_t threads = static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+  size_t m_blocks = 1;
+  if (n_tiles < threads) {
+    m_blocks = std::max<size_t>(1, std::min((threads + n_tiles - 1) / n_tiles, M / kMinRowsPerBlock));
+  }
+  const size_t rows_per_block = (M + m_blocks - 1) / m_blocks;
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+  auto tiles = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(n_tiles) * m_blocks * kTileK * kTileN);
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(n_tiles * m_blocks), [&](std::ptrdiff_t task) {
+        const size_t n_start = (static_cast<size_t>(task) % n_tiles) * kTileN;
+        const size_t m_start = (static_cast<size_t>(task) / n_tiles) * rows_per_block;
+        if (m_start >= M) {
+          return;
+        }
+        const size_t rows = std::min(rows_per_block, M - m_start);
+        const size_t columns = std::min(kTileN, N - n_start);
+        float* tile = tiles.get() + static_cast<size_t>(task) * kTileK * kTileN;
+        float* y_block = y_data + m_start * N + n_start;
+
+        if (K == 0) {
+          for (size_t m = 0; m < rows; m++) {
+            std::fill_n(y_block + m * N, columns, 0.0f);
+          }
+        }
+
+        for (size_t k_start = 0; k_start < K; k_start += kTileK) {
+          const size_t depth = std::min(kTileK, K - k_start);
+          for (size_t k = 0; k < depth; k++) {
+            const uint8_t* b_row = b_data + (k_start + k) * N + n_start;
+            float* tile_row = tile + k * columns;
+            for (size_t n = 0; n < columns; n++) {
+              tile_row[n] = table[b_row[n]];
+            }
+          }
+
+          MlasGemm(CblasNoTrans, CblasNoTrans, rows, columns, depth,
+                   1.0f, a_data + m_start * K + k_start, K,
+                   tile, columns,
+                   k_start == 0 ? 0.0f : 1.0f, y_block, N, nullptr);
+        }
+
+        if (per_column_scale || bias_data != nullptr) {
+          for (size_t m = 0; m < rows; m++) {
+            float* y_row = y_block + m * N;
+            for (size_t n = 0; n < columns; n++) {
+              float value = y_row[n];
+              if (per_column_scale) value *= scale_data[n_start + n];
+              if (bias_data != nullptr) value += bias_data[n_start + n];
+              y_row[n] = value;
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulFloat8,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", BuildKernelDefConstraints<Float8E4M3FN, Float8E4M3FNUZ, Float8E5M2, Float8E5M2FNUZ>()),
+    MatMulFloat8);
+
+}  // namespace contrib
+}  // namespace onnxruntime
+
+#endif  // !defined(DISABLE_FLOAT8_TYPES)
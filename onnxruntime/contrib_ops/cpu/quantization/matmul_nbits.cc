@@ -7,6 +7,7 @@
 #include "core/providers/common.h"
 #include "dequantize_blockwise.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/mlas/inc/mlas_q4.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -18,21 +19,168 @@ class MatMulNBits final : public OpKernel {
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("N", &N_));
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("block_size", &block_size_));
     ORT_ENFORCE(Status::OK() == info.GetAttr<int64_t>("bits", &nbits_));
+    accuracy_level_ = info.GetAttrOrDefault<int64_t>("accuracy_level", 0);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
  private:
+  // The accuracy level from which A may be quantized to int8 blocks.
+  static constexpr int64_t kAccuracyLevelInt8 = 4;
+
   int64_t K_;
   int64_t N_;
   int64_t block_size_;
   int64_t nbits_;
+  int64_t accuracy_level_;
+
+  // B packed for MlasQ4GemmBatch and MlasQ8Q4GemmBatch, when B, scales and zero points are constant.
+  IAllocatorUniquePtr<void> packed_b_;
+  MLAS_BLK_QUANT_TYPE packed_b_type_{BlkQ4Sym};
 };
 
+// Returns the MLAS block quantization type that holds B without quantizing it again: its block length must divide
+// the block size, and only BlkQ4Zp8 has zero points.
+static bool GetPackedBQuantType(int64_t block_size, bool has_zero_points, MLAS_BLK_QUANT_TYPE& qtype) {
+  if (!has_zero_points && block_size == 32) {
+    qtype = BlkQ4Sym;
+  } else if (!has_zero_points && block_size == 64) {
+    qtype = BlkQ4Sym64;
+  } else if (!has_zero_points && block_size == 128) {
+    qtype = BlkQ4Sym128;
+  } else if (block_size % 32 == 0) {
+    qtype = BlkQ4Zp8;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+Status MatMulNBits::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // B is packed together with its scales and zero points, so they must be constant too.
+  if (input_idx != 1 || nbits_ != 4) {
+    return Status::OK();
+  }
+
+  const Tensor* scales = nullptr;
+  if (!Info().TryGetConstantInput(2, &scales)) {
+    return Status::OK();
+  }
+
+  const auto& input_defs = Info().node().InputDefs();
+  const Tensor* zero_points = nullptr;
+  if (input_defs.size() > 3 && input_defs[3]->Exists() && !Info().TryGetConstantInput(3, &zero_points)) {
+    return Status::OK();
+  }
+
+  MLAS_BLK_QUANT_TYPE qtype;
+  if (!GetPackedBQuantType(block_size_, zero_points != nullptr, qtype)) {
+    return Status::OK();
+  }
+
+  const size_t packed_b_size = MlasQ4GemmPackBSize(qtype, static_cast<size_t>(N_), static_cast<size_t>(K_));
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  packed_b_ = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  packed_b_type_ = qtype;
+  MlasQ4GemmPackBQuantized(qtype, packed_b_.get(), tensor.Data<uint8_t>(), scales->Data<float>(),
+                           zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr,
+                           static_cast<size_t>(N_), static_cast<size_t>(K_), static_cast<size_t>(block_size_));
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  return Status::OK();
+}
+
+Status MatMulNBits::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status MatMulNBits::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
   const Tensor* a = ctx->Input<Tensor>(0);
+
+  if (packed_b_) {
+    // The packed int4 blocks of B are dequantized in the GEMM kernel, without a float copy of B.
+    TensorShape b_shape({N_, K_});
+
+    MatMulComputeHelper helper;
+    ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, false, true));
+
+    Tensor* y = ctx->Output(0, helper.OutputShape());
+
+    // Bail out early if the output is going to be empty
+    if (y->Shape().Size() == 0)
+      return Status::OK();
+
+    const auto* a_data = a->Data<float>();
+    auto* y_data = y->MutableData<float>();
+
+    const size_t max_len = helper.OutputOffsets().size();
+    const size_t M = static_cast<size_t>(helper.M());
+    const size_t N = static_cast<size_t>(helper.N());
+    const size_t K = static_cast<size_t>(helper.K());
+    const size_t lda = helper.Lda(false);
+
+    // A is quantized to int8 blocks for the int8 x int4 kernels when the accuracy level allows it.
+    const size_t a_quant_size = accuracy_level_ >= kAccuracyLevelInt8 ? MlasQ80BlkQuantSize(packed_b_type_, M, K) : 0;
+    if (a_quant_size > 0) {
+      AllocatorPtr allocator;
+      ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+      auto a_quant_data = IAllocator::MakeUniquePtr<int8_t>(allocator, SafeInt<size_t>(a_quant_size) * max_len);
+
+      std::vector<MLAS_Q8Q4_GEMM_DATA_PARAMS> data(max_len);
+      for (size_t i = 0; i < max_len; i++) {
+        int8_t* a_quant = a_quant_data.get() + a_quant_size * i;
+        MlasQ80BlkQuant(packed_b_type_, a_quant, a_data + helper.LeftOffsets()[i], M, K, lda, thread_pool);
+        data[i].A = a_quant;
+        data[i].B = packed_b_.get();
+        data[i].C = y_data + helper.OutputOffsets()[i];
+        data[i].ldc = N;
+      }
+      MlasQ8Q4GemmBatch(packed_b_type_, M, N, K, max_len, data.data(), thread_pool);
+      return Status::OK();
+    }
+
+    std::vector<MLAS_Q4_GEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].B = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+    }
+    MlasQ4GemmBatch(packed_b_type_, M, N, K, max_len, data.data(), thread_pool);
+    return Status::OK();
+  }
+
   const Tensor* b = ctx->Input<Tensor>(1);
   const Tensor* scales = ctx->Input<Tensor>(2);
   const Tensor* zero_points = ctx->Input<Tensor>(3);
@@ -81,7 +229,7 @@ Status MatMulNBits::Compute(OpKernelContext* ctx) const {
   const size_t lda = helper.Lda(false);
   const size_t ldb = helper.Ldb(true);
 
-  // TODO: implement with native kernel
+  // B couldn't be packed for the int4 kernels, so it runs as a float GEMM over the dequantized B.
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = false;
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -81,6 +82,23 @@ Status SkipLayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
 
   const auto& skip_size = skip->Shape().Size();
 
+  if constexpr (std::is_same<T, float>::value) {
+    MLAS_LAYER_NORM_PARAMS params;
+    params.Input = input_data;
+    params.Skip = skip_data;
+    params.SkipRowCount = onnxruntime::narrow<size_t>(skip_size / hidden_size);
+    params.Bias = bias_data;
+    params.Gamma = gamma_data;
+    params.Beta = beta_data;
+    params.Output = output_data;
+    params.SkipOutput = skip_input_bias_add_output_data;
+    params.Epsilon = epsilon_;
+    params.Simplified = simplified;
+    MlasLayerNormalization(&params, onnxruntime::narrow<size_t>(task_count), static_cast<size_t>(hidden_size),
+                           p_ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
       [&](ptrdiff_t task_idx) {
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#ifndef SHARED_PROVIDER
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+#endif
+
+#include <vector>
+
+namespace onnxruntime {
+namespace contrib {
+
+// Computes a 1D int64 tensor from the dims of its inputs, by evaluating the postfix program of each element.
+// Only the shapes of the inputs are read, so it is shared by the EPs with the output in CPU memory, like Shape.
+class ShapeExpression final : public OpKernel {
+ public:
+  // The opcodes of the program, see the ShapeExpression schema.
+  enum Op : int64_t {
+    kConst = 0,
+    kDim = 1,
+    kAdd = 2,
+    kSub = 3,
+    kMul = 4,
+    kDiv = 5,
+    kEnd = 6,
+  };
+
+  ShapeExpression(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_THROW_IF_ERROR(info.GetAttrs<int64_t>("program", program_));
+
+    // check the program once, so Compute only checks the dims
+    const int64_t num_inputs = static_cast<int64_t>(info.GetInputCount());
+    size_t depth = 0;
+    for (size_t i = 0; i < program_.size(); ++i) {
+      switch (program_[i]) {
+        case kConst:
+          ORT_ENFORCE(i + 1 < program_.size(), "Missing value of a constant of the ShapeExpression program.");
+          ++i;
+          ++depth;
+          break;
+        case kDim:
+          ORT_ENFORCE(i + 2 < program_.size() && program_[i + 1] >= 0 && program_[i + 1] < num_inputs &&
+                          program_[i + 2] >= 0,
+                      "Invalid dim of the ShapeExpression program.");
+          i += 2;
+          ++depth;
+          break;
+        case kAdd:
+        case kSub:
+        case kMul:
+        case kDiv:
+          ORT_ENFORCE(depth >= 2, "Missing operand of the ShapeExpression program.");
+          --depth;
+          break;
+        case kEnd:
+          ORT_ENFORCE(depth == 1, "Each element of the ShapeExpression program must end with one value.");
+          depth = 0;
+          ++num_elements_;
+          break;
+        default:
+          ORT_THROW("Invalid opcode of the ShapeExpression program: ", program_[i]);
+      }
+    }
+    ORT_ENFORCE(depth == 0, "The ShapeExpression program must end with an element.");
+  }
+
+  Status Compute(OpKernelContext* context) const override {
+    Tensor* output = context->Output(0, {num_elements_});
+    int64_t* output_data = output->MutableData<int64_t>();
+
+    InlinedVector<int64_t, 8> stack;
+    for (size_t i = 0; i < program_.size(); ++i) {
+      switch (program_[i]) {
+        case kConst:
+          stack.push_back(program_[++i]);
+          break;
+        case kDim: {
+          const TensorShape& shape = context->Input<Tensor>(static_cast<int>(program_[i + 1]))->Shape();
+          const int64_t axis = program_[i + 2];
+          ORT_RETURN_IF_NOT(axis < static_cast<int64_t>(shape.NumDimensions()), "Input ", program_[i + 1],
+                            " of ShapeExpression has no axis ", axis, ". Shape: ", shape);
+          stack.push_back(shape[static_cast<size_t>(axis)]);
+          i += 2;
+          break;
+        }
+        case kEnd:
+          *output_data++ = stack.back();
+          stack.pop_back();
+          break;
+        default: {
+          const int64_t b = stack.back();
+          stack.pop_back();
+          int64_t& a = stack.back();
+          if (program_[i] == kAdd) {
+            a += b;
+          } else if (program_[i] == kSub) {
+            a -= b;
+          } else if (program_[i] == kMul) {
+            a *= b;
+          } else {
+            ORT_RETURN_IF(b == 0, "Division by zero in ShapeExpression.");
+            a /= b;
+          }
+          break;
+        }
+      }
+    }
+
+    return Status::OK();
+  }
+
+ private:
+  std::vector<int64_t> program_;
+  int64_t num_elements_{0};
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -182,6 +182,13 @@ class BeamSearchBase : public GenerateBase {
                        AllocatorPtr& allocator,
                        int counter);
 
+  // Streams the tokens appended by GenerateNextToken to sequences of the given length.
+  // Returns false when the stream callback asks to stop. The CUDA beam scorer keeps the tokens on the device,
+  // so they are not streamed.
+  bool StreamNextTokens(gsl::span<const int32_t> beam_next_tokens, int sequence_length) {
+    return IsCuda() || streamer_.Stream(beam_next_tokens, beam_scorer_->GetNextIndicesCPU(), sequence_length);
+  }
+
   BeamSearchParameters* parameters_;
 
   std::unique_ptr<IBeamScorer> beam_scorer_;
@@ -222,6 +229,7 @@ Status BeamSearchBase<T>::Initialize() {
                 "'num_return_sequences' has to be smaller or equal to 'num_beams'.");
 
   ORT_RETURN_IF_ERROR(CheckInputs(this->context_));
+  ORT_RETURN_IF_ERROR(streamer_.Init(this->context_));
 
   // This flag will be updated later when the scores output exists.
   parameters_->output_scores = false;
@@ -229,7 +237,7 @@ Status BeamSearchBase<T>::Initialize() {
   if (!IsCuda()) {
     // Logits processor is used in CPU only. In CUDA, cuda kernels are used instead.
     // Initialize processors after CheckInputs so that parameters_->vocab_mask is ready.
-    logits_processors_.Init(*parameters_);
+    logits_processors_.Init(*parameters_, thread_pool_);
   }
 
   return Status::OK();
@@ -329,6 +329,9 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
                                                 cpu_state,
                                                 iteration_counter));
 
+    if (!this->StreamNextTokens(beam_next_tokens, current_length + 1))
+      break;
+
     // When all batches are finished, stop earlier to avoid wasting computation.
     if (this->beam_scorer_->IsDone())
       break;
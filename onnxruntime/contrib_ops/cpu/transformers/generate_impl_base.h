@@ -8,6 +8,7 @@
 #include <vector>
 #include "core/common/span_utils.h"
 #include "contrib_ops/cpu/transformers/generation_shared.h"
+#include "contrib_ops/cpu/transformers/generation_streamer.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -250,6 +251,8 @@ class GenerateBase {
 
   LogitsProcessorList logits_processors_;
 
+  GenerationStreamer streamer_;
+
   AllocatorPtr cpu_allocator_;
   AllocatorPtr temp_space_allocator_;
 
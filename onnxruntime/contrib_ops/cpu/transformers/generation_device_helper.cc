@@ -7,6 +7,7 @@
 #include "core/providers/cpu/math/top_k.h"
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "core/providers/cpu/generator/random.h"
+#include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
 #include "core/common/gsl.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
@@ -555,7 +556,69 @@ Status DeviceCopy(gsl::span<T> target, gsl::span<const T> source, Stream* /*stre
   return Status::OK();
 }
 
-// Copy present state to past state for GPT model
+// Reorders the beams of a state tensor in place, so that beam j gets the state of beam beam_indices[j].
+// The state holds num_parts consecutive parts (like key and value) of shape (batch_beam_size, block_size).
+// Beams that keep their own state are not copied, and only beams that are overwritten while another beam
+// still reads them are staged in the scratch buffer, which is grown as needed and can be shared across layers.
+template <typename T>
+void ReorderBeamStateInPlace(gsl::span<T> state,
+                             size_t num_parts,
+                             size_t block_size,
+                             gsl::span<const int32_t> beam_indices,
+                             AllocatorPtr allocator,
+                             IAllocatorUniquePtr<T>& scratch,
+                             size_t& scratch_size) {
+  const size_t batch_beam_size = beam_indices.size();
+  const size_t part_size = batch_beam_size * block_size;
+  auto block = [&](size_t part, size_t beam) {
+    return state.subspan(part * part_size + beam * block_size, block_size);
+  };
+
+  InlinedVector<int32_t> staged_slot(batch_beam_size, -1);
+  size_t num_staged = 0;
+  for (size_t j = 0; j < batch_beam_size; j++) {
+    const auto source = static_cast<size_t>(beam_indices[j]);
+    if (source != j && static_cast<size_t>(beam_indices[source]) != source && staged_slot[source] < 0) {
+      staged_slot[source] = static_cast<int32_t>(num_staged++);
+    }
+  }
+
+  gsl::span<T> staged;
+  if (num_staged > 0) {
+    const size_t required = SafeInt<size_t>(num_staged) * num_parts * block_size;
+    if (required > scratch_size) {
+      scratch = IAllocator::MakeUniquePtr<T>(allocator, required);
+      scratch_size = required;
+    }
+    staged = gsl::make_span<T>(scratch.get(), required);
+    for (size_t beam = 0; beam < batch_beam_size; beam++) {
+      if (staged_slot[beam] >= 0) {
+        for (size_t part = 0; part < num_parts; part++) {
+          const size_t offset = (static_cast<size_t>(staged_slot[beam]) * num_parts + part) * block_size;
+          gsl::copy(block(part, beam), staged.subspan(offset, block_size));
+        }
+      }
+    }
+  }
+
+  for (size_t j = 0; j < batch_beam_size; j++) {
+    const auto source = static_cast<size_t>(beam_indices[j]);
+    if (source == j) {
+      continue;
+    }
+    for (size_t part = 0; part < num_parts; part++) {
+      if (staged_slot[source] >= 0) {
+        const size_t offset = (static_cast<size_t>(staged_slot[source]) * num_parts + part) * block_size;
+        gsl::copy(staged.subspan(offset, block_size), block(part, j));
+      } else {
+        gsl::copy(block(part, source), block(part, j));
+      }
+    }
+  }
+}
+
+// Copy present state to past state for GPT model.
+// The present state is not used after this call, so it is reordered in place and fed back as past state.
 template <typename T>
 void PickGptPastState(const std::vector<OrtValue>& last_outputs,
                       std::vector<OrtValue>& next_inputs,
@@ -563,34 +626,20 @@ void PickGptPastState(const std::vector<OrtValue>& last_outputs,
                       int gpt_subgraph_first_past_input_idx,
                       int gpt_subgraph_first_present_output_idx,
                       AllocatorPtr allocator) {
+  IAllocatorUniquePtr<T> scratch;
+  size_t scratch_size = 0;
   int num_present_tensors = static_cast<int>(last_outputs.size()) - gpt_subgraph_first_present_output_idx;
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
-    const OrtValue& present = last_outputs[gpt_subgraph_first_present_output_idx + i];
+    OrtValue past = last_outputs[gpt_subgraph_first_present_output_idx + i];
 
     // shape is like (2, batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
+    const TensorShape& past_shape = past.Get<Tensor>().Shape();
     auto block_size_per_beam = past_shape[2] * past_shape[3] * past_shape[4];
-    auto past_key_size = past_shape[1] * past_shape[2] * past_shape[3] * past_shape[4];
-
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    auto past_type = DataTypeImpl::GetType<T>();
-    Tensor::InitOrtValue(past_type, past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_key = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<const T> present_value = present_span.subspan(past_key_size + beam_index * SafeInt<size_t>(block_size_per_beam),
-                                                              onnxruntime::narrow<size_t>(block_size_per_beam));
-
-      gsl::span<T> past_key = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_value = past_span.subspan(past_key_size + j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_key, past_key);
-      gsl::copy(present_value, past_value);
-    }
+
+    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(),
+                                               onnxruntime::narrow<size_t>(past_shape.Size()));
+    ReorderBeamStateInPlace<T>(past_span, 2, onnxruntime::narrow<size_t>(block_size_per_beam), beam_indices,
+                               allocator, scratch, scratch_size);
 
     next_inputs[gpt_subgraph_first_past_input_idx + i] = past;
   }
@@ -765,26 +814,20 @@ void PickT5PastState(const std::vector<OrtValue>& last_outputs,
                      int t5_decoder_first_past_input_idx,
                      int t5_decoder_first_present_output_idx,
                      AllocatorPtr allocator) {
+  IAllocatorUniquePtr<T> scratch;
+  size_t scratch_size = 0;
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
-    const OrtValue& present = last_outputs[t5_decoder_first_present_output_idx + i];
+    // The present state is not used after this call, so it is reordered in place and fed back as past state.
+    OrtValue past = last_outputs[t5_decoder_first_present_output_idx + i];
 
     // shape is like (batch_beam_size, 12, past_seq_len, 64)
-    const TensorShape& past_shape = present.Get<Tensor>().Shape();
+    const TensorShape& past_shape = past.Get<Tensor>().Shape();
     auto block_size_per_beam = past_shape[1] * past_shape[2] * past_shape[3];
 
-    // Create a tensor with same shape.
-    // TODO(tianleiwu): allocate one buffer for all layers
-    OrtValue past;
-    Tensor::InitOrtValue(DataTypeImpl::GetType<T>(), past_shape, allocator, past);
-
-    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    gsl::span<const T> present_span = gsl::make_span<const T>(present.Get<Tensor>().Data<T>(), onnxruntime::narrow<size_t>(past_shape.Size()));
-    for (size_t j = 0; j < beam_indices.size(); j++) {
-      int32_t beam_index = beam_indices[j];
-      gsl::span<const T> present_beam = present_span.subspan(beam_index * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::span<T> past_beam = past_span.subspan(j * SafeInt<size_t>(block_size_per_beam), onnxruntime::narrow<size_t>(block_size_per_beam));
-      gsl::copy(present_beam, past_beam);
-    }
+    gsl::span<T> past_span = gsl::make_span<T>(past.GetMutable<Tensor>()->MutableData<T>(),
+                                               onnxruntime::narrow<size_t>(past_shape.Size()));
+    ReorderBeamStateInPlace<T>(past_span, 1, onnxruntime::narrow<size_t>(block_size_per_beam), beam_indices,
+                               allocator, scratch, scratch_size);
 
     next_inputs[t5_decoder_first_past_input_idx + i] = past;
   }
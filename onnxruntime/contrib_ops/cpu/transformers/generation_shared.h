@@ -88,8 +88,8 @@ struct ISamplingState {
   size_t temp_storage_bytes;
   std::default_random_engine generator;
 
-  gsl::span<T> sorted_scores;
-  gsl::span<T> cumulative_probs;
+  gsl::span<int32_t> sorted_indices;  // CPU only. Token ids of each row, partially sorted by probability.
+  gsl::span<T> cumulative_probs;      // CPU only. Probabilities of the tokens of each row.
 };
 
 struct ISequences {
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/parse_string.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/session/onnxruntime_run_options_config_keys.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Passes the tokens of each generation step to the callback set in the run options.
+// See kOrtRunOptionsConfigGenerationStreamCallback for the callback contract.
+class GenerationStreamer {
+ public:
+  using Callback = int (*)(void* user_data, const int32_t* next_tokens, const int32_t* beam_indices, size_t count,
+                           int64_t sequence_length);
+
+  Status Init(const OpKernelContextInternal& context) {
+    const RunOptions* run_options = context.GetRunOptions();
+    if (run_options == nullptr) {
+      return Status::OK();
+    }
+
+    const auto& config = run_options->config_options;
+    size_t address = 0;
+    const std::string callback = config.GetConfigOrDefault(kOrtRunOptionsConfigGenerationStreamCallback, "");
+    if (!callback.empty()) {
+      ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(callback, address));
+      callback_ = reinterpret_cast<Callback>(address);
+    }
+
+    const std::string user_data = config.GetConfigOrDefault(kOrtRunOptionsConfigGenerationStreamCallbackUserData, "");
+    if (!user_data.empty()) {
+      ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(user_data, address));
+      user_data_ = reinterpret_cast<void*>(address);
+    }
+
+    return Status::OK();
+  }
+
+  // Passes the tokens appended to the sequences, and returns false when the callback asks to stop.
+  // beam_indices is empty for greedy search and sampling.
+  bool Stream(gsl::span<const int32_t> next_tokens, gsl::span<const int32_t> beam_indices,
+              int sequence_length) const {
+    if (callback_ == nullptr) {
+      return true;
+    }
+
+    return callback_(user_data_, next_tokens.data(), beam_indices.empty() ? nullptr : beam_indices.data(),
+                     next_tokens.size(), static_cast<int64_t>(sequence_length)) == 0;
+  }
+
+ private:
+  Callback callback_ = nullptr;
+  void* user_data_ = nullptr;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
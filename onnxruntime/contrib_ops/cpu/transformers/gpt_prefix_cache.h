@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace transformers {
+
+// Caches the past state computed for the prompts of earlier generation calls, so a later call whose prompt starts
+// with the same tokens (e.g. a shared system prompt) only computes the past state of the remaining tokens.
+// The least recently used entries are evicted once the total size exceeds the budget. Thread safe.
+// The float past state can be stored as int8, with a scale per block of tokens of each head, to fit more prompts.
+class GptPrefixCache {
+ public:
+  // The number of tokens of a head sharing a scale when the past state is stored as int8.
+  static constexpr size_t kQuantizationBlockSize = 32;
+
+  // The past state of one prompt. layers[i] holds the present output of layer i for the prompt,
+  // with shape (2, num_heads, tokens.size(), head_size). element_size is the size of the elements of the present
+  // output, and the layers hold int8 elements when `scales` isn't empty. scales[i] then holds the scales of
+  // layer i, with shape (2, num_heads, number of blocks of tokens).
+  struct Entry {
+    std::vector<int32_t> tokens;
+    size_t element_size = 0;
+    int64_t num_heads = 0;
+    int64_t head_size = 0;
+    std::vector<std::vector<uint8_t>> layers;
+    std::vector<std::vector<float>> scales;
+
+    size_t SizeInBytes() const {
+      size_t bytes = tokens.size() * sizeof(int32_t);
+      for (const auto& layer : layers) {
+        bytes += layer.size();
+      }
+      for (const auto& layer_scales : scales) {
+        bytes += layer_scales.size() * sizeof(float);
+      }
+      return bytes;
+    }
+  };
+
+  GptPrefixCache(size_t max_bytes, bool store_int8) : max_bytes_(max_bytes), store_int8_(store_int8) {}
+
+  bool StoresInt8() const {
+    return store_int8_;
+  }
+
+  // Stores the `tokens` x `head_size` values of a head as int8 with a symmetric scale per block of tokens.
+  static void QuantizeHead(const float* values, size_t tokens, size_t head_size, int8_t* quantized, float* scales) {
+    const size_t count = tokens * head_size;
+    const size_t block_count = kQuantizationBlockSize * head_size;
+    for (size_t start = 0; start < count; start += block_count) {
+      const size_t n = std::min(block_count, count - start);
+      float min_value;
+      float max_value;
+      MlasFindMinMaxElement(values + start, &min_value, &max_value, n);
+      const float scale = std::max(std::fabs(min_value), std::fabs(max_value)) / 127.0f;
+      *scales++ = scale;
+      MlasQuantizeLinear<int8_t>(values + start, quantized + start, n, scale == 0.0f ? 1.0f : scale, 0);
+    }
+  }
+
+  // Restores the values of the first `tokens` tokens of a head stored by QuantizeHead.
+  static void DequantizeHead(const int8_t* quantized, const float* scales, size_t tokens, size_t head_size,
+                             float* values) {
+    for (size_t token = 0; token < tokens; token++) {
+      const float scale = scales[token / kQuantizationBlockSize];
+      for (size_t i = 0; i < head_size; i++) {
+        values[i] = scale * static_cast<float>(quantized[i]);
+      }
+      quantized += head_size;
+      values += head_size;
+    }
+  }
+
+  // Returns the length of the longest cached prefix of `tokens`, and the entry holding it in `entry`.
+  // The entry stays valid while `entry` references it, even if it is evicted meanwhile.
+  size_t Lookup(gsl::span<const int32_t> tokens, std::shared_ptr<const Entry>& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t best_length = 0;
+    auto best = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      const auto& cached = (*it)->tokens;
+      const size_t length = std::min(cached.size(), tokens.size());
+      const size_t matched = static_cast<size_t>(
+          std::mismatch(cached.begin(), cached.begin() + length, tokens.begin()).first - cached.begin());
+      if (matched > best_length) {
+        best_length = matched;
+        best = it;
+      }
+    }
+
+    if (best == entries_.end()) {
+      entry.reset();
+      return 0;
+    }
+
+    entries_.splice(entries_.begin(), entries_, best);
+    entry = entries_.front();
+    return best_length;
+  }
+
+  // Adds an entry, replacing the entries whose tokens are a prefix of its tokens.
+  // Nothing is added if the entry exceeds the budget or a cached entry already covers its tokens.
+  void Insert(std::shared_ptr<const Entry> entry) {
+    const size_t entry_bytes = entry->SizeInBytes();
+    if (entry_bytes > max_bytes_) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      const auto& cached = (*it)->tokens;
+      const auto& tokens = entry->tokens;
+      if (cached.size() >= tokens.size() && std::equal(tokens.begin(), tokens.end(), cached.begin())) {
+        return;
+      }
+
+      if (cached.size() < tokens.size() && std::equal(cached.begin(), cached.end(), tokens.begin())) {
+        total_bytes_ -= (*it)->SizeInBytes();
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    entries_.push_front(std::move(entry));
+    total_bytes_ += entry_bytes;
+    while (total_bytes_ > max_bytes_) {
+      total_bytes_ -= entries_.back()->SizeInBytes();
+      entries_.pop_back();
+    }
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GptPrefixCache);
+
+  const size_t max_bytes_;
+  const bool store_int8_;
+  std::mutex mutex_;
+  // most recently used first
+  std::list<std::shared_ptr<const Entry>> entries_;
+  size_t total_bytes_ = 0;
+};
+
+}  // namespace transformers
+}  // namespace contrib
+}  // namespace onnxruntime
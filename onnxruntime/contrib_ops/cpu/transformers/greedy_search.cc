@@ -13,6 +13,7 @@
 #include <functional>
 #include <string>
 #include <utility>
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/providers/cpu/math/top_k.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -26,6 +27,7 @@
 #include "core/framework/session_options.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/ort_value.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/common/gsl.h"
 #include "contrib_ops/cpu/transformers/greedy_search.h"
 #include "contrib_ops/cpu/transformers/logits_processor.h"
@@ -117,6 +119,15 @@ Status GreedySearch::SetupSubgraphExecutionInfo(const SessionState& session_stat
 
       gpt_subgraph_ = std::move(res.second);
       decoder_feeds_fetches_manager_ = gpt_subgraph_->GetFeedsFetchesManager();
+
+      const size_t prefix_cache_max_bytes = ParseStringWithClassicLocale<size_t>(
+          session_state.GetSessionOptions().config_options.GetConfigOrDefault(
+              kOrtSessionOptionsConfigGenerationPrefixCacheMaxBytes, "0"));
+      if (prefix_cache_max_bytes > 0) {
+        const bool prefix_cache_int8 = session_state.GetSessionOptions().config_options.GetConfigOrDefault(
+                                           kOrtSessionOptionsConfigGenerationPrefixCacheInt8, "0") == "1";
+        prefix_cache_ = std::make_unique<GptPrefixCache>(prefix_cache_max_bytes, prefix_cache_int8);
+      }
     } else if (attribute_name == "init_decoder") {
       ORT_ENFORCE(init_run_gpt_subgraph_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
       // TODO (hasesh): If 'init_decoder' is present, then we update 'parameters_' again based on its subgraph (it would have been
@@ -207,6 +218,7 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
       ORT_RETURN_IF_ERROR(impl.InitializeCuda(reorder_past_state_func_, cuda_device_prop_, cuda_device_arch_));
 #endif
       ORT_RETURN_IF_ERROR(impl.Initialize());
+      impl.SetPrefixCache(prefix_cache_.get());
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
     } else {
@@ -231,6 +243,7 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
       ORT_RETURN_IF_ERROR(impl.InitializeCuda(reorder_past_state_func_, cuda_device_prop_, cuda_device_arch_));
 #endif
       ORT_RETURN_IF_ERROR(impl.Initialize());
+      impl.SetPrefixCache(prefix_cache_.get());
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
     }
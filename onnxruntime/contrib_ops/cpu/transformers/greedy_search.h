@@ -12,6 +12,7 @@
 #include "contrib_ops/cpu/transformers/subgraph_t5_encoder.h"
 #include "contrib_ops/cpu/transformers/subgraph_t5_decoder.h"
 #include "contrib_ops/cpu/transformers/generation_device_helper.h"
+#include "contrib_ops/cpu/transformers/gpt_prefix_cache.h"
 
 namespace onnxruntime {
 class FeedsFetchesManager;
@@ -124,6 +125,9 @@ class GreedySearch : public IControlFlowKernel {
   FeedsFetchesManager* decoder_feeds_fetches_manager_;
   FeedsFetchesManager* init_run_decoder_feeds_fetches_manager_;
 
+  // Past state of earlier prompts. nullptr if disabled.
+  std::unique_ptr<GptPrefixCache> prefix_cache_;
+
   IConsoleDumper* dumper_;
 
   GreedySearchParameters parameters_;
@@ -47,8 +47,8 @@ struct SamplingState : public ISamplingState<T> {
         this->h_sampled_all[i] = distribution(this->generator);
       }
     } else {
-      // TODO: Some buffer can be reused for CPU
-      this->sorted_scores = AllocateBuffer<T>(cpu_allocator, sorted_scores_buffer_, SafeInt<size_t>(total_count));
+      this->sorted_indices = AllocateBuffer<int32_t>(cpu_allocator, sorted_indices_buffer_,
+                                                     SafeInt<size_t>(total_count));
       this->cumulative_probs = AllocateBuffer<T>(cpu_allocator, cumulative_probs_buffer_, SafeInt<size_t>(total_count));
     }
   }
@@ -65,7 +65,7 @@ struct SamplingState : public ISamplingState<T> {
   BufferUniquePtr h_sampled_all_buffer_;
   BufferUniquePtr d_indices_buffer_;
   BufferUniquePtr d_presence_mask_buffer_;
-  BufferUniquePtr sorted_scores_buffer_;
+  BufferUniquePtr sorted_indices_buffer_;
   BufferUniquePtr cumulative_probs_buffer_;
 };
 
@@ -227,6 +227,7 @@ Status GreedySearchBase<T, ParametersT>::Initialize() {
   ORT_RETURN_IF_ERROR(CheckScalarInput("min_length", 2, false));
 
   ORT_RETURN_IF_ERROR(CheckInputs(this->context_));
+  ORT_RETURN_IF_ERROR(this->streamer_.Init(this->context_));
 
   // This flag will be updated later when the scores output exists.
   parameters_->output_scores = false;
@@ -234,7 +235,7 @@ Status GreedySearchBase<T, ParametersT>::Initialize() {
   if (!this->IsCuda()) {
     // Logits processor is used in CPU only. In CUDA, cuda kernels are used instead.
     // Initialize processors after CheckInputs so that parameters_->vocab_mask is ready.
-    this->logits_processors_.Init(*parameters_);
+    this->logits_processors_.Init(*parameters_, this->thread_pool_);
   }
 
   return Status::OK();
@@ -3,9 +3,13 @@
 
 #pragma once
 #include <algorithm>
+#include <cstring>
+#include <numeric>
 #include <vector>
 
+#include "core/common/narrow.h"
 #include "core/common/span_utils.h"
+#include "contrib_ops/cpu/transformers/gpt_prefix_cache.h"
 #include "contrib_ops/cpu/transformers/greedy_search_impl_base.h"
 
 namespace onnxruntime {
@@ -21,6 +25,62 @@ std::pair<Status, std::unique_ptr<GptSubgraph>> CreateGptSubgraphAndUpdateParame
     const std::string& attribute_name,
     const SessionState& subgraph_session_state,
     /*out*/ BeamSearchParameters& parameters);
+
+// Copies the given rows of dimension `axis` of `source` into a new tensor.
+inline void GatherRows(const Tensor& source, size_t axis, gsl::span<const int32_t> rows,
+                       AllocatorPtr allocator, OrtValue& target) {
+  const TensorShape& shape = source.Shape();
+  TensorShapeVector dims = shape.AsShapeVector();
+  dims[axis] = static_cast<int64_t>(rows.size());
+  Tensor::InitOrtValue(source.DataType(), TensorShape(dims), allocator, target);
+
+  const size_t outer = onnxruntime::narrow<size_t>(shape.SizeToDimension(axis));
+  const size_t source_rows = onnxruntime::narrow<size_t>(shape[axis]);
+  const size_t row_bytes = onnxruntime::narrow<size_t>(shape.SizeFromDimension(axis + 1)) *
+                           source.DataType()->Size();
+  const auto* src = static_cast<const uint8_t*>(source.DataRaw());
+  auto* dst = static_cast<uint8_t*>(target.GetMutable<Tensor>()->MutableDataRaw());
+  for (size_t o = 0; o < outer; o++) {
+    for (int32_t row : rows) {
+      memcpy(dst, src + (o * source_rows + static_cast<size_t>(row)) * row_bytes, row_bytes);
+      dst += row_bytes;
+    }
+  }
+}
+
+// Copies the rows of `source` into the given rows of dimension 0 of a new zero filled tensor of `num_rows` rows.
+inline void ScatterRows(const Tensor& source, gsl::span<const int32_t> rows, int64_t num_rows,
+                        AllocatorPtr allocator, OrtValue& target) {
+  const TensorShape& shape = source.Shape();
+  TensorShapeVector dims = shape.AsShapeVector();
+  dims[0] = num_rows;
+  Tensor::InitOrtValue(source.DataType(), TensorShape(dims), allocator, target);
+
+  const size_t row_bytes = onnxruntime::narrow<size_t>(shape.SizeFromDimension(1)) * source.DataType()->Size();
+  const auto* src = static_cast<const uint8_t*>(source.DataRaw());
+  auto* dst = static_cast<uint8_t*>(target.GetMutable<Tensor>()->MutableDataRaw());
+  memset(dst, 0, target.Get<Tensor>().SizeInBytes());
+  for (int32_t row : rows) {
+    memcpy(dst + static_cast<size_t>(row) * row_bytes, src, row_bytes);
+    src += row_bytes;
+  }
+}
+
+// Copies the columns of the 2-D tensor `source` from column `start` on into a new tensor.
+inline void SliceColumns(const Tensor& source, int64_t start, AllocatorPtr allocator, OrtValue& target) {
+  const TensorShape& shape = source.Shape();
+  Tensor::InitOrtValue(source.DataType(), TensorShape({shape[0], shape[1] - start}), allocator, target);
+
+  const size_t element_size = source.DataType()->Size();
+  const size_t row_bytes = onnxruntime::narrow<size_t>(shape[1] - start) * element_size;
+  const auto* src = static_cast<const uint8_t*>(source.DataRaw()) + onnxruntime::narrow<size_t>(start) * element_size;
+  auto* dst = static_cast<uint8_t*>(target.GetMutable<Tensor>()->MutableDataRaw());
+  for (int64_t row = 0; row < shape[0]; row++) {
+    memcpy(dst, src, row_bytes);
+    src += onnxruntime::narrow<size_t>(shape[1]) * element_size;
+    dst += row_bytes;
+  }
+}
 }  // namespace gpt_details
 
 // Greedy search implementation for GPT-2 model.
@@ -79,6 +139,9 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   }
 #endif
 
+  // The prompt past state of the calls is cached in `prefix_cache` if it's not nullptr.
+  void SetPrefixCache(GptPrefixCache* prefix_cache) { prefix_cache_ = prefix_cache; }
+
   // Execute beam search in iterations util stopping criteria is reached.
   // In each iteration, GPT subgraph is called, and next token for each sequence is generated.
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
@@ -101,6 +164,20 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Replaces the empty past state in the initial feeds with the cached past state of the longest prompt prefix that
+  // all rows share with cached prompts, and removes the prefix from the input ids and position ids.
+  // `cached_lengths` receives the cached prefix length of each row, and is empty if the prompts can't be cached.
+  void SeedPastStateFromPrefixCache(std::vector<OrtValue>& feeds,
+                                    gsl::span<const int32_t> input_ids,
+                                    std::vector<size_t>& cached_lengths);
+
+  // Adds the past state of the prompts that aren't cached yet from the presents of the first decoding run.
+  void InsertIntoPrefixCache(const std::vector<OrtValue>& fetches,
+                             gsl::span<const int32_t> input_ids,
+                             gsl::span<const size_t> cached_lengths);
+
+  GptPrefixCache* prefix_cache_ = nullptr;
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
@@ -187,6 +264,168 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             false);
 }
 
+template <typename T, typename ParametersT>
+void GreedySearchGpt<T, ParametersT>::SeedPastStateFromPrefixCache(std::vector<OrtValue>& feeds,
+                                                                   gsl::span<const int32_t> input_ids,
+                                                                   std::vector<size_t>& cached_lengths) {
+  cached_lengths.clear();
+  if (prefix_cache_ == nullptr || this->IsCuda() || gpt_subgraph_.past_present_share_buffer_ ||
+      init_run_gpt_subgraph_ != nullptr) {
+    return;
+  }
+
+  // The past state only depends on the tokens when there is no padding, so the positions are 0, 1, 2, ...
+  gsl::span<const int32_t> attention_mask = feeds[2].Get<Tensor>().DataAsSpan<int32_t>();
+  if (std::any_of(attention_mask.begin(), attention_mask.end(), [](int32_t mask) { return mask != 1; })) {
+    return;
+  }
+
+  const size_t batch_size = static_cast<size_t>(this->parameters_->BatchBeamSize());
+  const size_t sequence_length = static_cast<size_t>(this->parameters_->sequence_length);
+  cached_lengths.resize(batch_size, 0);
+
+  // The last token is always computed to get its logits.
+  size_t prefix_length = sequence_length - 1;
+  std::vector<std::shared_ptr<const GptPrefixCache::Entry>> entries(batch_size);
+  for (size_t row = 0; row < batch_size && prefix_length > 0; row++) {
+    cached_lengths[row] = prefix_cache_->Lookup(input_ids.subspan(row * sequence_length, sequence_length),
+                                                entries[row]);
+    prefix_length = std::min(prefix_length, cached_lengths[row]);
+  }
+
+  if (prefix_length == 0) {
+    return;
+  }
+
+  const int first_past_input_index = gpt_subgraph_.GetFirstPastInputIndex();
+  const Tensor& empty_past = feeds[first_past_input_index].Get<Tensor>();
+  const TensorShape& past_shape = empty_past.Shape();  // (2, B, N, 0, H)
+  const int64_t num_heads = past_shape[2];
+  const int64_t head_size = past_shape[4];
+  const size_t element_size = empty_past.DataType()->Size();
+  for (const auto& entry : entries) {
+    if (entry->element_size != element_size || entry->num_heads != num_heads || entry->head_size != head_size ||
+        entry->layers.size() != static_cast<size_t>(gpt_subgraph_.num_layers)) {
+      return;
+    }
+  }
+
+  const size_t heads = onnxruntime::narrow<size_t>(num_heads);
+  const size_t head_elements = onnxruntime::narrow<size_t>(head_size);
+  const size_t prefix_bytes = prefix_length * head_elements * element_size;
+  for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+    OrtValue past;
+    Tensor::InitOrtValue(empty_past.DataType(),
+                         TensorShape({2, past_shape[1], num_heads, static_cast<int64_t>(prefix_length), head_size}),
+                         this->temp_space_allocator_, past);
+    auto* dst = static_cast<uint8_t*>(past.GetMutable<Tensor>()->MutableDataRaw());
+    for (size_t kv = 0; kv < 2; kv++) {
+      for (size_t row = 0; row < batch_size; row++) {
+        const GptPrefixCache::Entry& entry = *entries[row];
+        const std::vector<uint8_t>& cached = entry.layers[static_cast<size_t>(layer)];
+        if (!entry.scales.empty()) {
+          const size_t head_count = entry.tokens.size() * head_elements;
+          const size_t head_blocks = (entry.tokens.size() + GptPrefixCache::kQuantizationBlockSize - 1) /
+                                     GptPrefixCache::kQuantizationBlockSize;
+          const float* scales = entry.scales[static_cast<size_t>(layer)].data() + kv * heads * head_blocks;
+          const auto* src = reinterpret_cast<const int8_t*>(cached.data()) + kv * heads * head_count;
+          for (size_t head = 0; head < heads; head++) {
+            GptPrefixCache::DequantizeHead(src, scales, prefix_length, head_elements, reinterpret_cast<float*>(dst));
+            src += head_count;
+            scales += head_blocks;
+            dst += prefix_bytes;
+          }
+          continue;
+        }
+
+        const size_t head_bytes = entry.tokens.size() * head_elements * element_size;
+        const uint8_t* src = cached.data() + kv * heads * head_bytes;
+        for (size_t head = 0; head < heads; head++) {
+          memcpy(dst, src, prefix_bytes);
+          src += head_bytes;
+          dst += prefix_bytes;
+        }
+      }
+    }
+    feeds[static_cast<size_t>(first_past_input_index + layer)] = past;
+  }
+
+  // The attention mask keeps covering the whole prompt.
+  for (size_t i = 0; i < 2; i++) {
+    OrtValue suffix;
+    gpt_details::SliceColumns(feeds[i].Get<Tensor>(), static_cast<int64_t>(prefix_length),
+                              this->temp_space_allocator_, suffix);
+    feeds[i] = suffix;
+  }
+}
+
+template <typename T, typename ParametersT>
+void GreedySearchGpt<T, ParametersT>::InsertIntoPrefixCache(const std::vector<OrtValue>& fetches,
+                                                            gsl::span<const int32_t> input_ids,
+                                                            gsl::span<const size_t> cached_lengths) {
+  const size_t sequence_length = static_cast<size_t>(this->parameters_->sequence_length);
+  const size_t first_present_output_index = static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex());
+  for (size_t row = 0; row < cached_lengths.size(); row++) {
+    gsl::span<const int32_t> tokens = input_ids.subspan(row * sequence_length, sequence_length);
+    bool cached = cached_lengths[row] == sequence_length;
+    for (size_t other = 0; other < row && !cached; other++) {
+      cached = std::equal(tokens.begin(), tokens.end(), input_ids.begin() + other * sequence_length);
+    }
+    if (cached) {
+      continue;
+    }
+
+    auto entry = std::make_shared<GptPrefixCache::Entry>();
+    entry->tokens.assign(tokens.begin(), tokens.end());
+    entry->layers.resize(static_cast<size_t>(gpt_subgraph_.num_layers));
+    for (size_t layer = 0; layer < entry->layers.size(); layer++) {
+      const Tensor& present = fetches[first_present_output_index + layer].Get<Tensor>();
+      const TensorShape& present_shape = present.Shape();  // (2, B, N, S, H)
+      if (present_shape[3] != static_cast<int64_t>(sequence_length)) {
+        return;
+      }
+
+      entry->element_size = present.DataType()->Size();
+      entry->num_heads = present_shape[2];
+      entry->head_size = present_shape[4];
+      const size_t num_heads = onnxruntime::narrow<size_t>(present_shape[2]);
+      const size_t head_count = onnxruntime::narrow<size_t>(present_shape.SizeFromDimension(3));
+      std::vector<uint8_t>& buffer = entry->layers[layer];
+      if (prefix_cache_->StoresInt8() && present.IsDataType<float>()) {
+        const size_t head_size = onnxruntime::narrow<size_t>(present_shape[4]);
+        const size_t head_blocks = (sequence_length + GptPrefixCache::kQuantizationBlockSize - 1) /
+                                   GptPrefixCache::kQuantizationBlockSize;
+        entry->scales.resize(entry->layers.size());
+        std::vector<float>& scales = entry->scales[layer];
+        scales.resize(2 * num_heads * head_blocks);
+        buffer.resize(2 * num_heads * head_count);
+        const float* src = present.Data<float>();
+        for (size_t kv = 0; kv < 2; kv++) {
+          for (size_t head = 0; head < num_heads; head++) {
+            const size_t index = kv * num_heads + head;
+            GptPrefixCache::QuantizeHead(src + ((kv * cached_lengths.size() + row) * num_heads + head) * head_count,
+                                         sequence_length, head_size,
+                                         reinterpret_cast<int8_t*>(buffer.data()) + index * head_count,
+                                         scales.data() + index * head_blocks);
+          }
+        }
+        continue;
+      }
+
+      const size_t head_bytes = head_count * entry->element_size;
+      buffer.resize(2 * num_heads * head_bytes);
+      const auto* src = static_cast<const uint8_t*>(present.DataRaw());
+      for (size_t kv = 0; kv < 2; kv++) {
+        memcpy(buffer.data() + kv * num_heads * head_bytes,
+               src + (kv * cached_lengths.size() + row) * num_heads * head_bytes,
+               num_heads * head_bytes);
+      }
+    }
+
+    prefix_cache_->Insert(std::move(entry));
+  }
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
@@ -228,6 +467,10 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
   OrtValue expanded_input_ids_in_cpu;
   ORT_RETURN_IF_ERROR(CreateInitialFeeds(greedy_state.sequence_lengths, expanded_input_ids_in_cpu, feeds, buffer));
 
+  std::vector<size_t> cached_prompt_lengths;
+  SeedPastStateFromPrefixCache(feeds, expanded_input_ids_in_cpu.Get<Tensor>().DataAsSpan<int32_t>(),
+                               cached_prompt_lengths);
+
   if (gpt_subgraph_.past_present_share_buffer_) {  // Reuse past and present
     fetches.reserve(static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()) + gpt_subgraph_.num_layers);
     fetches.resize(gpt_subgraph_.GetFirstPresentOutputIndex(), OrtValue());
@@ -266,6 +509,17 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                        this->temp_space_allocator_->Info(),
                        position_ids);
 
+  // Sequences that are finished are retired from the batch fed to the subgraph between decoding steps, so the
+  // remaining steps only compute the sequences still being generated. active_rows maps every row of the subgraph
+  // batch to its sequence. The logits are scattered back to the full batch, so logits processing and the
+  // greedy state are unchanged.
+  const bool retire_finished_rows = !this->IsCuda() &&
+                                    !gpt_subgraph_.past_present_share_buffer_ &&
+                                    !gpt_subgraph_.has_decoder_masked_attention_;
+  std::vector<int32_t> active_rows(static_cast<size_t>(parameters->BatchBeamSize()));
+  std::iota(active_rows.begin(), active_rows.end(), 0);
+  std::vector<int32_t> active_next_tokens;
+
   int current_length = parameters->sequence_length;
   int iteration_counter = 0;
   while (current_length < parameters->max_length) {
@@ -310,7 +564,16 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     ORT_RETURN_IF_ERROR(status);
 
-    const OrtValue& logits = fetches[0];
+    if (iteration_counter == 1 && !cached_prompt_lengths.empty()) {
+      InsertIntoPrefixCache(fetches, input_ids, cached_prompt_lengths);
+    }
+
+    OrtValue logits = fetches[0];
+    if (active_rows.size() < static_cast<size_t>(parameters->BatchBeamSize())) {
+      OrtValue active_logits = logits;
+      gpt_details::ScatterRows(active_logits.Get<Tensor>(), active_rows, parameters->BatchBeamSize(),
+                               this->temp_space_allocator_, logits);
+    }
     gsl::span<int32_t> next_tokens;
 
     ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
@@ -320,6 +583,10 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                                                 iteration_counter,
                                                 parameters->eos_token_id));
 
+    if (!this->streamer_.Stream(next_tokens, {}, current_length + 1)) {
+      break;
+    }
+
     // When all batches are finished, stop earlier to avoid wasting computation.
     gsl::span<bool>& eos_meet = greedy_state.eos_meet;
     size_t batch_id = 0;
@@ -359,9 +626,57 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     if (current_length < parameters->max_length) {
       bool increase_position = (iteration_counter > 1);
 
+      if (retire_finished_rows) {
+        // rows of the current subgraph batch whose sequence is still being generated
+        std::vector<int32_t> kept_rows;
+        kept_rows.reserve(active_rows.size());
+        for (size_t row = 0; row < active_rows.size(); row++) {
+          if (!eos_meet[active_rows[row]]) {
+            kept_rows.push_back(static_cast<int32_t>(row));
+          }
+        }
+
+        if (kept_rows.size() < active_rows.size()) {
+          for (int i = 0; i < gpt_subgraph_.num_layers; i++) {
+            OrtValue& present = fetches[gpt_subgraph_.GetFirstPresentOutputIndex() + i];
+            OrtValue kept_present;
+            gpt_details::GatherRows(present.Get<Tensor>(), 1, kept_rows, this->temp_space_allocator_, kept_present);
+            present = kept_present;
+          }
+
+          OrtValue kept_mask;
+          gpt_details::GatherRows(feeds[2].Get<Tensor>(), 0, kept_rows, this->temp_space_allocator_, kept_mask);
+          feeds[2] = kept_mask;
+
+          // kept_rows is increasing, so the positions can be compacted in place
+          gsl::span<int32_t> positions = greedy_state.next_positions;
+          for (size_t row = 0; row < kept_rows.size(); row++) {
+            positions[row] = positions[kept_rows[row]];
+            active_rows[row] = active_rows[kept_rows[row]];
+          }
+          active_rows.resize(kept_rows.size());
+
+          int64_t position_dims[] = {static_cast<int64_t>(active_rows.size()), 1};
+          Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(),
+                               TensorShape(&position_dims[0], 2),
+                               positions.data(),
+                               this->temp_space_allocator_->Info(),
+                               position_ids);
+        }
+      }
+
+      gsl::span<const int32_t> subgraph_next_tokens = ReinterpretAsSpan<const int32_t>(next_tokens);
+      if (active_rows.size() < next_tokens.size()) {
+        active_next_tokens.resize(active_rows.size());
+        for (size_t row = 0; row < active_rows.size(); row++) {
+          active_next_tokens[row] = next_tokens[active_rows[row]];
+        }
+        subgraph_next_tokens = active_next_tokens;
+      }
+
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
-                                      ReinterpretAsSpan<const int32_t>(next_tokens),
+                                      subgraph_next_tokens,
                                       current_length - 1));
     }
     if (gpt_subgraph_.past_present_share_buffer_) {
@@ -31,6 +31,14 @@ void NextTokenScores<T>::SetScore(int token_id, T score) {
   }
 }
 
+template <typename T>
+void ILogitsProcessor<T>::Process(const ISequences* sequences,
+                                  NextTokenScores<T>& next_token_scores) {
+  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
+    ProcessRow(sequences, i, 0, next_token_scores.GetScores(i));
+  }
+}
+
 #ifdef DEBUG_GENERATION
 template <typename T>
 void DumpScores(const char* name, const NextTokenScores<T>& next_token_scores) {
@@ -45,15 +53,14 @@ MinLengthLogitsProcessor<T>::MinLengthLogitsProcessor(int min_length, int eos_to
     : min_length_(min_length), eos_token_id_(eos_token_id) {}
 
 template <typename T>
-void MinLengthLogitsProcessor<T>::Process(const ISequences* sequences,
-                                          NextTokenScores<T>& next_token_scores) {
-  if (sequences->GetSequenceLength() < min_length_) {
-    next_token_scores.SetScore(eos_token_id_, std::numeric_limits<T>::lowest());
+void MinLengthLogitsProcessor<T>::ProcessRow(const ISequences* sequences,
+                                             int /*batch_beam_index*/,
+                                             int first_token_id,
+                                             gsl::span<T> scores) {
+  const int index = eos_token_id_ - first_token_id;
+  if (index >= 0 && index < static_cast<int>(scores.size()) && sequences->GetSequenceLength() < min_length_) {
+    scores[index] = std::numeric_limits<T>::lowest();
   }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("MinLengthLogitsProcessor", next_token_scores);
-#endif
 }
 
 template <typename T>
@@ -61,31 +68,23 @@ RepetitionPenaltyLogitsProcessor<T>::RepetitionPenaltyLogitsProcessor(float pena
 }
 
 template <typename T>
-void RepetitionPenaltyLogitsProcessor<T>::Process(const ISequences* sequences,
-                                                  NextTokenScores<T>& next_token_scores) {
-  const int batch_beam_size = next_token_scores.batch_beam_size;
-  for (int i = 0; i < batch_beam_size; i++) {
-    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-    gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-
-    // Find unique word IDs in sequence.
-    std::unordered_set<int32_t> unique_word_ids;
-    for (const auto& word_id : sequence) {
-      unique_word_ids.insert(word_id);
-    }
-
-    for (const int32_t word_id : unique_word_ids) {
-      T score = beam_token_scores[word_id];
-
-      // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
-      // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
-      beam_token_scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
-    }
+void RepetitionPenaltyLogitsProcessor<T>::ProcessRow(const ISequences* sequences,
+                                                     int batch_beam_index,
+                                                     int /*first_token_id*/,
+                                                     gsl::span<T> scores) {
+  // Find unique word IDs in sequence.
+  gsl::span<const int32_t> sequence = sequences->GetSequence(batch_beam_index);
+  InlinedVector<int32_t> unique_word_ids(sequence.begin(), sequence.end());
+  std::sort(unique_word_ids.begin(), unique_word_ids.end());
+  unique_word_ids.erase(std::unique(unique_word_ids.begin(), unique_word_ids.end()), unique_word_ids.end());
+
+  for (const int32_t word_id : unique_word_ids) {
+    T score = scores[word_id];
+
+    // If score < 0, then repetition penalty > 1.0 has to multiplied to reduce the previous token probability,
+    // This assumes that scores are either positive (like ctrl) or negative (like GPT-2), but not a mixture.
+    scores[word_id] = (score < 0 ? score * penalty_ : score / penalty_);
   }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("RepetitionPenaltyLogitsProcessor", next_token_scores);
-#endif
 }
 
 template <typename T>
@@ -93,40 +92,29 @@ NoRepeatNGramLogitsProcessor<T>::NoRepeatNGramLogitsProcessor(int ngram_size) :
 }
 
 template <typename T>
-void NoRepeatNGramLogitsProcessor<T>::Process(const ISequences* sequences,
-                                              NextTokenScores<T>& next_token_scores) {
+void NoRepeatNGramLogitsProcessor<T>::ProcessRow(const ISequences* sequences,
+                                                 int batch_beam_index,
+                                                 int /*first_token_id*/,
+                                                 gsl::span<T> scores) {
   if (ngram_size_ == 0 || ngram_size_ > sequences->GetSequenceLength()) {
     return;
   }
 
   const gsl::index prefix_length = static_cast<gsl::index>(ngram_size_) - 1;
-  int batch_beam_size = next_token_scores.batch_beam_size;
-
-  for (int i = 0; i < batch_beam_size; i++) {
-    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-    gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-
-    gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
-    ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
-
-    std::unordered_set<int32_t> blocked_word_ids;
-    for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
-      // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
-      // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
-      //                  and list of last word of NGram as value) for fast matching.
-      if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
-        blocked_word_ids.insert(sequence[static_cast<gsl::index>(j) + prefix_length]);
-      }
-    }
-
-    for (const int32_t word_id : blocked_word_ids) {
-      beam_token_scores[word_id] = std::numeric_limits<T>::lowest();
+  gsl::span<const int32_t> sequence = sequences->GetSequence(batch_beam_index);
+
+  gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
+  ORT_ENFORCE(prefix.size() == narrow<size_t>(prefix_length));
+
+  // Blocking a word is idempotent, so the words are blocked as they are found.
+  for (int j = 0; j <= static_cast<int>(sequence.size()) - ngram_size_; j++) {
+    // Here we use naive algorithm for matching. The complexity is O(batch_beam_size * ngram_size * sequence_length)
+    // TODO(tianleiwu): build N-Gram index (hash table with prefix of length NGram - 1 as key,
+    //                  and list of last word of NGram as value) for fast matching.
+    if (ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
+      scores[sequence[static_cast<gsl::index>(j) + prefix_length]] = std::numeric_limits<T>::lowest();
     }
   }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("NoRepeatNGramLogitsProcessor", next_token_scores);
-#endif
 }
 
 template <typename T>
@@ -135,60 +123,46 @@ VocabMaskLogitsProcessor<T>::VocabMaskLogitsProcessor(const gsl::span<const int3
 }
 
 template <typename T>
-void VocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                          NextTokenScores<T>& next_token_scores) {
+void VocabMaskLogitsProcessor<T>::ProcessRow(const ISequences* /*sequences*/,
+                                             int /*batch_beam_index*/,
+                                             int first_token_id,
+                                             gsl::span<T> scores) {
   assert(!vocab_mask_.empty());
 
   // Process vocabulary mask and set tokens with mask value 0 to -inf.
-  T* p = next_token_scores.scores.data();
-  // next_token_scores shape (batch_size * num_beams, vocab_size)
   // vocab_mask shape (vocab_size).
-  for (int i = 0; i < next_token_scores.batch_beam_size; i++) {
-    for (int j = 0; j < next_token_scores.vocab_size; j++, p++) {
-      if (vocab_mask_[j] == 0) {
-        *p = std::numeric_limits<T>::lowest();
-      }
-    }
+  const int32_t* mask = vocab_mask_.data() + first_token_id;
+  T* p = scores.data();
+  for (size_t j = 0; j < scores.size(); j++) {
+    p[j] = mask[j] == 0 ? std::numeric_limits<T>::lowest() : p[j];
   }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("VocabMaskLogitsProcessor", next_token_scores);
-#endif
 }
 
 template <typename T>
 PrefixVocabMaskLogitsProcessor<T>::PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& prefix_vocab_mask,
-                                                                  int batch_size)
+                                                                  int batch_size,
+                                                                  int num_beams)
     : prefix_vocab_mask_(prefix_vocab_mask),
-      batch_size_(batch_size) {
+      batch_size_(batch_size),
+      num_beams_(num_beams) {
 }
 
 template <typename T>
-void PrefixVocabMaskLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                                NextTokenScores<T>& next_token_scores) {
+void PrefixVocabMaskLogitsProcessor<T>::ProcessRow(const ISequences* /*sequences*/,
+                                                   int batch_beam_index,
+                                                   int first_token_id,
+                                                   gsl::span<T> scores) {
   assert(!prefix_vocab_mask_.empty());
 
-  // next_token_scores shape (batch_size * num_beams, vocab_size)
-  int num_beams = next_token_scores.batch_beam_size / batch_size_;
-  assert(num_beams * batch_size_ == next_token_scores.batch_beam_size);
-
   // Process prefix vocabulary mask and set tokens with mask value 0 to -inf.
   // prefix_vocab_mask shape (batch_size, vocab_size).
-  T* p = next_token_scores.scores.data();
-  for (int i = 0; i < batch_size_; i++) {
-    size_t prefix_vocab_mask_offset = SafeInt<size_t>(i) * next_token_scores.vocab_size;
-    for (int j = 0; j < num_beams; j++) {
-      for (int k = 0; k < next_token_scores.vocab_size; k++, p++) {
-        if (prefix_vocab_mask_[prefix_vocab_mask_offset + static_cast<size_t>(k)] == 0) {
-          *p = std::numeric_limits<T>::lowest();
-        }
-      }
-    }
+  const size_t vocab_size = prefix_vocab_mask_.size() / static_cast<size_t>(batch_size_);
+  const int32_t* mask = prefix_vocab_mask_.data() + static_cast<size_t>(batch_beam_index / num_beams_) * vocab_size +
+                        first_token_id;
+  T* p = scores.data();
+  for (size_t j = 0; j < scores.size(); j++) {
+    p[j] = mask[j] == 0 ? std::numeric_limits<T>::lowest() : p[j];
   }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("PrefixVocabMaskLogitsProcessor", next_token_scores);
-#endif
 }
 
 template <typename T>
@@ -196,46 +170,50 @@ TemperatureLogitsProcessor<T>::TemperatureLogitsProcessor(float temperature) : t
 }
 
 template <typename T>
-void TemperatureLogitsProcessor<T>::Process(const ISequences* /*sequences*/,
-                                            NextTokenScores<T>& next_token_scores) {
+void TemperatureLogitsProcessor<T>::ProcessRow(const ISequences* /*sequences*/,
+                                               int /*batch_beam_index*/,
+                                               int /*first_token_id*/,
+                                               gsl::span<T> scores) {
   if (temperature_ == 1.0f) {
     return;
   }
 
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p /= temperature_;
-    ++p;
+  T* p = scores.data();
+  for (size_t j = 0; j < scores.size(); j++) {
+    p[j] /= temperature_;
   }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("TemperatureLogitsProcessor", next_token_scores);
-#endif
 }
 
 template <typename T>
 PresencePenaltyLogitsProcessor<T>::PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                                                  float presence_penalty)
-    : presence_mask_(presence_mask), presence_penalty_(presence_penalty) {
+                                                                  float presence_penalty,
+                                                                  int batch_size,
+                                                                  int num_beams)
+    : presence_mask_(presence_mask),
+      presence_penalty_(presence_penalty),
+      batch_size_(batch_size),
+      num_beams_(num_beams) {
 }
 
 template <typename T>
-void PresencePenaltyLogitsProcessor<T>::Process(const ISequences*,
-                                                NextTokenScores<T>& next_token_scores) {
+void PresencePenaltyLogitsProcessor<T>::ProcessRow(const ISequences* /*sequences*/,
+                                                   int batch_beam_index,
+                                                   int first_token_id,
+                                                   gsl::span<T> scores) {
   if (presence_penalty_ == 0.0f) {
     return;
   }
 
   assert(!presence_mask_.empty());
 
-  T* p = next_token_scores.scores.data();
-  for (size_t i = 0; i < next_token_scores.scores.size(); i++) {
-    *p -= presence_mask_[i] * presence_penalty_;
+  // presence_mask shape (batch_size, vocab_size).
+  const size_t vocab_size = presence_mask_.size() / static_cast<size_t>(batch_size_);
+  const int32_t* mask = presence_mask_.data() + static_cast<size_t>(batch_beam_index / num_beams_) * vocab_size +
+                        first_token_id;
+  T* p = scores.data();
+  for (size_t j = 0; j < scores.size(); j++) {
+    p[j] -= mask[j] * presence_penalty_;
   }
-
-#ifdef DEBUG_GENERATION
-  DumpScores("PresencePenaltyLogitsProcessor", next_token_scores);
-#endif
 }
 
 template <typename T>
@@ -243,8 +221,10 @@ TimestampLogitsProcessor<T>::TimestampLogitsProcessor(int eos_token_id, int max_
     : eos_token_id_(eos_token_id), max_initial_timestamp_index_(max_initial_timestamp_index) {}
 
 template <typename T>
-void TimestampLogitsProcessor<T>::Process(const ISequences* sequences,
-                                          NextTokenScores<T>& next_token_scores) {
+void TimestampLogitsProcessor<T>::ProcessRow(const ISequences* sequences,
+                                             int batch_beam_index,
+                                             int /*first_token_id*/,
+                                             gsl::span<T> beam_token_scores) {
   const int beg_token_id_ = eos_token_id_ + 107;
   const int not_token_id_ = eos_token_id_ + 106;
   const int solm_token_id_ = eos_token_id_ + 105;
@@ -252,137 +232,180 @@ void TimestampLogitsProcessor<T>::Process(const ISequences* sequences,
   constexpr int translate_token_id_ = 50358;
   constexpr int transcribe_token_id_ = 50359;
 
-  const int batch_beam_size = next_token_scores.batch_beam_size;
-  const int vocab_size = next_token_scores.vocab_size;
-  for (int i = 0; i < batch_beam_size; i++) {
-    gsl::span<T> beam_token_scores = next_token_scores.GetScores(i);
-    gsl::span<const int32_t> sequence = sequences->GetSequence(i);
-    const size_t seq_length = sequence.size();
-
-    // Find first timestamp
-    size_t sample_begin = 0;
-    for (size_t j = 0; j < seq_length; j++) {
-      sample_begin++;
-      if (sequence[j] >= beg_token_id_) {
-        break;
-      }
+  const int vocab_size = static_cast<int>(beam_token_scores.size());
+  gsl::span<const int32_t> sequence = sequences->GetSequence(batch_beam_index);
+  const size_t seq_length = sequence.size();
+
+  // Find first timestamp
+  size_t sample_begin = 0;
+  for (size_t j = 0; j < seq_length; j++) {
+    sample_begin++;
+    if (sequence[j] >= beg_token_id_) {
+      break;
+    }
+  }
+
+  // Suppress tokens
+  auto suppress = [&](int token_id) {
+    if (token_id >= 0 && token_id < vocab_size) {
+      beam_token_scores[token_id] = std::numeric_limits<T>::lowest();
     }
+  };
+
+  // Suppress notimestamps and solm tokens
+  suppress(not_token_id_);
+  suppress(solm_token_id_);
 
-    // Suppress tokens
-    for (int j = 0; j < vocab_size; j++) {
-      // Suppress notimestamps and solm tokens
-      if (j == not_token_id_ || j == solm_token_id_) {
+  // Suppress sot, translate and transcribe tokens
+  if (seq_length > sample_begin) {
+    suppress(sot_token_id_);
+    suppress(translate_token_id_);
+    suppress(transcribe_token_id_);
+  }
+
+  // Timestamps should be in pair except the first one
+  const bool last_was_timestamp = seq_length > 0 && sequence.back() >= beg_token_id_;
+  const bool penultimate_was_timestamp = seq_length <= sample_begin || sequence[seq_length - 2] >= beg_token_id_;
+  if (last_was_timestamp) {
+    if (penultimate_was_timestamp) {
+      // If timestamps show up in pair, or it's the first timestamp, no more timestamp is generated
+      for (int j = beg_token_id_; j < vocab_size; j++) {
         beam_token_scores[j] = std::numeric_limits<T>::lowest();
       }
-
-      // Suppress sot, translate and transcribe tokens
-      if (seq_length > sample_begin) {
-        if (j == sot_token_id_ || j == translate_token_id_ || j == transcribe_token_id_) {
-          beam_token_scores[j] = std::numeric_limits<T>::lowest();
-        }
+    } else {
+      // If timestamp doesn't show up in pair, generate timestamp
+      for (int j = 0; j < eos_token_id_; j++) {
+        beam_token_scores[j] = std::numeric_limits<T>::lowest();
       }
     }
+  }
 
-    // Timestamps should be in pair except the first one
-    const bool last_was_timestamp = seq_length > 0 && sequence.back() >= beg_token_id_;
-    const bool penultimate_was_timestamp = seq_length <= sample_begin || sequence[seq_length - 2] >= beg_token_id_;
-    if (last_was_timestamp) {
-      if (penultimate_was_timestamp) {
-        // If timestamps show up in pair, or it's the first timestamp, no more timestamp is generated
-        for (int j = beg_token_id_; j < vocab_size; j++) {
-          beam_token_scores[j] = std::numeric_limits<T>::lowest();
-        }
-      } else {
-        // If timestamp doesn't show up in pair, generate timestamp
-        for (int j = 0; j < eos_token_id_; j++) {
-          beam_token_scores[j] = std::numeric_limits<T>::lowest();
-        }
-      }
+  // Find timestamp tokens
+  std::vector<int32_t> timestamps;
+  for (const auto& word_id : sequence) {
+    if (word_id >= beg_token_id_) {
+      timestamps.push_back(word_id);
     }
+  }
 
-    // Find timestamp tokens
-    std::vector<int32_t> timestamps;
-    for (const auto& word_id : sequence) {
-      if (word_id >= beg_token_id_) {
-        timestamps.push_back(word_id);
-      }
+  // Timestamps will not decrease
+  const size_t timestamps_len = timestamps.size();
+  if (timestamps_len > 0) {
+    int timestamp_last = 0;
+    if (last_was_timestamp && !penultimate_was_timestamp) {
+      // For single timestamp at the end, next timestamp must not be smaller
+      timestamp_last = timestamps.back();
+    } else {
+      // For paired timestamp at the end, next timestamp must be greater
+      timestamp_last = timestamps.back() + 1;
     }
 
-    // Timestamps will not decrease
-    const size_t timestamps_len = timestamps.size();
-    if (timestamps_len > 0) {
-      int timestamp_last = 0;
-      if (last_was_timestamp && !penultimate_was_timestamp) {
-        // For single timestamp at the end, next timestamp must not be smaller
-        timestamp_last = timestamps.back();
-      } else {
-        // For paired timestamp at the end, next timestamp must be greater
-        timestamp_last = timestamps.back() + 1;
-      }
-
-      for (int j = beg_token_id_; j < timestamp_last; j++) {
-        beam_token_scores[j] = std::numeric_limits<T>::lowest();
-      }
+    for (int j = beg_token_id_; j < timestamp_last; j++) {
+      beam_token_scores[j] = std::numeric_limits<T>::lowest();
     }
+  }
 
-    if (seq_length == sample_begin) {
-      const int last_allowed = beg_token_id_ + max_initial_timestamp_index_;
-      for (int j = last_allowed + 1; j < vocab_size; j++) {
-        beam_token_scores[j] = std::numeric_limits<T>::lowest();
-      }
+  if (seq_length == sample_begin) {
+    const int last_allowed = beg_token_id_ + max_initial_timestamp_index_;
+    for (int j = last_allowed + 1; j < vocab_size; j++) {
+      beam_token_scores[j] = std::numeric_limits<T>::lowest();
     }
+  }
 
-    // Caculate logsumexp on timestamps
-    float timestamp_logprob = std::numeric_limits<T>::lowest();
-    {
-      float logsumexp = 0.0f;
-      const float logprob_max = *std::max_element(beam_token_scores.begin() + beg_token_id_, beam_token_scores.end());
-      for (int j = beg_token_id_; j < vocab_size; ++j) {
-        if (beam_token_scores[j] > std::numeric_limits<T>::lowest()) {
-          logsumexp += expf(beam_token_scores[j] - logprob_max);
-        }
-      }
-      if (logsumexp > 0.0f) {
-        timestamp_logprob = logf(logsumexp) + logprob_max;
+  // Caculate logsumexp on timestamps
+  float timestamp_logprob = std::numeric_limits<T>::lowest();
+  {
+    float logsumexp = 0.0f;
+    const float logprob_max = *std::max_element(beam_token_scores.begin() + beg_token_id_, beam_token_scores.end());
+    for (int j = beg_token_id_; j < vocab_size; ++j) {
+      if (beam_token_scores[j] > std::numeric_limits<T>::lowest()) {
+        logsumexp += expf(beam_token_scores[j] - logprob_max);
       }
     }
-
-    const float max_text_token_logprob = *std::max_element(beam_token_scores.begin(), beam_token_scores.begin() + beg_token_id_);
-    if (timestamp_logprob > max_text_token_logprob) {
-      for (int j = 0; j < beg_token_id_; ++j) {
-        beam_token_scores[j] = std::numeric_limits<T>::lowest();
-      }
+    if (logsumexp > 0.0f) {
+      timestamp_logprob = logf(logsumexp) + logprob_max;
     }
   }
 
-#ifdef DEBUG_GENERATION
-  DumpScores("TimestampLogitsProcessor", next_token_scores);
-#endif
+  const float max_text_token_logprob = *std::max_element(beam_token_scores.begin(), beam_token_scores.begin() + beg_token_id_);
+  if (timestamp_logprob > max_text_token_logprob) {
+    for (int j = 0; j < beg_token_id_; ++j) {
+      beam_token_scores[j] = std::numeric_limits<T>::lowest();
+    }
+  }
 }
 
-void LogitsProcessorList::Init(const BeamSearchParameters& parameters) {
-  LogitsProcessorInitImpl<BeamSearchParameters>(parameters);
+void LogitsProcessorList::Init(const BeamSearchParameters& parameters, concurrency::ThreadPool* thread_pool) {
+  LogitsProcessorInitImpl<BeamSearchParameters>(parameters, thread_pool);
 }
 
-void LogitsProcessorList::Init(const GreedySearchParameters& parameters) {
-  LogitsProcessorInitImpl<GreedySearchParameters>(parameters);
+void LogitsProcessorList::Init(const GreedySearchParameters& parameters, concurrency::ThreadPool* thread_pool) {
+  LogitsProcessorInitImpl<GreedySearchParameters>(parameters, thread_pool);
 }
 
-void LogitsProcessorList::Init(const SamplingParameters& parameters) {
-  LogitsProcessorInitImpl<SamplingParameters>(parameters);
+void LogitsProcessorList::Init(const SamplingParameters& parameters, concurrency::ThreadPool* thread_pool) {
+  LogitsProcessorInitImpl<SamplingParameters>(parameters, thread_pool);
 }
 
 void LogitsProcessorList::Process(const ISequences* sequences,
                                   gsl::span<float>& next_token_scores,
                                   int step) {
-  NextTokenScores<float> input_scores = {next_token_scores, batch_beam_size_, vocab_size_};
+  InlinedVector<ILogitsProcessor<float>*> processors;
+  processors.reserve(processor_list_.size());
   for (size_t i = 0; i < processor_list_.size(); i++) {
     // Prefix vocab mask is applied to first iteration only.
     if (step > 1 && processor_list_[i] == prefix_vocab_mask_processor_.get()) {
       continue;
     }
-    processor_list_[i]->Process(sequences, input_scores);
+    processors.push_back(processor_list_[i]);
+  }
+
+  if (processors.empty()) {
+    return;
   }
+
+  // The processors are applied to each row in turn, so the rows can be processed in parallel, and a row is only
+  // loaded from memory once: consecutive element wise processors are applied block by block, where a block of the
+  // row stays in cache, and the other processors only touch the tokens they change.
+  constexpr int kBlockSize = 2048;
+  const int vocab_size = vocab_size_;
+  auto process_rows = [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t row = begin; row < end; row++) {
+      const int batch_beam_index = static_cast<int>(row);
+      gsl::span<float> row_scores = next_token_scores.subspan(static_cast<size_t>(row) * vocab_size, vocab_size);
+      size_t i = 0;
+      while (i < processors.size()) {
+        if (!processors[i]->IsElementWise()) {
+          processors[i]->ProcessRow(sequences, batch_beam_index, 0, row_scores);
+          i++;
+          continue;
+        }
+
+        size_t group_end = i + 1;
+        while (group_end < processors.size() && processors[group_end]->IsElementWise()) {
+          group_end++;
+        }
+
+        for (int first_token_id = 0; first_token_id < vocab_size; first_token_id += kBlockSize) {
+          gsl::span<float> block = row_scores.subspan(first_token_id, std::min(kBlockSize, vocab_size - first_token_id));
+          for (size_t j = i; j < group_end; j++) {
+            processors[j]->ProcessRow(sequences, batch_beam_index, first_token_id, block);
+          }
+        }
+        i = group_end;
+      }
+    }
+  };
+
+  const double cost = static_cast<double>(vocab_size) * sizeof(float);
+  concurrency::ThreadPool::TryParallelFor(thread_pool_, batch_beam_size_,
+                                          TensorOpCost{cost, cost, static_cast<double>(vocab_size) * processors.size()},
+                                          process_rows);
+
+#ifdef DEBUG_GENERATION
+  NextTokenScores<float> input_scores = {next_token_scores, batch_beam_size_, vocab_size_};
+  DumpScores("LogitsProcessorList", input_scores);
+#endif
 }
 
 }  // namespace transformers
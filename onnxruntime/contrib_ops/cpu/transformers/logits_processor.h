@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/inlined_containers.h"
+#include "core/platform/threadpool.h"
 #include "contrib_ops/cpu/transformers/sequences.h"
 #include "contrib_ops/cpu/transformers/beam_search_parameters.h"
 #include "contrib_ops/cpu/transformers/greedy_search_parameters.h"
@@ -31,8 +32,20 @@ class ILogitsProcessor {
  public:
   virtual ~ILogitsProcessor() {}
 
-  virtual void Process(const ISequences* sequences,
-                       NextTokenScores<T>& next_token_scores) = 0;
+  // Processes the scores of all rows.
+  void Process(const ISequences* sequences,
+               NextTokenScores<T>& next_token_scores);
+
+  // Processes the scores of one row, where scores[i] is the score of token first_token_id + i.
+  // Unless the processor is element wise, first_token_id is 0 and scores holds the whole row.
+  virtual void ProcessRow(const ISequences* sequences,
+                          int batch_beam_index,
+                          int first_token_id,
+                          gsl::span<T> scores) = 0;
+
+  // Whether the score of each token is processed independently of the scores of the other tokens,
+  // so a row can be processed in ranges of tokens.
+  virtual bool IsElementWise() const { return false; }
 };
 
 template <typename T>
@@ -40,8 +53,12 @@ class MinLengthLogitsProcessor : public ILogitsProcessor<T> {
  public:
   MinLengthLogitsProcessor(int min_length, int eos_token_id);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
+
+  bool IsElementWise() const override { return true; }
 
  private:
   int min_length_;
@@ -53,8 +70,10 @@ class RepetitionPenaltyLogitsProcessor : public ILogitsProcessor<T> {
  public:
   RepetitionPenaltyLogitsProcessor(float penalty);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
 
  private:
   float penalty_;
@@ -65,8 +84,10 @@ class NoRepeatNGramLogitsProcessor : public ILogitsProcessor<T> {
  public:
   NoRepeatNGramLogitsProcessor(int ngram_size);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
 
  private:
   int ngram_size_;
@@ -77,8 +98,12 @@ class VocabMaskLogitsProcessor : public ILogitsProcessor<T> {
  public:
   VocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
+
+  bool IsElementWise() const override { return true; }
 
  private:
   gsl::span<const int32_t> vocab_mask_;
@@ -87,14 +112,19 @@ class VocabMaskLogitsProcessor : public ILogitsProcessor<T> {
 template <typename T>
 class PrefixVocabMaskLogitsProcessor : public ILogitsProcessor<T> {
  public:
-  PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask, int batch_size);
+  PrefixVocabMaskLogitsProcessor(const gsl::span<const int32_t>& vocab_mask, int batch_size, int num_beams);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
+
+  bool IsElementWise() const override { return true; }
 
  private:
   gsl::span<const int32_t> prefix_vocab_mask_;
   const int batch_size_;
+  const int num_beams_;
 };
 
 template <typename T>
@@ -102,8 +132,12 @@ class TemperatureLogitsProcessor : public ILogitsProcessor<T> {
  public:
   TemperatureLogitsProcessor(float temperature);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
+
+  bool IsElementWise() const override { return true; }
 
  private:
   float temperature_;
@@ -128,14 +162,22 @@ template <typename T>
 class PresencePenaltyLogitsProcessor : public ILogitsProcessor<T> {
  public:
   PresencePenaltyLogitsProcessor(const gsl::span<const int32_t>& presence_mask,
-                                 float presence_penalty);
+                                 float presence_penalty,
+                                 int batch_size,
+                                 int num_beams);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
+
+  bool IsElementWise() const override { return true; }
 
  private:
   gsl::span<const int32_t> presence_mask_;
   float presence_penalty_;
+  const int batch_size_;
+  const int num_beams_;
 };
 
 template <typename T>
@@ -143,8 +185,10 @@ class TimestampLogitsProcessor : public ILogitsProcessor<T> {
  public:
   TimestampLogitsProcessor(int eos_token_id, int max_initial_timestamp_index);
 
-  void Process(const ISequences* sequences,
-               NextTokenScores<T>& next_token_scores) override;
+  void ProcessRow(const ISequences* sequences,
+                  int batch_beam_index,
+                  int first_token_id,
+                  gsl::span<T> scores) override;
 
  private:
   int eos_token_id_;
@@ -154,14 +198,15 @@ class TimestampLogitsProcessor : public ILogitsProcessor<T> {
 class LogitsProcessorList : public ILogitsProcessorList {
  public:
   LogitsProcessorList() = default;
-  void Init(const BeamSearchParameters& parameters);
-  void Init(const GreedySearchParameters& parameters);
-  void Init(const SamplingParameters& parameters);
+  // The rows are processed in parallel in `thread_pool` if it's not nullptr.
+  void Init(const BeamSearchParameters& parameters, concurrency::ThreadPool* thread_pool = nullptr);
+  void Init(const GreedySearchParameters& parameters, concurrency::ThreadPool* thread_pool = nullptr);
+  void Init(const SamplingParameters& parameters, concurrency::ThreadPool* thread_pool = nullptr);
   void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step);
 
  private:
   template <typename GenerationParametersT>
-  void LogitsProcessorInitImpl(const GenerationParametersT& parameters) {
+  void LogitsProcessorInitImpl(const GenerationParametersT& parameters, concurrency::ThreadPool* thread_pool) {
     processor_list_.clear();
 
     if (parameters.repetition_penalty != 1.0f) {  // 1.0 means no penalty
@@ -184,7 +229,8 @@ class LogitsProcessorList : public ILogitsProcessorList {
     if (!parameters.prefix_vocab_mask.empty()) {
       prefix_vocab_mask_processor_ = std::make_unique<
           PrefixVocabMaskLogitsProcessor<float>>(parameters.prefix_vocab_mask,
-                                                 parameters.batch_size);
+                                                 parameters.batch_size,
+                                                 parameters.num_beams);
       processor_list_.push_back(prefix_vocab_mask_processor_.get());
     }
 
@@ -202,7 +248,9 @@ class LogitsProcessorList : public ILogitsProcessorList {
     if (!parameters.presence_mask.empty()) {
       presence_penalty_processor_ = std::make_unique<
           PresencePenaltyLogitsProcessor<float>>(parameters.presence_mask,
-                                                 parameters.presence_penalty);
+                                                 parameters.presence_penalty,
+                                                 parameters.batch_size,
+                                                 parameters.num_beams);
       processor_list_.push_back(presence_penalty_processor_.get());
     }
 
@@ -215,10 +263,12 @@ class LogitsProcessorList : public ILogitsProcessorList {
 
     batch_beam_size_ = parameters.BatchBeamSize();
     vocab_size_ = parameters.vocab_size;
+    thread_pool_ = thread_pool;
   }
 
   int batch_beam_size_;
   int vocab_size_;
+  concurrency::ThreadPool* thread_pool_ = nullptr;
   InlinedVector<ILogitsProcessor<float>*> processor_list_;
 
   std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
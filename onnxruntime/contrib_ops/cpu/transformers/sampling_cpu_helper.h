@@ -6,51 +6,54 @@ namespace onnxruntime {
 namespace contrib {
 namespace SamplingCpuHelper {
 
+// Sets the scores of the tokens outside of the top-p nucleus of a row to the filter value.
+// Visiting the tokens in descending order of probability, a token is kept while the total probability of the tokens
+// before it is below top_p (at most top_p for custom sampling), and the first min_tokens_to_keep tokens are kept.
+// Instead of sorting the whole vocabulary, the most probable tokens are sorted in growing chunks until the first
+// filtered token is found, so usually only a few hundred tokens are sorted.
 template <typename T>
-void filter_scores(std::vector<size_t>& sorted_indice,
-                   gsl::span<T>& next_token_score,
-                   const transformers::IGenerationParameters* parameters,
-                   size_t chunk_offset,
-                   size_t offset) {
-  size_t real_index = sorted_indice[chunk_offset + offset];
-  next_token_score[chunk_offset + real_index] = (T)parameters->filter_value;
-}
-
-template <typename T>
-void cumulate_and_filter_custom(gsl::span<T>& next_token_scores,
-                                gsl::span<T>& cumulative_probs,
-                                const transformers::IGenerationParameters* parameters,
-                                std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] > parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 1);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - 1; j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] > parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j + 1);
+void filter_nucleus(gsl::span<T> next_token_score,
+                    gsl::span<const T> probs,
+                    gsl::span<int32_t> sorted_indices,
+                    const transformers::IGenerationParameters* parameters) {
+  const size_t vocab_size = next_token_score.size();
+  const bool custom = parameters->custom_sampling;
+  const size_t min_tokens_to_keep = custom ? 1 : static_cast<size_t>(std::max(parameters->min_tokens_to_keep, 0));
+  const T top_p = static_cast<T>(parameters->top_p);
+
+  std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
+  auto greater = [&probs](int32_t i1, int32_t i2) { return probs[i1] > probs[i2]; };
+
+  constexpr size_t kFirstChunkSize = 256;
+  size_t sorted = 0;
+  size_t kept = 0;
+  T kept_probs = 0;
+  while (kept == sorted && sorted < vocab_size) {
+    // sorted_indices[0, sorted) already holds the most probable tokens, so the next ones are sorted after them.
+    const size_t chunk_end = std::min(vocab_size, std::max(kFirstChunkSize, sorted * 4));
+    std::partial_sort(sorted_indices.begin() + sorted, sorted_indices.begin() + chunk_end, sorted_indices.end(),
+                      greater);
+    sorted = chunk_end;
+
+    for (; kept < sorted; kept++) {
+      if (kept >= min_tokens_to_keep && (custom ? kept_probs > top_p : kept_probs >= top_p)) {
+        break;
       }
+      kept_probs += probs[sorted_indices[kept]];
     }
   }
-}
 
-template <typename T>
-void cumulate_and_filter(gsl::span<T>& next_token_scores,
-                         gsl::span<T>& cumulative_probs,
-                         const transformers::IGenerationParameters* parameters,
-                         std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] <= 1 - parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset, 0);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - static_cast<size_t>(parameters->min_tokens_to_keep); j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] <= 1 - parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, offset, j);
-      }
-    }
+  if (kept == vocab_size) {
+    return;
+  }
+
+  InlinedVector<T> kept_scores(kept);
+  for (size_t i = 0; i < kept; i++) {
+    kept_scores[i] = next_token_score[sorted_indices[i]];
+  }
+  std::fill(next_token_score.begin(), next_token_score.end(), static_cast<T>(parameters->filter_value));
+  for (size_t i = 0; i < kept; i++) {
+    next_token_score[sorted_indices[i]] = kept_scores[i];
   }
 }
 
@@ -64,55 +67,27 @@ Status Sample(AllocatorPtr& allocator,
               const transformers::IConsoleDumper* dumper) {
   ORT_UNUSED_PARAMETER(dumper);
 
-  gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
-  std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
-
-  std::function<bool(T, T)> predicator;
-  if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
-  } else {
-    predicator = std::less<T>();
-  }
-
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    gsl::span<T> next_token_score = next_token_scores.subspan(i * parameters->vocab_size, parameters->vocab_size);
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_score, &predicator](size_t i1, size_t i2) {
-                return predicator(next_token_score[i1], next_token_score[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
-  }
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("sorted_scores", sorted_scores.data(), parameters->batch_size, parameters->vocab_size);
-  dumper->Print("sorted_indices", sorted_indices.data(), parameters->batch_size, parameters->vocab_size);
-#endif
-
   gsl::span<T>& cumulative_probs = sampling_state->cumulative_probs;
-
   ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
                                     parameters->vocab_size,
-                                    sorted_scores.data(),
+                                    next_token_scores.data(),
                                     cumulative_probs.data(),
                                     false,
                                     thread_pool));
 
-  if (parameters->custom_sampling) {
-    cumulate_and_filter_custom(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  } else {
-    cumulate_and_filter(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  }
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, parameters->batch_size,
+      [&](std::ptrdiff_t i) {
+        const size_t offset = static_cast<size_t>(i) * vocab_size;
+        filter_nucleus<T>(next_token_scores.subspan(offset, vocab_size),
+                          gsl::span<const T>(cumulative_probs.data() + offset, vocab_size),
+                          sampling_state->sorted_indices.subspan(offset, vocab_size),
+                          parameters);
+      });
 
 #ifdef DEBUG_GENERATION
-  dumper->Print("cumulative_probs after filtering", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
+  dumper->Print("probs", cumulative_probs.data(), parameters->batch_size, parameters->vocab_size);
   dumper->Print("next_token_scores after filtering", next_token_scores.data(), parameters->batch_size, parameters->vocab_size);
 #endif
 
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <utility>
 #include "core/framework/framework_common.h"
 #include "core/framework/session_state.h"
@@ -131,6 +132,34 @@ const IExecutionProvider* Subgraph::GetProvider() const {
   return provider;
 }
 
+bool Subgraph::IsOnlyCpuMultiHeadAttentionKeyOrValue(const std::string& input_name) const {
+  if (std::find(subgraph_output_names.begin(), subgraph_output_names.end(), input_name) !=
+      subgraph_output_names.end()) {
+    return false;
+  }
+
+  const auto consumers = subgraph.GetConsumerNodes(input_name);
+  if (consumers.empty()) {
+    return false;
+  }
+
+  for (const Node* consumer : consumers) {
+    if (consumer->OpType() != "MultiHeadAttention" || consumer->Domain() != kMSDomain ||
+        consumer->GetExecutionProviderType() != kCpuExecutionProvider) {
+      return false;
+    }
+
+    const auto& input_defs = consumer->InputDefs();
+    for (size_t i = 0; i < input_defs.size(); i++) {
+      if (input_defs[i]->Exists() && input_defs[i]->Name() == input_name && i != 1 && i != 2) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 Status Subgraph::GetParameters(const ONNX_NAMESPACE::TensorShapeProto* past_shape,
                                const ONNX_NAMESPACE::TensorShapeProto* logits_shape,
                                bool merged_past) {
@@ -70,6 +70,10 @@ class Subgraph {
                                   AllocatorPtr cpu_allocator,
                                   const int32_t init_value);
 
+  // Returns true when the subgraph input is only read as the key or value of MultiHeadAttention nodes run by the
+  // CPU execution provider, which accept a key and value with one batch for the beams of a batch.
+  bool IsOnlyCpuMultiHeadAttentionKeyOrValue(const std::string& input_name) const;
+
   Status AppendBeamWidthAndCacheIndir(std::vector<OrtValue>& feeds,
                                       AllocatorPtr cpu_allocator,
                                       AllocatorPtr default_allocator,
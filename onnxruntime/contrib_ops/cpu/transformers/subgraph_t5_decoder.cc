@@ -30,6 +30,7 @@ namespace transformers {
       past_key_cross_0: (B, num_heads, encode_sequence_length, head_size)
       past_value_cross_0: (B, num_heads, encode_sequence_length, head_size)
       ... (for each cross attention layer)
+      The batch size of past_key_cross_* and past_value_cross_* is batch_size when the beams share them.
 
       past_seq_len: int32 (1) - the length of past sequence(optional)
       num_beams: int32 (1) - the number of beams(optional)
@@ -126,10 +127,22 @@ Status T5DecoderSubgraph::Validate(const std::vector<const NodeArg*>& subgraph_i
   }
 
   is_output_float16_ = (subgraph_outputs[0]->TypeAsProto()->tensor_type().elem_type() == float16_type);
+  share_cross_kv_across_beams_ = CanShareCrossKvAcrossBeams();
 
   return Status::OK();
 }
 
+bool T5DecoderSubgraph::CanShareCrossKvAcrossBeams() const {
+  const int first_cross_input_index = first_past_input_index_ + 2 * num_layers;
+  for (int i = first_cross_input_index; i < first_cross_input_index + 2 * num_layers; i++) {
+    if (!IsOnlyCpuMultiHeadAttentionKeyOrValue(subgraph_input_names[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 // Create inputs for decoder from the following data sources:
 // encoder feeds: encoder_input_ids, encoder_attention_mask, decoder_input_ids (with start tokens)
 // encoder fetches: logits,
@@ -243,6 +256,12 @@ Status T5DecoderSubgraph::CreateInitialFeeds(
       }
       decoder_feeds.push_back(expanded_hidden_states);
     } else {
+      // The beams share the past key/value for cross attention when the decoder supports it, as they are static.
+      if (share_cross_kv_across_beams_ && j >= 2 + 2 * static_cast<size_t>(num_layers)) {
+        decoder_feeds.push_back(encoder_fetches[j]);
+        continue;
+      }
+
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) < 2 * static_cast<size_t>(num_layers);
 
@@ -18,7 +18,8 @@ class T5DecoderSubgraph : public Subgraph {
       const std::string& attribute_name,
       const GraphViewer& subgraph_in) : Subgraph(node_in, attribute_name, subgraph_in),
                                         has_hidden_state_(false),
-                                        use_sequence_as_input_ids_(true) {
+                                        use_sequence_as_input_ids_(true),
+                                        share_cross_kv_across_beams_(false) {
     first_present_output_index_ = 1;
   }
 
@@ -67,10 +68,16 @@ class T5DecoderSubgraph : public Subgraph {
   }
 
  protected:
+  // Returns true when the past key and value of cross attention of all layers are only read by MultiHeadAttention
+  // nodes run by the CPU execution provider, so the beams of a batch can share them instead of holding copies.
+  bool CanShareCrossKvAcrossBeams() const;
+
+
   int first_past_input_index_;
   int first_present_output_index_;
   bool has_hidden_state_;
   bool use_sequence_as_input_ids_;
+  bool share_cross_kv_across_beams_;
 };
 
 }  // namespace transformers
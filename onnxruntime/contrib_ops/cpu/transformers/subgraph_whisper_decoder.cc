@@ -30,6 +30,7 @@ namespace transformers {
       past_key_cross_0: (B, num_heads, encode_sequence_length, head_size)
       past_value_cross_0: (B, num_heads, encode_sequence_length, head_size)
       ... (for each cross attention layer)
+      The batch size of past_key_cross_* and past_value_cross_* is batch_size when the beams share them.
 
       past_seq_len: int32 (1) - the length of past sequence(optional)
       num_beams: int32 (1) - the number of beams(optional)
@@ -121,6 +122,7 @@ Status WhisperDecoderSubgraph::Validate(const std::vector<const NodeArg*>& subgr
   }
 
   is_output_float16_ = (subgraph_outputs[0]->TypeAsProto()->tensor_type().elem_type() == float16_type);
+  share_cross_kv_across_beams_ = CanShareCrossKvAcrossBeams();
 
   return Status::OK();
 }
@@ -226,6 +228,12 @@ Status WhisperDecoderSubgraph::CreateInitialFeeds(
       }
       decoder_feeds.push_back(expanded_hidden_states);
     } else {
+      // The beams share the past key/value for cross attention when the decoder supports it, as they are static.
+      if (share_cross_kv_across_beams_ && j >= 2 + 2 * static_cast<size_t>(num_layers)) {
+        decoder_feeds.push_back(encoder_fetches[j]);
+        continue;
+      }
+
       // past key/value for cross attention does not need to be initialized with max_seq_len since they are static.
       bool use_max_seq_len = (j - first_past_input_index_) <= 2 * static_cast<size_t>(num_layers);
 
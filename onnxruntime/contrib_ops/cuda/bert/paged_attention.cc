@@ -0,0 +1,158 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "core/providers/cuda/cuda_common.h"
+#include "contrib_ops/cuda/bert/paged_attention_impl.h"
+#include "contrib_ops/cuda/bert/paged_attention.h"
+
+using namespace onnxruntime::cuda;
+using namespace ::onnxruntime::common;
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                         \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                         \
+      PagedAttention,                                                    \
+      kMSDomain,                                                         \
+      1,                                                                 \
+      T,                                                                 \
+      kCudaExecutionProvider,                                            \
+      (*KernelDefBuilder::Create())                                      \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())         \
+          .TypeConstraint("M", {DataTypeImpl::GetTensorType<int32_t>()}) \
+          .MayInplace(3, 1)                                              \
+          .MayInplace(4, 2),                                             \
+      PagedAttention<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+template <typename T>
+PagedAttention<T>::PagedAttention(const OpKernelInfo& info)
+    : CudaKernel(info) {
+  int64_t num_heads = 0;
+  int64_t kv_num_heads = 0;
+  ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
+  ORT_ENFORCE(info.GetAttr("kv_num_heads", &kv_num_heads).IsOK() && kv_num_heads > 0 && num_heads % kv_num_heads == 0);
+  num_heads_ = static_cast<int>(num_heads);
+  kv_num_heads_ = static_cast<int>(kv_num_heads);
+  scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+}
+
+template <typename T>
+Status PagedAttention<T>::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* key_cache = context->Input<Tensor>(3);
+  const Tensor* value_cache = context->Input<Tensor>(4);
+  const Tensor* block_tables = context->Input<Tensor>(5);
+  const Tensor* seqlens = context->Input<Tensor>(6);
+
+  const auto& query_dims = query->Shape().GetDims();
+  const auto& cache_dims = key_cache->Shape().GetDims();
+  const auto& block_tables_dims = block_tables->Shape().GetDims();
+  if (query_dims.size() != 3 || query_dims[1] != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'query' is expected to have shape (batch_size, 1, hidden_size), got ",
+                           query->Shape());
+  }
+  if (cache_dims.size() != 4 || cache_dims[1] != kv_num_heads_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'key_cache' is expected to have shape (num_blocks, kv_num_heads, block_size, "
+                           "head_size), got ",
+                           key_cache->Shape());
+  }
+  if (value_cache->Shape() != key_cache->Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'value_cache' is expected to have the shape of 'key_cache', got ",
+                           value_cache->Shape());
+  }
+
+  const int64_t batch_size = query_dims[0];
+  const int64_t head_size = cache_dims[3];
+  if (query_dims[2] != num_heads_ * head_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'query' is expected to have hidden size num_heads * head_size = ",
+                           num_heads_ * head_size, ", got ", query_dims[2]);
+  }
+  if (head_size > kPagedAttentionMaxHeadSize) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "PagedAttention supports head sizes up to ", kPagedAttentionMaxHeadSize, ", got ", head_size);
+  }
+  const TensorShape kv_shape({batch_size, 1, kv_num_heads_ * head_size});
+  if (key->Shape() != kv_shape || value->Shape() != kv_shape) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Inputs 'key' and 'value' are expected to have shape ", kv_shape, ", got ", key->Shape(),
+                           " and ", value->Shape());
+  }
+  if (block_tables_dims.size() != 2 || block_tables_dims[0] != batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'block_tables' is expected to have shape (batch_size, max_blocks_per_sequence), got ",
+                           block_tables->Shape());
+  }
+  if (seqlens->Shape().NumDimensions() != 1 || seqlens->Shape()[0] != batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Input 'seqlens' is expected to have shape (batch_size), got ", seqlens->Shape());
+  }
+
+  PagedAttentionParameters parameters;
+  parameters.batch_size = static_cast<int>(batch_size);
+  parameters.num_heads = num_heads_;
+  parameters.kv_num_heads = kv_num_heads_;
+  parameters.head_size = static_cast<int>(head_size);
+  parameters.block_size = static_cast<int>(cache_dims[2]);
+  parameters.max_blocks_per_sequence = static_cast<int>(block_tables_dims[1]);
+  const int64_t max_sequence_length = block_tables_dims[1] * cache_dims[2];
+  parameters.num_partitions = static_cast<int>(
+      (max_sequence_length + kPagedAttentionPartitionSize - 1) / kPagedAttentionPartitionSize);
+  parameters.scale = scale_ == 0.0f ? 1.0f / std::sqrt(static_cast<float>(head_size)) : scale_;
+
+  Tensor* output = context->Output(0, query->Shape());
+  Tensor* key_cache_out = context->Output(1, key_cache->Shape());
+  Tensor* value_cache_out = context->Output(2, value_cache->Shape());
+  if (batch_size == 0) {
+    return Status::OK();
+  }
+
+  // The new token is written to the output caches, which hold a copy of the input caches unless they share them.
+  cudaStream_t stream = Stream(context);
+  if (key_cache_out->MutableDataRaw() != key_cache->DataRaw()) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(key_cache_out->MutableDataRaw(), key_cache->DataRaw(),
+                                         key_cache->SizeInBytes(), cudaMemcpyDeviceToDevice, stream));
+  }
+  if (value_cache_out->MutableDataRaw() != value_cache->DataRaw()) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(value_cache_out->MutableDataRaw(), value_cache->DataRaw(),
+                                         value_cache->SizeInBytes(), cudaMemcpyDeviceToDevice, stream));
+  }
+
+  const size_t workspace_elements = GetPagedAttentionWorkspaceSize(parameters);
+  auto workspace = GetScratchBuffer<float>(workspace_elements, context->GetComputeStream());
+  const size_t num_partials = static_cast<size_t>(parameters.batch_size) * parameters.num_heads *
+                              parameters.num_partitions;
+
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  PagedAttentionData<CudaT> data;
+  data.query = reinterpret_cast<const CudaT*>(query->Data<T>());
+  data.key = reinterpret_cast<const CudaT*>(key->Data<T>());
+  data.value = reinterpret_cast<const CudaT*>(value->Data<T>());
+  data.block_tables = block_tables->Data<int32_t>();
+  data.seqlens = seqlens->Data<int32_t>();
+  data.partial_output = workspace.get();
+  data.partial_max = data.partial_output + num_partials * parameters.head_size;
+  data.partial_sum = data.partial_max + num_partials;
+  data.output = reinterpret_cast<CudaT*>(output->MutableData<T>());
+  data.key_cache = reinterpret_cast<CudaT*>(key_cache_out->MutableData<T>());
+  data.value_cache = reinterpret_cast<CudaT*>(value_cache_out->MutableData<T>());
+
+  return LaunchPagedAttention<CudaT>(stream, parameters, data);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
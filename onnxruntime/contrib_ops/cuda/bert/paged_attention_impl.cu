@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cfloat>
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cuda_common.h"
+#include "contrib_ops/cuda/bert/paged_attention_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kThreadsPerBlock = 128;
+
+// The length of the sequence, bounded by the number of tokens its block table holds.
+__device__ __forceinline__ int GetSequenceLength(const int32_t* seqlens, int batch_index, int block_size,
+                                                 int max_blocks_per_sequence) {
+  return min(static_cast<int>(seqlens[batch_index]), block_size * max_blocks_per_sequence);
+}
+
+__device__ __forceinline__ int64_t GetCacheOffset(const int32_t* block_tables, int batch_index, int token, int kv_head,
+                                                  const PagedAttentionParameters& parameters) {
+  const int block = block_tables[static_cast<int64_t>(batch_index) * parameters.max_blocks_per_sequence +
+                                 token / parameters.block_size];
+  const int slot = token % parameters.block_size;
+  return ((static_cast<int64_t>(block) * parameters.kv_num_heads + kv_head) * parameters.block_size + slot) *
+         parameters.head_size;
+}
+
+// Reduces the values of the threads of the block, whose size is a power of 2.
+template <bool kIsMax>
+__device__ float BlockReduce(float value, float* buffer) {
+  buffer[threadIdx.x] = value;
+  __syncthreads();
+  for (int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
+    if (threadIdx.x < stride) {
+      buffer[threadIdx.x] = kIsMax ? fmaxf(buffer[threadIdx.x], buffer[threadIdx.x + stride])
+                                   : buffer[threadIdx.x] + buffer[threadIdx.x + stride];
+    }
+    __syncthreads();
+  }
+  const float result = buffer[0];
+  __syncthreads();
+  return result;
+}
+
+// Writes the key and value of the new token of each sequence to its slot in the cache.
+template <typename T>
+__global__ void AppendToPagedCacheKernel(const PagedAttentionParameters parameters, const T* key, const T* value,
+                                         const int32_t* block_tables, const int32_t* seqlens, T* key_cache,
+                                         T* value_cache) {
+  const int kv_head = blockIdx.x;
+  const int b = blockIdx.y;
+  const int token = GetSequenceLength(seqlens, b, parameters.block_size, parameters.max_blocks_per_sequence) - 1;
+  if (token < 0) {
+    return;
+  }
+
+  const int64_t cache_offset = GetCacheOffset(block_tables, b, token, kv_head, parameters);
+  const int64_t input_offset = (static_cast<int64_t>(b) * parameters.kv_num_heads + kv_head) * parameters.head_size;
+  for (int d = threadIdx.x; d < parameters.head_size; d += blockDim.x) {
+    key_cache[cache_offset + d] = key[input_offset + d];
+    value_cache[cache_offset + d] = value[input_offset + d];
+  }
+}
+
+// Attends to the tokens of one partition of a sequence for one head, and writes the unnormalized output with the
+// max and the sum of the exponentials of the logits of the partition.
+template <typename T>
+__global__ void PagedAttentionPartitionKernel(const PagedAttentionParameters parameters, const T* query,
+                                              const T* key_cache, const T* value_cache, const int32_t* block_tables,
+                                              const int32_t* seqlens, float* partial_output, float* partial_max,
+                                              float* partial_sum) {
+  __shared__ float q_shared[kPagedAttentionMaxHeadSize];
+  __shared__ float logits[kPagedAttentionPartitionSize];
+  __shared__ float reduce_buffer[kThreadsPerBlock];
+
+  const int partition = blockIdx.x;
+  const int head = blockIdx.y;
+  const int b = blockIdx.z;
+  const int head_size = parameters.head_size;
+  const int kv_head = head / (parameters.num_heads / parameters.kv_num_heads);
+  const int sequence_length =
+      GetSequenceLength(seqlens, b, parameters.block_size, parameters.max_blocks_per_sequence);
+  const int start = partition * kPagedAttentionPartitionSize;
+  const int end = min(start + kPagedAttentionPartitionSize, sequence_length);
+  const int64_t partial_index =
+      (static_cast<int64_t>(b) * parameters.num_heads + head) * parameters.num_partitions + partition;
+
+  if (start >= end) {
+    // the partition is past the end of the sequence, it is skipped when merging
+    if (threadIdx.x == 0) {
+      partial_max[partial_index] = -FLT_MAX;
+      partial_sum[partial_index] = 0.0f;
+    }
+    return;
+  }
+
+  const int64_t query_offset = (static_cast<int64_t>(b) * parameters.num_heads + head) * head_size;
+  for (int d = threadIdx.x; d < head_size; d += blockDim.x) {
+    q_shared[d] = static_cast<float>(query[query_offset + d]) * parameters.scale;
+  }
+  __syncthreads();
+
+  float thread_max = -FLT_MAX;
+  for (int token = start + threadIdx.x; token < end; token += blockDim.x) {
+    const T* k = key_cache + GetCacheOffset(block_tables, b, token, kv_head, parameters);
+    float dot = 0.0f;
+    for (int d = 0; d < head_size; ++d) {
+      dot += q_shared[d] * static_cast<float>(k[d]);
+    }
+    logits[token - start] = dot;
+    thread_max = fmaxf(thread_max, dot);
+  }
+  const float max = BlockReduce<true>(thread_max, reduce_buffer);
+
+  float thread_sum = 0.0f;
+  for (int token = start + threadIdx.x; token < end; token += blockDim.x) {
+    const float p = expf(logits[token - start] - max);
+    logits[token - start] = p;
+    thread_sum += p;
+  }
+  const float sum = BlockReduce<false>(thread_sum, reduce_buffer);
+
+  for (int d = threadIdx.x; d < head_size; d += blockDim.x) {
+    float output = 0.0f;
+    for (int token = start; token < end; ++token) {
+      const T* v = value_cache + GetCacheOffset(block_tables, b, token, kv_head, parameters);
+      output += logits[token - start] * static_cast<float>(v[d]);
+    }
+    partial_output[partial_index * head_size + d] = output;
+  }
+
+  if (threadIdx.x == 0) {
+    partial_max[partial_index] = max;
+    partial_sum[partial_index] = sum;
+  }
+}
+
+// Merges the partitions of each sequence and head, rescaling them to the max of the whole sequence.
+template <typename T>
+__global__ void PagedAttentionMergeKernel(const PagedAttentionParameters parameters, const float* partial_output,
+                                          const float* partial_max, const float* partial_sum, T* output) {
+  const int head = blockIdx.x;
+  const int b = blockIdx.y;
+  const int head_size = parameters.head_size;
+  const int64_t first_partial_index = (static_cast<int64_t>(b) * parameters.num_heads + head) *
+                                      parameters.num_partitions;
+
+  float max = -FLT_MAX;
+  for (int p = 0; p < parameters.num_partitions; ++p) {
+    if (partial_sum[first_partial_index + p] > 0.0f) {
+      max = fmaxf(max, partial_max[first_partial_index + p]);
+    }
+  }
+
+  float sum = 0.0f;
+  for (int p = 0; p < parameters.num_partitions; ++p) {
+    if (partial_sum[first_partial_index + p] > 0.0f) {
+      sum += partial_sum[first_partial_index + p] * expf(partial_max[first_partial_index + p] - max);
+    }
+  }
+
+  const int64_t output_offset = (static_cast<int64_t>(b) * parameters.num_heads + head) * head_size;
+  for (int d = threadIdx.x; d < head_size; d += blockDim.x) {
+    float value = 0.0f;
+    for (int p = 0; p < parameters.num_partitions; ++p) {
+      if (partial_sum[first_partial_index + p] > 0.0f) {
+        value += partial_output[(first_partial_index + p) * head_size + d] *
+                 expf(partial_max[first_partial_index + p] - max);
+      }
+    }
+    output[output_offset + d] = static_cast<T>(sum > 0.0f ? value / sum : 0.0f);
+  }
+}
+
+}  // namespace
+
+size_t GetPagedAttentionWorkspaceSize(const PagedAttentionParameters& parameters) {
+  const size_t num_partials = static_cast<size_t>(parameters.batch_size) * parameters.num_heads *
+                              parameters.num_partitions;
+  return num_partials * (parameters.head_size + 2);
+}
+
+template <typename T>
+Status LaunchPagedAttention(
+    cudaStream_t stream,
+    const PagedAttentionParameters& parameters,
+    PagedAttentionData<T>& data) {
+  const dim3 append_grid(parameters.kv_num_heads, parameters.batch_size);
+  AppendToPagedCacheKernel<T><<<append_grid, kThreadsPerBlock, 0, stream>>>(
+      parameters, data.key, data.value, data.block_tables, data.seqlens, data.key_cache, data.value_cache);
+
+  const dim3 partition_grid(parameters.num_partitions, parameters.num_heads, parameters.batch_size);
+  PagedAttentionPartitionKernel<T><<<partition_grid, kThreadsPerBlock, 0, stream>>>(
+      parameters, data.query, data.key_cache, data.value_cache, data.block_tables, data.seqlens,
+      data.partial_output, data.partial_max, data.partial_sum);
+
+  const dim3 merge_grid(parameters.num_heads, parameters.batch_size);
+  PagedAttentionMergeKernel<T><<<merge_grid, kThreadsPerBlock, 0, stream>>>(
+      parameters, data.partial_output, data.partial_max, data.partial_sum, data.output);
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
+template Status LaunchPagedAttention<float>(
+    cudaStream_t stream,
+    const PagedAttentionParameters& parameters,
+    PagedAttentionData<float>& data);
+
+template Status LaunchPagedAttention<half>(
+    cudaStream_t stream,
+    const PagedAttentionParameters& parameters,
+    PagedAttentionData<half>& data);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+#include <cuda_fp16.h>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The number of tokens of a sequence attended to by one thread block. The partitions of a sequence are merged by a
+// second kernel, so long sequences keep all the SMs busy even with a small batch.
+constexpr int kPagedAttentionPartitionSize = 256;
+constexpr int kPagedAttentionMaxHeadSize = 256;
+
+struct PagedAttentionParameters {
+  int batch_size = 0;
+  int num_heads = 0;
+  int kv_num_heads = 0;
+  int head_size = 0;
+  int block_size = 0;
+  int max_blocks_per_sequence = 0;
+  // the number of partitions of the longest sequence the block tables can hold
+  int num_partitions = 0;
+  float scale = 0.0f;
+};
+
+template <typename T>
+struct PagedAttentionData {
+  // Input Tensors
+  const T* query = nullptr;
+  const T* key = nullptr;
+  const T* value = nullptr;
+  const int32_t* block_tables = nullptr;
+  const int32_t* seqlens = nullptr;
+  // Partition buffers
+  float* partial_output = nullptr;
+  float* partial_max = nullptr;
+  float* partial_sum = nullptr;
+  // Output Tensors
+  T* output = nullptr;
+  T* key_cache = nullptr;
+  T* value_cache = nullptr;
+};
+
+// The number of floats of the partition buffers.
+size_t GetPagedAttentionWorkspaceSize(const PagedAttentionParameters& parameters);
+
+template <typename T>
+Status LaunchPagedAttention(
+    cudaStream_t stream,
+    const PagedAttentionParameters& parameters,
+    PagedAttentionData<T>& data);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include "core/common/status.h"
 #include "core/providers/cuda/nn/conv.h"
 #include "core/providers/cuda/cuda_common.h"
+#include "contrib_ops/cuda/fused_conv_impl.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -16,11 +17,13 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
   FusedConv(const OpKernelInfo& info) : onnxruntime::cuda::Conv<T, false>(info) {
     std::string activation;
     ORT_THROW_IF_ERROR(info.GetAttr<std::string>("activation", &activation));
-    ORT_THROW_IF_ERROR(MapMode(activation));
-    CUDNN_CALL_THROW(cudnnCreateActivationDescriptor(&activation_desc_));
-    CUDNN_CALL_THROW(cudnnSetActivationDescriptor(
-        activation_desc_, activation_mode_, cudnnNanPropagation_t::CUDNN_NOT_PROPAGATE_NAN,
-        std::numeric_limits<double>::max()));
+    ORT_THROW_IF_ERROR(MapMode(activation, info.GetAttrsOrDefault<float>("activation_params")));
+    if (use_cudnn_activation_) {
+      CUDNN_CALL_THROW(cudnnCreateActivationDescriptor(&activation_desc_));
+      CUDNN_CALL_THROW(cudnnSetActivationDescriptor(
+          activation_desc_, activation_mode_, cudnnNanPropagation_t::CUDNN_NOT_PROPAGATE_NAN,
+          std::numeric_limits<double>::max()));
+    }
   }
 
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(FusedConv);
@@ -45,24 +48,29 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
     const auto alpha = onnxruntime::cuda::Consts<CudaT>::One;
     const auto beta = onnxruntime::cuda::Consts<CudaT>::Zero;
     IAllocatorUniquePtr<void> workspace = Base::GetWorkSpace(context->GetComputeStream());
-    auto cudnn_status = cudnnConvolutionBiasActivationForward(cudnnHandle,
-                                                              &alpha,
-                                                              Base::s_.x_tensor,
-                                                              Base::s_.x_data,
-                                                              Base::s_.w_desc,
-                                                              Base::s_.w_data,
-                                                              Base::s_.conv_desc,
-                                                              Base::s_.algo,
-                                                              workspace.get(),
-                                                              Base::s_.workspace_bytes,
-                                                              has_z ? &alpha : &beta,
-                                                              has_z ? Base::s_.z_tensor : Base::s_.y_tensor,
-                                                              has_z ? Base::s_.z_data : Base::s_.y_data,
-                                                              Base::s_.b_tensor,
-                                                              has_b ? Base::s_.b_data : Base::s_.b_zero,
-                                                              activation_desc_,
-                                                              Base::s_.y_tensor,
-                                                              Base::s_.y_data);
+    // cudnnConvolutionBiasActivationForward only takes Relu, the other activations always run the convolution
+    // followed by a single kernel adding the bias and Z and applying the activation.
+    cudnnStatus_t cudnn_status = CUDNN_STATUS_NOT_SUPPORTED;
+    if (use_cudnn_activation_) {
+      cudnn_status = cudnnConvolutionBiasActivationForward(cudnnHandle,
+                                                           &alpha,
+                                                           Base::s_.x_tensor,
+                                                           Base::s_.x_data,
+                                                           Base::s_.w_desc,
+                                                           Base::s_.w_data,
+                                                           Base::s_.conv_desc,
+                                                           Base::s_.algo,
+                                                           workspace.get(),
+                                                           Base::s_.workspace_bytes,
+                                                           has_z ? &alpha : &beta,
+                                                           has_z ? Base::s_.z_tensor : Base::s_.y_tensor,
+                                                           has_z ? Base::s_.z_data : Base::s_.y_data,
+                                                           Base::s_.b_tensor,
+                                                           has_b ? Base::s_.b_data : Base::s_.b_zero,
+                                                           activation_desc_,
+                                                           Base::s_.y_tensor,
+                                                           Base::s_.y_data);
+    }
     if (CUDNN_STATUS_SUCCESS != cudnn_status) {
       CUDNN_RETURN_IF_ERROR(cudnnConvolutionForward(cudnnHandle,
                                                     &alpha,
@@ -77,16 +85,21 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
                                                     &beta,
                                                     Base::s_.y_tensor,
                                                     Base::s_.y_data));
-      if (has_b) {
-        CUDNN_RETURN_IF_ERROR(cudnnAddTensor(cudnnHandle, &alpha, Base::s_.b_tensor, Base::s_.b_data,
-                                             &alpha, Base::s_.y_tensor, Base::s_.y_data));
-      }
-      if (has_z) {
+      // Z has the shape of the output, so it is added by cuDNN when the convolution result has extra padding
+      const bool add_z_in_epilogue = has_z && !Base::s_.post_slicing_required;
+      if (has_z && !add_z_in_epilogue) {
         CUDNN_RETURN_IF_ERROR(cudnnAddTensor(cudnnHandle, &alpha, Base::s_.z_tensor, Base::s_.z_data,
                                              &alpha, Base::s_.y_tensor, Base::s_.y_data));
       }
-      CUDNN_RETURN_IF_ERROR(cudnnActivationForward(cudnnHandle, activation_desc_, &alpha, Base::s_.y_tensor,
-                                                   Base::s_.y_data, &beta, Base::s_.y_tensor, Base::s_.y_data));
+      const auto& y_dims = Base::s_.y_dims_with_adjusted_pads;
+      const int64_t channels = y_dims.size() > 1 ? y_dims[1] : 1;
+      const int64_t size = TensorShape(y_dims).Size();
+      const int64_t spatial_size = y_dims.size() > 2 ? TensorShape(y_dims).SizeFromDimension(2) : 1;
+      FusedConvEpilogueImpl<CudaT>(this->Stream(context), activation_params_,
+                                   has_b ? reinterpret_cast<const CudaT*>(Base::s_.b_data) : nullptr,
+                                   add_z_in_epilogue ? reinterpret_cast<const CudaT*>(Base::s_.z_data) : nullptr,
+                                   channels, spatial_size, size, reinterpret_cast<CudaT*>(Base::s_.y_data));
+      CUDA_RETURN_IF_ERROR(cudaGetLastError());
     }
     if (Base::s_.post_slicing_required) {
       ORT_RETURN_IF_ERROR(onnxruntime::cuda::SliceOutUnwantedOutputSection(
@@ -97,18 +110,55 @@ class FusedConv : public onnxruntime::cuda::Conv<T, false> {
   }
 
  private:
-  Status MapMode(const std::string& activaton_mode) {
+  Status MapMode(const std::string& activaton_mode, const std::vector<float>& activation_params) {
+    size_t num_params = 0;
+    activation_params_.alpha = 0.0f;
+    activation_params_.beta = 0.0f;
     if (activaton_mode == "Relu") {
       activation_mode_ = cudnnActivationMode_t::CUDNN_ACTIVATION_RELU;
+      use_cudnn_activation_ = true;
+      activation_params_.activation = FusedConvActivation::kRelu;
+    } else if (activaton_mode == "Sigmoid") {
+      activation_params_.activation = FusedConvActivation::kSigmoid;
+    } else if (activaton_mode == "Tanh") {
+      activation_params_.activation = FusedConvActivation::kTanh;
+    } else if (activaton_mode == "LeakyRelu") {
+      activation_params_.activation = FusedConvActivation::kLeakyRelu;
+      num_params = 1;
+    } else if (activaton_mode == "Clip") {
+      activation_params_.activation = FusedConvActivation::kClip;
+      num_params = 2;
+    } else if (activaton_mode == "HardSigmoid") {
+      activation_params_.activation = FusedConvActivation::kHardSigmoid;
+      num_params = 2;
+    } else if (activaton_mode == "Gelu") {
+      activation_params_.activation = FusedConvActivation::kGelu;
+    } else if (activaton_mode == "QuickGelu") {
+      activation_params_.activation = FusedConvActivation::kQuickGelu;
+      num_params = 1;
     } else {
       return ORT_MAKE_STATUS(
           StatusCategory::ONNXRUNTIME, StatusCode::INVALID_ARGUMENT,
           "unsupported conv activation mode \"", activaton_mode, "\"");
     }
+
+    if (activation_params.size() != num_params) {
+      return ORT_MAKE_STATUS(StatusCategory::ONNXRUNTIME, StatusCode::INVALID_ARGUMENT, "conv activation \"",
+                             activaton_mode, "\" takes ", num_params, " activation_params but got ",
+                             activation_params.size());
+    }
+    if (num_params > 0) {
+      activation_params_.alpha = activation_params[0];
+    }
+    if (num_params > 1) {
+      activation_params_.beta = activation_params[1];
+    }
     return Status::OK();
   }
   cudnnActivationMode_t activation_mode_;
   cudnnActivationDescriptor_t activation_desc_ = nullptr;
+  bool use_cudnn_activation_ = false;
+  FusedConvActivationParams activation_params_;
 };
 
 ONNX_OPERATOR_TYPED_KERNEL_EX(
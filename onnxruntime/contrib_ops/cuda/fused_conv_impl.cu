@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "fused_conv_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+__device__ __forceinline__ float ApplyFusedConvActivation(const FusedConvActivationParams& params, float x) {
+  switch (params.activation) {
+    case FusedConvActivation::kRelu:
+      return x > 0.0f ? x : 0.0f;
+    case FusedConvActivation::kSigmoid:
+      return 1.0f / (1.0f + expf(-x));
+    case FusedConvActivation::kTanh:
+      return tanhf(x);
+    case FusedConvActivation::kLeakyRelu:
+      return x >= 0.0f ? x : params.alpha * x;
+    case FusedConvActivation::kClip:
+      return fminf(fmaxf(x, params.alpha), params.beta);
+    case FusedConvActivation::kHardSigmoid:
+      return fmaxf(0.0f, fminf(1.0f, params.alpha * x + params.beta));
+    case FusedConvActivation::kGelu:
+      return 0.5f * x * (1.0f + erff(x * static_cast<float>(M_SQRT1_2)));
+    case FusedConvActivation::kQuickGelu:
+      return x / (1.0f + expf(-params.alpha * x));
+  }
+  return x;
+}
+
+template <typename T>
+__global__ void FusedConvEpilogueKernel(
+    const FusedConvActivationParams params,
+    const T* bias_data,
+    const T* z_data,
+    const int64_t channels,
+    const int64_t spatial_size,
+    const int64_t size,
+    T* y_data) {
+  const int64_t idx = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (idx >= size) {
+    return;
+  }
+
+  float value = static_cast<float>(y_data[idx]);
+  if (bias_data != nullptr) {
+    value += static_cast<float>(bias_data[(idx / spatial_size) % channels]);
+  }
+  if (z_data != nullptr) {
+    value += static_cast<float>(z_data[idx]);
+  }
+  y_data[idx] = static_cast<T>(ApplyFusedConvActivation(params, value));
+}
+
+template <typename T>
+void FusedConvEpilogueImpl(
+    cudaStream_t stream,
+    const FusedConvActivationParams& params,
+    const T* bias_data,
+    const T* z_data,
+    int64_t channels,
+    int64_t spatial_size,
+    int64_t size,
+    T* y_data) {
+  if (size == 0) {
+    return;
+  }
+
+  const int blocks = static_cast<int>(CeilDiv(size, static_cast<int64_t>(GridDim::maxThreadsPerBlock)));
+  FusedConvEpilogueKernel<T><<<blocks, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      params, bias_data, z_data, channels, spatial_size, size, y_data);
+}
+
+#define SPECIALIZED_IMPL(T)                                                                             \
+  template void FusedConvEpilogueImpl<T>(cudaStream_t stream, const FusedConvActivationParams& params, \
+                                         const T* bias_data, const T* z_data, int64_t channels,         \
+                                         int64_t spatial_size, int64_t size, T* y_data);
+
+SPECIALIZED_IMPL(float)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+enum class FusedConvActivation {
+  kRelu,
+  kSigmoid,
+  kTanh,
+  kLeakyRelu,
+  kClip,
+  kHardSigmoid,
+  kGelu,
+  kQuickGelu,
+};
+
+// The parameters of the activation, from the activation_params attribute: alpha for LeakyRelu and QuickGelu,
+// min and max for Clip, and alpha and beta for HardSigmoid.
+struct FusedConvActivationParams {
+  FusedConvActivation activation;
+  float alpha;
+  float beta;
+};
+
+// Computes Y = activation(Y + B + Z) in place in one pass over the NCHW output of the convolution, where B, of
+// shape [channels], and Z, of the shape of Y, may be nullptr.
+template <typename T>
+void FusedConvEpilogueImpl(
+    cudaStream_t stream,
+    const FusedConvActivationParams& params,
+    const T* bias_data,
+    const T* z_data,
+    int64_t channels,
+    int64_t spatial_size,
+    int64_t size,
+    T* y_data);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/math/elementwise_chain.h"
+
+#include <string>
+
+using namespace onnxruntime::common;
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    ElementwiseChain, kMSDomain, 1, kCudaExecutionProvider,
+    (*KernelDefBuilder::Create()).MayInplace(0, 0).TypeConstraint("T", BuildKernelDefConstraints<MLFloat16, float>()),
+    ElementwiseChain);
+
+namespace {
+
+bool GetElementwiseChainOp(const std::string& op_type, ElementwiseChainOp& op) {
+  if (op_type == "Add") {
+    op = ElementwiseChainOp::kAdd;
+  } else if (op_type == "Sub") {
+    op = ElementwiseChainOp::kSub;
+  } else if (op_type == "Mul") {
+    op = ElementwiseChainOp::kMul;
+  } else if (op_type == "Div") {
+    op = ElementwiseChainOp::kDiv;
+  } else if (op_type == "Relu") {
+    op = ElementwiseChainOp::kRelu;
+  } else if (op_type == "Sigmoid") {
+    op = ElementwiseChainOp::kSigmoid;
+  } else if (op_type == "Tanh") {
+    op = ElementwiseChainOp::kTanh;
+  } else if (op_type == "Softplus") {
+    op = ElementwiseChainOp::kSoftplus;
+  } else if (op_type == "Softsign") {
+    op = ElementwiseChainOp::kSoftsign;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool IsBinary(ElementwiseChainOp op) {
+  return op == ElementwiseChainOp::kAdd || op == ElementwiseChainOp::kSub || op == ElementwiseChainOp::kMul ||
+         op == ElementwiseChainOp::kDiv;
+}
+
+}  // namespace
+
+ElementwiseChain::ElementwiseChain(const OpKernelInfo& info) : CudaKernel(info) {
+  std::vector<std::string> ops;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(),
+              "ElementwiseChain requires a non-empty 'ops' attribute.");
+  ORT_ENFORCE(ops.size() <= static_cast<size_t>(kElementwiseChainMaxSteps),
+              "ElementwiseChain on CUDA supports at most ", kElementwiseChainMaxSteps, " steps but got ", ops.size());
+  const auto operand_first = info.GetAttrsOrDefault<int64_t>("operand_first");
+  ORT_ENFORCE(operand_first.empty() || operand_first.size() == ops.size(),
+              "'operand_first' must have one value per step.");
+
+  int next_operand = 1;
+  steps_.resize(ops.size());
+  operand_indices_.resize(ops.size(), -1);
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ElementwiseChainStep& step = steps_[i];
+    ORT_ENFORCE(GetElementwiseChainOp(ops[i], step.op), "ElementwiseChain on CUDA does not support ", ops[i]);
+    step.operand_first = false;
+    step.scalar_operand = false;
+    if (IsBinary(step.op)) {
+      operand_indices_[i] = next_operand++;
+      step.operand_first = !operand_first.empty() && operand_first[i] != 0;
+    }
+  }
+
+  ORT_ENFORCE(next_operand == static_cast<int>(info.GetInputCount()),
+              "ElementwiseChain has ", info.GetInputCount(), " inputs but its steps take ", next_operand);
+}
+
+template <typename T>
+Status ElementwiseChain::KernelLaunchDispatcher<T>::operator()(cudaStream_t stream,
+                                                               const std::vector<ElementwiseChainStep>& steps,
+                                                               const std::vector<int>& operand_indices,
+                                                               OpKernelContext& context, const Tensor& X,
+                                                               Tensor& Y) const {
+  using CudaT = typename ToCudaType<T>::MappedType;
+  const TensorShape& shape = X.Shape();
+
+  ElementwiseChainParams<CudaT> params{};
+  params.num_steps = static_cast<int>(steps.size());
+  for (size_t i = 0; i < steps.size(); ++i) {
+    params.steps[i] = steps[i];
+    params.operands[i] = nullptr;
+    if (operand_indices[i] < 0) {
+      continue;
+    }
+
+    const Tensor& operand = *context.Input<Tensor>(operand_indices[i]);
+    const TensorShape& operand_shape = operand.Shape();
+    const bool is_scalar = operand_shape.Size() == 1 && operand_shape.NumDimensions() <= shape.NumDimensions();
+    if (!is_scalar && operand_shape != shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ElementwiseChain operand ", operand_indices[i],
+                             " has shape ", operand_shape, " which is neither ", shape, " nor a single element.");
+    }
+
+    params.steps[i].scalar_operand = is_scalar;
+    params.operands[i] = reinterpret_cast<const CudaT*>(operand.template Data<T>());
+  }
+
+  LaunchElementwiseChainKernel<CudaT>(stream, shape.Size(), params,
+                                      reinterpret_cast<const CudaT*>(X.template Data<T>()),
+                                      reinterpret_cast<CudaT*>(Y.template MutableData<T>()));
+  return CUDA_CALL(cudaGetLastError());
+}
+
+Status ElementwiseChain::ComputeInternal(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  ORT_ENFORCE(X);
+  auto* Y = context->Output(0, X->Shape());
+  ORT_ENFORCE(Y);
+
+  if (X->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  utils::MLTypeCallDispatcher<MLFloat16, float> dispatcher{X->GetElementType()};
+  return dispatcher.InvokeRet<Status, KernelLaunchDispatcher>(Stream(context), steps_, operand_indices_, *context,
+                                                              *X, *Y);
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
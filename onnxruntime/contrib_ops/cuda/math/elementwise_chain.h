@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/providers/cuda/cuda_kernel.h"
+#include "contrib_ops/cuda/math/elementwise_chain_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Applies a chain of element-wise ops to its first input in a single kernel launch.
+class ElementwiseChain final : public CudaKernel {
+ public:
+  ElementwiseChain(const OpKernelInfo& info);
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  template <typename T>
+  struct KernelLaunchDispatcher {
+    Status operator()(cudaStream_t stream, const std::vector<ElementwiseChainStep>& steps,
+                      const std::vector<int>& operand_indices, OpKernelContext& context, const Tensor& X,
+                      Tensor& Y) const;
+  };
+
+  std::vector<ElementwiseChainStep> steps_;
+  // the input index of the operand of each step, or -1 for the activation steps
+  std::vector<int> operand_indices_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
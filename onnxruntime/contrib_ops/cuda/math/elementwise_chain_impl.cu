@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/math/elementwise_chain_impl.h"
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kElementsPerThread = GridDim::maxElementsPerThread;
+constexpr int kThreadsPerBlock = GridDim::maxThreadsPerBlock;
+
+// The steps run in float, so the fp16 values are only rounded once, when the output is written.
+__device__ __forceinline__ float ApplyStep(ElementwiseChainOp op, bool operand_first, float x, float operand) {
+  switch (op) {
+    case ElementwiseChainOp::kAdd:
+      return x + operand;
+    case ElementwiseChainOp::kSub:
+      return operand_first ? operand - x : x - operand;
+    case ElementwiseChainOp::kMul:
+      return x * operand;
+    case ElementwiseChainOp::kDiv:
+      return operand_first ? operand / x : x / operand;
+    case ElementwiseChainOp::kRelu:
+      return x > 0.0f ? x : 0.0f;
+    case ElementwiseChainOp::kSigmoid:
+      return 1.0f / (1.0f + expf(-x));
+    case ElementwiseChainOp::kTanh:
+      return tanhf(x);
+    case ElementwiseChainOp::kSoftplus:
+      return x > 0.0f ? x + log1pf(expf(-x)) : log1pf(expf(x));
+    case ElementwiseChainOp::kSoftsign:
+      return x / (1.0f + fabsf(x));
+  }
+  return x;
+}
+
+}  // namespace
+
+// Each thread takes kElementsPerThread elements through all the steps in registers, so the tensor is read and
+// written once rather than once per step.
+template <typename T>
+__global__ void ElementwiseChainKernel(int64_t size, const ElementwiseChainParams<T> params, const T* X, T* Y) {
+  const int64_t base_idx = static_cast<int64_t>(kElementsPerThread) * blockDim.x * blockIdx.x + threadIdx.x;
+
+  float values[kElementsPerThread];
+#pragma unroll
+  for (int i = 0; i < kElementsPerThread; ++i) {
+    const int64_t idx = base_idx + static_cast<int64_t>(i) * blockDim.x;
+    values[i] = idx < size ? static_cast<float>(X[idx]) : 0.0f;
+  }
+
+  for (int step_idx = 0; step_idx < params.num_steps; ++step_idx) {
+    const ElementwiseChainStep step = params.steps[step_idx];
+    const T* operand = params.operands[step_idx];
+    const float scalar_operand = operand != nullptr && step.scalar_operand ? static_cast<float>(operand[0]) : 0.0f;
+#pragma unroll
+    for (int i = 0; i < kElementsPerThread; ++i) {
+      const int64_t idx = base_idx + static_cast<int64_t>(i) * blockDim.x;
+      float operand_value = scalar_operand;
+      if (operand != nullptr && !step.scalar_operand && idx < size) {
+        operand_value = static_cast<float>(operand[idx]);
+      }
+      values[i] = ApplyStep(step.op, step.operand_first, values[i], operand_value);
+    }
+  }
+
+#pragma unroll
+  for (int i = 0; i < kElementsPerThread; ++i) {
+    const int64_t idx = base_idx + static_cast<int64_t>(i) * blockDim.x;
+    if (idx < size) {
+      Y[idx] = static_cast<T>(values[i]);
+    }
+  }
+}
+
+template <typename T>
+void LaunchElementwiseChainKernel(cudaStream_t stream, int64_t size, const ElementwiseChainParams<T>& params,
+                                  const T* X, T* Y) {
+  const int num_threads_per_block =
+      std::min<int>(static_cast<int>(CeilDiv(size, kElementsPerThread)), kThreadsPerBlock);
+  const auto num_blocks = CeilDiv(size, static_cast<int64_t>(kElementsPerThread) * num_threads_per_block);
+  ElementwiseChainKernel<T><<<static_cast<unsigned int>(num_blocks), num_threads_per_block, 0, stream>>>(
+      size, params, X, Y);
+}
+
+// explicit instantiations
+#define SPECIALIZED_ELEMENTWISE_CHAIN_IMPL(T)                                                     \
+  template void LaunchElementwiseChainKernel<T>(cudaStream_t stream, int64_t size,                \
+                                                const ElementwiseChainParams<T>& params, const T* X, \
+                                                T* Y)
+
+SPECIALIZED_ELEMENTWISE_CHAIN_IMPL(half);
+SPECIALIZED_ELEMENTWISE_CHAIN_IMPL(float);
+
+#undef SPECIALIZED_ELEMENTWISE_CHAIN_IMPL
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <stdint.h>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The maximum number of steps of an ElementwiseChain node run by the CUDA kernel.
+constexpr int kElementwiseChainMaxSteps = 16;
+
+enum class ElementwiseChainOp : int8_t {
+  kAdd,
+  kSub,
+  kMul,
+  kDiv,
+  kRelu,
+  kSigmoid,
+  kTanh,
+  kSoftplus,
+  kSoftsign,
+};
+
+struct ElementwiseChainStep {
+  ElementwiseChainOp op;
+  // set for the binary steps whose operand is their first input
+  bool operand_first;
+  // set for the binary steps whose operand has a single element
+  bool scalar_operand;
+};
+
+// The steps of the chain and the operands of its binary steps, passed to the kernel by value.
+template <typename T>
+struct ElementwiseChainParams {
+  int num_steps;
+  ElementwiseChainStep steps[kElementwiseChainMaxSteps];
+  const T* operands[kElementwiseChainMaxSteps];
+};
+
+template <typename T>
+void LaunchElementwiseChainKernel(cudaStream_t stream, int64_t size, const ElementwiseChainParams<T>& params,
+                                  const T* X, T* Y);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
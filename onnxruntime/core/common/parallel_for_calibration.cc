@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/parallel_for_calibration.h"
+
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+namespace {
+
+// TensorOpCost is expressed in cycles. The measured time is converted assuming a 3GHz core, which only scales the
+// costs relative to the thread pool's fixed per-task overhead estimate.
+constexpr double kCyclesPerNanosecond = 3.0;
+
+constexpr const char* kProfileHeader = "onnxruntime_parallel_for_calibration 1";
+
+}  // namespace
+
+ParallelForCalibration& ParallelForCalibration::Instance() {
+  static ParallelForCalibration instance;
+  return instance;
+}
+
+TensorOpCost ParallelForCalibration::GetCost(std::string_view call_site, const TensorOpCost& cost) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(call_site);
+  if (it == entries_.end() || it->second.num_samples < kMinSamples) {
+    return cost;
+  }
+
+  // the measured time includes the memory accesses, so the byte counts are dropped
+  return TensorOpCost{0, 0, it->second.nanoseconds_per_unit * kCyclesPerNanosecond};
+}
+
+bool ParallelForCalibration::ShouldSample(std::string_view call_site) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(call_site);
+  if (it == entries_.end()) {
+    it = entries_.emplace(std::string(call_site), Entry{}).first;
+  }
+
+  Entry& entry = it->second;
+  return entry.num_samples < kMinSamples || (entry.num_calls++ % kSampleInterval) == 0;
+}
+
+void ParallelForCalibration::RecordSample(std::string_view call_site, std::ptrdiff_t units, uint64_t nanoseconds) {
+  if (units <= 0) {
+    return;
+  }
+
+  const double nanoseconds_per_unit = static_cast<double>(nanoseconds) / static_cast<double>(units);
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(call_site);
+  if (it == entries_.end()) {
+    it = entries_.emplace(std::string(call_site), Entry{}).first;
+  }
+
+  // average the first samples, then follow changes with an exponentially weighted moving average
+  Entry& entry = it->second;
+  const double weight = entry.num_samples < kMinSamples ? 1.0 / (entry.num_samples + 1) : 1.0 / kMinSamples;
+  entry.nanoseconds_per_unit += weight * (nanoseconds_per_unit - entry.nanoseconds_per_unit);
+  if (entry.num_samples < kMinSamples) {
+    ++entry.num_samples;
+  }
+}
+
+Status ParallelForCalibration::Load(const PathString& path) {
+  std::ifstream file(path);
+  ORT_RETURN_IF_NOT(file, "Failed to open parallel for calibration profile ", PathToUTF8String(path));
+
+  std::string line;
+  ORT_RETURN_IF_NOT(std::getline(file, line) && line == kProfileHeader,
+                    "Invalid parallel for calibration profile ", PathToUTF8String(path));
+
+  InlinedHashMap<std::string, Entry> loaded;
+  while (std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+
+    // <nanoseconds per unit>\t<number of samples>\t<call site>
+    const auto fields = utils::SplitString(line, "\t", true);
+    Entry entry;
+    ORT_RETURN_IF_NOT(fields.size() == 3 &&
+                          TryParseStringWithClassicLocale(fields[0], entry.nanoseconds_per_unit) &&
+                          TryParseStringWithClassicLocale(fields[1], entry.num_samples) &&
+                          entry.nanoseconds_per_unit >= 0,
+                      "Invalid entry in parallel for calibration profile ", PathToUTF8String(path), ": ", line);
+    loaded.insert_or_assign(std::string(fields[2]), entry);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto& entry : loaded) {
+    // measurements of the current process take precedence once there are enough of them
+    Entry& existing = entries_[entry.first];
+    if (existing.num_samples < kMinSamples) {
+      entry.second.num_calls = existing.num_calls;
+      existing = entry.second;
+    }
+  }
+
+  return Status::OK();
+}
+
+Status ParallelForCalibration::Save(const PathString& path) const {
+  std::ostringstream contents;
+  contents.imbue(std::locale::classic());
+  contents.precision(9);
+  contents << kProfileHeader << "\n";
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (const auto& entry : entries_) {
+      if (entry.second.num_samples >= kMinSamples) {
+        contents << entry.second.nanoseconds_per_unit << "\t" << entry.second.num_samples << "\t" << entry.first
+                 << "\n";
+      }
+    }
+  }
+
+  std::ofstream file(path, std::ios::trunc);
+  ORT_RETURN_IF_NOT(file, "Failed to open parallel for calibration profile ", PathToUTF8String(path), " for writing");
+  file << contents.str();
+  ORT_RETURN_IF_NOT(file.good(), "Failed to write parallel for calibration profile ", PathToUTF8String(path));
+  return Status::OK();
+}
+
+void ParallelForCalibration::Clear() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  entries_.clear();
+}
+
+}  // namespace concurrency
+}  // namespace onnxruntime
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace concurrency {
+
+/**
+ * Learns the actual cost of a unit of work of the ThreadPool::TryParallelFor call sites, so that the block sizes
+ * of loops with poorly calibrated TensorOpCost estimates adapt over time.
+ *
+ * The first kMinSamples calls of a call site, and every kSampleInterval-th call after that, are timed. The sum of
+ * the time spent in the blocks of the loop divided by the number of units gives the measured cost per unit, which is
+ * averaged over the samples. Once a call site has kMinSamples samples, its estimate is replaced by the measured cost.
+ *
+ * Call sites are identified by the type of the loop body, so calibration requires RTTI. The measurements can be
+ * saved to and loaded from a profile file, which is only valid for the same build of onnxruntime.
+ */
+class ParallelForCalibration {
+ public:
+  static constexpr uint32_t kMinSamples = 4;
+  static constexpr uint32_t kSampleInterval = 16;
+
+  // Process-wide instance shared by the thread pools with cost calibration enabled.
+  static ParallelForCalibration& Instance();
+
+  // Returns the calibrated cost of a unit of work of `call_site`, or `cost` if it wasn't measured enough yet.
+  TensorOpCost GetCost(std::string_view call_site, const TensorOpCost& cost) const;
+
+  // Returns true if the current call of `call_site` should be timed.
+  bool ShouldSample(std::string_view call_site);
+
+  // Record a call of `call_site` that took `nanoseconds` in total for `units` units of work.
+  void RecordSample(std::string_view call_site, std::ptrdiff_t units, uint64_t nanoseconds);
+
+  // Merge the measurements of a profile file into this instance.
+  Status Load(const PathString& path);
+
+  Status Save(const PathString& path) const;
+
+  void Clear();
+
+ private:
+  struct Entry {
+    double nanoseconds_per_unit{0};
+    uint32_t num_samples{0};
+    uint32_t num_calls{0};
+  };
+
+  mutable OrtMutex mutex_;
+  InlinedHashMap<std::string, Entry> entries_;  // GUARDED_BY(mutex_)
+};
+
+}  // namespace concurrency
+}  // namespace onnxruntime
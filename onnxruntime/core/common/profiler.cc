@@ -3,10 +3,42 @@
 
 #include "profiler.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
 namespace onnxruntime {
 namespace profiling {
 using namespace std::chrono;
 
+namespace {
+
+// Buckets 0 to 7 count the durations 0 to 7, then each power of 2 spans 8 buckets.
+size_t GetDurationBucket(long long dur, size_t num_buckets) {
+  if (dur < 8) {
+    return dur < 0 ? 0 : static_cast<size_t>(dur);
+  }
+  int log2 = 3;
+  while ((dur >> (log2 + 1)) != 0) {
+    ++log2;
+  }
+  const size_t bucket = static_cast<size_t>(log2 - 2) * 8 + static_cast<size_t>((dur >> (log2 - 3)) & 7);
+  return std::min(bucket, num_buckets - 1);
+}
+
+// The middle of the durations counted in the bucket.
+long long GetDurationBucketValue(size_t bucket) {
+  if (bucket < 8) {
+    return static_cast<long long>(bucket);
+  }
+  const int shift = static_cast<int>(bucket / 8) - 1;
+  const long long lower_bound = static_cast<long long>(8 + bucket % 8) << shift;
+  return lower_bound + ((1LL << shift) >> 1);
+}
+
+}  // namespace
+
 std::atomic<size_t> Profiler::global_max_num_events_{1000 * 1000};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
@@ -22,6 +54,9 @@ profiling::Profiler::~Profiler() {}
 ::onnxruntime::TimePoint profiling::Profiler::Start() {
   ORT_ENFORCE(enabled_);
   auto start_time = std::chrono::high_resolution_clock::now();
+  if (sampling_) {
+    return start_time;
+  }
   auto ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->Start(ts);
@@ -29,6 +64,222 @@ profiling::Profiler::~Profiler() {}
   return start_time;
 }
 
+void Profiler::EnableSampling(const ProfilerSamplingOptions& options) {
+  ORT_ENFORCE(!enabled_, "Sampling must be enabled before profiling starts.");
+  sampling_ = true;
+  sampling_options_ = options;
+}
+
+bool Profiler::SampleRun() {
+  if (!enabled_ || !sampling_) {
+    return enabled_;
+  }
+
+  const uint64_t run = num_runs_.fetch_add(1, std::memory_order_relaxed);
+  const auto rate = sampling_options_.run_sample_rate;
+  const auto interval_ms = sampling_options_.run_sample_interval_ms;
+  bool sampled = (rate == 0 && interval_ms <= 0) || (rate > 0 && run % rate == 0);
+  const long long ts = TimeDiffMicroSeconds(profiling_start_time_);
+  if (!sampled && interval_ms > 0) {
+    long long last_ts = last_sampled_run_ts_.load(std::memory_order_relaxed);
+    // only one of the runs starting at the end of the interval is sampled
+    sampled = (last_ts < 0 || ts - last_ts >= interval_ms * 1000) &&
+              last_sampled_run_ts_.compare_exchange_strong(last_ts, ts, std::memory_order_relaxed);
+  } else if (sampled) {
+    last_sampled_run_ts_.store(ts, std::memory_order_relaxed);
+  }
+
+  if (sampled) {
+    num_sampled_runs_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return sampled;
+}
+
+void Profiler::AggregateEvent(EventCategory category, const std::string& event_name, long long dur,
+                              const std::initializer_list<std::pair<std::string, std::string>>& event_args) {
+  auto& stats = event_stats_[event_name];
+  stats.category = category;
+  ++stats.count;
+  stats.total_dur += dur;
+  stats.max_dur = std::max(stats.max_dur, dur);
+  ++stats.duration_histogram[GetDurationBucket(dur, kNumDurationBuckets)];
+  for (const auto& event_arg : event_args) {
+    if (event_arg.first == "output_size") {
+      stats.total_output_size += static_cast<size_t>(std::strtoull(event_arg.second.c_str(), nullptr, 10));
+      break;
+    }
+  }
+}
+
+void Profiler::EnableRoofline(double peak_gflops_per_second, double peak_gbytes_per_second) {
+  roofline_enabled_ = true;
+  peak_gflops_per_second_ = peak_gflops_per_second;
+  peak_gbytes_per_second_ = peak_gbytes_per_second;
+}
+
+void Profiler::RecordNodeCost(const std::string& node_name, const std::string& op_type, long long dur, double flops,
+                              double bytes) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& stats = node_cost_stats_[node_name];
+  stats.op_type = op_type;
+  ++stats.count;
+  stats.total_dur += dur;
+  stats.total_flops += flops;
+  stats.total_bytes += bytes;
+}
+
+std::string Profiler::GetRooflineLocked() const {
+  // The attainable throughput of a node is bounded by the peak compute throughput, and by the peak memory bandwidth
+  // times its operations per byte. The nodes with fewer operations per byte than the peaks' ratio are memory bound.
+  const auto write_entries = [this](std::ostream& ss, const std::unordered_map<std::string, NodeCostStats>& entries,
+                                    bool is_node) {
+    std::vector<std::pair<const std::string*, const NodeCostStats*>> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& entry : entries) {
+      sorted.emplace_back(&entry.first, &entry.second);
+    }
+    // the entries taking the most time first
+    std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.second->total_dur > rhs.second->total_dur ||
+             (lhs.second->total_dur == rhs.second->total_dur && *lhs.first < *rhs.first);
+    });
+
+    bool is_first_entry = true;
+    for (const auto& entry : sorted) {
+      const NodeCostStats& stats = *entry.second;
+      const double seconds = static_cast<double>(stats.total_dur) * 1e-6;
+      const double gflops_per_second = seconds > 0.0 ? stats.total_flops / seconds * 1e-9 : 0.0;
+      const double gbytes_per_second = seconds > 0.0 ? stats.total_bytes / seconds * 1e-9 : 0.0;
+      const double flops_per_byte = stats.total_bytes > 0.0 ? stats.total_flops / stats.total_bytes : 0.0;
+      const double attainable_gflops_per_second =
+          std::min(peak_gflops_per_second_, flops_per_byte * peak_gbytes_per_second_);
+      const bool is_memory_bound = flops_per_byte * peak_gbytes_per_second_ < peak_gflops_per_second_;
+      // the share of the bounding peak achieved by the node
+      const double peak_fraction =
+          is_memory_bound ? (peak_gbytes_per_second_ > 0.0 ? gbytes_per_second / peak_gbytes_per_second_ : 0.0)
+                          : (attainable_gflops_per_second > 0.0 ? gflops_per_second / attainable_gflops_per_second
+                                                                : 0.0);
+      ss << (is_first_entry ? "" : ", ") << "{" << (is_node ? R"("name" : ")" : R"("op_type" : ")")
+         << *entry.first << "\", ";
+      if (is_node) {
+        ss << R"("op_type" : ")" << stats.op_type << "\", ";
+      }
+      ss << "\"count\" : " << stats.count << ", "
+         << "\"dur_us\" : " << stats.total_dur << ", "
+         << "\"flops\" : " << stats.total_flops << ", "
+         << "\"bytes\" : " << stats.total_bytes << ", "
+         << "\"flops_per_byte\" : " << flops_per_byte << ", "
+         << "\"gflops_per_s\" : " << gflops_per_second << ", "
+         << "\"gbytes_per_s\" : " << gbytes_per_second << ", "
+         << R"("bound" : ")" << (is_memory_bound ? "memory" : "compute") << "\", "
+         << "\"peak_fraction\" : " << peak_fraction << "}";
+      is_first_entry = false;
+    }
+  };
+
+  std::unordered_map<std::string, NodeCostStats> op_type_stats;
+  for (const auto& entry : node_cost_stats_) {
+    auto& stats = op_type_stats[entry.second.op_type];
+    stats.count += entry.second.count;
+    stats.total_dur += entry.second.total_dur;
+    stats.total_flops += entry.second.total_flops;
+    stats.total_bytes += entry.second.total_bytes;
+  }
+
+  std::ostringstream ss;
+  ss << "{\"peak_gflops_per_s\" : " << peak_gflops_per_second_
+     << ", \"peak_gbytes_per_s\" : " << peak_gbytes_per_second_ << ", \"nodes\" : [";
+  write_entries(ss, node_cost_stats_, true);
+  ss << "], \"op_types\" : [";
+  write_entries(ss, op_type_stats, false);
+  ss << "]}";
+  return ss.str();
+}
+
+std::string Profiler::GetSummaryLocked(long long ts) const {
+  // the events taking the most time first
+  std::vector<std::pair<const std::string*, const EventStats*>> events;
+  events.reserve(event_stats_.size());
+  for (const auto& entry : event_stats_) {
+    events.emplace_back(&entry.first, &entry.second);
+  }
+  std::sort(events.begin(), events.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second->total_dur > rhs.second->total_dur ||
+           (lhs.second->total_dur == rhs.second->total_dur && *lhs.first < *rhs.first);
+  });
+
+  const auto percentile = [](const EventStats& stats, double p) {
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(stats.count)));
+    size_t seen = 0;
+    for (size_t bucket = 0; bucket < stats.duration_histogram.size(); ++bucket) {
+      seen += stats.duration_histogram[bucket];
+      if (seen >= rank) {
+        return std::min(GetDurationBucketValue(bucket), stats.max_dur);
+      }
+    }
+    return stats.max_dur;
+  };
+
+  std::ostringstream ss;
+  ss << "{\"ts\" : " << ts << ", \"sampled_runs\" : " << num_sampled_runs_.load(std::memory_order_relaxed)
+     << ", \"events\" : [";
+  bool is_first_event = true;
+  for (const auto& event : events) {
+    const EventStats& stats = *event.second;
+    ss << (is_first_event ? "" : ", ")
+       << R"({"cat" : ")" << event_category_names_[stats.category] << "\", "
+       << R"("name" : ")" << *event.first << "\", "
+       << "\"count\" : " << stats.count << ", "
+       << "\"mean_us\" : " << stats.total_dur / static_cast<long long>(stats.count) << ", "
+       << "\"p50_us\" : " << percentile(stats, 0.5) << ", "
+       << "\"p99_us\" : " << percentile(stats, 0.99) << ", "
+       << "\"max_us\" : " << stats.max_dur << ", "
+       << "\"output_size_mean\" : " << stats.total_output_size / stats.count << "}";
+    is_first_event = false;
+  }
+  ss << "]";
+  if (!node_cost_stats_.empty()) {
+    ss << ", \"roofline\" : " << GetRooflineLocked();
+  }
+  ss << "}";
+  return ss.str();
+}
+
+void Profiler::FlushSummary(long long ts) {
+  if (profile_with_logger_) {
+    for (const auto& entry : event_stats_) {
+      const EventStats& stats = entry.second;
+      EventRecord event(stats.category, logging::GetProcessId(), logging::GetThreadId(), entry.first, ts,
+                        stats.total_dur / static_cast<long long>(stats.count),
+                        {{"count", std::to_string(stats.count)},
+                         {"max_us", std::to_string(stats.max_dur)},
+                         {"output_size_mean", std::to_string(stats.total_output_size / stats.count)}});
+      custom_logger_->SendProfileEvent(event);
+    }
+    if (!node_cost_stats_.empty()) {
+      EventRecord event(SESSION_EVENT, logging::GetProcessId(), logging::GetThreadId(), "roofline", ts, 0,
+                        {{"roofline", GetRooflineLocked()}});
+      custom_logger_->SendProfileEvent(event);
+    }
+  } else {
+    profile_stream_ << GetSummaryLocked(ts) << "\n";
+    profile_stream_.flush();
+  }
+
+  event_stats_.clear();
+  node_cost_stats_.clear();
+  num_sampled_runs_.store(0, std::memory_order_relaxed);
+  last_flush_ts_ = ts;
+}
+
+std::string Profiler::GetSummary() {
+  if (!sampling_) {
+    return std::string();
+  }
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return GetSummaryLocked(TimeDiffMicroSeconds(profiling_start_time_));
+}
+
 void Profiler::Initialize(const logging::Logger* session_logger) {
   ORT_ENFORCE(session_logger != nullptr);
   session_logger_ = session_logger;
@@ -48,6 +299,9 @@ void Profiler::StartProfiling(const logging::Logger* custom_logger) {
   profile_with_logger_ = true;
   custom_logger_ = custom_logger;
   profiling_start_time_ = std::chrono::high_resolution_clock::now();
+  if (sampling_) {
+    return;
+  }
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->StartProfiling(profiling_start_time_);
   }
@@ -61,6 +315,9 @@ void Profiler::StartProfiling(const std::basic_string<T>& file_name) {
 #endif
   profile_stream_file_ = ToUTF8String(file_name);
   profiling_start_time_ = std::chrono::high_resolution_clock::now();
+  if (sampling_) {
+    return;
+  }
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->StartProfiling(profiling_start_time_);
   }
@@ -79,6 +336,17 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
+  if (sampling_) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    AggregateEvent(category, event_name, dur, event_args);
+    const long long end_ts = ts + dur;
+    const auto flush_interval_ms = sampling_options_.summary_flush_interval_ms;
+    if (flush_interval_ms > 0 && end_ts - last_flush_ts_ >= flush_interval_ms * 1000) {
+      FlushSummary(end_ts);
+    }
+    return;
+  }
+
   EventRecord event(category, logging::GetProcessId(),
                     logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
   if (profile_with_logger_) {
@@ -106,7 +374,28 @@ std::string Profiler::EndProfiling() {
   if (!enabled_) {
     return std::string();
   }
+  if (sampling_) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (!event_stats_.empty()) {
+      FlushSummary(TimeDiffMicroSeconds(profiling_start_time_));
+    }
+    enabled_ = false;
+    if (profile_with_logger_) {
+      profile_with_logger_ = false;
+      return std::string();
+    }
+#if !defined(__wasm__)
+    profile_stream_.close();
+#endif
+    return profile_stream_file_;
+  }
   if (profile_with_logger_) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (!node_cost_stats_.empty()) {
+      EventRecord event(SESSION_EVENT, logging::GetProcessId(), logging::GetThreadId(), "roofline",
+                        TimeDiffMicroSeconds(profiling_start_time_), 0, {{"roofline", GetRooflineLocked()}});
+      custom_logger_->SendProfileEvent(event);
+    }
     profile_with_logger_ = false;
     return std::string();
   }
@@ -122,6 +411,12 @@ std::string Profiler::EndProfiling() {
     ep_profiler->EndProfiling(profiling_start_time_, events_);
   }
 
+  if (!node_cost_stats_.empty()) {
+    events_.emplace_back(SESSION_EVENT, logging::GetProcessId(), logging::GetThreadId(), "roofline",
+                         TimeDiffMicroSeconds(profiling_start_time_), 0,
+                         std::unordered_map<std::string, std::string>{{"roofline", GetRooflineLocked()}});
+  }
+
   for (size_t i = 0; i < events_.size(); ++i) {
     auto& rec = events_[i];
     profile_stream_ << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
@@ -3,11 +3,13 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <fstream>
 #include <initializer_list>
 #include <iostream>
 #include <tuple>
+#include <unordered_map>
 
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
@@ -21,6 +23,21 @@ namespace profiling {
 // note that static profiler instance only works with single session
 // #define ENABLE_STATIC_PROFILER_INSTANCE
 
+/**
+ * Options of the sampling mode of the profiler, in which only some of the runs are profiled, and the statistics of
+ * their events are aggregated in memory instead of recording each event. A run is an execution of a graph.
+ * If neither sampling option is set, every run is profiled.
+ */
+struct ProfilerSamplingOptions {
+  // Profile 1 in run_sample_rate runs. 0 to not sample by count.
+  uint32_t run_sample_rate{0};
+  // Profile a run if no run was profiled in the last run_sample_interval_ms milliseconds. 0 to not sample by time.
+  int64_t run_sample_interval_ms{0};
+  // Write the summary of the statistics every summary_flush_interval_ms milliseconds and reset them.
+  // 0 to write the summary only when profiling ends.
+  int64_t summary_flush_interval_ms{0};
+};
+
 /**
  * Main class for profiling. It continues to accumulate events and produce
  * a corresponding "complete event (X)" in "chrome tracing" format.
@@ -60,6 +77,44 @@ class Profiler {
   bool IsEnabled() const {
     return enabled_;
   }
+
+  /*
+  Switch to the sampling mode. Must be called before profiling starts.
+  When sampling, the profile file is in the JSON Lines format, with a summary written per flush.
+  */
+  void EnableSampling(const ProfilerSamplingOptions& options);
+
+  bool IsSampling() const {
+    return sampling_;
+  }
+
+  /*
+  Whether the events of the run starting now are recorded. Without sampling, that is whether profiling is enabled.
+  */
+  bool SampleRun();
+
+  /*
+  Return the summary of the events aggregated since the last flush as a JSON object, without resetting it.
+  Returns an empty string if the profiler isn't sampling.
+  */
+  std::string GetSummary();
+
+  /*
+  Collect the operations and bytes moved of the nodes to compare their throughput with the given peaks of the
+  machine. The roofline analysis is written per node and per op type in a "roofline" event when profiling ends, or
+  in the summary when sampling.
+  */
+  void EnableRoofline(double peak_gflops_per_second, double peak_gbytes_per_second);
+
+  bool IsRooflineEnabled() const {
+    return roofline_enabled_;
+  }
+
+  /*
+  Record an execution of a node for the roofline analysis.
+  */
+  void RecordNodeCost(const std::string& node_name, const std::string& op_type, long long dur, double flops,
+                      double bytes);
   /*
   Return the stored start time of profiler.
   On some platforms, this timer may not be as precise as nanoseconds
@@ -113,7 +168,7 @@ class Profiler {
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
-      if (enabled_) {
+      if (enabled_ && !sampling_) {
         ep_profilers_.back()->StartProfiling(profiling_start_time_);
       }
     }
@@ -122,6 +177,38 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  // The durations are counted in buckets spanning 1/8 of a power of 2 microseconds, so the percentiles are
+  // approximated within 1/16 of their value.
+  static constexpr size_t kNumDurationBuckets = 8 * 34;
+
+  // The statistics of the events with the same name in the sampling mode
+  struct EventStats {
+    EventCategory category{SESSION_EVENT};
+    size_t count{0};
+    long long total_dur{0};
+    long long max_dur{0};
+    // the total size of the outputs of the node events, which the nodes allocated
+    size_t total_output_size{0};
+    std::array<uint32_t, kNumDurationBuckets> duration_histogram{};
+  };
+
+  void AggregateEvent(EventCategory category, const std::string& event_name, long long dur,
+                      const std::initializer_list<std::pair<std::string, std::string>>& event_args);
+
+  // The costs of the executions of a node for the roofline analysis
+  struct NodeCostStats {
+    std::string op_type;
+    size_t count{0};
+    long long total_dur{0};
+    double total_flops{0.0};
+    double total_bytes{0.0};
+  };
+
+  // mutex_ must be held
+  std::string GetRooflineLocked() const;
+  std::string GetSummaryLocked(long long ts) const;
+  void FlushSummary(long long ts);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -156,6 +243,20 @@ class Profiler {
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+
+  bool sampling_{false};
+  ProfilerSamplingOptions sampling_options_;
+  std::atomic<uint64_t> num_runs_{0};
+  std::atomic<uint64_t> num_sampled_runs_{0};
+  // the time of the last sampled run in microseconds since the start of profiling, or -1 before the first one
+  std::atomic<long long> last_sampled_run_ts_{-1};
+  long long last_flush_ts_{0};
+  std::unordered_map<std::string, EventStats> event_stats_;
+
+  bool roofline_enabled_{false};
+  double peak_gflops_per_second_{0.0};
+  double peak_gbytes_per_second_{0.0};
+  std::unordered_map<std::string, NodeCostStats> node_cost_stats_;
 };
 
 }  // namespace profiling
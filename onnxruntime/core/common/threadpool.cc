@@ -13,13 +13,18 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <optional>
+#include <string_view>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/parallel_for_calibration.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #if !defined(ORT_MINIMAL_BUILD)
@@ -65,6 +70,11 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
 
 void ThreadPoolProfiler::Start() {
   enabled_ = true;
+  auto& counters = GetMainThreadStat().child_counters_at_start_;
+  counters.resize(num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    counters[i] = child_thread_stats_[i].counters_;
+  }
 }
 
 ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
@@ -111,6 +121,12 @@ void ThreadPoolProfiler::LogStart() {
   }
 }
 
+void ThreadPoolProfiler::LogTasks(unsigned num_tasks) {
+  if (enabled_) {
+    GetMainThreadStat().num_tasks_ += num_tasks;
+  }
+}
+
 void ThreadPoolProfiler::LogEnd(ThreadPoolEvent evt) {
   if (enabled_) {
     GetMainThreadStat().LogEnd(evt);
@@ -153,7 +169,11 @@ void ThreadPoolProfiler::MainThreadStat::LogStart() {
 
 void ThreadPoolProfiler::MainThreadStat::LogEnd(ThreadPoolEvent evt) {
   ORT_ENFORCE(!points_.empty(), "LogStart must pair with LogEnd");
-  events_[evt] += TimeDiffMicroSeconds(points_.back(), Clock::now());
+  const uint64_t elapsed = TimeDiffMicroSeconds(points_.back(), Clock::now());
+  events_[evt] += elapsed;
+  if (evt == WAIT) {
+    max_wait_ = std::max(max_wait_, elapsed);
+  }
   points_.pop_back();
 }
 
@@ -172,12 +192,14 @@ std::string ThreadPoolProfiler::MainThreadStat::Reset() {
     ss << blocks_.back();
     blocks_.clear();
   }
-  ss << "], \"core\": " << core_ << ", ";
+  ss << "], \"core\": " << core_ << ", \"num_tasks\": " << num_tasks_ << ", \"MaxWait\": " << max_wait_ << ", ";
   for (int i = 0; i < MAX_EVENT; ++i) {
     ss << "\"" << ThreadPoolProfiler::GetEventName(static_cast<ThreadPoolEvent>(i))
        << "\": " << events_[i] << ((i == MAX_EVENT - 1) ? std::string{} : ", ");
   }
   memset(events_, 0, sizeof(uint64_t) * MAX_EVENT);
+  num_tasks_ = 0;
+  max_wait_ = 0;
   return ss.str();
 }
 
@@ -230,11 +252,37 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+void ThreadPoolProfiler::LogSteal(int thread_idx) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].counters_.num_steal_++;
+  }
+}
+
+void ThreadPoolProfiler::LogSpinWake(int thread_idx) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].counters_.num_spin_wake_++;
+  }
+}
+
+void ThreadPoolProfiler::LogBlock(int thread_idx) {
+  if (enabled_) {
+    child_thread_stats_[thread_idx].counters_.num_block_++;
+  }
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
+  // the counters are reported since the calling thread started profiling
+  const auto& counters_at_start = GetMainThreadStat().child_counters_at_start_;
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
+    const ChildThreadCounters& counters = child_thread_stats_[i].counters_;
+    const ChildThreadCounters start = static_cast<size_t>(i) < counters_at_start.size() ? counters_at_start[i]
+                                                                                        : ChildThreadCounters{};
     ss << "\"" << child_thread_stats_[i].thread_id_ << "\": {"
        << "\"num_run\": " << child_thread_stats_[i].num_run_ << ", "
+       << "\"num_steal\": " << counters.num_steal_ - start.num_steal_ << ", "
+       << "\"num_spin_wake\": " << counters.num_spin_wake_ - start.num_spin_wake_ << ", "
+       << "\"num_block\": " << counters.num_block_ - start.num_block_ << ", "
        << "\"core\": " << child_thread_stats_[i].core_ << "}"
        << (i == num_threads_ - 1 ? "" : ",");
   }
@@ -273,7 +321,8 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
               uint64_t d_of_p,
               uint64_t block_size = 1) : _num_shards(GetNumShards(num_iterations,
                                                                   d_of_p,
-                                                                  block_size)) {
+                                                                  block_size)),
+                                         _d_of_p(static_cast<unsigned>(d_of_p)) {
     // Divide the iteration space between the shards.  If the iteration
     // space does not divide evenly into shards of multiples of
     // block_size then the final shard is left uneven.
@@ -301,9 +350,14 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
   // loops: the worker that runs a given iteration in one loop will
   // tend to run the same iterations in the next loop.  This helps
   // operators with a series of short loops, such as GRU.
+  //
+  // Consecutive worker IDs share a home shard.  The thread pool hands
+  // out consecutive worker IDs to workers on the same NUMA node, so
+  // the iterations of a shard (and those of the neighboring shards
+  // that a thread proceeds to) tend to stay on one node.
 
   unsigned GetHomeShard(unsigned idx) const {
-    return idx % _num_shards;
+    return static_cast<unsigned>((static_cast<uint64_t>(idx) * _num_shards) / _d_of_p);
   }
 
   // Attempt to claim iterations from the sharded counter.  The function either
@@ -363,12 +417,67 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
 
   alignas(CACHE_LINE_BYTES) LoopCounterShard _shards[MAX_SHARDS];
   const unsigned _num_shards;
+  const unsigned _d_of_p;
 };
 
 #ifdef _MSC_VER
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
 
+namespace {
+
+// Runs the work of a ThreadPool on a scheduler of the application instead of threads created by the pool.
+class CustomSchedulerThreadPool final : public ExtendedThreadPoolInterface {
+ public:
+  explicit CustomSchedulerThreadPool(const OrtCustomScheduler& scheduler) : scheduler_(scheduler) {}
+
+  void Schedule(std::function<void()> fn) override {
+    auto task = std::make_unique<std::function<void()>>(std::move(fn));
+    scheduler_.Schedule(scheduler_.scheduler_state, RunScheduledTask, task.release());
+  }
+
+  // Parallel sections amortize the costs of distributing work to the threads of the pool, which the scheduler
+  // handles, so the loops of a section run as individual loops.
+  void StartParallelSection(ThreadPoolParallelSection&) override {}
+  void EndParallelSection(ThreadPoolParallelSection&) override {}
+
+  void RunInParallelSection(ThreadPoolParallelSection&, std::function<void(unsigned idx)> fn,
+                            unsigned n, std::ptrdiff_t block_size) override {
+    RunInParallel(std::move(fn), n, block_size);
+  }
+
+  void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t) override {
+    if (n <= 1) {
+      fn(0);
+      return;
+    }
+    scheduler_.RunTasks(scheduler_.scheduler_state, RunParallelTask, &fn, n);
+  }
+
+  // the calling thread takes part in the loops, as with the threads of the pool
+  int NumThreads() const override { return scheduler_.degree_of_parallelism - 1; }
+
+  // the threads of the scheduler are never threads of the pool
+  int CurrentThreadId() const override { return -1; }
+
+  void StartProfiling() override {}
+  std::string StopProfiling() override { return {}; }
+
+ private:
+  static void RunScheduledTask(void* ort_task_param, size_t) {
+    std::unique_ptr<std::function<void()>> task(static_cast<std::function<void()>*>(ort_task_param));
+    (*task)();
+  }
+
+  static void RunParallelTask(void* ort_task_param, size_t task_index) {
+    (*static_cast<std::function<void(unsigned idx)>*>(ort_task_param))(static_cast<unsigned>(task_index));
+  }
+
+  const OrtCustomScheduler scheduler_;
+};
+
+}  // namespace
+
 ThreadPool::ThreadPool(Env* env,
                        const ThreadOptions& thread_options,
                        const NAME_CHAR_TYPE* name,
@@ -376,11 +485,21 @@ ThreadPool::ThreadPool(Env* env,
                        bool low_latency_hint,
                        bool force_hybrid)
     : thread_options_(thread_options), force_hybrid_(force_hybrid) {
+#ifndef ORT_NO_RTTI
+  if (thread_options_.calibrate_parallel_for_costs) {
+    cost_calibration_ = &ParallelForCalibration::Instance();
+  }
+#endif
+
   // In the current implementation, a thread pool with degree_of_parallelism==1 uses
   // the caller as one of the threads for executing work.  Hence we only create
   // additional thread(s) for degree_of_parallelism>=2.
   assert(degree_of_parallelism >= 1);
-  if (degree_of_parallelism >= 2) {
+  if (thread_options_.custom_scheduler) {
+    // the scheduler provides the threads, with the degree of parallelism it was created with
+    custom_scheduler_threadpool_ = std::make_unique<CustomSchedulerThreadPool>(*thread_options_.custom_scheduler);
+    underlying_threadpool_ = custom_scheduler_threadpool_.get();
+  } else if (degree_of_parallelism >= 2) {
     int threads_to_create = degree_of_parallelism - 1;
 
     if (!thread_options_.affinities.empty()) {
@@ -422,6 +541,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     auto num_blocks = total / block_size;
     auto num_threads_inc_main = NumThreads() + 1;
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
+    num_work_items = NumWorkItemsInShare(num_work_items);
     assert(num_work_items > 0);
 
     LoopCounter lc(total, d_of_p, block_size);
@@ -459,7 +579,7 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     };
     // Distribute task among all threads in the pool, reduce number of work items if
     // num_of_blocks is smaller than number of threads.
-    RunInParallel(run_work, std::min(NumThreads() + 1, num_of_blocks), base_block_size);
+    RunInParallel(run_work, NumWorkItemsInShare(std::min(NumThreads() + 1, num_of_blocks)), base_block_size);
   }
 }
 
@@ -494,30 +614,90 @@ std::string ThreadPool::StopProfiling() {
 }
 
 namespace {
-thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
-}
+// Storage for the outermost parallel section of the thread, which avoids an allocation for sections that aren't
+// nested.
+thread_local std::optional<ThreadPoolParallelSection> outermost_parallel_section;
+
+// The innermost parallel section of the thread, or nullptr.
+thread_local ThreadPoolParallelSection* current_parallel_section = nullptr;
+}  // namespace
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
-  ORT_ENFORCE(!current_parallel_section.has_value(), "Nested parallelism not supported");
   ORT_ENFORCE(!ps_);
   tp_ = tp;
   if (tp && tp->underlying_threadpool_) {
-    current_parallel_section.emplace();
-    ps_ = &*current_parallel_section;
+    outer_ps_ = current_parallel_section;
+    if (outer_ps_ == nullptr) {
+      outermost_parallel_section.emplace();
+      ps_ = &*outermost_parallel_section;
+    } else {
+      ps_ = new ThreadPoolParallelSection();
+    }
+    current_parallel_section = ps_;
     tp_->underlying_threadpool_->StartParallelSection(*ps_);
   }
 }
 
 ThreadPool::ParallelSection::~ParallelSection() {
-  if (current_parallel_section) {
+  if (ps_) {
     tp_->underlying_threadpool_->EndParallelSection(*ps_);
-    current_parallel_section.reset();
+    current_parallel_section = outer_ps_;
+    if (outer_ps_ == nullptr) {
+      outermost_parallel_section.reset();
+    } else {
+      delete ps_;
+    }
+  }
+}
+
+namespace {
+thread_local const ThreadPool::WorkShareScope* current_work_share_scope = nullptr;
+}
+
+ThreadPool::WorkShareScope::WorkShareScope(ThreadPool* tp, const WorkShare& share) : share_(share) {
+  ORT_ENFORCE(share.weight > 0 && share.min_threads >= 0, "Invalid work share");
+  previous_ = current_work_share_scope;
+  for (const auto* scope = previous_; scope != nullptr; scope = scope->previous_) {
+    if (scope->tp_ == tp) {
+      return;
+    }
+  }
+
+  if (tp && tp->underlying_threadpool_) {
+    tp_ = tp;
+    tp_->active_work_share_weight_.fetch_add(share_.weight, std::memory_order_relaxed);
+    current_work_share_scope = this;
+  }
+}
+
+ThreadPool::WorkShareScope::~WorkShareScope() {
+  if (tp_) {
+    tp_->active_work_share_weight_.fetch_sub(share_.weight, std::memory_order_relaxed);
+    current_work_share_scope = previous_;
+  }
+}
+
+int ThreadPool::NumWorkItemsInShare(int num_work_items) const {
+  const WorkShareScope* scope = current_work_share_scope;
+  while (scope != nullptr && scope->tp_ != this) {
+    scope = scope->previous_;
   }
+  if (scope == nullptr) {
+    return num_work_items;
+  }
+
+  const int num_threads_inc_main = NumThreads() + 1;
+  const int total_weight = std::max(active_work_share_weight_.load(std::memory_order_relaxed), scope->share_.weight);
+  int share = static_cast<int>(static_cast<int64_t>(num_threads_inc_main) * scope->share_.weight / total_weight);
+  share = std::min(std::max({share, scope->share_.min_threads, 1}), num_threads_inc_main);
+  return std::min(num_work_items, share);
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
   if (underlying_threadpool_) {
-    if (current_parallel_section.has_value()) {
+    // A loop started from the body of a loop of the current parallel section, on the thread leading the section,
+    // can't reuse the workers of the section as they are busy, so it runs with workers of its own.
+    if (current_parallel_section != nullptr && current_parallel_section->current_loop.load() == nullptr) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
                                                    std::move(fn),
                                                    n, block_size);
@@ -613,6 +793,12 @@ static ptrdiff_t CalculateParallelForBlock(const ptrdiff_t n, const Eigen::Tenso
 void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& f) {
   ORT_ENFORCE(n >= 0);
+#ifndef ORT_NO_RTTI
+  if (cost_calibration_ != nullptr) {
+    CalibratedParallelFor(n, c, f);
+    return;
+  }
+#endif
   Eigen::TensorOpCost cost{c.bytes_loaded, c.bytes_stored, c.compute_cycles};
   auto d_of_p = DegreeOfParallelism(this);
   // Compute small problems directly in the caller thread.
@@ -626,6 +812,50 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
   ParallelForFixedBlockSizeScheduling(n, block, f);
 }
 
+void ThreadPool::CalibratedParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
+                                       const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& f) {
+#ifndef ORT_NO_RTTI
+  // the type of the loop body identifies the call site
+  const std::string_view call_site = f.target_type().name();
+  const TensorOpCost calibrated = cost_calibration_->GetCost(call_site, c);
+  Eigen::TensorOpCost cost{calibrated.bytes_loaded, calibrated.bytes_stored, calibrated.compute_cycles};
+  auto d_of_p = DegreeOfParallelism(this);
+  const bool run_inline = (!ShouldParallelizeLoop(n)) ||
+                          CostModel::numThreads(static_cast<double>(n), cost, d_of_p) == 1;
+
+  if (!cost_calibration_->ShouldSample(call_site)) {
+    if (run_inline) {
+      f(0, n);
+    } else {
+      ParallelForFixedBlockSizeScheduling(n, CalculateParallelForBlock(n, cost, nullptr, d_of_p), f);
+    }
+    return;
+  }
+
+  // the time spent in the blocks, which excludes the overhead of distributing them
+  std::atomic<uint64_t> nanoseconds{0};
+  auto timed_f = [&f, &nanoseconds](std::ptrdiff_t first, std::ptrdiff_t last) {
+    const auto start = std::chrono::steady_clock::now();
+    f(first, last);
+    nanoseconds += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+  };
+
+  if (run_inline) {
+    timed_f(0, n);
+  } else {
+    ParallelForFixedBlockSizeScheduling(n, CalculateParallelForBlock(n, cost, nullptr, d_of_p), timed_f);
+  }
+
+  cost_calibration_->RecordSample(call_site, n, nanoseconds);
+#else
+  ORT_UNUSED_PARAMETER(n);
+  ORT_UNUSED_PARAMETER(c);
+  ORT_UNUSED_PARAMETER(f);
+  ORT_THROW("Cost calibration requires RTTI.");
+#endif
+}
+
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& fn) {
   ParallelFor(total, TensorOpCost{0, 0, static_cast<double>(cost_per_unit)}, fn);
@@ -675,6 +905,15 @@ void ThreadPool::DisableSpinning() {
   }
 }
 
+void ThreadPool::GetBusyTime(const ThreadPool* tp, int& num_threads, uint64_t& busy_ns) {
+  num_threads = 0;
+  busy_ns = 0;
+  if (tp && tp->extended_eigen_threadpool_) {
+    num_threads = tp->extended_eigen_threadpool_->NumThreads();
+    busy_ns = tp->extended_eigen_threadpool_->BusyNanoseconds();
+  }
+}
+
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
   if (underlying_threadpool_) {
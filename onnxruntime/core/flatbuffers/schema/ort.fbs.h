@@ -98,6 +98,9 @@ struct OpIdKernelTypeStrArgsEntryBuilder;
 struct KernelTypeStrResolver;
 struct KernelTypeStrResolverBuilder;
 
+struct ExecutionPlan;
+struct ExecutionPlanBuilder;
+
 struct InferenceSession;
 struct InferenceSessionBuilder;
 
@@ -2979,12 +2982,425 @@ inline flatbuffers::Offset<KernelTypeStrResolver> CreateKernelTypeStrResolverDir
       op_kernel_type_str_args__);
 }
 
+struct ExecutionPlan FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef ExecutionPlanBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_CONFIG_HASH = 4,
+    VT_ALLOC_KINDS = 6,
+    VT_REUSED_BUFFERS = 8,
+    VT_LOCATIONS = 10,
+    VT_PROGRAM_COUNTER_OFFSETS = 12,
+    VT_PROGRAM_COUNTER_STARTS = 14,
+    VT_PROGRAM_COUNTER_ENDS = 16,
+    VT_INITIALIZER_ALLOCATION_ORDER = 18,
+    VT_ACTIVATION_ALLOCATION_ORDER = 20,
+    VT_STREAM_LOCATIONS = 22,
+    VT_STREAM_STEP_OFFSETS = 24,
+    VT_STEP_TYPES = 26,
+    VT_STEP_NODE_INDICES = 28,
+    VT_STEP_PARAMS = 30,
+    VT_VALUE_TO_STREAM_KEYS = 32,
+    VT_VALUE_TO_STREAM_VALUES = 34,
+    VT_RELEASE_ACTION_VALUES = 36,
+    VT_RELEASE_ACTION_REF_COUNTS = 38,
+    VT_NODE_RELEASE_OFFSETS = 40,
+    VT_NODE_RELEASE_ACTIONS = 42,
+    VT_NOTIFICATION_OWNERS = 44,
+    VT_DOWNSTREAM_KEYS = 46,
+    VT_DOWNSTREAM_OFFSETS = 48,
+    VT_DOWNSTREAM_STREAM_INDICES = 50,
+    VT_DOWNSTREAM_STEP_INDICES = 52,
+    VT_NUM_BARRIERS = 54,
+    VT_VIEW_VALUES = 56
+  };
+  uint64_t config_hash() const {
+    return GetField<uint64_t>(VT_CONFIG_HASH, 0);
+  }
+  const flatbuffers::Vector<int32_t> *alloc_kinds() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_ALLOC_KINDS);
+  }
+  const flatbuffers::Vector<int32_t> *reused_buffers() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_REUSED_BUFFERS);
+  }
+  const flatbuffers::Vector<uint32_t> *locations() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_LOCATIONS);
+  }
+  const flatbuffers::Vector<uint32_t> *program_counter_offsets() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_PROGRAM_COUNTER_OFFSETS);
+  }
+  const flatbuffers::Vector<uint32_t> *program_counter_starts() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_PROGRAM_COUNTER_STARTS);
+  }
+  const flatbuffers::Vector<uint32_t> *program_counter_ends() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_PROGRAM_COUNTER_ENDS);
+  }
+  const flatbuffers::Vector<int32_t> *initializer_allocation_order() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_INITIALIZER_ALLOCATION_ORDER);
+  }
+  const flatbuffers::Vector<int32_t> *activation_allocation_order() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_ACTIVATION_ALLOCATION_ORDER);
+  }
+  const flatbuffers::Vector<uint32_t> *stream_locations() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_STREAM_LOCATIONS);
+  }
+  const flatbuffers::Vector<uint32_t> *stream_step_offsets() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_STREAM_STEP_OFFSETS);
+  }
+  const flatbuffers::Vector<uint8_t> *step_types() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_STEP_TYPES);
+  }
+  const flatbuffers::Vector<uint32_t> *step_node_indices() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_STEP_NODE_INDICES);
+  }
+  const flatbuffers::Vector<uint32_t> *step_params() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_STEP_PARAMS);
+  }
+  const flatbuffers::Vector<uint32_t> *value_to_stream_keys() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_VALUE_TO_STREAM_KEYS);
+  }
+  const flatbuffers::Vector<uint32_t> *value_to_stream_values() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_VALUE_TO_STREAM_VALUES);
+  }
+  const flatbuffers::Vector<uint32_t> *release_action_values() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_RELEASE_ACTION_VALUES);
+  }
+  const flatbuffers::Vector<uint32_t> *release_action_ref_counts() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_RELEASE_ACTION_REF_COUNTS);
+  }
+  const flatbuffers::Vector<uint32_t> *node_release_offsets() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_NODE_RELEASE_OFFSETS);
+  }
+  const flatbuffers::Vector<uint32_t> *node_release_actions() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_NODE_RELEASE_ACTIONS);
+  }
+  const flatbuffers::Vector<uint32_t> *notification_owners() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_NOTIFICATION_OWNERS);
+  }
+  const flatbuffers::Vector<uint32_t> *downstream_keys() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_DOWNSTREAM_KEYS);
+  }
+  const flatbuffers::Vector<uint32_t> *downstream_offsets() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_DOWNSTREAM_OFFSETS);
+  }
+  const flatbuffers::Vector<uint32_t> *downstream_stream_indices() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_DOWNSTREAM_STREAM_INDICES);
+  }
+  const flatbuffers::Vector<uint32_t> *downstream_step_indices() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_DOWNSTREAM_STEP_INDICES);
+  }
+  uint32_t num_barriers() const {
+    return GetField<uint32_t>(VT_NUM_BARRIERS, 0);
+  }
+  const flatbuffers::Vector<int32_t> *view_values() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_VIEW_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint64_t>(verifier, VT_CONFIG_HASH) &&
+           VerifyOffset(verifier, VT_ALLOC_KINDS) &&
+           verifier.VerifyVector(alloc_kinds()) &&
+           VerifyOffset(verifier, VT_REUSED_BUFFERS) &&
+           verifier.VerifyVector(reused_buffers()) &&
+           VerifyOffset(verifier, VT_LOCATIONS) &&
+           verifier.VerifyVector(locations()) &&
+           VerifyOffset(verifier, VT_PROGRAM_COUNTER_OFFSETS) &&
+           verifier.VerifyVector(program_counter_offsets()) &&
+           VerifyOffset(verifier, VT_PROGRAM_COUNTER_STARTS) &&
+           verifier.VerifyVector(program_counter_starts()) &&
+           VerifyOffset(verifier, VT_PROGRAM_COUNTER_ENDS) &&
+           verifier.VerifyVector(program_counter_ends()) &&
+           VerifyOffset(verifier, VT_INITIALIZER_ALLOCATION_ORDER) &&
+           verifier.VerifyVector(initializer_allocation_order()) &&
+           VerifyOffset(verifier, VT_ACTIVATION_ALLOCATION_ORDER) &&
+           verifier.VerifyVector(activation_allocation_order()) &&
+           VerifyOffset(verifier, VT_STREAM_LOCATIONS) &&
+           verifier.VerifyVector(stream_locations()) &&
+           VerifyOffset(verifier, VT_STREAM_STEP_OFFSETS) &&
+           verifier.VerifyVector(stream_step_offsets()) &&
+           VerifyOffset(verifier, VT_STEP_TYPES) &&
+           verifier.VerifyVector(step_types()) &&
+           VerifyOffset(verifier, VT_STEP_NODE_INDICES) &&
+           verifier.VerifyVector(step_node_indices()) &&
+           VerifyOffset(verifier, VT_STEP_PARAMS) &&
+           verifier.VerifyVector(step_params()) &&
+           VerifyOffset(verifier, VT_VALUE_TO_STREAM_KEYS) &&
+           verifier.VerifyVector(value_to_stream_keys()) &&
+           VerifyOffset(verifier, VT_VALUE_TO_STREAM_VALUES) &&
+           verifier.VerifyVector(value_to_stream_values()) &&
+           VerifyOffset(verifier, VT_RELEASE_ACTION_VALUES) &&
+           verifier.VerifyVector(release_action_values()) &&
+           VerifyOffset(verifier, VT_RELEASE_ACTION_REF_COUNTS) &&
+           verifier.VerifyVector(release_action_ref_counts()) &&
+           VerifyOffset(verifier, VT_NODE_RELEASE_OFFSETS) &&
+           verifier.VerifyVector(node_release_offsets()) &&
+           VerifyOffset(verifier, VT_NODE_RELEASE_ACTIONS) &&
+           verifier.VerifyVector(node_release_actions()) &&
+           VerifyOffset(verifier, VT_NOTIFICATION_OWNERS) &&
+           verifier.VerifyVector(notification_owners()) &&
+           VerifyOffset(verifier, VT_DOWNSTREAM_KEYS) &&
+           verifier.VerifyVector(downstream_keys()) &&
+           VerifyOffset(verifier, VT_DOWNSTREAM_OFFSETS) &&
+           verifier.VerifyVector(downstream_offsets()) &&
+           VerifyOffset(verifier, VT_DOWNSTREAM_STREAM_INDICES) &&
+           verifier.VerifyVector(downstream_stream_indices()) &&
+           VerifyOffset(verifier, VT_DOWNSTREAM_STEP_INDICES) &&
+           verifier.VerifyVector(downstream_step_indices()) &&
+           VerifyField<uint32_t>(verifier, VT_NUM_BARRIERS) &&
+           VerifyOffset(verifier, VT_VIEW_VALUES) &&
+           verifier.VerifyVector(view_values()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ExecutionPlanBuilder {
+  typedef ExecutionPlan Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_config_hash(uint64_t config_hash) {
+    fbb_.AddElement<uint64_t>(ExecutionPlan::VT_CONFIG_HASH, config_hash, 0);
+  }
+  void add_alloc_kinds(flatbuffers::Offset<flatbuffers::Vector<int32_t>> alloc_kinds) {
+    fbb_.AddOffset(ExecutionPlan::VT_ALLOC_KINDS, alloc_kinds);
+  }
+  void add_reused_buffers(flatbuffers::Offset<flatbuffers::Vector<int32_t>> reused_buffers) {
+    fbb_.AddOffset(ExecutionPlan::VT_REUSED_BUFFERS, reused_buffers);
+  }
+  void add_locations(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> locations) {
+    fbb_.AddOffset(ExecutionPlan::VT_LOCATIONS, locations);
+  }
+  void add_program_counter_offsets(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> program_counter_offsets) {
+    fbb_.AddOffset(ExecutionPlan::VT_PROGRAM_COUNTER_OFFSETS, program_counter_offsets);
+  }
+  void add_program_counter_starts(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> program_counter_starts) {
+    fbb_.AddOffset(ExecutionPlan::VT_PROGRAM_COUNTER_STARTS, program_counter_starts);
+  }
+  void add_program_counter_ends(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> program_counter_ends) {
+    fbb_.AddOffset(ExecutionPlan::VT_PROGRAM_COUNTER_ENDS, program_counter_ends);
+  }
+  void add_initializer_allocation_order(flatbuffers::Offset<flatbuffers::Vector<int32_t>> initializer_allocation_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_INITIALIZER_ALLOCATION_ORDER, initializer_allocation_order);
+  }
+  void add_activation_allocation_order(flatbuffers::Offset<flatbuffers::Vector<int32_t>> activation_allocation_order) {
+    fbb_.AddOffset(ExecutionPlan::VT_ACTIVATION_ALLOCATION_ORDER, activation_allocation_order);
+  }
+  void add_stream_locations(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> stream_locations) {
+    fbb_.AddOffset(ExecutionPlan::VT_STREAM_LOCATIONS, stream_locations);
+  }
+  void add_stream_step_offsets(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> stream_step_offsets) {
+    fbb_.AddOffset(ExecutionPlan::VT_STREAM_STEP_OFFSETS, stream_step_offsets);
+  }
+  void add_step_types(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> step_types) {
+    fbb_.AddOffset(ExecutionPlan::VT_STEP_TYPES, step_types);
+  }
+  void add_step_node_indices(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> step_node_indices) {
+    fbb_.AddOffset(ExecutionPlan::VT_STEP_NODE_INDICES, step_node_indices);
+  }
+  void add_step_params(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> step_params) {
+    fbb_.AddOffset(ExecutionPlan::VT_STEP_PARAMS, step_params);
+  }
+  void add_value_to_stream_keys(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> value_to_stream_keys) {
+    fbb_.AddOffset(ExecutionPlan::VT_VALUE_TO_STREAM_KEYS, value_to_stream_keys);
+  }
+  void add_value_to_stream_values(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> value_to_stream_values) {
+    fbb_.AddOffset(ExecutionPlan::VT_VALUE_TO_STREAM_VALUES, value_to_stream_values);
+  }
+  void add_release_action_values(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> release_action_values) {
+    fbb_.AddOffset(ExecutionPlan::VT_RELEASE_ACTION_VALUES, release_action_values);
+  }
+  void add_release_action_ref_counts(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> release_action_ref_counts) {
+    fbb_.AddOffset(ExecutionPlan::VT_RELEASE_ACTION_REF_COUNTS, release_action_ref_counts);
+  }
+  void add_node_release_offsets(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> node_release_offsets) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_RELEASE_OFFSETS, node_release_offsets);
+  }
+  void add_node_release_actions(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> node_release_actions) {
+    fbb_.AddOffset(ExecutionPlan::VT_NODE_RELEASE_ACTIONS, node_release_actions);
+  }
+  void add_notification_owners(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> notification_owners) {
+    fbb_.AddOffset(ExecutionPlan::VT_NOTIFICATION_OWNERS, notification_owners);
+  }
+  void add_downstream_keys(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_keys) {
+    fbb_.AddOffset(ExecutionPlan::VT_DOWNSTREAM_KEYS, downstream_keys);
+  }
+  void add_downstream_offsets(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_offsets) {
+    fbb_.AddOffset(ExecutionPlan::VT_DOWNSTREAM_OFFSETS, downstream_offsets);
+  }
+  void add_downstream_stream_indices(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_stream_indices) {
+    fbb_.AddOffset(ExecutionPlan::VT_DOWNSTREAM_STREAM_INDICES, downstream_stream_indices);
+  }
+  void add_downstream_step_indices(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_step_indices) {
+    fbb_.AddOffset(ExecutionPlan::VT_DOWNSTREAM_STEP_INDICES, downstream_step_indices);
+  }
+  void add_num_barriers(uint32_t num_barriers) {
+    fbb_.AddElement<uint32_t>(ExecutionPlan::VT_NUM_BARRIERS, num_barriers, 0);
+  }
+  void add_view_values(flatbuffers::Offset<flatbuffers::Vector<int32_t>> view_values) {
+    fbb_.AddOffset(ExecutionPlan::VT_VIEW_VALUES, view_values);
+  }
+  explicit ExecutionPlanBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ExecutionPlanBuilder &operator=(const ExecutionPlanBuilder &);
+  flatbuffers::Offset<ExecutionPlan> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ExecutionPlan>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ExecutionPlan> CreateExecutionPlan(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t config_hash = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> alloc_kinds = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> reused_buffers = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> locations = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> program_counter_offsets = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> program_counter_starts = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> program_counter_ends = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> initializer_allocation_order = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> activation_allocation_order = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> stream_locations = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> stream_step_offsets = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> step_types = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> step_node_indices = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> step_params = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> value_to_stream_keys = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> value_to_stream_values = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> release_action_values = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> release_action_ref_counts = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> node_release_offsets = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> node_release_actions = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> notification_owners = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_keys = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_offsets = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_stream_indices = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> downstream_step_indices = 0,
+    uint32_t num_barriers = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> view_values = 0) {
+  ExecutionPlanBuilder builder_(_fbb);
+  builder_.add_config_hash(config_hash);
+  builder_.add_view_values(view_values);
+  builder_.add_num_barriers(num_barriers);
+  builder_.add_downstream_step_indices(downstream_step_indices);
+  builder_.add_downstream_stream_indices(downstream_stream_indices);
+  builder_.add_downstream_offsets(downstream_offsets);
+  builder_.add_downstream_keys(downstream_keys);
+  builder_.add_notification_owners(notification_owners);
+  builder_.add_node_release_actions(node_release_actions);
+  builder_.add_node_release_offsets(node_release_offsets);
+  builder_.add_release_action_ref_counts(release_action_ref_counts);
+  builder_.add_release_action_values(release_action_values);
+  builder_.add_value_to_stream_values(value_to_stream_values);
+  builder_.add_value_to_stream_keys(value_to_stream_keys);
+  builder_.add_step_params(step_params);
+  builder_.add_step_node_indices(step_node_indices);
+  builder_.add_step_types(step_types);
+  builder_.add_stream_step_offsets(stream_step_offsets);
+  builder_.add_stream_locations(stream_locations);
+  builder_.add_activation_allocation_order(activation_allocation_order);
+  builder_.add_initializer_allocation_order(initializer_allocation_order);
+  builder_.add_program_counter_ends(program_counter_ends);
+  builder_.add_program_counter_starts(program_counter_starts);
+  builder_.add_program_counter_offsets(program_counter_offsets);
+  builder_.add_locations(locations);
+  builder_.add_reused_buffers(reused_buffers);
+  builder_.add_alloc_kinds(alloc_kinds);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<ExecutionPlan> CreateExecutionPlanDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t config_hash = 0,
+    const std::vector<int32_t> *alloc_kinds = nullptr,
+    const std::vector<int32_t> *reused_buffers = nullptr,
+    const std::vector<uint32_t> *locations = nullptr,
+    const std::vector<uint32_t> *program_counter_offsets = nullptr,
+    const std::vector<uint32_t> *program_counter_starts = nullptr,
+    const std::vector<uint32_t> *program_counter_ends = nullptr,
+    const std::vector<int32_t> *initializer_allocation_order = nullptr,
+    const std::vector<int32_t> *activation_allocation_order = nullptr,
+    const std::vector<uint32_t> *stream_locations = nullptr,
+    const std::vector<uint32_t> *stream_step_offsets = nullptr,
+    const std::vector<uint8_t> *step_types = nullptr,
+    const std::vector<uint32_t> *step_node_indices = nullptr,
+    const std::vector<uint32_t> *step_params = nullptr,
+    const std::vector<uint32_t> *value_to_stream_keys = nullptr,
+    const std::vector<uint32_t> *value_to_stream_values = nullptr,
+    const std::vector<uint32_t> *release_action_values = nullptr,
+    const std::vector<uint32_t> *release_action_ref_counts = nullptr,
+    const std::vector<uint32_t> *node_release_offsets = nullptr,
+    const std::vector<uint32_t> *node_release_actions = nullptr,
+    const std::vector<uint32_t> *notification_owners = nullptr,
+    const std::vector<uint32_t> *downstream_keys = nullptr,
+    const std::vector<uint32_t> *downstream_offsets = nullptr,
+    const std::vector<uint32_t> *downstream_stream_indices = nullptr,
+    const std::vector<uint32_t> *downstream_step_indices = nullptr,
+    uint32_t num_barriers = 0,
+    const std::vector<int32_t> *view_values = nullptr) {
+  auto alloc_kinds__ = alloc_kinds ? _fbb.CreateVector<int32_t>(*alloc_kinds) : 0;
+  auto reused_buffers__ = reused_buffers ? _fbb.CreateVector<int32_t>(*reused_buffers) : 0;
+  auto locations__ = locations ? _fbb.CreateVector<uint32_t>(*locations) : 0;
+  auto program_counter_offsets__ = program_counter_offsets ? _fbb.CreateVector<uint32_t>(*program_counter_offsets) : 0;
+  auto program_counter_starts__ = program_counter_starts ? _fbb.CreateVector<uint32_t>(*program_counter_starts) : 0;
+  auto program_counter_ends__ = program_counter_ends ? _fbb.CreateVector<uint32_t>(*program_counter_ends) : 0;
+  auto initializer_allocation_order__ = initializer_allocation_order ? _fbb.CreateVector<int32_t>(*initializer_allocation_order) : 0;
+  auto activation_allocation_order__ = activation_allocation_order ? _fbb.CreateVector<int32_t>(*activation_allocation_order) : 0;
+  auto stream_locations__ = stream_locations ? _fbb.CreateVector<uint32_t>(*stream_locations) : 0;
+  auto stream_step_offsets__ = stream_step_offsets ? _fbb.CreateVector<uint32_t>(*stream_step_offsets) : 0;
+  auto step_types__ = step_types ? _fbb.CreateVector<uint8_t>(*step_types) : 0;
+  auto step_node_indices__ = step_node_indices ? _fbb.CreateVector<uint32_t>(*step_node_indices) : 0;
+  auto step_params__ = step_params ? _fbb.CreateVector<uint32_t>(*step_params) : 0;
+  auto value_to_stream_keys__ = value_to_stream_keys ? _fbb.CreateVector<uint32_t>(*value_to_stream_keys) : 0;
+  auto value_to_stream_values__ = value_to_stream_values ? _fbb.CreateVector<uint32_t>(*value_to_stream_values) : 0;
+  auto release_action_values__ = release_action_values ? _fbb.CreateVector<uint32_t>(*release_action_values) : 0;
+  auto release_action_ref_counts__ = release_action_ref_counts ? _fbb.CreateVector<uint32_t>(*release_action_ref_counts) : 0;
+  auto node_release_offsets__ = node_release_offsets ? _fbb.CreateVector<uint32_t>(*node_release_offsets) : 0;
+  auto node_release_actions__ = node_release_actions ? _fbb.CreateVector<uint32_t>(*node_release_actions) : 0;
+  auto notification_owners__ = notification_owners ? _fbb.CreateVector<uint32_t>(*notification_owners) : 0;
+  auto downstream_keys__ = downstream_keys ? _fbb.CreateVector<uint32_t>(*downstream_keys) : 0;
+  auto downstream_offsets__ = downstream_offsets ? _fbb.CreateVector<uint32_t>(*downstream_offsets) : 0;
+  auto downstream_stream_indices__ = downstream_stream_indices ? _fbb.CreateVector<uint32_t>(*downstream_stream_indices) : 0;
+  auto downstream_step_indices__ = downstream_step_indices ? _fbb.CreateVector<uint32_t>(*downstream_step_indices) : 0;
+  auto view_values__ = view_values ? _fbb.CreateVector<int32_t>(*view_values) : 0;
+  return onnxruntime::fbs::CreateExecutionPlan(
+      _fbb,
+      config_hash,
+      alloc_kinds__,
+      reused_buffers__,
+      locations__,
+      program_counter_offsets__,
+      program_counter_starts__,
+      program_counter_ends__,
+      initializer_allocation_order__,
+      activation_allocation_order__,
+      stream_locations__,
+      stream_step_offsets__,
+      step_types__,
+      step_node_indices__,
+      step_params__,
+      value_to_stream_keys__,
+      value_to_stream_values__,
+      release_action_values__,
+      release_action_ref_counts__,
+      node_release_offsets__,
+      node_release_actions__,
+      notification_owners__,
+      downstream_keys__,
+      downstream_offsets__,
+      downstream_stream_indices__,
+      downstream_step_indices__,
+      num_barriers,
+      view_values__);
+}
+
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef InferenceSessionBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_ORT_VERSION = 4,
     VT_MODEL = 6,
-    VT_KERNEL_TYPE_STR_RESOLVER = 10
+    VT_KERNEL_TYPE_STR_RESOLVER = 10,
+    VT_EXECUTION_PLAN = 12
   };
   const flatbuffers::String *ort_version() const {
     return GetPointer<const flatbuffers::String *>(VT_ORT_VERSION);
@@ -2995,6 +3411,9 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const onnxruntime::fbs::KernelTypeStrResolver *kernel_type_str_resolver() const {
     return GetPointer<const onnxruntime::fbs::KernelTypeStrResolver *>(VT_KERNEL_TYPE_STR_RESOLVER);
   }
+  const onnxruntime::fbs::ExecutionPlan *execution_plan() const {
+    return GetPointer<const onnxruntime::fbs::ExecutionPlan *>(VT_EXECUTION_PLAN);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ORT_VERSION) &&
@@ -3003,6 +3422,8 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyTable(model()) &&
            VerifyOffset(verifier, VT_KERNEL_TYPE_STR_RESOLVER) &&
            verifier.VerifyTable(kernel_type_str_resolver()) &&
+           VerifyOffset(verifier, VT_EXECUTION_PLAN) &&
+           verifier.VerifyTable(execution_plan()) &&
            verifier.EndTable();
   }
 };
@@ -3020,6 +3441,9 @@ struct InferenceSessionBuilder {
   void add_kernel_type_str_resolver(flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver) {
     fbb_.AddOffset(InferenceSession::VT_KERNEL_TYPE_STR_RESOLVER, kernel_type_str_resolver);
   }
+  void add_execution_plan(flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan) {
+    fbb_.AddOffset(InferenceSession::VT_EXECUTION_PLAN, execution_plan);
+  }
   explicit InferenceSessionBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -3036,8 +3460,10 @@ inline flatbuffers::Offset<InferenceSession> CreateInferenceSession(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<flatbuffers::String> ort_version = 0,
     flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan = 0) {
   InferenceSessionBuilder builder_(_fbb);
+  builder_.add_execution_plan(execution_plan);
   builder_.add_kernel_type_str_resolver(kernel_type_str_resolver);
   builder_.add_model(model);
   builder_.add_ort_version(ort_version);
@@ -3048,13 +3474,15 @@ inline flatbuffers::Offset<InferenceSession> CreateInferenceSessionDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     const char *ort_version = nullptr,
     flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    flatbuffers::Offset<onnxruntime::fbs::ExecutionPlan> execution_plan = 0) {
   auto ort_version__ = ort_version ? _fbb.CreateString(ort_version) : 0;
   return onnxruntime::fbs::CreateInferenceSession(
       _fbb,
       ort_version__,
       model,
-      kernel_type_str_resolver);
+      kernel_type_str_resolver,
+      execution_plan);
 }
 
 inline bool VerifyTypeInfoValue(flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type) {
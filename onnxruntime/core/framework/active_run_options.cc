@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/active_run_options.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace onnxruntime {
+
+namespace {
+struct ActiveRuns {
+  std::mutex mutex;
+  // terminate flag => RunOptions containing it and the number of scopes registering it
+  std::unordered_map<const bool*, std::pair<const RunOptions*, int>> run_options;
+};
+
+ActiveRuns& GetActiveRuns() {
+  static ActiveRuns active_runs;
+  return active_runs;
+}
+}  // namespace
+
+ActiveRunOptions::Scope::Scope(const RunOptions& run_options) : run_options_(nullptr) {
+  // Only the run configuration is looked up, so runs without one are not registered.
+  if (run_options.config_options.configurations.empty()) {
+    return;
+  }
+
+  run_options_ = &run_options;
+  auto& active_runs = GetActiveRuns();
+  std::lock_guard<std::mutex> lock(active_runs.mutex);
+  auto& entry = active_runs.run_options[&run_options.terminate];
+  entry.first = &run_options;
+  ++entry.second;
+}
+
+ActiveRunOptions::Scope::~Scope() {
+  if (run_options_ == nullptr) {
+    return;
+  }
+
+  auto& active_runs = GetActiveRuns();
+  std::lock_guard<std::mutex> lock(active_runs.mutex);
+  auto it = active_runs.run_options.find(&run_options_->terminate);
+  if (it != active_runs.run_options.end() && --it->second.second == 0) {
+    active_runs.run_options.erase(it);
+  }
+}
+
+const RunOptions* ActiveRunOptions::Find(const bool& terminate_flag) {
+  auto& active_runs = GetActiveRuns();
+  std::lock_guard<std::mutex> lock(active_runs.mutex);
+  auto it = active_runs.run_options.find(&terminate_flag);
+  return it != active_runs.run_options.end() ? it->second.first : nullptr;
+}
+
+}  // namespace onnxruntime
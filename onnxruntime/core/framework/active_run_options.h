@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+// Finds the RunOptions of a Run call in progress from its terminate flag. The flag is the only part of the
+// RunOptions passed down to the kernels, including the kernels of subgraphs, so kernels that need run level
+// configuration (see OpKernelContextInternal::GetRunOptions) look it up here.
+class ActiveRunOptions {
+ public:
+  // Registers run_options for the lifetime of the scope. Run calls sharing a RunOptions instance may nest scopes.
+  class Scope {
+   public:
+    explicit Scope(const RunOptions& run_options);
+    ~Scope();
+
+   private:
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Scope);
+
+    const RunOptions* run_options_;
+  };
+
+  // Returns the RunOptions whose terminate flag is terminate_flag, or nullptr when no Run call with it is in progress.
+  static const RunOptions* Find(const bool& terminate_flag);
+};
+
+}  // namespace onnxruntime
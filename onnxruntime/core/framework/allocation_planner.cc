@@ -5,9 +5,11 @@
 #include <list>
 #include <algorithm>
 #include <deque>
+#include <queue>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <limits>
 #include "core/common/exceptions.h"
 #include "core/common/inlined_containers.h"
 #include "core/common/safeint.h"
@@ -98,6 +100,7 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
       auto& elt_plan = plan.allocation_plan[index];
       out << elt_plan.alloc_kind;
       if (elt_plan.alloc_kind == AllocKind::kReuse) out << " " << elt_plan.reused_buffer;
+      if (elt_plan.is_view) out << " (view)";
       auto& loc = elt_plan.location;
       out << ", " << loc.ToString();
     } else {
@@ -157,6 +160,10 @@ class PlannerImpl {
       const PathString& partition_config_file,
       const logging::Logger& logger);
 
+  // Compute the peak size of the tensors allocated by the plan when the nodes run in topological order.
+  // Returns false if the size of an allocated value is not statically known.
+  bool ComputePlannedPeakMemory(size_t& peak);
+
  private:
   gsl::not_null<const ISequentialPlannerContext*> context_;
   SequentialExecutionPlan& plan_;
@@ -297,8 +304,9 @@ class PlannerImpl {
 
   // Find if there exists some input tensor that we can use in-place for output_arg_num-th input in the node.
   bool FindReusableInput(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* reusable_input,
-                         bool* is_strided_tensor) {
+                         bool* is_strided_tensor, bool* is_view) {
     *is_strided_tensor = false;
+    *is_view = false;
 #ifdef ENABLE_TRAINING
     // Inputs of Yields are essentially the outputs for FW partial subgraph
     // These tensors will be passed back to pytorch, thus cannot share the buffer with other tensors
@@ -320,6 +328,11 @@ class PlannerImpl {
       return false;
     }
 
+    // an output reusing a buffer is put at the start of the buffer, while a view is somewhere inside it, so
+    // a view can only be reused as another view. the kernels of aliasing outputs copy the data if the output
+    // isn't an alias.
+    auto is_view_input = [this](const NodeArg& arg) { return AllocPlan(Index(arg.Name())).is_view; };
+
     const auto& alias_map = ci.kernel_def->Alias();
     auto input_args = node.InputDefs();
     for (auto& pair : alias_map) {
@@ -327,7 +340,7 @@ class PlannerImpl {
         // we _must_ reuse this input to satisfy aliasing requirement: (e.g., for reshape)
         if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
           auto p_input_arg = input_args[pair.first];
-          if (p_input_arg->Exists()) {
+          if (p_input_arg->Exists() && !is_view_input(*p_input_arg)) {
             *reusable_input = Index(p_input_arg->Name());
             return true;
           }
@@ -343,19 +356,40 @@ class PlannerImpl {
       int alias_input_index = output_arg_num - output_offset + input_offset;
       if (alias_input_index >= 0 && static_cast<size_t>(alias_input_index) < input_args.size()) {
         auto p_input_arg = input_args[alias_input_index];
-        if (p_input_arg->Exists()) {
+        if (p_input_arg->Exists() && !is_view_input(*p_input_arg)) {
           *reusable_input = Index(p_input_arg->Name());
           return true;
         }
       }
     }
 
+    // the output may be a view of the input. it shares the buffer of the input, which keeps the buffer alive
+    // for the consumers of the output. the data of the input isn't changed, so the input may have other consumers.
+    const auto& view_map = ci.kernel_def->MayViewOutput();
+    const auto& variadic_view_input = ci.kernel_def->VariadicMayViewOutput();
+    auto view_it = std::find_if(view_map.begin(), view_map.end(),
+                                [output_arg_num](const std::pair<int, int>& pair) {
+                                  return pair.second == output_arg_num;
+                                });
+    if (view_it != view_map.end() || variadic_view_input.has_value()) {
+      const int view_input_index = view_it != view_map.end() ? view_it->first : *variadic_view_input;
+      if ((0 <= view_input_index) && (static_cast<size_t>(view_input_index) < input_args.size())) {
+        auto p_input_arg = input_args[view_input_index];
+        if (p_input_arg->Exists() && !IsNonTensor(*p_input_arg) &&
+            AllocPlan(Index(p_input_arg->Name())).location == AllocPlan(Index(p_output_arg->Name())).location) {
+          *reusable_input = Index(p_input_arg->Name());
+          *is_view = true;
+          return true;
+        }
+      }
+    }
+
     const auto& inplace_map = ci.kernel_def->MayInplace();
     for (auto& pair : inplace_map) {
       if (pair.second == output_arg_num) {
         if ((0 <= pair.first) && (static_cast<size_t>(pair.first) < input_args.size())) {
           auto p_input_arg = input_args[pair.first];
-          if (p_input_arg->Exists()) {
+          if (p_input_arg->Exists() && !is_view_input(*p_input_arg)) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
             if (1 == UseCount(original)) {
@@ -377,7 +411,7 @@ class PlannerImpl {
     const auto& may_strided_outputs_map = ci.kernel_def->MayStridedOutput();
     for (auto& pair : may_strided_outputs_map) {
       if (pair.second == output_arg_num && pair.first >= 0 && static_cast<size_t>(pair.first) < input_args.size() &&
-          input_args[pair.first]->Exists()) {
+          input_args[pair.first]->Exists() && !is_view_input(*input_args[pair.first])) {
         bool can_strided = true;
         for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
           const KernelCreateInfo& output_node_ci = GetKernelCreateInfo(kernel_create_info_map_, it->Index());
@@ -471,6 +505,41 @@ class PlannerImpl {
     */
   }
 
+  // Get the size in bytes of a tensor of arg with the given shape. Returns false if a dimension is not known.
+  static bool GetStaticSizeInBytes(const TensorShapeProto& shape, const onnxruntime::NodeArg& arg, size_t& size) {
+    SafeInt<size_t> num_elements = 1;
+    for (const auto& dim : shape.dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) return false;
+      num_elements *= static_cast<size_t>(dim.dim_value());
+    }
+
+    size = num_elements * GetElementSize(arg.Type());
+    return true;
+  }
+
+  // Check if the buffer of available_arg can hold the tensor of required_arg, even if the sizes differ.
+  // If both sizes are statically known, available_size is set to the size of the available buffer in bytes.
+  // Otherwise the shapes must be the same and available_size is set to 0.
+  static bool IsLargeEnough(const TensorShapeProto& available_shape, const onnxruntime::NodeArg& available_arg,
+                            const TensorShapeProto& required_shape, const onnxruntime::NodeArg& required_arg,
+                            size_t& available_size) {
+    // see SameSize for why string tensors are never reused
+    if (available_arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        required_arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return false;
+    }
+
+    size_t required_size = 0;
+    if (GetStaticSizeInBytes(available_shape, available_arg, available_size) &&
+        GetStaticSizeInBytes(required_shape, required_arg, required_size)) {
+      return required_size > 0 && available_size >= required_size;
+    }
+
+    available_size = 0;
+    return GetElementSize(available_arg.Type()) >= GetElementSize(required_arg.Type()) &&
+           SameShape(available_shape, required_shape);
+  }
+
   bool SameSize(const onnxruntime::NodeArg& arg1, const onnxruntime::NodeArg& arg2) {
     if ((!arg1.Exists()) || (!arg2.Exists())) return false;
     auto p_shape1 = context_->GetShape(arg1);
@@ -480,7 +549,8 @@ class PlannerImpl {
     return SameSize(*p_shape1, arg1, *p_shape2, arg2);
   }
 
-  // Find if freelist contains a buffer of the same size as output_arg
+  // Find if freelist contains a buffer of the same size as output_arg.
+  // If larger buffer reuse is enabled and there is none, the smallest buffer that can hold output_arg is used.
   bool FindReusableTensor(const onnxruntime::NodeArg& output_arg, OrtValueIndex* reusable_tensor) {
     if (!context_->GetEnableMemoryReuse()) {
       return false;
@@ -489,6 +559,13 @@ class PlannerImpl {
     if (nullptr == p_required_buffer_shape || p_required_buffer_shape->dim_size() == 0) return false;
     auto& required_memory_info = AllocPlan(output_arg.Name()).location;
 
+    const bool enable_larger_buffer_reuse = context_->GetEnableLargerBufferReuse();
+    // a buffer with a statically known size is preferred over one with the same symbolic shape,
+    // as only the former can be compared to find the best fit.
+    auto best_fit = freelist_.end();
+    size_t best_fit_size = 0;
+    auto same_shape_fit = freelist_.end();
+
     for (auto it = freelist_.begin(); it != freelist_.end(); ++it) {
       size_t reusable = static_cast<size_t>(it->ml_value);
       const onnxruntime::NodeArg* p_node_arg = ort_value_info_.at(reusable).p_def_site;
@@ -516,8 +593,28 @@ class PlannerImpl {
           freelist_.erase(it);
           return true;
         }
+
+        size_t available_size = 0;
+        if (enable_larger_buffer_reuse &&
+            IsLargeEnough(*p_available_buffer_shape, *p_node_arg, *p_required_buffer_shape, output_arg,
+                          available_size)) {
+          if (available_size == 0) {
+            if (same_shape_fit == freelist_.end()) same_shape_fit = it;
+          } else if (best_fit == freelist_.end() || available_size < best_fit_size) {
+            best_fit = it;
+            best_fit_size = available_size;
+          }
+        }
       }
     }
+
+    auto fit = best_fit != freelist_.end() ? best_fit : same_shape_fit;
+    if (fit != freelist_.end()) {
+      *reusable_tensor = fit->ml_value;
+      freelist_.erase(fit);
+      return true;
+    }
+
     return false;
   }
 
@@ -1367,6 +1464,7 @@ class PlannerImpl {
         // The the OrtValue indexed by current may reuse the memory in the OrtValue indexed by reused.
         OrtValueIndex reused;
         bool is_strided_tensor = false;
+        bool is_view = false;
         if (has_external_outputs) {
           ORT_ENFORCE(!IsNonTensor(*node_output), "Only tensors are supported for external outputs for now.");
           AllocPlan(current).alloc_kind = AllocKind::kAllocatedExternally;
@@ -1407,12 +1505,14 @@ class PlannerImpl {
             }
           }
         } else if (!context_->IsParallelExecutionEnabled() &&
-                   FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused, &is_strided_tensor)) {
+                   FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused, &is_strided_tensor,
+                                     &is_view)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
           // and optional types if the kernel has marked certain inputs as
           // possible candidates for re-use
           Reuse(reused, current, AllocKind::kReuse);
           ort_value_info_[current].is_inplace_reuse = true;
+          AllocPlan(current).is_view = is_view;
 #ifdef ENABLE_STRIDED_TENSORS
           if (is_strided_tensor) AllocPlan(current).is_strided_tensor = true;
 #else
@@ -1756,7 +1856,8 @@ class PlannerImpl {
   void
   PartitionIntoStreams(const logging::Logger& logger, const ExecutionProviders& execution_providers,
                        const PathString& partition_config_file) {
-    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file);
+    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file,
+                                                                 context_->GetMaxCpuStreams());
     auto status = partitioner->PartitionGraph(graph_viewer_, execution_providers, stream_nodes_, context_->GetExecutionOrder());
     ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
     node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
@@ -1819,7 +1920,8 @@ class PlannerImpl {
     size_t num_trigger_points = 0;
     InlinedHashMap<NodeIndex, size_t> node_to_trigger_points;
     InlinedHashMap<NodeIndex, NotificationIndex> node_to_notification;
-    std::map<NodeIndex, std::map<NodeIndex, WaitNotificationFn>> node_to_wait;
+    // key: consumer node. value: producer node -> {wait handle, device type of the waiting side}
+    std::map<NodeIndex, std::map<NodeIndex, std::pair<WaitNotificationFn, OrtDevice::DeviceType>>> node_to_wait;
     for (size_t i = 0; i < num_logic_streams_; ++i) {
       for (auto node_index : stream_nodes_[i]) {
         auto* node = graph_viewer_.GetNode(node_index);
@@ -1866,7 +1968,7 @@ class PlannerImpl {
                       plan_.notification_owners.push_back(i);
                     }
                     // if node_index is already in the map, it will NOT be overwritten by insert()
-                    node_to_wait[it->Index()].insert({node_index, wait_handle});
+                    node_to_wait[it->Index()].insert({node_index, {wait_handle, output_arg_device}});
                   }
                 }
               }  // output->Exists
@@ -1881,7 +1983,7 @@ class PlannerImpl {
                     node_to_notification[node_index] = plan_.notification_owners.size();
                     plan_.notification_owners.push_back(i);
                   }
-                  node_to_wait[it->Index()].insert({node_index, wait_handle});
+                  node_to_wait[it->Index()].insert({node_index, {wait_handle, downstream_device}});
                 }
               }
             }
@@ -1938,8 +2040,9 @@ class PlannerImpl {
         auto wait_it = node_to_wait.find(node_index);
         if (wait_it != node_to_wait.end()) {
           for (auto wait_param : wait_it->second) {
-            execution_plan[i]->steps_.emplace_back(std::make_unique<WaitOnEPStep>(wait_param.second,
-                                                                                  node_to_notification[wait_param.first], node_index));
+            execution_plan[i]->steps_.emplace_back(std::make_unique<WaitOnEPStep>(wait_param.second.first,
+                                                                                  node_to_notification[wait_param.first], node_index,
+                                                                                  wait_param.second.second));
           }
         }
 
@@ -2166,6 +2269,78 @@ Status PlannerImpl::CreatePlan(
   return Status::OK();
 }
 
+bool PlannerImpl::ComputePlannedPeakMemory(size_t& peak) {
+  peak = 0;
+  size_t live_size = 0;
+  // size of the allocated values that are not released yet
+  InlinedHashMap<OrtValueIndex, size_t> live_values;
+  // remaining releases of values consumed by multiple streams
+  InlinedHashMap<size_t, size_t> pending_releases;
+
+  for (NodeIndex node_index : graph_viewer_.GetNodesInTopologicalOrder(context_->GetExecutionOrder())) {
+    const Node* node = graph_viewer_.GetNode(node_index);
+    for (const auto* output : node->OutputDefs()) {
+      if (!output->Exists()) continue;
+      const OrtValueIndex index = Index(output->Name());
+      const auto alloc_kind = AllocPlan(index).alloc_kind;
+      if (alloc_kind != AllocKind::kAllocate && alloc_kind != AllocKind::kAllocateOutput) continue;
+
+      const auto* shape = context_->GetShape(*output);
+      size_t size = 0;
+      if (IsNonTensor(*output) || shape == nullptr || !GetStaticSizeInBytes(*shape, *output, size)) {
+        return false;
+      }
+
+      live_values[index] = size;
+      live_size += size;
+    }
+
+    peak = std::max(peak, live_size);
+
+    for (size_t action_index : plan_.node_release_list[node_index]) {
+      const auto& action = plan_.release_actions[action_index];
+      if (action.ref_count > 1) {
+        auto pending = pending_releases.insert({action_index, action.ref_count}).first;
+        if (--pending->second > 0) continue;
+      }
+
+      auto it = live_values.find(static_cast<OrtValueIndex>(action.value_index));
+      if (it != live_values.end()) {
+        live_size -= it->second;
+        live_values.erase(it);
+      }
+    }
+  }
+
+  return true;
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+namespace {
+// Plans with the given execution order and otherwise the configuration of another context.
+class ExecutionOrderOverrideContext : public ISequentialPlannerContext {
+ public:
+  ExecutionOrderOverrideContext(const ISequentialPlannerContext& context, ExecutionOrder execution_order)
+      : context_(context), execution_order_(execution_order) {}
+
+  const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
+    return context_.GetShape(arg);
+  }
+
+  bool IsParallelExecutionEnabled() const override { return context_.IsParallelExecutionEnabled(); }
+  ExecutionOrder GetExecutionOrder() const override { return execution_order_; }
+  bool GetEnableMemoryReuse() const override { return context_.GetEnableMemoryReuse(); }
+  size_t GetMaxCpuStreams() const override { return context_.GetMaxCpuStreams(); }
+  bool GetEnableLargerBufferReuse() const override { return context_.GetEnableLargerBufferReuse(); }
+  size_t GetMemoryBudget() const override { return context_.GetMemoryBudget(); }
+
+ private:
+  const ISequentialPlannerContext& context_;
+  ExecutionOrder execution_order_;
+};
+}  // namespace
+#endif
+
 Status SequentialPlanner::CreatePlan(
     const Node* parent_node,
     const onnxruntime::GraphViewer& graph_viewer,
@@ -2190,12 +2365,70 @@ Status SequentialPlanner::CreatePlan(
                       outer_scope_node_arg_to_location_map,
                       ort_value_name_idx_map, context, *plan);
 
-  return planner.CreatePlan(
+  ORT_RETURN_IF_ERROR(planner.CreatePlan(
 #ifdef ORT_ENABLE_STREAM
       stream_handle_registry,
 #endif
       partition_config_file,
-      logger);
+      logger));
+
+  // the planned peak is reported for the memory efficient order, which is chosen to lower it
+  const size_t memory_budget = context.GetMemoryBudget();
+  const bool report_peak = context.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT;
+  if ((memory_budget == 0 && !report_peak) || parent_node != nullptr) {
+    return Status::OK();
+  }
+
+  size_t peak = 0;
+  if (!planner.ComputePlannedPeakMemory(peak)) {
+    LOGS(logger, INFO) << "The planned peak memory can't be computed as the sizes of some tensors are not "
+                       << "statically known.";
+    return Status::OK();
+  }
+
+  if (report_peak) {
+    LOGS(logger, INFO) << "The planned peak memory with the memory efficient execution order is " << peak
+                       << " bytes.";
+  }
+
+  if (memory_budget == 0) {
+    return Status::OK();
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // the order only determines the execution order if all the nodes are on one stream per device
+  if (peak > memory_budget && context.GetExecutionOrder() == ExecutionOrder::DEFAULT &&
+      !context.IsParallelExecutionEnabled() && context.GetMaxCpuStreams() <= 1 && partition_config_file.empty()) {
+    ExecutionOrderOverrideContext memory_efficient_context(context, ExecutionOrder::MEMORY_EFFICIENT);
+    std::optional<SequentialExecutionPlan> memory_efficient_plan;
+    memory_efficient_plan.emplace();
+    PlannerImpl memory_efficient_planner(parent_node, graph_viewer, outer_scope_node_args, providers,
+                                         kernel_create_info_map, subgraphs_kernel_create_info_maps,
+                                         outer_scope_node_arg_to_location_map,
+                                         ort_value_name_idx_map, memory_efficient_context, *memory_efficient_plan);
+    ORT_RETURN_IF_ERROR(memory_efficient_planner.CreatePlan(
+#ifdef ORT_ENABLE_STREAM
+        stream_handle_registry,
+#endif
+        partition_config_file,
+        logger));
+
+    size_t memory_efficient_peak = 0;
+    if (memory_efficient_planner.ComputePlannedPeakMemory(memory_efficient_peak) && memory_efficient_peak < peak) {
+      LOGS(logger, INFO) << "Reordered the nodes to reduce the planned peak memory from " << peak << " to "
+                         << memory_efficient_peak << " bytes.";
+      plan = std::move(memory_efficient_plan);
+      peak = memory_efficient_peak;
+    }
+  }
+#endif
+
+  if (peak > memory_budget) {
+    LOGS(logger, WARNING) << "The planned peak memory of " << peak << " bytes exceeds the memory budget of "
+                          << memory_budget << " bytes.";
+  }
+
+  return Status::OK();
 }
 
 #ifdef ORT_ENABLE_STREAM
@@ -2375,11 +2608,212 @@ void DeviceBasedPartitioner::SaveConfig() const {
   }
 }
 
+/*
+CriticalPathPartitioner partitions the CPU EP nodes into up to max_cpu_streams streams, so that independent branches
+of the graph (e.g. the towers of a recommendation model) run concurrently on the inter-op thread pool.
+Nodes of other devices are partitioned by device, same as DeviceBasedPartitioner.
+
+The cost of each node is estimated from the static shapes of its outputs, and the nodes are list scheduled in the
+order of their bottom level (the cost of the longest path from the node to a graph output), so the critical path
+is placed first. Each CPU node goes to the stream where it can start earliest, with a penalty for waiting on a
+producer on another stream. A new stream is only opened when that lets a node start earlier, so graphs without
+independent branches keep all CPU nodes on one stream.
+*/
+class CriticalPathPartitioner : public IGraphPartitioner {
+ public:
+  CriticalPathPartitioner(const logging::Logger& logger,
+                          size_t max_cpu_streams) : IGraphPartitioner(logger, PathString{}),
+                                                    max_cpu_streams_(max_cpu_streams) {}
+
+  Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                        const ExecutionProviders& execution_providers,
+                        std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                        ExecutionOrder execution_order) override;
+
+  const char* Type() const override { return "CriticalPathPartitioner"; }
+  size_t Streams() const override { return num_streams_; }
+
+ private:
+  // cost of running a node regardless of its size, in the units of EstimateNodeCost
+  static constexpr double kNodeCost = 256.0;
+  // cost of handing a value over to a node on another stream
+  static constexpr double kCrossStreamCost = 4096.0;
+
+  static double EstimateNodeCost(const Node& node);
+
+  size_t max_cpu_streams_;
+  size_t num_streams_ = 0;
+};
+
+double CriticalPathPartitioner::EstimateNodeCost(const Node& node) {
+  // ops doing a reduction for each output element
+  static const InlinedHashSet<std::string_view> compute_bound_ops = {
+      "Conv", "ConvTranspose", "ConvInteger", "QLinearConv", "FusedConv", "NhwcFusedConv",
+      "MatMul", "MatMulInteger", "QLinearMatMul", "MatMulIntegerToFloat", "FusedMatMul", "DynamicQuantizeMatMul",
+      "Gemm", "FusedGemm", "Attention", "MultiHeadAttention", "Einsum", "LSTM", "GRU", "RNN"};
+  constexpr double kComputeBoundFactor = 32.0;
+
+  double cost = 0.0;
+  for (const auto* output : node.OutputDefs()) {
+    const auto* shape = output->Exists() ? output->Shape() : nullptr;
+    if (shape == nullptr) {
+      continue;
+    }
+
+    // symbolic dimensions scale all the nodes alike, so they are counted as 1
+    double num_elements = 1.0;
+    for (const auto& dim : shape->dim()) {
+      if (utils::HasDimValue(dim) && dim.dim_value() > 0) {
+        num_elements *= static_cast<double>(dim.dim_value());
+      }
+    }
+    cost += num_elements;
+  }
+
+  if (compute_bound_ops.count(node.OpType()) > 0) {
+    cost *= kComputeBoundFactor;
+  }
+
+  return kNodeCost + cost;
+}
+
+Status CriticalPathPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
+                                               const ExecutionProviders& execution_providers,
+                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
+                                               ExecutionOrder execution_order) {
+  const auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
+  const size_t num_nodes = p_graph_nodes.size();
+
+  InlinedHashMap<NodeIndex, size_t> node_position;
+  node_position.reserve(num_nodes);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    node_position[p_graph_nodes[i]] = i;
+  }
+
+  // producers and consumers of each node by position, ignoring nodes outside of the graph viewer
+  std::vector<InlinedVector<size_t>> producers(num_nodes);
+  std::vector<InlinedVector<size_t>> consumers(num_nodes);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    const auto* node = graph_viewer.GetNode(p_graph_nodes[i]);
+    for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+      auto position_it = node_position.find(it->Index());
+      if (position_it != node_position.end() &&
+          std::find(producers[i].begin(), producers[i].end(), position_it->second) == producers[i].end()) {
+        producers[i].push_back(position_it->second);
+        consumers[position_it->second].push_back(i);
+      }
+    }
+  }
+
+  std::vector<double> costs(num_nodes);
+  std::vector<double> bottom_levels(num_nodes);
+  std::vector<OrtDevice::DeviceType> device_types(num_nodes);
+  for (size_t i = num_nodes; i-- > 0;) {
+    const auto* node = graph_viewer.GetNode(p_graph_nodes[i]);
+    const auto* ep = execution_providers.Get(*node);
+    ORT_RETURN_IF(ep == nullptr, "Failed to find the execution provider of node ", node->Name());
+    device_types[i] = ep->GetOrtDeviceByMemType(OrtMemType::OrtMemTypeDefault).Type();
+    costs[i] = EstimateNodeCost(*node);
+
+    double longest_consumer_path = 0.0;
+    for (size_t consumer : consumers[i]) {
+      longest_consumer_path = std::max(longest_consumer_path, bottom_levels[consumer]);
+    }
+    bottom_levels[i] = costs[i] + longest_consumer_path;
+  }
+
+  // list scheduling. the nodes are appended to the streams in a topological order, so the streams never wait on
+  // each other in a cycle.
+  auto lower_priority = [&bottom_levels](size_t a, size_t b) {
+    return bottom_levels[a] != bottom_levels[b] ? bottom_levels[a] < bottom_levels[b] : a > b;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(lower_priority)> ready_nodes(lower_priority);
+  std::vector<size_t> num_pending_producers(num_nodes);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    num_pending_producers[i] = producers[i].size();
+    if (num_pending_producers[i] == 0) {
+      ready_nodes.push(i);
+    }
+  }
+
+  stream_nodes.clear();
+  std::vector<double> stream_finish_times;
+  InlinedVector<size_t> cpu_streams;
+  InlinedHashMap<OrtDevice::DeviceType, size_t> device_to_stream;
+  std::vector<size_t> node_streams(num_nodes);
+  std::vector<double> finish_times(num_nodes);
+
+  auto start_time_on = [&](size_t node, size_t stream) {
+    double start = stream < stream_finish_times.size() ? stream_finish_times[stream] : 0.0;
+    for (size_t producer : producers[node]) {
+      start = std::max(start,
+                       finish_times[producer] + (node_streams[producer] == stream ? 0.0 : kCrossStreamCost));
+    }
+    return start;
+  };
+
+  while (!ready_nodes.empty()) {
+    const size_t i = ready_nodes.top();
+    ready_nodes.pop();
+
+    size_t stream;
+    if (device_types[i] == OrtDevice::CPU && max_cpu_streams_ > 1) {
+      stream = stream_nodes.size();
+      double best_start = std::numeric_limits<double>::max();
+      for (size_t cpu_stream : cpu_streams) {
+        const double start = start_time_on(i, cpu_stream);
+        if (start < best_start) {
+          stream = cpu_stream;
+          best_start = start;
+        }
+      }
+
+      // a new stream is only opened if the node can start earlier there
+      if (cpu_streams.size() < max_cpu_streams_ && start_time_on(i, stream_nodes.size()) < best_start) {
+        stream = stream_nodes.size();
+      }
+    } else {
+      auto it = device_to_stream.find(device_types[i]);
+      stream = it != device_to_stream.end() ? it->second : stream_nodes.size();
+    }
+
+    if (stream == stream_nodes.size()) {
+      stream_nodes.emplace_back();
+      stream_finish_times.push_back(0.0);
+      if (device_types[i] == OrtDevice::CPU && max_cpu_streams_ > 1) {
+        cpu_streams.push_back(stream);
+      } else {
+        device_to_stream[device_types[i]] = stream;
+      }
+    }
+
+    finish_times[i] = start_time_on(i, stream) + costs[i];
+    node_streams[i] = stream;
+    stream_finish_times[stream] = finish_times[i];
+    stream_nodes[stream].push_back(p_graph_nodes[i]);
+
+    for (size_t consumer : consumers[i]) {
+      if (--num_pending_producers[consumer] == 0) {
+        ready_nodes.push(consumer);
+      }
+    }
+  }
+
+  num_streams_ = stream_nodes.size();
+  LOGS(logger_, INFO) << "Partitioned " << num_nodes << " nodes into " << num_streams_ << " streams, "
+                      << cpu_streams.size() << " of them for CPU nodes.";
+  return Status::OK();
+}
+
 std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
-                                                                             const PathString& config_file) {
+                                                                             const PathString& config_file,
+                                                                             size_t max_cpu_streams) {
   // use device based partitioner by default
   IGraphPartitioner::GraphPartitioningStrategy partitioner_type =
       IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
+  if (config_file.empty() && max_cpu_streams > 1) {
+    partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition;
+  }
   if (!config_file.empty()) {
     std::ifstream f(config_file);
     if (f.is_open()) {
@@ -2400,6 +2834,9 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
     LOGS(logger, INFO) << "Use DeviceBasedPartition as default";
     return std::make_unique<DeviceBasedPartitioner>(logger, config_file);
+  } else if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::CriticalPathPartition) {
+    LOGS(logger, INFO) << "Use CriticalPathPartition with up to " << max_cpu_streams << " CPU streams";
+    return std::make_unique<CriticalPathPartitioner>(logger, max_cpu_streams);
   }  // else if other partitioner types ...
   ORT_THROW("Failed to create partitioner");
 }
@@ -46,15 +46,34 @@ class ISequentialPlannerContext {
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
+
+  // Maximum number of streams the CPU nodes may be partitioned into based on their estimated cost.
+  // 0 or 1 keeps all the CPU nodes on one stream.
+  virtual size_t GetMaxCpuStreams() const { return 0; }
+
+  // If it returns true, a freed buffer that is larger than the output, or holds elements of a different size, may be
+  // reused for the output when no freed buffer has exactly the required size.
+  // see PlannerImpl::FindReusableTensor
+  virtual bool GetEnableLargerBufferReuse() const { return false; }
+
+  // The size in bytes the planned peak memory of the main graph should stay under. 0 if there is no budget.
+  // If the budget is exceeded, the planner tries a memory efficient execution order and reports if that is not enough.
+  // see SequentialPlanner::CreatePlan
+  virtual size_t GetMemoryBudget() const { return 0; }
   virtual ~ISequentialPlannerContext() = default;
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           size_t max_cpu_streams = 0, bool enable_larger_buffer_reuse = false,
+                           size_t memory_budget = 0)
       : execution_mode_(execution_mode),
         exection_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        max_cpu_streams_(max_cpu_streams),
+        enable_larger_buffer_reuse_(enable_larger_buffer_reuse),
+        memory_budget_(memory_budget) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -67,10 +86,19 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
 
+  size_t GetMaxCpuStreams() const override { return max_cpu_streams_; }
+
+  bool GetEnableLargerBufferReuse() const override { return enable_larger_buffer_reuse_; }
+
+  size_t GetMemoryBudget() const override { return memory_budget_; }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder exection_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  size_t max_cpu_streams_ = 0;
+  bool enable_larger_buffer_reuse_ = false;
+  size_t memory_budget_ = 0;
 };
 
 #ifdef ORT_ENABLE_STREAM
@@ -82,16 +110,20 @@ class IGraphPartitioner {
   // DeviceBasedPartitioner is the default, who partitions a graph based off device information.
   // i.e., given a graph which has CPU EP nodes, Cuda EP nodes and TRT EP nodes,
   // it will be partitioned as two sequences, one is for CPU EP nodes, another is for TRT and Cuda nodes.
-  // We will add more optimized partitioner later.
+  // CriticalPathPartitioner splits the CPU EP nodes further into up to max_cpu_streams streams, so that independent
+  // branches run concurrently on the inter-op thread pool. Nodes of other devices are partitioned by device.
   enum GraphPartitioningStrategy {
     DeviceBasedPartition = 0,
+    CriticalPathPartition,
     Unknown,
   };
   virtual ~IGraphPartitioner() = default;
   // create the partition based on the partition type.
   // perform partition based on the user input when provided.
+  // if there is no user input and max_cpu_streams > 1, the CPU nodes are partitioned based on the critical path.
   static std::unique_ptr<IGraphPartitioner> CreateGraphPartitioner(const logging::Logger& logger,
-                                                                   const PathString& config_file);
+                                                                   const PathString& config_file,
+                                                                   size_t max_cpu_streams = 0);
   virtual Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                 const ExecutionProviders& execution_providers,
                                 std::vector<InlinedVector<NodeIndex>>& stream_nodes,
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/allocation_trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'R', 'T', 'A', 'L', 'L', 'O', 'C'};
+constexpr uint32_t kVersion = 1;
+// buffered bytes written to the file at once
+constexpr size_t kFlushBytes = 1 << 20;
+
+thread_local uint32_t current_node = AllocationTraceEvent::kNoNode;
+
+template <typename T>
+void Append(std::vector<uint8_t>& buffer, T value) {
+  static_assert(std::is_integral_v<T>);
+  using Unsigned = std::make_unsigned_t<T>;
+  auto bits = static_cast<Unsigned>(value);
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    buffer.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+  }
+}
+
+class Reader {
+ public:
+  explicit Reader(const std::vector<uint8_t>& data) : data_{data} {}
+
+  bool AtEnd() const { return offset_ == data_.size(); }
+
+  template <typename T>
+  bool Read(T& value) {
+    if (data_.size() - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::make_unsigned_t<T> bits = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      bits |= static_cast<std::make_unsigned_t<T>>(data_[offset_ + i]) << (8 * i);
+    }
+    offset_ += sizeof(T);
+    value = static_cast<T>(bits);
+    return true;
+  }
+
+  bool Read(std::string& value, size_t length) {
+    if (data_.size() - offset_ < length) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char*>(data_.data() + offset_), length);
+    offset_ += length;
+    return true;
+  }
+
+ private:
+  const std::vector<uint8_t>& data_;
+  size_t offset_{0};
+};
+
+}  // namespace
+
+Status AllocationTraceRecorder::Create(const std::string& path, std::unique_ptr<AllocationTraceRecorder>& recorder) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  ORT_RETURN_IF_NOT(file.good(), "Failed to create the allocation trace file ", path);
+  recorder.reset(new AllocationTraceRecorder(std::move(file)));
+  return Status::OK();
+}
+
+AllocationTraceRecorder::AllocationTraceRecorder(std::ofstream file) : file_{std::move(file)} {
+  buffer_.reserve(kFlushBytes + 64);
+  buffer_.insert(buffer_.end(), std::begin(kMagic), std::end(kMagic));
+  Append(buffer_, kVersion);
+}
+
+AllocationTraceRecorder::~AllocationTraceRecorder() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  FlushLocked();
+}
+
+void AllocationTraceRecorder::FlushLocked() {
+  file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+  file_.flush();
+  buffer_.clear();
+}
+
+uint16_t AllocationTraceRecorder::AddAllocator(const std::string& name, const OrtArenaCfg& config) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  const uint16_t id = next_allocator_id_++;
+  const auto name_length = static_cast<uint16_t>(std::min<size_t>(name.size(), std::numeric_limits<uint16_t>::max()));
+  Append(buffer_, static_cast<uint8_t>(AllocationTraceEvent::Type::kAllocator));
+  Append(buffer_, id);
+  Append(buffer_, name_length);
+  buffer_.insert(buffer_.end(), name.begin(), name.begin() + name_length);
+  Append(buffer_, static_cast<uint64_t>(config.max_mem));
+  Append(buffer_, static_cast<int32_t>(config.arena_extend_strategy));
+  Append(buffer_, static_cast<int32_t>(config.initial_chunk_size_bytes));
+  Append(buffer_, static_cast<int32_t>(config.max_dead_bytes_per_chunk));
+  Append(buffer_, static_cast<int32_t>(config.initial_growth_chunk_size_bytes));
+  Append(buffer_, static_cast<int64_t>(config.max_power_of_two_extend_bytes));
+  Append(buffer_, static_cast<uint64_t>(config.thread_cache_max_bytes));
+  return id;
+}
+
+void AllocationTraceRecorder::Record(AllocationTraceEvent::Type type, uint16_t allocator_id, const void* address,
+                                     size_t size, const Stream* stream) {
+  const auto timestamp_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time_).count());
+  const uint32_t node_index = current_node;
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  uint16_t stream_id = 0;
+  if (stream != nullptr) {
+    auto it = stream_ids_.find(stream);
+    if (it == stream_ids_.end()) {
+      it = stream_ids_.emplace(stream, static_cast<uint16_t>(stream_ids_.size() + 1)).first;
+    }
+    stream_id = it->second;
+  }
+
+  Append(buffer_, static_cast<uint8_t>(type));
+  Append(buffer_, allocator_id);
+  Append(buffer_, stream_id);
+  Append(buffer_, node_index);
+  Append(buffer_, timestamp_ns);
+  Append(buffer_, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(address)));
+  Append(buffer_, static_cast<uint64_t>(size));
+  if (buffer_.size() >= kFlushBytes) {
+    FlushLocked();
+  }
+}
+
+void AllocationTraceRecorder::SetCurrentNode(uint32_t node_index) {
+  current_node = node_index;
+}
+
+uint32_t AllocationTraceRecorder::GetCurrentNode() {
+  return current_node;
+}
+
+Status AllocationTrace::Load(const std::string& path, AllocationTrace& trace) {
+  std::ifstream file(path, std::ios::binary);
+  ORT_RETURN_IF_NOT(file.good(), "Failed to open the allocation trace file ", path);
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  ORT_RETURN_IF(data.size() < sizeof(kMagic) || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0,
+                path, " is not an allocation trace");
+  Reader reader(data);
+  std::string magic;
+  uint32_t version = 0;
+  ORT_RETURN_IF_NOT(reader.Read(magic, sizeof(kMagic)) && reader.Read(version) && version == kVersion,
+                    "Unsupported allocation trace version in ", path);
+
+  trace.allocators.clear();
+  trace.events.clear();
+  while (!reader.AtEnd()) {
+    uint8_t type = 0;
+    reader.Read(type);
+    if (type == static_cast<uint8_t>(AllocationTraceEvent::Type::kAllocator)) {
+      uint16_t id = 0;
+      uint16_t name_length = 0;
+      AllocationTrace::Allocator allocator;
+      uint64_t max_mem = 0;
+      int32_t extend_strategy = 0;
+      uint64_t thread_cache_max_bytes = 0;
+      ORT_RETURN_IF_NOT(reader.Read(id) && reader.Read(name_length) && reader.Read(allocator.name, name_length) &&
+                            reader.Read(max_mem) && reader.Read(extend_strategy) &&
+                            reader.Read(allocator.config.initial_chunk_size_bytes) &&
+                            reader.Read(allocator.config.max_dead_bytes_per_chunk) &&
+                            reader.Read(allocator.config.initial_growth_chunk_size_bytes) &&
+                            reader.Read(allocator.config.max_power_of_two_extend_bytes) &&
+                            reader.Read(thread_cache_max_bytes),
+                        "Truncated allocator record in ", path);
+      ORT_RETURN_IF_NOT(id == trace.allocators.size(), "Unexpected allocator id ", id, " in ", path);
+      allocator.config.max_mem = static_cast<size_t>(max_mem);
+      allocator.config.arena_extend_strategy = extend_strategy;
+      allocator.config.thread_cache_max_bytes = static_cast<size_t>(thread_cache_max_bytes);
+      trace.allocators.push_back(std::move(allocator));
+    } else if (type >= static_cast<uint8_t>(AllocationTraceEvent::Type::kAlloc) &&
+               type <= static_cast<uint8_t>(AllocationTraceEvent::Type::kFree)) {
+      AllocationTraceEvent event;
+      event.type = static_cast<AllocationTraceEvent::Type>(type);
+      if (!(reader.Read(event.allocator_id) && reader.Read(event.stream_id) && reader.Read(event.node_index) &&
+            reader.Read(event.timestamp_ns) && reader.Read(event.address) && reader.Read(event.size))) {
+        // the last record of a trace whose process did not exit cleanly may be cut short
+        break;
+      }
+      ORT_RETURN_IF_NOT(event.allocator_id < trace.allocators.size(), "Unknown allocator id ", event.allocator_id,
+                        " in ", path);
+      trace.events.push_back(event);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unknown record type ", static_cast<int>(type), " in ",
+                             path);
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
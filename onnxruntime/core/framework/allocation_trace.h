@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class Stream;
+
+// A trace of the allocations and frees of arenas, recorded while running real workloads so that they can be replayed
+// offline against other arena configurations.
+//
+// The file starts with the 8 bytes "ORTALLOC" and a uint32 version, followed by records starting with a uint8
+// type. All integers are little-endian.
+//   kAllocator: uint16 id, uint16 name length, name, the OrtArenaCfg of the arena as
+//               uint64 max_mem, int32 extend strategy, int32 initial chunk, int32 max dead bytes,
+//               int32 initial growth chunk, int64 max power of two extend, uint64 thread cache max bytes
+//   kAlloc, kReserve, kFree: uint16 allocator id, uint16 stream id, uint32 node index, uint64 nanoseconds since the
+//               start of the trace, uint64 address, uint64 size (0 for kFree)
+// Stream id 0 is no stream. The node index is the one of the node whose kernel was executing on the thread, or
+// kNoNode.
+struct AllocationTraceEvent {
+  enum class Type : uint8_t {
+    kAllocator = 1,
+    kAlloc = 2,
+    kReserve = 3,
+    kFree = 4,
+  };
+
+  static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+  Type type{Type::kAlloc};
+  uint16_t allocator_id{0};
+  uint16_t stream_id{0};
+  uint32_t node_index{kNoNode};
+  uint64_t timestamp_ns{0};
+  uint64_t address{0};
+  uint64_t size{0};
+};
+
+// Records the events of the arenas registered with it into a trace file. Thread-safe.
+class AllocationTraceRecorder {
+ public:
+  // Creates or truncates the trace file.
+  static Status Create(const std::string& path, std::unique_ptr<AllocationTraceRecorder>& recorder);
+
+  // Writes the buffered events.
+  ~AllocationTraceRecorder();
+
+  // Adds an allocator to the trace and returns the id to record its events with.
+  uint16_t AddAllocator(const std::string& name, const OrtArenaCfg& config);
+
+  void Record(AllocationTraceEvent::Type type, uint16_t allocator_id, const void* address, size_t size,
+              const Stream* stream);
+
+  // The node whose kernel is executing on the calling thread, attributed to the events it records.
+  static void SetCurrentNode(uint32_t node_index);
+  static uint32_t GetCurrentNode();
+
+ private:
+  explicit AllocationTraceRecorder(std::ofstream file);
+
+  void FlushLocked();
+
+  std::ofstream file_;
+  const std::chrono::steady_clock::time_point start_time_{std::chrono::steady_clock::now()};
+
+  OrtMutex mutex_;
+  // GUARDED_BY(mutex_)
+  std::vector<uint8_t> buffer_;
+  uint16_t next_allocator_id_{0};
+  std::unordered_map<const Stream*, uint16_t> stream_ids_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AllocationTraceRecorder);
+};
+
+// Attributes the events recorded by the calling thread to a node while in scope.
+class AllocationTraceNodeScope {
+ public:
+  explicit AllocationTraceNodeScope(size_t node_index)
+      : previous_node_{AllocationTraceRecorder::GetCurrentNode()} {
+    AllocationTraceRecorder::SetCurrentNode(static_cast<uint32_t>(node_index));
+  }
+
+  ~AllocationTraceNodeScope() { AllocationTraceRecorder::SetCurrentNode(previous_node_); }
+
+ private:
+  const uint32_t previous_node_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AllocationTraceNodeScope);
+};
+
+// A trace file loaded in memory.
+struct AllocationTrace {
+  struct Allocator {
+    std::string name;
+    OrtArenaCfg config;
+  };
+
+  // indexed by allocator id
+  std::vector<Allocator> allocators;
+  // the kAlloc, kReserve and kFree events in the order they were recorded
+  std::vector<AllocationTraceEvent> events;
+
+  static Status Load(const std::string& path, AllocationTrace& trace);
+};
+
+}  // namespace onnxruntime
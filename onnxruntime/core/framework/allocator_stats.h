@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -22,6 +25,9 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_thread_cache_misses;   // Number of allocations the thread caches had to refill from the arena for.
+  int64_t num_thread_cache_flushes;  // Number of times a thread cache returned free chunks to the arena.
+  int64_t num_cross_stream_reuses;   // Number of allocations served by a chunk freed on another stream.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +41,9 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_misses = 0;
+    this->num_thread_cache_flushes = 0;
+    this->num_cross_stream_reuses = 0;
   }
 
   std::string DebugString() const {
@@ -47,7 +56,75 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumThreadCacheMisses:     " << this->num_thread_cache_misses << "\n"
+       << "NumThreadCacheFlushes:    " << this->num_thread_cache_flushes << "\n"
+       << "NumCrossStreamReuses:     " << this->num_cross_stream_reuses << "\n";
+    return ss.str();
+  }
+};
+
+// Detailed runtime metrics of an allocator, for monitoring e.g. how fragmented an arena is.
+struct AllocatorMetrics {
+  // bucket 0 counts the values below 2, bucket i > 0 the values in [2^i, 2^(i+1)). the last bucket is unbounded.
+  static constexpr size_t kNumHistogramBuckets = 40;
+  using Histogram = std::array<int64_t, kNumHistogramBuckets>;
+
+  struct BinMetrics {
+    size_t bin_size = 0;           // All chunks in the bin have >= bin_size bytes.
+    int64_t num_chunks_in_use = 0;
+    int64_t bytes_in_use = 0;
+    int64_t num_free_chunks = 0;
+    int64_t free_bytes = 0;
+  };
+
+  AllocatorStats stats;
+  int64_t largest_free_chunk = 0;  // Largest allocation that can be served without extending the arena.
+  std::vector<BinMetrics> bins;    // Only the bins that hold chunks.
+  Histogram alloc_size_histogram{};  // Requested size in bytes of every allocation.
+  Histogram lifetime_histogram{};    // Lifetime in microseconds of every freed allocation.
+
+  static size_t HistogramBucket(uint64_t value) {
+    size_t bucket = 0;
+    while (value > 1 && bucket + 1 < kNumHistogramBuckets) {
+      value >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  std::string ToJson() const {
+    std::ostringstream ss;
+    auto write_histogram = [&ss](const Histogram& histogram) {
+      ss << "[";
+      for (size_t i = 0; i < histogram.size(); ++i) {
+        ss << (i > 0 ? "," : "") << histogram[i];
+      }
+      ss << "]";
+    };
+
+    ss << "{\"bytes_in_use\":" << stats.bytes_in_use
+       << ",\"total_allocated_bytes\":" << stats.total_allocated_bytes
+       << ",\"max_bytes_in_use\":" << stats.max_bytes_in_use
+       << ",\"bytes_limit\":" << stats.bytes_limit
+       << ",\"num_allocs\":" << stats.num_allocs
+       << ",\"num_reserves\":" << stats.num_reserves
+       << ",\"num_arena_extensions\":" << stats.num_arena_extensions
+       << ",\"num_arena_shrinkages\":" << stats.num_arena_shrinkages
+       << ",\"max_alloc_size\":" << stats.max_alloc_size
+       << ",\"largest_free_chunk\":" << largest_free_chunk
+       << ",\"bins\":[";
+    for (size_t i = 0; i < bins.size(); ++i) {
+      const auto& bin = bins[i];
+      ss << (i > 0 ? "," : "") << "{\"bin_size\":" << bin.bin_size
+         << ",\"num_chunks_in_use\":" << bin.num_chunks_in_use << ",\"bytes_in_use\":" << bin.bytes_in_use
+         << ",\"num_free_chunks\":" << bin.num_free_chunks << ",\"free_bytes\":" << bin.free_bytes << "}";
+    }
+    ss << "],\"alloc_size_histogram\":";
+    write_histogram(alloc_size_histogram);
+    ss << ",\"lifetime_us_histogram\":";
+    write_histogram(lifetime_histogram);
+    ss << "}";
     return ss.str();
   }
 };
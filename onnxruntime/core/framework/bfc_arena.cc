@@ -3,16 +3,30 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
 #include <type_traits>
 
 namespace onnxruntime {
+
+namespace {
+int64_t NowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   size_t thread_cache_max_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -25,14 +39,21 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
-      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+      max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes),
+      thread_cache_max_bytes_(std::min(thread_cache_max_bytes, MAX_THREAD_CACHE_BYTES)) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy)
+                     << " thread_cache_max_bytes: " << thread_cache_max_bytes_;
+
+  if (thread_cache_max_bytes_ > 0) {
+    thread_caches_ = std::make_unique<ThreadCache[]>(kNumThreadCaches);
+    thread_cache_indices_ = std::make_unique<ThreadCacheIndex[]>(kNumThreadCaches);
+  }
 
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
@@ -212,6 +233,7 @@ Status BFCArena::Extend(size_t rounded_bytes) {
   LOGS_DEFAULT(INFO) << "Allocated memory at " << mem_addr << " to "
                      << static_cast<void*>(static_cast<char*>(mem_addr) + bytes);
   region_manager_.AddAllocationRegion(mem_addr, bytes, stats_.num_arena_extensions);
+  region_manager_.set_last_free_interval(mem_addr, shrink_interval_);
   stats_.num_arena_extensions += 1;
 
   // Create one large chunk for the whole memory space that will
@@ -269,7 +291,148 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
-  return AllocateRawInternal(size, false, nullptr, false, nullptr);
+  void* p = (thread_caches_ && size > 0 && size <= thread_cache_max_bytes_)
+                ? ThreadCacheAlloc(size)
+                : AllocateRawInternal(size, false, nullptr, false, nullptr);
+  RecordTraceEvent(AllocationTraceEvent::Type::kAlloc, p, size, nullptr);
+  return p;
+}
+
+OrtArenaCfg BFCArena::GetConfig() const {
+  return OrtArenaCfg(memory_limit_, static_cast<int>(arena_extend_strategy_), initial_chunk_size_bytes_,
+                     max_dead_bytes_per_chunk_, initial_growth_chunk_size_bytes_, max_power_of_two_extend_bytes_,
+                     thread_cache_max_bytes_);
+}
+
+void BFCArena::SetAllocationTraceRecorder(AllocationTraceRecorder* recorder) {
+  if (recorder != nullptr) {
+    trace_allocator_id_.store(recorder->AddAllocator(Info().name, GetConfig()), std::memory_order_relaxed);
+  }
+  trace_recorder_.store(recorder, std::memory_order_release);
+}
+
+BFCArena::ThreadCacheIndex& BFCArena::ThreadCacheIndexFor(const void* p) {
+  // chunks are at least kMinAllocationSize apart
+  const auto address = reinterpret_cast<std::uintptr_t>(p) >> kMinAllocationBits;
+  return thread_cache_indices_[address % kNumThreadCaches];
+}
+
+void* BFCArena::ThreadCacheAlloc(size_t size) {
+  const int size_class = Log2FloorNonZero(RoundedBytes(size) * 2 - 1) - static_cast<int>(kMinAllocationBits);
+  const size_t class_bytes = BinNumToSize(size_class);
+  ThreadCache& cache = thread_caches_[std::hash<std::thread::id>{}(std::this_thread::get_id()) % kNumThreadCaches];
+
+  {
+    std::lock_guard<OrtMutex> lock(cache.mutex);
+    auto& free_chunks = cache.free_chunks[size_class];
+    if (!free_chunks.empty()) {
+      void* p = free_chunks.back();
+      free_chunks.pop_back();
+      return p;
+    }
+  }
+
+  // refill with up to 32KB of chunks. only the first chunk may extend the arena.
+  const size_t batch_size = std::max<size_t>(1, std::min<size_t>(32, 32 * 1024 / class_bytes));
+  std::vector<void*> chunks;
+  chunks.reserve(batch_size);
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    ++stats_.num_thread_cache_misses;
+    chunks.push_back(AllocateRawLocked(class_bytes, false, nullptr, false, nullptr));
+    const BinNum bin_num = BinNumForSize(class_bytes);
+    while (chunks.size() < batch_size) {
+      auto* chunk = FindChunkPtr(bin_num, class_bytes, class_bytes, nullptr, false);
+      if (chunk == nullptr) {
+        break;
+      }
+      chunks.push_back(chunk->ptr);
+    }
+  }
+
+  for (void* p : chunks) {
+    ThreadCacheIndex& index = ThreadCacheIndexFor(p);
+    std::lock_guard<OrtMutex> lock(index.mutex);
+    index.size_classes[p] = size_class;
+  }
+
+  if (chunks.size() > 1) {
+    std::lock_guard<OrtMutex> lock(cache.mutex);
+    auto& free_chunks = cache.free_chunks[size_class];
+    free_chunks.insert(free_chunks.end(), chunks.begin() + 1, chunks.end());
+  }
+
+  return chunks.front();
+}
+
+bool BFCArena::ThreadCacheFree(void* p) {
+  int size_class;
+  {
+    ThreadCacheIndex& index = ThreadCacheIndexFor(p);
+    std::lock_guard<OrtMutex> lock(index.mutex);
+    auto it = index.size_classes.find(p);
+    if (it == index.size_classes.end()) {
+      return false;
+    }
+    size_class = it->second;
+  }
+
+  const size_t class_bytes = BinNumToSize(size_class);
+  const size_t max_cached_chunks = 2 * std::max<size_t>(1, std::min<size_t>(32, 32 * 1024 / class_bytes));
+  ThreadCache& cache = thread_caches_[std::hash<std::thread::id>{}(std::this_thread::get_id()) % kNumThreadCaches];
+  std::vector<void*> chunks_to_flush;
+  {
+    std::lock_guard<OrtMutex> lock(cache.mutex);
+    auto& free_chunks = cache.free_chunks[size_class];
+    free_chunks.push_back(p);
+    if (free_chunks.size() > max_cached_chunks) {
+      // return the chunks freed first, keep the most recently used ones
+      const auto flush_end = free_chunks.begin() + (free_chunks.size() - max_cached_chunks / 2);
+      chunks_to_flush.assign(free_chunks.begin(), flush_end);
+      free_chunks.erase(free_chunks.begin(), flush_end);
+    }
+  }
+
+  if (!chunks_to_flush.empty()) {
+    FlushThreadCacheChunks(chunks_to_flush);
+  }
+
+  return true;
+}
+
+void BFCArena::FlushThreadCacheChunks(const std::vector<void*>& chunks) {
+  for (void* p : chunks) {
+    ThreadCacheIndex& index = ThreadCacheIndexFor(p);
+    std::lock_guard<OrtMutex> lock(index.mutex);
+    index.size_classes.erase(p);
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  ++stats_.num_thread_cache_flushes;
+  for (void* p : chunks) {
+    DeallocateRawInternal(p);
+  }
+}
+
+void BFCArena::FlushThreadCaches() {
+  if (!thread_caches_) {
+    return;
+  }
+
+  for (size_t i = 0; i < kNumThreadCaches; ++i) {
+    std::vector<void*> chunks;
+    {
+      std::lock_guard<OrtMutex> lock(thread_caches_[i].mutex);
+      for (auto& free_chunks : thread_caches_[i].free_chunks) {
+        chunks.insert(chunks.end(), free_chunks.begin(), free_chunks.end());
+        free_chunks.clear();
+      }
+    }
+
+    if (!chunks.empty()) {
+      FlushThreadCacheChunks(chunks);
+    }
+  }
 }
 
 void* BFCArena::Reserve(size_t size) {
@@ -288,7 +451,9 @@ void* BFCArena::Reserve(size_t size) {
   stats_.num_allocs += 1;
   stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), size);
   stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
+  interval_max_bytes_in_use_ = std::max(interval_max_bytes_in_use_, stats_.bytes_in_use);
   stats_.total_allocated_bytes += size;
+  RecordTraceEvent(AllocationTraceEvent::Type::kReserve, ptr, size, nullptr);
   return ptr;
 }
 
@@ -317,6 +482,16 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
     LOGS_DEFAULT(VERBOSE) << "tried to allocate 0 bytes";
     return nullptr;
   }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  return AllocateRawLocked(num_bytes, dump_log_on_failure, stream, enable_cross_stream_reusing, wait_fn);
+}
+
+void* BFCArena::AllocateRawLocked(size_t num_bytes,
+                                  bool dump_log_on_failure,
+                                  Stream* stream,
+                                  bool enable_cross_stream_reusing,
+                                  WaitNotificationFn wait_fn) {
   // First, always allocate memory of at least kMinAllocationSize
   // bytes, and always allocate multiples of kMinAllocationSize bytes
   // so all memory addresses are nicely byte aligned.
@@ -325,7 +500,6 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
-  std::lock_guard<OrtMutex> lock(lock_);
   // search for a valid chunk
   auto* chunk = FindChunkPtr(bin_num,
                              rounded_bytes,
@@ -381,6 +555,37 @@ void BFCArena::GetStats(AllocatorStats* stats) {
   *stats = stats_;
 }
 
+void BFCArena::GetMetrics(AllocatorMetrics* metrics) {
+  *metrics = AllocatorMetrics{};
+  std::lock_guard<OrtMutex> lock(lock_);
+  metrics->stats = stats_;
+  metrics->alloc_size_histogram = alloc_size_histogram_;
+  metrics->lifetime_histogram = lifetime_histogram_;
+
+  const std::array<BinDebugInfo, kNumBins> bin_infos = get_bin_debug_info();
+  for (BinNum bin_num = 0; bin_num < kNumBins; bin_num++) {
+    const BinDebugInfo& bin_info = bin_infos[bin_num];
+    if (bin_info.total_chunks_in_bin == 0) {
+      continue;
+    }
+
+    const Bin* bin = BinFromIndex(bin_num);
+    AllocatorMetrics::BinMetrics bin_metrics;
+    bin_metrics.bin_size = bin->bin_size;
+    bin_metrics.num_chunks_in_use = static_cast<int64_t>(bin_info.total_chunks_in_use);
+    bin_metrics.bytes_in_use = static_cast<int64_t>(bin_info.total_bytes_in_use);
+    bin_metrics.num_free_chunks = static_cast<int64_t>(bin_info.total_chunks_in_bin - bin_info.total_chunks_in_use);
+    bin_metrics.free_bytes = static_cast<int64_t>(bin_info.total_bytes_in_bin - bin_info.total_bytes_in_use);
+    metrics->bins.push_back(bin_metrics);
+
+    // free chunks are sorted by size
+    if (!bin->free_chunks.empty()) {
+      const Chunk* largest = ChunkFromHandle(*bin->free_chunks.rbegin());
+      metrics->largest_free_chunk = std::max(metrics->largest_free_chunk, static_cast<int64_t>(largest->size));
+    }
+  }
+}
+
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
                                                  const BFCArena::Bin::FreeChunkSet::iterator& citer,
                                                  size_t rounded_bytes,
@@ -408,8 +613,11 @@ BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* fr
   stats_.bytes_in_use += chunk->size;
   stats_.max_bytes_in_use =
       std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  interval_max_bytes_in_use_ = std::max(interval_max_bytes_in_use_, stats_.bytes_in_use);
   stats_.max_alloc_size =
       std::max<int64_t>(stats_.max_alloc_size, static_cast<int64_t>(chunk->size));
+  ++alloc_size_histogram_[AllocatorMetrics::HistogramBucket(num_bytes)];
+  chunk->alloc_time_us = NowMicros();
   return chunk;
 }
 
@@ -417,7 +625,10 @@ BFCArena::Chunk* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
                                         size_t num_bytes, Stream* stream,
                                         bool allow_chunk_from_different_stream,
                                         WaitNotificationFn wait_fn) {
-  BFCArena::Chunk* other_stream_candidate = nullptr;
+  // a chunk last used by another stream can only be handed out if the stream can be made to wait for that use.
+  allow_chunk_from_different_stream = allow_chunk_from_different_stream && stream && wait_fn;
+  Bin* other_stream_bin = nullptr;
+  Bin::FreeChunkSet::iterator other_stream_candidate;
   // First identify the first bin that could satisfy rounded_bytes.
   for (; bin_num < kNumBins; bin_num++) {
     // Start searching from the first bin for the smallest chunk that fits
@@ -436,21 +647,27 @@ BFCArena::Chunk* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         if (safe_to_use) {
           // the chunk with same stream has higher priority.
           return SplitFreeChunkFromBin(&b->free_chunks, citer, rounded_bytes, num_bytes);
-        } else if (allow_chunk_from_different_stream && !other_stream_candidate) {
-          other_stream_candidate = chunk;
+        } else if (allow_chunk_from_different_stream && !other_stream_bin) {
+          // the chunks are visited in increasing size, so the first one is the best fit.
+          other_stream_bin = b;
+          other_stream_candidate = citer;
         }
       }
     }
   }
-  // if trying to use an unsafe chunk from other streams, secure it.
-  if (other_stream_candidate) {
-    SecureTheChunk(other_stream_candidate->stream, stream, wait_fn);
-    // if find some available chunk, make sure mark it as "being used" before return
-    other_stream_candidate->allocation_id = next_allocation_id_++;
-    other_stream_candidate->bin_num = kInvalidBinNum;
+
+  if (!other_stream_bin) {
+    return nullptr;
   }
 
-  return other_stream_candidate;
+  // make the stream wait for the work enqueued on the other stream so far, which includes the last use of the chunk,
+  // and hand the chunk over to the stream. The remainder split off the chunk stays with the other stream.
+  SecureTheChunk(ChunkFromHandle(*other_stream_candidate)->stream, stream, wait_fn);
+  BFCArena::Chunk* chunk = SplitFreeChunkFromBin(&other_stream_bin->free_chunks, other_stream_candidate, rounded_bytes, num_bytes);
+  chunk->stream = stream;
+  chunk->stream_timestamp = stream->GetCurrentTimestamp();
+  ++stats_.num_cross_stream_reuses;
+  return chunk;
 }
 
 void BFCArena::SplitChunk(BFCArena::ChunkHandle h, size_t num_bytes) {
@@ -496,6 +713,10 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  RecordTraceEvent(AllocationTraceEvent::Type::kFree, p, 0, nullptr);
+  if (thread_caches_ && ThreadCacheFree(p)) {
+    return;
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -508,7 +729,43 @@ void BFCArena::Free(void* p) {
   }
 }
 
+bool BFCArena::IsRegionUnused(void* region_ptr) {
+  ChunkHandle h = region_manager_.get_handle(region_ptr);
+  while (h != kInvalidChunkHandle) {
+    const Chunk* c = ChunkFromHandle(h);
+    if (c->in_use()) {
+      return false;
+    }
+    h = c->next;
+  }
+  return true;
+}
+
+void BFCArena::FreeRegion(void* region_ptr, size_t region_size) {
+  stats_.num_arena_shrinkages += 1;
+  stats_.total_allocated_bytes -= region_size;
+
+  LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
+                        << region_size << " bytes. "
+                        << " The total allocated bytes is now " << stats_.total_allocated_bytes;
+
+  ChunkHandle h = region_manager_.get_handle(region_ptr);
+  while (h != kInvalidChunkHandle) {
+    const Chunk* c = ChunkFromHandle(h);
+    ChunkHandle next = c->next;
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    h = next;
+  }
+
+  device_allocator_->Free(region_ptr);
+  region_manager_.RemoveAllocationRegion(region_ptr);
+  stats_.num_arena_extensions--;
+}
+
 Status BFCArena::Shrink() {
+  FlushThreadCaches();
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
@@ -523,52 +780,76 @@ Status BFCArena::Shrink() {
     }
   }
 
-  size_t i = 0;
-  for (void* region_ptr : region_ptrs) {
-    bool deallocate_region = true;
-    ChunkHandle region_begin_chunk = region_manager_.get_handle(region_ptr);
-    ChunkHandle h = region_begin_chunk;
-    while (h != kInvalidChunkHandle) {
-      const Chunk* c = ChunkFromHandle(h);
-      if (c->in_use()) {
-        // at-least one used chunk found in the allocation region -
-        // so we cannot deallocate it
-        deallocate_region = false;
-        break;
-      }
-      h = c->next;
+  for (size_t i = 0; i < region_ptrs.size(); ++i) {
+    // at-least one used chunk found in the allocation region - so we cannot deallocate it
+    if (IsRegionUnused(region_ptrs[i])) {
+      FreeRegion(region_ptrs[i], region_sizes[i]);
     }
+  }
+
+  // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
+  // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
+  curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
 
-    if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
-      stats_.num_arena_shrinkages += 1;
-      stats_.total_allocated_bytes -= shrink_size;
+  return Status::OK();
+}
 
-      LOGS_DEFAULT(VERBOSE) << device_allocator_->Info().name << " BFC Arena shrunk by "
-                            << shrink_size << " bytes. "
-                            << " The total allocated bytes is now " << stats_.total_allocated_bytes;
+Status BFCArena::ShrinkWithPolicy(const ShrinkPolicy& policy) {
+  // chunks held by the thread caches would keep their regions in use
+  FlushThreadCaches();
 
-      h = region_begin_chunk;
-      ChunkHandle temp = region_begin_chunk;
-      while (h != kInvalidChunkHandle) {
-        const Chunk* c = ChunkFromHandle(h);
-        temp = c->next;
-        RemoveFreeChunkFromBin(h);
-        DeleteChunk(h);
-        h = temp;
-      }
+  std::lock_guard<OrtMutex> lock(lock_);
+  const uint64_t current_interval = shrink_interval_++;
+
+  interval_peaks_.push_back(interval_max_bytes_in_use_);
+  while (interval_peaks_.size() > policy.high_water_mark_intervals) {
+    interval_peaks_.pop_front();
+  }
+  interval_max_bytes_in_use_ = stats_.bytes_in_use;
+
+  int64_t high_water_mark = 0;
+  for (int64_t peak : interval_peaks_) {
+    high_water_mark = std::max(high_water_mark, peak);
+  }
+
+  struct UnusedRegion {
+    uint64_t last_free_interval;
+    void* ptr;
+    size_t size;
+  };
+  std::vector<UnusedRegion> unused_regions;
+  for (const auto& region : region_manager_.regions()) {
+    if ((consider_first_allocation_region_for_shrinkage_ || region.id() != 0) && IsRegionUnused(region.ptr())) {
+      unused_regions.push_back({region.last_free_interval(), region.ptr(), region.memory_size()});
+    }
+  }
+
+  // least recently used first
+  std::sort(unused_regions.begin(), unused_regions.end(), [](const UnusedRegion& a, const UnusedRegion& b) {
+    return a.last_free_interval < b.last_free_interval;
+  });
+
+  bool shrunk = false;
+  for (const auto& region : unused_regions) {
+    const bool idle = policy.idle_intervals > 0 && current_interval - region.last_free_interval >= policy.idle_intervals;
+    const bool over_soft_limit = policy.soft_limit_bytes > 0 &&
+                                 stats_.total_allocated_bytes > static_cast<int64_t>(policy.soft_limit_bytes);
+    const bool above_high_water_mark = policy.high_water_mark_intervals > 0;
+    if (!idle && !over_soft_limit && !above_high_water_mark) {
+      continue;
+    }
 
-      device_allocator_->Free(region_ptr);
-      region_manager_.RemoveAllocationRegion(region_ptr);
-      stats_.num_arena_extensions--;
+    if (stats_.total_allocated_bytes - static_cast<int64_t>(region.size) < high_water_mark) {
+      continue;
     }
 
-    ++i;
+    FreeRegion(region.ptr, region.size);
+    shrunk = true;
   }
 
-  // Will affect how the arena grows if the arena extend strategy is kNextPowerOfTwo
-  // In case the extend strategy is kSameAsRequested, the arena growth is exactly the size of the memory request itself
-  curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+  if (shrunk) {
+    curr_region_allocation_bytes_ = initial_growth_chunk_size_bytes_;
+  }
 
   return Status::OK();
 }
@@ -577,6 +858,7 @@ void BFCArena::DeallocateRawInternal(void* ptr) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
+  region_manager_.set_last_free_interval(ptr, shrink_interval_);
 
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
@@ -658,6 +940,8 @@ void BFCArena::FreeAndMaybeCoalesce(BFCArena::ChunkHandle h) {
 
   // Updates the stats.
   stats_.bytes_in_use -= c->size;
+  const int64_t lifetime_us = NowMicros() - c->alloc_time_us;
+  ++lifetime_histogram_[AllocatorMetrics::HistogramBucket(static_cast<uint64_t>(std::max<int64_t>(lifetime_us, 0)))];
 
   // This chunk is no longer in-use, consider coalescing the chunk
   // with adjacent chunks.
@@ -856,19 +1140,23 @@ StreamAwareArena::StreamAwareArena(std::unique_ptr<IAllocator> resource_allocato
                                    int initial_chunk_size_bytes,
                                    int max_dead_bytes_per_chunk,
                                    int initial_growth_chunk_size_bytes,
-                                   int64_t max_power_of_two_extend_bytes) : BFCArena(std::move(resource_allocator),
-                                                                                     total_memory,
-                                                                                     arena_extend_strategy,
-                                                                                     initial_chunk_size_bytes,
-                                                                                     max_dead_bytes_per_chunk,
-                                                                                     initial_growth_chunk_size_bytes,
-                                                                                     max_power_of_two_extend_bytes),
+                                   int64_t max_power_of_two_extend_bytes,
+                                   size_t thread_cache_max_bytes) : BFCArena(std::move(resource_allocator),
+                                                                             total_memory,
+                                                                             arena_extend_strategy,
+                                                                             initial_chunk_size_bytes,
+                                                                             max_dead_bytes_per_chunk,
+                                                                             initial_growth_chunk_size_bytes,
+                                                                             max_power_of_two_extend_bytes,
+                                                                             thread_cache_max_bytes),
                                                                             enable_cross_stream_reusing_(enable_cross_stream_sharing) {
   arena_type_ = ArenaType::StreamAwareArena;
 }
 
 void* StreamAwareArena::AllocOnStream(size_t size, Stream* current_stream, WaitNotificationFn wait_fn) {
-  return AllocateRawInternal(size, false, current_stream, enable_cross_stream_reusing_, wait_fn);
+  void* p = AllocateRawInternal(size, false, current_stream, enable_cross_stream_reusing_, wait_fn);
+  RecordTraceEvent(AllocationTraceEvent::Type::kAlloc, p, size, current_stream);
+  return p;
 }
 
 void StreamAwareArena::ReleaseStreamBuffers(Stream* stream) {
@@ -16,9 +16,13 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -29,6 +33,7 @@ limitations under the License.
 
 #include "core/platform/ort_mutex.h"
 #include "core/framework/arena_extend_strategy.h"
+#include "core/framework/allocation_trace.h"
 #include "core/framework/allocator.h"
 
 #include "core/framework/stream_handles.h"
@@ -61,6 +66,8 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  // largest allocation that can be served from the per-thread caches
+  static const size_t MAX_THREAD_CACHE_BYTES = 1024 * 1024;
 
   enum ArenaType {
     BaseArena,
@@ -73,7 +80,8 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           size_t thread_cache_max_bytes = 0);
 
   ~BFCArena() override;
 
@@ -86,6 +94,7 @@ class BFCArena : public IAllocator {
   void Free(void* p) override;
 
   // Frees all allocation regions in which no chunk is in use.
+  // The free chunks held by the thread caches are returned to the arena first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -93,16 +102,42 @@ class BFCArena : public IAllocator {
   // and the allocation request.
   Status Shrink();
 
+  // Decides which allocation regions ShrinkWithPolicy frees. Only regions in which no chunk is in use are freed.
+  // The policy is evaluated once per interval, whose length is up to the caller.
+  struct ShrinkPolicy {
+    // free regions that have been unused for at least this many intervals. 0 disables.
+    uint64_t idle_intervals = 0;
+    // free unused regions, least recently used first, while the arena holds more than this many bytes. 0 disables.
+    size_t soft_limit_bytes = 0;
+    // free unused regions as long as the arena keeps enough memory for the peak usage of the last this many
+    // intervals, including the current one. Also limits the other criteria. 0 disables.
+    size_t high_water_mark_intervals = 0;
+  };
+
+  // Evaluates `policy` for the interval that ends now and frees the regions it selects.
+  // Does not free any reserved chunks, and is subject to the same first region rule as Shrink.
+  Status ShrinkWithPolicy(const ShrinkPolicy& policy);
+
   void* Reserve(size_t size) override;
 
   void GetStats(AllocatorStats* stats) override;
 
+  // Walks all chunks under the arena lock, so the cost is proportional to the number of chunks.
+  void GetMetrics(AllocatorMetrics* metrics) override;
+
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
 
   ArenaType GetArenaType() const { return arena_type_; }
 
+  // The configuration the arena was created with.
+  OrtArenaCfg GetConfig() const;
+
+  // Records the allocations, reservations and frees of the arena into `recorder` until it is replaced or reset with
+  // nullptr, which must happen before the recorder is destroyed.
+  void SetAllocationTraceRecorder(AllocationTraceRecorder* recorder);
+
   virtual void SecureTheChunk(Stream* /*chunk_stream*/,
                               Stream* /*target_stream*/,
                               WaitNotificationFn /*wait_fn*/) const {}
@@ -121,8 +156,54 @@ class BFCArena : public IAllocator {
   ArenaType arena_type_;
 
  private:
+  void* AllocateRawLocked(size_t num_bytes,
+                          bool dump_log_on_failure,
+                          Stream* stream,
+                          bool enable_cross_stream_reusing,
+                          WaitNotificationFn wait_fn);
+
   void DeallocateRawInternal(void* ptr);
 
+  // Records an event if the arena is traced. A null `p` is not recorded.
+  void RecordTraceEvent(AllocationTraceEvent::Type type, const void* p, size_t size, const Stream* stream) {
+    if (p == nullptr) {
+      return;
+    }
+    if (auto* recorder = trace_recorder_.load(std::memory_order_acquire)) {
+      recorder->Record(type, trace_allocator_id_.load(std::memory_order_relaxed), p, size, stream);
+    }
+  }
+
+  // Per-thread caches of free chunks in front of the arena, similar to the thread caches of tcmalloc.
+  // Allocations of up to thread_cache_max_bytes_ are rounded up to a power of two size class. A thread takes chunks
+  // of a size class from its cache and puts freed chunks back into its cache without holding lock_. An empty cache
+  // is refilled from the arena with a batch of chunks, and a cache holding too many chunks returns half of them,
+  // both under a single acquisition of lock_. Chunks held by the caches are in use as far as the arena is concerned.
+  // Threads are mapped to caches by hashing their id, so a few threads may share a cache.
+  static const int kNumThreadCacheSizeClasses = 13;  // 256 bytes to MAX_THREAD_CACHE_BYTES
+  static const size_t kNumThreadCaches = 16;
+
+  struct ThreadCache {
+    OrtMutex mutex;
+    // free chunks by size class. GUARDED_BY(mutex)
+    std::array<std::vector<void*>, kNumThreadCacheSizeClasses> free_chunks;
+  };
+
+  // size classes of the chunks owned by the caches, whether free or allocated, sharded by address.
+  struct ThreadCacheIndex {
+    OrtMutex mutex;
+    // GUARDED_BY(mutex)
+    std::unordered_map<const void*, int> size_classes;
+  };
+
+  void* ThreadCacheAlloc(size_t size);
+  // returns false if `p` is not owned by the caches.
+  bool ThreadCacheFree(void* p);
+  // return the chunks in `chunks` to the arena.
+  void FlushThreadCacheChunks(const std::vector<void*>& chunks);
+  void FlushThreadCaches();
+  ThreadCacheIndex& ThreadCacheIndexFor(const void* p);
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -170,6 +251,9 @@ class BFCArena : public IAllocator {
 
     uint64_t stream_timestamp = 0;
 
+    // when the chunk was allocated, in microseconds of the steady clock. only valid if in_use().
+    int64_t alloc_time_us = 0;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -259,6 +343,8 @@ class BFCArena : public IAllocator {
     void* end_ptr() const { return end_ptr_; }
     size_t memory_size() const { return memory_size_; }
     int64_t id() const { return id_; }
+    uint64_t last_free_interval() const { return last_free_interval_; }
+    void set_last_free_interval(uint64_t interval) { last_free_interval_ = interval; }
     ChunkHandle get_handle(const void* p) const {
       return handles_[IndexFor(p)];
     }
@@ -271,6 +357,7 @@ class BFCArena : public IAllocator {
       std::swap(memory_size_, other.memory_size_);
       std::swap(end_ptr_, other.end_ptr_);
       std::swap(id_, other.id_);
+      std::swap(last_free_interval_, other.last_free_interval_);
       std::swap(handles_, other.handles_);
     }
 
@@ -289,6 +376,8 @@ class BFCArena : public IAllocator {
     // A unique identifier for this allocation region
     // (May be used by the client to track which allocation region was allocated first, second, and so on)
     int64_t id_ = -1;
+    // The shrink interval in which a chunk of this region was last freed, see ShrinkWithPolicy
+    uint64_t last_free_interval_ = 0;
 
     // Array of size "memory_size / kMinAllocationSize".  It is
     // indexed by (p-base) / kMinAllocationSize, contains ChunkHandle
@@ -332,6 +421,9 @@ class BFCArena : public IAllocator {
       return MutableRegionFor(p)->set_handle(p, h);
     }
     void erase(const void* p) { return MutableRegionFor(p)->erase(p); }
+    void set_last_free_interval(const void* p, uint64_t interval) {
+      MutableRegionFor(p)->set_last_free_interval(interval);
+    }
 
     const std::vector<AllocationRegion>& regions() const { return regions_; }
 
@@ -365,6 +457,12 @@ class BFCArena : public IAllocator {
   // Returns 'bytes' rounded up to the next highest kMinAllocationSize.
   size_t RoundedBytes(size_t bytes);
 
+  // Returns true if no chunk of the region starting at 'region_ptr' is in use.
+  bool IsRegionUnused(void* region_ptr);
+
+  // Frees the region starting at 'region_ptr', which must be unused.
+  void FreeRegion(void* region_ptr, size_t region_size);
+
   // Try to add a new memory region that can satisfy an allocation of
   // 'rounded_bytes' bytes.
   Status Extend(size_t rounded_bytes);
@@ -501,6 +599,8 @@ class BFCArena : public IAllocator {
   int64_t next_allocation_id_;
 
   AllocatorStats stats_;
+  AllocatorMetrics::Histogram alloc_size_histogram_{};
+  AllocatorMetrics::Histogram lifetime_histogram_{};
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
@@ -509,6 +609,24 @@ class BFCArena : public IAllocator {
   const int initial_growth_chunk_size_bytes_;
   const int64_t max_power_of_two_extend_bytes_;
 
+  // number of intervals ShrinkWithPolicy has evaluated
+  uint64_t shrink_interval_ = 0;
+  // peak bytes in use during the current shrink interval
+  int64_t interval_max_bytes_in_use_ = 0;
+  // peak bytes in use of the most recent shrink intervals
+  std::deque<int64_t> interval_peaks_;
+
+  const size_t thread_cache_max_bytes_;
+
+  // nullptr unless the events of the arena are traced
+  std::atomic<AllocationTraceRecorder*> trace_recorder_{nullptr};
+  // the id of the arena in the trace of trace_recorder_
+  std::atomic<uint16_t> trace_allocator_id_{0};
+
+  // nullptr if the thread caches are disabled
+  std::unique_ptr<ThreadCache[]> thread_caches_;
+  std::unique_ptr<ThreadCacheIndex[]> thread_cache_indices_;
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
@@ -526,7 +644,8 @@ class StreamAwareArena : public BFCArena {
                    int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
                    int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
                    int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+                   int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+                   size_t thread_cache_max_bytes = 0);
 
   // If size is 0, then this function returns either NULL,
   // or a unique pointer value that can later be successfully
@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/framework/calibration_collector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "nlohmann/json.hpp"
+
+#include "core/common/parse_string.h"
+#include "core/framework/float16.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+
+CalibrationCollector::CalibrationCollector(Method method, size_t num_bins, PathString output_file)
+    : method_(method), num_bins_(num_bins), output_file_(std::move(output_file)) {
+}
+
+Status CalibrationCollector::Create(const ConfigOptions& config_options,
+                                    std::unique_ptr<CalibrationCollector>& collector) {
+  collector.reset();
+  const std::string method = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCalibrationMethod, "");
+  if (method.empty()) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_NOT(method == "minmax" || method == "histogram", "Invalid calibration method: ", method,
+                    ". It must be \"minmax\" or \"histogram\".");
+
+  size_t num_bins = 0;
+  ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+      config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCalibrationNumBins, "2048"), num_bins));
+  ORT_RETURN_IF_NOT(num_bins > 0, "The number of bins of the calibration histograms must be positive.");
+
+  collector = std::make_unique<CalibrationCollector>(
+      method == "minmax" ? Method::MinMax : Method::Histogram, num_bins,
+      ToPathString(config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCalibrationOutputFile, "")));
+  return Status::OK();
+}
+
+void CalibrationCollector::UpdateHistogram(TensorStatistics& statistics, const float* values, size_t count,
+                                           float abs_max) const {
+  auto& histogram = statistics.histogram;
+  if (histogram.empty()) {
+    if (abs_max == 0.0f) {
+      statistics.pending_zeros += count;
+      return;
+    }
+    statistics.threshold = abs_max;
+    histogram.assign(num_bins_, 0);
+    histogram[num_bins_ / 2] += statistics.pending_zeros;
+    statistics.pending_zeros = 0;
+  } else if (abs_max > statistics.threshold) {
+    const float stride = 2.0f * statistics.threshold / static_cast<float>(histogram.size());
+    const auto grow = static_cast<size_t>(std::ceil((abs_max - statistics.threshold) / stride));
+    if (histogram.size() + 2 * grow <= kMaxBinsFactor * num_bins_) {
+      histogram.insert(histogram.begin(), grow, 0);
+      histogram.insert(histogram.end(), grow, 0);
+      statistics.threshold += static_cast<float>(grow) * stride;
+    } else {
+      // re-bin each bin to the bin of its center over the new range
+      std::vector<uint64_t> rebinned(num_bins_, 0);
+      const float new_stride = 2.0f * abs_max / static_cast<float>(num_bins_);
+      for (size_t i = 0; i < histogram.size(); i++) {
+        const float center = -statistics.threshold + (static_cast<float>(i) + 0.5f) * stride;
+        const auto bin = static_cast<size_t>(std::clamp((center + abs_max) / new_stride, 0.0f,
+                                                        static_cast<float>(num_bins_ - 1)));
+        rebinned[bin] += histogram[i];
+      }
+      histogram = std::move(rebinned);
+      statistics.threshold = abs_max;
+    }
+  }
+
+  const float threshold = statistics.threshold;
+  const float inverse_stride = static_cast<float>(histogram.size()) / (2.0f * threshold);
+  const float last_bin = static_cast<float>(histogram.size() - 1);
+  for (size_t i = 0; i < count; i++) {
+    const float bin = (values[i] + threshold) * inverse_stride;
+    if (!std::isnan(bin)) {
+      histogram[static_cast<size_t>(std::clamp(bin, 0.0f, last_bin))]++;
+    }
+  }
+}
+
+void CalibrationCollector::Collect(const std::string& name, const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return;
+  }
+
+  const Tensor& tensor = value.Get<Tensor>();
+  if (tensor.Location().device.Type() != OrtDevice::CPU) {
+    return;
+  }
+
+  std::vector<float> converted;
+  const float* values = nullptr;
+  const auto count = static_cast<size_t>(tensor.Shape().Size());
+  if (tensor.IsDataType<float>()) {
+    values = tensor.Data<float>();
+  } else if (tensor.IsDataType<MLFloat16>()) {
+    const MLFloat16* half_values = tensor.Data<MLFloat16>();
+    converted.resize(count);
+    std::transform(half_values, half_values + count, converted.begin(),
+                   [](MLFloat16 value) { return value.ToFloat(); });
+    values = converted.data();
+  } else {
+    return;
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  const auto min_max = std::minmax_element(values, values + count);
+  const float min = *min_max.first;
+  const float max = *min_max.second;
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& statistics = statistics_[name];
+  statistics.min = std::min(statistics.min, min);
+  statistics.max = std::max(statistics.max, max);
+  const float abs_max = std::max(std::fabs(min), std::fabs(max));
+  if (method_ == Method::Histogram && std::isfinite(abs_max)) {
+    UpdateHistogram(statistics, values, count, abs_max);
+  }
+}
+
+void CalibrationCollector::CollectGraphInputs(const SessionState& session_state,
+                                              gsl::span<const int> feed_mlvalue_idxs,
+                                              gsl::span<const OrtValue> feeds) {
+  const auto& graph_inputs = session_state.GetGraphViewer().GetInputs();
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  std::string name;
+  for (size_t i = 0; i < feeds.size(); i++) {
+    if (!name_idx_map.GetName(feed_mlvalue_idxs[i], name).IsOK()) {
+      continue;
+    }
+
+    if (std::any_of(graph_inputs.begin(), graph_inputs.end(),
+                    [&name](const NodeArg* input) { return input->Name() == name; })) {
+      Collect(name, feeds[i]);
+    }
+  }
+}
+
+void CalibrationCollector::CollectNodeOutputs(OpKernelContextInternal& context, const Node& node) {
+  const auto& output_defs = node.OutputDefs();
+  for (int i = 0, end = context.OutputCount(); i < end; ++i) {
+    if (!output_defs[i]->Exists()) {
+      continue;
+    }
+
+    const auto* type = context.OutputType(i);
+    if (type == nullptr || !type->IsTensorType()) {
+      continue;
+    }
+
+    if (const auto* value = context.GetOutputMLValue(i); value != nullptr && value->IsAllocated()) {
+      Collect(output_defs[i]->Name(), *value);
+    }
+  }
+}
+
+std::map<std::string, CalibrationCollector::TensorStatistics> CalibrationCollector::GetStatistics() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return statistics_;
+}
+
+Status CalibrationCollector::Save(const PathString& path) const {
+  json tensors = json::object();
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (const auto& entry : statistics_) {
+      const auto& statistics = entry.second;
+      json tensor;
+      tensor["min"] = statistics.min;
+      tensor["max"] = statistics.max;
+      if (method_ == Method::Histogram) {
+        tensor["threshold"] = statistics.threshold;
+        tensor["histogram"] = statistics.histogram;
+      }
+      tensors[entry.first] = std::move(tensor);
+    }
+  }
+
+  json contents;
+  contents["method"] = method_ == Method::MinMax ? "minmax" : "histogram";
+  contents["tensors"] = std::move(tensors);
+
+  std::ofstream file(path, std::ios::trunc);
+  ORT_RETURN_IF_NOT(file, "Failed to open calibration file ", PathToUTF8String(path), " for writing");
+  file << contents.dump();
+  ORT_RETURN_IF_NOT(file.good(), "Failed to write calibration file ", PathToUTF8String(path));
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
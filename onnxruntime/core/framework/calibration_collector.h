@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/framework/config_options.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class Node;
+class OpKernelContextInternal;
+class SessionState;
+
+/**
+ * Collects statistics of the float tensors computed while a session runs, to calibrate the quantization of the
+ * model without adding every intermediate tensor to the graph outputs and copying it out of the session.
+ *
+ * The executor passes it the feeds that are inputs of the graph and the outputs of every node, of the main graph
+ * and of the subgraphs. Tensors outside of CPU memory are skipped. The statistics accumulate over all runs and can
+ * be saved as JSON for the quantization tool. Thread safe.
+ */
+class CalibrationCollector {
+ public:
+  enum class Method {
+    // the minimum and maximum of each tensor
+    MinMax,
+    // also a histogram of each tensor, for the entropy, percentile and distribution calibration methods
+    Histogram,
+  };
+
+  struct TensorStatistics {
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+    // Histogram of the values over [-threshold, threshold], like the histogram collector of the quantization tool.
+    // When a value falls outside, the histogram grows by whole bins on both sides, so the counts are not re-binned
+    // unless it would grow past kMaxBinsFactor times the initial number of bins.
+    std::vector<uint64_t> histogram;
+    float threshold = 0.0f;
+    // zeros seen before the first nonzero value sets the width of the bins
+    uint64_t pending_zeros = 0;
+  };
+
+  // The histogram of a tensor is re-binned to the initial number of bins over the whole range when it would grow
+  // past this many times the initial number of bins.
+  static constexpr size_t kMaxBinsFactor = 16;
+
+  CalibrationCollector(Method method, size_t num_bins, PathString output_file = {});
+
+  // Creates a collector as configured by the "session.calibration.*" options, or sets `collector` to nullptr if
+  // calibration is not enabled.
+  static Status Create(const ConfigOptions& config_options, std::unique_ptr<CalibrationCollector>& collector);
+
+  Method GetMethod() const { return method_; }
+
+  // The file the statistics are saved to when the session is destroyed. Empty if not set.
+  const PathString& OutputFile() const { return output_file_; }
+
+  // Adds the values of `value` to the statistics of `name` if it's a float or float16 tensor in CPU memory.
+  void Collect(const std::string& name, const OrtValue& value);
+
+  // Collects the feeds of `session_state` that are inputs of its graph.
+  void CollectGraphInputs(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
+                          gsl::span<const OrtValue> feeds);
+
+  // Collects the outputs of `node` computed in `context`.
+  void CollectNodeOutputs(OpKernelContextInternal& context, const Node& node);
+
+  // Returns the statistics collected so far by tensor name.
+  std::map<std::string, TensorStatistics> GetStatistics() const;
+
+  // Saves the statistics as JSON: {"method": ..., "tensors": {name: {"min", "max", "threshold", "histogram"}}}.
+  // The bins of a histogram split [-threshold, threshold] evenly.
+  Status Save(const PathString& path) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CalibrationCollector);
+
+  void UpdateHistogram(TensorStatistics& statistics, const float* values, size_t count, float abs_max) const;
+
+  const Method method_;
+  const size_t num_bins_;
+  const PathString output_file_;
+
+  mutable OrtMutex mutex_;
+  std::map<std::string, TensorStatistics> statistics_;  // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
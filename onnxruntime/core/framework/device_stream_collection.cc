@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #ifdef ORT_ENABLE_STREAM
+#include "core/common/inlined_containers.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/device_stream_collection.h"
 #include "core/framework/session_state.h"
@@ -45,6 +46,7 @@ class DeviceStreamCollectionImpl {
   }
 
   Status CleanUp(bool sync_streams) {
+    input_copy_notifications_.clear();
     if (sync_streams) {
       for (auto& device_stream : device_streams_) {
         if (device_stream) {
@@ -54,6 +56,9 @@ class DeviceStreamCollectionImpl {
           }
         }
       }
+      for (auto& input_copy_stream : input_copy_streams_) {
+        ORT_RETURN_IF_ERROR(input_copy_stream->CleanUpOnRunEnd());
+      }
     }
 
     // only clean the streams that is owned by current context
@@ -86,6 +91,32 @@ class DeviceStreamCollectionImpl {
     return root_stream_.get();
   }
 
+  void AddInputCopyStream(std::unique_ptr<Stream> stream) {
+    input_copy_streams_.emplace_back(std::move(stream));
+  }
+
+  Stream* GetInputCopyStream(const OrtDevice& device) const {
+    for (auto& stream : input_copy_streams_) {
+      if (stream->GetDevice() == device) {
+        return stream.get();
+      }
+    }
+    return nullptr;
+  }
+
+  void SetInputCopyNotification(int ort_value_idx, std::unique_ptr<synchronize::Notification> notification) {
+    input_copy_notifications_[ort_value_idx] = std::move(notification);
+  }
+
+  synchronize::Notification* GetInputCopyNotification(int ort_value_idx) const {
+    auto it = input_copy_notifications_.find(ort_value_idx);
+    return it != input_copy_notifications_.end() ? it->second.get() : nullptr;
+  }
+
+  bool HasInputCopyNotifications() const {
+    return !input_copy_notifications_.empty();
+  }
+
  private:
   size_t num_streams_;
   std::vector<Stream*> device_streams_;
@@ -96,6 +127,10 @@ class DeviceStreamCollectionImpl {
   // labelled this stream in the current thread, instead of the default stream which will be used in all the threads (thus caused thread safe issue)
   std::unique_ptr<Stream> root_stream_;
   OrtDevice root_stream_device_;
+  InlinedVector<std::unique_ptr<Stream>> input_copy_streams_;
+  // the notifications of the graph inputs copied on the input copy streams in the current iteration,
+  // set before the nodes run and only read while they run
+  InlinedHashMap<int, std::unique_ptr<synchronize::Notification>> input_copy_notifications_;
   void ReleaseSingleStreamBuffers();
 };
 
@@ -128,6 +163,27 @@ Stream* DeviceStreamCollection::GetRootStream() const {
   return impl_->GetRootStream();
 }
 
+void DeviceStreamCollection::AddInputCopyStream(std::unique_ptr<Stream> stream) {
+  impl_->AddInputCopyStream(std::move(stream));
+}
+
+Stream* DeviceStreamCollection::GetInputCopyStream(const OrtDevice& device) const {
+  return impl_->GetInputCopyStream(device);
+}
+
+void DeviceStreamCollection::SetInputCopyNotification(int ort_value_idx,
+                                                       std::unique_ptr<synchronize::Notification> notification) {
+  impl_->SetInputCopyNotification(ort_value_idx, std::move(notification));
+}
+
+synchronize::Notification* DeviceStreamCollection::GetInputCopyNotification(int ort_value_idx) const {
+  return impl_->GetInputCopyNotification(ort_value_idx);
+}
+
+bool DeviceStreamCollection::HasInputCopyNotifications() const {
+  return impl_->HasInputCopyNotifications();
+}
+
 DeviceStreamCollectionHolder::DeviceStreamCollectionHolder(const SessionState* session_state)
     : session_state_(session_state),
       p_(session_state->AcquireDeviceStreamCollection()) {
@@ -42,6 +42,23 @@ class DeviceStreamCollection {
 
   Stream* GetRootStream() const;
 
+  // Add a device stream instance, owned by the collection, that copies the graph inputs to its device concurrently
+  // with the nodes running on the streams of the execution plan.
+  void AddInputCopyStream(std::unique_ptr<Stream> stream);
+
+  // get the input copy stream of the given device, or nullptr if there is none.
+  Stream* GetInputCopyStream(const OrtDevice& device) const;
+
+  // Set the notification activated once the copy of the graph input with the given OrtValue index is done on an
+  // input copy stream. The nodes using the input wait on it. The notifications are released by CleanUp.
+  void SetInputCopyNotification(int ort_value_idx, std::unique_ptr<synchronize::Notification> notification);
+
+  // get the notification of the copy of the graph input with the given OrtValue index, or nullptr if it isn't
+  // copied on an input copy stream in the current iteration.
+  synchronize::Notification* GetInputCopyNotification(int ort_value_idx) const;
+
+  bool HasInputCopyNotifications() const;
+
  private:
   std::unique_ptr<DeviceStreamCollectionImpl> impl_;
 };
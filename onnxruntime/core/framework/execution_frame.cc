@@ -3,6 +3,7 @@
 
 #include "core/framework/execution_frame.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
@@ -191,6 +192,43 @@ Status IExecutionFrame::GetOrCreateNodeOutputMLValue(const int output_index, int
   return status;
 }
 
+Status IExecutionFrame::GetOrCreateNodeOutputView(int output_arg_index, const Tensor& input, const TensorShape& shape,
+                                                  ptrdiff_t byte_offset, OrtValue*& p_ort_value) {
+  p_ort_value = nullptr;
+
+  int ort_value_idx = GetNodeIdxToMLValueIdx(output_arg_index);
+  if (ort_value_idx == NodeIndexInfo::kInvalidEntry) {
+    return Status::OK();
+  }
+
+  const OrtValue* buffer = GetViewableBuffer(ort_value_idx);
+  if (buffer == nullptr || !buffer->IsTensor()) {
+    return Status::OK();
+  }
+
+  const size_t view_size = Tensor::CalculateTensorStorageSize(input.DataType(), shape);
+  ORT_RETURN_IF_NOT(byte_offset >= 0 && static_cast<size_t>(byte_offset) + view_size <= input.SizeInBytes(),
+                    "The output view of ", view_size, " bytes at offset ", byte_offset,
+                    " is outside of the input of ", input.SizeInBytes(), " bytes.");
+
+  // the view must be inside the buffer the planner kept alive for it
+  const Tensor& buffer_tensor = buffer->Get<Tensor>();
+  const auto* buffer_begin = static_cast<const char*>(buffer_tensor.DataRaw());
+  const auto* input_begin = static_cast<const char*>(input.DataRaw());
+  if (input.Location().device != buffer_tensor.Location().device || input_begin < buffer_begin ||
+      input_begin + input.SizeInBytes() > buffer_begin + buffer_tensor.SizeInBytes()) {
+    return Status::OK();
+  }
+
+  OrtValue& ort_value = all_values_[ort_value_idx];
+  ORT_RETURN_IF(ort_value.IsAllocated(), "The output to make a view was already created.");
+
+  Tensor::InitOrtValue(input.DataType(), shape, const_cast<void*>(input.DataRaw()), input.Location(), ort_value,
+                       byte_offset);
+  p_ort_value = &ort_value;
+  return Status::OK();
+}
+
 bool IExecutionFrame::TryGetInferredShape(int /*index*/, TensorShape& /*shape*/) const {
   // By default, there is no information about inferred shape, so this default
   // implementation always returns false. The derived class of IExecutionFrame
@@ -400,11 +438,15 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
       // if no existing patterns, generate one in this execution frame
       if (!mem_patterns_) {
-        planner_.emplace(*session_state.GetExecutionPlan());
+        planner_.emplace(*session_state.GetExecutionPlan(), /*trace_using_counters*/ false,
+                         session_state.GetMemoryPatternPlannerAlgorithm());
+        // with shape bucketing the patterns are shared by different input shapes so the tensor shapes would differ
+        record_placements_ = !session_state.GetMemoryPatternShapeBucketing();
       } else {
         // pre-allocate the big chunk requested in memory pattern.
         // all the internal kernel's input/output tensors will be allocated on these buffer.
         buffers_.reserve(mem_patterns_->locations.size());
+        pattern_buffers_.assign(mem_patterns_->locations.size(), nullptr);
         for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
           const auto& location = mem_patterns_->locations[i];
           ORT_ENFORCE(buffers_.find(location) == buffers_.end());
@@ -439,6 +481,8 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
                 for (size_t j = 0; j < device_streams_->NumStreams(); j++) {
                   stream_aware_alloc->SecureTheChunk(mem_pattern_stream, device_streams_->GetStream(j), nullptr);
                 }
+              } else if (alloc->IsStreamOrdered() && device_streams_ && device_streams_->GetRootStream()) {
+                buffer = alloc->AllocOnStream(peak_size, device_streams_->GetRootStream());
               } else {
                 buffer = alloc->Alloc(peak_size);
               }
@@ -461,6 +505,7 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
             if (buffer != nullptr) {
               buffers_[location] = BufferUniquePtr(buffer, BufferDeleter(alloc));
+              pattern_buffers_[i] = buffer;
             }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
             // Record activation memory pattern
@@ -520,6 +565,20 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     return Status(ONNXRUNTIME, FAIL, "Trying to allocate memory for unused optional inputs/outputs");
   }
 
+  // fast path for repeated input shapes. a tensor with the same shape as in the run that generated the memory
+  // patterns goes in the block recorded for it.
+  if (!pattern_buffers_.empty()) {
+    const auto* recorded = mem_patterns_->GetRecordedPlacement(ort_value_index);
+    if (recorded != nullptr && recorded->shape == shape) {
+      void* buffer = pattern_buffers_[recorded->location_index];
+      if (buffer != nullptr) {
+        return AllocateTensorWithPreAllocateBufferHelper(
+            ort_value, static_cast<void*>(static_cast<char*>(buffer) + recorded->block.offset_), element_type,
+            location, shape);
+      }
+    }
+  }
+
   size_t size;
   int64_t len = shape.Size();
   if (len < 0) {
@@ -548,8 +607,11 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // with shape bucketing the pattern may have been generated for a larger shape in the same bucket,
+          // so any block that is large enough can be used.
+          if (block->size_ == size ||
+              (block->size_ > size && session_state_.GetMemoryPatternShapeBucketing())) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
@@ -586,6 +648,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
       void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
       Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
+    } else if (alloc->IsStreamOrdered()) {
+      size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
+      void* p_data = alloc->AllocOnStream(buffer_size, current_stream);
+      Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
     }
@@ -601,6 +667,9 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   // placement new, we don't support it in memory pattern optimization.
   if (!utils::IsDataTypeString(element_type)) {
     TraceAllocate(ort_value_index, size);
+    if (record_placements_) {
+      traced_shapes_.insert_or_assign(ort_value_index, shape);
+    }
   }
 
   {
@@ -631,11 +700,12 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
   ORT_ENFORCE(!is_strided_tensor);
 #endif  // ENABLE_STRIDED_TENSORS
   if (!is_strided_tensor) {
-    auto buffer_num_elements = reuse_tensor->Shape().Size();
-    auto required_num_elements = shape.Size();
+    // compare the sizes in bytes as the planner may reuse the buffer of a tensor with a different element type
+    auto buffer_size = reuse_tensor->SizeInBytes();
+    auto required_size = Tensor::CalculateTensorStorageSize(element_type, shape);
 
-    // check number of elements matches. shape may not be an exact match (e.g. Reshape op)
-    if (buffer_num_elements != required_num_elements) {
+    // check size matches. shape may not be an exact match (e.g. Reshape op)
+    if (buffer_size != required_size) {
       // could be an allocation planner bug (less likely) or the model incorrectly uses something like 'None'
       // as a dim_param, or -1 in dim_value in multiple places making the planner think those shapes are equal.
       auto message = onnxruntime::MakeString(
@@ -643,12 +713,15 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
           ". Validate usage of dim_value (values should be > 0) and "
           "dim_param (all values with the same string should equate to the same size) in shapes in the model.");
 
-      // be generous and use the buffer if it's large enough. log a warning though as it indicates a bad model
-      if (buffer_num_elements >= required_num_elements) {
+      // be generous and use the buffer if it's large enough. log a warning though as it indicates a bad model,
+      // unless the planner was allowed to reuse larger buffers.
+      if (buffer_size >= required_size) {
         // View Operator is reusing the buffer bigger than the required size.
         // Disabling warning message for now. The op is in the process of being deprecated.
 #ifndef ENABLE_TRAINING
-        LOGS(session_state_.Logger(), WARNING) << message;
+        if (!session_state_.GetEnableLargerBufferReuse()) {
+          LOGS(session_state_.Logger(), WARNING) << message;
+        }
 #endif  // ENABLE_TRAINING
       } else {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, message);
@@ -758,6 +831,13 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
         break;
       }
       case AllocKind::kReuse: {
+        if (per_alloc_plan.is_view) {
+          // the kernel didn't make the output a view of its input, so it needs a buffer of its own
+          ORT_RETURN_IF_ERROR(AllocateMLValueTensorSelfOwnBuffer(ort_value, ort_value_index, ml_data_type, alloc_info,
+                                                                 *shape));
+          break;
+        }
+
         int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
 
         ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, shape));
@@ -827,6 +907,18 @@ AllocatorPtr ExecutionFrame::GetAllocatorImpl(const OrtDevice& info) const {
   return session_state_.GetAllocator(info);
 }
 
+const OrtValue* ExecutionFrame::GetViewableBuffer(int ort_value_idx) const {
+  const auto& alloc_plan = session_state_.GetPerValueAllocPlan();
+  ORT_ENFORCE(ort_value_idx >= 0 && static_cast<size_t>(ort_value_idx) < alloc_plan.size());
+  const auto& per_alloc_plan = alloc_plan[ort_value_idx];
+  if (per_alloc_plan.alloc_kind != AllocKind::kReuse || !per_alloc_plan.is_view) {
+    return nullptr;
+  }
+
+  const OrtValue& buffer = GetMLValue(per_alloc_plan.reused_buffer);
+  return buffer.IsAllocated() ? &buffer : nullptr;
+}
+
 // This method is not thread safe!
 // Return S_OK and nullptr if index map to a value that is an unused optional input/output
 Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) {
@@ -920,7 +1012,39 @@ Status ExecutionFrame::GeneratePatterns(MemoryPatternGroup& out) {
     return Status(ONNXRUNTIME, FAIL, "Memory pattern planner is not enabled on this execution framework.");
   }
 
-  return planner_->GeneratePatterns(out);
+  ORT_RETURN_IF_ERROR(planner_->GeneratePatterns(out));
+  if (record_placements_) {
+    RecordTensorPlacements(out);
+  }
+
+  return Status::OK();
+}
+
+void ExecutionFrame::RecordTensorPlacements(MemoryPatternGroup& patterns) {
+  patterns.recorded_placements.clear();
+
+  int max_ort_value_idx = -1;
+  for (const auto& entry : traced_shapes_) {
+    max_ort_value_idx = std::max(max_ort_value_idx, entry.first);
+  }
+
+  if (max_ort_value_idx < 0) {
+    return;
+  }
+
+  patterns.recorded_placements.resize(static_cast<size_t>(max_ort_value_idx) + 1);
+  for (const auto& [ort_value_idx, shape] : traced_shapes_) {
+    const auto& location = GetAllocationPlan(ort_value_idx).location;
+    for (size_t i = 0; i < patterns.locations.size(); ++i) {
+      if (patterns.locations[i] == location) {
+        const auto* block = patterns.patterns[i].GetBlock(ort_value_idx);
+        if (block != nullptr) {
+          patterns.recorded_placements[ort_value_idx] = RecordedTensorPlacement{shape, i, *block};
+        }
+        break;
+      }
+    }
+  }
 }
 
 bool ExecutionFrame::TryGetInferredShape(int index, TensorShape& shape) const {
@@ -76,6 +76,13 @@ class IExecutionFrame {
   Status GetOrCreateNodeOutputMLValue(const int index, int output_arg_index, const TensorShape* shape,
                                       OrtValue*& p_ort_value, const Node& node);
 
+  // This method is not thread safe!
+  // Make the output a tensor of the given shape that views the data of 'input', starting byte_offset bytes into it.
+  // Return S_OK and nullptr if the allocation plan doesn't let the output share the buffer of 'input'. The output
+  // is then created with GetOrCreateNodeOutputMLValue.
+  Status GetOrCreateNodeOutputView(int output_arg_index, const Tensor& input, const TensorShape& shape,
+                                   ptrdiff_t byte_offset, OrtValue*& p_ort_value);
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrieval is successful, this function returns true and false otherwise.
   virtual bool TryGetInferredShape(int index, TensorShape& shape) const;
@@ -94,6 +101,11 @@ class IExecutionFrame {
   // get the ort_value_idx from NodeIndexInfo
   int GetNodeIdxToMLValueIdx(int index) const;
 
+  const OrtValue& GetMLValue(int ort_value_index) const {
+    ORT_ENFORCE(ort_value_index >= 0 && static_cast<size_t>(ort_value_index) < all_values_size_);
+    return all_values_[ort_value_index];
+  }
+
   OrtValue& GetMutableMLValue(int ort_value_index) { return const_cast<OrtValue&>(GetMLValue(ort_value_index)); }
 
   virtual Status ReleaseMLValueImpl(int ort_value_idx);
@@ -104,17 +116,15 @@ class IExecutionFrame {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IExecutionFrame);
 
-  const OrtValue& GetMLValue(int ort_value_index) const {
-    ORT_ENFORCE(ort_value_index >= 0 && static_cast<size_t>(ort_value_index) < all_values_size_);
-    return all_values_[ort_value_index];
-  }
-
   // optional function that can check if the requested output_shape matched what was specified/inferred
   // for the node.
   virtual void VerifyOutputSizes(int /*output_index*/, const Node& /*node*/, const TensorShape& /*output_shape*/) {}
 
   virtual AllocatorPtr GetAllocatorImpl(const OrtDevice& info) const = 0;
 
+  // optional function that returns the buffer an output may be a view of. nullptr if the output can't be a view.
+  virtual const OrtValue* GetViewableBuffer(int /*ort_value_idx*/) const { return nullptr; }
+
   virtual Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) = 0;
 
   virtual Status CopyTensor(const Tensor& src, Tensor& dest) const = 0;
@@ -194,6 +204,7 @@ class ExecutionFrame final : public IExecutionFrame {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExecutionFrame);
 
   AllocatorPtr GetAllocatorImpl(const OrtDevice& info) const override;
+  const OrtValue* GetViewableBuffer(int ort_value_idx) const override;
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape) override;
   void VerifyOutputSizes(int output_index, const Node& node, const TensorShape& output_shape) override;
@@ -213,6 +224,9 @@ class ExecutionFrame final : public IExecutionFrame {
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
+  // fill MemoryPatternGroup::recorded_placements from the shapes traced in this execution
+  void RecordTensorPlacements(MemoryPatternGroup& patterns);
+
   const AllocPlanPerValue& GetAllocationPlan(int ort_value_idx);
 
   Stream* GetValueStream(int ort_value_idx) const;
@@ -229,7 +243,7 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -238,6 +252,15 @@ class ExecutionFrame final : public IExecutionFrame {
   // Big chunks on different locations that will be used by mem_pattern.
   InlinedHashMap<OrtDevice, BufferUniquePtr> buffers_;
 
+  // The big chunks by index in mem_patterns_->locations, or nullptr if the chunk could not be allocated.
+  // Used to place tensors with a recorded placement.
+  InlinedVector<void*> pattern_buffers_;
+
+  // Whether the tensor shapes are traced along with the allocations so the generated memory patterns can record
+  // the placement of each tensor. Only done if the patterns are specific to the exact input shapes.
+  bool record_placements_{false};
+  InlinedHashMap<int, TensorShape> traced_shapes_;
+
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
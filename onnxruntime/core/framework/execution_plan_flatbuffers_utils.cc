@@ -0,0 +1,597 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/execution_plan_flatbuffers_utils.h"
+
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+#include "core/common/narrow.h"
+#include "core/flatbuffers/flatbuffers_utils.h"
+#include "core/flatbuffers/schema/ort.fbs.h"
+#include "core/framework/allocation_planner.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/execution_steps.h"
+#include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
+#include "onnxruntime_config.h"
+
+namespace onnxruntime::execution_plan_utils {
+
+namespace {
+
+// the plan in training, strided tensor and memory profiling builds carries state we don't serialize
+#if defined(ENABLE_TRAINING) || defined(ENABLE_STRIDED_TENSORS) || defined(ORT_MEMORY_PROFILE)
+constexpr bool kIsSerializationSupported = false;
+#else
+constexpr bool kIsSerializationSupported = true;
+#endif
+
+// Step parameters. Every step has two.
+//   kBarrier:              barrier id, unused
+//   kWaitOnEP:             notification index, device type of the waiting side
+//   kLaunchKernel:         unused, unused
+//   kActivateNotification: notification index, unused
+//   kTriggerDownstream:    trigger point index, unused
+constexpr size_t kNumStepParams = 2;
+
+class ConfigHasher {
+ public:
+  void Add(const void* data, size_t len) {
+    MurmurHash3::x86_128(data, narrow<int>(len), hash_[0], &hash_);
+  }
+
+  template <typename T>
+  void AddValue(T value) {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+    Add(&value, sizeof(value));
+  }
+
+  void AddString(std::string_view str) {
+    AddValue(str.size());
+    Add(str.data(), str.size());
+  }
+
+  uint64_t Get() const { return (static_cast<uint64_t>(hash_[1]) << 32) | hash_[0]; }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+void AddDevice(ConfigHasher& hasher, const OrtDevice& device) {
+  hasher.AddValue(device.Type());
+  hasher.AddValue(device.MemType());
+  hasher.AddValue(device.Id());
+}
+
+uint32_t PackDevice(const OrtDevice& device) {
+  return static_cast<uint32_t>(static_cast<uint8_t>(device.Type())) |
+         (static_cast<uint32_t>(static_cast<uint8_t>(device.MemType())) << 8) |
+         (static_cast<uint32_t>(static_cast<uint16_t>(device.Id())) << 16);
+}
+
+OrtDevice UnpackDevice(uint32_t packed) {
+  return OrtDevice(static_cast<OrtDevice::DeviceType>(packed & 0xFF),
+                   static_cast<OrtDevice::MemoryType>((packed >> 8) & 0xFF),
+                   static_cast<OrtDevice::DeviceId>(packed >> 16));
+}
+
+// checks that `offsets` describes `num_groups` consecutive groups covering exactly `num_elements` elements
+bool IsValidOffsets(const flatbuffers::Vector<uint32_t>& offsets, size_t num_groups, size_t num_elements) {
+  if (offsets.size() != num_groups + 1 || offsets.Get(0) != 0 || offsets.Get(offsets.size() - 1) != num_elements) {
+    return false;
+  }
+
+  for (flatbuffers::uoffset_t i = 1; i < offsets.size(); ++i) {
+    if (offsets.Get(i) < offsets.Get(i - 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Status LoadFromOrtFormatImpl(const fbs::ExecutionPlan& fbs_plan, const GraphViewer& graph_viewer,
+                             const OrtValueNameIdxMap& ort_value_name_idx_map,
+                             const IStreamCommandHandleRegistry* stream_handle_registry,
+                             SequentialExecutionPlan& plan) {
+  const auto* alloc_kinds = fbs_plan.alloc_kinds();
+  const auto* reused_buffers = fbs_plan.reused_buffers();
+  const auto* locations = fbs_plan.locations();
+  const auto* program_counter_offsets = fbs_plan.program_counter_offsets();
+  const auto* program_counter_starts = fbs_plan.program_counter_starts();
+  const auto* program_counter_ends = fbs_plan.program_counter_ends();
+  const auto* initializer_allocation_order = fbs_plan.initializer_allocation_order();
+  const auto* activation_allocation_order = fbs_plan.activation_allocation_order();
+  const auto* stream_locations = fbs_plan.stream_locations();
+  const auto* stream_step_offsets = fbs_plan.stream_step_offsets();
+  const auto* step_types = fbs_plan.step_types();
+  const auto* step_node_indices = fbs_plan.step_node_indices();
+  const auto* step_params = fbs_plan.step_params();
+  const auto* value_to_stream_keys = fbs_plan.value_to_stream_keys();
+  const auto* value_to_stream_values = fbs_plan.value_to_stream_values();
+  const auto* release_action_values = fbs_plan.release_action_values();
+  const auto* release_action_ref_counts = fbs_plan.release_action_ref_counts();
+  const auto* node_release_offsets = fbs_plan.node_release_offsets();
+  const auto* node_release_actions = fbs_plan.node_release_actions();
+  const auto* notification_owners = fbs_plan.notification_owners();
+  const auto* downstream_keys = fbs_plan.downstream_keys();
+  const auto* downstream_offsets = fbs_plan.downstream_offsets();
+  const auto* downstream_stream_indices = fbs_plan.downstream_stream_indices();
+  const auto* downstream_step_indices = fbs_plan.downstream_step_indices();
+  // optional, plans saved before views were added have none
+  const auto* view_values = fbs_plan.view_values();
+
+  ORT_FORMAT_RETURN_IF_NULL(alloc_kinds, "ExecutionPlan.alloc_kinds");
+  ORT_FORMAT_RETURN_IF_NULL(reused_buffers, "ExecutionPlan.reused_buffers");
+  ORT_FORMAT_RETURN_IF_NULL(locations, "ExecutionPlan.locations");
+  ORT_FORMAT_RETURN_IF_NULL(program_counter_offsets, "ExecutionPlan.program_counter_offsets");
+  ORT_FORMAT_RETURN_IF_NULL(program_counter_starts, "ExecutionPlan.program_counter_starts");
+  ORT_FORMAT_RETURN_IF_NULL(program_counter_ends, "ExecutionPlan.program_counter_ends");
+  ORT_FORMAT_RETURN_IF_NULL(initializer_allocation_order, "ExecutionPlan.initializer_allocation_order");
+  ORT_FORMAT_RETURN_IF_NULL(activation_allocation_order, "ExecutionPlan.activation_allocation_order");
+  ORT_FORMAT_RETURN_IF_NULL(stream_locations, "ExecutionPlan.stream_locations");
+  ORT_FORMAT_RETURN_IF_NULL(stream_step_offsets, "ExecutionPlan.stream_step_offsets");
+  ORT_FORMAT_RETURN_IF_NULL(step_types, "ExecutionPlan.step_types");
+  ORT_FORMAT_RETURN_IF_NULL(step_node_indices, "ExecutionPlan.step_node_indices");
+  ORT_FORMAT_RETURN_IF_NULL(step_params, "ExecutionPlan.step_params");
+  ORT_FORMAT_RETURN_IF_NULL(value_to_stream_keys, "ExecutionPlan.value_to_stream_keys");
+  ORT_FORMAT_RETURN_IF_NULL(value_to_stream_values, "ExecutionPlan.value_to_stream_values");
+  ORT_FORMAT_RETURN_IF_NULL(release_action_values, "ExecutionPlan.release_action_values");
+  ORT_FORMAT_RETURN_IF_NULL(release_action_ref_counts, "ExecutionPlan.release_action_ref_counts");
+  ORT_FORMAT_RETURN_IF_NULL(node_release_offsets, "ExecutionPlan.node_release_offsets");
+  ORT_FORMAT_RETURN_IF_NULL(node_release_actions, "ExecutionPlan.node_release_actions");
+  ORT_FORMAT_RETURN_IF_NULL(notification_owners, "ExecutionPlan.notification_owners");
+  ORT_FORMAT_RETURN_IF_NULL(downstream_keys, "ExecutionPlan.downstream_keys");
+  ORT_FORMAT_RETURN_IF_NULL(downstream_offsets, "ExecutionPlan.downstream_offsets");
+  ORT_FORMAT_RETURN_IF_NULL(downstream_stream_indices, "ExecutionPlan.downstream_stream_indices");
+  ORT_FORMAT_RETURN_IF_NULL(downstream_step_indices, "ExecutionPlan.downstream_step_indices");
+
+  const size_t num_values = narrow<size_t>(ort_value_name_idx_map.MaxIdx() + 1);
+  const size_t num_nodes = narrow<size_t>(graph_viewer.MaxNodeIndex()) + 1;
+
+  // allocation plan
+  ORT_RETURN_IF_NOT(alloc_kinds->size() == num_values && reused_buffers->size() == num_values &&
+                        locations->size() == num_values,
+                    "Serialized execution plan has ", alloc_kinds->size(), " values. Expected ", num_values, ".");
+  ORT_RETURN_IF_NOT(program_counter_starts->size() == program_counter_ends->size() &&
+                        IsValidOffsets(*program_counter_offsets, num_values, program_counter_starts->size()),
+                    "Serialized execution plan has invalid program counters.");
+
+  plan.allocation_plan.resize(num_values);
+  for (size_t i = 0; i < num_values; ++i) {
+    const auto idx = static_cast<flatbuffers::uoffset_t>(i);
+    auto& value_plan = plan.allocation_plan[i];
+
+    const int32_t alloc_kind = alloc_kinds->Get(idx);
+    ORT_RETURN_IF_NOT(alloc_kind >= static_cast<int32_t>(AllocKind::kNotSet) &&
+                          alloc_kind <= static_cast<int32_t>(AllocKind::kAllocatedExternally),
+                      "Serialized execution plan has invalid allocation kind ", alloc_kind);
+    value_plan.alloc_kind = static_cast<AllocKind>(alloc_kind);
+
+    const int32_t reused_buffer = reused_buffers->Get(idx);
+    ORT_RETURN_IF_NOT(reused_buffer >= 0 && static_cast<size_t>(reused_buffer) < num_values,
+                      "Serialized execution plan has invalid reused buffer ", reused_buffer);
+    value_plan.reused_buffer = reused_buffer;
+    value_plan.location = UnpackDevice(locations->Get(idx));
+
+    // the planner sets the type for all values with a NodeArg. the executor looks it up for allocations.
+    std::string name;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetName(static_cast<int>(i), name));
+    if (const auto* node_arg = graph_viewer.GetNodeArg(name); node_arg != nullptr && node_arg->TypeAsProto()) {
+      value_plan.value_type = utils::GetMLDataType(*node_arg);
+    }
+
+    size_t previous_end = 0;
+    for (auto pc = program_counter_offsets->Get(idx), end = program_counter_offsets->Get(idx + 1); pc < end; ++pc) {
+      const size_t start = program_counter_starts->Get(pc);
+      const size_t stop = program_counter_ends->Get(pc);
+      ORT_RETURN_IF_NOT(stop >= start && (pc == program_counter_offsets->Get(idx) || start > previous_end),
+                        "Serialized execution plan has invalid program counters.");
+      value_plan.program_counter.AddStart(start);
+      value_plan.program_counter.AddEnd(stop);
+      previous_end = stop;
+    }
+  }
+
+  if (view_values != nullptr) {
+    for (const int32_t value : *view_values) {
+      ORT_RETURN_IF_NOT(value >= 0 && static_cast<size_t>(value) < num_values &&
+                            plan.allocation_plan[value].alloc_kind == AllocKind::kReuse,
+                        "Serialized execution plan has an invalid view value ", value);
+      plan.allocation_plan[value].is_view = true;
+    }
+  }
+
+  const auto load_value_indices = [num_values](const flatbuffers::Vector<int32_t>& src,
+                                               std::vector<OrtValueIndex>& dst) -> Status {
+    dst.reserve(src.size());
+    for (const int32_t value_idx : src) {
+      ORT_RETURN_IF_NOT(value_idx >= 0 && static_cast<size_t>(value_idx) < num_values,
+                        "Serialized execution plan has invalid OrtValue index ", value_idx);
+      dst.push_back(value_idx);
+    }
+
+    return Status::OK();
+  };
+
+  ORT_RETURN_IF_ERROR(load_value_indices(*initializer_allocation_order, plan.initializer_allocation_order));
+  ORT_RETURN_IF_ERROR(load_value_indices(*activation_allocation_order, plan.activation_allocation_order));
+
+  // release plan and notifications. loaded before the steps that refer to them.
+  ORT_RETURN_IF_NOT(release_action_values->size() == release_action_ref_counts->size(),
+                    "Serialized execution plan has mismatched release actions.");
+  plan.release_actions.reserve(release_action_values->size());
+  for (flatbuffers::uoffset_t i = 0; i < release_action_values->size(); ++i) {
+    const size_t value_idx = release_action_values->Get(i);
+    ORT_RETURN_IF_NOT(value_idx < num_values, "Serialized execution plan has invalid release action.");
+    plan.release_actions.push_back({value_idx, release_action_ref_counts->Get(i)});
+  }
+
+  ORT_RETURN_IF_NOT(IsValidOffsets(*node_release_offsets, num_nodes, node_release_actions->size()),
+                    "Serialized execution plan has an invalid node release list.");
+  plan.node_release_list.resize(num_nodes);
+  for (size_t i = 0; i < plan.node_release_list.size(); ++i) {
+    const auto idx = static_cast<flatbuffers::uoffset_t>(i);
+    auto& release_list = plan.node_release_list[i];
+    for (auto j = node_release_offsets->Get(idx), end = node_release_offsets->Get(idx + 1); j < end; ++j) {
+      const size_t action_idx = node_release_actions->Get(j);
+      ORT_RETURN_IF_NOT(action_idx < plan.release_actions.size(),
+                        "Serialized execution plan has an invalid node release list.");
+      release_list.push_back(action_idx);
+    }
+  }
+
+  const size_t num_streams = stream_locations->size();
+  plan.notification_owners.reserve(notification_owners->size());
+  for (const uint32_t owner : *notification_owners) {
+    ORT_RETURN_IF_NOT(owner < num_streams, "Serialized execution plan has an invalid notification owner.");
+    plan.notification_owners.push_back(owner);
+  }
+
+  plan.num_barriers = fbs_plan.num_barriers();
+
+  // logic streams
+  const size_t num_steps = step_types->size();
+  ORT_RETURN_IF_NOT(step_node_indices->size() == num_steps && step_params->size() == num_steps * kNumStepParams &&
+                        IsValidOffsets(*stream_step_offsets, num_streams, num_steps),
+                    "Serialized execution plan has invalid steps.");
+
+  plan.execution_plan.reserve(num_streams);
+  for (size_t i = 0; i < num_streams; ++i) {
+    const auto stream_idx = static_cast<flatbuffers::uoffset_t>(i);
+    auto& stream = *plan.execution_plan.emplace_back(
+        std::make_unique<SequentialExecutionPlan::LogicStream>(UnpackDevice(stream_locations->Get(stream_idx))));
+
+    for (auto step_idx = stream_step_offsets->Get(stream_idx), end = stream_step_offsets->Get(stream_idx + 1);
+         step_idx < end; ++step_idx) {
+      const NodeIndex node_index = step_node_indices->Get(step_idx);
+      ORT_RETURN_IF_NOT(graph_viewer.GetNode(node_index) != nullptr,
+                        "Serialized execution plan refers to missing node ", node_index);
+
+      const size_t param0 = step_params->Get(step_idx * kNumStepParams);
+      const size_t param1 = step_params->Get(step_idx * kNumStepParams + 1);
+
+      using StepType = SequentialExecutionPlan::ExecutionStep::Type;
+      switch (static_cast<StepType>(step_types->Get(step_idx))) {
+        case StepType::kBarrier:
+          ORT_RETURN_IF_NOT(param0 < plan.num_barriers, "Serialized execution plan has an invalid barrier.");
+          stream.steps_.emplace_back(std::make_unique<BarrierStep>(param0, node_index));
+          break;
+        case StepType::kWaitOnEP: {
+          ORT_RETURN_IF_NOT(param0 < plan.notification_owners.size(),
+                            "Serialized execution plan has an invalid notification.");
+          ORT_RETURN_IF(stream_handle_registry == nullptr,
+                        "Serialized execution plan requires stream support, which is not enabled in this build.");
+          // the owner's stream may come after this one so use the serialized location
+          const auto owner_stream_idx = static_cast<flatbuffers::uoffset_t>(plan.notification_owners[param0]);
+          const auto owner_device_type = UnpackDevice(stream_locations->Get(owner_stream_idx)).Type();
+          const auto waiting_device_type = static_cast<OrtDevice::DeviceType>(param1);
+          WaitNotificationFn wait_handle = stream_handle_registry->GetWaitHandle(owner_device_type,
+                                                                                 waiting_device_type);
+          ORT_RETURN_IF(wait_handle == nullptr, "No wait handle is registered for notifications from device type ",
+                        static_cast<int>(owner_device_type), " on device type ",
+                        static_cast<int>(waiting_device_type), ".");
+          stream.steps_.emplace_back(std::make_unique<WaitOnEPStep>(wait_handle, param0, node_index,
+                                                                    waiting_device_type));
+          break;
+        }
+        case StepType::kLaunchKernel:
+          stream.steps_.emplace_back(std::make_unique<LaunchKernelStep>(node_index));
+          break;
+        case StepType::kActivateNotification:
+          ORT_RETURN_IF_NOT(param0 < plan.notification_owners.size(),
+                            "Serialized execution plan has an invalid notification.");
+          stream.steps_.emplace_back(std::make_unique<ActivateNotificationStep>(param0, node_index));
+          break;
+        case StepType::kTriggerDownstream:
+          stream.steps_.emplace_back(std::make_unique<TriggerDownstreamStep>(param0, node_index));
+          break;
+        default:
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Serialized execution plan has invalid step type ",
+                                 static_cast<int>(step_types->Get(step_idx)));
+      }
+    }
+  }
+
+  ORT_RETURN_IF_NOT(value_to_stream_keys->size() == value_to_stream_values->size(),
+                    "Serialized execution plan has a mismatched value to stream map.");
+  plan.value_to_stream_map.reserve(value_to_stream_keys->size());
+  for (flatbuffers::uoffset_t i = 0; i < value_to_stream_keys->size(); ++i) {
+    const size_t value_idx = value_to_stream_keys->Get(i);
+    const size_t stream_idx = value_to_stream_values->Get(i);
+    ORT_RETURN_IF_NOT(value_idx < num_values && stream_idx < num_streams,
+                      "Serialized execution plan has an invalid value to stream map.");
+    plan.value_to_stream_map[value_idx] = stream_idx;
+  }
+
+  ORT_RETURN_IF_NOT(downstream_stream_indices->size() == downstream_step_indices->size() &&
+                        IsValidOffsets(*downstream_offsets, downstream_keys->size(),
+                                       downstream_stream_indices->size()),
+                    "Serialized execution plan has an invalid downstream map.");
+  plan.downstream_map.reserve(downstream_keys->size());
+  for (flatbuffers::uoffset_t i = 0; i < downstream_keys->size(); ++i) {
+    auto& downstream_steps = plan.downstream_map[downstream_keys->Get(i)];
+    for (auto j = downstream_offsets->Get(i), end = downstream_offsets->Get(i + 1); j < end; ++j) {
+      const size_t stream_idx = downstream_stream_indices->Get(j);
+      const size_t step_idx = downstream_step_indices->Get(j);
+      ORT_RETURN_IF_NOT(stream_idx < num_streams && step_idx < plan.execution_plan[stream_idx]->steps_.size(),
+                        "Serialized execution plan has an invalid downstream map.");
+      downstream_steps.push_back({stream_idx, step_idx});
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+uint64_t ComputeConfigHash(const GraphViewer& graph_viewer,
+                           const OrtValueNameIdxMap& ort_value_name_idx_map,
+                           const ExecutionProviders& execution_providers,
+                           const ISequentialPlannerContext& context,
+                           const PathString& partition_config_file) {
+  ConfigHasher hasher;
+  hasher.AddString(ORT_VERSION);
+
+  hasher.AddValue(context.IsParallelExecutionEnabled());
+  hasher.AddValue(context.GetExecutionOrder());
+  hasher.AddValue(context.GetEnableMemoryReuse());
+  hasher.AddValue(context.GetMaxCpuStreams());
+  hasher.AddValue(context.GetEnableLargerBufferReuse());
+  hasher.AddValue(context.GetMemoryBudget());
+  hasher.Add(partition_config_file.data(), partition_config_file.size() * sizeof(PathChar));
+
+  for (const auto& ep : execution_providers) {
+    hasher.AddString(ep->Type());
+    AddDevice(hasher, ep->GetOrtDeviceByMemType(OrtMemTypeDefault));
+  }
+
+  const auto add_defs = [&hasher](const ConstPointerContainer<std::vector<NodeArg*>>& defs) {
+    hasher.AddValue(defs.size());
+    for (const auto* def : defs) {
+      hasher.AddString(def->Name());
+    }
+  };
+
+  for (const auto node_index : graph_viewer.GetNodesInTopologicalOrder(context.GetExecutionOrder())) {
+    const auto& node = *graph_viewer.GetNode(node_index);
+    hasher.AddValue(node.Index());
+    hasher.AddString(node.Domain());
+    hasher.AddString(node.OpType());
+    hasher.AddValue(node.SinceVersion());
+    hasher.AddString(node.GetExecutionProviderType());
+    add_defs(node.InputDefs());
+    add_defs(node.ImplicitInputDefs());
+    add_defs(node.OutputDefs());
+  }
+
+  // the value indices and the shapes used for the reuse decisions
+  for (int idx = 0, max_idx = ort_value_name_idx_map.MaxIdx(); idx <= max_idx; ++idx) {
+    std::string name;
+    if (!ort_value_name_idx_map.GetName(idx, name).IsOK()) {
+      continue;
+    }
+
+    hasher.AddString(name);
+    const auto* node_arg = graph_viewer.GetNodeArg(name);
+    const auto* shape = node_arg != nullptr ? context.GetShape(*node_arg) : nullptr;
+    if (shape == nullptr) {
+      hasher.AddValue(-1);
+      continue;
+    }
+
+    hasher.AddValue(shape->dim_size());
+    for (const auto& dim : shape->dim()) {
+      if (utils::HasDimValue(dim)) {
+        hasher.AddValue(dim.dim_value());
+      } else {
+        hasher.AddString(utils::HasDimParam(dim) ? dim.dim_param() : std::string{});
+      }
+    }
+  }
+
+  return hasher.Get();
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder, const SequentialExecutionPlan& plan,
+                       uint64_t config_hash, flatbuffers::Offset<fbs::ExecutionPlan>& fbs_plan) {
+  if constexpr (!kIsSerializationSupported) {
+    ORT_UNUSED_PARAMETER(builder);
+    ORT_UNUSED_PARAMETER(plan);
+    ORT_UNUSED_PARAMETER(config_hash);
+    ORT_UNUSED_PARAMETER(fbs_plan);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "Saving the execution plan is not supported in this build.");
+  } else {
+    std::vector<int32_t> alloc_kinds;
+    std::vector<int32_t> reused_buffers;
+    std::vector<uint32_t> locations;
+    std::vector<uint32_t> program_counter_offsets;
+    std::vector<uint32_t> program_counter_starts;
+    std::vector<uint32_t> program_counter_ends;
+    std::vector<int32_t> view_values;
+    alloc_kinds.reserve(plan.allocation_plan.size());
+    reused_buffers.reserve(plan.allocation_plan.size());
+    locations.reserve(plan.allocation_plan.size());
+    program_counter_offsets.reserve(plan.allocation_plan.size() + 1);
+    for (const auto& value_plan : plan.allocation_plan) {
+      if (value_plan.is_view) {
+        view_values.push_back(narrow<int32_t>(alloc_kinds.size()));
+      }
+      alloc_kinds.push_back(static_cast<int32_t>(value_plan.alloc_kind));
+      reused_buffers.push_back(value_plan.reused_buffer);
+      locations.push_back(PackDevice(value_plan.location));
+      program_counter_offsets.push_back(narrow<uint32_t>(program_counter_starts.size()));
+      for (const auto start : value_plan.program_counter.Starts()) {
+        program_counter_starts.push_back(narrow<uint32_t>(start));
+      }
+      for (const auto end : value_plan.program_counter.Ends()) {
+        program_counter_ends.push_back(narrow<uint32_t>(end));
+      }
+    }
+    program_counter_offsets.push_back(narrow<uint32_t>(program_counter_starts.size()));
+
+    std::vector<uint32_t> stream_locations;
+    std::vector<uint32_t> stream_step_offsets;
+    std::vector<uint8_t> step_types;
+    std::vector<uint32_t> step_node_indices;
+    std::vector<uint32_t> step_params;
+    for (const auto& stream : plan.execution_plan) {
+      stream_locations.push_back(PackDevice(stream->device_));
+      stream_step_offsets.push_back(narrow<uint32_t>(step_types.size()));
+      for (const auto& step : stream->steps_) {
+        using StepType = SequentialExecutionPlan::ExecutionStep::Type;
+        const auto type = step->GetType();
+        size_t param0 = 0;
+        size_t param1 = 0;
+        switch (type) {
+          case StepType::kBarrier:
+            param0 = static_cast<const BarrierStep&>(*step).GetBarrierId();
+            break;
+          case StepType::kWaitOnEP: {
+            const auto& wait_step = static_cast<const WaitOnEPStep&>(*step);
+            param0 = wait_step.GetNotificationIndex();
+            param1 = static_cast<size_t>(wait_step.GetWaitingDeviceType());
+            break;
+          }
+          case StepType::kLaunchKernel:
+            break;
+          case StepType::kActivateNotification:
+            param0 = static_cast<const ActivateNotificationStep&>(*step).GetNotificationIndex();
+            break;
+          case StepType::kTriggerDownstream:
+            param0 = static_cast<const TriggerDownstreamStep&>(*step).GetTriggerPointIndex();
+            break;
+        }
+
+        step_types.push_back(static_cast<uint8_t>(type));
+        step_node_indices.push_back(narrow<uint32_t>(step->GetNodeIndex()));
+        step_params.push_back(narrow<uint32_t>(param0));
+        step_params.push_back(narrow<uint32_t>(param1));
+      }
+    }
+    stream_step_offsets.push_back(narrow<uint32_t>(step_types.size()));
+
+    // the maps are sorted so the output is deterministic
+    std::vector<std::pair<size_t, size_t>> value_to_stream(plan.value_to_stream_map.begin(),
+                                                           plan.value_to_stream_map.end());
+    std::sort(value_to_stream.begin(), value_to_stream.end());
+    std::vector<uint32_t> value_to_stream_keys;
+    std::vector<uint32_t> value_to_stream_values;
+    for (const auto& [value_idx, stream_idx] : value_to_stream) {
+      value_to_stream_keys.push_back(narrow<uint32_t>(value_idx));
+      value_to_stream_values.push_back(narrow<uint32_t>(stream_idx));
+    }
+
+    std::vector<uint32_t> release_action_values;
+    std::vector<uint32_t> release_action_ref_counts;
+    for (const auto& release_action : plan.release_actions) {
+      release_action_values.push_back(narrow<uint32_t>(release_action.value_index));
+      release_action_ref_counts.push_back(narrow<uint32_t>(release_action.ref_count));
+    }
+
+    std::vector<uint32_t> node_release_offsets;
+    std::vector<uint32_t> node_release_actions;
+    for (const auto& release_list : plan.node_release_list) {
+      node_release_offsets.push_back(narrow<uint32_t>(node_release_actions.size()));
+      for (const auto action_idx : release_list) {
+        node_release_actions.push_back(narrow<uint32_t>(action_idx));
+      }
+    }
+    node_release_offsets.push_back(narrow<uint32_t>(node_release_actions.size()));
+
+    std::vector<uint32_t> notification_owners;
+    for (const auto owner : plan.notification_owners) {
+      notification_owners.push_back(narrow<uint32_t>(owner));
+    }
+
+    std::vector<NotificationIndex> downstream_notifications;
+    for (const auto& entry : plan.downstream_map) {
+      downstream_notifications.push_back(entry.first);
+    }
+    std::sort(downstream_notifications.begin(), downstream_notifications.end());
+    std::vector<uint32_t> downstream_keys;
+    std::vector<uint32_t> downstream_offsets;
+    std::vector<uint32_t> downstream_stream_indices;
+    std::vector<uint32_t> downstream_step_indices;
+    for (const auto notification : downstream_notifications) {
+      downstream_keys.push_back(narrow<uint32_t>(notification));
+      downstream_offsets.push_back(narrow<uint32_t>(downstream_stream_indices.size()));
+      for (const auto& [stream_idx, step_idx] : plan.downstream_map.at(notification)) {
+        downstream_stream_indices.push_back(narrow<uint32_t>(stream_idx));
+        downstream_step_indices.push_back(narrow<uint32_t>(step_idx));
+      }
+    }
+    downstream_offsets.push_back(narrow<uint32_t>(downstream_stream_indices.size()));
+
+    fbs_plan = fbs::CreateExecutionPlanDirect(builder, config_hash,
+                                              &alloc_kinds, &reused_buffers, &locations,
+                                              &program_counter_offsets, &program_counter_starts,
+                                              &program_counter_ends,
+                                              &plan.initializer_allocation_order,
+                                              &plan.activation_allocation_order,
+                                              &stream_locations, &stream_step_offsets, &step_types,
+                                              &step_node_indices, &step_params,
+                                              &value_to_stream_keys, &value_to_stream_values,
+                                              &release_action_values, &release_action_ref_counts,
+                                              &node_release_offsets, &node_release_actions,
+                                              &notification_owners,
+                                              &downstream_keys, &downstream_offsets,
+                                              &downstream_stream_indices, &downstream_step_indices,
+                                              narrow<uint32_t>(plan.num_barriers), &view_values);
+    return Status::OK();
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status LoadFromOrtFormat(const fbs::ExecutionPlan& fbs_plan, const GraphViewer& graph_viewer,
+                         const OrtValueNameIdxMap& ort_value_name_idx_map,
+                         const IStreamCommandHandleRegistry* stream_handle_registry,
+                         std::optional<SequentialExecutionPlan>& plan) {
+  if constexpr (!kIsSerializationSupported) {
+    ORT_UNUSED_PARAMETER(fbs_plan);
+    ORT_UNUSED_PARAMETER(graph_viewer);
+    ORT_UNUSED_PARAMETER(ort_value_name_idx_map);
+    ORT_UNUSED_PARAMETER(stream_handle_registry);
+    plan.reset();
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "Loading the execution plan is not supported in this build.");
+  } else {
+    plan.emplace();
+    auto status = LoadFromOrtFormatImpl(fbs_plan, graph_viewer, ort_value_name_idx_map, stream_handle_registry,
+                                        *plan);
+    if (!status.IsOK()) {
+      plan.reset();
+    }
+
+    return status;
+  }
+}
+
+}  // namespace onnxruntime::execution_plan_utils
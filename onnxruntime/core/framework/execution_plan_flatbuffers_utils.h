@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <optional>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/framework/sequential_execution_plan.h"
+
+namespace flatbuffers {
+class FlatBufferBuilder;
+template <typename T>
+struct Offset;
+}  // namespace flatbuffers
+
+namespace onnxruntime {
+
+namespace fbs {
+struct ExecutionPlan;
+}  // namespace fbs
+
+class ExecutionProviders;
+class GraphViewer;
+class IStreamCommandHandleRegistry;
+class ISequentialPlannerContext;
+class OrtValueNameIdxMap;
+
+namespace execution_plan_utils {
+
+/**
+ * Computes the hash of everything SequentialPlanner::CreatePlan depends on for the main graph: the graph nodes and
+ * their execution provider assignment, the OrtValue indices, the value shapes, the execution providers, the planner
+ * options and the ORT version. A serialized plan is only used if its hash matches.
+ */
+uint64_t ComputeConfigHash(const GraphViewer& graph_viewer,
+                           const OrtValueNameIdxMap& ort_value_name_idx_map,
+                           const ExecutionProviders& execution_providers,
+                           const ISequentialPlannerContext& context,
+                           const PathString& partition_config_file);
+
+#if !defined(ORT_MINIMAL_BUILD)
+/**
+ * Saves `plan` along with `config_hash` in ORT format.
+ * Returns a NOT_IMPLEMENTED error in builds where the plan carries state that is not serialized.
+ */
+Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder, const SequentialExecutionPlan& plan,
+                       uint64_t config_hash, flatbuffers::Offset<fbs::ExecutionPlan>& fbs_plan);
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+/**
+ * Loads the plan in `fbs_plan` into `plan`. The caller is expected to have checked the config hash.
+ * The serialized data is validated against `graph_viewer` and `ort_value_name_idx_map`, and the wait handles of
+ * WaitOnEPStep instances are re-resolved from `stream_handle_registry`, which may be nullptr if streams are not
+ * enabled in this build.
+ * On failure `plan` is reset.
+ */
+Status LoadFromOrtFormat(const fbs::ExecutionPlan& fbs_plan, const GraphViewer& graph_viewer,
+                         const OrtValueNameIdxMap& ort_value_name_idx_map,
+                         const IStreamCommandHandleRegistry* stream_handle_registry,
+                         std::optional<SequentialExecutionPlan>& plan);
+
+}  // namespace execution_plan_utils
+}  // namespace onnxruntime
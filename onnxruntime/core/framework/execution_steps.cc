@@ -21,9 +21,11 @@ std::string BarrierStep::ToString() const {
 }
 
 WaitOnEPStep::WaitOnEPStep(WaitNotificationFn handle,
-                           NotificationIndex idx, NodeIndex node_index) : SequentialExecutionPlan::ExecutionStep(node_index),
-                                                                          wait_handle_(handle),
-                                                                          notification_idx_(idx) {}
+                           NotificationIndex idx, NodeIndex node_index,
+                           OrtDevice::DeviceType waiting_device_type) : SequentialExecutionPlan::ExecutionStep(node_index),
+                                                                        wait_handle_(handle),
+                                                                        notification_idx_(idx),
+                                                                        waiting_device_type_(waiting_device_type) {}
 
 Status WaitOnEPStep::Execute(StreamExecutionContext& ctx,
                              size_t stream_idx,
@@ -21,13 +21,19 @@ class BarrierStep : public SequentialExecutionPlan::ExecutionStep {
 
   std::string ToString() const override;
 
+  Type GetType() const override { return Type::kBarrier; }
+  size_t GetBarrierId() const { return barrier_id_; }
+
  private:
   size_t barrier_id_{0};
 };
 
 class WaitOnEPStep : public SequentialExecutionPlan::ExecutionStep {
  public:
-  WaitOnEPStep(WaitNotificationFn handle, NotificationIndex idx, NodeIndex node_index);
+  // waiting_device_type is the device type of the side that waits, which together with the device type of the
+  // notification owner selects `handle` from the stream handle registry.
+  WaitOnEPStep(WaitNotificationFn handle, NotificationIndex idx, NodeIndex node_index,
+               OrtDevice::DeviceType waiting_device_type);
 
   Status Execute(StreamExecutionContext& ctx,
                  size_t stream_idx,
@@ -37,9 +43,14 @@ class WaitOnEPStep : public SequentialExecutionPlan::ExecutionStep {
 
   std::string ToString() const override;
 
+  Type GetType() const override { return Type::kWaitOnEP; }
+  NotificationIndex GetNotificationIndex() const { return notification_idx_; }
+  OrtDevice::DeviceType GetWaitingDeviceType() const { return waiting_device_type_; }
+
  private:
   WaitNotificationFn wait_handle_;
   NotificationIndex notification_idx_;
+  OrtDevice::DeviceType waiting_device_type_;
 };
 
 class LaunchKernelStep : public SequentialExecutionPlan::ExecutionStep {
@@ -53,6 +64,8 @@ class LaunchKernelStep : public SequentialExecutionPlan::ExecutionStep {
                  bool& continue_flag) override;
 
   std::string ToString() const override;
+
+  Type GetType() const override { return Type::kLaunchKernel; }
 };
 
 class ActivateNotificationStep : public SequentialExecutionPlan::ExecutionStep {
@@ -67,6 +80,9 @@ class ActivateNotificationStep : public SequentialExecutionPlan::ExecutionStep {
 
   virtual std::string ToString() const override;
 
+  Type GetType() const override { return Type::kActivateNotification; }
+  NotificationIndex GetNotificationIndex() const { return notification_idx_; }
+
  private:
   NotificationIndex notification_idx_;
 };
@@ -82,6 +98,9 @@ class TriggerDownstreamStep : public SequentialExecutionPlan::ExecutionStep {
 
   virtual std::string ToString() const override;
 
+  Type GetType() const override { return Type::kTriggerDownstream; }
+  size_t GetTriggerPointIndex() const { return trigger_point_index_; }
+
  private:
   size_t trigger_point_index_;
 };
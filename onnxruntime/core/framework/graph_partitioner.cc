@@ -12,8 +12,10 @@
 #include "core/framework/kernel_lookup.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/partitioning_cost_model.h"
 #include "core/graph/function.h"
 #include "core/graph/graph_viewer.h"
+#include "core/platform/threadpool.h"
 
 // uncomment this line to count non-CUDA ops in ONNX domain
 // #define COUNT_NON_CUDA_OPS
@@ -55,6 +57,7 @@ struct PartitionParams {
   std::reference_wrapper<int> fused_node_unique_id;
   std::reference_wrapper<const layout_transformation::TransformLayoutFunction> transform_layout_function;
   std::reference_wrapper<const layout_transformation::DebugGraphFn> debug_graph_fn;
+  concurrency::ThreadPool* compile_thread_pool;
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 };
 }  // namespace
@@ -70,6 +73,49 @@ static void BuildFusedKernelDef(KernelDefBuilder& builder, const IndexedSubGraph
       .Provider(provider_type);
 }
 
+// Compiling the fused nodes in parallel requires an EP that supports concurrent calls to Compile, more than one node
+// and a thread pool with more than one thread.
+static bool CanCompileInParallel(const IExecutionProvider& ep, size_t num_fused_nodes,
+                                 concurrency::ThreadPool* thread_pool) {
+  return num_fused_nodes > 1 && ep.ConcurrentCompileSupported() &&
+         concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1;
+}
+
+// Compile each fused node with a separate call to Compile on the thread pool. Returns the error of the first node that
+// failed, so the status returned does not depend on the thread scheduling.
+static Status CompileInParallel(IExecutionProvider& ep,
+                                const std::vector<IExecutionProvider::FusedNodeAndGraph>& fused_nodes_and_graphs,
+                                std::vector<NodeComputeInfo>& node_compute_funcs,
+                                concurrency::ThreadPool* thread_pool) {
+  const size_t num_fused_nodes = fused_nodes_and_graphs.size();
+  std::vector<std::vector<NodeComputeInfo>> compute_funcs_per_node(num_fused_nodes);
+  std::vector<Status> statuses(num_fused_nodes);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_fused_nodes),
+      [&](std::ptrdiff_t i) {
+        ORT_TRY {
+          statuses[i] = ep.Compile({fused_nodes_and_graphs[i]}, compute_funcs_per_node[i]);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  node_compute_funcs.reserve(node_compute_funcs.size() + num_fused_nodes);
+  for (size_t i = 0; i < num_fused_nodes; ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    if (compute_funcs_per_node[i].size() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ep.Type(), " did not return correct number of compiled functions");
+    }
+    node_compute_funcs.push_back(std::move(compute_funcs_per_node[i][0]));
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "Compiled " << num_fused_nodes << " fused nodes of " << ep.Type() << " in parallel.";
+  return Status::OK();
+}
+
 /// <summary>
 /// Check if a node can be placed on a specific provider. If yes, then set the nodes execution provider.
 /// Do nothing if the node is already assigned.
@@ -327,6 +373,59 @@ static Node* PlaceNode(Graph& graph, const IndexedSubGraph& capability,
   return result;
 }
 
+// Leave the nodes a device EP claimed with individual kernels to the CPU EP, if the islands they form are estimated
+// to run faster on CPU once the copies the memcpy transformer inserts around them are accounted for.
+// Compiling EPs are left alone as they weigh the size of what they fuse themselves.
+static void RemoveCapabilitiesCheaperOnCpu(Graph& graph, const KernelRegistryManager& kernel_registry_mgr,
+                                           const IExecutionProvider& current_ep,
+                                           std::vector<std::unique_ptr<ComputeCapability>>& capabilities) {
+  const auto& ep_type = current_ep.Type();
+  if (ep_type == kCpuExecutionProvider ||
+      current_ep.GetOrtDeviceByMemType(OrtMemTypeDefault).Type() == OrtDevice::CPU ||
+      current_ep.GetPreferredLayout() == DataLayout::NHWC) {
+    return;
+  }
+
+  std::vector<NodeIndex> tentative_nodes;
+  for (const auto& capability : capabilities) {
+    const auto& sub_graph = *capability->sub_graph;
+    if (sub_graph.GetMetaDef() == nullptr && sub_graph.nodes.size() == 1) {
+      const Node* node = graph.GetNode(sub_graph.nodes[0]);
+      if (node != nullptr && node->GetExecutionProviderType().empty()) {
+        tentative_nodes.push_back(node->Index());
+      }
+    }
+  }
+
+  if (tentative_nodes.empty()) {
+    return;
+  }
+
+  const KernelLookup kernel_lookup{ep_type,
+                                   kernel_registry_mgr.GetKernelRegistriesByProviderType(ep_type),
+                                   kernel_registry_mgr.GetKernelTypeStrResolver()};
+  const KernelLookup cpu_kernel_lookup{kCpuExecutionProvider,
+                                       kernel_registry_mgr.GetKernelRegistriesByProviderType(kCpuExecutionProvider),
+                                       kernel_registry_mgr.GetKernelTypeStrResolver()};
+
+  const GraphViewer graph_viewer(graph);
+  const auto cpu_nodes = GetNodesCheaperOnCpu(graph_viewer, kernel_lookup, cpu_kernel_lookup, tentative_nodes);
+  if (cpu_nodes.empty()) {
+    return;
+  }
+
+  capabilities.erase(std::remove_if(capabilities.begin(), capabilities.end(),
+                                    [&cpu_nodes](const std::unique_ptr<ComputeCapability>& capability) {
+                                      const auto& sub_graph = *capability->sub_graph;
+                                      return sub_graph.GetMetaDef() == nullptr && sub_graph.nodes.size() == 1 &&
+                                             cpu_nodes.count(sub_graph.nodes[0]) != 0;
+                                    }),
+                     capabilities.end());
+
+  LOGS_DEFAULT(INFO) << "Cost aware partitioning left " << cpu_nodes.size() << " node(s) claimed by " << ep_type
+                     << " to the CPU EP.";
+}
+
 // for the current EP, recursively iterate through the Graph and any nested subgraphs (recursion is bottom-up).
 // assign any nodes to the EP that are currently unassigned, and that the EP can handle.
 static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
@@ -336,7 +435,9 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
                                            GraphPartitioner::Mode mode,
                                            int& fused_node_unique_id,
                                            const layout_transformation::TransformLayoutFunction& transform_layout_fn,
-                                           const layout_transformation::DebugGraphFn& debug_graph_fn) {
+                                           const layout_transformation::DebugGraphFn& debug_graph_fn,
+                                           bool cost_aware,
+                                           concurrency::ThreadPool* compile_thread_pool) {
   // handle testing edge case where optimizers or constant lifting results in graph with no nodes.
   // doing it here saves all providers checking for this in GetCapability
   if (graph.NumberOfNodes() == 0) {
@@ -350,7 +451,8 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       // we pass through the FuncManager from the top level graph
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(*subgraph, func_mgr, kernel_registry_mgr,
                                                        fused_kernel_registry, current_ep, mode, fused_node_unique_id,
-                                                       transform_layout_fn, debug_graph_fn));
+                                                       transform_layout_fn, debug_graph_fn, cost_aware,
+                                                       compile_thread_pool));
     }
   }
 
@@ -376,6 +478,11 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
       std::cref(debug_graph_fn)};
 
   ORT_RETURN_IF_ERROR(GetCapabilityForEP(get_capability_params));
+
+  if (cost_aware && mode == GraphPartitioner::Mode::kNormal) {
+    RemoveCapabilitiesCheaperOnCpu(graph, kernel_registry_mgr, current_ep, capabilities);
+  }
+
   if (capabilities.empty()) {
     return Status::OK();
   }
@@ -436,7 +543,12 @@ static Status PartitionOnnxFormatModelImpl(Graph& graph, FuncManager& func_mgr,
         nodes_and_viewers.push_back(IExecutionProvider::FusedNodeAndGraph{*node, *viewers.back()});
       }
 
-      ORT_RETURN_IF_ERROR(current_ep.Compile(nodes_and_viewers, node_compute_funcs));
+      if (CanCompileInParallel(current_ep, nodes_and_viewers.size(), compile_thread_pool)) {
+        ORT_RETURN_IF_ERROR(CompileInParallel(current_ep, nodes_and_viewers, node_compute_funcs,
+                                              compile_thread_pool));
+      } else {
+        ORT_RETURN_IF_ERROR(current_ep.Compile(nodes_and_viewers, node_compute_funcs));
+      }
 
       if (node_compute_funcs.size() != nodes_to_compile.size()) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, type, " did not return correct number of compiled functions");
@@ -535,7 +647,8 @@ static Status InlineNodes(Graph& graph, bool& modified_graph) {
 
 static Status PartitionOnnxFormatModel(const PartitionParams& partition_params, GraphPartitioner::Mode mode,
                                        const ExecutionProviders& execution_providers,
-                                       KernelRegistryManager& kernel_registry_manager) {
+                                       KernelRegistryManager& kernel_registry_manager,
+                                       bool cost_aware) {
   bool modified_graph = false;
 
   auto& graph = partition_params.graph.get();
@@ -550,7 +663,8 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
       ORT_RETURN_IF_ERROR(PartitionOnnxFormatModelImpl(graph, func_mgr, kernel_registry_manager,
                                                        fused_kernel_registry, *ep, mode, fused_node_unique_id,
                                                        transform_layout_function,
-                                                       partition_params.debug_graph_fn));
+                                                       partition_params.debug_graph_fn, cost_aware,
+                                                       partition_params.compile_thread_pool));
     }
 
     // expand any nodes that have an ONNX function definition but no matching ORT kernel.
@@ -646,16 +760,36 @@ static Status PartitionOrtFormatModelImpl(const PartitionParams& partition_param
   }
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
-  // We will compile the fused nodes one by one, and fuse the subgraph if successful.
-  for (const auto& compilation_entry : compilation_entries) {
-    Node& node = compilation_entry.fused_node;
-    std::vector<NodeComputeInfo> single_node_compute_func;
-    ORT_RETURN_IF_ERROR(current_ep.Compile({IExecutionProvider::FusedNodeAndGraph{node, *compilation_entry.viewer}},
-                                           single_node_compute_func));
+  std::vector<NodeComputeInfo> node_compute_funcs;
+  if (CanCompileInParallel(current_ep, compilation_entries.size(), partition_params.compile_thread_pool)) {
+    std::vector<IExecutionProvider::FusedNodeAndGraph> nodes_and_viewers;
+    nodes_and_viewers.reserve(compilation_entries.size());
+    for (const auto& compilation_entry : compilation_entries) {
+      nodes_and_viewers.push_back(
+          IExecutionProvider::FusedNodeAndGraph{compilation_entry.fused_node, *compilation_entry.viewer});
+    }
+    ORT_RETURN_IF_ERROR(CompileInParallel(current_ep, nodes_and_viewers, node_compute_funcs,
+                                          partition_params.compile_thread_pool));
+  } else {
+    // We will compile the fused nodes one by one.
+    node_compute_funcs.reserve(compilation_entries.size());
+    for (const auto& compilation_entry : compilation_entries) {
+      Node& node = compilation_entry.fused_node;
+      std::vector<NodeComputeInfo> single_node_compute_func;
+      ORT_RETURN_IF_ERROR(current_ep.Compile({IExecutionProvider::FusedNodeAndGraph{node, *compilation_entry.viewer}},
+                                             single_node_compute_func));
+
+      ORT_RETURN_IF(single_node_compute_func.empty(), "single_node_compute_func should have 1 element.");
+      node_compute_funcs.push_back(std::move(single_node_compute_func[0]));
+    }
+  }
 
-    ORT_RETURN_IF(single_node_compute_func.empty(), "single_node_compute_func should have 1 element.");
+  // fuse the subgraphs now that all of them compiled successfully
+  for (size_t j = 0, end = compilation_entries.size(); j < end; j++) {
+    const auto& compilation_entry = compilation_entries[j];
+    Node& node = compilation_entry.fused_node;
     auto& func_mgr = partition_params.func_mgr.get();
-    ORT_RETURN_IF_ERROR(func_mgr.AddFuncInfo(node.Name(), std::move(single_node_compute_func[0])));
+    ORT_RETURN_IF_ERROR(func_mgr.AddFuncInfo(node.Name(), std::move(node_compute_funcs[j])));
 
     const ComputeCapability& cur_capability = compilation_entry.capability;
     const IndexedSubGraph& indexed_sub_graph = *cur_capability.sub_graph;
@@ -724,6 +858,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
       std::ref(fused_node_unique_id),
       std::cref(transform_layout_function),
       std::cref(debug_graph_fn),
+      compile_thread_pool_,
   };
 
 #else  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -740,7 +875,7 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   if (mode == Mode::kNormal || mode == Mode::kAssignOnly) {
 #if !defined(ORT_MINIMAL_BUILD)
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(partition_params, mode,
-                                                 providers_, kernel_registry_mgr_));
+                                                 providers_, kernel_registry_mgr_, cost_aware_));
 #else
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ONNX models are not supported in this build.");
 #endif  //! defined(ORT_MINIMAL_BUILD)
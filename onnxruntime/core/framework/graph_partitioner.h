@@ -12,6 +12,9 @@ namespace onnxruntime {
 
 class ExecutionProviders;
 class KernelRegistryManager;
+namespace concurrency {
+class ThreadPool;
+}
 
 class GraphPartitioner {
  public:
@@ -22,9 +25,15 @@ class GraphPartitioner {
   };
 
   // The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  // If cost_aware is true, islands of nodes a device EP claims with individual kernels are left to the CPU EP when
+  // the copies around them are estimated to cost more than running them on the device saves.
+  // If compile_thread_pool is not null, the fused nodes of EPs supporting concurrent compilation are compiled on it.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   bool cost_aware = false, concurrency::ThreadPool* compile_thread_pool = nullptr)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        cost_aware_(cost_aware),
+        compile_thread_pool_(compile_thread_pool) {
   }
 
   // Run partitioning.
@@ -38,6 +47,8 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const bool cost_aware_;
+  concurrency::ThreadPool* const compile_thread_pool_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <vector>
+
+#include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/env.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace onnxruntime {
+
+namespace {
+
+#if defined(__linux__)
+// from <numaif.h>, which is only available with libnuma installed
+constexpr int kMpolPreferred = 1;
+
+bool BindToNumaNode(void* p, size_t size, int numa_node) {
+  constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;
+  std::vector<unsigned long> node_mask(static_cast<size_t>(numa_node) / kBitsPerWord + 1, 0);
+  node_mask[static_cast<size_t>(numa_node) / kBitsPerWord] |= 1UL << (static_cast<size_t>(numa_node) % kBitsPerWord);
+  return syscall(SYS_mbind, p, size, kMpolPreferred, node_mask.data(), node_mask.size() * kBitsPerWord + 1, 0) == 0;
+}
+#endif
+
+}  // namespace
+
+HugePageCPUAllocator::HugePageCPUAllocator(const Options& options) : options_(options) {
+#if !defined(__linux__)
+  if (!options_.IsDefault()) {
+    LOGS_DEFAULT(WARNING) << "Huge pages and NUMA binding are not supported on this platform. "
+                          << "Allocations use regular pages.";
+  }
+#endif
+}
+
+Status HugePageCPUAllocator::ParseOptions(const std::string& huge_pages, const std::string& numa_node,
+                                          const std::string& intra_op_thread_affinities, Options& options) {
+  Options parsed;
+  if (!huge_pages.empty()) {
+    int value = 0;
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(huge_pages, value));
+    ORT_RETURN_IF_NOT(value >= static_cast<int>(HugePages::kNone) && value <= static_cast<int>(HugePages::kExplicit),
+                      "Invalid huge page mode: ", huge_pages, ". Valid values are 0, 1 and 2.");
+    parsed.huge_pages = static_cast<HugePages>(value);
+  }
+
+  if (numa_node == "auto") {
+    // the affinity string uses 1-based processor ids. each thread is given a list or a range of processors.
+    std::vector<int> processors;
+    for (const auto& thread_affinity : utils::SplitString(intra_op_thread_affinities, ";")) {
+      for (const auto& item : utils::SplitString(thread_affinity, ",")) {
+        const auto interval = utils::SplitString(item, "-");
+        int from = 0;
+        int to = 0;
+        ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(interval.front(), from));
+        ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(interval.back(), to));
+        ORT_RETURN_IF_NOT(from > 0 && from <= to, "Invalid processors in thread affinity: ", item);
+        for (int processor = from; processor <= to; ++processor) {
+          processors.push_back(processor - 1);
+        }
+      }
+    }
+
+    parsed.numa_node = GetNumaNodeOfProcessors(processors);
+    if (parsed.numa_node < 0) {
+      LOGS_DEFAULT(WARNING) << "Could not determine the NUMA node of the intra-op thread affinities '"
+                            << intra_op_thread_affinities << "'. CPU allocations are not bound to a NUMA node.";
+    }
+  } else if (!numa_node.empty()) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(numa_node, parsed.numa_node));
+    ORT_RETURN_IF_NOT(parsed.numa_node >= -1, "Invalid NUMA node: ", numa_node);
+  }
+
+  options = parsed;
+  return Status::OK();
+}
+
+int HugePageCPUAllocator::GetNumaNodeOfProcessors(gsl::span<const int> processors) {
+  return Env::Default().GetNumaNodeOfProcessors(LogicalProcessors(processors.begin(), processors.end()));
+}
+
+void* HugePageCPUAllocator::Map(size_t size) {
+#if defined(__linux__)
+  const size_t length = (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  void* p = MAP_FAILED;
+
+  if (options_.huge_pages == HugePages::kExplicit) {
+    p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  }
+
+  if (p == MAP_FAILED) {
+    // over-allocate so the mapping can be trimmed to a huge page boundary, which transparent huge pages need.
+    void* raw = mmap(nullptr, length + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+      return nullptr;
+    }
+
+    const auto raw_address = reinterpret_cast<uintptr_t>(raw);
+    const auto address = (raw_address + kHugePageSize - 1) & ~static_cast<uintptr_t>(kHugePageSize - 1);
+    const size_t head = address - raw_address;
+    const size_t tail = kHugePageSize - head;
+    if (head > 0) {
+      munmap(raw, head);
+    }
+    if (tail > 0) {
+      munmap(reinterpret_cast<void*>(address + length), tail);
+    }
+
+    p = reinterpret_cast<void*>(address);
+    if (options_.huge_pages != HugePages::kNone) {
+      // failures only mean regular pages are used.
+      madvise(p, length, MADV_HUGEPAGE);
+    }
+  }
+
+  // bind before the pages are first touched.
+  if (options_.numa_node >= 0 && !BindToNumaNode(p, length, options_.numa_node)) {
+    LOGS_DEFAULT(VERBOSE) << "Failed to bind " << length << " bytes to NUMA node " << options_.numa_node;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  mappings_[p] = length;
+  return p;
+#else
+  ORT_UNUSED_PARAMETER(size);
+  return nullptr;
+#endif
+}
+
+void* HugePageCPUAllocator::Alloc(size_t size) {
+  // CPUAllocator pads the allocation for the MLAS kernels that read past the end of their buffers.
+  if (!options_.IsDefault() && size + MLAS_SYMM_QGEMM_BUF_OVERRUN >= kHugePageSize) {
+    void* p = Map(size + MLAS_SYMM_QGEMM_BUF_OVERRUN);
+    if (p != nullptr) {
+      return p;
+    }
+  }
+
+  return CPUAllocator::Alloc(size);
+}
+
+void HugePageCPUAllocator::Free(void* p) {
+#if defined(__linux__)
+  if (p != nullptr && !options_.IsDefault()) {
+    size_t length = 0;
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      auto it = mappings_.find(p);
+      if (it != mappings_.end()) {
+        length = it->second;
+        mappings_.erase(it);
+      }
+    }
+
+    if (length > 0) {
+      munmap(p, length);
+      return;
+    }
+  }
+#endif
+
+  CPUAllocator::Free(p);
+}
+
+}  // namespace onnxruntime
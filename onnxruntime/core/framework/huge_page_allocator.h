@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * CPU allocator that maps large allocations directly from the OS so that they can be backed by huge pages and
+ * placed on a given NUMA node.
+ *
+ * Allocations of at least kHugePageSize bytes, e.g. arena regions and initializers, are mapped separately, aligned
+ * to kHugePageSize and bound to the NUMA node before they are touched, so pages don't land on whichever node first
+ * writes them. Smaller allocations are served like CPUAllocator.
+ * Huge pages and NUMA binding are only supported on Linux. Elsewhere the allocator behaves like CPUAllocator.
+ */
+class HugePageCPUAllocator : public CPUAllocator {
+ public:
+  static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+  enum class HugePages {
+    // regular pages.
+    kNone = 0,
+    // transparent huge pages, requested with madvise.
+    kTransparent = 1,
+    // pages from the explicit huge page pool, falling back to transparent huge pages if the pool is exhausted.
+    kExplicit = 2,
+  };
+
+  struct Options {
+    HugePages huge_pages{HugePages::kNone};
+    // NUMA node to bind large allocations to. -1 doesn't bind them.
+    int numa_node{-1};
+
+    bool IsDefault() const { return huge_pages == HugePages::kNone && numa_node < 0; }
+  };
+
+  explicit HugePageCPUAllocator(const Options& options);
+
+  /**
+   * Parse the options from the session config values.
+   * `numa_node` may be "auto", in which case the node of most of the processors in `intra_op_thread_affinities`
+   * is used, if it can be determined.
+   */
+  static Status ParseOptions(const std::string& huge_pages, const std::string& numa_node,
+                             const std::string& intra_op_thread_affinities, Options& options);
+
+  // NUMA node most of `processors` (0-based logical processor ids) belong to. -1 if it can't be determined.
+  static int GetNumaNodeOfProcessors(gsl::span<const int> processors);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+  const Options& GetOptions() const { return options_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HugePageCPUAllocator);
+
+  // Map `size` bytes. Returns nullptr if the mapping fails.
+  void* Map(size_t size);
+
+  const Options options_;
+
+  OrtMutex mutex_;
+  // length of the mappings created by Map. GUARDED_BY(mutex_)
+  InlinedHashMap<void*, size_t> mappings_;
+};
+
+}  // namespace onnxruntime
@@ -179,6 +179,17 @@ KernelDefBuilder& KernelDefBuilder::VariadicAlias(int input_offset, int output_o
   return *this;
 }
 
+KernelDefBuilder& KernelDefBuilder::MayViewOutput(int input_index, int output_index) {
+  kernel_def_->may_view_output_map_.emplace_back(input_index, output_index);
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::VariadicMayViewOutput(int input_index) {
+  ORT_ENFORCE(input_index >= 0);
+  kernel_def_->variadic_may_view_input_ = input_index;
+  return *this;
+}
+
 #ifdef ENABLE_STRIDED_TENSORS
 KernelDefBuilder& KernelDefBuilder::MayStridedInput(int input_index) {
   kernel_def_->may_strided_inputs_.emplace_back(input_index);
@@ -2,9 +2,12 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <optional>
+
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/tensor_shape.h"
 
 namespace onnxruntime {
 struct MemoryBlock {
@@ -26,11 +29,13 @@ class MemoryPattern {
 
   MemoryPattern(MemoryPattern&& rhs) noexcept
       : patterns_{std::move(rhs.patterns_)},
-        peak_size_{std::move(rhs.peak_size_)} {}
+        peak_size_{std::move(rhs.peak_size_)},
+        lower_bound_size_{std::move(rhs.lower_bound_size_)} {}
 
   MemoryPattern& operator=(MemoryPattern&& rhs) noexcept {
     patterns_ = std::move(rhs.patterns_);
     peak_size_ = std::move(rhs.peak_size_);
+    lower_bound_size_ = std::move(rhs.lower_bound_size_);
     return *this;
   }
 
@@ -38,6 +43,12 @@ class MemoryPattern {
     return peak_size_;
   }
 
+  // The largest total size of the blocks in use at the same time, which no placement of the blocks can go below.
+  // 0 if it is unknown.
+  size_t LowerBoundSize() const {
+    return lower_bound_size_;
+  }
+
   const MemoryBlock* GetBlock(int ml_value_idx) const {
     auto it = patterns_.find(ml_value_idx);
     if (it == patterns_.end())
@@ -56,12 +67,34 @@ class MemoryPattern {
 
   InlinedHashMap<int, MemoryBlock> patterns_;
   size_t peak_size_{0};
+  size_t lower_bound_size_{0};
+};
+
+// The shape and block of a tensor recorded in the run that generated a MemoryPatternGroup.
+struct RecordedTensorPlacement {
+  TensorShape shape;
+  size_t location_index{0};  // index into MemoryPatternGroup::locations
+  MemoryBlock block;
 };
 
 struct MemoryPatternGroup {
   std::vector<OrtDevice> locations;
   std::vector<MemoryPattern> patterns;
 
+  // The tensors allocated from the patterns in the run that generated them, indexed on OrtValue index.
+  // Only populated if the patterns are specific to the exact input shapes. A later run with the same input shapes
+  // can then place a tensor that has the recorded shape without calculating its size or searching the patterns.
+  std::vector<std::optional<RecordedTensorPlacement>> recorded_placements;
+
+  const RecordedTensorPlacement* GetRecordedPlacement(int ml_value_idx) const {
+    if (ml_value_idx < 0 || static_cast<size_t>(ml_value_idx) >= recorded_placements.size() ||
+        !recorded_placements[ml_value_idx].has_value()) {
+      return nullptr;
+    }
+
+    return &*recorded_placements[ml_value_idx];
+  }
+
   const MemoryPattern* GetPatterns(const OrtDevice& location) const {
     for (size_t i = 0; i < locations.size(); i++)
       if (locations[i] == location) {
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+namespace onnxruntime {
+
+size_t MemoryPatternCache::PeakBytes(const MemoryPatternGroup& patterns) {
+  size_t bytes = 0;
+  for (const auto& pattern : patterns.patterns) {
+    bytes += pattern.PeakSize();
+  }
+
+  return bytes;
+}
+
+bool MemoryPatternCache::Covers(gsl::span<const int64_t> dims, gsl::span<const int64_t> other) {
+  if (dims.size() != other.size()) {
+    return false;
+  }
+
+  for (size_t i = 0, end = dims.size(); i < end; ++i) {
+    if (dims[i] < other[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::shared_ptr<const MemoryPatternGroup> MemoryPatternCache::Find(int64_t key, gsl::span<const int64_t> dims) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+
+  auto entry = it->second;
+  if (!dims.empty() && !Covers(entry->dims, dims)) {
+    ++misses_;
+    return nullptr;
+  }
+
+  ++hits_;
+  lru_.splice(lru_.begin(), lru_, entry);
+  return entry->patterns;
+}
+
+std::shared_ptr<const MemoryPatternGroup> MemoryPatternCache::Insert(int64_t key, MemoryPatternGroup&& patterns,
+                                                                     gsl::span<const int64_t> dims,
+                                                                     bool replace_if_covering) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    auto entry = it->second;
+    if (!replace_if_covering || !Covers(dims, entry->dims)) {
+      lru_.splice(lru_.begin(), lru_, entry);
+      return entry->patterns;
+    }
+
+    total_bytes_ -= entry->bytes;
+    lru_.erase(entry);
+    index_.erase(it);
+  }
+
+  const size_t bytes = PeakBytes(patterns);
+  lru_.push_front(Entry{key, std::make_shared<const MemoryPatternGroup>(std::move(patterns)),
+                        InlinedVector<int64_t>(dims.begin(), dims.end()), bytes});
+  index_.emplace(key, lru_.begin());
+  total_bytes_ += bytes;
+
+  // keep the new entry's pattern alive for the caller even if it's evicted because it alone exceeds the limit
+  auto result = lru_.front().patterns;
+  EvictIfNeeded();
+  return result;
+}
+
+void MemoryPatternCache::EvictIfNeeded() {
+  if (max_bytes_ == 0) {
+    return;
+  }
+
+  while (total_bytes_ > max_bytes_ && !lru_.empty()) {
+    const auto& entry = lru_.back();
+    total_bytes_ -= entry.bytes;
+    index_.erase(entry.key);
+    lru_.pop_back();
+  }
+}
+
+}  // namespace onnxruntime
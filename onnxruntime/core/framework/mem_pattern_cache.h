@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <memory>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+
+namespace onnxruntime {
+
+/**
+ * LRU cache of MemoryPatternGroup instances keyed on a hash of the input shapes.
+ *
+ * Each entry records the input dims it was generated with. A lookup with the same key only hits if the recorded
+ * dims are at least as large as the requested ones, so that a pattern generated for one shape can serve every
+ * smaller shape that maps to the same key (see the shape bucketing in SessionState).
+ *
+ * Entries are handed out as shared_ptr so an entry can be evicted while an ExecutionFrame is still using it.
+ * The class is not thread-safe. SessionState serializes access with mem_patterns_lock_.
+ */
+class MemoryPatternCache {
+ public:
+  // max_bytes of 0 means the cache is unbounded.
+  explicit MemoryPatternCache(size_t max_bytes = 0) : max_bytes_{max_bytes} {}
+
+  void SetMaxBytes(size_t max_bytes) {
+    max_bytes_ = max_bytes;
+    EvictIfNeeded();
+  }
+
+  /**
+   * Find the entry for `key`. If `dims` is not empty the entry is only returned if it was generated with dims
+   * covering `dims`. On a hit the entry becomes the most recently used one.
+   */
+  std::shared_ptr<const MemoryPatternGroup> Find(int64_t key, gsl::span<const int64_t> dims = {});
+
+  /**
+   * Insert the patterns for `key`.
+   * If an entry for `key` exists it is kept unless `replace_if_covering` is true and `dims` cover the existing
+   * entry's dims. Returns the entry for `key` after the insertion.
+   */
+  std::shared_ptr<const MemoryPatternGroup> Insert(int64_t key, MemoryPatternGroup&& patterns,
+                                                   gsl::span<const int64_t> dims = {},
+                                                   bool replace_if_covering = false);
+
+  size_t Size() const { return index_.size(); }
+  size_t TotalBytes() const { return total_bytes_; }
+
+  // Number of calls to Find that returned an entry, and that did not.
+  size_t Hits() const { return hits_; }
+  size_t Misses() const { return misses_; }
+
+  // Sum of the peak sizes of all patterns in the group.
+  static size_t PeakBytes(const MemoryPatternGroup& patterns);
+
+  // true if every element of `dims` is >= the corresponding element of `other`.
+  static bool Covers(gsl::span<const int64_t> dims, gsl::span<const int64_t> other);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryPatternCache);
+
+  struct Entry {
+    int64_t key;
+    std::shared_ptr<const MemoryPatternGroup> patterns;
+    InlinedVector<int64_t> dims;
+    size_t bytes;
+  };
+
+  void EvictIfNeeded();
+
+  size_t max_bytes_;
+  size_t total_bytes_{0};
+  size_t hits_{0};
+  size_t misses_{0};
+
+  // most recently used entry first
+  std::list<Entry> lru_;
+  InlinedHashMap<int64_t, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace onnxruntime
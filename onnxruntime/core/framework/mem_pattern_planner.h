@@ -16,6 +16,8 @@ limitations under the License.
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <limits>
 #include <list>
 #include "core/common/safeint.h"
 #include "core/framework/mem_pattern.h"
@@ -23,6 +25,16 @@ limitations under the License.
 #include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
+// How MemPatternPlanner places the traced allocations.
+enum class MemPatternPlannerAlgorithm {
+  // place each allocation in the smallest free gap at the time it is traced. The default.
+  kOnline,
+  // once the iteration is traced, place the allocations in order of decreasing size, each in the smallest gap left
+  // by the already placed allocations whose lifetimes overlap with it.
+  // The online placement is kept if it has a smaller peak. Not used with program counters.
+  kGreedyBySize,
+};
+
 // MemPatternPlanner is used to trace allocation/free steps
 // in a single iteration, record the pattern and cached for
 // future request if they have the same input shape.
@@ -30,7 +42,8 @@ namespace onnxruntime {
 class MemPatternPlanner {
  public:
   // only the Training code currently uses the program counter based logic
-  MemPatternPlanner(bool using_counters) : using_counters_{using_counters} {}
+  MemPatternPlanner(bool using_counters, MemPatternPlannerAlgorithm algorithm = MemPatternPlannerAlgorithm::kOnline)
+      : using_counters_{using_counters}, algorithm_{algorithm} {}
 
 #ifdef ENABLE_TRAINING
   // TODO: OverlappingTimeSchedules should be private
@@ -175,6 +188,7 @@ class MemPatternPlanner {
     // the maximum size of the buffer.
     buffer_size_ = std::max(buffer_size_, SafeInt<size_t>(best_offset) + size);
     allocs_.emplace_back(ml_value_idx, MemoryBlock(best_offset, size));
+    allocs_.back().start_ = clock_++;
     std::list<int>::iterator best_fit_it = blocks_.end();
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].block_.offset_ < best_offset)
@@ -194,6 +208,7 @@ class MemPatternPlanner {
 
     for (auto it = blocks_.begin(); it != blocks_.end(); it++) {
       if (allocs_[*it].index_ == ml_value_index) {
+        allocs_[*it].end_ = clock_++;
         blocks_.erase(it);
         break;
       }
@@ -240,15 +255,115 @@ class MemPatternPlanner {
       pattern.patterns_.insert_or_assign(alloc.index_, alloc.block_);
     }
 
+    if (!using_counters_) {
+      pattern.lower_bound_size_ = LowerBoundSize();
+      if (algorithm_ == MemPatternPlannerAlgorithm::kGreedyBySize) {
+        InlinedVector<MemoryBlock> blocks;
+        const size_t peak_size = PlaceGreedyBySize(blocks);
+        if (peak_size < pattern.peak_size_) {
+          pattern.peak_size_ = peak_size;
+          for (size_t i = 0; i < allocs_.size(); ++i) {
+            pattern.patterns_.insert_or_assign(allocs_[i].index_, blocks[i]);
+          }
+        }
+      }
+    }
+
     return pattern;
   }
 
  private:
+  // Maximum over time of the total size of the live allocations.
+  size_t LowerBoundSize() const {
+    // allocations and frees have distinct clock values, so the order of events at the same time doesn't matter.
+    InlinedVector<std::pair<size_t, int64_t>> events;
+    for (const auto& alloc : allocs_) {
+      if (alloc.block_.size_ > 0) {
+        events.emplace_back(alloc.start_, static_cast<int64_t>(alloc.block_.size_));
+        events.emplace_back(alloc.end_, -static_cast<int64_t>(alloc.block_.size_));
+      }
+    }
+
+    std::sort(events.begin(), events.end());
+    int64_t live = 0;
+    int64_t peak = 0;
+    for (const auto& event : events) {
+      live += event.second;
+      peak = std::max(peak, live);
+    }
+
+    return static_cast<size_t>(peak);
+  }
+
+  // Place the allocations in order of decreasing size. `blocks` is indexed like allocs_. Returns the peak size.
+  size_t PlaceGreedyBySize(InlinedVector<MemoryBlock>& blocks) const {
+    blocks.assign(allocs_.size(), MemoryBlock(0, 0));
+
+    InlinedVector<size_t> order;
+    for (size_t i = 0; i < allocs_.size(); ++i) {
+      if (allocs_[i].block_.size_ > 0) {
+        order.push_back(i);
+      }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return allocs_[a].block_.size_ > allocs_[b].block_.size_;
+    });
+
+    SafeInt<size_t> peak_size = 0;
+    InlinedVector<size_t> placed;
+    InlinedVector<const MemoryBlock*> overlapping;
+    for (size_t i : order) {
+      const auto& alloc = allocs_[i];
+      const size_t size = alloc.block_.size_;
+
+      overlapping.clear();
+      for (size_t j : placed) {
+        if (allocs_[j].start_ < alloc.end_ && alloc.start_ < allocs_[j].end_) {
+          overlapping.push_back(&blocks[j]);
+        }
+      }
+
+      std::sort(overlapping.begin(), overlapping.end(),
+                [](const MemoryBlock* a, const MemoryBlock* b) { return a->offset_ < b->offset_; });
+
+      size_t current = 0;
+      size_t best_offset = 0;
+      size_t waste_bytes = std::numeric_limits<size_t>::max();
+      bool best_offset_found = false;
+      for (const MemoryBlock* block : overlapping) {
+        if (block->offset_ >= current) {
+          const size_t gap = block->offset_ - current;
+          if (gap >= size && gap - size < waste_bytes) {
+            waste_bytes = gap - size;
+            best_offset = current;
+            best_offset_found = true;
+          }
+        }
+        current = std::max(current, block->offset_ + block->size_);
+      }
+
+      if (!best_offset_found) {
+        best_offset = current;
+      }
+
+      blocks[i] = MemoryBlock(best_offset, size);
+      peak_size = std::max(peak_size, SafeInt<size_t>(best_offset) + size);
+      placed.push_back(i);
+    }
+
+    return peak_size;
+  }
+
   struct OrtValueAllocationBlock {
     int index_{-1};
     MemoryBlock block_;
     const AllocPlanPerValue::ProgramCounter* counter_{nullptr};
     bool reuse_{false};
+    // lifetime in trace steps, only recorded without program counters. allocations that are never freed are live
+    // until the end of the iteration.
+    size_t start_{0};
+    size_t end_{std::numeric_limits<size_t>::max()};
     OrtValueAllocationBlock() = default;
     OrtValueAllocationBlock(int index, const MemoryBlock& block) : index_(index), block_(block), reuse_{false} {}
     OrtValueAllocationBlock(int index, const AllocPlanPerValue::ProgramCounter& counter, const MemoryBlock& block)
@@ -261,6 +376,9 @@ class MemPatternPlanner {
   std::list<int> blocks_;
   SafeInt<size_t> buffer_size_{0};
   bool using_counters_;
+  MemPatternPlannerAlgorithm algorithm_;
+  // incremented on every traced allocation and free.
+  size_t clock_{0};
   mutable OrtMutex lock_;
 };
 
@@ -69,6 +69,21 @@ bool OpKernelContext::TryGetInferredOutputShape(int index, TensorShape& shape) c
   return execution_frame_->TryGetInferredShape(GetOutputArgIndex(index), shape);
 }
 
+Tensor* OpKernelContext::OutputView(int index, int input_index, const TensorShape& shape, ptrdiff_t byte_offset) {
+  if (index < 0 || index >= OutputCount())
+    return nullptr;
+
+  const OrtValue* input = GetInputMLValue(input_index);
+  if (input == nullptr || !input->IsTensor())
+    return nullptr;
+
+  OrtValue* p_ml_value = nullptr;
+  Status status = execution_frame_->GetOrCreateNodeOutputView(GetOutputArgIndex(index), input->Get<Tensor>(), shape,
+                                                              byte_offset, p_ml_value);
+  ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
+}
+
 OrtValue* OpKernelContext::OutputMLValue(int index, const TensorShape& shape) {
   if (index < 0 || index >= OutputCount())
     return nullptr;
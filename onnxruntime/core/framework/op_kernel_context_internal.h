@@ -4,6 +4,7 @@
 #pragma once
 
 #include <functional>
+#include "core/framework/active_run_options.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
 #include "core/session/onnxruntime_c_api.h"
@@ -71,6 +72,9 @@ class OpKernelContextInternal : public OpKernelContext {
 
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
+  // The RunOptions of the Run call, or nullptr if it's unknown or has no run configuration.
+  const RunOptions* GetRunOptions() const { return ActiveRunOptions::Find(terminate_flag_); }
+
  private:
   const SessionState& session_state_;
   const bool& terminate_flag_;
@@ -6,11 +6,13 @@
 #include "core/framework/execution_plan_base.h"
 
 namespace onnxruntime {
-OrtValuePatternPlanner::OrtValuePatternPlanner(const ExecutionPlanBase& execution_plan, bool trace_using_counters)
+OrtValuePatternPlanner::OrtValuePatternPlanner(const ExecutionPlanBase& execution_plan, bool trace_using_counters,
+                                               MemPatternPlannerAlgorithm algorithm)
     : execution_planner_(execution_plan) {
   planner_map_.reserve(execution_plan.GetAllLocations().size());
   for (auto& location : execution_plan.GetAllLocations()) {
-    planner_map_.emplace(location, trace_using_counters);
+    planner_map_.emplace(std::piecewise_construct, std::forward_as_tuple(location),
+                         std::forward_as_tuple(trace_using_counters, algorithm));
   }
 }
 
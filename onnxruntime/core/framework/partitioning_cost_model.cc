@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/partitioning_cost_model.h"
+#include "core/common/inlined_containers.h"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/data_types.h"
+#include "core/framework/op_kernel.h"
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+namespace onnxruntime {
+
+namespace {
+
+// Rough throughputs of memory bound work on the CPU and on a discrete device, and of copies between the two.
+// Only their ratios matter. With these, an island stays on the device when the bytes copied across its boundary are
+// less than about 0.58 times the bytes its nodes read and write.
+constexpr double kCpuBytesPerSecond = 20e9;
+constexpr double kDeviceBytesPerSecond = 500e9;
+constexpr double kCopyBytesPerSecond = 12e9;
+
+// Ops whose cost is dominated by compute rather than by the bytes they move. A device is assumed to always win on
+// these, so islands containing them are kept on the device.
+constexpr std::array<std::string_view, 17> kComputeBoundOps{
+    "Attention",
+    "Conv",
+    "ConvInteger",
+    "ConvTranspose",
+    "Einsum",
+    "FusedConv",
+    "FusedGemm",
+    "FusedMatMul",
+    "GRU",
+    "Gemm",
+    "LSTM",
+    "MatMul",
+    "MatMulInteger",
+    "MultiHeadAttention",
+    "QLinearConv",
+    "QLinearMatMul",
+    "RNN",
+};
+
+bool IsComputeBound(const Node& node) {
+  return std::find(kComputeBoundOps.begin(), kComputeBoundOps.end(), node.OpType()) != kComputeBoundOps.end();
+}
+
+// Size of the tensor in bytes, from its inferred shape. Dimensions of unknown size count as 1, so for a model with
+// dynamic shapes the sizes are per unit of the dynamic dimensions, which keeps their ratios meaningful.
+double GetTensorBytes(const NodeArg& arg) {
+  const auto* type_proto = arg.TypeAsProto();
+  if (type_proto == nullptr || !type_proto->has_tensor_type() ||
+      type_proto->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_UNDEFINED) {
+    return 0.0;
+  }
+
+  double bytes = static_cast<double>(
+      DataTypeImpl::TensorTypeFromONNXEnum(type_proto->tensor_type().elem_type())->GetElementType()->Size());
+  if (const auto* shape = arg.Shape(); shape != nullptr) {
+    for (const auto& dim : shape->dim()) {
+      if (dim.has_dim_value() && dim.dim_value() > 0) {
+        bytes *= static_cast<double>(dim.dim_value());
+      }
+    }
+  }
+  return bytes;
+}
+
+bool IsInitializer(const GraphViewer& graph, const NodeArg& arg) {
+  // initializers are copied to the device once when the session is created
+  return graph.GetGraph().GetInitializer(arg.Name(), true) != nullptr;
+}
+
+bool IsGraphOutput(const GraphViewer& graph, const NodeArg& arg) {
+  const auto& outputs = graph.GetOutputs();
+  return std::find(outputs.begin(), outputs.end(), &arg) != outputs.end();
+}
+
+// Returns true if the island of nodes is estimated to run faster on CPU than on the device
+bool IsIslandCheaperOnCpu(const GraphViewer& graph,
+                          const IExecutionProvider::IKernelLookup& kernel_lookup,
+                          const IExecutionProvider::IKernelLookup& cpu_kernel_lookup,
+                          const InlinedHashSet<NodeIndex>& island) {
+  double work_bytes = 0.0;
+  double copy_bytes = 0.0;
+  InlinedHashSet<const NodeArg*> copied_args;
+
+  for (const NodeIndex node_index : island) {
+    const Node& node = *graph.GetNode(node_index);
+    if (IsComputeBound(node) || node.ContainsSubgraph() || cpu_kernel_lookup.LookUpKernel(node) == nullptr) {
+      return false;
+    }
+
+    const KernelCreateInfo* kernel_create_info = kernel_lookup.LookUpKernel(node);
+    const KernelDef* kernel_def = kernel_create_info != nullptr ? kernel_create_info->kernel_def.get() : nullptr;
+
+    const auto& input_defs = node.InputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      const NodeArg& arg = *input_defs[i];
+      if (!arg.Exists()) {
+        continue;
+      }
+
+      const double bytes = GetTensorBytes(arg);
+      work_bytes += bytes;
+
+      // inputs produced outside of the island are copied to the device, unless the kernel takes them in CPU memory
+      if (IsInitializer(graph, arg) || (kernel_def != nullptr && kernel_def->IsInputOnCpu(i))) {
+        continue;
+      }
+      const Node* producer = graph.GetProducerNode(arg.Name());
+      if ((producer == nullptr || island.count(producer->Index()) == 0) && copied_args.insert(&arg).second) {
+        copy_bytes += bytes;
+      }
+    }
+
+    const auto& output_defs = node.OutputDefs();
+    for (size_t i = 0; i < output_defs.size(); ++i) {
+      const NodeArg& arg = *output_defs[i];
+      if (!arg.Exists()) {
+        continue;
+      }
+
+      const double bytes = GetTensorBytes(arg);
+      work_bytes += bytes;
+
+      // outputs consumed outside of the island are copied from the device, unless the kernel produces them in CPU
+      // memory
+      if (kernel_def != nullptr && kernel_def->IsOutputOnCpu(i)) {
+        continue;
+      }
+      const auto consumers = graph.GetConsumerNodes(arg.Name());
+      const bool consumed_outside = IsGraphOutput(graph, arg) ||
+                                    std::any_of(consumers.begin(), consumers.end(), [&island](const Node* consumer) {
+                                      return consumer != nullptr && island.count(consumer->Index()) == 0;
+                                    });
+      if (consumed_outside && copied_args.insert(&arg).second) {
+        copy_bytes += bytes;
+      }
+    }
+  }
+
+  const double cpu_seconds = work_bytes / kCpuBytesPerSecond;
+  const double device_seconds = work_bytes / kDeviceBytesPerSecond + copy_bytes / kCopyBytesPerSecond;
+  return device_seconds > cpu_seconds;
+}
+
+}  // namespace
+
+std::unordered_set<NodeIndex> GetNodesCheaperOnCpu(const GraphViewer& graph,
+                                                   const IExecutionProvider::IKernelLookup& kernel_lookup,
+                                                   const IExecutionProvider::IKernelLookup& cpu_kernel_lookup,
+                                                   gsl::span<const NodeIndex> tentative_nodes) {
+  const InlinedHashSet<NodeIndex> tentative(tentative_nodes.begin(), tentative_nodes.end());
+  InlinedHashSet<NodeIndex> visited;
+  std::unordered_set<NodeIndex> cpu_nodes;
+
+  for (const NodeIndex start : tentative_nodes) {
+    if (!visited.insert(start).second) {
+      continue;
+    }
+
+    // collect the island of tentative nodes connected to start
+    InlinedHashSet<NodeIndex> island;
+    InlinedVector<NodeIndex> to_visit{start};
+    while (!to_visit.empty()) {
+      const NodeIndex node_index = to_visit.back();
+      to_visit.pop_back();
+      island.insert(node_index);
+
+      const Node* node = graph.GetNode(node_index);
+      if (node == nullptr) {
+        continue;
+      }
+
+      const auto visit_neighbor = [&](const Node& neighbor) {
+        if (tentative.count(neighbor.Index()) != 0 && visited.insert(neighbor.Index()).second) {
+          to_visit.push_back(neighbor.Index());
+        }
+      };
+      for (auto it = node->InputNodesBegin(), end = node->InputNodesEnd(); it != end; ++it) {
+        visit_neighbor(*it);
+      }
+      for (auto it = node->OutputNodesBegin(), end = node->OutputNodesEnd(); it != end; ++it) {
+        visit_neighbor(*it);
+      }
+    }
+
+    if (IsIslandCheaperOnCpu(graph, kernel_lookup, cpu_kernel_lookup, island)) {
+      LOGS_DEFAULT(INFO) << "Cost aware partitioning moves an island of " << island.size()
+                         << " node(s) to CPU, as the copies around it cost more than running it on the device saves.";
+      cpu_nodes.insert(island.begin(), island.end());
+    }
+  }
+
+  return cpu_nodes;
+}
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
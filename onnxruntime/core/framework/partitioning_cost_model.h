@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers_fwd.h"
+#include "core/framework/execution_provider.h"  // for IExecutionProvider::IKernelLookup
+#include "core/graph/graph_viewer.h"
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+namespace onnxruntime {
+
+/**
+  Returns the nodes, of those tentatively placed on a device EP, which are estimated to run faster on CPU.
+  The tentative nodes are grouped into islands of connected nodes. An island is estimated to run faster on CPU when
+  the copies of the tensors crossing its boundary cost more than running its memory bound nodes on the device saves.
+  Islands with compute bound nodes, or with nodes the CPU EP has no kernel for, are kept on the device.
+  @param graph Graph viewer
+  @param kernel_lookup The kernel lookup for the device EP. Used to skip copies of inputs and outputs which the device
+                       kernels take in CPU memory, the same way the memcpy transformer does.
+  @param cpu_kernel_lookup The kernel lookup for the CPU EP
+  @param tentative_nodes Nodes that are tentative to be placed on the device EP
+  */
+std::unordered_set<NodeIndex> GetNodesCheaperOnCpu(const GraphViewer& graph,
+                                                   const IExecutionProvider::IKernelLookup& kernel_lookup,
+                                                   const IExecutionProvider::IKernelLookup& cpu_kernel_lookup,
+                                                   gsl::span<const NodeIndex> tentative_nodes);
+
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -47,6 +47,11 @@ class PrepackedWeightsContainer final {
   // Returns the number of elements in the container
   size_t GetNumberOfElements() const;
 
+  // Returns all PrePackedWeights instances keyed as described above.
+  const std::unordered_map<std::string, PrePackedWeights>& GetWeights() const {
+    return prepacked_weights_map_;
+  }
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
 
   // Resource to be acquired by the method that is going to invoke calls to the kernels'
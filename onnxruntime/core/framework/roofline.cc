@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/roofline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Run fn a few times and return the shortest duration in seconds.
+template <typename TFunc>
+double MeasureBestSeconds(int iterations, TFunc&& fn) {
+  fn();  // warm up
+  double best = 0.0;
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    best = (i == 0) ? seconds : std::min(best, seconds);
+  }
+  return best;
+}
+
+const Tensor* GetInputTensor(const OpKernel& kernel, const OpKernelContextInternal& context, int index) {
+  if (index >= context.InputCount()) {
+    return nullptr;
+  }
+  // pre-packed constant inputs are not in the context
+  const Tensor* tensor = nullptr;
+  if (kernel.Info().TryGetConstantInput(index, &tensor)) {
+    return tensor;
+  }
+  const OrtValue* value = context.GetInputMLValue(index);
+  return (value != nullptr && value->IsTensor()) ? &value->Get<Tensor>() : nullptr;
+}
+
+const Tensor* GetOutputTensor(OpKernelContextInternal& context, int index) {
+  if (index >= context.OutputCount()) {
+    return nullptr;
+  }
+  const OrtValue* value = context.GetOutputMLValue(index);
+  return (value != nullptr && value->IsTensor()) ? &value->Get<Tensor>() : nullptr;
+}
+
+// The multiply-adds per output element of a convolution are the weights of an output channel.
+double ConvolutionFlops(const Tensor& per_element_tensor, const Tensor& weights) {
+  const auto& weight_shape = weights.Shape();
+  if (weight_shape.NumDimensions() == 0 || weight_shape[0] == 0) {
+    return 0.0;
+  }
+  return 2.0 * static_cast<double>(per_element_tensor.Shape().Size()) *
+         static_cast<double>(weight_shape.Size() / weight_shape[0]);
+}
+
+const std::unordered_set<std::string>& ElementwiseOps() {
+  static const std::unordered_set<std::string> ops{
+      "Abs", "Add", "BiasGelu", "Ceil", "Clip", "Cos", "Div", "Elu", "Equal", "Erf", "Exp", "FastGelu", "Floor",
+      "Gelu", "Greater", "HardSigmoid", "HardSwish", "LeakyRelu", "Less", "Log", "Max", "Mean", "Min", "Mod", "Mul",
+      "Neg", "Pow", "PRelu", "QuickGelu", "Reciprocal", "Relu", "Round", "Selu", "Sigmoid", "Sign", "Sin", "Softplus",
+      "Sqrt", "Sub", "Sum", "Tanh", "Where"};
+  return ops;
+}
+
+const std::unordered_set<std::string>& NormalizationOps() {
+  static const std::unordered_set<std::string> ops{
+      "BatchNormalization", "GroupNorm", "InstanceNormalization", "LayerNormalization", "LogSoftmax",
+      "SimplifiedLayerNormalization", "SkipLayerNormalization", "SkipSimplifiedLayerNormalization", "Softmax"};
+  return ops;
+}
+
+}  // namespace
+
+MachinePeaks MeasureCpuPeaks(concurrency::ThreadPool* thread_pool) {
+  MachinePeaks peaks;
+
+  constexpr size_t kGemmSize = 512;
+  std::vector<float> a(kGemmSize * kGemmSize, 1.0f);
+  std::vector<float> b(kGemmSize * kGemmSize, 1.0f);
+  std::vector<float> c(kGemmSize * kGemmSize);
+  const double gemm_seconds = MeasureBestSeconds(5, [&]() {
+    MlasGemm(CblasNoTrans, CblasNoTrans, kGemmSize, kGemmSize, kGemmSize, 1.0f, a.data(), kGemmSize, b.data(),
+             kGemmSize, 0.0f, c.data(), kGemmSize, thread_pool);
+  });
+  if (gemm_seconds > 0.0) {
+    peaks.gflops_per_second = 2.0 * kGemmSize * kGemmSize * kGemmSize / gemm_seconds * 1e-9;
+  }
+
+  // 32 MB per buffer is larger than the last level cache of most CPUs
+  constexpr size_t kCopyBytes = size_t{32} << 20;
+  constexpr std::ptrdiff_t kCopyChunks = 64;
+  std::vector<char> source(kCopyBytes, 1);
+  std::vector<char> destination(kCopyBytes);
+  const double copy_seconds = MeasureBestSeconds(5, [&]() {
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, kCopyChunks, [&](std::ptrdiff_t chunk) {
+      constexpr size_t chunk_bytes = kCopyBytes / kCopyChunks;
+      std::memcpy(destination.data() + chunk * chunk_bytes, source.data() + chunk * chunk_bytes, chunk_bytes);
+    });
+  });
+  if (copy_seconds > 0.0) {
+    // the copy reads and writes each byte
+    peaks.gbytes_per_second = 2.0 * kCopyBytes / copy_seconds * 1e-9;
+  }
+
+  return peaks;
+}
+
+double EstimateNodeFlops(const Node& node, gsl::span<const Tensor* const> inputs,
+                         gsl::span<const Tensor* const> outputs) {
+  const auto get_input = [inputs](size_t index) -> const Tensor* {
+    return index < inputs.size() ? inputs[index] : nullptr;
+  };
+  const std::string& op_type = node.OpType();
+  const Tensor* output = outputs.empty() ? nullptr : outputs[0];
+  if (output == nullptr) {
+    return 0.0;
+  }
+  const double output_size = static_cast<double>(output->Shape().Size());
+
+  if (op_type == "MatMul" || op_type == "FusedMatMul" || op_type == "MatMulInteger" ||
+      op_type == "MatMulIntegerToFloat" || op_type == "QLinearMatMul" || op_type == "DynamicQuantizeMatMul" ||
+      op_type == "MatMulNBits") {
+    const Tensor* a = get_input(0);
+    if (a == nullptr || a->Shape().NumDimensions() == 0) {
+      return 0.0;
+    }
+    // the reduced dimension K is the last one of A, unless it is transposed by FusedMatMul
+    const auto& a_shape = a->Shape();
+    const auto& attributes = node.GetAttributes();
+    const auto trans_a = attributes.find("transA");
+    const bool is_a_transposed = trans_a != attributes.end() && trans_a->second.i() != 0;
+    const size_t k_axis = (is_a_transposed && a_shape.NumDimensions() > 1) ? a_shape.NumDimensions() - 2
+                                                                            : a_shape.NumDimensions() - 1;
+    return 2.0 * output_size * static_cast<double>(a_shape[k_axis]);
+  }
+
+  if (op_type == "Gemm") {
+    const Tensor* a = get_input(0);
+    const auto& y_shape = output->Shape();
+    if (a == nullptr || y_shape.NumDimensions() != 2 || y_shape[0] == 0) {
+      return 0.0;
+    }
+    const double k = static_cast<double>(a->Shape().Size() / y_shape[0]);
+    const bool has_c = get_input(2) != nullptr;
+    return 2.0 * output_size * k + (has_c ? output_size : 0.0);
+  }
+
+  if (op_type == "Conv" || op_type == "FusedConv" || op_type == "ConvInteger" || op_type == "NhwcConv" ||
+      op_type == "NhwcFusedConv" || op_type == "QLinearConv") {
+    const Tensor* weights = get_input(op_type == "QLinearConv" ? 3 : 1);
+    return weights == nullptr ? 0.0 : ConvolutionFlops(*output, *weights);
+  }
+
+  if (op_type == "ConvTranspose") {
+    // each input element is multiplied by the weights of its channel
+    const Tensor* x = get_input(0);
+    const Tensor* weights = get_input(1);
+    return (x == nullptr || weights == nullptr) ? 0.0 : ConvolutionFlops(*x, *weights);
+  }
+
+  if (op_type == "MaxPool" || op_type == "AveragePool" || op_type == "LpPool") {
+    const auto& attributes = node.GetAttributes();
+    const auto kernel_shape = attributes.find("kernel_shape");
+    double window_size = 1.0;
+    if (kernel_shape != attributes.end()) {
+      for (const auto dim : kernel_shape->second.ints()) {
+        window_size *= static_cast<double>(dim);
+      }
+    }
+    return output_size * window_size;
+  }
+
+  if (op_type == "GlobalAveragePool" || op_type == "GlobalMaxPool" || op_type.rfind("Reduce", 0) == 0) {
+    const Tensor* x = get_input(0);
+    return x == nullptr ? 0.0 : static_cast<double>(x->Shape().Size());
+  }
+
+  if (NormalizationOps().count(op_type) != 0) {
+    return 5.0 * output_size;
+  }
+
+  if (ElementwiseOps().count(op_type) != 0) {
+    return output_size;
+  }
+
+  return 0.0;
+}
+
+double EstimateNodeFlops(const OpKernel& kernel, OpKernelContextInternal& context) {
+  InlinedVector<const Tensor*> inputs;
+  for (int i = 0; i < context.InputCount(); ++i) {
+    inputs.push_back(GetInputTensor(kernel, context, i));
+  }
+  const Tensor* output = GetOutputTensor(context, 0);
+  return EstimateNodeFlops(kernel.Node(), inputs, gsl::make_span(&output, 1));
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <gsl/gsl>
+
+namespace onnxruntime {
+
+class Node;
+class OpKernel;
+class OpKernelContextInternal;
+namespace concurrency {
+class ThreadPool;
+}
+class Tensor;
+
+// The peak compute throughput and memory bandwidth the nodes are compared against in a roofline analysis.
+struct MachinePeaks {
+  double gflops_per_second{0.0};
+  double gbytes_per_second{0.0};
+};
+
+// Measure the peaks of the CPU with a single precision GEMM and a copy of buffers larger than the caches, using the
+// threads of the given thread pool. Takes in the order of 100 milliseconds.
+MachinePeaks MeasureCpuPeaks(concurrency::ThreadPool* thread_pool);
+
+// Estimate the floating point or integer operations of the execution of a node from the shapes of its inputs and
+// outputs. The matrix multiplications and convolutions count 2 operations per multiply-add, the element-wise ops 1
+// per output element and the normalizations 5 per element. Ops moving data, e.g. Transpose or Gather, and unknown
+// ops count 0.
+double EstimateNodeFlops(const OpKernel& kernel, OpKernelContextInternal& context);
+
+// The same from the input and output tensors of the node, any of which may be null when absent.
+double EstimateNodeFlops(const Node& node, gsl::span<const Tensor* const> inputs,
+                         gsl::span<const Tensor* const> outputs);
+
+}  // namespace onnxruntime
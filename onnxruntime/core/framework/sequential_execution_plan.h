@@ -35,6 +35,10 @@ struct AllocPlanPerValue {
   // reused_buffer is valid only if alloc_kind == kReuse. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
+  // is_view is valid only if alloc_kind == kReuse. It indicates that reused_buffer holds an input of the
+  // producing node that the kernel may make this OrtValue a view of (see KernelDefBuilder::MayViewOutput).
+  // If the kernel doesn't, the OrtValue gets a buffer of its own.
+  bool is_view{false};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
@@ -109,15 +113,25 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // 3. Wait on a notificaiton
   class ExecutionStep {
    public:
+    // the concrete step classes are in execution_steps.h
+    enum class Type : uint8_t {
+      kBarrier = 0,
+      kWaitOnEP = 1,
+      kLaunchKernel = 2,
+      kActivateNotification = 3,
+      kTriggerDownstream = 4,
+    };
+
     ExecutionStep(NodeIndex node_index) : node_index_(node_index) {}
     virtual ~ExecutionStep() {}
+    virtual Type GetType() const = 0;
     virtual Status Execute(StreamExecutionContext& ctx,
                            size_t stream_idx,
                            SessionScope& session_scope,
                            const bool& terminate_flag,
                            bool& continue_flag) = 0;
     virtual std::string ToString() const = 0;
-    inline NodeIndex GetNodeIndex() { return node_index_; }
+    inline NodeIndex GetNodeIndex() const { return node_index_; }
 
    protected:
     NodeIndex node_index_;
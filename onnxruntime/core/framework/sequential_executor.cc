@@ -4,16 +4,21 @@
 #include "core/framework/sequential_executor.h"
 
 #include <chrono>
+#include <optional>
 #include <thread>
 #include <vector>
 #include <sstream>
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/allocation_trace.h"
+#include "core/framework/calibration_collector.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/session_state.h"
+#include "core/framework/task_graph_executor.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/roofline.h"
 #include "core/framework/utils.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
@@ -155,7 +160,8 @@ class SessionScope {
  public:
   friend class KernelScope;
   SessionScope(const SessionState& session_state, const ExecutionFrame& frame)
-      : session_state_(session_state)
+      : session_state_(session_state),
+        profile_run_(session_state.Profiler().SampleRun())
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
         ,
         frame_(frame)
@@ -176,7 +182,7 @@ class SessionScope {
             session_state_.GetGraphExecutionCounter(), 0}
 #endif
   {
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profile_run_) {
       session_start_ = session_state.Profiler().Start();
     }
 
@@ -224,7 +230,7 @@ class SessionScope {
     }
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (profile_run_) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -249,6 +255,8 @@ class SessionScope {
 
  private:
   const SessionState& session_state_;
+  // Whether the events of this execution are recorded, which the profiler decides per execution when sampling.
+  const bool profile_run_;
   TimePoint session_start_;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
@@ -334,7 +342,7 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_scope_.profile_run_) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
       auto& profiler = session_state_.Profiler();
@@ -359,10 +367,20 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
-    if (session_state_.Profiler().IsEnabled()) {
+    if (session_scope_.profile_run_) {
       auto& profiler = session_state_.Profiler();
+      // the host time only measures the kernels running on the CPU
+      const bool record_node_cost = profiler.IsRooflineEnabled() &&
+                                    kernel_.KernelDef().Provider() == kCpuExecutionProvider;
+      const long long kernel_dur = record_node_cost ? TimeDiffMicroSeconds(kernel_begin_time_) : 0;
       std::string output_type_shape_;
       CalculateTotalOutputSizes(&kernel_context_, total_output_sizes_, node_name_, output_type_shape_);
+      if (record_node_cost) {
+        profiler.RecordNodeCost(node_name_, kernel_.Node().OpType(), kernel_dur,
+                                EstimateNodeFlops(kernel_, kernel_context_),
+                                static_cast<double>(input_activation_sizes_ + input_parameter_sizes_ +
+                                                    total_output_sizes_));
+      }
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_kernel_time",
                                      kernel_begin_time_,
@@ -446,6 +464,11 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+  // attribute the allocations of the kernel and the frees of its inputs to the node in allocation traces
+  AllocationTraceNodeScope allocation_trace_node_scope(idx);
+#ifdef ORT_ENABLE_STREAM
+  ctx.WaitOnInputCopies(idx, stream_idx);
+#endif
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
@@ -453,6 +476,12 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
                                      ctx.GetLogger(),
                                      terminate_flag,
                                      ctx.GetDeviceStream(stream_idx));
+  // kernels of subgraphs run inside the scope of the kernel of their main graph
+  std::optional<concurrency::ThreadPool::WorkShareScope> work_share_scope;
+  if (const auto& work_share = ctx.GetSessionState().GetIntraOpWorkShare()) {
+    work_share_scope.emplace(ctx.GetSessionState().GetThreadPool(), *work_share);
+  }
+
   onnxruntime::Status status;
   auto& logger = ctx.GetLogger();
   if (p_kernel->IsAsync()) {
@@ -484,13 +513,21 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
           }
         }
       }
-      if (!reuse_cached_value) {
+      auto* memoized_run = ctx.GetMemoizedRun();
+      if (memoized_run != nullptr && memoized_run->IsMemoized(idx)) {
+        status = memoized_run->ExecuteNode(ctx.GetSessionState(), idx, *p_kernel, kernel_ctx);
+      } else if (!reuse_cached_value) {
         status = p_kernel->Compute(&kernel_ctx);
       } else {
         status = kernel_ctx.SetOutputMLValue(0, cache.get()->at(cached_arg_name));
       }
 #else
-      status = p_kernel->Compute(&kernel_ctx);
+      auto* memoized_run = ctx.GetMemoizedRun();
+      if (memoized_run != nullptr && memoized_run->IsMemoized(idx)) {
+        status = memoized_run->ExecuteNode(ctx.GetSessionState(), idx, *p_kernel, kernel_ctx);
+      } else {
+        status = p_kernel->Compute(&kernel_ctx);
+      }
 #endif
     }
     ORT_CATCH(const std::exception& ex) {
@@ -514,6 +551,11 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     LOGS(logger, ERROR) << msg_string;
     return Status(status.Category(), status.Code(), msg_string);
   }
+#if !defined(ORT_MINIMAL_BUILD)
+  if (auto* calibration_collector = ctx.GetSessionState().GetCalibrationCollector()) {
+    calibration_collector->CollectNodeOutputs(kernel_ctx, p_kernel->Node());
+  }
+#endif
   ctx.RecycleNodeInputs(idx);
   LOGS(logger, VERBOSE) << "stream " << stream_idx << " launch kernel with idx " << idx;
   return Status::OK();
@@ -572,26 +614,57 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
   ORT_UNUSED_PARAMETER(only_execute_path_to_fetches);
 #endif
 
+  std::unique_ptr<SubgraphMemoizer::Run> memoized_run;
+  if (const auto* memoizer = session_state.GetSubgraphMemoizer()) {
+    memoized_run = memoizer->BeginRun(session_state, feed_mlvalue_idxs, feeds);
+    ctx.SetMemoizedRun(memoized_run.get());
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  if (auto* calibration_collector = session_state.GetCalibrationCollector()) {
+    calibration_collector->CollectGraphInputs(session_state, feed_mlvalue_idxs, feeds);
+  }
+#endif
+
   SessionScope session_scope(session_state, ctx.GetExecutionFrame());
 
-  auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+  // the kernels of a task graph run on the intra-op thread pool, so it needs more than the calling thread
+  const TaskGraph* task_graph = session_state.GetTaskGraph();
+  if (concurrency::ThreadPool::DegreeOfParallelism(session_state.GetThreadPool()) <= 1) {
+    task_graph = nullptr;
+  }
+#ifdef ENABLE_TRAINING
+  if (ctx.GetNodeToExecute() != nullptr) {
+    task_graph = nullptr;
+  }
+#endif
 
-  for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
-    if (execution_plan->execution_plan[i]->steps_.empty()) {
-      // execution context is initialized with number of valid streams
-      // for invalid stream (0 steps), it doesn't count in number of tasks
-      // so don't need to invoke CompleteTask here
-      // ctx.CompleteTask();
-    } else {
-      concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
-        RunSince(i, ctx, session_scope, terminate_flag, 0);
-      });
+  if (task_graph != nullptr) {
+    RunTaskGraph(*task_graph, ctx, session_scope, terminate_flag);
+  } else {
+    auto* tp = single_thread_mode ? nullptr : session_state.GetInterOpThreadPool();
+
+    for (size_t i = 0; i < execution_plan->execution_plan.size(); ++i) {
+      if (execution_plan->execution_plan[i]->steps_.empty()) {
+        // execution context is initialized with number of valid streams
+        // for invalid stream (0 steps), it doesn't count in number of tasks
+        // so don't need to invoke CompleteTask here
+        // ctx.CompleteTask();
+      } else {
+        concurrency::ThreadPool::Schedule(tp, [i, &ctx, &terminate_flag, &session_scope]() {
+          RunSince(i, ctx, session_scope, terminate_flag, 0);
+        });
+      }
     }
-  }
 
-  ctx.WaitAll();
+    ctx.WaitAll();
+  }
   ORT_RETURN_IF_ERROR(ctx.TaskStatus());
   ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GetOutputs(fetches));
+  if (memoized_run) {
+    session_state.GetSubgraphMemoizer()->EndRun(*memoized_run);
+  }
+
   if (ctx.GetExecutionFrame().HasMemoryPatternPlanner()) {
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -604,7 +677,13 @@ onnxruntime::Status ExecuteThePlan(const SessionState& session_state, gsl::span<
     if (all_tensors) {
       MemoryPatternGroup mem_patterns;
       ORT_RETURN_IF_ERROR(ctx.GetExecutionFrame().GeneratePatterns(mem_patterns));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, std::move(mem_patterns)));
+      for (size_t i = 0; i < mem_patterns.locations.size(); ++i) {
+        LOGS(logger, INFO) << "Memory pattern for " << mem_patterns.locations[i].ToString() << ": planned peak "
+                           << mem_patterns.patterns[i].PeakSize() << " bytes, lower bound "
+                           << mem_patterns.patterns[i].LowerBoundSize() << " bytes.";
+      }
+      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(feeds, feed_mlvalue_idxs,
+                                                                        std::move(mem_patterns)));
     }
   }
 
@@ -20,8 +20,9 @@
 namespace onnxruntime {
 
 enum class ExecutionOrder {
-  DEFAULT = 0,        // default topological sort
-  PRIORITY_BASED = 1  // priority-based topological sort
+  DEFAULT = 0,          // default topological sort
+  PRIORITY_BASED = 1,   // priority-based topological sort
+  MEMORY_EFFICIENT = 2  // topological sort that greedily keeps the size of the live tensors small, with lookahead
 };
 
 enum class FreeDimensionOverrideType {
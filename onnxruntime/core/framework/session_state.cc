@@ -3,17 +3,23 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
+#include "core/common/hash_combine.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
+#include "core/framework/execution_plan_flatbuffers_utils.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -87,6 +93,28 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+
+  const std::string shape_bucketing =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternShapeBucketing, "");
+  ORT_ENFORCE(shape_bucketing.empty() || shape_bucketing == "pow2",
+              "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternShapeBucketing, ": ", shape_bucketing,
+              ". Valid values are \"\" and \"pow2\".");
+  mem_pattern_shape_bucketing_ = shape_bucketing == "pow2";
+
+  const std::string mem_pattern_algorithm =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternAlgorithm, "online");
+  ORT_ENFORCE(mem_pattern_algorithm == "online" || mem_pattern_algorithm == "greedy_by_size",
+              "Invalid value for ", kOrtSessionOptionsConfigMemoryPatternAlgorithm, ": ", mem_pattern_algorithm,
+              ". Valid values are \"online\" and \"greedy_by_size\".");
+  mem_pattern_algorithm_ = mem_pattern_algorithm == "greedy_by_size" ? MemPatternPlannerAlgorithm::kGreedyBySize
+                                                                     : MemPatternPlannerAlgorithm::kOnline;
+
+  larger_buffer_reuse_ =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAllowLargerBufferReuse, "0") == "1";
+
+  mem_patterns_.SetMaxBytes(ParseStringWithClassicLocale<size_t>(
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheMaxBytes, "0")));
+
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -213,7 +241,45 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+namespace {
+// Kernels of the CPU EP for the built-in operator domains don't depend on state shared between kernel instances, so
+// they can be created and pre-packed concurrently. Custom op kernels and kernels of other EPs may not be thread-safe.
+bool CanInitializeKernelInParallel(const Node& node) {
+  if (node.GetExecutionProviderType() != kCpuExecutionProvider) {
+    return false;
+  }
+
+  const auto& domain = node.Domain();
+  return domain == kOnnxDomain || domain == kMLDomain || domain == kMSDomain;
+}
+
+// Run `fn` for each index in [0, count) on `thread_pool`. Returns the error of the lowest index that failed, so the
+// status returned does not depend on the thread scheduling.
+template <typename TFn>
+Status ParallelForWithStatus(concurrency::ThreadPool* thread_pool, size_t count, const TFn& fn) {
+  std::vector<Status> statuses(count);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(count),
+      [&fn, &statuses](std::ptrdiff_t i) {
+        ORT_TRY {
+          statuses[i] = fn(static_cast<size_t>(i));
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  for (auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager, bool parallelize) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -222,7 +288,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
     }
     session_kernels_.clear();
     session_kernels_.resize(max_nodeid + 1);
-    for (const auto& node : nodes) {
+
+    auto create_kernel = [this, &kernel_registry_manager](const Node& node) -> Status {
       // construct and save the kernels
       const KernelCreateInfo& kci = GetNodeKernelCreateInfo(node.Index());
 
@@ -230,8 +297,27 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       onnxruntime::ProviderType exec_provider_name = node.GetExecutionProviderType();
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
-      // assumes vector is already resize()'ed to the number of nodes in the graph
-      ORT_RETURN_IF_ERROR(kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]));
+      // assumes vector is already resize()'ed to the number of nodes in the graph.
+      // each node writes to its own slot so this is safe to call concurrently.
+      return kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci, session_kernels_[node.Index()]);
+    };
+
+    parallelize = parallelize && concurrency::ThreadPool::DegreeOfParallelism(thread_pool_) > 1;
+
+    InlinedVector<const Node*> parallel_nodes;
+    for (const auto& node : nodes) {
+      if (parallelize && CanInitializeKernelInParallel(node)) {
+        parallel_nodes.push_back(&node);
+      } else {
+        ORT_RETURN_IF_ERROR(create_kernel(node));
+      }
+    }
+
+    if (!parallel_nodes.empty()) {
+      ORT_RETURN_IF_ERROR(ParallelForWithStatus(thread_pool_, parallel_nodes.size(),
+                                                [&create_kernel, &parallel_nodes](size_t i) {
+                                                  return create_kernel(*parallel_nodes[i]);
+                                                }));
     }
   }
   node_index_info_.emplace(*graph_viewer_, ort_value_name_idx_map_);
@@ -282,6 +368,18 @@ const std::vector<AllocPlanPerValue>& SessionState::GetPerValueAllocPlan() const
   return p_seq_exec_plan_->allocation_plan;
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+Status SessionState::SaveExecutionPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                                  flatbuffers::Offset<fbs::ExecutionPlan>& fbs_plan) const {
+  ORT_RETURN_IF(parent_ != nullptr, "Only the execution plan of the main graph can be saved.");
+  ORT_RETURN_IF_NOT(p_seq_exec_plan_.has_value(), "The session state has not been finalized.");
+  ORT_RETURN_IF(execution_plan_config_hash_ == 0, "The execution plan config hash was not computed. Set ",
+                kOrtSessionOptionsConfigSaveExecutionPlanInOrtFormat, " before initializing the session.");
+
+  return execution_plan_utils::SaveToOrtFormat(builder, *p_seq_exec_plan_, execution_plan_config_hash_, fbs_plan);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 Status SessionState::AddInitializedTensor(int ort_value_index, const OrtValue& ort_value, const OrtCallback* d,
                                           bool constant, bool sparse) {
   auto p = initialized_tensors_.insert({ort_value_index, ort_value});
@@ -384,6 +482,13 @@ static Status KernelUseSharedPrePackedBuffers(OpKernel& kernel, int input_idx,
   return Status::OK();
 }
 
+// the key of a pre-packed weight in the persistent cache
+static std::string GenerateKeyForPrepackedWeightsCache(const Node& node, int input_idx) {
+  std::ostringstream ss;
+  ss << node.OpType() << "+" << node.Name() << "+" << input_idx;
+  return ss.str();
+}
+
 static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
                                                      const PrePackedWeights& pre_packed_weights) {
   std::ostringstream ss_1;
@@ -394,141 +499,350 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+Status SessionState::PrepackWithPersistentCache(const PrepackedWeightsCache& cache, const Node& node, OpKernel& kernel,
+                                                const Tensor& tensor, int input_idx, bool& is_packed, bool& restored,
+                                                SharedWeightsFile::Entry& new_entry) {
+  is_packed = false;
+  restored = false;
+  std::string key = GenerateKeyForPrepackedWeightsCache(node, input_idx);
+  const uint64_t fingerprint = SharedWeightsFile::ComputeFingerprint(tensor);
+  const auto dims = tensor.Shape().GetDims();
+
+  const SharedWeightsFile::Entry* entry = cache.file != nullptr ? cache.file->Find(key) : nullptr;
+  if (entry != nullptr && entry->data_type == 0 && entry->fingerprint == fingerprint &&
+      std::equal(dims.begin(), dims.end(), entry->dims.begin(), entry->dims.end())) {
+    std::vector<BufferUniquePtr> cached_buffers;
+    InlinedVector<size_t> cached_buffer_sizes;
+    for (const auto& buffer : entry->buffers) {
+      // the mapping is read-only. kernels never write to pre-packed weights.
+      cached_buffers.emplace_back(const_cast<void*>(buffer.data), BufferDeleter(nullptr));
+      cached_buffer_sizes.push_back(buffer.size);
+    }
+
+    ORT_RETURN_IF_ERROR(kernel.UseCachedPrePackedBuffers(tensor, cached_buffers, cached_buffer_sizes, input_idx,
+                                                         restored));
+    if (restored) {
+      is_packed = true;
+      return Status::OK();
+    }
+  }
+
+  // ask for the buffers so they can be persisted, and hand them back to the kernel, which owns them
+  AllocatorPtr session_cpu_alloc = GetAllocator(kernel.Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+  PrePackedWeights prepacked_weights;
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, session_cpu_alloc, is_packed, &prepacked_weights));
+  if (!is_packed || prepacked_weights.buffers_.empty()) {
+    return Status::OK();
+  }
+
+  new_entry.name = std::move(key);
+  new_entry.fingerprint = fingerprint;
+  new_entry.dims.assign(dims.begin(), dims.end());
+  std::vector<BufferUniquePtr> owned_buffers;
+  owned_buffers.reserve(prepacked_weights.buffers_.size());
+  for (size_t i = 0; i < prepacked_weights.buffers_.size(); ++i) {
+    new_entry.buffers.push_back(SharedWeightsFile::Buffer{prepacked_weights.buffers_[i].get(),
+                                                          prepacked_weights.buffer_sizes_[i]});
+    owned_buffers.emplace_back(prepacked_weights.buffers_[i].release(), BufferDeleter(session_cpu_alloc));
+  }
+
+  bool used_shared_buffers = false;
+  ORT_RETURN_IF_ERROR(kernel.UseSharedPrePackedBuffers(owned_buffers, input_idx, used_shared_buffers));
+  ORT_RETURN_IF_NOT(used_shared_buffers, "The kernel corresponding to the node ", node.Name(),
+                    " doesn't have an implementation that can consume provided pre-packed weights");
+  return Status::OK();
+}
+
 Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
-                  // weight with the pre-packed weight generated by this instance of the same op_type because other static
-                  // properties of the node like node attributes could play a role in the pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
-                                                                                                           weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
-
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-                    } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key, std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
-                                                                          node.Name()));
-                    }
-                  }
-
-                } else {  // caching of pre-packed weights' turned OFF
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
-                                                      session_cpu_alloc,  // use allocator tied to this session
-                                                      is_packed,
-                                                      nullptr  // no caching required
-                                                      ));
-                }
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
-
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
-                  }
-                }
-              }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
-              }
+                                                       const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                                       bool parallelize) {
+  // a constant initialized tensor used by a node input
+  struct PrePackInput {
+    SessionState* owner;  // the session state (this or an ancestor) holding the constant initialized tensor
+    int ort_value_idx;
+    int input_idx;
+    const std::string* input_name;
+    bool cache_prepacked_weights;
+    PrePackedWeights weights_to_be_filled_in;
+    bool is_packed = false;
+    // true if the weight is looked up in and added to the persistent cache
+    bool use_persistent_cache = false;
+    bool restored_from_persistent_cache = false;
+    // the pre-packed weight to add to the persistent cache. the buffers are owned by the kernel.
+    SharedWeightsFile::Entry new_cache_entry;
+  };
+
+  struct NodePrePackWork {
+    const Node* node;
+    OpKernel* kernel;
+    InlinedVector<PrePackInput> inputs;
+  };
+
+  const bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
+
+  const SessionState* root = this;
+  while (root->parent_ != nullptr) {
+    root = root->parent_;
+  }
+  PrepackedWeightsCache* const persistent_cache = root->prepacked_weights_cache_;
+
+  // find the constant initialized tensors used by `node`
+  auto collect_inputs = [this, &initializers_to_share_map, should_cache_prepacked_weights_for_shared_initializers,
+                         persistent_cache](const Node& node, NodePrePackWork& work) {
+    work.node = &node;
+    work.kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            // the lazily read initializers are not pre-packed, so creating the session does not read them
+            if (st->constant_initialized_tensors_.count(ort_value_idx) &&
+                st->lazy_initializers_.count(ort_value_idx) == 0) {
+              bool is_shared_initializer = initializers_to_share_map.find(input_name) != initializers_to_share_map.end();
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+              bool cache_prepacked_weights = is_shared_initializer &&
+                                             should_cache_prepacked_weights_for_shared_initializers &&
+                                             node.GetExecutionProviderType() == kCpuExecutionProvider;
+
+              work.inputs.push_back(PrePackInput{st, ort_value_idx, input_idx, &input_name, cache_prepacked_weights,
+                                                 PrePackedWeights{}});
+              // weights shared through the container are not persisted as the container owns them
+              work.inputs.back().use_persistent_cache = persistent_cache != nullptr && !cache_prepacked_weights &&
+                                                        node.GetExecutionProviderType() == kCpuExecutionProvider;
+            }
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
             }
-            st = st->Parent();
-          } while (st);
+          }
+          st = st->Parent();
+        } while (st);
+      }
+      input_idx++;
+    }
+  };
+
+  AllocatorPtr allocator_for_caching;
+  if (should_cache_prepacked_weights_for_shared_initializers) {
+    allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+    ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+  }
+
+  // call PrePack() for the inputs of a node. this only touches the kernel and `work` so it can run concurrently
+  // for different nodes.
+  auto prepack_node = [this, &allocator_for_caching, persistent_cache](NodePrePackWork& work) -> Status {
+    for (auto& input : work.inputs) {
+      const Tensor& const_initialized_tensor = input.owner->constant_initialized_tensors_.at(input.ort_value_idx).Get<Tensor>();
+      if (input.use_persistent_cache) {
+        ORT_RETURN_IF_ERROR(PrepackWithPersistentCache(*persistent_cache, *work.node, *work.kernel,
+                                                       const_initialized_tensor, input.input_idx, input.is_packed,
+                                                       input.restored_from_persistent_cache, input.new_cache_entry));
+      } else if (input.cache_prepacked_weights) {  // caching of pre-packed weights' turned ON
+        // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+        // cached by another instance of the same op_type (for the same constant initializer) is because
+        // to truly know if we can use a cached pre-packed weight, we would have to compare the cached pre-packed
+        // weight with the pre-packed weight generated by this instance of the same op_type because other static
+        // properties of the node like node attributes could play a role in the pre-packed weights' contents.
+        ORT_RETURN_IF_ERROR(work.kernel->PrePack(const_initialized_tensor, input.input_idx, allocator_for_caching,
+                                                 input.is_packed,
+                                                 &input.weights_to_be_filled_in));
+      } else {  // caching of pre-packed weights' turned OFF
+        AllocatorPtr session_cpu_alloc = GetAllocator(work.kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+        ORT_RETURN_IF_ERROR(work.kernel->PrePack(const_initialized_tensor, input.input_idx,
+                                                 session_cpu_alloc,  // use allocator tied to this session
+                                                 input.is_packed,
+                                                 nullptr  // no caching required
+                                                 ));
+      }
+    }
+
+    return Status::OK();
+  };
+
+  // share the pre-packed weights through the container and release the constant initialized tensors that are no
+  // longer needed. this is always done in node order so the result does not depend on the thread scheduling.
+  auto apply_prepacked_weights = [this, &constant_initializers_use_count, persistent_cache](NodePrePackWork& work) -> Status {
+    const Node& node = *work.node;
+    for (auto& input : work.inputs) {
+      if (!input.is_packed) {
+        continue;
+      }
+
+      const std::string& input_name = *input.input_name;
+      if (input.restored_from_persistent_cache) {
+        ++restored_pre_packed_weights_counter_;
+      } else if (!input.new_cache_entry.buffers.empty()) {
+        std::lock_guard<OrtMutex> lock(persistent_cache->mutex);
+        persistent_cache->new_entries.push_back(std::move(input.new_cache_entry));
+      }
+
+      if (input.cache_prepacked_weights) {
+        // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight to be cached if the weight was pre-packed
+        ORT_ENFORCE(input.weights_to_be_filled_in.buffers_.size() > 0, "The kernel corresponding to the node ", node.Name(),
+                    " doesn't have an implementation that can cache computed pre-packed weights");
+
+        const auto& op_type = node.OpType();
+
+        // Sanity check
+        // TODO: Check if some version of the ONNX IR allows op_type to be empty
+        ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+        // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+        // that we just got by invoking PrePack() on this kernel.
+
+        const std::string& prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(op_type,
+                                                                                               input.weights_to_be_filled_in);
+
+        bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(prepacked_weights_container_key);
+
+        if (container_contains_packed_weight) {
+          LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: " << input_name
+                              << " used in the node: " << node.Name() << " which is of op type: " << node.OpType();
+
+          ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*work.kernel, input.input_idx,
+                                                              prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                              node.Name()));
+
+          ++used_shared_pre_packed_weights_counter_;
+        } else {  // container doesn't contain the pre-packed weight - so write into it for sharing across kernel instances
+
+          if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
+                                                         std::move(input.weights_to_be_filled_in))) {
+            return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unable to write the provided PrePackedWeights instance into the container");
+          }
+
+          ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*work.kernel, input.input_idx,
+                                                              prepacked_weights_container_->GetWeight(prepacked_weights_container_key),
+                                                              node.Name()));
         }
-        input_idx++;
+
+        // free the buffers of a duplicate pre-packed weight now rather than when the batch completes
+        input.weights_to_be_filled_in = PrePackedWeights{};
+      }
+
+      if (!input.restored_from_persistent_cache) {
+        ++number_of_prepacks_counter_;
+      }
+
+      if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+        // release the constant initialized tensor
+        input.owner->initialized_tensors_.erase(input.ort_value_idx);
+        input.owner->constant_initialized_tensors_.erase(input.ort_value_idx);
       }
     }
 
     return Status::OK();
   };
 
-  bool should_cache_prepacked_weights_for_shared_initializers = (prepacked_weights_container_ != nullptr);
+  auto prepacked_constant_weights = [&]() -> Status {
+    const int degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(thread_pool_);
+    parallelize = parallelize && degree_of_parallelism > 1;
+
+    // nodes are processed in batches so that the original and the pre-packed versions of a weight only co-exist for
+    // the nodes in a batch. without parallelization every node is its own batch, which matches the serial behavior.
+    const size_t batch_size = parallelize ? static_cast<size_t>(degree_of_parallelism) * 4 : 1;
+
+    InlinedVector<NodePrePackWork> batch;
+    InlinedVector<size_t> parallel_work;
+    batch.reserve(batch_size);
+
+    auto process_batch = [&]() -> Status {
+      parallel_work.clear();
+      for (size_t i = 0; i < batch.size(); ++i) {
+        if (parallelize && CanInitializeKernelInParallel(*batch[i].node)) {
+          parallel_work.push_back(i);
+        } else {
+          ORT_RETURN_IF_ERROR(prepack_node(batch[i]));
+        }
+      }
+
+      if (!parallel_work.empty()) {
+        ORT_RETURN_IF_ERROR(ParallelForWithStatus(thread_pool_, parallel_work.size(),
+                                                  [&prepack_node, &batch, &parallel_work](size_t i) {
+                                                    return prepack_node(batch[parallel_work[i]]);
+                                                  }));
+      }
+
+      for (auto& work : batch) {
+        ORT_RETURN_IF_ERROR(apply_prepacked_weights(work));
+      }
+
+      batch.clear();
+      return Status::OK();
+    };
+
+    for (auto& node : GetGraphViewer().Nodes()) {
+      NodePrePackWork work;
+      collect_inputs(node, work);
+      if (work.inputs.empty()) {
+        continue;
+      }
+
+      batch.push_back(std::move(work));
+      if (batch.size() == batch_size) {
+        ORT_RETURN_IF_ERROR(process_batch());
+      }
+    }
+
+    return process_batch();
+  };
 
   if (should_cache_prepacked_weights_for_shared_initializers) {
     // serialize calls to the method that looks up the container, calls UseCachedPrePackedWeight/PrePack
     // and writes pre-packed weights to the container
     std::lock_guard<onnxruntime::OrtMutex> l(prepacked_weights_container_->mutex_);
-    return prepacked_constant_weights(true);
+    return prepacked_constant_weights();
   } else {
-    return prepacked_constant_weights(false);
+    return prepacked_constant_weights();
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
-  for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+namespace {
+int64_t RoundUpToPowerOfTwo(int64_t value) {
+  int64_t result = 1;
+  while (result < value) {
+    result <<= 1;
   }
-  return key;
+  return value <= 0 ? value : result;
+}
+}  // namespace
+
+int64_t SessionState::CalculateMemoryPatternsKey(gsl::span<const OrtValue> tensor_inputs,
+                                                 gsl::span<const int> feed_mlvalue_idxs,
+                                                 InlinedVector<int64_t>& bucketed_dims) const {
+  bucketed_dims.clear();
+  if (!mem_pattern_shape_bucketing_) {
+    int64_t key = 0;
+    for (const auto& input : tensor_inputs) {
+      for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+    }
+    return key;
+  }
+
+  size_t key = 0;
+  for (size_t i = 0, end = tensor_inputs.size(); i < end; ++i) {
+    const auto dims = tensor_inputs[i].Get<Tensor>().Shape().GetDims();
+    const auto bucketed = i < feed_mlvalue_idxs.size() ? mem_pattern_bucketed_dims_.find(feed_mlvalue_idxs[i])
+                                                       : mem_pattern_bucketed_dims_.end();
+    HashCombine(dims.size(), key);
+    for (size_t d = 0; d < dims.size(); ++d) {
+      const bool round_up = bucketed != mem_pattern_bucketed_dims_.end() && d < bucketed->second.size() &&
+                            bucketed->second[d];
+      HashCombine(round_up ? RoundUpToPowerOfTwo(dims[d]) : dims[d], key);
+      bucketed_dims.push_back(dims[d]);
+    }
+  }
+
+  return static_cast<int64_t>(key);
 }
 
 #ifdef ENABLE_TRAINING
@@ -765,29 +1079,33 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+void SessionState::GetMemoryPatternCacheStats(size_t& hits, size_t& misses) const {
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  hits = mem_patterns_.Hits();
+  misses = mem_patterns_.Misses();
+}
+
+// MemoryPatternGroup is only inserted upon creation and is not updated if already present,
+// unless shape bucketing is enabled and the new pattern was generated for larger input shapes.
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     gsl::span<const OrtValue> tensor_inputs,
     gsl::span<const int> feed_mlvalue_idxs,
     const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
   out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  InlinedVector<int64_t> bucketed_dims;
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, feed_mlvalue_idxs, bucketed_dims);
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
+  auto patterns = mem_patterns_.Find(key, bucketed_dims);
+  if (!patterns) {
 #ifdef ENABLE_TRAINING
     MemoryPatternGroup mem_patterns;
     InlinedHashMap<int, TensorShape> inferred_shapes;
     if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
+      auto ptr = mem_patterns_.Insert(key, std::move(mem_patterns), bucketed_dims, /*replace_if_covering*/ true);
       auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
       out_inferred_shapes = &shape_insert.first->second;
       return ptr;
     }
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
 #endif
     return nullptr;
   }
@@ -796,7 +1114,7 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
   if (patt_hit != shape_patterns_.cend()) {
     out_inferred_shapes = &patt_hit->second;
   }
-  return &it->second;
+  return patterns;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -830,6 +1148,35 @@ void SessionState::ResolveMemoryPatternFlag() {
     if (multi_stream)
       enable_mem_pattern_ = false;
 
+    if (enable_mem_pattern_ && mem_pattern_shape_bucketing_) {
+      // by default every free dim is bucketed. optionally limit that to the listed dim params.
+      InlinedHashSet<std::string> dim_params;
+      const std::string bucketed_dim_params =
+          sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternBucketedDims, "");
+      for (const auto& dim_param : utils::SplitString(bucketed_dim_params, ",")) {
+        dim_params.emplace(dim_param);
+      }
+
+      mem_pattern_bucketed_dims_.clear();
+      for (const auto* input : graph_viewer_->GetInputs()) {
+        int idx = -1;
+        const auto* shape = input->Shape();
+        if (shape == nullptr || !ort_value_name_idx_map_.GetIdx(input->Name(), idx).IsOK()) {
+          continue;
+        }
+
+        InlinedVector<bool> bucketed;
+        bucketed.reserve(shape->dim_size());
+        for (const auto& dim : shape->dim()) {
+          bucketed.push_back(!utils::HasDimValue(dim) &&
+                             (dim_params.empty() ||
+                              (utils::HasDimParam(dim) && dim_params.count(dim.dim_param()) > 0)));
+        }
+
+        mem_pattern_bucketed_dims_.insert_or_assign(idx, std::move(bucketed));
+      }
+    }
+
     // For subgraphs, the implicit inputs need to meet the same crieria
     // as the explicit inputs for memory pattern to be enabled
     if (graph_viewer_->IsSubgraph()) {
@@ -846,12 +1193,15 @@ void SessionState::ResolveMemoryPatternFlag() {
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
+                                                   gsl::span<const int> feed_mlvalue_idxs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  InlinedVector<int64_t> bucketed_dims;
+  int64_t key = CalculateMemoryPatternsKey(tensor_inputs, feed_mlvalue_idxs, bucketed_dims);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  // Do not update if present unless the new pattern covers larger shapes in the same bucket.
+  // Replacing is safe as execution frames hold a reference to the pattern they are using.
+  mem_patterns_.Insert(key, std::move(mem_patterns), bucketed_dims, /*replace_if_covering*/ !bucketed_dims.empty());
   return Status::OK();
 }
 
@@ -1182,8 +1532,24 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
 
   InlinedHashMap<std::string, size_t> constant_initializers_use_count;
   ComputeConstantInitializerUseCount(graph_, constant_initializers_use_count);
-  return FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
-                                  remove_initializers, constant_initializers_use_count);
+  ORT_RETURN_IF_ERROR(FinalizeSessionStateImpl(graph_location, kernel_registry_manager, nullptr, sess_options_,
+                                               remove_initializers, constant_initializers_use_count));
+
+  // the OS reads the lazily read initializers in the background, in the order the first Run reads them
+  AdviseLazyInitializers(Env::MappedMemoryAdvice::kWillNeed);
+  return Status::OK();
+}
+
+void SessionState::AdviseLazyInitializers(Env::MappedMemoryAdvice advice) const {
+  for (const auto& data : lazy_initializer_data_) {
+    Env::Default().AdviseMappedMemory(data.data(), data.size(), advice);
+  }
+
+  for (const auto& node_to_subgraph_ss : subgraph_session_states_) {
+    for (const auto& attr_name_to_subgraph_ss : node_to_subgraph_ss.second) {
+      attr_name_to_subgraph_ss.second->AdviseLazyInitializers(advice);
+    }
+  }
 }
 
 static Status Index(const OrtValueNameIdxMap& ort_value_name_idx_map,
@@ -1372,9 +1738,35 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
-  SequentialPlannerContext context(session_options.execution_mode,
+  size_t max_cpu_streams = 0;
+  if (parent_node == nullptr && session_options.execution_mode == ExecutionMode::ORT_PARALLEL &&
+      session_options.execution_order == ExecutionOrder::DEFAULT) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMaxCpuStreams, "0"),
+        max_cpu_streams));
+  }
+
+  size_t memory_budget = 0;
+  if (parent_node == nullptr) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryBudgetBytes, "0"),
+        memory_budget));
+  }
+
+  // the kernels of a task graph run out of order, so buffers can't be reused between values, as in parallel execution
+  const bool task_graph_execution =
+      parent_node == nullptr && session_options.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTaskGraphExecution, "0") == "1";
+  if (task_graph_execution) {
+    enable_mem_pattern_ = false;
+  }
+
+  SequentialPlannerContext context(task_graph_execution ? ExecutionMode::ORT_PARALLEL : session_options.execution_mode,
                                    session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+                                   session_options.enable_mem_reuse,
+                                   max_cpu_streams,
+                                   larger_buffer_reuse_,
+                                   memory_budget);
 
 #ifdef _WIN32
 
@@ -1390,18 +1782,78 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
 
 #endif
 
-  auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
-                                              execution_providers_, kernel_create_info_map_,
-                                              subgraphs_kernel_create_info_maps,
-                                              outer_scope_node_arg_to_location_map,
-                                              ort_value_name_idx_map_, context,
+  // record the time taken by each phase of the finalization in the session profiler
+  const bool profiling_enabled = profiler_.IsEnabled();
+  TimePoint phase_start_time;
+  if (profiling_enabled) {
+    phase_start_time = profiler_.Start();
+  }
+
+  auto record_phase = [this, profiling_enabled, &phase_start_time](const char* phase_name) {
+    if (profiling_enabled) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, phase_name, phase_start_time,
+                                      {{"graph", graph_viewer_->Name()}});
+      phase_start_time = profiler_.Start();
+    }
+  };
+
+  // the execution plan of the main graph can be loaded from an ORT format model, or saved to one
+  const bool use_serialized_plan =
+      parent_node == nullptr && serialized_execution_plan_ != nullptr &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseSavedExecutionPlan, "1") == "1";
+  const bool save_plan =
+      parent_node == nullptr &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveExecutionPlanInOrtFormat,
+                                                        "0") == "1";
+  if (use_serialized_plan || save_plan) {
+    execution_plan_config_hash_ = execution_plan_utils::ComputeConfigHash(*graph_viewer_, ort_value_name_idx_map_,
+                                                                          execution_providers_, context,
+                                                                          partition_config_file);
+  }
+
+  execution_plan_from_ort_format_ = false;
+  if (use_serialized_plan) {
+    if (serialized_execution_plan_->config_hash() != execution_plan_config_hash_) {
+      LOGS(Logger(), INFO) << "The execution plan in the ORT format model was created for a different graph or "
+                              "session configuration. Creating a new plan.";
+    } else {
+      const auto status = execution_plan_utils::LoadFromOrtFormat(*serialized_execution_plan_, *graph_viewer_,
+                                                                  ort_value_name_idx_map_,
 #ifdef ORT_ENABLE_STREAM
-                                              GetStreamHandleRegistryInstance(),
+                                                                  &GetStreamHandleRegistryInstance(),
+#else
+                                                                  nullptr,
 #endif
-                                              partition_config_file,
-                                              Logger(),
-                                              p_seq_exec_plan_);
-  ORT_RETURN_IF_ERROR(status);
+                                                                  p_seq_exec_plan_);
+      if (status.IsOK()) {
+        execution_plan_from_ort_format_ = true;
+      } else {
+        LOGS(Logger(), WARNING) << "Failed to load the execution plan from the ORT format model. "
+                                   "Creating a new plan. Error: "
+                                << status.ErrorMessage();
+      }
+    }
+  }
+
+  // the plan is only needed until the session state is finalized, and the model bytes may be released afterwards
+  serialized_execution_plan_ = nullptr;
+
+  if (!execution_plan_from_ort_format_) {
+    auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
+                                                execution_providers_, kernel_create_info_map_,
+                                                subgraphs_kernel_create_info_maps,
+                                                outer_scope_node_arg_to_location_map,
+                                                ort_value_name_idx_map_, context,
+#ifdef ORT_ENABLE_STREAM
+                                                GetStreamHandleRegistryInstance(),
+#endif
+                                                partition_config_file,
+                                                Logger(),
+                                                p_seq_exec_plan_);
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  record_phase("session_state_execution_planning");
 
   // Record the allocation plan
 
@@ -1467,28 +1919,70 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
       }
     }
   }
+
+  // the copies on the input copy streams aren't captured in CUDA graphs
+  use_input_copy_streams_ =
+      has_device_stream_enabled_ep_ && graph_viewer_->ParentNode() == nullptr &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseInputCopyStreams, "0") == "1" &&
+      std::none_of(execution_providers_.begin(), execution_providers_.end(),
+                   [](const auto& ep) { return ep->IsGraphCaptureEnabled(); });
 #endif
 
+  const std::string lazy_external_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigLazyExternalInitializers, "0");
+  lazy_initializers_cold_after_run_ = lazy_external_initializers == "2";
+  InlinedHashMap<int, gsl::span<const std::byte>> lazy_initializer_data;
+
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInitializedTensors(
           Env::Default(), graph_location, *graph_viewer_,
           GetAllocator(OrtDevice()),
           ort_value_name_idx_map_, initializer_allocation_order, *tensor_allocator,
-          [this, remove_initializers](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
-                                      bool constant, bool sparse) -> Status {
+          [this, remove_initializers, lazy = lazy_external_initializers != "0", &lazy_initializer_data,
+           &session_options](const std::string& name, int idx, const OrtValue& value, const OrtCallback& d,
+                             bool constant, bool sparse) -> Status {
             ORT_RETURN_IF_ERROR(AddInitializedTensor(idx, value, &d, constant, sparse));
+            // the CPU tensors with external data in a file use the mapped file, unless the user supplied them
+            const ONNX_NAMESPACE::TensorProto* tensor_proto = nullptr;
+            if (lazy && constant && value.IsTensor() &&
+                value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU &&
+                session_options.initializers_to_share_map.find(name) ==
+                    session_options.initializers_to_share_map.end() &&
+                graph_.GetInitializedTensor(name, tensor_proto) && utils::HasExternalDataInFile(*tensor_proto)) {
+              const Tensor& tensor = value.Get<Tensor>();
+              lazy_initializers_.insert(idx);
+              lazy_initializer_data.emplace(
+                  idx, gsl::make_span(static_cast<const std::byte*>(tensor.DataRaw()), tensor.SizeInBytes()));
+            }
             if (remove_initializers) {
               graph_.RemoveInitializedTensor(name);
             }
             return Status::OK();
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_, session_options, memory_profile_func, thread_pool_));
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
   GetMemoryProfiler()->GetMemoryInfo().RecordInitializerAllocInfo(GetInitializedTensors());
 #endif
 
+  // order the lazily read initializers as their nodes run
+  if (!lazy_initializer_data.empty()) {
+    for (NodeIndex node_index : graph_viewer_->GetNodesInTopologicalOrder(session_options.execution_order)) {
+      graph_viewer_->GetNode(node_index)->ForEachDef([&](const NodeArg& arg, bool is_input) {
+        int idx;
+        if (!is_input || !arg.Exists() || !ort_value_name_idx_map_.GetIdx(arg.Name(), idx).IsOK()) {
+          return;
+        }
+        auto it = lazy_initializer_data.find(idx);
+        if (it != lazy_initializer_data.end()) {
+          lazy_initializer_data_.push_back(it->second);
+          lazy_initializer_data.erase(it);
+        }
+      });
+    }
+  }
+
   // remove weights from the graph now to save memory but in many cases it won't save memory, if the tensor was
   // preallocated with the some other tensors in a single 'allocate' call, which is very common.
   // TODO: make it better
@@ -1496,16 +1990,51 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  record_phase("session_state_initializer_saving");
+
+  const bool parallelize_kernel_initialization =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableParallelKernelCreation,
+                                                        "0") != "1";
+
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, parallelize_kernel_initialization));
+  record_phase("session_state_kernel_creation");
 
   if (!disable_prepacking) {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          parallelize_kernel_initialization));
+    record_phase("session_state_prepacking");
   }
 
   ORT_RETURN_IF_ERROR(
       session_state_utils::SaveInputOutputNamesToNodeMapping(*graph_viewer_, *this, valid_outer_scope_node_args));
 
+  if (parent_node == nullptr) {
+    SubgraphMemoizer::Config memoization_config;
+    bool enable_memoization = false;
+    ORT_RETURN_IF_ERROR(SubgraphMemoizer::ParseConfig(
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoizationInputs, ""),
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoizationMaxEntries, ""),
+        memoization_config, enable_memoization));
+
+    if (enable_memoization) {
+      ORT_RETURN_IF_ERROR(SubgraphMemoizer::Create(*graph_viewer_, GetOrtValueNameIdxMap(), memoization_config,
+                                                   subgraph_memoizer_));
+      LOGS(logger_, INFO) << "Memoizing "
+                          << (subgraph_memoizer_ ? subgraph_memoizer_->NumMemoizedNodes() : 0)
+                          << " nodes depending on the inputs " << session_options.config_options.GetConfigOrDefault(
+                                                                     kOrtSessionOptionsConfigMemoizationInputs, "");
+    }
+
+    if (task_graph_execution) {
+      if (subgraph_memoizer_) {
+        LOGS(logger_, INFO) << "Not using task graph execution as memoization is enabled.";
+      } else {
+        task_graph_ = BuildTaskGraph(*this, logger_);
+      }
+    }
+  }
+
   // Need to recurse into subgraph session state instances to finalize them and add the execution info
 
   // Currently all subgraphs need to be executed using the sequential EP due to potential deadlock with the current
@@ -1587,9 +2116,7 @@ std::unique_ptr<DeviceStreamCollection> SessionState::AcquireDeviceStreamCollect
       device_stream_pool_.pop_back();
       return device_stream;
     } else {
-      auto device_stream = std::make_unique<DeviceStreamCollection>(this->GetExecutionPlan()->execution_plan.size(), *allocators_, graph_viewer_->ParentNode() == nullptr);
-      BindToDeviceStream(*this->GetExecutionPlan(), *device_stream, *stream_handles_registry_);
-      return device_stream;
+      return CreateDeviceStreamCollection();
     }
   } else {
     // no reusing of device stream is needed, just return nullptr, the caller will handle it
@@ -1597,6 +2124,33 @@ std::unique_ptr<DeviceStreamCollection> SessionState::AcquireDeviceStreamCollect
   }
 }
 
+std::unique_ptr<DeviceStreamCollection> SessionState::CreateDeviceStreamCollection() const {
+  auto device_stream = std::make_unique<DeviceStreamCollection>(this->GetExecutionPlan()->execution_plan.size(), *allocators_, graph_viewer_->ParentNode() == nullptr);
+  BindToDeviceStream(*this->GetExecutionPlan(), *device_stream, *stream_handles_registry_);
+  if (use_input_copy_streams_) {
+    // one input copy stream per device with streams in the execution plan
+    for (const auto& logic_stream : this->GetExecutionPlan()->execution_plan) {
+      const OrtDevice& device = logic_stream->device_;
+      auto create_stream_fn = stream_handles_registry_->GetCreateStreamFn(device.Type());
+      if (logic_stream->steps_.size() > 0 && create_stream_fn && !device_stream->GetInputCopyStream(device)) {
+        device_stream->AddInputCopyStream(create_stream_fn(device));
+      }
+    }
+  }
+  return device_stream;
+}
+
+void SessionState::FillDeviceStreamPool(size_t pool_size) const {
+  if (!has_device_stream_enabled_ep_) {
+    return;
+  }
+
+  std::lock_guard<onnxruntime::OrtMutex> lock(device_stream_pool_mutex_);
+  while (device_stream_pool_.size() < pool_size) {
+    device_stream_pool_.push_back(CreateDeviceStreamCollection());
+  }
+}
+
 void SessionState::RecycleDeviceStreamCollection(std::unique_ptr<DeviceStreamCollection> device_stream_collection) const {
   // if no need to reuse the device stream, don't perform the recycle
   if (has_device_stream_enabled_ep_) {
@@ -19,18 +19,24 @@
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/stream_execution_context.h"
+#include "core/framework/subgraph_memoizer.h"
+#include "core/framework/task_graph_executor.h"
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/shared_weights_file.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_cache.h"
+#include "core/framework/mem_pattern_planner.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/platform/env.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/path_lib.h"
 #include "core/platform/threadpool.h"
@@ -52,6 +58,7 @@ struct Offset;
 namespace onnxruntime {
 
 namespace fbs {
+struct ExecutionPlan;
 struct SessionState;
 }  // namespace fbs
 
@@ -65,6 +72,9 @@ class DeviceStreamCollection;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
+#if !defined(ORT_MINIMAL_BUILD)
+class CalibrationCollector;
+#endif
 
 /**
  * SessionState should be modified by the inference session class only.
@@ -223,8 +233,9 @@ class SessionState {
   made under mutex being held. In inference scenarios,
   it is not mutable, we do not obtain a lock and simply get a pointer
   w/o copying a hashtable
+  The returned pattern group stays valid while the caller holds it, even if it is evicted from the cache.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
       gsl::span<const int> feed_mlvalue_idxs,
       const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
@@ -235,8 +246,24 @@ class SessionState {
   All inputs must represent Tensors
   */
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
+                                       gsl::span<const int> feed_mlvalue_idxs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Whether memory patterns are shared by all input shapes that round up to the same bucket.
+  If so, a block in a pattern can be used for any tensor that fits into it.
+  */
+  bool GetMemoryPatternShapeBucketing() const noexcept { return mem_pattern_shape_bucketing_; }
+
+  // Number of runs that found their memory pattern in the cache, and that did not.
+  void GetMemoryPatternCacheStats(size_t& hits, size_t& misses) const;
+
+  // How the memory patterns generated by the runs of this session place the tensors.
+  MemPatternPlannerAlgorithm GetMemoryPatternPlannerAlgorithm() const noexcept { return mem_pattern_algorithm_; }
+
+  // Whether the allocation planner may reuse a freed buffer that is larger than the value it is reused for.
+  bool GetEnableLargerBufferReuse() const noexcept { return larger_buffer_reuse_; }
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -298,6 +325,14 @@ class SessionState {
 
   const DataTransferManager& GetDataTransferMgr() const noexcept { return data_transfer_mgr_; }
 
+  // Memoizer for the nodes depending only on the inputs configured with "session.memoization.inputs".
+  // nullptr if memoization is not enabled or there are no such nodes. Only set for the main graph.
+  const SubgraphMemoizer* GetSubgraphMemoizer() const noexcept { return subgraph_memoizer_.get(); }
+
+  // Dependencies between the kernels of the execution plan for "session.experimental_task_graph_execution".
+  // nullptr if it is not enabled or the plan doesn't qualify. Only set for the main graph.
+  const TaskGraph* GetTaskGraph() const noexcept { return task_graph_.get(); }
+
   InlinedVector<BufferUniquePtr>& GetMutableWeightsBuffers() noexcept { return weights_buffers_; }
 
   const NodeIndexInfo& GetNodeIndexInfo() const;
@@ -311,6 +346,24 @@ class SessionState {
                               bool remove_initializers = true,
                               bool saving_ort_format = false);
 
+  /**
+  Provide the execution plan saved in an ORT format model. If its config hash matches the current graph and
+  session configuration, FinalizeSessionState uses it instead of running the planner.
+  Only valid for the main graph, and `fbs_plan` must remain valid until FinalizeSessionState returns.
+  */
+  void SetSerializedExecutionPlan(const fbs::ExecutionPlan* fbs_plan) {
+    serialized_execution_plan_ = fbs_plan;
+  }
+
+  // true if FinalizeSessionState used the serialized execution plan
+  bool IsExecutionPlanFromOrtFormat() const { return execution_plan_from_ort_format_; }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Save the execution plan along with its config hash. FinalizeSessionState must have been called.
+  Status SaveExecutionPlanToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                      flatbuffers::Offset<fbs::ExecutionPlan>& fbs_plan) const;
+#endif
+
   SessionState* Parent() {
     return parent_;
   }
@@ -327,6 +380,51 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  // Number of pre-packed weights restored from the persistent cache instead of being pre-packed.
+  size_t GetRestoredPrePackedWeightCounter() const {
+    return restored_pre_packed_weights_counter_;
+  }
+
+  // Use a persistent cache of pre-packed weights when the session state is finalized. Subgraphs use the cache of the
+  // main graph. The cache must outlive the kernels as they may reference the buffers of its file.
+  void SetPrepackedWeightsCache(PrepackedWeightsCache* cache) {
+    prepacked_weights_cache_ = cache;
+  }
+
+  // Gives the OS a hint about the access to the initializers that the kernels read lazily from mapped files,
+  // including those of the subgraphs. See kOrtSessionOptionsConfigLazyExternalInitializers.
+  void AdviseLazyInitializers(Env::MappedMemoryAdvice advice) const;
+
+  // Whether the pages of the lazily read initializers are marked cold after each Run.
+  bool LazyInitializersColdAfterRun() const {
+    return lazy_initializers_cold_after_run_;
+  }
+
+  // Share of the intra-op thread pool used by the kernels, if the pool is shared with other sessions.
+  void SetIntraOpWorkShare(const concurrency::ThreadPool::WorkShare& work_share) {
+    intra_op_work_share_ = work_share;
+  }
+
+  const std::optional<concurrency::ThreadPool::WorkShare>& GetIntraOpWorkShare() const {
+    return intra_op_work_share_;
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Collect statistics of the tensors computed by the session to calibrate quantization. Set on the main graph.
+  void SetCalibrationCollector(CalibrationCollector* collector) {
+    calibration_collector_ = collector;
+  }
+
+  // The calibration collector of the session, or nullptr. Subgraphs use the collector of the main graph.
+  CalibrationCollector* GetCalibrationCollector() const {
+    const SessionState* root = this;
+    while (root->parent_ != nullptr) {
+      root = root->parent_;
+    }
+    return root->calibration_collector_;
+  }
+#endif
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -340,6 +438,10 @@ class SessionState {
 
   void RecycleDeviceStreamCollection(std::unique_ptr<DeviceStreamCollection> device_stream_collection) const;
 
+  // Create device stream collections until the pool holds `pool_size` of them, so that that many concurrent runs
+  // get their own device streams without creating them.
+  void FillDeviceStreamPool(size_t pool_size) const;
+
   IStreamCommandHandleRegistry& GetStreamHandleRegistryInstance() const {
     return *stream_handles_registry_;
   }
@@ -364,8 +466,9 @@ class SessionState {
   // Populate OrtValueNameIdxMap and create the graph viewer.
   void CreateGraphInfo();
 
-  // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  // create kernels using info in kernel_create_info_map_.
+  // if `parallelize` is true the kernels of the CPU EP for built-in operator domains are created on thread_pool_.
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager, bool parallelize);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -374,9 +477,22 @@ class SessionState {
   /**
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
+   * If `parallelize` is true PrePack() is called on thread_pool_ for the kernels of the CPU EP for built-in operator
+   * domains, a batch of nodes at a time. The results are applied to the PrepackedWeightsContainer in node order so
+   * the sharing of pre-packed weights does not depend on the thread scheduling.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           bool parallelize);
+
+  /**
+   * Hand the pre-packed weight of `tensor` in `cache` to `kernel`, or call PrePack() if there is none the kernel can
+   * use. In the latter case `new_entry` describes the buffers the kernel pre-packed so that they can be added to the
+   * cache. This only touches the kernel and the outputs so it can run concurrently for different nodes.
+   */
+  Status PrepackWithPersistentCache(const PrepackedWeightsCache& cache, const Node& node, OpKernel& kernel,
+                                    const Tensor& tensor, int input_idx, bool& is_packed, bool& restored,
+                                    SharedWeightsFile::Entry& new_entry);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -477,6 +593,11 @@ class SessionState {
   InlinedVector<BufferUniquePtr> weights_buffers_;
   std::optional<SequentialExecutionPlan> p_seq_exec_plan_;
 
+  // execution plan from the ORT format model, and the hash of the configuration p_seq_exec_plan_ was created for
+  const fbs::ExecutionPlan* serialized_execution_plan_{nullptr};
+  uint64_t execution_plan_config_hash_{0};
+  bool execution_plan_from_ort_format_{false};
+
   const logging::Logger& logger_;
   profiling::Profiler& profiler_;
 
@@ -487,11 +608,32 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // Calculate the key for mem_patterns_ from the input shapes.
+  // If shape bucketing is enabled, bucketed dims are rounded up to the next power of two. `bucketed_dims` receives
+  // the flattened input dims that the pattern has to cover, and is left empty if bucketing is disabled.
+  int64_t CalculateMemoryPatternsKey(gsl::span<const OrtValue> tensor_inputs,
+                                     gsl::span<const int> feed_mlvalue_idxs,
+                                     InlinedVector<int64_t>& bucketed_dims) const;
+
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
+  // bounded by "session.memory_pattern.cache_max_bytes" if set.
+  mutable MemoryPatternCache mem_patterns_;
+
+  std::unique_ptr<SubgraphMemoizer> subgraph_memoizer_;
+
+  std::unique_ptr<TaskGraph> task_graph_;
+
+  // "session.memory_pattern.shape_bucketing" is set to "pow2"
+  bool mem_pattern_shape_bucketing_{false};
+  // "session.memory_pattern.algorithm"
+  MemPatternPlannerAlgorithm mem_pattern_algorithm_{MemPatternPlannerAlgorithm::kOnline};
+  // "session.memory_reuse.allow_larger_buffers" is set to "1"
+  bool larger_buffer_reuse_{false};
+  // for each graph input (by OrtValue index) whether each dim is bucketed.
+  // populated in ResolveMemoryPatternFlag if mem_pattern_shape_bucketing_ is true.
+  InlinedHashMap<int, InlinedVector<bool>> mem_pattern_bucketed_dims_;
   // This is mutable under mutex in training scenarios so execution frame would make a copy
   // of the value when created.
 #ifdef ENABLE_TRAINING
@@ -509,6 +651,14 @@ class SessionState {
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
 
+  // share of thread_pool_ of the session, if thread_pool_ is shared between sessions
+  std::optional<concurrency::ThreadPool::WorkShare> intra_op_work_share_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // collector of calibration statistics of the main graph. nullptr if not used.
+  CalibrationCollector* calibration_collector_{nullptr};
+#endif
+
   const DataTransferManager& data_transfer_mgr_;
 
   const SessionOptions& sess_options_;
@@ -521,6 +671,15 @@ class SessionState {
   // prepacked_weights_container_ can be nullptr if no caching is required for prepacked weights
   PrepackedWeightsContainer* const prepacked_weights_container_{};
 
+  // persistent cache of pre-packed weights of the main graph. nullptr if not used.
+  PrepackedWeightsCache* prepacked_weights_cache_{nullptr};
+
+  // the constant initializers read lazily from mapped files by the CPU kernels, and their data in the execution
+  // order of the nodes reading them
+  InlinedHashSet<int> lazy_initializers_;
+  std::vector<gsl::span<const std::byte>> lazy_initializer_data_;
+  bool lazy_initializers_cold_after_run_ = false;
+
 #ifdef ENABLE_TRAINING
 // Needed for ORTTrainer. Should be removed along with ORTTrainer code
 #ifndef DISABLE_ABSEIL
@@ -551,12 +710,17 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight was restored from the persistent cache
+  size_t restored_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
 #endif
 
 #ifdef ORT_ENABLE_STREAM
+  std::unique_ptr<DeviceStreamCollection> CreateDeviceStreamCollection() const;
+
   std::unique_ptr<IStreamCommandHandleRegistry> stream_handles_registry_;
 
   // lock for the device stream pool
@@ -564,6 +728,9 @@ class SessionState {
   mutable std::vector<std::unique_ptr<DeviceStreamCollection>> device_stream_pool_;
   // flag to indicate whether current session using any EP that create device stream dynamically.
   bool has_device_stream_enabled_ep_ = false;
+  // whether the device stream collections of the main graph get input copy streams,
+  // see kOrtSessionOptionsConfigUseInputCopyStreams
+  bool use_input_copy_streams_ = false;
 #endif
 };
 
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <utility>
@@ -12,6 +13,7 @@
 #include "core/framework/session_state_utils.h"
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/graph_partitioner.h"
@@ -26,6 +28,7 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -103,6 +106,21 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
                   "DeserializeTensorProto() takes either pre-allocated buffer or an allocator!");
   }
 
+  // the tensors with external data on CPU use the mapped file directly. a buffer for them would be allocated and
+  // released right away, which grows an arena by the size of the tensor.
+  const OrtDevice& device = m != nullptr ? m->GetAllocInfo().device : alloc->Info().device;
+  if (device.Type() == OrtDevice::CPU && utils::HasExternalData(tensor_proto)) {
+    auto p_tensor = std::make_unique<Tensor>();
+    OrtCallback ext_data_deleter;
+    ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
+
+    ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
+
+    MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+    ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
+    return common::Status::OK();
+  }
+
   // Get shape and type of the tensor, and allocate the empty tensor
   TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
@@ -128,28 +146,17 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
   if (p_tensor->Location().device.Type() == OrtDevice::CPU) {
     // deserialize directly to CPU tensor
-    if (utils::HasExternalData(tensor_proto)) {
-      // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
-      // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
-      // TensorProtoToTensor it would copy the data, causing unnecessary overhead
-      OrtCallback ext_data_deleter;
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
-
-      ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
-
-      MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
-      ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
-      return common::Status::OK();
-    }
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor));
   } else {  // non-cpu tensor
     if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "string tensor is not supported for copying between allocators");
     }
 
-    // deserialize to CPU first for non-CPU allocator, then copy
+    // deserialize to CPU first for non-CPU allocator, then copy. external data is copied from the mapped file.
     std::unique_ptr<Tensor> p_deserialize_tensor;
-    if (use_device_allocator_for_initializers) {
+    if (utils::HasExternalData(tensor_proto)) {
+      p_deserialize_tensor = std::make_unique<Tensor>();
+    } else if (use_device_allocator_for_initializers) {
       void* tensor_buffer = nullptr;
       ORT_RETURN_IF_ERROR(AllocateBufferUsingDeviceAllocatorFromShapeAndType(tensor_shape, type, default_cpu_alloc, tensor_buffer));
       p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, tensor_buffer, default_cpu_alloc);
@@ -197,7 +204,8 @@ common::Status SaveInitializedTensors(
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
     const SessionOptions& session_options,
-    const MemoryProfileFunction& memory_profile_func) {
+    const MemoryProfileFunction& memory_profile_func,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -292,6 +300,77 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
+  const bool use_device_allocator_for_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
+  auto deserialize = [&](const ONNX_NAMESPACE::TensorProto& tensor_proto, const std::optional<MemBuffer>& m,
+                         const AllocatorPtr& alloc, OrtValue& ort_value) -> Status {
+    Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
+                                       default_cpu_alloc, ort_value, data_transfer_mgr,
+                                       use_device_allocator_for_initializers);
+    if (!st.IsOK()) {
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << tensor_proto.name() << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+    return Status::OK();
+  };
+
+  // the initializers with external data in a file are read, and copied to their device, on up to
+  // load_concurrency threads of thread_pool first. they are saved in the same order as the other initializers below.
+  InlinedHashMap<int, OrtValue> loaded_initializers;
+  size_t load_concurrency = 1;
+  ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigExternalInitializersLoadConcurrency,
+                                                        "1"),
+      load_concurrency));
+  if (load_concurrency > 1 && concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1) {
+    struct InitializerToLoad {
+      int ort_value_index;
+      const ONNX_NAMESPACE::TensorProto* tensor_proto;
+      std::optional<MemBuffer> m;
+      AllocatorPtr alloc;
+      OrtValue ort_value;
+      Status status;
+    };
+
+    std::vector<InitializerToLoad> to_load;
+    for (const auto& entry : id_to_initialized_tensor) {
+      if (entry.second->name().empty() || user_supplied_initializer_ids.count(entry.first) != 0 ||
+          !utils::HasExternalDataInFile(*entry.second)) {
+        continue;
+      }
+
+      // the planner is not thread-safe
+      auto& initializer = to_load.emplace_back();
+      initializer.ort_value_index = entry.first;
+      initializer.tensor_proto = entry.second;
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(entry.first, entry.second->name(), initializer.m,
+                                                        initializer.alloc));
+    }
+
+    concurrency::ThreadPool::TryBatchParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(to_load.size()),
+        [&to_load, &deserialize](std::ptrdiff_t i) {
+          auto& initializer = to_load[i];
+          ORT_TRY {
+            initializer.status = deserialize(*initializer.tensor_proto, initializer.m, initializer.alloc,
+                                             initializer.ort_value);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              initializer.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+        },
+        static_cast<std::ptrdiff_t>(std::min(load_concurrency, to_load.size())));
+
+    for (auto& initializer : to_load) {
+      ORT_RETURN_IF_ERROR(initializer.status);
+      loaded_initializers.emplace(initializer.ort_value_index, std::move(initializer.ort_value));
+    }
+  }
+
   // 3. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
@@ -307,6 +386,8 @@ common::Status SaveInitializedTensors(
     if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
       ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
+    } else if (auto loaded = loaded_initializers.find(ort_value_index); loaded != loaded_initializers.end()) {
+      ort_value = std::move(loaded->second);
     } else {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
 
@@ -314,17 +395,7 @@ common::Status SaveInitializedTensors(
       AllocatorPtr alloc;
       // TODO: if the tensor need be copied, does it have enough room?
       ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
-
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
-                                         default_cpu_alloc, ort_value, data_transfer_mgr,
-                                         use_device_allocator_for_initializers);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
-      }
+      ORT_RETURN_IF_ERROR(deserialize(tensor_proto, m, alloc, ort_value));
     }
 
     // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
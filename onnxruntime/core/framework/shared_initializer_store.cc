@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/framework/allocator.h"
+#include "core/framework/data_types.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The key of a tensor in the store: its type, shape and a hash of all of its data.
+std::string GetKey(const Tensor& tensor) {
+  // MurmurHash3 takes an int length, so hash large tensors in chunks
+  constexpr size_t kChunkSize = size_t{1} << 30;
+  uint32_t hash[4] = {0, 0, 0, 0};
+  const auto* data = static_cast<const char*>(tensor.DataRaw());
+  const size_t length = tensor.SizeInBytes();
+  for (size_t offset = 0; offset < length; offset += kChunkSize) {
+    MurmurHash3::x86_128(data + offset, narrow<int>(std::min(kChunkSize, length - offset)), hash[0], &hash);
+  }
+
+  std::string key = std::to_string(tensor.GetElementType()) + ":" + tensor.Shape().ToString() + ":";
+  for (const auto value : hash) {
+    key += std::to_string(value) + ",";
+  }
+  return key;
+}
+
+// An OrtValue over the buffer of a shared tensor, which it keeps alive
+OrtValue CreateSharedValue(std::shared_ptr<const Tensor> shared) {
+  // kernels never write to initializers
+  auto p_tensor = std::make_unique<Tensor>(shared->DataType(), shared->Shape(), const_cast<void*>(shared->DataRaw()),
+                                           shared->Location());
+  OrtValue value;
+  value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+             [shared](void* p) { delete static_cast<Tensor*>(p); });
+  return value;
+}
+
+}  // namespace
+
+Status SharedInitializerStore::GetOrAddInitializers(const Env& env, const PathString& model_path, const Graph& graph,
+                                                    size_t min_size_in_bytes,
+                                                    std::unordered_map<std::string, OrtValue>& initializers,
+                                                    size_t& num_shared) {
+  num_shared = 0;
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    const auto& tensor_proto = *entry.second;
+    if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        utils::HasExternalData(tensor_proto)) {
+      continue;
+    }
+
+    const auto* type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+    const TensorShape shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+    if (static_cast<size_t>(shape.Size()) * type->Size() < min_size_in_bytes) {
+      continue;
+    }
+
+    auto tensor = std::make_shared<Tensor>(type, shape, cpu_allocator);
+    ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, model_path.empty() ? nullptr : model_path.c_str(),
+                                                   tensor_proto, *tensor));
+    const std::string key = GetKey(*tensor);
+
+    std::shared_ptr<const Tensor> shared;
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      auto range = tensors_.equal_range(key);
+      for (auto it = range.first; it != range.second;) {
+        auto existing = it->second.lock();
+        if (!existing) {
+          // released by all the sessions that used it
+          it = tensors_.erase(it);
+          continue;
+        }
+
+        // the hash is not a proof of equality
+        if (existing->SizeInBytes() == tensor->SizeInBytes() &&
+            std::memcmp(existing->DataRaw(), tensor->DataRaw(), tensor->SizeInBytes()) == 0) {
+          shared = std::move(existing);
+          break;
+        }
+        ++it;
+      }
+
+      if (shared) {
+        ++num_shared;
+      } else {
+        shared = tensor;
+        tensors_.emplace(key, shared);
+      }
+    }
+
+    initializers[entry.first] = CreateSharedValue(std::move(shared));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class Graph;
+class Tensor;
+
+/**
+ * An environment wide store of initializers addressed by their content, so that sessions of models sharing
+ * initializers byte for byte, e.g. fine-tuned variants of the same base model, hold one copy of each of them.
+ *
+ * The initializers of a session are hashed when it is initialized. An initializer with the same type, shape and data
+ * as one another session already loaded uses the buffer of that one. A buffer is reference counted by the tensors
+ * using it and released with the last session using it.
+ * The store also holds a PrepackedWeightsContainer, whose keys hash the pre-packed content, so that the sessions share
+ * the pre-packed forms of the shared initializers as well.
+ */
+class SharedInitializerStore final {
+ public:
+  SharedInitializerStore() = default;
+
+  /**
+   * Create tensors for the initializers of `graph` of at least `min_size_in_bytes`, using the buffer of an
+   * initializer with the same content if there is one in the store and adding the others to it.
+   * String tensors and tensors with external data, which are mapped from the external data file already, are skipped.
+   * Subgraph initializers are not included.
+   * @param num_shared Set to the number of initializers that use a buffer loaded by another session.
+   */
+  Status GetOrAddInitializers(const Env& env, const PathString& model_path, const Graph& graph,
+                              size_t min_size_in_bytes,
+                              std::unordered_map<std::string, OrtValue>& initializers,
+                              size_t& num_shared);
+
+  PrepackedWeightsContainer& GetPrepackedWeightsContainer() { return prepacked_weights_container_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+  OrtMutex mutex_;
+  // keyed by the type, shape and hash of the data. initializers with colliding hashes share a key.
+  std::unordered_multimap<std::string, std::weak_ptr<const Tensor>> tensors_;
+
+  PrepackedWeightsContainer prepacked_weights_container_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,413 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_weights_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "core/framework/allocator.h"
+#include "core/common/narrow.h"
+#include "core/framework/data_types.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'R', 'T', 'S', 'H', 'W', 'T', '\0'};
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_entries;
+  uint64_t index_offset;
+  uint64_t index_length;
+};
+
+static_assert(sizeof(FileHeader) == 32, "Unexpected padding in FileHeader");
+
+// Identifies the data of an initializer without hashing all of it, so that a file written for another version of the
+// model with the same initializer names and shapes is not used.
+uint64_t ComputeFingerprint(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  constexpr size_t kSampleSize = 4096;
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto update = [&hash](const void* data, size_t length) {
+    MurmurHash3::x86_128(data, narrow<int>(length), hash[0], &hash);
+  };
+
+  if (utils::HasRawData(tensor_proto)) {
+    const std::string& raw_data = tensor_proto.raw_data();
+    const size_t length = raw_data.size();
+    update(&length, sizeof(length));
+    update(raw_data.data(), std::min(length, kSampleSize));
+    if (length > kSampleSize) {
+      update(raw_data.data() + length - kSampleSize, kSampleSize);
+    }
+  } else {
+    const std::string serialized = tensor_proto.SerializeAsString();
+    update(serialized.data(), serialized.size());
+  }
+
+  return (static_cast<uint64_t>(hash[1]) << 32) | hash[0];
+}
+
+Status RenameFile(const PathString& from, const PathString& to) {
+#ifdef _WIN32
+  const int result = _wrename(from.c_str(), to.c_str());
+#else
+  const int result = std::rename(from.c_str(), to.c_str());
+#endif
+  ORT_RETURN_IF_NOT(result == 0, "Failed to rename ", PathToUTF8String(from), " to ", PathToUTF8String(to));
+  return Status::OK();
+}
+
+void RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  _wremove(path.c_str());
+#else
+  std::remove(path.c_str());
+#endif
+}
+
+// Writes the entries to a temporary file next to the target and renames it to the target on Commit, so that readers
+// only ever see complete files.
+class Writer {
+ public:
+  explicit Writer(const PathString& path)
+      : path_(path),
+        tmp_path_(path + ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + ".tmp")) {}
+
+  ~Writer() {
+    if (!committed_) {
+      stream_.close();
+      RemoveFile(tmp_path_);
+    }
+  }
+
+  Status Open() {
+    stream_.open(tmp_path_, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(stream_.good(), "Failed to open ", PathToUTF8String(tmp_path_), " for writing");
+
+    // the header is written once the index location is known
+    FileHeader header{};
+    return Write(&header, sizeof(header));
+  }
+
+  Status AddEntry(const std::string& name, int32_t data_type, uint64_t fingerprint, gsl::span<const int64_t> dims,
+                  gsl::span<const SharedWeightsFile::Buffer> buffers) {
+    index_entries_ += 1;
+    AppendToIndex(static_cast<uint32_t>(name.size()));
+    index_.insert(index_.end(), name.begin(), name.end());
+    AppendToIndex(data_type);
+    AppendToIndex(fingerprint);
+    AppendToIndex(static_cast<uint32_t>(dims.size()));
+    for (int64_t dim : dims) {
+      AppendToIndex(dim);
+    }
+
+    AppendToIndex(static_cast<uint32_t>(buffers.size()));
+    for (const auto& buffer : buffers) {
+      ORT_RETURN_IF_ERROR(Align());
+      AppendToIndex(static_cast<uint64_t>(offset_));
+      AppendToIndex(static_cast<uint64_t>(buffer.size));
+      ORT_RETURN_IF_ERROR(Write(buffer.data, buffer.size));
+    }
+
+    return Status::OK();
+  }
+
+  Status Commit() {
+    FileHeader header{};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.num_entries = index_entries_;
+    header.index_offset = offset_;
+    header.index_length = index_.size();
+    ORT_RETURN_IF_ERROR(Write(index_.data(), index_.size()));
+
+    stream_.seekp(0);
+    stream_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream_.close();
+    ORT_RETURN_IF_NOT(!stream_.fail(), "Failed to write ", PathToUTF8String(tmp_path_));
+
+    ORT_RETURN_IF_ERROR(RenameFile(tmp_path_, path_));
+    committed_ = true;
+    return Status::OK();
+  }
+
+ private:
+  template <typename T>
+  void AppendToIndex(T value) {
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    index_.insert(index_.end(), bytes, bytes + sizeof(T));
+  }
+
+  Status Write(const void* data, size_t size) {
+    if (size > 0) {
+      stream_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+      ORT_RETURN_IF_NOT(stream_.good(), "Failed to write ", PathToUTF8String(tmp_path_));
+      offset_ += size;
+    }
+
+    return Status::OK();
+  }
+
+  Status Align() {
+    static const char padding[SharedWeightsFile::kAlignment] = {};
+    const size_t remainder = offset_ % SharedWeightsFile::kAlignment;
+    return remainder == 0 ? Status::OK() : Write(padding, SharedWeightsFile::kAlignment - remainder);
+  }
+
+  const PathString path_;
+  const PathString tmp_path_;
+  std::ofstream stream_;
+  size_t offset_{0};
+  uint32_t index_entries_{0};
+  std::vector<char> index_;
+  bool committed_{false};
+};
+
+}  // namespace
+
+Status SharedWeightsFile::Load(const Env& env, const PathString& path,
+                               std::shared_ptr<const SharedWeightsFile>& file) {
+  std::shared_ptr<SharedWeightsFile> result(new SharedWeightsFile());
+  ORT_RETURN_IF_ERROR(env.GetFileLength(path.c_str(), result->length_));
+  ORT_RETURN_IF_NOT(result->length_ >= sizeof(FileHeader), "Shared weights file ", PathToUTF8String(path),
+                    " is too small");
+  ORT_RETURN_IF_ERROR(env.MapFileIntoMemory(path.c_str(), 0, result->length_, result->mapped_memory_));
+
+  const Status status = result->Parse();
+  if (!status.IsOK()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_GRAPH, "Invalid shared weights file ", PathToUTF8String(path), ": ",
+                           status.ErrorMessage());
+  }
+
+  file = std::move(result);
+  return Status::OK();
+}
+
+Status SharedWeightsFile::Parse() {
+  const char* const base = mapped_memory_.get();
+
+  FileHeader header;
+  memcpy(&header, base, sizeof(header));
+  ORT_RETURN_IF_NOT(memcmp(header.magic, kMagic, sizeof(kMagic)) == 0, "bad magic");
+  ORT_RETURN_IF_NOT(header.version == kVersion, "unsupported version ", header.version);
+  ORT_RETURN_IF_NOT(header.index_offset <= length_ && header.index_length <= length_ - header.index_offset,
+                    "index out of bounds");
+
+  const char* cursor = base + header.index_offset;
+  const char* const end = cursor + header.index_length;
+  auto read = [&cursor, end](void* value, size_t size) {
+    if (static_cast<size_t>(end - cursor) < size) {
+      return false;
+    }
+    memcpy(value, cursor, size);
+    cursor += size;
+    return true;
+  };
+
+  for (uint32_t i = 0; i < header.num_entries; ++i) {
+    Entry entry;
+    uint32_t name_length = 0;
+    ORT_RETURN_IF_NOT(read(&name_length, sizeof(name_length)) && static_cast<size_t>(end - cursor) >= name_length,
+                      "truncated index");
+    entry.name.assign(cursor, name_length);
+    cursor += name_length;
+
+    uint32_t num_dims = 0;
+    ORT_RETURN_IF_NOT(read(&entry.data_type, sizeof(entry.data_type)) &&
+                          read(&entry.fingerprint, sizeof(entry.fingerprint)) &&
+                          read(&num_dims, sizeof(num_dims)),
+                      "truncated index");
+    entry.dims.resize(num_dims);
+    for (auto& dim : entry.dims) {
+      ORT_RETURN_IF_NOT(read(&dim, sizeof(dim)), "truncated index");
+    }
+
+    uint32_t num_buffers = 0;
+    ORT_RETURN_IF_NOT(read(&num_buffers, sizeof(num_buffers)), "truncated index");
+    entry.buffers.reserve(num_buffers);
+    for (uint32_t j = 0; j < num_buffers; ++j) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      ORT_RETURN_IF_NOT(read(&offset, sizeof(offset)) && read(&size, sizeof(size)), "truncated index");
+      ORT_RETURN_IF_NOT(offset <= header.index_offset && size <= header.index_offset - offset &&
+                            offset % kAlignment == 0,
+                        "buffer of entry ", entry.name, " out of bounds");
+      entry.buffers.push_back(Buffer{base + offset, static_cast<size_t>(size)});
+    }
+
+    std::string name = entry.name;
+    ORT_RETURN_IF_NOT(entries_.emplace(std::move(name), std::move(entry)).second, "duplicate entry");
+  }
+
+  return Status::OK();
+}
+
+Status SharedWeightsFile::SaveInitializers(const Env& env, const PathString& model_path, const Graph& graph,
+                                           const PathString& path) {
+  // sort by name so the file is the same in every process.
+  // initializers with external data are skipped as they are already mapped from the external data file.
+  std::vector<const ONNX_NAMESPACE::TensorProto*> initializers;
+  for (const auto& entry : graph.GetAllInitializedTensors()) {
+    if (entry.second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+        !utils::HasExternalData(*entry.second)) {
+      initializers.push_back(entry.second);
+    }
+  }
+  std::sort(initializers.begin(), initializers.end(),
+            [](const ONNX_NAMESPACE::TensorProto* a, const ONNX_NAMESPACE::TensorProto* b) {
+              return a->name() < b->name();
+            });
+
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+
+  Writer writer(path);
+  ORT_RETURN_IF_ERROR(writer.Open());
+  for (const auto* tensor_proto : initializers) {
+    // deserialize one initializer at a time to limit the peak memory usage
+    const auto* type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto->data_type())->GetElementType();
+    Tensor tensor(type, utils::GetTensorShapeFromTensorProto(*tensor_proto), cpu_allocator);
+    ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, model_path.c_str(), *tensor_proto, tensor));
+
+    const Buffer buffer{tensor.DataRaw(), tensor.SizeInBytes()};
+    ORT_RETURN_IF_ERROR(writer.AddEntry(tensor_proto->name(), tensor_proto->data_type(),
+                                        ComputeFingerprint(*tensor_proto), tensor.Shape().GetDims(), gsl::make_span(&buffer, 1)));
+  }
+
+  return writer.Commit();
+}
+
+Status SharedWeightsFile::SavePrepackedWeights(const PrepackedWeightsContainer& container, const PathString& path) {
+  std::vector<const std::string*> keys;
+  for (const auto& entry : container.GetWeights()) {
+    keys.push_back(&entry.first);
+  }
+  std::sort(keys.begin(), keys.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+  Writer writer(path);
+  ORT_RETURN_IF_ERROR(writer.Open());
+  for (const std::string* key : keys) {
+    const PrePackedWeights& weights = container.GetWeight(*key);
+    InlinedVector<Buffer> buffers;
+    buffers.reserve(weights.buffers_.size());
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      buffers.push_back(Buffer{weights.buffers_[i].get(), weights.buffer_sizes_[i]});
+    }
+
+    ORT_RETURN_IF_ERROR(writer.AddEntry(*key, 0, 0, {}, buffers));
+  }
+
+  return writer.Commit();
+}
+
+Status SharedWeightsFile::SaveEntries(gsl::span<const Entry* const> entries, const PathString& path) {
+  std::vector<const Entry*> sorted(entries.begin(), entries.end());
+  std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+  Writer writer(path);
+  ORT_RETURN_IF_ERROR(writer.Open());
+  for (const Entry* entry : sorted) {
+    ORT_RETURN_IF_ERROR(writer.AddEntry(entry->name, entry->data_type, entry->fingerprint, entry->dims,
+                                        entry->buffers));
+  }
+
+  return writer.Commit();
+}
+
+uint64_t SharedWeightsFile::ComputeFingerprint(const Tensor& tensor) {
+  constexpr size_t kSampleSize = 4096;
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto update = [&hash](const void* data, size_t length) {
+    MurmurHash3::x86_128(data, narrow<int>(length), hash[0], &hash);
+  };
+
+  const int32_t element_type = tensor.GetElementType();
+  const auto dims = tensor.Shape().GetDims();
+  update(&element_type, sizeof(element_type));
+  update(dims.data(), dims.size_bytes());
+
+  if (!tensor.IsDataTypeString()) {
+    const auto* data = static_cast<const char*>(tensor.DataRaw());
+    const size_t length = tensor.SizeInBytes();
+    update(data, std::min(length, kSampleSize));
+    if (length > kSampleSize) {
+      update(data + length - kSampleSize, kSampleSize);
+    }
+  }
+
+  return (static_cast<uint64_t>(hash[1]) << 32) | hash[0];
+}
+
+Status SharedWeightsFile::CreateInitializers(const Graph& graph,
+                                             std::unordered_map<std::string, OrtValue>& initializers) const {
+  auto self = shared_from_this();
+  const OrtMemoryInfo cpu_memory_info(CPU, OrtAllocatorType::OrtDeviceAllocator);
+  for (const auto& graph_initializer : graph.GetAllInitializedTensors()) {
+    const auto& tensor_proto = *graph_initializer.second;
+    const Entry* entry = Find(graph_initializer.first);
+    if (entry == nullptr || entry->data_type == 0 || entry->data_type != tensor_proto.data_type() ||
+        entry->buffers.size() != 1 || utils::HasExternalData(tensor_proto) ||
+        entry->fingerprint != ComputeFingerprint(tensor_proto)) {
+      continue;
+    }
+
+    TensorShape shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+    const auto* type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+    const auto dims = shape.GetDims();
+    if (!std::equal(dims.begin(), dims.end(), entry->dims.begin(), entry->dims.end()) ||
+        static_cast<size_t>(shape.Size()) * type->Size() != entry->buffers[0].size) {
+      continue;
+    }
+
+    // the mapping is read-only. kernels never write to initializers.
+    auto p_tensor = std::make_unique<Tensor>(type, shape, const_cast<void*>(entry->buffers[0].data),
+                                             cpu_memory_info);
+    OrtValue value;
+    value.Init(p_tensor.release(), DataTypeImpl::GetType<Tensor>(),
+               [self](void* p) { delete static_cast<Tensor*>(p); });
+    initializers[graph_initializer.first] = std::move(value);
+  }
+
+  return Status::OK();
+}
+
+size_t SharedWeightsFile::AddPrepackedWeights(PrepackedWeightsContainer& container) const {
+  auto self = shared_from_this();
+  size_t num_added = 0;
+  for (const auto& item : entries_) {
+    const Entry& entry = item.second;
+    if (entry.data_type != 0 || container.HasWeight(entry.name)) {
+      continue;
+    }
+
+    PrePackedWeights weights;
+    for (const auto& buffer : entry.buffers) {
+      weights.buffers_.emplace_back(const_cast<void*>(buffer.data), [self](void*) {});
+      weights.buffer_sizes_.push_back(buffer.size);
+    }
+
+    if (container.WriteWeight(entry.name, std::move(weights))) {
+      ++num_added;
+    }
+  }
+
+  return num_added;
+}
+
+const SharedWeightsFile::Entry* SharedWeightsFile::Find(const std::string& name) const {
+  auto it = entries_.find(name);
+  return it == entries_.end() ? nullptr : &it->second;
+}
+
+}  // namespace onnxruntime
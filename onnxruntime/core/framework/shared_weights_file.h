@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/path_string.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/platform/env.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class Graph;
+class PrepackedWeightsContainer;
+class Tensor;
+
+/**
+ * A file holding the data of initializers or pre-packed weights so that several processes can map the same copy.
+ *
+ * The file is mapped read-only, so the pages are backed by the OS page cache and shared between all processes that
+ * map it instead of every process holding a private copy of the weights.
+ *
+ * A file consists of a small header, the data of each entry aligned to kAlignment bytes, and an index at the end.
+ * An entry is either an initializer, identified by its name and holding one buffer, or a pre-packed weight,
+ * identified by its PrepackedWeightsContainer key and holding the pre-packed buffers.
+ * Files are written to a temporary file that is renamed once complete, so a process never maps a partial file
+ * written by a sibling. The format is host specific and the file should not be copied to other machines.
+ */
+class SharedWeightsFile final : public std::enable_shared_from_this<SharedWeightsFile> {
+ public:
+  static constexpr size_t kAlignment = 64;
+
+  struct Buffer {
+    const void* data;
+    size_t size;
+  };
+
+  struct Entry {
+    std::string name;
+    // ONNX TensorProto data type of an initializer. 0 for a pre-packed weight.
+    int32_t data_type{0};
+    // sample based hash of the initializer data. 0 for a pre-packed weight.
+    uint64_t fingerprint{0};
+    InlinedVector<int64_t> dims;
+    InlinedVector<Buffer> buffers;
+  };
+
+  /**
+   * Map the file at `path`. Fails if it does not exist or is not a valid shared weights file.
+   */
+  static Status Load(const Env& env, const PathString& path, std::shared_ptr<const SharedWeightsFile>& file);
+
+  /**
+   * Write the initializers of `graph` to `path`, except for string tensors and tensors with external data, which
+   * are mapped from the external data file already. Subgraph initializers are not included.
+   */
+  static Status SaveInitializers(const Env& env, const PathString& model_path, const Graph& graph,
+                                 const PathString& path);
+
+  /**
+   * Write the pre-packed weights in `container` to `path`. The caller must hold the container's mutex.
+   */
+  static Status SavePrepackedWeights(const PrepackedWeightsContainer& container, const PathString& path);
+
+  /**
+   * Write `entries` to `path`. The entries must have distinct names.
+   */
+  static Status SaveEntries(gsl::span<const Entry* const> entries, const PathString& path);
+
+  /**
+   * Sample based hash of the type, shape and data of `tensor`, which identifies it without reading all of its data.
+   */
+  static uint64_t ComputeFingerprint(const Tensor& tensor);
+
+  /**
+   * Create tensors over the mapped data for the initializers of `graph` that have an entry with a matching type,
+   * shape and fingerprint. The tensors keep the mapping alive.
+   */
+  Status CreateInitializers(const Graph& graph, std::unordered_map<std::string, OrtValue>& initializers) const;
+
+  /**
+   * Add the pre-packed weights in the file to `container`, skipping keys it already contains. The buffers keep the
+   * mapping alive. The caller must hold the container's mutex.
+   * Returns the number of weights added.
+   */
+  size_t AddPrepackedWeights(PrepackedWeightsContainer& container) const;
+
+  const Entry* Find(const std::string& name) const;
+
+  size_t NumEntries() const { return entries_.size(); }
+
+  const InlinedHashMap<std::string, Entry>& Entries() const { return entries_; }
+
+ private:
+  SharedWeightsFile() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedWeightsFile);
+
+  Status Parse();
+
+  Env::MappedMemoryPtr mapped_memory_;
+  size_t length_{0};
+  InlinedHashMap<std::string, Entry> entries_;
+};
+
+/**
+ * A persistent cache of the pre-packed weights of the CPU kernels of a session, see
+ * "session.prepacked_weights_cache_dir".
+ *
+ * The pre-packed weights found in `file` are handed to the kernels through OpKernel::UseCachedPrePackedBuffers
+ * instead of pre-packing the initializers again, so the weights are only paged in from the mapped file. The weights
+ * that had to be pre-packed are collected in `new_entries` so that the file can be rewritten once the session is
+ * initialized. Entries are keyed by the op type, node name and input index, and are only used if the fingerprint and
+ * shape of the initializer match.
+ */
+struct PrepackedWeightsCache {
+  // the cache file of the session. nullptr if there is none yet.
+  std::shared_ptr<const SharedWeightsFile> file;
+
+  OrtMutex mutex;
+  // the buffers are owned by the kernels of the session. GUARDED_BY(mutex)
+  std::vector<SharedWeightsFile::Entry> new_entries;
+};
+
+}  // namespace onnxruntime
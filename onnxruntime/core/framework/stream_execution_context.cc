@@ -79,6 +79,40 @@ Stream* StreamExecutionContext ::GetDeviceStream(size_t idx) {
   }
 }
 
+void StreamExecutionContext::WaitOnInputCopies(NodeIndex node_index, size_t stream_idx) {
+  if (!device_stream_map_ || !device_stream_map_->HasInputCopyNotifications()) {
+    return;
+  }
+
+  // the inputs used by nodes on a stream that doesn't support Stream aren't on a device with an input copy stream
+  Stream* stream = GetDeviceStream(stream_idx);
+  if (!stream) {
+    return;
+  }
+
+  const auto& node = *session_state_->GetGraphViewer().GetNode(node_index);
+  const auto& node_index_info = session_state_->GetNodeIndexInfo();
+  const int node_offset = node_index_info.GetNodeOffset(node_index);
+  const size_t num_inputs = node.InputDefs().size() + node.ImplicitInputDefs().size();
+  for (size_t i = 0; i < num_inputs; ++i) {
+    const int ort_value_idx = node_index_info.GetMLValueIndex(node_offset + static_cast<int>(i));
+    if (ort_value_idx == NodeIndexInfo::kInvalidEntry) {
+      continue;
+    }
+
+    auto* notification = device_stream_map_->GetInputCopyNotification(ort_value_idx);
+    if (notification) {
+      // the input copy stream is on the device of the nodes using the input
+      auto wait_handle = session_state_->GetStreamHandleRegistryInstance().GetWaitHandle(
+          stream->GetDevice().Type(), stream->GetDevice().Type());
+      if (wait_handle) {
+        wait_handle(*stream, *notification);
+        stream->UpdateStreamClock(notification->GetStreamSyncTable());
+      }
+    }
+  }
+}
+
 #else
 StreamExecutionContext::StreamExecutionContext(const SessionState& sess_state,
                                                int32_t num_streams,
@@ -163,9 +197,18 @@ void StreamExecutionContext ::SetStatus(Status& status) {
 
 StreamExecutionContext::~StreamExecutionContext() {}
 
+void StreamExecutionContext::UseTaskGraphReleasePlan(const TaskGraph& task_graph) {
+  for (size_t i = 0; i < task_graph.release_ref_counts.size(); ++i) {
+    release_plan_[i] = task_graph.release_ref_counts[i];
+  }
+  task_graph_ = &task_graph;
+}
+
 void StreamExecutionContext::RecycleNodeInputs(onnxruntime::NodeIndex node_index) {
   auto* execution_plan = session_state_->GetExecutionPlan();
-  for (auto idx : execution_plan->node_release_list[node_index]) {
+  const auto& release_list = task_graph_ != nullptr ? task_graph_->node_release_list[node_index]
+                                                    : execution_plan->node_release_list[node_index];
+  for (auto idx : release_list) {
     if (--release_plan_[idx] == 0) {
       ORT_ENFORCE(frame_.ReleaseMLValue(static_cast<int>(execution_plan->release_actions[idx].value_index)).IsOK());
       LOGS(*logger_, VERBOSE) << "ort value " << execution_plan->release_actions[idx].value_index << " released";
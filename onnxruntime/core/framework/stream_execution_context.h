@@ -7,6 +7,7 @@
 #include "core/framework/ort_value.h"
 #include "core/framework/iexecutor.h"
 #include "core/framework/stream_handles.h"
+#include "core/framework/subgraph_memoizer.h"
 #include "core/graph/basic_types.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/memory_info.h"
@@ -18,6 +19,7 @@ namespace onnxruntime {
 class SessionState;
 
 class SessionScope;
+struct TaskGraph;
 typedef InlinedHashMap<std::string, OrtValue> OrtValueCache;
 typedef std::shared_ptr<OrtValueCache> OrtValueCachePtr;
 
@@ -100,6 +102,12 @@ class StreamExecutionContext {
   // return nullptr if the device of given logic sequence doesn't register stream support.
   Stream* GetDeviceStream(size_t idx);
 
+#ifdef ORT_ENABLE_STREAM
+  // Make the stream `stream_idx` wait for the copies of the graph inputs used by the node that were issued on the
+  // input copy streams of the device stream collection.
+  void WaitOnInputCopies(NodeIndex node_index, size_t stream_idx);
+#endif
+
   // Decrease the count of remaining job by 1.
   void CompleteTask();
 
@@ -116,6 +124,19 @@ class StreamExecutionContext {
   // Release the OrtValues after a step, based on the execution plan.
   void RecycleNodeInputs(onnxruntime::NodeIndex node_index);
 
+  // Release the OrtValues based on the release plan of `task_graph` instead, as its nodes run out of order.
+  // Must be called before any node runs.
+  void UseTaskGraphReleasePlan(const TaskGraph& task_graph);
+
+  // Set if the nodes memoized by the session state's SubgraphMemoizer are handled by `run`.
+  void SetMemoizedRun(SubgraphMemoizer::Run* run) {
+    memoized_run_ = run;
+  }
+
+  SubgraphMemoizer::Run* GetMemoizedRun() const {
+    return memoized_run_;
+  }
+
 #ifdef ENABLE_TRAINING
   void SetOrtValueCache(OrtValueCachePtr cache) {
     cache_ = std::move(cache);
@@ -160,6 +181,10 @@ class StreamExecutionContext {
 
   Status task_status_{Status::OK()};
 
+  SubgraphMemoizer::Run* memoized_run_{nullptr};
+
+  const TaskGraph* task_graph_{nullptr};
+
 #ifdef ENABLE_TRAINING
   const ProgramRegion* program_range_{nullptr};
 
@@ -0,0 +1,319 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/subgraph_memoizer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/session_state.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// ops whose outputs differ between executions with the same inputs
+bool IsNonDeterministic(const Node& node) {
+  static const InlinedHashSet<std::string_view> non_deterministic_ops = {
+      "RandomNormal", "RandomNormalLike", "RandomUniform", "RandomUniformLike", "Multinomial", "Bernoulli",
+      "Dropout"};
+  return non_deterministic_ops.count(node.OpType()) > 0;
+}
+
+bool IsNonStringTensor(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING;
+}
+
+bool IsCpuNonStringTensor(const OrtValue& value) {
+  if (!value.IsTensor()) {
+    return false;
+  }
+
+  const auto& tensor = value.Get<Tensor>();
+  return tensor.Location().device.Type() == OrtDevice::CPU && !tensor.IsDataTypeString();
+}
+
+bool TensorsEqual(const Tensor& a, const Tensor& b) {
+  return a.GetElementType() == b.GetElementType() && a.Shape() == b.Shape() &&
+         memcmp(a.DataRaw(), b.DataRaw(), a.SizeInBytes()) == 0;
+}
+
+}  // namespace
+
+Status SubgraphMemoizer::ParseConfig(const std::string& input_names, const std::string& max_entries,
+                                     Config& config, bool& enabled) {
+  enabled = false;
+  Config parsed;
+  for (const auto& name : utils::SplitString(input_names, ",")) {
+    parsed.input_names.emplace_back(name);
+  }
+
+  if (parsed.input_names.empty()) {
+    return Status::OK();
+  }
+
+  if (!max_entries.empty()) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(max_entries, parsed.max_entries));
+  }
+
+  if (parsed.max_entries > 0) {
+    config = std::move(parsed);
+    enabled = true;
+  }
+
+  return Status::OK();
+}
+
+Status SubgraphMemoizer::Create(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                const Config& config, std::unique_ptr<SubgraphMemoizer>& memoizer) {
+  memoizer.reset();
+
+  InlinedHashSet<std::string_view> derived_values;
+  std::unique_ptr<SubgraphMemoizer> result(new SubgraphMemoizer());
+  for (const auto& name : config.input_names) {
+    const auto& graph_inputs = graph_viewer.GetInputs();
+    const bool is_graph_input = std::any_of(graph_inputs.cbegin(), graph_inputs.cend(),
+                                            [&name](const NodeArg* input) { return input->Name() == name; });
+    ORT_RETURN_IF_NOT(is_graph_input, "Memoization input '", name, "' is not an input of the graph.");
+
+    int idx = -1;
+    ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(name, idx));
+    result->input_idxs_.push_back(idx);
+    derived_values.insert(name);
+  }
+
+  // a node is memoized if all its inputs are designated inputs, outputs of memoized nodes or constant initializers,
+  // and at least one of them is not a constant initializer (those nodes are constant folded already).
+  InlinedHashSet<NodeIndex> memoized_nodes;
+  for (NodeIndex node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node* node = graph_viewer.GetNode(node_index);
+    if (node == nullptr || node->ContainsSubgraph() || IsNonDeterministic(*node) || node->OutputDefs().empty()) {
+      continue;
+    }
+
+    bool depends_on_derived_value = false;
+    bool can_memoize = true;
+    for (const auto* input : node->InputDefs()) {
+      if (!input->Exists()) {
+        continue;
+      }
+
+      if (derived_values.count(input->Name()) > 0) {
+        depends_on_derived_value = true;
+      } else if (!graph_viewer.IsConstantInitializer(input->Name(), false)) {
+        can_memoize = false;
+        break;
+      }
+    }
+
+    for (const auto* output : node->OutputDefs()) {
+      if (output->Exists() && !IsNonStringTensor(*output)) {
+        can_memoize = false;
+      }
+    }
+
+    if (can_memoize && depends_on_derived_value) {
+      memoized_nodes.insert(node_index);
+      for (const auto* output : node->OutputDefs()) {
+        if (output->Exists()) {
+          derived_values.insert(output->Name());
+        }
+      }
+    }
+  }
+
+  if (memoized_nodes.empty()) {
+    return Status::OK();
+  }
+
+  // only the values consumed outside of the memoized nodes need to be cached
+  InlinedHashSet<std::string_view> consumed_values;
+  for (const auto* output : graph_viewer.GetOutputs()) {
+    consumed_values.insert(output->Name());
+  }
+
+  for (const auto& node : graph_viewer.Nodes()) {
+    if (memoized_nodes.count(node.Index()) > 0) {
+      continue;
+    }
+
+    for (const auto* input : node.InputDefs()) {
+      consumed_values.insert(input->Name());
+    }
+
+    for (const auto* input : node.ImplicitInputDefs()) {
+      consumed_values.insert(input->Name());
+    }
+  }
+
+  for (NodeIndex node_index : memoized_nodes) {
+    NodeInfo& info = result->nodes_[node_index];
+    const auto& outputs = graph_viewer.GetNode(node_index)->OutputDefs();
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      if (outputs[i]->Exists() && consumed_values.count(outputs[i]->Name()) > 0) {
+        info.cached_outputs.emplace_back(static_cast<int>(i), result->num_values_++);
+      }
+    }
+  }
+
+  result->max_entries_ = config.max_entries;
+  memoizer = std::move(result);
+  return Status::OK();
+}
+
+std::unique_ptr<SubgraphMemoizer::Run> SubgraphMemoizer::BeginRun(const SessionState& session_state,
+                                                                  gsl::span<const int> feed_mlvalue_idxs,
+                                                                  gsl::span<const OrtValue> feeds) const {
+  InlinedVector<const OrtValue*> inputs;
+  inputs.reserve(input_idxs_.size());
+  for (int input_idx : input_idxs_) {
+    auto it = std::find(feed_mlvalue_idxs.begin(), feed_mlvalue_idxs.end(), input_idx);
+    if (it == feed_mlvalue_idxs.end()) {
+      return nullptr;
+    }
+
+    const OrtValue& feed = feeds[narrow<size_t>(it - feed_mlvalue_idxs.begin())];
+    if (!IsCpuNonStringTensor(feed)) {
+      return nullptr;
+    }
+
+    inputs.push_back(&feed);
+  }
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  auto update_hash = [&hash](const void* data, size_t length) {
+    MurmurHash3::x86_128(data, narrow<int>(length), hash[0], &hash);
+  };
+
+  for (const OrtValue* input : inputs) {
+    const auto& tensor = input->Get<Tensor>();
+    const int32_t element_type = tensor.GetElementType();
+    const auto dims = tensor.Shape().GetDims();
+    update_hash(&element_type, sizeof(element_type));
+    update_hash(dims.data(), dims.size_bytes());
+    update_hash(tensor.DataRaw(), tensor.SizeInBytes());
+  }
+
+  const uint64_t key = (static_cast<uint64_t>(hash[1]) << 32) | hash[0];
+
+  std::unique_ptr<Run> run(new Run(*this));
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      const Entry& entry = **it;
+      if (entry.hash != key) {
+        continue;
+      }
+
+      bool equal = true;
+      for (size_t i = 0; i < inputs.size() && equal; ++i) {
+        equal = TensorsEqual(entry.inputs[i].Get<Tensor>(), inputs[i]->Get<Tensor>());
+      }
+
+      if (equal) {
+        run->hit_ = *it;
+        entries_.splice(entries_.begin(), entries_, it);
+        return run;
+      }
+    }
+  }
+
+  // keep a copy of the inputs to verify hits against
+  auto pending = std::make_shared<Entry>();
+  pending->hash = key;
+  pending->values.resize(num_values_);
+  const AllocatorPtr cpu_allocator = session_state.GetAllocator(OrtDevice());
+  for (const OrtValue* input : inputs) {
+    const auto& tensor = input->Get<Tensor>();
+    OrtValue copy;
+    Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), cpu_allocator, copy);
+    memcpy(copy.GetMutable<Tensor>()->MutableDataRaw(), tensor.DataRaw(), tensor.SizeInBytes());
+    pending->inputs.push_back(std::move(copy));
+  }
+
+  run->pending_ = std::move(pending);
+  return run;
+}
+
+void SubgraphMemoizer::EndRun(Run& run) const {
+  if (run.IsHit() || !run.pending_ || !run.pending_valid_) {
+    return;
+  }
+
+  // nodes that were not executed (e.g. because only part of the graph was run) leave values unset
+  for (const auto& value : run.pending_->values) {
+    if (!value.IsAllocated()) {
+      return;
+    }
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  entries_.push_front(std::move(run.pending_));
+  while (entries_.size() > max_entries_) {
+    entries_.pop_back();
+  }
+}
+
+size_t SubgraphMemoizer::NumEntries() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return entries_.size();
+}
+
+bool SubgraphMemoizer::Run::IsMemoized(NodeIndex node_index) const {
+  return memoizer_.nodes_.count(node_index) > 0;
+}
+
+Status SubgraphMemoizer::Run::ExecuteNode(const SessionState& session_state, NodeIndex node_index,
+                                          const OpKernel& kernel, OpKernelContext& context) {
+  const NodeInfo& info = memoizer_.nodes_.at(node_index);
+  const auto& data_transfer_mgr = session_state.GetDataTransferMgr();
+
+  if (hit_ != nullptr) {
+    for (const auto& cached_output : info.cached_outputs) {
+      const Tensor& cached = hit_->values[cached_output.second].Get<Tensor>();
+      Tensor* output = context.Output(cached_output.first, cached.Shape());
+      ORT_RETURN_IF(output == nullptr, "Failed to allocate memoized output ", cached_output.first, " of node ",
+                    kernel.Node().Name());
+      ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(cached, *output));
+    }
+
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(kernel.Compute(&context));
+
+  if (pending_ != nullptr) {
+    for (const auto& cached_output : info.cached_outputs) {
+      const Tensor* output = context.Output<Tensor>(cached_output.first);
+      if (output == nullptr) {
+        pending_valid_ = false;
+        continue;
+      }
+
+      AllocatorPtr allocator = session_state.GetAllocator(output->Location().device);
+      if (allocator == nullptr) {
+        pending_valid_ = false;
+        continue;
+      }
+
+      // every slot belongs to exactly one node, so nodes on different streams don't write the same slot
+      OrtValue& value = pending_->values[cached_output.second];
+      Tensor::InitOrtValue(output->DataType(), output->Shape(), std::move(allocator), value);
+      ORT_RETURN_IF_ERROR(data_transfer_mgr.CopyTensor(*output, *value.GetMutable<Tensor>()));
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OpKernel;
+class OpKernelContext;
+class OrtValueNameIdxMap;
+class SessionState;
+
+/**
+ * Memoizes the nodes of the main graph that only depend on designated graph inputs which rarely change between Run
+ * calls (e.g. an attention mask or position ids) and on constant initializers.
+ *
+ * On every Run the values of the designated inputs are looked up in a small LRU cache. On a hit the memoized nodes
+ * are not executed. Instead, the values they produce for the rest of the graph are copied from the cache entry. On a
+ * miss the nodes are executed and those values are copied into a new cache entry once the Run has succeeded.
+ * Cached values are copied rather than handed out so that the allocation plan can reuse their buffers as usual.
+ *
+ * Nodes with subgraphs, random number generators and nodes producing anything other than non-string tensors are
+ * never memoized.
+ */
+class SubgraphMemoizer {
+ public:
+  struct Config {
+    // names of the graph inputs that rarely change.
+    std::vector<std::string> input_names;
+    // maximum number of cached input values.
+    size_t max_entries{4};
+  };
+
+  /**
+   * Parse the memoization configuration from the session config values.
+   * `enabled` is set to true if the values request memoization, in which case `config` is populated.
+   */
+  static Status ParseConfig(const std::string& input_names, const std::string& max_entries,
+                            Config& config, bool& enabled);
+
+  /**
+   * Find the nodes of `graph_viewer` that can be memoized. `memoizer` is set to nullptr if there are none.
+   */
+  static Status Create(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                       const Config& config, std::unique_ptr<SubgraphMemoizer>& memoizer);
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    InlinedVector<OrtValue> inputs;
+    // the values consumed outside of the memoized nodes, indexed by slot
+    std::vector<OrtValue> values;
+  };
+
+ public:
+  // State of a single Run.
+  class Run {
+   public:
+    bool IsMemoized(NodeIndex node_index) const;
+
+    // true if the values were found in the cache, in which case the memoized nodes are not executed.
+    bool IsHit() const { return hit_ != nullptr; }
+
+    /**
+     * Execute the memoized node `node_index`: copy its outputs from the cache on a hit, otherwise compute it and
+     * copy its outputs into the pending cache entry.
+     */
+    Status ExecuteNode(const SessionState& session_state, NodeIndex node_index, const OpKernel& kernel,
+                       OpKernelContext& context);
+
+   private:
+    friend class SubgraphMemoizer;
+    explicit Run(const SubgraphMemoizer& memoizer) : memoizer_(memoizer) {}
+
+    const SubgraphMemoizer& memoizer_;
+    std::shared_ptr<const Entry> hit_;
+    std::shared_ptr<Entry> pending_;
+    std::atomic<bool> pending_valid_{true};
+  };
+
+  /**
+   * Look up the values of the designated inputs in `feeds`. Returns nullptr if memoization can't be used for the
+   * Run, e.g. because a designated input is not fed or is not a CPU tensor.
+   */
+  std::unique_ptr<Run> BeginRun(const SessionState& session_state, gsl::span<const int> feed_mlvalue_idxs,
+                                gsl::span<const OrtValue> feeds) const;
+
+  // Add the values computed by a successful Run to the cache.
+  void EndRun(Run& run) const;
+
+  size_t NumMemoizedNodes() const { return nodes_.size(); }
+
+  size_t NumCachedValues() const { return num_values_; }
+
+  size_t NumEntries() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SubgraphMemoizer);
+  SubgraphMemoizer() = default;
+
+  struct NodeInfo {
+    // output index of the node and the slot of its value in Entry::values
+    InlinedVector<std::pair<int, size_t>> cached_outputs;
+  };
+
+  InlinedVector<int> input_idxs_;
+  InlinedHashMap<NodeIndex, NodeInfo> nodes_;
+  size_t num_values_{0};
+  size_t max_entries_{0};
+
+  mutable OrtMutex mutex_;
+  // most recently used entry first. GUARDED_BY(mutex_)
+  mutable std::list<std::shared_ptr<const Entry>> entries_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/task_graph_executor.h"
+
+#include <atomic>
+#include <optional>
+
+#include "core/framework/sequential_executor.h"
+#include "core/framework/session_state.h"
+#include "core/framework/stream_execution_context.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<TaskGraph> BuildTaskGraph(const SessionState& session_state, const logging::Logger& logger) {
+  const auto& plan = *session_state.GetExecutionPlan();
+
+  const SequentialExecutionPlan::LogicStream* stream = nullptr;
+  for (const auto& logic_stream : plan.execution_plan) {
+    if (logic_stream && !logic_stream->steps_.empty()) {
+      if (stream != nullptr) {
+        LOGS(logger, INFO) << "Not using task graph execution as the execution plan has more than one stream.";
+        return nullptr;
+      }
+      stream = logic_stream.get();
+    }
+  }
+
+  if (stream == nullptr) {
+    return nullptr;
+  }
+
+  if (stream->device_.Type() != OrtDevice::CPU) {
+    LOGS(logger, INFO) << "Not using task graph execution as the nodes are not on CPU.";
+    return nullptr;
+  }
+
+  for (const auto& value_plan : plan.allocation_plan) {
+    if (value_plan.alloc_kind == AllocKind::kReuse) {
+      LOGS(logger, INFO) << "Not using task graph execution as the execution plan reuses buffers between values.";
+      return nullptr;
+    }
+  }
+
+  auto task_graph = std::make_unique<TaskGraph>();
+  InlinedHashMap<NodeIndex, size_t> node_tasks;
+  for (const auto& step : stream->steps_) {
+    if (step->GetType() != SequentialExecutionPlan::ExecutionStep::Type::kLaunchKernel) {
+      LOGS(logger, INFO) << "Not using task graph execution as the execution plan synchronizes between devices.";
+      return nullptr;
+    }
+
+    node_tasks.emplace(step->GetNodeIndex(), task_graph->nodes.size());
+    task_graph->nodes.push_back(step->GetNodeIndex());
+  }
+
+  const size_t num_tasks = task_graph->nodes.size();
+  task_graph->successors.resize(num_tasks);
+  task_graph->num_predecessors.resize(num_tasks, 0);
+
+  InlinedHashMap<size_t, size_t> value_release_actions;
+  for (size_t i = 0; i < plan.release_actions.size(); ++i) {
+    value_release_actions.emplace(plan.release_actions[i].value_index, i);
+  }
+
+  task_graph->release_ref_counts.resize(plan.release_actions.size(), 0);
+  task_graph->node_release_list.resize(plan.node_release_list.size());
+
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  const auto& ort_value_name_idx_map = session_state.GetOrtValueNameIdxMap();
+  for (size_t task = 0; task < num_tasks; ++task) {
+    const NodeIndex node_index = task_graph->nodes[task];
+    const Node& node = *graph_viewer.GetNode(node_index);
+
+    // the input edges include implicit inputs of subgraphs and control dependencies
+    InlinedHashSet<size_t> predecessors;
+    for (auto edge = node.InputEdgesBegin(), end = node.InputEdgesEnd(); edge != end; ++edge) {
+      auto it = node_tasks.find(edge->GetNode().Index());
+      if (it != node_tasks.end() && it->second != task && predecessors.insert(it->second).second) {
+        task_graph->successors[it->second].push_back(task);
+        ++task_graph->num_predecessors[task];
+      }
+    }
+
+    if (predecessors.empty()) {
+      task_graph->roots.push_back(task);
+    }
+
+    // the node's inputs are released once every node reading them ran
+    InlinedHashSet<size_t> release_actions;
+    auto add_reads = [&](const ConstPointerContainer<std::vector<NodeArg*>>& defs) {
+      for (const NodeArg* def : defs) {
+        int value_index = -1;
+        if (!def->Exists() || !ort_value_name_idx_map.GetIdx(def->Name(), value_index).IsOK()) {
+          continue;
+        }
+
+        auto it = value_release_actions.find(static_cast<size_t>(value_index));
+        if (it != value_release_actions.end() && release_actions.insert(it->second).second) {
+          task_graph->node_release_list[node_index].push_back(it->second);
+          ++task_graph->release_ref_counts[it->second];
+        }
+      }
+    };
+    add_reads(node.InputDefs());
+    add_reads(node.ImplicitInputDefs());
+  }
+
+  // values that no node reads are released where the execution plan releases them, i.e. after their producer
+  const std::vector<int> num_readers = task_graph->release_ref_counts;
+  for (size_t node_index = 0; node_index < plan.node_release_list.size(); ++node_index) {
+    for (size_t release_action : plan.node_release_list[node_index]) {
+      if (num_readers[release_action] == 0) {
+        task_graph->node_release_list[node_index].push_back(release_action);
+        ++task_graph->release_ref_counts[release_action];
+      }
+    }
+  }
+
+  LOGS(logger, INFO) << "Using task graph execution for " << num_tasks << " nodes with " << task_graph->roots.size()
+                     << " nodes without dependencies.";
+  return task_graph;
+}
+
+namespace {
+
+struct TaskGraphRun {
+  const TaskGraph& task_graph;
+  StreamExecutionContext& ctx;
+  SessionScope& session_scope;
+  const bool& terminate_flag;
+  concurrency::ThreadPool* thread_pool;
+
+  // number of predecessors of each task that did not run yet
+  std::unique_ptr<std::atomic_int[]> pending_predecessors;
+
+  OrtMutex status_mutex;
+  std::atomic<bool> failed{false};
+};
+
+void SetFailed(TaskGraphRun& run, Status& status) {
+  std::lock_guard<OrtMutex> lock(run.status_mutex);
+  run.ctx.SetStatus(status);
+  run.failed.store(true, std::memory_order_release);
+}
+
+void RunTasksFrom(TaskGraphRun& run, size_t task);
+
+void ScheduleTask(TaskGraphRun& run, size_t task) {
+  run.ctx.AddTask();
+  concurrency::ThreadPool::Schedule(run.thread_pool, [&run, task]() { RunTasksFrom(run, task); });
+}
+
+// Run `task`, then continue with one of the tasks that became ready and schedule the others, so that a chain of
+// dependent kernels stays on the same thread.
+void RunTasksFrom(TaskGraphRun& run, size_t task) {
+  for (;;) {
+    if (run.failed.load(std::memory_order_acquire)) {
+      break;
+    }
+
+    if (run.terminate_flag) {
+      Status status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+      SetFailed(run, status);
+      break;
+    }
+
+    Status status = ExecuteKernel(run.ctx, run.task_graph.nodes[task], 0, run.terminate_flag, run.session_scope);
+    if (!status.IsOK()) {
+      SetFailed(run, status);
+      break;
+    }
+
+    std::optional<size_t> next_task;
+    for (size_t successor : run.task_graph.successors[task]) {
+      if (run.pending_predecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (!next_task) {
+          next_task = successor;
+        } else {
+          ScheduleTask(run, successor);
+        }
+      }
+    }
+
+    if (!next_task) {
+      break;
+    }
+    task = *next_task;
+  }
+
+  run.ctx.CompleteTask();
+}
+
+}  // namespace
+
+void RunTaskGraph(const TaskGraph& task_graph, StreamExecutionContext& ctx, SessionScope& session_scope,
+                  const bool& terminate_flag) {
+  ORT_ENFORCE(!task_graph.roots.empty(), "The task graph has no tasks without dependencies.");
+
+  ctx.UseTaskGraphReleasePlan(task_graph);
+
+  TaskGraphRun run{task_graph, ctx, session_scope, terminate_flag, ctx.GetSessionState().GetThreadPool(),
+                   std::make_unique<std::atomic_int[]>(task_graph.nodes.size())};
+  for (size_t i = 0; i < task_graph.nodes.size(); ++i) {
+    run.pending_predecessors[i].store(task_graph.num_predecessors[i], std::memory_order_relaxed);
+  }
+
+  // the context counts the stream of the plan as one task, which is the chain of tasks run by this thread
+  for (size_t i = 1; i < task_graph.roots.size(); ++i) {
+    ScheduleTask(run, task_graph.roots[i]);
+  }
+  RunTasksFrom(run, task_graph.roots[0]);
+
+  ctx.WaitAll();
+}
+
+}  // namespace onnxruntime
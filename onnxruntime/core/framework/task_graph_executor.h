@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+
+class SessionScope;
+class SessionState;
+class StreamExecutionContext;
+
+/**
+ * Dependencies between the kernels of a single stream CPU execution plan, so that kernels which don't depend on each
+ * other can run at the same time instead of one after the other in the order of the plan.
+ *
+ * The values a kernel reads are released once all the kernels reading them ran, instead of after the last of them in
+ * the order of the plan, so `release_ref_counts` and `node_release_list` replace the ones of the execution plan.
+ * See StreamExecutionContext::UseTaskGraphReleasePlan.
+ */
+struct TaskGraph {
+  // node index of each task, in the order of the execution plan
+  InlinedVector<NodeIndex> nodes;
+  // tasks reading an output of each task
+  std::vector<InlinedVector<size_t>> successors;
+  // number of tasks each task reads an output of
+  std::vector<int> num_predecessors;
+  // tasks without predecessors
+  InlinedVector<size_t> roots;
+
+  // for each release action of the execution plan, the number of tasks to run before it is done
+  std::vector<int> release_ref_counts;
+  // for each node index, the release actions to count down once the node ran
+  std::vector<std::vector<size_t>> node_release_list;
+};
+
+/**
+ * Build the task graph of the finalized execution plan of `session_state`.
+ * Returns nullptr, and logs why, if the plan can't run out of order, in which case it runs sequentially as usual.
+ * A plan qualifies if it has a single stream of kernel launches and doesn't reuse buffers between values.
+ */
+std::unique_ptr<TaskGraph> BuildTaskGraph(const SessionState& session_state, const logging::Logger& logger);
+
+/**
+ * Run the tasks of `task_graph` on the intra-op thread pool of the session state of `ctx` as soon as their inputs are
+ * available. The calling thread runs tasks too, and returns once all of them ran or one failed.
+ * The status of the run is set in `ctx`.
+ */
+void RunTaskGraph(const TaskGraph& task_graph, StreamExecutionContext& ctx, SessionScope& session_scope,
+                  const bool& terminate_flag);
+
+}  // namespace onnxruntime
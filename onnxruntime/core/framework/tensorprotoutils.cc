@@ -755,6 +755,16 @@ static Status GetFileContent(
   return Status::OK();
 }
 
+bool HasExternalDataInFile(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  if (!utils::HasExternalData(tensor_proto)) {
+    return false;
+  }
+
+  std::unique_ptr<ExternalDataInfo> external_data_info;
+  return ExternalDataInfo::Create(tensor_proto.external_data(), external_data_info).IsOK() &&
+         external_data_info->GetRelPath() != kTensorProtoMemoryAddressTag;
+}
+
 Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_path,
                                  const ONNX_NAMESPACE::TensorProto& tensor_proto,
                                  void*& ext_data_buf, SafeInt<size_t>& ext_data_len, OrtCallback& ext_data_deleter) {
@@ -90,6 +90,10 @@ common::Status GetExtDataFromTensorProto(const Env& env, const ORTCHAR_T* model_
                                          void*& ext_data_buf, SafeInt<size_t>& ext_data_len,
                                          OrtCallback& ext_data_deleter);
 
+// Whether the tensor proto has external data in a file, rather than in memory tagged with
+// kTensorProtoMemoryAddressTag.
+bool HasExternalDataInFile(const ONNX_NAMESPACE::TensorProto& tensor_proto);
+
 // Convert the AttributeProto from a Constant node into a TensorProto that can be used as an initializer
 // If AttributeProto contains a TensorProto, this tensor proto is converted as is including the case when the
 // the data location is external. i.e. it does not load the external data.
@@ -3,9 +3,11 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/utils.h"
 
+#include <algorithm>
 #include <iomanip>
 
 #include "core/graph/graph_viewer.h"
+#include "core/framework/active_run_options.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/execution_frame.h"
@@ -104,6 +106,13 @@ static common::Status AllocateHelper(const AllocatorPtr& allocator,
                              p_data,
                              allocator, target_mlvalue);
       }
+    } else if (target_stream && allocator->IsStreamOrdered()) {
+      size_t len = Tensor::CalculateTensorStorageSize(source_tensor.DataType(), source_tensor.Shape());
+      void* p_data = allocator->AllocOnStream(len, target_stream);
+      Tensor::InitOrtValue(source_tensor.DataType(),
+                           source_tensor.Shape(),
+                           p_data,
+                           allocator, target_mlvalue);
     } else {
       Tensor::InitOrtValue(source_tensor.DataType(),
                            source_tensor.Shape(),
@@ -438,11 +447,43 @@ static void FinalizeFeedFetchCopyInfo(FeedsFetchesManager& feeds_fetches_manager
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feed_locations, fetch_alloc_info);
 }
 
+#ifdef ORT_ENABLE_STREAM
+// Copy a feed tensor on `input_copy_stream`, and set the notification the nodes using the feed wait on.
+// The target tensor is allocated on `stream`, the stream the feed would be copied on otherwise.
+static Status CopyInputOnInputCopyStream(const SessionState& session_state,
+                                         const MLValueCopyInfo& copy_info,
+                                         int feed_mlvalue_idx,
+                                         const OrtValue& source_mlvalue,
+                                         OrtValue& target_mlvalue,
+                                         Stream* stream,
+                                         Stream& input_copy_stream,
+                                         DeviceStreamCollection& device_stream_collection) {
+  if (!target_mlvalue.IsAllocated()) {
+    auto allocator = session_state.GetAllocator(copy_info.target_device);
+    ORT_ENFORCE(allocator != nullptr, "Failed to find allocator for device ", copy_info.target_device.ToString());
+    ORT_RETURN_IF_ERROR(utils::AllocateHelper(allocator, stream, source_mlvalue, target_mlvalue));
+  }
+
+  ORT_RETURN_IF_ERROR(session_state.GetDataTransferMgr().CopyTensorAsync(
+      source_mlvalue.Get<Tensor>(), *target_mlvalue.GetMutable<Tensor>(), input_copy_stream));
+  auto notification = input_copy_stream.CreateNotification(/*num_consumers*/ 1);
+  notification->ActivateAndUpdate();
+  device_stream_collection.SetInputCopyNotification(feed_mlvalue_idx, std::move(notification));
+  return Status::OK();
+}
+#endif
+
 static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
                                               gsl::span<const OrtValue> orig_feeds,
                                               std::vector<OrtValue>& new_feeds,
                                               gsl::span<const MLValueCopyInfo> copy_info,
-                                              gsl::span<Stream* const> feed_streams) {
+                                              gsl::span<Stream* const> feed_streams
+#ifdef ORT_ENABLE_STREAM
+                                              ,
+                                              const FeedsFetchesInfo* feeds_fetches_info = nullptr,
+                                              DeviceStreamCollection* device_stream_collection = nullptr
+#endif
+) {
   size_t num_feeds = orig_feeds.size();
   ORT_ENFORCE(copy_info.size() == num_feeds);
   ORT_ENFORCE(feed_streams.size() == num_feeds);
@@ -454,6 +495,24 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
 #endif
 
   for (size_t idx = 0; idx < num_feeds; ++idx) {
+#ifdef ORT_ENABLE_STREAM
+    // copy the tensors one at a time on the input copy stream of their device, if there is one, so that the nodes
+    // using a feed don't wait for the copies of the other feeds. A feed that is also a fetch is copied back without
+    // a node waiting for its copy, so it is copied on the stream of the nodes.
+    Stream* input_copy_stream = device_stream_collection && feed_streams[idx]
+                                    ? device_stream_collection->GetInputCopyStream(feed_streams[idx]->GetDevice())
+                                    : nullptr;
+    if (input_copy_stream && orig_feeds[idx].IsTensor() &&
+        copy_info[idx].source_device != copy_info[idx].target_device &&
+        std::find(feeds_fetches_info->fetches_mlvalue_idxs.begin(), feeds_fetches_info->fetches_mlvalue_idxs.end(),
+                  feeds_fetches_info->feeds_mlvalue_idxs[idx]) == feeds_fetches_info->fetches_mlvalue_idxs.end()) {
+      ORT_RETURN_IF_ERROR(CopyInputOnInputCopyStream(session_state, copy_info[idx],
+                                                     feeds_fetches_info->feeds_mlvalue_idxs[idx],
+                                                     orig_feeds[idx], new_feeds[idx], feed_streams[idx],
+                                                     *input_copy_stream, *device_stream_collection));
+      continue;
+    }
+#endif
 #if !defined(DISABLE_SPARSE_TENSORS)
     ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], orig_feeds[idx], new_feeds[idx],
                                            feed_streams[idx],
@@ -666,7 +725,12 @@ ExecuteGraphImpl(const SessionState& session_state,
         feed_streams.push_back(nullptr);
       }
 #endif
+#ifdef ORT_ENABLE_STREAM
+      ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info, feed_streams,
+                                                  &feeds_fetches_info, device_stream_collection));
+#else
       ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info, feed_streams));
+#endif
       feeds_to_use = device_feeds;
     }
 
@@ -737,21 +801,22 @@ common::Status ExecuteGraph(const SessionState& session_state,
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
                             bool only_execute_path_to_fetches,
-                            Stream* parent_stream) {
+                            Stream* parent_stream,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
 #ifdef ORT_ENABLE_STREAM
   DeviceStreamCollection* device_stream_collection = device_stream_collection_holder.p_.get();
-  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  auto retval = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                                  execution_mode, terminate_flag, logger,
                                  device_stream_collection,
                                  only_execute_path_to_fetches,
                                  parent_stream);
   return retval;
 #else
-  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
+  return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
                           execution_mode, terminate_flag, logger,
                           only_execute_path_to_fetches,
                           parent_stream);
@@ -765,7 +830,9 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #ifdef ORT_ENABLE_STREAM
                             DeviceStreamCollectionHolder& device_stream_collection_holder,
 #endif
-                            const logging::Logger& logger) {
+                            const logging::Logger& logger,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  ActiveRunOptions::Scope active_run_options_scope(run_options);
   return ExecuteGraph(session_state,
                       feeds_fetches_manager,
                       feeds, fetches,
@@ -775,7 +842,9 @@ common::Status ExecuteGraph(const SessionState& session_state,
 #ifdef ORT_ENABLE_STREAM
                       device_stream_collection_holder,
 #endif
-                      run_options.only_execute_path_to_fetches);
+                      run_options.only_execute_path_to_fetches,
+                      nullptr,
+                      fetch_allocators);
 }
 
 #ifdef ENABLE_TRAINING
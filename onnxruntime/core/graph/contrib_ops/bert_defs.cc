@@ -1052,6 +1052,87 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           GroupQueryAttentionTypeAndShapeInference(ctx, 3);
         }));
 
+constexpr const char* PagedAttention_ver1_doc = R"DOC(
+Decoding self attention over a paged key/value cache, for one new token of each sequence.
+
+The cache is a pool of blocks of block_size tokens shared by all the sequences, and row b of block_tables lists
+the blocks holding the tokens of sequence b in order: token t of the sequence is in slot t % block_size of block
+block_tables[b, t / block_size]. The key and value of the new token are written to slot seqlens[b] - 1, then the
+query attends to the seqlens[b] tokens of the sequence. Long sequences are split into partitions attended to in
+parallel, and their results are merged.
+
+Sequences may share blocks, for instance the beams of a beam search sharing the blocks of their common prefix, so
+reordering the beams only reorders the rows of block_tables. The block receiving the new token of a sequence must
+not be shared with another sequence.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    PagedAttention, 1,
+    OpSchema()
+        .SetDoc(PagedAttention_ver1_doc)
+        .Attr("num_heads", "Number of attention heads for q", AttributeProto::INT)
+        .Attr("kv_num_heads", "Number of attention heads for k and v", AttributeProto::INT)
+        .Attr("scale",
+              "Custom scale will be used if specified. Default value is 1/sqrt(head_size)",
+              AttributeProto::FLOAT,
+              OPTIONAL_VALUE)
+        .Input(0,
+               "query",
+               "Query with shape (batch_size, 1, hidden_size)",
+               "T")
+        .Input(1,
+               "key",
+               "Key of the new token with shape (batch_size, 1, kv_hidden_size)",
+               "T")
+        .Input(2,
+               "value",
+               "Value of the new token with shape (batch_size, 1, kv_hidden_size)",
+               "T")
+        .Input(3,
+               "key_cache",
+               "Key cache with shape (num_blocks, kv_num_heads, block_size, head_size)",
+               "T")
+        .Input(4,
+               "value_cache",
+               "Value cache with shape (num_blocks, kv_num_heads, block_size, head_size)",
+               "T")
+        .Input(5,
+               "block_tables",
+               "The blocks of each sequence, with shape (batch_size, max_blocks_per_sequence)",
+               "M")
+        .Input(6,
+               "seqlens",
+               "1D tensor of shape (batch_size) with the length of each sequence including the new token",
+               "M")
+        .Output(0,
+                "output",
+                "3D output tensor with shape (batch_size, 1, hidden_size)",
+                "T")
+        .Output(1,
+                "key_cache_out",
+                "The key cache with the new token, which may share the buffer of key_cache",
+                "T")
+        .Output(2,
+                "value_cache_out",
+                "The value cache with the new token, which may share the buffer of value_cache",
+                "T")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("M", {"tensor(int32)"}, "Constrain block tables and sequence lengths to int tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          propagateElemTypeFromInputToOutput(ctx, 3, 1);
+          propagateElemTypeFromInputToOutput(ctx, 4, 2);
+          if (hasInputShape(ctx, 0)) {
+            propagateShapeFromInputToOutput(ctx, 0, 0);
+          }
+          if (hasInputShape(ctx, 3)) {
+            propagateShapeFromInputToOutput(ctx, 3, 1);
+          }
+          if (hasInputShape(ctx, 4)) {
+            propagateShapeFromInputToOutput(ctx, 4, 2);
+          }
+        }));
+
 constexpr const char* Longformer_Attention_doc = R"DOC(
 Longformer Self Attention with a local context and a global context. Tokens attend locally: Each token
 attends to its W previous tokens and W succeeding tokens with W being the window length. A selected few tokens
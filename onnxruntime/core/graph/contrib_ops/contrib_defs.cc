@@ -627,6 +627,87 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* ElementwiseChain_ver1_doc = R"DOC(
+Apply a chain of element-wise ops to the first input in one pass.
+Step i applies ops[i] to the result of the previous step, or to the first input for the first step.
+Add, Sub, Mul and Div steps take the next of the remaining inputs as their other operand, which is either of
+the shape of the first input or a tensor with a single element. Relu, Sigmoid, Softplus, Softsign and Tanh steps
+take no operand. On CUDA, which also takes float16 tensors, the steps are computed in float and run in a single
+kernel launch with at most 16 steps. This op is created by the ElementwiseChainFusion transformer.)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    ElementwiseChain, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(ElementwiseChain_ver1_doc)
+        .Attr("ops", "The op type of each step of the chain.", AttributeProto::STRINGS)
+        .Attr("operand_first",
+              "One value per step, 1 when the operand of an Add, Sub, Mul or Div step is its first input and "
+              "the result of the previous step its second. Default is all 0.",
+              AttributeProto::INTS, OPTIONAL_VALUE)
+        .Input(0, "inputs", "The input to the chain, followed by the operands of its binary steps in order.", "T",
+               OpSchema::Variadic, true, 1)
+        .Output(0, "Y", "The output, of the shape of the first input.", "T")
+        .TypeConstraint("T", {"tensor(float16)", "tensor(float)"},
+                        "Constrain input and output types to float16 and float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+constexpr const char* MLPreprocessing_ver1_doc = R"DOC(
+Apply a chain of ai.onnx.ml preprocessing ops to the rows of a float tensor of shape [N, C] or [C] in one pass.
+Step i applies stages[i] to the result of the previous step, or to the input for the first step, with the next
+value_counts[i] floats of values as its parameters:
+Imputer takes replaced_value_float followed by imputed_value_floats, Scaler takes offset followed by scale,
+Binarizer takes threshold and Normalizer takes none, its norm being the next of norms.
+The stages behave like the ops they replace. This op is created by the MLPreprocessingFusion transformer.)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MLPreprocessing, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(MLPreprocessing_ver1_doc)
+        .Attr("stages", "The op type of each step: Imputer, Scaler, Binarizer or Normalizer.",
+              AttributeProto::STRINGS)
+        .Attr("value_counts", "The number of floats of values taken by each step.", AttributeProto::INTS)
+        .Attr("values", "The parameters of the steps, one after the other.", AttributeProto::FLOATS,
+              OPTIONAL_VALUE)
+        .Attr("norms", "The norm of each Normalizer step: MAX, L1 or L2.", AttributeProto::STRINGS, OPTIONAL_VALUE)
+        .Input(0, "X", "The input, of shape [N, C] or [C].", "T")
+        .Output(0, "Y", "The output, of the shape of the input.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+constexpr const char* ShapeExpression_ver1_doc = R"DOC(
+Compute a 1D int64 tensor from the dims of the inputs, whose data isn't read. Each element of the output is given by
+a postfix program, and the programs of the elements follow each other in the program attribute as opcodes with their
+operands: 0 v pushes the constant v, 1 i a pushes dim a of input i, 2, 3, 4 and 5 replace the two values on the top of
+the stack with their sum, difference, product and quotient (truncated, like Div), and 6 ends the element with the
+value on the top of the stack.
+This op is created by the ShapeExpressionFusion transformer from the Shape, Gather, Concat and arithmetic nodes that
+compute the shape input of a Reshape or Expand.)DOC";
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    ShapeExpression, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(ShapeExpression_ver1_doc)
+        .Attr("program", "The opcodes and operands of the programs of the output elements.", AttributeProto::INTS)
+        .Input(0, "inputs", "The tensors whose dims the program reads.", "T", OpSchema::Variadic, false, 1)
+        .Output(0, "Y", "The 1D tensor of the values of the elements.", "tensor(int64)")
+        .TypeConstraint("T", OpSchema::all_tensor_types(), "Allow inputs of any tensor type.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          ctx.getOutputType(0)->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto::INT64);
+          const auto* program = ctx.getAttribute("program");
+          if (program != nullptr) {
+            int64_t num_elements = 0;
+            for (int i = 0; i < program->ints_size(); ++i) {
+              const int64_t op = program->ints(i);
+              num_elements += op == 6 ? 1 : 0;
+              i += op == 0 ? 1 : op == 1 ? 2 : 0;
+            }
+            ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(num_elements);
+          }
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -2957,6 +3038,10 @@ Input zero_points is stored as uint8_t. If bits <= 4, two zero points are stored
       .Attr("N", "size of each output feature", AttributeProto::INT)
       .Attr("bits", "number of bits used for weight quantization (default 4)", AttributeProto::INT)
       .Attr("block_size", "number of groupsize used for weight quantization,(default 128). It needs to be a power of 2 and not smaller than 16.", AttributeProto::INT)
+      .Attr("accuracy_level",
+            "The minimum accuracy level of input A: 0 (unset), 1 (fp32), 2 (fp16), 3 (bf16) or 4 (int8). "
+            "With 4, input A may be quantized to int8 blocks internally when B is constant (default 0).",
+            AttributeProto::INT, static_cast<int64_t>(0))
       .Input(0, "A", "The input tensor, not quantized", "T1")
       .Input(1, "B", "1-dimensional data blob", "T2")
       .Input(2, "scales", "quantization scale", "T1")
@@ -3008,6 +3093,91 @@ Input absmax is stored in same type as original type of B(float32, float16) with
         MatmulWithQuantWeightShapeInference(ctx, in_features, out_features);
       });
 
+  static const char* MatMulFloat8_ver1_doc = R"DOC(
+MatMulFloat8 is a MatMul with the weight stored as 8 bit floats (float8e4m3fn, float8e4m3fnuz, float8e5m2 or
+float8e5m2fnuz). It computes Y = A * (B * B_scale) + bias, like a MatMul whose input B is the output of a
+DequantizeLinear with a zero zero point, with differences:
+  1. Input B is a 2D constant Matrix of shape [K, N]. Its input feature count and output feature count are specified by attribute 'K' and 'N'.
+  2. Input B_scale is a scalar scale for the whole weight, or has shape [N] for a scale per output feature.
+  3. The optional input bias has shape [N] and is added to the output.
+
+The weight is decoded in small tiles while multiplying, so it only takes a byte per element in memory.
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulFloat8)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(MatMulFloat8_ver1_doc)
+      .Attr("K", "size of each input feature", AttributeProto::INT)
+      .Attr("N", "size of each output feature", AttributeProto::INT)
+      .Input(0, "A", "The input tensor, not quantized", "T1")
+      .Input(1, "B", "2-dimensional float8 data for weight, with shape [K, N]", "T2")
+      .Input(2, "B_scale", "scale of the weight, a scalar or with shape [N]", "T1")
+      .Input(3, "bias", "bias with shape [N]", "T1", OpSchema::Optional)
+      .Output(0, "Y", "tensor. The output tensor has the same rank as the input. ", "T1")
+      .TypeConstraint("T1", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float/half_float tensors.")
+      .TypeConstraint("T2", {"tensor(float8e4m3fn)", "tensor(float8e4m3fnuz)", "tensor(float8e5m2)", "tensor(float8e5m2fnuz)"},
+                      "Constrain weight types to float8 tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // Type inference
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        // Shape inference
+        int64_t in_features = getAttribute(ctx, "K", -1);
+        int64_t out_features = getAttribute(ctx, "N", -1);
+        MatmulWithQuantWeightShapeInference(ctx, in_features, out_features);
+      });
+
+  static const char* GatherBlockQuantized_ver1_doc = R"DOC(
+GatherBlockQuantized is a Gather along axis 0 of a 2D table, like an embedding table, quantized blockwise with
+4 or 8 bits in the same format as input B of MatMulNBits. Only the gathered rows are dequantized.
+  1. Input data holds the table of shape [N, K], where N is the number of rows and K is specified by attribute 'K'.
+  2. Each row is quantized with x bits, specified by attribute 'bits', in blocks of block_size elements, specified by
+     attribute 'block_size'. block_size must be a power of 2 and not smaller than 16.
+  3. The scale and zero point of each block are specified by inputs scales and zero_points.
+
+Input data is stored as uint8_t with shape: [N][n_blocks_per_row][blob_size] in which:
+- n_blocks_per_row = (K + block_size - 1) / block_size
+- blob_size = block_size / 8 * bits
+With 4 bits, the first of two elements is stored in the low 4 bits of a byte.
+
+Input scales is stored in same type as the output with shape like: [N * n_blocks_per_row]
+Input zero_points is stored as uint8_t, with shape:
+  - [(N * n_blocks_per_row + 1) / 2] if bits is 4, two zero points per byte starting with the low 4 bits
+  - [N * n_blocks_per_row] if bits is 8
+If it's not specified, the zero point is 8 with 4 bits and 128 with 8 bits.
+
+The output has shape indices.shape + [K].
+)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(GatherBlockQuantized)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(GatherBlockQuantized_ver1_doc)
+      .Attr("K", "size of each row of the table", AttributeProto::INT)
+      .Attr("bits", "number of bits used for quantization, 4 or 8 (default 4)", AttributeProto::INT,
+            static_cast<int64_t>(4))
+      .Attr("block_size", "number of elements of a row quantized together (default 128). It needs to be a power of 2 and not smaller than 16.",
+            AttributeProto::INT, static_cast<int64_t>(128))
+      .Input(0, "data", "quantized table with shape [N, n_blocks_per_row, blob_size]", "T2")
+      .Input(1, "indices", "indices of the rows to gather, negative indices count back from N", "Tind")
+      .Input(2, "scales", "quantization scale", "T1")
+      .Input(3, "zero_points", "quantization zero points", "T2", OpSchema::Optional)
+      .Output(0, "output", "the dequantized rows, with shape indices.shape + [K]", "T1")
+      .TypeConstraint("T1", {"tensor(float)", "tensor(float16)"}, "Constrain scales and output types to float/half_float tensors.")
+      .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized types to uint8.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        // Type inference
+        propagateElemTypeFromInputToOutput(ctx, 2, 0);
+        // Shape inference
+        if (!hasInputShape(ctx, 1)) {
+          return;
+        }
+        auto* output_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        *output_shape = getInputShape(ctx, 1);
+        output_shape->add_dim()->set_dim_value(getAttribute(ctx, "K", -1));
+      });
+
 #ifdef ENABLE_ATEN
   ONNX_CONTRIB_OPERATOR_SCHEMA(ATen)
       .SetDomain(kPytorchAtenDomain)
@@ -234,6 +234,19 @@ ONNX_MS_OPERATOR_SET_SCHEMA(QLinearConv, 1,
                                 .Input(6, "y_scale", "", "tensor(float)")
                                 .Input(7, "y_zero_point", "", "T3")
                                 .Input(8, "B", "", "T4", OpSchema::Optional)
+                                .Input(9, "sum",
+                                       "Optional tensor of the shape of y, added to the quantized convolution "
+                                       "result like a QLinearAdd, e.g. a residual connection.",
+                                       "T3", OpSchema::Optional)
+                                .Input(10, "sum_scale", "Scale of sum. Required with sum.", "tensor(float)",
+                                       OpSchema::Optional)
+                                .Input(11, "sum_zero_point", "Zero point of sum. Required with sum.", "T3",
+                                       OpSchema::Optional)
+                                .Input(12, "out_scale", "Scale of the output when sum is added. Required with sum.",
+                                       "tensor(float)", OpSchema::Optional)
+                                .Input(13, "out_zero_point",
+                                       "Zero point of the output when sum is added. Required with sum.", "T3",
+                                       OpSchema::Optional)
                                 .Output(0, "y", "", "T3")
                                 .TypeConstraint("T1", {"tensor(int8)", "tensor(uint8)"}, "")
                                 .TypeConstraint("T2", {"tensor(int8)", "tensor(uint8)"}, "")
@@ -246,6 +259,12 @@ ONNX_MS_OPERATOR_SET_SCHEMA(QLinearConv, 1,
                                 .Attr("pads", "", AttributeProto::INTS, OPTIONAL_VALUE)
                                 .Attr("group", "", AttributeProto::INT, static_cast<int64_t>(1))
                                 .Attr("channels_last", "", AttributeProto::INT, static_cast<int64_t>(0))
+                                .Attr("activation",
+                                      "Optional activation applied to the quantized output, after sum is added: "
+                                      "'Relu' or 'Clip'.",
+                                      AttributeProto::STRING, OPTIONAL_VALUE)
+                                .Attr("activation_params", "The min and max of the 'Clip' activation.",
+                                      AttributeProto::FLOATS, OPTIONAL_VALUE)
                                 .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
                                   auto x_type = ctx.getInputType(0);
                                   auto w_type = ctx.getInputType(3);
@@ -3,6 +3,8 @@
 
 #include "core/graph/graph.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <fstream>
 #include <iostream>
@@ -178,8 +180,13 @@ static std::string GenerateSchemaKey(const IndexedSubGraph& subgraph_ptr) {
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+static uint64_t NextNodeArgVersion() noexcept {
+  static std::atomic<uint64_t> last_version{0};
+  return ++last_version;
+}
+
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
-NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type) {
+NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type) : version_(NextNodeArgVersion()) {
   node_arg_info_.set_name(name);
   // If the name is empty, it means the arg does not exist.
   exists_ = !(name.empty());
@@ -197,7 +204,7 @@ NodeArg::NodeArg(const std::string& name, const TypeProto* p_node_arg_type) {
 }
 #endif  // #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
 
-NodeArg::NodeArg(NodeArgInfo&& node_arg_info) {
+NodeArg::NodeArg(NodeArgInfo&& node_arg_info) : version_(NextNodeArgVersion()) {
   node_arg_info_ = std::move(node_arg_info);
 
   exists_ = !node_arg_info_.name().empty();
@@ -288,6 +295,7 @@ bool NodeArg::HasTensorOrScalarShape() const {
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 void NodeArg::SetShape(const TensorShapeProto& shape) {
+  MarkChanged();
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -319,6 +327,7 @@ void NodeArg::SetShape(const TensorShapeProto& shape) {
 }
 
 void NodeArg::ClearShape() {
+  MarkChanged();
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -382,6 +391,9 @@ common::Status NodeArg::OverrideTypesHelper(const ONNX_NAMESPACE::TypeProto& inp
 
 common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& input_type, bool strict,
                                            bool override_types, const logging::Logger& logger) {
+  // MergeShapeInfo updates the shape in place
+  MarkChanged();
+
   if (!utils::HasType(node_arg_info_)) {
     SetType(input_type);
     return Status::OK();
@@ -501,6 +513,7 @@ void NodeArg::SetType(DataType p_type) {
 
   type_ = p_type;
   *(node_arg_info_.mutable_type()) = DataTypeUtils::ToTypeProto(p_type);
+  MarkChanged();
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -510,6 +523,7 @@ void NodeArg::SetType(DataType p_type) {
 void NodeArg::SetType(const TypeProto& type_proto) {
   type_ = DataTypeUtils::ToType(type_proto);
   *(node_arg_info_.mutable_type()) = type_proto;
+  MarkChanged();
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -518,6 +532,10 @@ bool NodeArg::Exists() const noexcept {
   return exists_;
 }
 
+void NodeArg::MarkChanged() noexcept {
+  version_ = NextNodeArgVersion();
+}
+
 Node::EdgeEnd::EdgeEnd(const Node& node, int src_arg_index, int dst_arg_index) noexcept
     : node_(&node),
       src_arg_index_(src_arg_index),
@@ -932,6 +950,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+  inferred_def_versions_.clear();
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -982,6 +1001,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  inferred_def_versions_.clear();
   return attributes_.erase(attr_name) > 0;
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -993,6 +1013,9 @@ int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attrib
   for (const auto& name : removable_attributes) {
     n_removed += static_cast<int>(attributes_.erase(name));
   }
+  if (n_removed > 0) {
+    inferred_def_versions_.clear();
+  }
   can_be_saved_ = can_be_saved_ && n_removed == 0;
   return n_removed;
 }
@@ -1173,14 +1196,21 @@ Graph::Graph(const Model& owning_model,
 
   // Process 'Constant' nodes
   // Put the 'TensorProto' stored in the 'Constant' nodes attribute into the graphs initializer list
-  for (auto& node : graph_proto_->node()) {
+  for (auto& node : *graph_proto_->mutable_node()) {
     if (node.op_type() != kConstant) {
       continue;
     }
 
     const gsl::not_null<TensorProto*> tensor{graph_proto_->add_initializer()};
-    auto status = utils::ConstantNodeProtoToTensorProto(node, model_path, *tensor);
-    ORT_ENFORCE(status.IsOK(), status.ToString());
+    if (node.attribute_size() > 0 && node.attribute(0).type() == AttributeProto_AttributeType_TENSOR &&
+        node.output_size() > 0) {
+      // the node is removed below, so take its tensor instead of holding two copies of the data
+      tensor->Swap(node.mutable_attribute(0)->mutable_t());
+      *(tensor->mutable_name()) = node.output(0);
+    } else {
+      auto status = utils::ConstantNodeProtoToTensorProto(node, model_path, *tensor);
+      ORT_ENFORCE(status.IsOK(), status.ToString());
+    }
     // Ensure initializers are also graph inputs.
     if (ir_version_ < 4) {
       TypeProto t{TypeProtoFromTensorProto(*tensor)};
@@ -1210,13 +1240,17 @@ Graph::Graph(const Model& owning_model,
   // initializers directly. We remove them from graph_proto. We will reconstitute them
   // when saving to ORT format to save space on disk.
   if (graph_proto_->sparse_initializer_size() > 0) {
-    for (const auto& sparse_tensor : graph_proto_->sparse_initializer()) {
+    for (auto& sparse_tensor : *graph_proto_->mutable_sparse_initializer()) {
       ORT_ENFORCE(utils::HasName(sparse_tensor), "Sparse initializer must have a name. This model is invalid");
       const gsl::not_null<TensorProto*> tensor{graph_proto_->add_initializer()};
       auto status = utils::SparseTensorProtoToDenseTensorProto(sparse_tensor, model_path, *tensor);
       ORT_ENFORCE(status.IsOK(), status.ToString());
       auto p = sparse_tensor_names_.emplace(tensor->name());
       ORT_ENFORCE(p.second, "Duplicate sparse_tensor_initializer: '", tensor->name(), "' Model is invalid.");
+
+      // free the sparse data now so the sparse and dense forms of all initializers are never held at the same time.
+      // Clear() would keep the capacity of the buffers.
+      SparseTensorProto().Swap(&sparse_tensor);
     }
 
     // Remove sparse_initializers from protobuf to save memory as they are converted to dense now
@@ -2533,15 +2567,32 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
+  // The versions of the input and output NodeArgs of a node. A node whose versions did not change since its last type
+  // and shape inference, and whose attributes did not change either, would infer the same outputs again.
+  // Nodes with subgraphs and the nodes of subgraphs always run inference, as they depend on outer scope values.
+  const bool incremental_type_inference = !options.full_type_inference && !options.override_types &&
+                                          parent_node_ == nullptr;
+  auto get_def_versions = [](const Node& node, InlinedVector<uint64_t>& versions) {
+    versions.clear();
+    for (const auto* input_def : node.GetDefinitions().input_defs) {
+      versions.push_back(input_def->version_);
+    }
+    versions.push_back(0);  // versions start at 1
+    for (const auto* output_def : node.GetDefinitions().output_defs) {
+      versions.push_back(output_def->version_);
+    }
+  };
+  InlinedVector<uint64_t> def_versions;
+  InlinedVector<std::pair<uint64_t, std::string>> output_states;
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
-
-    NodeProto node_proto;
-    node.ToProto(node_proto);
     const auto& node_name = node.Name();
 
     if (!node.Op()) {
+      NodeProto node_proto;
+      node.ToProto(node_proto);
       {
         auto status = Status::OK();
         ORT_TRY {
@@ -2614,11 +2665,38 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
-    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    bool inference_current = false;
+    if (incremental_type_inference && !node.ContainsSubgraph()) {
+      get_def_versions(node, def_versions);
+      inference_current = def_versions == node.inferred_def_versions_;
+    }
+
+    if (!inference_current || options.verify_incremental_type_inference) {
+      // outputs that inference leaves as they were keep their version, so their consumers can skip inference
+      const auto& output_defs = node.GetDefinitions().output_defs;
+      output_states.clear();
+      for (const auto* output_def : output_defs) {
+        output_states.emplace_back(output_def->version_, output_def->ToProto().SerializeAsString());
+      }
+
+      NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+
+      for (size_t i = 0; i < output_defs.size(); ++i) {
+        if (output_defs[i]->ToProto().SerializeAsString() == output_states[i].second) {
+          output_defs[i]->version_ = output_states[i].first;
+        } else if (inference_current) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Type and shape inference changed output ",
+                                 output_defs[i]->Name(), " of node (", node_name,
+                                 "), although the node and its inputs did not change since the previous Resolve.");
+        }
+      }
+
+      get_def_versions(node, node.inferred_def_versions_);
+    }
 
     // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
+    for (const auto* output_def : node.OutputDefs()) {
+      lsc.output_names.insert(output_def->Name());
     }
   }
 
@@ -2825,6 +2903,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
   SetGraphResolveNeeded();
+  MarkInitializerChanged(tensor.name());
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
     // the shape will be set to the correct value in TypeCheckInputsAndInitializers as we don't yet know whether there
@@ -2873,6 +2952,13 @@ bool Graph::IsSparseInitializer(const std::string& name) const {
 }
 #endif
 
+void Graph::MarkInitializerChanged(const std::string& name) {
+  // shape inference of the consumers may read the initializer value
+  if (auto* node_arg = GetNodeArg(name)) {
+    node_arg->MarkChanged();
+  }
+}
+
 void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
   bool found = false;
   auto iter = name_to_initial_tensor_.find(tensor_name);
@@ -2883,6 +2969,7 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     sparse_tensor_names_.erase(tensor_name);
 #endif
     SetGraphResolveNeeded();
+    MarkInitializerChanged(tensor_name);
   } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
     ORT_ENFORCE(sparse_tensor_names_.count(tensor_name) == 0, "sparse_tensor_names_ not in sync with name_to_initial_tensor_");
@@ -2937,6 +3024,7 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
   **existing_entry = std::move(new_initializer);
+  MarkInitializerChanged((*existing_entry)->name());
 
   return Status::OK();
 }
@@ -4019,6 +4107,65 @@ Node& Graph::FuseSubGraph(const IndexedSubGraph& sub_graph,
   return fused_node;
 }
 
+bool Graph::TryGetFunctionProtoForInlining(const Node& node, FunctionProto& function_proto) {
+  if (node.func_template_ != nullptr || node.Op() == nullptr || !node.Op()->HasContextDependentFunction()) {
+    return node.TryGetFunctionProto(function_proto);
+  }
+
+  // the schema builds the body from the attributes, the input types and which optional inputs and outputs exist
+  std::string key;
+  auto append_to_key = [&key](std::string_view part) {
+    key.append(std::to_string(part.size())).append(1, ':').append(part);
+  };
+  append_to_key(node.Domain());
+  append_to_key(node.OpType());
+  append_to_key(std::to_string(node.SinceVersion()));
+
+  InlinedVector<const AttributeProto*> attributes;
+  attributes.reserve(node.GetAttributes().size());
+  for (const auto& entry : node.GetAttributes()) {
+    attributes.push_back(&entry.second);
+  }
+  std::sort(attributes.begin(), attributes.end(),
+            [](const AttributeProto* a, const AttributeProto* b) { return a->name() < b->name(); });
+  append_to_key(std::to_string(attributes.size()));
+  for (const auto* attribute : attributes) {
+    append_to_key(attribute->SerializeAsString());
+  }
+
+  append_to_key(std::to_string(node.InputDefs().size()));
+  for (const auto* input_def : node.InputDefs()) {
+    const auto* type = input_def->Exists() ? input_def->TypeAsProto() : nullptr;
+    append_to_key(type != nullptr ? "t" + type->SerializeAsString() : "");
+  }
+  append_to_key(std::to_string(node.OutputDefs().size()));
+  for (const auto* output_def : node.OutputDefs()) {
+    append_to_key(output_def->Exists() ? "1" : "0");
+  }
+
+  Graph* top_level_graph = this;
+  while (top_level_graph->parent_graph_ != nullptr) {
+    top_level_graph = top_level_graph->parent_graph_;
+  }
+
+  auto& cache = top_level_graph->context_dependent_function_bodies_;
+  auto entry = cache.find(key);
+  if (entry == cache.end()) {
+    std::optional<FunctionProto> body;
+    FunctionProto built_body;
+    if (node.TryGetFunctionProto(built_body)) {
+      body = std::move(built_body);
+    }
+    entry = cache.emplace(std::move(key), std::move(body)).first;
+  }
+
+  if (!entry->second.has_value()) {
+    return false;
+  }
+  function_proto = *entry->second;
+  return true;
+}
+
 Status Graph::InlineFunction(Node& callnode) {
   const auto& model_path = ModelPath();
   auto output_edges = callnode.GetRelationships().output_edges;
@@ -4036,7 +4183,8 @@ Status Graph::InlineFunction(Node& callnode) {
     // This is the normal use-case: inlining a FunctionProto (representing
     // a model-local function or a schema-defined function).
     FunctionProto inlined_fp;
-    ORT_ENFORCE(callnode.TryGetFunctionProto(inlined_fp), "Node has no function body and cannot be inlined.");
+    ORT_ENFORCE(TryGetFunctionProtoForInlining(callnode, inlined_fp),
+                "Node has no function body and cannot be inlined.");
     function_utils::Specialize(inlined_fp, callnode, uniq_identifier);
 
     auto to_node_arg = [this](const std::string& name) {
@@ -4170,6 +4318,11 @@ void Graph::SetInputs(gsl::span<const NodeArg* const> inputs) {
     ComputeOverridableInitializers();
   }
 
+  // an initializer that is also a graph input is not constant, so its value is not used to infer shapes
+  for (const auto* input : inputs) {
+    MarkInitializerChanged(input->Name());
+  }
+
   graph_inputs_manually_set_ = true;
   GraphProtoSyncNeeded(true);
   GraphResolveNeeded(true);
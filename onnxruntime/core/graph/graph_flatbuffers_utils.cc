@@ -47,6 +47,9 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     std::vector<uint8_t> unpacked_tensor;
     ORT_RETURN_IF_ERROR(
         onnxruntime::utils::UnpackInitializerData(initializer, model_path, unpacked_tensor));
+    if (unpacked_tensor.size() >= kMinInitializerBytesForDirectUse) {
+      builder.ForceVectorAlignment(unpacked_tensor.size(), sizeof(uint8_t), kInitializerRawDataAlignment);
+    }
     raw_data = builder.CreateVector(unpacked_tensor.data(), unpacked_tensor.size());
   }
 
@@ -201,7 +204,7 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor, TensorProto& init
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
-    if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() > 127) {
+    if (load_options.can_use_flatbuffer_for_initializers && fbs_raw_data->size() >= kMinInitializerBytesForDirectUse) {
       initializer.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
       static_assert(sizeof(void*) <= sizeof(ExternalDataInfo::OFFSET_TYPE));
@@ -44,6 +44,14 @@ struct SparseTensor;
 
 namespace utils {
 
+// Initializers with at least this many bytes of raw data can reference the flatbuffer directly when loaded.
+constexpr size_t kMinInitializerBytesForDirectUse = 128;
+
+// Alignment of the raw data of those initializers in the flatbuffer, relative to the start of the buffer.
+// A buffer at an aligned address, like an mmapped model file, holds them at addresses the kernels can read as well
+// as the ones allocated by ORT.
+constexpr size_t kInitializerRawDataAlignment = 64;
+
 Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
     const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor);
@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/graph/graph_viewer.h"
+
+#include <algorithm>
+
+#include "core/common/inlined_containers.h"
+#include "core/common/safeint.h"
 #include "core/graph/indexed_sub_graph.h"
 
 namespace onnxruntime {
@@ -39,6 +44,68 @@ struct PriorityNodeCompare {
     return n1->Index() > n2->Index();
   }
 };
+
+namespace {
+// Estimate the size in bytes of the tensor of node_arg. Symbolic and unknown dimensions count as 1, so the estimate
+// is only meaningful relative to the sizes of the other tensors of a graph.
+size_t EstimateTensorSize(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return 0;
+  }
+
+  size_t element_size = 1;
+  switch (type->tensor_type().elem_type()) {
+    case ONNX_NAMESPACE::TensorProto_DataType_COMPLEX128:
+      element_size = 16;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_COMPLEX64:
+      element_size = 8;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT32:
+      element_size = 4;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+      element_size = 2;
+      break;
+    default:
+      break;
+  }
+
+  SafeInt<size_t> size = element_size;
+  if (const auto* shape = node_arg.Shape()) {
+    for (const auto& dim : shape->dim()) {
+      if (dim.has_dim_value() && dim.dim_value() > 0) {
+        size *= static_cast<size_t>(dim.dim_value());
+      }
+    }
+  }
+
+  return size;
+}
+
+// the distinct existing explicit and implicit inputs of node
+InlinedVector<const NodeArg*> GetDistinctInputs(const Node& node) {
+  InlinedVector<const NodeArg*> inputs;
+  auto add = [&inputs](const NodeArg* input) {
+    if (input->Exists() && std::find(inputs.begin(), inputs.end(), input) == inputs.end()) {
+      inputs.push_back(input);
+    }
+  };
+
+  for (const auto* input : node.InputDefs()) add(input);
+  for (const auto* input : node.ImplicitInputDefs()) add(input);
+  return inputs;
+}
+}  // namespace
 #endif
 
 GraphViewer::GraphViewer(const Graph& graph)
@@ -239,12 +306,150 @@ const std::vector<NodeIndex>& GraphViewer::GetNodesInTopologicalOrder(ExecutionO
 #if !defined(ORT_MINIMAL_BUILD)
     case ExecutionOrder::PRIORITY_BASED:
       return nodes_in_topological_order_with_priority_;
+    case ExecutionOrder::MEMORY_EFFICIENT:
+      std::call_once(memory_efficient_order_flag_, [this]() { ComputeMemoryEfficientTopologicalOrder(); });
+      return nodes_in_memory_efficient_topological_order_;
 #endif
     default:
       ORT_THROW("Invalid ExecutionOrder");
   }
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+// A Kahn's topological sort that runs the ready node that grows the size of the live tensors the least first,
+// i.e. the one with the smallest size of its outputs minus the size of the inputs it is the last consumer of.
+// With a lookahead of one node, a ready node also gets the growth of running it and then one of the nodes that only
+// wait for it, so the branch that leads to a node that frees large tensors, like the last input of a Concat, is
+// finished before other branches allocate more.
+void GraphViewer::ComputeMemoryEfficientTopologicalOrder() const {
+  const auto& nodes = nodes_in_topological_order_;
+  const size_t max_node_index = static_cast<size_t>(MaxNodeIndex());
+  std::vector<bool> in_view(max_node_index, false);
+  for (NodeIndex node_index : nodes) {
+    in_view[node_index] = true;
+  }
+
+  InlinedHashSet<const NodeArg*> graph_outputs(GetOutputs().cbegin(), GetOutputs().cend());
+  // values produced by the nodes, which are freed after their last consumer ran unless they are graph outputs
+  InlinedHashMap<const NodeArg*, size_t> remaining_consumers;
+  std::vector<size_t> in_degree(max_node_index, 0);
+  for (NodeIndex node_index : nodes) {
+    const Node* node = GetNode(node_index);
+    for (const auto* output : node->OutputDefs()) {
+      if (output->Exists() && graph_outputs.count(output) == 0) {
+        remaining_consumers.insert({output, 0});
+      }
+    }
+
+    for (auto it = node->InputNodesBegin(); it != node->InputNodesEnd(); ++it) {
+      if (in_view[it->Index()]) {
+        ++in_degree[node_index];
+      }
+    }
+  }
+
+  for (NodeIndex node_index : nodes) {
+    for (const auto* input : GetDistinctInputs(*GetNode(node_index))) {
+      auto it = remaining_consumers.find(input);
+      if (it != remaining_consumers.end()) {
+        ++it->second;
+      }
+    }
+  }
+
+  auto size_increase = [&](const Node& node) {
+    int64_t increase = 0;
+    for (const auto* output : node.OutputDefs()) {
+      if (output->Exists()) {
+        increase += static_cast<int64_t>(EstimateTensorSize(*output));
+      }
+    }
+
+    for (const auto* input : GetDistinctInputs(node)) {
+      auto it = remaining_consumers.find(input);
+      if (it != remaining_consumers.end() && it->second == 1) {
+        increase -= static_cast<int64_t>(EstimateTensorSize(*input));
+      }
+    }
+
+    return increase;
+  };
+
+  // updates the consumers of the inputs of the node as if it ran, or undoes that
+  auto consume_inputs = [&](const Node& node, bool undo) {
+    for (const auto* input : GetDistinctInputs(node)) {
+      auto it = remaining_consumers.find(input);
+      if (it != remaining_consumers.end()) {
+        if (undo) {
+          ++it->second;
+        } else {
+          --it->second;
+        }
+      }
+    }
+  };
+
+  // the smallest growth of running the node, alone or followed by one of the nodes it makes ready
+  InlinedHashMap<NodeIndex, size_t> edges_from_node;
+  auto lookahead_increase = [&](const Node& node) {
+    const int64_t increase = size_increase(node);
+
+    edges_from_node.clear();
+    for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+      if (in_view[it->Index()]) {
+        ++edges_from_node[it->Index()];
+      }
+    }
+
+    int64_t best_next_increase = 0;
+    consume_inputs(node, false);
+    for (const auto& [next_index, num_edges] : edges_from_node) {
+      if (in_degree[next_index] == num_edges) {
+        best_next_increase = std::min(best_next_increase, size_increase(*GetNode(next_index)));
+      }
+    }
+    consume_inputs(node, true);
+
+    return increase + best_next_increase;
+  };
+
+  // ties are broken in favor of the node that became ready first
+  std::vector<NodeIndex> ready;
+  for (NodeIndex node_index : nodes) {
+    if (in_degree[node_index] == 0) {
+      ready.push_back(node_index);
+    }
+  }
+
+  nodes_in_memory_efficient_topological_order_.reserve(nodes.size());
+  while (!ready.empty()) {
+    auto best = ready.begin();
+    int64_t best_increase = lookahead_increase(*GetNode(*best));
+    for (auto it = std::next(ready.begin()); it != ready.end(); ++it) {
+      const int64_t increase = lookahead_increase(*GetNode(*it));
+      if (increase < best_increase) {
+        best = it;
+        best_increase = increase;
+      }
+    }
+
+    const Node* node = GetNode(*best);
+    ready.erase(best);
+    nodes_in_memory_efficient_topological_order_.push_back(node->Index());
+    consume_inputs(*node, false);
+
+    for (auto it = node->OutputNodesBegin(); it != node->OutputNodesEnd(); ++it) {
+      if (in_view[it->Index()] && --in_degree[it->Index()] == 0) {
+        ready.push_back(it->Index());
+      }
+    }
+  }
+
+  ORT_ENFORCE(nodes_in_memory_efficient_topological_order_.size() == nodes.size(),
+              "Some nodes are not included in the memory efficient topological sort.");
+}
+#endif
+
 const std::vector<NodeIndex>& GraphViewer::GetRootNodes() const {
   // TODO: See if we need to calculate the root_nodes_ of the filtered graph.
   // GetRootNodes is only used by parallel executor currently, and isn't relevant to the usage of a filtered graph.
@@ -145,6 +145,73 @@ MlasPlatformU8S8Overflow(
 
 #endif
 
+//
+// Kernel dispatch introspection and override.
+//
+// The kernels of each family of routines are selected from the instruction
+// sets supported by the processor. The instruction set of a family can be
+// limited with a specification of comma separated `family=isa` entries, where
+// the family `*` applies to every family, for example `*=avx2,qgemm=avx512vnni`.
+// The specification is read from the MLAS_DISPATCH_OVERRIDE environment
+// variable when the library initializes.
+//
+
+enum MLAS_KERNEL_FAMILY {
+    MlasKernelFamilySgemm,
+    MlasKernelFamilyDgemm,
+    MlasKernelFamilyQgemm,
+    MlasKernelFamilyConv,
+    MlasKernelFamilyActivation,
+    MlasKernelFamilyReduce,
+    MlasKernelFamilyQuantize,
+    MlasKernelFamilyHalfGemm,
+    MlasKernelFamilyBf16Gemm,
+    MlasKernelFamilyQ4Gemm,
+    MlasKernelFamilyCast,
+    MlasKernelFamilyTree,
+    MlasKernelFamilyCount,
+};
+
+/**
+ * @brief Return the name of a kernel family as used by the dispatch
+ *        override specification, for example "sgemm".
+ */
+const char*
+MLASCALL
+MlasGetKernelFamilyName(
+    MLAS_KERNEL_FAMILY Family
+    );
+
+/**
+ * @brief Return the name of the instruction set of the kernels selected for
+ *        a kernel family, for example "avx512f", or "none" if the routines
+ *        of the family are not supported on this platform.
+ */
+const char*
+MLASCALL
+MlasGetKernelFamilyIsa(
+    MLAS_KERNEL_FAMILY Family
+    );
+
+/**
+ * @brief Reselect the kernels of every family with a dispatch override
+ *        specification, replacing the one read from the environment.
+ *
+ *        The call must not overlap any other MLAS call, as it replaces the
+ *        kernels used by those calls. It is intended for tests and tools
+ *        that compare the kernels of different instruction sets.
+ *
+ * @param Specification  The override specification, or nullptr or an empty
+ *                       string to select the kernels from the processor
+ *                       features alone.
+ * @return  false if the specification is malformed, in which case the
+ *          kernels are left unchanged.
+ */
+bool
+MLASCALL
+MlasSetKernelDispatchOverride(
+    const char* Specification
+    );
 
 //
 // Activation routines.
@@ -196,6 +263,18 @@ MlasActivation(
 // op(X) = X or op(X) = transpose(X) or op(X) = conjg(transpose(X))
 //
 
+/**
+ * @brief Supply the operations applied to the output of single precision gemm
+ *        functions while the output is in cache:
+ *        C = Activation(alpha * op(A) * op(B) + beta * C + Bias) + Addend
+ */
+struct MLAS_SGEMM_EPILOGUE {
+    const float* Bias = nullptr;                 /**< Supplies the optional bias vector of N elements */
+    const MLAS_ACTIVATION* Activation = nullptr; /**< Supplies the optional activation */
+    const float* Addend = nullptr;               /**< Supplies the optional matrix added after the activation, must not overlap C */
+    size_t ldaddend = 0;                         /**< Supplies the first dimension of the addend matrix. */
+};
+
 /**
  * @brief Supply matrices data information to single precision gemm functions
  */
@@ -209,6 +288,7 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr; /**< Supplies the optional operations applied to C */
 };
 
 /**
@@ -751,6 +831,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -783,6 +864,10 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            const void* PackedFilter;
+            size_t TileBlockSize;
+        } Winograd;
     } u;
 };
 
@@ -802,7 +887,8 @@ MlasConvPrepare(MLAS_CONV_PARAMETERS* Parameters,
                 const MLAS_ACTIVATION* Activation,
                 size_t* WorkingBufferSize,
                 float Beta,
-                MLAS_THREADPOOL* ThreadPool);
+                MLAS_THREADPOOL* ThreadPool,
+                const void* WinogradPackedFilter = nullptr);
 
 void
 MLASCALL
@@ -816,6 +902,32 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(4x4, 3x3) convolution routines. A 3x3 convolution with unit
+// stride and dilation and enough channels uses the Winograd algorithm if
+// MlasConvPrepare is given its filter packed by MlasConvWinogradPackW. The
+// transforms round differently from the other algorithms, so the results are
+// not bitwise identical to theirs.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradPackWSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackW(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -1022,7 +1134,107 @@ MlasComputeTanh(
     );
 
 //
-// Half-precision floating-point routines.
+// Reduction routines.
+//
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceSumSquare,
+    MlasReduceMaximum,
+};
+
+/**
+ * @brief Reduce each row of a matrix to one value:
+ *        Output[r] = Reduce(Input[r * ldInput + c] for c in [0, RowLength))
+ *        A row of no elements reduces to 0 for the sums and to -infinity
+ *        for the maximum.
+ *
+ * @param Kind       Supplies the reduction.
+ * @param Input      Supplies the input matrix.
+ * @param ldInput    Supplies the first dimension of the input matrix.
+ * @param Output     Supplies the output vector of Rows elements.
+ * @param Rows       Supplies the number of rows of the input matrix.
+ * @param RowLength  Supplies the number of elements reduced per row.
+ */
+void
+MLASCALL
+MlasReduceRows(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    );
+
+/**
+ * @brief Reduce the rows of a matrix to one row:
+ *        Output[c] = Reduce(Input[r * ldInput + c] for r in [0, Rows))
+ *
+ * @param Kind       Supplies the reduction.
+ * @param Input      Supplies the input matrix.
+ * @param ldInput    Supplies the first dimension of the input matrix.
+ * @param Output     Supplies the output vector of Columns elements.
+ * @param Rows       Supplies the number of rows reduced.
+ * @param Columns    Supplies the number of columns of the input matrix.
+ */
+void
+MLASCALL
+MlasReduceColumns(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    );
+
+/**
+ * @brief Parameters of a layer normalization over the rows of a matrix.
+ *        Each row is X = Input + Skip + Bias, and
+ *        Output = (X - Mean(X)) / sqrt(Var(X) + Epsilon) * Gamma + Beta.
+ *        The simplified (RMS) normalization computes
+ *        Output = X / sqrt(Mean(X * X) + Epsilon) * Gamma instead.
+ */
+struct MLAS_LAYER_NORM_PARAMS {
+    const float* Input = nullptr;      /**< Supplies the input matrix of Rows x Columns. */
+    const float* Skip = nullptr;       /**< Optional skip matrix added to the input. */
+    size_t SkipRowCount = 0;           /**< Number of rows of Skip, repeated over the input rows. */
+    const float* Bias = nullptr;       /**< Optional bias vector of Columns added to the input. */
+    const float* Gamma = nullptr;      /**< Supplies the scale vector of Columns. */
+    const float* Beta = nullptr;       /**< Optional shift vector of Columns, ignored if Simplified. */
+    float* Output = nullptr;           /**< Supplies the output matrix, which may alias Input. */
+    float* SkipOutput = nullptr;       /**< Optional output of X, which may alias Input. */
+    float* Mean = nullptr;             /**< Optional output of the mean of each row. */
+    float* InvStdDev = nullptr;        /**< Optional output of the inverse standard deviation of each row. */
+    float Epsilon = 0.0f;
+    bool Simplified = false;
+};
+
+/**
+ * @brief Normalize each row of a matrix. The mean and variance of a row are
+ *        computed in one pass with a vectorized Welford update, which also
+ *        writes X to the output, and a second pass over the cached row
+ *        normalizes it.
+ *
+ * @param Params      Supplies the layer normalization parameters.
+ * @param Rows        Supplies the number of rows of the input matrix.
+ * @param Columns     Supplies the number of columns of the input matrix.
+ * @param ThreadPool  Supplies the thread pool object to use, else nullptr if
+ *                    the base library threading support should be used.
+ */
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t Rows,
+    size_t Columns,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Half-precision and bfloat16 floating-point conversion routines. The
+// conversions to the narrower formats round to nearest even.
 //
 
 extern "C"
@@ -1034,6 +1246,30 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 //
 // Transpose routines.
 //
@@ -1083,6 +1319,26 @@ MlasTranspose(
     size_t N
     );
 
+//
+// N-dimensional transpose routine. Output axis i is input axis Permutation[i].
+// Elements are moved as raw bytes, so any type of 1, 2, 4 or 8 bytes is
+// supported.
+//
+
+constexpr size_t MLAS_TRANSPOSE_MAXIMUM_RANK = 16;
+
+void
+MLASCALL
+MlasTransposeND(
+    const void* Input,
+    void* Output,
+    size_t ElementSize,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Buffer reordering routines.
 //
@@ -1405,6 +1661,9 @@ constexpr size_t FP16_SIZE = sizeof(uint16_t);
 
 /**
  * @brief Whether current CPU supports FP16 acceleration.
+ *
+ * On x64 this only covers the half precision GEMM, which has F16C and
+ * AVX512-FP16 kernels. The other fp16 routines require ARM64.
 */
 bool MLASCALL
 MlasFp16AccelerationSupported();
@@ -1611,6 +1870,245 @@ MlasHalfGemmConvertPackB(
     void* PackedB
     );
 
+/**
+ * @brief Data parameters for bfloat16 GEMM routine
+ *        All except C are [in] parameters
+*/
+struct MLAS_BF16_GEMM_DATA_PARAMS {
+    const float* A = nullptr;         /**< address of fp32 A, converted to bfloat16 on the fly */
+    const void* B = nullptr;          /**< address of B packed by MlasBf16GemmConvertPackB */
+    const float* Bias = nullptr;      /**< address of Bias, vector size N */
+    float* C = nullptr;               /**< address of result matrix */
+    size_t lda = 0;                   /**< leading dimension of A */
+    size_t ldc = 0;                   /**< leading dimension of C*/
+    bool ZeroMode = true;             /**< true: C = A * B + Bias, false: C += A * B + Bias */
+};
+
+/**
+ * @brief Returns true if the processor supports bfloat16 GEMM,
+ *        i.e. AVX512-BF16 or AMX-BF16
+*/
+bool
+MLASCALL
+MlasBf16GemmSupported(
+    void
+    );
+
+/**
+ * @brief Bfloat16 Batched GEMM:  C = A * B + Bias
+ *        A is fp32 and rounded to bfloat16, B is pre-packed bfloat16,
+ *        the products are accumulated in fp32.
+ *
+ * Note:  We only support uniform batching, so shapes and types of the
+ *        input must be same across all parameter blocks.
+ *
+ * @param[in]  M       row size of matrix A and C
+ * @param[in]  N       column size of matrix B and C
+ * @param[in]  K       column size of matrix A and row size of matrix B
+ * @param[in]  BatchN  number of batches
+ * @param[inout]  DataParams  An array (size BatchN) of parameter blocks
+ * @param[in]  ThreadPool
+ * @return
+*/
+void
+MLASCALL
+MlasBf16GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_BF16_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool = nullptr
+    );
+
+/**
+ * @brief For bfloat16 GEMM, returns size of the
+ *        packing buffer needed for right hand side
+ * @param[in] N   Number of columns
+ * @param[in] K   Number of rows
+ * @return  size of the packing buffer,
+ *          0 if operation not supported
+*/
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief For bfloat16 GEMM, convert the float matrix B
+ *        to bfloat16 and pack it into a packing buffer
+ *
+ * @param[in]  TransB   Whether B is transposed
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+ * @param[out] PackedB  Address of the packed matrix
+*/
+void
+MLASCALL
+MlasBf16GemmConvertPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Data parameters for the 2:4 structured sparse GEMM routine
+ *        All except C are [in] parameters
+*/
+struct MLAS_SPARSE24_GEMM_DATA_PARAMS {
+    const float* A = nullptr;         /**< address of A */
+    const void* B = nullptr;          /**< address of B packed by MlasSparse24GemmPackB */
+    const float* Bias = nullptr;      /**< address of Bias, vector size N */
+    float* C = nullptr;               /**< address of result matrix */
+    size_t lda = 0;                   /**< leading dimension of A */
+    size_t ldc = 0;                   /**< leading dimension of C*/
+    bool ZeroMode = true;             /**< true: C = A * B + Bias, false: C += A * B + Bias */
+};
+
+/**
+ * @brief Returns true if B has 2:4 structured sparsity, i.e. each column of
+ *        B has at most two nonzero values in every group of 4 consecutive
+ *        rows, so that MlasSparse24GemmPackB can compress it
+ *
+ * @param[in]  TransB   Whether B is transposed
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+*/
+bool
+MLASCALL
+MlasSparse24GemmIsSparse(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+/**
+ * @brief 2:4 structured sparse Batched GEMM:  C = A * B + Bias
+ *        B is compressed to its nonzero values by MlasSparse24GemmPackB, so
+ *        half of the products of a dense GEMM are skipped and half of B is
+ *        read.
+ *
+ * Note:  We only support uniform batching, so shapes and types of the
+ *        input must be same across all parameter blocks.
+ *
+ * @param[in]  M       row size of matrix A and C
+ * @param[in]  N       column size of matrix B and C
+ * @param[in]  K       column size of matrix A and row size of matrix B
+ * @param[in]  BatchN  number of batches
+ * @param[inout]  DataParams  An array (size BatchN) of parameter blocks
+ * @param[in]  ThreadPool
+ * @return
+*/
+void
+MLASCALL
+MlasSparse24GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_SPARSE24_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool = nullptr
+    );
+
+/**
+ * @brief For 2:4 structured sparse GEMM, returns size of the
+ *        packing buffer needed for right hand side
+ * @param[in] N   Number of columns
+ * @param[in] K   Number of rows
+ * @return  size of the packing buffer
+*/
+size_t
+MLASCALL
+MlasSparse24GemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+/**
+ * @brief For 2:4 structured sparse GEMM, compress the float matrix B,
+ *        which MlasSparse24GemmIsSparse accepts, into a packing buffer
+ *
+ * @param[in]  TransB   Whether B is transposed
+ * @param[in]  N        Number of columns
+ * @param[in]  K        Number of rows
+ * @param[in]  B        Address of matrix B
+ * @param[in]  ldb      leading dimension of input matrix B
+ * @param[out] PackedB  Address of the packed matrix
+*/
+void
+MLASCALL
+MlasSparse24GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+/**
+ * @brief Comparison of a feature with the threshold of a decision tree node,
+ *        which leads to the true branch of the node when it holds
+*/
+enum MLAS_TREE_NODE_MODE {
+    MlasTreeNodeLeq,
+    MlasTreeNodeLt,
+    MlasTreeNodeGte,
+    MlasTreeNodeGt,
+    MlasTreeNodeEq,
+    MlasTreeNodeNeq,
+};
+
+/**
+ * @brief Walks rows of features through a decision tree compiled into flat
+ *        arrays, several rows in lockstep, and returns the leaf each row
+ *        reaches
+ *
+ *        Node i compares feature FeatureIds[i] of a row with Thresholds[i] and
+ *        goes on with node Children[2 * i + 1] when the comparison holds, with
+ *        node Children[2 * i] otherwise. A negative FeatureIds[i] stands for
+ *        feature ~FeatureIds[i] with a missing (NaN) feature also taking the
+ *        true branch. A leaf is a node whose two children are itself, so every
+ *        row takes Depth steps.
+ *
+ * @param[in]  Mode        comparison of all the nodes
+ * @param[in]  FeatureIds  feature of each node
+ * @param[in]  Thresholds  threshold of each node
+ * @param[in]  Children    two children of each node
+ * @param[in]  Root        index of the first node
+ * @param[in]  Depth       number of steps from the root to the deepest leaf
+ * @param[in]  Input       address of the first row, features are less than
+ *                         Stride when Rows > 1
+ * @param[in]  Stride      distance between two rows
+ * @param[in]  Rows        number of rows
+ * @param[out] Leaves      index of the leaf reached by each row
+*/
+void
+MLASCALL
+MlasTreeTraverse(
+    MLAS_TREE_NODE_MODE Mode,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    );
+
 /**
  * @brief Indirect Depthwise convolution for fp16
  * @param Input         Supplies the indirect buffer for NHWC input
@@ -73,6 +73,38 @@ MlasQ4GemmPackB(
     );
 
 
+/**
+ * @brief Pack a weight tensor that is already int4 block quantized, e.g.
+ *        the weight of MatMulNBits, into the layout of MlasQ4GemmPackB,
+ *        without quantizing it again. The block length of QType must
+ *        divide BlockSize. Only BlkQ4Zp8 takes zero points, the other
+ *        types require a zero point of 8.
+ *
+ * @param QType       type of block quantization
+ * @param PackedBuf   destination buffer, MlasQ4GemmPackBSize bytes
+ * @param QuantData   the quantized values, shape [N, ceil(K / BlockSize), BlockSize / 2],
+ *                    with value 2i in the low nibble and value 2i + 1 in the
+ *                    high nibble of byte i of a block
+ * @param Scales      the scales, shape [N, ceil(K / BlockSize)]
+ * @param ZeroPoints  the zero points, two 4-bit values per byte in the order of
+ *                    Scales, nullptr if all the zero points are 8
+ * @param N           the number of columns of matrix B.
+ * @param K           the number of rows of matrix B.
+ * @param BlockSize   the number of values of a column of B sharing a scale
+*/
+void
+MLASCALL
+MlasQ4GemmPackBQuantized(
+    MLAS_BLK_QUANT_TYPE QType,
+    void* PackedBuf,
+    const uint8_t* QuantData,
+    const float* Scales,
+    const uint8_t* ZeroPoints,
+    size_t N,
+    size_t K,
+    size_t BlockSize
+    );
+
 /**
  * @brief Unpack and dequantize from int4 to fp32, reverse operation of
  *        MlasQ4GemmPackB
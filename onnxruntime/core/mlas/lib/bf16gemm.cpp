@@ -0,0 +1,242 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.cpp
+
+Abstract:
+
+    This module implements the fp32 matrix multiplication computed in
+    bfloat16 with fp32 accumulation. The right hand side is converted to
+    bfloat16 and pre-packed, the left hand side is converted while the
+    operation runs.
+--*/
+
+#include "bf16gemm.h"
+
+#include <cstring>
+
+//
+// Number of columns of B one kernel call covers, so that the packed blocks
+// of the columns stay in cache while all the rows of the operation reuse
+// them.
+//
+
+constexpr size_t MLAS_BF16_GEMM_STRIDEN = 64;
+
+constexpr size_t MLAS_BF16_GEMM_STRIDEM = 128;
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBf16(
+    float Value
+    )
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    if ((Bits & 0x7fffffff) > 0x7f800000) {
+        // quiet NaN
+        return uint16_t((Bits >> 16) | 0x40);
+    }
+
+    // round to nearest even
+    Bits += 0x7fff + ((Bits >> 16) & 1);
+    return uint16_t(Bits >> 16);
+}
+
+bool
+MLASCALL
+MlasBf16GemmSupported(
+    void
+    )
+{
+    return GetMlasPlatform().Bf16GemmDispatch != nullptr;
+}
+
+size_t
+MLASCALL
+MlasBf16GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+    if (GetMlasPlatform().Bf16GemmDispatch == nullptr) {
+        return 0;
+    }
+
+    const size_t AlignedN = MlasDivRoundup(N, MLAS_BF16_GEMM_PACKED_N) * MLAS_BF16_GEMM_PACKED_N;
+    const size_t BytesRequired = AlignedN * MlasBf16GemmPackedK(K) * sizeof(uint16_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+void
+MLASCALL
+MlasBf16GemmConvertPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    const size_t PackedK = MlasBf16GemmPackedK(K);
+    uint16_t* D = reinterpret_cast<uint16_t*>(PackedB);
+
+    for (size_t n0 = 0; n0 < N; n0 += MLAS_BF16_GEMM_PACKED_N) {
+        const size_t CountN = std::min(N - n0, MLAS_BF16_GEMM_PACKED_N);
+
+        for (size_t k = 0; k < PackedK; k++) {
+            uint16_t* d = D + (k / 2) * (MLAS_BF16_GEMM_PACKED_N * 2) + (k % 2);
+
+            for (size_t n = 0; n < MLAS_BF16_GEMM_PACKED_N; n++) {
+                float Value = 0.0f;
+                if (k < K && n < CountN) {
+                    Value = (TransB == CblasNoTrans) ? B[k * ldb + n0 + n] : B[(n0 + n) * ldb + k];
+                }
+                d[n * 2] = MlasFloatToBf16(Value);
+            }
+        }
+
+        D += PackedK * MLAS_BF16_GEMM_PACKED_N;
+    }
+}
+
+static
+void
+MlasBf16GemmOperation(
+    const MLAS_BF16_GEMM_DISPATCH* Dispatch,
+    const size_t K,
+    const MLAS_BF16_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    const size_t PackedK = MlasBf16GemmPackedK(K);
+    const size_t PackedM = MlasDivRoundup(RangeCountM, MLAS_BF16_GEMM_PACKED_M) * MLAS_BF16_GEMM_PACKED_M;
+
+    //
+    // Convert the rows of A to bfloat16, padding the columns and rows with
+    // zeros.
+    //
+
+    MlasThreadedBufAlloc(PackedM * PackedK * sizeof(uint16_t));
+    uint16_t* PackedA = reinterpret_cast<uint16_t*>(ThreadedBufHolder.get());
+
+    for (size_t m = 0; m < PackedM; m++) {
+        uint16_t* a = PackedA + m * PackedK;
+        size_t CountK = 0;
+        if (m < RangeCountM) {
+            Dispatch->ConvertKernel(Data->A + (RangeStartM + m) * Data->lda, a, K);
+            CountK = K;
+        }
+        std::fill_n(a + CountK, PackedK - CountK, uint16_t(0));
+    }
+
+    const uint16_t* PackedB = reinterpret_cast<const uint16_t*>(Data->B);
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_BF16_GEMM_STRIDEN) {
+        const size_t StartN = RangeStartN + n;
+        const size_t CountN = std::min(RangeCountN - n, MLAS_BF16_GEMM_STRIDEN);
+
+        //
+        // The thread ranges of N are aligned to the packed blocks.
+        //
+
+        Dispatch->Kernel(PackedA, PackedK, PackedB + (StartN / MLAS_BF16_GEMM_PACKED_N) * PackedK * MLAS_BF16_GEMM_PACKED_N,
+                         Data->C + RangeStartM * Data->ldc + StartN, Data->ldc,
+                         Data->Bias == nullptr ? nullptr : Data->Bias + StartN,
+                         RangeCountM, CountN, PackedK, Data->ZeroMode);
+    }
+}
+
+void
+MLASCALL
+MlasBf16GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_BF16_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const MLAS_BF16_GEMM_DISPATCH* Dispatch = GetMlasPlatform().Bf16GemmDispatch;
+    if (Dispatch == nullptr) {
+        MLAS_THROW_EX(std::runtime_error, "bfloat16 GEMM is not supported on this processor");
+    }
+
+    if (ThreadPool == nullptr) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            for (size_t m = 0; m < M; m += MLAS_BF16_GEMM_STRIDEM) {
+                MlasBf16GemmOperation(Dispatch, K, &DataParams[gemm_i], m,
+                                      std::min(M - m, MLAS_BF16_GEMM_STRIDEM), 0, N);
+            }
+        }
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN);
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool) * 8;
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchN;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    constexpr size_t StrideM = MLAS_BF16_GEMM_STRIDEM;
+
+    size_t nc = N;
+    if (ThreadsPerGemm > 1) {
+        // more than one thread per GEMM
+
+        const size_t BlockedM = MlasDivRoundup(M, StrideM);
+        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
+        if (max_nc < nc) {
+            nc = std::min(nc, MlasDivRoundup(max_nc, MLAS_BF16_GEMM_PACKED_N) *
+                                  MLAS_BF16_GEMM_PACKED_N);
+        }
+    }
+    const size_t StrideN = nc;
+
+    const size_t ThreadCountM = MlasDivRoundup(M, StrideM);
+    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
+    ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+        auto Data = &DataParams[gemm_i];
+
+        const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
+        const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
+
+        const size_t RangeStartM = ThreadIdM * StrideM;
+        const size_t RangeCountM = std::min(M - RangeStartM, (size_t)StrideM);
+
+        const size_t RangeStartN = ThreadIdN * StrideN;
+        const size_t RangeCountN = std::min(N - RangeStartN, (size_t)StrideN);
+
+        MlasBf16GemmOperation(Dispatch, K, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+    });
+}
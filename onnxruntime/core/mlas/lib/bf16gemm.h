@@ -0,0 +1,137 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm.h
+
+Abstract:
+
+    This module defines the kernel interface of the bfloat16 matrix/matrix
+    multiply operation with fp32 accumulation.
+
+    Packed B layout: the columns of B are split into blocks of 16 columns,
+    the last block padded with zeros. The rows of a block, padded with zeros
+    to a multiple of MLAS_BF16_GEMM_PACKED_K, are stored in pairs: each 64
+    byte row of the packed block holds (B[k][n], B[k+1][n]) for the 16
+    columns n of the block. This is the pair layout used by both VDPBF16PS
+    and the B tile of TDPBF16PS.
+
+    The kernels take the rows of A converted to bfloat16, padded with zeros
+    to MLAS_BF16_GEMM_PACKED_K columns and to a multiple of
+    MLAS_BF16_GEMM_PACKED_M rows.
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+constexpr size_t MLAS_BF16_GEMM_PACKED_N = 16;
+constexpr size_t MLAS_BF16_GEMM_PACKED_K = 32;
+constexpr size_t MLAS_BF16_GEMM_PACKED_M = 16;
+
+/**
+ * @brief Returns the number of rows of B after padding
+ */
+MLAS_FORCEINLINE
+size_t
+MlasBf16GemmPackedK(
+    size_t K
+    )
+{
+    return (K + MLAS_BF16_GEMM_PACKED_K - 1) & ~(MLAS_BF16_GEMM_PACKED_K - 1);
+}
+
+/**
+ * @brief Convert fp32 values to bfloat16, rounding to nearest even
+ *
+ * @param[in]  Source       Address of the fp32 values
+ * @param[out] Destination  Address of the bfloat16 values
+ * @param[in]  Count        Number of values
+ */
+typedef
+void
+(MLASCALL MLAS_BF16_CONVERT_KERNEL)(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    );
+
+/**
+ * @brief Compute C = A * B + Bias (or C += A * B + Bias) for a range of C
+ *
+ * @param[in]  A          Address of the bfloat16 rows of A
+ * @param[in]  lda        Leading dimension of A, the padded K
+ * @param[in]  PackedB    Address of the first packed block of the columns
+ * @param[out] C          Address of the first element of C
+ * @param[in]  ldc        Leading dimension of C
+ * @param[in]  Bias       Optional address of the bias of the columns
+ * @param[in]  CountM     Number of rows of C
+ * @param[in]  CountN     Number of columns of C
+ * @param[in]  PackedK    Padded K, the number of rows of a packed block
+ * @param[in]  ZeroMode   true to overwrite C, false to accumulate into C
+ */
+typedef
+void
+(MLASCALL MLAS_BF16_GEMM_KERNEL)(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    size_t PackedK,
+    bool ZeroMode
+    );
+
+struct MLAS_BF16_GEMM_DISPATCH {
+    MLAS_BF16_CONVERT_KERNEL* ConvertKernel;
+    MLAS_BF16_GEMM_KERNEL* Kernel;
+};
+
+extern "C" {
+
+    void
+    MLASCALL
+    MlasConvertFloatToBf16Avx512Bf16(
+        const float* Source,
+        uint16_t* Destination,
+        size_t Count
+        );
+
+    void
+    MLASCALL
+    MlasBf16GemmKernelAvx512Bf16(
+        const uint16_t* A,
+        size_t lda,
+        const uint16_t* PackedB,
+        float* C,
+        size_t ldc,
+        const float* Bias,
+        size_t CountM,
+        size_t CountN,
+        size_t PackedK,
+        bool ZeroMode
+        );
+
+    void
+    MLASCALL
+    MlasBf16GemmKernelAmx(
+        const uint16_t* A,
+        size_t lda,
+        const uint16_t* PackedB,
+        float* C,
+        size_t ldc,
+        const float* Bias,
+        size_t CountM,
+        size_t CountN,
+        size_t PackedK,
+        bool ZeroMode
+        );
+
+}
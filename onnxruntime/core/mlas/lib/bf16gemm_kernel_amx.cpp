@@ -0,0 +1,168 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_amx.cpp
+
+Abstract:
+
+    This module implements the bfloat16 GEMM kernel using AMX-BF16 tiles.
+
+--*/
+
+#include "bf16gemm.h"
+#include "amx_common.h"
+
+#include <cstring>
+
+#define TMM0 0
+#define TMM1 1
+#define TMM4 4
+#define TMM6 6
+#define TMM7 7
+
+#define TILE_M 16
+#define TILE_N 16
+#define TILE_K 32
+
+static_assert(TILE_M == MLAS_BF16_GEMM_PACKED_M, "A is padded to whole tiles");
+static_assert(TILE_N == MLAS_BF16_GEMM_PACKED_N, "a packed block of B is one tile wide");
+static_assert(TILE_K == MLAS_BF16_GEMM_PACKED_K, "B is padded to whole tiles");
+
+static
+void
+MlasBf16GemmAmxInitTileConfig()
+{
+    static thread_local struct tileconfig_t tc = {0};
+    struct tileconfig_t current_tc = {0};
+    tile_storeconfig(&current_tc);
+
+    if (tc.palette_id == 0 || std::memcmp(&current_tc, &tc, sizeof(tc)) != 0) {
+        // All tiles are 16 rows of 64 bytes: 16x32 bfloat16 for A, 16 pairs
+        // of rows of 16 columns for B, 16x16 fp32 for C.
+        tc.palette_id = 1;
+        for (int t = 0; t < 8; t++) {
+            tc.rows[t] = 16;
+            tc.colb[t] = 64;
+        }
+
+        tile_loadconfig(&tc);
+    }
+}
+
+/**
+ * @brief Write a 16x16 fp32 result tile to C, adding the bias and the
+ *        previous contents of C if required.
+ */
+static
+MLAS_FORCEINLINE
+void
+MlasBf16GemmAmxStoreTile(
+    const float* Tile,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    bool ZeroMode
+    )
+{
+    const __mmask16 Mask = __mmask16((1u << CountN) - 1);
+    const __m512 BiasElements = (Bias != nullptr) ? _mm512_maskz_loadu_ps(Mask, Bias) : _mm512_setzero_ps();
+
+    for (size_t r = 0; r < CountM; r++) {
+        float* c = C + r * ldc;
+        __m512 Result = _mm512_add_ps(_mm512_load_ps(Tile + r * TILE_N), BiasElements);
+        if (!ZeroMode) {
+            Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, c));
+        }
+        _mm512_mask_storeu_ps(c, Mask, Result);
+    }
+}
+
+void
+MLASCALL
+MlasBf16GemmKernelAmx(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    size_t PackedK,
+    bool ZeroMode
+    )
+{
+    MlasBf16GemmAmxInitTileConfig();
+
+    alignas(64) float Tile0[TILE_M * TILE_N];
+    alignas(64) float Tile1[TILE_M * TILE_N];
+
+    const size_t PackedBBlockSize = PackedK * TILE_N;
+    const size_t StrideA = lda * sizeof(uint16_t);
+    constexpr size_t StrideB = TILE_N * 2 * sizeof(uint16_t);
+
+    for (size_t m = 0; m < CountM; m += TILE_M) {
+        const uint16_t* a = A + m * lda;
+        const size_t RowCount = std::min(CountM - m, size_t(TILE_M));
+
+        //
+        // Compute two tiles of C at a time so that a tile of A is loaded
+        // once for two tiles of B.
+        //
+
+        size_t n = 0;
+        for (; n + TILE_N < CountN; n += 2 * TILE_N) {
+            const uint16_t* b0 = PackedB + (n / TILE_N) * PackedBBlockSize;
+            const uint16_t* b1 = b0 + PackedBBlockSize;
+
+            tile_zero(TMM0);
+            tile_zero(TMM1);
+
+            for (size_t k = 0; k < PackedK; k += TILE_K) {
+                tile_loadd(TMM4, a + k, StrideA);
+                tile_loadd(TMM6, b0 + k * TILE_N, StrideB);
+                tile_loadd(TMM7, b1 + k * TILE_N, StrideB);
+                tile_dpbf16ps(TMM0, TMM4, TMM6);
+                tile_dpbf16ps(TMM1, TMM4, TMM7);
+            }
+
+            tile_stored(TMM0, Tile0, TILE_N * sizeof(float));
+            tile_stored(TMM1, Tile1, TILE_N * sizeof(float));
+
+            MlasBf16GemmAmxStoreTile(Tile0, C + m * ldc + n, ldc, Bias == nullptr ? nullptr : Bias + n,
+                                     RowCount, TILE_N, ZeroMode);
+            MlasBf16GemmAmxStoreTile(Tile1, C + m * ldc + n + TILE_N, ldc,
+                                     Bias == nullptr ? nullptr : Bias + n + TILE_N,
+                                     RowCount, std::min(CountN - n - TILE_N, size_t(TILE_N)), ZeroMode);
+        }
+
+        if (n < CountN) {
+            const uint16_t* b0 = PackedB + (n / TILE_N) * PackedBBlockSize;
+
+            tile_zero(TMM0);
+
+            for (size_t k = 0; k < PackedK; k += TILE_K) {
+                tile_loadd(TMM4, a + k, StrideA);
+                tile_loadd(TMM6, b0 + k * TILE_N, StrideB);
+                tile_dpbf16ps(TMM0, TMM4, TMM6);
+            }
+
+            tile_stored(TMM0, Tile0, TILE_N * sizeof(float));
+
+            MlasBf16GemmAmxStoreTile(Tile0, C + m * ldc + n, ldc, Bias == nullptr ? nullptr : Bias + n,
+                                     RowCount, CountN - n, ZeroMode);
+        }
+    }
+}
+
+const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAmx = {
+    MlasConvertFloatToBf16Avx512Bf16,
+    MlasBf16GemmKernelAmx,
+};
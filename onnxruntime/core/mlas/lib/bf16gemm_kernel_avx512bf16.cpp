@@ -0,0 +1,142 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    bf16gemm_kernel_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 GEMM kernel using VDPBF16PS, and
+    the fp32 to bfloat16 conversion used by all the bfloat16 GEMM kernels.
+
+--*/
+
+#include "bf16gemm.h"
+
+#include <cstring>
+#include <immintrin.h>
+
+constexpr size_t KernelMaxM = 4;
+
+void
+MLASCALL
+MlasConvertFloatToBf16Avx512Bf16(
+    const float* Source,
+    uint16_t* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        __m256bh Values = _mm512_cvtneps_pbh(_mm512_loadu_ps(Source));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Destination), (__m256i)Values);
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count > 0) {
+        const __mmask16 Mask = __mmask16((1u << Count) - 1);
+        __m256bh Values = _mm512_cvtneps_pbh(_mm512_maskz_loadu_ps(Mask, Source));
+        _mm256_mask_storeu_epi16(Destination, Mask, (__m256i)Values);
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmKernelAvx512Bf16Rows(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountN,
+    size_t PackedK,
+    bool ZeroMode
+    )
+{
+    for (size_t n = 0; n < CountN; n += MLAS_BF16_GEMM_PACKED_N) {
+        __m512 Accumulators[RowCount];
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = _mm512_setzero_ps();
+        }
+
+        const uint16_t* b = PackedB + (n / MLAS_BF16_GEMM_PACKED_N) * PackedK * MLAS_BF16_GEMM_PACKED_N;
+
+        for (size_t k = 0; k < PackedK; k += 2) {
+            const __m512bh BElements = (__m512bh)_mm512_loadu_si512(b + k * MLAS_BF16_GEMM_PACKED_N);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                int32_t APair;
+                std::memcpy(&APair, A + r * lda + k, sizeof(APair));
+                Accumulators[r] = _mm512_dpbf16_ps(Accumulators[r], (__m512bh)_mm512_set1_epi32(APair), BElements);
+            }
+        }
+
+        const size_t Columns = std::min(CountN - n, MLAS_BF16_GEMM_PACKED_N);
+        const __mmask16 Mask = __mmask16((1u << Columns) - 1);
+        const __m512 BiasElements = (Bias != nullptr) ? _mm512_maskz_loadu_ps(Mask, Bias + n) : _mm512_setzero_ps();
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            __m512 Result = _mm512_add_ps(Accumulators[r], BiasElements);
+            if (!ZeroMode) {
+                Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, c));
+            }
+            _mm512_mask_storeu_ps(c, Mask, Result);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasBf16GemmKernelAvx512Bf16(
+    const uint16_t* A,
+    size_t lda,
+    const uint16_t* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    size_t PackedK,
+    bool ZeroMode
+    )
+{
+    while (CountM > 0) {
+        size_t RowsHandled;
+
+        switch (std::min(CountM, KernelMaxM)) {
+            case 1:
+                MlasBf16GemmKernelAvx512Bf16Rows<1>(A, lda, PackedB, C, ldc, Bias, CountN, PackedK, ZeroMode);
+                RowsHandled = 1;
+                break;
+            case 2:
+                MlasBf16GemmKernelAvx512Bf16Rows<2>(A, lda, PackedB, C, ldc, Bias, CountN, PackedK, ZeroMode);
+                RowsHandled = 2;
+                break;
+            case 3:
+                MlasBf16GemmKernelAvx512Bf16Rows<3>(A, lda, PackedB, C, ldc, Bias, CountN, PackedK, ZeroMode);
+                RowsHandled = 3;
+                break;
+            default:
+                MlasBf16GemmKernelAvx512Bf16Rows<4>(A, lda, PackedB, C, ldc, Bias, CountN, PackedK, ZeroMode);
+                RowsHandled = 4;
+                break;
+        }
+
+        A += RowsHandled * lda;
+        C += RowsHandled * ldc;
+        CountM -= RowsHandled;
+    }
+}
+
+const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16 = {
+    MlasConvertFloatToBf16Avx512Bf16,
+    MlasBf16GemmKernelAvx512Bf16,
+};
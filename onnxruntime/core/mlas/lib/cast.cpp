@@ -0,0 +1,226 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements the routines to convert buffers between single
+    precision and the half precision and bfloat16 formats.
+
+    The conversions round to nearest even and keep denormals, infinities and
+    NaNs, matching the scalar conversions of the ONNX Runtime types.
+
+--*/
+
+#include "mlasi.h"
+
+#include <cstring>
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFloatToBFloat16(
+    float Value
+    )
+{
+    uint32_t Bits;
+    std::memcpy(&Bits, &Value, sizeof(Bits));
+
+    //
+    // NaNs keep their sign and become quiet NaNs, the other values round to
+    // nearest even.
+    //
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return uint16_t(((Bits >> 16) & 0x8000) | 0x7FC0);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+
+    return uint16_t(Bits >> 16);
+}
+
+#if !defined(_M_AMD64) || defined(_M_ARM64EC)
+
+//
+// The Windows x64 build implements this routine in assembly.
+//
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of half precision elements to single
+    precision.
+
+Arguments:
+
+    Source - Supplies the buffer of half precision elements.
+
+    Destination - Supplies the buffer that receives the single precision
+        elements.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    if (GetMlasPlatform().CastF16ToF32Kernel != nullptr) {
+        GetMlasPlatform().CastF16ToF32Kernel(Source, Destination, Count);
+        return;
+    }
+#elif defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+    while (Count >= 8) {
+        float16x8_t Vector = vreinterpretq_f16_u16(vld1q_u16(Source));
+        vst1q_f32(Destination, vcvt_f32_f16(vget_low_f16(Vector)));
+        vst1q_f32(Destination + 4, vcvt_high_f32_f16(Vector));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Half2Float(Source[i]);
+    }
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision elements to half
+    precision.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision elements.
+
+    Destination - Supplies the buffer that receives the half precision
+        elements.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    if (GetMlasPlatform().CastF32ToF16Kernel != nullptr) {
+        GetMlasPlatform().CastF32ToF16Kernel(Source, Destination, Count);
+        return;
+    }
+#elif defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+    while (Count >= 8) {
+        float16x8_t Vector = vcvt_high_f16_f32(vcvt_f16_f32(vld1q_f32(Source)), vld1q_f32(Source + 4));
+        vst1q_u16(Destination, vreinterpretq_u16_f16(Vector));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+#endif
+
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MLAS_Float2Half(Source[i]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of bfloat16 elements to single precision.
+
+    The loop widens the elements with integer shifts, which the compiler
+    vectorizes.
+
+Arguments:
+
+    Source - Supplies the buffer of bfloat16 elements.
+
+    Destination - Supplies the buffer that receives the single precision
+        elements.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    uint32_t* DestinationBits = reinterpret_cast<uint32_t*>(Destination);
+
+    for (size_t i = 0; i < Count; i++) {
+        DestinationBits[i] = uint32_t(Source[i]) << 16;
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision elements to bfloat16.
+
+    The loop rounds the elements with integer operations, which the compiler
+    vectorizes.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision elements.
+
+    Destination - Supplies the buffer that receives the bfloat16 elements.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t i = 0; i < Count; i++) {
+        Destination[i] = MlasFloatToBFloat16(Source[i]);
+    }
+}
@@ -0,0 +1,84 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_kernel_f16c.cpp
+
+Abstract:
+
+    This module implements the kernels to convert buffers between single and
+    half precision for processors with the F16C instructions.
+
+--*/
+
+#include "mlasi.h"
+
+#include <immintrin.h>
+
+void
+MLASCALL
+MlasCastF16ToF32KernelF16c(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        __m128i Elements0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+        __m128i Elements1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + 8));
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(Elements0));
+        _mm256_storeu_ps(Destination + 8, _mm256_cvtph_ps(Elements1));
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    while (Count >= 8) {
+        __m128i Elements = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(Elements));
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+        *Destination++ = _cvtsh_ss(*Source++);
+        Count--;
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelF16c(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+        __m128i Elements0 = _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        __m128i Elements1 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + 8), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Elements0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + 8), Elements1);
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    while (Count >= 8) {
+        __m128i Elements = _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Elements);
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    while (Count > 0) {
+        *Destination++ = _cvtss_sh(*Source++, _MM_FROUND_TO_NEAREST_INT);
+        Count--;
+    }
+}
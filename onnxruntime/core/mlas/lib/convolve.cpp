@@ -729,6 +729,91 @@ Return Value:
     }
 }
 
+#if defined(MLAS_TARGET_WASM)
+
+void
+MlasConvDepthwiseThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute the depthwise
+    convolution of a range of channels.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Compute the range of indices to use for this thread.
+    //
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t BatchGroupCount = Parameters->BatchCount * GroupCount;
+
+    size_t BatchGroupStart;
+    size_t BatchGroupRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount, BatchGroupCount,
+        &BatchGroupStart, &BatchGroupRemaining);
+
+    size_t BatchGroupEnd = BatchGroupStart + BatchGroupRemaining;
+
+    //
+    // Iterate over the batch and groups allocated to this thread. Each group
+    // has a single input channel and a single 3x3 filter.
+    //
+
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t K = Parameters->K;
+
+    for (size_t bg = BatchGroupStart; bg < BatchGroupEnd; bg++) {
+
+        size_t group = bg % GroupCount;
+
+        const float* input = WorkBlock->Input + bg * InputSize;
+        const float* filter = WorkBlock->Filter + group * K;
+        float* output = WorkBlock->Output + bg * OutputSize;
+
+        //
+        // The working buffer holds the zeros read in place of the padding
+        // rows. It is shared by all threads and only read.
+        //
+
+        MlasConvDepthwiseFloat_CHW(Parameters, input, filter, output, WorkBlock->WorkingBuffer);
+
+        //
+        // Apply the activation with optional bias.
+        //
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group;
+        }
+
+        MlasActivation(Parameters->Activation, output, bias, 1, OutputSize, OutputSize);
+    }
+}
+
+#endif
+
 inline
 bool
 MlasConvTryMultithread(
@@ -903,12 +988,51 @@ Return Value:
         return;
     }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_TARGET_WASM)
+
+    //
+    // Schedule the channels of depthwise convolutions across multiple threads.
+    //
 
     if (Algorithm == MlasConvAlgorithmDepthwise) {
+
         // Fill the Working Buffer with Zero for use by the depthwise kernel.
         // The length for the zeros are input image wide + 2 currently.
         std::fill_n(WorkingBuffer, Parameters->InputShape[1] + 2, 0.0f);
+
+        const size_t BatchGroupCount = BatchCount * GroupCount;
+
+        //
+        // Compute the number of target threads given the complexity of the
+        // convolution operation, so that small images run on a single thread.
+        //
+
+        const double Complexity = double(BatchGroupCount) * double(OutputSize) * double(K);
+
+        ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (TargetThreadCount >= MaximumThreadCount) {
+            TargetThreadCount = MaximumThreadCount;
+        }
+
+        if (size_t(TargetThreadCount) >= BatchGroupCount) {
+            TargetThreadCount = ptrdiff_t(BatchGroupCount);
+        }
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Filter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = WorkingBuffer;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = TargetThreadCount;
+
+        MlasExecuteThreaded(MlasConvDepthwiseThreaded, &WorkBlock, TargetThreadCount, ThreadPool);
+
+        return;
     }
 
 #endif
@@ -976,17 +1100,23 @@ Return Value:
                     break;
                 }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
-
-                case MlasConvAlgorithmDepthwise:
+                case MlasConvAlgorithmWinograd:
                 {
-                    MlasConvDepthwiseFloat_CHW(Parameters, Input, filter, Output, WorkingBuffer);
-                    MlasActivation(Parameters->Activation, Output, bias, FilterCount, OutputSize, OutputSize);
+                    //
+                    // The packed filter of each group holds the GEMM operand of
+                    // each point of the transformed tiles.
+                    //
+
+                    const size_t PackedFilterGroupSize =
+                        MlasConvWinogradPackWSize(1, FilterCount, Parameters->InputChannels);
+
+                    MlasConvWinograd(Parameters, Input,
+                        static_cast<const uint8_t*>(Parameters->u.Winograd.PackedFilter) + group * PackedFilterGroupSize,
+                        bias, WorkingBuffer, Output, ThreadPool);
+
                     break;
                 }
 
-#endif
-
                 case MlasConvAlgorithmExpandThenGemmSegmented:
                 {
                     //
@@ -1041,7 +1171,8 @@ MlasConvPrepare(
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
     float Beta,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    const void* WinogradPackedFilter
     )
 /*++
 
@@ -1088,6 +1219,10 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    WinogradPackedFilter - Optionally supplies the filter packed by
+        MlasConvWinogradPackW. If the convolution suits the Winograd algorithm,
+        MlasConv then uses this filter instead of the Filter argument.
+
 Return Value:
 
     None.
@@ -1168,6 +1303,16 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    if (WinogradPackedFilter != nullptr && MlasConvWinogradIsSupported(Parameters)) {
+
+        Parameters->Algorithm = MlasConvAlgorithmWinograd;
+        Parameters->u.Winograd.PackedFilter = WinogradPackedFilter;
+
+        *WorkingBufferSize = MlasConvWinogradPrepare(Parameters, ThreadPool);
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -1224,9 +1369,9 @@ Return Value:
 
     } else {
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_TARGET_WASM)
 
-        // Scalar direct conv for depthwise convolution.
+        // Direct conv for depthwise convolution.
         // Currently only support 3x3 kernel with padding <=1 and dilations = 1.
         // TODO: support more general depthwise convolution.
 
@@ -0,0 +1,251 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx512fp16.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for processors
+    with the AVX512-FP16 instructions. The products are accumulated in fp16,
+    as the NEON kernel does.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#include <immintrin.h>
+
+struct MLAS_HALF_GEMM_KERNEL_AVX512FP16 {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+MLAS_FORCEINLINE
+void
+CvtFloat2HalfAvx512Fp16(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+)
+{
+    while (len >= 16) {
+        __m256h res = _mm512_cvtxps_ph(_mm512_loadu_ps(src));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), _mm256_castph_si256(res));
+        src += 16;
+        dest += 16;
+        len -= 16;
+    }
+
+    if (0 == len) {
+        return;
+    }
+
+    const __mmask16 Mask = __mmask16((1u << len) - 1);
+    __m256h res = _mm512_cvtxps_ph(_mm512_maskz_loadu_ps(Mask, src));
+    _mm256_mask_storeu_epi16(dest, Mask, _mm256_castph_si256(res));
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2DAvx512Fp16(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        const size_t len = CntRow * CntCol;
+        CvtFloat2HalfAvx512Fp16(dest, src, len);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2HalfAvx512Fp16(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512Fp16(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DAvx512Fp16(D, B, ldb, CountK, CountN);
+}
+
+/**
+ * @brief Compute a block of RowCount rows by up to 64 columns of C.
+ */
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx512Fp16Block(
+    __mmask32 Mask0,
+    __mmask32 Mask1,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    __m512h Accumulators[RowCount][2];
+
+    __m512h BiasElements[2] = {_mm512_setzero_ph(), _mm512_setzero_ph()};
+
+    if (Bias != nullptr) {
+        BiasElements[0] = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask0, Bias));
+        BiasElements[1] = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask1, Bias + 32));
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = BiasElements[0];
+        Accumulators[r][1] = BiasElements[1];
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        const __m512h BElements0 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask0, B));
+        const __m512h BElements1 = _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask1, B + 32));
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m512h AElement = _mm512_castsi512_ph(_mm512_set1_epi16(short(A[r * lda + k])));
+            Accumulators[r][0] = _mm512_fmadd_ph(AElement, BElements0, Accumulators[r][0]);
+            Accumulators[r][1] = _mm512_fmadd_ph(AElement, BElements1, Accumulators[r][1]);
+        }
+
+        B += ldb;
+    }
+
+    //
+    // Add the partial result of the previous K slice after the slice is
+    // accumulated, in the same order as the scalar fp16 definition.
+    //
+
+    for (size_t r = 0; r < RowCount; r++) {
+        if (!ZeroMode) {
+            Accumulators[r][0] = _mm512_add_ph(Accumulators[r][0],
+                _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask0, C + r * ldc)));
+            Accumulators[r][1] = _mm512_add_ph(Accumulators[r][1],
+                _mm512_castsi512_ph(_mm512_maskz_loadu_epi16(Mask1, C + r * ldc + 32)));
+        }
+        _mm512_mask_storeu_epi16(C + r * ldc, Mask0, _mm512_castph_si512(Accumulators[r][0]));
+        _mm512_mask_storeu_epi16(C + r * ldc + 32, Mask1, _mm512_castph_si512(Accumulators[r][1]));
+    }
+}
+
+MLAS_FORCEINLINE
+__mmask32
+MlasHalfGemmColumnMaskAvx512Fp16(
+    size_t Columns
+    )
+{
+    return (Columns >= 32) ? __mmask32(~0u) : __mmask32((1u << Columns) - 1);
+}
+
+template<size_t RowCount>
+void
+MlasHalfGemmKernelAvx512Fp16Rows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    for (size_t n = 0; n < CountN; n += 64) {
+
+        const size_t Columns = std::min(CountN - n, size_t(64));
+        const __mmask32 Mask0 = MlasHalfGemmColumnMaskAvx512Fp16(Columns);
+        const __mmask32 Mask1 = MlasHalfGemmColumnMaskAvx512Fp16((Columns > 32) ? Columns - 32 : 0);
+
+        MlasHalfGemmKernelAvx512Fp16Block<RowCount>(
+            Mask0, Mask1, CountK, C + n, ldc, (Bias != nullptr) ? Bias + n : nullptr, A, lda, B + n, ldb, ZeroMode);
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX512FP16>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM)) {
+        case 1:
+            MlasHalfGemmKernelAvx512Fp16Rows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelAvx512Fp16Rows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelAvx512Fp16Rows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelAvx512Fp16Rows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16 = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX512FP16>,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX512FP16::KernelMaxM,
+    0
+};
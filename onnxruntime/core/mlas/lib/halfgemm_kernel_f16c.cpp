@@ -0,0 +1,282 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_f16c.cpp
+
+Abstract:
+
+    This module implements the half precision GEMM kernel for processors
+    with the F16C and FMA3 instructions. The fp16 elements are converted to
+    fp32 as they are loaded and the products are accumulated in fp32.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+#include <cstring>
+#include <immintrin.h>
+
+struct MLAS_HALF_GEMM_KERNEL_F16C {
+    static constexpr bool PackNeeded = false;
+    static constexpr size_t KernelMaxM = 4;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+MLAS_FORCEINLINE
+void
+CvtFloat2HalfF16c(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+)
+{
+    while (len >= 8) {
+        __m128i res = _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), res);
+        src += 8;
+        dest += 8;
+        len -= 8;
+    }
+
+    if (0 == len) {
+        return;
+    }
+
+    float buf[8] = {};
+    std::memcpy(buf, src, len * sizeof(float));
+    __m128i res = _mm256_cvtps_ph(_mm256_loadu_ps(buf), _MM_FROUND_TO_NEAREST_INT);
+    std::memcpy(dest, &res, len * sizeof(_mlas_fp16_));
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2DF16c(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        const size_t len = CntRow * CntCol;
+        CvtFloat2HalfF16c(dest, src, len);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2HalfF16c(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_F16C>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DF16c(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_F16C>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2DF16c(D, B, ldb, CountK, CountN);
+}
+
+/**
+ * @brief Load 16 fp16 elements, or the first Count elements followed by
+ *        zeros, and convert them to fp32.
+ */
+template<bool Partial>
+MLAS_FORCEINLINE
+void
+MlasHalfLoad16F16c(
+    const _mlas_fp16_* Buffer,
+    size_t Count,
+    __m256& Low,
+    __m256& High
+    )
+{
+    __m128i Elements[2];
+
+    if (Partial) {
+        Elements[0] = _mm_setzero_si128();
+        Elements[1] = _mm_setzero_si128();
+        std::memcpy(Elements, Buffer, Count * sizeof(_mlas_fp16_));
+    } else {
+        MLAS_UNREFERENCED_PARAMETER(Count);
+        Elements[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer));
+        Elements[1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Buffer + 8));
+    }
+
+    Low = _mm256_cvtph_ps(Elements[0]);
+    High = _mm256_cvtph_ps(Elements[1]);
+}
+
+/**
+ * @brief Compute a block of RowCount rows by 16 columns of C.
+ */
+template<size_t RowCount, bool Partial>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelF16cBlock(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    __m256 Accumulators[RowCount][2];
+
+    //
+    // Start from the bias or the partial result of the previous K slice.
+    //
+
+    if (ZeroMode) {
+        __m256 BiasElements[2] = {_mm256_setzero_ps(), _mm256_setzero_ps()};
+        if (Bias != nullptr) {
+            MlasHalfLoad16F16c<Partial>(Bias, CountN, BiasElements[0], BiasElements[1]);
+        }
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = BiasElements[0];
+            Accumulators[r][1] = BiasElements[1];
+        }
+    } else {
+        for (size_t r = 0; r < RowCount; r++) {
+            MlasHalfLoad16F16c<Partial>(C + r * ldc, CountN, Accumulators[r][0], Accumulators[r][1]);
+        }
+    }
+
+    for (size_t k = 0; k < CountK; k++) {
+
+        __m256 BElements[2];
+        MlasHalfLoad16F16c<Partial>(B, CountN, BElements[0], BElements[1]);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m256 AElement = _mm256_cvtph_ps(_mm_set1_epi16(short(A[r * lda + k])));
+            Accumulators[r][0] = _mm256_fmadd_ps(AElement, BElements[0], Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(AElement, BElements[1], Accumulators[r][1]);
+        }
+
+        B += ldb;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        _mlas_fp16_* c = C + r * ldc;
+
+        __m128i Elements[2];
+        Elements[0] = _mm256_cvtps_ph(Accumulators[r][0], _MM_FROUND_TO_NEAREST_INT);
+        Elements[1] = _mm256_cvtps_ph(Accumulators[r][1], _MM_FROUND_TO_NEAREST_INT);
+
+        if (Partial) {
+            std::memcpy(c, Elements, CountN * sizeof(_mlas_fp16_));
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c), Elements[0]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c + 8), Elements[1]);
+        }
+    }
+}
+
+template<size_t RowCount>
+void
+MlasHalfGemmKernelF16cRows(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+    )
+{
+    size_t n = 0;
+
+    for (; n + 16 <= CountN; n += 16) {
+        MlasHalfGemmKernelF16cBlock<RowCount, false>(
+            16, CountK, C + n, ldc, (Bias != nullptr) ? Bias + n : nullptr, A, lda, B + n, ldb, ZeroMode);
+    }
+
+    if (n < CountN) {
+        MlasHalfGemmKernelF16cBlock<RowCount, true>(
+            CountN - n, CountK, C + n, ldc, (Bias != nullptr) ? Bias + n : nullptr, A, lda, B + n, ldb, ZeroMode);
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_F16C>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    switch (std::min(CountM, MLAS_HALF_GEMM_KERNEL_F16C::KernelMaxM)) {
+        case 1:
+            MlasHalfGemmKernelF16cRows<1>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 2:
+            MlasHalfGemmKernelF16cRows<2>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        case 3:
+            MlasHalfGemmKernelF16cRows<3>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+        default:
+            MlasHalfGemmKernelF16cRows<4>(CountN, CountK, C, ldc, Bias, A, lda, B, ldb, ZeroMode);
+            break;
+    }
+}
+
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchF16c = {
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_F16C>,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_F16C>,
+    MLAS_HALF_GEMM_KERNEL_F16C::PackedK,
+    MLAS_HALF_GEMM_KERNEL_F16C::KernelMaxM,
+    0
+};
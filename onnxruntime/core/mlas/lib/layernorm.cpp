@@ -0,0 +1,160 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements the single precision layer normalization, which
+    the LayerNormalization and SkipLayerNormalization operators compute.
+
+--*/
+
+#include "layernorm.h"
+
+struct MLAS_LAYER_NORM_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    const MLAS_LAYER_NORM_PARAMS* Params;
+    size_t N;
+    size_t D;
+};
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t RowStart,
+    size_t RowCount,
+    size_t Columns
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to normalize a range of rows
+    of a matrix.
+
+Arguments:
+
+    Params - Supplies the layer normalization parameters.
+
+    RowStart - Supplies the first row to normalize.
+
+    RowCount - Supplies the number of rows to normalize.
+
+    Columns - Supplies the number of columns of the matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasLayerNormKernel<MLAS_REDUCE_VECTOR_OPS_FLOAT32X4>(Params, RowStart, RowCount, Columns);
+}
+
+void
+MlasLayerNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYER_NORM_WORK_BLOCK*)Context;
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().LayerNormF32Kernel(WorkBlock->Params, n, CountN, WorkBlock->D);
+#else
+    MlasLayerNormF32Kernel(WorkBlock->Params, n, CountN, WorkBlock->D);
+#endif
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t Rows,
+    size_t Columns,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes each row of a matrix.
+
+Arguments:
+
+    Params - Supplies the layer normalization parameters.
+
+    Rows - Supplies the number of rows of the matrix.
+
+    Columns - Supplies the number of columns of the matrix.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_LAYER_NORM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Params = Params;
+    WorkBlock.N = Rows;
+    WorkBlock.D = Columns;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of rows and try
+    // to keep each thread processing a minimum number of elements before
+    // using another thread.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > Rows) {
+        ThreadCountN = ptrdiff_t(Rows);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((Rows * Columns) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasLayerNormThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -0,0 +1,292 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.h
+
+Abstract:
+
+    This module implements the single precision layer normalization kernel
+    for a vector type. Each kernel file instantiates it with the vector
+    operations of its instruction set.
+
+--*/
+
+#pragma once
+
+#include "reduce.h"
+
+#include <cmath>
+
+//
+// Running mean and sum of squared deviations of a set of values.
+//
+
+struct MLAS_WELFORD_STATE
+{
+    float Count;
+    float Mean;
+    float M2;
+};
+
+MLAS_FORCEINLINE
+void
+MlasWelfordCombine(
+    MLAS_WELFORD_STATE& State,
+    float Count,
+    float Mean,
+    float M2
+    )
+{
+    if (Count == 0.0f) {
+        return;
+    }
+
+    const float TotalCount = State.Count + Count;
+    const float Delta = Mean - State.Mean;
+    const float Weight = Count / TotalCount;
+
+    State.Mean += Delta * Weight;
+    State.M2 += M2 + Delta * Delta * State.Count * Weight;
+    State.Count = TotalCount;
+}
+
+template<typename VectorOps>
+MLAS_FORCEINLINE
+void
+MlasWelfordCombineVector(
+    MLAS_WELFORD_STATE& State,
+    float Count,
+    typename VectorOps::Vector Mean,
+    typename VectorOps::Vector M2
+    )
+{
+    constexpr size_t Width = VectorOps::Width;
+
+    float Means[Width];
+    float M2s[Width];
+
+    VectorOps::Store(Means, Mean);
+    VectorOps::Store(M2s, M2);
+
+    for (size_t i = 0; i < Width; i++) {
+        MlasWelfordCombine(State, Count, Means[i], M2s[i]);
+    }
+}
+
+//
+// Loads Input + Skip + Bias. The sum is stored to Output and SkipOutput.
+//
+
+template<typename VectorOps>
+MLAS_FORCEINLINE
+typename VectorOps::Vector
+MlasLayerNormLoadInput(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    float* SkipOutput,
+    size_t Offset
+    )
+{
+    auto Value = VectorOps::Load(Input + Offset);
+
+    if (Skip != nullptr) {
+        Value = VectorOps::Add(Value, VectorOps::Load(Skip + Offset));
+    }
+    if (Bias != nullptr) {
+        Value = VectorOps::Add(Value, VectorOps::Load(Bias + Offset));
+    }
+    if (SkipOutput != nullptr) {
+        VectorOps::Store(SkipOutput + Offset, Value);
+    }
+
+    VectorOps::Store(Output + Offset, Value);
+
+    return Value;
+}
+
+template<typename VectorOps>
+void
+MlasLayerNormRow(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    const float* Input,
+    const float* Skip,
+    float* Output,
+    float* SkipOutput,
+    float* Mean,
+    float* InvStdDev,
+    size_t N
+    )
+{
+    using Vector = typename VectorOps::Vector;
+    constexpr size_t Width = VectorOps::Width;
+
+    const float* Bias = Params->Bias;
+
+    //
+    // Combine the inputs and accumulate the Welford state of each lane of
+    // a group of vectors. The lanes of a vector have the same count, and
+    // the vectors of the group have the same count except for the first,
+    // which also takes the trailing whole vectors.
+    //
+
+    Vector Means[MLAS_REDUCE_UNROLL];
+    Vector M2s[MLAS_REDUCE_UNROLL];
+
+    for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+        Means[i] = VectorOps::Broadcast(0.0f);
+        M2s[i] = VectorOps::Broadcast(0.0f);
+    }
+
+    float Count = 0.0f;
+    size_t n = 0;
+
+    for (; n + Width * MLAS_REDUCE_UNROLL <= N; n += Width * MLAS_REDUCE_UNROLL) {
+
+        Count += 1.0f;
+        const Vector InverseCount = VectorOps::Broadcast(1.0f / Count);
+
+        for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+            Vector Value = MlasLayerNormLoadInput<VectorOps>(Input, Skip, Bias, Output, SkipOutput, n + i * Width);
+            Vector Delta = VectorOps::Subtract(Value, Means[i]);
+            Means[i] = VectorOps::MultiplyAdd(Delta, InverseCount, Means[i]);
+            M2s[i] = VectorOps::MultiplyAdd(Delta, VectorOps::Subtract(Value, Means[i]), M2s[i]);
+        }
+    }
+
+    float Count0 = Count;
+
+    for (; n + Width <= N; n += Width) {
+
+        Count0 += 1.0f;
+        const Vector InverseCount = VectorOps::Broadcast(1.0f / Count0);
+
+        Vector Value = MlasLayerNormLoadInput<VectorOps>(Input, Skip, Bias, Output, SkipOutput, n);
+        Vector Delta = VectorOps::Subtract(Value, Means[0]);
+        Means[0] = VectorOps::MultiplyAdd(Delta, InverseCount, Means[0]);
+        M2s[0] = VectorOps::MultiplyAdd(Delta, VectorOps::Subtract(Value, Means[0]), M2s[0]);
+    }
+
+    MLAS_WELFORD_STATE State{0.0f, 0.0f, 0.0f};
+
+    MlasWelfordCombineVector<VectorOps>(State, Count0, Means[0], M2s[0]);
+
+    for (size_t i = 1; i < MLAS_REDUCE_UNROLL; i++) {
+        MlasWelfordCombineVector<VectorOps>(State, Count, Means[i], M2s[i]);
+    }
+
+    for (; n < N; n++) {
+
+        float Value = Input[n];
+
+        if (Skip != nullptr) {
+            Value += Skip[n];
+        }
+        if (Bias != nullptr) {
+            Value += Bias[n];
+        }
+        if (SkipOutput != nullptr) {
+            SkipOutput[n] = Value;
+        }
+
+        Output[n] = Value;
+
+        State.Count += 1.0f;
+        const float Delta = Value - State.Mean;
+        State.Mean += Delta / State.Count;
+        State.M2 += Delta * (Value - State.Mean);
+    }
+
+    //
+    // Normalize the row in place in the output, which is still cached.
+    //
+
+    const float Variance = (N == 0) ? 0.0f : State.M2 / State.Count;
+    float RowMean;
+    float RowInvStdDev;
+
+    if (Params->Simplified) {
+        RowMean = 0.0f;
+        RowInvStdDev = 1.0f / std::sqrt(Variance + State.Mean * State.Mean + Params->Epsilon);
+    } else {
+        RowMean = State.Mean;
+        RowInvStdDev = 1.0f / std::sqrt(Variance + Params->Epsilon);
+    }
+
+    if (Mean != nullptr) {
+        *Mean = RowMean;
+    }
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+
+    const float* Gamma = Params->Gamma;
+    const float* Beta = Params->Simplified ? nullptr : Params->Beta;
+
+    const Vector MeanVector = VectorOps::Broadcast(RowMean);
+    const Vector InvStdDevVector = VectorOps::Broadcast(RowInvStdDev);
+
+    n = 0;
+
+    for (; n + Width <= N; n += Width) {
+
+        Vector Value = VectorOps::Subtract(VectorOps::Load(Output + n), MeanVector);
+        Value = VectorOps::Multiply(Value, InvStdDevVector);
+
+        if (Beta != nullptr) {
+            Value = VectorOps::MultiplyAdd(Value, VectorOps::Load(Gamma + n), VectorOps::Load(Beta + n));
+        } else {
+            Value = VectorOps::Multiply(Value, VectorOps::Load(Gamma + n));
+        }
+
+        VectorOps::Store(Output + n, Value);
+    }
+
+    for (; n < N; n++) {
+
+        float Value = (Output[n] - RowMean) * RowInvStdDev * Gamma[n];
+
+        if (Beta != nullptr) {
+            Value += Beta[n];
+        }
+
+        Output[n] = Value;
+    }
+}
+
+template<typename VectorOps>
+void
+MlasLayerNormKernel(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t RowStart,
+    size_t RowCount,
+    size_t Columns
+    )
+{
+    for (size_t Row = RowStart; Row < RowStart + RowCount; Row++) {
+
+        const size_t Offset = Row * Columns;
+
+        const float* Skip = nullptr;
+
+        if (Params->Skip != nullptr) {
+            Skip = Params->Skip + (Row % Params->SkipRowCount) * Columns;
+        }
+
+        MlasLayerNormRow<VectorOps>(
+            Params,
+            Params->Input + Offset,
+            Skip,
+            Params->Output + Offset,
+            Params->SkipOutput == nullptr ? nullptr : Params->SkipOutput + Offset,
+            Params->Mean == nullptr ? nullptr : Params->Mean + Row,
+            Params->InvStdDev == nullptr ? nullptr : Params->InvStdDev + Row,
+            Columns);
+    }
+}
@@ -20,6 +20,7 @@ Abstract:
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <initializer_list>
 #include <limits>
 #include <memory>
 #include <stdexcept>
@@ -574,6 +575,68 @@ void
     size_t N
     );
 
+typedef
+void
+(MLASCALL MLAS_REDUCE_ROWS_FLOAT_KERNEL)(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    );
+
+typedef
+void
+(MLASCALL MLAS_REDUCE_COLUMNS_FLOAT_KERNEL)(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    );
+
+typedef
+void
+(MLASCALL MLAS_LAYER_NORM_FLOAT_KERNEL)(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t RowStart,
+    size_t RowCount,
+    size_t Columns
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F16_TO_F32_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_F16_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_TREE_TRAVERSE_KERNEL)(
+    MLAS_TREE_NODE_MODE Mode,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    );
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -673,6 +736,10 @@ extern "C" {
 #if defined(MLAS_TARGET_AMD64)
     MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1Avx;
     MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1TransposeBAvx;
+    MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1Fma3;
+    MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1TransposeBFma3;
+    MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1Avx512F;
+    MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1TransposeBAvx512F;
 #elif defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_WASM)
     MLAS_GEMV_FLOAT_KERNEL MlasGemvFloatKernel;
 #endif
@@ -760,9 +827,22 @@ extern "C" {
 
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32Kernel;
+    MLAS_REDUCE_ROWS_FLOAT_KERNEL MlasReduceRowsF32Kernel;
+    MLAS_REDUCE_COLUMNS_FLOAT_KERNEL MlasReduceColumnsF32Kernel;
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32Kernel;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL MlasReduceMaximumF32KernelAvx;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
+    MLAS_REDUCE_ROWS_FLOAT_KERNEL MlasReduceRowsF32KernelAvx2;
+    MLAS_REDUCE_COLUMNS_FLOAT_KERNEL MlasReduceColumnsF32KernelAvx2;
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx2;
+    MLAS_REDUCE_ROWS_FLOAT_KERNEL MlasReduceRowsF32KernelAvx512F;
+    MLAS_REDUCE_COLUMNS_FLOAT_KERNEL MlasReduceColumnsF32KernelAvx512F;
+    MLAS_LAYER_NORM_FLOAT_KERNEL MlasLayerNormF32KernelAvx512F;
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32KernelF16c;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16KernelF16c;
+    MLAS_TREE_TRAVERSE_KERNEL MlasTreeTraverseKernelAvx2;
+    MLAS_TREE_TRAVERSE_KERNEL MlasTreeTraverseKernelAvx512F;
 #endif
 
 }
@@ -811,7 +891,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue = nullptr
     );
 
 //
@@ -858,10 +939,28 @@ extern const MLAS_CONV_SYM_DISPATCH MlasConvSymS8DispatchDot;
 struct MLAS_Q8Q4GEMM_DISPATCH;
 
 extern const MLAS_Q8Q4GEMM_DISPATCH MlasQ8Q4GemmDispatchAvx512vnni;
+extern const MLAS_Q8Q4GEMM_DISPATCH MlasQ8Q4GemmDispatchNeon;
+extern const MLAS_Q8Q4GEMM_DISPATCH MlasQ8Q4GemmDispatchSdot;
 
 struct MLAS_FPQ4GEMM_DISPATCH;
 
 extern const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchAvx512;
+extern const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchNeon;
+
+struct MLAS_BF16_GEMM_DISPATCH;
+
+extern const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAvx512Bf16;
+extern const MLAS_BF16_GEMM_DISPATCH MlasBf16GemmDispatchAmx;
+
+struct MLAS_SPARSE24_GEMM_DISPATCH;
+
+extern const MLAS_SPARSE24_GEMM_DISPATCH MlasSparse24GemmDispatchDefault;
+extern const MLAS_SPARSE24_GEMM_DISPATCH MlasSparse24GemmDispatchAvx512F;
+
+struct MLAS_HALFGEMM_DISPATCH;
+
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchF16c;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx512Fp16;
 
 //
 // Quantized depthwise convolution kernels.
@@ -920,11 +1019,51 @@ struct MLAS_CONV_SYM_POST_PROCESS_PARAMS {
 
 enum MlasCoreType { mlas_core_unknown = 0, mlas_core_little = 2, mlas_core_big = 3 };
 
+//
+// Ordered instruction set levels of the platform kernels. The levels of one
+// target architecture are ordered by the nesting of the processor feature
+// checks, so that a level limits the kernels to those checks at or below it.
+//
+
+enum MLAS_ISA_LEVEL : uint8_t {
+    MlasIsaBaseline,
+    MlasIsaSse41,
+    MlasIsaAvx,
+    MlasIsaAvx2,
+    MlasIsaAvxVnni,
+    MlasIsaAvx512F,
+    MlasIsaAvx512Core,
+    MlasIsaAvx512Vnni,
+    MlasIsaAvx512Bf16,
+    MlasIsaAvx512Fp16,
+    MlasIsaAmx,
+    MlasIsaNeonDot,
+    MlasIsaMaximum,
+};
+
+struct MLAS_DISPATCH_OVERRIDE {
+    MLAS_ISA_LEVEL IsaLimit[MlasKernelFamilyCount];
+};
 
 struct MLAS_PLATFORM {
 
     MLAS_PLATFORM(void);
 
+    MLAS_PLATFORM(const MLAS_DISPATCH_OVERRIDE& Override);
+
+    void SelectKernels(MLAS_ISA_LEVEL IsaLimit);
+
+    void CopyKernelFamily(const MLAS_PLATFORM& Source, MLAS_KERNEL_FAMILY Family);
+
+    void SetKernelFamilyIsa(std::initializer_list<MLAS_KERNEL_FAMILY> Families, MLAS_ISA_LEVEL Isa)
+    {
+        for (MLAS_KERNEL_FAMILY Family : Families) {
+            KernelFamilyIsa[Family] = Isa;
+        }
+    }
+
+    MLAS_ISA_LEVEL KernelFamilyIsa[MlasKernelFamilyCount];
+
 #if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER)
     MLAS_GEMM_FLOAT_KERNEL* GemmFloatKernel;
 #endif
@@ -954,13 +1093,13 @@ struct MLAS_PLATFORM {
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
 #endif
 #if defined(MLAS_TARGET_AMD64)
-    MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1Routine;
-    MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1TransposeBRoutine;
+    MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1Routine{nullptr};
+    MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1TransposeBRoutine{nullptr};
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE* TransposePackB16x4Routine;
     MLAS_GEMM_DOUBLE_KERNEL* GemmDoubleKernel;
-    MLAS_GEMM_U8S8_KERNEL* GemmU8S8Kernel;
-    MLAS_GEMV_U8S8_KERNEL* GemvU8S8Kernel;
-    MLAS_GEMM_U8U8_KERNEL* GemmU8U8Kernel;
+    MLAS_GEMM_U8S8_KERNEL* GemmU8S8Kernel{nullptr};
+    MLAS_GEMV_U8S8_KERNEL* GemvU8S8Kernel{nullptr};
+    MLAS_GEMM_U8U8_KERNEL* GemmU8U8Kernel{nullptr};
     MLAS_CONV_FLOAT_KERNEL* ConvNchwFloatKernel;
     MLAS_CONV_FLOAT_KERNEL* ConvNchwcFloatKernel;
     MLAS_CONV_DEPTHWISE_FLOAT_KERNEL* ConvDepthwiseFloatKernel;
@@ -977,6 +1116,12 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_REDUCE_ROWS_FLOAT_KERNEL* ReduceRowsF32Kernel;
+    MLAS_REDUCE_COLUMNS_FLOAT_KERNEL* ReduceColumnsF32Kernel;
+    MLAS_LAYER_NORM_FLOAT_KERNEL* LayerNormF32Kernel;
+    MLAS_CAST_F16_TO_F32_KERNEL* CastF16ToF32Kernel{nullptr};
+    MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel{nullptr};
+    MLAS_TREE_TRAVERSE_KERNEL* TreeTraverseKernel{nullptr};
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     uint32_t NchwcBlockSize;
@@ -990,6 +1135,9 @@ struct MLAS_PLATFORM {
 
     const MLAS_FPQ4GEMM_DISPATCH* FpQ4GemmDispatch{nullptr};
     const MLAS_Q8Q4GEMM_DISPATCH* Q8Q4GemmDispatch{nullptr};
+    const MLAS_BF16_GEMM_DISPATCH* Bf16GemmDispatch{nullptr};
+    const MLAS_SPARSE24_GEMM_DISPATCH* Sparse24GemmDispatch{&MlasSparse24GemmDispatchDefault};
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{nullptr};
 };
 
 inline
@@ -1123,7 +1271,33 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+//
+// Winograd convolution routines.
+//
+
+bool
+MlasConvWinogradIsSupported(
+    const MLAS_CONV_PARAMETERS* Parameters
+    );
+
+size_t
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const uint8_t* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+#if defined(MLAS_TARGET_WASM)
 
 void
 MLASCALL
@@ -1182,6 +1356,9 @@ MlasConvDepthwiseFloat_CHW(
 #endif
 #elif defined(MLAS_TARGET_WASM_SIMD)
 #define MLAS_WASM_SIMD_INTRINSICS
+#if defined(__wasm_relaxed_simd__)
+#define MLAS_WASM_RELAXED_SIMD_INTRINSICS
+#endif
 #endif
 
 #if defined(MLAS_NEON_INTRINSICS)
@@ -1779,6 +1956,9 @@ MlasMultiplyAddFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FL
     return _mm_add_ps(_mm_mul_ps(Vector1, Vector2), Vector3);
 #elif defined(MLAS_VSX_INTRINSICS)
     return vec_madd(Vector1, Vector2, Vector3);
+#elif defined(MLAS_WASM_RELAXED_SIMD_INTRINSICS)
+    // The engine may or may not fuse the multiply and add, as the FMA3 and SSE2 paths differ.
+    return wasm_f32x4_relaxed_madd(Vector1, Vector2, Vector3);
 #elif defined(MLAS_WASM_SIMD_INTRINSICS)
     return wasm_f32x4_add(wasm_f32x4_mul(Vector1, Vector2), Vector3);
 #else
@@ -17,6 +17,7 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <cstdlib>
 #include <thread>
 #include <mutex>
 
@@ -171,18 +172,20 @@ MlasInitAMX()
 
 #endif // MLAS_TARGET_AMD64_IX86
 
-MLAS_PLATFORM::MLAS_PLATFORM(
-    void
+void
+MLAS_PLATFORM::SelectKernels(
+    MLAS_ISA_LEVEL IsaLimit
     )
 /*++
 
 Routine Description:
 
-    This routine initializes the platform support for this library.
+    This routine selects the kernels of every family from the processor
+    features, skipping the features above the supplied instruction set level.
 
 Arguments:
 
-    None.
+    IsaLimit - Supplies the highest instruction set level to select.
 
 Return Value:
 
@@ -190,6 +193,11 @@ Return Value:
 
 --*/
 {
+    MLAS_UNREFERENCED_PARAMETER(IsaLimit);
+
+    for (size_t Family = 0; Family < MlasKernelFamilyCount; Family++) {
+        this->KernelFamilyIsa[Family] = MlasIsaBaseline;
+    }
 
     this->ConvDepthwiseU8S8Kernel = MlasConvDepthwiseKernel<uint8_t, int8_t>;
     this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t, uint8_t>;
@@ -226,6 +234,9 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->ReduceRowsF32Kernel = MlasReduceRowsF32Kernel;
+    this->ReduceColumnsF32Kernel = MlasReduceColumnsF32Kernel;
+    this->LayerNormF32Kernel = MlasLayerNormF32Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -251,8 +262,9 @@ Return Value:
     // Check if the processor supports SSE 4.1 instructions.
     //
 
-    if ((Cpuid1[2] & 0x80000) != 0) {
+    if ((Cpuid1[2] & 0x80000) != 0 && IsaLimit >= MlasIsaSse41) {
         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchSse41;
+        this->SetKernelFamilyIsa({MlasKernelFamilyQgemm}, MlasIsaSse41);
     }
 
 #endif
@@ -269,9 +281,10 @@ Return Value:
 
         uint64_t xcr0 = MlasReadExtendedControlRegister(_XCR_XFEATURE_ENABLED_MASK);
 
-        if ((xcr0 & 0x6) == 0x6) {
+        if ((xcr0 & 0x6) == 0x6 && IsaLimit >= MlasIsaAvx) {
 
             this->GemmFloatKernel = MlasGemmFloatKernelAvx;
+            this->SetKernelFamilyIsa({MlasKernelFamilySgemm}, MlasIsaAvx);
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -291,6 +304,8 @@ Return Value:
             this->ReduceMaximumF32Kernel = MlasReduceMaximumF32KernelAvx;
             this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32KernelAvx;
             this->GemmU8U8Kernel = nullptr;
+            this->SetKernelFamilyIsa({MlasKernelFamilyDgemm, MlasKernelFamilyConv, MlasKernelFamilyActivation},
+                                     MlasIsaAvx);
 
             //
             // Check if the processor supports AVX2/FMA3 features.
@@ -303,7 +318,7 @@ Return Value:
             __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
 #endif
 
-            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
+            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0) && IsaLimit >= MlasIsaAvx2) {
 
                 this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
                 this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx2;
@@ -313,6 +328,8 @@ Return Value:
                 this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx2;
 
                 this->GemmFloatKernel = MlasGemmFloatKernelFma3;
+                this->KernelM1Routine = MlasSgemmKernelM1Fma3;
+                this->KernelM1TransposeBRoutine = MlasSgemmKernelM1TransposeBFma3;
                 this->GemmDoubleKernel = MlasGemmDoubleKernelFma3;
                 this->ConvNchwFloatKernel = MlasConvNchwFloatKernelFma3;
                 this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelFma3;
@@ -329,6 +346,26 @@ Return Value:
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->ReduceRowsF32Kernel = MlasReduceRowsF32KernelAvx2;
+                this->ReduceColumnsF32Kernel = MlasReduceColumnsF32KernelAvx2;
+                this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx2;
+                this->TreeTraverseKernel = MlasTreeTraverseKernelAvx2;
+                this->SetKernelFamilyIsa({MlasKernelFamilySgemm, MlasKernelFamilyDgemm, MlasKernelFamilyQgemm,
+                                          MlasKernelFamilyConv, MlasKernelFamilyActivation, MlasKernelFamilyReduce,
+                                          MlasKernelFamilyQuantize, MlasKernelFamilyTree},
+                                         MlasIsaAvx2);
+
+                //
+                // Check if the processor supports the F16C conversions.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+
+                    this->HalfGemmDispatch = &MlasHalfGemmDispatchF16c;
+                    this->CastF16ToF32Kernel = MlasCastF16ToF32KernelF16c;
+                    this->CastF32ToF16Kernel = MlasCastF32ToF16KernelF16c;
+                    this->SetKernelFamilyIsa({MlasKernelFamilyHalfGemm, MlasKernelFamilyCast}, MlasIsaAvx2);
+                }
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -349,12 +386,13 @@ Return Value:
                 __cpuid_count(7, 1, Cpuid7_1[0], Cpuid7_1[1], Cpuid7_1[2], Cpuid7_1[3]);
 #endif
 
-                if ((Cpuid7_1[0] & 0x10) != 0) {
+                if ((Cpuid7_1[0] & 0x10) != 0 && IsaLimit >= MlasIsaAvxVnni) {
 
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
                     this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvxVnni;
+                    this->SetKernelFamilyIsa({MlasKernelFamilyQgemm}, MlasIsaAvxVnni);
                 }
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -364,9 +402,11 @@ Return Value:
                 // operating system supports saving AVX512F state.
                 //
 
-                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0) && IsaLimit >= MlasIsaAvx512F) {
 
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
+                    this->KernelM1Routine = MlasSgemmKernelM1Avx512F;
+                    this->KernelM1TransposeBRoutine = MlasSgemmKernelM1TransposeBAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
                     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelAvx512F;
                     this->ConvNchwcFloatKernel = MlasConvNchwcFloatKernelAvx512F;
@@ -377,35 +417,67 @@ Return Value:
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
                     this->ComputeExpF32Kernel = MlasComputeExpF32KernelAvx512F;
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
+                    this->ReduceRowsF32Kernel = MlasReduceRowsF32KernelAvx512F;
+                    this->ReduceColumnsF32Kernel = MlasReduceColumnsF32KernelAvx512F;
+                    this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->Sparse24GemmDispatch = &MlasSparse24GemmDispatchAvx512F;
+                    this->TreeTraverseKernel = MlasTreeTraverseKernelAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
+                    this->SetKernelFamilyIsa({MlasKernelFamilySgemm, MlasKernelFamilyDgemm, MlasKernelFamilyConv,
+                                              MlasKernelFamilyActivation, MlasKernelFamilyReduce,
+                                              MlasKernelFamilyQuantize, MlasKernelFamilyTree},
+                                             MlasIsaAvx512F);
 
                     //
                     // Check if the processor supports AVX512 core features
                     // (AVX512BW/AVX512DQ/AVX512VL).
                     //
 
-                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000) {
+                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000 && IsaLimit >= MlasIsaAvx512Core) {
 
                         this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
                         this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
                         this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Core;
                         this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchAvx512;
+                        this->SetKernelFamilyIsa({MlasKernelFamilyQgemm, MlasKernelFamilyQ4Gemm}, MlasIsaAvx512Core);
 
                         //
                         // Check if the processor supports AVX512VNNI.
                         //
 
-                        if ((Cpuid7[2] & 0x800) != 0) {
+                        if ((Cpuid7[2] & 0x800) != 0 && IsaLimit >= MlasIsaAvx512Vnni) {
 
                             this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
                             this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchAvx512vnni;
+                            this->SetKernelFamilyIsa({MlasKernelFamilyQgemm, MlasKernelFamilyQ4Gemm},
+                                                     MlasIsaAvx512Vnni);
+                        }
+
+                        //
+                        // Check if the processor supports AVX512_BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0 && IsaLimit >= MlasIsaAvx512Bf16) {
+
+                            this->Bf16GemmDispatch = &MlasBf16GemmDispatchAvx512Bf16;
+                            this->SetKernelFamilyIsa({MlasKernelFamilyBf16Gemm}, MlasIsaAvx512Bf16);
+                        }
+
+                        //
+                        // Check if the processor supports AVX512_FP16.
+                        //
+
+                        if ((Cpuid7[3] & 0x800000) != 0 && IsaLimit >= MlasIsaAvx512Fp16) {
+
+                            this->HalfGemmDispatch = &MlasHalfGemmDispatchAvx512Fp16;
+                            this->SetKernelFamilyIsa({MlasKernelFamilyHalfGemm}, MlasIsaAvx512Fp16);
                         }
                     }
                 }
@@ -415,10 +487,23 @@ Return Value:
                 // Check if the processor supports AMX-TILE and AMX-INT8
                 // features.
                 //
-                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 25) != 0) {
+                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 25) != 0 && IsaLimit >= MlasIsaAmx) {
                     if (MlasInitAMX()) {
                         this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAmx;
                         this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                        this->SetKernelFamilyIsa({MlasKernelFamilyQgemm}, MlasIsaAmx);
+                    }
+                }
+
+                //
+                // Check if the processor supports AMX-TILE and AMX-BF16
+                // features. The kernel converts A with AVX512_BF16.
+                //
+                if ((Cpuid7[3] & 0b1 << 24) != 0 && (Cpuid7[3] & 0b1 << 22) != 0 &&
+                    this->Bf16GemmDispatch != nullptr && IsaLimit >= MlasIsaAmx) {
+                    if (MlasInitAMX()) {
+                        this->Bf16GemmDispatch = &MlasBf16GemmDispatchAmx;
+                        this->SetKernelFamilyIsa({MlasKernelFamilyBf16Gemm}, MlasIsaAmx);
                     }
                 }
 #endif // __APPLE__
@@ -442,6 +527,8 @@ Return Value:
     this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchNeon;
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
+    this->FpQ4GemmDispatch = &MlasFpQ4GemmDispatchNeon;
+    this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchNeon;
 
     //
     // Check if the processor supports ASIMD dot product instructions.
@@ -464,13 +551,15 @@ Return Value:
     HasDotProductInstructions = MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeonDot();
 #endif
 
-    if (HasDotProductInstructions) {
+    if (HasDotProductInstructions && IsaLimit >= MlasIsaNeonDot) {
         this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchUdot;
         this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchUdot;
         this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSdot;
         this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchSdot;
         this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchDot;
         this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchDot;
+        this->Q8Q4GemmDispatch = &MlasQ8Q4GemmDispatchSdot;
+        this->SetKernelFamilyIsa({MlasKernelFamilyQgemm, MlasKernelFamilyQ4Gemm}, MlasIsaNeonDot);
     }
 
 #endif // MLAS_TARGET_ARM64
@@ -506,6 +595,452 @@ Return Value:
 
 }
 
+//
+// Names of the kernel families and instruction set levels used by the
+// dispatch override specification.
+//
+
+static const char* const MlasKernelFamilyNames[MlasKernelFamilyCount] = {
+    "sgemm",
+    "dgemm",
+    "qgemm",
+    "conv",
+    "activation",
+    "reduce",
+    "quantize",
+    "halfgemm",
+    "bf16gemm",
+    "q4gemm",
+    "cast",
+    "tree",
+};
+
+static const struct {
+    const char* Name;
+    MLAS_ISA_LEVEL Isa;
+} MlasIsaLevelNames[] = {
+#if defined(MLAS_TARGET_AMD64_IX86)
+    {"sse2", MlasIsaBaseline},
+    {"sse41", MlasIsaSse41},
+    {"avx", MlasIsaAvx},
+    {"avx2", MlasIsaAvx2},
+    {"avxvnni", MlasIsaAvxVnni},
+    {"avx512f", MlasIsaAvx512F},
+    {"avx512core", MlasIsaAvx512Core},
+    {"avx512vnni", MlasIsaAvx512Vnni},
+    {"avx512bf16", MlasIsaAvx512Bf16},
+    {"avx512fp16", MlasIsaAvx512Fp16},
+    {"amx", MlasIsaAmx},
+#elif defined(MLAS_TARGET_ARM64)
+    {"neon", MlasIsaBaseline},
+    {"dot", MlasIsaNeonDot},
+#else
+    {"baseline", MlasIsaBaseline},
+#endif
+};
+
+static
+bool
+MlasParseDispatchOverride(
+    const char* Specification,
+    MLAS_DISPATCH_OVERRIDE& Override
+    )
+/*++
+
+Routine Description:
+
+    This routine parses a dispatch override specification of comma separated
+    `family=isa` entries. Later entries replace the limits of earlier entries.
+
+Arguments:
+
+    Specification - Supplies the specification, or nullptr for no limits.
+
+    Override - Receives the instruction set limit of each kernel family.
+
+Return Value:
+
+    Returns false if the specification is malformed.
+
+--*/
+{
+    for (size_t Family = 0; Family < MlasKernelFamilyCount; Family++) {
+        Override.IsaLimit[Family] = MlasIsaMaximum;
+    }
+
+    if (Specification == nullptr) {
+        return true;
+    }
+
+    const std::string Entries(Specification);
+    size_t Start = 0;
+
+    while (Start <= Entries.size()) {
+
+        size_t End = Entries.find(',', Start);
+        if (End == std::string::npos) {
+            End = Entries.size();
+        }
+
+        std::string Entry = Entries.substr(Start, End - Start);
+        Entry.erase(std::remove(Entry.begin(), Entry.end(), ' '), Entry.end());
+        Start = End + 1;
+
+        if (Entry.empty()) {
+            continue;
+        }
+
+        const size_t Separator = Entry.find('=');
+        if (Separator == std::string::npos) {
+            return false;
+        }
+
+        const std::string FamilyName = Entry.substr(0, Separator);
+        const std::string IsaName = Entry.substr(Separator + 1);
+
+        const auto* IsaLevel = std::find_if(std::begin(MlasIsaLevelNames), std::end(MlasIsaLevelNames),
+                                            [&](const auto& Level) { return IsaName == Level.Name; });
+        if (IsaLevel == std::end(MlasIsaLevelNames)) {
+            return false;
+        }
+
+        bool Matched = false;
+
+        for (size_t Family = 0; Family < MlasKernelFamilyCount; Family++) {
+            if (FamilyName == "*" || FamilyName == MlasKernelFamilyNames[Family]) {
+                Override.IsaLimit[Family] = IsaLevel->Isa;
+                Matched = true;
+            }
+        }
+
+        if (!Matched) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static
+MLAS_DISPATCH_OVERRIDE
+MlasReadEnvironmentDispatchOverride(
+    void
+    )
+{
+    const char* Specification = nullptr;
+
+#if defined(_WIN32)
+    char Buffer[256];
+    DWORD Length = GetEnvironmentVariableA("MLAS_DISPATCH_OVERRIDE", Buffer, sizeof(Buffer));
+    if (Length > 0 && Length < sizeof(Buffer)) {
+        Specification = Buffer;
+    }
+#else
+    Specification = getenv("MLAS_DISPATCH_OVERRIDE");
+#endif
+
+    //
+    // A malformed specification is ignored, as there is no caller to report
+    // the error to while the library initializes.
+    //
+
+    MLAS_DISPATCH_OVERRIDE Override;
+
+    if (!MlasParseDispatchOverride(Specification, Override)) {
+        MlasParseDispatchOverride(nullptr, Override);
+    }
+
+    return Override;
+}
+
+MLAS_PLATFORM::MLAS_PLATFORM(
+    void
+    ) : MLAS_PLATFORM(MlasReadEnvironmentDispatchOverride())
+/*++
+
+Routine Description:
+
+    This routine initializes the platform support for this library.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    None.
+
+--*/
+{
+}
+
+MLAS_PLATFORM::MLAS_PLATFORM(
+    const MLAS_DISPATCH_OVERRIDE& Override
+    )
+/*++
+
+Routine Description:
+
+    This routine initializes the platform support for this library with the
+    instruction set of each kernel family limited by a dispatch override.
+
+Arguments:
+
+    Override - Supplies the instruction set limit of each kernel family.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_ISA_LEVEL IsaLimit = MlasIsaBaseline;
+
+    for (size_t Family = 0; Family < MlasKernelFamilyCount; Family++) {
+        IsaLimit = std::max(IsaLimit, Override.IsaLimit[Family]);
+    }
+
+    SelectKernels(IsaLimit);
+
+    //
+    // Replace the kernels of the families with a lower limit by the kernels
+    // selected for the whole platform at that limit.
+    //
+
+    for (size_t Family = 0; Family < MlasKernelFamilyCount; Family++) {
+
+        if (Override.IsaLimit[Family] < IsaLimit) {
+
+            MLAS_DISPATCH_OVERRIDE FamilyOverride;
+
+            for (size_t f = 0; f < MlasKernelFamilyCount; f++) {
+                FamilyOverride.IsaLimit[f] = Override.IsaLimit[Family];
+            }
+
+            const MLAS_PLATFORM Limited(FamilyOverride);
+
+            CopyKernelFamily(Limited, MLAS_KERNEL_FAMILY(Family));
+        }
+    }
+}
+
+void
+MLAS_PLATFORM::CopyKernelFamily(
+    const MLAS_PLATFORM& Source,
+    MLAS_KERNEL_FAMILY Family
+    )
+/*++
+
+Routine Description:
+
+    This routine copies the kernels of a family from another platform
+    configuration. The members of a family are copied together, as the
+    kernels of a family may share data layouts such as the NCHWc block size.
+
+Arguments:
+
+    Source - Supplies the platform configuration to copy from.
+
+    Family - Supplies the kernel family to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Family) {
+
+        case MlasKernelFamilySgemm:
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER)
+            this->GemmFloatKernel = Source.GemmFloatKernel;
+#endif
+#if defined(MLAS_TARGET_AMD64)
+            this->KernelM1Routine = Source.KernelM1Routine;
+            this->KernelM1TransposeBRoutine = Source.KernelM1TransposeBRoutine;
+            this->TransposePackB16x4Routine = Source.TransposePackB16x4Routine;
+#endif
+            break;
+
+        case MlasKernelFamilyDgemm:
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_POWER)
+            this->GemmDoubleKernel = Source.GemmDoubleKernel;
+#endif
+            break;
+
+        case MlasKernelFamilyQgemm:
+#if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_ARM64)
+            this->GemmU8S8Dispatch = Source.GemmU8S8Dispatch;
+            this->GemmU8U8Dispatch = Source.GemmU8U8Dispatch;
+#endif
+#if defined(MLAS_TARGET_ARM64)
+            this->GemmS8S8Dispatch = Source.GemmS8S8Dispatch;
+#endif
+#if defined(MLAS_TARGET_POWER)
+            this->GemmU8X8Dispatch = Source.GemmU8X8Dispatch;
+#endif
+#if defined(MLAS_TARGET_AMD64)
+            this->GemmU8S8Kernel = Source.GemmU8S8Kernel;
+            this->GemvU8S8Kernel = Source.GemvU8S8Kernel;
+            this->GemmU8U8Kernel = Source.GemmU8U8Kernel;
+#endif
+            this->SymmQgemmDispatch = Source.SymmQgemmDispatch;
+            this->ConvSymU8S8Dispatch = Source.ConvSymU8S8Dispatch;
+            this->ConvSymS8S8Dispatch = Source.ConvSymS8S8Dispatch;
+            break;
+
+        case MlasKernelFamilyConv:
+            this->ConvDepthwiseU8S8Kernel = Source.ConvDepthwiseU8S8Kernel;
+            this->ConvDepthwiseU8U8Kernel = Source.ConvDepthwiseU8U8Kernel;
+            this->ConvDepthwiseS8S8Kernel = Source.ConvDepthwiseS8S8Kernel;
+            this->ConvDepthwiseS8U8Kernel = Source.ConvDepthwiseS8U8Kernel;
+#if defined(MLAS_TARGET_AMD64)
+            this->ConvNchwFloatKernel = Source.ConvNchwFloatKernel;
+            this->ConvNchwcFloatKernel = Source.ConvNchwcFloatKernel;
+            this->ConvDepthwiseFloatKernel = Source.ConvDepthwiseFloatKernel;
+            this->ConvPointwiseFloatKernel = Source.ConvPointwiseFloatKernel;
+            for (size_t Kind = 0; Kind < MlasPoolingKindCount; Kind++) {
+                this->PoolFloatKernel[Kind] = Source.PoolFloatKernel[Kind];
+            }
+            this->NchwcBlockSize = Source.NchwcBlockSize;
+#endif
+            break;
+
+        case MlasKernelFamilyActivation:
+#if defined(MLAS_TARGET_AMD64)
+            this->ComputeExpF32Kernel = Source.ComputeExpF32Kernel;
+            this->LogisticKernelRoutine = Source.LogisticKernelRoutine;
+            this->TanhKernelRoutine = Source.TanhKernelRoutine;
+            this->ErfKernelRoutine = Source.ErfKernelRoutine;
+            this->ComputeSumExpF32Kernel = Source.ComputeSumExpF32Kernel;
+            this->ComputeSoftmaxOutputF32Kernel = Source.ComputeSoftmaxOutputF32Kernel;
+            this->ComputeLogSoftmaxOutputF32Kernel = Source.ComputeLogSoftmaxOutputF32Kernel;
+            this->ReduceMaximumF32Kernel = Source.ReduceMaximumF32Kernel;
+            this->ReduceMinimumMaximumF32Kernel = Source.ReduceMinimumMaximumF32Kernel;
+#endif
+            break;
+
+        case MlasKernelFamilyReduce:
+#if defined(MLAS_TARGET_AMD64)
+            this->ReduceRowsF32Kernel = Source.ReduceRowsF32Kernel;
+            this->ReduceColumnsF32Kernel = Source.ReduceColumnsF32Kernel;
+            this->LayerNormF32Kernel = Source.LayerNormF32Kernel;
+#endif
+            break;
+
+        case MlasKernelFamilyQuantize:
+#if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_POWER)
+            this->QuantizeLinearS8Kernel = Source.QuantizeLinearS8Kernel;
+            this->QuantizeLinearU8Kernel = Source.QuantizeLinearU8Kernel;
+#endif
+#if defined(MLAS_TARGET_AMD64)
+            this->QLinearAddS8Kernel = Source.QLinearAddS8Kernel;
+            this->QLinearAddU8Kernel = Source.QLinearAddU8Kernel;
+#endif
+            break;
+
+        case MlasKernelFamilyHalfGemm:
+            this->HalfGemmDispatch = Source.HalfGemmDispatch;
+            break;
+
+        case MlasKernelFamilyBf16Gemm:
+            this->Bf16GemmDispatch = Source.Bf16GemmDispatch;
+            break;
+
+        case MlasKernelFamilyQ4Gemm:
+            this->FpQ4GemmDispatch = Source.FpQ4GemmDispatch;
+            this->Q8Q4GemmDispatch = Source.Q8Q4GemmDispatch;
+            break;
+
+        case MlasKernelFamilyCast:
+#if defined(MLAS_TARGET_AMD64)
+            this->CastF16ToF32Kernel = Source.CastF16ToF32Kernel;
+            this->CastF32ToF16Kernel = Source.CastF32ToF16Kernel;
+#endif
+            break;
+
+        case MlasKernelFamilyTree:
+#if defined(MLAS_TARGET_AMD64)
+            this->TreeTraverseKernel = Source.TreeTraverseKernel;
+#endif
+            break;
+
+        default:
+            return;
+    }
+
+    this->KernelFamilyIsa[Family] = Source.KernelFamilyIsa[Family];
+}
+
+const char*
+MLASCALL
+MlasGetKernelFamilyName(
+    MLAS_KERNEL_FAMILY Family
+    )
+{
+    if (size_t(Family) >= MlasKernelFamilyCount) {
+        return "unknown";
+    }
+
+    return MlasKernelFamilyNames[Family];
+}
+
+const char*
+MLASCALL
+MlasGetKernelFamilyIsa(
+    MLAS_KERNEL_FAMILY Family
+    )
+{
+    if (size_t(Family) >= MlasKernelFamilyCount) {
+        return "unknown";
+    }
+
+    const auto& Platform = GetMlasPlatform();
+
+    bool Supported = true;
+
+    switch (Family) {
+        case MlasKernelFamilyHalfGemm:
+            Supported = MlasFp16AccelerationSupported();
+            break;
+        case MlasKernelFamilyBf16Gemm:
+            Supported = (Platform.Bf16GemmDispatch != nullptr);
+            break;
+        case MlasKernelFamilyQ4Gemm:
+            Supported = (Platform.FpQ4GemmDispatch != nullptr || Platform.Q8Q4GemmDispatch != nullptr);
+            break;
+        default:
+            break;
+    }
+
+    if (Supported) {
+        for (const auto& Level : MlasIsaLevelNames) {
+            if (Level.Isa == Platform.KernelFamilyIsa[Family]) {
+                return Level.Name;
+            }
+        }
+    }
+
+    return "none";
+}
+
+bool
+MLASCALL
+MlasSetKernelDispatchOverride(
+    const char* Specification
+    )
+{
+    MLAS_DISPATCH_OVERRIDE Override;
+
+    if (!MlasParseDispatchOverride(Specification, Override)) {
+        return false;
+    }
+
+    GetMlasPlatform() = MLAS_PLATFORM(Override);
+
+    return true;
+}
+
 size_t
 MLASCALL
 MlasGetPreferredBufferAlignment(
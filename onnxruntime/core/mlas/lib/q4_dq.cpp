@@ -192,6 +192,97 @@ MlasQ4GemmPackB(
     }
 }
 
+template<typename T>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmPackBQuantizedImpl(
+    void* PackedBuf,
+    const uint8_t* QuantData,
+    const float* Scales,
+    const uint8_t* ZeroPoints,
+    size_t N,
+    size_t K,
+    size_t BlockSize
+    )
+{
+    auto* dst_ptr = reinterpret_cast<uint8_t*>(PackedBuf);
+    const size_t BlockCountK = MlasDivRoundup(K, BlockSize);
+
+    for (size_t n = 0; n < N; n++) {
+        const uint8_t* src = QuantData + n * BlockCountK * (BlockSize / 2);
+
+        for (size_t k = 0; k < K; k += T::BlkLen) {
+            //
+            // The block length of T divides BlockSize, so a block of T
+            // takes the parameters of a single source block.
+            //
+            const size_t block_idx = n * BlockCountK + k / BlockSize;
+            uint8_t zp = 8;
+            if (ZeroPoints != nullptr) {
+                zp = ZeroPoints[block_idx / 2];
+                zp = (block_idx & 1) ? (zp >> 4) : (zp & 0x0F);
+            }
+
+            MlasQ4BlkScale<T>(dst_ptr) = Scales[block_idx];
+            if constexpr (std::is_same_v<T, MLAS_Q4TYPE_BLK1>) {
+                MlasQ4BlkZeroPoint<T>(dst_ptr) = zp;
+            }
+            uint8_t* data = MlasQ4BlkData<T>(dst_ptr);
+
+            //
+            // The source holds consecutive values in the low and high
+            // nibbles of a byte, while a packed sub block of 32 values
+            // holds value l and value l + 16 in byte l. Values past K are
+            // padded with the zero point.
+            //
+            const size_t klen = std::min(size_t(T::BlkLen), K - k);
+            for (size_t kk = 0; kk < T::BlkLen; kk += 32) {
+                for (size_t l = 0; l < 16; l++) {
+                    const size_t k0 = k + kk + l;
+                    const size_t k1 = k0 + 16;
+                    const uint8_t vi0 = (kk + l < klen)
+                        ? (src[k0 / 2] >> ((k0 & 1) * 4)) & 0x0F : zp;
+                    const uint8_t vi1 = (kk + l + 16 < klen)
+                        ? (src[k1 / 2] >> ((k1 & 1) * 4)) & 0x0F : zp;
+                    data[l] = vi0 | (vi1 << 4);
+                }
+                data += 16;
+            }
+
+            dst_ptr += T::BlobSize;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmPackBQuantized(
+    MLAS_BLK_QUANT_TYPE QType,
+    void* PackedBuf,
+    const uint8_t* QuantData,
+    const float* Scales,
+    const uint8_t* ZeroPoints,
+    size_t N,
+    size_t K,
+    size_t BlockSize
+    )
+{
+    switch (QType) {
+        case BlkQ4Sym:
+            return MlasQ4GemmPackBQuantizedImpl<MLAS_Q4TYPE_BLK0>(
+                PackedBuf, QuantData, Scales, nullptr, N, K, BlockSize);
+        case BlkQ4Sym64:
+            return MlasQ4GemmPackBQuantizedImpl<MLAS_Q4TYPE_BLK2>(
+                PackedBuf, QuantData, Scales, nullptr, N, K, BlockSize);
+        case BlkQ4Sym128:
+            return MlasQ4GemmPackBQuantizedImpl<MLAS_Q4TYPE_BLK4>(
+                PackedBuf, QuantData, Scales, nullptr, N, K, BlockSize);
+        default:
+            return MlasQ4GemmPackBQuantizedImpl<MLAS_Q4TYPE_BLK1>(
+                PackedBuf, QuantData, Scales, ZeroPoints, N, K, BlockSize);
+    }
+}
+
 template<typename T>
 MLAS_FORCEINLINE
 void
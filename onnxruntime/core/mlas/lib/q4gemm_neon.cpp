@@ -0,0 +1,557 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_neon.cpp
+
+Abstract:
+
+    This module implements the fp32 matrix multiplication with compressed
+    weight tensor (right hand side) using ARM64 NEON, and the int8 x int4
+    GEMM using the baseline NEON multiply accumulate instructions.
+
+--*/
+
+#include "q4gemm_neon.h"
+
+struct MLAS_FP_Q4_GEMM_KERNEL_NEON {
+    static constexpr size_t StrideM = 256;
+};
+
+struct MLAS_Q8Q4_GEMM_KERNEL_NEON {
+    static constexpr size_t StrideM = 256;
+
+    static
+    MLAS_FORCEINLINE
+    int32x4_t
+    DotProduct(int32x4_t Accumulator, int8x16_t A, int8x16_t B)
+    {
+        // The int4 values are in [-15, 15], so each pair of products fits
+        // in 16 bits.
+        int16x8_t Products = vmull_s8(vget_low_s8(A), vget_low_s8(B));
+        Products = vmlal_high_s8(Products, A, B);
+        return vpadalq_s16(Accumulator, Products);
+    }
+};
+
+/**
+ * @brief Convert 16 signed bytes to 4 vectors of floats.
+ */
+MLAS_FORCEINLINE
+void
+MlasQ4ConvertToFloatNeon(int8x16_t Values, float32x4_t Floats[4])
+{
+    const int16x8_t Values16Low = vmovl_s8(vget_low_s8(Values));
+    const int16x8_t Values16High = vmovl_high_s8(Values);
+
+    Floats[0] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(Values16Low)));
+    Floats[1] = vcvtq_f32_s32(vmovl_high_s16(Values16Low));
+    Floats[2] = vcvtq_f32_s32(vmovl_s16(vget_low_s16(Values16High)));
+    Floats[3] = vcvtq_f32_s32(vmovl_high_s16(Values16High));
+}
+
+/**
+ * @brief Compute NCols consecutive outputs of one row of C with fp32 A.
+ */
+template<typename Q4Type, size_t NCols>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmRowNeon(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountK,
+    size_t ldb,
+    const float* Bias
+    )
+{
+    float32x4_t acc[NCols];
+    for (size_t nn = 0; nn < NCols; nn++) {
+        acc[nn] = vdupq_n_f32(0.0f);
+    }
+
+    const uint8_t* b = PackedB;
+
+    for (size_t k = 0; k < CountK; k += Q4Type::BlkLen) {
+        const size_t ck = std::min(CountK - k, Q4Type::BlkLen);
+
+        float scale_v[NCols];
+        int8x16_t zp_v[NCols];
+        const uint8_t* b_ptr[NCols];
+        float32x4_t blk_acc[NCols];
+        for (size_t nn = 0; nn < NCols; nn++) {
+            const uint8_t* bb = b + ldb * nn;
+            scale_v[nn] = MlasQ4BlkScale<Q4Type>(bb);
+            zp_v[nn] = MlasQ4BlkZeroPointNeon<Q4Type>(bb);
+            b_ptr[nn] = MlasQ4BlkData<Q4Type>(bb);
+            blk_acc[nn] = vdupq_n_f32(0.0f);
+        }
+
+        for (size_t kk = 0; kk < ck; kk += MLAS_QUANT4_BLK_UNIT) {
+            const size_t kklen = std::min((size_t)MLAS_QUANT4_BLK_UNIT, ck - kk);
+
+            // Load A row vectors, zero padding a partial unit.
+            const float* a = A + k + kk;
+            float padded[MLAS_QUANT4_BLK_UNIT];
+            if (kklen < MLAS_QUANT4_BLK_UNIT) {
+                std::memcpy(padded, a, kklen * sizeof(float));
+                std::memset(padded + kklen, 0, (MLAS_QUANT4_BLK_UNIT - kklen) * sizeof(float));
+                a = padded;
+            }
+
+            float32x4_t av[8];
+            for (size_t i = 0; i < 8; i++) {
+                av[i] = vld1q_f32(a + i * 4);
+            }
+
+            for (size_t nn = 0; nn < NCols; nn++) {
+                int8x16_t b_lo;
+                int8x16_t b_hi;
+                MlasQ4UnpackUnitNeon(b_ptr[nn], zp_v[nn], b_lo, b_hi);
+                b_ptr[nn] += MLAS_QUANT4_BLK_UNIT / 2;
+
+                float32x4_t bvf[4];
+                MlasQ4ConvertToFloatNeon(b_lo, bvf);
+                for (size_t i = 0; i < 4; i++) {
+                    blk_acc[nn] = vfmaq_f32(blk_acc[nn], bvf[i], av[i]);
+                }
+                MlasQ4ConvertToFloatNeon(b_hi, bvf);
+                for (size_t i = 0; i < 4; i++) {
+                    blk_acc[nn] = vfmaq_f32(blk_acc[nn], bvf[i], av[i + 4]);
+                }
+            }
+        }
+
+        // Apply the scale of the block once.
+        for (size_t nn = 0; nn < NCols; nn++) {
+            acc[nn] = vfmaq_n_f32(acc[nn], blk_acc[nn], scale_v[nn]);
+        }
+
+        b += Q4Type::BlobSize;
+    }
+
+    for (size_t nn = 0; nn < NCols; nn++) {
+        C[nn] = vaddvq_f32(acc[nn]) + ((Bias == nullptr) ? 0.0f : Bias[nn]);
+    }
+}
+
+template<typename Q4Type>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernelNeon(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    // We process 32 quantized values in a batch.
+    static_assert(MLAS_QUANT4_BLK_UNIT == 32);
+    static_assert(Q4Type::BlkLen % MLAS_QUANT4_BLK_UNIT == 0);
+
+    for (size_t m = 0; m < CountM; m++) {
+        const uint8_t* b_col = PackedB;
+        float* sum_ptr = C;
+        const float* bias_ptr = Bias;
+
+        size_t n = 0;
+        for (; n + 4 <= CountN; n += 4) {
+            MlasQ4GemmRowNeon<Q4Type, 4>(A, b_col, sum_ptr, CountK, ldb, bias_ptr);
+            b_col += 4 * ldb;
+            sum_ptr += 4;
+            bias_ptr = (Bias == nullptr) ? nullptr : bias_ptr + 4;
+        }
+
+        // left over columns less than 4 ?
+        for (; n < CountN; n++) {
+            MlasQ4GemmRowNeon<Q4Type, 1>(A, b_col, sum_ptr, CountK, ldb, bias_ptr);
+            b_col += ldb;
+            sum_ptr += 1;
+            bias_ptr = (Bias == nullptr) ? nullptr : bias_ptr + 1;
+        }
+
+        // Prepare pointers for the next row
+        C += ldc;
+        A += lda;
+    }
+    return CountM;
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK1, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelNeon<MLAS_Q4TYPE_BLK1>(A, PackedB, C, CountM, CountN, CountK, lda,
+                                                  ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK2, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelNeon<MLAS_Q4TYPE_BLK2>(A, PackedB, C, CountM, CountN, CountK, lda,
+                                                  ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK4, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelNeon<MLAS_Q4TYPE_BLK4>(A, PackedB, C, CountM, CountN, CountK, lda,
+                                                  ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmKernel<MLAS_Q4TYPE_BLK0, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ4GemmKernelNeon<MLAS_Q4TYPE_BLK0>(A, PackedB, C, CountM, CountN, CountK, lda,
+                                                  ldb, ldc, Bias);
+}
+
+/**
+ * @brief Transpose 4 vectors of 4 values of consecutive k of 4 columns
+ *        and store the rows of k that are in range to the packed buffer.
+ */
+MLAS_FORCEINLINE
+void
+MlasQ4StoreTransposed4x4Neon(
+    float* FpData,
+    float32x4_t v0,
+    float32x4_t v1,
+    float32x4_t v2,
+    float32x4_t v3,
+    size_t RowCount
+    )
+{
+    const float32x4_t t01lo = vtrn1q_f32(v0, v1);
+    const float32x4_t t01hi = vtrn2q_f32(v0, v1);
+    const float32x4_t t23lo = vtrn1q_f32(v2, v3);
+    const float32x4_t t23hi = vtrn2q_f32(v2, v3);
+
+    float32x4_t rows[4];
+    rows[0] = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t01lo), vreinterpretq_f64_f32(t23lo)));
+    rows[1] = vreinterpretq_f32_f64(vtrn1q_f64(vreinterpretq_f64_f32(t01hi), vreinterpretq_f64_f32(t23hi)));
+    rows[2] = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t01lo), vreinterpretq_f64_f32(t23lo)));
+    rows[3] = vreinterpretq_f32_f64(vtrn2q_f64(vreinterpretq_f64_f32(t01hi), vreinterpretq_f64_f32(t23hi)));
+
+    for (size_t r = 0; r < std::min(RowCount, size_t(4)); r++) {
+        vst1q_f32(FpData + r * 16, rows[r]);
+    }
+}
+
+/**
+ * @brief Dequantize B into the 16 column panels of the SGEMM packing
+ *        layout, so that the SGEMM kernel can be used for larger M.
+ */
+template <typename Q4Type>
+MLAS_FORCEINLINE
+void
+BlkQ4DequantBNeon(
+    float* FpData, const uint8_t* PackedB, size_t CountN, size_t CountK, size_t ldb)
+{
+    for (size_t n = 0; n < CountN; n += 16) {
+        const size_t panel_n = std::min(CountN - n, size_t(16));
+        const uint8_t* b = PackedB + n * ldb;
+        float* panel = FpData;
+
+        for (size_t k = 0; k < CountK; k += Q4Type::BlkLen) {
+            const size_t ck = std::min(CountK - k, Q4Type::BlkLen);
+
+            for (size_t kk = 0; kk < ck; kk += MLAS_QUANT4_BLK_UNIT) {
+                const size_t kklen = std::min((size_t)MLAS_QUANT4_BLK_UNIT, ck - kk);
+                float* dst = panel + (k + kk) * 16;
+
+                // Each group of 4 columns is transposed into the panel.
+                for (size_t nn = 0; nn < 16; nn += 4) {
+                    float32x4_t bvf[4][8];
+
+                    for (size_t c = 0; c < 4; c++) {
+                        if (nn + c >= panel_n) {
+                            for (size_t i = 0; i < 8; i++) {
+                                bvf[c][i] = vdupq_n_f32(0.0f);
+                            }
+                            continue;
+                        }
+
+                        const uint8_t* bb = b + ldb * (nn + c) + (k / Q4Type::BlkLen) * Q4Type::BlobSize;
+                        const float32x4_t s = vdupq_n_f32(MlasQ4BlkScale<Q4Type>(bb));
+
+                        int8x16_t b_lo;
+                        int8x16_t b_hi;
+                        MlasQ4UnpackUnitNeon(MlasQ4BlkData<Q4Type>(bb) + kk / 2,
+                                             MlasQ4BlkZeroPointNeon<Q4Type>(bb), b_lo, b_hi);
+
+                        MlasQ4ConvertToFloatNeon(b_lo, &bvf[c][0]);
+                        MlasQ4ConvertToFloatNeon(b_hi, &bvf[c][4]);
+                        for (size_t i = 0; i < 8; i++) {
+                            bvf[c][i] = vmulq_f32(bvf[c][i], s);
+                        }
+                    }
+
+                    for (size_t i = 0; i < 8 && i * 4 < kklen; i++) {
+                        MlasQ4StoreTransposed4x4Neon(dst + i * 4 * 16 + nn, bvf[0][i], bvf[1][i],
+                                                     bvf[2][i], bvf[3][i], kklen - i * 4);
+                    }
+                }
+            }
+        }
+
+        FpData += 16 * CountK;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE void
+MlasBlkQ4DequantB<MLAS_Q4TYPE_BLK0, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    float* FpData, const uint8_t* PackedB, size_t CountN, size_t CountK, size_t ldb)
+{
+    BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK0>(FpData, PackedB, CountN, CountK, ldb);
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasBlkQ4DequantB<MLAS_Q4TYPE_BLK1, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    float* FpData, const uint8_t* PackedB, size_t CountN, size_t CountK, size_t ldb)
+{
+    BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK1>(FpData, PackedB, CountN, CountK, ldb);
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasBlkQ4DequantB<MLAS_Q4TYPE_BLK2, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    float* FpData, const uint8_t* PackedB, size_t CountN, size_t CountK, size_t ldb)
+{
+    BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK2>(FpData, PackedB, CountN, CountK, ldb);
+}
+
+template <>
+MLAS_FORCEINLINE void
+MlasBlkQ4DequantB<MLAS_Q4TYPE_BLK4, MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    float* FpData, const uint8_t* PackedB, size_t CountN, size_t CountK, size_t ldb)
+{
+    BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK4>(FpData, PackedB, CountN, CountK, ldb);
+}
+
+/**
+ * @brief For testing purpose,
+ *        Dequantize the data intp fp32, and then pack them for use
+ *        in sgemm kernel. equivalent to MlasQ4GemmUnPackB and then
+ *        MlasSgemmCopyPackB
+ */
+void
+MlasBlkQ4DequantSgemmPackB(
+    MLAS_BLK_QUANT_TYPE QType,
+    float* FpData,
+    const uint8_t* PackedB,
+    size_t CountN,
+    size_t CountK,
+    size_t ldb)
+{
+    switch (QType) {
+        case BlkQ4Zp8:
+            return BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK1>(FpData, PackedB, CountN, CountK, ldb);
+        case BlkQ4Sym64:
+            return BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK2>(FpData, PackedB, CountN, CountK, ldb);
+        case BlkQ4Sym128:
+            return BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK4>(FpData, PackedB, CountN, CountK, ldb);
+        default:
+            return BlkQ4DequantBNeon<MLAS_Q4TYPE_BLK0>(FpData, PackedB, CountN, CountK, ldb);
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+AddBiasAvx<MLAS_FP_Q4_GEMM_KERNEL_NEON>(
+    const float* Bias,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+{
+    for (size_t m = 0; m < CountM; m++) {
+        size_t n = 0;
+        for (; n + 4 <= CountN; n += 4) {
+            vst1q_f32(C + n, vaddq_f32(vld1q_f32(C + n), vld1q_f32(Bias + n)));
+        }
+        for (; n < CountN; n++) {
+            C[n] += Bias[n];
+        }
+        C += ldc;
+    }
+}
+
+
+static MLAS_Q4GEMM_OPERATION* Q4Operations_neon[] = {
+    MlasQ4GemmOperation<MLAS_Q4TYPE_BLK0, MLAS_FP_Q4_GEMM_KERNEL_NEON>,
+    MlasQ4GemmOperation<MLAS_Q4TYPE_BLK1, MLAS_FP_Q4_GEMM_KERNEL_NEON>,
+    MlasQ4GemmOperation<MLAS_Q4TYPE_BLK2, MLAS_FP_Q4_GEMM_KERNEL_NEON>,
+    nullptr,
+    MlasQ4GemmOperation<MLAS_Q4TYPE_BLK4, MLAS_FP_Q4_GEMM_KERNEL_NEON>
+};
+
+const MLAS_FPQ4GEMM_DISPATCH MlasFpQ4GemmDispatchNeon = {
+    Q4Operations_neon
+};
+
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK1, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK1, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK0, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK0, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK2, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK2, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK4, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK4, MLAS_Q8Q4_GEMM_KERNEL_NEON>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+static MLAS_Q80_BLKQUANT* Q80Quant_neon[] = {
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK0>,
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK1>,
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK2>,
+    nullptr,
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK4>
+};
+
+static MLAS_Q8Q4GEMM_OPERATION* Q8Q4Operations_neon[] = {
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK0, MLAS_Q8Q4_GEMM_KERNEL_NEON>,
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK1, MLAS_Q8Q4_GEMM_KERNEL_NEON>,
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK2, MLAS_Q8Q4_GEMM_KERNEL_NEON>,
+    nullptr,
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK4, MLAS_Q8Q4_GEMM_KERNEL_NEON>
+};
+
+const MLAS_Q8Q4GEMM_DISPATCH MlasQ8Q4GemmDispatchNeon = {
+    Q80Quant_neon,
+    Q8Q4Operations_neon
+};
@@ -0,0 +1,256 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_neon.h
+
+Abstract:
+
+    This module implements the int8 activation quantization and the int8 x
+    int4 block GEMM kernels for ARM64 NEON. The dot product of a block is
+    supplied by the kernel type, so that the same kernels are built for the
+    baseline NEON instructions and for the SDOT instructions.
+
+    The kernels read the blobs written by MlasQ4GemmPackB: each column of B
+    is a sequence of blocks, and each 32 value unit of a block packs value
+    i in the low nibble and value i + 16 in the high nibble of byte i.
+
+--*/
+
+#pragma once
+
+#include "q4gemm.h"
+
+#include <arm_neon.h>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief Broadcast the zero point of a block of B.
+ */
+template <typename Q4Type>
+MLAS_FORCEINLINE
+int8x16_t
+MlasQ4BlkZeroPointNeon(const uint8_t* BlkPtr)
+{
+    if constexpr (std::is_same_v<Q4Type, MLAS_Q4TYPE_BLK1>) {
+        return vdupq_n_s8(int8_t(MlasQ4BlkZeroPoint<MLAS_Q4TYPE_BLK1>(BlkPtr)));
+    } else {
+        return vdupq_n_s8(8);
+    }
+}
+
+/**
+ * @brief Expand a 32 value unit of B to signed bytes: values 0 to 15 to
+ *        ValuesLow, values 16 to 31 to ValuesHigh.
+ */
+MLAS_FORCEINLINE
+void
+MlasQ4UnpackUnitNeon(
+    const uint8_t* Data,
+    int8x16_t ZeroPoint,
+    int8x16_t& ValuesLow,
+    int8x16_t& ValuesHigh
+    )
+{
+    const uint8x16_t Packed = vld1q_u8(Data);
+
+    ValuesLow = vsubq_s8(vreinterpretq_s8_u8(vandq_u8(Packed, vdupq_n_u8(0x0F))), ZeroPoint);
+    ValuesHigh = vsubq_s8(vreinterpretq_s8_u8(vshrq_n_u8(Packed, 4)), ZeroPoint);
+}
+
+////////////////////////////////////////////////////////////
+//  Block int8 quantization, currently we only
+//  implement symmetric quant, with no zero-point
+
+template <typename QType>
+MLAS_FORCEINLINE
+void
+MlasQ80BlkQuantRowNeon(const float* A, void* Qblob, size_t size)
+{
+    static_assert(QType::BlkLen % 16 == 0);
+    int8_t* blob = reinterpret_cast<int8_t*>(Qblob);
+
+    for (size_t k = 0; k < size; k += QType::BlkLen) {
+        const size_t step = std::min(QType::BlkLen, size - k);
+        const float* a = A + k;
+
+        // Copy a partial block so that whole vectors can be loaded.
+        float padded[QType::BlkLen];
+        if (step < QType::BlkLen) {
+            std::memcpy(padded, a, step * sizeof(float));
+            std::memset(padded + step, 0, (QType::BlkLen - step) * sizeof(float));
+            a = padded;
+        }
+
+        // Compute max(abs(e)) for the block
+        float32x4_t maxAbs = vdupq_n_f32(0.0f);
+        for (size_t kk = 0; kk < QType::BlkLen; kk += 4) {
+            maxAbs = vmaxq_f32(maxAbs, vabsq_f32(vld1q_f32(a + kk)));
+        }
+        const float maxScalar = vmaxvq_f32(maxAbs);
+
+        // Quantize these floats
+        const float scale = maxScalar / 127.f;
+        *reinterpret_cast<float*>(blob) = scale;
+        blob += sizeof(float);
+
+        const float inverse_scale = (maxScalar != 0.0f) ? 127.f / maxScalar : 0.0f;
+
+        for (size_t kk = 0; kk < QType::BlkLen; kk += 16) {
+            // Round to nearest integer and narrow to int8
+            const int32x4_t i0 = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(a + kk), inverse_scale));
+            const int32x4_t i1 = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(a + kk + 4), inverse_scale));
+            const int32x4_t i2 = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(a + kk + 8), inverse_scale));
+            const int32x4_t i3 = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(a + kk + 12), inverse_scale));
+
+            const int16x8_t s01 = vcombine_s16(vqmovn_s32(i0), vqmovn_s32(i1));
+            const int16x8_t s23 = vcombine_s16(vqmovn_s32(i2), vqmovn_s32(i3));
+            vst1q_s8(blob + kk, vcombine_s8(vqmovn_s16(s01), vqmovn_s16(s23)));
+        }
+        blob += QType::BlkLen;
+    }
+}
+
+template<typename QType>
+void
+Q80BlkQuantNeon(void* Qblob, const float* A, size_t M, size_t K, size_t lda, MLAS_THREADPOOL* ThreadPool)
+{
+    const size_t parts = (size_t)ceil(double(M) * K / (16.0 * 1024));
+    const size_t TargetThreadCnt =
+        std::max(std::min(parts, (size_t)MlasGetMaximumThreadCount(ThreadPool)), (size_t)1);
+    const size_t linesize = MlasQ80BlkQuantSizeImpl<QType>(1, K);
+
+    size_t M_stride = MlasDivRoundup(M, TargetThreadCnt);
+    size_t threads = MlasDivRoundup(M, M_stride);
+    MlasTrySimpleParallel(ThreadPool, threads, [&](ptrdiff_t tid) {
+        const size_t m = tid * M_stride;
+        const float* src = A + lda * m;
+        uint8_t* dst = reinterpret_cast<uint8_t*>(Qblob) + m * linesize;
+        for (size_t i = 0; i < std::min(M_stride, M-m); i++) {
+            MlasQ80BlkQuantRowNeon<QType>(src, dst, K);
+            src += lda;
+            dst += linesize;
+        }
+    });
+}
+
+/**
+ * @brief Compute NCols consecutive outputs of one row of C.
+ */
+template<typename Q4Type, typename KERNEL, size_t NCols>
+MLAS_FORCEINLINE
+void
+MlasQ8Q4GemmRowNeon(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountK,
+    size_t ldb,
+    const float* Bias
+    )
+{
+    float32x4_t acc[NCols];
+    for (size_t nn = 0; nn < NCols; nn++) {
+        acc[nn] = vdupq_n_f32(0.0f);
+    }
+
+    const int8_t* ablob = QuantA;
+    const uint8_t* b = PackedB;
+
+    for (size_t k = 0; k < CountK; k += Q4Type::BlkLen) {
+        const float a_scale = *reinterpret_cast<const float*>(ablob);
+        ablob += sizeof(float);
+
+        float scale_v[NCols];
+        int8x16_t zp_v[NCols];
+        const uint8_t* b_ptr[NCols];
+        int32x4_t iacc[NCols];
+        for (size_t nn = 0; nn < NCols; nn++) {
+            const uint8_t* bb = b + ldb * nn;
+            scale_v[nn] = MlasQ4BlkScale<Q4Type>(bb) * a_scale;
+            zp_v[nn] = MlasQ4BlkZeroPointNeon<Q4Type>(bb);
+            b_ptr[nn] = MlasQ4BlkData<Q4Type>(bb);
+            iacc[nn] = vdupq_n_s32(0);
+        }
+
+        // The quantized A is zero padded to whole blocks.
+        for (size_t kk = 0; kk < Q4Type::BlkLen; kk += MLAS_QUANT4_BLK_UNIT) {
+            const int8x16_t a_lo = vld1q_s8(ablob);
+            const int8x16_t a_hi = vld1q_s8(ablob + 16);
+            ablob += MLAS_QUANT4_BLK_UNIT;
+
+            for (size_t nn = 0; nn < NCols; nn++) {
+                int8x16_t b_lo;
+                int8x16_t b_hi;
+                MlasQ4UnpackUnitNeon(b_ptr[nn], zp_v[nn], b_lo, b_hi);
+                b_ptr[nn] += MLAS_QUANT4_BLK_UNIT / 2;
+
+                iacc[nn] = KERNEL::DotProduct(iacc[nn], a_lo, b_lo);
+                iacc[nn] = KERNEL::DotProduct(iacc[nn], a_hi, b_hi);
+            }
+        }
+
+        for (size_t nn = 0; nn < NCols; nn++) {
+            acc[nn] = vfmaq_n_f32(acc[nn], vcvtq_f32_s32(iacc[nn]), scale_v[nn]);
+        }
+
+        b += Q4Type::BlobSize;
+    }
+
+    for (size_t nn = 0; nn < NCols; nn++) {
+        C[nn] = vaddvq_f32(acc[nn]) + ((Bias == nullptr) ? 0.0f : Bias[nn]);
+    }
+}
+
+template<typename Q4Type, typename KERNEL>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernelNeon(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    // We process 32 quantized values in a batch.
+    static_assert(MLAS_QUANT4_BLK_UNIT == 32);
+    static_assert(Q4Type::BlkLen % MLAS_QUANT4_BLK_UNIT == 0);
+
+    for (size_t m = 0; m < CountM; m++) {
+        const uint8_t* b_col = PackedB;
+        float* sum_ptr = C;
+        const float* bias_ptr = Bias;
+
+        size_t n = 0;
+        for (; n + 4 <= CountN; n += 4) {
+            MlasQ8Q4GemmRowNeon<Q4Type, KERNEL, 4>(QuantA, b_col, sum_ptr, CountK, ldb, bias_ptr);
+            b_col += 4 * ldb;
+            sum_ptr += 4;
+            bias_ptr = (Bias == nullptr) ? nullptr : bias_ptr + 4;
+        }
+
+        // left over columns less than 4 ?
+        for (; n < CountN; n++) {
+            MlasQ8Q4GemmRowNeon<Q4Type, KERNEL, 1>(QuantA, b_col, sum_ptr, CountK, ldb, bias_ptr);
+            b_col += ldb;
+            sum_ptr += 1;
+            bias_ptr = (Bias == nullptr) ? nullptr : bias_ptr + 1;
+        }
+
+        // Prepare pointers for the next row
+        C += ldc;
+        QuantA += lda;
+    }
+    return CountM;
+}
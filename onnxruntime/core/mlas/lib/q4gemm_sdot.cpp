@@ -0,0 +1,131 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_sdot.cpp
+
+Abstract:
+
+    This module implements the int8 x int4 block GEMM using the ARM64 SDOT
+    instructions.
+
+--*/
+
+#include "q4gemm_neon.h"
+
+struct MLAS_Q8Q4_GEMM_KERNEL_SDOT {
+    static constexpr size_t StrideM = 256;
+
+    static
+    MLAS_FORCEINLINE
+    int32x4_t
+    DotProduct(int32x4_t Accumulator, int8x16_t A, int8x16_t B)
+    {
+        return vdotq_s32(Accumulator, A, B);
+    }
+};
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK1, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK1, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK0, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK0, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK2, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK2, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+template<>
+MLAS_FORCEINLINE
+size_t
+MlasQ8Q4GemmKernel<MLAS_Q4TYPE_BLK4, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+    const int8_t* QuantA,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    const float* Bias
+    )
+{
+    return MlasQ8Q4GemmKernelNeon<MLAS_Q4TYPE_BLK4, MLAS_Q8Q4_GEMM_KERNEL_SDOT>(
+        QuantA, PackedB, C, CountM, CountN, CountK, lda, ldb, ldc, Bias);
+}
+
+static MLAS_Q80_BLKQUANT* Q80Quant_sdot[] = {
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK0>,
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK1>,
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK2>,
+    nullptr,
+    Q80BlkQuantNeon<MLAS_Q4TYPE_BLK4>
+};
+
+static MLAS_Q8Q4GEMM_OPERATION* Q8Q4Operations_sdot[] = {
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK0, MLAS_Q8Q4_GEMM_KERNEL_SDOT>,
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK1, MLAS_Q8Q4_GEMM_KERNEL_SDOT>,
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK2, MLAS_Q8Q4_GEMM_KERNEL_SDOT>,
+    nullptr,
+    MlasQ8Q4GemmOperation<MLAS_Q4TYPE_BLK4, MLAS_Q8Q4_GEMM_KERNEL_SDOT>
+};
+
+const MLAS_Q8Q4GEMM_DISPATCH MlasQ8Q4GemmDispatchSdot = {
+    Q80Quant_sdot,
+    Q8Q4Operations_sdot
+};
@@ -0,0 +1,135 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements the single precision reductions over the rows or
+    the columns of a matrix, which the reduction operators and the
+    normalizations compute for each of their fast reduce layouts.
+
+--*/
+
+#include "reduce.h"
+
+void
+MLASCALL
+MlasReduceRowsF32Kernel(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to reduce each row of a
+    matrix to one value.
+
+Arguments:
+
+    Kind - Supplies the reduction.
+
+    Input - Supplies the input matrix.
+
+    ldInput - Supplies the first dimension of the input matrix.
+
+    Output - Supplies the output vector.
+
+    Rows - Supplies the number of rows of the input matrix.
+
+    RowLength - Supplies the number of elements reduced per row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasReduceRowsKernelDispatch<MLAS_REDUCE_VECTOR_OPS_FLOAT32X4>(Kind, Input, ldInput, Output, Rows, RowLength);
+}
+
+void
+MLASCALL
+MlasReduceColumnsF32Kernel(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel to reduce the rows of a
+    matrix to one row.
+
+Arguments:
+
+    Kind - Supplies the reduction.
+
+    Input - Supplies the input matrix.
+
+    ldInput - Supplies the first dimension of the input matrix.
+
+    Output - Supplies the output vector.
+
+    Rows - Supplies the number of rows reduced.
+
+    Columns - Supplies the number of columns of the input matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasReduceColumnsKernelDispatch<MLAS_REDUCE_VECTOR_OPS_FLOAT32X4>(Kind, Input, ldInput, Output, Rows, Columns);
+}
+
+void
+MLASCALL
+MlasReduceRows(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().ReduceRowsF32Kernel(Kind, Input, ldInput, Output, Rows, RowLength);
+#else
+    MlasReduceRowsF32Kernel(Kind, Input, ldInput, Output, Rows, RowLength);
+#endif
+}
+
+void
+MLASCALL
+MlasReduceColumns(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+{
+#if defined(MLAS_TARGET_AMD64)
+    GetMlasPlatform().ReduceColumnsF32Kernel(Kind, Input, ldInput, Output, Rows, Columns);
+#else
+    MlasReduceColumnsF32Kernel(Kind, Input, ldInput, Output, Rows, Columns);
+#endif
+}
@@ -0,0 +1,286 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.h
+
+Abstract:
+
+    This module implements the single precision reduction kernels for a
+    vector type. Each kernel file instantiates them with the vector type of
+    its instruction set.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+#include <limits>
+
+//
+// Number of vectors accumulated in parallel to hide the latency of the
+// dependent additions.
+//
+
+constexpr size_t MLAS_REDUCE_UNROLL = 4;
+
+//
+// Vector operations of the portable kernels.
+//
+
+struct MLAS_REDUCE_VECTOR_OPS_FLOAT32X4
+{
+    using Vector = MLAS_FLOAT32X4;
+
+    static constexpr size_t Width = 4;
+
+    static Vector Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+    static Vector Load(const float* Input) { return MlasLoadFloat32x4(Input); }
+    static void Store(float* Output, Vector Value) { MlasStoreFloat32x4(Output, Value); }
+    static Vector Add(Vector Vector1, Vector Vector2) { return MlasAddFloat32x4(Vector1, Vector2); }
+    static Vector Subtract(Vector Vector1, Vector Vector2) { return MlasSubtractFloat32x4(Vector1, Vector2); }
+    static Vector Multiply(Vector Vector1, Vector Vector2) { return MlasMultiplyFloat32x4(Vector1, Vector2); }
+    static Vector MultiplyAdd(Vector Vector1, Vector Vector2, Vector Vector3) { return MlasMultiplyAddFloat32x4(Vector1, Vector2, Vector3); }
+    static Vector Maximum(Vector Vector1, Vector Vector2) { return MlasMaximumFloat32x4(Vector1, Vector2); }
+    static float ReduceAdd(Vector Value) { return MlasReduceAddFloat32x4(Value); }
+    static float ReduceMaximum(Vector Value) { return MlasReduceMaximumFloat32x4(Value); }
+};
+
+template<typename VectorOps, MLAS_REDUCE_KIND Kind>
+struct MlasReduceOperation;
+
+template<typename VectorOps>
+struct MlasReduceOperation<VectorOps, MlasReduceSum>
+{
+    using Vector = typename VectorOps::Vector;
+
+    static float Identity() { return 0.0f; }
+    static Vector Update(Vector Accumulator, Vector Value) { return VectorOps::Add(Accumulator, Value); }
+    static float Update(float Accumulator, float Value) { return Accumulator + Value; }
+    static Vector Combine(Vector Vector1, Vector Vector2) { return VectorOps::Add(Vector1, Vector2); }
+    static float Reduce(Vector Accumulator) { return VectorOps::ReduceAdd(Accumulator); }
+};
+
+template<typename VectorOps>
+struct MlasReduceOperation<VectorOps, MlasReduceSumSquare>
+{
+    using Vector = typename VectorOps::Vector;
+
+    static float Identity() { return 0.0f; }
+    static Vector Update(Vector Accumulator, Vector Value) { return VectorOps::MultiplyAdd(Value, Value, Accumulator); }
+    static float Update(float Accumulator, float Value) { return Accumulator + Value * Value; }
+    static Vector Combine(Vector Vector1, Vector Vector2) { return VectorOps::Add(Vector1, Vector2); }
+    static float Reduce(Vector Accumulator) { return VectorOps::ReduceAdd(Accumulator); }
+};
+
+template<typename VectorOps>
+struct MlasReduceOperation<VectorOps, MlasReduceMaximum>
+{
+    using Vector = typename VectorOps::Vector;
+
+    static float Identity() { return -std::numeric_limits<float>::infinity(); }
+    static Vector Update(Vector Accumulator, Vector Value) { return VectorOps::Maximum(Accumulator, Value); }
+    static float Update(float Accumulator, float Value) { return Value > Accumulator ? Value : Accumulator; }
+    static Vector Combine(Vector Vector1, Vector Vector2) { return VectorOps::Maximum(Vector1, Vector2); }
+    static float Reduce(Vector Accumulator) { return VectorOps::ReduceMaximum(Accumulator); }
+};
+
+template<typename VectorOps, MLAS_REDUCE_KIND Kind>
+MLAS_FORCEINLINE
+float
+MlasReduceRow(
+    const float* Input,
+    size_t N
+    )
+{
+    using Operation = MlasReduceOperation<VectorOps, Kind>;
+    using Vector = typename VectorOps::Vector;
+    constexpr size_t Width = VectorOps::Width;
+
+    Vector Accumulators[MLAS_REDUCE_UNROLL];
+
+    for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+        Accumulators[i] = VectorOps::Broadcast(Operation::Identity());
+    }
+
+    while (N >= Width * MLAS_REDUCE_UNROLL) {
+
+        for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+            Accumulators[i] = Operation::Update(Accumulators[i], VectorOps::Load(Input + i * Width));
+        }
+
+        Input += Width * MLAS_REDUCE_UNROLL;
+        N -= Width * MLAS_REDUCE_UNROLL;
+    }
+
+    while (N >= Width) {
+
+        Accumulators[0] = Operation::Update(Accumulators[0], VectorOps::Load(Input));
+
+        Input += Width;
+        N -= Width;
+    }
+
+    Accumulators[0] = Operation::Combine(Accumulators[0], Accumulators[1]);
+    Accumulators[2] = Operation::Combine(Accumulators[2], Accumulators[3]);
+    Accumulators[0] = Operation::Combine(Accumulators[0], Accumulators[2]);
+
+    float Accumulator = Operation::Reduce(Accumulators[0]);
+
+    while (N > 0) {
+
+        Accumulator = Operation::Update(Accumulator, *Input++);
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+template<typename VectorOps, MLAS_REDUCE_KIND Kind>
+void
+MlasReduceRowsKernel(
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    )
+{
+    for (size_t r = 0; r < Rows; r++) {
+        Output[r] = MlasReduceRow<VectorOps, Kind>(Input, RowLength);
+        Input += ldInput;
+    }
+}
+
+template<typename VectorOps, MLAS_REDUCE_KIND Kind>
+void
+MlasReduceColumnsKernel(
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+{
+    using Operation = MlasReduceOperation<VectorOps, Kind>;
+    using Vector = typename VectorOps::Vector;
+    constexpr size_t Width = VectorOps::Width;
+
+    //
+    // Accumulate blocks of columns in registers down all the rows, so that
+    // the output is written once.
+    //
+
+    while (Columns >= Width * MLAS_REDUCE_UNROLL) {
+
+        Vector Accumulators[MLAS_REDUCE_UNROLL];
+
+        for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+            Accumulators[i] = VectorOps::Broadcast(Operation::Identity());
+        }
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < Rows; r++) {
+
+            for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+                Accumulators[i] = Operation::Update(Accumulators[i], VectorOps::Load(input + i * Width));
+            }
+
+            input += ldInput;
+        }
+
+        for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+            VectorOps::Store(Output + i * Width, Accumulators[i]);
+        }
+
+        Input += Width * MLAS_REDUCE_UNROLL;
+        Output += Width * MLAS_REDUCE_UNROLL;
+        Columns -= Width * MLAS_REDUCE_UNROLL;
+    }
+
+    while (Columns >= Width) {
+
+        Vector Accumulator = VectorOps::Broadcast(Operation::Identity());
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < Rows; r++) {
+            Accumulator = Operation::Update(Accumulator, VectorOps::Load(input));
+            input += ldInput;
+        }
+
+        VectorOps::Store(Output, Accumulator);
+
+        Input += Width;
+        Output += Width;
+        Columns -= Width;
+    }
+
+    for (size_t c = 0; c < Columns; c++) {
+
+        float Accumulator = Operation::Identity();
+
+        const float* input = Input + c;
+
+        for (size_t r = 0; r < Rows; r++) {
+            Accumulator = Operation::Update(Accumulator, *input);
+            input += ldInput;
+        }
+
+        Output[c] = Accumulator;
+    }
+}
+
+template<typename VectorOps>
+void
+MlasReduceRowsKernelDispatch(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    )
+{
+    switch (Kind) {
+        case MlasReduceSum:
+            MlasReduceRowsKernel<VectorOps, MlasReduceSum>(Input, ldInput, Output, Rows, RowLength);
+            break;
+        case MlasReduceSumSquare:
+            MlasReduceRowsKernel<VectorOps, MlasReduceSumSquare>(Input, ldInput, Output, Rows, RowLength);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceRowsKernel<VectorOps, MlasReduceMaximum>(Input, ldInput, Output, Rows, RowLength);
+            break;
+    }
+}
+
+template<typename VectorOps>
+void
+MlasReduceColumnsKernelDispatch(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+{
+    switch (Kind) {
+        case MlasReduceSum:
+            MlasReduceColumnsKernel<VectorOps, MlasReduceSum>(Input, ldInput, Output, Rows, Columns);
+            break;
+        case MlasReduceSumSquare:
+            MlasReduceColumnsKernel<VectorOps, MlasReduceSumSquare>(Input, ldInput, Output, Rows, Columns);
+            break;
+        case MlasReduceMaximum:
+            MlasReduceColumnsKernel<VectorOps, MlasReduceMaximum>(Input, ldInput, Output, Rows, Columns);
+            break;
+    }
+}
@@ -0,0 +1,124 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the single precision reduction, layer
+    normalization and matrix/vector multiply kernels for AVX2 and FMA3.
+
+--*/
+
+#include "reduce.h"
+#include "layernorm.h"
+#include "sgemv.h"
+
+#include <immintrin.h>
+
+struct MLAS_REDUCE_VECTOR_OPS_AVX2
+{
+    using Vector = __m256;
+
+    static constexpr size_t Width = 8;
+
+    static Vector Broadcast(float Value) { return _mm256_set1_ps(Value); }
+    static Vector Load(const float* Input) { return _mm256_loadu_ps(Input); }
+    static void Store(float* Output, Vector Value) { _mm256_storeu_ps(Output, Value); }
+    static Vector Add(Vector Vector1, Vector Vector2) { return _mm256_add_ps(Vector1, Vector2); }
+    static Vector Subtract(Vector Vector1, Vector Vector2) { return _mm256_sub_ps(Vector1, Vector2); }
+    static Vector Multiply(Vector Vector1, Vector Vector2) { return _mm256_mul_ps(Vector1, Vector2); }
+    static Vector MultiplyAdd(Vector Vector1, Vector Vector2, Vector Vector3) { return _mm256_fmadd_ps(Vector1, Vector2, Vector3); }
+    static Vector Maximum(Vector Vector1, Vector Vector2) { return _mm256_max_ps(Vector1, Vector2); }
+
+    static float ReduceAdd(Vector Value)
+    {
+        __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Value), _mm256_extractf128_ps(Value, 1));
+        Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+        Sum = _mm_add_ss(Sum, _mm_shuffle_ps(Sum, Sum, 1));
+        return _mm_cvtss_f32(Sum);
+    }
+
+    static float ReduceMaximum(Vector Value)
+    {
+        __m128 Maximum = _mm_max_ps(_mm256_castps256_ps128(Value), _mm256_extractf128_ps(Value, 1));
+        Maximum = _mm_max_ps(Maximum, _mm_movehl_ps(Maximum, Maximum));
+        Maximum = _mm_max_ss(Maximum, _mm_shuffle_ps(Maximum, Maximum, 1));
+        return _mm_cvtss_f32(Maximum);
+    }
+};
+
+void
+MLASCALL
+MlasReduceRowsF32KernelAvx2(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    )
+{
+    MlasReduceRowsKernelDispatch<MLAS_REDUCE_VECTOR_OPS_AVX2>(Kind, Input, ldInput, Output, Rows, RowLength);
+}
+
+void
+MLASCALL
+MlasReduceColumnsF32KernelAvx2(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+{
+    MlasReduceColumnsKernelDispatch<MLAS_REDUCE_VECTOR_OPS_AVX2>(Kind, Input, ldInput, Output, Rows, Columns);
+}
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx2(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t RowStart,
+    size_t RowCount,
+    size_t Columns
+    )
+{
+    MlasLayerNormKernel<MLAS_REDUCE_VECTOR_OPS_AVX2>(Params, RowStart, RowCount, Columns);
+}
+
+void
+MLASCALL
+MlasSgemmKernelM1Fma3(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldb,
+    float beta
+    )
+{
+    MlasSgemvKernel<MLAS_REDUCE_VECTOR_OPS_AVX2>(A, B, C, CountK, CountN, ldb, beta);
+}
+
+void
+MLASCALL
+MlasSgemmKernelM1TransposeBFma3(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldb,
+    float beta
+    )
+{
+    MlasSgemvTransposeBKernel<MLAS_REDUCE_VECTOR_OPS_AVX2>(A, B, C, CountK, CountN, ldb, beta);
+}
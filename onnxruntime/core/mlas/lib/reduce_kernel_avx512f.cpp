@@ -0,0 +1,110 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the single precision reduction, layer
+    normalization and matrix/vector multiply kernels for AVX512F.
+
+--*/
+
+#include "reduce.h"
+#include "layernorm.h"
+#include "sgemv.h"
+
+#include <immintrin.h>
+
+struct MLAS_REDUCE_VECTOR_OPS_AVX512F
+{
+    using Vector = __m512;
+
+    static constexpr size_t Width = 16;
+
+    static Vector Broadcast(float Value) { return _mm512_set1_ps(Value); }
+    static Vector Load(const float* Input) { return _mm512_loadu_ps(Input); }
+    static void Store(float* Output, Vector Value) { _mm512_storeu_ps(Output, Value); }
+    static Vector Add(Vector Vector1, Vector Vector2) { return _mm512_add_ps(Vector1, Vector2); }
+    static Vector Subtract(Vector Vector1, Vector Vector2) { return _mm512_sub_ps(Vector1, Vector2); }
+    static Vector Multiply(Vector Vector1, Vector Vector2) { return _mm512_mul_ps(Vector1, Vector2); }
+    static Vector MultiplyAdd(Vector Vector1, Vector Vector2, Vector Vector3) { return _mm512_fmadd_ps(Vector1, Vector2, Vector3); }
+    static Vector Maximum(Vector Vector1, Vector Vector2) { return _mm512_max_ps(Vector1, Vector2); }
+    static float ReduceAdd(Vector Value) { return _mm512_reduce_add_ps(Value); }
+    static float ReduceMaximum(Vector Value) { return _mm512_reduce_max_ps(Value); }
+};
+
+void
+MLASCALL
+MlasReduceRowsF32KernelAvx512F(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t RowLength
+    )
+{
+    MlasReduceRowsKernelDispatch<MLAS_REDUCE_VECTOR_OPS_AVX512F>(Kind, Input, ldInput, Output, Rows, RowLength);
+}
+
+void
+MLASCALL
+MlasReduceColumnsF32KernelAvx512F(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    float* Output,
+    size_t Rows,
+    size_t Columns
+    )
+{
+    MlasReduceColumnsKernelDispatch<MLAS_REDUCE_VECTOR_OPS_AVX512F>(Kind, Input, ldInput, Output, Rows, Columns);
+}
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx512F(
+    const MLAS_LAYER_NORM_PARAMS* Params,
+    size_t RowStart,
+    size_t RowCount,
+    size_t Columns
+    )
+{
+    MlasLayerNormKernel<MLAS_REDUCE_VECTOR_OPS_AVX512F>(Params, RowStart, RowCount, Columns);
+}
+
+void
+MLASCALL
+MlasSgemmKernelM1Avx512F(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldb,
+    float beta
+    )
+{
+    MlasSgemvKernel<MLAS_REDUCE_VECTOR_OPS_AVX512F>(A, B, C, CountK, CountN, ldb, beta);
+}
+
+void
+MLASCALL
+MlasSgemmKernelM1TransposeBAvx512F(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldb,
+    float beta
+    )
+{
+    MlasSgemvTransposeBKernel<MLAS_REDUCE_VECTOR_OPS_AVX512F>(A, B, C, CountK, CountN, ldb, beta);
+}
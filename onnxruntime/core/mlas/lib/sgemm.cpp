@@ -16,6 +16,7 @@ Abstract:
 --*/
 
 #include "mlasi.h"
+#include "sgemv.h"
 
 //
 // Define the number of rows from matrix A to transpose to a local buffer.
@@ -91,6 +92,142 @@ Return Value:
     }
 }
 
+MLAS_FORCEINLINE
+MLAS_SGEMM_EPILOGUE
+MlasSgemmOffsetEpilogue(
+    const MLAS_SGEMM_EPILOGUE& Epilogue,
+    size_t StartM,
+    size_t StartN
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the epilogue of the output matrix starting at the
+    supplied row and column.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue of the output matrix.
+
+    StartM - Supplies the starting row of the output matrix.
+
+    StartN - Supplies the starting column of the output matrix.
+
+Return Value:
+
+    Returns the offset epilogue.
+
+--*/
+{
+    MLAS_SGEMM_EPILOGUE OffsetEpilogue = Epilogue;
+
+    if (OffsetEpilogue.Bias != nullptr) {
+        OffsetEpilogue.Bias += StartN;
+    }
+
+    if (OffsetEpilogue.Addend != nullptr) {
+        OffsetEpilogue.Addend += StartM * OffsetEpilogue.ldaddend + StartN;
+    }
+
+    return OffsetEpilogue;
+}
+
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine adds the bias vector, applies the activation and adds the
+    addend matrix of the epilogue to a block of the output matrix.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue, offset to the start of the block.
+
+    C - Supplies the address of the block of matrix C.
+
+    CountM - Supplies the number of rows from matrix C.
+
+    CountN - Supplies the number of columns from matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const bool HasActivation = Epilogue->Activation != nullptr &&
+        Epilogue->Activation->ActivationKind != MlasIdentityActivation;
+
+    //
+    // Add the bias vector, and the addend matrix if there is no activation
+    // in between, in a single pass over the block.
+    //
+
+    const float* Bias = Epilogue->Bias;
+    const float* Addend = HasActivation ? nullptr : Epilogue->Addend;
+
+    if (Bias != nullptr || Addend != nullptr) {
+
+        float* c = C;
+        const float* addend = Addend;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            size_t n = 0;
+
+            for (; n + 4 <= CountN; n += 4) {
+
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(c + n);
+
+                if (Bias != nullptr) {
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(Bias + n));
+                }
+
+                if (addend != nullptr) {
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(addend + n));
+                }
+
+                MlasStoreFloat32x4(c + n, Vector);
+            }
+
+            for (; n < CountN; n++) {
+                c[n] += (Bias != nullptr ? Bias[n] : 0.0f) + (addend != nullptr ? addend[n] : 0.0f);
+            }
+
+            c += ldc;
+
+            if (addend != nullptr) {
+                addend += Epilogue->ldaddend;
+            }
+        }
+    }
+
+    if (HasActivation) {
+
+        MlasActivation(Epilogue->Activation, C, nullptr, CountM, CountN, ldc);
+
+        if (Epilogue->Addend != nullptr) {
+
+            MLAS_SGEMM_EPILOGUE AddendEpilogue;
+            AddendEpilogue.Addend = Epilogue->Addend;
+            AddendEpilogue.ldaddend = Epilogue->ldaddend;
+
+            MlasSgemmApplyEpilogue(&AddendEpilogue, C, CountM, CountN, ldc);
+        }
+    }
+}
+
 void
 MlasSgemmTransposeA(
     float* D,
@@ -1015,7 +1152,8 @@ MlasSgemmKernelLoop(
     size_t lda,
     size_t ldc,
     float alpha,
-    bool ZeroMode
+    bool ZeroMode,
+    MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1051,6 +1189,10 @@ Arguments:
     ZeroMode - Supplies true if the output matrix must be zero initialized,
         else false if the output matrix is accumulated into.
 
+    Epilogue - Supplies the epilogue to apply to the rows once the kernel
+        computed them, else nullptr. The addend of the epilogue is advanced
+        past the rows processed.
+
 Return Value:
 
     Returns the next address of matrix C.
@@ -1071,6 +1213,15 @@ Return Value:
         }
 #endif
 
+        if (Epilogue != nullptr) {
+
+            MlasSgemmApplyEpilogue(Epilogue, C, RowsHandled, CountN, ldc);
+
+            if (Epilogue->Addend != nullptr) {
+                Epilogue->Addend += Epilogue->ldaddend * RowsHandled;
+            }
+        }
+
         C += ldc * RowsHandled;
         A += lda * RowsHandled;
         CountM -= RowsHandled;
@@ -1093,7 +1244,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1131,6 +1283,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Supplies the optional epilogue, offset to the start of matrix C.
+
 Return Value:
 
     None.
@@ -1147,6 +1301,9 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+        }
         return;
     }
 
@@ -1170,13 +1327,31 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+            }
             return;
         }
 
-#elif defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_WASM)
+#elif defined(MLAS_TARGET_ARM64)
+
+        if (TransB == CblasNoTrans) {
+            MlasSgemvKernel<MLAS_REDUCE_VECTOR_OPS_FLOAT32X4>(A, B, C, K, N, ldb, beta);
+        } else {
+            MlasSgemvTransposeBKernel<MLAS_REDUCE_VECTOR_OPS_FLOAT32X4>(A, B, C, K, N, ldb, beta);
+        }
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+        }
+        return;
+
+#elif defined(MLAS_TARGET_WASM)
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+            }
             return;
         }
 
@@ -1205,9 +1380,24 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+            }
             return;
         }
 
+#elif defined(MLAS_TARGET_ARM64)
+
+        if (TransA == CblasNoTrans) {
+            MlasSgemvTransposeBKernel<MLAS_REDUCE_VECTOR_OPS_FLOAT32X4>(B, A, C, K, M, lda, beta);
+        } else {
+            MlasSgemvKernel<MLAS_REDUCE_VECTOR_OPS_FLOAT32X4>(B, A, C, K, M, lda, beta);
+        }
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, M, N, ldc);
+        }
+        return;
+
 #endif
 
     }
@@ -1256,6 +1446,17 @@ Return Value:
             MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
         }
 
+        //
+        // Apply the epilogue to the rows of the slice as the last slice of
+        // matrix B along the K dimension completes them.
+        //
+
+        MLAS_SGEMM_EPILOGUE SliceEpilogue;
+
+        if (Epilogue != nullptr) {
+            SliceEpilogue = MlasSgemmOffsetEpilogue(*Epilogue, 0, n);
+        }
+
         //
         // Step through each slice of matrix B along the K dimension.
         //
@@ -1267,6 +1468,8 @@ Return Value:
 
             CountK = std::min(K - k, StrideK);
 
+            MLAS_SGEMM_EPILOGUE* KernelEpilogue = (Epilogue != nullptr && k + CountK == K) ? &SliceEpilogue : nullptr;
+
             //
             // Copy or transpose a panel of matrix B to a local packed buffer.
             //
@@ -1285,7 +1488,7 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode, KernelEpilogue);
 
             } else {
 
@@ -1309,7 +1512,7 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode, KernelEpilogue);
                 }
             }
 
@@ -1332,7 +1535,8 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1372,6 +1576,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Supplies the optional epilogue, offset to the start of matrix C.
+
 Return Value:
 
     None.
@@ -1400,6 +1606,17 @@ Return Value:
             MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
         }
 
+        //
+        // Apply the epilogue to the rows of the slice as the last slice of
+        // matrix B along the K dimension completes them.
+        //
+
+        MLAS_SGEMM_EPILOGUE SliceEpilogue;
+
+        if (Epilogue != nullptr) {
+            SliceEpilogue = MlasSgemmOffsetEpilogue(*Epilogue, 0, n);
+        }
+
         //
         // Step through each slice of matrix B along the K dimension.
         //
@@ -1411,6 +1628,8 @@ Return Value:
 
             CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
 
+            MLAS_SGEMM_EPILOGUE* KernelEpilogue = (Epilogue != nullptr && k + CountK == K) ? &SliceEpilogue : nullptr;
+
             //
             // Step through each slice of matrix A along the M dimension.
             //
@@ -1420,7 +1639,7 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode, KernelEpilogue);
 
             } else {
 
@@ -1444,7 +1663,7 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode, KernelEpilogue);
                 }
             }
 
@@ -1536,11 +1755,19 @@ Return Value:
     const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
     float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
+    MLAS_SGEMM_EPILOGUE Epilogue;
+    const MLAS_SGEMM_EPILOGUE* RangeEpilogue = nullptr;
+
+    if (DataParams->Epilogue != nullptr) {
+        Epilogue = MlasSgemmOffsetEpilogue(*DataParams->Epilogue, RangeStartM, RangeStartN);
+        RangeEpilogue = &Epilogue;
+    }
+
     if (DataParams->BIsPacked) {
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc, RangeEpilogue);
 
     } else {
 
@@ -1549,7 +1776,7 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc, RangeEpilogue);
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1603,6 +1830,47 @@ MlasGemmBatch(
     ptrdiff_t ThreadCountM;
     ptrdiff_t ThreadCountN;
 
+    //
+    // Run a batch of operations that each use a single thread, such as the
+    // per head products of attention, as ranges of whole operations per
+    // thread. The thread pool is then dispatched once for the batch instead
+    // of once per operation and the packed panels of each operation stay in
+    // the cache of the thread computing it.
+    //
+
+    if (ThreadsPerGemm == 1 && BatchSize > 1) {
+
+        const double BatchComplexity = Complexity * double(BatchSize);
+
+        ptrdiff_t BatchThreadCount;
+
+        if (BatchComplexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MaximumThreadCount)) {
+            BatchThreadCount = ptrdiff_t(BatchComplexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            BatchThreadCount = MaximumThreadCount;
+        }
+
+        if (size_t(BatchThreadCount) > BatchSize) {
+            BatchThreadCount = ptrdiff_t(BatchSize);
+        }
+
+        const size_t GemmsPerThread = MlasDivRoundup(BatchSize, size_t(BatchThreadCount));
+
+        BatchThreadCount = ptrdiff_t(MlasDivRoundup(BatchSize, GemmsPerThread));
+
+        MlasTrySimpleParallel(ThreadPool, BatchThreadCount, [=](ptrdiff_t tid)
+        {
+            const size_t GemmStart = size_t(tid) * GemmsPerThread;
+            const size_t GemmEnd = std::min(GemmStart + GemmsPerThread, BatchSize);
+
+            for (size_t GemmIdx = GemmStart; GemmIdx < GemmEnd; GemmIdx++) {
+                MlasSgemmThreaded(1, 1, TransA, TransB, M, N, K, &(Data[GemmIdx]), 0);
+            }
+        });
+
+        return;
+    }
+
     if (N > M) {
 
         const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
@@ -0,0 +1,264 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sgemv.h
+
+Abstract:
+
+    This module implements the single precision matrix/vector multiply
+    kernels (SGEMV) for the M=1 case of SGEMM for a vector type. Each kernel
+    file instantiates them with the vector type of its instruction set.
+
+    The kernels read the elements of matrix B exactly once, directly from
+    the caller's buffer, and write each element of the output vector once.
+
+--*/
+
+#pragma once
+
+#include "reduce.h"
+
+template<typename VectorOps>
+MLAS_FORCEINLINE
+void
+MlasSgemvStoreOutput(
+    float* C,
+    typename VectorOps::Vector Accumulator,
+    float beta
+    )
+{
+    if (beta != 0.0f) {
+        Accumulator = VectorOps::Add(Accumulator, VectorOps::Load(C));
+    }
+
+    VectorOps::Store(C, Accumulator);
+}
+
+template<typename VectorOps>
+void
+MlasSgemvKernel(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldb,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the product of the row vector A and matrix B for
+    the special case of M=1. The elements in matrix B are not transposed.
+
+Arguments:
+
+    A - Supplies the address of the row vector A.
+
+    B - Supplies the address of matrix B.
+
+    C - Supplies the address of the output row vector C.
+
+    CountK - Supplies the number of columns from vector A and the number of
+        rows from matrix B to iterate over.
+
+    CountN - Supplies the number of columns from matrix B and vector C to
+        iterate over.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier, either 0 or 1.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    using Vector = typename VectorOps::Vector;
+    constexpr size_t Width = VectorOps::Width;
+
+    //
+    // Accumulate blocks of columns in registers down all the rows of matrix
+    // B, so that each element of B is read once and the output is written
+    // once.
+    //
+
+    while (CountN >= Width * MLAS_REDUCE_UNROLL) {
+
+        Vector Accumulators[MLAS_REDUCE_UNROLL];
+
+        for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+            Accumulators[i] = VectorOps::Broadcast(0.0f);
+        }
+
+        const float* b = B;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            const Vector AElement = VectorOps::Broadcast(A[k]);
+
+            for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+                Accumulators[i] = VectorOps::MultiplyAdd(AElement, VectorOps::Load(b + i * Width), Accumulators[i]);
+            }
+
+            b += ldb;
+        }
+
+        for (size_t i = 0; i < MLAS_REDUCE_UNROLL; i++) {
+            MlasSgemvStoreOutput<VectorOps>(C + i * Width, Accumulators[i], beta);
+        }
+
+        B += Width * MLAS_REDUCE_UNROLL;
+        C += Width * MLAS_REDUCE_UNROLL;
+        CountN -= Width * MLAS_REDUCE_UNROLL;
+    }
+
+    while (CountN >= Width) {
+
+        Vector Accumulator = VectorOps::Broadcast(0.0f);
+
+        const float* b = B;
+
+        for (size_t k = 0; k < CountK; k++) {
+            Accumulator = VectorOps::MultiplyAdd(VectorOps::Broadcast(A[k]), VectorOps::Load(b), Accumulator);
+            b += ldb;
+        }
+
+        MlasSgemvStoreOutput<VectorOps>(C, Accumulator, beta);
+
+        B += Width;
+        C += Width;
+        CountN -= Width;
+    }
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        float Accumulator = 0.0f;
+
+        const float* b = B + n;
+
+        for (size_t k = 0; k < CountK; k++) {
+            Accumulator += A[k] * b[0];
+            b += ldb;
+        }
+
+        C[n] = (beta != 0.0f) ? C[n] + Accumulator : Accumulator;
+    }
+}
+
+template<typename VectorOps, size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSgemvTransposeBRows(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t ldb,
+    float beta
+    )
+{
+    using Vector = typename VectorOps::Vector;
+    constexpr size_t Width = VectorOps::Width;
+
+    Vector Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = VectorOps::Broadcast(0.0f);
+    }
+
+    size_t k = 0;
+
+    for (; k + Width <= CountK; k += Width) {
+
+        const Vector AElements = VectorOps::Load(A + k);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = VectorOps::MultiplyAdd(AElements, VectorOps::Load(B + r * ldb + k), Accumulators[r]);
+        }
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float Accumulator = VectorOps::ReduceAdd(Accumulators[r]);
+
+        for (size_t kk = k; kk < CountK; kk++) {
+            Accumulator += A[kk] * B[r * ldb + kk];
+        }
+
+        C[r] = (beta != 0.0f) ? C[r] + Accumulator : Accumulator;
+    }
+}
+
+template<typename VectorOps>
+void
+MlasSgemvTransposeBKernel(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldb,
+    float beta
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the product of the row vector A and matrix B for
+    the special case of M=1. The elements in matrix B are transposed, so
+    each output is the dot product of A with a row of B.
+
+Arguments:
+
+    A - Supplies the address of the row vector A.
+
+    B - Supplies the address of matrix B.
+
+    C - Supplies the address of the output row vector C.
+
+    CountK - Supplies the number of columns from vector A and the number of
+        columns from matrix B to iterate over.
+
+    CountN - Supplies the number of rows from matrix B and the number of
+        columns from vector C to iterate over.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scalar beta multiplier, either 0 or 1.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Compute four outputs at a time to share the loads of vector A.
+    //
+
+    while (CountN >= 4) {
+
+        MlasSgemvTransposeBRows<VectorOps, 4>(A, B, C, CountK, ldb, beta);
+
+        B += 4 * ldb;
+        C += 4;
+        CountN -= 4;
+    }
+
+    while (CountN > 0) {
+
+        MlasSgemvTransposeBRows<VectorOps, 1>(A, B, C, CountK, ldb, beta);
+
+        B += ldb;
+        C += 1;
+        CountN -= 1;
+    }
+}
@@ -0,0 +1,344 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse24gemm.cpp
+
+Abstract:
+
+    This module implements the fp32 matrix multiplication with a 2:4
+    structured sparse right hand side. B is compressed to the nonzero values
+    of each group of 4 rows and their rows, so the kernels read half of B and
+    skip the products of the pruned values.
+--*/
+
+#include "sparse24gemm.h"
+
+//
+// Number of columns of B one kernel call covers, so that the packed blocks
+// of the columns stay in cache while all the rows of the operation reuse
+// them.
+//
+
+constexpr size_t MLAS_SPARSE24_GEMM_STRIDEN = 64;
+
+constexpr size_t MLAS_SPARSE24_GEMM_STRIDEM = 128;
+
+constexpr size_t MLAS_SPARSE24_GEMM_KERNEL_MAX_M = 4;
+
+MLAS_FORCEINLINE
+float
+MlasSparse24GemmLoadB(
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t k,
+    size_t n
+    )
+{
+    return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+}
+
+bool
+MLASCALL
+MlasSparse24GemmIsSparse(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+{
+    for (size_t k0 = 0; k0 < K; k0 += MLAS_SPARSE24_GEMM_GROUP_K) {
+        const size_t CountK = std::min(K - k0, MLAS_SPARSE24_GEMM_GROUP_K);
+
+        for (size_t n = 0; n < N; n++) {
+            size_t NonZeros = 0;
+            for (size_t k = k0; k < k0 + CountK; k++) {
+                NonZeros += MlasSparse24GemmLoadB(TransB, B, ldb, k, n) != 0.0f;
+            }
+            if (NonZeros > 2) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+size_t
+MLASCALL
+MlasSparse24GemmPackBSize(
+    size_t N,
+    size_t K
+    )
+{
+    const size_t BlockCount = MlasDivRoundup(N, MLAS_SPARSE24_GEMM_PACKED_N);
+    const size_t BytesRequired =
+        BlockCount * MlasSparse24GemmGroupCount(K) * sizeof(MLAS_SPARSE24_GEMM_PACKED_GROUP);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+void
+MLASCALL
+MlasSparse24GemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    const size_t GroupCount = MlasSparse24GemmGroupCount(K);
+    auto* Group = reinterpret_cast<MLAS_SPARSE24_GEMM_PACKED_GROUP*>(PackedB);
+
+    for (size_t n0 = 0; n0 < N; n0 += MLAS_SPARSE24_GEMM_PACKED_N) {
+        const size_t CountN = std::min(N - n0, MLAS_SPARSE24_GEMM_PACKED_N);
+
+        for (size_t g = 0; g < GroupCount; g++, Group++) {
+            const size_t k0 = g * MLAS_SPARSE24_GEMM_GROUP_K;
+            const size_t CountK = std::min(K - k0, MLAS_SPARSE24_GEMM_GROUP_K);
+
+            for (size_t n = 0; n < MLAS_SPARSE24_GEMM_PACKED_N; n++) {
+                float Values[2] = {0.0f, 0.0f};
+                uint8_t Rows[2] = {0, 0};
+                size_t Count = 0;
+
+                //
+                // Values past the first two nonzero values of the group are
+                // dropped, the caller checks the sparsity first.
+                //
+
+                for (size_t k = 0; k < CountK && n < CountN && Count < 2; k++) {
+                    const float Value = MlasSparse24GemmLoadB(TransB, B, ldb, k0 + k, n0 + n);
+                    if (Value != 0.0f) {
+                        Values[Count] = Value;
+                        Rows[Count] = uint8_t(k);
+                        Count++;
+                    }
+                }
+
+                Group->Values[0][n] = Values[0];
+                Group->Values[1][n] = Values[1];
+                Group->Indices[n] = uint8_t(Rows[0] | (Rows[1] << 2));
+            }
+        }
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSparse24GemmKernelRows(
+    const float* A,
+    size_t lda,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_PACKED_GROUP* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountN,
+    bool ZeroMode
+    )
+{
+    const size_t GroupCount = MlasSparse24GemmGroupCount(K);
+
+    for (size_t n = 0; n < CountN; n += MLAS_SPARSE24_GEMM_PACKED_N) {
+        float Accumulators[RowCount][MLAS_SPARSE24_GEMM_PACKED_N] = {};
+
+        const MLAS_SPARSE24_GEMM_PACKED_GROUP* Group = PackedB + (n / MLAS_SPARSE24_GEMM_PACKED_N) * GroupCount;
+
+        for (size_t g = 0; g < GroupCount; g++, Group++) {
+            const size_t k0 = g * MLAS_SPARSE24_GEMM_GROUP_K;
+            const size_t CountK = std::min(K - k0, MLAS_SPARSE24_GEMM_GROUP_K);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                float a[MLAS_SPARSE24_GEMM_GROUP_K] = {};
+                std::copy_n(A + r * lda + k0, CountK, a);
+
+                for (size_t i = 0; i < MLAS_SPARSE24_GEMM_PACKED_N; i++) {
+                    const unsigned Index = Group->Indices[i];
+                    Accumulators[r][i] += a[Index & 3] * Group->Values[0][i] + a[Index >> 2] * Group->Values[1][i];
+                }
+            }
+        }
+
+        const size_t Columns = std::min(CountN - n, MLAS_SPARSE24_GEMM_PACKED_N);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            for (size_t i = 0; i < Columns; i++) {
+                float Result = Accumulators[r][i];
+                if (Bias != nullptr) {
+                    Result += Bias[n + i];
+                }
+                c[i] = ZeroMode ? Result : c[i] + Result;
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSparse24GemmKernel(
+    const float* A,
+    size_t lda,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_PACKED_GROUP* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    bool ZeroMode
+    )
+{
+    while (CountM > 0) {
+        size_t RowsHandled;
+
+        switch (std::min(CountM, MLAS_SPARSE24_GEMM_KERNEL_MAX_M)) {
+            case 1:
+                MlasSparse24GemmKernelRows<1>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 1;
+                break;
+            case 2:
+                MlasSparse24GemmKernelRows<2>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 2;
+                break;
+            case 3:
+                MlasSparse24GemmKernelRows<3>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 3;
+                break;
+            default:
+                MlasSparse24GemmKernelRows<4>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 4;
+                break;
+        }
+
+        A += RowsHandled * lda;
+        C += RowsHandled * ldc;
+        CountM -= RowsHandled;
+    }
+}
+
+const MLAS_SPARSE24_GEMM_DISPATCH MlasSparse24GemmDispatchDefault = {
+    MlasSparse24GemmKernel,
+};
+
+static
+void
+MlasSparse24GemmOperation(
+    const MLAS_SPARSE24_GEMM_DISPATCH* Dispatch,
+    const size_t K,
+    const MLAS_SPARSE24_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    const size_t GroupCount = MlasSparse24GemmGroupCount(K);
+    const auto* PackedB = reinterpret_cast<const MLAS_SPARSE24_GEMM_PACKED_GROUP*>(Data->B);
+
+    for (size_t n = 0; n < RangeCountN; n += MLAS_SPARSE24_GEMM_STRIDEN) {
+        const size_t StartN = RangeStartN + n;
+        const size_t CountN = std::min(RangeCountN - n, MLAS_SPARSE24_GEMM_STRIDEN);
+
+        //
+        // The thread ranges of N are aligned to the packed blocks.
+        //
+
+        Dispatch->Kernel(Data->A + RangeStartM * Data->lda, Data->lda, K,
+                         PackedB + (StartN / MLAS_SPARSE24_GEMM_PACKED_N) * GroupCount,
+                         Data->C + RangeStartM * Data->ldc + StartN, Data->ldc,
+                         Data->Bias == nullptr ? nullptr : Data->Bias + StartN,
+                         RangeCountM, CountN, Data->ZeroMode);
+    }
+}
+
+void
+MLASCALL
+MlasSparse24GemmBatch(
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BatchN,
+    const MLAS_SPARSE24_GEMM_DATA_PARAMS* DataParams,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const MLAS_SPARSE24_GEMM_DISPATCH* Dispatch = GetMlasPlatform().Sparse24GemmDispatch;
+
+    if (ThreadPool == nullptr) {
+        for (size_t gemm_i = 0; gemm_i < BatchN; gemm_i++) {
+            for (size_t m = 0; m < M; m += MLAS_SPARSE24_GEMM_STRIDEM) {
+                MlasSparse24GemmOperation(Dispatch, K, &DataParams[gemm_i], m,
+                                          std::min(M - m, MLAS_SPARSE24_GEMM_STRIDEM), 0, N);
+            }
+        }
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation, half of the products of the dense operation. Small requests
+    // should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchN) / 2;
+
+    ptrdiff_t TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool) * 8;
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    ptrdiff_t ThreadsPerGemm = TargetThreadCount / BatchN;
+    if (ThreadsPerGemm < 1) {
+        ThreadsPerGemm = 1;
+    }
+
+    constexpr size_t StrideM = MLAS_SPARSE24_GEMM_STRIDEM;
+
+    size_t nc = N;
+    if (ThreadsPerGemm > 1) {
+        // more than one thread per GEMM
+
+        const size_t BlockedM = MlasDivRoundup(M, StrideM);
+        const size_t max_nc = MlasDivRoundup(N * BlockedM, ThreadsPerGemm);
+        if (max_nc < nc) {
+            nc = std::min(nc, MlasDivRoundup(max_nc, MLAS_SPARSE24_GEMM_PACKED_N) *
+                                  MLAS_SPARSE24_GEMM_PACKED_N);
+        }
+    }
+    const size_t StrideN = nc;
+
+    const size_t ThreadCountM = MlasDivRoundup(M, StrideM);
+    const size_t ThreadCountN = MlasDivRoundup(N, StrideN);
+    ThreadsPerGemm = ThreadCountM * ThreadCountN;
+
+    MlasTrySimpleParallel(ThreadPool, ThreadsPerGemm * BatchN, [&](ptrdiff_t tid) {
+        const auto gemm_i = tid / ThreadsPerGemm;
+        const auto blk_i = tid % ThreadsPerGemm;
+        auto Data = &DataParams[gemm_i];
+
+        const ptrdiff_t ThreadIdN = blk_i / ThreadCountM;
+        const ptrdiff_t ThreadIdM = blk_i % ThreadCountM;
+
+        const size_t RangeStartM = ThreadIdM * StrideM;
+        const size_t RangeCountM = std::min(M - RangeStartM, (size_t)StrideM);
+
+        const size_t RangeStartN = ThreadIdN * StrideN;
+        const size_t RangeCountN = std::min(N - RangeStartN, (size_t)StrideN);
+
+        MlasSparse24GemmOperation(Dispatch, K, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+    });
+}
@@ -0,0 +1,101 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse24gemm.h
+
+Abstract:
+
+    This module defines the kernel interface of the matrix/matrix multiply
+    operation with a 2:4 structured sparse right hand side.
+
+    Packed B layout: the columns of B are split into blocks of 16 columns,
+    the last block padded with zeros. The rows of a block are split into
+    groups of 4 rows, the last group padded with zeros, and each column of a
+    group holds at most two nonzero values. A packed group stores the two
+    values of the 16 columns, then a byte per column with the row of the
+    first value in the group in bits 0-1 and the row of the second value in
+    bits 2-3. A column with fewer nonzero values stores zeros instead.
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+constexpr size_t MLAS_SPARSE24_GEMM_PACKED_N = 16;
+constexpr size_t MLAS_SPARSE24_GEMM_GROUP_K = 4;
+
+struct MLAS_SPARSE24_GEMM_PACKED_GROUP {
+    float Values[2][MLAS_SPARSE24_GEMM_PACKED_N];
+    uint8_t Indices[MLAS_SPARSE24_GEMM_PACKED_N];
+};
+
+static_assert(sizeof(MLAS_SPARSE24_GEMM_PACKED_GROUP) == 144, "packed groups must not be padded");
+
+/**
+ * @brief Returns the number of groups of rows of B
+ */
+MLAS_FORCEINLINE
+size_t
+MlasSparse24GemmGroupCount(
+    size_t K
+    )
+{
+    return (K + MLAS_SPARSE24_GEMM_GROUP_K - 1) / MLAS_SPARSE24_GEMM_GROUP_K;
+}
+
+/**
+ * @brief Compute C = A * B + Bias (or C += A * B + Bias) for a range of C
+ *
+ * @param[in]  A          Address of the first row of A
+ * @param[in]  lda        Leading dimension of A
+ * @param[in]  K          Number of columns of A
+ * @param[in]  PackedB    Address of the first packed block of the columns
+ * @param[out] C          Address of the first element of C
+ * @param[in]  ldc        Leading dimension of C
+ * @param[in]  Bias       Optional address of the bias of the columns
+ * @param[in]  CountM     Number of rows of C
+ * @param[in]  CountN     Number of columns of C
+ * @param[in]  ZeroMode   true to overwrite C, false to accumulate into C
+ */
+typedef
+void
+(MLASCALL MLAS_SPARSE24_GEMM_KERNEL)(
+    const float* A,
+    size_t lda,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_PACKED_GROUP* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    bool ZeroMode
+    );
+
+struct MLAS_SPARSE24_GEMM_DISPATCH {
+    MLAS_SPARSE24_GEMM_KERNEL* Kernel;
+};
+
+extern "C" {
+
+    void
+    MLASCALL
+    MlasSparse24GemmKernelAvx512F(
+        const float* A,
+        size_t lda,
+        size_t K,
+        const MLAS_SPARSE24_GEMM_PACKED_GROUP* PackedB,
+        float* C,
+        size_t ldc,
+        const float* Bias,
+        size_t CountM,
+        size_t CountN,
+        bool ZeroMode
+        );
+
+}
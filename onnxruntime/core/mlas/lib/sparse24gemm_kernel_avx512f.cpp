@@ -0,0 +1,132 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparse24gemm_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the 2:4 structured sparse GEMM kernel using
+    AVX512F. The 4 values of A of a group of rows of B are loaded in a
+    register once per row of C, and VPERMPS selects the values each column
+    multiplies by its two nonzero values.
+
+--*/
+
+#include "sparse24gemm.h"
+
+#include <immintrin.h>
+
+constexpr size_t KernelMaxM = 4;
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSparse24GemmKernelAvx512FRows(
+    const float* A,
+    size_t lda,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_PACKED_GROUP* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountN,
+    bool ZeroMode
+    )
+{
+    const size_t GroupCount = MlasSparse24GemmGroupCount(K);
+    const size_t TailK = K - (K - 1) / MLAS_SPARSE24_GEMM_GROUP_K * MLAS_SPARSE24_GEMM_GROUP_K;
+    const __mmask16 TailMaskA = __mmask16((1u << TailK) - 1);
+    const __m512i IndexMask = _mm512_set1_epi32(3);
+
+    for (size_t n = 0; n < CountN; n += MLAS_SPARSE24_GEMM_PACKED_N) {
+        __m512 Accumulators[RowCount];
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = _mm512_setzero_ps();
+        }
+
+        const MLAS_SPARSE24_GEMM_PACKED_GROUP* Group = PackedB + (n / MLAS_SPARSE24_GEMM_PACKED_N) * GroupCount;
+
+        for (size_t g = 0; g < GroupCount; g++, Group++) {
+            const __m512 Values0 = _mm512_loadu_ps(Group->Values[0]);
+            const __m512 Values1 = _mm512_loadu_ps(Group->Values[1]);
+            const __m512i Indices =
+                _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Group->Indices)));
+            const __m512i Indices0 = _mm512_and_si512(Indices, IndexMask);
+            const __m512i Indices1 = _mm512_srli_epi32(Indices, 2);
+
+            // the masked load of the last group doesn't read past the row of A
+            const __mmask16 MaskA = (g + 1 == GroupCount) ? TailMaskA : __mmask16(0xF);
+
+            for (size_t r = 0; r < RowCount; r++) {
+                const __m512 AElements = _mm512_maskz_loadu_ps(MaskA, A + r * lda + g * MLAS_SPARSE24_GEMM_GROUP_K);
+                Accumulators[r] = _mm512_fmadd_ps(_mm512_permutexvar_ps(Indices0, AElements), Values0, Accumulators[r]);
+                Accumulators[r] = _mm512_fmadd_ps(_mm512_permutexvar_ps(Indices1, AElements), Values1, Accumulators[r]);
+            }
+        }
+
+        const size_t Columns = std::min(CountN - n, MLAS_SPARSE24_GEMM_PACKED_N);
+        const __mmask16 Mask = __mmask16((1u << Columns) - 1);
+        const __m512 BiasElements = (Bias != nullptr) ? _mm512_maskz_loadu_ps(Mask, Bias + n) : _mm512_setzero_ps();
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            __m512 Result = _mm512_add_ps(Accumulators[r], BiasElements);
+            if (!ZeroMode) {
+                Result = _mm512_add_ps(Result, _mm512_maskz_loadu_ps(Mask, c));
+            }
+            _mm512_mask_storeu_ps(c, Mask, Result);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasSparse24GemmKernelAvx512F(
+    const float* A,
+    size_t lda,
+    size_t K,
+    const MLAS_SPARSE24_GEMM_PACKED_GROUP* PackedB,
+    float* C,
+    size_t ldc,
+    const float* Bias,
+    size_t CountM,
+    size_t CountN,
+    bool ZeroMode
+    )
+{
+    while (CountM > 0) {
+        size_t RowsHandled;
+
+        switch (std::min(CountM, KernelMaxM)) {
+            case 1:
+                MlasSparse24GemmKernelAvx512FRows<1>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 1;
+                break;
+            case 2:
+                MlasSparse24GemmKernelAvx512FRows<2>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 2;
+                break;
+            case 3:
+                MlasSparse24GemmKernelAvx512FRows<3>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 3;
+                break;
+            default:
+                MlasSparse24GemmKernelAvx512FRows<4>(A, lda, K, PackedB, C, ldc, Bias, CountN, ZeroMode);
+                RowsHandled = 4;
+                break;
+        }
+
+        A += RowsHandled * lda;
+        C += RowsHandled * ldc;
+        CountM -= RowsHandled;
+    }
+}
+
+const MLAS_SPARSE24_GEMM_DISPATCH MlasSparse24GemmDispatchAvx512F = {
+    MlasSparse24GemmKernelAvx512F,
+};
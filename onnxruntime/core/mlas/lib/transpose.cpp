@@ -16,6 +16,8 @@ Abstract:
 
 #include "mlasi.h"
 
+#include <cstring>
+
 #if defined(MLAS_SSE2_INTRINSICS)
 
 MLAS_FORCEINLINE
@@ -121,6 +123,22 @@ MlasTranspose8x8Block(
     _mm_storeh_pi((__m64*)&Output[OutputStride * 7], d3);
 }
 
+MLAS_FORCEINLINE
+void
+MlasTranspose2x2Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(a0, a1));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(a0, a1));
+}
+
 #elif defined(MLAS_NEON_INTRINSICS)
 
 MLAS_FORCEINLINE
@@ -220,6 +238,22 @@ MlasTranspose8x8Block(
     vst1_u8(&Output[OutputStride * 7], vreinterpret_u8_u32(d3.val[1]));
 }
 
+MLAS_FORCEINLINE
+void
+MlasTranspose2x2Block(
+    const uint64_t* Input,
+    size_t InputStride,
+    uint64_t* Output,
+    size_t OutputStride
+    )
+{
+    uint64x2_t a0 = vld1q_u64(&Input[InputStride * 0]);
+    uint64x2_t a1 = vld1q_u64(&Input[InputStride * 1]);
+
+    vst1q_u64(&Output[OutputStride * 0], vcombine_u64(vget_low_u64(a0), vget_low_u64(a1)));
+    vst1q_u64(&Output[OutputStride * 1], vcombine_u64(vget_high_u64(a0), vget_high_u64(a1)));
+}
+
 #elif defined(MLAS_TARGET_POWER)
 
 MLAS_FORCEINLINE
@@ -810,3 +844,612 @@ MlasTranspose(
         M,
         N);
 }
+
+//
+// Define the block kernels used by the N-dimensional transpose. Each kernel
+// transposes a square block of BlockSize rows from an input matrix with the
+// supplied row stride to an output matrix with the supplied row stride.
+//
+
+template<typename ElementType, size_t BlockSize>
+MLAS_FORCEINLINE
+void
+MlasTransposeScalarBlock(
+    const ElementType* Input,
+    size_t InputStride,
+    ElementType* Output,
+    size_t OutputStride
+    )
+{
+    for (size_t n = 0; n < BlockSize; n++) {
+        for (size_t m = 0; m < BlockSize; m++) {
+            Output[OutputStride * n + m] = Input[InputStride * m + n];
+        }
+    }
+}
+
+template<typename ElementType>
+struct MLAS_TRANSPOSE_ND_BLOCK;
+
+template<>
+struct MLAS_TRANSPOSE_ND_BLOCK<uint8_t>
+{
+#if defined(MLAS_TARGET_POWER)
+    static constexpr size_t BlockSize = 16;
+#else
+    static constexpr size_t BlockSize = 8;
+#endif
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Transpose(
+        const uint8_t* Input,
+        size_t InputStride,
+        uint8_t* Output,
+        size_t OutputStride
+        )
+    {
+#if defined(MLAS_TARGET_POWER)
+        MlasTranspose16x16Block(Input, InputStride, Output, OutputStride);
+#elif defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+        MlasTranspose8x8Block(Input, InputStride, Output, OutputStride);
+#else
+        MlasTransposeScalarBlock<uint8_t, BlockSize>(Input, InputStride, Output, OutputStride);
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_ND_BLOCK<uint16_t>
+{
+    static constexpr size_t BlockSize = 4;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Transpose(
+        const uint16_t* Input,
+        size_t InputStride,
+        uint16_t* Output,
+        size_t OutputStride
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+        MlasTranspose4x4Block(Input, InputStride, Output, OutputStride);
+#else
+        MlasTransposeScalarBlock<uint16_t, BlockSize>(Input, InputStride, Output, OutputStride);
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_ND_BLOCK<uint32_t>
+{
+    static constexpr size_t BlockSize = 4;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Transpose(
+        const uint32_t* Input,
+        size_t InputStride,
+        uint32_t* Output,
+        size_t OutputStride
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS) || defined(MLAS_TARGET_POWER)
+        MlasTranspose4x4Block(Input, InputStride, Output, OutputStride);
+#else
+        MlasTransposeScalarBlock<uint32_t, BlockSize>(Input, InputStride, Output, OutputStride);
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_ND_BLOCK<uint64_t>
+{
+    static constexpr size_t BlockSize = 2;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    Transpose(
+        const uint64_t* Input,
+        size_t InputStride,
+        uint64_t* Output,
+        size_t OutputStride
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+        MlasTranspose2x2Block(Input, InputStride, Output, OutputStride);
+#else
+        MlasTransposeScalarBlock<uint64_t, BlockSize>(Input, InputStride, Output, OutputStride);
+#endif
+    }
+};
+
+template<typename ElementType>
+void
+MlasTransposeStrided(
+    const ElementType* Input,
+    size_t InputStride,
+    ElementType* Output,
+    size_t OutputStride,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns), where the rows of both matrices are
+    separated by the supplied strides.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+    Output - Supplies the output buffer.
+
+    OutputStride - Supplies the number of elements between rows of the output
+        matrix.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = MLAS_TRANSPOSE_ND_BLOCK<ElementType>::BlockSize;
+
+    size_t n = 0;
+
+    for (; n + BlockSize <= N; n += BlockSize) {
+
+        const ElementType* s = Input + n;
+        ElementType* d = Output + OutputStride * n;
+        size_t m = 0;
+
+        for (; m + BlockSize <= M; m += BlockSize) {
+            MLAS_TRANSPOSE_ND_BLOCK<ElementType>::Transpose(&s[InputStride * m], InputStride, &d[m], OutputStride);
+        }
+
+        for (; m < M; m++) {
+            for (size_t nn = 0; nn < BlockSize; nn++) {
+                d[OutputStride * nn + m] = s[InputStride * m + nn];
+            }
+        }
+    }
+
+    for (; n < N; n++) {
+        for (size_t m = 0; m < M; m++) {
+            Output[OutputStride * n + m] = Input[InputStride * m + n];
+        }
+    }
+}
+
+//
+// Define the number of bytes to move per thread for the N-dimensional
+// transpose to be split across threads.
+//
+
+constexpr size_t MLAS_TRANSPOSE_ND_BYTES_PER_THREAD = 64 * 1024;
+
+struct MLAS_TRANSPOSE_ND_AXIS {
+    size_t Count;
+    size_t InputStride;
+    size_t OutputStride;
+};
+
+template<typename InnerRoutine>
+void
+MlasTransposeNDThreaded(
+    const uint8_t* Input,
+    uint8_t* Output,
+    const MLAS_TRANSPOSE_ND_AXIS* Axes,
+    size_t AxisCount,
+    size_t BytesPerUnit,
+    MLAS_THREADPOOL* ThreadPool,
+    InnerRoutine Inner
+    )
+/*++
+
+Routine Description:
+
+    This routine iterates over the index space of the supplied outer axes,
+    split in contiguous ranges across threads, and invokes the inner routine
+    with the byte offsets of each unit of work.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    Axes - Supplies the outer axes, outermost first, with their strides in
+        bytes.
+
+    AxisCount - Supplies the number of outer axes.
+
+    BytesPerUnit - Supplies the approximate number of bytes moved by a unit
+        of work, used to size the number of threads.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+    Inner - Supplies the routine called with the input and output pointers
+        and the index of each unit of work.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t TotalWork = 1;
+
+    for (size_t i = 0; i < AxisCount; i++) {
+        TotalWork *= Axes[i].Count;
+    }
+
+    const size_t TotalBytes = TotalWork * BytesPerUnit;
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > TotalBytes / MLAS_TRANSPOSE_ND_BYTES_PER_THREAD) {
+        ThreadCount = ptrdiff_t(TotalBytes / MLAS_TRANSPOSE_ND_BYTES_PER_THREAD);
+    }
+
+    if (size_t(ThreadCount) > TotalWork) {
+        ThreadCount = ptrdiff_t(TotalWork);
+    }
+
+    if (ThreadCount < 1) {
+        ThreadCount = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool, ThreadCount, [&](ptrdiff_t tid) {
+
+        size_t WorkIndex;
+        size_t WorkRemaining;
+
+        MlasPartitionWork(tid, ThreadCount, TotalWork, &WorkIndex, &WorkRemaining);
+
+        //
+        // Compute the starting index and offsets of this range.
+        //
+
+        size_t Index[MLAS_TRANSPOSE_MAXIMUM_RANK];
+        size_t InputOffset = 0;
+        size_t OutputOffset = 0;
+
+        for (size_t i = AxisCount; i > 0; i--) {
+            const MLAS_TRANSPOSE_ND_AXIS& Axis = Axes[i - 1];
+            Index[i - 1] = WorkIndex % Axis.Count;
+            WorkIndex /= Axis.Count;
+            InputOffset += Index[i - 1] * Axis.InputStride;
+            OutputOffset += Index[i - 1] * Axis.OutputStride;
+        }
+
+        while (WorkRemaining > 0) {
+
+            Inner(Input + InputOffset, Output + OutputOffset, Index);
+
+            //
+            // Advance to the next unit of work.
+            //
+
+            for (size_t i = AxisCount; i > 0; i--) {
+                const MLAS_TRANSPOSE_ND_AXIS& Axis = Axes[i - 1];
+                InputOffset += Axis.InputStride;
+                OutputOffset += Axis.OutputStride;
+                if (++Index[i - 1] < Axis.Count) {
+                    break;
+                }
+                InputOffset -= Axis.Count * Axis.InputStride;
+                OutputOffset -= Axis.Count * Axis.OutputStride;
+                Index[i - 1] = 0;
+            }
+
+            WorkRemaining--;
+        }
+    });
+}
+
+template<typename ElementType>
+void
+MlasTransposeNDTiled(
+    const uint8_t* Input,
+    uint8_t* Output,
+    MLAS_TRANSPOSE_ND_AXIS* Axes,
+    size_t AxisCount,
+    size_t M,
+    size_t InputStride,
+    size_t N,
+    size_t OutputStride,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the inner matrix of M rows by N columns for each
+    index of the outer axes, one cache sized tile at a time.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    Axes - Supplies the outer axes with room for the two tile axes appended
+        by this routine.
+
+    AxisCount - Supplies the number of outer axes.
+
+    M - Supplies the number of rows of the inner input matrix, which is the
+        innermost axis of the output.
+
+    InputStride - Supplies the number of elements between rows of the inner
+        input matrix.
+
+    N - Supplies the number of columns of the inner input matrix, which is the
+        innermost axis of the input.
+
+    OutputStride - Supplies the number of elements between rows of the inner
+        output matrix.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t TileSize = (sizeof(ElementType) == 8) ? 32 : 64;
+
+    //
+    // Append the tile axes: the tiles step along the columns of the input,
+    // then along the columns of the output so that consecutive tiles write
+    // adjacent output.
+    //
+
+    const size_t TileAxisN = AxisCount;
+    const size_t TileAxisM = AxisCount + 1;
+
+    Axes[TileAxisN].Count = (N + TileSize - 1) / TileSize;
+    Axes[TileAxisN].InputStride = TileSize * sizeof(ElementType);
+    Axes[TileAxisN].OutputStride = TileSize * OutputStride * sizeof(ElementType);
+
+    Axes[TileAxisM].Count = (M + TileSize - 1) / TileSize;
+    Axes[TileAxisM].InputStride = TileSize * InputStride * sizeof(ElementType);
+    Axes[TileAxisM].OutputStride = TileSize * sizeof(ElementType);
+
+    MlasTransposeNDThreaded(Input, Output, Axes, AxisCount + 2,
+        TileSize * TileSize * sizeof(ElementType), ThreadPool,
+        [&](const uint8_t* s, uint8_t* d, const size_t* Index) {
+            const size_t TileN = std::min(TileSize, N - Index[TileAxisN] * TileSize);
+            const size_t TileM = std::min(TileSize, M - Index[TileAxisM] * TileSize);
+            MlasTransposeStrided(reinterpret_cast<const ElementType*>(s), InputStride,
+                reinterpret_cast<ElementType*>(d), OutputStride, TileM, TileN);
+        });
+}
+
+void
+MLASCALL
+MlasTransposeND(
+    const void* Input,
+    void* Output,
+    size_t ElementSize,
+    const size_t* InputShape,
+    const size_t* Permutation,
+    size_t Rank,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input tensor to the output tensor, where
+    output axis i is input axis Permutation[i].
+
+    Axes of size one are dropped and input axes that stay adjacent in the
+    output are merged. If the innermost axis is unchanged, the output is
+    copied a row at a time. Otherwise, the matrix formed by the innermost
+    input axis and the input axis that becomes the innermost output axis is
+    transposed in cache sized tiles by the block kernels. The remaining axes
+    and the tiles are split across threads.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    ElementSize - Supplies the size in bytes of an element: 1, 2, 4 or 8.
+
+    InputShape - Supplies the shape of the input tensor.
+
+    Permutation - Supplies the permutation of the input axes.
+
+    Rank - Supplies the number of axes, at most MLAS_TRANSPOSE_MAXIMUM_RANK.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Rank > MLAS_TRANSPOSE_MAXIMUM_RANK) {
+        MLAS_THROW_EX(std::invalid_argument, "transpose rank is too large");
+    }
+
+    if (ElementSize != 1 && ElementSize != 2 && ElementSize != 4 && ElementSize != 8) {
+        MLAS_THROW_EX(std::invalid_argument, "unsupported transpose element size");
+    }
+
+    //
+    // Renumber the input axes that are not of size one.
+    //
+
+    size_t Renumber[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t AxisDims[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t AxisCount = 0;
+    size_t TotalElements = 1;
+
+    for (size_t i = 0; i < Rank; i++) {
+        TotalElements *= InputShape[i];
+        if (InputShape[i] != 1) {
+            Renumber[i] = AxisCount;
+            AxisDims[AxisCount] = InputShape[i];
+            AxisCount++;
+        }
+    }
+
+    if (TotalElements == 0) {
+        return;
+    }
+
+    //
+    // Merge the runs of the output axes that are consecutive input axes.
+    //
+
+    size_t GroupFirst[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t GroupDims[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t GroupCount = 0;
+    size_t PreviousAxis = 0;
+
+    for (size_t i = 0; i < Rank; i++) {
+        if (InputShape[Permutation[i]] == 1) {
+            continue;
+        }
+        const size_t Axis = Renumber[Permutation[i]];
+        if (GroupCount > 0 && Axis == PreviousAxis + 1) {
+            GroupDims[GroupCount - 1] *= AxisDims[Axis];
+        } else {
+            GroupFirst[GroupCount] = Axis;
+            GroupDims[GroupCount] = AxisDims[Axis];
+            GroupCount++;
+        }
+        PreviousAxis = Axis;
+    }
+
+    if (GroupCount <= 1) {
+        std::memcpy(Output, Input, TotalElements * ElementSize);
+        return;
+    }
+
+    //
+    // Build the merged shape and permutation. The input position of a group
+    // is the number of groups that start at an earlier input axis.
+    //
+
+    size_t Dims[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t Perm[MLAS_TRANSPOSE_MAXIMUM_RANK];
+
+    for (size_t g = 0; g < GroupCount; g++) {
+        size_t Position = 0;
+        for (size_t h = 0; h < GroupCount; h++) {
+            Position += (GroupFirst[h] < GroupFirst[g]) ? 1 : 0;
+        }
+        Perm[g] = Position;
+        Dims[Position] = GroupDims[g];
+    }
+
+    const size_t R = GroupCount;
+
+    size_t InputStrides[MLAS_TRANSPOSE_MAXIMUM_RANK];
+    size_t OutputStrides[MLAS_TRANSPOSE_MAXIMUM_RANK];
+
+    InputStrides[R - 1] = 1;
+    OutputStrides[R - 1] = 1;
+
+    for (size_t i = R - 1; i > 0; i--) {
+        InputStrides[i - 1] = InputStrides[i] * Dims[i];
+        OutputStrides[i - 1] = OutputStrides[i] * Dims[Perm[i]];
+    }
+
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(Input);
+    uint8_t* output = reinterpret_cast<uint8_t*>(Output);
+
+    MLAS_TRANSPOSE_ND_AXIS Axes[MLAS_TRANSPOSE_MAXIMUM_RANK + 2];
+    size_t OuterCount = 0;
+
+    if (Perm[R - 1] == R - 1) {
+
+        //
+        // The innermost axis is unchanged: copy the output a row at a time.
+        //
+
+        for (size_t i = 0; i < R - 1; i++) {
+            Axes[OuterCount].Count = Dims[Perm[i]];
+            Axes[OuterCount].InputStride = InputStrides[Perm[i]] * ElementSize;
+            Axes[OuterCount].OutputStride = OutputStrides[i] * ElementSize;
+            OuterCount++;
+        }
+
+        const size_t RowBytes = Dims[R - 1] * ElementSize;
+
+        MlasTransposeNDThreaded(input, output, Axes, OuterCount, RowBytes, ThreadPool,
+            [&](const uint8_t* s, uint8_t* d, const size_t*) {
+                std::memcpy(d, s, RowBytes);
+            });
+
+        return;
+    }
+
+    //
+    // Transpose the matrix formed by the input axis that becomes the
+    // innermost output axis (rows) and the innermost input axis (columns).
+    //
+
+    const size_t AxisM = Perm[R - 1];
+    size_t OutputAxisN = 0;
+
+    for (size_t i = 0; i < R - 1; i++) {
+        if (Perm[i] == R - 1) {
+            OutputAxisN = i;
+        } else {
+            Axes[OuterCount].Count = Dims[Perm[i]];
+            Axes[OuterCount].InputStride = InputStrides[Perm[i]] * ElementSize;
+            Axes[OuterCount].OutputStride = OutputStrides[i] * ElementSize;
+            OuterCount++;
+        }
+    }
+
+    const size_t M = Dims[AxisM];
+    const size_t N = Dims[R - 1];
+    const size_t InputStride = InputStrides[AxisM];
+    const size_t OutputStride = OutputStrides[OutputAxisN];
+
+    switch (ElementSize) {
+        case 1:
+            MlasTransposeNDTiled<uint8_t>(input, output, Axes, OuterCount, M, InputStride, N, OutputStride, ThreadPool);
+            break;
+        case 2:
+            MlasTransposeNDTiled<uint16_t>(input, output, Axes, OuterCount, M, InputStride, N, OutputStride, ThreadPool);
+            break;
+        case 4:
+            MlasTransposeNDTiled<uint32_t>(input, output, Axes, OuterCount, M, InputStride, N, OutputStride, ThreadPool);
+            break;
+        default:
+            MlasTransposeNDTiled<uint64_t>(input, output, Axes, OuterCount, M, InputStride, N, OutputStride, ThreadPool);
+            break;
+    }
+}
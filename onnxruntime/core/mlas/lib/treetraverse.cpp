@@ -0,0 +1,204 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    treetraverse.cpp
+
+Abstract:
+
+    This module implements the routine to walk rows of features through a
+    decision tree compiled into flat arrays.
+
+    Each step selects the next node of a row with a comparison instead of a
+    branch, so rows are walked in lockstep: the portable kernel interleaves
+    four rows, the vector kernels gather the features of a row per lane.
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+#include <functional>
+
+template <typename Compare>
+void
+MlasTreeTraverseKernel(
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    )
+{
+    const Compare Comparison;
+
+    auto NextNode = [&](int32_t Node, const float* Row) {
+        const int32_t FeatureId = FeatureIds[Node];
+        const int32_t MissingTrack = FeatureId >> 31;
+        const float Value = Row[FeatureId ^ MissingTrack];
+        const int32_t IsTrue = int32_t(Comparison(Value, Thresholds[Node])) |
+                               (MissingTrack & int32_t(std::isnan(Value)));
+        return Children[2 * Node + IsTrue];
+    };
+
+    //
+    // Interleave the rows so that the loads of one row overlap those of the
+    // others.
+    //
+
+    while (Rows >= 4) {
+
+        int32_t Node0 = Root;
+        int32_t Node1 = Root;
+        int32_t Node2 = Root;
+        int32_t Node3 = Root;
+
+        for (size_t d = 0; d < Depth; d++) {
+            Node0 = NextNode(Node0, Input);
+            Node1 = NextNode(Node1, Input + Stride);
+            Node2 = NextNode(Node2, Input + 2 * Stride);
+            Node3 = NextNode(Node3, Input + 3 * Stride);
+        }
+
+        Leaves[0] = Node0;
+        Leaves[1] = Node1;
+        Leaves[2] = Node2;
+        Leaves[3] = Node3;
+
+        Input += 4 * Stride;
+        Leaves += 4;
+        Rows -= 4;
+    }
+
+    while (Rows > 0) {
+
+        int32_t Node = Root;
+
+        for (size_t d = 0; d < Depth; d++) {
+            Node = NextNode(Node, Input);
+        }
+
+        *Leaves++ = Node;
+
+        Input += Stride;
+        Rows--;
+    }
+}
+
+void
+MLASCALL
+MlasTreeTraverseKernelDefault(
+    MLAS_TREE_NODE_MODE Mode,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    )
+{
+    switch (Mode) {
+        case MlasTreeNodeLeq:
+            MlasTreeTraverseKernel<std::less_equal<float>>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                           Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeLt:
+            MlasTreeTraverseKernel<std::less<float>>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                     Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeGte:
+            MlasTreeTraverseKernel<std::greater_equal<float>>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                              Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeGt:
+            MlasTreeTraverseKernel<std::greater<float>>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                        Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeEq:
+            MlasTreeTraverseKernel<std::equal_to<float>>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                         Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeNeq:
+            MlasTreeTraverseKernel<std::not_equal_to<float>>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                             Stride, Rows, Leaves);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasTreeTraverse(
+    MLAS_TREE_NODE_MODE Mode,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    )
+/*++
+
+Routine Description:
+
+    This routine walks rows of features through a decision tree compiled into
+    flat arrays and returns the leaf each row reaches.
+
+Arguments:
+
+    Mode - Supplies the comparison of all the nodes.
+
+    FeatureIds - Supplies the feature of each node, complemented when a
+        missing feature takes the true branch of the node.
+
+    Thresholds - Supplies the threshold of each node.
+
+    Children - Supplies the false and true children of each node.
+
+    Root - Supplies the index of the first node.
+
+    Depth - Supplies the number of steps from the root to the deepest leaf.
+
+    Input - Supplies the address of the first row.
+
+    Stride - Supplies the distance between two rows.
+
+    Rows - Supplies the number of rows.
+
+    Leaves - Supplies the buffer that receives the index of the leaf reached
+        by each row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    //
+    // The vector kernels address the features of a block of 16 rows with 32
+    // bit offsets.
+    //
+
+    if (GetMlasPlatform().TreeTraverseKernel != nullptr && Stride < (size_t(1) << 26)) {
+        GetMlasPlatform().TreeTraverseKernel(Mode, FeatureIds, Thresholds, Children, Root, Depth, Input, Stride,
+                                             Rows, Leaves);
+        return;
+    }
+#endif
+
+    MlasTreeTraverseKernelDefault(Mode, FeatureIds, Thresholds, Children, Root, Depth, Input, Stride, Rows, Leaves);
+}
@@ -0,0 +1,136 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    treetraverse_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel to walk rows of features through a
+    compiled decision tree for AVX2.
+
+    Eight rows are walked in lockstep, one per lane: each step gathers the
+    feature, threshold and feature value of the node of every row, and the
+    compare mask selects the child of the node.
+
+--*/
+
+#include "mlasi.h"
+
+#include <immintrin.h>
+
+template <int Predicate>
+void
+MlasTreeTraverseKernelAvx2Impl(
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    )
+{
+    const __m256i LaneIndices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i StrideBroadcast = _mm256_set1_epi32(int32_t(Stride));
+
+    while (Rows > 0) {
+
+        const size_t BlockRows = std::min(Rows, size_t(8));
+
+        //
+        // The lanes past the last row walk the last row again.
+        //
+
+        const __m256i RowIndices = _mm256_min_epi32(LaneIndices, _mm256_set1_epi32(int32_t(BlockRows - 1)));
+        const __m256i RowOffsets = _mm256_mullo_epi32(RowIndices, StrideBroadcast);
+
+        __m256i Nodes = _mm256_set1_epi32(Root);
+
+        for (size_t d = 0; d < Depth; d++) {
+
+            __m256i Features = _mm256_i32gather_epi32(FeatureIds, Nodes, 4);
+            const __m256i MissingTracks = _mm256_srai_epi32(Features, 31);
+            Features = _mm256_xor_si256(Features, MissingTracks);
+
+            const __m256 Values = _mm256_i32gather_ps(Input, _mm256_add_epi32(RowOffsets, Features), 4);
+            const __m256 NodeThresholds = _mm256_i32gather_ps(Thresholds, Nodes, 4);
+
+            __m256 IsTrue = _mm256_cmp_ps(Values, NodeThresholds, Predicate);
+            const __m256 IsMissing = _mm256_cmp_ps(Values, Values, _CMP_UNORD_Q);
+            IsTrue = _mm256_or_ps(IsTrue, _mm256_and_ps(IsMissing, _mm256_castsi256_ps(MissingTracks)));
+
+            //
+            // The true child follows the false child, and a true lane of the
+            // mask is -1.
+            //
+
+            const __m256i ChildIndices = _mm256_sub_epi32(_mm256_add_epi32(Nodes, Nodes), _mm256_castps_si256(IsTrue));
+            Nodes = _mm256_i32gather_epi32(Children, ChildIndices, 4);
+        }
+
+        if (BlockRows == 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(Leaves), Nodes);
+        } else {
+            const __m256i StoreMask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t(BlockRows)), LaneIndices);
+            _mm256_maskstore_epi32(Leaves, StoreMask, Nodes);
+        }
+
+        Input += BlockRows * Stride;
+        Leaves += BlockRows;
+        Rows -= BlockRows;
+    }
+}
+
+void
+MLASCALL
+MlasTreeTraverseKernelAvx2(
+    MLAS_TREE_NODE_MODE Mode,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    )
+{
+    //
+    // The comparisons of a NaN are false, except for not equal.
+    //
+
+    switch (Mode) {
+        case MlasTreeNodeLeq:
+            MlasTreeTraverseKernelAvx2Impl<_CMP_LE_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input, Stride,
+                                                       Rows, Leaves);
+            break;
+        case MlasTreeNodeLt:
+            MlasTreeTraverseKernelAvx2Impl<_CMP_LT_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input, Stride,
+                                                       Rows, Leaves);
+            break;
+        case MlasTreeNodeGte:
+            MlasTreeTraverseKernelAvx2Impl<_CMP_GE_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input, Stride,
+                                                       Rows, Leaves);
+            break;
+        case MlasTreeNodeGt:
+            MlasTreeTraverseKernelAvx2Impl<_CMP_GT_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input, Stride,
+                                                       Rows, Leaves);
+            break;
+        case MlasTreeNodeEq:
+            MlasTreeTraverseKernelAvx2Impl<_CMP_EQ_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input, Stride,
+                                                       Rows, Leaves);
+            break;
+        case MlasTreeNodeNeq:
+            MlasTreeTraverseKernelAvx2Impl<_CMP_NEQ_UQ>(FeatureIds, Thresholds, Children, Root, Depth, Input, Stride,
+                                                        Rows, Leaves);
+            break;
+    }
+}
@@ -0,0 +1,132 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    treetraverse_kernel_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel to walk rows of features through a
+    compiled decision tree for AVX512F.
+
+    Sixteen rows are walked in lockstep, one per lane: each step gathers the
+    feature, threshold and feature value of the node of every row, and the
+    compare mask selects the child of the node.
+
+--*/
+
+#include "mlasi.h"
+
+#include <immintrin.h>
+
+template <int Predicate>
+void
+MlasTreeTraverseKernelAvx512FImpl(
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    )
+{
+    const __m512i LaneIndices = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i StrideBroadcast = _mm512_set1_epi32(int32_t(Stride));
+    const __m512i ZeroBroadcast = _mm512_setzero_si512();
+    const __m512i OneBroadcast = _mm512_set1_epi32(1);
+
+    while (Rows > 0) {
+
+        const size_t BlockRows = std::min(Rows, size_t(16));
+
+        //
+        // The lanes past the last row walk the last row again.
+        //
+
+        const __m512i RowIndices = _mm512_min_epi32(LaneIndices, _mm512_set1_epi32(int32_t(BlockRows - 1)));
+        const __m512i RowOffsets = _mm512_mullo_epi32(RowIndices, StrideBroadcast);
+
+        __m512i Nodes = _mm512_set1_epi32(Root);
+
+        for (size_t d = 0; d < Depth; d++) {
+
+            __m512i Features = _mm512_i32gather_epi32(Nodes, FeatureIds, 4);
+            const __mmask16 MissingTracks = _mm512_cmplt_epi32_mask(Features, ZeroBroadcast);
+            Features = _mm512_xor_si512(Features, _mm512_srai_epi32(Features, 31));
+
+            const __m512 Values = _mm512_i32gather_ps(_mm512_add_epi32(RowOffsets, Features), Input, 4);
+            const __m512 NodeThresholds = _mm512_i32gather_ps(Nodes, Thresholds, 4);
+
+            const __mmask16 IsTrue = _mm512_cmp_ps_mask(Values, NodeThresholds, Predicate) |
+                                     (_mm512_cmp_ps_mask(Values, Values, _CMP_UNORD_Q) & MissingTracks);
+
+            //
+            // The true child follows the false child.
+            //
+
+            const __m512i FalseIndices = _mm512_add_epi32(Nodes, Nodes);
+            const __m512i ChildIndices = _mm512_mask_add_epi32(FalseIndices, IsTrue, FalseIndices, OneBroadcast);
+            Nodes = _mm512_i32gather_epi32(ChildIndices, Children, 4);
+        }
+
+        _mm512_mask_storeu_epi32(Leaves, __mmask16((1u << BlockRows) - 1), Nodes);
+
+        Input += BlockRows * Stride;
+        Leaves += BlockRows;
+        Rows -= BlockRows;
+    }
+}
+
+void
+MLASCALL
+MlasTreeTraverseKernelAvx512F(
+    MLAS_TREE_NODE_MODE Mode,
+    const int32_t* FeatureIds,
+    const float* Thresholds,
+    const int32_t* Children,
+    int32_t Root,
+    size_t Depth,
+    const float* Input,
+    size_t Stride,
+    size_t Rows,
+    int32_t* Leaves
+    )
+{
+    //
+    // The comparisons of a NaN are false, except for not equal.
+    //
+
+    switch (Mode) {
+        case MlasTreeNodeLeq:
+            MlasTreeTraverseKernelAvx512FImpl<_CMP_LE_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                          Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeLt:
+            MlasTreeTraverseKernelAvx512FImpl<_CMP_LT_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                          Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeGte:
+            MlasTreeTraverseKernelAvx512FImpl<_CMP_GE_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                          Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeGt:
+            MlasTreeTraverseKernelAvx512FImpl<_CMP_GT_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                          Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeEq:
+            MlasTreeTraverseKernelAvx512FImpl<_CMP_EQ_OQ>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                          Stride, Rows, Leaves);
+            break;
+        case MlasTreeNodeNeq:
+            MlasTreeTraverseKernelAvx512FImpl<_CMP_NEQ_UQ>(FeatureIds, Thresholds, Children, Root, Depth, Input,
+                                                           Stride, Rows, Leaves);
+            break;
+    }
+}
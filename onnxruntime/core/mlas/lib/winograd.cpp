@@ -0,0 +1,712 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    winograd.cpp
+
+Abstract:
+
+    This module implements the single precision Winograd F(4x4, 3x3)
+    convolution for 3x3 convolutions with unit stride and dilation.
+
+    Each 4x4 tile of the output is computed from the 6x6 tile of the input
+    that covers it. The input tiles are transformed, each of the 36 points of
+    the transformed tiles is multiplied by the transformed filters as a GEMM
+    over the input channels, and the products are transformed back to the
+    output tiles. This takes 36 multiplies per output tile and channel pair
+    instead of 144. The filters are transformed and packed for the GEMMs
+    once, by MlasConvWinogradPackW.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the tile sizes of the F(4x4, 3x3) transforms.
+//
+
+constexpr size_t MLAS_WINOGRAD_OUTPUT_TILE = 4;
+constexpr size_t MLAS_WINOGRAD_INPUT_TILE = 6;
+constexpr size_t MLAS_WINOGRAD_TILE_POINTS = MLAS_WINOGRAD_INPUT_TILE * MLAS_WINOGRAD_INPUT_TILE;
+
+//
+// Define the number of working buffer elements a thread uses to transform a
+// block of tiles, which bounds the number of tiles in a block.
+//
+
+constexpr size_t MLAS_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD = 256 * 1024;
+
+//
+// Define the smallest number of channels that the Winograd algorithm is used
+// for. With fewer channels the transforms cost more than the multiplies they
+// save.
+//
+
+constexpr size_t MLAS_WINOGRAD_MINIMUM_CHANNELS = 16;
+
+//
+// Define the parameters to execute blocks of tiles on worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const uint8_t* PackedFilter;
+    float* WorkingBuffer;
+    float* Output;
+    size_t TileCount;
+};
+
+template<typename T>
+MLAS_FORCEINLINE
+void
+MlasWinogradFilterTransform(
+    const T* g,
+    size_t gStride,
+    T* u,
+    size_t uStride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes G * g for a column of 3 filter elements, where G is
+    the 6x3 filter transform matrix.
+
+--*/
+{
+    const T g0 = g[0];
+    const T g1 = g[gStride];
+    const T g2 = g[2 * gStride];
+
+    u[0] = g0 / T(4);
+    u[uStride] = -(g0 + g1 + g2) / T(6);
+    u[2 * uStride] = -(g0 - g1 + g2) / T(6);
+    u[3 * uStride] = g0 / T(24) + g1 / T(12) + g2 / T(6);
+    u[4 * uStride] = g0 / T(24) - g1 / T(12) + g2 / T(6);
+    u[5 * uStride] = g2;
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradInputTransform(
+    const float* d,
+    size_t dStride,
+    float* v,
+    size_t vStride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes B^T * d for a column of 6 input elements, where B^T
+    is the 6x6 input transform matrix.
+
+--*/
+{
+    const float d0 = d[0];
+    const float d1 = d[dStride];
+    const float d2 = d[2 * dStride];
+    const float d3 = d[3 * dStride];
+    const float d4 = d[4 * dStride];
+    const float d5 = d[5 * dStride];
+
+    v[0] = 4.0f * d0 - 5.0f * d2 + d4;
+    v[vStride] = -4.0f * (d1 + d2) + d3 + d4;
+    v[2 * vStride] = 4.0f * (d1 - d2) - d3 + d4;
+    v[3 * vStride] = 2.0f * (d3 - d1) - d2 + d4;
+    v[4 * vStride] = 2.0f * (d1 - d3) - d2 + d4;
+    v[5 * vStride] = 4.0f * d1 - 5.0f * d3 + d5;
+}
+
+MLAS_FORCEINLINE
+void
+MlasWinogradOutputTransform(
+    const float* m,
+    size_t mStride,
+    float* y,
+    size_t yStride
+    )
+/*++
+
+Routine Description:
+
+    This routine computes A^T * m for a column of 6 transformed products,
+    where A^T is the 4x6 output transform matrix.
+
+--*/
+{
+    const float m0 = m[0];
+    const float m1 = m[mStride];
+    const float m2 = m[2 * mStride];
+    const float m3 = m[3 * mStride];
+    const float m4 = m[4 * mStride];
+    const float m5 = m[5 * mStride];
+
+    const float Sum12 = m1 + m2;
+    const float Difference12 = m1 - m2;
+    const float Sum34 = m3 + m4;
+    const float Difference34 = m3 - m4;
+
+    y[0] = m0 + Sum12 + Sum34;
+    y[yStride] = Difference12 + 2.0f * Difference34;
+    y[2 * yStride] = Sum12 + 4.0f * Sum34;
+    y[3 * yStride] = Difference12 + 8.0f * Difference34 + m5;
+}
+
+bool
+MlasConvWinogradIsSupported(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the Winograd algorithm suits the
+    convolution: a 2D 3x3 convolution with unit stride and dilation, with
+    enough input and output channels for the transforms to pay off.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+Return Value:
+
+    Returns true if the convolution should use the Winograd algorithm.
+
+--*/
+{
+    return Parameters->Dimensions == 2 &&
+        Parameters->KernelShape[0] == 3 && Parameters->KernelShape[1] == 3 &&
+        Parameters->StrideShape[0] == 1 && Parameters->StrideShape[1] == 1 &&
+        Parameters->DilationShape[0] == 1 && Parameters->DilationShape[1] == 1 &&
+        Parameters->InputChannels >= MLAS_WINOGRAD_MINIMUM_CHANNELS &&
+        Parameters->FilterCount >= MLAS_WINOGRAD_MINIMUM_CHANNELS &&
+        Parameters->OutputShape[0] >= MLAS_WINOGRAD_OUTPUT_TILE &&
+        Parameters->OutputShape[1] >= MLAS_WINOGRAD_OUTPUT_TILE;
+}
+
+size_t
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine splits the output tiles of a Winograd convolution into
+    blocks for the threads and computes the working buffer size.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters, and receives the tile block size and thread count.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns the number of elements of the working buffer.
+
+--*/
+{
+    const size_t TileCount =
+        ((Parameters->OutputShape[0] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE) *
+        ((Parameters->OutputShape[1] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE);
+
+    //
+    // A tile takes the transformed input and the products of all the channels
+    // at the 36 points.
+    //
+
+    const size_t ElementsPerTile =
+        MLAS_WINOGRAD_TILE_POINTS * (Parameters->InputChannels + Parameters->FilterCount);
+
+    size_t MaximumBlockSize = MLAS_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD / ElementsPerTile;
+
+    if (MaximumBlockSize == 0) {
+        MaximumBlockSize = 1;
+    }
+
+    //
+    // Split the tiles evenly between the threads, unless the blocks would be
+    // too large for the working buffer.
+    //
+
+    ptrdiff_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > TileCount) {
+        ThreadCount = ptrdiff_t(TileCount);
+    }
+
+    size_t BlockSize = (TileCount + ThreadCount - 1) / ThreadCount;
+
+    if (BlockSize > MaximumBlockSize) {
+        BlockSize = MaximumBlockSize;
+    }
+
+    const size_t BlockCount = (TileCount + BlockSize - 1) / BlockSize;
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = ptrdiff_t(BlockCount);
+    }
+
+    Parameters->ThreadCount = ThreadCount;
+    Parameters->u.Winograd.TileBlockSize = BlockSize;
+
+    return size_t(ThreadCount) * BlockSize * ElementsPerTile;
+}
+
+void
+MlasConvWinogradBlock(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const uint8_t* PackedFilter,
+    float* WorkingBuffer,
+    float* Output,
+    size_t TileStart,
+    size_t TileCount,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output tiles of a Winograd convolution
+    for a batch and group.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the batch and group.
+
+    PackedFilter - Supplies the filter of the group packed by
+        MlasConvWinogradPackW.
+
+    WorkingBuffer - Supplies the working buffer of the thread.
+
+    Output - Supplies the output tensor of the batch and group.
+
+    TileStart - Supplies the index of the first output tile of the block.
+
+    TileCount - Supplies the number of output tiles of the block.
+
+    ThreadPool - Supplies the thread pool object to run the GEMMs on, else
+        nullptr to run them on the calling thread.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileCountW = (OutputWidth + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE;
+    const float Beta = Parameters->Beta;
+
+    //
+    // The transformed input holds a TileCount x InputChannels matrix for each
+    // point, and the products a TileCount x FilterCount matrix.
+    //
+
+    float* TransformedInput = WorkingBuffer;
+    float* Products = WorkingBuffer + MLAS_WINOGRAD_TILE_POINTS * TileCount * InputChannels;
+
+    const size_t InputPointStride = TileCount * InputChannels;
+    const size_t ProductPointStride = TileCount * FilterCount;
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t Tile = TileStart + t;
+        const size_t ih0 = (Tile / TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE - PaddingTop;
+        const size_t iw0 = (Tile % TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE - PaddingLeft;
+
+        //
+        // Tiles inside the input are read in place, the others are copied
+        // with the padding and the elements past the end of the input
+        // replaced by zeros. The subtraction of the padding wraps around, so
+        // an unsigned comparison checks both ends.
+        //
+
+        const bool TileIsInside = ih0 + MLAS_WINOGRAD_INPUT_TILE <= InputHeight &&
+            iw0 + MLAS_WINOGRAD_INPUT_TILE <= InputWidth && ih0 < InputHeight && iw0 < InputWidth;
+
+        const float* input = Input;
+        float* v = TransformedInput + t * InputChannels;
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            float d[MLAS_WINOGRAD_TILE_POINTS];
+            const float* TileData;
+            size_t TileStride;
+
+            if (TileIsInside) {
+
+                TileData = input + ih0 * InputWidth + iw0;
+                TileStride = InputWidth;
+
+            } else {
+
+                for (size_t y = 0; y < MLAS_WINOGRAD_INPUT_TILE; y++) {
+                    const size_t ih = ih0 + y;
+                    for (size_t x = 0; x < MLAS_WINOGRAD_INPUT_TILE; x++) {
+                        const size_t iw = iw0 + x;
+                        d[y * MLAS_WINOGRAD_INPUT_TILE + x] =
+                            (ih < InputHeight && iw < InputWidth) ? input[ih * InputWidth + iw] : 0.0f;
+                    }
+                }
+
+                TileData = d;
+                TileStride = MLAS_WINOGRAD_INPUT_TILE;
+            }
+
+            //
+            // Compute B^T * d * B, transforming the columns and then the rows.
+            //
+
+            float Columns[MLAS_WINOGRAD_TILE_POINTS];
+
+            for (size_t x = 0; x < MLAS_WINOGRAD_INPUT_TILE; x++) {
+                MlasWinogradInputTransform(TileData + x, TileStride, Columns + x, MLAS_WINOGRAD_INPUT_TILE);
+            }
+
+            for (size_t y = 0; y < MLAS_WINOGRAD_INPUT_TILE; y++) {
+                MlasWinogradInputTransform(Columns + y * MLAS_WINOGRAD_INPUT_TILE, 1,
+                    v + y * MLAS_WINOGRAD_INPUT_TILE * InputPointStride, InputPointStride);
+            }
+
+            input += InputSize;
+            v++;
+        }
+    }
+
+    //
+    // Multiply the transformed input by the transformed filter at each point.
+    //
+
+    const size_t PackedPointSize = MlasGemmPackBSize(FilterCount, InputChannels);
+
+    MLAS_SGEMM_DATA_PARAMS Data[MLAS_WINOGRAD_TILE_POINTS];
+
+    for (size_t p = 0; p < MLAS_WINOGRAD_TILE_POINTS; p++) {
+        Data[p].A = TransformedInput + p * InputPointStride;
+        Data[p].lda = InputChannels;
+        Data[p].B = reinterpret_cast<const float*>(PackedFilter + p * PackedPointSize);
+        Data[p].BIsPacked = true;
+        Data[p].C = Products + p * ProductPointStride;
+        Data[p].ldc = FilterCount;
+    }
+
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, TileCount, FilterCount, InputChannels, Data,
+        MLAS_WINOGRAD_TILE_POINTS, ThreadPool);
+
+    //
+    // Transform the products back to the output tiles.
+    //
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t Tile = TileStart + t;
+        const size_t oh0 = (Tile / TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE;
+        const size_t ow0 = (Tile % TileCountW) * MLAS_WINOGRAD_OUTPUT_TILE;
+        const size_t RowCount = std::min(MLAS_WINOGRAD_OUTPUT_TILE, OutputHeight - oh0);
+        const size_t ColumnCount = std::min(MLAS_WINOGRAD_OUTPUT_TILE, OutputWidth - ow0);
+
+        const float* m = Products + t * FilterCount;
+        float* output = Output + oh0 * OutputWidth + ow0;
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            //
+            // Compute A^T * m * A, transforming the columns and then the rows.
+            //
+
+            float Columns[MLAS_WINOGRAD_OUTPUT_TILE * MLAS_WINOGRAD_INPUT_TILE];
+            float y[MLAS_WINOGRAD_OUTPUT_TILE * MLAS_WINOGRAD_OUTPUT_TILE];
+
+            for (size_t x = 0; x < MLAS_WINOGRAD_INPUT_TILE; x++) {
+                MlasWinogradOutputTransform(m + x * ProductPointStride, MLAS_WINOGRAD_INPUT_TILE * ProductPointStride,
+                    Columns + x, MLAS_WINOGRAD_INPUT_TILE);
+            }
+
+            for (size_t r = 0; r < MLAS_WINOGRAD_OUTPUT_TILE; r++) {
+                MlasWinogradOutputTransform(Columns + r * MLAS_WINOGRAD_INPUT_TILE, 1,
+                    y + r * MLAS_WINOGRAD_OUTPUT_TILE, 1);
+            }
+
+            for (size_t r = 0; r < RowCount; r++) {
+                for (size_t x = 0; x < ColumnCount; x++) {
+                    float& Value = output[r * OutputWidth + x];
+                    Value = (Beta == 0.0f) ? y[r * MLAS_WINOGRAD_OUTPUT_TILE + x] :
+                        y[r * MLAS_WINOGRAD_OUTPUT_TILE + x] + Beta * Value;
+                }
+            }
+
+            m++;
+            output += OutputSize;
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to compute the blocks of
+    output tiles of a thread.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<MLAS_CONV_WINOGRAD_WORK_BLOCK*>(Context);
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t ThreadCount = size_t(Parameters->ThreadCount);
+    const size_t BlockSize = Parameters->u.Winograd.TileBlockSize;
+    const size_t TileCount = WorkBlock->TileCount;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer + size_t(Index) * BlockSize *
+        MLAS_WINOGRAD_TILE_POINTS * (Parameters->InputChannels + Parameters->FilterCount);
+
+    for (size_t TileStart = size_t(Index) * BlockSize; TileStart < TileCount; TileStart += ThreadCount * BlockSize) {
+        MlasConvWinogradBlock(Parameters, WorkBlock->Input, WorkBlock->PackedFilter, WorkingBuffer,
+            WorkBlock->Output, TileStart, std::min(BlockSize, TileCount - TileStart), nullptr);
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const uint8_t* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution of a batch and group.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the batch and group.
+
+    PackedFilter - Supplies the filter of the group packed by
+        MlasConvWinogradPackW.
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor of the batch and group.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TileCount =
+        ((Parameters->OutputShape[0] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE) *
+        ((Parameters->OutputShape[1] + MLAS_WINOGRAD_OUTPUT_TILE - 1) / MLAS_WINOGRAD_OUTPUT_TILE);
+
+    if (Parameters->ThreadCount > 1) {
+
+        MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.PackedFilter = PackedFilter;
+        WorkBlock.WorkingBuffer = WorkingBuffer;
+        WorkBlock.Output = Output;
+        WorkBlock.TileCount = TileCount;
+
+        MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+
+    } else {
+
+        //
+        // The tiles fit in a few blocks, so let the GEMMs of each block use
+        // the thread pool instead.
+        //
+
+        const size_t BlockSize = Parameters->u.Winograd.TileBlockSize;
+
+        for (size_t TileStart = 0; TileStart < TileCount; TileStart += BlockSize) {
+            MlasConvWinogradBlock(Parameters, Input, PackedFilter, WorkingBuffer, Output, TileStart,
+                std::min(BlockSize, TileCount - TileStart), ThreadPool);
+        }
+    }
+
+    //
+    // Apply the activation with optional bias.
+    //
+
+    MlasActivation(Parameters->Activation, Output, Bias, Parameters->FilterCount,
+        Parameters->OutputSize, Parameters->OutputSize);
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackWSize(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes of the filter packed for the
+    Winograd convolution.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the size in bytes of the packed filter buffer, or 0 if the
+    convolution has too few channels for the Winograd algorithm.
+
+--*/
+{
+    if (InputChannels < MLAS_WINOGRAD_MINIMUM_CHANNELS || FilterCount < MLAS_WINOGRAD_MINIMUM_CHANNELS) {
+        return 0;
+    }
+
+    return GroupCount * MLAS_WINOGRAD_TILE_POINTS * MlasGemmPackBSize(FilterCount, InputChannels);
+}
+
+void
+MLASCALL
+MlasConvWinogradPackW(
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    void* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters of a convolution to the 6x6
+    Winograd domain and packs the matrix of each of the 36 points for the
+    GEMMs of MlasConv.
+
+    The transform G * g * G^T is computed in double precision, so the packed
+    filter is rounded once.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of output channels per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor, with shape [GroupCount * FilterCount,
+        InputChannels, 3, 3].
+
+    PackedFilter - Supplies the buffer sized to MlasConvWinogradPackWSize that
+        receives the packed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PointStride = FilterCount * InputChannels;
+    const size_t PackedPointSize = MlasGemmPackBSize(FilterCount, InputChannels);
+
+    //
+    // The transformed filter holds a FilterCount x InputChannels matrix for
+    // each point, which is the transposed B matrix of the point's GEMM.
+    //
+
+    std::unique_ptr<float[]> TransformedFilter(new float[MLAS_WINOGRAD_TILE_POINTS * PointStride]);
+
+    uint8_t* packed = static_cast<uint8_t*>(PackedFilter);
+
+    for (size_t g = 0; g < GroupCount; g++) {
+
+        for (size_t fc = 0; fc < PointStride; fc++) {
+
+            double Kernel[9];
+            double Columns[MLAS_WINOGRAD_INPUT_TILE * 3];
+            double u[MLAS_WINOGRAD_TILE_POINTS];
+
+            for (size_t k = 0; k < 9; k++) {
+                Kernel[k] = double(Filter[k]);
+            }
+
+            for (size_t x = 0; x < 3; x++) {
+                MlasWinogradFilterTransform(Kernel + x, 3, Columns + x, 3);
+            }
+
+            for (size_t y = 0; y < MLAS_WINOGRAD_INPUT_TILE; y++) {
+                MlasWinogradFilterTransform(Columns + y * 3, 1, u + y * MLAS_WINOGRAD_INPUT_TILE, 1);
+            }
+
+            for (size_t p = 0; p < MLAS_WINOGRAD_TILE_POINTS; p++) {
+                TransformedFilter[p * PointStride + fc] = float(u[p]);
+            }
+
+            Filter += 9;
+        }
+
+        for (size_t p = 0; p < MLAS_WINOGRAD_TILE_POINTS; p++) {
+            MlasGemmPackB(CblasTrans, FilterCount, InputChannels, TransformedFilter.get() + p * PointStride,
+                InputChannels, packed);
+            packed += PackedPointSize;
+        }
+    }
+}
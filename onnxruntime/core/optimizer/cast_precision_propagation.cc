@@ -0,0 +1,444 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/cast_precision_propagation.h"
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+
+#include "core/framework/data_types.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr int32_t kFloat = TensorProto_DataType_FLOAT;
+constexpr int32_t kFloat16 = TensorProto_DataType_FLOAT16;
+
+// ops whose result rounded to float16 equals their result on the inputs rounded to float16, as they only move or
+// select values, or are monotonic and keep the sign. They give the same values in float and float16.
+const InlinedHashSet<std::string_view> kValuePreservingOps = {
+    "Identity", "Transpose", "Reshape", "Squeeze", "Unsqueeze", "Flatten", "Concat", "Split", "Slice",
+    "Expand", "Tile", "Gather", "DepthToSpace", "SpaceToDepth", "Relu", "Max", "Min", "Abs", "Neg",
+    "MaxPool", "GlobalMaxPool"};
+
+// ops that compute new values. They may move from float16 to float, and from float to float16 if allowed.
+const InlinedHashSet<std::string_view> kArithmeticOps = {
+    "Add", "Sub", "Mul", "Div", "Sqrt", "Erf", "Sigmoid", "Tanh", "LeakyRelu", "AveragePool", "GlobalAveragePool"};
+
+std::optional<int32_t> GetFloatType(const NodeArg& arg) {
+  if (!arg.Exists() || arg.TypeAsProto() == nullptr || !arg.TypeAsProto()->has_tensor_type()) {
+    return std::nullopt;
+  }
+
+  const int32_t type = arg.TypeAsProto()->tensor_type().elem_type();
+  return type == kFloat || type == kFloat16 ? std::optional<int32_t>{type} : std::nullopt;
+}
+
+// The type of all float inputs and outputs of a node the pass may switch to the other type.
+std::optional<int32_t> GetSwitchableType(const Node& node) {
+  if (node.Domain() != kOnnxDomain || node.Op() == nullptr || node.ContainsSubgraph() ||
+      node.GetExecutionProviderType().empty() ||
+      (kValuePreservingOps.find(node.OpType()) == kValuePreservingOps.end() &&
+       kArithmeticOps.find(node.OpType()) == kArithmeticOps.end())) {
+    return std::nullopt;
+  }
+
+  std::optional<int32_t> type;
+  bool mixed = false;
+  node.ForEachDef([&](const NodeArg& arg, bool /*is_input*/) {
+    if (auto arg_type = GetFloatType(arg)) {
+      mixed = mixed || (type.has_value() && *type != *arg_type);
+      type = arg_type;
+    }
+  });
+  return mixed ? std::nullopt : type;
+}
+
+bool IsCastTo(const Node& node, int32_t type) {
+  if (node.OpType() != "Cast" || node.Domain() != kOnnxDomain) {
+    return false;
+  }
+  const auto* to = graph_utils::GetNodeAttribute(node, "to");
+  return to != nullptr && to->i() == type;
+}
+
+TypeProto WithElemType(const NodeArg& arg, int32_t type) {
+  TypeProto type_proto(*arg.TypeAsProto());
+  type_proto.mutable_tensor_type()->set_elem_type(type);
+  return type_proto;
+}
+
+// Connected nodes on the same EP whose float values between them have the same type.
+struct Region {
+  InlinedVector<Node*> nodes;
+  InlinedHashSet<NodeIndex> node_indices;
+
+  bool Contains(const Node& node) const { return node_indices.find(node.Index()) != node_indices.end(); }
+};
+
+std::vector<Region> FindRegions(Graph& graph) {
+  std::vector<Region> regions;
+  InlinedHashSet<NodeIndex> visited;
+
+  GraphViewer graph_viewer(graph);
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    Node* start = graph.GetNode(node_index);
+    if (start == nullptr || visited.find(node_index) != visited.end()) {
+      continue;
+    }
+    const auto type = GetSwitchableType(*start);
+    if (!type.has_value()) {
+      continue;
+    }
+
+    Region region;
+    std::deque<Node*> to_visit{start};
+    visited.insert(node_index);
+    auto visit = [&](const Node& node, const NodeArg& arg) {
+      if (visited.find(node.Index()) == visited.end() && GetFloatType(arg) == type &&
+          node.GetExecutionProviderType() == start->GetExecutionProviderType() && GetSwitchableType(node) == type) {
+        visited.insert(node.Index());
+        to_visit.push_back(graph.GetNode(node.Index()));
+      }
+    };
+
+    while (!to_visit.empty()) {
+      Node* node = to_visit.front();
+      to_visit.pop_front();
+      region.nodes.push_back(node);
+      region.node_indices.insert(node->Index());
+
+      for (auto it = node->InputEdgesBegin(), end = node->InputEdgesEnd(); it != end; ++it) {
+        visit(it->GetNode(), *node->InputDefs()[it->GetDstArgIndex()]);
+      }
+      for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+        visit(it->GetNode(), *node->OutputDefs()[it->GetSrcArgIndex()]);
+      }
+    }
+
+    regions.push_back(std::move(region));
+  }
+
+  return regions;
+}
+
+void RemoveNodeEdges(Graph& graph, const Node& node) {
+  const auto input_edges = node.GetRelationships().input_edges;
+  for (const auto& edge : input_edges) {
+    graph.RemoveEdge(edge.GetNode().Index(), node.Index(), edge.GetSrcArgIndex(), edge.GetDstArgIndex());
+  }
+  const auto output_edges = node.GetRelationships().output_edges;
+  for (const auto& edge : output_edges) {
+    graph.RemoveEdge(node.Index(), edge.GetNode().Index(), edge.GetSrcArgIndex(), edge.GetDstArgIndex());
+  }
+}
+
+void ReplaceInput(Node& node, const NodeArg& old_arg, NodeArg& new_arg) {
+  auto& input_defs = node.MutableInputDefs();
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    if (input_defs[i] == &old_arg) {
+      graph_utils::ReplaceNodeInput(node, static_cast<int>(i), new_arg);
+    }
+  }
+}
+
+NodeArg& AddCast(Graph& graph, NodeArg& input, NodeArg& output, int32_t to, const std::string& provider_type) {
+  Node& cast = graph.AddNode(graph.GenerateNodeName(input.Name() + "_cast"), "Cast",
+                             "Added by CastPrecisionPropagation", {&input}, {&output});
+  cast.AddAttribute("to", static_cast<int64_t>(to));
+  cast.SetExecutionProviderType(provider_type);
+  return output;
+}
+
+// A value a region reads from outside of the region.
+struct RegionInput {
+  InlinedVector<std::pair<Node*, const NodeArg*>> uses;
+  // a Cast from the other type that produces the value, and whether only the region reads it
+  const Node* cast = nullptr;
+  bool cast_removable = false;
+};
+
+// A value a region produces.
+struct RegionOutput {
+  Node* producer;
+  size_t output_index;
+  InlinedVector<Node*> region_consumers;
+  // Casts to the other type whose consumers can read the value in the other type directly
+  InlinedVector<Node*> casts;
+  // a Cast to the other type that produces a graph output or values of subgraphs. The value in the other type takes
+  // over its NodeArg.
+  Node* graph_output_cast = nullptr;
+  // whether other nodes or the graph outputs read the value
+  bool other_uses = false;
+};
+
+class RegionSwitch {
+ public:
+  RegionSwitch(Graph& graph, const Region& region) : graph_(graph), region_(region) {}
+
+  // Collects the boundaries of the region and returns the number of Casts saved by switching it to the other type.
+  int64_t Analyze(int32_t type) {
+    type_ = type;
+    to_ = type == kFloat ? kFloat16 : kFloat;
+
+    for (Node* node : region_.nodes) {
+      for (const NodeArg* input : node->InputDefs()) {
+        if (!GetFloatType(*input).has_value()) {
+          continue;
+        }
+        const Node* producer = graph_.GetProducerNode(input->Name());
+        if (producer != nullptr && region_.Contains(*producer)) {
+          continue;
+        }
+        if (graph_utils::GetConstantInitializer(graph_, input->Name(), true) != nullptr) {
+          initializer_uses_.push_back({node, input});
+          continue;
+        }
+
+        auto [it, inserted] = inputs_.try_emplace(input->Name());
+        if (inserted) {
+          input_names_.push_back(input->Name());
+          if (producer != nullptr && IsCastTo(*producer, type) && GetFloatType(*producer->InputDefs()[0]) == to_) {
+            it->second.cast = producer;
+            it->second.cast_removable = !graph_.IsOutput(input);
+            for (const Node* consumer : graph_.GetConsumerNodes(input->Name())) {
+              it->second.cast_removable = it->second.cast_removable && region_.Contains(*consumer);
+            }
+          }
+        }
+        it->second.uses.push_back({node, input});
+      }
+
+      const auto& output_defs = node->OutputDefs();
+      for (size_t i = 0; i < output_defs.size(); ++i) {
+        if (!GetFloatType(*output_defs[i]).has_value()) {
+          continue;
+        }
+
+        RegionOutput output{node, i};
+        output.other_uses = graph_.IsOutput(output_defs[i]);
+        for (Node* consumer : graph_.GetMutableConsumerNodes(output_defs[i]->Name())) {
+          if (region_.Contains(*consumer)) {
+            output.region_consumers.push_back(consumer);
+          } else if (CanBypassCast(*consumer)) {
+            output.casts.push_back(consumer);
+          } else if (IsCastTo(*consumer, to_) && output.graph_output_cast == nullptr) {
+            output.graph_output_cast = consumer;
+          } else {
+            output.other_uses = true;
+          }
+        }
+        outputs_.push_back(std::move(output));
+      }
+    }
+
+    int64_t casts_now = 0;
+    int64_t casts_after = 0;
+    for (const auto& name : input_names_) {
+      const RegionInput& input = inputs_[name];
+      if (input.cast == nullptr) {
+        ++casts_after;
+      } else if (input.cast_removable) {
+        ++casts_now;
+      }
+    }
+    for (const auto& output : outputs_) {
+      casts_now += static_cast<int64_t>(output.casts.size()) + (output.graph_output_cast != nullptr ? 1 : 0);
+      casts_after += output.other_uses ? 1 : 0;
+    }
+    return casts_now - casts_after;
+  }
+
+  void Apply() {
+    const std::string& provider_type = region_.nodes.front()->GetExecutionProviderType();
+
+    // Resolve adds the edges of the new connections
+    for (const Node* node : region_.nodes) {
+      RemoveNodeEdges(graph_, *node);
+    }
+
+    // the outputs go first, so a Cast at the inputs that reads a bypassed Cast at the outputs reads the new value
+    for (auto& output : outputs_) {
+      NodeArg& value = *output.producer->MutableOutputDefs()[output.output_index];
+      NodeArg* converted_arg = nullptr;
+      if (output.graph_output_cast != nullptr) {
+        converted_arg = output.graph_output_cast->MutableOutputDefs()[0];
+        output.casts.push_back(output.graph_output_cast);
+      } else {
+        const TypeProto type_proto = WithElemType(value, to_);
+        converted_arg = &graph_.GetOrCreateNodeArg(graph_.GenerateNodeArgName(value.Name()), &type_proto);
+      }
+      NodeArg& converted = *converted_arg;
+      output.producer->MutableOutputDefs()[output.output_index] = &converted;
+
+      for (Node* consumer : output.region_consumers) {
+        ReplaceInput(*consumer, value, converted);
+      }
+
+      for (Node* cast : output.casts) {
+        const NodeArg& cast_output = *cast->OutputDefs()[0];
+        for (Node* consumer : graph_.GetMutableConsumerNodes(cast_output.Name())) {
+          if (consumer != nullptr) {
+            ReplaceInput(*consumer, cast_output, converted);
+          }
+        }
+        graph_utils::RemoveNodeOutputEdges(graph_, *cast);
+        graph_.RemoveNode(cast->Index());
+      }
+
+      // the value keeps its NodeArg for the other consumers and the graph outputs
+      if (output.other_uses) {
+        AddCast(graph_, converted, value, type_, provider_type);
+      }
+    }
+
+    for (const auto& name : input_names_) {
+      const RegionInput& input = inputs_[name];
+      const NodeArg& value = *input.uses.front().second;
+      NodeArg* converted = nullptr;
+      if (input.cast != nullptr) {
+        converted = graph_.GetNodeArg(input.cast->InputDefs()[0]->Name());
+        if (input.cast_removable) {
+          Node& cast = *graph_.GetNode(input.cast->Index());
+          graph_utils::RemoveNodeOutputEdges(graph_, cast);
+          graph_.RemoveNode(cast.Index());
+        }
+      } else {
+        const TypeProto type_proto = WithElemType(value, to_);
+        converted = &AddCast(graph_, *graph_.GetNodeArg(value.Name()),
+                             graph_.GetOrCreateNodeArg(graph_.GenerateNodeArgName(value.Name()), &type_proto), to_,
+                             provider_type);
+      }
+      for (auto& [node, arg] : input.uses) {
+        ReplaceInput(*node, *arg, *converted);
+      }
+    }
+
+    InlinedHashMap<std::string, NodeArg*> converted_initializers;
+    for (auto& [node, arg] : initializer_uses_) {
+      auto [it, inserted] = converted_initializers.try_emplace(arg->Name(), nullptr);
+      if (inserted) {
+        it->second = &graph_utils::AddInitializer(graph_, ConvertInitializer(arg->Name()));
+      }
+      ReplaceInput(*node, *arg, *it->second);
+    }
+
+    graph_.SetGraphResolveNeeded();
+  }
+
+  int32_t To() const { return to_; }
+
+ private:
+  // Whether the node is a Cast to the other type whose consumers can read the value of the region instead.
+  bool CanBypassCast(const Node& node) const {
+    if (!IsCastTo(node, to_) || graph_.NodeProducesGraphOutput(node)) {
+      return false;
+    }
+
+    // the values read by subgraphs keep their names
+    const NodeArg* cast_output = node.OutputDefs()[0];
+    for (const Node* consumer : graph_.GetConsumerNodes(cast_output->Name())) {
+      const auto& implicit_inputs = consumer->ImplicitInputDefs();
+      if (std::find(implicit_inputs.begin(), implicit_inputs.end(), cast_output) != implicit_inputs.end()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  TensorProto ConvertInitializer(const std::string& name) const {
+    const TensorProto* initializer = graph_utils::GetConstantInitializer(graph_, name, true);
+    Initializer data(*initializer, graph_.ModelPath());
+    const std::string converted_name = graph_.GenerateNodeArgName(name);
+    if (to_ == kFloat16) {
+      return data.ToFP16(converted_name);
+    }
+
+    Initializer converted(TensorProto_DataType_FLOAT, converted_name, data.dims());
+    const auto values = data.DataAsSpan<MLFloat16>();
+    float* converted_values = converted.data<float>();
+    for (size_t i = 0; i < values.size(); ++i) {
+      converted_values[i] = values[i].ToFloat();
+    }
+    TensorProto tensor_proto;
+    converted.ToProto(tensor_proto);
+    return tensor_proto;
+  }
+
+  Graph& graph_;
+  const Region& region_;
+  int32_t type_ = kFloat;
+  int32_t to_ = kFloat16;
+  InlinedHashMap<std::string, RegionInput> inputs_;
+  std::vector<std::string> input_names_;
+  InlinedVector<std::pair<Node*, const NodeArg*>> initializer_uses_;
+  std::vector<RegionOutput> outputs_;
+};
+
+}  // namespace
+
+Status CastPrecisionPropagation::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                           const logging::Logger& logger) const {
+  for (const Region& region : FindRegions(graph)) {
+    const int32_t type = *GetSwitchableType(*region.nodes.front());
+    const int32_t to = type == kFloat ? kFloat16 : kFloat;
+    const MLDataType to_data_type = to == kFloat ? DataTypeImpl::GetTensorType<float>()
+                                                 : DataTypeImpl::GetTensorType<MLFloat16>();
+
+    bool can_switch = true;
+    for (const Node* node : region.nodes) {
+      // computing in float16 loses precision the model may need
+      if (to == kFloat16 && kArithmeticOps.find(node->OpType()) != kArithmeticOps.end() &&
+          fp16_ops_.find(node->OpType()) == fp16_ops_.end()) {
+        can_switch = false;
+        break;
+      }
+
+      // the data input of all ops the pass switches has the type constraint of all float values
+      const KernelRegistry::TypeConstraintMap type_constraints{{node->Op()->inputs()[0].GetTypeStr(), to_data_type}};
+      const auto& provider_type = node->GetExecutionProviderType();
+      bool has_kernel = false;
+      for (const KernelRegistry* registry : registry_manager_.get().GetKernelRegistriesByProviderType(provider_type)) {
+        const KernelCreateInfo* kernel_create_info = nullptr;
+        if (registry->TryFindKernel(*node, provider_type, type_constraints, &kernel_create_info).IsOK() &&
+            kernel_create_info != nullptr) {
+          has_kernel = true;
+          break;
+        }
+      }
+      if (!has_kernel) {
+        can_switch = false;
+        break;
+      }
+    }
+    if (!can_switch) {
+      continue;
+    }
+
+    RegionSwitch region_switch(graph, region);
+    const int64_t saved_casts = region_switch.Analyze(type);
+    if (saved_casts <= 0) {
+      continue;
+    }
+
+    LOGS(logger, VERBOSE) << "Switching " << region.nodes.size() << " nodes starting at "
+                          << region.nodes.front()->Name() << " to " << (to == kFloat ? "float" : "float16")
+                          << " saves " << saved_casts << " Cast nodes";
+    region_switch.Apply();
+    modified = true;
+
+    // the next regions look up the producers and consumers of their values
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+
+#include "core/framework/kernel_registry_manager.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class CastPrecisionPropagation
+Choose float or float16 for each connected region of nodes that can run in either type, so that the fewest Cast
+nodes are needed at the boundaries of the region. Runs after the nodes are assigned to EPs, as a region only switches
+to a type the kernel registries of its EP have kernels for.
+Switching a region to the other type removes the Casts from that type at its inputs and to that type at its outputs,
+and adds Casts for the other inputs and outputs. Constant initializers are converted instead.
+Data movement and selection ops like Transpose, Concat, Relu and Max give the same values in both types, as they
+commute with rounding. A region with arithmetic ops like Add only switches from float to float16 if all of their op
+types are in fp16_ops. The nodes of subgraphs are left as they are.
+*/
+class CastPrecisionPropagation : public GraphTransformer {
+ public:
+  CastPrecisionPropagation(const KernelRegistryManager& registry_manager,
+                           InlinedHashSet<std::string> fp16_ops = {}) noexcept
+      : GraphTransformer("CastPrecisionPropagation"),
+        registry_manager_(std::cref(registry_manager)),
+        fp16_ops_(std::move(fp16_ops)) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  std::reference_wrapper<const KernelRegistryManager> registry_manager_;
+  const InlinedHashSet<std::string> fp16_ops_;
+};
+
+}  // namespace onnxruntime
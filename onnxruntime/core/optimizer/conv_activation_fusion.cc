@@ -71,6 +71,34 @@ bool ConvFusionDataTypeCheck(const Node& conv_node) {
   return true;
 }
 
+bool IsSupportedNonCudaRocmEpActivation(const GraphViewer& graph_viewer, const Node& activation_node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Relu", {6, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Sigmoid", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Tanh", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "LeakyRelu", {6, 16})) {
+    return true;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Clip", {6, 11, 12, 13})) {
+    float min, max;
+    if (!optimizer_utils::GetClipConstantMinMax(graph_viewer.GetGraph(), activation_node, min, max)) {
+      return false;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+// The CUDA FusedConv kernel runs Relu in cuDNN and the other activations in a kernel that also adds the bias and
+// the Add input, so it takes the com.microsoft Gelu and QuickGelu (SiLU with alpha 1) too.
+bool IsSupportedCudaEpActivation(const GraphViewer& graph_viewer, const Node& activation_node) {
+  return IsSupportedNonCudaRocmEpActivation(graph_viewer, activation_node) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "HardSigmoid", {6}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Gelu", {1}, kMSDomain) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "QuickGelu", {1}, kMSDomain);
+}
+
 class ConvActivationSelector : public NodeSelector {
  public:
   ConvActivationSelector() = default;
@@ -83,41 +111,26 @@ class ConvActivationSelector : public NodeSelector {
       return std::nullopt;
     }
 
-    auto is_supported_non_cuda_rocm_ep_activation = [&graph_viewer](const Node& activation_node) {
-      if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Relu", {6, 13, 14}) ||
-          graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Sigmoid", {6, 13}) ||
-          graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Tanh", {6, 13}) ||
-          graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "LeakyRelu", {6, 16})) {
-        return true;
-      }
-
-      if (graph_utils::IsSupportedOptypeVersionAndDomain(activation_node, "Clip", {6, 11, 12, 13})) {
-        float min, max;
-        if (!optimizer_utils::GetClipConstantMinMax(graph_viewer.GetGraph(), activation_node, min, max)) {
-          return false;
-        }
-        return true;
-      }
-
-      return false;
-    };
-
     if (!ConvFusionDataTypeCheck(node)) {
       return std::nullopt;
     }
 
     // check EP type and activation
-    if (node_ep == kCudaExecutionProvider || node_ep == kRocmExecutionProvider) {
+    if (node_ep == kCudaExecutionProvider) {
+      if (!IsSupportedCudaEpActivation(graph_viewer, *next_node)) {
+        return std::nullopt;
+      }
+    } else if (node_ep == kRocmExecutionProvider) {
       if (!graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "Relu", {6, 13, 14})) {
         return std::nullopt;
       }
     } else if (node_ep.empty() || node_ep == kCpuExecutionProvider) {
-      if (!is_supported_non_cuda_rocm_ep_activation(*next_node) &&
+      if (!IsSupportedNonCudaRocmEpActivation(graph_viewer, *next_node) &&
           !graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "HardSigmoid", {6})) {
         return std::nullopt;
       }
     } else {
-      if (!is_supported_non_cuda_rocm_ep_activation(*next_node)) {
+      if (!IsSupportedNonCudaRocmEpActivation(graph_viewer, *next_node)) {
         return std::nullopt;
       }
     }
@@ -129,9 +142,9 @@ class ConvActivationSelector : public NodeSelector {
   }
 };
 
-class ConvAddRelu : public NodeSelector {
+class ConvAddActivation : public NodeSelector {
  public:
-  ConvAddRelu() = default;
+  ConvAddActivation() = default;
 
   std::optional<NodesToOptimizeIndices> Select(const GraphViewer& graph_viewer, const Node& node) const override {
     const std::string_view node_ep = node.GetExecutionProviderType();
@@ -151,17 +164,17 @@ class ConvAddRelu : public NodeSelector {
       return std::nullopt;
     }
 
-    const auto* relu_node = GetLoneConsumerNode(graph_viewer, *add_node);
-    if (!relu_node ||
-        !graph_utils::IsSupportedOptypeVersionAndDomain(*relu_node, "Relu", {6, 13, 14}) ||
-        relu_node->GetExecutionProviderType() != node_ep) {
+    const auto* activation_node = GetLoneConsumerNode(graph_viewer, *add_node);
+    if (!activation_node ||
+        !IsSupportedCudaEpActivation(graph_viewer, *activation_node) ||
+        activation_node->GetExecutionProviderType() != node_ep) {
       return std::nullopt;
     }
 
     NodesToOptimizeIndicesBuilder builder{};
     builder.target_node = node.Index();
     builder.output_nodes = {add_node->Index(),
-                            relu_node->Index()};
+                            activation_node->Index()};
     return builder.Build();
   }
 };
@@ -172,6 +185,43 @@ class ConvAddRelu : public NodeSelector {
 namespace actions {
 using NTO = NodesToOptimize;
 
+// The activation and activation_params attributes of the FusedConv node replacing the activation node.
+NodeAttributes FusedConvActivationAttributes(const Graph& graph, const Node* activation) {
+  NodeAttributes extra_fused_conv_attributes;
+  ORT_ENFORCE(activation != nullptr, "Expected activation node.");
+
+  const auto& activation_op_type = activation->OpType();
+  utils::SetNodeAttribute(utils::MakeAttribute("activation", activation_op_type), extra_fused_conv_attributes);
+
+  InlinedVector<float> activation_params;
+  if (activation_op_type == "LeakyRelu") {
+    activation_params.push_back(graph_utils::GetNodeAttribute(*activation, "alpha")->f());
+  } else if (activation_op_type == "Clip") {
+    float min, max;
+    ORT_ENFORCE(optimizer_utils::GetClipConstantMinMax(graph, *activation, min, max),
+                "Failed to get Clip min/max constants.");
+    activation_params.push_back(min);
+    activation_params.push_back(max);
+  } else if (activation_op_type == "HardSigmoid") {
+    auto* alpha_attr = graph_utils::GetNodeAttribute(*activation, "alpha");
+    auto* beta_attr = graph_utils::GetNodeAttribute(*activation, "beta");
+    float alpha = (alpha_attr == nullptr ? 0.2f : alpha_attr->f());
+    float beta = (beta_attr == nullptr ? 0.5f : beta_attr->f());
+    activation_params.push_back(alpha);
+    activation_params.push_back(beta);
+  } else if (activation_op_type == "QuickGelu") {
+    auto* alpha_attr = graph_utils::GetNodeAttribute(*activation, "alpha");
+    activation_params.push_back(alpha_attr == nullptr ? 1.702f : alpha_attr->f());
+  }
+
+  if (!activation_params.empty()) {
+    utils::SetNodeAttribute(utils::MakeAttribute("activation_params", activation_params),
+                            extra_fused_conv_attributes);
+  }
+
+  return extra_fused_conv_attributes;
+}
+
 class FuseConvActivationAction : public ReplaceWithNew {
  private:
   std::string OpType(const RuntimeState&) const override { return "FusedConv"; }
@@ -179,38 +229,7 @@ class FuseConvActivationAction : public ReplaceWithNew {
   std::string Domain(const RuntimeState&) const override { return kMSDomain; }
 
   NodeAttributes ExtraAttributes(const RuntimeState& state) const override {
-    NodeAttributes extra_fused_conv_attributes;
-
-    const auto* activation = state.selected_nodes.Output(0);
-    ORT_ENFORCE(activation != nullptr, "Expected activation node.");
-
-    const auto& activation_op_type = activation->OpType();
-    utils::SetNodeAttribute(utils::MakeAttribute("activation", activation_op_type), extra_fused_conv_attributes);
-
-    InlinedVector<float> activation_params;
-    if (activation_op_type == "LeakyRelu") {
-      activation_params.push_back(graph_utils::GetNodeAttribute(*activation, "alpha")->f());
-    } else if (activation_op_type == "Clip") {
-      float min, max;
-      ORT_ENFORCE(optimizer_utils::GetClipConstantMinMax(state.graph, *activation, min, max),
-                  "Failed to get Clip min/max constants.");
-      activation_params.push_back(min);
-      activation_params.push_back(max);
-    } else if (activation_op_type == "HardSigmoid") {
-      auto* alpha_attr = graph_utils::GetNodeAttribute(*activation, "alpha");
-      auto* beta_attr = graph_utils::GetNodeAttribute(*activation, "beta");
-      float alpha = (alpha_attr == nullptr ? 0.2f : alpha_attr->f());
-      float beta = (beta_attr == nullptr ? 0.5f : beta_attr->f());
-      activation_params.push_back(alpha);
-      activation_params.push_back(beta);
-    }
-
-    if (!activation_params.empty()) {
-      utils::SetNodeAttribute(utils::MakeAttribute("activation_params", activation_params),
-                              extra_fused_conv_attributes);
-    }
-
-    return extra_fused_conv_attributes;
+    return FusedConvActivationAttributes(state.graph, state.selected_nodes.Output(0));
   }
 
   std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState&) const override {
@@ -224,16 +243,14 @@ class FuseConvActivationAction : public ReplaceWithNew {
   }
 };
 
-class FuseConvAddRelu : public ReplaceWithNew {
+class FuseConvAddActivation : public ReplaceWithNew {
  private:
   std::string OpType(const RuntimeState&) const override { return "FusedConv"; }
 
   std::string Domain(const RuntimeState&) const override { return kMSDomain; }
 
-  NodeAttributes ExtraAttributes(const RuntimeState&) const override {
-    NodeAttributes extra_fused_conv_attributes;
-    utils::SetNodeAttribute(utils::MakeAttribute("activation", "Relu"), extra_fused_conv_attributes);
-    return extra_fused_conv_attributes;
+  NodeAttributes ExtraAttributes(const RuntimeState& state) const override {
+    return FusedConvActivationAttributes(state.graph, state.selected_nodes.Output(1));
   }
 
   std::vector<NodeAndMoveInfo> ValueMoves(const RuntimeState& state) const override {
@@ -245,12 +262,12 @@ class FuseConvAddRelu : public ReplaceWithNew {
 
     const auto conv_location = NTO::NodeLocation{NTO::NodeType::kTarget, 0};
     const auto add_location = NTO::NodeLocation{NTO::NodeType::kOutput, 0};
-    const auto relu_location = NTO::NodeLocation{NTO::NodeType::kOutput, 1};
+    const auto activation_location = NTO::NodeLocation{NTO::NodeType::kOutput, 1};
 
     return {
         MoveAll(conv_location, ArgType::kInput),                                       // move all inputs from conv
         MoveAndAppend(add_location, ArgType::kInput, add_input_idx, ArgType::kInput),  // append add input
-        MoveAll(relu_location, ArgType::kOutput),                                      // move all outputs from relu
+        MoveAll(activation_location, ArgType::kOutput),                                // move all outputs from activation
     };
   }
 };
@@ -268,11 +285,12 @@ void RegisterConvActivationFusionRules(SelectorActionRegistry& registry) {
 #endif
 }
 
-void RegisterConvAddReluFusionRules(SelectorActionRegistry& registry) {
+void RegisterConvAddActivationFusionRules(SelectorActionRegistry& registry) {
+  // the name predates the activations other than Relu, and is kept for the runtime optimizations saved with it
   const auto name = "ConvAddRelu";
-  auto action = std::make_unique<actions::FuseConvAddRelu>();
+  auto action = std::make_unique<actions::FuseConvAddActivation>();
 #if !defined(ORT_MINIMAL_BUILD)
-  auto selector = std::make_unique<selectors::ConvAddRelu>();
+  auto selector = std::make_unique<selectors::ConvAddActivation>();
   registry.RegisterSelectorAndAction(name, {{"Conv", {1, 11}}},
                                      std::move(selector), std::move(action));
 #else
@@ -283,7 +301,7 @@ void RegisterConvAddReluFusionRules(SelectorActionRegistry& registry) {
 SelectorActionRegistry CreateSelectorActionRegistry() {
   SelectorActionRegistry registry{};
   RegisterConvActivationFusionRules(registry);
-  RegisterConvAddReluFusionRules(registry);
+  RegisterConvAddActivationFusionRules(registry);
   return registry;
 }
 
@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+static constexpr std::array supported_data_types{"tensor(float)"};
+static constexpr std::array cuda_supported_data_types{"tensor(float16)", "tensor(float)"};
+
+// The number of steps the CUDA kernel of ElementwiseChain takes at most, kElementwiseChainMaxSteps in
+// contrib_ops/cuda/math/elementwise_chain_impl.h
+static constexpr size_t kCudaMaxSteps = 16;
+
+// A node of the chain, with the operand of a binary node
+struct ChainStep {
+  Node* node;
+  NodeArg* operand;
+  bool operand_first;
+};
+
+bool IsChainUnaryOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Softplus", {1}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Softsign", {1});
+}
+
+bool IsChainBinaryOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+}
+
+// Whether the shapes are known to be the same. Symbolic dims match if they have the same name.
+bool HaveSameShape(const NodeArg& arg, const NodeArg& other) {
+  const auto* shape = arg.Shape();
+  const auto* other_shape = other.Shape();
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() != other_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& other_dim = other_shape->dim(i);
+    if (utils::HasDimValue(dim) && utils::HasDimValue(other_dim)) {
+      if (dim.dim_value() != other_dim.dim_value()) {
+        return false;
+      }
+    } else if (!utils::HasDimParam(dim) || !utils::HasDimParam(other_dim) ||
+               dim.dim_param() != other_dim.dim_param()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Whether the operand has a single element and broadcasting it doesn't change the shape of the chain
+bool IsSingleElementOperand(const NodeArg& operand, const NodeArg& chain_value) {
+  const auto* shape = operand.Shape();
+  const auto* chain_shape = chain_value.Shape();
+  if (shape == nullptr || chain_shape == nullptr || shape->dim_size() > chain_shape->dim_size()) {
+    return false;
+  }
+
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim) || dim.dim_value() != 1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Adds the node to the chain if it is an op of the chain that consumes chain_value once, with an operand that
+// doesn't change the shape.
+bool TryAddChainStep(Node& node, const NodeArg& chain_value, const InlinedHashSet<std::string_view>& providers,
+                     InlinedVector<ChainStep>& steps) {
+  if (!graph_utils::IsSupportedProvider(node, providers)) {
+    return false;
+  }
+
+  // the CPU kernel only takes float
+  if (node.GetExecutionProviderType() == kCudaExecutionProvider) {
+    if (!optimizer_utils::IsSupportedDataType(node, cuda_supported_data_types) || steps.size() >= kCudaMaxSteps) {
+      return false;
+    }
+  } else if (!optimizer_utils::IsSupportedDataType(node, supported_data_types)) {
+    return false;
+  }
+
+  // all the nodes of the chain run on the EP of its first node
+  if (!steps.empty() && steps[0].node->GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return false;
+  }
+
+  auto& input_defs = node.MutableInputDefs();
+  if (IsChainUnaryOp(node)) {
+    if (input_defs[0]->Name() != chain_value.Name()) {
+      return false;
+    }
+
+    steps.push_back({&node, nullptr, false});
+    return true;
+  }
+
+  if (!IsChainBinaryOp(node)) {
+    return false;
+  }
+
+  const bool chain_value_first = input_defs[0]->Name() == chain_value.Name();
+  const bool chain_value_second = input_defs[1]->Name() == chain_value.Name();
+  if (chain_value_first == chain_value_second) {
+    return false;
+  }
+
+  NodeArg* operand = input_defs[chain_value_first ? 1 : 0];
+  if (!HaveSameShape(chain_value, *node.OutputDefs()[0]) ||
+      !(HaveSameShape(*operand, chain_value) || IsSingleElementOperand(*operand, chain_value))) {
+    return false;
+  }
+
+  steps.push_back({&node, operand, chain_value_second});
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // the chain starts from the first input of a unary node, or from the input of a binary node that has the shape
+    // of its output
+    InlinedVector<ChainStep> steps;
+    NodeArg* chain_input = nullptr;
+    for (NodeArg* input : node.MutableInputDefs()) {
+      if (TryAddChainStep(node, *input, GetCompatibleExecutionProviders(), steps)) {
+        chain_input = input;
+        break;
+      }
+    }
+
+    if (chain_input == nullptr) {
+      continue;
+    }
+
+    Node* last_node = &node;
+    while (optimizer_utils::CheckOutputEdges(graph, *last_node, 1)) {
+      Node& next_node = *graph.GetNode(last_node->OutputNodesBegin()->Index());
+      if (!TryAddChainStep(next_node, *last_node->OutputDefs()[0], GetCompatibleExecutionProviders(), steps)) {
+        break;
+      }
+      last_node = &next_node;
+    }
+
+    if (steps.size() < 2) {
+      continue;
+    }
+
+    InlinedVector<NodeArg*> inputs{chain_input};
+    std::vector<std::string> ops;
+    std::vector<int64_t> operand_first;
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse;
+    for (const ChainStep& step : steps) {
+      if (step.operand != nullptr) {
+        inputs.push_back(step.operand);
+      }
+      ops.push_back(step.node->OpType());
+      operand_first.push_back(step.operand_first ? 1 : 0);
+      nodes_to_fuse.emplace_back(*step.node);
+    }
+
+    Node& chain_node = graph.AddNode(graph.GenerateNodeName("ElementwiseChain"), "ElementwiseChain",
+                                     "fused element-wise chain", inputs, {}, nullptr, kMSDomain);
+    chain_node.AddAttribute("ops", ops);
+    chain_node.AddAttribute("operand_first", operand_first);
+    chain_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // FinalizeNodeFusion moves the input edges of the first node, so move the edges of the operands of the
+    // other nodes here
+    for (size_t i = 1; i < steps.size(); ++i) {
+      const Node& step_node = *steps[i].node;
+      for (auto it = step_node.InputEdgesBegin(), end = step_node.InputEdgesEnd(); it != end; ++it) {
+        if (&it->GetNode() == steps[i - 1].node) {
+          continue;
+        }
+
+        const NodeArg& arg = *step_node.InputDefs()[it->GetDstArgIndex()];
+        graph.AddEdge(it->GetNode().Index(), chain_node.Index(), it->GetSrcArgIndex(),
+                      optimizer_utils::IndexOfNodeInput(chain_node, arg));
+      }
+    }
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, chain_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
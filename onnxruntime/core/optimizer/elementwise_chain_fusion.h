@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseChainFusion
+Fuse chains of Add, Sub, Mul, Div, Relu, Sigmoid, Softplus, Softsign and Tanh nodes, where each node is the only
+consumer of the previous one, into one ElementwiseChain node that takes the tensor through all of them in one pass.
+The operand of a binary node must have the shape of the chain or a single element.
+The chains are float on CPU, and float or float16 of at most 16 nodes on CUDA, where they run in one kernel launch.
+*/
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/gather_block_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// The quantized table, scales and zero points of a float table, as the inputs of GatherBlockQuantized.
+struct QuantizedTable {
+  NodeArg* data;
+  NodeArg* scales;
+  NodeArg* zero_points;
+};
+
+// Quantizes each block of each row with its own scale and zero point, so that the block's range, extended to include
+// 0, maps to [0, 2^bits - 1]. This is the asymmetric quantization of MatMulNBits weights.
+QuantizedTable QuantizeTable(Graph& graph, const TensorProto& table_proto, int64_t bits, int64_t block_size) {
+  Initializer table{table_proto, graph.ModelPath()};
+  const float* table_data = table.data<float>();
+  const int64_t N = table_proto.dims(0);
+  const int64_t K = table_proto.dims(1);
+  const int64_t blocks_per_row = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size / 8 * bits;
+  const int64_t block_count = N * blocks_per_row;
+  const int max_q = (1 << bits) - 1;
+
+  std::string data(static_cast<size_t>(block_count * blob_size), '\0');
+  std::vector<float> scales(static_cast<size_t>(block_count));
+  std::vector<uint8_t> zero_points(static_cast<size_t>(block_count));
+
+  for (int64_t block_idx = 0; block_idx < block_count; block_idx++) {
+    const int64_t k = (block_idx % blocks_per_row) * block_size;
+    const float* src = table_data + (block_idx / blocks_per_row) * K + k;
+    const int64_t len = std::min(block_size, K - k);
+
+    float min = 0.0f;
+    float max = 0.0f;
+    for (int64_t i = 0; i < len; i++) {
+      min = std::min(min, src[i]);
+      max = std::max(max, src[i]);
+    }
+
+    const float scale = (max - min) / max_q;
+    const float reciprocal_scale = scale != 0.0f ? 1.0f / scale : 0.0f;
+    const uint8_t zp =
+        scale != 0.0f ? static_cast<uint8_t>(std::clamp(std::round(-min / scale), 0.0f, static_cast<float>(max_q))) : 0;
+    scales[block_idx] = scale;
+    zero_points[block_idx] = zp;
+
+    auto* blob = reinterpret_cast<uint8_t*>(data.data()) + block_idx * blob_size;
+    for (int64_t i = 0; i < len; i++) {
+      const auto q = static_cast<uint8_t>(
+          std::clamp(std::round(src[i] * reciprocal_scale + zp), 0.0f, static_cast<float>(max_q)));
+      if (bits == 4) {
+        blob[i / 2] |= (i & 1) ? (q << 4) : q;
+      } else {
+        blob[i] = q;
+      }
+    }
+  }
+
+  TensorProto data_proto;
+  data_proto.set_name(graph.GenerateNodeArgName(table_proto.name() + "_quantized"));
+  data_proto.set_data_type(TensorProto_DataType_UINT8);
+  data_proto.add_dims(N);
+  data_proto.add_dims(blocks_per_row);
+  data_proto.add_dims(blob_size);
+  data_proto.set_raw_data(std::move(data));
+
+  TensorProto scales_proto;
+  scales_proto.set_name(graph.GenerateNodeArgName(table_proto.name() + "_scales"));
+  scales_proto.set_data_type(TensorProto_DataType_FLOAT);
+  scales_proto.add_dims(block_count);
+  scales_proto.set_raw_data(scales.data(), scales.size() * sizeof(float));
+
+  // with 4 bits, two zero points are stored in a byte, starting with the low 4 bits
+  if (bits == 4) {
+    for (int64_t i = 0; i < block_count; i += 2) {
+      const uint8_t high = i + 1 < block_count ? zero_points[i + 1] : 0;
+      zero_points[i / 2] = static_cast<uint8_t>(zero_points[i] | (high << 4));
+    }
+    zero_points.resize(static_cast<size_t>((block_count + 1) / 2));
+  }
+
+  TensorProto zero_points_proto;
+  zero_points_proto.set_name(graph.GenerateNodeArgName(table_proto.name() + "_zero_points"));
+  zero_points_proto.set_data_type(TensorProto_DataType_UINT8);
+  zero_points_proto.add_dims(static_cast<int64_t>(zero_points.size()));
+  zero_points_proto.set_raw_data(zero_points.data(), zero_points.size());
+
+  return {&graph_utils::AddInitializer(graph, data_proto),
+          &graph_utils::AddInitializer(graph, scales_proto),
+          &graph_utils::AddInitializer(graph, zero_points_proto)};
+}
+
+}  // namespace
+
+Status GatherBlockQuantization::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  // tables used by more than one Gather are quantized once
+  InlinedHashMap<std::string, QuantizedTable> quantized_tables;
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+    const int64_t axis = axis_attr != nullptr && utils::HasInt(*axis_attr) ? axis_attr->i() : 0;
+    if (axis != 0 && axis != -2) {
+      continue;
+    }
+
+    const NodeArg& table_arg = *node.InputDefs()[0];
+    const TensorProto* table_proto = graph_utils::GetConstantInitializer(graph, table_arg.Name());
+    if (table_proto == nullptr || table_proto->data_type() != TensorProto_DataType_FLOAT ||
+        table_proto->dims_size() != 2 || table_proto->dims(1) == 0 ||
+        table_proto->dims(0) * table_proto->dims(1) < min_elements_) {
+      continue;
+    }
+
+    const int64_t K = table_proto->dims(1);
+    auto it = quantized_tables.find(table_arg.Name());
+    if (it == quantized_tables.end()) {
+      it = quantized_tables.emplace(table_arg.Name(), QuantizeTable(graph, *table_proto, bits_, block_size_)).first;
+    }
+    const QuantizedTable& quantized_table = it->second;
+
+    InlinedVector<NodeArg*> inputs{quantized_table.data, node.MutableInputDefs()[1], quantized_table.scales,
+                                   quantized_table.zero_points};
+    Node& gather_node = graph.AddNode(graph.GenerateNodeName("GatherBlockQuantized"), "GatherBlockQuantized",
+                                      "Gather of a blockwise quantized table", inputs, {}, nullptr, kMSDomain);
+    gather_node.AddAttribute("K", K);
+    gather_node.AddAttribute("bits", bits_);
+    gather_node.AddAttribute("block_size", block_size_);
+    gather_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {node}, gather_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class GatherBlockQuantization
+Replace Gather nodes along axis 0 of a large 2D float initializer, like an embedding table, with GatherBlockQuantized
+nodes reading the table quantized blockwise with 4 or 8 bits in the format of MatMulNBits, so the session keeps the
+quantized table and only dequantizes the gathered rows.
+The float table is kept while another node still uses it.
+*/
+class GatherBlockQuantization : public GraphTransformer {
+ public:
+  // Tables with fewer than this many elements are not quantized.
+  static constexpr int64_t kDefaultMinElements = int64_t{1} << 20;
+
+  GatherBlockQuantization(int64_t bits, int64_t block_size = 32, int64_t min_elements = kDefaultMinElements,
+                          const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("GatherBlockQuantization", compatible_execution_providers),
+        bits_(bits),
+        block_size_(block_size),
+        min_elements_(min_elements) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  const int64_t bits_;
+  const int64_t block_size_;
+  const int64_t min_elements_;
+};
+
+}  // namespace onnxruntime
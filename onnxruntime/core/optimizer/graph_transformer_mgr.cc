@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <limits>
+
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -26,15 +29,46 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
     return Status::OK();
   }
 
+  const bool profiling = profiler_ != nullptr && profiler_->IsEnabled();
+
+  // the number of the modifications of the graph, and its value when each transformer last ran to no effect
+  size_t num_modifications = 0;
+  constexpr size_t kNotRun = std::numeric_limits<size_t>::max();
+  InlinedVector<size_t> unmodified_at(transformers->second.size(), kNotRun);
+
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
+    for (size_t i = 0; i < transformers->second.size(); ++i) {
+      const auto& transformer = transformers->second[i];
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      // the graph is the same as when the transformer last ran without modifying it
+      if (unmodified_at[i] == num_modifications)
+        continue;
+
+      TimePoint start_time;
+      if (profiling) {
+        start_time = profiler_->Start();
+      }
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
       graph_changed = graph_changed || modified;
+
+      if (profiling) {
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, transformer->Name(), start_time,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "1" : "0"}});
+      }
+
+      if (modified) {
+        ++num_modifications;
+        unmodified_at[i] = kNotRun;
+      } else {
+        unmodified_at[i] = num_modifications;
+      }
     }
     if (!graph_changed) {
       break;
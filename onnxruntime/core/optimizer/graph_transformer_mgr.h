@@ -5,6 +5,7 @@
 
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/rewrite_rule.h"
@@ -24,10 +25,15 @@ class GraphTransformerManager {
   // Get the maximum number of graph transformation steps
   common::Status GetSteps(unsigned& steps) const;
 
+  // Set the profiler that records the time and the effect of each transformer application while it is enabled.
+  void SetProfiler(profiling::Profiler* profiler) { profiler_ = profiler; }
+
   // Register a transformer with a level.
   common::Status Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level);
 
-  // Apply all transformers registered for the given level on the given graph
+  // Apply all transformers registered for the given level on the given graph until none of them modifies it,
+  // or for at most the maximum number of steps. A transformer is skipped in a step if it didn't modify the graph
+  // the last time it ran and no transformer has modified it since.
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
  private:
@@ -36,6 +42,8 @@ class GraphTransformerManager {
   // maximum number of graph transformation steps
   unsigned steps_;
 
+  profiling::Profiler* profiler_ = nullptr;
+
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
 };
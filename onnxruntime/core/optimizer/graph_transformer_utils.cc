@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <variant>
 
+#include "core/common/parse_string.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
@@ -32,10 +33,12 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
+#include "core/optimizer/gather_block_quantization.h"
 #include "core/optimizer/gather_fusion.h"
 #include "core/optimizer/gelu_approximation.h"
 #include "core/optimizer/gelu_fusion.h"
@@ -45,11 +48,13 @@
 #include "core/optimizer/identical_children_consolidation.h"
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_activation_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/ml_preprocessing_fusion.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
@@ -61,16 +66,20 @@
 #include "core/optimizer/qdq_transformer/ensure_unique_dq_for_node_unit.h"
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
+#include "core/optimizer/qdq_transformer/qlinear_conv_fusion.h"
 #include "core/optimizer/qdq_transformer/relu_quantizelinear.h"
 #include "core/optimizer/quick_gelu_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rocm_blas_alt_impl.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/shape_expression_fusion.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_sharding.h"
 #include "core/optimizer/transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
+#include "core/optimizer/zipmap_columnar.h"
 #ifdef ENABLE_TRAINING
 #include "orttraining/core/optimizer/bias_softmax_dropout_fusion.h"
 #include "orttraining/core/optimizer/bitmask_dropout_replacement.h"
@@ -206,6 +215,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<DoubleQDQPairsRemover>());
       }
 
+      // LoopInvariantCodeMotion moves the invariant nodes of Loop and Scan bodies into their outer graphs, where
+      // ConstantSharing and CommonSubexpressionElimination merge them with equal initializers and nodes.
+      transformers.emplace_back(std::make_unique<LoopInvariantCodeMotion>());
+
       // Put ConstantSharing before CommonSubexpressionElimination by intention as it can create more opportunities for
       // CSE. For example, if A and B nodes both do Add operation with a same value but different initializers, by
       // default, CSE will not merge them, because the different initializers are represented by different NodeArg.
@@ -224,6 +237,11 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
           session_options.free_dimension_overrides));
 
+      // ZipMapColumnar changes the type of the model outputs, so it needs to be manually enabled.
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableZipMapColumnar, "0") == "1") {
+        transformers.emplace_back(std::make_unique<ZipMapColumnar>());
+      }
+
       if (!disable_quant_qdq) {
         transformers.emplace_back(std::make_unique<QDQPropagationTransformer>());
 
@@ -255,7 +273,21 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                             QDQIsInt8Allowed() ? "1" : "0") == "1";
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
-
+      const bool enable_elementwise_chain_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseChainFusion, "0") == "1";
+      const bool enable_ml_preprocessing_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableMLPreprocessingFusion, "0") == "1";
+      const bool enable_shape_expression_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableShapeExpressionFusion, "0") == "1";
+      const std::string gather_block_quantization_bits =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsGatherBlockQuantizationBits, "0");
+      ORT_ENFORCE(gather_block_quantization_bits == "0" || gather_block_quantization_bits == "4" ||
+                      gather_block_quantization_bits == "8",
+                  "Invalid value for ", kOrtSessionOptionsGatherBlockQuantizationBits, ": ",
+                  gather_block_quantization_bits);
+
+      const InlinedHashSet<std::string_view> cpu_cuda_eps = {onnxruntime::kCpuExecutionProvider,
+                                                             onnxruntime::kCudaExecutionProvider};
       const InlinedHashSet<std::string_view> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                               onnxruntime::kRocmExecutionProvider};
       const InlinedHashSet<std::string_view> cpu_cuda_rocm_eps = {onnxruntime::kCpuExecutionProvider,
@@ -285,6 +317,12 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
           transformers.emplace_back(std::make_unique<QDQS8ToU8Transformer>(avx2_precision_mode, cpu_ep));
         }
         transformers.emplace_back(std::make_unique<QDQSelectorActionTransformer>(qdq_is_int8_allowed));
+
+        // QLinearConvFusion needs to run before ConvActivationFusion takes the activations of QDQ Conv nodes. The
+        // weights of the QLinearConv nodes it adds are not converted by Avx2WeightS8ToU8Transformer.
+        if (!avx2_precision_mode) {
+          transformers.emplace_back(std::make_unique<QLinearConvFusion>(qdq_is_int8_allowed, cpu_ep));
+        }
       }
 
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
@@ -335,6 +373,52 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<MatMulActivationFusion>(dml_ep));
 
+      // ElementwiseChainFusion takes the Add and Relu nodes that the Level3 Conv and NCHWc fusions would otherwise
+      // fold into the Conv, so it needs to be manually enabled.
+      if (enable_elementwise_chain_fusion) {
+        transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_cuda_eps));
+      }
+
+      // MLPreprocessingFusion changes the rounding of the linear models it folds a Scaler into, so it needs to be
+      // manually enabled.
+      if (enable_ml_preprocessing_fusion) {
+        transformers.emplace_back(std::make_unique<MLPreprocessingFusion>(cpu_ep));
+      }
+
+      // GatherBlockQuantization changes the values of the gathered rows, so it needs to be manually enabled. It runs
+      // after EmbedLayerNormFusion, which needs the float embedding tables.
+      if (gather_block_quantization_bits != "0") {
+        transformers.emplace_back(std::make_unique<GatherBlockQuantization>(
+            gather_block_quantization_bits == "4" ? 4 : 8, 32, GatherBlockQuantization::kDefaultMinElements, cpu_ep));
+      }
+
+      // ShapeExpressionFusion replaces the shape subgraphs that the attention and other fusions above match, so it
+      // runs after them. The ShapeExpression node is a contrib op with CPU and CUDA kernels only, and the optimized
+      // model needs it, so it needs to be manually enabled.
+      if (enable_shape_expression_fusion) {
+        transformers.emplace_back(std::make_unique<ShapeExpressionFusion>(cpu_cuda_eps));
+      }
+
+      // TensorParallelSharding runs after the Attention, Gelu and bias fusions so that it matches the fused blocks.
+      // The AllReduce nodes it adds only have CUDA kernels.
+      int64_t tensor_parallel_world_size = 1;
+      int64_t tensor_parallel_rank = 0;
+      ORT_ENFORCE(TryParseStringWithClassicLocale(
+                      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsTensorParallelWorldSize, "1"),
+                      tensor_parallel_world_size) &&
+                      tensor_parallel_world_size >= 1,
+                  "Invalid value for ", kOrtSessionOptionsTensorParallelWorldSize);
+      ORT_ENFORCE(TryParseStringWithClassicLocale(
+                      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsTensorParallelRank, "0"),
+                      tensor_parallel_rank) &&
+                      tensor_parallel_rank >= 0 && tensor_parallel_rank < tensor_parallel_world_size,
+                  "Invalid value for ", kOrtSessionOptionsTensorParallelRank);
+      if (tensor_parallel_world_size > 1) {
+        transformers.emplace_back(std::make_unique<TensorParallelSharding>(
+            tensor_parallel_rank, tensor_parallel_world_size,
+            InlinedHashSet<std::string_view>{onnxruntime::kCudaExecutionProvider}));
+      }
+
 #ifdef MLAS_TARGET_AMD64_IX86
       if (avx2_precision_mode) {
         transformers.emplace_back(std::make_unique<Avx2WeightS8ToU8Transformer>(cpu_ep));
@@ -355,7 +439,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerEnabler, "");
       const std::string probe_level =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerProbeLevel, "0");
-      transformers.emplace_back(std::make_unique<MemoryOptimizer>(enable_memory_optimizer, probe_level));
+      const std::string recompute_memory_budget =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerRecomputeBudget, "");
+      transformers.emplace_back(std::make_unique<MemoryOptimizer>(enable_memory_optimizer, probe_level,
+                                                                  recompute_memory_budget));
 #endif
 
     } break;
@@ -364,7 +451,9 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #ifndef DISABLE_CONTRIB_OPS
       // Register the NCHWc layout transformer if supported by the platform.
       if (MlasNchwcGetBlockSize() > 1) {
-        transformers.emplace_back(std::make_unique<NchwcTransformer>());
+        const bool use_nchwc_cost_model =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableNchwcCostModel, "0") == "1";
+        transformers.emplace_back(std::make_unique<NchwcTransformer>(use_nchwc_cost_model));
       }
       AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
       auto cpu_registry = cpu_execution_provider.GetKernelRegistry();
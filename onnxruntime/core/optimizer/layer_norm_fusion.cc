@@ -577,26 +577,49 @@ Status SimplifiedLayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int gr
     }
     nodes_to_remove.push_back(sqrt_node);
 
-    const Node* p_div = graph_utils::FirstChildByType(sqrt_node, "Div");
-    if (p_div == nullptr) {
+    // x / sqrt(...), or x * (1 / sqrt(...)) with Reciprocal or Div, as rsqrt is exported
+    const NodeArg* p_pow_input = pow_node.MutableInputDefs()[0];
+    Node& sqrt_consumer = *graph.GetNode(sqrt_node.OutputNodesBegin()->Index());
+    if (sqrt_consumer.GetExecutionProviderType() != pow_node.GetExecutionProviderType() ||
+        !optimizer_utils::CheckOutputEdges(graph, sqrt_consumer, 1) || !IsSupportedDataType(sqrt_consumer)) {
       continue;
     }
-    Node& div_node = *graph.GetNode(p_div->Index());
-    if (!graph_utils::IsSupportedOptypeVersionAndDomain(div_node, "Div", {7, 13, 14}) ||
-        div_node.GetExecutionProviderType() != pow_node.GetExecutionProviderType() ||
-        !optimizer_utils::CheckOutputEdges(graph, div_node, 1) || !IsSupportedDataType(div_node)) {
-      continue;
+
+    Node* p_normalize = nullptr;
+    bool is_reciprocal = false;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(sqrt_consumer, "Div", {7, 13, 14}) &&
+        sqrt_consumer.InputDefs()[1] == sqrt_node.OutputDefs()[0]) {
+      if (sqrt_consumer.InputDefs()[0] == p_pow_input) {
+        p_normalize = &sqrt_consumer;
+      } else {
+        is_reciprocal = optimizer_utils::IsInitializerWithExpectedValue(graph, *sqrt_consumer.InputDefs()[0], 1.0f,
+                                                                        true);
+      }
+    } else {
+      is_reciprocal = graph_utils::IsSupportedOptypeVersionAndDomain(sqrt_consumer, "Reciprocal", {6, 13});
+    }
+
+    if (is_reciprocal) {
+      nodes_to_remove.push_back(sqrt_consumer);
+      Node& reciprocal_mul_node = *graph.GetNode(sqrt_consumer.OutputNodesBegin()->Index());
+      const auto& mul_inputs = reciprocal_mul_node.InputDefs();
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(reciprocal_mul_node, "Mul", {7, 13, 14}) &&
+          reciprocal_mul_node.GetExecutionProviderType() == pow_node.GetExecutionProviderType() &&
+          optimizer_utils::CheckOutputEdges(graph, reciprocal_mul_node, 1) &&
+          IsSupportedDataType(reciprocal_mul_node) &&
+          (mul_inputs[0] == p_pow_input || mul_inputs[1] == p_pow_input)) {
+        p_normalize = &reciprocal_mul_node;
+      }
     }
-    nodes_to_remove.push_back(div_node);
 
-    // Check Div and Pow has same input, and if this input is a Cast, we can also remove it.
-    const NodeArg* p_div_input = div_node.MutableInputDefs()[0];
-    const NodeArg* p_pow_input = pow_node.MutableInputDefs()[0];
-    if (!p_pow_input || !p_div_input || p_div_input != p_pow_input) {
+    if (p_normalize == nullptr || p_pow_input == nullptr) {
       continue;
     }
+    Node& normalize_node = *p_normalize;
+    nodes_to_remove.push_back(normalize_node);
 
-    // There are only 4 possible cases (x=Pow->ReduceMean->Add->Sqrt->Div and cannot on fp16 type, y=Mul):
+    // There are only 4 possible cases (x=Pow->ReduceMean->Add->Sqrt->Div and cannot on fp16 type, y=Mul),
+    // where Div can also be Reciprocal->Mul or Div(1)->Mul:
     // 1. Cast(to:float)->x->Cast(to:fp16)->y : SimplifiedLayerNorm(T:fp16,V:fp16)
     // 2. Cast(to:float)->x->y : SimplifiedLayerNorm(T:fp16,V:float)
     // 3. x->Cast(to:fp16)->y : SimplifiedLayerNorm(T:float,V:fp16)
@@ -616,7 +639,7 @@ Status SimplifiedLayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int gr
                      skip_device_check_;
     if (is_gpu_ep && p_pow_input_node) {
       Node& pow_input_node = *graph.GetNode(p_pow_input_node->Index());
-      // If input to Pow is a Cast, and the Cast has 2 consumers only (Pow, Div)
+      // If input to Pow is a Cast, and the Cast has 2 consumers only (Pow, Div or Mul)
       if (graph_utils::IsSupportedOptypeVersionAndDomain(pow_input_node, "Cast", {9, 13, 19}) &&
           pow_input_node.GetExecutionProviderType() == pow_node.GetExecutionProviderType() &&
           optimizer_utils::CheckOutputEdges(graph, pow_input_node, 2)) {
@@ -626,7 +649,7 @@ Status SimplifiedLayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int gr
     }
 
     // div --> mul or div --> cast --> mul
-    Node* next_node = graph.GetNode(div_node.OutputNodesBegin()->Index());
+    Node* next_node = graph.GetNode(normalize_node.OutputNodesBegin()->Index());
     if (graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, "Cast", {9, 13, 19}) &&
         optimizer_utils::CheckOutputEdges(graph, *next_node, 1)) {
       if (!is_gpu_ep) continue;
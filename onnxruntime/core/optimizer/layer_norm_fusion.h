@@ -31,6 +31,7 @@ Rewrite graph fusing Layer Normalization subgraph to a single LayerNormalization
 
 The formula corresponding to LayerNorm activation subgraph:
 (x ) / sqrt(var(x, axis)) * scale, where x is the input, and var() is given by mean(x^2, axis).
+The division can also be a multiplication by Reciprocal(sqrt()) or Div(1, sqrt()), as RMSNorm with rsqrt is exported.
 
 */
 class SimplifiedLayerNormFusion : public GraphTransformer {
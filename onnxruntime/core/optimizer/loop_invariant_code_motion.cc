@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_invariant_code_motion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Whether the value is the same in each iteration of the body: a value of an outer scope or a constant initializer.
+bool IsLoopInvariant(const Graph& body, const NodeArg& arg) {
+  if (!arg.Exists() || graph_utils::GetConstantInitializer(body, arg.Name(), false) != nullptr) {
+    return true;
+  }
+
+  const auto& body_inputs = body.GetInputsIncludingInitializers();
+  return body.GetProducerNode(arg.Name()) == nullptr &&
+         std::find(body_inputs.begin(), body_inputs.end(), &arg) == body_inputs.end();
+}
+
+bool CanHoistNode(const Graph& body, Graph& graph, const Node& node,
+                  const InlinedHashSet<std::string_view>& compatible_providers) {
+  if (!graph_utils::IsSupportedProvider(node, compatible_providers) || node.ContainsSubgraph() ||
+      !optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType()) ||
+      body.NodeProducesGraphOutput(node)) {
+    return false;
+  }
+
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!IsLoopInvariant(body, *input)) {
+      return false;
+    }
+  }
+
+  // the outputs keep their names, so the nodes of the body and of its subgraphs read them from the outer scope
+  for (const NodeArg* output : node.OutputDefs()) {
+    if (output->Exists() && graph.GetNodeArgIncludingParentGraphs(output->Name()) != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Moves the node from the body into the graph that contains the Loop or Scan node.
+void HoistNode(Graph& body, Graph& graph, Node& node) {
+  std::vector<NodeArg*> inputs;
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!input->Exists()) {
+      inputs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+    } else if (const auto* initializer = graph_utils::GetConstantInitializer(body, input->Name(), false)) {
+      // another initializer or value of the graph may have the same name
+      TensorProto hoisted_initializer(*initializer);
+      hoisted_initializer.set_name(graph.GenerateNodeArgName(input->Name()));
+      inputs.push_back(&graph_utils::AddInitializer(graph, hoisted_initializer));
+    } else {
+      inputs.push_back(&graph.GetOrCreateNodeArg(input->Name(), input->TypeAsProto()));
+    }
+  }
+
+  std::vector<NodeArg*> outputs;
+  for (const NodeArg* output : node.OutputDefs()) {
+    outputs.push_back(&graph.GetOrCreateNodeArg(output->Name(), output->TypeAsProto()));
+  }
+
+  Node& hoisted_node = graph.AddNode(graph.GenerateNodeName(node.Name()), node.OpType(), node.Description(), inputs,
+                                     outputs, &node.GetAttributes(), node.Domain());
+  hoisted_node.SetExecutionProviderType(node.GetExecutionProviderType());
+  for (const NodeArg* output : outputs) {
+    if (output->Exists()) {
+      graph.UpdateProducerNode(output->Name(), hoisted_node.Index());
+    }
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (const Node* producer = graph.GetProducerNode(inputs[i]->Name())) {
+      graph.AddEdge(producer->Index(), hoisted_node.Index(),
+                    graph_utils::GetNodeOutputIndexFromOutputName(*producer, inputs[i]->Name()), static_cast<int>(i));
+    }
+  }
+
+  // the consumers in the body keep their NodeArgs, which are outer scope values now. Resolve adds the outputs to the
+  // implicit inputs of the Loop or Scan node.
+  graph_utils::RemoveNodeOutputEdges(body, node);
+  body.RemoveNode(node.Index());
+}
+
+}  // namespace
+
+Status LoopInvariantCodeMotion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // the bodies of If nodes run at most once, so nothing is saved by moving their nodes
+    if ((!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Loop", {1, 11, 13, 16, 19}) &&
+         !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scan", {8, 9, 11, 16, 19})) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    Graph& body = *node.GetMutableGraphAttribute("body");
+
+    // in topological order, the nodes that only read moved nodes are moved as well
+    GraphViewer body_viewer(body);
+    for (auto body_node_index : body_viewer.GetNodesInTopologicalOrder()) {
+      Node* body_node = body.GetNode(body_node_index);
+      if (body_node == nullptr || !CanHoistNode(body, graph, *body_node, GetCompatibleExecutionProviders())) {
+        continue;
+      }
+
+      LOGS(logger, VERBOSE) << "Moving loop invariant node " << body_node->Name() << " out of the body of "
+                            << node.Name();
+      HoistNode(body, graph, *body_node);
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,28 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class LoopInvariantCodeMotion
+Move the nodes of the body of a Loop or Scan node whose inputs are all outer scope values or constant initializers
+into the graph of the Loop or Scan node, so they run once instead of once per iteration. The constant initializers
+they read are copied to that graph. Nested subgraphs are handled first, so an invariant node moves up as many levels
+as it is invariant for.
+Once they are in the same graph, CommonSubexpressionElimination merges the moved nodes with the equal nodes of that
+graph and of the bodies of other Loop and Scan nodes, and ConstantSharing merges the copied initializers.
+The moved nodes run even if the Loop runs zero iterations.
+*/
+class LoopInvariantCodeMotion : public GraphTransformer {
+ public:
+  LoopInvariantCodeMotion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopInvariantCodeMotion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/ml_preprocessing_fusion.h"
+
+#include <cmath>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+static constexpr std::array supported_data_types{"tensor(float)"};
+
+// Folding a Scaler into a linear model moves -offset * scale into the intercepts, where it cancels against the
+// products of the coefficients with the scaled features. The fold is skipped above this magnitude, so the float
+// intercepts keep the precision of the original computation.
+constexpr double kMaxFoldedOffset = 16.0;
+
+// A stage of the chain, with its values in the layout of the MLPreprocessing attributes
+struct PreprocessingStep {
+  Node* node;
+  std::vector<float> values;
+  std::string norm;
+};
+
+std::vector<float> GetFloats(const Node& node, const std::string& name) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, name);
+  return attr == nullptr ? std::vector<float>{} : std::vector<float>(attr->floats().begin(), attr->floats().end());
+}
+
+// Whether the input of the node is a float tensor of rank 1 or 2, like the MLPreprocessing kernel takes
+bool HasRowInput(const Node& node) {
+  if (!optimizer_utils::IsSupportedDataType(node, supported_data_types)) {
+    return false;
+  }
+
+  const auto* shape = node.InputDefs()[0]->Shape();
+  return shape != nullptr && (shape->dim_size() == 1 || shape->dim_size() == 2);
+}
+
+// Adds the node to the chain if it is a stage the MLPreprocessing kernel runs, with valid attributes.
+bool TryAddPreprocessingStep(Node& node, const InlinedHashSet<std::string_view>& providers,
+                             InlinedVector<PreprocessingStep>& steps) {
+  if (!graph_utils::IsSupportedProvider(node, providers) || !HasRowInput(node)) {
+    return false;
+  }
+
+  PreprocessingStep step{&node, {}, {}};
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Imputer", {1}, kMLDomain)) {
+    const auto* replaced = graph_utils::GetNodeAttribute(node, "replaced_value_float");
+    std::vector<float> imputed = GetFloats(node, "imputed_value_floats");
+    if (replaced == nullptr || imputed.empty()) {
+      return false;
+    }
+    step.values.push_back(replaced->f());
+    step.values.insert(step.values.end(), imputed.begin(), imputed.end());
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain)) {
+    std::vector<float> offsets = GetFloats(node, "offset");
+    std::vector<float> scales = GetFloats(node, "scale");
+    if (scales.empty() || offsets.size() != scales.size()) {
+      return false;
+    }
+    step.values = std::move(offsets);
+    step.values.insert(step.values.end(), scales.begin(), scales.end());
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Binarizer", {1}, kMLDomain)) {
+    const auto* threshold = graph_utils::GetNodeAttribute(node, "threshold");
+    step.values.push_back(threshold == nullptr ? 1.f : threshold->f());
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Normalizer", {1}, kMLDomain)) {
+    const auto* norm = graph_utils::GetNodeAttribute(node, "norm");
+    if (norm == nullptr || (norm->s() != "MAX" && norm->s() != "L1" && norm->s() != "L2")) {
+      return false;
+    }
+    step.norm = norm->s();
+  } else {
+    return false;
+  }
+
+  steps.push_back(std::move(step));
+  return true;
+}
+
+// Folds the Scaler into the LinearClassifier or LinearRegressor that consumes it:
+//   W * ((x - o) * s) + b = (W * diag(s)) * x + (b - W * (o * s))
+bool TryFoldScaler(Graph& graph, Node& scaler, const InlinedHashSet<std::string_view>& providers,
+                   const logging::Logger& logger) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(scaler, "Scaler", {1}, kMLDomain) ||
+      !optimizer_utils::CheckOutputEdges(graph, scaler, 1)) {
+    return false;
+  }
+
+  Node& linear = *graph.GetNode(scaler.OutputNodesBegin()->Index());
+  const bool is_classifier = graph_utils::IsSupportedOptypeVersionAndDomain(linear, "LinearClassifier", {1},
+                                                                             kMLDomain);
+  if ((!is_classifier && !graph_utils::IsSupportedOptypeVersionAndDomain(linear, "LinearRegressor", {1}, kMLDomain)) ||
+      !graph_utils::IsSupportedProvider(linear, providers) ||
+      linear.GetExecutionProviderType() != scaler.GetExecutionProviderType() ||
+      !graph_utils::CanRemoveNode(graph, scaler, logger)) {
+    return false;
+  }
+
+  std::vector<float> coefficients = GetFloats(linear, "coefficients");
+  std::vector<float> intercepts = GetFloats(linear, "intercepts");
+  size_t num_outputs = intercepts.size();
+  if (!is_classifier) {
+    const auto* targets = graph_utils::GetNodeAttribute(linear, "targets");
+    if (targets == nullptr || targets->i() <= 0) {
+      return false;
+    }
+    num_outputs = static_cast<size_t>(targets->i());
+    // the intercepts are only used if there is one per target
+    if (intercepts.size() != num_outputs) {
+      intercepts.assign(num_outputs, 0.f);
+    }
+  }
+
+  if (num_outputs == 0 || coefficients.empty() || coefficients.size() % num_outputs != 0) {
+    return false;
+  }
+
+  const size_t num_features = coefficients.size() / num_outputs;
+  const std::vector<float> offsets = GetFloats(scaler, "offset");
+  const std::vector<float> scales = GetFloats(scaler, "scale");
+  if (scales.empty() || offsets.size() != scales.size() ||
+      (scales.size() != 1 && scales.size() != num_features)) {
+    return false;
+  }
+
+  std::vector<double> shifts(num_features);
+  for (size_t j = 0; j < num_features; ++j) {
+    const size_t f = scales.size() == 1 ? 0 : j;
+    shifts[j] = static_cast<double>(offsets[f]) * scales[f];
+    if (!(std::abs(shifts[j]) <= kMaxFoldedOffset) || !std::isfinite(scales[f])) {
+      return false;
+    }
+  }
+
+  for (size_t k = 0; k < num_outputs; ++k) {
+    double intercept = intercepts[k];
+    for (size_t j = 0; j < num_features; ++j) {
+      float& w = coefficients[k * num_features + j];
+      intercept -= static_cast<double>(w) * shifts[j];
+      w *= scales[scales.size() == 1 ? 0 : j];
+    }
+    intercepts[k] = static_cast<float>(intercept);
+  }
+
+  linear.AddAttribute("coefficients", coefficients);
+  linear.AddAttribute("intercepts", intercepts);
+  return graph_utils::RemoveNode(graph, scaler);
+}
+
+}  // namespace
+
+Status MLPreprocessingFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                        const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    InlinedVector<PreprocessingStep> steps;
+    if (!TryAddPreprocessingStep(node, GetCompatibleExecutionProviders(), steps)) {
+      continue;
+    }
+
+    Node* last_node = &node;
+    while (optimizer_utils::CheckOutputEdges(graph, *last_node, 1)) {
+      Node& next_node = *graph.GetNode(last_node->OutputNodesBegin()->Index());
+      if (next_node.InputDefs()[0] != last_node->OutputDefs()[0] ||
+          next_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          !TryAddPreprocessingStep(next_node, GetCompatibleExecutionProviders(), steps)) {
+        break;
+      }
+      last_node = &next_node;
+    }
+
+    // a trailing Scaler is cheaper as part of the gemm of the linear model than as a stage
+    if (TryFoldScaler(graph, *last_node, GetCompatibleExecutionProviders(), logger)) {
+      steps.pop_back();
+      modified = true;
+    }
+
+    if (steps.size() < 2) {
+      continue;
+    }
+
+    std::vector<std::string> stages;
+    std::vector<int64_t> value_counts;
+    std::vector<float> values;
+    std::vector<std::string> norms;
+    InlinedVector<std::reference_wrapper<Node>> nodes_to_fuse;
+    for (PreprocessingStep& step : steps) {
+      stages.push_back(step.node->OpType());
+      value_counts.push_back(static_cast<int64_t>(step.values.size()));
+      values.insert(values.end(), step.values.begin(), step.values.end());
+      if (!step.norm.empty()) {
+        norms.push_back(step.norm);
+      }
+      nodes_to_fuse.emplace_back(*step.node);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("MLPreprocessing"), "MLPreprocessing",
+                                     "fused ML preprocessing stages", {node.MutableInputDefs()[0]}, {}, nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("stages", stages);
+    fused_node.AddAttribute("value_counts", value_counts);
+    if (!values.empty()) {
+      fused_node.AddAttribute("values", values);
+    }
+    if (!norms.empty()) {
+      fused_node.AddAttribute("norms", norms);
+    }
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, nodes_to_fuse, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MLPreprocessingFusion
+Fuse chains of float Imputer, Scaler, Binarizer and Normalizer nodes of the ai.onnx.ml domain, where each node is the
+only consumer of the previous one, into one MLPreprocessing node that takes each block of rows through all of them.
+A Scaler that ends a chain and feeds a LinearClassifier or LinearRegressor is folded into the coefficients and
+intercepts of the linear model instead, when its offsets are small enough for the folded intercepts to stay accurate.
+*/
+class MLPreprocessingFusion : public GraphTransformer {
+ public:
+  MLPreprocessingFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MLPreprocessingFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <deque>
+#include <numeric>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/nchwc_transformer.h"
@@ -13,7 +14,8 @@ namespace onnxruntime {
 
 class NchwcTransformerImpl {
  public:
-  NchwcTransformerImpl(Graph& graph) noexcept : graph_(graph) {}
+  NchwcTransformerImpl(Graph& graph, const InlinedHashSet<NodeIndex>& excluded_nodes) noexcept
+      : graph_(graph), excluded_nodes_(excluded_nodes) {}
 
   void Transform(Node& node);
   void Finalize(bool& modified);
@@ -131,6 +133,10 @@ class NchwcTransformerImpl {
 
   Graph& graph_;
 
+  // Stores the Conv and pooling nodes that are left in NCHW format, as the
+  // cost model predicted that their NCHWc regions are slower.
+  const InlinedHashSet<NodeIndex>& excluded_nodes_;
+
   // Stores a queue of nodes to be removed after walking through the graph.
   std::deque<NodeIndex> removed_nodes_;
 
@@ -1147,10 +1153,14 @@ void NchwcTransformerImpl::Transform(Node& node) {
 
   if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
       graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain)) {
-    TransformConv(node);
+    if (excluded_nodes_.count(node.Index()) == 0) {
+      TransformConv(node);
+    }
   } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", {1, 8, 10, 11, 12}) ||
              graph_utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", {1, 7, 10, 11})) {
-    TransformPool(node);
+    if (excluded_nodes_.count(node.Index()) == 0) {
+      TransformPool(node);
+    }
   } else if (node.GetInputEdgesCount() == 0 && node.InputDefs().size() != 0) {
     // The following transforms only run when the input edge count has already
     // been decremented to zero by earlier transforms. This is a hint that the
@@ -1218,11 +1228,205 @@ void NchwcTransformerImpl::Finalize(bool& modified) {
   }
 }
 
+namespace {
+
+// Rough single-threaded costs of the NCHW and NCHWc paths, in nanoseconds. The NCHWc convolution kernels save a part
+// of the time of the im2col and GEMM path of the NCHW convolution, while the ReorderInput and ReorderOutput nodes at
+// the boundaries of an NCHWc region copy the whole tensor. Only the ratios between these matter.
+constexpr double kConvNsPerFlop = 1.0 / 64;
+constexpr double kNchwcConvSavings = 0.25;
+constexpr double kReorderNsPerElement = 0.25;
+
+enum class NchwcNodeKind {
+  kNone,
+  // Converted to NCHWc whatever the format of its input, like Conv and pooling.
+  kEntry,
+  // Converted to NCHWc only if its inputs are already in NCHWc format, like Add and Relu.
+  kFollower,
+};
+
+NchwcNodeKind GetNchwcNodeKind(const Node& node) {
+  if (node.GetExecutionProviderType() != kCpuExecutionProvider) {
+    return NchwcNodeKind::kNone;
+  }
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "MaxPool", {1, 8, 10, 11, 12}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "AveragePool", {1, 7, 10, 11})) {
+    return NchwcNodeKind::kEntry;
+  }
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sum", {6, 8, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "BatchNormalization", {7, 9, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Upsample", {9, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Resize", {10, 11, 13}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "GlobalMaxPool", {1}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "GlobalAveragePool", {1})) {
+    return NchwcNodeKind::kFollower;
+  }
+  return NchwcNodeKind::kNone;
+}
+
+// Returns the number of elements of the tensor, or a negative value if its shape isn't fully known.
+double GetNumElements(const NodeArg& arg) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return -1.0;
+  }
+  double num_elements = 1.0;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return -1.0;
+    }
+    num_elements *= static_cast<double>(dim.dim_value());
+  }
+  return num_elements;
+}
+
+// Predicted time saved by the NCHWc regions minus the time of the reorders they need.
+struct NchwcRegionCost {
+  double saved_ns{0.0};
+  double reorder_ns{0.0};
+  bool known{true};
+  InlinedVector<NodeIndex> entry_nodes;
+  InlinedHashSet<const NodeArg*> reordered_args;
+
+  void AddReorder(const NodeArg& arg) {
+    if (reordered_args.insert(&arg).second) {
+      const double num_elements = GetNumElements(arg);
+      known = known && num_elements >= 0.0;
+      reorder_ns += num_elements * kReorderNsPerElement;
+    }
+  }
+};
+
+// Groups the nodes that the transformer would convert into connected NCHWc regions, and returns the Conv and
+// pooling nodes of the regions whose reorders are predicted to cost more than their NCHWc kernels save. As the
+// regions are only connected through NCHW tensors, leaving a region in NCHW format doesn't change the cost of the
+// others. Regions with unknown shapes are converted, like without the cost model.
+InlinedHashSet<NodeIndex> PlanNchwcRegions(const Graph& graph, gsl::span<const NodeIndex> order) {
+  const size_t max_index = graph.MaxNodeIndex();
+  InlinedVector<NchwcNodeKind> kinds(max_index, NchwcNodeKind::kNone);
+  InlinedVector<NodeIndex> parents(max_index);
+  std::iota(parents.begin(), parents.end(), NodeIndex{0});
+  auto find_region = [&parents](NodeIndex index) {
+    while (parents[index] != index) {
+      parents[index] = parents[parents[index]];
+      index = parents[index];
+    }
+    return index;
+  };
+
+  auto get_nchwc_producer = [&](const NodeArg* arg) -> const Node* {
+    const Node* producer = graph.GetProducerNode(arg->Name());
+    return producer != nullptr && kinds[producer->Index()] != NchwcNodeKind::kNone ? producer : nullptr;
+  };
+
+  for (NodeIndex index : order) {
+    const Node* node = graph.GetNode(index);
+    if (node == nullptr) {
+      continue;
+    }
+    NchwcNodeKind kind = GetNchwcNodeKind(*node);
+    const auto& input_defs = node->InputDefs();
+    if (kind == NchwcNodeKind::kFollower) {
+      // BatchNormalization and Resize only take their data input in NCHWc format, the others all their inputs.
+      const size_t num_data_inputs = (node->OpType() == "BatchNormalization" || node->OpType() == "Resize" ||
+                                      node->OpType() == "Upsample")
+                                         ? 1
+                                         : input_defs.size();
+      for (size_t i = 0; i < num_data_inputs && i < input_defs.size(); ++i) {
+        if (get_nchwc_producer(input_defs[i]) == nullptr) {
+          kind = NchwcNodeKind::kNone;
+          break;
+        }
+      }
+    }
+    if (kind == NchwcNodeKind::kNone || input_defs.empty()) {
+      continue;
+    }
+
+    kinds[index] = kind;
+    for (const NodeArg* input_def : input_defs) {
+      if (const Node* producer = get_nchwc_producer(input_def)) {
+        parents[find_region(producer->Index())] = find_region(index);
+      }
+    }
+  }
+
+  InlinedHashMap<NodeIndex, NchwcRegionCost> regions;
+  for (NodeIndex index : order) {
+    if (kinds[index] == NchwcNodeKind::kNone) {
+      continue;
+    }
+    const Node& node = *graph.GetNode(index);
+    NchwcRegionCost& region = regions[find_region(index)];
+
+    if (kinds[index] == NchwcNodeKind::kEntry) {
+      region.entry_nodes.push_back(index);
+      const NodeArg& input = *node.InputDefs()[0];
+      bool reorders_input = get_nchwc_producer(&input) == nullptr;
+
+      const ONNX_NAMESPACE::TensorProto* weights = nullptr;
+      if (node.InputDefs().size() >= 2 && graph.GetInitializedTensor(node.InputDefs()[1]->Name(), weights) &&
+          weights->dims_size() == 4) {
+        // the NCHWc convolution reads an NCHW input with fewer channels than the block size directly
+        const auto* group_attr = graph_utils::GetNodeAttribute(node, "group");
+        const int64_t group_count = group_attr != nullptr && utils::HasInt(*group_attr) ? group_attr->i() : 1;
+        if (group_count == 1 && static_cast<size_t>(weights->dims(1)) < MlasNchwcGetBlockSize()) {
+          reorders_input = false;
+        }
+
+        const double num_outputs = GetNumElements(*node.OutputDefs()[0]);
+        const double flops_per_output =
+            2.0 * static_cast<double>(weights->dims(1) * weights->dims(2) * weights->dims(3));
+        region.known = region.known && num_outputs >= 0.0;
+        region.saved_ns += num_outputs * flops_per_output * kConvNsPerFlop * kNchwcConvSavings;
+      }
+
+      if (reorders_input) {
+        region.AddReorder(input);
+      }
+    }
+
+    // The output is reordered back to NCHW format for the nodes that aren't converted and for graph outputs.
+    const NodeArg& output = *node.OutputDefs()[0];
+    bool reorders_output = graph.IsOutput(&output);
+    for (const Node* consumer : graph.GetConsumerNodes(output.Name())) {
+      reorders_output = reorders_output || kinds[consumer->Index()] == NchwcNodeKind::kNone;
+    }
+    if (reorders_output) {
+      region.AddReorder(output);
+    }
+  }
+
+  InlinedHashSet<NodeIndex> excluded_nodes;
+  for (const auto& region : regions) {
+    if (region.second.known && region.second.reorder_ns > region.second.saved_ns) {
+      excluded_nodes.insert(region.second.entry_nodes.begin(), region.second.entry_nodes.end());
+    }
+  }
+  return excluded_nodes;
+}
+
+}  // namespace
+
 Status NchwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  NchwcTransformerImpl impl(graph);
   GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  InlinedHashSet<NodeIndex> excluded_nodes;
+  if (use_cost_model_) {
+    excluded_nodes = PlanNchwcRegions(graph, order);
+  }
 
-  for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
+  NchwcTransformerImpl impl(graph, excluded_nodes);
+  for (auto index : order) {
     auto& node = *graph.GetNode(index);
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
     if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
@@ -164,6 +164,41 @@ NhwcTransformer::NhwcTransformer(AllocatorPtr cpu_allocator, std::shared_ptr<Ker
           OpTransformInfo{nhwc_gavgpool_fp16.op_type_, nhwc_gavgpool_fp16.domain_, nhwc_gavgpool_fp16.version_, false});
     }
   }
+
+  {
+    // fp16 BatchNormalization -> fp16 nhwc BatchNormalization
+    OpKernelRegistryId nhwc_batchnorm_fp16{
+        "BatchNormalization", kMSInternalNHWCDomain, 15, {{"T", {DataTypeImpl::GetTensorType<MLFloat16>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_batchnorm_fp16.op_type_, nhwc_batchnorm_fp16.domain_,
+        nhwc_batchnorm_fp16.version_, nhwc_batchnorm_fp16.type_constraints_, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("BatchNormalization", kOnnxDomain, api::DataType::FLOAT16),
+          OpTransformInfo{nhwc_batchnorm_fp16.op_type_, nhwc_batchnorm_fp16.domain_, nhwc_batchnorm_fp16.version_, false});
+    }
+  }
+
+  {
+    // fp16 InstanceNormalization -> fp16 nhwc InstanceNormalization
+    OpKernelRegistryId nhwc_instancenorm_fp16{
+        "InstanceNormalization", kMSInternalNHWCDomain, 6, {{"T", {DataTypeImpl::GetTensorType<MLFloat16>()}}}};
+
+    const KernelCreateInfo* kernel_create_info{};
+    const auto status = cpu_kernel_registry->TryFindKernel(
+        kCpuExecutionProvider, nhwc_instancenorm_fp16.op_type_, nhwc_instancenorm_fp16.domain_,
+        nhwc_instancenorm_fp16.version_, nhwc_instancenorm_fp16.type_constraints_, &kernel_create_info);
+    if (status.IsOK() && kernel_create_info != nullptr) {
+      kernel_create_info = nullptr;
+      conv_table_.emplace(
+          OpIdInfo("InstanceNormalization", kOnnxDomain, api::DataType::FLOAT16),
+          OpTransformInfo{nhwc_instancenorm_fp16.op_type_, nhwc_instancenorm_fp16.domain_,
+                          nhwc_instancenorm_fp16.version_, false});
+    }
+  }
 };
 
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -213,7 +248,16 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     size_t rank = shape->dim_size();
     std::vector<int64_t> input_perm = ChannelFirstToLastPerm(rank);
     std::vector<int64_t> output_perm = ChannelLastToFirstPerm(rank);
-    WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+    std::vector<const std::vector<int64_t>*> input_perms{&input_perm};
+    // The sum fused into a QLinearConv has the layout of the output.
+    constexpr size_t qlinear_conv_sum_idx = 9;
+    const auto inputs = node->Inputs();
+    if (node->OpType() == "QLinearConv" && inputs.size() > qlinear_conv_sum_idx &&
+        !inputs[qlinear_conv_sum_idx].empty()) {
+      input_perms.resize(qlinear_conv_sum_idx + 1, nullptr);
+      input_perms[qlinear_conv_sum_idx] = &input_perm;
+    }
+    WrapTransposesAroundNode(*api_graph, *node, input_perms, {&output_perm});
 
     // Replace the operator if needed
     if (node->Domain() != transform->domain_ ||
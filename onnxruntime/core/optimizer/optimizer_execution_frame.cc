@@ -166,13 +166,20 @@ std::unique_ptr<const OpKernel> OptimizerExecutionFrame::Info::CreateKernel(cons
 }
 
 // For optimizer, probably no need to pass feed_mlvalue_idxs, feeds to initialize IExecutionFrame.
-// If needed, the parameters of OptimizerExecutionFrame ctor can be changed later.
 OptimizerExecutionFrame::OptimizerExecutionFrame(const Info& info,
                                                  const std::vector<int>& fetch_mlvalue_idxs,
                                                  const std::vector<OrtValue>& fetches)
+    : OptimizerExecutionFrame(info, gsl::span<const int>(), gsl::span<const OrtValue>(), fetch_mlvalue_idxs, fetches) {
+}
+
+OptimizerExecutionFrame::OptimizerExecutionFrame(const Info& info,
+                                                 gsl::span<const int> feed_mlvalue_idxs,
+                                                 gsl::span<const OrtValue> feeds,
+                                                 const std::vector<int>& fetch_mlvalue_idxs,
+                                                 const std::vector<OrtValue>& fetches)
     : IExecutionFrame(info.GetMLValueNameIdxMap(), info.GetNodeIndexInfo(), fetch_mlvalue_idxs),
       info_(info) {
-  Init(gsl::span<const int>(), gsl::span<const OrtValue>(), info.GetInitializers(), info.GetSparseInitializerLookupFunc(), fetches);
+  Init(feed_mlvalue_idxs, feeds, info.GetInitializers(), info.GetSparseInitializerLookupFunc(), fetches);
 }
 
 AllocatorPtr OptimizerExecutionFrame::GetAllocatorImpl(const OrtDevice&) const {
@@ -82,6 +82,14 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
                           const std::vector<int>& fetch_mlvalue_idxs,
                           const std::vector<OrtValue>& fetches = {});
 
+  // feeds are used for the values that are not initializers, e.g. to run the kernels of the nodes repeatedly with
+  // different inputs
+  OptimizerExecutionFrame(const Info& info,
+                          gsl::span<const int> feed_mlvalue_idxs,
+                          gsl::span<const OrtValue> feeds,
+                          const std::vector<int>& fetch_mlvalue_idxs,
+                          const std::vector<OrtValue>& fetches = {});
+
   ~OptimizerExecutionFrame() override = default;
 
  private:
@@ -0,0 +1,445 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qdq_transformer/qlinear_conv_fusion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/qdq_transformer/qdq_util.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// Inputs of QLinearConv. The sum and its quantization parameters are only in the com.microsoft domain.
+constexpr size_t kYScaleIdx = 6;
+constexpr size_t kYZeroPointIdx = 7;
+constexpr size_t kSumIdx = 9;
+constexpr size_t kOutScaleIdx = 12;
+constexpr size_t kOutZeroPointIdx = 13;
+
+// The activation fused into a QLinearConv: a Relu or Clip with constant min and max, and the Q node quantizing its
+// output.
+struct QuantizedActivation {
+  std::string activation;
+  std::vector<float> activation_params;
+  Node* activation_node = nullptr;
+  Node* q_node = nullptr;
+};
+
+bool IsQLinearConv(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearConv", {10}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "QLinearConv", {1}, kMSDomain);
+}
+
+int32_t ElemType(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr ? type->tensor_type().elem_type() : TensorProto_DataType_UNDEFINED;
+}
+
+bool Is8BitType(int32_t elem_type) {
+  return elem_type == TensorProto_DataType_UINT8 || elem_type == TensorProto_DataType_INT8;
+}
+
+// Whether the shapes are known to be the same. Symbolic dims match if they have the same name.
+bool HaveSameShape(const NodeArg& arg, const NodeArg& other) {
+  const auto* shape = arg.Shape();
+  const auto* other_shape = other.Shape();
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() != other_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < shape->dim_size(); ++i) {
+    const auto& dim = shape->dim(i);
+    const auto& other_dim = other_shape->dim(i);
+    if (utils::HasDimValue(dim) && utils::HasDimValue(other_dim)) {
+      if (dim.dim_value() != other_dim.dim_value()) {
+        return false;
+      }
+    } else if (!utils::HasDimParam(dim) || !utils::HasDimParam(other_dim) ||
+               dim.dim_param() != other_dim.dim_param()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Whether the scale or zero point args are the same tensor, or constant scalars of the same value.
+bool IsSameQuantParam(const Graph& graph, const NodeArg& arg, const NodeArg& other) {
+  if (arg.Name() == other.Name()) {
+    return true;
+  }
+
+  const TensorProto* proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  const TensorProto* other_proto = graph_utils::GetConstantInitializer(graph, other.Name());
+  if (proto == nullptr || other_proto == nullptr || proto->data_type() != other_proto->data_type()) {
+    return false;
+  }
+
+  Initializer value{*proto, graph.ModelPath()};
+  Initializer other_value{*other_proto, graph.ModelPath()};
+  const auto bytes = value.DataAsByteSpan();
+  const auto other_bytes = other_value.DataAsByteSpan();
+  return value.size() == 1 && other_value.size() == 1 &&
+         std::equal(bytes.begin(), bytes.end(), other_bytes.begin(), other_bytes.end());
+}
+
+// Whether the node is a Q or DQ node with constant scalar scale and zero point inputs.
+bool IsScalarQOrDQ(const Graph& graph, const Node& node, bool is_q) {
+  if (!(is_q ? QDQ::MatchQNode(node) : QDQ::MatchDQNode(node)) || node.InputDefs().size() != QDQ::TOTAL_COUNT) {
+    return false;
+  }
+
+  bool zero_point_exists = false;
+  return QDQ::QOrDQNodeHasConstantScalarScaleAndZeroPoint(
+             node, [&graph](const std::string& name) { return graph_utils::GetConstantInitializer(graph, name); },
+             zero_point_exists) &&
+         zero_point_exists;
+}
+
+// Returns the only consumer of the output of the node, if the output is not a graph output either.
+Node* GetOnlyConsumer(Graph& graph, const Node& node, const InlinedHashSet<std::string_view>& providers) {
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return nullptr;
+  }
+
+  Node* consumer = graph.GetNode(node.OutputNodesBegin()->Index());
+  return graph_utils::IsSupportedProvider(*consumer, providers) ? consumer : nullptr;
+}
+
+// Matches the output of the node -> Relu or Clip -> Q, where each node is the only consumer of the previous one.
+bool MatchQuantizedActivation(Graph& graph, const Node& node, const InlinedHashSet<std::string_view>& providers,
+                              QuantizedActivation& result) {
+  Node* activation_node = GetOnlyConsumer(graph, node, providers);
+  if (activation_node == nullptr) {
+    return false;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(*activation_node, "Relu", {6, 13, 14})) {
+    result.activation = "Relu";
+    result.activation_params.clear();
+  } else {
+    float min, max;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(*activation_node, "Clip", {6, 11, 12, 13}) ||
+        !optimizer_utils::GetClipConstantMinMax(graph, *activation_node, min, max)) {
+      return false;
+    }
+    result.activation = "Clip";
+    result.activation_params = {min, max};
+  }
+
+  Node* q_node = GetOnlyConsumer(graph, *activation_node, providers);
+  if (q_node == nullptr || !IsScalarQOrDQ(graph, *q_node, true)) {
+    return false;
+  }
+
+  result.activation_node = activation_node;
+  result.q_node = q_node;
+  return true;
+}
+
+// Adds a com.microsoft QLinearConv with the attributes of the convolution, and the activation if any.
+Node& AddQLinearConv(Graph& graph, const Node& conv, gsl::span<NodeArg* const> inputs,
+                     const QuantizedActivation* activation) {
+  Node& node = graph.AddNode(graph.GenerateNodeName("QLinearConv"), "QLinearConv", "fused QLinearConv", inputs, {},
+                             &conv.GetAttributes(), kMSDomain);
+  if (activation != nullptr) {
+    node.AddAttribute("activation", activation->activation);
+    if (!activation->activation_params.empty()) {
+      node.AddAttribute("activation_params", activation->activation_params);
+    }
+  }
+  node.SetExecutionProviderType(conv.GetExecutionProviderType());
+  return node;
+}
+
+// Replaces the nodes with the replacement, which takes the output of the last node and inputs of the replaced and
+// input nodes. The input nodes, like the DQ nodes of the inputs, are removed if they are left without consumers.
+void ReplaceNodes(Graph& graph, gsl::span<Node* const> nodes, gsl::span<Node* const> input_nodes, Node& replacement) {
+  InlinedHashMap<std::string, std::pair<NodeIndex, int>> producers;
+  auto add_producers = [&producers](const Node& node) {
+    for (auto it = node.InputEdgesBegin(), end = node.InputEdgesEnd(); it != end; ++it) {
+      producers.emplace(node.InputDefs()[it->GetDstArgIndex()]->Name(),
+                        std::make_pair(it->GetNode().Index(), it->GetSrcArgIndex()));
+    }
+  };
+  std::for_each(nodes.begin(), nodes.end(), [&](const Node* node) { add_producers(*node); });
+  std::for_each(input_nodes.begin(), input_nodes.end(), [&](const Node* node) { add_producers(*node); });
+
+  const auto& input_defs = replacement.InputDefs();
+  for (size_t i = 0; i < input_defs.size(); ++i) {
+    auto it = producers.find(input_defs[i]->Name());
+    if (input_defs[i]->Exists() && it != producers.end()) {
+      graph.AddEdge(it->second.first, replacement.Index(), it->second.second, static_cast<int>(i));
+    }
+  }
+
+  InlinedVector<NodeIndex> input_node_indices;
+  for (const Node* input_node : input_nodes) {
+    input_node_indices.push_back(input_node->Index());
+  }
+
+  graph_utils::FinalizeNodeFusion(graph, replacement, *nodes.back());
+  for (size_t i = nodes.size() - 1; i-- > 0;) {
+    graph_utils::RemoveNodeOutputEdges(graph, *nodes[i]);
+    graph.RemoveNode(nodes[i]->Index());
+  }
+
+  for (NodeIndex index : input_node_indices) {
+    const Node* input_node = graph.GetNode(index);
+    if (input_node != nullptr && input_node->GetOutputEdgesCount() == 0 && !graph.NodeProducesGraphOutput(*input_node)) {
+      graph.RemoveNode(index);
+    }
+  }
+}
+
+// DQ(x), DQ(w), [DQ(b)] -> Conv -> Relu or Clip -> Q, with the checks of the QDQ Conv selector.
+bool FuseQDQConv(Graph& graph, Node& conv, const InlinedHashSet<std::string_view>& providers, bool int8_allowed) {
+  const auto& conv_inputs = conv.InputDefs();
+  if (conv_inputs.size() < 2 || conv_inputs.size() > 3) {
+    return false;
+  }
+
+  InlinedVector<Node*> dq_nodes;
+  for (int i = 0; i < static_cast<int>(conv_inputs.size()); ++i) {
+    const Node* dq_node = graph_utils::GetInputNode(conv, i);
+    if (dq_node == nullptr || !QDQ::MatchDQNode(*dq_node) || dq_node->InputDefs().size() != QDQ::TOTAL_COUNT ||
+        !graph_utils::IsSupportedProvider(*dq_node, providers)) {
+      return false;
+    }
+    dq_nodes.push_back(graph.GetNode(dq_node->Index()));
+  }
+
+  // the input is quantized per tensor, and the weight per tensor or per output channel
+  const Node& dq_w = *dq_nodes[1];
+  const NodeArg& w_scale = *dq_w.InputDefs()[QDQ::SCALE_ID];
+  if (!IsScalarQOrDQ(graph, *dq_nodes[0], false) || !graph_utils::NodeArgIsConstant(graph, w_scale) ||
+      !graph_utils::NodeArgIsConstant(graph, *dq_w.InputDefs()[QDQ::ZERO_POINT_ID])) {
+    return false;
+  }
+  if (!optimizer_utils::IsScalar(w_scale)) {
+    const auto* axis = graph_utils::GetNodeAttribute(dq_w, "axis");
+    if (axis == nullptr || axis->i() != 0) {
+      return false;
+    }
+  }
+
+  const int32_t dt_input = ElemType(*dq_nodes[0]->InputDefs()[0]);
+  const int32_t dt_weight = ElemType(*dq_w.InputDefs()[0]);
+  if (!Is8BitType(dt_input) || !Is8BitType(dt_weight) ||
+      (dt_input == TensorProto_DataType_INT8 && (!int8_allowed || dt_weight != dt_input))) {
+    return false;
+  }
+  if (dq_nodes.size() == 3 && ElemType(*dq_nodes[2]->InputDefs()[0]) != TensorProto_DataType_INT32) {
+    return false;
+  }
+
+  QuantizedActivation activation;
+  if (!MatchQuantizedActivation(graph, conv, providers, activation) ||
+      ElemType(*activation.q_node->OutputDefs()[0]) != dt_input) {
+    return false;
+  }
+
+  InlinedVector<NodeArg*> inputs;
+  for (size_t i = 0; i < 2; ++i) {
+    const auto& dq_inputs = dq_nodes[i]->MutableInputDefs();
+    inputs.insert(inputs.end(), dq_inputs.begin(), dq_inputs.end());
+  }
+  inputs.push_back(activation.q_node->MutableInputDefs()[QDQ::SCALE_ID]);
+  inputs.push_back(activation.q_node->MutableInputDefs()[QDQ::ZERO_POINT_ID]);
+  if (dq_nodes.size() == 3) {
+    // the bias is quantized with the product of the input and weight scales, like in the QDQ Conv action
+    inputs.push_back(dq_nodes[2]->MutableInputDefs()[0]);
+  }
+
+  Node& qlinear_conv = AddQLinearConv(graph, conv, inputs, &activation);
+  InlinedVector<Node*> nodes{&conv, activation.activation_node, activation.q_node};
+  ReplaceNodes(graph, nodes, dq_nodes, qlinear_conv);
+  return true;
+}
+
+// QLinearConv -> QLinearAdd, or QLinearConv -> DQ -> Add with another DQ -> [Relu or Clip] -> Q. Returns the fused
+// QLinearConv.
+Node* FuseSum(Graph& graph, Node& conv, const InlinedHashSet<std::string_view>& providers) {
+  Node* consumer = GetOnlyConsumer(graph, conv, providers);
+  if (consumer == nullptr) {
+    return nullptr;
+  }
+
+  const NodeArg& conv_output = *conv.OutputDefs()[0];
+  const auto& conv_inputs = conv.InputDefs();
+  InlinedVector<Node*> nodes{&conv};
+  InlinedVector<Node*> input_nodes;
+  QuantizedActivation activation;
+  bool has_activation = false;
+  InlinedVector<NodeArg*> sum_inputs;  // sum, sum_scale, sum_zero_point, out_scale, out_zero_point
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(*consumer, "QLinearAdd", {1}, kMSDomain)) {
+    auto& add_inputs = consumer->MutableInputDefs();
+    if (add_inputs.size() != 8 ||
+        std::any_of(add_inputs.begin(), add_inputs.end(), [](const NodeArg* arg) { return !arg->Exists(); })) {
+      return nullptr;
+    }
+
+    const size_t conv_output_idx = add_inputs[0]->Name() == conv_output.Name() ? 0 : 3;
+    const size_t sum_idx = 3 - conv_output_idx;
+    if (add_inputs[conv_output_idx]->Name() != conv_output.Name() || add_inputs[sum_idx]->Name() == conv_output.Name() ||
+        !IsSameQuantParam(graph, *add_inputs[conv_output_idx + 1], *conv_inputs[kYScaleIdx]) ||
+        !IsSameQuantParam(graph, *add_inputs[conv_output_idx + 2], *conv_inputs[kYZeroPointIdx])) {
+      return nullptr;
+    }
+
+    sum_inputs = {add_inputs[sum_idx], add_inputs[sum_idx + 1], add_inputs[sum_idx + 2], add_inputs[6], add_inputs[7]};
+    nodes.push_back(consumer);
+  } else {
+    // the DQ of the output must dequantize it with the parameters it was quantized with
+    if (!IsScalarQOrDQ(graph, *consumer, false) ||
+        !IsSameQuantParam(graph, *consumer->InputDefs()[QDQ::SCALE_ID], *conv_inputs[kYScaleIdx]) ||
+        !IsSameQuantParam(graph, *consumer->InputDefs()[QDQ::ZERO_POINT_ID], *conv_inputs[kYZeroPointIdx])) {
+      return nullptr;
+    }
+
+    Node* add = GetOnlyConsumer(graph, *consumer, providers);
+    if (add == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*add, "Add", {7, 13, 14})) {
+      return nullptr;
+    }
+
+    const int sum_idx = add->InputDefs()[0]->Name() == consumer->OutputDefs()[0]->Name() ? 1 : 0;
+    const Node* sum_dq = graph_utils::GetInputNode(*add, sum_idx);
+    if (sum_dq == nullptr || sum_dq == consumer || !graph_utils::IsSupportedProvider(*sum_dq, providers) ||
+        !IsScalarQOrDQ(graph, *sum_dq, false)) {
+      return nullptr;
+    }
+
+    // Add -> Q, or Add -> Relu or Clip -> Q
+    Node* q_node = GetOnlyConsumer(graph, *add, providers);
+    if (q_node == nullptr) {
+      return nullptr;
+    }
+    if (!IsScalarQOrDQ(graph, *q_node, true)) {
+      if (!MatchQuantizedActivation(graph, *add, providers, activation)) {
+        return nullptr;
+      }
+      has_activation = true;
+      q_node = activation.q_node;
+    }
+
+    auto& sum_dq_inputs = graph.GetNode(sum_dq->Index())->MutableInputDefs();
+    auto& q_inputs = q_node->MutableInputDefs();
+    sum_inputs = {sum_dq_inputs[QDQ::INPUT_ID], sum_dq_inputs[QDQ::SCALE_ID], sum_dq_inputs[QDQ::ZERO_POINT_ID],
+                  q_inputs[QDQ::SCALE_ID], q_inputs[QDQ::ZERO_POINT_ID]};
+    if (ElemType(*q_node->OutputDefs()[0]) != ElemType(conv_output)) {
+      return nullptr;
+    }
+
+    nodes.insert(nodes.end(), {consumer, add});
+    if (has_activation) {
+      nodes.push_back(activation.activation_node);
+    }
+    nodes.push_back(q_node);
+    input_nodes.push_back(graph.GetNode(sum_dq->Index()));
+  }
+
+  // the sum is added without broadcasting
+  const NodeArg& sum = *sum_inputs[0];
+  if (ElemType(sum) != ElemType(conv_output) || !HaveSameShape(sum, conv_output)) {
+    return nullptr;
+  }
+
+  InlinedVector<NodeArg*> inputs(conv.MutableInputDefs().begin(), conv.MutableInputDefs().end());
+  inputs.resize(kSumIdx, &graph.GetOrCreateNodeArg("", nullptr));
+  inputs.insert(inputs.end(), sum_inputs.begin(), sum_inputs.end());
+
+  Node& qlinear_conv = AddQLinearConv(graph, conv, inputs, has_activation ? &activation : nullptr);
+  ReplaceNodes(graph, nodes, input_nodes, qlinear_conv);
+  return &qlinear_conv;
+}
+
+// QLinearConv -> DQ -> Relu or Clip -> Q
+bool FuseActivation(Graph& graph, Node& conv, const InlinedHashSet<std::string_view>& providers) {
+  const auto& conv_inputs = conv.InputDefs();
+  const bool has_sum = conv_inputs.size() > kSumIdx && conv_inputs[kSumIdx]->Exists();
+  const size_t scale_idx = has_sum ? kOutScaleIdx : kYScaleIdx;
+  const size_t zero_point_idx = has_sum ? kOutZeroPointIdx : kYZeroPointIdx;
+
+  Node* dq_node = GetOnlyConsumer(graph, conv, providers);
+  if (dq_node == nullptr || !IsScalarQOrDQ(graph, *dq_node, false) ||
+      !IsSameQuantParam(graph, *dq_node->InputDefs()[QDQ::SCALE_ID], *conv_inputs[scale_idx]) ||
+      !IsSameQuantParam(graph, *dq_node->InputDefs()[QDQ::ZERO_POINT_ID], *conv_inputs[zero_point_idx])) {
+    return false;
+  }
+
+  QuantizedActivation activation;
+  if (!MatchQuantizedActivation(graph, *dq_node, providers, activation) ||
+      ElemType(*activation.q_node->OutputDefs()[0]) != ElemType(*conv.OutputDefs()[0])) {
+    return false;
+  }
+
+  // the output is quantized with the parameters of the Q node instead
+  InlinedVector<NodeArg*> inputs(conv.MutableInputDefs().begin(), conv.MutableInputDefs().end());
+  inputs[scale_idx] = activation.q_node->MutableInputDefs()[QDQ::SCALE_ID];
+  inputs[zero_point_idx] = activation.q_node->MutableInputDefs()[QDQ::ZERO_POINT_ID];
+
+  Node& qlinear_conv = AddQLinearConv(graph, conv, inputs, &activation);
+  InlinedVector<Node*> nodes{&conv, dq_node, activation.activation_node, activation.q_node};
+  ReplaceNodes(graph, nodes, {}, qlinear_conv);
+  return true;
+}
+
+}  // namespace
+
+Status QLinearConvFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  const auto& providers = GetCompatibleExecutionProviders();
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, providers)) {
+      continue;
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11})) {
+      if (FuseQDQConv(graph, node, providers, int8_allowed_)) {
+        modified = true;
+      }
+      continue;
+    }
+
+    const auto& input_defs = node.InputDefs();
+    if (!IsQLinearConv(node) || graph_utils::GetNodeAttribute(node, "activation") != nullptr ||
+        (input_defs.size() > kSumIdx && input_defs[kSumIdx]->Exists())) {
+      continue;
+    }
+
+    // the sum is added before the activation
+    Node* conv = &node;
+    if (Node* fused_conv = FuseSum(graph, *conv, providers)) {
+      modified = true;
+      if (graph_utils::GetNodeAttribute(*fused_conv, "activation") != nullptr) {
+        continue;
+      }
+      conv = fused_conv;
+    }
+
+    if (FuseActivation(graph, *conv, providers)) {
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class QLinearConvFusion
+Fuse the quantized nodes around a convolution into the requantization of a com.microsoft QLinearConv:
+- DQ(x), DQ(w), [DQ(b)] -> Conv -> Relu or Clip -> Q, into a QLinearConv with the activation.
+- QLinearConv -> QLinearAdd, and QLinearConv -> DQ -> Add with another DQ -> [Relu or Clip] -> Q, into a QLinearConv
+  with the sum and the optional activation. These are the residual connections of ResNet like models.
+- QLinearConv -> DQ -> Relu or Clip -> Q, into a QLinearConv with the activation.
+Quantization is monotonic, so the activation is computed as a clamp of the quantized output.
+*/
+class QLinearConvFusion : public GraphTransformer {
+ public:
+  QLinearConvFusion(bool int8_allowed,
+                    const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QLinearConvFusion", compatible_execution_providers), int8_allowed_(int8_allowed) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  // Whether int8 activations are allowed, as in the QDQ Conv selector.
+  const bool int8_allowed_;
+};
+
+}  // namespace onnxruntime
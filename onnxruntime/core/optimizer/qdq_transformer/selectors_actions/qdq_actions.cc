@@ -113,6 +113,26 @@ QDQReplaceWithNew MatMulIntToFloatReplacer() {
   return QDQReplaceWithNew(kMSDomain, "MatMulIntegerToFloat", std::move(moves));
 }
 
+QDQReplaceWithNew QAttentionReplacer() {
+  NTO::NodeLocation dq_input{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation dq_weights{NTO::NodeType::kInput, 1};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAndAppend(dq_input, ArgType::kInput, 0, ArgType::kInput),    // input
+      MoveAndAppend(dq_weights, ArgType::kInput, 0, ArgType::kInput),  // weight
+      MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput),      // bias
+      MoveAndAppend(dq_input, ArgType::kInput, 1, ArgType::kInput),    // input_scale
+      MoveAndAppend(dq_weights, ArgType::kInput, 1, ArgType::kInput),  // weight_scale
+      MoveAndAppend(target, ArgType::kInput, 3, ArgType::kInput),      // mask_index
+      MoveAndAppend(dq_input, ArgType::kInput, 2, ArgType::kInput),    // input_zero_point
+      MoveAndAppend(dq_weights, ArgType::kInput, 2, ArgType::kInput),  // weight_zero_point
+      MoveAndAppend(target, ArgType::kInput, 4, ArgType::kInput),      // past
+      MoveAll(target, ArgType::kOutput)};
+
+  return QDQReplaceWithNew(kMSDomain, "QAttention", std::move(moves));
+}
+
 struct SetOptionalZeroPoint {
   static void UpdateNodes(Graph&, const NodesToOptimize& selected_nodes);
 
@@ -289,6 +309,37 @@ GemmReplaceWithQuant::GemmReplaceWithQuant()
       qgemm_with_8bits_as_output_replacer_(kMSDomain, "QGemm", GetGemmMoveInfo(true)) {
 }
 
+AttentionReplaceWithQAttention::AttentionReplaceWithQAttention()
+    : qattention_replacer_(QAttentionReplacer()) {
+}
+
+void AttentionReplaceWithQAttention::AddMissingOptionalInputs(Graph& graph, const NodesToOptimize& selected_nodes) {
+  // inputs 3 (mask_index) and 4 (past) are moved to QAttention
+  constexpr size_t kNumMovedInputs = 5;
+  Node& target = selected_nodes.Target();
+  auto& input_defs = target.MutableInputDefs();
+  while (input_defs.size() < kNumMovedInputs) {
+    input_defs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+    target.MutableInputArgsCount().push_back(1);
+  }
+}
+
+Status AttentionReplaceWithQAttention::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  AddMissingOptionalInputs(graph, selected_nodes);
+  return qattention_replacer_.Run(graph, selected_nodes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status AttentionReplaceWithQAttention::RunForSave(Graph& graph,
+                                                  const NodesToOptimize& selected_nodes,
+                                                  const SatRuntimeOptimizationSaveContext& save_context,
+                                                  SavedState& saved_state,
+                                                  bool& graph_modified) const {
+  AddMissingOptionalInputs(graph, selected_nodes);
+  return qattention_replacer_.RunForSave(graph, selected_nodes, save_context, saved_state, graph_modified);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 Status GemmReplaceWithQuant::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
   RemoveAttrBeta(selected_nodes);
   bool is_output_float = selected_nodes.num_outputs == 0;
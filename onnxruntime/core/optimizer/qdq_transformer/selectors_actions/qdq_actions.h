@@ -96,5 +96,25 @@ struct GemmReplaceWithQuant : public Action {
   QDQReplaceWithNew qgemm_with_8bits_as_output_replacer_;
 };
 
+// replace Attention with QAttention. The input and weights come from DQ nodes, and the output stays float.
+struct AttentionReplaceWithQAttention : public Action {
+  AttentionReplaceWithQAttention();
+
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& /*graph*/, const NodesToOptimize& /*selected_nodes*/,
+                    const SatRuntimeOptimizationSaveContext& /*save_context*/,
+                    SavedState& /*saved_state*/, bool& /*graph_modified*/) const override;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+  // QAttention takes the optional mask_index and past at other positions, so give Attention empty entries for the
+  // missing ones for them to be moved.
+  static void AddMissingOptionalInputs(Graph& graph, const NodesToOptimize& selected_nodes);
+
+ private:
+  QDQReplaceWithNew qattention_replacer_;
+};
+
 }  // namespace QDQ
 }  // namespace onnxruntime
@@ -94,6 +94,7 @@ void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::UnarySelector>();
   qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
                                                          {{"AveragePool", {}},
+                                                          {"Gelu", {1}},  // com.microsoft Gelu
                                                           {"LeakyRelu", {}},
                                                           {"GlobalAveragePool", {}},
                                                           {"Sigmoid", {}},
@@ -226,6 +227,26 @@ void WhereQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void AttentionQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. 0=DQ input, 1=DQ weights, 2=Attention
+  // Replace with QAttention. The output stays float, so any Q nodes consuming it are left alone.
+  // Delete all original nodes.
+  const std::string action_name{"Attention"};
+
+  std::unique_ptr<Action> action = std::make_unique<QDQ::AttentionReplaceWithQAttention>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::AttentionSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Attention", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
   SelectorActionRegistry qdq_selector_action_registry;
   SplitQDQRules(qdq_selector_action_registry);
@@ -238,6 +259,7 @@ SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
   MatMulQDQRules(qdq_selector_action_registry, is_int8_allowed);
   GemmQDQRules(qdq_selector_action_registry);
   WhereQDQRules(qdq_selector_action_registry);
+  AttentionQDQRules(qdq_selector_action_registry);
 
   return qdq_selector_action_registry;
 }
@@ -330,6 +330,63 @@ bool WhereNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node&
          dt_input_1 == dt_output;
 }
 
+bool AttentionNodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                       const Node& node,
+                                       const std::vector<const Node*>& dq_nodes,
+                                       const std::vector<const Node*>& /*q_nodes*/) const {
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, {}, 2 /*num_dq_inputs*/, true /*is_empty_q_nodes_allowed*/)) {
+    return false;
+  }
+
+  // the DQ nodes must provide the input and the weights
+  const auto& input_defs = node.InputDefs();
+  if (dq_nodes[0]->OutputDefs()[0] != input_defs[0] || dq_nodes[1]->OutputDefs()[0] != input_defs[1]) {
+    return false;
+  }
+
+  // QAttention requires the bias, and has no relative_position_bias or past_sequence_length input
+  auto has_input = [&input_defs](size_t idx) { return idx < input_defs.size() && input_defs[idx]->Exists(); };
+  if (!has_input(2) || has_input(5) || has_input(6)) {
+    return false;
+  }
+
+  // QAttention has no qkv_hidden_sizes, and the CPU kernel doesn't handle rotary embeddings or a shared past buffer
+  const auto& attributes = node.GetAttributes();
+  if (attributes.find("qkv_hidden_sizes") != attributes.end()) {
+    return false;
+  }
+  for (const char* name : {"do_rotary", "past_present_share_buffer"}) {
+    const auto it = attributes.find(name);
+    if (it != attributes.end() && it->second.i() != 0) {
+      return false;
+    }
+  }
+
+  // the CPU kernel supports a uint8 input quantized per tensor, and uint8 or int8 weights quantized per tensor or
+  // per column
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_input != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8 ||
+      !optimizer_utils::IsScalar(*dq_nodes[0]->InputDefs()[InputIndex::SCALE_ID])) {
+    return false;
+  }
+
+  if (!optimizer_utils::IsScalar(*dq_nodes[1]->InputDefs()[InputIndex::SCALE_ID])) {
+    const auto& dq_attributes = dq_nodes[1]->GetAttributes();
+    const auto axis = dq_attributes.find("axis");
+    const int64_t axis_value = axis != dq_attributes.end() ? axis->second.i() : 1;
+    if (axis_value != 1 && axis_value != -1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void AttentionSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  // QAttention produces float output, so leave any Q nodes consuming it alone
+  builder.output_nodes.clear();
+}
+
 bool InstanceAndLayerNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer,
                                                            const Node& node,
                                                            const std::vector<const Node*>& dq_nodes,
@@ -137,6 +137,15 @@ class GemmNodeGroupSelector : public NodeGroupSelector {
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// Input: DQ nodes for input and weights. The bias, mask and past are not quantized.
+// Output: float. QAttention produces float output, so Q nodes consuming it are not part of the group.
+class AttentionNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // Input: DQ nodes for input, scale, and B
 // Output: Q node for output
 class InstanceAndLayerNormalizationNodeGroupSelector : public NodeGroupSelector {
@@ -259,6 +268,16 @@ class GemmSelector : public BaseSelector {
   void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
 };
 
+// Input: DQ nodes for input and weights
+// Output: float
+class AttentionSelector : public BaseSelector {
+ public:
+  AttentionSelector()
+      : BaseSelector(std::make_unique<AttentionNodeGroupSelector>()) {}
+
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 // Input: DQ nodes for input, scale, and B (bias)
 // Output: Q node for output
 class InstanceNormalizationSelector : public BaseSelector {
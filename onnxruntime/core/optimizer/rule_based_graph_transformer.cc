@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/rule_based_graph_transformer.h"
+
+#include <algorithm>
+
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/rewrite_rule.h"
 
@@ -39,48 +42,80 @@ Status RuleBasedGraphTransformer::ApplyRulesOnNode(Graph& graph, Node& node,
   return Status::OK();
 }
 
-Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
-  GraphViewer graph_viewer(graph);
-  auto& order = graph_viewer.GetNodesInTopologicalOrder();
+namespace {
+
+// Bounds the passes over the nodes around the rewrites, in case rules keep rewriting each other's results.
+constexpr int kMaxIncrementalPasses = 10;
+
+void AddNodeAndNeighbors(const Node& node, InlinedHashSet<NodeIndex>& nodes) {
+  nodes.insert(node.Index());
+  for (auto it = node.InputNodesBegin(), end = node.InputNodesEnd(); it != end; ++it) {
+    nodes.insert(it->Index());
+  }
+  for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+    nodes.insert(it->Index());
+  }
+}
 
-  for (NodeIndex i : order) {
+}  // namespace
+
+Status RuleBasedGraphTransformer::ApplyRulesOnNodes(Graph& graph, gsl::span<const NodeIndex> node_indices,
+                                                    bool recurse, bool& modified, int graph_level,
+                                                    InlinedHashSet<NodeIndex>& nodes_to_revisit,
+                                                    const logging::Logger& logger) const {
+  const auto* any_op_rules = GetAnyOpRewriteRules();
+  InlinedHashSet<NodeIndex> neighbors;
+  for (NodeIndex i : node_indices) {
     auto* node = graph.GetNode(i);
     // A node might not be found as it might have already been deleted from one of the rules.
     if (!node) {
       continue;
     }
 
-    // Initialize the effect of rules on this node to denote that the graph has not yet been modified
-    // by the rule application on the current node.
-    auto rule_effect = RuleEffect::kNone;
-
     if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
       continue;
     }
 
-    // First apply rewrite rules that are registered for the op type of the current node; then apply rules that are
-    // registered to be applied regardless of the op type; then recursively apply rules to subgraphs (if any).
-    // Stop further rule application for the current node, if the node gets removed by a rule.
-    const InlinedVector<std::reference_wrapper<const RewriteRule>>* rules = nullptr;
-
-    rules = GetRewriteRulesForOpType(node->OpType());
-    if (rules) {
-      ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, *node, *rules, rule_effect, logger));
-    }
+    // Initialize the effect of rules on this node to denote that the graph has not yet been modified
+    // by the rule application on the current node.
+    auto rule_effect = RuleEffect::kNone;
 
-    if (rule_effect != RuleEffect::kRemovedCurrentNode) {
-      rules = GetAnyOpRewriteRules();
+    const auto* rules = GetRewriteRulesForOpType(node->OpType());
+    if (rules || !any_op_rules->empty()) {
+      // The neighbors of the node are collected before the rules run, as they are gone if the node is removed.
+      // Rules look at the nodes next to the one they are triggered on, so the neighbors are the nodes whose rules
+      // may apply after a rewrite.
+      neighbors.clear();
+      AddNodeAndNeighbors(*node, neighbors);
+      const NodeIndex first_new_node = graph.MaxNodeIndex();
+
+      // First apply rewrite rules that are registered for the op type of the current node; then apply rules that are
+      // registered to be applied regardless of the op type.
+      // Stop further rule application for the current node, if the node gets removed by a rule.
       if (rules) {
         ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, *node, *rules, rule_effect, logger));
       }
-    }
 
-    // Update the modified field of the rule-based transformer.
-    if (rule_effect != RuleEffect::kNone) {
-      modified = true;
+      if (rule_effect != RuleEffect::kRemovedCurrentNode) {
+        ORT_RETURN_IF_ERROR(ApplyRulesOnNode(graph, *node, *any_op_rules, rule_effect, logger));
+      }
+
+      if (rule_effect != RuleEffect::kNone) {
+        modified = true;
+        nodes_to_revisit.insert(neighbors.begin(), neighbors.end());
+        if (rule_effect != RuleEffect::kRemovedCurrentNode) {
+          AddNodeAndNeighbors(*node, nodes_to_revisit);
+        }
+        for (NodeIndex new_node = first_new_node; new_node < graph.MaxNodeIndex(); ++new_node) {
+          if (const auto* added = graph.GetNode(new_node)) {
+            AddNodeAndNeighbors(*added, nodes_to_revisit);
+          }
+        }
+      }
     }
 
-    if (rule_effect != RuleEffect::kRemovedCurrentNode) {
+    // Recursively apply rules to subgraphs (if any), which visit their own nodes incrementally.
+    if (recurse && rule_effect != RuleEffect::kRemovedCurrentNode) {
       ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
     }
   }
@@ -88,6 +123,28 @@ Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int gr
   return Status::OK();
 }
 
+Status RuleBasedGraphTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  InlinedHashSet<NodeIndex> nodes_to_revisit;
+  {
+    GraphViewer graph_viewer(graph);
+    const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+    ORT_RETURN_IF_ERROR(ApplyRulesOnNodes(graph, order, /*recurse*/ true, modified, graph_level, nodes_to_revisit,
+                                          logger));
+  }
+
+  // Instead of another pass over the whole graph, only the nodes around the rewrites are revisited until no rule
+  // applies to them. Node indices grow with the nodes that rules add, which roughly keeps producers before consumers.
+  for (int pass = 1; pass < kMaxIncrementalPasses && !nodes_to_revisit.empty(); ++pass) {
+    InlinedVector<NodeIndex> nodes(nodes_to_revisit.begin(), nodes_to_revisit.end());
+    std::sort(nodes.begin(), nodes.end());
+    nodes_to_revisit.clear();
+    ORT_RETURN_IF_ERROR(ApplyRulesOnNodes(graph, nodes, /*recurse*/ false, modified, graph_level, nodes_to_revisit,
+                                          logger));
+  }
+
+  return Status::OK();
+}
+
 size_t RuleBasedGraphTransformer::RulesCount() const {
   return rules_.size();
 }
@@ -0,0 +1,444 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/shape_expression_fusion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// The opcodes of the program of a ShapeExpression node, see its schema.
+constexpr int64_t kConst = 0;
+constexpr int64_t kDim = 1;
+constexpr int64_t kAdd = 2;
+constexpr int64_t kSub = 3;
+constexpr int64_t kMul = 4;
+constexpr int64_t kDiv = 5;
+constexpr int64_t kEnd = 6;
+
+// Shape subgraphs compute a few small values, so larger ones are left alone
+constexpr size_t kMaxElements = 16;
+constexpr size_t kMaxExpressionSize = 64;
+constexpr int kMaxDepth = 64;
+
+// The postfix program of one int64 value, without the kEnd opcode
+using Expression = InlinedVector<int64_t, 8>;
+
+// A value of the shape subgraph: a scalar or a 1D tensor, with the expression of each element
+struct ShapeValue {
+  InlinedVector<Expression, 4> elements;
+  bool is_scalar{false};
+};
+
+bool GetConstant(const Expression& expression, int64_t& value) {
+  if (expression.size() != 2 || expression[0] != kConst) {
+    return false;
+  }
+  value = expression[1];
+  return true;
+}
+
+bool IsInt64Tensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->tensor_type().elem_type() == TensorProto_DataType_INT64;
+}
+
+// Whether the axes are the one axis of a 1D value, which is either 0 or -1
+bool IsAxisZero(const InlinedVector<int64_t, 4>& axes) {
+  return axes.size() == 1 && (axes[0] == 0 || axes[0] == -1);
+}
+
+// Evaluates the values of a shape subgraph as expressions of the dims of the tensors whose shapes it takes.
+class ShapeExpressionBuilder {
+ public:
+  ShapeExpressionBuilder(Graph& graph, const InlinedHashSet<std::string_view>& compatible_providers)
+      : graph_(graph), compatible_providers_(compatible_providers) {}
+
+  bool Evaluate(const NodeArg& arg, ShapeValue& value, int depth = 0) {
+    auto it = values_.find(&arg);
+    if (it != values_.end()) {
+      value = it->second;
+      return true;
+    }
+
+    if (depth > kMaxDepth) {
+      return false;
+    }
+
+    bool evaluated = false;
+    if (const auto* initializer = graph_utils::GetConstantInitializer(graph_, arg.Name())) {
+      evaluated = EvaluateInitializer(*initializer, value);
+    } else if (const Node* node = graph_.GetProducerNode(arg.Name())) {
+      evaluated = EvaluateNode(*node, value, depth);
+      if (evaluated) {
+        nodes_.push_back(node->Index());
+      }
+    }
+
+    if (evaluated) {
+      values_.emplace(&arg, value);
+    }
+    return evaluated;
+  }
+
+  // The tensors whose dims the program reads, which are the inputs of the ShapeExpression node
+  const std::vector<NodeArg*>& Inputs() const { return inputs_; }
+
+  // The nodes of the subgraph, with each node after the nodes it takes values from
+  const InlinedVector<NodeIndex>& Nodes() const { return nodes_; }
+
+  // The EP of the Shape nodes, which has the input tensors
+  const std::string& ExecutionProviderType() const { return shape_provider_; }
+
+ private:
+  bool EvaluateInitializer(const TensorProto& tensor, ShapeValue& value) {
+    if (tensor.dims_size() > 1) {
+      return false;
+    }
+
+    Initializer initializer(tensor, graph_.ModelPath());
+    if (initializer.size() > kMaxElements) {
+      return false;
+    }
+
+    value.is_scalar = tensor.dims_size() == 0;
+    if (initializer.data_type() == TensorProto_DataType_INT64) {
+      for (int64_t v : initializer.DataAsSpan<int64_t>()) {
+        value.elements.push_back({kConst, v});
+      }
+    } else if (initializer.data_type() == TensorProto_DataType_INT32) {
+      for (int32_t v : initializer.DataAsSpan<int32_t>()) {
+        value.elements.push_back({kConst, v});
+      }
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // Evaluates an optional input whose elements all have to be constants.
+  bool EvaluateConstants(const Node& node, size_t index, InlinedVector<int64_t, 4>& constants, int depth,
+                         bool* is_scalar = nullptr) {
+    const auto& inputs = node.InputDefs();
+    if (index >= inputs.size() || !inputs[index]->Exists()) {
+      return true;
+    }
+
+    ShapeValue value;
+    if (!Evaluate(*inputs[index], value, depth + 1)) {
+      return false;
+    }
+
+    for (const Expression& element : value.elements) {
+      int64_t constant;
+      if (!GetConstant(element, constant)) {
+        return false;
+      }
+      constants.push_back(constant);
+    }
+    if (is_scalar != nullptr) {
+      *is_scalar = value.is_scalar;
+    }
+    return true;
+  }
+
+  // Returns the index of the tensor in the inputs of the ShapeExpression node.
+  int64_t AddInput(const NodeArg& arg) {
+    NodeArg* input = graph_.GetNodeArg(arg.Name());
+    auto it = std::find(inputs_.begin(), inputs_.end(), input);
+    if (it == inputs_.end()) {
+      inputs_.push_back(input);
+      return static_cast<int64_t>(inputs_.size() - 1);
+    }
+    return static_cast<int64_t>(it - inputs_.begin());
+  }
+
+  bool EvaluateShape(const Node& node, ShapeValue& value) {
+    const auto* shape = node.InputDefs()[0]->Shape();
+    if (shape == nullptr ||
+        (!shape_provider_.empty() && shape_provider_ != node.GetExecutionProviderType())) {
+      return false;
+    }
+    shape_provider_ = node.GetExecutionProviderType();
+
+    const int64_t rank = shape->dim_size();
+    auto get_bound = [&](const char* name, int64_t default_value) {
+      const auto* attr = graph_utils::GetNodeAttribute(node, name);
+      int64_t bound = attr == nullptr ? default_value : attr->i();
+      if (bound < 0) {
+        bound += rank;
+      }
+      return std::clamp<int64_t>(bound, 0, rank);
+    };
+    const int64_t start = get_bound("start", 0);
+    const int64_t end = get_bound("end", rank);
+    if (end - start > static_cast<int64_t>(kMaxElements)) {
+      return false;
+    }
+
+    const int64_t input_index = AddInput(*node.InputDefs()[0]);
+    for (int64_t axis = start; axis < end; ++axis) {
+      const auto& dim = shape->dim(static_cast<int>(axis));
+      if (utils::HasDimValue(dim)) {
+        value.elements.push_back({kConst, dim.dim_value()});
+      } else {
+        value.elements.push_back({kDim, input_index, axis});
+      }
+    }
+    return true;
+  }
+
+  bool EvaluateBinary(const Node& node, int64_t op, ShapeValue& value, int depth) {
+    ShapeValue a;
+    ShapeValue b;
+    if (!IsInt64Tensor(*node.OutputDefs()[0]) ||
+        !Evaluate(*node.InputDefs()[0], a, depth + 1) || !Evaluate(*node.InputDefs()[1], b, depth + 1)) {
+      return false;
+    }
+
+    const size_t size = std::max(a.elements.size(), b.elements.size());
+    if ((a.elements.size() != size && a.elements.size() != 1) ||
+        (b.elements.size() != size && b.elements.size() != 1)) {
+      return false;
+    }
+
+    value.is_scalar = a.is_scalar && b.is_scalar;
+    for (size_t i = 0; i < size; ++i) {
+      const Expression& lhs = a.elements[a.elements.size() == 1 ? 0 : i];
+      const Expression& rhs = b.elements[b.elements.size() == 1 ? 0 : i];
+
+      // the operations of constants are folded into constants
+      int64_t x;
+      int64_t y;
+      if (GetConstant(lhs, x) && GetConstant(rhs, y)) {
+        if (op == kDiv && y == 0) {
+          return false;
+        }
+        const int64_t result = op == kAdd ? x + y : op == kSub ? x - y : op == kMul ? x * y : x / y;
+        value.elements.push_back({kConst, result});
+        continue;
+      }
+
+      if (lhs.size() + rhs.size() + 1 > kMaxExpressionSize) {
+        return false;
+      }
+      Expression expression = lhs;
+      expression.insert(expression.end(), rhs.begin(), rhs.end());
+      expression.push_back(op);
+      value.elements.push_back(std::move(expression));
+    }
+    return true;
+  }
+
+  bool EvaluateNode(const Node& node, ShapeValue& value, int depth) {
+    if (!graph_utils::IsSupportedProvider(node, compatible_providers_)) {
+      return false;
+    }
+
+    const auto& inputs = node.InputDefs();
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Shape", {1, 13, 15, 19})) {
+      return EvaluateShape(node, value);
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Identity", {1, 13, 14, 16, 19}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Cast", {6, 9, 13, 19})) {
+      // Casts to int64 keep the values, as the values of the subgraph are int64, or int32 constants
+      return IsInt64Tensor(*node.OutputDefs()[0]) && Evaluate(*inputs[0], value, depth + 1);
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14})) {
+      return EvaluateBinary(node, kAdd, value, depth);
+    }
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14})) {
+      return EvaluateBinary(node, kSub, value, depth);
+    }
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14})) {
+      return EvaluateBinary(node, kMul, value, depth);
+    }
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14})) {
+      return EvaluateBinary(node, kDiv, value, depth);
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", {1, 11, 13})) {
+      const auto* axis = graph_utils::GetNodeAttribute(node, "axis");
+      ShapeValue data;
+      InlinedVector<int64_t, 4> indices;
+      bool is_scalar = false;
+      if ((axis != nullptr && axis->i() != 0 && axis->i() != -1) ||
+          !Evaluate(*inputs[0], data, depth + 1) || data.is_scalar ||
+          !EvaluateConstants(node, 1, indices, depth, &is_scalar) || indices.size() > kMaxElements) {
+        return false;
+      }
+
+      const int64_t size = static_cast<int64_t>(data.elements.size());
+      for (int64_t index : indices) {
+        if (index < -size || index >= size) {
+          return false;
+        }
+        value.elements.push_back(data.elements[static_cast<size_t>(index < 0 ? index + size : index)]);
+      }
+      value.is_scalar = is_scalar;
+      return true;
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Unsqueeze", {1, 11, 13}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Squeeze", {1, 11, 13})) {
+      const bool is_unsqueeze = node.OpType() == "Unsqueeze";
+      InlinedVector<int64_t, 4> axes;
+      if (node.SinceVersion() < 13) {
+        const auto* attr = graph_utils::GetNodeAttribute(node, "axes");
+        if (attr != nullptr) {
+          axes.assign(attr->ints().begin(), attr->ints().end());
+        }
+      } else if (!EvaluateConstants(node, 1, axes, depth)) {
+        return false;
+      }
+
+      // only the scalars and the 1D values of one element are converted into each other
+      ShapeValue data;
+      if ((!IsAxisZero(axes) && (is_unsqueeze || !axes.empty())) ||
+          !Evaluate(*inputs[0], data, depth + 1) || data.is_scalar != is_unsqueeze || data.elements.size() != 1) {
+        return false;
+      }
+      value.elements = std::move(data.elements);
+      value.is_scalar = !is_unsqueeze;
+      return true;
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11, 13})) {
+      const auto* axis = graph_utils::GetNodeAttribute(node, "axis");
+      if (axis == nullptr || (axis->i() != 0 && axis->i() != -1)) {
+        return false;
+      }
+
+      for (const NodeArg* input : inputs) {
+        ShapeValue part;
+        if (!Evaluate(*input, part, depth + 1) || part.is_scalar ||
+            value.elements.size() + part.elements.size() > kMaxElements) {
+          return false;
+        }
+        value.elements.insert(value.elements.end(), part.elements.begin(), part.elements.end());
+      }
+      return true;
+    }
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Slice", {10, 11, 13})) {
+      ShapeValue data;
+      InlinedVector<int64_t, 4> starts;
+      InlinedVector<int64_t, 4> ends;
+      InlinedVector<int64_t, 4> axes;
+      InlinedVector<int64_t, 4> steps;
+      if (!Evaluate(*inputs[0], data, depth + 1) || data.is_scalar ||
+          !EvaluateConstants(node, 1, starts, depth) || !EvaluateConstants(node, 2, ends, depth) ||
+          !EvaluateConstants(node, 3, axes, depth) || !EvaluateConstants(node, 4, steps, depth) ||
+          starts.size() != 1 || ends.size() != 1 || (!axes.empty() && !IsAxisZero(axes)) ||
+          (!steps.empty() && (steps.size() != 1 || steps[0] != 1))) {
+        return false;
+      }
+
+      const int64_t size = static_cast<int64_t>(data.elements.size());
+      auto clamp = [size](int64_t bound) {
+        return std::clamp<int64_t>(bound < 0 ? bound + size : bound, 0, size);
+      };
+      for (int64_t i = clamp(starts[0]), end = clamp(ends[0]); i < end; ++i) {
+        value.elements.push_back(data.elements[static_cast<size_t>(i)]);
+      }
+      return true;
+    }
+
+    return false;
+  }
+
+  Graph& graph_;
+  const InlinedHashSet<std::string_view>& compatible_providers_;
+  InlinedHashMap<const NodeArg*, ShapeValue> values_;
+  std::vector<NodeArg*> inputs_;
+  InlinedVector<NodeIndex> nodes_;
+  std::string shape_provider_;
+};
+
+}  // namespace
+
+Status ShapeExpressionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                        const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if ((!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reshape", {5, 13, 14, 19}) &&
+         !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Expand", {8, 13})) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const NodeArg& shape_arg = *node.InputDefs()[1];
+    const Node* shape_node = graph.GetProducerNode(shape_arg.Name());
+    if (shape_node == nullptr ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(*shape_node, "ShapeExpression", {1}, kMSDomain)) {
+      continue;
+    }
+
+    // the subgraph has to read a dim that isn't known, or constant folding does it, and has more than one node
+    ShapeExpressionBuilder builder(graph, GetCompatibleExecutionProviders());
+    ShapeValue value;
+    if (!builder.Evaluate(shape_arg, value) || value.is_scalar || builder.Inputs().empty() ||
+        builder.Nodes().size() < 2) {
+      continue;
+    }
+
+    std::vector<int64_t> program;
+    for (const Expression& element : value.elements) {
+      program.insert(program.end(), element.begin(), element.end());
+      program.push_back(kEnd);
+    }
+
+    NodeArg& output = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("shape_expression"), shape_arg.TypeAsProto());
+    Node& expression_node = graph.AddNode(graph.GenerateNodeName("ShapeExpression"), "ShapeExpression",
+                                          "computes the shape input of " + node.Name(), builder.Inputs(), {&output},
+                                          nullptr, kMSDomain);
+    expression_node.AddAttribute("program", program);
+    expression_node.SetExecutionProviderType(builder.ExecutionProviderType());
+
+    const auto& inputs = builder.Inputs();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (const Node* producer = graph.GetProducerNode(inputs[i]->Name())) {
+        graph.AddEdge(producer->Index(), expression_node.Index(),
+                      graph_utils::GetNodeOutputIndexFromOutputName(*producer, inputs[i]->Name()), static_cast<int>(i));
+      }
+    }
+
+    graph.RemoveEdge(shape_node->Index(), node.Index(),
+                     graph_utils::GetNodeOutputIndexFromOutputName(*shape_node, shape_arg.Name()), 1);
+    graph_utils::ReplaceNodeInput(node, 1, output);
+    graph.AddEdge(expression_node.Index(), node.Index(), 0, 1);
+
+    // removes the nodes of the subgraph that computed nothing else, with their consumers first
+    const auto& subgraph_nodes = builder.Nodes();
+    for (auto it = subgraph_nodes.rbegin(); it != subgraph_nodes.rend(); ++it) {
+      const Node* subgraph_node = graph.GetNode(*it);
+      if (subgraph_node != nullptr && subgraph_node->GetOutputEdgesCount() == 0 &&
+          !graph.NodeProducesGraphOutput(*subgraph_node)) {
+        graph.RemoveNode(*it);
+      }
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
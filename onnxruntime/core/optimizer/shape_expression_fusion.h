@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ShapeExpressionFusion
+Replace the subgraph that computes the shape input of a Reshape or Expand from the dims of other tensors, like
+Shape -> Gather -> Unsqueeze -> Concat, with one ShapeExpression node that evaluates the same arithmetic on the dims.
+The subgraph may only contain Shape, Gather, Squeeze, Unsqueeze, Concat, Slice, Cast, Identity and integer
+Add, Sub, Mul and Div nodes whose other inputs are constant initializers, so the whole value only depends on shapes.
+*/
+class ShapeExpressionFusion : public GraphTransformer {
+ public:
+  ShapeExpressionFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ShapeExpressionFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
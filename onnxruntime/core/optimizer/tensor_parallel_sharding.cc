@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/tensor_parallel_sharding.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// How an initializer is split over the ranks.
+enum class ShardAxis {
+  // the last axis is split into `groups` blocks, e.g. the Q, K and V weights of Attention, and each block is split
+  Columns,
+  // the first axis of a 2D initializer is split
+  Rows,
+};
+
+struct ShardedInput {
+  Node* node;
+  int input_index;
+  ShardAxis axis;
+  int64_t groups;
+};
+
+// Returns the constant float or float16 initializer of input `input_index` of `node` if it has `dims_size` dimensions
+// and the axis it is split along has `size` elements, or any number of elements when `size` is -1.
+const TensorProto* GetShardableInitializer(const Graph& graph, const Node& node, int input_index, int dims_size,
+                                           ShardAxis axis, int64_t size) {
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() <= static_cast<size_t>(input_index) || !input_defs[input_index]->Exists()) {
+    return nullptr;
+  }
+
+  const TensorProto* proto = graph_utils::GetConstantInitializer(graph, input_defs[input_index]->Name());
+  if (proto == nullptr ||
+      (proto->data_type() != TensorProto_DataType_FLOAT && proto->data_type() != TensorProto_DataType_FLOAT16) ||
+      proto->dims_size() != dims_size ||
+      (size != -1 && proto->dims(axis == ShardAxis::Rows ? 0 : dims_size - 1) != size)) {
+    return nullptr;
+  }
+
+  return proto;
+}
+
+// Adds the initializer holding the part of `proto` of `rank`.
+NodeArg& AddShard(Graph& graph, const TensorProto& proto, ShardAxis axis, int64_t groups, int64_t rank,
+                  int64_t world_size) {
+  Initializer initializer{proto, graph.ModelPath()};
+  const auto bytes = initializer.DataAsByteSpan();
+  const size_t element_size = bytes.size() / initializer.size();
+  const int64_t cols = proto.dims(proto.dims_size() - 1);
+  const int64_t rows = proto.dims_size() == 2 ? proto.dims(0) : 1;
+  const char* src = reinterpret_cast<const char*>(bytes.data());
+
+  TensorProto shard_proto;
+  shard_proto.set_name(graph.GenerateNodeArgName(proto.name() + "_rank_" + std::to_string(rank)));
+  shard_proto.set_data_type(proto.data_type());
+
+  std::string data;
+  if (axis == ShardAxis::Rows) {
+    const int64_t shard_rows = rows / world_size;
+    const size_t shard_bytes = static_cast<size_t>(shard_rows * cols) * element_size;
+    shard_proto.add_dims(shard_rows);
+    shard_proto.add_dims(cols);
+    data.assign(src + rank * shard_bytes, shard_bytes);
+  } else {
+    const int64_t group_cols = cols / groups;
+    const int64_t shard_cols = group_cols / world_size;
+    const size_t shard_bytes = static_cast<size_t>(shard_cols) * element_size;
+    if (proto.dims_size() == 2) {
+      shard_proto.add_dims(rows);
+    }
+    shard_proto.add_dims(shard_cols * groups);
+    data.reserve(static_cast<size_t>(rows * groups) * shard_bytes);
+    for (int64_t r = 0; r < rows; r++) {
+      for (int64_t g = 0; g < groups; g++) {
+        data.append(src + static_cast<size_t>(r * cols + g * group_cols + rank * shard_cols) * element_size,
+                    shard_bytes);
+      }
+    }
+  }
+  shard_proto.set_raw_data(std::move(data));
+
+  return graph_utils::AddInitializer(graph, shard_proto);
+}
+
+// Returns the only node using the output of `node`, if it runs on the same execution provider.
+Node* GetOnlyChild(Graph& graph, const Node& node) {
+  if (node.GetOutputEdgesCount() != 1 || graph.NodeProducesGraphOutput(node)) {
+    return nullptr;
+  }
+
+  Node* child = graph.GetNode(node.OutputNodesBegin()->Index());
+  return child->GetExecutionProviderType() == node.GetExecutionProviderType() ? child : nullptr;
+}
+
+// Element-wise activations between the MatMuls of an MLP. Sets `bias_index` to the index of the bias input of the
+// fused activations, or -1.
+bool IsActivation(const Node& node, int& bias_index) {
+  bias_index = -1;
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "QuickGelu", {1}, kMSDomain)) {
+    return true;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(node, "BiasGelu", {1}, kMSDomain)) {
+    bias_index = 1;
+    return true;
+  }
+
+  return false;
+}
+
+// Matches the nodes of an MLP block after `matmul`, and returns the MatMul node using the sharded hidden state.
+Node* MatchMLP(Graph& graph, Node& matmul, int64_t hidden_size, InlinedVector<ShardedInput>& sharded_inputs,
+               InlinedVector<Node*>& sharded_nodes) {
+  Node* node = GetOnlyChild(graph, matmul);
+  if (node != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*node, "Add", {7, 13, 14})) {
+    const int bias_index = node->InputDefs()[0] == matmul.OutputDefs()[0] ? 1 : 0;
+    if (GetShardableInitializer(graph, *node, bias_index, 1, ShardAxis::Columns, hidden_size) == nullptr) {
+      return nullptr;
+    }
+    sharded_inputs.push_back({node, bias_index, ShardAxis::Columns, 1});
+    sharded_nodes.push_back(node);
+    node = GetOnlyChild(graph, *node);
+  }
+
+  int bias_index;
+  if (node != nullptr && IsActivation(*node, bias_index)) {
+    if (bias_index >= 0 && static_cast<size_t>(bias_index) < node->InputDefs().size() &&
+        node->InputDefs()[bias_index]->Exists()) {
+      if (GetShardableInitializer(graph, *node, bias_index, 1, ShardAxis::Columns, hidden_size) == nullptr) {
+        return nullptr;
+      }
+      sharded_inputs.push_back({node, bias_index, ShardAxis::Columns, 1});
+    }
+    sharded_nodes.push_back(node);
+    node = GetOnlyChild(graph, *node);
+  }
+
+  return node;
+}
+
+}  // namespace
+
+Status TensorParallelSharding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  // initializers used by more than one block are sharded once
+  InlinedHashMap<std::string, NodeArg*> shards;
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // the inputs to shard, and the nodes whose outputs only hold the part of the hidden state of this rank
+    InlinedVector<ShardedInput> sharded_inputs;
+    InlinedVector<Node*> sharded_nodes{&node};
+    int64_t hidden_size = 0;
+    Node* output_matmul = nullptr;
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13})) {
+      const TensorProto* weights = GetShardableInitializer(graph, node, 1, 2, ShardAxis::Columns, -1);
+      if (weights == nullptr || weights->dims(1) % world_size_ != 0) {
+        continue;
+      }
+
+      hidden_size = weights->dims(1);
+      sharded_inputs.push_back({&node, 1, ShardAxis::Columns, 1});
+      output_matmul = MatchMLP(graph, node, hidden_size, sharded_inputs, sharded_nodes);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Attention", {1}, kMSDomain)) {
+      // K and V need the same hidden size as Q, and the past and present state and the relative position bias have
+      // all heads
+      const auto* num_heads_attr = graph_utils::GetNodeAttribute(node, "num_heads");
+      const auto& input_defs = node.InputDefs();
+      if (num_heads_attr == nullptr || num_heads_attr->i() % world_size_ != 0 ||
+          graph_utils::GetNodeAttribute(node, "qkv_hidden_sizes") != nullptr ||
+          (input_defs.size() > 4 && input_defs[4]->Exists()) ||
+          (input_defs.size() > 5 && input_defs[5]->Exists()) ||
+          (node.OutputDefs().size() > 1 && node.OutputDefs()[1]->Exists())) {
+        continue;
+      }
+
+      const TensorProto* weights = GetShardableInitializer(graph, node, 1, 2, ShardAxis::Columns, -1);
+      if (weights == nullptr || weights->dims(1) % 3 != 0) {
+        continue;
+      }
+
+      hidden_size = weights->dims(1) / 3;
+      sharded_inputs.push_back({&node, 1, ShardAxis::Columns, 3});
+      if (input_defs.size() > 2 && input_defs[2]->Exists()) {
+        if (GetShardableInitializer(graph, node, 2, 1, ShardAxis::Columns, 3 * hidden_size) == nullptr) {
+          continue;
+        }
+        sharded_inputs.push_back({&node, 2, ShardAxis::Columns, 3});
+      }
+      output_matmul = GetOnlyChild(graph, node);
+    } else {
+      continue;
+    }
+
+    if (output_matmul == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*output_matmul, "MatMul", {1, 9, 13}) ||
+        output_matmul->InputDefs()[0] != sharded_nodes.back()->OutputDefs()[0] ||
+        GetShardableInitializer(graph, *output_matmul, 1, 2, ShardAxis::Rows, hidden_size) == nullptr) {
+      continue;
+    }
+    sharded_inputs.push_back({output_matmul, 1, ShardAxis::Rows, 1});
+
+    for (const auto& sharded_input : sharded_inputs) {
+      const NodeArg& input = *sharded_input.node->InputDefs()[sharded_input.input_index];
+      const std::string key = input.Name() + (sharded_input.axis == ShardAxis::Rows ? ":rows" : ":columns");
+      auto it = shards.find(key);
+      if (it == shards.end()) {
+        const TensorProto* proto = graph_utils::GetConstantInitializer(graph, input.Name());
+        it = shards.emplace(key, &AddShard(graph, *proto, sharded_input.axis, sharded_input.groups, rank_,
+                                           world_size_))
+                 .first;
+      }
+      graph_utils::ReplaceNodeInput(*sharded_input.node, sharded_input.input_index, *it->second);
+    }
+
+    // the shapes of the sharded hidden state are inferred again when the graph is resolved
+    for (Node* sharded_node : sharded_nodes) {
+      sharded_node->MutableOutputDefs()[0]->ClearShape();
+    }
+    if (node.OpType() == "Attention") {
+      node.AddAttribute("num_heads", graph_utils::GetNodeAttribute(node, "num_heads")->i() / world_size_);
+    }
+
+    // the output MatMul computes the part of the sum of this rank, which AllReduce sums over the ranks
+    NodeArg& partial_sum = graph_utils::CreateNodeArg(graph, *output_matmul->OutputDefs()[0]);
+    Node& matmul = graph.AddNode(graph.GenerateNodeName(output_matmul->Name()), "MatMul",
+                                 "MatMul of the weights of this rank", output_matmul->MutableInputDefs(),
+                                 {&partial_sum});
+    matmul.SetExecutionProviderType(output_matmul->GetExecutionProviderType());
+    Node& all_reduce = graph.AddNode(graph.GenerateNodeName("AllReduce"), "AllReduce",
+                                     "Sum of the partial sums of the ranks", {&partial_sum}, {}, nullptr, kMSDomain);
+    all_reduce.SetExecutionProviderType(output_matmul->GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {*output_matmul}, matmul, all_reduce);
+    graph.AddEdge(matmul.Index(), all_reduce.Index(), 0, 0);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TensorParallelSharding
+Keep the part of the weights of this rank out of world_size ranks in the MLP and Attention blocks of a transformer
+model, like Megatron-LM, so that each rank runs the same model with 1/world_size of the weights of those blocks.
+
+MatMul(X, W1) -> [Add(B1)] -> [activation] -> MatMul(W2): W1, B1 and the bias of the activation are split along
+their columns, and W2 along its rows. Attention(X, W_qkv, B_qkv) -> MatMul(W_o): the Q, K and V parts of W_qkv and
+B_qkv are split along their columns, i.e. by heads, num_heads is divided by world_size, and W_o is split along its
+rows. The output of the last MatMul of a block then is a partial sum, which an AllReduce node sums over the ranks.
+
+Each rank runs the model in its own process on its own device, and the AllReduce nodes talk to the other ranks
+with NCCL, e.g. with the ranks of an MPI job.
+*/
+class TensorParallelSharding : public GraphTransformer {
+ public:
+  TensorParallelSharding(int64_t rank, int64_t world_size,
+                         const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TensorParallelSharding", compatible_execution_providers),
+        rank_(rank),
+        world_size_(world_size) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  const int64_t rank_;
+  const int64_t world_size_;
+};
+
+}  // namespace onnxruntime
@@ -4,7 +4,10 @@
 #include "transformer_memcpy.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/execution_providers.h"
+#include "core/framework/session_options.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
+#include "core/graph/graph_utils.h"
 
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
@@ -23,6 +26,7 @@ class TransformerMemcpyImpl {
   void BuildDefsMapping(const onnxruntime::NodeArg* arg, const KernelRegistryManager& kernel_registries);
   void AddCopyNode(onnxruntime::NodeArg* arg, bool is_input);
   bool ProcessInitializers(const KernelRegistryManager& kernel_registries, const InitializedTensorSet& initializers_consumed);
+  bool OptimizeCopyNodes();
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TransformerMemcpyImpl);
@@ -107,6 +111,11 @@ considered to be non-provider here.)
 Note that every ml-value is computed at a unique point (either provider or non-provider),
 but it may be referenced and used at multiple points (by both provider and non-provider).
 
+(4) Finally, copy nodes of the same value in the same direction are merged into one, and copies of small constant
+initializers to the provider are replaced by a copy of the initializer, which session state copies over to the
+provider device once at initialization. Copy nodes can already be in the graph, e.g. when loading a model that was
+saved after optimization, so this also cleans up copies that would otherwise run on every inference.
+
 This transformer does not currently optimize copies between, e.g., two different GPU devices, etc.
 
 */
@@ -182,6 +191,9 @@ bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_regi
     }
   }
 
+  if (OptimizeCopyNodes())
+    modified = true;
+
   return modified;
 }
 
@@ -313,6 +325,9 @@ void TransformerMemcpyImpl::AddCopyNode(onnxruntime::NodeArg* arg, bool is_input
                                   std::vector<onnxruntime::NodeArg*>{src_arg},
                                   std::vector<onnxruntime::NodeArg*>{dst_arg});
   new_node.SetExecutionProviderType(provider_);
+  // with the priority based execution order, issue the copy as soon as its input is produced so that it can overlap
+  // with the other nodes instead of delaying the consumers.
+  new_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_HIGH));
   std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> map = {{arg, new_arg}};
   auto it = provider_input_nodes_.find(arg);
   if (it != provider_input_nodes_.end()) {
@@ -398,4 +413,83 @@ bool TransformerMemcpyImpl::ProcessInitializers(const KernelRegistryManager& ker
   return !replacements.empty();
 }
 
+// Copies of constant initializers up to this size are replaced by a copy of the initializer on the provider device.
+// Larger ones are left as copy nodes so that the provider device memory is only held while the copy is in use.
+static constexpr size_t kMaxHoistedInitializerBytes = 64 * 1024;
+
+// Merges copy nodes of the same value in the same direction, and replaces the copy nodes of small constant
+// initializers to the provider with initializers.
+bool TransformerMemcpyImpl::OptimizeCopyNodes() {
+  std::unordered_set<std::string> graph_outputs;
+  for (const auto* output : graph_.GetOutputs()) {
+    graph_outputs.insert(output->Name());
+  }
+
+  // subgraphs refer to the outer scope values by name, so the outputs of copy nodes they consume have to stay
+  std::unordered_set<std::string> implicit_inputs;
+  for (const auto& node : graph_.Nodes()) {
+    for (const auto* arg : node.ImplicitInputDefs()) {
+      implicit_inputs.insert(arg->Name());
+    }
+  }
+
+  std::vector<Node*> copy_nodes;
+  for (auto& node : graph_.Nodes()) {
+    if ((node.OpType() == "MemcpyFromHost" || node.OpType() == "MemcpyToHost") &&
+        node.GetExecutionProviderType() == provider_) {
+      copy_nodes.push_back(&node);
+    }
+  }
+
+  bool modified = false;
+  std::map<std::pair<std::string, std::string>, NodeArg*> copied_values;
+  std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> replacements;
+  std::vector<NodeIndex> nodes_to_remove;
+  for (auto* node : copy_nodes) {
+    auto* input = node->MutableInputDefs()[0];
+    auto* output = node->MutableOutputDefs()[0];
+    if (graph_outputs.count(output->Name()) != 0 || implicit_inputs.count(output->Name()) != 0) {
+      continue;
+    }
+
+    if (node->OpType() == "MemcpyFromHost" && graph_utils::IsConstantInitializer(graph_, input->Name(), true)) {
+      const TensorProto* tensor_proto = GetInitializer(graph_, input->Name(), true);
+      size_t size_in_bytes = 0;
+      if (tensor_proto != nullptr &&
+          utils::GetSizeInBytesFromTensorProto<0>(*tensor_proto, &size_in_bytes).IsOK() &&
+          size_in_bytes <= kMaxHoistedInitializerBytes) {
+        TensorProto new_tensor_proto = *tensor_proto;
+        *(new_tensor_proto.mutable_name()) = output->Name();
+        graph_utils::RemoveNodeOutputEdges(graph_, *node);
+        graph_.RemoveNode(node->Index());
+        graph_.AddInitializedTensor(new_tensor_proto);
+        modified = true;
+        continue;
+      }
+    }
+
+    auto inserted = copied_values.insert({{node->OpType(), input->Name()}, output});
+    if (!inserted.second) {
+      replacements.insert({output, inserted.first->second});
+      nodes_to_remove.push_back(node->Index());
+    }
+  }
+
+  if (replacements.empty()) {
+    return modified;
+  }
+
+  for (const auto node_index : nodes_to_remove) {
+    Node& node = *graph_.GetNode(node_index);
+    graph_utils::RemoveNodeOutputEdges(graph_, node);
+    graph_.RemoveNode(node_index);
+  }
+
+  for (auto& node : graph_.Nodes()) {
+    node.ReplaceDefs(replacements);
+  }
+
+  return true;
+}
+
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -652,6 +653,42 @@ static int EstimateValueRank(const api::GraphRef& graph, std::string_view input)
   return rank;
 }
 
+// Given a value, returns its number of elements, or nullopt if the shape is not fully known.
+// When the shapes of all values involved in pushing a Transpose are known, the number of elements moved by the
+// Transposes before and after the push are compared as well, so a Transpose is not pushed into a larger tensor
+// (e.g. the output of an upsampling Resize or of a broadcasting Add) just because the ranks favor it.
+static std::optional<int64_t> EstimateValueSize(const api::GraphRef& graph, std::string_view input) {
+  std::optional<std::vector<int64_t>> shape = graph.GetValueInfo(input)->Shape();
+  if (shape == std::nullopt) {
+    return std::nullopt;
+  }
+  int64_t size = 1;
+  for (int64_t d : *shape) {
+    if (d < 0) {
+      return std::nullopt;
+    }
+    // saturate, the value is only compared
+    size = d != 0 && size > std::numeric_limits<int64_t>::max() / d ? std::numeric_limits<int64_t>::max() : size * d;
+  }
+  return size;
+}
+
+// Elements moved by the Transposes removed and added by pushing a Transpose through a node. nullopt if a size is
+// unknown.
+struct TransposeTraffic {
+  std::optional<int64_t> removed = 0;
+  std::optional<int64_t> added = 0;
+};
+
+static void AddTraffic(std::optional<int64_t>& total, const std::optional<int64_t>& size) {
+  if (total.has_value() && size.has_value()) {
+    *total = *size > std::numeric_limits<int64_t>::max() - *total ? std::numeric_limits<int64_t>::max()
+                                                                   : *total + *size;
+  } else {
+    total = std::nullopt;
+  }
+}
+
 static const HandlerInfo* GetHandler(api::NodeRef& node, const HandlerMap& extended_handlers);
 
 // Returns true if the provided transpose node is only consumed by nodes we can likely push it through.
@@ -673,7 +710,8 @@ static bool CanLikelyRemoveTranspose(const api::GraphRef& graph, api::NodeRef& t
 // Feel free to improve as needed.
 static int EstimateTransposeValueCost(const api::GraphRef& graph, std::string_view input,
                                       const std::vector<int64_t>& perm_inv,
-                                      const HandlerMap& extended_handlers) {
+                                      const HandlerMap& extended_handlers,
+                                      TransposeTraffic& traffic) {
   // Case 1: Transposing constants probably costs nothing.
   std::unique_ptr<api::TensorRef> constant = graph.GetConstant(input);
   if (constant != nullptr) {
@@ -686,6 +724,7 @@ static int EstimateTransposeValueCost(const api::GraphRef& graph, std::string_vi
     std::optional<std::vector<int64_t>> perm2 = GetPermAttrIfValid(*node);
     if (perm2 != std::nullopt) {
       if (*perm2 == perm_inv && CanLikelyRemoveTranspose(graph, *node, extended_handlers)) {
+        AddTraffic(traffic.removed, EstimateValueSize(graph, input));
         return -EstimateValueRank(graph, input);
       } else {
         return 0;
@@ -694,6 +733,7 @@ static int EstimateTransposeValueCost(const api::GraphRef& graph, std::string_vi
   }
 
   // Case 3: We will likely need to add a transpose.
+  AddTraffic(traffic.added, EstimateValueSize(graph, input));
   return EstimateValueRank(graph, input);
 }
 
@@ -701,11 +741,12 @@ static int EstimateTransposeValueCost(const api::GraphRef& graph, std::string_vi
 static int EstimateTransposeInputsCost(const api::GraphRef& graph, const api::NodeRef& node,
                                        const std::vector<int64_t>& perm_inv,
                                        const std::vector<size_t>& input_indices,
-                                       const HandlerMap& extended_handlers) {
+                                       const HandlerMap& extended_handlers,
+                                       TransposeTraffic& traffic) {
   auto inputs = node.Inputs();
   int cost = 0;
   for (size_t j : input_indices) {
-    cost += EstimateTransposeValueCost(graph, inputs[j], perm_inv, extended_handlers);
+    cost += EstimateTransposeValueCost(graph, inputs[j], perm_inv, extended_handlers, traffic);
   }
   return cost;
 }
@@ -1174,7 +1215,8 @@ constexpr HandlerInfo unsqueeze_handler = {&FirstInput, &HandleUnsqueeze};
 
 static bool HandleQuantizeDequantizeScale(const api::GraphRef& graph, const std::vector<int64_t>& perm,
                                           api::NodeRef& node, int64_t opset) {
-  if (opset >= 13) {
+  // the com.microsoft variants always have the axis attribute
+  if (opset >= 13 || node.Domain() == onnxruntime::kMSDomain) {
     size_t rank = perm.size();
     // Update axis in Opset >= 13 if scale/zero_point are non-scalar
     auto inputs = node.Inputs();
@@ -1193,7 +1235,7 @@ static bool HandleQuantizeDequantizeScale(const api::GraphRef& graph, const std:
   return true;
 }
 
-static bool HandleQuantizeDequantizeLinear(HandlerArgs& args) {
+bool HandleQuantizeDequantizeLinear(HandlerArgs& args) {
   if (!HandleQuantizeDequantizeScale(args.ctx.graph, args.perm, args.node, args.ctx.opset)) {
     return false;
   }
@@ -1636,6 +1678,159 @@ static bool HandleReshape(HandlerArgs& args) {
 
 constexpr HandlerInfo reshape_handler = {&FirstInput, &HandleReshape, /*transposes_outputs*/ false};
 
+// Gather with scalar or 1D indices. The gathered axis of the transposed input is mapped back to the input of the
+// Transpose. The output has the same permutation, without the gathered axis if the indices are a scalar.
+static bool HandleGather(HandlerArgs& args) {
+  size_t rank = args.perm.size();
+  int64_t axis = args.node.GetAttributeIntDefault("axis", 0);
+  if (!NormalizeAndValidateAxis(axis, rank)) {
+    return false;
+  }
+
+  std::optional<std::vector<int64_t>> indices_shape = args.ctx.graph.GetValueInfo(args.node.Inputs()[1])->Shape();
+  if (indices_shape == std::nullopt || indices_shape->size() > 1) {
+    return false;
+  }
+
+  int64_t new_axis = args.perm[gsl::narrow_cast<size_t>(axis)];
+  args.node.SetAttributeInt("axis", new_axis);
+  TransposeFirstInput(args.ctx, args.node, args.perm_inv);
+  if (indices_shape->empty()) {
+    TransposeOutputs(args.ctx, args.node, SqueezePerm({new_axis}, args.perm));
+  } else {
+    TransposeOutputs(args.ctx, args.node, args.perm);
+  }
+
+  return true;
+}
+
+constexpr HandlerInfo gather_handler = {&FirstInput, &HandleGather};
+
+// Handles LayerNormalization and SimplifiedLayerNormalization. The normalized dims [axis, rank) must be kept in
+// place by the Transpose, as scale and bias are broadcast to them. The optional Mean and InvStdDev outputs have the
+// rank of the input and are transposed like it.
+bool HandleLayerNormalization(HandlerArgs& args) {
+  size_t rank = args.perm.size();
+  int64_t axis = args.node.GetAttributeIntDefault("axis", -1);
+  if (!NormalizeAndValidateAxis(axis, rank)) {
+    return false;
+  }
+
+  for (size_t i = gsl::narrow_cast<size_t>(axis); i < rank; ++i) {
+    if (args.perm[i] != gsl::narrow_cast<int64_t>(i)) {
+      return false;
+    }
+  }
+
+  TransposeFirstInput(args.ctx, args.node, args.perm_inv);
+  auto outputs = args.node.Outputs();
+  for (size_t j = 0; j < outputs.size(); ++j) {
+    if (outputs[j] != "") {
+      TransposeOutput(args.ctx.graph, args.node, j, args.perm, args.perm_inv);
+    }
+  }
+
+  return true;
+}
+
+constexpr HandlerInfo layer_norm_handler = {&FirstInput, &HandleLayerNormalization};
+
+// Splits an Einsum equation into the terms of the inputs and the rest ("->..." or ""). Spaces are removed.
+static std::vector<std::string> SplitEinsumEquation(const std::string& equation, std::string& output_term) {
+  std::string compact;
+  for (char c : equation) {
+    if (c != ' ') {
+      compact.push_back(c);
+    }
+  }
+
+  size_t arrow = compact.find("->");
+  output_term = arrow == std::string::npos ? "" : compact.substr(arrow);
+  std::string inputs = compact.substr(0, arrow);
+
+  std::vector<std::string> terms;
+  size_t start = 0;
+  while (true) {
+    size_t comma = inputs.find(',', start);
+    terms.push_back(inputs.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+    if (comma == std::string::npos) {
+      break;
+    }
+    start = comma + 1;
+  }
+  return terms;
+}
+
+// Einsum absorbs the Transpose by permuting the subscripts of the inputs it feeds, so no Transpose is added.
+// Ex: perm = [1, 0], "ij,jk->ik" with the Transpose on input 0 becomes "ji,jk->ik" on the input of the Transpose.
+// An implicit output is unchanged as the same subscripts are used.
+static bool HandleEinsum(HandlerArgs& args) {
+  std::optional<std::string> equation = args.node.GetAttributeString("equation");
+  if (equation == std::nullopt) {
+    return false;
+  }
+
+  std::string output_term;
+  std::vector<std::string> terms = SplitEinsumEquation(*equation, output_term);
+  auto inputs = args.node.Inputs();
+  std::string_view transpose_output = args.transpose.Outputs()[0];
+  if (terms.size() != inputs.size()) {
+    return false;
+  }
+
+  // Validate all terms first so the graph is only modified on success. Ellipsis terms have no fixed rank.
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i] == transpose_output &&
+        (terms[i].size() != args.perm.size() || terms[i].find('.') != std::string::npos)) {
+      return false;
+    }
+  }
+
+  std::string new_equation;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i] == transpose_output) {
+      // dim j of the transposed value is dim perm[j] of the input of the Transpose
+      std::string term(terms[i].size(), ' ');
+      for (size_t j = 0; j < args.perm.size(); ++j) {
+        term[gsl::narrow_cast<size_t>(args.perm[j])] = terms[i][j];
+      }
+      terms[i] = term;
+    }
+    new_equation += (i > 0 ? "," : "") + terms[i];
+  }
+  new_equation += output_term;
+
+  args.node.SetAttributeString("equation", new_equation);
+  std::string_view pre_transpose_value = args.transpose.Inputs()[0];
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i] == transpose_output) {
+      args.node.SetInput(i, pre_transpose_value);
+    }
+  }
+
+  if (!args.ctx.graph.HasValueConsumers(transpose_output)) {
+    args.ctx.graph.RemoveNode(args.transpose);
+  }
+
+  return true;
+}
+
+// The inputs of an Einsum that are produced by a Transpose. Other inputs are never transposed, so they don't count
+// towards the cost.
+static std::vector<size_t> TransposedInputs(OptimizerCtx& ctx, api::NodeRef& node) {
+  auto inputs = node.Inputs();
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    std::unique_ptr<api::NodeRef> producer = ctx.graph.GetNodeProducingOutput(inputs[i]);
+    if (producer != nullptr && producer->IsOp("Transpose")) {
+      indices.push_back(i);
+    }
+  }
+  return indices;
+}
+
+constexpr HandlerInfo einsum_handler = {&TransposedInputs, &HandleEinsum, /*transposes_outputs*/ false};
+
 // TODO: check binary size of this and replace it with constexpr if large
 static const std::unordered_map<std::string_view, const HandlerInfo&> handler_map{
     {"Cast", simple_node_handler},
@@ -1738,6 +1933,10 @@ static const std::unordered_map<std::string_view, const HandlerInfo&> handler_ma
     {"QuantizeLinear", quantize_dequantize_linear_handler},
     {"DequantizeLinear", quantize_dequantize_linear_handler},
     {"Reshape", reshape_handler},
+
+    {"Gather", gather_handler},
+    {"LayerNormalization", layer_norm_handler},
+    {"Einsum", einsum_handler},
 };
 
 static const HandlerInfo* GetHandler(api::NodeRef& node, const HandlerMap& extended_handlers) {
@@ -1772,12 +1971,13 @@ static int CalculateCost(const api::GraphRef& graph, const api::NodeRef& node,
                          const std::unordered_set<std::string>& outputs_leading_to_transpose,
                          const HandlerInfo& info,
                          const std::vector<size_t>& input_indices,
-                         const HandlerMap& extended_handlers) {
+                         const HandlerMap& extended_handlers,
+                         TransposeTraffic& traffic) {
   // We require the input cost (number of transposes before the op) and the total cost to strictly decrease.
   // Strict decrease of the input cost ensures the optimization is stable, since the total cost decrease is just an
   // estimate (the transpose after the op may or may not cancel with a subsequent transpose). We don't want
   // repeated runs of the optimizer to have a transpose toggle between two inputs of a binary op.
-  int cost = EstimateTransposeInputsCost(graph, node, perm, input_indices, extended_handlers);
+  int cost = EstimateTransposeInputsCost(graph, node, perm, input_indices, extended_handlers, traffic);
 
   if (cost < 0 && info.transposes_outputs) {
     // If the output will be transposed and won't ultimately cancel, factor in that cost.
@@ -1790,6 +1990,10 @@ static int CalculateCost(const api::GraphRef& graph, const api::NodeRef& node,
       out_cost = std::max(out_cost, EstimateValueRank(graph, out));
       if (outputs_leading_to_transpose.find(std::string(out)) != outputs_leading_to_transpose.end()) {
         has_output_leading_to_transpose = true;
+        // the Transpose after the node is expected to cancel
+        AddTraffic(traffic.removed, EstimateValueSize(graph, out));
+      } else {
+        AddTraffic(traffic.added, EstimateValueSize(graph, out));
       }
     }
 
@@ -1812,9 +2016,16 @@ static bool ShouldPushTranspose(const api::GraphRef& graph, const api::NodeRef&
     return true;
   }
 
+  TransposeTraffic traffic;
   int cost = CalculateCost(graph, node, perm, outputs_leading_to_transpose, info, transposable_input_indices,
-                           extended_handlers);
-  return cost < 0;
+                           extended_handlers, traffic);
+  if (cost >= 0) {
+    return false;
+  }
+
+  // Fewer transposed dimensions, but don't move more elements than before if the sizes are known. Equal traffic is
+  // allowed as fewer Transpose nodes are still better, e.g. for two inputs of a Concat.
+  return !traffic.removed.has_value() || !traffic.added.has_value() || *traffic.added <= *traffic.removed;
 }
 
 // Finds a handler for the node and estimates the cost of pushing a transpose. Does so if deemed beneficial.
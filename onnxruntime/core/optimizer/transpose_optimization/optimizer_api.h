@@ -184,6 +184,13 @@ class NodeRef {
   /// <param name="value">New value of attribute</param>
   virtual void SetAttributeInts(std::string_view name, const std::vector<int64_t>& value) = 0;
 
+  /// <summary>
+  /// Sets a string attribute with name and value. Overwrites existing value if present.
+  /// </summary>
+  /// <param name="name">Name of the attribute to set</param>
+  /// <param name="value">New value of attribute</param>
+  virtual void SetAttributeString(std::string_view name, std::string_view value) = 0;
+
   /// <summary>
   /// Copies all attributes from a node to this node
   /// </summary>
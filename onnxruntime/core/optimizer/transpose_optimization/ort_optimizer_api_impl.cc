@@ -91,6 +91,7 @@ class ApiNode final : public api::NodeRef {
   std::optional<std::vector<int64_t>> GetAttributeInts(std::string_view name) const override;
   void SetAttributeInt(std::string_view name, int64_t value) override;
   void SetAttributeInts(std::string_view name, const std::vector<int64_t>& value) override;
+  void SetAttributeString(std::string_view name, std::string_view value) override;
   void CopyAttributes(const api::NodeRef& node) override;
   void ClearAttribute(std::string_view name) override;
   void SetInput(size_t i, std::string_view name) override;
@@ -349,6 +350,10 @@ void ApiNode::SetAttributeInts(std::string_view name, const std::vector<int64_t>
   node_.AddAttribute(std::string(name), value);
 }
 
+void ApiNode::SetAttributeString(std::string_view name, std::string_view value) {
+  node_.AddAttribute(std::string(name), std::string(value));
+}
+
 void ApiNode::CopyAttributes(const api::NodeRef& node) {
   const ApiNode& ort_node = static_cast<const ApiNode&>(node);
   const NodeAttributes& attributes = ort_node.node_.GetAttributes();
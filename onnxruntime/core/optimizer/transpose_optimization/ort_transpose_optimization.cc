@@ -39,6 +39,14 @@ std::vector<size_t> QLinearBinaryOpInputs(OptimizerCtx&, api::NodeRef&) {
 
 constexpr HandlerInfo q_linear_binary_op_handler = {&QLinearBinaryOpInputs, &HandleQLinearBinaryOp};
 
+std::vector<size_t> QLinearWhereInputs(OptimizerCtx&, api::NodeRef&) {
+  // Inputs are: [condition, X, x_scale, x_zero_point, Y, y_scale, y_zero_point, z_scale, z_zero_point],
+  // we want [condition, X, Y].
+  return {0, 1, 4};
+}
+
+constexpr HandlerInfo q_linear_where_handler = {&QLinearWhereInputs, &HandleSimpleNodeBroadcast};
+
 static bool HandleQLinearPoolOp(HandlerArgs& args) {
   // Swap between channel first/last variants. Only works for applicable values of perm.
   int64_t channels_last = args.node.GetAttributeIntDefault("channels_last", 0);
@@ -88,20 +96,28 @@ static bool HandleMaxPool(HandlerArgs& args) {
 constexpr HandlerInfo max_pool_op_handler = {&FirstInput, &HandleMaxPool};
 constexpr HandlerInfo node_1_inp_handler = {&FirstInput, &HandleSimpleNode};
 constexpr HandlerInfo reduce_op_handler = {&FirstInput, &HandleReduceOps};
+constexpr HandlerInfo layer_norm_handler = {&FirstInput, &HandleLayerNormalization};
+constexpr HandlerInfo quantize_dequantize_linear_handler = {&FirstInput, &HandleQuantizeDequantizeLinear};
 
 // ORT contrib ops and special cased ONNX ops where we have EP specific handling
 const HandlerMap& OrtExtendedHandlers() {
   static const HandlerMap extended_handler_map = []() {
     HandlerMap map = {
         {"MaxPool", max_pool_op_handler},
+        // ORT schema in the ONNX domain
+        {"SimplifiedLayerNormalization", layer_norm_handler},
+        {"com.microsoft.DequantizeLinear", quantize_dequantize_linear_handler},
         {"com.microsoft.QLinearAdd", q_linear_binary_op_handler},
         {"com.microsoft.QLinearAveragePool", q_linear_pool_op_handler},
         {"com.microsoft.QLinearConcat", q_linear_concat_handler},
+        {"com.microsoft.QLinearGelu", node_1_inp_handler},
         {"com.microsoft.QLinearGlobalAveragePool", q_linear_pool_op_handler},
         {"com.microsoft.QLinearLeakyRelu", node_1_inp_handler},
         {"com.microsoft.QLinearMul", q_linear_binary_op_handler},
         {"com.microsoft.QLinearReduceMean", reduce_op_handler},
         {"com.microsoft.QLinearSigmoid", node_1_inp_handler},
+        {"com.microsoft.QLinearWhere", q_linear_where_handler},
+        {"com.microsoft.QuantizeLinear", quantize_dequantize_linear_handler},
     };
 
     return map;
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/zipmap_columnar.h"
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+Status ZipMapColumnar::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                 const logging::Logger& /*logger*/) const {
+  // only the outputs of the main graph reach the caller, so there is nothing to do in subgraphs
+  if (graph.IsSubgraph()) {
+    return Status::OK();
+  }
+
+  InlinedVector<const NodeArg*> graph_outputs(graph.GetOutputs().begin(), graph.GetOutputs().end());
+  const size_t original_output_count = graph_outputs.size();
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (!p_node) continue;
+
+    Node& node = *p_node;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "ZipMap", {1}, kMLDomain) ||
+        node.GetOutputEdgesCount() != 0 || !graph.NodeProducesGraphOutput(node)) {
+      continue;
+    }
+
+    const auto* strings_attr = graph_utils::GetNodeAttribute(node, "classlabels_strings");
+    const auto* int64s_attr = graph_utils::GetNodeAttribute(node, "classlabels_int64s");
+    const bool using_strings = strings_attr != nullptr && strings_attr->strings_size() > 0;
+    const bool using_int64s = int64s_attr != nullptr && int64s_attr->ints_size() > 0;
+    if (using_strings == using_int64s) {
+      continue;
+    }
+
+    NodeArg& output_arg = *node.MutableOutputDefs()[0];
+
+    TensorProto labels_proto;
+    labels_proto.set_name(graph.GenerateNodeArgName(output_arg.Name() + "_labels"));
+    if (using_strings) {
+      labels_proto.set_data_type(TensorProto_DataType_STRING);
+      labels_proto.add_dims(strings_attr->strings_size());
+      *labels_proto.mutable_string_data() = strings_attr->strings();
+    } else {
+      labels_proto.set_data_type(TensorProto_DataType_INT64);
+      labels_proto.add_dims(int64s_attr->ints_size());
+      *labels_proto.mutable_int64_data() = int64s_attr->ints();
+    }
+    graph_outputs.push_back(&graph_utils::AddInitializer(graph, labels_proto));
+
+    Node& identity_node = graph.AddNode(graph.GenerateNodeName("ZipMapColumnar"), "Identity",
+                                        "Columnar output of a ZipMap", {node.MutableInputDefs()[0]}, {});
+    graph_utils::FinalizeNodeFusion(graph, {node}, identity_node);
+
+    // the output keeps its name and becomes the float tensor passed through
+    TypeProto output_type;
+    output_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    graph.SetNodeArgType(output_arg, output_type);
+    modified = true;
+  }
+
+  if (graph_outputs.size() != original_output_count) {
+    graph.SetOutputs(graph_outputs);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ZipMapColumnar
+Replace ZipMap nodes producing a graph output with an Identity node, so the output is the float tensor of
+probabilities instead of a sequence with one map per row, and add the class labels of the ZipMap as a constant graph
+output named after the output with a "_labels" suffix.
+Callers read the probability of row r and class c at [r, c] and its label at [c].
+*/
+class ZipMapColumnar : public GraphTransformer {
+ public:
+  ZipMapColumnar() noexcept : GraphTransformer("ZipMapColumnar") {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
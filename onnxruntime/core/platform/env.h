@@ -19,6 +19,7 @@ limitations under the License.
 #include <iosfwd>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -87,10 +88,21 @@ struct ThreadOptions {
   // Set or unset denormal as zero.
   bool set_denormal_as_zero = false;
 
+  // If true, idle threads spin only when the work they wait for is expected to arrive sooner than it takes to wake
+  // them up, and block otherwise. See AdaptiveSpinPolicy.
+  bool adaptive_spinning = false;
+
+  // If true, the cost estimates of ThreadPool::TryParallelFor are replaced by the costs measured at run time.
+  // See ParallelForCalibration.
+  bool calibrate_parallel_for_costs = false;
+
   OrtCustomCreateThreadFn custom_create_thread_fn = nullptr;
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // If set, the work of ThreadPool runs on this scheduler of the application and the pool creates no threads.
+  std::optional<OrtCustomScheduler> custom_scheduler;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -141,6 +153,24 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// \brief Returns the NUMA node that most of the given logical processors belong to,
+  /// or -1 if it can't be determined.
+  virtual int GetNumaNodeOfProcessors(const LogicalProcessors& /*processors*/) const {
+    return -1;
+  }
+
+  /// \brief Returns the CPU package (socket) that most of the given logical processors belong to,
+  /// or -1 if it can't be determined.
+  virtual int GetCpuPackageOfProcessors(const LogicalProcessors& /*processors*/) const {
+    return -1;
+  }
+
+  /// \brief Returns the logical processors of the efficiency cores (E-cores) of a hybrid CPU,
+  /// or an empty vector if the CPU is not hybrid or the core types can't be determined.
+  virtual LogicalProcessors GetEfficiencyCoreProcessors() const {
+    return {};
+  }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -186,6 +216,21 @@ class Env {
   virtual common::Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                            MappedMemoryPtr& mapped_memory) const = 0;
 
+  /** How memory mapped by MapFileIntoMemory will be accessed. */
+  enum class MappedMemoryAdvice {
+    kWillNeed,  ///< it is read soon, so the OS can read it from the file in the background
+    kCold,      ///< it is not read for a while, so the OS can reclaim it before other memory
+  };
+
+  /**
+   * Gives the OS a hint about the access to memory mapped by MapFileIntoMemory.
+   * This is only a hint, so the default implementation ignores it.
+   * @param address The start of the memory.
+   * @param length The length in bytes of the memory.
+   * @param advice How the memory will be accessed.
+   */
+  virtual void AdviseMappedMemory(const void* /*address*/, size_t /*length*/, MappedMemoryAdvice /*advice*/) const {}
+
 #ifdef _WIN32
   /// \brief Returns true if the directory exists.
   virtual bool FolderExists(const std::wstring& path) const = 0;
@@ -17,6 +17,7 @@ limitations under the License.
 #include "core/platform/env.h"
 
 #include <assert.h>
+#include <dirent.h>
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <ftw.h>
@@ -29,7 +30,9 @@ limitations under the License.
 #include <sys/syscall.h>
 #include <unistd.h>
 
+#include <fstream>
 #include <iostream>
+#include <map>
 #include <optional>
 #include <thread>
 #include <utility>  // for std::forward
@@ -47,6 +50,8 @@ limitations under the License.
 #include "core/common/gsl.h"
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
 #include "core/platform/scoped_resource.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 
@@ -328,6 +333,89 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  int GetNumaNodeOfProcessors(const LogicalProcessors& processors) const override {
+#if defined(__linux__)
+    std::map<int, size_t> num_processors_per_node;
+    for (int processor : processors) {
+      const int node = GetNumaNodeOfProcessor(processor);
+      if (node >= 0) {
+        ++num_processors_per_node[node];
+      }
+    }
+
+    int best_node = -1;
+    size_t best_count = 0;
+    for (const auto& entry : num_processors_per_node) {
+      if (entry.second > best_count) {
+        best_node = entry.first;
+        best_count = entry.second;
+      }
+    }
+
+    return best_node;
+#else
+    ORT_UNUSED_PARAMETER(processors);
+    return -1;
+#endif
+  }
+
+  int GetCpuPackageOfProcessors(const LogicalProcessors& processors) const override {
+#if defined(__linux__)
+    std::map<int, size_t> num_processors_per_package;
+    for (int processor : processors) {
+      std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(processor) + "/topology/physical_package_id");
+      std::string package_id;
+      int package = -1;
+      if (file && std::getline(file, package_id) && TryParseStringWithClassicLocale(package_id, package) &&
+          package >= 0) {
+        ++num_processors_per_package[package];
+      }
+    }
+
+    int best_package = -1;
+    size_t best_count = 0;
+    for (const auto& entry : num_processors_per_package) {
+      if (entry.second > best_count) {
+        best_package = entry.first;
+        best_count = entry.second;
+      }
+    }
+
+    return best_package;
+#else
+    ORT_UNUSED_PARAMETER(processors);
+    return -1;
+#endif
+  }
+
+  LogicalProcessors GetEfficiencyCoreProcessors() const override {
+    LogicalProcessors processors;
+#if defined(__linux__)
+    // hybrid Intel CPUs expose a perf PMU per core type, listing the processors of that type, e.g. "16-23"
+    std::ifstream file("/sys/devices/cpu_atom/cpus");
+    std::string cpu_list;
+    if (!file || !std::getline(file, cpu_list)) {
+      return processors;
+    }
+
+    for (const auto& range : utils::SplitString(cpu_list, ",")) {
+      const auto bounds = utils::SplitString(range, "-");
+      int first = -1;
+      int last = -1;
+      if (bounds.empty() || bounds.size() > 2 ||
+          !TryParseStringWithClassicLocale(bounds.front(), first) ||
+          !TryParseStringWithClassicLocale(bounds.back(), last) || first < 0 || last < first) {
+        return {};
+      }
+
+      for (int processor = first; processor <= last; ++processor) {
+        processors.push_back(processor);
+      }
+    }
+#endif
+    return processors;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -460,6 +548,28 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  void AdviseMappedMemory(const void* address, size_t length, MappedMemoryAdvice advice) const override {
+    if (address == nullptr || length == 0) {
+      return;
+    }
+
+    int madvise_advice = MADV_WILLNEED;
+    if (advice == MappedMemoryAdvice::kCold) {
+#if defined(MADV_COLD)
+      madvise_advice = MADV_COLD;
+#else
+      return;
+#endif
+    }
+
+    // madvise() needs a page aligned address. The page of the address belongs to the same mapping.
+    static const size_t page_size = narrow<size_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(address) / page_size * page_size;
+    const size_t advised_length = length + static_cast<size_t>(reinterpret_cast<uintptr_t>(address) - begin);
+    // failures only lose the hint
+    ORT_IGNORE_RETURN_VALUE(madvise(reinterpret_cast<void*>(begin), advised_length, madvise_advice));
+  }
+
   static common::Status ReportSystemError(const char* operation_name, const std::string& path) {
     auto [err_no, err_msg] = GetSystemError();
     std::ostringstream oss;
@@ -596,6 +706,30 @@ class PosixEnv : public Env {
   }
 
  private:
+#if defined(__linux__)
+  static int GetNumaNodeOfProcessor(int processor) {
+    const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(processor);
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) {
+      return -1;
+    }
+
+    int node = -1;
+    while (const dirent* entry = readdir(dir)) {
+      const std::string_view name = entry->d_name;
+      int value = -1;
+      if (name.size() > 4 && name.substr(0, 4) == "node" &&
+          TryParseStringWithClassicLocale(name.substr(4), value)) {
+        node = value;
+        break;
+      }
+    }
+
+    closedir(dir);
+    return node;
+  }
+#endif
+
   Telemetry telemetry_provider_;
 #ifdef ORT_USE_CPUINFO
   PosixEnv() {
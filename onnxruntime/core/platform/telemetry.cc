@@ -69,6 +69,11 @@ void Telemetry::LogRuntimePerf(uint32_t session_id, uint32_t total_runs_since_la
   ORT_UNUSED_PARAMETER(total_run_duration_since_last);
 }
 
+void Telemetry::LogSessionMetrics(uint32_t session_id, const std::string& metrics_json) const {
+  ORT_UNUSED_PARAMETER(session_id);
+  ORT_UNUSED_PARAMETER(metrics_json);
+}
+
 void Telemetry::LogExecutionProviderEvent(LUID* adapterLuid) const {
   ORT_UNUSED_PARAMETER(adapterLuid);
 }
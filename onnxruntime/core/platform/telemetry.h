@@ -59,6 +59,10 @@ class Telemetry {
 
   virtual void LogRuntimePerf(uint32_t session_id, uint32_t total_runs_since_last, int64_t total_run_duration_since_last) const;
 
+  // Exports a snapshot of the metrics of a session, see InferenceSession::GetMetrics. Called along with
+  // LogRuntimePerf, so a telemetry provider can forward the metrics to a monitoring system.
+  virtual void LogSessionMetrics(uint32_t session_id, const std::string& metrics_json) const;
+
   virtual void LogExecutionProviderEvent(LUID* adapterLuid) const;
 
  private:
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "core/platform/windows/env.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <optional>
@@ -260,6 +261,10 @@ std::vector<LogicalProcessors> WindowsEnv::GetDefaultThreadAffinities() const {
   return cores_.empty() ? std::vector<LogicalProcessors>(DefaultNumCores(), LogicalProcessors{}) : cores_;
 }
 
+LogicalProcessors WindowsEnv::GetEfficiencyCoreProcessors() const {
+  return efficiency_core_processors_;
+}
+
 WindowsEnv& WindowsEnv::Instance() {
   static WindowsEnv default_env;
   return default_env;
@@ -857,6 +862,7 @@ void WindowsEnv::InitializeCpuInfo() {
 
   int core_id = 0;
   int global_processor_id = 0;
+  std::vector<BYTE> core_efficiency_classes;
   const BYTE* iter = reinterpret_cast<const BYTE*>(processorInfos);
   const BYTE* end = iter + returnLength;
   std::stringstream log_stream;
@@ -890,10 +896,21 @@ void WindowsEnv::InitializeCpuInfo() {
         }
       }
       cores_.push_back(std::move(core_global_proc_ids));
+      core_efficiency_classes.push_back(processor_info->Processor.EfficiencyClass);
       core_id++;
     }
     iter += size;
   }
+
+  // on hybrid CPUs the performance cores have the highest efficiency class
+  if (!core_efficiency_classes.empty()) {
+    const BYTE performance_class = *std::max_element(core_efficiency_classes.begin(), core_efficiency_classes.end());
+    for (size_t i = 0; i < cores_.size(); ++i) {
+      if (core_efficiency_classes[i] < performance_class) {
+        efficiency_core_processors_.insert(efficiency_core_processors_.end(), cores_[i].begin(), cores_[i].end());
+      }
+    }
+  }
   if (logging::LoggingManager::HasDefaultLogger()) {
     LOGS_DEFAULT(VERBOSE) << "Found total " << cores_.size() << " core(s) from windows system:";
     LOGS_DEFAULT(VERBOSE) << log_stream.str();
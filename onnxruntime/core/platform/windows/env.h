@@ -55,6 +55,7 @@ class WindowsEnv : public Env {
   static int DefaultNumCores();
   int GetNumPhysicalCpuCores() const override;
   std::vector<LogicalProcessors> GetDefaultThreadAffinities() const override;
+  LogicalProcessors GetEfficiencyCoreProcessors() const override;
   static WindowsEnv& Instance();
   PIDType GetSelfPid() const override;
   Status GetFileLength(_In_z_ const ORTCHAR_T* file_path, size_t& length) const override;
@@ -113,6 +114,12 @@ class WindowsEnv : public Env {
    * }
    */
   std::vector<LogicalProcessors> cores_;
+  /*
+   * "efficiency_core_processors_" holds the global processor ids of the cores
+   * with a lower efficiency class than the most performant cores of a hybrid CPU.
+   * It is empty if all cores have the same efficiency class.
+   */
+  LogicalProcessors efficiency_core_processors_;
   /*
    * "global_processor_info_map_" is a map of:
    * global_processor_id <--> (group_id, local_processor_id)
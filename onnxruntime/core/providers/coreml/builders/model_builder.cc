@@ -2,12 +2,14 @@
 // Licensed under the MIT License.
 
 #include <fstream>
+#include <iomanip>
 #include <core/common/safeint.h>
 
 #include "model_builder.h"
 #include "helper.h"
 #include "op_builder_factory.h"
 
+#include "core/framework/murmurhash3.h"
 #include "core/providers/common.h"
 #include "core/providers/coreml/builders/impl/builder_utils.h"
 #include "core/providers/coreml/model/host_utils.h"
@@ -239,9 +241,12 @@ Status ModelBuilder::RegisterModelOutputs() {
   return Status::OK();
 }
 
-Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path) {
+Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path,
+                             const std::string& compiled_model_cache_dir) {
   ORT_RETURN_IF_ERROR(SaveCoreMLModel(path));
-  model.reset(new Model(path, logger_, coreml_flags_));
+  const std::string compiled_model_cache_path =
+      compiled_model_cache_dir.empty() ? std::string{} : GetCompiledModelCachePath(compiled_model_cache_dir);
+  model.reset(new Model(path, compiled_model_cache_path, logger_, coreml_flags_));
   model->SetScalarOutputs(std::move(scalar_outputs_));
   model->SetInt64Outputs(std::move(int64_outputs_));
   model->SetInputOutputInfo(std::move(input_output_info_));
@@ -262,6 +267,26 @@ Status ModelBuilder::SaveCoreMLModel(const std::string& path) {
   return Status::OK();
 }
 
+std::string ModelBuilder::GetCompiledModelCachePath(const std::string& compiled_model_cache_dir) const {
+  // The converted model contains the partition and its initializers, and the OS version is included since a model
+  // compiled by another version of CoreML may not load or may run differently
+  uint32_t hash[4] = {0, 0, 0, 0};
+  const auto hash_str = [&hash](const std::string& str) {
+    MurmurHash3::x86_128(str.data(), static_cast<int>(str.size()), hash[0], &hash);
+  };
+  hash_str(coreml_model_->SerializeAsString());
+  hash_str(std::to_string(coreml_flags_));
+  hash_str(util::GetOSVersionString());
+
+  std::ostringstream os;
+  os << compiled_model_cache_dir << "/";
+  for (const auto h : hash) {
+    os << std::hex << std::setw(8) << std::setfill('0') << h;
+  }
+  os << ".mlmodelc";
+  return os.str();
+}
+
 void ModelBuilder::AddScalarOutput(const std::string& output_name) {
   scalar_outputs_.insert(output_name);
 }
@@ -18,7 +18,10 @@ class ModelBuilder {
   ModelBuilder(const GraphViewer& graph_viewer, const logging::Logger& logger, uint32_t coreml_flags);
   ~ModelBuilder() = default;
 
-  Status Compile(std::unique_ptr<Model>& model, const std::string& path);
+  // If `compiled_model_cache_dir` is not empty, the compiled model is cached in it, keyed by the content of the
+  // converted model, the CoreML flags and the OS version
+  Status Compile(std::unique_ptr<Model>& model, const std::string& path,
+                 const std::string& compiled_model_cache_dir = {});
   Status SaveCoreMLModel(const std::string& path);
 
   // Accessors for members
@@ -72,6 +75,9 @@ class ModelBuilder {
   // Record the onnx int64 type output names
   void AddInt64Output(const std::string& output_name);
 
+  // Get the path of the compiled model in `compiled_model_cache_dir`, the model must have been initialized
+  std::string GetCompiledModelCachePath(const std::string& compiled_model_cache_dir) const;
+
   static const IOpBuilder* GetOpBuilder(const Node& node);
 };
 
@@ -23,9 +23,10 @@ namespace onnxruntime {
 
 constexpr const char* COREML = "CoreML";
 
-CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags)
+CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags, const std::string& model_cache_dir)
     : IExecutionProvider{onnxruntime::kCoreMLExecutionProvider, true},
-      coreml_flags_(coreml_flags) {
+      coreml_flags_(coreml_flags),
+      model_cache_dir_(model_cache_dir) {
 }
 
 CoreMLExecutionProvider::~CoreMLExecutionProvider() {}
@@ -96,7 +97,7 @@ common::Status CoreMLExecutionProvider::Compile(const std::vector<FusedNodeAndGr
     coreml::ModelBuilder builder(graph_viewer, *GetLogger(), coreml_flags_);
     std::unique_ptr<coreml::Model> coreml_model;
     const std::string coreml_model_file_path = coreml::util::GetTemporaryFilePath();
-    ORT_RETURN_IF_ERROR(builder.Compile(coreml_model, coreml_model_file_path));
+    ORT_RETURN_IF_ERROR(builder.Compile(coreml_model, coreml_model_file_path, model_cache_dir_));
 
     {
       const auto& input_defs = fused_node.InputDefs();
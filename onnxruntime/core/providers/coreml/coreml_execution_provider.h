@@ -13,7 +13,7 @@ class Model;
 
 class CoreMLExecutionProvider : public IExecutionProvider {
  public:
-  CoreMLExecutionProvider(uint32_t coreml_flags);
+  CoreMLExecutionProvider(uint32_t coreml_flags, const std::string& model_cache_dir = {});
   virtual ~CoreMLExecutionProvider();
 
   std::vector<std::unique_ptr<ComputeCapability>>
@@ -30,6 +30,9 @@ class CoreMLExecutionProvider : public IExecutionProvider {
   const uint32_t coreml_flags_;
 
  private:
+  // Directory to cache the compiled CoreML models in, caching is disabled if empty
+  const std::string model_cache_dir_;
+
 // <fused_node_name, <coreml_model_file_path, compiled_coreml_model>>
 #ifdef __APPLE__
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::coreml::Model>> coreml_models_;
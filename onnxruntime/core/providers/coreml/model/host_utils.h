@@ -24,6 +24,9 @@ bool HasRequiredBaseOS();
 // Get a temporary macOS/iOS temp file path
 std::string GetTemporaryFilePath();
 
+// Get the version of the running macOS/iOS, including the build, e.g. "Version 13.4 (Build 22F66)"
+std::string GetOSVersionString();
+
 }  // namespace util
 }  // namespace coreml
 }  // namespace onnxruntime
@@ -72,7 +72,10 @@ class Model {
 
   OrtMutex mutex_;
 
-  Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  // If `compiled_model_cache_path` is not empty, the compiled model is loaded from there if it exists, and otherwise
+  // moved there after compiling the model at `path`, so that later sessions do not compile the model again
+  Model(const std::string& path, const std::string& compiled_model_cache_path, const logging::Logger& logger,
+        uint32_t coreml_flags);
   Status LoadModel();
 
   void SetInputOutputInfo(std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info) {
@@ -176,18 +176,23 @@ NS_ASSUME_NONNULL_BEGIN
 // Execution for a CoreML model, it performs
 // 1. Compile the model by given path for execution
 // 2. Predict using given OnnxTensorFeatureProvider input and copy the output data back ORT
-// 3. The compiled model will be removed in dealloc or removed using cleanup function
+// 3. The compiled model will be removed in dealloc or removed using cleanup function, unless it was moved to or
+//    loaded from the compiled model cache
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
   NSString* compiled_model_path_;
+  NSString* _Nullable compiled_model_cache_path_;
   const logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags;
+    compiledModelCachePath:(const std::string&)compiled_model_cache_path
+                    logger:(const logging::Logger&)logger
+              coreml_flags:(uint32_t)coreml_flags;
 - (void)cleanup;
+- (nullable MLModel*)loadCachedModel:(MLModelConfiguration*)config API_AVAILABLE_OS_VERSIONS;
+- (void)cacheCompiledModel:(NSURL*)compileUrl;
 - (void)dealloc;
 - (Status)loadModel API_AVAILABLE_OS_VERSIONS;
 - (Status)predict:(const std::unordered_map<std::string, OnnxTensorData>&)inputs
@@ -203,10 +208,14 @@ NS_ASSUME_NONNULL_BEGIN
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags {
+    compiledModelCachePath:(const std::string&)compiled_model_cache_path
+                    logger:(const logging::Logger&)logger
+              coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = [NSString stringWithUTF8String:path.c_str()];
+    compiled_model_cache_path_ = compiled_model_cache_path.empty()
+                                     ? nil
+                                     : [NSString stringWithUTF8String:compiled_model_cache_path.c_str()];
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -239,7 +248,62 @@ NS_ASSUME_NONNULL_BEGIN
   [self cleanup];
 }
 
+- (nullable MLModel*)loadCachedModel:(MLModelConfiguration*)config {
+  NSFileManager* file_manager = [NSFileManager defaultManager];
+  if (compiled_model_cache_path_ == nil || ![file_manager fileExistsAtPath:compiled_model_cache_path_]) {
+    return nil;
+  }
+
+  NSError* error = nil;
+  NSURL* cacheUrl = [NSURL fileURLWithPath:compiled_model_cache_path_ isDirectory:YES];
+  MLModel* model = [MLModel modelWithContentsOfURL:cacheUrl configuration:config error:&error];
+  if (model != nil && error == nil) {
+    LOGS(*logger_, VERBOSE) << "Loaded the cached compiled model: " << [compiled_model_cache_path_ UTF8String];
+    return model;
+  }
+
+  // the cached model is stale or corrupted, remove it so that it is replaced by the model compiled now
+  LOGS(*logger_, WARNING) << "Failed loading the cached compiled model: " << [compiled_model_cache_path_ UTF8String]
+                          << ", the model will be compiled again. Error message: "
+                          << (error != nil ? [[error localizedDescription] UTF8String] : "unknown");
+  [file_manager removeItemAtPath:compiled_model_cache_path_ error:nil];
+  return nil;
+}
+
+- (void)cacheCompiledModel:(NSURL*)compileUrl {
+  if (compiled_model_cache_path_ == nil) {
+    return;
+  }
+
+  NSFileManager* file_manager = [NSFileManager defaultManager];
+  NSError* error = nil;
+  NSString* cache_dir = [compiled_model_cache_path_ stringByDeletingLastPathComponent];
+  [file_manager createDirectoryAtPath:cache_dir withIntermediateDirectories:YES attributes:nil error:&error];
+  // another session may have cached the same model meanwhile, in which case the model compiled here is not kept
+  if (error == nil && ![file_manager fileExistsAtPath:compiled_model_cache_path_]) {
+    [file_manager moveItemAtPath:[compileUrl path] toPath:compiled_model_cache_path_ error:&error];
+  }
+
+  if (error != nil) {
+    LOGS(*logger_, WARNING) << "Failed caching the compiled model: " << [compiled_model_cache_path_ UTF8String]
+                            << ", error message: " << [[error localizedDescription] UTF8String];
+  } else if (![file_manager fileExistsAtPath:[compileUrl path]]) {
+    // moved to the cache, which must outlive this execution
+    compiled_model_path_ = nil;
+  }
+}
+
 - (Status)loadModel {
+  MLModelConfiguration* config = [MLModelConfiguration alloc];
+  config.computeUnits = (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY)
+                            ? MLComputeUnitsCPUOnly
+                            : MLComputeUnitsAll;
+
+  _model = [self loadCachedModel:config];
+  if (_model != nil) {
+    return Status::OK();
+  }
+
   NSError* error = nil;
   NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
   NSAssert(modelUrl != nil, @"modelUrl must not be nil");
@@ -251,11 +315,11 @@ NS_ASSUME_NONNULL_BEGIN
   }
 
   compiled_model_path_ = [compileUrl path];
+  [self cacheCompiledModel:compileUrl];
+  if (compiled_model_path_ == nil) {
+    compileUrl = [NSURL fileURLWithPath:compiled_model_cache_path_ isDirectory:YES];
+  }
 
-  MLModelConfiguration* config = [MLModelConfiguration alloc];
-  config.computeUnits = (coreml_flags_ & COREML_FLAG_USE_CPU_ONLY)
-                            ? MLComputeUnitsCPUOnly
-                            : MLComputeUnitsAll;
   _model = [MLModel modelWithContentsOfURL:compileUrl configuration:config error:&error];
 
   if (error != NULL) {
@@ -382,7 +446,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& compiled_model_cache_path, const logging::Logger& logger,
+            uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -395,9 +460,11 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& compiled_model_cache_path,
+                     const logging::Logger& logger, uint32_t coreml_flags) {
   @autoreleasepool {
     execution_ = [[CoreMLExecution alloc] initWithPath:path
+                                compiledModelCachePath:compiled_model_cache_path
                                                 logger:logger
                                           coreml_flags:coreml_flags];
   }
@@ -436,8 +503,9 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::LoadModel requires macos 10.15+ or ios 13+ ");
 }
 
-Model::Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)) {
+Model::Model(const std::string& path, const std::string& compiled_model_cache_path, const logging::Logger& logger,
+             uint32_t coreml_flags)
+    : execution_(std::make_unique<Execution>(path, compiled_model_cache_path, logger, coreml_flags)) {
 }
 
 Model::~Model() {}
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/execution_provider.h"
+#include "core/framework/huge_page_allocator.h"
 #include "core/graph/constants.h"
 
 namespace onnxruntime {
@@ -11,6 +12,24 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // huge page and NUMA settings of the allocator. Allocations use CPUAllocator if these are the defaults.
+  HugePageCPUAllocator::Options allocator_options;
+  // compute float MatMul and Gemm with a constant B in bfloat16 if the processor supports it
+  bool enable_bf16_gemm{false};
+  // also compute float MatMul with a B that isn't constant and Conv in bfloat16 if the processor supports it
+  bool enable_bf16_mixed_precision{false};
+  // compute float 3x3 Conv nodes with a constant filter using the Winograd algorithm where it applies
+  bool enable_winograd_conv{true};
+  // quantize the input A of DynamicQuantizeMatMul with a scale and zero point per row instead of per tensor
+  bool dynamic_quantize_matmul_per_row{false};
+  // compute the attention core of QAttention with int8 gemms and a lookup table softmax
+  bool qattention_int8_core{false};
+  // compute float MatMul and Gemm with a constant B that has 2:4 structured sparsity on the compressed B
+  bool enable_sparse24_gemm{false};
+  // store the trees of TreeEnsembleRegressor and TreeEnsembleClassifier with 16 bit threshold codes and fp16 leaves
+  bool quantize_tree_ensembles{false};
+  // keep the leaf weights of a tree ensemble in full precision unless fp16 represents them all exactly
+  bool tree_ensemble_exact_quantization{false};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -32,6 +51,8 @@ class CPUExecutionProvider : public IExecutionProvider {
   std::unique_ptr<IDataTransfer> GetDataTransfer() const override;
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
 
+  const CPUExecutionProviderInfo& GetInfo() const { return info_; }
+
  private:
   CPUExecutionProviderInfo info_;
   std::vector<FuseRuleFn> fuse_rules_;
@@ -13,22 +13,30 @@
 namespace onnxruntime {
 
 struct CpuProviderFactory : IExecutionProviderFactory {
-  CpuProviderFactory(bool create_arena) : create_arena_(create_arena) {}
+  CpuProviderFactory(bool create_arena, const HugePageCPUAllocator::Options& allocator_options)
+      : create_arena_(create_arena), allocator_options_(allocator_options) {}
   ~CpuProviderFactory() override = default;
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
 
  private:
   bool create_arena_;
+  HugePageCPUAllocator::Options allocator_options_;
 };
 
 std::unique_ptr<IExecutionProvider> CpuProviderFactory::CreateProvider() {
   CPUExecutionProviderInfo info;
   info.create_arena = create_arena_;
+  info.allocator_options = allocator_options_;
   return std::make_unique<CPUExecutionProvider>(info);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CPUProviderFactoryCreator::Create(int use_arena) {
-  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0);
+  return Create(use_arena, HugePageCPUAllocator::Options{});
+}
+
+std::shared_ptr<IExecutionProviderFactory> CPUProviderFactoryCreator::Create(
+    int use_arena, const HugePageCPUAllocator::Options& allocator_options) {
+  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0, allocator_options);
 }
 
 }  // namespace onnxruntime
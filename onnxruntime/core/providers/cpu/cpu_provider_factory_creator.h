@@ -5,10 +5,13 @@
 
 #include <memory>
 
+#include "core/framework/huge_page_allocator.h"
 #include "core/providers/providers.h"
 
 namespace onnxruntime {
 struct CPUProviderFactoryCreator {
   static std::shared_ptr<IExecutionProviderFactory> Create(int use_arena);
+  static std::shared_ptr<IExecutionProviderFactory> Create(int use_arena,
+                                                           const HugePageCPUAllocator::Options& allocator_options);
 };
 }  // namespace onnxruntime
@@ -0,0 +1,344 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/mlas/inc/mlas.h"
+
+#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/common/safeint.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Number of elements converted to single precision at a time.
+constexpr size_t kFp16NormBlockSize = 1024;
+
+// Number of channels whose statistics are gathered together by a channels last instance normalization task.
+constexpr int64_t kFp16NormChannelBlockSize = 64;
+
+Status ValidateChannelInput(const Tensor* input, int64_t channels, const char* name) {
+  if (input->Shape().NumDimensions() != 1 || input->Shape()[0] != channels) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid input ", name, ": expected shape [", channels,
+                           "], got ", input->Shape());
+  }
+  return Status::OK();
+}
+
+std::vector<float> ConvertToFloat(const Tensor* input) {
+  std::vector<float> output(onnxruntime::narrow<size_t>(input->Shape().Size()));
+  MlasConvertHalfToFloatBuffer(&input->Data<MLFloat16>()[0].val, output.data(), output.size());
+  return output;
+}
+
+// Computes output = input * scale + shift. With channels last, `scale` and `shift` hold one value per element of
+// the row, otherwise a single value applies to the whole row.
+void ScaleShiftRow(const MLFloat16* input, MLFloat16* output, size_t count,
+                   const float* scale, const float* shift, bool per_element) {
+  float buffer[kFp16NormBlockSize];
+  for (size_t offset = 0; offset < count; offset += kFp16NormBlockSize) {
+    const size_t n = std::min(kFp16NormBlockSize, count - offset);
+    MlasConvertHalfToFloatBuffer(&input[offset].val, buffer, n);
+    if (per_element) {
+      for (size_t i = 0; i < n; ++i) {
+        buffer[i] = buffer[i] * scale[offset + i] + shift[offset + i];
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        buffer[i] = buffer[i] * scale[0] + shift[0];
+      }
+    }
+    MlasConvertFloatToHalfBuffer(buffer, &output[offset].val, n);
+  }
+}
+
+// Returns the mean and the mean squared deviation of a contiguous row.
+std::pair<float, float> RowMoments(const MLFloat16* input, size_t count) {
+  float buffer[kFp16NormBlockSize];
+  float sum = 0.0f;
+  for (size_t offset = 0; offset < count; offset += kFp16NormBlockSize) {
+    const size_t n = std::min(kFp16NormBlockSize, count - offset);
+    MlasConvertHalfToFloatBuffer(&input[offset].val, buffer, n);
+    for (size_t i = 0; i < n; ++i) {
+      sum += buffer[i];
+    }
+  }
+  const float mean = sum / count;
+
+  float squared_sum = 0.0f;
+  for (size_t offset = 0; offset < count; offset += kFp16NormBlockSize) {
+    const size_t n = std::min(kFp16NormBlockSize, count - offset);
+    MlasConvertHalfToFloatBuffer(&input[offset].val, buffer, n);
+    for (size_t i = 0; i < n; ++i) {
+      squared_sum += (buffer[i] - mean) * (buffer[i] - mean);
+    }
+  }
+  return {mean, squared_sum / count};
+}
+
+}  // namespace
+
+/**
+ * @brief Batch normalization for type FP16, inference only.
+ * The channel statistics are folded into a scale and shift that are applied
+ * in single precision, in either channels first or channels last layout.
+ */
+class BatchNormFp16 : public OpKernel {
+ public:
+  explicit BatchNormFp16(const OpKernelInfo& info)
+      : OpKernel(info),
+        epsilon_(info.GetAttrOrDefault<float>("epsilon", 1e-5f)),
+        channels_last_(info.GetKernelDef().Domain() == kMSInternalNHWCDomain) {
+    ORT_ENFORCE(info.GetAttrOrDefault<int64_t>("training_mode", 0) == 0 && info.GetOutputCount() == 1,
+                "FP16 BatchNormalization only supports inference mode.");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+  bool channels_last_;
+};
+
+Status BatchNormFp16::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* scale = context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+  const auto* mean = context->Input<Tensor>(3);
+  const auto* var = context->Input<Tensor>(4);
+
+  const TensorShape& x_shape = X->Shape();
+  const size_t rank = x_shape.NumDimensions();
+  ORT_RETURN_IF_NOT(rank >= 2, "Input dimension cannot be less than 2.");
+
+  const int64_t C = channels_last_ ? x_shape[rank - 1] : x_shape[1];
+  ORT_RETURN_IF_ERROR(ValidateChannelInput(scale, C, "scale"));
+  ORT_RETURN_IF_ERROR(ValidateChannelInput(B, C, "B"));
+  ORT_RETURN_IF_ERROR(ValidateChannelInput(mean, C, "mean"));
+  ORT_RETURN_IF_ERROR(ValidateChannelInput(var, C, "var"));
+
+  Tensor* Y = context->Output(0, x_shape);
+  if (x_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  // Fold the statistics into y = x * channel_scale + channel_shift.
+  std::vector<float> channel_scale = ConvertToFloat(scale);
+  std::vector<float> channel_shift = ConvertToFloat(B);
+  const std::vector<float> channel_mean = ConvertToFloat(mean);
+  const std::vector<float> channel_var = ConvertToFloat(var);
+  for (size_t c = 0; c < channel_scale.size(); ++c) {
+    channel_scale[c] /= std::sqrt(channel_var[c] + epsilon_);
+    channel_shift[c] -= channel_mean[c] * channel_scale[c];
+  }
+
+  // Each row is either the image of one channel, or the channels of one pixel.
+  const int64_t row_size = channels_last_ ? C : x_shape.SizeFromDimension(2);
+  const int64_t row_count = x_shape.Size() / row_size;
+  const auto* Xdata = X->Data<MLFloat16>();
+  auto* Ydata = Y->MutableData<MLFloat16>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), onnxruntime::narrow<std::ptrdiff_t>(row_count),
+      TensorOpCost{static_cast<double>(row_size * sizeof(MLFloat16)),
+                   static_cast<double>(row_size * sizeof(MLFloat16)),
+                   static_cast<double>(row_size * 4)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const size_t channel = channels_last_ ? 0 : static_cast<size_t>(row % C);
+          ScaleShiftRow(Xdata + row * row_size, Ydata + row * row_size, static_cast<size_t>(row_size),
+                        channel_scale.data() + channel, channel_shift.data() + channel, channels_last_);
+        }
+      });
+
+  return Status::OK();
+}
+
+/**
+ * @brief Instance normalization for type FP16, in either channels first or
+ * channels last layout. The statistics are accumulated in single precision.
+ */
+class InstanceNormFp16 : public OpKernel {
+ public:
+  explicit InstanceNormFp16(const OpKernelInfo& info)
+      : OpKernel(info),
+        epsilon_(info.GetAttrOrDefault<float>("epsilon", 1e-5f)),
+        channels_last_(info.GetKernelDef().Domain() == kMSInternalNHWCDomain) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+  bool channels_last_;
+};
+
+Status InstanceNormFp16::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* scale = context->Input<Tensor>(1);
+  const auto* B = context->Input<Tensor>(2);
+
+  const TensorShape& x_shape = X->Shape();
+  const size_t rank = x_shape.NumDimensions();
+  ORT_RETURN_IF_NOT(rank >= 3, "Input dimension cannot be less than 3.");
+
+  const int64_t N = x_shape[0];
+  const int64_t C = channels_last_ ? x_shape[rank - 1] : x_shape[1];
+  ORT_RETURN_IF_ERROR(ValidateChannelInput(scale, C, "scale"));
+  ORT_RETURN_IF_ERROR(ValidateChannelInput(B, C, "B"));
+
+  Tensor* Y = context->Output(0, x_shape);
+  if (x_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const int64_t image_size = x_shape.Size() / (N * C);
+  const std::vector<float> scale_data = ConvertToFloat(scale);
+  const std::vector<float> bias_data = ConvertToFloat(B);
+  const auto* Xdata = X->Data<MLFloat16>();
+  auto* Ydata = Y->MutableData<MLFloat16>();
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  const double image_bytes = static_cast<double>(image_size * sizeof(MLFloat16));
+
+  if (!channels_last_) {
+    // The image of each channel is contiguous, so each one is normalized on its own.
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, onnxruntime::narrow<std::ptrdiff_t>(N * C),
+        TensorOpCost{image_bytes * 3, image_bytes, static_cast<double>(image_size * 8)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const MLFloat16* input = Xdata + i * image_size;
+            const auto moments = RowMoments(input, static_cast<size_t>(image_size));
+            const float channel_scale = scale_data[i % C] / std::sqrt(moments.second + epsilon_);
+            const float channel_shift = bias_data[i % C] - moments.first * channel_scale;
+            ScaleShiftRow(input, Ydata + i * image_size, static_cast<size_t>(image_size),
+                          &channel_scale, &channel_shift, false);
+          }
+        });
+    return Status::OK();
+  }
+
+  // With channels last, a task gathers the statistics of a block of channels of one image by walking its pixels,
+  // converting the block's channels of each pixel together.
+  const int64_t channel_blocks = (C + kFp16NormChannelBlockSize - 1) / kFp16NormChannelBlockSize;
+  const int64_t block_channels = std::min(C, kFp16NormChannelBlockSize);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(N * channel_blocks),
+      TensorOpCost{image_bytes * block_channels * 3, image_bytes * block_channels,
+                   static_cast<double>(image_size * block_channels * 8)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        float buffer[kFp16NormChannelBlockSize];
+        float sum[kFp16NormChannelBlockSize];
+        float channel_scale[kFp16NormChannelBlockSize];
+        float channel_shift[kFp16NormChannelBlockSize];
+
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t n = task / channel_blocks;
+          const int64_t c0 = (task % channel_blocks) * kFp16NormChannelBlockSize;
+          const size_t count = static_cast<size_t>(std::min(kFp16NormChannelBlockSize, C - c0));
+          const MLFloat16* input = Xdata + n * image_size * C + c0;
+          MLFloat16* output = Ydata + n * image_size * C + c0;
+
+          std::fill_n(sum, count, 0.0f);
+          for (int64_t p = 0; p < image_size; ++p) {
+            MlasConvertHalfToFloatBuffer(&input[p * C].val, buffer, count);
+            for (size_t c = 0; c < count; ++c) {
+              sum[c] += buffer[c];
+            }
+          }
+          // channel_shift holds the means until the scale is known
+          for (size_t c = 0; c < count; ++c) {
+            channel_shift[c] = sum[c] / image_size;
+          }
+
+          std::fill_n(sum, count, 0.0f);
+          for (int64_t p = 0; p < image_size; ++p) {
+            MlasConvertHalfToFloatBuffer(&input[p * C].val, buffer, count);
+            for (size_t c = 0; c < count; ++c) {
+              sum[c] += (buffer[c] - channel_shift[c]) * (buffer[c] - channel_shift[c]);
+            }
+          }
+          for (size_t c = 0; c < count; ++c) {
+            channel_scale[c] = scale_data[c0 + c] / std::sqrt(sum[c] / image_size + epsilon_);
+            channel_shift[c] = bias_data[c0 + c] - channel_shift[c] * channel_scale[c];
+          }
+
+          for (int64_t p = 0; p < image_size; ++p) {
+            ScaleShiftRow(input + p * C, output + p * C, count, channel_scale, channel_shift, true);
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+//
+// Operator definitions
+//
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    BatchNormalization, 9, 13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    BatchNormFp16);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    BatchNormalization, 14, 14,
+    MLFloat16,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>())
+        .TypeConstraint("U", DataTypeImpl::GetTensorType<MLFloat16>()),
+    BatchNormFp16);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    BatchNormalization,
+    15,
+    MLFloat16,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<MLFloat16>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<MLFloat16>()),
+    BatchNormFp16);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    InstanceNormalization,
+    6,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    InstanceNormFp16);
+
+#ifndef DISABLE_CONTRIB_OPS
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    BatchNormalization,
+    kMSInternalNHWCDomain,
+    15,
+    MLFloat16,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>())
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<MLFloat16>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<MLFloat16>()),
+    BatchNormFp16);
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    InstanceNormalization,
+    kMSInternalNHWCDomain,
+    6,
+    MLFloat16,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    InstanceNormFp16);
+
+}  // namespace contrib
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace onnxruntime
+
+#endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
@@ -2,50 +2,111 @@
 // Licensed under the MIT License.
 
 #include "cumsum.h"
+
+#include <algorithm>
+
+#include "core/common/narrow.h"
 #include "core/providers/common.h"
-#include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 using namespace onnxruntime;
 
 namespace {
 // static section
-std::vector<int64_t> GetStarts(int64_t rank, int64_t axis, int64_t index) {
-  std::vector<int64_t> starts(onnxruntime::narrow<size_t>(rank), 0);
-  starts[onnxruntime::narrow<size_t>(axis)] = index;
-  return starts;
-}
+
+// Minimum number of elements along the axis scanned by each block when a single long scan is split across threads.
+constexpr std::ptrdiff_t kMinScanBlockSize = 16 * 1024;
+
+// Scans `count` contiguous elements in the given direction, starting from `carry`. The scan may be done in place.
 template <typename T>
-void ZeroOutSliceAtIndex(Tensor& output, int64_t rank, int64_t axis, int64_t index,
-                         gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  T zero{};
-  auto output_starts(GetStarts(rank, axis, index));
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator) {
-    *output_iterator = zero;
+void ScanContiguous(const T* input, T* output, std::ptrdiff_t count, bool exclusive, bool reverse, T carry) {
+  if (!reverse) {
+    if (exclusive) {
+      for (std::ptrdiff_t i = 0; i < count; ++i) {
+        const T value = input[i];
+        output[i] = carry;
+        carry += value;
+      }
+    } else {
+      for (std::ptrdiff_t i = 0; i < count; ++i) {
+        carry += input[i];
+        output[i] = carry;
+      }
+    }
+  } else {
+    if (exclusive) {
+      for (std::ptrdiff_t i = count - 1; i >= 0; --i) {
+        const T value = input[i];
+        output[i] = carry;
+        carry += value;
+      }
+    } else {
+      for (std::ptrdiff_t i = count - 1; i >= 0; --i) {
+        carry += input[i];
+        output[i] = carry;
+      }
+    }
   }
 }
+
+// Scans `columns` adjacent lanes that are `stride` elements apart along the axis. Each step adds a whole row to the
+// previous one, so the inner loops are contiguous and independent and the compiler vectorizes them.
 template <typename T>
-void CopySlices(const Tensor& input, Tensor& output,
-                const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts,
-                gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator) {
-    *output_iterator = *input_iterator;
+void ScanColumns(const T* input, T* output, std::ptrdiff_t dim, std::ptrdiff_t stride, std::ptrdiff_t columns,
+                 bool exclusive, bool reverse) {
+  const std::ptrdiff_t first = reverse ? dim - 1 : 0;
+  const std::ptrdiff_t step = reverse ? -stride : stride;
+
+  T* out = output + first * stride;
+  const T* in = input + first * stride;
+  if (exclusive) {
+    std::fill_n(out, columns, T{});
+  } else {
+    std::copy_n(in, columns, out);
+  }
+
+  for (std::ptrdiff_t index = 1; index < dim; ++index) {
+    const T* previous_out = out;
+    // an exclusive scan adds the input of the previous position along the axis
+    const T* addend = exclusive ? in : in + step;
+    out += step;
+    in += step;
+    for (std::ptrdiff_t k = 0; k < columns; ++k) {
+      out[k] = previous_out[k] + addend[k];
+    }
   }
 }
+
+// Scans one long contiguous axis with a two pass blocked scan: the blocks are summed in parallel, the block sums are
+// scanned to find the offset each block starts from, and then the blocks are scanned in parallel from their offsets.
 template <typename T>
-void SumSlices(const Tensor& input, Tensor& output,
-               const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts, const std::vector<int64_t>& previous_output_starts,
-               gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  SliceIterator<T> previous_output_iterator(output, previous_output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator, ++previous_output_iterator) {
-    *output_iterator = *input_iterator + *previous_output_iterator;
-  }
+void ParallelScanContiguous(concurrency::ThreadPool* tp, const T* input, T* output, std::ptrdiff_t dim,
+                            std::ptrdiff_t num_blocks, bool exclusive, bool reverse) {
+  const std::ptrdiff_t block_size = (dim + num_blocks - 1) / num_blocks;
+  num_blocks = (dim + block_size - 1) / block_size;
+  std::vector<T> block_offsets(onnxruntime::narrow<size_t>(num_blocks));
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    const std::ptrdiff_t start = block * block_size;
+    const std::ptrdiff_t count = std::min(block_size, dim - start);
+    T sum{};
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      sum += input[start + i];
+    }
+    block_offsets[onnxruntime::narrow<size_t>(block)] = sum;
+  });
+
+  // exclusive scan of the block sums in the direction of the scan
+  ScanContiguous(block_offsets.data(), block_offsets.data(), num_blocks, true, reverse, T{});
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    const std::ptrdiff_t start = block * block_size;
+    const std::ptrdiff_t count = std::min(block_size, dim - start);
+    ScanContiguous(input + start, output + start, count, exclusive, reverse,
+                   block_offsets[onnxruntime::narrow<size_t>(block)]);
+  });
 }
 }  // namespace
 
@@ -200,65 +261,56 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   int64_t axis = 0;
   ORT_THROW_IF_ERROR(cumsum_op::GetAxis(axis_tensor, rank, axis));
 
-  auto dim(output_tensor.Shape()[onnxruntime::narrow<size_t>(axis)]);  // dimension size for the axis
-  TensorShape slice_shape(input->Shape());                             // the shape of one slice of input/output for the given value of the axis
-  slice_shape[onnxruntime::narrow<size_t>(axis)] = 1;
-  auto slice_size(slice_shape.Size());     // total number of elements in each slice
-  auto slice_dims(slice_shape.GetDims());  // dim array for the slice
-
-  std::vector<int64_t> steps(onnxruntime::narrow<size_t>(rank), 1);  // steps for the slice -- always set to 1
-
-  if (!reverse_) {
-    int64_t index(0);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      ++index;
+  // view the tensor as [outer, dim, inner] with the scan running along dim
+  const auto axis_index = onnxruntime::narrow<size_t>(axis);
+  const auto dim = onnxruntime::narrow<std::ptrdiff_t>(output_shape[axis_index]);
+  const auto outer = onnxruntime::narrow<std::ptrdiff_t>(output_shape.SizeToDimension(axis_index));
+  const auto inner = onnxruntime::narrow<std::ptrdiff_t>(output_shape.SizeFromDimension(axis_index + 1));
+
+  const T* input_data = input->Data<T>();
+  T* output_data = output_tensor.MutableData<T>();
+  const bool exclusive = exclusive_ != 0;
+  const bool reverse = reverse_ != 0;
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  // the cost of scanning one lane along the axis
+  const TensorOpCost lane_cost{static_cast<double>(dim * sizeof(T)), static_cast<double>(dim * sizeof(T)),
+                               static_cast<double>(dim)};
+
+  if (inner == 1) {
+    // When there are too few rows to keep the threads busy, split each long row into blocks instead.
+    const std::ptrdiff_t num_threads = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    const std::ptrdiff_t num_blocks = std::min(num_threads, dim / kMinScanBlockSize);
+    if (outer < num_threads && num_blocks > 1) {
+      for (std::ptrdiff_t row = 0; row < outer; ++row) {
+        ParallelScanContiguous(tp, input_data + row * dim, output_data + row * dim, dim, num_blocks,
+                               exclusive, reverse);
+      }
+      return Status::OK();
     }
 
-    if (index < dim) {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, 0));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      ++index;
-    }
-
-    for (; index < dim; ++index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index - 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index - 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
-  } else {
-    //_reverse == true
-    int64_t index(dim - 1);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      --index;
-    }
-
-    if (index >= 0) {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, dim - 1));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      --index;
-    }
-
-    for (; index >= 0; --index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index + 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index + 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
+    concurrency::ThreadPool::TryParallelFor(
+        tp, outer, lane_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t row = first; row < last; ++row) {
+            ScanContiguous(input_data + row * dim, output_data + row * dim, dim, exclusive, reverse, T{});
+          }
+        });
+    return Status::OK();
   }
 
+  // Each of the outer * inner lanes is scanned independently, so split the lanes across threads and scan the
+  // adjacent lanes of a range together.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, outer * inner, lane_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        while (first < last) {
+          const std::ptrdiff_t o = first / inner;
+          const std::ptrdiff_t i = first % inner;
+          const std::ptrdiff_t columns = std::min(last - first, inner - i);
+          const std::ptrdiff_t offset = o * dim * inner + i;
+          ScanColumns(input_data + offset, output_data + offset, dim, inner, columns, exclusive, reverse);
+          first += columns;
+        }
+      });
+
   return Status::OK();
 }
 
@@ -3,6 +3,8 @@
 
 #include "einsum.h"
 
+#include "core/mlas/inc/mlas.h"
+
 namespace onnxruntime {
 
 // Credit: Implementation influenced by Torch's implementation at the time of writing
@@ -17,6 +19,237 @@ ONNX_CPU_OPERATOR_KERNEL(
                                                DataTypeImpl::GetTensorType<int32_t>()}),
     Einsum);
 
+namespace {
+
+// Labels of the dims of an ellipsis follow the labels of the letters
+constexpr int64_t kEllipsisLabelBase = EinsumOp::num_of_letters;
+
+// Expand a subscript to a label for each dim of an operand with the given number of ellipsis dims.
+// The ellipsis dims are aligned to the innermost of the max_ellipsis_rank ellipsis labels, as they broadcast.
+bool ExpandSubscriptLabels(const std::string& subscript, size_t ellipsis_rank, size_t max_ellipsis_rank,
+                           std::vector<int64_t>& labels) {
+  labels.clear();
+  for (size_t i = 0; i < subscript.size(); ++i) {
+    if (subscript[i] == '.') {
+      if (subscript.compare(i, 3, "...") != 0) {
+        return false;
+      }
+      for (size_t e = 0; e < ellipsis_rank; ++e) {
+        labels.push_back(kEllipsisLabelBase + static_cast<int64_t>(max_ellipsis_rank - ellipsis_rank + e));
+      }
+      i += 2;
+    } else {
+      int64_t letter_index = EinsumOp::LetterToIndex(subscript[i]);
+      if (letter_index == -1) {
+        return false;
+      }
+      labels.push_back(letter_index);
+    }
+  }
+  return true;
+}
+
+// Returns whether labels is the concatenation of the given label sequences
+bool IsConcatenation(const std::vector<int64_t>& labels, std::initializer_list<const std::vector<int64_t>*> sequences) {
+  size_t offset = 0;
+  for (const auto* sequence : sequences) {
+    if (labels.size() < offset + sequence->size() ||
+        !std::equal(sequence->begin(), sequence->end(), labels.begin() + offset)) {
+      return false;
+    }
+    offset += sequence->size();
+  }
+  return offset == labels.size();
+}
+
+EinsumGemmPlan CreateGemmPlan(const EinsumEquationPreprocessor& equation, const std::vector<const Tensor*>& inputs) {
+  EinsumGemmPlan plan;
+
+  // The implicit form (and its sorted output subscript) is left to the general implementation
+  if (!equation.is_explicit_ || inputs.size() != 2 || equation.left_equation_split_.size() != 2) {
+    return plan;
+  }
+
+  // Find the number of dims of the ellipsis of each input
+  size_t ellipsis_ranks[2];
+  size_t max_ellipsis_rank = 0;
+  for (size_t i = 0; i < 2; ++i) {
+    const std::string& subscript = equation.left_equation_split_[i];
+    const size_t rank = inputs[i]->Shape().NumDimensions();
+    const bool has_ellipsis = subscript.find("...") != std::string::npos;
+    const size_t letter_count = static_cast<size_t>(
+        std::count_if(subscript.begin(), subscript.end(), [](char c) { return c != '.'; }));
+    if (has_ellipsis ? letter_count > rank : letter_count != rank) {
+      return plan;
+    }
+    ellipsis_ranks[i] = rank - letter_count;
+    max_ellipsis_rank = std::max(max_ellipsis_rank, ellipsis_ranks[i]);
+  }
+
+  std::vector<int64_t> labels[3];
+  if (!ExpandSubscriptLabels(equation.left_equation_split_[0], ellipsis_ranks[0], max_ellipsis_rank, labels[0]) ||
+      !ExpandSubscriptLabels(equation.left_equation_split_[1], ellipsis_ranks[1], max_ellipsis_rank, labels[1]) ||
+      !ExpandSubscriptLabels(equation.right_equation_, max_ellipsis_rank, max_ellipsis_rank, labels[2])) {
+    return plan;
+  }
+
+  // Record the operands (a bit for each of the inputs and the output) and the dim value of each label.
+  // A label repeated within an operand (a diagonal) or a dim value that broadcasts is not lowered.
+  const size_t label_count = static_cast<size_t>(kEllipsisLabelBase) + max_ellipsis_rank;
+  std::vector<uint32_t> label_operands(label_count, 0);
+  std::vector<int64_t> label_dims(label_count, -1);
+
+  for (size_t i = 0; i < 2; ++i) {
+    const auto dims = inputs[i]->Shape().GetDims();
+    for (size_t d = 0; d < labels[i].size(); ++d) {
+      const size_t label = static_cast<size_t>(labels[i][d]);
+      if ((label_operands[label] & (1u << i)) != 0 || dims[d] == 0 ||
+          (label_dims[label] != -1 && label_dims[label] != dims[d])) {
+        return plan;
+      }
+      label_operands[label] |= 1u << i;
+      label_dims[label] = dims[d];
+    }
+  }
+
+  for (int64_t label : labels[2]) {
+    if (label_operands[static_cast<size_t>(label)] == 0 || (label_operands[static_cast<size_t>(label)] & 4u) != 0) {
+      return plan;
+    }
+    label_operands[static_cast<size_t>(label)] |= 4u;
+  }
+
+  // Group the labels: batch labels are in all three operands, M labels are in the first input and the output,
+  // N labels are in the second input and the output, and K labels are in both inputs and are reduced.
+  // A label in only one input (a reduction of that input alone) is not lowered.
+  std::vector<int64_t> batch_labels, m_labels, n_labels, k_labels;
+  for (int64_t label : labels[2]) {
+    switch (label_operands[static_cast<size_t>(label)]) {
+      case 7u:
+        batch_labels.push_back(label);
+        break;
+      case 5u:
+        m_labels.push_back(label);
+        break;
+      case 6u:
+        n_labels.push_back(label);
+        break;
+      default:
+        return plan;
+    }
+  }
+  for (int64_t label : labels[0]) {
+    switch (label_operands[static_cast<size_t>(label)]) {
+      case 3u:
+        k_labels.push_back(label);
+        break;
+      case 1u:
+        return plan;
+      default:
+        break;
+    }
+  }
+  for (int64_t label : labels[1]) {
+    if (label_operands[static_cast<size_t>(label)] == 2u) {
+      return plan;
+    }
+  }
+
+  // The batch labels lead every operand and each group is contiguous, in the same order in every operand.
+  bool swap_operands;
+  if (IsConcatenation(labels[2], {&batch_labels, &m_labels, &n_labels})) {
+    swap_operands = false;
+  } else if (IsConcatenation(labels[2], {&batch_labels, &n_labels, &m_labels})) {
+    swap_operands = true;
+  } else {
+    return plan;
+  }
+
+  bool left_transposed;
+  if (IsConcatenation(labels[0], {&batch_labels, &m_labels, &k_labels})) {
+    left_transposed = false;
+  } else if (IsConcatenation(labels[0], {&batch_labels, &k_labels, &m_labels})) {
+    left_transposed = true;
+  } else {
+    return plan;
+  }
+
+  bool right_transposed;
+  if (IsConcatenation(labels[1], {&batch_labels, &k_labels, &n_labels})) {
+    right_transposed = false;
+  } else if (IsConcatenation(labels[1], {&batch_labels, &n_labels, &k_labels})) {
+    right_transposed = true;
+  } else {
+    return plan;
+  }
+
+  auto group_size = [&](const std::vector<int64_t>& group) {
+    size_t size = 1;
+    for (int64_t label : group) {
+      size *= static_cast<size_t>(label_dims[static_cast<size_t>(label)]);
+    }
+    return size;
+  };
+
+  // An output laid out as [batch, N, M] is the transposed product, computed with the inputs swapped.
+  plan.is_gemm = true;
+  plan.a_input = swap_operands ? 1 : 0;
+  plan.trans_a = swap_operands ? !right_transposed : left_transposed;
+  plan.trans_b = swap_operands ? !left_transposed : right_transposed;
+  plan.batch = group_size(batch_labels);
+  plan.m = group_size(swap_operands ? n_labels : m_labels);
+  plan.n = group_size(swap_operands ? m_labels : n_labels);
+  plan.k = group_size(k_labels);
+
+  plan.output_dims.reserve(labels[2].size());
+  for (int64_t label : labels[2]) {
+    plan.output_dims.push_back(label_dims[static_cast<size_t>(label)]);
+  }
+
+  return plan;
+}
+
+template <typename T, typename DataParams>
+void ComputeGemmPlan(const EinsumGemmPlan& plan, const T* a, const T* b, T* c, concurrency::ThreadPool* tp) {
+  std::vector<DataParams> data(plan.batch);
+  for (size_t i = 0; i < plan.batch; ++i) {
+    data[i].A = a + i * plan.m * plan.k;
+    data[i].lda = plan.trans_a ? plan.m : plan.k;
+    data[i].B = b + i * plan.k * plan.n;
+    data[i].ldb = plan.trans_b ? plan.k : plan.n;
+    data[i].C = c + i * plan.m * plan.n;
+    data[i].ldc = plan.n;
+  }
+
+  MlasGemmBatch(plan.trans_a ? CblasTrans : CblasNoTrans, plan.trans_b ? CblasTrans : CblasNoTrans,
+                plan.m, plan.n, plan.k, data.data(), plan.batch, tp);
+}
+
+}  // namespace
+
+EinsumGemmPlan Einsum::GetGemmPlan(const std::vector<const Tensor*>& inputs) const {
+  std::vector<int64_t> key;
+  for (const auto* input : inputs) {
+    const auto dims = input->Shape().GetDims();
+    key.push_back(static_cast<int64_t>(dims.size()));
+    key.insert(key.end(), dims.begin(), dims.end());
+  }
+
+  std::lock_guard<std::mutex> lock(gemm_plan_cache_mutex_);
+
+  auto it = gemm_plan_cache_.find(key);
+  if (it == gemm_plan_cache_.end()) {
+    // Bound the cache for models whose input shapes keep changing
+    constexpr size_t kMaxCachedPlans = 64;
+    if (gemm_plan_cache_.size() >= kMaxCachedPlans) {
+      gemm_plan_cache_.clear();
+    }
+    it = gemm_plan_cache_.emplace(std::move(key), CreateGemmPlan(*einsum_equation_preprocessor_, inputs)).first;
+  }
+
+  return it->second;
+}
+
 Status Einsum::Compute(OpKernelContext* context) const {
   int num_inputs = context->InputCount();
   if (num_inputs == 0) {
@@ -45,6 +278,24 @@ Status Einsum::Compute(OpKernelContext* context) const {
 
 Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const Tensor*>& inputs,
                              AllocatorPtr allocator, concurrency::ThreadPool* tp) const {
+  // Compute a contraction laid out as a batched matrix multiply directly on the inputs
+  if (inputs.size() == 2 && (inputs[0]->IsDataType<float>() || inputs[0]->IsDataType<double>())) {
+    const EinsumGemmPlan plan = GetGemmPlan(inputs);
+    if (plan.is_gemm) {
+      const Tensor& a = *inputs[plan.a_input];
+      const Tensor& b = *inputs[1 - plan.a_input];
+      Tensor& output = *context->Output(0, plan.output_dims);
+      if (inputs[0]->IsDataType<float>()) {
+        ComputeGemmPlan<float, MLAS_SGEMM_DATA_PARAMS>(plan, a.Data<float>(), b.Data<float>(),
+                                                       output.MutableData<float>(), tp);
+      } else {
+        ComputeGemmPlan<double, MLAS_DGEMM_DATA_PARAMS>(plan, a.Data<double>(), b.Data<double>(),
+                                                        output.MutableData<double>(), tp);
+      }
+      return Status::OK();
+    }
+  }
+
   // EinsumComputePreprocessor section -
   auto einsum_compute_preprocessor =
       EinsumComputePreprocessor(*einsum_equation_preprocessor_, inputs, allocator, nullptr);
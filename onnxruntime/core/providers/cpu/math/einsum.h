@@ -10,8 +10,28 @@
 #endif
 #include "einsum_utils/einsum_compute_preprocessor.h"
 
+#include <map>
+#include <mutex>
+
 namespace onnxruntime {
 
+// A two operand Einsum whose subscripts are laid out as [batch, M, K] x [batch, K, N] -> [batch, M, N],
+// up to the order of the groups within each operand, is computed with a strided batched GEMM on the
+// operands as they are, with no intermediate transposes.
+struct EinsumGemmPlan {
+  // Whether the contraction can be computed with a single strided batched GEMM
+  bool is_gemm = false;
+  // The input supplying matrix A (the other supplies matrix B)
+  size_t a_input = 0;
+  bool trans_a = false;
+  bool trans_b = false;
+  size_t batch = 0;
+  size_t m = 0;
+  size_t n = 0;
+  size_t k = 0;
+  TensorShapeVector output_dims;
+};
+
 class Einsum : public OpKernel {
  public:
   Einsum(const OpKernelInfo& info) : OpKernel(info) {
@@ -27,8 +47,15 @@ class Einsum : public OpKernel {
   virtual Status DeviceCompute(OpKernelContext* context, const std::vector<const Tensor*>& inputs,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp) const;
 
+  // Returns the GEMM plan of the input shapes, computing it on the first call with the shapes
+  EinsumGemmPlan GetGemmPlan(const std::vector<const Tensor*>& inputs) const;
+
   std::string equation_;
   std::unique_ptr<EinsumEquationPreprocessor> einsum_equation_preprocessor_;
+
+  // The GEMM plans of the input shapes seen so far, keyed by the ranks and dims of the inputs
+  mutable std::mutex gemm_plan_cache_mutex_;
+  mutable std::map<std::vector<int64_t>, EinsumGemmPlan> gemm_plan_cache_;
 };
 
 }  // namespace onnxruntime
@@ -13,6 +13,7 @@
 #include "core/mlas/inc/mlas.h"
 
 #include <cmath>
+#include <functional>
 
 namespace onnxruntime {
 // Supported types for operators that have type reduction enabled
@@ -974,91 +975,67 @@ Status Xor::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
-template <typename T>
-Status Equal<T>::Compute(OpKernelContext* context) const {
-  ProcessBroadcastSpanFuncs funcs{
+// Comparisons of spans of inputs in plain loops, which compilers vectorize, including the narrowing of the results to
+// bool. Eigen evaluates comparisons that produce bool one element at a time.
+template <typename T, typename Compare>
+ProcessBroadcastSpanFuncs ComparisonBroadcastFuncs() {
+  return ProcessBroadcastSpanFuncs{
       [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.ScalarInput0<T>() == per_iter_bh.EigenInput1<T>().array();
+        const T& input0 = per_iter_bh.ScalarInput0<T>();
+        const T* input1 = per_iter_bh.SpanInput1<T>().data();
+        auto output = per_iter_bh.OutputSpan<bool>();
+        bool* output_data = output.data();
+        for (size_t i = 0, count = output.size(); i < count; ++i) {
+          output_data[i] = Compare{}(input0, input1[i]);
+        }
       },
       [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput0<T>().array() == per_iter_bh.ScalarInput1<T>();
+        const T* input0 = per_iter_bh.SpanInput0<T>().data();
+        const T& input1 = per_iter_bh.ScalarInput1<T>();
+        auto output = per_iter_bh.OutputSpan<bool>();
+        bool* output_data = output.data();
+        for (size_t i = 0, count = output.size(); i < count; ++i) {
+          output_data[i] = Compare{}(input0[i], input1);
+        }
       },
       [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() =
-            per_iter_bh.EigenInput0<T>().array() == per_iter_bh.EigenInput1<T>().array();
+        const T* input0 = per_iter_bh.SpanInput0<T>().data();
+        const T* input1 = per_iter_bh.SpanInput1<T>().data();
+        auto output = per_iter_bh.OutputSpan<bool>();
+        bool* output_data = output.data();
+        for (size_t i = 0, count = output.size(); i < count; ++i) {
+          output_data[i] = Compare{}(input0[i], input1[i]);
+        }
       }};
+}
 
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+template <typename T>
+Status Equal<T>::Compute(OpKernelContext* context) const {
+  UntypedBroadcastTwo(*context, ComparisonBroadcastFuncs<T, std::equal_to<T>>(), 1.0);
   return Status::OK();
 }
 
 template <typename T>
 Status Less<T>::Compute(OpKernelContext* context) const {
-  ProcessBroadcastSpanFuncs funcs{
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput1<T>().array() > per_iter_bh.ScalarInput0<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput0<T>().array() < per_iter_bh.ScalarInput1<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput0<T>().array() < per_iter_bh.EigenInput1<T>().array();
-      }};
-
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+  UntypedBroadcastTwo(*context, ComparisonBroadcastFuncs<T, std::less<T>>(), 1.0);
   return Status::OK();
 }
 
 template <typename T>
 Status Greater<T>::Compute(OpKernelContext* context) const {
-  ProcessBroadcastSpanFuncs funcs{
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput1<T>().array() < per_iter_bh.ScalarInput0<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput0<T>().array() > per_iter_bh.ScalarInput1<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() =
-            per_iter_bh.EigenInput0<T>().array() > per_iter_bh.EigenInput1<T>().array();
-      }};
-
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+  UntypedBroadcastTwo(*context, ComparisonBroadcastFuncs<T, std::greater<T>>(), 1.0);
   return Status::OK();
 }
 
 template <typename T>
 Status LessOrEqual<T>::Compute(OpKernelContext* context) const {
-  ProcessBroadcastSpanFuncs funcs{
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput1<T>().array() >= per_iter_bh.ScalarInput0<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput0<T>().array() <= per_iter_bh.ScalarInput1<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput0<T>().array() <= per_iter_bh.EigenInput1<T>().array();
-      }};
-
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+  UntypedBroadcastTwo(*context, ComparisonBroadcastFuncs<T, std::less_equal<T>>(), 1.0);
   return Status::OK();
 }
 
 template <typename T>
 Status GreaterOrEqual<T>::Compute(OpKernelContext* context) const {
-  ProcessBroadcastSpanFuncs funcs{
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput1<T>().array() <= per_iter_bh.ScalarInput0<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() = per_iter_bh.EigenInput0<T>().array() >= per_iter_bh.ScalarInput1<T>();
-      },
-      [](BroadcastHelper& per_iter_bh) {
-        per_iter_bh.OutputEigen<bool>() =
-            per_iter_bh.EigenInput0<T>().array() >= per_iter_bh.EigenInput1<T>().array();
-      }};
-
-  UntypedBroadcastTwo(*context, funcs, 1.0);
+  UntypedBroadcastTwo(*context, ComparisonBroadcastFuncs<T, std::greater_equal<T>>(), 1.0);
   return Status::OK();
 }
 
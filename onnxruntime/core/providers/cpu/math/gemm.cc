@@ -5,6 +5,7 @@
 #include "core/providers/cpu/math/gemm.h"
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
@@ -138,6 +139,155 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+bool GemmIsCachedPackBFp32(const Tensor& tensor_b,
+                           bool trans_b,
+                           size_t packed_b_size,
+                           TensorShape& b_shape) {
+  const auto& shape = tensor_b.Shape();
+  if (shape.NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  if (packed_b_size == 0 || MlasGemmPackBSize(N, K) != packed_b_size) {
+    return false;
+  }
+
+  b_shape = shape;
+  return true;
+}
+
+bool GemmUseBf16(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  return ep->Type() == kCpuExecutionProvider &&
+         (static_cast<const CPUExecutionProvider*>(ep)->GetInfo().enable_bf16_gemm ||
+          static_cast<const CPUExecutionProvider*>(ep)->GetInfo().enable_bf16_mixed_precision) &&
+         MlasBf16GemmSupported();
+}
+
+bool GemmUseBf16MixedPrecision(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  return ep->Type() == kCpuExecutionProvider &&
+         static_cast<const CPUExecutionProvider*>(ep)->GetInfo().enable_bf16_mixed_precision &&
+         MlasBf16GemmSupported();
+}
+
+bool GemmPackBBf16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   IAllocatorUniquePtr<void>& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasBf16GemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  auto* packed_b_data = packed_b.get();
+
+  // zero the alignment padding so that the hashes of the pre-packed buffers are deterministic
+  memset(packed_b_data, 0, packed_b_size);
+
+  MlasBf16GemmConvertPackB(trans_b ? CblasTrans : CblasNoTrans,
+                           N,
+                           K,
+                           tensor_b.Data<float>(),
+                           trans_b ? K : N,
+                           packed_b_data);
+  return true;
+}
+
+bool GemmIsCachedPackBBf16(const Tensor& tensor_b,
+                           bool trans_b,
+                           size_t packed_b_size,
+                           TensorShape& b_shape) {
+  const auto& shape = tensor_b.Shape();
+  if (shape.NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  if (packed_b_size == 0 || MlasBf16GemmPackBSize(N, K) != packed_b_size) {
+    return false;
+  }
+
+  b_shape = shape;
+  return true;
+}
+
+bool GemmUseSparse24(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  return ep->Type() == kCpuExecutionProvider &&
+         static_cast<const CPUExecutionProvider*>(ep)->GetInfo().enable_sparse24_gemm;
+}
+
+bool GemmPackBSparse24(AllocatorPtr& alloc,
+                       const Tensor& tensor_b,
+                       bool trans_b,
+                       IAllocatorUniquePtr<void>& packed_b,
+                       size_t& packed_b_size,
+                       TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const auto& shape = tensor_b.Shape();
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  const float* b_data = tensor_b.Data<float>();
+  if (N == 0 || K == 0 ||
+      !MlasSparse24GemmIsSparse(trans_b ? CblasTrans : CblasNoTrans, N, K, b_data, trans_b ? K : N)) {
+    return false;
+  }
+  b_shape = shape;
+
+  packed_b_size = MlasSparse24GemmPackBSize(N, K);
+  packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_b_size, true);
+  auto* packed_b_data = packed_b.get();
+
+  // zero the alignment padding so that the hashes of the pre-packed buffers are deterministic
+  memset(packed_b_data, 0, packed_b_size);
+
+  MlasSparse24GemmPackB(trans_b ? CblasTrans : CblasNoTrans,
+                        N,
+                        K,
+                        b_data,
+                        trans_b ? K : N,
+                        packed_b_data);
+  return true;
+}
+
+bool GemmIsCachedPackBSparse24(const Tensor& tensor_b,
+                               bool trans_b,
+                               size_t packed_b_size,
+                               TensorShape& b_shape) {
+  const auto& shape = tensor_b.Shape();
+  if (shape.NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  if (N == 0 || K == 0 || MlasSparse24GemmPackBSize(N, K) != packed_b_size ||
+      !MlasSparse24GemmIsSparse(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(), trans_b ? K : N)) {
+    return false;
+  }
+
+  b_shape = shape;
+  return true;
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -189,7 +339,7 @@ void Gemm<MLFloat16>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans
 #if defined(__GNUC__) && defined(HAS_CLASS_MEMACCESS)
 #pragma GCC diagnostic pop
 #endif
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) || defined(MLAS_TARGET_AMD64)
   bool support_mlas = false;
   if (c_shape == nullptr) {
     support_mlas = true;
@@ -253,7 +403,12 @@ Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx,
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    use_sparse24_gemm_ = allow_sparse24_gemm_ &&
+                         GemmPackBSparse24(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_);
+    is_packed = use_sparse24_gemm_ ||
+                (use_bf16_gemm_
+                     ? GemmPackBBf16(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_)
+                     : GemmPackBFp32(alloc, tensor, trans_B_ != CblasNoTrans, packed_b_, packed_b_size, b_shape_));
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -284,6 +439,41 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <typename T>
+Status Gemm<T>::UseCachedPrePackedBuffers(const Tensor& /*tensor*/,
+                                          std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                          gsl::span<const size_t> /*prepacked_buffer_sizes*/,
+                                          int /*input_idx*/,
+                                          /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseCachedPrePackedBuffers(const Tensor& tensor,
+                                              std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              gsl::span<const size_t> prepacked_buffer_sizes,
+                                              int input_idx,
+                                              /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  if (input_idx != 1 || prepacked_buffers.size() != 1) {
+    return Status::OK();
+  }
+
+  // PrePack compresses B if it is 2:4 sparse, which the size of the cached buffer tells apart
+  use_sparse24_gemm_ = allow_sparse24_gemm_ &&
+                       GemmIsCachedPackBSparse24(tensor, trans_B_ != CblasNoTrans, prepacked_buffer_sizes[0], b_shape_);
+  if (use_sparse24_gemm_ ||
+      (use_bf16_gemm_
+           ? GemmIsCachedPackBBf16(tensor, trans_B_ != CblasNoTrans, prepacked_buffer_sizes[0], b_shape_)
+           : GemmIsCachedPackBFp32(tensor, trans_B_ != CblasNoTrans, prepacked_buffer_sizes[0], b_shape_))) {
+    used_cached_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -408,27 +598,91 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
-    ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
-                c_data, c_shape, y_data, thread_pool);
-  } else {
+  bool activation_fused = false;
+
+  if (use_sparse24_gemm_ && !B) {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    MlasGemm(
-        trans_A_,
-        static_cast<size_t>(M),
-        static_cast<size_t>(N),
-        static_cast<size_t>(K),
-        alpha_,
-        A->Data<float>(),
-        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-        packed_b_.get(),
-        c_data != nullptr ? beta_ : 0.0f,
-        y_data,
-        static_cast<size_t>(N),
-        thread_pool);
+    if (c_data != nullptr && beta_ != 0.0f && beta_ != 1.0f) {
+      EigenMatrixMapRowMajor<float>(y_data, M, N) *= beta_;
+    }
+    MLAS_SPARSE24_GEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(K);
+    data.B = packed_b_.get();
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.ZeroMode = c_data == nullptr || beta_ == 0.0f;
+    MlasSparse24GemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), 1, &data,
+                          thread_pool);
+  } else if (use_bf16_gemm_ && !B) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    if (c_data != nullptr && beta_ != 0.0f && beta_ != 1.0f) {
+      EigenMatrixMapRowMajor<float>(y_data, M, N) *= beta_;
+    }
+    MLAS_BF16_GEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(K);
+    data.B = packed_b_.get();
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.ZeroMode = c_data == nullptr || beta_ == 0.0f;
+    MlasBf16GemmBatch(static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), 1, &data,
+                      thread_pool);
+  } else {
+    MLAS_SGEMM_EPILOGUE epilogue;
+    bool use_epilogue = false;
+    float beta = c_data != nullptr ? beta_ : 0.0f;
+
+    // Add C as part of the epilogue, while the output is in cache, instead of copying it to the output first.
+    // The addend is added after the activation, so C only becomes the addend without one.
+    if (c_data != nullptr && beta_ == 1.0f) {
+      const auto& c_dims = c_shape->GetDims();
+      if (c_shape->Size() == N && (c_dims.size() == 1 || (c_dims.size() == 2 && c_dims[0] == 1))) {
+        epilogue.Bias = c_data;
+      } else if (c_dims.size() == 2 && c_dims[0] == M && c_dims[1] == N &&
+                 mlas_activation_.ActivationKind == MlasIdentityActivation) {
+        epilogue.Addend = c_data;
+        epilogue.ldaddend = static_cast<size_t>(N);
+      }
+      if (epilogue.Bias != nullptr || epilogue.Addend != nullptr) {
+        use_epilogue = true;
+        beta = 0.0f;
+      }
+    }
+
+    if (!use_epilogue) {
+      GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    }
+
+    if (mlas_activation_.ActivationKind != MlasIdentityActivation) {
+      epilogue.Activation = &mlas_activation_;
+      use_epilogue = true;
+      activation_fused = true;
+    }
+
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+    if (B) {
+      data.B = B->Data<float>();
+      data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+    } else {
+      data.B = static_cast<const float*>(packed_b_.get());
+      data.BIsPacked = true;
+    }
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.alpha = alpha_;
+    data.beta = beta;
+    data.Epilogue = use_epilogue ? &epilogue : nullptr;
+
+    MlasGemmBatch(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                  &data, 1, thread_pool);
   }
 
-  ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+  if (!activation_fused) {
+    ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
+  }
 
   return Status::OK();
 }
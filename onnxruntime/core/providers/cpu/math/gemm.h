@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -16,6 +17,12 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+    // the bfloat16 kernel computes A * B for a pre-packed B
+    use_bf16_gemm_ = std::is_same<T, float>::value && trans_A_ == CblasNoTrans && alpha_ == 1.0f &&
+                     GemmUseBf16(info);
+    // so does the 2:4 sparse kernel, if B turns out to be 2:4 sparse when it is pre-packed
+    allow_sparse24_gemm_ = std::is_same<T, float>::value && trans_A_ == CblasNoTrans && alpha_ == 1.0f &&
+                           GemmUseSparse24(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -28,6 +35,12 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor,
+                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   gsl::span<const size_t> prepacked_buffer_sizes,
+                                   int input_idx,
+                                   /*out*/ bool& used_cached_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
                           T alpha,
@@ -40,9 +53,16 @@ class Gemm : protected GemmBase, public OpKernel {
  protected:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // packed_b_ holds B in bfloat16 for MlasBf16GemmBatch
+  bool use_bf16_gemm_{false};
+  bool allow_sparse24_gemm_{false};
+  // packed_b_ holds the compressed B for MlasSparse24GemmBatch, which takes precedence over use_bf16_gemm_
+  bool use_sparse24_gemm_{false};
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
+  // activation_ as an MLAS activation, applied by the float SGEMM epilogue
+  MLAS_ACTIVATION mlas_activation_{MlasIdentityActivation, {}};
 
   void ComputeActivation(_Inout_updates_(y_size) T* y_data, ptrdiff_t y_size, _Inout_opt_ concurrency::ThreadPool* thread_pool) const;
 };
@@ -14,4 +14,54 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
 
+// Check that `packed_b_size` is the size GemmPackBFp32 produces for `tensor_b`, setting `b_shape` if it is.
+bool GemmIsCachedPackBFp32(const Tensor& tensor_b,
+                           bool trans_b,
+                           size_t packed_b_size,
+                           TensorShape& b_shape);
+
+// Check if the node runs on a CPU execution provider with bfloat16 GEMM enabled on a processor that supports it.
+bool GemmUseBf16(const OpKernelInfo& info);
+
+// Check if the node runs on a CPU execution provider with bfloat16 mixed precision enabled on a processor that
+// supports it, so B is converted to bfloat16 for each run when it isn't constant.
+bool GemmUseBf16MixedPrecision(const OpKernelInfo& info);
+
+// Converting a B that isn't constant to bfloat16 costs about as much as computing a few rows of the product, so
+// products with fewer rows than this stay in fp32.
+constexpr size_t kBf16GemmMinRows = 16;
+
+// Convert a 2D `tensor_b` to bfloat16 and pack it for MlasBf16GemmBatch.
+bool GemmPackBBf16(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   IAllocatorUniquePtr<void>& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape);
+
+// Check that `packed_b_size` is the size GemmPackBBf16 produces for `tensor_b`, setting `b_shape` if it is.
+bool GemmIsCachedPackBBf16(const Tensor& tensor_b,
+                           bool trans_b,
+                           size_t packed_b_size,
+                           TensorShape& b_shape);
+
+// Check if the node runs on a CPU execution provider with 2:4 structured sparse GEMM enabled.
+bool GemmUseSparse24(const OpKernelInfo& info);
+
+// Compress a 2D `tensor_b` that has 2:4 structured sparsity for MlasSparse24GemmBatch.
+// Returns false if `tensor_b` isn't 2:4 sparse.
+bool GemmPackBSparse24(AllocatorPtr& alloc,
+                       const Tensor& tensor_b,
+                       bool trans_b,
+                       IAllocatorUniquePtr<void>& packed_b,
+                       size_t& packed_b_size,
+                       TensorShape& b_shape);
+
+// Check that `tensor_b` is 2:4 sparse and `packed_b_size` is the size GemmPackBSparse24 produces for it, setting
+// `b_shape` if it is.
+bool GemmIsCachedPackBSparse24(const Tensor& tensor_b,
+                               bool trans_b,
+                               size_t packed_b_size,
+                               TensorShape& b_shape);
+
 };  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+#include "core/common/safeint.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/util/math.h"
@@ -134,7 +135,12 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+    use_sparse24_gemm_ = allow_sparse24_gemm_ &&
+                         GemmPackBSparse24(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+    is_packed = use_sparse24_gemm_ ||
+                (use_bf16_gemm_
+                     ? GemmPackBBf16(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_)
+                     : GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_));
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -157,6 +163,29 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status MatMul<float>::UseCachedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                gsl::span<const size_t> prepacked_buffer_sizes, int input_idx,
+                                                /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  if (input_idx != 1 || prepacked_buffers.size() != 1) {
+    return Status::OK();
+  }
+
+  // PrePack compresses B if it is 2:4 sparse, which the size of the cached buffer tells apart
+  use_sparse24_gemm_ = allow_sparse24_gemm_ &&
+                       GemmIsCachedPackBSparse24(tensor, trans_b_attr_ != 0, prepacked_buffer_sizes[0], b_shape_);
+  if (use_sparse24_gemm_ ||
+      (use_bf16_gemm_
+           ? GemmIsCachedPackBBf16(tensor, trans_b_attr_ != 0, prepacked_buffer_sizes[0], b_shape_)
+           : GemmIsCachedPackBFp32(tensor, trans_b_attr_ != 0, prepacked_buffer_sizes[0], b_shape_))) {
+    used_cached_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -187,6 +216,66 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
 
+  if (packed_b_ && use_sparse24_gemm_) {
+    std::vector<MLAS_SPARSE24_GEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].B = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+    }
+    MlasSparse24GemmBatch(M, N, K, max_len, data.data(), thread_pool);
+    return Status::OK();
+  }
+
+  if (packed_b_ && use_bf16_gemm_) {
+    std::vector<MLAS_BF16_GEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].B = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+    }
+    MlasBf16GemmBatch(M, N, K, max_len, data.data(), thread_pool);
+    return Status::OK();
+  }
+
+  const size_t bf16_packed_b_size = use_bf16_mixed_precision_ && !packed_b_ && M >= kBf16GemmMinRows
+                                        ? MlasBf16GemmPackBSize(N, K)
+                                        : 0;
+  if (bf16_packed_b_size != 0) {
+    // B is shared by the products that broadcast it, so each distinct B is converted once
+    InlinedHashMap<size_t, size_t> packed_b_indices;
+    InlinedVector<size_t> b_offsets;
+    for (size_t i = 0; i < max_len; i++) {
+      if (packed_b_indices.emplace(helper.RightOffsets()[i], b_offsets.size()).second) {
+        b_offsets.push_back(helper.RightOffsets()[i]);
+      }
+    }
+
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+    auto packed_b = IAllocator::MakeUniquePtr<uint8_t>(alloc, SafeInt<size_t>(bf16_packed_b_size) * b_offsets.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(b_offsets.size()), [&](std::ptrdiff_t i) {
+          MlasBf16GemmConvertPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, b_data + b_offsets[i], ldb,
+                                   packed_b.get() + i * bf16_packed_b_size);
+        });
+
+    std::vector<MLAS_BF16_GEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].B = packed_b.get() + packed_b_indices[helper.RightOffsets()[i]] * bf16_packed_b_size;
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+    }
+    MlasBf16GemmBatch(M, N, K, max_len, data.data(), thread_pool);
+    return Status::OK();
+  }
+
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
     data[i].BIsPacked = bool(packed_b_);
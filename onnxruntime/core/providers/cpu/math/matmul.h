@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -27,6 +28,13 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transBatchB", &trans_batch_b_attr, 0);
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
+    // the bfloat16 kernel computes A * B for a pre-packed B
+    use_bf16_gemm_ = trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_ && alpha_attr_ == 1.0f &&
+                     GemmUseBf16(info);
+    use_bf16_mixed_precision_ = use_bf16_gemm_ && GemmUseBf16MixedPrecision(info);
+    // so does the 2:4 sparse kernel, if B turns out to be 2:4 sparse when it is pre-packed
+    allow_sparse24_gemm_ = trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_ && alpha_attr_ == 1.0f &&
+                           GemmUseSparse24(info);
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -36,11 +44,22 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   gsl::span<const size_t> prepacked_buffer_sizes, int input_idx,
+                                   /*out*/ bool& used_cached_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
   TensorShape b_shape_;
   IAllocatorUniquePtr<void> packed_b_;
+  // packed_b_ holds B in bfloat16 for MlasBf16GemmBatch
+  bool use_bf16_gemm_{false};
+  // a B that isn't constant is converted to bfloat16 for each run
+  bool use_bf16_mixed_precision_{false};
+  bool allow_sparse24_gemm_{false};
+  // packed_b_ holds the compressed B for MlasSparse24GemmBatch, which takes precedence over use_bf16_gemm_
+  bool use_sparse24_gemm_{false};
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
@@ -25,6 +25,7 @@
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -32,6 +33,7 @@ namespace onnxruntime {
 template <typename T>
 struct GreaterValueCmp {
   using DataType = T;
+  static constexpr bool IsGreater = true;
   GreaterValueCmp(const T* data = nullptr) : data_(data) {
   }
 
@@ -53,6 +55,7 @@ struct GreaterValueCmp {
 template <typename T>
 struct LesserValueCmp {
   using DataType = T;
+  static constexpr bool IsGreater = false;
 
   LesserValueCmp(const T* data = nullptr) : data_(data) {
   }
@@ -140,6 +143,94 @@ static void SelectTopK(const Comparator& comparer,
   // the data_holder now contains the indices of the top k elements in the first k elements
 }
 
+// Rows of at least this many float values are selected with RadixSelectTopK instead of SelectTopK
+constexpr int64_t kRadixSelectMinBlocks = 1024;
+
+// The number of most significant key bits in the histogram of RadixSelectTopK
+constexpr int kRadixSelectBits = 11;
+
+// Maps a float value to an unsigned key that orders like the comparator prefers the value, so that the best
+// values have the largest keys. -0.0f and 0.0f compare equal, so they map to the same key.
+template <bool IsGreater>
+static inline uint32_t RadixSelectKey(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  // flip all the bits of the negative values and the sign bit of the others, so larger floats have larger keys.
+  // this is branch free, as the sign of the values of a row can't be predicted.
+  uint32_t key = bits ^ ((0u - (bits >> 31)) | 0x80000000u);
+  // -0.0f is now just below 0.0f
+  key += static_cast<uint32_t>(key == 0x7FFFFFFFu);
+  return IsGreater ? key : ~key;
+}
+
+// Selects the top k elements of a contiguous row of float values, as SelectTopK does, for the long rows of
+// vocabulary sized inputs.
+// A histogram of the most significant bits of the keys finds the bucket holding the k-th best value. Only the
+// values in that bucket or a better one can be in the top k, so a second pass collects these candidates and
+// just they are ordered with the comparator, which keeps the tie breaking on the index.
+// Returns false without selecting if the row holds a NaN, which has no place in the order of the keys.
+template <class Comparator>
+static bool RadixSelectTopK(const Comparator& comparer, const float* input_data, int64_t row_offset,
+                            int64_t num_blocks, const unsigned k, bool sort_top_k,
+                            std::vector<uint32_t>& histogram, std::vector<int64_t>& data_holder) {
+  constexpr int shift = 32 - kRadixSelectBits;
+  const float* row = input_data + row_offset;
+
+  // the histogram is split into 4 interleaved ones, as the values of a row mostly fall into a few buckets and
+  // consecutive increments of the same counter stall on each other
+  constexpr size_t num_buckets = size_t{1} << kRadixSelectBits;
+  std::fill(histogram.begin(), histogram.end(), 0u);
+  uint32_t* counts = histogram.data();
+
+  uint32_t nan_bits = 0;
+  int64_t l = 0;
+  for (; l + 4 <= num_blocks; l += 4) {
+    for (int64_t u = 0; u < 4; ++u) {
+      uint32_t bits;
+      memcpy(&bits, row + l + u, sizeof(bits));
+      nan_bits |= static_cast<uint32_t>((bits & 0x7FFFFFFFu) > 0x7F800000u);
+      counts[u * num_buckets + (RadixSelectKey<Comparator::IsGreater>(row[l + u]) >> shift)]++;
+    }
+  }
+  for (; l < num_blocks; ++l) {
+    nan_bits |= static_cast<uint32_t>(std::isnan(row[l]));
+    counts[RadixSelectKey<Comparator::IsGreater>(row[l]) >> shift]++;
+  }
+
+  if (nan_bits != 0) {
+    return false;
+  }
+
+  for (size_t b = 0; b < num_buckets; ++b) {
+    counts[b] += counts[num_buckets + b] + counts[2 * num_buckets + b] + counts[3 * num_buckets + b];
+  }
+
+  // walk down from the best bucket until it holds the k-th best value
+  uint32_t bucket = static_cast<uint32_t>(num_buckets);
+  size_t count = 0;
+  while (count < k) {
+    count += counts[--bucket];
+  }
+
+  size_t num_candidates = 0;
+  for (l = 0; l < num_blocks; ++l) {
+    // write unconditionally to avoid a branch that can't be predicted; it's overwritten if not a candidate
+    data_holder[num_candidates] = row_offset + l;
+    num_candidates += (RadixSelectKey<Comparator::IsGreater>(row[l]) >> shift) >= bucket;
+  }
+
+  auto candidates_end = data_holder.begin() + num_candidates;
+  if (num_candidates > k) {
+    std::nth_element(data_holder.begin(), data_holder.begin() + (k - 1), candidates_end, comparer);
+  }
+
+  if (sort_top_k) {
+    std::sort(data_holder.begin(), data_holder.begin() + k, comparer);
+  }
+
+  return true;
+}
+
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
 // along with the metadata output 'indices'
@@ -296,10 +387,24 @@ static void FindTopKElements(const Tensor* input, const TensorShape& input_shape
           // the call to SelectTopK overwrites any existing data so we don't need to clear on each iteration.
           std::vector<int64_t> data_holder(onnxruntime::narrow<size_t>(num_blocks));
 
+          // long contiguous rows of float values are selected by radix
+          constexpr bool is_float = std::is_same<typename Comparator::DataType, float>::value;
+          const bool use_radix_select = is_float && block_slice == 1 && num_blocks >= kRadixSelectMinBlocks;
+          std::vector<uint32_t> histogram(use_radix_select ? size_t{4} << kRadixSelectBits : 0);
+
           for (auto i = work.start; i < work.end; ++i) {
             auto row_offset = i * cols;
             for (int64_t j = 0; j < block_slice; ++j) {
-              SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              bool selected = false;
+              if constexpr (is_float) {
+                selected = use_radix_select &&
+                           RadixSelectTopK<Comparator>(comparer, input_data, row_offset, num_blocks, k, sorted,
+                                                       histogram, data_holder);
+              }
+
+              if (!selected) {
+                SelectTopK<Comparator>(comparer, row_offset, num_blocks, block_slice, j, k, sorted, data_holder);
+              }
 
               // Insert the top 'k' (largest or smallest) elements into the final output buffers
               for (int64_t l = 0; l < k; ++l) {
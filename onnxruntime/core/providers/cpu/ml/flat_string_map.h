@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace ml {
+
+// Map from strings to values for the fixed vocabularies of the ML kernels, like LabelEncoder and CategoryMapper.
+// The keys are copied one after the other in a single arena and found through an open addressing table of 8 byte
+// slots, which keep the high bits of the hash of their key so most probes of other keys end without touching the arena.
+// The table is built once when the kernel is created and is read only afterwards, so lookups can run concurrently.
+template <typename TValue>
+class FlatStringMap {
+ public:
+  FlatStringMap() = default;
+
+  void reserve(size_t count) {
+    entries_.reserve(count);
+    values_.reserve(count);
+    if (count * 2 > slots_.size()) {
+      Rehash(count * 2);
+    }
+  }
+
+  size_t size() const noexcept { return entries_.size(); }
+
+  // Inserts the key with the value unless the key is already in the map, like std::unordered_map::emplace.
+  // Returns the value of the key and whether it was inserted.
+  std::pair<TValue*, bool> emplace(std::string_view key, TValue value) {
+    const size_t hash = Hash(key);
+    if (const uint32_t index = FindIndex(key, hash); index != kEmpty) {
+      return {&values_[index], false};
+    }
+
+    if ((entries_.size() + 1) * 2 > slots_.size()) {
+      Rehash((entries_.size() + 1) * 2);
+    }
+
+    ORT_ENFORCE(entries_.size() < kEmpty, "Too many keys in FlatStringMap.");
+    const auto index = static_cast<uint32_t>(entries_.size());
+    entries_.push_back({arena_.size(), key.size()});
+    arena_.append(key);
+    values_.push_back(std::move(value));
+    InsertSlot(hash, index);
+    return {&values_[index], true};
+  }
+
+  // Returns the value of the key, or nullptr if the key is not in the map.
+  const TValue* find(std::string_view key) const {
+    const uint32_t index = FindIndex(key, Hash(key));
+    return index == kEmpty ? nullptr : &values_[index];
+  }
+
+ private:
+  static constexpr uint32_t kEmpty = ~uint32_t{0};
+
+  struct Entry {
+    size_t offset;
+    size_t length;
+  };
+
+  struct Slot {
+    uint32_t tag;
+    uint32_t index;
+  };
+
+  static size_t Hash(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+  static uint32_t Tag(size_t hash) { return static_cast<uint32_t>(static_cast<uint64_t>(hash) >> 32); }
+
+  uint32_t FindIndex(std::string_view key, size_t hash) const {
+    if (slots_.empty()) {
+      return kEmpty;
+    }
+
+    const uint32_t tag = Tag(hash);
+    for (size_t s = hash & mask_;; s = (s + 1) & mask_) {
+      const Slot& slot = slots_[s];
+      if (slot.index == kEmpty) {
+        return kEmpty;
+      }
+      if (slot.tag == tag) {
+        const Entry& entry = entries_[slot.index];
+        if (entry.length == key.size() && std::memcmp(arena_.data() + entry.offset, key.data(), key.size()) == 0) {
+          return slot.index;
+        }
+      }
+    }
+  }
+
+  void InsertSlot(size_t hash, uint32_t index) {
+    size_t s = hash & mask_;
+    while (slots_[s].index != kEmpty) {
+      s = (s + 1) & mask_;
+    }
+    slots_[s] = {Tag(hash), index};
+  }
+
+  // Resizes the table to the next power of 2 of at least min_slots slots.
+  void Rehash(size_t min_slots) {
+    size_t slot_count = 16;
+    while (slot_count < min_slots) {
+      slot_count *= 2;
+    }
+
+    slots_.assign(slot_count, Slot{0, kEmpty});
+    mask_ = slot_count - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const Entry& entry = entries_[i];
+      InsertSlot(Hash(std::string_view(arena_.data() + entry.offset, entry.length)), static_cast<uint32_t>(i));
+    }
+  }
+
+  std::string arena_;
+  std::vector<Entry> entries_;
+  std::vector<TValue> values_;
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
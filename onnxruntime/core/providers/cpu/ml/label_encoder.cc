@@ -32,35 +32,25 @@ Status LabelEncoder::Compute(OpKernelContext* context) const {
     if (!Y.IsDataType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(string) must have output of tensor(int64)");
 
-    auto input = gsl::make_span(X.Data<std::string>(), onnxruntime::narrow<size_t>(shape.Size()));
-    auto output = gsl::make_span(Y.MutableData<int64_t>(), onnxruntime::narrow<size_t>(shape.Size()));
-    auto out = output.begin();
-
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
-
-    std::for_each(input.begin(), input.end(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    ParallelLookup(context->GetOperatorThreadPool(), X.Data<std::string>(), Y.MutableData<int64_t>(),
+                   onnxruntime::narrow<std::ptrdiff_t>(shape.Size()),
+                   [this](const std::string& value) {
+                     const int64_t* map_to = string_to_int_map_.find(value);
+                     return map_to == nullptr ? default_int_ : *map_to;
+                   });
   } else {
     if (!Y.IsDataTypeString())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(int64) must have output of tensor(string)");
 
-    auto input = gsl::make_span(X.Data<int64_t>(), onnxruntime::narrow<size_t>(shape.Size()));
-    auto output = gsl::make_span(Y.MutableData<std::string>(), onnxruntime::narrow<size_t>(shape.Size()));
-    auto out = output.begin();
-
+    // map isn't going to change so get end() once instead of calling inside the lookups
     const auto map_end = int_to_string_map_.end();
 
-    std::for_each(input.begin(), input.end(),
-                  [&out, &map_end, this](const int64_t& value) {
-                    auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
-                  });
+    ParallelLookup(context->GetOperatorThreadPool(), X.Data<int64_t>(), Y.MutableData<std::string>(),
+                   onnxruntime::narrow<std::ptrdiff_t>(shape.Size()),
+                   [this, &map_end](int64_t value) -> const std::string& {
+                     auto map_to = int_to_string_map_.find(value);
+                     return map_to == map_end ? default_string_ : map_to->second;
+                   });
   }
 
   return Status::OK();
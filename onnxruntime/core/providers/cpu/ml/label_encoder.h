@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/flat_string_map.h"
 #include "core/providers/cpu/ml/ml_common.h"
 
 namespace onnxruntime {
@@ -28,7 +29,8 @@ class LabelEncoder final : public OpKernel {
     for (size_t i = 0; i < num_entries; ++i) {
       const std::string& str = string_classes[i];
 
-      string_to_int_map_[str] = i;
+      // the last of duplicated classes wins
+      *string_to_int_map_.emplace(str, static_cast<int64_t>(i)).first = static_cast<int64_t>(i);
       int_to_string_map_[i] = str;
     }
   }
@@ -36,8 +38,8 @@ class LabelEncoder final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  FlatStringMap<int64_t> string_to_int_map_;
+  InlinedHashMap<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -75,16 +77,12 @@ class LabelEncoder_2 final : public OpKernel {
     const TensorShape& shape = X.Shape();
     Tensor& Y = *context->Output(0, shape);
 
-    auto input = X.template DataAsSpan<TKey>();
-    auto output = Y.template MutableDataAsSpan<TValue>();
-
-    for (int64_t i = 0; i < shape.Size(); ++i) {
-      const auto found = _map.find(input[onnxruntime::narrow<size_t>(i)]);
-      if (found == _map.end())
-        output[onnxruntime::narrow<size_t>(i)] = _default_value;
-      else
-        output[onnxruntime::narrow<size_t>(i)] = found->second;
-    }
+    ParallelLookup(context->GetOperatorThreadPool(), X.template Data<TKey>(), Y.template MutableData<TValue>(),
+                   onnxruntime::narrow<std::ptrdiff_t>(shape.Size()),
+                   [this](const TKey& key) -> const TValue& {
+                     const TValue* found = Find(key);
+                     return found == nullptr ? _default_value : *found;
+                   });
 
     return Status::OK();
   }
@@ -95,10 +93,20 @@ class LabelEncoder_2 final : public OpKernel {
   // for other types can be found in ONNX spec.
   void InitializeSomeFields(const OpKernelInfo& info);
 
+  const TValue* Find(const TKey& key) const {
+    if constexpr (std::is_same_v<TKey, std::string>) {
+      return _map.find(key);
+    } else {
+      const auto found = _map.find(key);
+      return found == _map.end() ? nullptr : &found->second;
+    }
+  }
+
   // A collection of key-value pairs. Each (a_key, a_value) pair
   // means that the "a_key" in the input would be mapped to "a_value".
   // If _map doesn't contain "a_key", we use _default_value as its output.
-  InlinedHashMap<TKey, TValue> _map;
+  // String keys are kept in a FlatStringMap, which is faster to search for large vocabularies.
+  std::conditional_t<std::is_same_v<TKey, std::string>, FlatStringMap<TValue>, InlinedHashMap<TKey, TValue>> _map;
   TValue _default_value;
   // ONNX attribute name to load keys.
   std::string _key_field_name;
@@ -524,5 +524,21 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+
+// Writes lookup(input[i]) to output[i] for the count elements of a tensor, split across the intra-op threads.
+// The string keys and values of the lookups cost more than their size, so each element is given the cost of a
+// hash, a probe and a copy.
+template <typename TKey, typename TValue, typename Lookup>
+void ParallelLookup(concurrency::ThreadPool* tp, const TKey* input, TValue* output, std::ptrdiff_t count,
+                    const Lookup& lookup) {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, count, TensorOpCost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)), 16.0},
+      [input, output, &lookup](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          output[i] = lookup(input[i]);
+        }
+      });
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
@@ -63,6 +63,7 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    init_support_vectors(support_vectors_, vector_count_, feature_count_);
   } else {
     feature_count_ = coefficients_.size() / class_count_;  // liblinear mode
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -74,6 +75,36 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   ORT_ENFORCE(coefficients_.size() > 0);
   weights_are_all_positive_ = std::all_of(coefficients_.cbegin(), coefficients_.cend(),
                                           [](float value) { return value >= 0.f; });
+
+  // The classifiers of class_count_ classes multiply class_count_ / 2 times more coefficients as a gemm with the
+  // zeros, which still pays off for a few classes.
+  constexpr ptrdiff_t kMaxPairGemmClasses = 8;
+  const ptrdiff_t num_classifiers = class_count_ * (class_count_ - 1) / 2;
+  if (mode_ == SVM_TYPE::SVM_SVC && num_classifiers > 0 && class_count_ <= kMaxPairGemmClasses &&
+      vectors_per_class_.size() == static_cast<size_t>(class_count_) &&
+      rho_.size() >= static_cast<size_t>(num_classifiers) &&
+      coefficients_.size() >= static_cast<size_t>((class_count_ - 1) * vector_count_)) {
+    // the classifier of classes i and j weights the support vectors of i with row j - 1 of the coefficients and
+    // those of j with row i
+    pair_coefficients_.resize(SafeInt<size_t>(num_classifiers) * vector_count_, 0.f);
+    auto copy_class_coefficients = [this](ptrdiff_t row, ptrdiff_t cls, float* pair) {
+      const auto start = narrow<ptrdiff_t>(starting_vector_[narrow<size_t>(cls)]);
+      const auto count = narrow<ptrdiff_t>(vectors_per_class_[narrow<size_t>(cls)]);
+      std::copy_n(coefficients_.data() + row * vector_count_ + start, count, pair + start);
+    };
+    float* cur_pair = pair_coefficients_.data();
+    for (ptrdiff_t i = 0; i < class_count_ - 1; i++) {
+      for (ptrdiff_t j = i + 1; j < class_count_; j++, cur_pair += vector_count_) {
+        copy_class_coefficients(j - 1, i, cur_pair);
+        copy_class_coefficients(i, j, cur_pair);
+      }
+    }
+    packed_pair_coefficients_ = pack_transposed_b(pair_coefficients_.data(), narrow<size_t>(num_classifiers),
+                                                  narrow<size_t>(vector_count_));
+    if (packed_pair_coefficients_) {
+      pair_coefficients_ = {};
+    }
+  }
 }
 
 template <typename LabelType>
@@ -189,7 +220,6 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
   auto final_scores = Z.MutableDataAsSpan<float>();
 
   std::vector<float> kernels_data;
-  std::vector<int64_t> votes_data;
 
   std::vector<float> classifier_scores_data;
   std::vector<float> probsp2_data;
@@ -237,71 +267,88 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     }
 
     kernels_data.resize(num_batches * vector_count_);
-    votes_data.resize(num_batches * class_count_, 0);
 
     auto kernels_span = gsl::make_span<float>(kernels_data.data(), kernels_data.size());
-    auto votes_span = gsl::make_span<int64_t>(votes_data.data(), votes_data.size());
 
     // combine the input data with the support vectors and apply the kernel type
     // output is {num_batches, vector_count_}
-    batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
-                              threadpool);
-
-    for (int64_t n = 0; n < num_batches; n++) {
-      // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
-      // per class.
-      // coefficients: [num_classes - 1, vector_count_]
-      //
-      // e.g. say you have 3 classes, with 3 x 3 coefficients
-      //
-      // AA AB AC
-      // BA BB BC
-      // CA CB CC
-      //
-      // you can remove the diagonal line of items comparing a class with itself leaving one less row.
-      //
-      // BA AB AC
-      // CA CB BC
-      //
-      // for each class there is a coefficient per support vector, and a class has one or more support vectors.
-      //
-      // Combine the scores for the two combinations for two classes with their coefficient.
-      // e.g. AB combines with BA.
-      // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
-
-      auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
-      auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
-      auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
-      auto scores_iter = cur_scores.begin();
-
-      size_t classifier_idx = 0;
-      for (int64_t i = 0; i < class_count_ - 1; i++) {
-        int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
-        int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
-        int64_t i_coeff_row_offset = vector_count_ * i;
-
-        for (int64_t j = i + 1; j < class_count_; j++) {
-          int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
-          int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
-          int64_t j_coeff_row_offset = vector_count_ * (j - 1);
-
-          double sum = 0;
-
-          const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
-          const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
-          val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
-
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          sum += rho_[classifier_idx++];
-
-          *scores_iter++ = static_cast<float>(sum);
-          ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
+    batched_kernel_support_vectors(x_data, num_batches, kernels_span, threadpool);
+
+    if (packed_pair_coefficients_ || !pair_coefficients_.empty()) {
+      // the scores of all the classifiers are one product of the kernels with their coefficients, plus rho
+      MLAS_SGEMM_EPILOGUE epilogue;
+      epilogue.Bias = rho_.data();
+
+      MLAS_SGEMM_DATA_PARAMS data;
+      data.A = kernels_span.data();
+      data.lda = narrow<size_t>(vector_count_);
+      if (packed_pair_coefficients_) {
+        data.B = static_cast<const float*>(packed_pair_coefficients_.get());
+        data.BIsPacked = true;
+      } else {
+        data.B = pair_coefficients_.data();
+        data.ldb = narrow<size_t>(vector_count_);
+      }
+      data.C = classifier_scores.data();
+      data.ldc = narrow<size_t>(num_slots_per_iteration);
+      data.Epilogue = &epilogue;
+      MlasGemmBatch(CblasNoTrans, CblasTrans, narrow<size_t>(num_batches), narrow<size_t>(num_classifiers),
+                    narrow<size_t>(vector_count_), &data, 1, threadpool);
+    } else {
+      for (int64_t n = 0; n < num_batches; n++) {
+        // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
+        // per class.
+        // coefficients: [num_classes - 1, vector_count_]
+        //
+        // e.g. say you have 3 classes, with 3 x 3 coefficients
+        //
+        // AA AB AC
+        // BA BB BC
+        // CA CB CC
+        //
+        // you can remove the diagonal line of items comparing a class with itself leaving one less row.
+        //
+        // BA AB AC
+        // CA CB BC
+        //
+        // for each class there is a coefficient per support vector, and a class has one or more support vectors.
+        //
+        // Combine the scores for the two combinations for two classes with their coefficient.
+        // e.g. AB combines with BA.
+        // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
+
+        auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
+        auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
+        auto scores_iter = cur_scores.begin();
+
+        size_t classifier_idx = 0;
+        for (int64_t i = 0; i < class_count_ - 1; i++) {
+          int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
+          int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
+          int64_t i_coeff_row_offset = vector_count_ * i;
+
+          for (int64_t j = i + 1; j < class_count_; j++) {
+            int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
+            int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
+            int64_t j_coeff_row_offset = vector_count_ * (j - 1);
+
+            double sum = 0;
+
+            const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
+            const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
+            for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
+              sum += *val1 * *val2;
+
+            val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
+            val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
+
+            for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
+              sum += *val1 * *val2;
+
+            sum += rho_[classifier_idx++];
+
+            *scores_iter++ = static_cast<float>(sum);
+          }
         }
       }
     }
@@ -309,7 +356,7 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
 
   auto finalize_batch = [this, &final_scores, final_scores_per_batch,
                          have_proba, &probsp2_data, class_count_squared,
-                         &classifier_scores_data, num_classifiers, &votes_data, &Y,
+                         &classifier_scores_data, num_classifiers, &Y,
                          num_scores_per_batch, write_additional_scores](ptrdiff_t idx) {
     int n = SafeInt<int32_t>(idx);  // convert to a usable sized type
     auto cur_scores = final_scores.subspan(n * SafeInt<size_t>(final_scores_per_batch), onnxruntime::narrow<size_t>(final_scores_per_batch));
@@ -340,8 +387,16 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
 
     float max_weight = 0;
     int64_t maxclass = -1;
-    if (votes_data.size() > 0) {
-      auto votes = gsl::make_span<int64_t>(votes_data.data() + (n * class_count_), onnxruntime::narrow<size_t>(class_count_));
+    if (mode_ == SVM_TYPE::SVM_SVC) {
+      // each classifier votes for the class its score favors
+      const float* classifier_scores = have_proba ? classifier_scores_data.data() + (n * num_classifiers)
+                                                  : final_scores.data() + (n * final_scores_per_batch);
+      InlinedVector<int64_t> votes(onnxruntime::narrow<size_t>(class_count_), 0);
+      for (int64_t i = 0; i < class_count_ - 1; ++i) {
+        for (int64_t j = i + 1; j < class_count_; ++j) {
+          ++votes[onnxruntime::narrow<size_t>(*classifier_scores++ > 0 ? i : j)];
+        }
+      }
       auto it_maxvotes = std::max_element(votes.begin(), votes.end());
       maxclass = std::distance(votes.begin(), it_maxvotes);
     } else {
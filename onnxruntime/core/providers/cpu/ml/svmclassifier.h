@@ -4,7 +4,10 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/framework/allocator.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 #include "core/providers/cpu/math/gemm.h"
@@ -30,6 +33,108 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // Packs b, n rows of k values, as the transposed B of MlasGemm. Returns nullptr if MLAS doesn't pack B.
+  static IAllocatorUniquePtr<void> pack_transposed_b(const float* b, size_t n, size_t k) {
+    const size_t packed_size = MlasGemmPackBSize(n, k);
+    if (packed_size == 0) {
+      return nullptr;
+    }
+    AllocatorPtr alloc = std::make_shared<CPUAllocator>();
+    auto packed_b = IAllocator::MakeUniquePtr<void>(alloc, packed_size, true);
+    memset(packed_b.get(), 0, packed_size);
+    MlasGemmPackB(CblasTrans, n, k, b, k, packed_b.get());
+    return packed_b;
+  }
+
+  // Packs the support vectors, vector_count rows of feature_count values, for batched_kernel_support_vectors.
+  // support_vectors must outlive the kernel.
+  void init_support_vectors(gsl::span<const float> support_vectors, ptrdiff_t vector_count, ptrdiff_t feature_count) {
+    const auto n = narrow<size_t>(vector_count);
+    const auto k = narrow<size_t>(feature_count);
+    support_vectors_data_ = support_vectors.data();
+    support_vector_count_ = vector_count;
+    support_vector_feature_count_ = feature_count;
+
+    packed_support_vectors_ = pack_transposed_b(support_vectors.data(), n, k);
+
+    // the terms of the kernel that only depend on the support vector, added to each column of the products
+    if (kernel_type_ == KERNEL::RBF) {
+      // |x - s|^2 = |x|^2 - 2 x.s + |s|^2, -gamma |s|^2 is added to 2 gamma x.s
+      support_vector_bias_.resize(n);
+      for (size_t v = 0; v < n; ++v) {
+        const float* cur_support_vector = support_vectors.data() + v * k;
+        float sum = 0.f;
+        for (size_t feature = 0; feature < k; ++feature) {
+          sum += cur_support_vector[feature] * cur_support_vector[feature];
+        }
+        support_vector_bias_[v] = -gamma_ * sum;
+      }
+    } else if (kernel_type_ != KERNEL::LINEAR && coef0_ != 0.f) {
+      support_vector_bias_.assign(n, coef0_);
+    }
+  }
+
+  // Computes the kernel between each of the m rows of a and the support vectors given to init_support_vectors as
+  // one gemm followed by the transform of the kernel type, out is {m, vector_count}.
+  void batched_kernel_support_vectors(const gsl::span<const float> a, ptrdiff_t m, const gsl::span<float> out,
+                                      concurrency::ThreadPool* threadpool) const {
+    const auto n = narrow<size_t>(support_vector_count_);
+    const auto k = narrow<size_t>(support_vector_feature_count_);
+    assert(a.size() == size_t(m) * k && out.size() == size_t(m) * n);
+    if (m == 0 || n == 0) {
+      return;
+    }
+
+    MLAS_SGEMM_EPILOGUE epilogue;
+    epilogue.Bias = support_vector_bias_.empty() ? nullptr : support_vector_bias_.data();
+
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.A = a.data();
+    data.lda = k;
+    if (packed_support_vectors_) {
+      data.B = static_cast<const float*>(packed_support_vectors_.get());
+      data.BIsPacked = true;
+    } else {
+      data.B = support_vectors_data_;
+      data.ldb = k;
+    }
+    data.C = out.data();
+    data.ldc = n;
+    data.alpha = kernel_type_ == KERNEL::LINEAR ? 1.f : (kernel_type_ == KERNEL::RBF ? 2.f * gamma_ : gamma_);
+    data.Epilogue = epilogue.Bias != nullptr ? &epilogue : nullptr;
+    MlasGemmBatch(CblasNoTrans, CblasTrans, narrow<size_t>(m), n, k, &data, 1, threadpool);
+
+    if (kernel_type_ == KERNEL::RBF) {
+      concurrency::ThreadPool::TryBatchParallelFor(
+          threadpool, m,
+          [this, &a, &out, n, k](ptrdiff_t row) {
+            const float* cur_input = a.data() + row * k;
+            float sum = 0.f;
+            for (size_t feature = 0; feature < k; ++feature) {
+              sum += cur_input[feature] * cur_input[feature];
+            }
+            // the expansion of |x - s|^2 may round below 0
+            const float row_term = gamma_ * sum;
+            float* cur_out = out.data() + row * n;
+            for (size_t v = 0; v < n; ++v) {
+              cur_out[v] = std::min(cur_out[v] - row_term, 0.f);
+            }
+            MlasComputeExp(cur_out, cur_out, n);
+          },
+          0);
+    } else if (kernel_type_ == KERNEL::POLY) {
+      auto map_out = EigenVectorArrayMap<float>(out.data(), out.size());
+      if (degree_ == 2)
+        map_out = map_out.square();
+      else if (degree_ == 3)
+        map_out = map_out.cube();
+      else
+        map_out = map_out.pow(degree_);
+    } else if (kernel_type_ == KERNEL::SIGMOID) {
+      MlasComputeTanh(out.data(), out.data(), out.size());
+    }
+  }
+
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           ptrdiff_t m, ptrdiff_t n, ptrdiff_t k,
@@ -100,11 +205,21 @@ class SVMCommon {
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
+
+  // set by init_support_vectors
+  const float* support_vectors_data_{nullptr};
+  ptrdiff_t support_vector_count_{0};
+  ptrdiff_t support_vector_feature_count_{0};
+  IAllocatorUniquePtr<void> packed_support_vectors_;
+  std::vector<float> support_vector_bias_;
 };
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
+  using SVMCommon::batched_kernel_support_vectors;
   using SVMCommon::get_kernel_type;
+  using SVMCommon::init_support_vectors;
+  using SVMCommon::pack_transposed_b;
   using SVMCommon::set_kernel_type;
 
  public:
@@ -126,6 +241,11 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  // The coefficients of each classifier comparing a pair of classes over all the support vectors, zero for those of
+  // the other classes: {num_classifiers, vector_count_}, packed for MlasGemm if MLAS packs B, else in
+  // pair_coefficients_. Both are empty if there are too many classes for the zeros to be worth multiplying.
+  std::vector<float> pair_coefficients_;
+  IAllocatorUniquePtr<void> packed_pair_coefficients_;
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
@@ -15,7 +15,9 @@ namespace ml {
 template <typename T>
 class SVMRegressor final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
+  using SVMCommon::batched_kernel_support_vectors;
   using SVMCommon::get_kernel_type;
+  using SVMCommon::init_support_vectors;
   using SVMCommon::set_kernel_type;
 
  public:
@@ -3,9 +3,17 @@
 
 #pragma once
 
+#include <functional>
+#include <type_traits>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "tree_ensemble_aggregator.h"
+#include "core/framework/float16.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "tree_ensemble_helper.h"
 
 namespace onnxruntime {
@@ -34,6 +42,129 @@ class TreeEnsembleCommonAttributes {
   int parallel_N_;       // starts parallelizing the computing by rows if n_rows <= parallel_N_
 };
 
+// The trees of an ensemble compiled into flat arrays, each tree in breadth first order from its root.
+// A leaf is stored inline as a node whose two branches lead back to itself, so a tree is traversed in as many
+// steps as its deepest leaf, with a comparison selecting the next node instead of a branch.
+template <typename ThresholdType>
+struct CompiledTrees {
+  // the comparison of all the nodes
+  NODE_MODE mode;
+  // the feature of each node, complemented (~feature_id) if a missing value follows the true branch of the node
+  std::vector<int32_t> feature_ids;
+  std::vector<ThresholdType> thresholds;
+  // children[2 * i] is the false branch of node i, children[2 * i + 1] the true branch
+  std::vector<int32_t> children;
+  // position of each node in TreeEnsembleCommon::nodes_, read for the leaves
+  std::vector<int32_t> node_positions;
+  // first node of each tree
+  std::vector<int32_t> roots;
+  // number of steps from the root of each tree to its deepest leaf, -1 if the tree isn't compiled
+  std::vector<int32_t> depths;
+};
+
+// The trees of an ensemble laid out for QuickScorer (Lucchese et al., SIGIR 2015).
+// The leaves of a tree are numbered with the leaves of the true branch of every node before those of its false branch.
+// A node taking its false branch rules out the leaves of its true branch, which is a mask ANDed into the bitvector of
+// its tree, and the leaf a row reaches is the first leaf left in the bitvector. The nodes of all the trees are grouped
+// by feature and sorted so that, for any value of the feature, the nodes taking their false branch come first: the
+// nodes of a feature are visited until the first one taking its true branch, without any branch on the tree layout.
+template <typename ThresholdType>
+struct QuickScorerTrees {
+  // the comparison of all the nodes
+  NODE_MODE mode;
+  // the features tested by the nodes, the nodes of features[f] are [feature_offsets[f], feature_offsets[f + 1])
+  std::vector<int64_t> features;
+  std::vector<size_t> feature_offsets;
+  std::vector<ThresholdType> thresholds;
+  std::vector<uint32_t> tree_ids;
+  // bitvector of the leaves the node rules out when it takes its false branch, as zeros
+  std::vector<uint64_t> masks;
+  // 1 if a missing value follows the true branch of the node, empty if no node does
+  std::vector<uint8_t> missing_tracks;
+  // the leaves of tree j are leaf_positions[leaf_offsets[j]] and the next ones, positions in TreeEnsembleCommon::nodes_
+  std::vector<int32_t> leaf_positions;
+  std::vector<size_t> leaf_offsets;
+};
+
+// A node of QuantizedTrees, a third of the size of a TreeNodeElement.
+struct QuantizedTreeNode {
+  static constexpr uint16_t kLeaf = 0xFFFF;
+  static constexpr uint32_t kMissingTrack = 0x80000000;
+
+  // the feature tested by the node, kLeaf for a leaf
+  uint16_t feature;
+  // the rank of the threshold of the node among the distinct thresholds of the feature
+  uint16_t code;
+  // the true branch of the node, ORed with kMissingTrack if a missing value follows it, or the index of the leaf
+  uint32_t next;
+};
+
+// The trees of an ensemble with the thresholds replaced by 16 bit codes and the leaf weights stored in fp16.
+// The features of a row are binned once: the code of a feature is the number of thresholds of the feature on the false
+// side of the comparison for BRANCH_LEQ and BRANCH_LT, on its true side for BRANCH_GTE and BRANCH_GT. A node then
+// compares the code of its feature with the rank of its threshold, which takes the same branch as comparing the values.
+template <typename ThresholdType>
+struct QuantizedTrees {
+  // code of a missing value
+  static constexpr uint16_t kMissing = 0xFFFF;
+
+  // the comparison of all the nodes
+  NODE_MODE mode;
+  // the distinct thresholds of feature f in ascending order are bin_thresholds[bin_offsets[f]] and the next ones,
+  // up to bin_offsets[f + 1]
+  std::vector<ThresholdType> bin_thresholds;
+  std::vector<size_t> bin_offsets;
+  // the nodes in the order of TreeEnsembleCommon::nodes_, the false branch of a node is the next node
+  std::vector<QuantizedTreeNode> nodes;
+  // first node of each tree
+  std::vector<uint32_t> roots;
+  size_t n_leaves{0};
+  // weight k of leaf l targets targets[k] for k in [weight_offsets[l], weight_offsets[l + 1]), empty for 1 target
+  std::vector<size_t> weight_offsets;
+  std::vector<uint32_t> targets;
+  size_t max_leaf_weights{0};
+  // the unique weight of each leaf followed by weight k at n_leaves + k, in fp16 or, if fp16_weights is empty,
+  // in full precision
+  std::vector<MLFloat16> fp16_weights;
+  std::vector<ThresholdType> weights;
+};
+
+// Returns the index of the lowest set bit of a nonzero n.
+inline int LowestSetBit(uint64_t n) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(n);
+#elif defined(_MSC_VER) && defined(_WIN64)
+  unsigned long index;
+  _BitScanForward64(&index, n);
+  return static_cast<int>(index);
+#else
+  int index = 0;
+  while ((n & 1) == 0) {
+    n >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+// The comparison of MlasTreeTraverse for a branch mode.
+inline MLAS_TREE_NODE_MODE ToMlasTreeNodeMode(NODE_MODE mode) {
+  switch (mode) {
+    case NODE_MODE::BRANCH_LT:
+      return MlasTreeNodeLt;
+    case NODE_MODE::BRANCH_GTE:
+      return MlasTreeNodeGte;
+    case NODE_MODE::BRANCH_GT:
+      return MlasTreeNodeGt;
+    case NODE_MODE::BRANCH_EQ:
+      return MlasTreeNodeEq;
+    case NODE_MODE::BRANCH_NEQ:
+      return MlasTreeNodeNeq;
+    default:
+      return MlasTreeNodeLeq;
+  }
+}
+
 // TI: input type
 // TH: tree type (types of the node values and targets)
 // TO: output type, usually float
@@ -47,8 +178,26 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   // `ThresholdType` is used as well for output type (double as well for lightgbm) and not `OutputType`.
   std::vector<SparseValue<ThresholdType>> weights_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
+  // Empty if the nodes have different comparisons.
+  CompiledTrees<ThresholdType> compiled_trees_;
+  // Empty unless the ensemble is evaluated with QuickScorer.
+  QuickScorerTrees<ThresholdType> quick_scorer_trees_;
+  // Empty unless the trees are quantized, nodes_, weights_ and roots_ are then released.
+  QuantizedTrees<ThresholdType> quantized_trees_;
+  // set from the CPU execution provider by Init(info) before the trees are built
+  bool quantize_trees_{false};
+  bool exact_quantization_{false};
 
  public:
+  // Trees deeper than this keep walking nodes_, as the compiled traversal takes as many steps as the deepest leaf
+  // whichever leaf a row reaches.
+  static constexpr int32_t kMaxCompiledTreeDepth = 32;
+  // QuickScorer evaluates ensembles of many shallow trees: each tree must be compiled, so no deeper than
+  // kMaxCompiledTreeDepth, and have at most as many leaves as bits in its bitvector. The comparison must order the
+  // thresholds, so BRANCH_EQ and BRANCH_NEQ are left to the traversal.
+  static constexpr int64_t kQuickScorerMinTrees = 16;
+  static constexpr size_t kQuickScorerMaxLeaves = 64;
+
   TreeEnsembleCommon() {}
 
   virtual Status Init(const OpKernelInfo& info);
@@ -83,6 +232,30 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Returns the leaf of tree j reached by x_data.
+  const TreeNodeElement<ThresholdType>* ProcessTreeLeaf(size_t j, const InputType* x_data) const;
+
+  // Sets leaves[i] to the leaf of tree j reached by row i of the n_rows rows of x_data.
+  void ProcessTreeLeaves(size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+                         const TreeNodeElement<ThresholdType>** leaves) const;
+
+  // Sets leaves[j] to the leaf of every tree j reached by x_data, with QuickScorer. bitvectors holds n_trees_ values.
+  void ProcessQuickScorerLeaves(const InputType* x_data, uint64_t* bitvectors,
+                                const TreeNodeElement<ThresholdType>** leaves) const;
+
+  // Sets codes[f] to the code of feature f of x_data in quantized_trees_.
+  void BinQuantizedFeatures(const InputType* x_data, uint16_t* codes) const;
+
+  // Returns the index of the leaf of quantized tree j reached by the codes of a row.
+  uint32_t ProcessQuantizedTreeLeaf(size_t j, const uint16_t* codes) const;
+
+  // Sets the weights of leaf to those of quantized leaf l, leaf_weights holds max_leaf_weights values.
+  void SetQuantizedLeaf(uint32_t l, TreeNodeElement<ThresholdType>& leaf,
+                        SparseValue<ThresholdType>* leaf_weights) const;
+
+  // Reads the quantization of the trees from the execution provider of the node.
+  void SetQuantizationOptions(const OpKernelInfo& info);
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 
@@ -92,6 +265,43 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
                   const std::vector<ThresholdType>& nodes_values_as_tensor, const std::vector<float>& node_values,
                   const std::vector<int64_t>& nodes_missing_value_tracks_true, std::vector<size_t>& updated_mapping,
                   int64_t tree_id, const InlinedVector<TreeNodeElementId>& node_tree_ids);
+
+  void CompileTrees();
+
+  // Fills quick_scorer_trees_ if the trees are shallow and numerous enough, after CompileTrees.
+  void BuildQuickScorerTrees();
+
+  struct QuickScorerNode {
+    int64_t feature;
+    ThresholdType threshold;
+    uint32_t tree_id;
+    uint64_t mask;
+    uint8_t missing_track;
+  };
+
+  // Appends the leaves of the subtree of node to quick_scorer_trees_.leaf_positions and its nodes to qs_nodes,
+  // returns false if the tree whose first leaf is first_leaf has more than kQuickScorerMaxLeaves leaves.
+  bool AddQuickScorerNodes(const TreeNodeElement<ThresholdType>* node, uint32_t tree_id, size_t first_leaf,
+                           std::vector<QuickScorerNode>& qs_nodes);
+
+  template <typename Compare>
+  void ProcessQuickScorerLeaves(const InputType* x_data, uint64_t* bitvectors,
+                                const TreeNodeElement<ThresholdType>** leaves) const;
+
+  // Fills quantized_trees_ and releases nodes_, weights_ and roots_ if quantize_trees_ is set and the trees allow it.
+  void BuildQuantizedTrees();
+
+  ThresholdType QuantizedWeight(size_t k) const {
+    const auto& qt = quantized_trees_;
+    return qt.fp16_weights.empty() ? qt.weights[k] : static_cast<ThresholdType>(qt.fp16_weights[k].ToFloat());
+  }
+
+  template <typename Compare>
+  void BinQuantizedFeatures(const InputType* x_data, uint16_t* codes) const;
+
+  template <typename Compare>
+  void ProcessCompiledTreeLeaves(size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+                                 const TreeNodeElement<ThresholdType>** leaves) const;
 };
 
 template <typename InputType, typename ThresholdType, typename OutputType>
@@ -105,6 +315,7 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(const OpKe
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "target_weights_as_tensor", target_weights_as_tensor));
 #endif
 
+  SetQuantizationOptions(info);
   return Init(
       80,
       128,
@@ -338,9 +549,298 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(
     }
   }
 
+  BuildQuantizedTrees();
+  if (quantized_trees_.roots.empty()) {
+    CompileTrees();
+    BuildQuickScorerTrees();
+  }
+
   return Status::OK();
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::SetQuantizationOptions(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  if (ep != nullptr && ep->Type() == kCpuExecutionProvider) {
+    const auto& ep_info = static_cast<const CPUExecutionProvider*>(ep)->GetInfo();
+    quantize_trees_ = ep_info.quantize_tree_ensembles;
+    exact_quantization_ = ep_info.tree_ensemble_exact_quantization;
+  }
+}
+
+// Returns the number of steps from node to its deepest leaf, or -1 if it is more than max_depth.
+template <typename ThresholdType>
+int32_t TreeDepth(const TreeNodeElement<ThresholdType>* node, int32_t max_depth,
+                  InlinedHashMap<const TreeNodeElement<ThresholdType>*, int32_t>& depths) {
+  if (!node->is_not_leaf()) {
+    return 0;
+  }
+  // nodes shared by several parents are only visited once
+  auto it = depths.find(node);
+  if (it != depths.end()) {
+    return it->second <= max_depth ? it->second : -1;
+  }
+  if (max_depth == 0) {
+    return -1;
+  }
+  const int32_t false_depth = TreeDepth(node + 1, max_depth - 1, depths);
+  const int32_t true_depth =
+      false_depth < 0 ? -1 : TreeDepth<ThresholdType>(node->truenode_or_weight.ptr, max_depth - 1, depths);
+  if (true_depth < 0) {
+    return -1;
+  }
+  const int32_t depth = 1 + std::max(false_depth, true_depth);
+  depths.emplace(node, depth);
+  return depth;
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::CompileTrees() {
+  compiled_trees_ = {};
+  if (!same_mode_ || nodes_.size() >= static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return;
+  }
+
+  compiled_trees_.mode = NODE_MODE::BRANCH_LEQ;
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      compiled_trees_.mode = node.mode();
+      break;
+    }
+  }
+
+  for (const auto* root : roots_) {
+    InlinedHashMap<const TreeNodeElement<ThresholdType>*, int32_t> depths;
+    const int32_t depth = TreeDepth(root, kMaxCompiledTreeDepth, depths);
+    compiled_trees_.depths.push_back(depth);
+    compiled_trees_.roots.push_back(static_cast<int32_t>(compiled_trees_.feature_ids.size()));
+    if (depth < 0) {
+      continue;
+    }
+
+    // number the nodes in breadth first order
+    const auto first = static_cast<int32_t>(compiled_trees_.feature_ids.size());
+    InlinedHashMap<const TreeNodeElement<ThresholdType>*, int32_t> indices;
+    std::vector<const TreeNodeElement<ThresholdType>*> order{root};
+    indices.emplace(root, first);
+    for (size_t k = 0; k < order.size(); ++k) {
+      const auto* node = order[k];
+      if (node->is_not_leaf()) {
+        for (const auto* child : {node + 1, static_cast<const TreeNodeElement<ThresholdType>*>(
+                                                node->truenode_or_weight.ptr)}) {
+          if (indices.emplace(child, first + static_cast<int32_t>(order.size())).second) {
+            order.push_back(child);
+          }
+        }
+      }
+    }
+
+    for (size_t k = 0; k < order.size(); ++k) {
+      const auto* node = order[k];
+      const int32_t index = first + static_cast<int32_t>(k);
+      const bool is_leaf = !node->is_not_leaf();
+      const bool missing_track = has_missing_tracks_ && !is_leaf && node->is_missing_track_true();
+      compiled_trees_.feature_ids.push_back(is_leaf ? 0 : (missing_track ? ~node->feature_id : node->feature_id));
+      compiled_trees_.thresholds.push_back(is_leaf ? ThresholdType{0} : node->value_or_unique_weight);
+      compiled_trees_.children.push_back(is_leaf ? index : indices[node + 1]);
+      compiled_trees_.children.push_back(is_leaf ? index : indices[node->truenode_or_weight.ptr]);
+      compiled_trees_.node_positions.push_back(static_cast<int32_t>(node - nodes_.data()));
+    }
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+bool TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddQuickScorerNodes(
+    const TreeNodeElement<ThresholdType>* node, uint32_t tree_id, size_t first_leaf,
+    std::vector<QuickScorerNode>& qs_nodes) {
+  auto& leaf_positions = quick_scorer_trees_.leaf_positions;
+  if (!node->is_not_leaf()) {
+    if (leaf_positions.size() - first_leaf == kQuickScorerMaxLeaves) {
+      return false;
+    }
+    leaf_positions.push_back(static_cast<int32_t>(node - nodes_.data()));
+    return true;
+  }
+
+  // the leaves of the true branch come first, [begin, end) in the bitvector
+  const size_t begin = leaf_positions.size() - first_leaf;
+  if (!AddQuickScorerNodes(node->truenode_or_weight.ptr, tree_id, first_leaf, qs_nodes)) {
+    return false;
+  }
+  const size_t end = leaf_positions.size() - first_leaf;
+  const uint64_t below_end = end == kQuickScorerMaxLeaves ? ~uint64_t{0} : (uint64_t{1} << end) - 1;
+  const uint64_t true_leaves = below_end & ~((uint64_t{1} << begin) - 1);
+  qs_nodes.push_back({node->feature_id, node->value_or_unique_weight, tree_id, ~true_leaves,
+                      static_cast<uint8_t>(node->is_missing_track_true() ? 1 : 0)});
+  return AddQuickScorerNodes(node + 1, tree_id, first_leaf, qs_nodes);
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BuildQuickScorerTrees() {
+  quick_scorer_trees_ = {};
+  // the trees must be compiled, which bounds their depth
+  if (n_trees_ < kQuickScorerMinTrees || compiled_trees_.depths.empty() ||
+      roots_.size() >= static_cast<size_t>(std::numeric_limits<uint32_t>::max())) {
+    return;
+  }
+
+  NODE_MODE mode = NODE_MODE::BRANCH_LEQ;
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      mode = node.mode();
+      // NaN thresholds can't be sorted
+      if (std::isnan(node.value_or_unique_weight)) {
+        return;
+      }
+    }
+  }
+  if (mode == NODE_MODE::BRANCH_EQ || mode == NODE_MODE::BRANCH_NEQ) {
+    return;
+  }
+
+  auto& qs = quick_scorer_trees_;
+  qs.mode = mode;
+  std::vector<QuickScorerNode> qs_nodes;
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    qs.leaf_offsets.push_back(qs.leaf_positions.size());
+    if (compiled_trees_.depths[j] < 0 ||
+        !AddQuickScorerNodes(roots_[j], static_cast<uint32_t>(j), qs.leaf_positions.size(), qs_nodes)) {
+      quick_scorer_trees_ = {};
+      return;
+    }
+  }
+  qs.leaf_offsets.push_back(qs.leaf_positions.size());
+
+  // For BRANCH_LEQ and BRANCH_LT, the nodes with the smallest thresholds take their false branch first as the
+  // feature grows, for BRANCH_GTE and BRANCH_GT those with the largest thresholds as it shrinks.
+  const bool ascending = mode == NODE_MODE::BRANCH_LEQ || mode == NODE_MODE::BRANCH_LT;
+  std::stable_sort(qs_nodes.begin(), qs_nodes.end(), [ascending](const QuickScorerNode& a, const QuickScorerNode& b) {
+    if (a.feature != b.feature) {
+      return a.feature < b.feature;
+    }
+    return ascending ? a.threshold < b.threshold : b.threshold < a.threshold;
+  });
+
+  for (size_t k = 0; k < qs_nodes.size(); ++k) {
+    const auto& qs_node = qs_nodes[k];
+    if (qs.features.empty() || qs.features.back() != qs_node.feature) {
+      qs.features.push_back(qs_node.feature);
+      qs.feature_offsets.push_back(k);
+    }
+    qs.thresholds.push_back(qs_node.threshold);
+    qs.tree_ids.push_back(qs_node.tree_id);
+    qs.masks.push_back(qs_node.mask);
+    if (has_missing_tracks_) {
+      qs.missing_tracks.push_back(qs_node.missing_track);
+    }
+  }
+  qs.feature_offsets.push_back(qs_nodes.size());
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BuildQuantizedTrees() {
+  quantized_trees_ = {};
+  if (!quantize_trees_ || !same_mode_ || roots_.empty() || max_feature_id_ >= QuantizedTreeNode::kLeaf ||
+      nodes_.size() >= static_cast<size_t>(QuantizedTreeNode::kMissingTrack)) {
+    return;
+  }
+
+  QuantizedTrees<ThresholdType> qt;
+  qt.mode = NODE_MODE::BRANCH_LEQ;
+  std::vector<std::vector<ThresholdType>> thresholds(onnxruntime::narrow<size_t>(max_feature_id_ + 1));
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      qt.mode = node.mode();
+      // NaN thresholds can't be ranked
+      if (node.feature_id < 0 || std::isnan(node.value_or_unique_weight)) {
+        return;
+      }
+      thresholds[node.feature_id].push_back(node.value_or_unique_weight);
+    }
+  }
+  if (qt.mode == NODE_MODE::BRANCH_EQ || qt.mode == NODE_MODE::BRANCH_NEQ) {
+    return;
+  }
+
+  qt.bin_offsets.push_back(0);
+  for (auto& feature_thresholds : thresholds) {
+    std::sort(feature_thresholds.begin(), feature_thresholds.end());
+    feature_thresholds.erase(std::unique(feature_thresholds.begin(), feature_thresholds.end()),
+                             feature_thresholds.end());
+    // the codes go from 0 to the number of thresholds, kMissing excluded
+    if (feature_thresholds.size() >= QuantizedTrees<ThresholdType>::kMissing) {
+      return;
+    }
+    qt.bin_thresholds.insert(qt.bin_thresholds.end(), feature_thresholds.begin(), feature_thresholds.end());
+    qt.bin_offsets.push_back(qt.bin_thresholds.size());
+  }
+
+  std::vector<ThresholdType> weights, target_weights;
+  const bool single_target = n_targets_or_classes_ == 1;
+  if (!single_target) {
+    qt.weight_offsets.push_back(0);
+  }
+  qt.nodes.reserve(nodes_.size());
+  for (const auto& node : nodes_) {
+    if (node.is_not_leaf()) {
+      const auto& feature_thresholds = thresholds[node.feature_id];
+      const auto code = std::lower_bound(feature_thresholds.begin(), feature_thresholds.end(),
+                                         node.value_or_unique_weight) -
+                        feature_thresholds.begin();
+      const bool missing_track = has_missing_tracks_ && node.is_missing_track_true();
+      qt.nodes.push_back({static_cast<uint16_t>(node.feature_id), static_cast<uint16_t>(code),
+                          static_cast<uint32_t>(node.truenode_or_weight.ptr - nodes_.data()) |
+                              (missing_track ? QuantizedTreeNode::kMissingTrack : 0)});
+      continue;
+    }
+
+    qt.nodes.push_back({QuantizedTreeNode::kLeaf, 0, static_cast<uint32_t>(weights.size())});
+    weights.push_back(node.value_or_unique_weight);
+    if (!single_target) {
+      const auto& weight_data = node.truenode_or_weight.weight_data;
+      for (int32_t k = 0; k < weight_data.n_weights; ++k) {
+        const auto& w = weights_[static_cast<size_t>(weight_data.weight) + k];
+        if (w.i < 0 || w.i >= std::numeric_limits<uint32_t>::max()) {
+          return;
+        }
+        qt.targets.push_back(static_cast<uint32_t>(w.i));
+        target_weights.push_back(w.value);
+      }
+      qt.weight_offsets.push_back(qt.targets.size());
+      qt.max_leaf_weights = std::max(qt.max_leaf_weights, static_cast<size_t>(weight_data.n_weights));
+    }
+  }
+  for (const auto* root : roots_) {
+    qt.roots.push_back(static_cast<uint32_t>(root - nodes_.data()));
+  }
+  qt.n_leaves = weights.size();
+  weights.insert(weights.end(), target_weights.begin(), target_weights.end());
+
+  bool fp16 = true;
+  if (exact_quantization_) {
+    for (const auto w : weights) {
+      if (static_cast<ThresholdType>(MLFloat16(static_cast<float>(w)).ToFloat()) != w) {
+        fp16 = false;
+        break;
+      }
+    }
+  }
+  if (fp16) {
+    qt.fp16_weights.reserve(weights.size());
+    for (const auto w : weights) {
+      qt.fp16_weights.push_back(MLFloat16(static_cast<float>(w)));
+    }
+  } else {
+    qt.weights = std::move(weights);
+  }
+
+  quantized_trees_ = std::move(qt);
+  // the trees are only evaluated from quantized_trees_ from now on
+  nodes_ = {};
+  weights_ = {};
+  roots_ = {};
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 size_t TreeEnsembleCommon<InputType, ThresholdType, OutputType>::AddNodes(
     const size_t i, const InlinedVector<NODE_MODE>& cmodes, const InlinedVector<size_t>& truenode_ids,
@@ -406,28 +906,28 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::compute(OpKerne
       ComputeAgg(
           ctx->GetOperatorThreadPool(), X, Y, label,
           TreeAggregatorAverage<InputType, ThresholdType, OutputType>(
-              roots_.size(), n_targets_or_classes_,
+              onnxruntime::narrow<size_t>(n_trees_), n_targets_or_classes_,
               post_transform_, base_values_));
       return Status::OK();
     case AGGREGATE_FUNCTION::SUM:
       ComputeAgg(
           ctx->GetOperatorThreadPool(), X, Y, label,
           TreeAggregatorSum<InputType, ThresholdType, OutputType>(
-              roots_.size(), n_targets_or_classes_,
+              onnxruntime::narrow<size_t>(n_trees_), n_targets_or_classes_,
               post_transform_, base_values_));
       return Status::OK();
     case AGGREGATE_FUNCTION::MIN:
       ComputeAgg(
           ctx->GetOperatorThreadPool(), X, Y, label,
           TreeAggregatorMin<InputType, ThresholdType, OutputType>(
-              roots_.size(), n_targets_or_classes_,
+              onnxruntime::narrow<size_t>(n_trees_), n_targets_or_classes_,
               post_transform_, base_values_));
       return Status::OK();
     case AGGREGATE_FUNCTION::MAX:
       ComputeAgg(
           ctx->GetOperatorThreadPool(), X, Y, label,
           TreeAggregatorMax<InputType, ThresholdType, OutputType>(
-              roots_.size(), n_targets_or_classes_,
+              onnxruntime::narrow<size_t>(n_trees_), n_targets_or_classes_,
               post_transform_, base_values_));
       return Status::OK();
     default:
@@ -455,12 +955,84 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
   int64_t* label_data = label == nullptr ? nullptr : label->MutableData<int64_t>();
   auto max_num_threads = concurrency::ThreadPool::DegreeOfParallelism(ttp);
 
+  if (!quantized_trees_.roots.empty()) { /* section Z: quantized trees, parallelization by rows */
+    auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        ttp,
+        num_threads,
+        [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+          const auto& qt = quantized_trees_;
+          std::vector<uint16_t> codes(qt.bin_offsets.size() - 1);
+          std::vector<SparseValue<ThresholdType>> leaf_weights(qt.max_leaf_weights);
+          TreeNodeElement<ThresholdType> leaf{};
+          leaf.flags = static_cast<uint8_t>(NODE_MODE::LEAF);
+          InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
+          auto work = concurrency::ThreadPool::PartitionWork(batch_num, onnxruntime::narrow<ptrdiff_t>(num_threads),
+                                                             onnxruntime::narrow<ptrdiff_t>(N));
+
+          for (auto i = work.start; i < work.end; ++i) {
+            BinQuantizedFeatures(x_data + i * stride, codes.data());
+            if (n_targets_or_classes_ == 1) {
+              ScoreValue<ThresholdType> score = {0, 0};
+              for (size_t j = 0; j < qt.roots.size(); ++j) {
+                SetQuantizedLeaf(ProcessQuantizedTreeLeaf(j, codes.data()), leaf, leaf_weights.data());
+                agg.ProcessTreeNodePrediction1(score, leaf);
+              }
+              agg.FinalizeScores1(z_data + i, score, label_data == nullptr ? nullptr : (label_data + i));
+            } else {
+              std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
+              for (size_t j = 0; j < qt.roots.size(); ++j) {
+                SetQuantizedLeaf(ProcessQuantizedTreeLeaf(j, codes.data()), leaf, leaf_weights.data());
+                agg.ProcessTreeNodePrediction(scores, leaf, leaf_weights);
+              }
+              agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
+                                 label_data == nullptr ? nullptr : (label_data + i));
+            }
+          }
+        });
+    return;
+  }
+
+  if (!quick_scorer_trees_.leaf_offsets.empty()) { /* section Q: QuickScorer, parallelization by rows */
+    auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(N));
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        ttp,
+        num_threads,
+        [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
+          const auto n_trees = onnxruntime::narrow<size_t>(n_trees_);
+          std::vector<uint64_t> bitvectors(n_trees);
+          std::vector<const TreeNodeElement<ThresholdType>*> leaves(n_trees);
+          InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
+          auto work = concurrency::ThreadPool::PartitionWork(batch_num, onnxruntime::narrow<ptrdiff_t>(num_threads),
+                                                             onnxruntime::narrow<ptrdiff_t>(N));
+
+          for (auto i = work.start; i < work.end; ++i) {
+            ProcessQuickScorerLeaves(x_data + i * stride, bitvectors.data(), leaves.data());
+            if (n_targets_or_classes_ == 1) {
+              ScoreValue<ThresholdType> score = {0, 0};
+              for (const auto* leaf : leaves) {
+                agg.ProcessTreeNodePrediction1(score, *leaf);
+              }
+              agg.FinalizeScores1(z_data + i, score, label_data == nullptr ? nullptr : (label_data + i));
+            } else {
+              std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
+              for (const auto* leaf : leaves) {
+                agg.ProcessTreeNodePrediction(scores, *leaf, weights_);
+              }
+              agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
+                                 label_data == nullptr ? nullptr : (label_data + i));
+            }
+          }
+        });
+    return;
+  }
+
   if (n_targets_or_classes_ == 1) {
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A: 1 output, 1 row and not enough trees to parallelize */
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
+          agg.ProcessTreeNodePrediction1(score, *ProcessTreeLeaf(onnxruntime::narrow<size_t>(j), x_data));
         }
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_trees_), {0, 0});
@@ -468,7 +1040,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             ttp,
             SafeInt<int32_t>(n_trees_),
             [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeLeaf(j, x_data));
             },
             max_num_threads);
 
@@ -489,6 +1061,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       // split into batch so that every batch holds on caches, then loop on trees and finally loop
       // on the batch rows.
       std::vector<ScoreValue<ThresholdType>> scores(parallel_tree_N_);
+      std::vector<const TreeNodeElement<ThresholdType>*> leaves(parallel_tree_N_);
       size_t j;
       int64_t i, batch, batch_end;
 
@@ -498,8 +1071,9 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           scores[SafeInt<ptrdiff_t>(i - batch)] = {0, 0};
         }
         for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+          ProcessTreeLeaves(j, x_data + batch * stride, stride, batch_end - batch, leaves.data());
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            agg.ProcessTreeNodePrediction1(scores[SafeInt<ptrdiff_t>(i - batch)], *leaves[SafeInt<ptrdiff_t>(i - batch)]);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -518,13 +1092,15 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, begin_n, end_n, stride](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              std::vector<const TreeNodeElement<ThresholdType>*> leaves(onnxruntime::narrow<size_t>(end_n - begin_n));
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
               }
               for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeLeaves(j, x_data + begin_n * stride, stride, end_n - begin_n, leaves.data());
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                 *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+                                                 *leaves[onnxruntime::narrow<size_t>(i - begin_n)]);
                 }
               }
             });
@@ -550,7 +1126,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
             ScoreValue<ThresholdType> score = {0, 0};
             for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              agg.ProcessTreeNodePrediction1(score, *ProcessTreeLeaf(j, x_data + i * stride));
             }
 
             agg.FinalizeScores1(z_data + i, score,
@@ -563,7 +1139,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       if (n_trees_ <= parallel_tree_ || max_num_threads == 1) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data), weights_);
+          agg.ProcessTreeNodePrediction(scores, *ProcessTreeLeaf(onnxruntime::narrow<size_t>(j), x_data), weights_);
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -576,7 +1152,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
               scores[batch_num].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(n_trees_));
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data), weights_);
+                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeLeaf(j, x_data), weights_);
               }
             });
         for (size_t i = 1, limit = scores.size(); i < limit; ++i) {
@@ -586,6 +1162,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
     } else if (N <= parallel_N_ || max_num_threads == 1) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
       std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(parallel_tree_N_);
+      std::vector<const TreeNodeElement<ThresholdType>*> leaves(parallel_tree_N_);
       size_t j, limit;
       int64_t i, batch, batch_end;
       batch_end = std::min(N, static_cast<int64_t>(parallel_tree_N_));
@@ -598,8 +1175,9 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           std::fill(scores[SafeInt<ptrdiff_t>(i - batch)].begin(), scores[SafeInt<ptrdiff_t>(i - batch)].end(), ScoreValue<ThresholdType>({0, 0}));
         }
         for (j = 0, limit = roots_.size(); j < limit; ++j) {
+          ProcessTreeLeaves(j, x_data + batch * stride, stride, batch_end - batch, leaves.data());
           for (i = batch; i < batch_end; ++i) {
-            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+            agg.ProcessTreeNodePrediction(scores[SafeInt<ptrdiff_t>(i - batch)], *leaves[SafeInt<ptrdiff_t>(i - batch)], weights_);
           }
         }
         for (i = batch; i < batch_end; ++i) {
@@ -619,13 +1197,15 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             num_threads,
             [this, &agg, &scores, num_threads, x_data, N, stride, begin_n, end_n](ptrdiff_t batch_num) {
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(this->n_trees_));
+              std::vector<const TreeNodeElement<ThresholdType>*> leaves(onnxruntime::narrow<size_t>(end_n - begin_n));
               for (int64_t i = begin_n; i < end_n; ++i) {
                 scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               }
               for (auto j = work.start; j < work.end; ++j) {
+                ProcessTreeLeaves(j, x_data + begin_n * stride, stride, end_n - begin_n, leaves.data());
                 for (int64_t i = begin_n; i < end_n; ++i) {
                   agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                                *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                                                *leaves[onnxruntime::narrow<size_t>(i - begin_n)], weights_);
                 }
               }
             });
@@ -657,7 +1237,7 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (auto i = work.start; i < work.end; ++i) {
               std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
               for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride), weights_);
+                agg.ProcessTreeNodePrediction(scores, *ProcessTreeLeaf(j, x_data + i * stride), weights_);
               }
 
               agg.FinalizeScores(scores,
@@ -767,6 +1347,245 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+const TreeNodeElement<ThresholdType>*
+TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeLeaf(size_t j, const InputType* x_data) const {
+  const TreeNodeElement<ThresholdType>* leaf;
+  ProcessTreeLeaves(j, x_data, 0, 1, &leaf);
+  return leaf;
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeLeaves(
+    size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  if (compiled_trees_.depths.empty() || compiled_trees_.depths[j] < 0) {
+    for (int64_t i = 0; i < n_rows; ++i) {
+      leaves[i] = ProcessTreeNodeLeave(roots_[j], x_data + i * stride);
+    }
+    return;
+  }
+
+  if constexpr (std::is_same_v<InputType, float> && std::is_same_v<ThresholdType, float>) {
+    // MLAS walks 8 or 16 rows in lockstep with vector gathers where the processor has them.
+    const MLAS_TREE_NODE_MODE mode = ToMlasTreeNodeMode(compiled_trees_.mode);
+    const int32_t root = compiled_trees_.roots[j];
+    const auto depth = static_cast<size_t>(compiled_trees_.depths[j]);
+    constexpr int64_t kRowBlock = 128;
+    int32_t nodes[kRowBlock];
+    for (int64_t i = 0; i < n_rows; i += kRowBlock) {
+      const int64_t block_rows = std::min(kRowBlock, n_rows - i);
+      MlasTreeTraverse(mode, compiled_trees_.feature_ids.data(), compiled_trees_.thresholds.data(),
+                       compiled_trees_.children.data(), root, depth, x_data + i * stride,
+                       static_cast<size_t>(stride), static_cast<size_t>(block_rows), nodes);
+      for (int64_t r = 0; r < block_rows; ++r) {
+        leaves[i + r] = &nodes_[compiled_trees_.node_positions[nodes[r]]];
+      }
+    }
+    return;
+  }
+
+  switch (compiled_trees_.mode) {
+    case NODE_MODE::BRANCH_LEQ:
+      ProcessCompiledTreeLeaves<std::less_equal<>>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_LT:
+      ProcessCompiledTreeLeaves<std::less<>>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      ProcessCompiledTreeLeaves<std::greater_equal<>>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_GT:
+      ProcessCompiledTreeLeaves<std::greater<>>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      ProcessCompiledTreeLeaves<std::equal_to<>>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      ProcessCompiledTreeLeaves<std::not_equal_to<>>(j, x_data, stride, n_rows, leaves);
+      break;
+    case NODE_MODE::LEAF:
+      break;
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Compare>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessCompiledTreeLeaves(
+    size_t j, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  const Compare compare;
+  const int32_t root = compiled_trees_.roots[j];
+  const int32_t depth = compiled_trees_.depths[j];
+  const int32_t* feature_ids = compiled_trees_.feature_ids.data();
+  const ThresholdType* thresholds = compiled_trees_.thresholds.data();
+  const int32_t* children = compiled_trees_.children.data();
+
+  auto next_node = [&](int32_t node, const InputType* x) {
+    const int32_t missing_track = feature_ids[node] >> 31;
+    const InputType val = x[feature_ids[node] ^ missing_track];
+    const int32_t is_true =
+        static_cast<int32_t>(compare(val, thresholds[node])) | (missing_track & static_cast<int32_t>(_isnan_(val)));
+    return children[2 * node + is_true];
+  };
+
+  // The rows are traversed a few at a time so that the loads of one row overlap those of the others.
+  constexpr int64_t kRows = 4;
+  int64_t i = 0;
+  for (; i + kRows <= n_rows; i += kRows) {
+    int32_t nodes[kRows] = {root, root, root, root};
+    for (int32_t d = 0; d < depth; ++d) {
+      for (int64_t r = 0; r < kRows; ++r) {
+        nodes[r] = next_node(nodes[r], x_data + (i + r) * stride);
+      }
+    }
+    for (int64_t r = 0; r < kRows; ++r) {
+      leaves[i + r] = &nodes_[compiled_trees_.node_positions[nodes[r]]];
+    }
+  }
+  for (; i < n_rows; ++i) {
+    int32_t node = root;
+    for (int32_t d = 0; d < depth; ++d) {
+      node = next_node(node, x_data + i * stride);
+    }
+    leaves[i] = &nodes_[compiled_trees_.node_positions[node]];
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessQuickScorerLeaves(
+    const InputType* x_data, uint64_t* bitvectors, const TreeNodeElement<ThresholdType>** leaves) const {
+  switch (quick_scorer_trees_.mode) {
+    case NODE_MODE::BRANCH_LEQ:
+      ProcessQuickScorerLeaves<std::less_equal<>>(x_data, bitvectors, leaves);
+      break;
+    case NODE_MODE::BRANCH_LT:
+      ProcessQuickScorerLeaves<std::less<>>(x_data, bitvectors, leaves);
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      ProcessQuickScorerLeaves<std::greater_equal<>>(x_data, bitvectors, leaves);
+      break;
+    case NODE_MODE::BRANCH_GT:
+      ProcessQuickScorerLeaves<std::greater<>>(x_data, bitvectors, leaves);
+      break;
+    default:
+      break;
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Compare>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessQuickScorerLeaves(
+    const InputType* x_data, uint64_t* bitvectors, const TreeNodeElement<ThresholdType>** leaves) const {
+  const Compare compare;
+  const auto& qs = quick_scorer_trees_;
+  const size_t n_trees = qs.leaf_offsets.size() - 1;
+  std::fill_n(bitvectors, n_trees, ~uint64_t{0});
+
+  for (size_t f = 0; f < qs.features.size(); ++f) {
+    const InputType val = x_data[qs.features[f]];
+    size_t k = qs.feature_offsets[f];
+    const size_t end = qs.feature_offsets[f + 1];
+    if (_isnan_(val)) {
+      // a missing value takes the false branch of every node but those tracking it to the true branch
+      for (; k < end; ++k) {
+        if (qs.missing_tracks.empty() || !qs.missing_tracks[k]) {
+          bitvectors[qs.tree_ids[k]] &= qs.masks[k];
+        }
+      }
+      continue;
+    }
+    for (; k < end && !compare(val, qs.thresholds[k]); ++k) {
+      bitvectors[qs.tree_ids[k]] &= qs.masks[k];
+    }
+  }
+
+  for (size_t j = 0; j < n_trees; ++j) {
+    leaves[j] = &nodes_[qs.leaf_positions[qs.leaf_offsets[j] + LowestSetBit(bitvectors[j])]];
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BinQuantizedFeatures(const InputType* x_data,
+                                                                                    uint16_t* codes) const {
+  switch (quantized_trees_.mode) {
+    case NODE_MODE::BRANCH_LEQ:
+      BinQuantizedFeatures<std::less_equal<>>(x_data, codes);
+      break;
+    case NODE_MODE::BRANCH_LT:
+      BinQuantizedFeatures<std::less<>>(x_data, codes);
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      BinQuantizedFeatures<std::greater_equal<>>(x_data, codes);
+      break;
+    case NODE_MODE::BRANCH_GT:
+      BinQuantizedFeatures<std::greater<>>(x_data, codes);
+      break;
+    default:
+      break;
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <typename Compare>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::BinQuantizedFeatures(const InputType* x_data,
+                                                                                    uint16_t* codes) const {
+  const Compare compare;
+  const auto& qt = quantized_trees_;
+  // The comparison with the sorted thresholds is false then true for BRANCH_LEQ and BRANCH_LT, true then false for
+  // BRANCH_GTE and BRANCH_GT.
+  const bool ascending = qt.mode == NODE_MODE::BRANCH_LEQ || qt.mode == NODE_MODE::BRANCH_LT;
+  for (size_t f = 0; f + 1 < qt.bin_offsets.size(); ++f) {
+    const ThresholdType* begin = qt.bin_thresholds.data() + qt.bin_offsets[f];
+    const ThresholdType* end = qt.bin_thresholds.data() + qt.bin_offsets[f + 1];
+    if (begin == end) {
+      continue;
+    }
+    const InputType val = x_data[f];
+    if (_isnan_(val)) {
+      codes[f] = QuantizedTrees<ThresholdType>::kMissing;
+      continue;
+    }
+    const ThresholdType* bin =
+        std::partition_point(begin, end, [&](ThresholdType threshold) { return compare(val, threshold) != ascending; });
+    codes[f] = static_cast<uint16_t>(bin - begin);
+  }
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+uint32_t TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessQuantizedTreeLeaf(
+    size_t j, const uint16_t* codes) const {
+  const auto& qt = quantized_trees_;
+  const bool ascending = qt.mode == NODE_MODE::BRANCH_LEQ || qt.mode == NODE_MODE::BRANCH_LT;
+  const QuantizedTreeNode* nodes = qt.nodes.data();
+  const QuantizedTreeNode* node = nodes + qt.roots[j];
+  while (node->feature != QuantizedTreeNode::kLeaf) {
+    const uint16_t code = codes[node->feature];
+    const bool is_true = code == QuantizedTrees<ThresholdType>::kMissing
+                             ? (node->next & QuantizedTreeNode::kMissingTrack) != 0
+                             : (code <= node->code) == ascending;
+    node = is_true ? nodes + (node->next & ~QuantizedTreeNode::kMissingTrack) : node + 1;
+  }
+  return node->next;
+}
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::SetQuantizedLeaf(
+    uint32_t l, TreeNodeElement<ThresholdType>& leaf, SparseValue<ThresholdType>* leaf_weights) const {
+  const auto& qt = quantized_trees_;
+  leaf.value_or_unique_weight = QuantizedWeight(l);
+  if (qt.weight_offsets.empty()) {
+    return;
+  }
+  const size_t begin = qt.weight_offsets[l];
+  const size_t end = qt.weight_offsets[l + 1];
+  for (size_t k = begin; k < end; ++k) {
+    leaf_weights[k - begin] = {static_cast<int64_t>(qt.targets[k]), QuantizedWeight(qt.n_leaves + k)};
+  }
+  leaf.truenode_or_weight.weight_data.weight = 0;
+  leaf.truenode_or_weight.weight_data.n_weights = static_cast<int32_t>(end - begin);
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
@@ -821,6 +1640,7 @@ Status TreeEnsembleCommonClassifier<InputType, ThresholdType, OutputType>::Init(
   ORT_THROW_IF_ERROR(GetVectorAttrsOrDefault(info, "class_weights_as_tensor", class_weights_as_tensor));
 #endif
 
+  this->SetQuantizationOptions(info);
   return Init(
       80,
       128,
@@ -933,7 +1753,7 @@ Status TreeEnsembleCommonClassifier<InputType, ThresholdType, OutputType>::compu
     this->ComputeAgg(
         ctx->GetOperatorThreadPool(), X, Z, label,
         TreeAggregatorClassifier<InputType, ThresholdType, OutputType>(
-            this->roots_.size(), this->n_targets_or_classes_,
+            onnxruntime::narrow<size_t>(this->n_trees_), this->n_targets_or_classes_,
             this->post_transform_, this->base_values_,
             classlabels_int64s_, binary_case_,
             weights_are_all_positive_));
@@ -945,7 +1765,7 @@ Status TreeEnsembleCommonClassifier<InputType, ThresholdType, OutputType>::compu
     this->ComputeAgg(
         ctx->GetOperatorThreadPool(), X, Z, &label_int64,
         TreeAggregatorClassifier<InputType, ThresholdType, OutputType>(
-            this->roots_.size(), this->n_targets_or_classes_,
+            onnxruntime::narrow<size_t>(this->n_trees_), this->n_targets_or_classes_,
             this->post_transform_, this->base_values_,
             class_labels_, binary_case_,
             weights_are_all_positive_));
@@ -17,8 +17,12 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <algorithm>
+
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -153,6 +157,57 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+bool Conv<float>::ConvUseWinograd(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  return ep->Type() == kCpuExecutionProvider &&
+         static_cast<const CPUExecutionProvider*>(ep)->GetInfo().enable_winograd_conv;
+}
+
+bool Conv<float>::ConvUseBf16(const OpKernelInfo& info) {
+  const auto* ep = info.GetExecutionProvider();
+  return ep->Type() == kCpuExecutionProvider &&
+         static_cast<const CPUExecutionProvider*>(ep)->GetInfo().enable_bf16_mixed_precision &&
+         MlasBf16GemmSupported();
+}
+
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+
+  // MlasConvPrepare picks the Winograd algorithm for the 2D convolutions with a 3x3 filter and unit strides and
+  // dilations if it is given the packed filter.
+  if (input_idx != 1 || !use_winograd_) {
+    return Status::OK();
+  }
+
+  const auto& shape = tensor.Shape();
+  if (shape.NumDimensions() != 4 || shape[2] != 3 || shape[3] != 3 || conv_attrs_.group <= 0 ||
+      shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+  auto is_one = [](int64_t value) { return value == 1; };
+  if (!std::all_of(conv_attrs_.strides.begin(), conv_attrs_.strides.end(), is_one) ||
+      !std::all_of(conv_attrs_.dilations.begin(), conv_attrs_.dilations.end(), is_one)) {
+    return Status::OK();
+  }
+
+  const size_t group_count = narrow<size_t>(conv_attrs_.group);
+  const size_t filter_count = narrow<size_t>(shape[0] / conv_attrs_.group);
+  const size_t input_channels = narrow<size_t>(shape[1]);
+
+  // The size is zero if there are too few channels for the Winograd algorithm.
+  const size_t packed_w_size = MlasConvWinogradPackWSize(group_count, filter_count, input_channels);
+  if (packed_w_size == 0) {
+    return Status::OK();
+  }
+
+  winograd_packed_w_ = IAllocator::MakeUniquePtr<void>(alloc, packed_w_size, true);
+  MlasConvWinogradPackW(group_count, filter_count, input_channels, tensor.Data<float>(), winograd_packed_w_.get());
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
@@ -213,7 +268,70 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const size_t kernel_rank = kernel_shape.size();
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
-  if (kernel_rank >= 1 && kernel_rank <= 3) {
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+  const size_t gemm_m = narrow<size_t>(M / group_count);
+  const size_t gemm_n = narrow<size_t>(output_shape.Size());
+  const size_t gemm_k = narrow<size_t>(SafeInt<int64_t>(C) / group_count * kernel_size);
+  // the column buffer is converted to bfloat16 for each image, which pays off for enough filters of enough weights
+  const size_t bf16_packed_col_size = use_bf16_gemm_ && gemm_m >= kBf16GemmMinRows && gemm_k >= kBf16GemmMinRows
+                                          ? MlasBf16GemmPackBSize(gemm_n, gemm_k)
+                                          : 0;
+
+  if (bf16_packed_col_size != 0) {
+    const int64_t input_image_size = input_shape.Size();
+    const SafeInt<int64_t> X_offset = SafeInt<int64_t>(C) / group_count * input_image_size;
+    const SafeInt<int64_t> Y_offset = SafeInt<int64_t>(gemm_m) * gemm_n;
+    const SafeInt<int64_t> W_offset = SafeInt<int64_t>(W->Shape().Size()) / group_count;
+
+    // a pointwise convolution reads the input image as its column buffer
+    auto is_one = [](int64_t value) { return value == 1; };
+    const bool is_pointwise = kernel_size == 1 && std::all_of(strides.begin(), strides.end(), is_one) &&
+                              std::all_of(pads.begin(), pads.end(), [](int64_t pad) { return pad == 0; });
+
+    auto col_data = is_pointwise ? IAllocatorUniquePtr<float>{}
+                                 : IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(gemm_k) * gemm_n);
+    auto packed_col_data = IAllocator::MakeUniquePtr<uint8_t>(alloc,
+                                                              SafeInt<size_t>(bf16_packed_col_size) * group_count);
+    std::vector<MLAS_BF16_GEMM_DATA_PARAMS> gemm_params(narrow<size_t>(group_count));
+    const auto* w_data = W->Data<float>();
+    for (int64_t image_id = 0; image_id < N; ++image_id) {
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        const float* col = &Xdata[group_id * X_offset];
+        if (!is_pointwise) {
+          math::Im2col<float, StorageOrder::NCHW>()(
+              col,
+              input_shape.GetDims().data(),
+              output_shape.GetDims().data(),
+              narrow<int64_t>(gemm_k),
+              kernel_shape.data(),
+              strides.data(),
+              dilations.data(),
+              pads.data(),
+              narrow<int>(kernel_rank),
+              col_data.get());
+          col = col_data.get();
+        }
+
+        void* packed_col = packed_col_data.get() + group_id * bf16_packed_col_size;
+        MlasBf16GemmConvertPackB(CblasNoTrans, gemm_n, gemm_k, col, gemm_n, packed_col);
+
+        auto& params = gemm_params[narrow<size_t>(group_id)];
+        params.A = w_data + group_id * W_offset;
+        params.lda = gemm_k;
+        params.B = packed_col;
+        params.C = &Ydata[group_id * Y_offset];
+        params.ldc = gemm_n;
+        params.ZeroMode = Beta == 0.0f;
+      }
+      MlasBf16GemmBatch(gemm_m, gemm_n, gemm_k, gemm_params.size(), gemm_params.data(), thread_pool);
+
+      MlasActivation(&activation_, Ydata.data(), Bdata, narrow<size_t>(M), gemm_n, gemm_n);
+
+      Xdata = Xdata.subspan(X_offset * group_count);
+      Ydata = Ydata.subspan(Y_offset * group_count);
+    }
+  } else if (kernel_rank >= 1 && kernel_rank <= 3) {
     MLAS_CONV_PARAMETERS Parameters;
     size_t WorkingBufferSize;
     MlasConvPrepare(&Parameters,
@@ -231,7 +349,8 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     &activation_,
                     &WorkingBufferSize,
                     Beta,
-                    thread_pool);
+                    thread_pool,
+                    kernel_rank == 2 ? winograd_packed_w_.get() : nullptr);
 
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
@@ -247,7 +366,6 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   } else {
     const int64_t input_image_size = input_shape.Size();
     const int64_t output_image_size = output_shape.Size();
-    const int64_t kernel_size = TensorShape(kernel_shape).Size();
     const SafeInt<int64_t> X_offset = SafeInt<int64_t>(C) / conv_attrs_.group * input_image_size;
     const SafeInt<int64_t> Y_offset = SafeInt<int64_t>(Y->Shape().Size()) / Y->Shape()[0] / conv_attrs_.group;
     const SafeInt<int64_t> W_offset = SafeInt<int64_t>(W->Shape().Size()) / conv_attrs_.group;
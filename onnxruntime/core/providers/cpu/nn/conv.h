@@ -24,16 +24,34 @@ class Conv : public OpKernel {
 template <>
 class Conv<float> : public OpKernel {
  public:
-  Conv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+  Conv(const OpKernelInfo& info)
+      : OpKernel(info),
+        conv_attrs_(info),
+        use_bf16_gemm_(ConvUseBf16(info)),
+        use_winograd_(!use_bf16_gemm_ && ConvUseWinograd(info)) {
     activation_.ActivationKind = MlasIdentityActivation;
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  static bool ConvUseWinograd(const OpKernelInfo& info);
+  static bool ConvUseBf16(const OpKernelInfo& info);
+
+  // compute the convolutions as an im2col and a bfloat16 GEMM, which takes precedence over the Winograd algorithm
+  bool use_bf16_gemm_;
+  bool use_winograd_;
+  // the filter packed for the Winograd algorithm. The original filter is kept for the inputs it does not apply to.
+  IAllocatorUniquePtr<void> winograd_packed_w_;
 };
 
 }  // namespace onnxruntime
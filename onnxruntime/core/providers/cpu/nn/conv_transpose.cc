@@ -17,13 +17,71 @@
 
 #include "core/providers/cpu/nn/conv_transpose.h"
 
+#include <algorithm>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 
+namespace {
+
+// Adds the contribution of one kernel tap of a 2D transposed convolution to the output. `tap_data` holds the
+// product of the tap's filter and the input, one input sized image per output channel, and each of its pixels is
+// added to the output pixel it lands on for this tap.
+void AddKernelTapToOutput(const float* tap_data, int64_t channels, int64_t input_height, int64_t input_width,
+                          int64_t output_height, int64_t output_width, int64_t kernel_y, int64_t kernel_x,
+                          int64_t dilation_h, int64_t dilation_w, int64_t pad_t, int64_t pad_l,
+                          int64_t stride_h, int64_t stride_w, float* output_data,
+                          concurrency::ThreadPool* thread_pool) {
+  // output pixel = input pixel * stride - pad + kernel offset, so find the input range landing inside the output
+  const int64_t offset_y = kernel_y * dilation_h - pad_t;
+  const int64_t offset_x = kernel_x * dilation_w - pad_l;
+  const auto first_input = [](int64_t offset, int64_t stride) {
+    return offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+  };
+  const auto last_input = [](int64_t offset, int64_t stride, int64_t input_size, int64_t output_size) {
+    return output_size - offset <= 0 ? 0 : std::min(input_size, (output_size - offset - 1) / stride + 1);
+  };
+  const int64_t iy_begin = first_input(offset_y, stride_h);
+  const int64_t iy_end = last_input(offset_y, stride_h, input_height, output_height);
+  const int64_t ix_begin = first_input(offset_x, stride_w);
+  const int64_t ix_end = last_input(offset_x, stride_w, input_width, output_width);
+  if (iy_begin >= iy_end || ix_begin >= ix_end) {
+    return;
+  }
+
+  const int64_t input_image_size = input_height * input_width;
+  const int64_t output_image_size = output_height * output_width;
+  const double pixels = static_cast<double>((iy_end - iy_begin) * (ix_end - ix_begin));
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, onnxruntime::narrow<std::ptrdiff_t>(channels),
+      TensorOpCost{pixels * 2 * sizeof(float), pixels * sizeof(float), pixels},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t c = first; c < last; ++c) {
+          for (int64_t iy = iy_begin; iy < iy_end; ++iy) {
+            const float* input_row = tap_data + c * input_image_size + iy * input_width;
+            float* output_row = output_data + c * output_image_size + (iy * stride_h + offset_y) * output_width +
+                                offset_x;
+            if (stride_w == 1) {
+              for (int64_t ix = ix_begin; ix < ix_end; ++ix) {
+                output_row[ix] += input_row[ix];
+              }
+            } else {
+              for (int64_t ix = ix_begin; ix < ix_end; ++ix) {
+                output_row[ix * stride_w] += input_row[ix];
+              }
+            }
+          }
+        }
+      });
+}
+
+}  // namespace
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     ConvTranspose,
     1, 10,
@@ -244,7 +302,15 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
-  const int64_t col_buffer_size = kernel_dim * p.input_shape.Size();
+  // With the prepacked filter, the rows of each kernel tap form a strided matrix, so a 2D transposed convolution
+  // runs one GEMM per tap and adds the result straight into the output. The buffer then only holds one tap's
+  // product rather than the whole column buffer, which is kernel_size times larger.
+  const bool direct = !p.F && p.X->Shape().NumDimensions() == 4;
+  const int64_t output_channels_per_group = p.num_output_channels / conv_transpose_attrs_.group;
+  const int64_t input_channels_per_group = p.num_input_channels / conv_transpose_attrs_.group;
+
+  const int64_t col_buffer_size = direct ? output_channels_per_group * input_image_size
+                                         : kernel_dim * input_image_size;
   auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * col_buffer_size);
   BufferUniquePtr col_buffer(col_data, BufferDeleter(std::move(alloc)));
   float* col_buffer_data = static_cast<float*>(col_buffer.get());
@@ -256,6 +322,38 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
 
   for (auto image_id = 0; image_id < p.N; ++image_id) {
     for (int group_id = 0; group_id < conv_transpose_attrs_.group; ++group_id) {
+      if (direct) {
+        float* group_output = Ydata + group_id * Y_offset;
+        std::fill_n(group_output, onnxruntime::narrow<size_t>(Y_offset), 0.0f);
+
+        for (int64_t kernel_y = 0; kernel_y < p.kernel_shape[0]; ++kernel_y) {
+          for (int64_t kernel_x = 0; kernel_x < p.kernel_shape[1]; ++kernel_x) {
+            // the packed filter of a group is [output channel][kernel tap][input channel]
+            const int64_t tap = kernel_y * p.kernel_shape[1] + kernel_x;
+            MlasGemm(CblasNoTrans,
+                     CblasNoTrans,
+                     onnxruntime::narrow<size_t>(output_channels_per_group),
+                     onnxruntime::narrow<size_t>(input_image_size),
+                     onnxruntime::narrow<size_t>(input_channels_per_group),
+                     1.0f,
+                     filter_data + group_id * W_offset + tap * input_channels_per_group,
+                     onnxruntime::narrow<size_t>(kernel_size * input_channels_per_group),
+                     Xdata + group_id * X_offset,
+                     onnxruntime::narrow<size_t>(input_image_size),
+                     0.0f,
+                     col_buffer_data,
+                     onnxruntime::narrow<size_t>(input_image_size),
+                     thread_pool);
+
+            AddKernelTapToOutput(col_buffer_data, output_channels_per_group,
+                                 p.input_shape[0], p.input_shape[1], output_shape[0], output_shape[1],
+                                 kernel_y, kernel_x, p.dilations[0], p.dilations[1], p.pads[0], p.pads[1],
+                                 p.strides[0], p.strides[1], group_output, thread_pool);
+          }
+        }
+        continue;
+      }
+
       // Weight term
       math::Gemm<float>(
           p.F ? CblasTrans : CblasNoTrans,
@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -18,6 +19,14 @@ LayerNormImpl::LayerNormImpl(const OpKernelInfo& op_kernel_info, bool simplified
 }
 
 namespace {
+template <typename T>
+void ComputeSumAndSumSquare(const T* p_input, int64_t norm_size, T& sum, T& sum_square) {
+  for (int64_t h = 0; h < norm_size; h++) {
+    sum += p_input[h];
+    sum_square += p_input[h] * p_input[h];
+  }
+}
+
 template <typename T, typename U>
 Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, bool simplified) {
   // Inputs
@@ -74,6 +83,21 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
     inv_std_dev_data = inv_std_dev->MutableData<U>();
   }
 
+  if constexpr (std::is_same<T, float>::value && std::is_same<U, float>::value) {
+    MLAS_LAYER_NORM_PARAMS params;
+    params.Input = X_data;
+    params.Gamma = scale_data;
+    params.Beta = bias_data;
+    params.Output = Y_data;
+    params.Mean = mean_data;
+    params.InvStdDev = inv_std_dev_data;
+    params.Epsilon = epsilon;
+    params.Simplified = simplified;
+    MlasLayerNormalization(&params, onnxruntime::narrow<size_t>(norm_count), onnxruntime::narrow<size_t>(norm_size),
+                           p_ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
       [&](ptrdiff_t task_idx) {
@@ -83,10 +107,7 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
         T mean = 0;
         T mean_square = 0;
 
-        for (int64_t h = 0; h < norm_size; h++) {
-          mean += p_input[h];
-          mean_square += p_input[h] * p_input[h];
-        }
+        ComputeSumAndSumSquare(p_input, norm_size, mean, mean_square);
 
         mean = mean / norm_size;
         if (simplified) {
@@ -13,6 +13,7 @@
 #include <codecvt>
 #else
 #include <limits>
+#include <vector>
 #include <iconv.h>
 
 #endif  // _MSC_VER
@@ -128,19 +129,32 @@ using Utf8Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
 #else
 
 // All others (not Windows, Apple, or Android)
+// The conversion descriptors and the scratch buffer are kept for the lifetime of
+// the converter so that converting a tensor does not open/close iconv per string.
 class Utf8Converter {
  public:
-  Utf8Converter(const std::string&, const std::wstring&) {}
+  // Order of arguments is to, from
+  Utf8Converter(const std::string&, const std::wstring&)
+      : to_wide_(iconv_open("WCHAR_T", "UTF-8")),
+        to_utf8_(iconv_open("UTF-8", "WCHAR_T")) {}
+
+  ~Utf8Converter() {
+    if (IsOpen(to_wide_)) {
+      iconv_close(to_wide_);
+    }
+    if (IsOpen(to_utf8_)) {
+      iconv_close(to_utf8_);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Utf8Converter);
 
-  std::wstring from_bytes(const std::string& s) const {
+  std::wstring from_bytes(const std::string& s) {
     std::wstring result;
     if (s.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("WCHAR_T", "UTF-8");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    if (!IsOpen(to_wide_)) {
       return wconv_error;
     }
 
@@ -149,30 +163,27 @@ class Utf8Converter {
     // Temporary buffer assumes 1 byte to 1 wchar_t
     // to make sure it is enough.
     const size_t buffer_len = iconv_in_bytes * sizeof(wchar_t);
-    auto buffer = std::make_unique<char[]>(buffer_len);
-    char* iconv_out = buffer.get();
+    char* iconv_out = GetBuffer(buffer_len);
     size_t iconv_out_bytes = buffer_len;
-    auto ret = iconv(icvt, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
+    auto ret = iconv(to_wide_, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
     if (static_cast<size_t>(-1) == ret) {
       result = wconv_error;
+      // Reset the conversion state before the descriptor is reused
+      iconv(to_wide_, nullptr, nullptr, nullptr, nullptr);
     } else {
       size_t converted_bytes = buffer_len - iconv_out_bytes;
       assert((converted_bytes % sizeof(wchar_t)) == 0);
-      result.assign(reinterpret_cast<const wchar_t*>(buffer.get()), converted_bytes / sizeof(wchar_t));
+      result.assign(reinterpret_cast<const wchar_t*>(buffer_.data()), converted_bytes / sizeof(wchar_t));
     }
-    iconv_close(icvt);
     return result;
   }
 
-  std::string to_bytes(const std::wstring& wstr) const {
+  std::string to_bytes(const std::wstring& wstr) {
     std::string result;
     if (wstr.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("UTF-8", "WCHAR_T");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    if (!IsOpen(to_utf8_)) {
       return conv_error;
     }
 
@@ -180,23 +191,38 @@ class Utf8Converter {
     wchar_t* non_const_in = const_cast<wchar_t*>(wstr.c_str());
     char* iconv_in = reinterpret_cast<char*>(non_const_in);
     size_t iconv_in_bytes = wstr.length() * sizeof(wchar_t);
-    // Temp buffer, assume every code point converts into 3 bytes, this should be enough
+    // Temp buffer, a code point converts into at most 4 bytes
     // We do not convert terminating zeros
-    const size_t buffer_len = wstr.length() * 3;
-    auto buffer = std::make_unique<char[]>(buffer_len);
-
-    char* iconv_out = buffer.get();
+    const size_t buffer_len = wstr.length() * 4;
+    char* iconv_out = GetBuffer(buffer_len);
     size_t iconv_out_bytes = buffer_len;
-    auto ret = iconv(icvt, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
+    auto ret = iconv(to_utf8_, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
     if (static_cast<size_t>(-1) == ret) {
       result = conv_error;
+      iconv(to_utf8_, nullptr, nullptr, nullptr, nullptr);
     } else {
       size_t converted_len = buffer_len - iconv_out_bytes;
-      result.assign(buffer.get(), converted_len);
+      result.assign(buffer_.data(), converted_len);
     }
-    iconv_close(icvt);
     return result;
   }
+
+ private:
+  static bool IsOpen(iconv_t icvt) {
+    // CentOS is not happy with -1
+    return std::numeric_limits<iconv_t>::max() != icvt;
+  }
+
+  char* GetBuffer(size_t len) {
+    if (buffer_.size() < len) {
+      buffer_.resize(len);
+    }
+    return buffer_.data();
+  }
+
+  iconv_t to_wide_;
+  iconv_t to_utf8_;
+  std::vector<char> buffer_;
 };
 
 #endif
@@ -287,7 +313,8 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   }
 
   locale_name_ = info.GetAttrOrDefault("locale", default_locale);
-  Locale locale(locale_name_);
+  locale_ = std::make_unique<Locale>(locale_name_);
+  const Locale& locale = *locale_;
   Utf8Converter converter(conv_error, wconv_error);
 
   std::vector<std::string> swords = info.GetAttrsOrDefault<std::string>("stopwords");
@@ -306,6 +333,8 @@ StringNormalizer::StringNormalizer(const OpKernelInfo& info) : OpKernel(info),
   }
 }
 
+StringNormalizer::~StringNormalizer() = default;
+
 Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   using namespace string_normalizer;
 
@@ -334,7 +363,7 @@ Status StringNormalizer::Compute(OpKernelContext* ctx) const {
   }
 
   Status status;
-  Locale locale(locale_name_);
+  const Locale& locale = *locale_;
   Utf8Converter converter(conv_error, wconv_error);
   auto* const input_data = X->Data<std::string>();
   using StrRef = std::reference_wrapper<const std::string>;
@@ -6,8 +6,11 @@
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
-#include <functional>
-#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string_view>
+#include <core/common/inlined_containers.h>
 #include <core/common/safeint.h>
 
 namespace onnxruntime {
@@ -24,65 +27,83 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
+// NgramTrie is a trie of the n-grams of the pool flattened into arrays. Each n-gram is a path from the root and the
+// node at its end holds its output index. For (1,2,3) node 2 would be a child of 1 with no output index because (1,2)
+// does not exist, node 3 would have one.
+// The first tokens are found through a hash table. The children of the other nodes are stored contiguously,
+// sorted by token, in child_tokens_ and child_nodes_ and are binary searched.
+// String tokens are replaced by their index in the pool vocabulary before walking the trie.
+class NgramTrie {
+ public:
+  static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+  static constexpr int64_t kNoOutput = -1;
+
+  // Adds the ngram_size tokens starting at first as an n-gram writing to output_index.
+  template <class ForwardIter>
+  void Add(ForwardIter first, size_t ngram_size, int64_t output_index, size_t ngram_id) {
+    uint32_t node = kNoNode;
+    for (size_t n = 0; n < ngram_size; ++n, ++first) {
+      auto& children = node == kNoNode ? building_roots_ : building_children_[node];
+      auto p = children.emplace(*first, static_cast<uint32_t>(output_indexes_.size()));
+      if (p.second) {
+        output_indexes_.push_back(kNoOutput);
+        building_children_.emplace_back();
+      }
+      node = p.first->second;
+    }
+    ORT_ENFORCE(output_indexes_[node] == kNoOutput, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
+    output_indexes_[node] = output_index;
+  }
 
-template <>
-struct NgramPart<int64_t>;
+  // Flattens the children added so far, the trie can be searched afterwards.
+  void Finalize() {
+    ORT_ENFORCE(output_indexes_.size() < kNoNode, "Too many ngrams in the pool");
+    roots_.reserve(building_roots_.size());
+    for (const auto& root : building_roots_) {
+      roots_.emplace(root.first, root.second);
+    }
+    child_begin_.reserve(building_children_.size() + 1);
+    for (const auto& children : building_children_) {
+      child_begin_.push_back(static_cast<uint32_t>(child_tokens_.size()));
+      for (const auto& child : children) {
+        child_tokens_.push_back(child.first);
+        child_nodes_.push_back(child.second);
+      }
+    }
+    child_begin_.push_back(static_cast<uint32_t>(child_tokens_.size()));
+    building_roots_.clear();
+    building_children_.clear();
+    building_children_.shrink_to_fit();
+  }
 
-template <>
-struct NgramPart<std::string>;
+  bool Empty() const noexcept { return output_indexes_.empty(); }
 
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
+  uint32_t Root(int64_t token) const {
+    auto hit = roots_.find(token);
+    return hit == roots_.end() ? kNoNode : hit->second;
+  }
 
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = std::unordered_map<int64_t, std::unique_ptr<NgramPartInt>>;
+  uint32_t Child(uint32_t node, int64_t token) const {
+    const int64_t* begin = child_tokens_.data() + child_begin_[node];
+    const int64_t* end = child_tokens_.data() + child_begin_[node + 1];
+    const int64_t* hit = std::lower_bound(begin, end, token);
+    return hit == end || *hit != token ? kNoNode : child_nodes_[hit - child_tokens_.data()];
+  }
 
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
+  int64_t OutputIndex(uint32_t node) const { return output_indexes_[node]; }
 
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+ private:
+  // ordered children, only used while the trie is built
+  std::map<int64_t, uint32_t> building_roots_;
+  std::vector<std::map<int64_t, uint32_t>> building_children_;
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+  InlinedHashMap<int64_t, uint32_t> roots_;
+  std::vector<uint32_t> child_begin_;
+  std::vector<int64_t> child_tokens_;
+  std::vector<uint32_t> child_nodes_;
+  std::vector<int64_t> output_indexes_;
 };
 
-// Returns next ngram_id
-template <class K, class ForwardIter, class Map>
-inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
-  for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
-      ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
-    }
-  }
-  return ngram_id;
-}
-
 }  // namespace ngram_details
 }  // namespace onnxruntime
 
@@ -90,10 +111,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -128,11 +145,10 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // Index of each string of the pool_strings attribute, which owns the strings, in the vocabulary of the trie.
+  InlinedHashMap<std::string_view, int64_t> vocabulary_;
+  bool string_pool_ = false;
+  NgramTrie trie_;
 
   size_t output_size_ = 0;
 
@@ -140,16 +156,6 @@ struct TfIdfVectorizer::Impl {
   ~Impl() = default;
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
-
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
-    assert(ngram_id != 0);
-    --ngram_id;
-    assert(ngram_id < ngram_indexes_.size());
-    size_t output_idx = row_num * output_size_ + SafeInt<size_t>(ngram_indexes_[ngram_id]);
-    assert(output_idx < frequencies.size());
-    ++frequencies[output_idx];
-  }
 };
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(std::make_unique<Impl>()) {
@@ -218,8 +224,19 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
+  // String n-grams are added to the trie as the indexes of their strings in the vocabulary.
+  impl_->string_pool_ = !pool_strings.empty();
+  std::vector<int64_t> pool_tokens;
+  if (impl_->string_pool_) {
+    pool_tokens.reserve(pool_strings.size());
+    for (const std::string& str : pool_strings) {
+      const auto next_token = static_cast<int64_t>(impl_->vocabulary_.size());
+      pool_tokens.push_back(impl_->vocabulary_.emplace(str, next_token).first->second);
+    }
+  }
+
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
-  const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
+  const auto total_items = impl_->string_pool_ ? pool_tokens.size() : pool_int64s.size();
   size_t ngram_id = 1;  // start with 1, 0 - means no n-gram
   // Load into dictionary only required gram sizes
   const size_t min_gram_length = onnxruntime::narrow<size_t>(impl_->min_gram_length_);
@@ -235,12 +252,18 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       ORT_ENFORCE((items % ngram_size == 0),
                   "Number of items must compose whole ", std::to_string(ngram_size), "-grams");
       auto ngrams = items / ngram_size;
-      // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
+      // Skip loading into the trie ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
-        if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
-        } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+        for (size_t k = 0; k < ngrams; ++k, ++ngram_id) {
+          ORT_ENFORCE(ngram_id <= impl_->ngram_indexes_.size(),
+                      "ngram_indexes has no output index for ngram id: ", std::to_string(ngram_id));
+          const int64_t output_index = impl_->ngram_indexes_[ngram_id - 1];
+          const size_t first = start_idx + k * ngram_size;
+          if (impl_->string_pool_) {
+            impl_->trie_.Add(pool_tokens.begin() + first, ngram_size, output_index, ngram_id);
+          } else {
+            impl_->trie_.Add(pool_int64s.begin() + first, ngram_size, output_index, ngram_id);
+          }
         }
       } else {
         ngram_id += ngrams;
@@ -248,60 +271,92 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
     }
     ++ngram_size;
   }
+  impl_->trie_.Finalize();
 }
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::vector<uint32_t>& frequences) const {
-  const Impl& impl = *impl_;
-  std::vector<int64_t> output_dims;
-  if (B == 0) {
-    output_dims.push_back(impl.output_size_);
-    B = 1;  // For use in the loops below
+void TfIdfVectorizer::ComputeRow(const Tensor& X, size_t row_num, size_t row_size, std::vector<int64_t>& tokens,
+                                 std::vector<uint32_t>& roots, float* output_row) const {
+  const auto& impl = *impl_;
+  const auto& trie = impl.trie_;
+  const size_t row_start = row_num * row_size;
+
+  // Tokens missing from the vocabulary are given an index that is not in the trie.
+  if (X.IsDataTypeString()) {
+    const std::string* row = X.Data<std::string>() + row_start;
+    for (size_t i = 0; i < row_size; ++i) {
+      auto hit = impl.vocabulary_.find(row[i]);
+      tokens[i] = hit == impl.vocabulary_.end() ? -1 : hit->second;
+    }
+  } else if (X.IsDataType<int32_t>()) {
+    const int32_t* row = X.Data<int32_t>() + row_start;
+    std::copy(row, row + row_size, tokens.begin());
   } else {
-    output_dims.push_back(B);
-    output_dims.push_back(impl.output_size_);
+    const int64_t* row = X.Data<int64_t>() + row_start;
+    std::copy(row, row + row_size, tokens.begin());
   }
 
-  const auto row_size = impl.output_size_;
+  // the first token of an n-gram doesn't depend on the skip distance
+  for (size_t i = 0; i < row_size; ++i) {
+    roots[i] = trie.Root(tokens[i]);
+  }
 
-  TensorShape output_shape(output_dims);
-  assert(frequences.size() == static_cast<size_t>(output_shape.Size()));
+  const size_t max_gram_length = onnxruntime::narrow<size_t>(impl.max_gram_length_);
+  const size_t max_skip_distance = onnxruntime::narrow<size_t>(impl.max_skip_count_) + 1;  // Convert to distance
+  size_t start_ngram_size = onnxruntime::narrow<size_t>(impl.min_gram_length_);
 
-  auto Y = ctx->Output(0, output_shape);
-  auto output_data = Y->MutableData<float>();
+  for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (size_t ngram_start = 0; ngram_start < row_size; ++ngram_start) {
+      // We went far enough so no n-grams of any size can be gathered
+      if (ngram_start + skip_distance * (start_ngram_size - 1) >= row_size) {
+        break;
+      }
+
+      uint32_t node = roots[ngram_start];
+      size_t item = ngram_start;
+      for (size_t ngram_size = 1; node != NgramTrie::kNoNode;) {
+        if (ngram_size >= start_ngram_size) {
+          const int64_t output_index = trie.OutputIndex(node);
+          if (output_index != NgramTrie::kNoOutput) {
+            output_row[output_index] += 1.0f;
+          }
+        }
+        item += skip_distance;
+        if (++ngram_size > max_gram_length || item >= row_size) {
+          break;
+        }
+        node = trie.Child(node, tokens[item]);
+      }
+    }
+    // We count UniGrams only once since they are not affected
+    // by skip distance
+    if (start_ngram_size == 1 && ++start_ngram_size > max_gram_length) {
+      break;
+    }
+  }
+
+  // Apply the weighting criteria to the counts
   const auto& w = impl.weights_;
+  const size_t output_size = impl.output_size_;
   switch (impl.weighting_criteria_) {
-    case kTF: {
-      for (auto f : frequences) {
-        *output_data++ = static_cast<float>(f);
-      }
-    } break;
+    case kTF:
+      break;
     case kIDF: {
       if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = (*freqs++ > 0) ? w[i] : 0;
-          }
+        for (size_t i = 0; i < output_size; ++i) {
+          output_row[i] = (output_row[i] > 0) ? w[i] : 0;
         }
       } else {
-        for (auto f : frequences) {
-          *output_data++ = (f > 0) ? 1.0f : 0;
+        for (size_t i = 0; i < output_size; ++i) {
+          output_row[i] = (output_row[i] > 0) ? 1.0f : 0;
         }
       }
     } break;
     case kTFIDF: {
       if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = *freqs++ * w[i];
-          }
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = static_cast<float>(f);
+        for (size_t i = 0; i < output_size; ++i) {
+          output_row[i] *= w[i];
         }
       }
     } break;
@@ -311,83 +366,13 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
   }
 }
 
-void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                                  std::vector<uint32_t>& frequencies) const {
-  auto X = ctx->Input<Tensor>(0);
-  const auto elem_size = X->DataType()->Size();
-
-  const void* const row_begin = AdvanceElementPtr(X->DataRaw(), row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
-
-  const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
-
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
-      // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, SafeInt<size_t>(skip_distance) * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
-        break;
-      }
-
-      auto ngram_item = ngram_start;
-      if (X->IsDataTypeString()) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          str_map = &hit->second->leafs_;
-        }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (X->IsDataType<int32_t>()) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
-          }
-          int_map = &hit->second->leafs_;
-        }
-      }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
-    }
-    // We count UniGrams only once since they are not affected
-    // by skip distance
-    if (start_ngram_size == 1 && ++start_ngram_size > max_gram_length) {
-      break;
-    }
-  }
-}
-
 Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   auto X = ctx->Input<Tensor>(0);
   auto& input_shape = X->Shape();
   const size_t total_items = onnxruntime::narrow<size_t>(input_shape.Size());
+  const auto& impl = *impl_;
 
-  int32_t num_rows = 0;
+  size_t num_rows = 0;
   size_t B = 0;
   size_t C = 0;
   auto input_dims = input_shape.GetDims();
@@ -401,7 +386,7 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   } else if (input_dims.size() == 2) {
     B = onnxruntime::narrow<size_t>(input_dims[0]);
     C = onnxruntime::narrow<size_t>(input_dims[1]);
-    num_rows = static_cast<int32_t>(B);
+    num_rows = B;
     if (B < 1) {
       return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                     "Input shape must have either [C] or [B,C] dimensions with B > 0.");
@@ -412,30 +397,39 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   }
 
   assert((num_rows * C) == total_items);
-  // Frequency holder allocate [B..output_size_]
-  // and init all to zero
-  std::vector<uint32_t> frequencies;
-  frequencies.resize(num_rows * impl_->output_size_, 0);
-
-  if (total_items == 0 ||
-      (X->IsDataTypeString() && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+  TensorShape output_shape = B == 0 ? TensorShape({static_cast<int64_t>(impl.output_size_)})
+                                    : TensorShape({static_cast<int64_t>(B), static_cast<int64_t>(impl.output_size_)});
+  auto* Y = ctx->Output(0, output_shape);
+  float* output_data = Y->MutableData<float>();
+
+  // the counts are accumulated in the output, all the weighting criteria leave the zero counts as 0
+  std::fill_n(output_data, num_rows * impl.output_size_, 0.0f);
+
+  if (total_items == 0 || impl.trie_.Empty() || X->IsDataTypeString() != impl.string_pool_) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
     // {b_dim, output_size} when b_dim is the number of received observations
     // and output_size the is the maximum value in ngram_indexes attribute plus 1.
-    OutputResult(ctx, B, frequencies);
     return Status::OK();
   }
 
-  std::function<void(ptrdiff_t)> fn = [this, ctx, C, &frequencies](ptrdiff_t row_num) {
-    ComputeImpl(ctx, row_num, C, frequencies);
-  };
-
-  concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), num_rows, std::move(fn), 0);
-
-  OutputResult(ctx, B, frequencies);
+  // each token of a row starts an n-gram for each skip distance
+  const double walks_per_row = static_cast<double>(C) * static_cast<double>(impl.max_skip_count_ + 1);
+  const TensorOpCost cost{static_cast<double>(C * X->DataType()->Size()),
+                          static_cast<double>(impl.output_size_ * sizeof(float)),
+                          walks_per_row * static_cast<double>(impl.max_gram_length_) * 4.0};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_rows), cost,
+      [this, X, C, output_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<int64_t> tokens(C);
+        std::vector<uint32_t> roots(C);
+        for (std::ptrdiff_t row_num = first; row_num < last; ++row_num) {
+          ComputeRow(*X, static_cast<size_t>(row_num), C, tokens, roots,
+                     output_data + static_cast<size_t>(row_num) * impl_->output_size_);
+        }
+      });
 
   return Status::OK();
 }
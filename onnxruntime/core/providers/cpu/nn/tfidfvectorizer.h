@@ -19,11 +19,10 @@ class TfIdfVectorizer final : public OpKernel {
   Status Compute(OpKernelContext* ctx) const override;
 
  private:
-  void ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                   std::vector<uint32_t>& frequencies) const;
-
-  // Apply weighing criteria and output
-  void OutputResult(OpKernelContext* ctx, size_t b_dim, const std::vector<uint32_t>& frequences) const;
+  // Counts the n-grams of a row into its output and applies the weighting criteria.
+  // tokens and roots are scratch buffers of row_size elements.
+  void ComputeRow(const Tensor& X, size_t row_num, size_t row_size, std::vector<int64_t>& tokens,
+                  std::vector<uint32_t>& roots, float* output_row) const;
 
   struct Impl;
   std::unique_ptr<Impl> impl_;
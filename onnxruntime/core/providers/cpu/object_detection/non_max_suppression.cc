@@ -13,10 +13,12 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -43,6 +45,144 @@ ONNX_OPERATOR_KERNEL_EX(
 
 using namespace nms_helpers;
 
+namespace {
+
+// A box as its corners and area, which are computed once per box instead of in every IOU check.
+struct BoxCorners {
+  float x_min;
+  float y_min;
+  float x_max;
+  float y_max;
+  float area;
+};
+
+void ComputeBoxCorners(const float* boxes_data, int64_t num_boxes, int64_t center_point_box, BoxCorners* corners) {
+  for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+    const float* box = boxes_data + 4 * box_index;
+    BoxCorners& c = corners[box_index];
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(box[1], box[3], c.x_min, c.x_max);
+      MaxMin(box[0], box[2], c.y_min, c.y_max);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      c.x_min = box[0] - width_half;
+      c.x_max = box[0] + width_half;
+      c.y_min = box[1] - height_half;
+      c.y_max = box[1] + height_half;
+    }
+    c.area = (c.x_max - c.x_min) * (c.y_max - c.y_min);
+  }
+}
+
+// Same as nms_helpers::SuppressByIOU, for boxes with precomputed corners.
+inline bool SuppressByIOU(const BoxCorners& box1, const BoxCorners& box2, float iou_threshold) {
+  const float intersection_x_min = HelperMax(box1.x_min, box2.x_min);
+  const float intersection_x_max = HelperMin(box1.x_max, box2.x_max);
+  if (intersection_x_max <= intersection_x_min)
+    return false;
+
+  const float intersection_y_min = HelperMax(box1.y_min, box2.y_min);
+  const float intersection_y_max = HelperMin(box1.y_max, box2.y_max);
+  if (intersection_y_max <= intersection_y_min)
+    return false;
+
+  const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                  (intersection_y_max - intersection_y_min);
+
+  if (intersection_area <= .0f) {
+    return false;
+  }
+
+  const float union_area = box1.area + box2.area - intersection_area;
+
+  if (box1.area <= .0f || box2.area <= .0f || union_area <= .0f) {
+    return false;
+  }
+
+  const float intersection_over_union = intersection_area / union_area;
+
+  return intersection_over_union > iou_threshold;
+}
+
+struct BoxInfoPtr {
+  float score_{};
+  int64_t index_{};
+
+  BoxInfoPtr() = default;
+  explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
+
+  // the boxes are visited with the higher scores first, and the lower index first for the same score. a NaN
+  // score, which only passes when there is no score threshold, goes last.
+  inline bool operator<(const BoxInfoPtr& rhs) const {
+    const bool is_nan = std::isnan(score_);
+    const bool rhs_is_nan = std::isnan(rhs.score_);
+    if (is_nan || rhs_is_nan) {
+      return !is_nan || (rhs_is_nan && index_ < rhs.index_);
+    }
+    return score_ > rhs.score_ || (score_ == rhs.score_ && index_ < rhs.index_);
+  }
+};
+
+// Selects the boxes of one class from highest to lowest score, suppressing the boxes that overlap a selected
+// one by more than iou_threshold.
+// The candidates are sorted into order lazily in growing chunks, as usually only a small part of them is
+// visited before max_output_boxes_per_class boxes are selected.
+void SelectBoxesInsideClass(const float* class_scores, const BoxCorners* corners, int num_boxes,
+                            bool use_score_threshold, float score_threshold, float iou_threshold,
+                            int64_t max_output_boxes_per_class, std::vector<BoxInfoPtr>& candidate_boxes,
+                            std::vector<int64_t>& selected_boxes_inside_class) {
+  candidate_boxes.clear();
+  // Filter by score_threshold_
+  if (use_score_threshold) {
+    for (int box_index = 0; box_index < num_boxes; ++box_index) {
+      if (class_scores[box_index] > score_threshold) {
+        candidate_boxes.emplace_back(class_scores[box_index], box_index);
+      }
+    }
+  } else {
+    for (int box_index = 0; box_index < num_boxes; ++box_index) {
+      candidate_boxes.emplace_back(class_scores[box_index], box_index);
+    }
+  }
+
+  const size_t max_selected = static_cast<size_t>(std::min<int64_t>(max_output_boxes_per_class, num_boxes));
+  size_t sorted_end = 0;
+  size_t chunk_size = std::max<size_t>(64, 4 * max_selected);
+
+  selected_boxes_inside_class.clear();
+  // Get the next box with top score, filter by iou_threshold
+  for (size_t i = 0; i < candidate_boxes.size() && selected_boxes_inside_class.size() < max_selected; ++i) {
+    if (i == sorted_end) {
+      const size_t next_end = std::min(candidate_boxes.size(), sorted_end + chunk_size);
+      std::partial_sort(candidate_boxes.begin() + sorted_end, candidate_boxes.begin() + next_end,
+                        candidate_boxes.end());
+      sorted_end = next_end;
+      chunk_size *= 2;
+    }
+
+    const BoxCorners& next_top_score = corners[candidate_boxes[i].index_];
+
+    bool selected = true;
+    // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+    for (const auto selected_index : selected_boxes_inside_class) {
+      if (SuppressByIOU(next_top_score, corners[selected_index], iou_threshold)) {
+        selected = false;
+        break;
+      }
+    }
+
+    if (selected) {
+      selected_boxes_inside_class.push_back(candidate_boxes[i].index_);
+    }
+  }
+}
+
+}  // namespace
+
 // This works for both CPU and GPU.
 // CUDA kernel declare OrtMemTypeCPUInput for max_output_boxes_per_class(2), iou_threshold(3) and score_threshold(4)
 Status NonMaxSuppressionBase::PrepareCompute(OpKernelContext* ctx, PrepareContext& pc) {
@@ -136,67 +276,44 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
 
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
+  // The corners of the boxes of a batch are shared by all the classes
+  std::vector<BoxCorners> corners(SafeInt<size_t>(pc.num_batches_) * pc.num_boxes_);
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
+    ComputeBoxCorners(boxes_data + (batch_index * pc.num_boxes_ * 4), pc.num_boxes_, center_point_box,
+                      corners.data() + batch_index * pc.num_boxes_);
+  }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+  // The classes of all the batches are processed in parallel, each into its own list of selected boxes
+  const int64_t num_batch_classes = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_boxes(narrow<size_t>(num_batch_classes));
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_batch_classes),
+      static_cast<double>(pc.num_boxes_) * 16,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(pc.num_boxes_);
+
+        for (std::ptrdiff_t batch_class = first; batch_class < last; ++batch_class) {
+          const int64_t batch_index = batch_class / pc.num_classes_;
+          int64_t box_score_offset = batch_class * pc.num_boxes_;
+          SelectBoxesInsideClass(scores_data + box_score_offset, corners.data() + batch_index * pc.num_boxes_,
+                                 pc.num_boxes_, pc.score_threshold_ != nullptr, score_threshold, iou_threshold,
+                                 max_output_boxes_per_class, candidate_boxes,
+                                 selected_boxes[narrow<size_t>(batch_class)]);
         }
-        sorted_boxes.pop();
-      }  // while
-    }    // for class_index
-  }      // for batch_index
+      });
+
+  std::vector<SelectedIndex> selected_indices;
+  for (int64_t batch_class = 0; batch_class < num_batch_classes; ++batch_class) {
+    const int64_t batch_index = batch_class / pc.num_classes_;
+    const int64_t class_index = batch_class % pc.num_classes_;
+    for (const auto box_index : selected_boxes[narrow<size_t>(batch_class)]) {
+      selected_indices.emplace_back(batch_index, class_index, box_index);
+    }
+  }
 
   constexpr auto last_dim = 3;
   const auto num_selected = selected_indices.size();
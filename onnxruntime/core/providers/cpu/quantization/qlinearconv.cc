@@ -20,6 +20,18 @@ class QLinearConv : public OpKernel {
  public:
   explicit QLinearConv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     channels_last_ = (info.GetAttrOrDefault<int64_t>("channels_last", static_cast<int64_t>(0)) != 0);
+
+    // The contrib version of the operator can fuse a Relu or Clip, applied to the quantized output.
+    const std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+    if (activation == "Relu") {
+      activation_kind_ = MlasReluActivation;
+    } else if (activation == "Clip") {
+      activation_kind_ = MlasClipActivation;
+      activation_params_ = info.GetAttrsOrDefault<float>("activation_params");
+      ORT_ENFORCE(activation_params_.size() == 2, "QLinearConv : Clip activation requires min and max activation_params");
+    } else {
+      ORT_ENFORCE(activation.empty(), "QLinearConv : unsupported activation ", activation);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -42,7 +54,12 @@ class QLinearConv : public OpKernel {
     IN_W_ZERO_POINT = 5,
     IN_Y_SCALE = 6,
     IN_Y_ZERO_POINT = 7,
-    IN_BIAS = 8
+    IN_BIAS = 8,
+    IN_SUM = 9,
+    IN_SUM_SCALE = 10,
+    IN_SUM_ZERO_POINT = 11,
+    IN_OUT_SCALE = 12,
+    IN_OUT_ZERO_POINT = 13
   };
 
   enum OutputTensors : int {
@@ -108,6 +125,31 @@ class QLinearConv : public OpKernel {
     return output_scales;
   }
 
+  // Quantizes a bound of the fused Clip activation to the output type.
+  static ActType QuantizeActivationBound(float value, float scale, ActType zero_point) {
+    const float q = std::nearbyintf(value / scale) + static_cast<float>(zero_point);
+    return static_cast<ActType>(std::clamp(q,
+                                           static_cast<float>(std::numeric_limits<ActType>::lowest()),
+                                           static_cast<float>(std::numeric_limits<ActType>::max())));
+  }
+
+  /**
+   * @brief Computes the range of the quantized output allowed by the fused activation.
+   *
+   *        Quantization is monotonic, so clamping the quantized output gives the same
+   *        result as quantizing the activation of the real value.
+   */
+  void ComputeActivationRange(float scale, ActType zero_point, ActType& lower_bound, ActType& upper_bound) const {
+    lower_bound = std::numeric_limits<ActType>::lowest();
+    upper_bound = std::numeric_limits<ActType>::max();
+    if (activation_kind_ == MlasReluActivation) {
+      lower_bound = zero_point;
+    } else if (activation_kind_ == MlasClipActivation) {
+      lower_bound = QuantizeActivationBound(activation_params_[0], scale, zero_point);
+      upper_bound = QuantizeActivationBound(activation_params_[1], scale, zero_point);
+    }
+  }
+
   /**
    * @brief Computes the partition stride of the activation tensor.
    *
@@ -299,6 +341,8 @@ class QLinearConv : public OpKernel {
   bool is_symmetric_conv_{false};
   bool is_symmetric_gemm_{false};
   bool channels_last_{false};
+  MLAS_ACTIVATION_KIND activation_kind_{MlasIdentityActivation};
+  std::vector<float> activation_params_;
   std::vector<int32_t> column_sums_;
 };
 
@@ -570,6 +614,56 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
+  // The contrib version of the operator can fuse a residual QLinearAdd of the requantized output
+  // with another tensor, followed by the activation.
+  const Tensor* Sum = context->Input<Tensor>(InputTensors::IN_SUM);
+  const ActType* sum_data = nullptr;
+  const float Y_scale_value = *(context->Input<Tensor>(InputTensors::IN_Y_SCALE)->Data<float>());
+  float sum_scale_value = 0.0f;
+  float out_scale_value = Y_scale_value;
+  ActType sum_zero_point_value = 0;
+  ActType out_zero_point_value = Y_zero_point_value;
+  if (Sum != nullptr) {
+    const Tensor* sum_scale = context->Input<Tensor>(InputTensors::IN_SUM_SCALE);
+    const Tensor* sum_zero_point = context->Input<Tensor>(InputTensors::IN_SUM_ZERO_POINT);
+    const Tensor* out_scale = context->Input<Tensor>(InputTensors::IN_OUT_SCALE);
+    const Tensor* out_zero_point = context->Input<Tensor>(InputTensors::IN_OUT_ZERO_POINT);
+    ORT_RETURN_IF_NOT(Sum->Shape() == Y->Shape(), "QLinearConv : sum must have the shape of the output");
+    ORT_RETURN_IF_NOT(sum_scale != nullptr && IsScalarOr1ElementVector(sum_scale) &&
+                          sum_zero_point != nullptr && IsScalarOr1ElementVector(sum_zero_point) &&
+                          out_scale != nullptr && IsScalarOr1ElementVector(out_scale) &&
+                          out_zero_point != nullptr && IsScalarOr1ElementVector(out_zero_point),
+                      "QLinearConv : sum requires scalar sum and output scales and zero points");
+    sum_data = Sum->Data<ActType>();
+    sum_scale_value = *(sum_scale->Data<float>());
+    sum_zero_point_value = *(sum_zero_point->Data<ActType>());
+    out_scale_value = *(out_scale->Data<float>());
+    out_zero_point_value = *(out_zero_point->Data<ActType>());
+  }
+
+  ActType activation_lower_bound;
+  ActType activation_upper_bound;
+  ComputeActivationRange(out_scale_value, out_zero_point_value, activation_lower_bound, activation_upper_bound);
+  const bool has_activation = activation_lower_bound != std::numeric_limits<ActType>::lowest() ||
+                              activation_upper_bound != std::numeric_limits<ActType>::max();
+  const bool has_epilogue = sum_data != nullptr || has_activation;
+
+  // Adds the sum to and applies the activation to a span of the requantized output. Channels last
+  // outputs are processed by each worker while its tile is still in cache.
+  auto apply_epilogue = [&](ActType* output, const ActType* sum, size_t count) {
+    if (sum != nullptr) {
+      MlasQLinearAdd(output, Y_scale_value, Y_zero_point_value,
+                     sum, sum_scale_value, sum_zero_point_value,
+                     out_scale_value, out_zero_point_value,
+                     output, count, false);
+    }
+    if (has_activation) {
+      for (size_t i = 0; i < count; i++) {
+        output[i] = std::clamp(output[i], activation_lower_bound, activation_upper_bound);
+      }
+    }
+  };
+
   const int64_t input_image_size = input_shape.Size();
   const int64_t output_image_size = output_shape.Size();
   const int64_t kernel_size = TensorShape(kernel_shape).Size();
@@ -770,6 +864,12 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
       } else {
         MlasConvSym(conv_params);
       }
+
+      if (has_epilogue) {
+        const int64_t worker_offset = Y_offset * image_id + output_start * M;
+        apply_epilogue(worker_output, sum_data != nullptr ? sum_data + worker_offset : nullptr,
+                       static_cast<size_t>(output_count * M));
+      }
     };
 
     concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, onnxruntime::narrow<ptrdiff_t>(task_count * N), conv_worker);
@@ -861,6 +961,10 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
         } else {
           MlasConvSym(conv_params);
         }
+        if (has_epilogue && channels_last_) {
+          apply_epilogue(worker_output, sum_data != nullptr ? sum_data + output_start * M : nullptr,
+                         static_cast<size_t>(output_count * M));
+        }
         return;
       }
 
@@ -987,6 +1091,11 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
           0,
           static_cast<size_t>(output_count),
           static_cast<size_t>(M));
+
+      if (has_epilogue && channels_last_) {
+        apply_epilogue(worker_output, sum_data != nullptr ? sum_data + output_start * M : nullptr,
+                       static_cast<size_t>(output_count * M));
+      }
     };
 
     concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, onnxruntime::narrow<ptrdiff_t>(task_count), conv_worker);
@@ -998,10 +1107,18 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
           Ydata,
           static_cast<size_t>(output_image_size),
           static_cast<size_t>(M));
+
+      // The sum is channels first too, so the epilogue runs on the transposed image.
+      if (has_epilogue) {
+        apply_epilogue(Ydata, sum_data, static_cast<size_t>(Y_offset));
+      }
     }
 
     Xdata += X_offset;
     Ydata += Y_offset;
+    if (sum_data != nullptr) {
+      sum_data += Y_offset;
+    }
   }
 
   return Status::OK();
@@ -7,6 +7,7 @@
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
 #include "core/providers/common.h"
+#include "core/mlas/inc/mlas.h"
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26451)
@@ -327,6 +328,100 @@ void ReduceAggregatorBase::FastReduceRKR(const Tensor&, const gsl::span<const in
   ValidateMustBeOverloaded();
 }
 
+// Reduces each row of fast_shape (K, R) with MLAS.
+static void MlasFastReduceKR(MLAS_REDUCE_KIND kind, const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                             Tensor& output, concurrency::ThreadPool* tp) {
+  const float* data = input.Data<float>();
+  float* out = output.MutableData<float>();
+  const size_t stridei = onnxruntime::narrow<size_t>(fast_shape[1]);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, fast_shape[1], sizeof(float), 6),
+      [kind, data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
+        MlasReduceRows(kind, data + first * stridei, stridei, out + first, static_cast<size_t>(last - first), stridei);
+      });
+}
+
+// Reduces the rows of each (R, K) block of fast_shape (B, R, K) with MLAS. RK is a single block.
+static void MlasFastReduceRK(MLAS_REDUCE_KIND kind, const float* data, int64_t n_blocks, int64_t n_rows, int64_t N,
+                             float* out, concurrency::ThreadPool* tp) {
+  const size_t stridei = SafeInt<size_t>(n_rows) * N;
+  if (n_blocks == 1) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(float), 6),
+        [kind, data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+          MlasReduceColumns(kind, data + begin, static_cast<size_t>(N), out + begin, static_cast<size_t>(n_rows),
+                            static_cast<size_t>(end - begin));
+        });
+  } else {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(n_blocks), ParallelReduceFastCost(n_rows, N, sizeof(float), 6),
+        [kind, data, out, N, n_rows, stridei](ptrdiff_t begin, ptrdiff_t end) {
+          for (ptrdiff_t d = begin; d < end; ++d) {
+            MlasReduceColumns(kind, data + d * stridei, static_cast<size_t>(N), out + d * N,
+                              static_cast<size_t>(n_rows), static_cast<size_t>(N));
+          }
+        });
+  }
+}
+
+template <>
+void ReduceAggregatorSum<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp) {
+  MlasFastReduceKR(MlasReduceSum, input, fast_shape, output, tp);
+}
+
+template <>
+void ReduceAggregatorSum<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp) {
+  MlasFastReduceRK(MlasReduceSum, input.Data<float>(), 1, fast_shape[0], fast_shape[1],
+                   output.MutableData<float>(), tp);
+}
+
+template <>
+void ReduceAggregatorSum<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                               Tensor& output, concurrency::ThreadPool* tp) {
+  MlasFastReduceRK(MlasReduceSum, input.Data<float>(), fast_shape[0], fast_shape[1], fast_shape[2],
+                   output.MutableData<float>(), tp);
+}
+
+template <>
+void ReduceAggregatorMax<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp) {
+  MlasFastReduceKR(MlasReduceMaximum, input, fast_shape, output, tp);
+}
+
+template <>
+void ReduceAggregatorMax<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp) {
+  MlasFastReduceRK(MlasReduceMaximum, input.Data<float>(), 1, fast_shape[0], fast_shape[1],
+                   output.MutableData<float>(), tp);
+}
+
+template <>
+void ReduceAggregatorMax<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                               Tensor& output, concurrency::ThreadPool* tp) {
+  MlasFastReduceRK(MlasReduceMaximum, input.Data<float>(), fast_shape[0], fast_shape[1], fast_shape[2],
+                   output.MutableData<float>(), tp);
+}
+
+template <>
+void ReduceAggregatorL2<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                             Tensor& output, concurrency::ThreadPool* tp) {
+  MlasFastReduceKR(MlasReduceSumSquare, input, fast_shape, output, tp);
+  float* out = output.MutableData<float>();
+  EigenVectorArrayMap<float>(out, onnxruntime::narrow<size_t>(fast_shape[0])) =
+      ConstEigenVectorArrayMap<float>(out, onnxruntime::narrow<size_t>(fast_shape[0])).sqrt();
+}
+
+template <>
+void ReduceAggregatorL2<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                             Tensor& output, concurrency::ThreadPool* tp) {
+  float* out = output.MutableData<float>();
+  MlasFastReduceRK(MlasReduceSumSquare, input.Data<float>(), 1, fast_shape[0], fast_shape[1], out, tp);
+  EigenVectorArrayMap<float>(out, onnxruntime::narrow<size_t>(fast_shape[1])) =
+      ConstEigenVectorArrayMap<float>(out, onnxruntime::narrow<size_t>(fast_shape[1])).sqrt();
+}
+
 void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
                                  gsl::span<const int64_t> reduced_axes,
                                  ResultsNoTransposePrepareForReduce& results) {
@@ -648,6 +648,48 @@ class ReduceAggregatorL2 : public ReduceAggregator<T, T> {
   }
   inline void update(const T& v) { this->accumulator_ += v * v; }
   inline T get_value() { return reduce_sqrt<T>(this->accumulator_); }
+
+  // Fast reduction
+  static inline FastReduceKind WhichFastReduce() {
+    return FastReduceKind::kKR | FastReduceKind::kRK;
+  }
+
+  static void FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+    int64_t stridei = fast_shape[1];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(fast_shape[0]), ParallelReduceFastCost(1, stridei, sizeof(T), 6),
+        [data, stridei, out](ptrdiff_t first, ptrdiff_t last) {
+          for (ptrdiff_t d = first; d < last; ++d) {
+            out[d] = reduce_sqrt<T>(Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, 1>>(
+                                        data + d * stridei, onnxruntime::narrow<size_t>(stridei))
+                                        .squaredNorm());
+          }
+        });
+  }
+
+  static void FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                           Tensor& output, concurrency::ThreadPool* tp) {
+    int64_t N = fast_shape[1];
+    const T* data = input.Data<T>();
+    T* out = output.MutableData<T>();
+
+    int64_t n_rows = fast_shape[0];
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N), ParallelReduceFastCost(1, n_rows, sizeof(T), 6),
+        [data, out, N, n_rows](ptrdiff_t begin, ptrdiff_t end) {
+          EigenVectorArrayMap<T> sums(out + begin, end - begin);
+          sums = ConstEigenVectorArrayMap<T>(data + begin, end - begin).square();
+          for (int64_t row = 1; row < n_rows; ++row) {
+            sums += ConstEigenVectorArrayMap<T>(data + row * N + begin, end - begin).square();
+          }
+          for (ptrdiff_t j = begin; j < end; ++j) {
+            out[j] = reduce_sqrt<T>(out[j]);
+          }
+        });
+  }
 };
 
 template <typename T>
@@ -710,6 +752,32 @@ void CommonReduce2Loops(OpKernelContext* ctx,
                         const gsl::span<const int64_t>& axes_, int64_t keepdims_,
                         bool noop_with_empty_axes = false);
 
+// The float fast reductions run the vectorized MLAS reduction kernels.
+template <>
+void ReduceAggregatorSum<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorSum<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorSum<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                               Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMax<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMax<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                              Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorMax<float>::FastReduceKRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                               Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorL2<float>::FastReduceKR(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                             Tensor& output, concurrency::ThreadPool* tp);
+template <>
+void ReduceAggregatorL2<float>::FastReduceRK(const Tensor& input, const gsl::span<const int64_t>& fast_shape,
+                                             Tensor& output, concurrency::ThreadPool* tp);
+
 template <bool allow_multi_axes>
 class ReduceKernelBase {
  protected:
@@ -314,22 +314,6 @@ void ComputeGemm(const int M,
 
 namespace deepcpu {
 
-constexpr float alpha_1 = 4.89352455891786e-03f;
-constexpr float alpha_3 = 6.37261928875436e-04f;
-constexpr float alpha_5 = 1.48572235717979e-05f;
-constexpr float alpha_7 = 5.12229709037114e-08f;
-constexpr float alpha_9 = -8.60467152213735e-11f;
-constexpr float alpha_11 = 2.00018790482477e-13f;
-constexpr float alpha_13 = -2.76076847742355e-16f;
-
-constexpr float beta_0 = 4.89352518554385e-03f;
-constexpr float beta_2 = 2.26843463243900e-03f;
-constexpr float beta_4 = 1.18534705686654e-04f;
-constexpr float beta_6 = 1.19825839466702e-06f;
-
-constexpr float sigmoid_bound = 20.0f;
-constexpr float tanh_bound = 10.0f;
-
 #if defined(__GNUC__) && !defined(__wasm__)
 #define restrict __restrict__
 #elif defined(_MSC_VER)
@@ -338,46 +322,6 @@ constexpr float tanh_bound = 10.0f;
 #define restrict
 #endif
 
-inline void clip_for_sigmoid_in_place(float* ps, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -sigmoid_bound)
-      ps[i] = -sigmoid_bound;
-    else if (ps[i] > sigmoid_bound)
-      ps[i] = sigmoid_bound;
-  }
-}
-
-inline void clip_for_tanh_in_place(float* ps, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -tanh_bound)
-      ps[i] = -tanh_bound;
-    else if (ps[i] > tanh_bound)
-      ps[i] = tanh_bound;
-  }
-}
-
-inline void clip_for_sigmoid(const float* ps, float* pd, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -sigmoid_bound)
-      pd[i] = -sigmoid_bound;
-    else if (ps[i] > sigmoid_bound)
-      pd[i] = sigmoid_bound;
-    else
-      pd[i] = ps[i];
-  }
-}
-
-inline void clip_for_tanh(const float* ps, float* pd, int c) {
-  for (int i = 0; i < c; i++) {
-    if (ps[i] < -tanh_bound)
-      pd[i] = -tanh_bound;
-    else if (ps[i] > tanh_bound)
-      pd[i] = tanh_bound;
-    else
-      pd[i] = ps[i];
-  }
-}
-
 void add_bias_into_ignore(const float* ps, const float* pd, int c) {
   ORT_UNUSED_PARAMETER(ps);
   ORT_UNUSED_PARAMETER(pd);
@@ -558,22 +502,8 @@ void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float a
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_tanh_in_place(ps2, c);
-
+  MlasComputeTanh(ps2, ps2, c);
   for (int i = 0; i < c; i++) {
-    float x = ps2[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    ps2[i] = p / q;
     pd[i] = ps1[i] * ps2[i];
   }
 }
@@ -582,22 +512,8 @@ void gru_reset_gate_sigmoid(const float* ps1, float* ps2, float* pd, int c, floa
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_sigmoid_in_place(ps2, c);
-
+  MlasComputeLogistic(ps2, ps2, c);
   for (int i = 0; i < c; i++) {
-    float x = 0.5f * ps2[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    ps2[i] = 0.5f * (1 + p / q);
     pd[i] = ps1[i] * ps2[i];
   }
 }
@@ -623,22 +539,8 @@ void gru_output_gate_tanh(float* ph, const float* pz, const float* ps, float* po
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_tanh_in_place(ph, c);
-
+  MlasComputeTanh(ph, ph, c);
   for (int i = 0; i < c; i++) {
-    float x = ph[i];
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    ph[i] = p / q;
     po[i] = (1 - pz[i]) * ph[i] + pz[i] * ps[i];
   }
 }
@@ -664,22 +566,9 @@ void gru_output_gate_sigmoid(float* ph, const float* pz, const float* ps, float*
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
 
-  clip_for_sigmoid_in_place(ph, c);
-
+  MlasComputeLogistic(ph, ph, c);
   for (int i = 0; i < c; i++) {
-    float x = 0.5f * (ph[i]);
-    float x2 = x * x;
-    float p = x2 * alpha_13 + alpha_11;
-    p = x2 * p + alpha_9;
-    p = x2 * p + alpha_7;
-    p = x2 * p + alpha_5;
-    p = x2 * p + alpha_3;
-    p = x2 * p + alpha_1;
-    p = x * p;
-    float q = x2 * beta_6 + beta_4;
-    q = x2 * q + beta_2;
-    q = x2 * q + beta_0;
-    po[i] = (1 - pz[i]) * 0.5f * (1 + (p / q)) + pz[i] * ps[i];
+    po[i] = (1 - pz[i]) * ph[i] + pz[i] * ps[i];
   }
 }
 
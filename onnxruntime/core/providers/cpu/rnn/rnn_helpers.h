@@ -129,6 +129,16 @@ void ReverseSequence(gsl::span<const T> inputs,
   }
 }
 
+// Get the number of rows of the batch, from first_row, up to the last one whose sequence is still running at the step.
+// The rows after it are padding, so the recurrent GEMM of the step can leave them out. When sequence_lens is in
+// decreasing order, as it is for packed sequences, the rows shrink to exactly the running sequences.
+inline int RunningRows(gsl::span<const int> sequence_lengths, int step, int first_row, int num_rows) {
+  while (num_rows > 0 && sequence_lengths[first_row + num_rows - 1] <= step) {
+    --num_rows;
+  }
+  return num_rows;
+}
+
 // A has size M x K, B has size N x K (transposed), and C has size M x N
 // We check that A, B and C are large enough before calling the lower level GEMM implementation
 template <typename TSpanAIter, typename TSpanBIter, typename TSpanCIter>
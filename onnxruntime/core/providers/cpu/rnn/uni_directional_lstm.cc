@@ -335,14 +335,20 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
 
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
       // Do it sequentially to avoid nested parallelism
-      ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
-                  gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
-                  recurrent_weights,                                                          // R[iofc]
-                  beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4,
-                  quantized_input_or_a_.data() + (seq_start * hidden_size_),
-                  quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
-                  ttp);
+      // Rows after the last running sequence are skipped by GateComputations, so leave them out of the GEMM
+      const int running_rows = step < min_sequence_length
+                                   ? num_seq_to_compute_adjusted
+                                   : RunningRows(sequence_lengths, step, seq_start, num_seq_to_compute_adjusted);
+      if (running_rows > 0) {
+        ComputeGemm(running_rows, hidden_size_x4, hidden_size_, alpha,
+                    gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
+                    recurrent_weights,                                                          // R[iofc]
+                    beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4,
+                    quantized_input_or_a_.data() + (seq_start * hidden_size_),
+                    quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
+                    ttp);
+      }
 
       DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str, &*step_out_IOFC, num_seq_to_compute_adjusted, hidden_size_x4);
 
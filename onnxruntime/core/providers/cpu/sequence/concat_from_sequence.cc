@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/sequence/concat_from_sequence.h"
+#include "core/common/narrow.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/TensorSeq.h"
 
@@ -17,6 +19,34 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("S", DataTypeImpl::AllSequenceTensorTypes()),
     ConcatFromSequence);
 
+namespace {
+// When the output has no dimensions in front of the concatenation axis, it is simply the inputs laid end to end.
+// Inputs that are already adjacent in memory (e.g. the elements produced by SplitToSequence) are copied as a
+// single block instead of one strided copy per sequence element.
+Status CopyInputsEndToEnd(const Prepare& p, concurrency::ThreadPool* tp) {
+  auto* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+  const size_t num_inputs = p.inputs.size();
+  size_t i = 0;
+  while (i < num_inputs) {
+    const auto* run_start = static_cast<const uint8_t*>(p.inputs[i].tensor->DataRaw());
+    size_t run_bytes = p.inputs[i].tensor->SizeInBytes();
+    for (++i; i < num_inputs && p.inputs[i].tensor->DataRaw() == run_start + run_bytes; ++i) {
+      run_bytes += p.inputs[i].tensor->SizeInBytes();
+    }
+    if (run_bytes == 0) {
+      continue;
+    }
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(run_bytes), TensorOpCost{1.0, 1.0, 0.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          memcpy(output + first, run_start + first, static_cast<size_t>(last - first));
+        });
+    output += run_bytes;
+  }
+  return Status::OK();
+}
+}  // namespace
+
 // core Compute() method for the 'ConcatFromSequence' kernel
 Status ConcatFromSequence::Compute(OpKernelContext* ctx) const {
   const auto* X = ctx->Input<TensorSeq>(0);
@@ -39,6 +69,10 @@ Status ConcatFromSequence::Compute(OpKernelContext* ctx) const {
   if (p.output_num_elements == 0)
     return Status::OK();
 
+  if (!p.is_string_type && p.output_tensor->Shape().SizeToDimension(narrow<size_t>(p.axis)) == 1) {
+    return CopyInputsEndToEnd(p, ctx->GetOperatorThreadPool());
+  }
+
   // Compute values to be placed in the output tensor
   return ComputeImpl(p, ctx);
 }
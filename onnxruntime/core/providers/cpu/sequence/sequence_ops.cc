@@ -518,9 +518,25 @@ Status SplitToSequence::ComputeImpl(OpKernelContext& context, const Tensor& inpu
   tseq->SetType(input.DataType());
   tseq->Reserve(static_cast<size_t>(num_outputs));
 
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context.GetTempSpaceAllocator(&alloc));
+
+  // The splits of a non-string tensor are carved out of a single buffer shared by all the sequence elements.
+  // This saves an allocation per element and lays the elements out back to back, so a ConcatFromSequence
+  // consuming them can copy them as one block.
+  std::shared_ptr<void> pool;
+  T* pool_data = nullptr;
+  if constexpr (!std::is_same<T, std::string>::value) {
+    if (num_outputs > 1 && input_shape.Size() > 0) {
+      pool = IAllocator::MakeUniquePtr<void>(alloc, SafeInt<size_t>(input_shape.Size()) * sizeof(T));
+      pool_data = static_cast<T*>(pool.get());
+    }
+  }
+
   // copy dimensions so we can update the selected axis in place
   auto output_dimensions = input_shape.AsShapeVector();
   int64_t input_offset = 0;
+  int64_t pool_offset = 0;
   const T* input_data = input.Data<T>();
   for (int i = 0; i < num_outputs; ++i) {
     // update size of dimension for axis we're splitting on while considering uneven split
@@ -532,10 +548,12 @@ Status SplitToSequence::ComputeImpl(OpKernelContext& context, const Tensor& inpu
     }
     output_dimensions[onnxruntime::narrow<size_t>(axis)] = split_size;
 
-    AllocatorPtr alloc;
-    ORT_RETURN_IF_ERROR(context.GetTempSpaceAllocator(&alloc));
-    Tensor output_tensor(input.DataType(), onnxruntime::TensorShape(output_dimensions), alloc);
+    Tensor output_tensor = pool_data != nullptr
+                               ? Tensor(input.DataType(), onnxruntime::TensorShape(output_dimensions),
+                                        pool_data + pool_offset, alloc->Info())
+                               : Tensor(input.DataType(), onnxruntime::TensorShape(output_dimensions), alloc);
     T* output_data = output_tensor.MutableData<T>();
+    pool_offset += static_cast<int64_t>(before_dims) * split_size * after_dims_excluding_split;
 
     ::onnxruntime::math::CopyMatrix<T>(
         before_dims,                                       // M
@@ -563,7 +581,15 @@ Status SplitToSequence::ComputeImpl(OpKernelContext& context, const Tensor& inpu
     }
 
     // finally move the resulting tensor to the output sequence
-    tseq->Add(std::move(output_tensor));
+    if (pool) {
+      // the element keeps the shared buffer alive for as long as it is referenced
+      OrtValue value;
+      value.Init(new Tensor(std::move(output_tensor)), DataTypeImpl::GetType<Tensor>(),
+                 [pool](void* p) { delete static_cast<Tensor*>(p); });
+      tseq->Add(std::move(value));
+    } else {
+      tseq->Add(std::move(output_tensor));
+    }
   }
 
   return Status::OK();
@@ -0,0 +1,257 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/signal/fft_plan.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace signal {
+
+namespace {
+
+// std::complex multiplication checks for NaN and infinity through a library call, which keeps the butterflies
+// from being inlined and vectorized.
+template <typename T>
+inline std::complex<T> Multiply(const std::complex<T>& a, const std::complex<T>& b) {
+  return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// exp(i * pi * numerator / denominator), computed in double so the float twiddles are rounded once
+template <typename T>
+std::complex<T> UnitRoot(double numerator, double denominator) {
+  const double angle = M_PI * numerator / denominator;
+  return std::complex<T>(static_cast<T>(std::cos(angle)), static_cast<T>(std::sin(angle)));
+}
+
+bool IsPowerOf2(size_t n) {
+  return n != 0 && (n & (n - 1)) == 0;
+}
+
+}  // namespace
+
+template <typename T>
+ComplexFFT<T>::ComplexFFT(size_t length, bool inverse) : length_(length) {
+  ORT_ENFORCE(length > 0, "The FFT length must be positive.");
+  const double direction = inverse ? 1.0 : -1.0;
+
+  if (IsPowerOf2(length)) {
+    unsigned bits = 0;
+    while ((size_t{1} << bits) < length) {
+      ++bits;
+    }
+
+    bit_reversed_.resize(length);
+    bit_reversed_[0] = 0;
+    for (size_t i = 1; i < length; ++i) {
+      bit_reversed_[i] = (bit_reversed_[i >> 1] >> 1) | ((i & 1) << (bits - 1));
+    }
+
+    twiddles_.resize(length / 2);
+    for (size_t k = 0; k < length / 2; ++k) {
+      twiddles_[k] = UnitRoot<T>(direction * 2.0 * static_cast<double>(k), static_cast<double>(length));
+    }
+    return;
+  }
+
+  // x_k = c_k * sum_n (x_n * c_n) * conj(c_(k - n)) with the chirp c_n = exp(+-pi i n^2 / length), so the
+  // transform is a convolution, run as a power of 2 FFT of at least 2 * length - 1 elements
+  size_t fft_length = 1;
+  while (fft_length < 2 * length - 1) {
+    fft_length <<= 1;
+  }
+  bluestein_fft_ = std::make_unique<ComplexFFT<T>>(fft_length, false);
+
+  chirp_.resize(length);
+  for (size_t n = 0; n < length; ++n) {
+    // n^2 modulo 2 * length keeps the angle small, so it stays accurate for long signals
+    const uint64_t n_squared = (static_cast<uint64_t>(n) * n) % (2 * static_cast<uint64_t>(length));
+    chirp_[n] = UnitRoot<T>(direction * static_cast<double>(n_squared), static_cast<double>(length));
+  }
+
+  std::vector<std::complex<T>> b(fft_length);
+  const T inverse_fft_length = static_cast<T>(1.0 / static_cast<double>(fft_length));
+  b[0] = std::conj(chirp_[0]) * inverse_fft_length;
+  for (size_t n = 1; n < length; ++n) {
+    b[n] = b[fft_length - n] = std::conj(chirp_[n]) * inverse_fft_length;
+  }
+
+  chirp_fft_.resize(fft_length);
+  bluestein_fft_->Transform(b.data(), chirp_fft_.data(), nullptr);
+}
+
+template <typename T>
+void ComplexFFT<T>::TransformRadix2(const std::complex<T>* input, std::complex<T>* output) const {
+  for (size_t i = 0; i < length_; ++i) {
+    output[i] = input[bit_reversed_[i]];
+  }
+
+  for (size_t size = 2; size <= length_; size <<= 1) {
+    const size_t half_size = size >> 1;
+    const size_t twiddle_step = length_ / size;
+    for (size_t begin = 0; begin < length_; begin += size) {
+      std::complex<T>* even = output + begin;
+      std::complex<T>* odd = even + half_size;
+      for (size_t k = 0; k < half_size; ++k) {
+        const std::complex<T> u = even[k];
+        const std::complex<T> v = Multiply(odd[k], twiddles_[k * twiddle_step]);
+        even[k] = u + v;
+        odd[k] = u - v;
+      }
+    }
+  }
+}
+
+template <typename T>
+void ComplexFFT<T>::Transform(const std::complex<T>* input, std::complex<T>* output,
+                              std::complex<T>* scratch) const {
+  if (!bluestein_fft_) {
+    TransformRadix2(input, output);
+    return;
+  }
+
+  const size_t fft_length = bluestein_fft_->Length();
+  std::complex<T>* a = scratch;
+  std::complex<T>* a_fft = scratch + fft_length;
+
+  for (size_t n = 0; n < length_; ++n) {
+    a[n] = Multiply(input[n], chirp_[n]);
+  }
+  std::fill(a + length_, a + fft_length, std::complex<T>());
+  bluestein_fft_->Transform(a, a_fft, nullptr);
+
+  // the inverse FFT of the product is the conjugate of the forward FFT of its conjugate
+  for (size_t i = 0; i < fft_length; ++i) {
+    a_fft[i] = std::conj(Multiply(a_fft[i], chirp_fft_[i]));
+  }
+  bluestein_fft_->Transform(a_fft, a, nullptr);
+
+  for (size_t k = 0; k < length_; ++k) {
+    output[k] = Multiply(std::conj(a[k]), chirp_[k]);
+  }
+}
+
+template <typename T>
+FFTPlan<T>::FFTPlan(size_t length, bool inverse, bool real_input)
+    : length_(length), scale_(inverse ? static_cast<T>(1.0 / static_cast<double>(length)) : T(1)) {
+  if (real_input && length % 2 == 0) {
+    const size_t half_length = length / 2;
+    half_fft_ = std::make_unique<ComplexFFT<T>>(half_length, inverse);
+    split_twiddles_.resize(half_length + 1);
+    for (size_t k = 0; k <= half_length; ++k) {
+      split_twiddles_[k] = UnitRoot<T>((inverse ? 2.0 : -2.0) * static_cast<double>(k), static_cast<double>(length));
+    }
+  } else {
+    fft_ = std::make_unique<ComplexFFT<T>>(length, inverse);
+  }
+}
+
+template <typename T>
+size_t FFTPlan<T>::ScratchSize() const {
+  if (half_fft_) {
+    return length_ + half_fft_->ScratchSize();
+  }
+  return 2 * length_ + fft_->ScratchSize();
+}
+
+template <typename T>
+template <typename U>
+void FFTPlan<T>::ExecuteComplex(const U* x, size_t x_stride, size_t num_samples, const T* window,
+                                std::complex<T>* y, size_t y_stride, size_t output_size,
+                                std::complex<T>* scratch) const {
+  std::complex<T>* input = scratch;
+  std::complex<T>* output = scratch + length_;
+
+  num_samples = std::min(num_samples, length_);
+  for (size_t n = 0; n < num_samples; ++n) {
+    input[n] = std::complex<T>(x[n * x_stride]);
+    if (window) {
+      input[n] *= window[n];
+    }
+  }
+  std::fill(input + num_samples, input + length_, std::complex<T>());
+
+  fft_->Transform(input, output, scratch + 2 * length_);
+
+  for (size_t k = 0; k < output_size; ++k) {
+    y[k * y_stride] = output[k] * scale_;
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Execute(const T* x, size_t x_stride, size_t num_samples, const T* window, std::complex<T>* y,
+                         size_t y_stride, size_t output_size, std::complex<T>* scratch) const {
+  if (!half_fft_) {
+    ExecuteComplex(x, x_stride, num_samples, window, y, y_stride, output_size, scratch);
+    return;
+  }
+
+  // pack the even samples as the real parts and the odd samples as the imaginary parts
+  const size_t half_length = length_ / 2;
+  std::complex<T>* packed = scratch;
+  std::complex<T>* packed_fft = scratch + half_length;
+
+  num_samples = std::min(num_samples, length_);
+  auto sample = [&](size_t n) {
+    if (n >= num_samples) {
+      return T(0);
+    }
+    return window ? x[n * x_stride] * window[n] : x[n * x_stride];
+  };
+  for (size_t n = 0; n < half_length; ++n) {
+    packed[n] = std::complex<T>(sample(2 * n), sample(2 * n + 1));
+  }
+
+  half_fft_->Transform(packed, packed_fft, scratch + length_);
+
+  // the transforms of the even and odd samples are the conjugate-symmetric and conjugate-antisymmetric parts of
+  // the packed transform, and x_k = even_k + exp(+-2 pi i k / length) * odd_k
+  const T half = static_cast<T>(0.5);
+  for (size_t k = 0; k < output_size; ++k) {
+    const size_t bin = k <= half_length ? k : length_ - k;
+    const std::complex<T> z = packed_fft[bin % half_length];
+    const std::complex<T> z_mirror = std::conj(packed_fft[(half_length - bin) % half_length]);
+    const std::complex<T> even = (z + z_mirror) * half;
+    const std::complex<T> difference = (z - z_mirror) * half;
+    const std::complex<T> odd(difference.imag(), -difference.real());
+    const std::complex<T> value = (even + Multiply(split_twiddles_[bin], odd)) * scale_;
+    y[k * y_stride] = k <= half_length ? value : std::conj(value);
+  }
+}
+
+template <typename T>
+void FFTPlan<T>::Execute(const std::complex<T>* x, size_t x_stride, size_t num_samples, const T* window,
+                         std::complex<T>* y, size_t y_stride, size_t output_size,
+                         std::complex<T>* scratch) const {
+  ExecuteComplex(x, x_stride, num_samples, window, y, y_stride, output_size, scratch);
+}
+
+template <typename T>
+std::shared_ptr<const FFTPlan<T>> FFTPlanCache<T>::Get(size_t length, bool inverse, bool real_input) {
+  const auto key = std::make_tuple(length, inverse, real_input);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = plans_.find(key);
+  if (it == plans_.end()) {
+    // Bound the cache for models whose input shapes keep changing
+    constexpr size_t kMaxCachedPlans = 64;
+    if (plans_.size() >= kMaxCachedPlans) {
+      plans_.clear();
+    }
+    it = plans_.emplace(key, std::make_shared<const FFTPlan<T>>(length, inverse, real_input)).first;
+  }
+
+  return it->second;
+}
+
+template class ComplexFFT<float>;
+template class ComplexFFT<double>;
+template class FFTPlan<float>;
+template class FFTPlan<double>;
+template class FFTPlanCache<float>;
+template class FFTPlanCache<double>;
+
+}  // namespace signal
+}  // namespace onnxruntime
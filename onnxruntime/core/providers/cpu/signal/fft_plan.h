@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace signal {
+
+// An unscaled complex FFT of one length and direction, with its twiddles computed once.
+// Power of 2 lengths run an iterative radix-2 transform, and other lengths run Bluestein's algorithm as a
+// convolution with the chirp, whose transform is computed when the FFT is created.
+template <typename T>
+class ComplexFFT {
+ public:
+  ComplexFFT(size_t length, bool inverse);
+
+  size_t Length() const { return length_; }
+
+  // The number of complex elements of scratch space Transform needs.
+  size_t ScratchSize() const { return bluestein_fft_ ? 2 * bluestein_fft_->Length() : 0; }
+
+  // Transforms the length elements of input to output, which must not overlap.
+  void Transform(const std::complex<T>* input, std::complex<T>* output, std::complex<T>* scratch) const;
+
+ private:
+  void TransformRadix2(const std::complex<T>* input, std::complex<T>* output) const;
+
+  size_t length_;
+
+  // radix-2: the bit-reversed permutation, and exp(+-2 pi i k / length) for k < length / 2
+  std::vector<size_t> bit_reversed_;
+  std::vector<std::complex<T>> twiddles_;
+
+  // Bluestein: the chirp exp(+-pi i k^2 / length), the forward transform of its conjugate divided by the length
+  // of the power of 2 FFT that runs the convolution, and that FFT
+  std::vector<std::complex<T>> chirp_;
+  std::vector<std::complex<T>> chirp_fft_;
+  std::unique_ptr<ComplexFFT<T>> bluestein_fft_;
+};
+
+// The transform of signals of one DFT length and direction, as run by DFT and STFT.
+//
+// A real signal of even length is packed as a complex signal of half the length, whose transform is split into the
+// spectrum of the real signal, so it takes half the work of the complex transform. The rest of the spectrum is the
+// conjugate of the first half.
+template <typename T>
+class FFTPlan {
+ public:
+  FFTPlan(size_t length, bool inverse, bool real_input);
+
+  // The number of complex elements of scratch space Execute needs.
+  size_t ScratchSize() const;
+
+  // Transforms the first num_samples elements of x, read with x_stride and multiplied by the window if it is
+  // given, and padded with zeros up to the DFT length, writing the first output_size elements of the
+  // spectrum to y with y_stride. The inverse transform is divided by the DFT length.
+  void Execute(const T* x, size_t x_stride, size_t num_samples, const T* window, std::complex<T>* y,
+               size_t y_stride, size_t output_size, std::complex<T>* scratch) const;
+  void Execute(const std::complex<T>* x, size_t x_stride, size_t num_samples, const T* window, std::complex<T>* y,
+               size_t y_stride, size_t output_size, std::complex<T>* scratch) const;
+
+ private:
+  template <typename U>
+  void ExecuteComplex(const U* x, size_t x_stride, size_t num_samples, const T* window, std::complex<T>* y,
+                      size_t y_stride, size_t output_size, std::complex<T>* scratch) const;
+
+  size_t length_;
+  T scale_;
+
+  // set for a real signal of even length, with exp(+-2 pi i k / length) for k <= length / 2
+  std::unique_ptr<ComplexFFT<T>> half_fft_;
+  std::vector<std::complex<T>> split_twiddles_;
+
+  // set otherwise
+  std::unique_ptr<ComplexFFT<T>> fft_;
+};
+
+// A bounded cache of FFT plans by length, direction and whether the signal is real, so a kernel computes the
+// twiddles of each DFT length once. The plans are shared, so a plan stays valid while it is used even if the
+// cache is cleared.
+template <typename T>
+class FFTPlanCache {
+ public:
+  std::shared_ptr<const FFTPlan<T>> Get(size_t length, bool inverse, bool real_input);
+
+ private:
+  std::mutex mutex_;
+  std::map<std::tuple<size_t, bool, bool>, std::shared_ptr<const FFTPlan<T>>> plans_;
+};
+
+}  // namespace signal
+}  // namespace onnxruntime
@@ -0,0 +1,229 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tensor/broadcast_plan.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+
+namespace onnxruntime {
+
+namespace {
+
+template <typename T>
+void FillTyped(void* dst, const void* value, size_t count) {
+  T element;
+  memcpy(&element, value, sizeof(T));
+  std::fill_n(static_cast<T*>(dst), count, element);
+}
+
+}  // namespace
+
+void FillElements(void* dst, const void* value, size_t count, size_t element_size) {
+  if (count == 0) {
+    return;
+  }
+
+  switch (element_size) {
+    case 1:
+      memset(dst, *static_cast<const uint8_t*>(value), count);
+      break;
+    case 2:
+      FillTyped<uint16_t>(dst, value, count);
+      break;
+    case 4:
+      FillTyped<uint32_t>(dst, value, count);
+      break;
+    case 8:
+      FillTyped<uint64_t>(dst, value, count);
+      break;
+    default:
+      memcpy(dst, value, element_size);
+      ReplicateBlock(dst, element_size, count);
+      break;
+  }
+}
+
+void ReplicateBlock(void* dst, size_t block_bytes, size_t num_blocks) {
+  auto* output = static_cast<uint8_t*>(dst);
+  const size_t total_bytes = SafeInt<size_t>(block_bytes) * num_blocks;
+  for (size_t copied = block_bytes; copied < total_bytes;) {
+    const size_t bytes = std::min(copied, total_bytes - copied);
+    memcpy(output + copied, output, bytes);
+    copied += bytes;
+  }
+}
+
+Status BroadcastPlan::Create(gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims,
+                             BroadcastPlan& plan) {
+  if (input_dims.size() > output_dims.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Cannot broadcast an input of rank ", input_dims.size(),
+                           " to an output of rank ", output_dims.size());
+  }
+
+  plan.dims_.clear();
+  plan.input_strides_.clear();
+  plan.num_output_elements_ = 1;
+
+  // collapse the dims into loops, using the stride 0 to mark the repeated loops until the strides are computed
+  const size_t leading_dims = output_dims.size() - input_dims.size();
+  for (size_t i = 0; i < output_dims.size(); ++i) {
+    const int64_t input_dim = i < leading_dims ? 1 : input_dims[i - leading_dims];
+    const int64_t output_dim = output_dims[i];
+    if (input_dim != output_dim && input_dim != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Cannot broadcast the input dim ", input_dim,
+                             " to the output dim ", output_dim);
+    }
+
+    plan.num_output_elements_ *= narrow<size_t>(output_dim);
+    if (output_dim == 1) {
+      continue;
+    }
+
+    const int64_t repeated = input_dim != output_dim ? 0 : 1;
+    if (!plan.dims_.empty() && plan.input_strides_.back() == repeated) {
+      plan.dims_.back() *= output_dim;
+    } else {
+      plan.dims_.push_back(output_dim);
+      plan.input_strides_.push_back(repeated);
+    }
+  }
+
+  if (plan.dims_.empty()) {
+    // the output has a single element
+    plan.dims_.push_back(1);
+    plan.input_strides_.push_back(1);
+  }
+
+  int64_t input_stride = 1;
+  for (size_t i = plan.dims_.size(); i-- > 0;) {
+    if (plan.input_strides_[i] != 0) {
+      plan.input_strides_[i] = input_stride;
+      input_stride *= plan.dims_[i];
+    }
+  }
+
+  return Status::OK();
+}
+
+void BroadcastPlan::Execute(const void* input, void* output, size_t element_size,
+                            concurrency::ThreadPool* tp) const {
+  if (num_output_elements_ == 0) {
+    return;
+  }
+
+  const auto* src = static_cast<const uint8_t*>(input);
+  auto* dst = static_cast<uint8_t*>(output);
+
+  const size_t num_loops = dims_.size();
+  const size_t row_size = narrow<size_t>(dims_[num_loops - 1]);
+  const bool fill_row = input_strides_[num_loops - 1] == 0;
+  size_t num_outer_loops = num_loops - 1;
+  size_t num_blocks = num_output_elements_ / row_size;
+
+  // a copied row and the repeated loop outside of it are one block, unless there'd be too few blocks to share
+  // between the threads, in which case the rows are copied from the input by each thread
+  size_t row_repeats = 1;
+  if (!fill_row && num_outer_loops > 0) {
+    const size_t repeats = narrow<size_t>(dims_[num_outer_loops - 1]);
+    if (num_blocks / repeats >= static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(tp))) {
+      row_repeats = repeats;
+      num_blocks /= repeats;
+      --num_outer_loops;
+    }
+  }
+
+  if (num_blocks == 1 && row_repeats == 1) {
+    // a single row, so split it between the threads
+    concurrency::ThreadPool::TryParallelFor(
+        tp, narrow<std::ptrdiff_t>(row_size),
+        TensorOpCost{static_cast<double>(element_size), static_cast<double>(element_size), 1.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          const size_t offset = static_cast<size_t>(first) * element_size;
+          const size_t count = static_cast<size_t>(last - first);
+          if (fill_row) {
+            FillElements(dst + offset, src, count, element_size);
+          } else {
+            memcpy(dst + offset, src + offset, count * element_size);
+          }
+        });
+    return;
+  }
+
+  const size_t row_bytes = row_size * element_size;
+  const size_t block_bytes = row_bytes * row_repeats;
+  const double input_bytes = fill_row ? static_cast<double>(element_size) : static_cast<double>(row_bytes);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_blocks),
+      TensorOpCost{input_bytes, static_cast<double>(block_bytes), static_cast<double>(row_repeats)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // the position of the first block in the outer loops, and its input offset
+        TensorShapeVector counters(num_outer_loops);
+        int64_t input_offset = 0;
+        for (size_t i = num_outer_loops, remaining = static_cast<size_t>(first); i-- > 0;) {
+          const size_t dim = narrow<size_t>(dims_[i]);
+          counters[i] = static_cast<int64_t>(remaining % dim);
+          remaining /= dim;
+          input_offset += counters[i] * input_strides_[i];
+        }
+
+        uint8_t* block = dst + static_cast<size_t>(first) * block_bytes;
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const uint8_t* row = src + static_cast<size_t>(input_offset) * element_size;
+          if (fill_row) {
+            FillElements(block, row, row_size, element_size);
+          } else {
+            memcpy(block, row, row_bytes);
+          }
+
+          if (row_repeats > 1) {
+            ReplicateBlock(block, row_bytes, row_repeats);
+          }
+
+          block += block_bytes;
+
+          for (size_t i = num_outer_loops; i-- > 0;) {
+            input_offset += input_strides_[i];
+            if (++counters[i] < dims_[i]) {
+              break;
+            }
+
+            input_offset -= counters[i] * input_strides_[i];
+            counters[i] = 0;
+          }
+        }
+      });
+}
+
+Status BroadcastPlanCache::Get(gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims,
+                               BroadcastPlan& plan) {
+  std::vector<int64_t> key;
+  key.reserve(input_dims.size() + output_dims.size() + 1);
+  key.push_back(static_cast<int64_t>(input_dims.size()));
+  key.insert(key.end(), input_dims.begin(), input_dims.end());
+  key.insert(key.end(), output_dims.begin(), output_dims.end());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto it = plans_.find(key);
+  if (it == plans_.end()) {
+    BroadcastPlan new_plan;
+    ORT_RETURN_IF_ERROR(BroadcastPlan::Create(input_dims, output_dims, new_plan));
+
+    // Bound the cache for models whose input shapes keep changing
+    constexpr size_t kMaxCachedPlans = 64;
+    if (plans_.size() >= kMaxCachedPlans) {
+      plans_.clear();
+    }
+    it = plans_.emplace(std::move(key), std::move(new_plan)).first;
+  }
+
+  plan = it->second;
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Fills count elements of element_size bytes at dst with the element at value.
+// Elements of 1, 2, 4 and 8 bytes are stored with a typed loop that the compiler vectorizes.
+void FillElements(void* dst, const void* value, size_t count, size_t element_size);
+
+// Repeats the block of block_bytes bytes at the start of dst so dst holds num_blocks copies of it.
+// Each memcpy copies everything written so far, so a small block takes a logarithmic number of calls.
+void ReplicateBlock(void* dst, size_t block_bytes, size_t num_blocks);
+
+// The loops of copying an input to an output that broadcasts it, as done by Expand and Tile.
+//
+// An output dim is either copied from the input, or repeated where the input dim is 1. Adjacent dims of the same
+// kind are collapsed into one, so a broadcast of any rank runs as alternating copied and repeated loops. The
+// innermost loop is a memcpy of a row when it is copied, or a fill of a column from one input element when it is
+// repeated, and a repeated loop right outside a copied row replicates the row block in the output.
+class BroadcastPlan {
+ public:
+  // Creates the plan of broadcasting an input of input_dims to output_dims. The input dims are aligned with the
+  // innermost output dims, and each must be 1 or equal to its output dim.
+  static Status Create(gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims,
+                       BroadcastPlan& plan);
+
+  size_t NumOutputElements() const { return num_output_elements_; }
+
+  // Copies the input with elements of element_size bytes to the output, splitting the loops between the threads.
+  void Execute(const void* input, void* output, size_t element_size, concurrency::ThreadPool* tp) const;
+
+ private:
+  // the collapsed loops from the outermost, with the input stride of each in elements, which is 0 for a repeated loop
+  TensorShapeVector dims_;
+  TensorShapeVector input_strides_;
+  size_t num_output_elements_{0};
+};
+
+// A bounded cache of broadcast plans by input and output dims, so a kernel plans each shape once.
+class BroadcastPlanCache {
+ public:
+  Status Get(gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims, BroadcastPlan& plan);
+
+ private:
+  std::mutex mutex_;
+  std::map<std::vector<int64_t>, BroadcastPlan> plans_;
+};
+
+}  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <string>
@@ -15,17 +16,12 @@
 #include "core/framework/data_types.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
 
-#include "Eigen/src/Core/arch/Default/BFloat16.h"
-#include "Eigen/src/Core/arch/Default/Half.h"
-
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-#include "core/mlas/inc/mlas.h"
-#endif
-
 namespace onnxruntime {
 
 namespace op_kernel_type_control {
@@ -161,36 +157,94 @@ CastFromString(const std::string& input, DstType& output) {
   output = DstType(intermediate);
 }
 
-// type that is usable with Eigen cast
-template <typename T>
-struct EigenCastType {
-  using type = T;
+// Runs cast_range(first, last) over the elements of a tensor, split across the intra-op threads by the bytes each
+// element reads and writes.
+template <typename SrcType, typename DstType, typename CastRange>
+void ParallelCast(const OpKernelContext& context, std::ptrdiff_t count, const CastRange& cast_range) {
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), count,
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), 1.0},
+      cast_range);
+}
+
+// generic tensor X -> Y
+template <typename SrcType, typename DstType, typename Enable = void>
+struct TensorCaster {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
+    const auto* in_data = in.Data<SrcType>();
+    auto* out_data = out.MutableData<DstType>();
+    ParallelCast<SrcType, DstType>(context, shape_size, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      const auto in_vector = ConstEigenVectorMap<SrcType>(in_data + first, last - first);
+      auto out_vector = EigenVectorMap<DstType>(out_data + first, last - first);
+      out_vector = in_vector.template cast<DstType>();
+    });
+  }
 };
 
-// ORT float16 types don't support Eigen cast, so map them to Eigen ones
+// buffer X -> float, with the MLAS routines for the float 16 types
+template <typename SrcType>
+void ConvertToFloat(const SrcType* in, float* out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = static_cast<float>(in[i]);
+  }
+}
 
 template <>
-struct EigenCastType<MLFloat16> {
-  using type = Eigen::half;
-};
+void ConvertToFloat(const MLFloat16* in, float* out, size_t count) {
+  MlasConvertHalfToFloatBuffer(&in[0].val, out, count);
+}
 
 template <>
-struct EigenCastType<BFloat16> {
-  using type = Eigen::bfloat16;
-};
-// generic tensor X -> Y
-template <typename SrcType, typename DstType, typename Enable = void>
-struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    using SrcEigenCastType = typename EigenCastType<SrcType>::type;
-    using DstEigenCastType = typename EigenCastType<DstType>::type;
+void ConvertToFloat(const BFloat16* in, float* out, size_t count) {
+  MlasConvertBFloat16ToFloatBuffer(&in[0].val, out, count);
+}
+
+// buffer float -> X, with the MLAS routines for the float 16 types
+template <typename DstType>
+void ConvertFromFloat(const float* in, DstType* out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = static_cast<DstType>(in[i]);
+  }
+}
 
+template <>
+void ConvertFromFloat(const float* in, MLFloat16* out, size_t count) {
+  MlasConvertFloatToHalfBuffer(in, &out[0].val, count);
+}
+
+template <>
+void ConvertFromFloat(const float* in, BFloat16* out, size_t count) {
+  MlasConvertFloatToBFloat16Buffer(in, &out[0].val, count);
+}
+
+// tensor X -> Y where X or Y is MLFloat16 or BFloat16.
+// The elements are converted through float, which is also how the float 16 types convert element by element, in
+// blocks small enough for the intermediate buffer to stay in the L1 cache.
+template <typename SrcType, typename DstType>
+struct TensorCaster<SrcType, DstType,
+                    std::enable_if_t<(IsOrtFloat16Type<SrcType>::value || IsOrtFloat16Type<DstType>::value) &&
+                                     !std::is_same_v<SrcType, std::string> &&
+                                     !std::is_same_v<DstType, std::string>>> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
     const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+    const auto* in_data = in.Data<SrcType>();
+    auto* out_data = out.MutableData<DstType>();
+    ParallelCast<SrcType, DstType>(context, shape_size, [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+      if constexpr (std::is_same_v<SrcType, float>) {
+        ConvertFromFloat(in_data + first, out_data + first, static_cast<size_t>(last - first));
+      } else if constexpr (std::is_same_v<DstType, float>) {
+        ConvertToFloat(in_data + first, out_data + first, static_cast<size_t>(last - first));
+      } else {
+        constexpr std::ptrdiff_t kBlockSize = 1024;
+        float buffer[kBlockSize];
+        for (std::ptrdiff_t block = first; block < last; block += kBlockSize) {
+          const size_t count = static_cast<size_t>(std::min(kBlockSize, last - block));
+          ConvertToFloat(in_data + block, buffer, count);
+          ConvertFromFloat(buffer, out_data + block, count);
+        }
+      }
+    });
   }
 };
 
@@ -252,55 +306,6 @@ struct TensorCasterNoSat<std::string, DstType> {
 
 #endif
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
-
-// tensor MLFloat16 -> float
-template <>
-struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-  }
-};
-
-Tensor GetIntermediateMLFloat16ToFloatTensor(
-    const OpKernelContext& context, const TensorShape& shape, const Tensor& in) {
-  AllocatorPtr allocator;
-  ORT_THROW_IF_ERROR(context.GetTempSpaceAllocator(&allocator));
-  Tensor out{DataTypeImpl::GetType<float>(), shape, allocator};
-  TensorCaster<MLFloat16, float>{}.Cast(context, shape, in, out);
-  return out;
-}
-
-template <typename DstType>
-void CastMLFloat16ThroughFloatTensor(
-    const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) {
-  // use optimized MLFloat16 -> float, then float -> DstType
-  Tensor intermediate_tensor = GetIntermediateMLFloat16ToFloatTensor(context, shape, in);
-  TensorCaster<float, DstType>{}.Cast(context, shape, intermediate_tensor, out);
-}
-
-// tensor MLFloat16 -> X
-template <typename DstType>
-struct TensorCaster<MLFloat16, DstType> {
-  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    CastMLFloat16ThroughFloatTensor<DstType>(context, shape, in, out);
-  }
-};
-
-// tensor MLFloat16 -> string
-template <>
-struct TensorCaster<MLFloat16, std::string> {
-  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
-  }
-};
-#endif
-
 class Cast final : public OpKernel {
  public:
   Cast(const OpKernelInfo& info) : OpKernel(info) {
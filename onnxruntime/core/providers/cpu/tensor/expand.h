@@ -6,6 +6,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/broadcast_plan.h"
 
 namespace onnxruntime {
 
@@ -14,6 +15,9 @@ class Expand final : public OpKernel {
  public:
   Expand(const OpKernelInfo& info) : OpKernel(info) {}
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  mutable BroadcastPlanCache broadcast_plans_;
 };
 
 }  // namespace onnxruntime
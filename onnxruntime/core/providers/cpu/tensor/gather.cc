@@ -9,6 +9,7 @@
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/providers/cpu/tensor/gather_scatter_copy.h"
 
 namespace onnxruntime {
 
@@ -102,6 +103,22 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
+  if (!is_string_type) {
+    // the gathered blocks are contiguous in the output
+    CopySlices(
+        src_base, dst_base, SafeInt<size_t>(M) * N, narrow<size_t>(block_size),
+        [&](size_t index) {
+          const int64_t batch = static_cast<int64_t>(index) / N;
+          const int64_t i = static_cast<int64_t>(index) % N;
+          Tin idx = indices_data[i];
+          idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
+          return SliceCopyOffsets{narrow<size_t>(batch * data_batch_bytes + idx * block_size),
+                                  index * narrow<size_t>(block_size)};
+        },
+        tp);
+    return Status::OK();
+  }
+
   auto lambda = [&](int64_t index) {
     int64_t batch = index / N;
     int64_t i = index % N;
@@ -113,12 +130,8 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     const int64_t src_offset = src_offset_batch + idx * block_size;
     const int64_t dst_offset = dst_offset_batch + i * block_size;
 
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, narrow<size_t>(block_size));
-    }
+    reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
+        reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
   };
   concurrency::ThreadPool::TryParallelFor(tp, SafeInt<ptrdiff_t>(M) * N, static_cast<double>(block_size),
                                           [&lambda](ptrdiff_t first, ptrdiff_t last) {
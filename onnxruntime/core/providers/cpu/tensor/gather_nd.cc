@@ -3,6 +3,7 @@
 #include <core/common/safeint.h>
 #include "gather_nd.h"
 #include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/gather_scatter_copy.h"
 
 namespace onnxruntime {
 
@@ -177,17 +178,15 @@ Status GatherND::Compute(OpKernelContext* context) const {
 }
 
 Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t slice_idx) {
-    memcpy(p.output_base + slice_idx * p.bytes_per_slice, p.input_base + p.slice_offsets[onnxruntime::narrow<size_t>(slice_idx)] * p.element_bytes,
-           onnxruntime::narrow<size_t>(p.bytes_per_slice));
-  };
-  concurrency::ThreadPool::TryParallelFor(
-      tp, p.slice_offsets.size(), static_cast<double>(p.bytes_per_slice),
-      [&lambda](ptrdiff_t first, ptrdiff_t last) {
-        for (int slice_idx = static_cast<int>(first), end = static_cast<int>(last); slice_idx < end; ++slice_idx) {
-          lambda(slice_idx);
-        }
-      });
+  const size_t bytes_per_slice = onnxruntime::narrow<size_t>(p.bytes_per_slice);
+  const size_t element_bytes = onnxruntime::narrow<size_t>(p.element_bytes);
+  CopySlices(
+      p.input_base, p.output_base, p.slice_offsets.size(), bytes_per_slice,
+      [&](size_t slice_idx) {
+        return SliceCopyOffsets{onnxruntime::narrow<size_t>(p.slice_offsets[slice_idx]) * element_bytes,
+                                slice_idx * bytes_per_slice};
+      },
+      tp);
   return Status::OK();
 }
 
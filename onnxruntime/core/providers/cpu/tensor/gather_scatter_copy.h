@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// The byte offsets of one slice in the source and the destination of a slice copy.
+struct SliceCopyOffsets {
+  size_t src;
+  size_t dst;
+};
+
+// Copies num_slices slices of slice_bytes bytes each from src to dst, as done by the Gather and Scatter ops.
+// get_offsets(i) returns the SliceCopyOffsets of slice i.
+//
+// The per slice overhead dominates for the small slices of embedding lookups, so slices of the common small
+// sizes are copied with a memcpy of a size known at compile time, which is lowered to a few vector moves rather
+// than a call to the library routine. The slices are split between the threads by the number of bytes copied.
+template <typename GetOffsets>
+void CopySlices(const uint8_t* src, uint8_t* dst, size_t num_slices, size_t slice_bytes,
+                const GetOffsets& get_offsets, concurrency::ThreadPool* tp) {
+  const TensorOpCost cost{static_cast<double>(slice_bytes), static_cast<double>(slice_bytes), 1.0};
+
+  auto copy_slices = [&](auto bytes) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_slices), cost,
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const SliceCopyOffsets offsets = get_offsets(static_cast<size_t>(i));
+            memcpy(dst + offsets.dst, src + offsets.src, bytes);
+          }
+        });
+  };
+
+  switch (slice_bytes) {
+    case 1:
+      copy_slices(std::integral_constant<size_t, 1>{});
+      break;
+    case 2:
+      copy_slices(std::integral_constant<size_t, 2>{});
+      break;
+    case 4:
+      copy_slices(std::integral_constant<size_t, 4>{});
+      break;
+    case 8:
+      copy_slices(std::integral_constant<size_t, 8>{});
+      break;
+    case 12:
+      copy_slices(std::integral_constant<size_t, 12>{});
+      break;
+    case 16:
+      copy_slices(std::integral_constant<size_t, 16>{});
+      break;
+    case 24:
+      copy_slices(std::integral_constant<size_t, 24>{});
+      break;
+    case 32:
+      copy_slices(std::integral_constant<size_t, 32>{});
+      break;
+    case 48:
+      copy_slices(std::integral_constant<size_t, 48>{});
+      break;
+    case 64:
+      copy_slices(std::integral_constant<size_t, 64>{});
+      break;
+    default:
+      copy_slices(slice_bytes);
+      break;
+  }
+}
+
+}  // namespace onnxruntime
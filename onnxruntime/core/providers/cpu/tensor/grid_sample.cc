@@ -3,11 +3,15 @@
 
 #include "core/providers/cpu/tensor/grid_sample.h"
 
+#include <vector>
+
+#include "core/common/narrow.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/providers/common.h"
 #include "core/framework/copy.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -98,23 +102,43 @@ T GsBicubicInterpolate(T p[4][4], float x, float y) {
 }
 
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
-  T pixel = {};  // default 0
+int64_t GridSample<T>::OffsetAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const float border[/* 4 */]) const {
   if (padding_mode_ == Zeros) {
     if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
+      return r * W + c;
     }
+    return -1;
   } else if (padding_mode_ == Border) {
     c = std::clamp<int64_t>(c, 0, W - 1);
     r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
   } else {  // (padding_mode_ == Reflection)
     c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
     r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
   }
-  return pixel;
+  return r * W + c;
+}
+
+template <typename T>
+T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
+  const int64_t offset = OffsetAtGrid(r, c, H, W, border);
+  return offset >= 0 ? image[offset] : T{};  // default 0
+}
+
+namespace {
+// Source pixels and weights of one output pixel in bilinear or nearest mode. They only depend on the grid so
+// they are computed once per output pixel and shared by all the channels. Padding is already applied: zero
+// padded taps have offset -1.
+template <typename T>
+struct GsTaps {
+  int64_t offset[4];
+  T weight[4];
+};
+
+template <typename T>
+inline T GsTapValue(const T* image, int64_t offset) {
+  return offset >= 0 ? image[offset] : T{};
 }
+}  // namespace
 
 // When grid sampling, padding is applied before interpolation.
 // For instance, in bilinear mode and zeros padding-mode, pixel p at actual
@@ -168,75 +192,134 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
   }
   float border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
 
-  concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-  for (int64_t n = 0; n < N; n++) {
-    const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-        [&](std::ptrdiff_t c) {
-          const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
-          T* Y_data = Y.MutableData<T>() + (n * C + c) * (H_out * W_out);
-
-          for (int64_t oy = 0; oy < H_out; oy++) {
-            for (int64_t ox = 0; ox < W_out; ox++) {
-              const T* gridpoint = grid_data + (oy * W_out + ox) * 2;
-              T* Y_gridpoint = Y_data + oy * W_out + ox;
-              auto nx = gridpoint[0];  // normalized location
-              auto ny = gridpoint[1];
-              auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-              auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-
-              if (mode_ == Nearest) {
-                x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
-                y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
-              }
+  const int64_t plane_in = H_in * W_in;
+  const int64_t plane_out = H_out * W_out;
 
-              if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
-                if (padding_mode_ == Border) {
-                  // use original border in both align_corner cases
-                  x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
-                  y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
-                } else if (padding_mode_ == Reflection) {
-                  x = GsReflect(x, x_min, x_max);
-                  y = GsReflect(y, y_min, y_max);
-                }
-              }  // out of bound
+  // Maps a normalized grid point to its actual location in the input image, with the out of bound handling
+  // of the padding mode applied.
+  auto source_location = [&](const T* gridpoint, T& x, T& y) {
+    auto nx = gridpoint[0];  // normalized location
+    auto ny = gridpoint[1];
+    x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
+    y = GsDenormalize<T>(ny, H_in, align_corners_);
+
+    if (mode_ == Nearest) {
+      x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
+      y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
+    }
+
+    if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
+      if (padding_mode_ == Border) {
+        // use original border in both align_corner cases
+        x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
+        y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
+      } else if (padding_mode_ == Reflection) {
+        x = GsReflect(x, x_min, x_max);
+        y = GsReflect(y, y_min, y_max);
+      }
+    }  // out of bound
+  };
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  if (mode_ == Bicubic) {
+    // sample every (n, c) plane independently
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(N * C),
+        TensorOpCost{static_cast<double>(plane_out * 16 * sizeof(T)), static_cast<double>(plane_out * sizeof(T)),
+                     static_cast<double>(plane_out * 64)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t nc = first; nc < last; ++nc) {
+            const int64_t n = nc / C;
+            const T* grid_data = grid->Data<T>() + n * plane_out * 2;
+            const T* X_data = input->Data<T>() + nc * plane_in;
+            T* Y_data = Y.MutableData<T>() + nc * plane_out;
 
-              if (mode_ == Nearest) {
-                // x, y are integers in all padding modes
-                *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                continue;
+            for (int64_t i = 0; i < plane_out; i++) {
+              T x, y;
+              source_location(grid_data + i * 2, x, y);
+              int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+              int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
+              T p[4][4] = {};  // [H][W]
+              for (int64_t h = 0; h < 4; h++) {
+                for (int64_t w = 0; w < 4; w++) {
+                  p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
+                }
               }
+              T dx = static_cast<T>(x - x0 - 1);
+              T dy = static_cast<T>(y - y0 - 1);
+              Y_data[i] = GsBicubicInterpolate(p, static_cast<float>(dx), static_cast<float>(dy));
+            }
+          }
+        });
+    return Status::OK();
+  }
+
+  // Bilinear and nearest: resolve the source pixels and weights of every output pixel of a batch once, then
+  // every channel is a branch free weighted gather.
+  const int num_taps = mode_ == Bilinear ? 4 : 1;
+  std::vector<GsTaps<T>> taps(onnxruntime::narrow<size_t>(plane_out));
+
+  for (int64_t n = 0; n < N; n++) {
+    const T* grid_data = grid->Data<T>() + n * plane_out * 2;
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(plane_out),
+        TensorOpCost{static_cast<double>(2 * sizeof(T)), static_cast<double>(sizeof(GsTaps<T>)), 32.0},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            T x, y;
+            source_location(grid_data + i * 2, x, y);
+            GsTaps<T>& tap = taps[i];
 
-              if (mode_ == Bilinear) {
-                int64_t x1 = static_cast<int64_t>(std::floor(x));
-                int64_t y1 = static_cast<int64_t>(std::floor(y));
-                int64_t x2 = x1 + 1;
-                int64_t y2 = y1 + 1;
-
-                T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                T dx2 = static_cast<T>(x2) - x;
-                T dx1 = x - static_cast<T>(x1);
-                T dy2 = static_cast<T>(y2) - y;
-                T dy1 = y - static_cast<T>(y1);
-                *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
+            if (mode_ == Nearest) {
+              // x, y are integers in all padding modes
+              tap.offset[0] = OffsetAtGrid(static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
+              tap.weight[0] = static_cast<T>(1);
+              continue;
+            }
+
+            int64_t x1 = static_cast<int64_t>(std::floor(x));
+            int64_t y1 = static_cast<int64_t>(std::floor(y));
+            int64_t x2 = x1 + 1;
+            int64_t y2 = y1 + 1;
+
+            T dx2 = static_cast<T>(x2) - x;
+            T dx1 = x - static_cast<T>(x1);
+            T dy2 = static_cast<T>(y2) - y;
+            T dy1 = y - static_cast<T>(y1);
+
+            tap.offset[0] = OffsetAtGrid(y1, x1, H_in, W_in, border);
+            tap.offset[1] = OffsetAtGrid(y1, x2, H_in, W_in, border);
+            tap.offset[2] = OffsetAtGrid(y2, x1, H_in, W_in, border);
+            tap.offset[3] = OffsetAtGrid(y2, x2, H_in, W_in, border);
+            tap.weight[0] = dy2 * dx2;
+            tap.weight[1] = dy2 * dx1;
+            tap.weight[2] = dy1 * dx2;
+            tap.weight[3] = dy1 * dx1;
+          }
+        });
+
+    concurrency::ThreadPool::TryParallelFor(
+        tp, onnxruntime::narrow<std::ptrdiff_t>(C),
+        TensorOpCost{static_cast<double>(plane_out * (sizeof(GsTaps<T>) + num_taps * sizeof(T))),
+                     static_cast<double>(plane_out * sizeof(T)), static_cast<double>(plane_out * num_taps * 2)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t c = first; c < last; ++c) {
+            const T* X_data = input->Data<T>() + (n * C + c) * plane_in;
+            T* Y_data = Y.MutableData<T>() + (n * C + c) * plane_out;
+            const GsTaps<T>* tap = taps.data();
+
+            if (num_taps == 1) {
+              for (int64_t i = 0; i < plane_out; i++) {
+                Y_data[i] = GsTapValue(X_data, tap[i].offset[0]);
               }
-              if (mode_ == Bicubic) {
-                int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-                T p[4][4] = {};  // [H][W]
-                for (int64_t h = 0; h < 4; h++) {
-                  for (int64_t w = 0; w < 4; w++) {
-                    p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                  }
-                }
-                T dx = static_cast<T>(x - x0 - 1);
-                T dy = static_cast<T>(y - y0 - 1);
-                *Y_gridpoint = GsBicubicInterpolate(p, static_cast<float>(dx), static_cast<float>(dy));
+            } else {
+              for (int64_t i = 0; i < plane_out; i++) {
+                Y_data[i] = tap[i].weight[0] * GsTapValue(X_data, tap[i].offset[0]) +
+                            tap[i].weight[1] * GsTapValue(X_data, tap[i].offset[1]) +
+                            tap[i].weight[2] * GsTapValue(X_data, tap[i].offset[2]) +
+                            tap[i].weight[3] * GsTapValue(X_data, tap[i].offset[3]);
               }
             }
           }
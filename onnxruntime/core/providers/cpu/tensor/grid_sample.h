@@ -53,6 +53,8 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
+  // Offset of pixel (r, c) in an H x W image after padding is applied, or -1 for a zero padded pixel
+  int64_t OffsetAtGrid(int64_t r, int64_t c, int64_t H, int64_t W, const float border[/* 4 */]) const;
   T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const;
 
   GridSampleInterpolationMode mode_{Bilinear};
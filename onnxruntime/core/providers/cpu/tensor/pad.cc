@@ -5,6 +5,7 @@
 
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/broadcast_plan.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math.h"
@@ -171,6 +172,17 @@ using PadsVector = PadBase::PadsVector;
 template <typename T>
 static void PadAxis(T* output, T* input, ptrdiff_t input_delta, ptrdiff_t input_pitch,
                     size_t block_size, size_t block_count) {
+  if (input_delta == 1) {
+    // the blocks are contiguous runs of the input. a block never overlaps its source, but it may be the source of
+    // a later block, so the blocks are copied in order.
+    for (size_t block_index = 0; block_index < block_count; block_index++) {
+      memcpy(output, input, block_size * sizeof(T));
+      output += block_size;
+      input += block_size + input_pitch;
+    }
+    return;
+  }
+
   for (size_t block_index = 0; block_index < block_count; block_index++) {
     for (size_t i = 0; i < block_size; i++) {
       *output++ = *input;
@@ -199,11 +211,7 @@ static void PadAxisConstant(T* output, T constant, size_t size) {
     *output = constant;
     *(output + 1) = constant;
   } else {
-    // This would be faster with SSE instructions.
-    // That would mean to have an implementation for each type (uint8, uint32, uint64).
-    T* end = output + size;
-    for (; output != end;)
-      *output++ = constant;
+    FillElements(output, &constant, size, sizeof(T));
   }
 }
 
@@ -7,6 +7,7 @@
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/providers/cpu/tensor/gather_scatter_copy.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
@@ -356,6 +357,21 @@ struct ScatterNDDispatchTarget {
     Prepare<TData> prepare;
     ORT_RETURN_IF_ERROR(PrepareForCompute(context, prepare));
 
+    if constexpr (!std::is_same<TData, std::string>::value) {
+      if (reduction == ScatterND::Reduction::None) {
+        const size_t bytes_to_copy = SafeInt<size_t>(prepare.element_to_copy) * sizeof(TData);
+        CopySlices(
+            reinterpret_cast<const uint8_t*>(prepare.input_base), reinterpret_cast<uint8_t*>(prepare.output_base),
+            prepare.element_offsets.size(), bytes_to_copy,
+            [&](size_t i) {
+              return SliceCopyOffsets{i * bytes_to_copy,
+                                      onnxruntime::narrow<size_t>(prepare.element_offsets[i]) * sizeof(TData)};
+            },
+            tp);
+        return Status::OK();
+      }
+    }
+
     auto lambda = [&](int64_t i) {
       switch (reduction) {
         case ScatterND::Reduction::Add: {
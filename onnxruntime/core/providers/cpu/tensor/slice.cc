@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "core/common/narrow.h"
+#include "core/common/safeint.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
@@ -42,7 +43,9 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
+        .MayViewOutput(0, 0),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -50,7 +53,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     10, 10,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayViewOutput(0, 0),
     Slice10);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -59,7 +63,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     12,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayViewOutput(0, 0),
     Slice10);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -67,7 +72,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     13,
     KernelDefBuilder()
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
-        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
+        .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>())
+        .MayViewOutput(0, 0),
     Slice10);
 
 // Coalesce contiguous non-slice dimensions into a single dimension.
@@ -224,11 +230,59 @@ Status SliceBase::FillVectorsFromInput(const Tensor& start_tensor,
   return Status::OK();
 }
 
+// Check if the output is a contiguous part of the input. That is the case when the outer dimensions have a single
+// element in the output, the next dimension has a step of 1 and the inner dimensions are taken whole.
+// If so, set offset to the index of the first element of the output in the input.
+static bool IsContiguousSlice(gsl::span<const int64_t> input_dims, gsl::span<const int64_t> output_dims,
+                              gsl::span<const int64_t> starts, gsl::span<const int64_t> steps, int64_t& offset) {
+  size_t dim = input_dims.size();
+  while (dim > 0 && output_dims[dim - 1] == input_dims[dim - 1] &&
+         (input_dims[dim - 1] == 1 || (starts[dim - 1] == 0 && steps[dim - 1] == 1))) {
+    --dim;
+  }
+
+  if (dim > 0 && output_dims[dim - 1] != 1 && steps[dim - 1] != 1) {
+    return false;
+  }
+
+  for (size_t i = 0; i + 1 < dim; ++i) {
+    if (output_dims[i] != 1) {
+      return false;
+    }
+  }
+
+  offset = 0;
+  int64_t pitch = 1;
+  for (size_t i = input_dims.size(); i > 0; --i) {
+    offset += starts[i - 1] * pitch;
+    pitch *= input_dims[i - 1];
+  }
+
+  return true;
+}
+
 template <typename T>
 static Status SliceImpl(OpKernelContext* ctx,
                         const Tensor& input_tensor,
                         SliceOp::PrepareForComputeMetadata& compute_metadata) {
   TensorShape output_shape(compute_metadata.output_dims_);
+
+  // a contiguous part of the input doesn't need to be copied if the output can be a view of the input
+  // starts and steps match the flattened dimensions if the dimensions were coalesced
+  const bool flattened = compute_metadata.p_flattened_input_dims_ != nullptr;
+  using ConstDims = gsl::span<const int64_t>;
+  const ConstDims input_dims = flattened ? ConstDims(compute_metadata.flattened_input_dims_)
+                                         : compute_metadata.input_dimensions_;
+  const ConstDims output_dims = flattened ? ConstDims(compute_metadata.flattened_output_dims_)
+                                          : ConstDims(compute_metadata.output_dims_);
+  int64_t view_offset = 0;
+  if (output_shape.Size() > 0 &&
+      IsContiguousSlice(input_dims, output_dims, compute_metadata.starts_, compute_metadata.steps_, view_offset) &&
+      ctx->OutputView(0, 0, output_shape,
+                      SafeInt<ptrdiff_t>(view_offset) * input_tensor.DataType()->Size()) != nullptr) {
+    return Status::OK();
+  }
+
   auto& output_tensor = *ctx->Output(0, output_shape);
 
   // output tensor's size is 0, nothing to fill - return
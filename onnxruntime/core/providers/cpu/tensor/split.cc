@@ -32,8 +32,9 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     2,
     10,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .VariadicMayViewOutput(0),
     Split_1_13);
 
 // Opset 11 starts to support Neg Axis.
@@ -41,8 +42,9 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     11,
     12,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .VariadicMayViewOutput(0),
     Split_1_13);
 
 // Opset 13 starts to supports 'split' as optional input.
@@ -50,16 +52,18 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     13,
     17,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .VariadicMayViewOutput(0),
     Split_1_13);
 
 // TODO: support unequal split and num_outputs
 ONNX_CPU_OPERATOR_KERNEL(
     Split,
     18,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    KernelDefBuilder()
+        .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>())
+        .VariadicMayViewOutput(0),
     Split_18);
 
 Status SplitBase::PrepareForCompute(const TensorShape& input_shape, int num_outputs, int64_t& axis, int& before_dims,
@@ -158,13 +162,23 @@ Status SplitImpl::Compute(OpKernelContext* context) const {
     auto split_size = narrow<int>(split_sizes[i]);
     output_dimensions[narrow<size_t>(axis)] = split_size;
 
-    Tensor* output = context->Output(i, TensorShape{output_dimensions});
-    const auto output_strides = StridesForTensor(*output);
+    const TensorShape output_shape{output_dimensions};
 
-    ORT_RETURN_IF_ERROR(DispatchStridedCopy<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
-                                                                   *output, /* dst_offset */ 0, output_strides,
-                                                                   output->Shape(),
-                                                                   input, input_offset, input_strides));
+    // with nothing before the split axis, each output is a contiguous part of the input and can be a view of it
+    Tensor* output = nullptr;
+    if (before_dims == 1) {
+      output = context->OutputView(i, 0, output_shape, input_offset * SafeInt<ptrdiff_t>(input.DataType()->Size()));
+    }
+
+    if (output == nullptr) {
+      output = context->Output(i, output_shape);
+      const auto output_strides = StridesForTensor(*output);
+
+      ORT_RETURN_IF_ERROR(DispatchStridedCopy<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
+                                                                     *output, /* dst_offset */ 0, output_strides,
+                                                                     output->Shape(),
+                                                                     input, input_offset, input_strides));
+    }
 
     input_offset += SafeInt<ptrdiff_t>(split_size) * after_dims_excluding_split;  // offset by the data we used in this iteration
   }
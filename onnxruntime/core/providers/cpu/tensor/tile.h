@@ -5,6 +5,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/tensor/broadcast_plan.h"
 #endif
 
 namespace onnxruntime {
@@ -36,6 +37,7 @@ bool IsTileMemcpy(const TensorShape& input_shape,
                   /*out*/ size_t& num_of_batch_copies);
 }  // namespace TileOp
 
+#ifndef SHARED_PROVIDER
 struct Tile : OpKernel {
   explicit Tile(const OpKernelInfo& info) : OpKernel(info) {
   }
@@ -43,6 +45,8 @@ struct Tile : OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  mutable BroadcastPlanCache broadcast_plans_;
 };
+#endif
 
 }  // namespace onnxruntime
@@ -249,7 +249,8 @@ static void DoTransposeEltWise(int64_t num_axes, gsl::span<const int64_t> target
 
 //  `input_shape_override` overrides the shape of `input` for compute purposes.
 static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                 const TensorShape* input_shape_override = nullptr) {
+                                 const TensorShape* input_shape_override = nullptr,
+                                 concurrency::ThreadPool* tp = nullptr) {
   const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
   const auto& input_dims = input_shape.GetDims();
   auto rank = input_shape.NumDimensions();
@@ -257,6 +258,19 @@ static Status DoUntypedTranspose(const gsl::span<const size_t>& permutations, co
   const auto element_size = input.DataType()->Size();
   const bool is_string_type = input.IsDataTypeString();
 
+  // MLAS moves the elements as raw bytes, merging the axes that stay adjacent
+  // and transposing the innermost matrix in cache sized tiles.
+  if (!is_string_type && rank <= MLAS_TRANSPOSE_MAXIMUM_RANK &&
+      (element_size == 1 || element_size == 2 || element_size == 4 || element_size == 8)) {
+    InlinedVector<size_t> mlas_shape(rank);
+    for (size_t i = 0; i < rank; i++) {
+      mlas_shape[i] = onnxruntime::narrow<size_t>(input_dims[i]);
+    }
+    MlasTransposeND(input.DataRaw(), output.MutableDataRaw(), element_size, mlas_shape.data(),
+                    permutations.data(), rank, tp);
+    return Status::OK();
+  }
+
   InlinedVector<size_t> stride(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
@@ -338,7 +352,7 @@ bool IsTransposeReshape(const gsl::span<const size_t>& perm, gsl::span<const int
 
 //`input_shape_override` overrides the shape of `input` for compute purposes.
 Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, const Tensor& input, Tensor& output,
-                                  const TensorShape* input_shape_override) {
+                                  const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -360,10 +374,10 @@ Status TransposeBase::DoTranspose(const gsl::span<const size_t>& permutations, c
     bool moving_single_axis = IsTransposeMovingSingleAxis(permutations, from, to);
 
     if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to, input_shape_override);
+      SingleAxisTranspose(permutations, input, output, from, to, input_shape_override, tp);
     } else {
       // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output, input_shape_override);
+      status = DoUntypedTranspose(permutations, input, output, input_shape_override, tp);
     }
   }
 
@@ -405,7 +419,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
     SingleAxisTranspose(*p_perm, X, Y, from, to, nullptr, ctx->GetOperatorThreadPool());
   } else {
     // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
+    status = DoUntypedTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
   }
 
   return status;
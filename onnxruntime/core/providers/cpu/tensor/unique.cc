@@ -2,10 +2,14 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <numeric>
 #include <core/common/safeint.h>
 #include "core/common/gsl.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -298,6 +302,214 @@ static void CreateOutput(OpKernelContext& context,
   }
 }
 
+namespace {
+
+// Inputs at least this large are partitioned by hash so the tables can be built in parallel.
+constexpr int64_t kMinPartitionedUniqueSize = 64 * 1024;
+
+// Upper bound on the number of hash partitions, as a power of 2.
+constexpr int kMaxUniquePartitionBits = 6;
+
+template <typename T>
+uint64_t UniqueHash(T value) {
+  uint64_t bits = 0;
+  if constexpr (std::is_floating_point<T>::value) {
+    if (value == T(0)) {
+      value = T(0);  // -0.0 and 0.0 are the same unique value
+    }
+    std::memcpy(&bits, &value, sizeof(T));
+  } else {
+    bits = static_cast<uint64_t>(value);
+  }
+
+  // splitmix64 finalizer, so that both the low bits (table slot) and high bits (partition) are well mixed
+  bits ^= bits >> 30;
+  bits *= 0xbf58476d1ce4e5b9ULL;
+  bits ^= bits >> 27;
+  bits *= 0x94d049bb133111ebULL;
+  bits ^= bits >> 31;
+  return bits;
+}
+
+// Unique of the flattened input using open addressing hash tables.
+// The elements are partitioned by the high bits of their hash and each partition builds its own table in parallel,
+// visiting its elements in input order so the first entry of each unique value is its first occurrence.
+// The unique values are then ranked by value (sorted) or by first occurrence (unsorted) to produce the outputs.
+// Values are compared with operator==, so the input must not contain NaN.
+template <typename T>
+void ComputeFlattenedUniqueWithHash(OpKernelContext& context, const T* data, int64_t n, bool sorted) {
+  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
+  const int64_t num_threads = concurrency::ThreadPool::DegreeOfParallelism(tp);
+
+  int partition_bits = 0;
+  if (n >= kMinPartitionedUniqueSize) {
+    while ((int64_t{1} << partition_bits) < num_threads && partition_bits < kMaxUniquePartitionBits) {
+      ++partition_bits;
+    }
+  }
+  const std::ptrdiff_t num_partitions = std::ptrdiff_t{1} << partition_bits;
+  const auto partition_of = [partition_bits](uint64_t hash) {
+    return partition_bits == 0 ? int64_t{0} : static_cast<int64_t>(hash >> (64 - partition_bits));
+  };
+
+  // Group the element indices by partition, keeping each group in input order.
+  std::vector<int64_t> partition_offsets(onnxruntime::narrow<size_t>(num_partitions + 1), 0);
+  std::vector<int64_t> partitioned_indices;
+  partition_offsets[1] = n;
+  if (num_partitions > 1) {
+    const std::ptrdiff_t num_chunks = onnxruntime::narrow<std::ptrdiff_t>(num_threads);
+    const int64_t chunk_size = (n + num_chunks - 1) / num_chunks;
+    std::vector<int64_t> chunk_positions(onnxruntime::narrow<size_t>(num_chunks * num_partitions), 0);
+
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_chunks, [&](std::ptrdiff_t chunk) {
+      int64_t* counts = chunk_positions.data() + chunk * num_partitions;
+      const int64_t end = std::min(n, (chunk + 1) * chunk_size);
+      for (int64_t i = chunk * chunk_size; i < end; ++i) {
+        ++counts[partition_of(UniqueHash(data[i]))];
+      }
+    });
+
+    // partition major exclusive scan of the counts gives where each chunk writes in each partition
+    int64_t total = 0;
+    for (int64_t p = 0; p < num_partitions; ++p) {
+      partition_offsets[onnxruntime::narrow<size_t>(p)] = total;
+      for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+        int64_t& position = chunk_positions[onnxruntime::narrow<size_t>(chunk * num_partitions + p)];
+        const int64_t count = position;
+        position = total;
+        total += count;
+      }
+    }
+    partition_offsets[onnxruntime::narrow<size_t>(num_partitions)] = total;
+
+    partitioned_indices.resize(onnxruntime::narrow<size_t>(n));
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_chunks, [&](std::ptrdiff_t chunk) {
+      int64_t* positions = chunk_positions.data() + chunk * num_partitions;
+      const int64_t end = std::min(n, (chunk + 1) * chunk_size);
+      for (int64_t i = chunk * chunk_size; i < end; ++i) {
+        partitioned_indices[positions[partition_of(UniqueHash(data[i]))]++] = i;
+      }
+    });
+  }
+  const auto element_at = [&](int64_t k) {
+    return num_partitions == 1 ? k : partitioned_indices[onnxruntime::narrow<size_t>(k)];
+  };
+
+  // Build a table per partition. inverse holds the partition local id of each element.
+  std::vector<int64_t> inverse(onnxruntime::narrow<size_t>(n));
+  std::vector<std::vector<int64_t>> first_indices(onnxruntime::narrow<size_t>(num_partitions));
+  std::vector<std::vector<int64_t>> counts(onnxruntime::narrow<size_t>(num_partitions));
+
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_partitions, [&](std::ptrdiff_t p) {
+    const int64_t begin = partition_offsets[p];
+    const int64_t end = partition_offsets[p + 1];
+    size_t capacity = 16;
+    while (capacity < 2 * static_cast<size_t>(end - begin)) {
+      capacity *= 2;
+    }
+    const size_t mask = capacity - 1;
+    std::vector<int64_t> table(capacity, -1);
+    auto& partition_first = first_indices[p];
+    auto& partition_counts = counts[p];
+
+    for (int64_t k = begin; k < end; ++k) {
+      const int64_t i = element_at(k);
+      const T value = data[i];
+      size_t slot = static_cast<size_t>(UniqueHash(value)) & mask;
+      for (;;) {
+        const int64_t id = table[slot];
+        if (id < 0) {
+          table[slot] = static_cast<int64_t>(partition_first.size());
+          inverse[i] = table[slot];
+          partition_first.push_back(i);
+          partition_counts.push_back(1);
+          break;
+        }
+        if (data[partition_first[id]] == value) {
+          inverse[i] = id;
+          ++partition_counts[id];
+          break;
+        }
+        slot = (slot + 1) & mask;
+      }
+    }
+  });
+
+  // Number the unique values across partitions.
+  std::vector<int64_t> unique_offsets(onnxruntime::narrow<size_t>(num_partitions + 1), 0);
+  for (int64_t p = 0; p < num_partitions; ++p) {
+    unique_offsets[p + 1] = unique_offsets[p] + static_cast<int64_t>(first_indices[p].size());
+  }
+  const int64_t num_unique = unique_offsets[onnxruntime::narrow<size_t>(num_partitions)];
+
+  std::vector<int64_t> unique_first(onnxruntime::narrow<size_t>(num_unique));
+  std::vector<int64_t> unique_counts(onnxruntime::narrow<size_t>(num_unique));
+  for (int64_t p = 0; p < num_partitions; ++p) {
+    std::copy(first_indices[p].begin(), first_indices[p].end(), unique_first.begin() + unique_offsets[p]);
+    std::copy(counts[p].begin(), counts[p].end(), unique_counts.begin() + unique_offsets[p]);
+  }
+  if (num_partitions > 1) {
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_partitions, [&](std::ptrdiff_t p) {
+      for (int64_t k = partition_offsets[p]; k < partition_offsets[p + 1]; ++k) {
+        inverse[element_at(k)] += unique_offsets[p];
+      }
+    });
+  }
+
+  // Rank the unique values in output order.
+  std::vector<int64_t> rank(onnxruntime::narrow<size_t>(num_unique));
+  if (sorted) {
+    std::vector<int64_t> order(onnxruntime::narrow<size_t>(num_unique));
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return data[unique_first[a]] < data[unique_first[b]];
+    });
+    for (int64_t r = 0; r < num_unique; ++r) {
+      rank[order[r]] = r;
+    }
+  } else {
+    int64_t next = 0;
+    for (int64_t i = 0; i < n; ++i) {
+      const int64_t id = inverse[i];
+      if (unique_first[id] == i) {
+        rank[id] = next++;
+      }
+    }
+  }
+
+  Tensor& Y = *context.Output(0, {num_unique});
+  Tensor* indices_out = context.Output(1, {num_unique});
+  Tensor* inverse_indices = context.Output(2, {n});
+  Tensor* counts_out = context.Output(3, {num_unique});
+
+  T* Y_data = Y.MutableData<T>();
+  int64_t* indices_data = indices_out != nullptr ? indices_out->MutableData<int64_t>() : nullptr;
+  int64_t* counts_data = counts_out != nullptr ? counts_out->MutableData<int64_t>() : nullptr;
+  for (int64_t id = 0; id < num_unique; ++id) {
+    const int64_t r = rank[id];
+    Y_data[r] = data[unique_first[id]];
+    if (indices_data) {
+      indices_data[r] = unique_first[id];
+    }
+    if (counts_data) {
+      counts_data[r] = unique_counts[id];
+    }
+  }
+
+  if (inverse_indices) {
+    int64_t* inverse_data = inverse_indices->MutableData<int64_t>();
+    concurrency::ThreadPool::TryParallelFor(tp, onnxruntime::narrow<std::ptrdiff_t>(n),
+                                            TensorOpCost{16.0, 8.0, 1.0},
+                                            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                              for (std::ptrdiff_t i = first; i < last; ++i) {
+                                                inverse_data[i] = rank[inverse[i]];
+                                              }
+                                            });
+  }
+}
+
+}  // namespace
+
 template <typename T>
 Status Unique::ComputeImpl(OpKernelContext& context) const {
   if (!utils::HasType<EnabledUniqueDataTypes, T>()) {
@@ -307,6 +519,19 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   const Tensor& input = *context.Input<Tensor>(0);
   auto data = input.DataAsSpan<T>();
 
+  if constexpr (std::is_arithmetic<T>::value) {
+    // NaN never compares equal, so inputs containing it keep the ordered map below
+    bool has_nan = false;
+    if constexpr (std::is_floating_point<T>::value) {
+      has_nan = std::any_of(data.begin(), data.end(), [](T value) { return value != value; });
+    }
+
+    if (flatten_ && !has_nan) {
+      ComputeFlattenedUniqueWithHash(context, data.data(), static_cast<int64_t>(data.size()), sort_);
+      return Status::OK();
+    }
+  }
+
   if (flatten_) {
     std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
     std::vector<std::vector<int64_t>> indices;
@@ -1065,6 +1065,51 @@ void ResizeBiCubic(int64_t batch_size,
 #pragma warning(pop)
 #endif
 
+template <typename T>
+struct UpsampleLinearTables {
+  // only the tables of the path the kernel takes for the shapes are computed
+  BilinearParams bilinear;
+  BilinearParamsInteger bilinear_integer;
+  std::unique_ptr<FilterParamsAntiAlias<typename AccumulateType<T>::type>> antialias;
+};
+
+// Tables for at most this many shapes are cached by a kernel.
+constexpr size_t kMaxCachedLinearTables = 16;
+
+template <typename T>
+template <typename SetupTables>
+std::shared_ptr<const UpsampleLinearTables<T>> Upsample<T>::GetLinearTables(const gsl::span<const int64_t>& input_dims,
+                                                                            const gsl::span<const int64_t>& output_dims,
+                                                                            const std::vector<float>& scales,
+                                                                            const std::vector<float>& roi,
+                                                                            SetupTables&& setup) const {
+  LinearTablesKey key;
+  key.first.reserve(input_dims.size() + output_dims.size());
+  key.first.insert(key.first.end(), input_dims.begin(), input_dims.end());
+  key.first.insert(key.first.end(), output_dims.begin(), output_dims.end());
+  key.second.reserve(scales.size() + roi.size());
+  key.second.insert(key.second.end(), scales.begin(), scales.end());
+  key.second.insert(key.second.end(), roi.begin(), roi.end());
+
+  std::lock_guard<std::mutex> lock(linear_tables_cache_mutex_);
+
+  auto it = linear_tables_cache_.find(key);
+  if (it != linear_tables_cache_.end()) {
+    return it->second;
+  }
+
+  auto tables = std::make_shared<UpsampleLinearTables<T>>();
+  setup(*tables);
+
+  // shapes that vary from run to run must not grow the cache without bound
+  if (linear_tables_cache_.size() >= kMaxCachedLinearTables) {
+    linear_tables_cache_.clear();
+  }
+
+  linear_tables_cache_.emplace(std::move(key), tables);
+  return tables;
+}
+
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                 const std::vector<float>& roi,
@@ -1166,65 +1211,74 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
           }
         }
 
-        if (is_nchw) {
-          if (antialias_) {
-            UpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                                      height_scale, width_scale, roi, use_extrapolation_, extrapolation_value_, exclude_outside_,
-                                      X, Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                      output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+        // The interpolation tables only depend on the shapes, so they are computed by the first call and reused.
+        if (antialias_) {
+          auto tables = GetLinearTables(dims, output_dims, scales, roi, [&](UpsampleLinearTables<T>& t) {
+            int64_t input_paras[] = {input_height, input_width};
+            int64_t output_paras[] = {output_height, output_width};
+            float scale_paras[] = {height_scale, width_scale};
+            auto p = std::make_unique<BilinearParamsAntiAlias<typename AccumulateType<T>::type>>();
+            SetupUpsampleFilterAntiAlias(*p, input_paras, output_paras, scale_paras, roi,
+                                         alloc, get_original_coordinate_, exclude_outside_, is_nchw);
+            t.antialias = std::move(p);
+          });
+
+          concurrency::ThreadPool* tp = output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr;
+          if (is_nchw) {
+            UpsampleBaseAntiAlias<T>(*tables->antialias, batch_size, num_channels, input_height, input_width,
+                                     output_height, output_width, use_extrapolation_, extrapolation_value_,
+                                     X->Data<T>(), Y->MutableData<T>(), alloc, tp);
+          } else {
+            NhwcUpsampleBasicAntiAlias(*tables->antialias, batch_size, num_channels, input_height, input_width,
+                                       output_height, output_width, use_extrapolation_, extrapolation_value_,
+                                       X->Data<T>(), Y->MutableData<T>(), alloc, tp);
+          }
+          return Status::OK();
+        }
+
+        const bool use_integer = !is_nchw && !is_2D &&
+                                 (Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_UINT8 ||
+                                  Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_INT8);
+
+        auto tables = GetLinearTables(dims, output_dims, scales, roi, [&](UpsampleLinearTables<T>& t) {
+          if (use_integer) {
+            t.bilinear_integer = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
+                                                              height_scale, width_scale, roi,
+                                                              alloc, get_original_coordinate_, is_nchw);
           } else {
-            UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                             height_scale, width_scale, roi,
-                             use_extrapolation_, extrapolation_value_, X->Data<T>(),
-                             Y->MutableData<T>(), alloc, get_original_coordinate_,
-                             output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+            t.bilinear = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                               height_scale, width_scale, roi,
+                                               alloc, get_original_coordinate_, is_nchw);
           }
+        });
+
+        if (is_nchw) {
+          UpsampleBilinear(tables->bilinear, batch_size, num_channels, input_height, input_width,
+                           output_height, output_width, use_extrapolation_, extrapolation_value_,
+                           X->Data<T>(), Y->MutableData<T>(),
+                           output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
         } else {
+          concurrency::ThreadPool* tp =
+              output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr;
           if (use_extrapolation_) {
-            if (antialias_) {
-              NhwcUpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                                            height_scale, width_scale, roi, use_extrapolation_, extrapolation_value_, exclude_outside_,
-                                            X, Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                            output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+            if (use_integer) {
+              NhwcUpsampleBilinearInteger<T, true>(
+                  tables->bilinear_integer, batch_size, num_channels, input_height, input_width,
+                  output_height, output_width, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(), tp);
             } else {
-              if (!is_2D &&
-                  (Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_UINT8 ||
-                   Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
-                NhwcUpsampleBilinearInteger<T, true>(
-                    batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
-              } else {
-                NhwcUpsampleBilinear<T, true>(
-                    batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
-              }
+              NhwcUpsampleBilinear<T, true>(
+                  tables->bilinear, batch_size, num_channels, input_height, input_width,
+                  output_height, output_width, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(), tp);
             }
           } else {
-            if (antialias_) {
-              NhwcUpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                                            height_scale, width_scale, roi, use_extrapolation_, extrapolation_value_, exclude_outside_,
-                                            X, Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                            output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+            if (use_integer) {
+              NhwcUpsampleBilinearInteger<T, false>(
+                  tables->bilinear_integer, batch_size, num_channels, input_height, input_width,
+                  output_height, output_width, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(), tp);
             } else {
-              if (!is_2D &&
-                  (Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_UINT8 ||
-                   Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
-                NhwcUpsampleBilinearInteger<T, false>(
-                    batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
-              } else {
-                NhwcUpsampleBilinear<T, false>(
-                    batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
-                    alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
-              }
+              NhwcUpsampleBilinear<T, false>(
+                  tables->bilinear, batch_size, num_channels, input_height, input_width,
+                  output_height, output_width, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(), tp);
             }
           }
         }
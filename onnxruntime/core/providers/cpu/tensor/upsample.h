@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -58,6 +62,11 @@ struct BilinearParamsInteger {
   int32_t* dy2_scale_10{nullptr};
 };
 
+// The interpolation tables of the 'linear' mode for one combination of input shape, output shape, scales and roi.
+// Defined in upsample.cc.
+template <typename T>
+struct UpsampleLinearTables;
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -68,6 +77,22 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const gsl::span<const int64_t>& output_dims) const;
+
+ private:
+  // Returns the cached interpolation tables for the shapes, scales and roi, calling setup to compute them
+  // on the first use. The tables depend on nothing else, as the mode and the coordinate transformation are
+  // fixed for the kernel, so they are reused by every later call with the same shapes.
+  template <typename SetupTables>
+  std::shared_ptr<const UpsampleLinearTables<T>> GetLinearTables(const gsl::span<const int64_t>& input_dims,
+                                                                 const gsl::span<const int64_t>& output_dims,
+                                                                 const std::vector<float>& scales,
+                                                                 const std::vector<float>& roi,
+                                                                 SetupTables&& setup) const;
+
+  using LinearTablesKey = std::pair<std::vector<int64_t>, std::vector<float>>;
+
+  mutable std::mutex linear_tables_cache_mutex_;
+  mutable std::map<LinearTablesKey, std::shared_ptr<const UpsampleLinearTables<T>>> linear_tables_cache_;
 };
 
 BilinearParams SetupUpsampleBilinear(const int32_t input_height,
@@ -82,25 +107,18 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const bool is_nchw);
 
 template <typename T>
-void UpsampleBilinear(const int32_t batch_size,
+void UpsampleBilinear(const BilinearParams& p,
+                      const int32_t batch_size,
                       const int32_t num_channels,
                       const int32_t input_height,
                       const int32_t input_width,
                       const int32_t output_height,
                       const int32_t output_width,
-                      const float height_scale,
-                      const float width_scale,
-                      const std::vector<float>& roi,
                       const bool use_extrapolation,
                       const float extrapolation_value,
                       const T* const XdataBase,
                       T* const YdataBase,
-                      AllocatorPtr& alloc,
-                      const GetOriginalCoordinateFunc& get_original_coordinate,
                       concurrency::ThreadPool* tp) {
-  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
-                                           height_scale, width_scale, roi,
-                                           alloc, get_original_coordinate, true);
   for (int32_t n = 0; n < batch_size; ++n) {
     concurrency::ThreadPool::TrySimpleParallelFor(
         tp, num_channels,
@@ -109,51 +127,75 @@ void UpsampleBilinear(const int32_t batch_size,
               XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
           T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
           for (int32_t y = 0; y < output_height; ++y) {
+            // the input rows and the vertical coefficients are the same for the whole output row
+            const T* const Xrow1 = Xdata + p.input_width_mul_y1[y];
+            const T* const Xrow2 = Xdata + p.input_width_mul_y2[y];
+            const float dy1 = p.dy1[y];
+            const float dy2 = p.dy2[y];
+            const bool y_out_of_range =
+                use_extrapolation && (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1));
+            T* const Yrow = Ydata + output_width * y;
             for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
               // when use_extrapolation is set and original index of x or y is out of the dim range
               // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
+              if (y_out_of_range ||
+                  (use_extrapolation &&
                    (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
+                Yrow[x] = static_cast<T>(extrapolation_value);
                 continue;
               }
 
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+              T X11 = Xrow1[p.in_x1[x]];
+              T X21 = Xrow1[p.in_x2[x]];
+              T X12 = Xrow2[p.in_x1[x]];
+              T X22 = Xrow2[p.in_x2[x]];
 
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
+              Yrow[x] = static_cast<T>(p.dx2[x] * dy2 * X11 +
+                                       p.dx1[x] * dy2 * X21 +
+                                       p.dx2[x] * dy1 * X12 +
+                                       p.dx1[x] * dy1 * X22);
             }
           }
         });
   }
 }
 
+template <typename T>
+void UpsampleBilinear(const int32_t batch_size,
+                      const int32_t num_channels,
+                      const int32_t input_height,
+                      const int32_t input_width,
+                      const int32_t output_height,
+                      const int32_t output_width,
+                      const float height_scale,
+                      const float width_scale,
+                      const std::vector<float>& roi,
+                      const bool use_extrapolation,
+                      const float extrapolation_value,
+                      const T* const XdataBase,
+                      T* const YdataBase,
+                      AllocatorPtr& alloc,
+                      const GetOriginalCoordinateFunc& get_original_coordinate,
+                      concurrency::ThreadPool* tp) {
+  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                           height_scale, width_scale, roi,
+                                           alloc, get_original_coordinate, true);
+  UpsampleBilinear(p, batch_size, num_channels, input_height, input_width, output_height, output_width,
+                   use_extrapolation, extrapolation_value, XdataBase, YdataBase, tp);
+}
+
 template <typename T, bool UseExtrapolation>
-void NhwcUpsampleBilinear(const int32_t batch_size,
+void NhwcUpsampleBilinear(const BilinearParams& p,
+                          const int32_t batch_size,
                           const int32_t num_channels,
                           const int32_t input_height,
                           const int32_t input_width,
                           const int32_t output_height,
                           const int32_t output_width,
-                          const float height_scale,
-                          const float width_scale,
-                          const std::vector<float>& roi,
                           const float extrapolation_value,
                           const T* const XdataBase,
                           T* const YdataBase,
-                          AllocatorPtr& alloc,
-                          const GetOriginalCoordinateFunc& get_original_coordinate,
                           concurrency::ThreadPool* tp) {
-  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
-                                           height_scale, width_scale, roi,
-                                           alloc, get_original_coordinate, false);
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -221,6 +263,30 @@ void NhwcUpsampleBilinear(const int32_t batch_size,
   }
 }
 
+template <typename T, bool UseExtrapolation>
+void NhwcUpsampleBilinear(const int32_t batch_size,
+                          const int32_t num_channels,
+                          const int32_t input_height,
+                          const int32_t input_width,
+                          const int32_t output_height,
+                          const int32_t output_width,
+                          const float height_scale,
+                          const float width_scale,
+                          const std::vector<float>& roi,
+                          const float extrapolation_value,
+                          const T* const XdataBase,
+                          T* const YdataBase,
+                          AllocatorPtr& alloc,
+                          const GetOriginalCoordinateFunc& get_original_coordinate,
+                          concurrency::ThreadPool* tp) {
+  BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                           height_scale, width_scale, roi,
+                                           alloc, get_original_coordinate, false);
+  NhwcUpsampleBilinear<T, UseExtrapolation>(p, batch_size, num_channels, input_height, input_width,
+                                            output_height, output_width, extrapolation_value,
+                                            XdataBase, YdataBase, tp);
+}
+
 BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
                                                    const int32_t input_width,
                                                    const int32_t output_height,
@@ -233,24 +299,17 @@ BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
                                                    const bool is_nchw);
 
 template <typename T, bool UseExtrapolation>
-void NhwcUpsampleBilinearInteger(const int32_t batch_size,
+void NhwcUpsampleBilinearInteger(const BilinearParamsInteger& p,
+                                 const int32_t batch_size,
                                  const int32_t num_channels,
                                  const int32_t input_height,
                                  const int32_t input_width,
                                  const int32_t output_height,
                                  const int32_t output_width,
-                                 const float height_scale,
-                                 const float width_scale,
-                                 const std::vector<float>& roi,
                                  const float extrapolation_value,
                                  const T* const XdataBase,
                                  T* const YdataBase,
-                                 AllocatorPtr& alloc,
-                                 const GetOriginalCoordinateFunc& get_original_coordinate,
                                  concurrency::ThreadPool* tp) {
-  BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
-                                                         height_scale, width_scale, roi,
-                                                         alloc, get_original_coordinate, false);
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -320,6 +379,30 @@ void NhwcUpsampleBilinearInteger(const int32_t batch_size,
   }
 }
 
+template <typename T, bool UseExtrapolation>
+void NhwcUpsampleBilinearInteger(const int32_t batch_size,
+                                 const int32_t num_channels,
+                                 const int32_t input_height,
+                                 const int32_t input_width,
+                                 const int32_t output_height,
+                                 const int32_t output_width,
+                                 const float height_scale,
+                                 const float width_scale,
+                                 const std::vector<float>& roi,
+                                 const float extrapolation_value,
+                                 const T* const XdataBase,
+                                 T* const YdataBase,
+                                 AllocatorPtr& alloc,
+                                 const GetOriginalCoordinateFunc& get_original_coordinate,
+                                 concurrency::ThreadPool* tp) {
+  BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
+                                                         height_scale, width_scale, roi,
+                                                         alloc, get_original_coordinate, false);
+  NhwcUpsampleBilinearInteger<T, UseExtrapolation>(p, batch_size, num_channels, input_height, input_width,
+                                                   output_height, output_width, extrapolation_value,
+                                                   XdataBase, YdataBase, tp);
+}
+
 }  // namespace onnxruntime
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
@@ -492,7 +492,7 @@ void HandleExtrapolation(int64_t num_channels,
 }
 
 template <typename T, typename T1>
-void UpsampleBaseAntiAlias(FilterParamsAntiAlias<T1>& p,
+void UpsampleBaseAntiAlias(const FilterParamsAntiAlias<T1>& p,
                            const int64_t batch_size,
                            const int64_t num_channels,
                            const int64_t input_height,
@@ -627,7 +627,7 @@ void NhwcResizeBiCubicAntiAlias(const int64_t batch_size,
 }
 
 template <typename T, typename T1>
-void NhwcUpsampleBasicAntiAlias(FilterParamsAntiAlias<T1>& p,
+void NhwcUpsampleBasicAntiAlias(const FilterParamsAntiAlias<T1>& p,
                                 const int64_t batch_size,
                                 const int64_t num_channels,
                                 const int64_t input_height,
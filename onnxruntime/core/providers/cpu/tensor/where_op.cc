@@ -4,8 +4,11 @@
 #include "core/providers/cpu/tensor/where_op.h"
 
 #include <algorithm>
+#include <initializer_list>
 #include <type_traits>
 
+#include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/element_wise_ops.h"  // for broadcast utilities
 
 namespace onnxruntime {
@@ -245,10 +248,152 @@ static void UntypedMerge(OpKernelContext& context,
 
   BroadcastLooper(broadcast_helper, functors);
 }
+
+// Computes the broadcast shape of the inputs. Returns false if they don't broadcast.
+bool BroadcastShapes(std::initializer_list<const TensorShape*> shapes, TensorShapeVector& output_dims) {
+  size_t rank = 0;
+  for (const auto* shape : shapes) {
+    rank = std::max(rank, shape->NumDimensions());
+  }
+
+  output_dims.assign(rank, 1);
+  for (const auto* shape : shapes) {
+    const size_t offset = rank - shape->NumDimensions();
+    for (size_t i = 0; i < shape->NumDimensions(); ++i) {
+      const int64_t dim = (*shape)[i];
+      int64_t& output_dim = output_dims[offset + i];
+      if (dim != output_dim) {
+        if (output_dim == 1) {
+          output_dim = dim;
+        } else if (dim != 1) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+// An input whose shape, after dropping its leading 1s, matches the trailing dimensions of the output repeats every
+// Size() output elements. This covers full size inputs, scalars and row broadcasts.
+bool IsRepeatedOverOutput(const TensorShape& shape, gsl::span<const int64_t> output_dims) {
+  const auto dims = shape.GetDims();
+  size_t first = 0;
+  while (first < dims.size() && dims[first] == 1) {
+    ++first;
+  }
+
+  const size_t trailing_rank = dims.size() - first;
+  return std::equal(dims.begin() + first, dims.end(), output_dims.end() - trailing_rank);
+}
+
+// Selects between X and Y with a condition for each element. The values are read unconditionally so that the loop
+// compiles to vector blends.
+template <typename T, bool XIsScalar, bool YIsScalar>
+void SelectSpan(const bool* condition, const T* X, const T* Y, T* output, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const T x = X[XIsScalar ? 0 : i];
+    const T y = Y[YIsScalar ? 0 : i];
+    output[i] = condition[i] ? x : y;
+  }
+}
+
+template <typename T>
+void CopyOrFillSpan(const T* values, bool is_scalar, T* output, size_t count) {
+  if (is_scalar) {
+    std::fill_n(output, count, *values);
+  } else {
+    std::copy_n(values, count, output);
+  }
+}
+
+// Where in a single parallel pass over the output, for the inputs that repeat over the output (see
+// IsRepeatedOverOutput). Returns false for the other broadcasts, which are handled by UntypedSelect and UntypedMerge.
+template <typename T>
+bool TrySelectRepeatedInputs(OpKernelContext& context) {
+  const auto& condition = *context.Input<Tensor>(0);
+  const auto& X = *context.Input<Tensor>(1);
+  const auto& Y = *context.Input<Tensor>(2);
+
+  TensorShapeVector output_dims;
+  if (!BroadcastShapes({&condition.Shape(), &X.Shape(), &Y.Shape()}, output_dims) ||
+      !IsRepeatedOverOutput(condition.Shape(), output_dims) ||
+      !IsRepeatedOverOutput(X.Shape(), output_dims) ||
+      !IsRepeatedOverOutput(Y.Shape(), output_dims)) {
+    return false;
+  }
+
+  Tensor& output = *context.Output(0, output_dims);
+  const std::ptrdiff_t output_size = narrow<std::ptrdiff_t>(output.Shape().Size());
+  if (output_size == 0) {
+    return true;
+  }
+
+  const bool* condition_data = condition.Data<bool>();
+  const T* X_data = X.Data<T>();
+  const T* Y_data = Y.Data<T>();
+  T* output_data = output.MutableData<T>();
+  const std::ptrdiff_t condition_size = narrow<std::ptrdiff_t>(condition.Shape().Size());
+  const std::ptrdiff_t X_size = narrow<std::ptrdiff_t>(X.Shape().Size());
+  const std::ptrdiff_t Y_size = narrow<std::ptrdiff_t>(Y.Shape().Size());
+
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), output_size,
+      TensorOpCost{static_cast<double>(sizeof(bool) + 2 * sizeof(T)), static_cast<double>(sizeof(T)), 1.0},
+      [=](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::ptrdiff_t position = first;
+        while (position < last) {
+          // process up to the end of the range or the next wrap around of a repeated input
+          std::ptrdiff_t count = last - position;
+          for (std::ptrdiff_t size : {condition_size, X_size, Y_size}) {
+            if (size > 1) {
+              count = std::min(count, size - position % size);
+            }
+          }
+
+          const bool* condition_span = condition_data + (condition_size > 1 ? position % condition_size : 0);
+          const T* X_span = X_data + (X_size > 1 ? position % X_size : 0);
+          const T* Y_span = Y_data + (Y_size > 1 ? position % Y_size : 0);
+          T* output_span = output_data + position;
+          const size_t span_size = static_cast<size_t>(count);
+
+          if (condition_size == 1) {
+            if (*condition_span) {
+              CopyOrFillSpan(X_span, X_size == 1, output_span, span_size);
+            } else {
+              CopyOrFillSpan(Y_span, Y_size == 1, output_span, span_size);
+            }
+          } else if (X_size == 1) {
+            if (Y_size == 1) {
+              SelectSpan<T, true, true>(condition_span, X_span, Y_span, output_span, span_size);
+            } else {
+              SelectSpan<T, true, false>(condition_span, X_span, Y_span, output_span, span_size);
+            }
+          } else {
+            if (Y_size == 1) {
+              SelectSpan<T, false, true>(condition_span, X_span, Y_span, output_span, span_size);
+            } else {
+              SelectSpan<T, false, false>(condition_span, X_span, Y_span, output_span, span_size);
+            }
+          }
+
+          position += count;
+        }
+      });
+
+  return true;
+}
 }  // namespace
 
 template <typename T>
 Status Where<T>::Compute(OpKernelContext* context) const {
+  if constexpr (std::is_arithmetic<T>::value) {
+    if (TrySelectRepeatedInputs<T>(*context)) {
+      return Status::OK();
+    }
+  }
+
   // we use a func pointer to save the overhead of std::function, so we can't capture tensor_allocator here
   const auto typed_tensor_allocation = [](const TensorAllocator& allocator,
                                           const TensorShape& shape) {
@@ -4,6 +4,7 @@
 #include "cuda_allocator.h"
 #include "cuda_common.h"
 #include "gpu_data_transfer.h"
+#include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
 
@@ -86,6 +87,104 @@ void* CUDAExternalAllocator::Reserve(size_t size) {
   return p;
 }
 
+namespace {
+// The memory pools are shared by the sessions of the process, one per device. They are never destroyed, as buffers
+// allocated from them may outlive the sessions.
+cudaMemPool_t GetSharedMemPool(OrtDevice::DeviceId device_id, size_t release_threshold) {
+  static OrtMutex mutex;
+  static std::unordered_map<OrtDevice::DeviceId, cudaMemPool_t> pools;
+
+  std::lock_guard<OrtMutex> lock(mutex);
+  auto it = pools.find(device_id);
+  if (it == pools.end()) {
+    cudaMemPoolProps props{};
+    props.allocType = cudaMemAllocationTypePinned;
+    props.handleTypes = cudaMemHandleTypeNone;
+    props.location.type = cudaMemLocationTypeDevice;
+    props.location.id = device_id;
+    cudaMemPool_t pool;
+    CUDA_CALL_THROW(cudaMemPoolCreate(&pool, &props));
+    it = pools.emplace(device_id, pool).first;
+  }
+
+  // the pool keeps the largest threshold requested by the sessions sharing it
+  uint64_t threshold = 0;
+  CUDA_CALL_THROW(cudaMemPoolGetAttribute(it->second, cudaMemPoolAttrReleaseThreshold, &threshold));
+  if (release_threshold > threshold) {
+    threshold = release_threshold;
+    CUDA_CALL_THROW(cudaMemPoolSetAttribute(it->second, cudaMemPoolAttrReleaseThreshold, &threshold));
+  }
+  return it->second;
+}
+}  // namespace
+
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t release_threshold)
+    : CUDAAllocator(device_id, name), pool_(GetSharedMemPool(device_id, release_threshold)) {
+}
+
+void* CUDAMemPoolAllocator::AllocOnCudaStream(size_t size, cudaStream_t stream) {
+  SetDevice(true);
+  CheckDevice(true);
+  void* p = nullptr;
+  if (size > 0) {
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, stream));
+    if (stream == nullptr) {
+      // the buffer may be used on any stream
+      CUDA_CALL_THROW(cudaStreamSynchronize(nullptr));
+    }
+
+    std::lock_guard<OrtMutex> lock(lock_);
+    buffers_.emplace(p, BufferInfo{stream, size});
+    stats_.num_allocs++;
+    stats_.bytes_in_use += size;
+    stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+    stats_.max_alloc_size = std::max(stats_.max_alloc_size, static_cast<int64_t>(size));
+  }
+  return p;
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  return AllocOnCudaStream(size, nullptr);
+}
+
+void* CUDAMemPoolAllocator::AllocOnStream(size_t size, Stream* stream) {
+  return AllocOnCudaStream(size, stream != nullptr ? static_cast<cudaStream_t>(stream->GetHandle()) : nullptr);
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  BufferInfo info{};
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    auto it = buffers_.find(p);
+    ORT_ENFORCE(it != buffers_.end(), "Freeing a buffer that was not allocated by this allocator.");
+    info = it->second;
+    buffers_.erase(it);
+    stats_.bytes_in_use -= info.size;
+  }
+
+  SetDevice(false);
+  CheckDevice(false);
+  // the stream of a buffer returned to the user may have been destroyed with its session, so fall back to a free
+  // that synchronizes the device. do not throw error since it's OK for the free to fail during shutdown.
+  if (info.stream == nullptr || cudaFreeAsync(p, info.stream) != cudaSuccess) {
+    cudaFree(p);
+  }
+}
+
+void CUDAMemPoolAllocator::GetStats(AllocatorStats* stats) {
+  uint64_t reserved = 0;
+  cudaMemPoolGetAttribute(pool_, cudaMemPoolAttrReservedMemCurrent, &reserved);
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  *stats = stats_;
+  // the memory the pool holds for all its users
+  stats->total_allocated_bytes = static_cast<int64_t>(reserved);
+}
+
 void* CUDAPinnedAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
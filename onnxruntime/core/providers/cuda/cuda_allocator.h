@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_pch.h"
 
 namespace onnxruntime {
 
@@ -19,7 +20,7 @@ class CUDAAllocator : public IAllocator {
   void* Alloc(size_t size) override;
   void Free(void* p) override;
 
- private:
+ protected:
   void CheckDevice(bool throw_when_fail) const;
   void SetDevice(bool throw_when_fail) const;
 };
@@ -49,6 +50,35 @@ class CUDAExternalAllocator : public CUDAAllocator {
   InlinedHashSet<void*> reserved_;
 };
 
+// Allocates from a stream ordered memory pool of the device, shared by all the sessions of the process using it on
+// that device. A buffer is freed on the stream it was allocated on, so the work enqueued after it on that stream
+// reuses the memory without synchronization. The driver returns the memory the pool holds beyond the release
+// threshold to the OS when a stream or the device is synchronized.
+class CUDAMemPoolAllocator : public CUDAAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t release_threshold);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  bool IsStreamOrdered() const override { return true; }
+  void* AllocOnStream(size_t size, Stream* stream) override;
+  void GetStats(AllocatorStats* stats) override;
+
+ private:
+  struct BufferInfo {
+    // the stream the buffer was allocated on, nullptr if it was allocated without a stream
+    cudaStream_t stream;
+    size_t size;
+  };
+
+  void* AllocOnCudaStream(size_t size, cudaStream_t stream);
+
+  cudaMemPool_t pool_;
+  mutable OrtMutex lock_;
+  InlinedHashMap<void*, BufferInfo> buffers_;
+  AllocatorStats stats_;
+};
+
 // TODO: add a default constructor
 class CUDAPinnedAllocator : public IAllocator {
  public:
@@ -128,7 +128,8 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
                                                         size_t gpu_mem_limit,
                                                         ArenaExtendStrategy arena_extend_strategy,
                                                         CUDAExecutionProviderExternalAllocatorInfo external_allocator_info,
-                                                        const OrtArenaCfg* default_memory_arena_cfg) {
+                                                        const OrtArenaCfg* default_memory_arena_cfg,
+                                                        bool enable_cross_stream_reusing) {
   if (external_allocator_info.UseExternalAllocator()) {
     AllocatorCreationInfo default_memory_info(
         [external_allocator_info](OrtDevice::DeviceId id) {
@@ -152,8 +153,7 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
                                   : OrtArenaCfg(gpu_mem_limit, static_cast<int>(arena_extend_strategy), -1, -1, -1, -1L)},
         // make it stream aware
         true,
-        // enable cross stream sharing?
-        false);
+        enable_cross_stream_reusing);
 
     // CUDA malloc/free is expensive so always use an arena
     return CreateAllocator(default_memory_info);
@@ -162,7 +162,8 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
 
 CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t /*gpu_mem_limit*/,
                                                           ArenaExtendStrategy /*arena_extend_strategy*/, CUDAExecutionProviderExternalAllocatorInfo /*external_allocator_info*/,
-                                                          OrtArenaCfg* /*default_memory_arena_cfg*/) {
+                                                          OrtArenaCfg* /*default_memory_arena_cfg*/, int cuda_graph_max_captures)
+    : stream_(stream), cuda_graph_max_captures_(cuda_graph_max_captures) {
   CUDA_CALL_THROW(cudaSetDevice(device_id));
 
   CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
@@ -172,7 +173,9 @@ CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
   CUDNN_CALL_THROW(cudnnCreate(&cudnn_handle_));
   CUDNN_CALL_THROW(cudnnSetStream(cudnn_handle_, stream));
 
-  cuda_graph_.SetStream(stream);
+  cuda_graphs_.emplace_front(std::string{}, stream_);
+  cuda_graphs_by_key_.emplace(std::string{}, cuda_graphs_.begin());
+  current_cuda_graph_ = &cuda_graphs_.front();
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -181,31 +184,55 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
   ORT_IGNORE_RETURN_VALUE(CUDNN_CALL(cudnnDestroy(cudnn_handle_)));
 }
 
+void CUDAExecutionProvider::PerThreadContext::SetGraphCaptureKey(const std::string& key) {
+  if (cuda_graph_max_captures_ <= 0 || key == current_cuda_graph_->key) {
+    return;
+  }
+
+  auto it = cuda_graphs_by_key_.find(key);
+  if (it != cuda_graphs_by_key_.end()) {
+    // mark as the most recently used
+    cuda_graphs_.splice(cuda_graphs_.begin(), cuda_graphs_, it->second);
+  } else {
+    while (cuda_graphs_.size() >= static_cast<size_t>(cuda_graph_max_captures_)) {
+      LOGS_DEFAULT(INFO) << "Evicting the least recently used cuda graph, captured for the input shapes "
+                         << cuda_graphs_.back().key;
+      cuda_graphs_by_key_.erase(cuda_graphs_.back().key);
+      cuda_graphs_.pop_back();
+    }
+
+    cuda_graphs_.emplace_front(key, stream_);
+    cuda_graphs_by_key_.emplace(key, cuda_graphs_.begin());
+  }
+
+  current_cuda_graph_ = &cuda_graphs_.front();
+}
+
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
-  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
+  return current_cuda_graph_->regular_run_count_before_graph_capture >= min_num_runs_before_cuda_graph_capture_;
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureBegin() {
-  cuda_graph_.Reset();
-  cuda_graph_.CaptureBegin();
+  current_cuda_graph_->cuda_graph.Reset();
+  current_cuda_graph_->cuda_graph.CaptureBegin();
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureEnd() {
-  cuda_graph_.CaptureEnd();
-  is_graph_captured_ = true;
+  current_cuda_graph_->cuda_graph.CaptureEnd();
+  current_cuda_graph_->is_graph_captured = true;
 }
 
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured() const {
-  return is_graph_captured_;
+  return current_cuda_graph_->is_graph_captured;
 }
 
 Status CUDAExecutionProvider::PerThreadContext::ReplayGraph() {
   ORT_ENFORCE(IsGraphCaptured());
-  return cuda_graph_.Replay();
+  return current_cuda_graph_->cuda_graph.Replay();
 }
 
 void CUDAExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
-  ++regular_run_count_before_graph_capture_;
+  ++current_cuda_graph_->regular_run_count_before_graph_capture;
 }
 
 void OverrideTunableOpInfoByEnv(CUDAExecutionProviderInfo& info) {
@@ -241,6 +268,11 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
 
   // This scenario is not supported.
   ORT_ENFORCE(!(info.has_user_compute_stream && info.external_allocator_info.UseExternalAllocator()));
+  ORT_ENFORCE(!(info.use_cuda_mem_pool && info.external_allocator_info.UseExternalAllocator()),
+              "use_cuda_mem_pool can't be used with an external allocator.");
+  // the buffers allocated during the graph capture would have to stay allocated while the graph is replayed
+  ORT_ENFORCE(!(info.use_cuda_mem_pool && info.enable_cuda_graph),
+              "use_cuda_mem_pool can't be used with enable_cuda_graph.");
 
   if (info.has_user_compute_stream) {
     external_stream_ = true;
@@ -266,6 +298,10 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
 
   OverrideTunableOpInfoByEnv(info_);
 
+  if (info_.pinned_staging_pool_max_bytes > 0) {
+    staging_pool_ = std::make_shared<CudaPinnedStagingPool>(info_.pinned_staging_pool_max_bytes);
+  }
+
 #ifdef USE_TRITON_KERNEL
   onnxruntime::cuda::LoadOrtTritonKernel();
 #endif
@@ -292,7 +328,7 @@ ITuningContext* CUDAExecutionProvider::GetTuningContext() const {
 }
 
 std::unique_ptr<profiling::EpProfiler> CUDAExecutionProvider::GetProfiler() {
-  return std::make_unique<profiling::CudaProfiler>();
+  return std::make_unique<profiling::CudaProfiler>(info_.enable_profiling_kernel_metrics);
 }
 
 // Suppressing warning "C26816: The pointer points to memory allocated on the stack." for
@@ -324,7 +360,8 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
     // get or create a context
     if (context_state_.retired_context_pool.empty()) {
       context = std::make_shared<PerThreadContext>(info_.device_id, stream_, info_.gpu_mem_limit,
-                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+                                                   info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                                   info_.cuda_graph_max_captures);
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -424,6 +461,12 @@ Status CUDAExecutionProvider::ReplayGraph() {
   return GetPerThreadContext().ReplayGraph();
 }
 
+void CUDAExecutionProvider::SetGraphCaptureKey(const std::string& key) {
+  if (IsGraphCaptureEnabled()) {
+    GetPerThreadContext().SetGraphCaptureKey(key);
+  }
+}
+
 namespace cuda {
 // opset 1 to 9
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
@@ -2480,7 +2523,7 @@ static bool CastNeedFallbackToCPU(const onnxruntime::Node& node) {
 }
 
 std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransfer() const {
-  return std::make_unique<onnxruntime::GPUDataTransfer>();
+  return std::make_unique<onnxruntime::GPUDataTransfer>(staging_pool_);
 }
 
 std::vector<std::unique_ptr<ComputeCapability>>
@@ -2592,9 +2635,23 @@ std::vector<AllocatorPtr> CUDAExecutionProvider::CreatePreferredAllocators() {
       // correct to use the GPU device id, unless we wanted to share the pinned memory allocator across devices,
       // at the risk the lifetime isn't managed correctly if one of those devices go away.
       0);
+  AllocatorPtr device_allocator;
+  if (info_.use_cuda_mem_pool) {
+    AllocatorCreationInfo mem_pool_memory_info(
+        [release_threshold = info_.cuda_mem_pool_release_threshold](OrtDevice::DeviceId id) {
+          return std::make_unique<CUDAMemPoolAllocator>(id, CUDA, release_threshold);
+        },
+        info_.device_id,
+        // the pool reuses the memory itself
+        false);
+    device_allocator = CreateAllocator(mem_pool_memory_info);
+  } else {
+    device_allocator = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
+                                           info_.external_allocator_info, info_.default_memory_arena_cfg,
+                                           info_.enable_cross_stream_buffer_reuse);
+  }
   return std::vector<AllocatorPtr>{
-      CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                          info_.external_allocator_info, info_.default_memory_arena_cfg),
+      device_allocator,
       CreateAllocator(pinned_memory_info),
   };
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <set>
 #include <vector>
 
@@ -11,6 +12,7 @@
 #include "core/platform/ort_mutex.h"
 #include "core/providers/cuda/cuda_execution_provider_info.h"
 #include "core/providers/cuda/cuda_graph.h"
+#include "core/providers/cuda/cuda_pinned_staging_pool.h"
 #include "core/providers/cuda/cuda_pch.h"
 #include "core/providers/cuda/shared_inc/cuda_utils.h"
 #include "core/providers/cuda/shared_inc/cuda_call.h"
@@ -74,7 +76,8 @@ class CUDAExecutionProvider : public IExecutionProvider {
   }
 
   static AllocatorPtr CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, const OrtArenaCfg* arena_cfg);
+                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, const OrtArenaCfg* arena_cfg,
+                                          bool enable_cross_stream_reusing = false);
 
   ITuningContext* GetTuningContext() const override;
 
@@ -83,6 +86,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool IsGraphCaptureEnabled() const override;
   bool IsGraphCaptured() const override;
   Status ReplayGraph() override;
+  void SetGraphCaptureKey(const std::string& key) override;
   void RegisterStreamHandlers(IStreamCommandHandleRegistry& stream_handle_registry, AllocatorMap& allocators) const override;
   OrtDevice GetOrtDeviceByMemType(OrtMemType mem_type) const override;
   std::vector<AllocatorPtr> CreatePreferredAllocators() override;
@@ -96,13 +100,17 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   bool use_ep_level_unified_stream_ = false;
 
+  // stages copies between pageable host memory and the device. shared by the data transfers of all sessions.
+  std::shared_ptr<CudaPinnedStagingPool> staging_pool_;
+
   // the tuning context might be altered when calling into a TunableOp
   mutable cuda::tunable::CudaTuningContext tuning_context_;
 
   class PerThreadContext final {
    public:
     PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+                     CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                     int cuda_graph_max_captures);
     ~PerThreadContext();
 
     cublasHandle_t CublasHandle() const {
@@ -164,6 +172,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
       }
     }
 
+    void SetGraphCaptureKey(const std::string& key);
     bool IsGraphCaptureAllowed() const;
     void CaptureBegin();
     void CaptureEnd();
@@ -185,11 +194,26 @@ class CUDAExecutionProvider : public IExecutionProvider {
     std::unique_ptr<cuda::IConstantBuffer<Float8E5M2>> constant_ones_float8e5m2_;
 #endif
 
-    // Cuda graph with multi threads will be supported in the future, so cuda_graph_
-    // is put under PerThreadContext.
-    CUDAGraph cuda_graph_;
-    bool is_graph_captured_ = false;
-    int regular_run_count_before_graph_capture_ = 0;
+    struct CapturedGraph {
+      CapturedGraph(std::string graph_key, cudaStream_t stream) : key(std::move(graph_key)), cuda_graph(stream) {}
+
+      std::string key;
+      CUDAGraph cuda_graph;
+      bool is_graph_captured = false;
+      int regular_run_count_before_graph_capture = 0;
+    };
+
+    // Cuda graph with multi threads will be supported in the future, so the cuda graphs
+    // are put under PerThreadContext.
+    // With cuda_graph_max_captures_ > 0 there is one graph per graph capture key (i.e. per set of input shapes),
+    // ordered from the most to the least recently used. Otherwise there is a single graph whatever the key is.
+    // The addresses baked into a graph stay valid after other graphs ran because the arena does not release the
+    // chunks it hands out to the runs, so all the graphs share the device arena rather than owning a memory pool each.
+    cudaStream_t stream_;
+    const int cuda_graph_max_captures_;
+    std::list<CapturedGraph> cuda_graphs_;
+    std::unordered_map<std::string, std::list<CapturedGraph>::iterator> cuda_graphs_by_key_;
+    CapturedGraph* current_cuda_graph_;
 
     // There is chance that the second regular run allocates GPU memory for causes like:
     // (1) memory pattern is enabled. (2) arena allocation for stream.
@@ -29,6 +29,12 @@ constexpr const char* kTunableOpEnable = "tunable_op_enable";
 constexpr const char* kTunableOpTuningEnable = "tunable_op_tuning_enable";
 constexpr const char* kTunableOpMaxTuningDurationMs = "tunable_op_max_tuning_duration_ms";
 constexpr const char* kEnableSkipLayerNormStrictMode = "enable_skip_layer_norm_strict_mode";
+constexpr const char* kPinnedStagingPoolMaxBytes = "pinned_staging_pool_max_bytes";
+constexpr const char* kEnableCrossStreamBufferReuse = "enable_cross_stream_buffer_reuse";
+constexpr const char* kCudaGraphMaxCaptures = "cuda_graph_max_captures";
+constexpr const char* kUseCudaMemPool = "use_cuda_mem_pool";
+constexpr const char* kCudaMemPoolReleaseThreshold = "cuda_mem_pool_release_threshold";
+constexpr const char* kEnableProfilingKernelMetrics = "enable_profiling_kernel_metrics";
 }  // namespace provider_option_names
 }  // namespace cuda
 
@@ -99,6 +105,22 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToReference(cuda::provider_option_names::kEnableCudaGraph, info.enable_cuda_graph)
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConv1dPadToNc1d, info.cudnn_conv1d_pad_to_nc1d)
           .AddAssignmentToReference(cuda::provider_option_names::kEnableSkipLayerNormStrictMode, info.enable_skip_layer_norm_strict_mode)
+          .AddAssignmentToReference(cuda::provider_option_names::kPinnedStagingPoolMaxBytes, info.pinned_staging_pool_max_bytes)
+          .AddAssignmentToReference(cuda::provider_option_names::kEnableCrossStreamBufferReuse, info.enable_cross_stream_buffer_reuse)
+          .AddValueParser(
+              cuda::provider_option_names::kCudaGraphMaxCaptures,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.cuda_graph_max_captures));
+                ORT_RETURN_IF_NOT(info.cuda_graph_max_captures >= 0,
+                                  "Invalid ", cuda::provider_option_names::kCudaGraphMaxCaptures, ": ",
+                                  info.cuda_graph_max_captures, ", must not be negative.");
+                return Status::OK();
+              })
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMemPool, info.use_cuda_mem_pool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+                                    info.cuda_mem_pool_release_threshold)
+          .AddAssignmentToReference(cuda::provider_option_names::kEnableProfilingKernelMetrics,
+                                    info.enable_profiling_kernel_metrics)
           .AddValueParser(
               cuda::provider_option_names::kTunableOpEnable,
               [&info](const std::string& value_str) -> Status {
@@ -144,6 +166,12 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kTunableOpTuningEnable, MakeStringWithClassicLocale(info.tunable_op.tuning_enable)},
       {cuda::provider_option_names::kTunableOpMaxTuningDurationMs, MakeStringWithClassicLocale(info.tunable_op.max_tuning_duration_ms)},
       {cuda::provider_option_names::kEnableSkipLayerNormStrictMode, MakeStringWithClassicLocale(info.enable_skip_layer_norm_strict_mode)},
+      {cuda::provider_option_names::kPinnedStagingPoolMaxBytes, MakeStringWithClassicLocale(info.pinned_staging_pool_max_bytes)},
+      {cuda::provider_option_names::kEnableCrossStreamBufferReuse, MakeStringWithClassicLocale(info.enable_cross_stream_buffer_reuse)},
+      {cuda::provider_option_names::kCudaGraphMaxCaptures, MakeStringWithClassicLocale(info.cuda_graph_max_captures)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mem_pool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.cuda_mem_pool_release_threshold)},
+      {cuda::provider_option_names::kEnableProfilingKernelMetrics, MakeStringWithClassicLocale(info.enable_profiling_kernel_metrics)},
   };
 
   return options;
@@ -162,6 +190,12 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
       {cuda::provider_option_names::kTunableOpEnable, MakeStringWithClassicLocale(info.tunable_op_enable)},
       {cuda::provider_option_names::kTunableOpTuningEnable, MakeStringWithClassicLocale(info.tunable_op_tuning_enable)},
       {cuda::provider_option_names::kTunableOpMaxTuningDurationMs, MakeStringWithClassicLocale(info.tunable_op_max_tuning_duration_ms)},
+      {cuda::provider_option_names::kPinnedStagingPoolMaxBytes, MakeStringWithClassicLocale(info.pinned_staging_pool_max_bytes)},
+      {cuda::provider_option_names::kEnableCrossStreamBufferReuse, MakeStringWithClassicLocale(info.enable_cross_stream_buffer_reuse)},
+      {cuda::provider_option_names::kCudaGraphMaxCaptures, MakeStringWithClassicLocale(info.cuda_graph_max_captures)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mem_pool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.cuda_mem_pool_release_threshold)},
+      {cuda::provider_option_names::kEnableProfilingKernelMetrics, MakeStringWithClassicLocale(info.enable_profiling_kernel_metrics)},
   };
 
   return options;
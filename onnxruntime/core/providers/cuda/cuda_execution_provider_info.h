@@ -72,6 +72,28 @@ struct CUDAExecutionProviderInfo {
 
   bool enable_skip_layer_norm_strict_mode{false};
 
+  // Maximum total size of the pinned host buffers used to stage copies between pageable host memory and the device.
+  // 0 disables staging.
+  size_t pinned_staging_pool_max_bytes{0};
+
+  // Let the device arena hand a chunk freed on one stream to another stream, which then waits for the work enqueued
+  // on the first stream. Otherwise each stream only reuses its own chunks until the end of the run.
+  bool enable_cross_stream_buffer_reuse{false};
+
+  // Keep up to this many CUDA graphs, one per distinct set of input shapes, evicting the least recently used one.
+  // 0 keeps the single graph captured by the first runs and replays it whatever the input shapes are.
+  int cuda_graph_max_captures{0};
+
+  // Allocate the device memory from a stream ordered memory pool (cudaMallocAsync) of the device, shared by all the
+  // sessions using it, instead of an arena owned by the EP. The driver reuses the memory freed on a stream for the
+  // work enqueued after it, and releases what the pool holds beyond the release threshold when synchronizing.
+  bool use_cuda_mem_pool{false};
+  size_t cuda_mem_pool_release_threshold{std::numeric_limits<size_t>::max()};
+
+  // Add the theoretical occupancy, the waves and the registers and shared memory of each kernel to its event in the
+  // profile, and the count, time and time weighted occupancy of its kernels to each node event.
+  bool enable_profiling_kernel_metrics{false};
+
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtCUDAProviderOptionsV2& info);
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/shared_library/provider_api.h"
+#include "core/providers/cuda/cuda_pinned_staging_pool.h"
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+
+namespace {
+
+struct StagingBufferInfo {
+  std::shared_ptr<CudaPinnedStagingPool> pool;
+  void* buffer;
+};
+
+void CUDART_CB ReleaseStagingBufferCallback(void* raw_info) {
+  std::unique_ptr<StagingBufferInfo> info(reinterpret_cast<StagingBufferInfo*>(raw_info));
+  info->pool->Release(info->buffer);
+}
+
+}  // namespace
+
+CudaPinnedStagingPool::~CudaPinnedStagingPool() {
+  // all buffers have been released by now, as a release pending on a stream holds a reference to the pool.
+  for (auto& bucket : free_buffers_) {
+    for (void* buffer : bucket.second) {
+      cudaFreeHost(buffer);
+    }
+  }
+}
+
+size_t CudaPinnedStagingPool::BucketSize(size_t size) {
+  size_t bucket_size = kMinBufferSize;
+  while (bucket_size < size) {
+    bucket_size *= 2;
+  }
+
+  return bucket_size;
+}
+
+bool CudaPinnedStagingPool::MakeRoom(size_t size) {
+  for (auto it = free_buffers_.rbegin(); it != free_buffers_.rend() && allocated_bytes_ + size > max_bytes_; ++it) {
+    auto& buffers = it->second;
+    while (!buffers.empty() && allocated_bytes_ + size > max_bytes_) {
+      void* buffer = buffers.back();
+      buffers.pop_back();
+      buffer_sizes_.erase(buffer);
+      allocated_bytes_ -= it->first;
+      cudaFreeHost(buffer);
+    }
+  }
+
+  return allocated_bytes_ + size <= max_bytes_;
+}
+
+void* CudaPinnedStagingPool::Acquire(size_t size) {
+  if (size == 0 || size > max_bytes_) {
+    return nullptr;
+  }
+
+  const size_t bucket_size = BucketSize(size);
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = free_buffers_.find(bucket_size);
+  if (it != free_buffers_.end() && !it->second.empty()) {
+    void* buffer = it->second.back();
+    it->second.pop_back();
+    return buffer;
+  }
+
+  if (!MakeRoom(bucket_size)) {
+    return nullptr;
+  }
+
+  void* buffer = nullptr;
+  if (cudaMallocHost(&buffer, bucket_size) != cudaSuccess) {
+    // clear the error so it is not reported by a later call
+    ORT_IGNORE_RETURN_VALUE(cudaGetLastError());
+    return nullptr;
+  }
+
+  buffer_sizes_[buffer] = bucket_size;
+  allocated_bytes_ += bucket_size;
+  return buffer;
+}
+
+void CudaPinnedStagingPool::Release(void* buffer) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = buffer_sizes_.find(buffer);
+  ORT_ENFORCE(it != buffer_sizes_.end(), "Buffer was not acquired from this staging pool.");
+  free_buffers_[it->second].push_back(buffer);
+}
+
+Status CudaPinnedStagingPool::ReleaseOnStream(void* buffer, cudaStream_t stream) {
+  auto info = std::make_unique<StagingBufferInfo>();
+  info->pool = shared_from_this();
+  info->buffer = buffer;
+  // the callback takes ownership of info
+  CUDA_RETURN_IF_ERROR(cudaLaunchHostFunc(stream, ReleaseStagingBufferCallback, info.get()));
+  info.release();
+  return Status::OK();
+}
+
+size_t CudaPinnedStagingPool::NumBytesAllocated() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return allocated_bytes_;
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_pch.h"
+
+namespace onnxruntime {
+
+/**
+ * A pool of pinned host buffers used to stage copies between pageable host memory and a CUDA device.
+ *
+ * Copies from pageable memory can't be asynchronous and allocating pinned memory per copy is slow and synchronizes
+ * the device, so the buffers are allocated once and kept for reuse. Buffer sizes are rounded up to a power of two
+ * of at least kMinBufferSize bytes. The total size of the buffers is capped at `max_bytes`. Unused buffers of other
+ * sizes are freed to make room for a new buffer, and copies that still don't fit are not staged.
+ *
+ * The pool must be owned by a std::shared_ptr as buffers released on a stream keep it alive until the stream
+ * reaches the release.
+ */
+class CudaPinnedStagingPool : public std::enable_shared_from_this<CudaPinnedStagingPool> {
+ public:
+  static constexpr size_t kMinBufferSize = 64 * 1024;
+
+  explicit CudaPinnedStagingPool(size_t max_bytes) : max_bytes_(max_bytes) {}
+  ~CudaPinnedStagingPool();
+
+  /**
+   * Get a buffer of at least `size` bytes.
+   * Returns nullptr if `size` is 0 or no buffer can be provided within the cap.
+   */
+  void* Acquire(size_t size);
+
+  // Return a buffer from Acquire to the pool.
+  void Release(void* buffer);
+
+  // Return a buffer from Acquire to the pool once the work enqueued on `stream` so far has completed.
+  Status ReleaseOnStream(void* buffer, cudaStream_t stream);
+
+  // Total size of the buffers allocated by the pool, whether in use or not.
+  size_t NumBytesAllocated() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaPinnedStagingPool);
+
+  static size_t BucketSize(size_t size);
+
+  // free unused buffers until `size` more bytes fit within the cap. The caller must hold mutex_.
+  bool MakeRoom(size_t size);
+
+  const size_t max_bytes_;
+
+  mutable OrtMutex mutex_;
+  size_t allocated_bytes_{0};
+  // bucket size of each buffer allocated by the pool
+  std::unordered_map<void*, size_t> buffer_sizes_;
+  // unused buffers by bucket size
+  std::map<size_t, std::vector<void*>> free_buffers_;
+};
+
+}  // namespace onnxruntime
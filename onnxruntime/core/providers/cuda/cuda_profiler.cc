@@ -12,16 +12,72 @@ namespace profiling {
 
 #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING)
 
-CudaProfiler::CudaProfiler() {
+CudaProfiler::CudaProfiler(bool enable_kernel_metrics) : enable_kernel_metrics_(enable_kernel_metrics) {
   auto& manager = CUPTIManager::GetInstance();
   client_handle_ = manager.RegisterClient();
+  if (enable_kernel_metrics_) {
+    manager.EnableKernelMetrics();
+  }
 }
 
 CudaProfiler::~CudaProfiler() {
   auto& manager = CUPTIManager::GetInstance();
+  if (enable_kernel_metrics_) {
+    manager.DisableKernelMetrics();
+  }
   manager.DeregisterClient(client_handle_);
 }
 
+void CudaProfiler::EndProfiling(TimePoint start_time, Events& events) {
+  GPUProfilerBase<CUPTIManager>::EndProfiling(start_time, events);
+  if (!enable_kernel_metrics_) {
+    return;
+  }
+
+  // MergeEvents puts the kernel events of a node right after the node event, naming it as their parent.
+  EventRecord* node_event = nullptr;
+  int64_t kernel_count = 0;
+  int64_t kernel_dur = 0;
+  double occupancy_dur = 0.0;
+  auto add_to_node_event = [&]() {
+    if (node_event != nullptr && kernel_count > 0) {
+      node_event->args["kernel_count"] = std::to_string(kernel_count);
+      node_event->args["kernel_dur"] = std::to_string(kernel_dur);
+      if (kernel_dur > 0) {
+        node_event->args["kernel_theoretical_occupancy"] = std::to_string(occupancy_dur / kernel_dur);
+      }
+    }
+    kernel_count = 0;
+    kernel_dur = 0;
+    occupancy_dur = 0.0;
+  };
+
+  for (auto& event : events) {
+    if (event.cat == EventCategory::NODE_EVENT) {
+      add_to_node_event();
+      node_event = &event;
+      continue;
+    }
+
+    if (event.cat != EventCategory::KERNEL_EVENT || node_event == nullptr) {
+      continue;
+    }
+
+    auto parent_it = event.args.find("parent_name");
+    if (parent_it == event.args.end() || parent_it->second != node_event->name) {
+      continue;
+    }
+
+    ++kernel_count;
+    kernel_dur += event.dur;
+    auto occupancy_it = event.args.find("theoretical_occupancy");
+    if (occupancy_it != event.args.end()) {
+      occupancy_dur += std::stod(occupancy_it->second) * event.dur;
+    }
+  }
+  add_to_node_event();
+}
+
 #endif /* #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING) */
 
 }  // namespace profiling
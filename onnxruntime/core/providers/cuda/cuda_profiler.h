@@ -20,16 +20,22 @@ namespace profiling {
 
 class CudaProfiler final : public GPUProfilerBase<CUPTIManager> {
  public:
-  CudaProfiler();
+  // With enable_kernel_metrics, the kernel events get the kernel metrics computed by CUPTIManager, and each node
+  // event the number of its kernels, their total duration and their duration weighted theoretical occupancy.
+  explicit CudaProfiler(bool enable_kernel_metrics = false);
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaProfiler);
   ~CudaProfiler();
+  void EndProfiling(TimePoint start_time, Events& events) override;
+
+ private:
+  bool enable_kernel_metrics_;
 };
 
 #else /* #if defined(USE_CUDA) && defined(ENABLE_CUDA_PROFILING) */
 
 class CudaProfiler final : public EpProfiler {
  public:
-  CudaProfiler() = default;
+  explicit CudaProfiler(bool = false) {}
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudaProfiler);
   ~CudaProfiler() {}
   bool StartProfiling(TimePoint) override { return true; }
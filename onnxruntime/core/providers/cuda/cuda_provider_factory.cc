@@ -222,6 +222,12 @@ struct CUDA_Provider : Provider {
     info.tunable_op.tuning_enable = params->tunable_op_tuning_enable;
     info.tunable_op.max_tuning_duration_ms = params->tunable_op_max_tuning_duration_ms;
     info.enable_skip_layer_norm_strict_mode = params->enable_skip_layer_norm_strict_mode != 0;
+    info.pinned_staging_pool_max_bytes = params->pinned_staging_pool_max_bytes;
+    info.enable_cross_stream_buffer_reuse = params->enable_cross_stream_buffer_reuse != 0;
+    info.cuda_graph_max_captures = params->cuda_graph_max_captures;
+    info.use_cuda_mem_pool = params->use_cuda_mem_pool != 0;
+    info.cuda_mem_pool_release_threshold = params->cuda_mem_pool_release_threshold;
+    info.enable_profiling_kernel_metrics = params->enable_profiling_kernel_metrics != 0;
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -253,6 +259,12 @@ struct CUDA_Provider : Provider {
     cuda_options.enable_cuda_graph = internal_options.enable_cuda_graph;
     cuda_options.cudnn_conv1d_pad_to_nc1d = internal_options.cudnn_conv1d_pad_to_nc1d;
     cuda_options.enable_skip_layer_norm_strict_mode = internal_options.enable_skip_layer_norm_strict_mode;
+    cuda_options.pinned_staging_pool_max_bytes = internal_options.pinned_staging_pool_max_bytes;
+    cuda_options.enable_cross_stream_buffer_reuse = internal_options.enable_cross_stream_buffer_reuse;
+    cuda_options.cuda_graph_max_captures = internal_options.cuda_graph_max_captures;
+    cuda_options.use_cuda_mem_pool = internal_options.use_cuda_mem_pool;
+    cuda_options.cuda_mem_pool_release_threshold = internal_options.cuda_mem_pool_release_threshold;
+    cuda_options.enable_profiling_kernel_metrics = internal_options.enable_profiling_kernel_metrics;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
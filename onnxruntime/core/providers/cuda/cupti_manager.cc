@@ -3,6 +3,7 @@
 
 #include "cupti_manager.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace onnxruntime {
@@ -116,6 +117,10 @@ void CUPTIManager::ProcessActivityBuffers(const std::vector<ProfilerActivityBuff
               {"block_z", std::to_string(kernel->blockZ)},
           };
 
+          if (num_kernel_metrics_clients_ > 0) {
+            AddKernelMetrics(*kernel, args);
+          }
+
           std::string name{demangle(kernel->name)};
 
           new (&event) EventRecord{
@@ -157,6 +162,57 @@ void CUPTIManager::ProcessActivityBuffers(const std::vector<ProfilerActivityBuff
   } /* for */
 }
 
+void CUPTIManager::AddKernelMetrics(const CUpti_ActivityKernel3& kernel,
+                                    std::unordered_map<std::string, std::string>& args) {
+  const int shared_memory = kernel.staticSharedMemory + kernel.dynamicSharedMemory;
+  args["registers_per_thread"] = std::to_string(kernel.registersPerThread);
+  args["shared_memory"] = std::to_string(shared_memory);
+  args["local_memory_per_thread"] = std::to_string(kernel.localMemoryPerThread);
+
+  auto props_it = device_props_.find(kernel.deviceId);
+  if (props_it == device_props_.end()) {
+    cudaDeviceProp props;
+    if (cudaGetDeviceProperties(&props, static_cast<int>(kernel.deviceId)) != cudaSuccess) {
+      return;
+    }
+    props_it = device_props_.emplace(kernel.deviceId, props).first;
+  }
+  const cudaDeviceProp& props = props_it->second;
+
+  // The number of blocks of the kernel resident on an SM at a time is bounded by the warps, the registers and the
+  // shared memory of an SM, the way the CUDA occupancy calculator computes it. Registers are allocated by warp in
+  // units of 256.
+  const int64_t threads_per_block = static_cast<int64_t>(kernel.blockX) * kernel.blockY * kernel.blockZ;
+  const int64_t warps_per_block = (threads_per_block + props.warpSize - 1) / props.warpSize;
+  const int64_t max_warps_per_sm = props.maxThreadsPerMultiProcessor / props.warpSize;
+  if (warps_per_block == 0 || max_warps_per_sm == 0) {
+    return;
+  }
+
+  int64_t blocks_per_sm = std::min<int64_t>(props.maxBlocksPerMultiProcessor, max_warps_per_sm / warps_per_block);
+  if (kernel.registersPerThread > 0) {
+    constexpr int64_t kRegisterAllocationUnit = 256;
+    const int64_t registers_per_warp =
+        (kernel.registersPerThread * props.warpSize + kRegisterAllocationUnit - 1) / kRegisterAllocationUnit *
+        kRegisterAllocationUnit;
+    blocks_per_sm = std::min<int64_t>(blocks_per_sm,
+                                      props.regsPerMultiprocessor / registers_per_warp / warps_per_block);
+  }
+  if (shared_memory > 0) {
+    const int64_t shared_memory_per_block = static_cast<int64_t>(shared_memory) + props.reservedSharedMemPerBlock;
+    blocks_per_sm = std::min<int64_t>(blocks_per_sm,
+                                      static_cast<int64_t>(props.sharedMemPerMultiprocessor) / shared_memory_per_block);
+  }
+
+  const double occupancy = static_cast<double>(blocks_per_sm * warps_per_block) / max_warps_per_sm;
+  args["theoretical_occupancy"] = std::to_string(occupancy);
+  if (blocks_per_sm > 0) {
+    // below 1, the grid leaves SMs idle
+    const int64_t blocks = static_cast<int64_t>(kernel.gridX) * kernel.gridY * kernel.gridZ;
+    args["waves"] = std::to_string(static_cast<double>(blocks) / (blocks_per_sm * props.multiProcessorCount));
+  }
+}
+
 void CUPTIAPI CUPTIManager::BufferRequested(uint8_t** buffer, size_t* size, size_t* maxNumRecords) {
   // ProfilerActivityBuffer expects a char[], match up new[] and delete[] types just to be safe!
   // Note on ownership: This method is a callback that is invoked whenever CUPTI needs
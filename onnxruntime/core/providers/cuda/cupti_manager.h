@@ -7,9 +7,12 @@
 
 #include <atomic>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <cupti.h>
+#include <cuda_runtime_api.h>
 
 // Do not move the check for CUDA_VERSION above #include <cupti.h>
 // the macros are defined in cupti.h
@@ -29,6 +32,10 @@ class CUPTIManager : public GPUTracerManager<CUPTIManager> {
   ~CUPTIManager();
   static CUPTIManager& GetInstance();
 
+  // The kernel events get the kernel metrics args while at least one client enables them.
+  void EnableKernelMetrics() { ++num_kernel_metrics_clients_; }
+  void DisableKernelMetrics() { --num_kernel_metrics_clients_; }
+
  protected:
   bool PushUniqueCorrelation(uint64_t unique_cid);
   void PopUniqueCorrelation(uint64_t& popped_unique_cid);
@@ -44,6 +51,13 @@ class CUPTIManager : public GPUTracerManager<CUPTIManager> {
 
   CUPTIManager() = default;
 
+  // Adds the resource usage of the kernel, its theoretical occupancy and the number of waves of its grid to args.
+  void AddKernelMetrics(const CUpti_ActivityKernel3& kernel, std::unordered_map<std::string, std::string>& args);
+
+  std::atomic<int> num_kernel_metrics_clients_{0};
+  // the properties of the devices the kernels ran on, only used by ProcessActivityBuffers
+  InlinedHashMap<uint32_t, cudaDeviceProp> device_props_;
+
   static void CUPTIAPI BufferRequested(uint8_t** buffer, size_t* size, size_t* maxNumRecords);
   static void CUPTIAPI BufferCompleted(CUcontext, uint32_t, uint8_t* buffer, size_t, size_t valid_size);
 }; /* class CUPTIManager*/
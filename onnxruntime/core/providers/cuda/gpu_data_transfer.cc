@@ -4,10 +4,35 @@
 #include "core/providers/shared_library/provider_api.h"
 
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include "core/providers/cuda/cuda_pinned_staging_pool.h"
 #include "cuda_common.h"
 
 namespace onnxruntime {
-GPUDataTransfer::GPUDataTransfer() {}
+namespace {
+bool IsPageable(const OrtDevice& device) {
+  return device.Type() == OrtDevice::CPU && device.MemType() == OrtDevice::MemType::DEFAULT;
+}
+
+// Get a staging buffer for a copy of `bytes` between pageable memory and the GPU on `stream`.
+// Returns nullptr if the copy should not be staged.
+void* AcquireStagingBuffer(CudaPinnedStagingPool* staging_pool, size_t bytes, cudaStream_t stream) {
+  if (staging_pool == nullptr) {
+    return nullptr;
+  }
+
+  // a host function releasing the buffer would be captured in the CUDA graph and run on every replay
+  cudaStreamCaptureStatus capture_status = cudaStreamCaptureStatusNone;
+  if (cudaStreamIsCapturing(stream, &capture_status) != cudaSuccess ||
+      capture_status != cudaStreamCaptureStatusNone) {
+    return nullptr;
+  }
+
+  return staging_pool->Acquire(bytes);
+}
+}  // namespace
+
+GPUDataTransfer::GPUDataTransfer(std::shared_ptr<CudaPinnedStagingPool> staging_pool)
+    : staging_pool_(std::move(staging_pool)) {}
 
 GPUDataTransfer::~GPUDataTransfer() {}
 
@@ -59,8 +84,22 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
 
   if (dst_device.Type() == OrtDevice::GPU) {
     if (src_device.Type() == OrtDevice::CPU) {
-      // copy from pinned memory to GPU, this is non-blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream.GetHandle())));
+      void* staging_buffer = IsPageable(src_device)
+                                 ? AcquireStagingBuffer(staging_pool_.get(), bytes, static_cast<cudaStream_t>(stream.GetHandle()))
+                                 : nullptr;
+      if (staging_buffer != nullptr) {
+        // copy from pageable memory to a pinned staging buffer, which is released once the copy to GPU is done
+        memcpy(staging_buffer, src_data, bytes);
+        const cudaError_t copy_result = cudaMemcpyAsync(dst_data, staging_buffer, bytes, cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream.GetHandle()));
+        if (copy_result != cudaSuccess) {
+          staging_pool_->Release(staging_buffer);
+          CUDA_RETURN_IF_ERROR(copy_result);
+        }
+        ORT_RETURN_IF_ERROR(staging_pool_->ReleaseOnStream(staging_buffer, static_cast<cudaStream_t>(stream.GetHandle())));
+      } else {
+        // copy from pinned memory to GPU, this is non-blocking
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream.GetHandle())));
+      }
     } else if (src_device.Type() == OrtDevice::GPU) {
       // copying between GPU, this is non-blocking
       if (dst_data != src_data) {
@@ -69,8 +108,24 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
     }
   } else if (src_device.Type() == OrtDevice::GPU) {
     if (dst_device.Type() == OrtDevice::CPU) {
-      // copying from GPU to pinned memory, this is non-blocking
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, static_cast<cudaStream_t>(stream.GetHandle())));
+      void* staging_buffer = IsPageable(dst_device)
+                                 ? AcquireStagingBuffer(staging_pool_.get(), bytes, static_cast<cudaStream_t>(stream.GetHandle()))
+                                 : nullptr;
+      if (staging_buffer != nullptr) {
+        // a copy to pageable memory blocks anyway, so wait for the copy to the staging buffer and copy it from there
+        cudaError_t copy_result = cudaMemcpyAsync(staging_buffer, src_data, bytes, cudaMemcpyDeviceToHost, static_cast<cudaStream_t>(stream.GetHandle()));
+        if (copy_result == cudaSuccess) {
+          copy_result = cudaStreamSynchronize(static_cast<cudaStream_t>(stream.GetHandle()));
+        }
+        if (copy_result == cudaSuccess) {
+          memcpy(dst_data, staging_buffer, bytes);
+        }
+        staging_pool_->Release(staging_buffer);
+        CUDA_RETURN_IF_ERROR(copy_result);
+      } else {
+        // copying from GPU to pinned memory, this is non-blocking
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, static_cast<cudaStream_t>(stream.GetHandle())));
+      }
     }
   } else {
     if (src_device.MemType() == OrtDevice::MemType::CUDA_PINNED) {
@@ -3,14 +3,19 @@
 
 #pragma once
 
+#include <memory>
+
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
 
 namespace onnxruntime {
 
+class CudaPinnedStagingPool;
+
 class GPUDataTransfer : public IDataTransfer {
  public:
-  GPUDataTransfer();
+  // if `staging_pool` is provided, copies between pageable host memory and the GPU are staged through its buffers.
+  explicit GPUDataTransfer(std::shared_ptr<CudaPinnedStagingPool> staging_pool = nullptr);
   ~GPUDataTransfer();
 
   bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override;
@@ -19,6 +24,9 @@ class GPUDataTransfer : public IDataTransfer {
   using IDataTransfer::CopyTensor;
   common::Status CopyTensor(const Tensor& src, Tensor& dst) const override;
   common::Status CopyTensorAsync(const Tensor& src, Tensor& dst, Stream& stream) const override;
+
+ private:
+  std::shared_ptr<CudaPinnedStagingPool> staging_pool_;
 };
 
 }  // namespace onnxruntime
@@ -44,7 +44,8 @@ const std::vector<MLDataType>& CastOpTypeConstraints() {
       kCudaExecutionProvider,                                     \
       (*KernelDefBuilder::Create())                               \
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()) \
-          .TypeConstraint("T2", CastOpTypeConstraints()),         \
+          .TypeConstraint("T2", CastOpTypeConstraints())          \
+          .MayInplace(0, 0),                                      \
       Cast<T>);                                                   \
   ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                        \
       Cast,                                                       \
@@ -54,7 +55,8 @@ const std::vector<MLDataType>& CastOpTypeConstraints() {
       kCudaExecutionProvider,                                     \
       (*KernelDefBuilder::Create())                               \
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()) \
-          .TypeConstraint("T2", CastOpTypeConstraints()),         \
+          .TypeConstraint("T2", CastOpTypeConstraints())          \
+          .MayInplace(0, 0),                                      \
       Cast<T>);                                                   \
   ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                        \
       Cast,                                                       \
@@ -64,7 +66,8 @@ const std::vector<MLDataType>& CastOpTypeConstraints() {
       kCudaExecutionProvider,                                     \
       (*KernelDefBuilder::Create())                               \
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()) \
-          .TypeConstraint("T2", CastOpTypeConstraints()),         \
+          .TypeConstraint("T2", CastOpTypeConstraints())          \
+          .MayInplace(0, 0),                                      \
       Cast<T>);                                                   \
   ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
       Cast,                                                       \
@@ -74,7 +77,8 @@ const std::vector<MLDataType>& CastOpTypeConstraints() {
       kCudaExecutionProvider,                                     \
       (*KernelDefBuilder::Create())                               \
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()) \
-          .TypeConstraint("T2", CastOpTypeConstraints()),         \
+          .TypeConstraint("T2", CastOpTypeConstraints())          \
+          .MayInplace(0, 0),                                      \
       Cast<T>);
 
 #define CASE(TP_TYPE, DstT)                                                                 \
@@ -315,7 +319,8 @@ SPECIALIZE_IMPL(BFloat16)
       kCudaExecutionProvider,                                     \
       (*KernelDefBuilder::Create())                               \
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>()) \
-          .TypeConstraint("T2", CastOpTypeConstraints()),         \
+          .TypeConstraint("T2", CastOpTypeConstraints())          \
+          .MayInplace(0, 0),                                      \
       Cast<T>);
 
 #if !defined(DISABLE_FLOAT8_TYPES)
@@ -50,6 +50,12 @@ DnnlExecutionProvider::DnnlExecutionProvider(const DnnlExecutionProviderInfo& in
     enable_fusion_ = (std::stoi(fusion_env) == 0 ? false : true);
   }
 
+  // 0 recompiles the primitives whenever the input shapes of a subgraph change
+  const std::string primitive_cache_size_env = onnxruntime::GetEnvironmentVar("ORT_DNNL_PRIMITIVE_CACHE_SIZE");
+  if (!primitive_cache_size_env.empty()) {
+    primitive_cache_size_ = static_cast<size_t>(std::stoul(primitive_cache_size_env));
+  }
+
   // Set the number of threads specified by the user
   // If provided arguments set them as the number of threads, else call
   // calc which usually = numcores
@@ -297,7 +303,8 @@ Status DnnlExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
     }
 
     // subgraph primitive
-    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get());
+    auto dnnl_subgraph_primitive = std::make_unique<ort_dnnl::DnnlSubgraphPrimitive>(*subgraphs_[fused_node.Name()].get(),
+                                                                                     primitive_cache_size_);
     {
       const auto& input_defs = fused_node.InputDefs();
       std::vector<std::string> onnx_input_names(input_defs.size());
@@ -41,6 +41,8 @@ class DnnlExecutionProvider : public IExecutionProvider {
   bool debug_log_ = false;
   // enable fusion by default
   bool enable_fusion_ = true;
+  // number of input shapes each subgraph keeps its compiled primitives for
+  size_t primitive_cache_size_ = 8;
 };
 
 }  // namespace onnxruntime
@@ -35,6 +35,7 @@
 #include "dnnl_relugrad.h"
 #endif
 
+#include <algorithm>
 #include <inttypes.h>
 #include <stdio.h>
 #include <iostream>
@@ -240,7 +241,8 @@ void DnnlSubgraphPrimitive::AddKernels() {
   }
 }
 
-DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph) {
+DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t cache_size)
+    : cache_size_(cache_size) {
   subgraph_ = &dnnl_subgraph;
   if (dnnl_engine_get_count(dnnl_engine_kind_t::dnnl_cpu)) {
     cpu_engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
@@ -251,6 +253,56 @@ DnnlSubgraphPrimitive::DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgra
   }
 }
 
+DnnlSubgraphPrimitive::~DnnlSubgraphPrimitive() {
+  if (IsDynamic()) {
+    LOGS_DEFAULT(INFO) << "Subgraph primitive cache: " << cache_hits_ << " hits, " << cache_misses_ << " misses";
+  }
+}
+
+void DnnlSubgraphPrimitive::CacheCompiledShape() {
+  if (cache_size_ == 0) {
+    return;
+  }
+  CompiledShape compiled;
+  compiled.intermediates = std::move(intermediates_);
+  compiled.inputs = std::move(inputs_);
+  compiled.inputs_md = std::move(inputs_md_);
+  compiled.input_is_scalar = std::move(input_is_scalar_);
+  compiled.outputs = std::move(outputs_);
+  compiled.outputs_md = std::move(outputs_md_);
+  compiled.outputs_are_always_copied = std::move(outputs_are_always_copied_);
+  compiled.net = std::move(net_);
+  compiled.net_args = std::move(net_args_);
+  compiled.reshapes = std::move(reshapes_);
+  compiled.scalar_outputs = std::move(scalar_outputs_);
+  compiled_shapes_.emplace_front(shape_key_, std::move(compiled));
+  if (compiled_shapes_.size() > cache_size_) {
+    compiled_shapes_.pop_back();
+  }
+}
+
+bool DnnlSubgraphPrimitive::RestoreCompiledShape(const std::string& key) {
+  auto it = std::find_if(compiled_shapes_.begin(), compiled_shapes_.end(),
+                         [&key](const auto& entry) { return entry.first == key; });
+  if (it == compiled_shapes_.end()) {
+    return false;
+  }
+  CompiledShape& compiled = it->second;
+  intermediates_ = std::move(compiled.intermediates);
+  inputs_ = std::move(compiled.inputs);
+  inputs_md_ = std::move(compiled.inputs_md);
+  input_is_scalar_ = std::move(compiled.input_is_scalar);
+  outputs_ = std::move(compiled.outputs);
+  outputs_md_ = std::move(compiled.outputs_md);
+  outputs_are_always_copied_ = std::move(compiled.outputs_are_always_copied);
+  net_ = std::move(compiled.net);
+  net_args_ = std::move(compiled.net_args);
+  reshapes_ = std::move(compiled.reshapes);
+  scalar_outputs_ = std::move(compiled.scalar_outputs);
+  compiled_shapes_.erase(it);
+  return true;
+}
+
 bool DnnlSubgraphPrimitive::IsDynamic() {
   return subgraph_->IsDynamic();
 }
@@ -276,11 +328,21 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
     key += "|";
   }
   // if key different from shape key, update and recompile
-  if (key != shape_key_) {
-    shape_key_ = key;
-  } else {
+  if (key == shape_key_) {
     return;
   }
+  if (!shape_key_.empty()) {
+    CacheCompiledShape();
+  }
+  shape_key_ = key;
+  // the data handles of the inputs and outputs are set by Predict, and the initializers are kept across shapes
+  if (RestoreCompiledShape(key)) {
+    ++cache_hits_;
+    LOGS_DEFAULT(VERBOSE) << "Reusing the primitives compiled for shape " << key;
+    return;
+  }
+  ++cache_misses_;
+
   if (IsDynamic()) {
     LOGS_DEFAULT(INFO) << "Dynamic Compile";
   } else {
@@ -297,6 +359,7 @@ void DnnlSubgraphPrimitive::Compile(const std::unordered_map<std::string, OnnxTe
   net_args_.clear();
   reshapes_.clear();
   scalar_outputs_.clear();
+  input_is_scalar_.clear();
   // initializer should not be cleared upon recompile
   // initializers_.clear();
 
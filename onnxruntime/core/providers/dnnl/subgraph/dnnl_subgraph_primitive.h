@@ -6,6 +6,8 @@
 #include "dnnl.hpp"
 #include "core/platform/ort_mutex.h"
 
+#include <list>
+
 namespace onnxruntime {
 namespace ort_dnnl {
 
@@ -22,8 +24,10 @@ struct OnnxTensorData {
 
 class DnnlSubgraphPrimitive {
  public:
-  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph);
-  ~DnnlSubgraphPrimitive() = default;
+  // cache_size is the number of other input shapes the compiled primitives are kept for, so that switching back to
+  // one of them doesn't recompile
+  DnnlSubgraphPrimitive(ort_dnnl::DnnlSubgraph& dnnl_subgraph, size_t cache_size = 0);
+  ~DnnlSubgraphPrimitive();
 
   // compile subgraph primitive with runtime input information
   void Compile(const std::unordered_map<std::string, OnnxTensorData>& inputs);
@@ -96,7 +100,31 @@ class DnnlSubgraphPrimitive {
   }
 
  private:
+  // the primitives and memories compiled for one shape key
+  struct CompiledShape {
+    std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates;
+    std::unordered_map<std::string, dnnl::memory> inputs;
+    std::unordered_map<std::string, dnnl::memory::desc> inputs_md;
+    std::unordered_set<std::string> input_is_scalar;
+    std::unordered_map<std::string, dnnl::memory> outputs;
+    std::unordered_map<std::string, dnnl::memory::desc> outputs_md;
+    std::unordered_set<std::string> outputs_are_always_copied;
+    std::vector<dnnl::primitive> net;
+    std::vector<std::unordered_map<int, dnnl::memory>> net_args;
+    std::vector<std::pair<dnnl::memory, dnnl::memory>> reshapes;
+    std::unordered_set<std::string> scalar_outputs;
+  };
+  // moves the compiled state of shape_key_ into the cache, evicting the least recently used entry when full
+  void CacheCompiledShape();
+  // moves the compiled state of key out of the cache, returns false if it isn't cached
+  bool RestoreCompiledShape(const std::string& key);
+
   std::string shape_key_;
+  // most recently used first
+  std::list<std::pair<std::string, CompiledShape>> compiled_shapes_;
+  size_t cache_size_;
+  size_t cache_hits_{0};
+  size_t cache_misses_{0};
 
   std::unordered_map<std::string, std::vector<dnnl::memory>> intermediates_;
 
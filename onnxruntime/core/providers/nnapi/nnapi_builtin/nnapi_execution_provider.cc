@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/string_utils.h"
 #include "core/framework/compute_capability.h"
 #include "core/graph/graph_viewer.h"
@@ -46,13 +47,52 @@ std::unordered_set<std::string> GetPartitioningStopOps(const optional<std::strin
   return stop_ops_set;
 }
 
+size_t GetMinPartitionSize(const optional<std::string>& min_partition_size) {
+  if (!min_partition_size.has_value() || min_partition_size->empty()) {
+    return 0;
+  }
+
+  size_t value = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(min_partition_size.value(), value),
+              "Invalid NNAPI EP minimum partition size: \"", min_partition_size.value(),
+              "\". It should be a non-negative integer.");
+  LOGS_DEFAULT(INFO) << "Using minimum partition size from configuration: " << value << ".";
+  return value;
+}
+
+// Ops which only move, reshape or convert data. They gain little from the accelerator,
+// so they are not counted towards the size of a partition.
+constexpr std::array kDataMovementOps{
+    "Cast",
+    "DequantizeLinear",
+    "Flatten",
+    "Identity",
+    "QuantizeLinear",
+    "Reshape",
+    "Squeeze",
+    "Transpose",
+    "Unsqueeze",
+};
+
+// The number of nodes in the partition which do compute, an estimate of what the partition gains from NNAPI
+size_t GetNumComputeNodes(const GraphViewer& graph_viewer, const IndexedSubGraph& sub_graph) {
+  return static_cast<size_t>(std::count_if(
+      sub_graph.nodes.cbegin(), sub_graph.nodes.cend(), [&graph_viewer](NodeIndex node_index) {
+        const Node* node = graph_viewer.GetNode(node_index);
+        return node != nullptr &&
+               std::find(kDataMovementOps.begin(), kDataMovementOps.end(), node->OpType()) == kDataMovementOps.end();
+      }));
+}
+
 }  // namespace
 
 NnapiExecutionProvider::NnapiExecutionProvider(uint32_t nnapi_flags,
-                                               const optional<std::string>& partitioning_stop_ops_list)
+                                               const optional<std::string>& partitioning_stop_ops_list,
+                                               const optional<std::string>& min_partition_size)
     : IExecutionProvider{onnxruntime::kNnapiExecutionProvider, true},
       nnapi_flags_(nnapi_flags),
-      partitioning_stop_ops_(GetPartitioningStopOps(partitioning_stop_ops_list)) {
+      partitioning_stop_ops_(GetPartitioningStopOps(partitioning_stop_ops_list)),
+      min_partition_size_(GetMinPartitionSize(min_partition_size)) {
   nnapi_handle_ = NnApiImplementation();
   ORT_ENFORCE(nnapi_handle_ != nullptr, "Failed to get NnApiImplementation");
 
@@ -206,18 +246,41 @@ NnapiExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_view
     }
   });
 
-  const auto num_of_partitions = result.size();
+  // Each partition pays for its NNAPI compilation and for copying its inputs and outputs between the CPU and the
+  // accelerator, so small partitions, typically split apart by unsupported ops, are left to the CPU EP.
+  size_t num_of_dropped_partitions = 0;
+  if (min_partition_size_ > 0) {
+    std::for_each(result.begin(), result.end(), [&](auto& capability) {
+      if (capability && capability->sub_graph) {
+        const size_t num_compute_nodes = GetNumComputeNodes(graph_viewer, *capability->sub_graph);
+        if (num_compute_nodes < min_partition_size_) {
+          LOGS_DEFAULT(INFO) << "NnapiExecutionProvider::GetCapability, leaving partition with "
+                             << capability->sub_graph->nodes.size() << " nodes, " << num_compute_nodes
+                             << " of which do compute, to the CPU EP. Minimum partition size: " << min_partition_size_;
+          capability.reset();
+          ++num_of_dropped_partitions;
+        }
+      }
+    });
+  }
+
+  const auto num_of_partitions = static_cast<size_t>(std::count_if(
+      result.begin(), result.end(), [](const auto& partition) { return partition != nullptr; }));
   const auto num_of_supported_nodes = std::accumulate(
       result.begin(), result.end(), size_t{0},
       [](const auto& acc, const auto& partition) -> size_t {
         return acc + (partition && partition->sub_graph ? partition->sub_graph->nodes.size() : 0);
       });
 
-  const auto summary_msg = MakeString(
+  auto summary_msg = MakeString(
       "NnapiExecutionProvider::GetCapability,",
       " number of partitions supported by NNAPI: ", num_of_partitions,
       " number of nodes in the graph: ", graph_viewer.NumberOfNodes(),
       " number of nodes supported by NNAPI: ", num_of_supported_nodes);
+  if (num_of_dropped_partitions > 0) {
+    summary_msg += MakeString(" number of partitions left to the CPU EP for having fewer than ", min_partition_size_,
+                              " compute nodes: ", num_of_dropped_partitions);
+  }
 
   // If the graph is partitioned in multiple subgraphs, and this may impact performance,
   // we want to give users a summary message at warning level.
@@ -18,7 +18,8 @@ class Model;
 class NnapiExecutionProvider : public IExecutionProvider {
  public:
   explicit NnapiExecutionProvider(uint32_t nnapi_flags,
-                                  const optional<std::string>& partitioning_stop_ops_list = {});
+                                  const optional<std::string>& partitioning_stop_ops_list = {},
+                                  const optional<std::string>& min_partition_size = {});
 
   virtual ~NnapiExecutionProvider();
 
@@ -42,6 +43,9 @@ class NnapiExecutionProvider : public IExecutionProvider {
 
   const std::unordered_set<std::string> partitioning_stop_ops_;
 
+  // Partitions with fewer compute nodes than this are left to the CPU EP, 0 takes all partitions
+  const size_t min_partition_size_;
+
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::nnapi::Model>> nnapi_models_;
 
   // For Android NNAPI and stub implementation.
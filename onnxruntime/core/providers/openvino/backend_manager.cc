@@ -262,6 +262,7 @@ void BackendManager::Compute(OrtKernelContext* context) {
     auto key = MakeMapKeyString(tensor_shapes, GetGlobalContext().device_type);
 
     std::shared_ptr<IBackend> dynamic_backend;
+    std::unique_lock<std::mutex> lock(backend_map_mutex_);
     auto search = backend_map_.find(key);
     if (search == backend_map_.end()) {
       LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
@@ -280,6 +281,7 @@ void BackendManager::Compute(OrtKernelContext* context) {
     } else {
       dynamic_backend = search->second;
     }
+    lock.unlock();
 
     dynamic_backend->Infer(context);
   } else {
@@ -252,6 +252,57 @@ void FillOutputBlob(OVTensorPtr outputBlob, Ort::UnownedValue& output_tensor,
   std::memcpy(batch_memory_offset, output_data, output_data_size);
 }
 
+OVTensorPtr ShareOrtBuffer(const Ort::ConstValue& ort_tensor, const ov::element::Type& type, const ov::Shape& shape) {
+  auto mem_info = ort_tensor.GetTensorMemoryInfo();
+  if (mem_info.GetDeviceType() != OrtMemoryInfoDeviceType_CPU || mem_info.GetAllocatorName() == OpenVINO_GPU) {
+    return nullptr;
+  }
+
+  auto tensor_info = ort_tensor.GetTensorTypeAndShapeInfo();
+  ov::element::Type ort_type;
+  switch (tensor_info.GetElementType()) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      ort_type = ov::element::f32;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      ort_type = ov::element::f16;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      ort_type = ov::element::f64;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+      ort_type = ov::element::i8;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      ort_type = ov::element::u8;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+      ort_type = ov::element::i16;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      ort_type = ov::element::u16;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      ort_type = ov::element::i32;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      ort_type = ov::element::i64;
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      ort_type = ov::element::boolean;
+      break;
+    default:
+      return nullptr;
+  }
+  if (ort_type != type || tensor_info.GetElementCount() != ov::shape_size(shape)) {
+    return nullptr;
+  }
+
+  // OpenVINO does not write to the tensors of the inputs, the ORT buffer of an input is only const for ORT
+  void* data = const_cast<void*>(ort_tensor.GetTensorRawData());
+  return std::make_shared<ov::Tensor>(type, shape, data);
+}
+
 void printPerformanceCounts(const std::vector<OVProfilingInfo>& performanceMap,
                             std::ostream& stream, std::string deviceName) {
   long long totalTime = 0;
@@ -56,6 +56,11 @@ void FillInputBlob(OVTensorPtr inputBlob, size_t batch_slice_idx,
 void FillOutputBlob(OVTensorPtr outputBlob, Ort::UnownedValue& output_tensor,
                     size_t batch_slice_idx);
 
+// Wraps the buffer of an ORT tensor in CPU memory in an OpenVINO tensor of the given type and shape, so that
+// an infer request reads or writes it in place instead of copying it.
+// Returns nullptr if the buffer is not in CPU memory or the ORT tensor has another element type or element count.
+OVTensorPtr ShareOrtBuffer(const Ort::ConstValue& ort_tensor, const ov::element::Type& type, const ov::Shape& shape);
+
 std::shared_ptr<OVNetwork>
 CreateOVModel(const ONNX_NAMESPACE::ModelProto& model_proto, const GlobalContext& global_context, const SubGraphContext& subgraph_context,
               std::map<std::string, std::shared_ptr<ov::Node>>& const_outputs_map);
@@ -1,6 +1,7 @@
 // Copyright (C) 2019-2022 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <memory>
@@ -90,9 +91,17 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
     throw(msg);
   }
 
-  // The infer_requests_ pool will be intialized with a default value of 8 infer_request's
-  // The nireq value can also be configured to any num_of_threads during runtime
+  // The infer_requests_ pool is sized to the optimal number of infer requests of the device, so that concurrent runs
+  // are processed by parallel device streams. The nireq value can also be configured with num_of_threads
   size_t nireq = global_context_.num_of_threads;
+  if (nireq == 0) {
+    try {
+      nireq = exe_network_.Get().get_property(ov::optimal_number_of_infer_requests);
+    } catch (const ov::Exception& e) {
+      LOGS_DEFAULT(WARNING) << log_tag << "Failed to query the optimal number of infer requests: " << e.what();
+    }
+    nireq = std::max<size_t>(nireq, 1);
+  }
   LOGS_DEFAULT(INFO) << log_tag << "The value of nireq being used is: " << nireq;
 #ifndef NDEBUG
   if (openvino_ep::backend_utils::IsDebugEnabled()) {
@@ -204,24 +213,37 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
           tensor_iter += 1;
         }
         auto input = ie_cnn_network_->get_parameters().at(input_idx);
-        OVTensorPtr tensor_ptr = std::make_shared<ov::Tensor>(input->get_element_type(), input_tensor_shape);
-        FillInputBlob(tensor_ptr, batch_slice_idx, input_name, context, subgraph_context_);
+        OVTensorPtr tensor_ptr = ShareOrtBuffer(tensor, input->get_element_type(), input_tensor_shape);
+        if (tensor_ptr == nullptr) {
+          tensor_ptr = std::make_shared<ov::Tensor>(input->get_element_type(), input_tensor_shape);
+          FillInputBlob(tensor_ptr, batch_slice_idx, input_name, context, subgraph_context_);
+        }
         try {
           infer_request->SetTensor(input_name, tensor_ptr);
         } catch (const char* msg) {
           throw(msg);
         }
       } else {
-        OVTensorPtr graph_input_blob;
+        auto tensor = context.GetInput(subgraph_context_.input_names.at(input_name));
+        OVTensorPtr graph_input_blob = ShareOrtBuffer(tensor, input_info_iter->get_element_type(),
+                                                      input_info_iter->get_shape());
+        if (graph_input_blob == nullptr) {
+          // the request may hold the buffer of a previous run, so the input is copied to a tensor of its own
+          graph_input_blob = std::make_shared<ov::Tensor>(input_info_iter->get_element_type(),
+                                                          input_info_iter->get_shape());
+          FillInputBlob(graph_input_blob, batch_slice_idx, input_name, context, subgraph_context_);
+        }
         try {
-          graph_input_blob = infer_request->GetTensor(input_name);
+          infer_request->SetTensor(input_name, graph_input_blob);
         } catch (const char* msg) {
           throw(msg);
         }
-        FillInputBlob(graph_input_blob, batch_slice_idx, input_name, context, subgraph_context_);
       }
       input_idx++;
     }
+    if (!subgraph_context_.has_dynamic_input_shape) {
+      BindOutputBuffers(context, infer_request);
+    }
     // Start Async inference
     infer_request->StartAsync();
   } catch (const char* msg) {
@@ -229,6 +251,39 @@ void BasicBackend::StartAsyncInference(Ort::KernelContext& context, OVInferReque
   }
 }
 
+// Sets the ORT buffers of the outputs, whose shapes are static, as the output tensors of the infer request so that
+// the results are written in place
+void BasicBackend::BindOutputBuffers(Ort::KernelContext& context, OVInferRequestPtr infer_request) {
+  auto graph_output_info = exe_network_.Get().outputs();
+  for (auto output_info_iter = graph_output_info.begin();
+       output_info_iter != graph_output_info.end(); ++output_info_iter) {
+    if (output_info_iter->get_partial_shape().is_dynamic()) {
+      continue;
+    }
+    auto output_names = output_info_iter->get_names();
+    auto it = std::find_if(subgraph_context_.output_names.begin(), subgraph_context_.output_names.end(),
+                           [&output_names](const auto& name) { return output_names.count(name.first) > 0; });
+    if (it == subgraph_context_.output_names.end()) {
+      // reported when the results are copied
+      continue;
+    }
+
+    const auto& shape = output_info_iter->get_shape();
+    std::vector<int64_t> output_shape(shape.begin(), shape.end());
+    auto output_tensor = context.GetOutput(it->second, output_shape.data(), output_shape.size());
+    OVTensorPtr output_blob = ShareOrtBuffer(output_tensor.GetConst(), output_info_iter->get_element_type(), shape);
+    if (output_blob == nullptr) {
+      // the request may hold the buffer of a previous run, so the output is written to a tensor of its own
+      output_blob = std::make_shared<ov::Tensor>(output_info_iter->get_element_type(), shape);
+    }
+    try {
+      infer_request->SetTensor(it->first, output_blob);
+    } catch (const char* msg) {
+      throw(msg);
+    }
+  }
+}
+
 #ifdef IO_BUFFER_ENABLED
 // Wait for Remote Aynchronous inference completion
 void BasicBackend::StartRemoteAsyncInference(Ort::KernelContext& context, OVInferRequestPtr infer_request) {
@@ -368,7 +423,8 @@ void BasicBackend::CompleteAsyncInference(Ort::KernelContext& context, OVInferRe
       auto mem_info = output_tensor.GetTensorMemoryInfo();
       if (mem_info.GetAllocatorName() == OpenVINO_GPU) {
         return;
-      } else {
+      } else if (graph_output_blob->data() != output_tensor.GetTensorMutableRawData()) {
+        // not bound to the ORT buffer by BindOutputBuffers
         size_t batch_slice = 0;
         FillOutputBlob(graph_output_blob, output_tensor, batch_slice);
       }
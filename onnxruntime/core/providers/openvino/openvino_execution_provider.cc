@@ -25,7 +25,8 @@ OpenVINOExecutionProvider::OpenVINOExecutionProvider(const OpenVINOExecutionProv
   openvino_ep::BackendManager::GetGlobalContext().enable_dynamic_shapes = info.enable_dynamic_shapes_;
 
   if ((int)info.num_of_threads_ <= 0) {
-    openvino_ep::BackendManager::GetGlobalContext().num_of_threads = 8;
+    // the pool of infer requests of each backend is sized to the optimal number of requests of the device
+    openvino_ep::BackendManager::GetGlobalContext().num_of_threads = 0;
   } else if ((int)info.num_of_threads_ > 8) {
     std::string err_msg = std::string("\n [ERROR] num_of_threads configured during runtime is: ") + std::to_string(info.num_of_threads_) + "\nnum_of_threads configured should be >0 and <=8.\n";
     ORT_THROW(err_msg);
@@ -62,8 +62,9 @@ struct OpenVINO_Provider : Provider {
     bool enable_vpu_fast_compile = false;   // [enable_vpu_fast_compile]: Fast-compile may be optionally enabled to
                                             // speeds up the model's compilation to VPU device specific format.
     const char* device_id = "";             // [device_id]: Selects a particular hardware device for inference.
-    size_t num_of_threads = 8;              // [num_of_threads]: Overrides the accelerator default value of number of
-                                            //  threads with this value at runtime.
+    size_t num_of_threads = 0;              // [num_of_threads]: Overrides the accelerator default value of number of
+                                            //  threads with this value at runtime. 0 uses the optimal number of
+                                            //  infer requests of the device.
     const char* cache_dir = "";             // [cache_dir]: specify the path to
                                             // dump and load the blobs for the model caching/kernel caching (GPU)
                                             // feature. If blob files are already present, it will be directly loaded.
@@ -102,10 +103,8 @@ struct OpenVINO_Provider : Provider {
     }
 
     if (provider_options_map.find("num_of_threads") != provider_options_map.end()) {
-      num_of_threads = std::stoi(provider_options_map.at("num_of_threads"));
-      if (num_of_threads <= 0) {
-        num_of_threads = 1;
-      }
+      const int num_of_threads_option = std::stoi(provider_options_map.at("num_of_threads"));
+      num_of_threads = num_of_threads_option <= 0 ? 0 : static_cast<size_t>(num_of_threads_option);
     }
 
     if (provider_options_map.find("num_streams") != provider_options_map.end()) {
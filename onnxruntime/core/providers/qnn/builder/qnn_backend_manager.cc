@@ -344,7 +344,20 @@ Status WriteInt16ToBinaryFile(std::ofstream& of_stream, uint16_t value) {
   return Status::OK();
 }
 
-Status QnnBackendManager::DumpQnnContext(const std::string& model_name, const std::string& graph_name) {
+// The graphs of all the partitions are composed into the same context,
+// their names are stored in the metadata of the context binary file as a comma separated list
+std::string JoinGraphNames(const std::vector<std::string>& graph_names) {
+  std::string result;
+  for (const auto& graph_name : graph_names) {
+    if (!result.empty()) {
+      result += ",";
+    }
+    result += graph_name;
+  }
+  return result;
+}
+
+Status QnnBackendManager::DumpQnnContext(const std::string& model_name, const std::vector<std::string>& graph_names) {
   if (nullptr == qnn_interface_.contextGetBinarySize ||
       nullptr == qnn_interface_.contextGetBinary) {
     LOGS(*logger_, ERROR) << "Failed to get valid function pointer.";
@@ -387,12 +400,16 @@ Status QnnBackendManager::DumpQnnContext(const std::string& model_name, const st
   }
 
   // Write Ort metadata into context binary file
+  const std::string graph_name = JoinGraphNames(graph_names);
+  const std::string backend_build_id = GetBackendBuildId();
   uint16_t model_name_length = static_cast<uint16_t>(model_name.length());
   uint16_t graph_name_length = static_cast<uint16_t>(graph_name.length());
   uint16_t model_description_length = static_cast<uint16_t>(model_description_.length());
+  uint16_t backend_build_id_length = static_cast<uint16_t>(backend_build_id.length());
 
-  // Header: uint16_t(totale_length)|uint16_t(model_name_length)|model_name|uint16_t(graph_name_length)|graph_name|uint16_t(model_description_length)|model_description
-  uint16_t header_length = 4 * sizeof(uint16_t) + model_name_length + graph_name_length + model_description_length;
+  // Header: uint16_t(totale_length)|uint16_t(model_name_length)|model_name|uint16_t(graph_name_length)|graph_name|uint16_t(model_description_length)|model_description|uint16_t(backend_build_id_length)|backend_build_id
+  uint16_t header_length = 5 * sizeof(uint16_t) + model_name_length + graph_name_length + model_description_length +
+                           backend_build_id_length;
   uint16_t totale_length = header_length + static_cast<uint16_t>(strlen(QNN_PROVIDER));
   of_stream.write(QNN_PROVIDER, strlen(QNN_PROVIDER));
 
@@ -408,6 +425,9 @@ Status QnnBackendManager::DumpQnnContext(const std::string& model_name, const st
   of_stream.write(model_description_.c_str(), model_description_length);
   model_description_.clear();
 
+  ORT_RETURN_IF_ERROR(WriteInt16ToBinaryFile(of_stream, backend_build_id_length));
+  of_stream.write(backend_build_id.c_str(), backend_build_id_length);
+
   LOGS(*logger_, VERBOSE) << "Dump metadata with length: " << totale_length;
 
   of_stream.write(reinterpret_cast<char*>(context_buffer.get()), written_buffer_size);
@@ -416,7 +436,15 @@ Status QnnBackendManager::DumpQnnContext(const std::string& model_name, const st
   return Status::OK();
 }
 
-Status QnnBackendManager::LoadCachedQnnContext(QnnModel& qnn_model) {
+std::string GetGraphNameFromBinaryInfo(const QnnSystemContext_GraphInfo_t& qnn_sys_ctx_graph_info) {
+  if (qnn_sys_ctx_graph_info.version == QNN_SYSTEM_CONTEXT_GRAPH_INFO_VERSION_1 &&
+      nullptr != qnn_sys_ctx_graph_info.graphInfoV1.graphName) {
+    return qnn_sys_ctx_graph_info.graphInfoV1.graphName;
+  }
+  return "";
+}
+
+Status QnnBackendManager::LoadCachedQnnContext(std::unordered_map<std::string, std::unique_ptr<QnnModel>>& qnn_models) {
   bool result = nullptr == qnn_sys_interface_.systemContextCreate ||
                 nullptr == qnn_sys_interface_.systemContextGetBinaryInfo ||
                 nullptr == qnn_sys_interface_.systemContextFree;
@@ -472,7 +500,9 @@ Status QnnBackendManager::LoadCachedQnnContext(QnnModel& qnn_model) {
     graphs_info = binary_info->contextBinaryInfoV2.graphs;
   }
 
-  ORT_RETURN_IF(graph_count > 1, "Load from Qnn cached context only support 1 sub-graph.");
+  ORT_RETURN_IF(graph_count != qnn_models.size(), "The number of graphs in Qnn cached context: ", graph_count,
+                " is different with the number of partitions: ", qnn_models.size(),
+                ". You may need to re-generate the context binary file.");
   ORT_RETURN_IF(graphs_info == nullptr, "Failed to get graph info from Qnn cached context.");
 
   ORT_RETURN_IF(nullptr == qnn_interface_.contextCreateFromBinary,
@@ -486,7 +516,19 @@ Status QnnBackendManager::LoadCachedQnnContext(QnnModel& qnn_model) {
                                               profile_backend_handle_);
   ORT_RETURN_IF(QNN_SUCCESS != rt, "Failed to create context from binary.");
 
-  ORT_RETURN_IF_ERROR(qnn_model.DeserializeGraphInfoFromBinaryInfo(graphs_info[0]));
+  // All the graphs share the context, so the weights of the context are loaded once for all of them.
+  // A single graph is not matched by name since a context binary generated by the QNN toolchain names it freely.
+  if (1 == graph_count) {
+    ORT_RETURN_IF_ERROR(qnn_models.begin()->second->DeserializeGraphInfoFromBinaryInfo(graphs_info[0]));
+  } else {
+    for (uint32_t i = 0; i < graph_count; ++i) {
+      const std::string graph_name = GetGraphNameFromBinaryInfo(graphs_info[i]);
+      auto qnn_model_pos = qnn_models.find(graph_name);
+      ORT_RETURN_IF(qnn_model_pos == qnn_models.end(), "Graph: ", graph_name,
+                    " from Qnn cached context doesn't match any partition.");
+      ORT_RETURN_IF_ERROR(qnn_model_pos->second->DeserializeGraphInfoFromBinaryInfo(graphs_info[i]));
+    }
+  }
 
   qnn_sys_interface_.systemContextFree(sys_ctx_handle);
   sys_ctx_handle = nullptr;
@@ -564,27 +606,55 @@ Status QnnBackendManager::GetMetadataFromOrtContextFile() {
 
   uint16_t str_length = 0;
   ORT_RETURN_IF_ERROR(ReadInt16FromBinaryFile(cache_file, str_length));
-  ort_ctx_metadata_length_ = str_length + static_cast<uint16_t>(ort_flag_length);
+  const uint16_t header_length = str_length;
+  ort_ctx_metadata_length_ = header_length + static_cast<uint16_t>(ort_flag_length);
+  size_t header_read_length = sizeof(uint16_t);
 
   ORT_RETURN_IF_ERROR(ReadInt16FromBinaryFile(cache_file, str_length));
   ORT_RETURN_IF_ERROR(ReadStringFromBinaryFile(cache_file, model_name_from_ctx_cache_, static_cast<size_t>(str_length)));
+  header_read_length += sizeof(uint16_t) + str_length;
 
   ORT_RETURN_IF_ERROR(ReadInt16FromBinaryFile(cache_file, str_length));
   ORT_RETURN_IF_ERROR(ReadStringFromBinaryFile(cache_file, graph_name_from_ctx_cache_, static_cast<size_t>(str_length)));
+  header_read_length += sizeof(uint16_t) + str_length;
 
   ORT_RETURN_IF_ERROR(ReadInt16FromBinaryFile(cache_file, str_length));
   ORT_RETURN_IF_ERROR(ReadStringFromBinaryFile(cache_file, model_description_from_ctx_cache_, static_cast<size_t>(str_length)));
+  header_read_length += sizeof(uint16_t) + str_length;
+
+  // Files generated before the backend build id was recorded end the header here
+  if (header_read_length < header_length) {
+    ORT_RETURN_IF_ERROR(ReadInt16FromBinaryFile(cache_file, str_length));
+    ORT_RETURN_IF_ERROR(ReadStringFromBinaryFile(cache_file, backend_build_id_from_ctx_cache_,
+                                                 static_cast<size_t>(str_length)));
+  }
 
   return Status::OK();
 }
 
-/* \brief: Validate the model file name and graph name with Ort generated context cache metadata
+bool QnnBackendManager::IsContextCacheStale() {
+  auto status = GetMetadataFromOrtContextFile();
+  if (!status.IsOK()) {
+    LOGS(*logger_, WARNING) << "Failed to read metadata from Qnn context cache file: " << status.ErrorMessage();
+    return true;
+  }
+
+  // The context binary file generated from QNN toolchain is used as is
+  if (!ort_generated_ctx_cache_) {
+    return false;
+  }
+
+  return backend_build_id_from_ctx_cache_ != GetBackendBuildId();
+}
+
+/* \brief: Validate the model file name and graph names with Ort generated context cache metadata
  * \param[in] model_name - model file name
- * \param[in] graph_name - graph name, e.g Ort_QNN_[hash_id]_[id]. Since GetCapability is called twice,
- *                         [hash_id]_[id] changes even for same graph,
- *                          so only validate the graph name for 2nd call
+ * \param[in] graph_names - graph names of all the partitions, e.g Ort_QNN_[hash_id]_[id]. Since GetCapability is
+ *                          called twice, [hash_id]_[id] changes even for same graph,
+ *                          so only validate the graph names for 2nd call
  */
-Status QnnBackendManager::ValidateWithContextFile(const std::string& model_name, const std::string& graph_name) {
+Status QnnBackendManager::ValidateWithContextFile(const std::string& model_name,
+                                                  const std::vector<std::string>& graph_names) {
   ORT_RETURN_IF(!ctx_file_exists_, "Qnn context binary file not exist for some reason!");
 
   // Get metadata from cached context binary file
@@ -605,6 +675,7 @@ Status QnnBackendManager::ValidateWithContextFile(const std::string& model_name,
                     " is different with target: " + model_description_ +
                     ". Please make sure the context binary file matches the model.");
 
+  const std::string graph_name = JoinGraphNames(graph_names);
   ORT_RETURN_IF(graph_name != graph_name_from_ctx_cache_ && get_capability_round_2_,
                 "Graph name from context cache metadata: " + graph_name_from_ctx_cache_ +
                     " is different with target: " + graph_name +
@@ -623,15 +694,24 @@ Status QnnBackendManager::SetupBackend(const logging::Logger& logger, bool load_
   ORT_RETURN_IF_ERROR(LoadBackend());
   LOGS(logger, VERBOSE) << "LoadBackend succeed.";
 
-  if (load_from_cached_context) {
-    ORT_RETURN_IF_ERROR(LoadQnnSystemLib());
-  }
+  SetLogger(&logger);
+  LOGS(logger, VERBOSE) << "SetLogger succeed.";
 
   LOGS(logger, VERBOSE) << "Backend build version: "
                         << GetBackendBuildId();
 
-  SetLogger(&logger);
-  LOGS(logger, VERBOSE) << "SetLogger succeed.";
+  // A context binary generated with another QNN SDK is regenerated rather than loaded
+  if (load_from_cached_context && IsContextCacheStale()) {
+    LOGS(logger, WARNING) << "Qnn context cache file: " << context_cache_path_
+                          << " was generated with backend build version: " << backend_build_id_from_ctx_cache_
+                          << ", it will be re-generated.";
+    ctx_file_exists_ = false;
+    load_from_cached_context = false;
+  }
+
+  if (load_from_cached_context) {
+    ORT_RETURN_IF_ERROR(LoadQnnSystemLib());
+  }
 
   ORT_RETURN_IF_ERROR(InitializeBackend());
   LOGS(logger, VERBOSE) << "InitializeBackend succeed.";
@@ -10,6 +10,11 @@
 #include <dlfcn.h>
 #endif
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "HTP/QnnHtpDevice.h"
 #include "QnnLog.h"
 #include "System/QnnSystemInterface.h"
@@ -69,13 +74,15 @@ class QnnBackendManager {
     return CreateContext();
   }
 
-  Status DumpQnnContext(const std::string& model_name, const std::string& graph_name);
+  // Dumps the context, which holds the graphs of all the partitions, with the given graph names as metadata
+  Status DumpQnnContext(const std::string& model_name, const std::vector<std::string>& graph_names);
 
-  Status LoadCachedQnnContext(QnnModel& qnn_model);
+  // Creates the context from the cached binary and retrieves each graph in it into the model of the same name
+  Status LoadCachedQnnContext(std::unordered_map<std::string, std::unique_ptr<QnnModel>>& qnn_models);
 
   Status GetMetadataFromOrtContextFile();
 
-  Status ValidateWithContextFile(const std::string& model_name, const std::string& graph_name);
+  Status ValidateWithContextFile(const std::string& model_name, const std::vector<std::string>& graph_names);
 
   Status SetupBackend(const logging::Logger& logger, bool load_from_cached_context);
 
@@ -163,6 +170,9 @@ class QnnBackendManager {
 
   bool IsDevicePropertySupported();
 
+  // A context binary generated by ORT is only valid for the backend build it was generated with
+  bool IsContextCacheStale();
+
   template <typename T>
   std::vector<std::add_pointer_t<std::add_const_t<T>>> ObtainNullTermPtrVector(const std::vector<T>& vec) {
     std::vector<std::add_pointer_t<std::add_const_t<T>>> ret;
@@ -200,6 +210,7 @@ class QnnBackendManager {
   std::string model_name_from_ctx_cache_ = "";
   std::string graph_name_from_ctx_cache_ = "";
   std::string model_description_from_ctx_cache_ = "";
+  std::string backend_build_id_from_ctx_cache_ = "";
   std::string model_description_ = "";
   std::string context_cache_path_ = "";
   bool ctx_file_exists_ = false;
@@ -297,6 +297,13 @@ QNNExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_viewer
     return result;
   }
 
+  // SetupBackend discards a context cache file generated with another backend build
+  if (load_from_cached_context) {
+    load_from_cached_context = qnn_backend_manager_->IsContextCacheFileExists(context_cache_path_,
+                                                                              graph_viewer.Description(),
+                                                                              graph_viewer.ModelPath().ToPathString());
+  }
+
   if (context_cache_enabled_ && !qnn_backend_manager_->IsNpuBackend()) {
     LOGS(logger, ERROR) << "Qnn context cache only works for NPU backend.";
     return result;
@@ -387,19 +394,20 @@ QNNExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph_viewer
 
   const size_t num_of_partitions = result.size();
 
-  if (load_from_cached_context && 1 == num_of_partitions) {
+  if (load_from_cached_context && num_of_partitions > 0) {
+    std::vector<std::string> graph_names;
+    graph_names.reserve(num_of_partitions);
+    for (const auto& partition : result) {
+      graph_names.push_back(partition->sub_graph->GetMetaDef()->name);
+    }
     rt = qnn_backend_manager_->ValidateWithContextFile(GetFileNameFromModelPath(graph_viewer.ModelPath()),
-                                                       result[0]->sub_graph->GetMetaDef()->name);
+                                                       graph_names);
     if (Status::OK() != rt) {
       LOGS(logger, ERROR) << "QNN failed to validate context cache metadata: " << rt.ErrorMessage();
       return result;
     }
   }
 
-  if (num_of_partitions > 1) {
-    ORT_ENFORCE(!context_cache_enabled_, "Only support single partition for context cache feature.");
-  }
-
   const auto summary_msg = MakeString("Number of partitions supported by QNN EP: ", num_of_partitions,
                                       ", number of nodes in the graph: ", num_nodes_in_graph,
                                       ", number of nodes supported by QNN: ", num_of_supported_nodes);
@@ -473,8 +481,7 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
   bool is_npu_backend = qnn_backend_manager_->IsNpuBackend();
 
   if (context_cache_enabled_) {
-    ORT_ENFORCE(fused_nodes_and_graphs.size() == 1, "Only support singel partition for context cache feature.");
-    Node& fused_node = fused_nodes_and_graphs[0].fused_node;
+    // The graphs of all the partitions live in the same Qnn context, which is cached as a whole
     const onnxruntime::GraphViewer& graph_viewer(fused_nodes_and_graphs[0].filtered_graph);
     // The dumy_model_description won't be used since IsContextCacheFileExists call cached the result
     // The graph_viewer.Description here is not same with original model
@@ -484,27 +491,41 @@ Status QNNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused
                                                                                    graph_viewer.ModelPath().ToPathString());
     // Load and execute from cached context if exist
     if (load_from_cached_context) {
-      std::unique_ptr<qnn::QnnModel> qnn_model = std::make_unique<qnn::QnnModel>(logger,
-                                                                                 qnn_backend_manager_.get(),
-                                                                                 is_npu_backend);
-      ORT_RETURN_IF_ERROR(qnn_backend_manager_->LoadCachedQnnContext(*(qnn_model.get())));
-      ORT_RETURN_IF_ERROR(qnn_model->SetGraphInputOutputInfo(graph_viewer, fused_node));
-      ORT_RETURN_IF_ERROR(qnn_model->SetupQnnInputOutput());
-
-      // fused node name is QNNExecutionProvider_QNN_[hash_id]_[id]
-      // the name here should be same with context->node_name in compute_info
-      LOGS(logger, VERBOSE) << "fused node name: " << fused_node.Name();
-      qnn_models_.emplace(fused_node.Name(), std::move(qnn_model));
-
-      ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
+      // The graphs in the context are named after the partitions they were composed from
+      std::unordered_map<std::string, std::unique_ptr<qnn::QnnModel>> qnn_models;
+      for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+        qnn_models.emplace(fused_node_and_graph.filtered_graph.get().Name(),
+                           std::make_unique<qnn::QnnModel>(logger, qnn_backend_manager_.get(), is_npu_backend));
+      }
+      ORT_RETURN_IF_ERROR(qnn_backend_manager_->LoadCachedQnnContext(qnn_models));
+
+      for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+        Node& fused_node = fused_node_and_graph.fused_node;
+        const onnxruntime::GraphViewer& fused_graph_viewer(fused_node_and_graph.filtered_graph);
+        std::unique_ptr<qnn::QnnModel> qnn_model = std::move(qnn_models[fused_graph_viewer.Name()]);
+        ORT_RETURN_IF_ERROR(qnn_model->SetGraphInputOutputInfo(fused_graph_viewer, fused_node));
+        ORT_RETURN_IF_ERROR(qnn_model->SetupQnnInputOutput());
+
+        // fused node name is QNNExecutionProvider_QNN_[hash_id]_[id]
+        // the name here should be same with context->node_name in compute_info
+        LOGS(logger, VERBOSE) << "fused node name: " << fused_node.Name();
+        qnn_models_.emplace(fused_node.Name(), std::move(qnn_model));
+
+        ORT_RETURN_IF_ERROR(CreateComputeFunc(node_compute_funcs, logger));
+      }
       return Status::OK();
     } else {
       // Load and execute from Onnx model if not exit and dump the context
       ORT_RETURN_IF_ERROR(CompileFromOrtGraph(fused_nodes_and_graphs, node_compute_funcs, logger));
       // graph_viewer.Name() is generated in GetCapability, e.g QNN_[hash_id]_[id]
-      // dump graph_viewer.Name() as metadata in context cache binary file, so that we can validate it in GetCapability
+      // dump the names as metadata in context cache binary file, so that we can validate them in GetCapability
+      std::vector<std::string> graph_names;
+      graph_names.reserve(fused_nodes_and_graphs.size());
+      for (const auto& fused_node_and_graph : fused_nodes_and_graphs) {
+        graph_names.push_back(fused_node_and_graph.filtered_graph.get().Name());
+      }
       ORT_RETURN_IF_ERROR(qnn_backend_manager_->DumpQnnContext(GetFileNameFromModelPath(graph_viewer.ModelPath()),
-                                                               graph_viewer.Name()));
+                                                               graph_names));
     }
     return Status::OK();
   }
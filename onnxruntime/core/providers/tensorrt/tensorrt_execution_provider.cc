@@ -798,7 +798,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     ORT_IGNORE_RETURN_VALUE(CUDNN_CALL(cudnnSetStream(external_cudnn_handle_, stream_)));
   }
 
-  std::string profile_min_shapes, profile_max_shapes, profile_opt_shapes;
+  std::string profile_min_shapes, profile_max_shapes, profile_opt_shapes, profile_shapes_trace;
+  int num_auto_profiles = 3;
 
   // Get environment variables
   if (info.has_trt_options) {
@@ -841,6 +842,8 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     profile_max_shapes = info.profile_max_shapes;
     profile_opt_shapes = info.profile_opt_shapes;
     cuda_graph_enable_ = info.cuda_graph_enable;
+    profile_shapes_trace = info.profile_shapes_trace;
+    num_auto_profiles = info.num_auto_profiles;
   } else {
     try {
       const std::string max_partition_iterations_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxPartitionIterations);
@@ -985,6 +988,13 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       if (!cuda_graph_enable_env.empty()) {
         cuda_graph_enable_ = (std::stoi(cuda_graph_enable_env) == 0 ? false : true);
       }
+
+      profile_shapes_trace = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kProfileShapesTrace);
+
+      const std::string num_auto_profiles_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kNumAutoProfiles);
+      if (!num_auto_profiles_env.empty()) {
+        num_auto_profiles = std::stoi(num_auto_profiles_env);
+      }
     } catch (const std::invalid_argument& ex) {
       LOGS_DEFAULT(WARNING) << "[TensorRT EP] Invalid Argument (from environment variables): " << ex.what();
     } catch (const std::out_of_range& ex) {
@@ -1073,6 +1083,21 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     }
   }
 
+  // Explicit profile shapes take precedence over the ones generated from the observed shapes
+  if (status && !profile_shapes_trace.empty() && profile_min_shapes_.empty() && profile_max_shapes_.empty() &&
+      profile_opt_shapes_.empty()) {
+    if (num_auto_profiles < 1) {
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_num_auto_profiles must be a positive integer value. Set it to 3";
+      num_auto_profiles = 3;
+    }
+    if (!GenerateProfileShapesFromTrace(profile_shapes_trace, num_auto_profiles, profile_min_shapes_, profile_max_shapes_, profile_opt_shapes_)) {
+      profile_min_shapes_.clear();
+      profile_max_shapes_.clear();
+      profile_opt_shapes_.clear();
+      LOGS_DEFAULT(WARNING) << "[TensorRT EP] Failed to generate profiles from provider option 'trt_profile_shapes_trace'. Make sure the file exists and each line follows the format of 'input1:dim1xdimd2...,input2:dim1xdim2...,...' with the same inputs";
+    }
+  }
+
   if (status) {
     status = ValidateProfileShapes(profile_min_shapes_, profile_max_shapes_, profile_opt_shapes_);
     if (!status) {
@@ -1112,7 +1137,9 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_profile_min_shapes: " << profile_min_shapes
                         << ", trt_profile_max_shapes: " << profile_max_shapes
                         << ", trt_profile_opt_shapes: " << profile_opt_shapes
-                        << ", trt_cuda_graph_enable: " << cuda_graph_enable_;
+                        << ", trt_cuda_graph_enable: " << cuda_graph_enable_
+                        << ", trt_profile_shapes_trace: " << profile_shapes_trace
+                        << ", trt_num_auto_profiles: " << num_auto_profiles;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
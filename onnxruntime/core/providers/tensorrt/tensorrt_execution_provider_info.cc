@@ -45,6 +45,8 @@ constexpr const char* kProfilesMinShapes = "trt_profile_min_shapes";
 constexpr const char* kProfilesMaxShapes = "trt_profile_max_shapes";
 constexpr const char* kProfilesOptShapes = "trt_profile_opt_shapes";
 constexpr const char* kCudaGraphEnable = "trt_cuda_graph_enable";
+constexpr const char* kProfileShapesTrace = "trt_profile_shapes_trace";
+constexpr const char* kNumAutoProfiles = "trt_num_auto_profiles";
 }  // namespace provider_option_names
 }  // namespace tensorrt
 
@@ -95,6 +97,8 @@ TensorrtExecutionProviderInfo TensorrtExecutionProviderInfo::FromProviderOptions
           .AddAssignmentToReference(tensorrt::provider_option_names::kProfilesMaxShapes, info.profile_max_shapes)
           .AddAssignmentToReference(tensorrt::provider_option_names::kProfilesOptShapes, info.profile_opt_shapes)
           .AddAssignmentToReference(tensorrt::provider_option_names::kCudaGraphEnable, info.cuda_graph_enable)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kProfileShapesTrace, info.profile_shapes_trace)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kNumAutoProfiles, info.num_auto_profiles)
           .Parse(options));  // add new provider option here.
 
   return info;
@@ -135,6 +139,8 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const TensorrtE
       {tensorrt::provider_option_names::kProfilesMaxShapes, MakeStringWithClassicLocale(info.profile_max_shapes)},
       {tensorrt::provider_option_names::kProfilesOptShapes, MakeStringWithClassicLocale(info.profile_opt_shapes)},
       {tensorrt::provider_option_names::kCudaGraphEnable, MakeStringWithClassicLocale(info.cuda_graph_enable)},
+      {tensorrt::provider_option_names::kProfileShapesTrace, MakeStringWithClassicLocale(info.profile_shapes_trace)},
+      {tensorrt::provider_option_names::kNumAutoProfiles, MakeStringWithClassicLocale(info.num_auto_profiles)},
   };
   return options;
 }
@@ -149,6 +155,7 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensor
   const std::string kProfilesMinShapes_ = empty_if_null(info.trt_profile_min_shapes);
   const std::string kProfilesMaxShapes_ = empty_if_null(info.trt_profile_max_shapes);
   const std::string kProfilesOptShapes_ = empty_if_null(info.trt_profile_opt_shapes);
+  const std::string kProfileShapesTrace_ = empty_if_null(info.trt_profile_shapes_trace);
 
   const ProviderOptions options{
       {tensorrt::provider_option_names::kDeviceId, MakeStringWithClassicLocale(info.device_id)},
@@ -183,6 +190,8 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const OrtTensor
       {tensorrt::provider_option_names::kProfilesMaxShapes, kProfilesMaxShapes_},
       {tensorrt::provider_option_names::kProfilesOptShapes, kProfilesOptShapes_},
       {tensorrt::provider_option_names::kCudaGraphEnable, MakeStringWithClassicLocale(info.trt_cuda_graph_enable)},
+      {tensorrt::provider_option_names::kProfileShapesTrace, kProfileShapesTrace_},
+      {tensorrt::provider_option_names::kNumAutoProfiles, MakeStringWithClassicLocale(info.trt_num_auto_profiles)},
   };
   return options;
 }
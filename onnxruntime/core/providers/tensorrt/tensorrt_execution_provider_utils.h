@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <fstream>
 #include <unordered_map>
 #include <string>
@@ -694,4 +695,111 @@ bool ParseProfileShapes(std::string profile_shapes_string, std::unordered_map<st
 
   return true;
 }
+
+/*
+ * Generate explicit profile min/max/opt shapes from a trace of observed input shapes.
+ *
+ * The trace file has one observation per line, in the format of the profile shapes provider options, for example:
+ * input_id:32x1,attention_mask:32x1
+ * input_id:32x41,attention_mask:32x41
+ * Every observation must contain the same inputs with the same ranks.
+ *
+ * The observations are sorted by the total number of elements of their inputs and split into at most num_profiles
+ * contiguous groups of about the same size. Each group becomes a profile: its min/max shapes are the per-dimension
+ * min/max of the observations in the group and its opt shapes are the ones of the median observation, so that the
+ * shapes seen most often get a profile tuned for them instead of one covering the whole range.
+ *
+ * Return true if the trace can be successfully parsed or false if the file is missing or has wrong format.
+ */
+bool GenerateProfileShapesFromTrace(const std::string& trace_file, int num_profiles,
+                                    std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_min_shapes,
+                                    std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_max_shapes,
+                                    std::unordered_map<std::string, std::vector<std::vector<int64_t>>>& profile_opt_shapes) {
+  std::ifstream infile(trace_file, std::ios::in);
+  if (!infile || num_profiles < 1) {
+    return false;
+  }
+
+  using Observation = std::unordered_map<std::string, std::vector<int64_t>>;
+  std::vector<Observation> observations;
+  std::string line;
+  while (std::getline(infile, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::stringstream line_stream(line);
+    std::string input_name_with_shape;
+    Observation observation;
+    while (std::getline(line_stream, input_name_with_shape, ',')) {
+      std::pair<std::string, std::vector<int64_t>> pair;
+      if (!MakeInputNameShapePair(input_name_with_shape, pair)) {
+        return false;
+      }
+      if (!pair.first.empty()) {
+        observation[pair.first] = pair.second;
+      }
+    }
+
+    // all the observations must describe the same inputs
+    if (!observations.empty()) {
+      const auto& first = observations.front();
+      if (observation.size() != first.size()) {
+        return false;
+      }
+      for (const auto& input : observation) {
+        auto it = first.find(input.first);
+        if (it == first.end() || it->second.size() != input.second.size()) {
+          return false;
+        }
+      }
+    }
+    observations.push_back(std::move(observation));
+  }
+
+  if (observations.empty()) {
+    return false;
+  }
+
+  auto volume = [](const Observation& observation) {
+    int64_t total = 0;
+    for (const auto& input : observation) {
+      int64_t elements = 1;
+      for (auto dim : input.second) {
+        elements *= dim;
+      }
+      total += elements;
+    }
+    return total;
+  };
+  std::stable_sort(observations.begin(), observations.end(),
+                   [&volume](const Observation& a, const Observation& b) { return volume(a) < volume(b); });
+
+  const size_t num_groups = std::min(static_cast<size_t>(num_profiles), observations.size());
+  profile_min_shapes.clear();
+  profile_max_shapes.clear();
+  profile_opt_shapes.clear();
+  for (size_t group = 0; group < num_groups; group++) {
+    const size_t begin = group * observations.size() / num_groups;
+    const size_t end = (group + 1) * observations.size() / num_groups;
+    for (const auto& input : observations[begin]) {
+      const auto& input_name = input.first;
+      std::vector<int64_t> min_shape = input.second;
+      std::vector<int64_t> max_shape = input.second;
+      for (size_t i = begin + 1; i < end; i++) {
+        const auto& shape = observations[i].at(input_name);
+        for (size_t j = 0; j < shape.size(); j++) {
+          min_shape[j] = std::min(min_shape[j], shape[j]);
+          max_shape[j] = std::max(max_shape[j], shape[j]);
+        }
+      }
+      profile_min_shapes[input_name].push_back(min_shape);
+      profile_max_shapes[input_name].push_back(max_shape);
+      profile_opt_shapes[input_name].push_back(observations[begin + (end - begin) / 2].at(input_name));
+    }
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Generated " << num_groups << " profile(s) from " << observations.size()
+                        << " observed shape(s) in " << trace_file;
+  return true;
+}
 }  // namespace onnxruntime
@@ -95,6 +95,8 @@ struct Tensorrt_Provider : Provider {
     info.profile_max_shapes = options.trt_profile_max_shapes == nullptr ? "" : options.trt_profile_max_shapes;
     info.profile_opt_shapes = options.trt_profile_opt_shapes == nullptr ? "" : options.trt_profile_opt_shapes;
     info.cuda_graph_enable = options.trt_cuda_graph_enable != 0;
+    info.profile_shapes_trace = options.trt_profile_shapes_trace == nullptr ? "" : options.trt_profile_shapes_trace;
+    info.num_auto_profiles = options.trt_num_auto_profiles;
 
     common::Status status = CreateTensorRTCustomOpDomainList(info);
     if (!status.IsOK()) {
@@ -245,6 +247,22 @@ struct Tensorrt_Provider : Provider {
     }
 
     trt_options.trt_cuda_graph_enable = internal_options.cuda_graph_enable;
+
+    str_size = internal_options.profile_shapes_trace.size();
+    if (str_size == 0) {
+      trt_options.trt_profile_shapes_trace = nullptr;
+    } else {
+      dest = new char[str_size + 1];
+#ifdef _MSC_VER
+      strncpy_s(dest, str_size + 1, internal_options.profile_shapes_trace.c_str(), str_size);
+#else
+      strncpy(dest, internal_options.profile_shapes_trace.c_str(), str_size);
+#endif
+      dest[str_size] = '\0';
+      trt_options.trt_profile_shapes_trace = (const char*)dest;
+    }
+
+    trt_options.trt_num_auto_profiles = internal_options.num_auto_profiles;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
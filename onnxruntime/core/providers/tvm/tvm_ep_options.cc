@@ -26,6 +26,7 @@ constexpr const char* kSetOutputZeroCopy = "set_output_zero_copy";
 constexpr const char* kToNHWC = "to_nhwc";
 constexpr const char* kTuningFilePath = "tuning_file_path";
 constexpr const char* kTuningType = "tuning_type";
+constexpr const char* kModuleCacheSize = "module_cache_size";
 constexpr const char* kInputNames = "input_names";
 constexpr const char* kInputShapes = "input_shapes";
 
@@ -42,6 +43,7 @@ static const std::unordered_set<std::string> valid_keys{
     std::string{kToNHWC},
     std::string{kTuningFilePath},
     std::string{kTuningType},
+    std::string{kModuleCacheSize},
     std::string{kInputNames},
     std::string{kInputShapes}};
 
@@ -128,6 +130,7 @@ TvmEPOptions TvmEPOptionsHelper::FromProviderOptions(const ProviderOptions& pr_o
           .AddAssignmentToReference(tvm::provider_option_names::kToNHWC, options.to_nhwc)
           .AddAssignmentToReference(tvm::provider_option_names::kTuningFilePath, options.tuning_file_path)
           .AddAssignmentToReference(tvm::provider_option_names::kTuningType, options.tuning_type)
+          .AddAssignmentToReference(tvm::provider_option_names::kModuleCacheSize, options.module_cache_size)
           .AddAssignmentToReference(tvm::provider_option_names::kInputNames, options.input_names_str)
           .AddAssignmentToReference(tvm::provider_option_names::kInputShapes, options.input_shapes_str)
           .Parse(pr_options));
@@ -263,6 +266,7 @@ std::ostream& operator<<(std::ostream& out, const TvmEPOptions& options) {
       << "set_output_zero_copy: " << options.set_output_zero_copy << "\n"
       << "tuning file path: " << options.tuning_file_path << "\n"
       << "tuning type: " << options.tuning_type << "\n"
+      << "module cache size: " << options.module_cache_size << "\n"
       << "convert layout to NHWC: " << options.to_nhwc << "\n"
       << "input tensor names: " << options.input_names_str << "\n"
       << "input tensor shapes: " << options.input_shapes_str;
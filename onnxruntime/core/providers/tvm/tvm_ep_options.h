@@ -43,6 +43,8 @@ struct TvmEPOptions {
   bool set_output_zero_copy = true;
   std::string tuning_file_path{""};
   std::string tuning_type{tvm::default_tuning_type};
+  // number of compiled modules kept in the process wide cache for reuse by later sessions, 0 disables the cache
+  unsigned int module_cache_size{0};
   std::string input_names_str{""};
   std::string input_shapes_str{""};
   TVMInputShapes input_shapes{};
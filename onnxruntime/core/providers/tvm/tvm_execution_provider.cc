@@ -3,6 +3,7 @@
 
 #include <fstream>
 #include <map>
+#include <sstream>
 #include <utility>
 
 #include "core/common/common.h"
@@ -19,6 +20,9 @@
 #include "tvm_allocator.h"
 #include "tvm_utils.h"
 #include "tvm_api.h"
+#include "tvm_module_cache.h"
+
+#include "hash_alg/hasher.h"  // NOLINT(build/include_subdir)
 
 using namespace ONNX_NAMESPACE;
 
@@ -126,16 +130,21 @@ common::Status TvmExecutionProvider::Compile(const std::vector<FusedNodeAndGraph
 
     std::string onnx_model_str;
     model_proto.SerializeToString(&onnx_model_str);
+    std::string subgraph_hash;
+    if (options_.module_cache_size > 0) {
+      subgraph_hash = Hasher("sha256").hash(onnx_model_str.data(), onnx_model_str.size());
+    }
     compilers_[func_name] = std::make_shared<TVMCompiler>(std::move(onnx_model_str),
                                                           ToUTF8String(fused_node.ModelPath().ToPathString()),
                                                           int(opset->version()));
     InputsInfoMap all_input_shapes;
-    auto mod = compileModel(func_name, graph_body_viewer, all_input_shapes);
+    std::shared_ptr<OrtMutex> run_mutex;
+    auto mod = compileModel(func_name, subgraph_hash, graph_body_viewer, all_input_shapes, run_mutex);
 
     std::vector<DLTensor> output_tensors;
     prepareOutputTensors(mod, output_tensors, graph_body_viewer.GetOutputs().size());
 
-    runners_[func_name] = std::make_shared<Runner>(options_, mod, all_input_shapes, output_tensors);
+    runners_[func_name] = std::make_shared<Runner>(options_, mod, all_input_shapes, output_tensors, run_mutex);
 
     if (dump_subgraphs_) {
       std::fstream dump("/tmp/" + func_name + ".onnx",
@@ -168,9 +177,12 @@ void TvmExecutionProvider::printOptions() {
 }
 
 std::shared_ptr<TvmModule> TvmExecutionProvider::compileModel(const std::string& func_name,
+                                                              const std::string& subgraph_hash,
                                                               const GraphViewer& graph_viewer,
-                                                              InputsInfoMap& all_input_shapes) {
+                                                              InputsInfoMap& all_input_shapes,
+                                                              std::shared_ptr<OrtMutex>& run_mutex) {
   all_input_shapes.clear();
+  run_mutex = nullptr;
 
   TVMTensorShapes input_shapes;
   if (options_.freeze_weights) {
@@ -179,9 +191,38 @@ std::shared_ptr<TvmModule> TvmExecutionProvider::compileModel(const std::string&
     setInputShapesForUnfreezedNN(graph_viewer, input_shapes, all_input_shapes);
   }
 
-  std::shared_ptr<TvmModule> mod = compilers_[func_name]->operator()(options_, input_shapes);
+  auto compile = [this, &func_name, &input_shapes]() {
+    return compilers_[func_name]->operator()(options_, input_shapes);
+  };
+
+  if (options_.module_cache_size == 0) {
+    return compile();
+  }
+
+  const std::string key = getModuleCacheKey(subgraph_hash,
+                                             ToUTF8String(graph_viewer.ModelPath().ToPathString()),
+                                             input_shapes);
+  auto cached = TVMModuleCache::Instance().GetOrCompile(key, options_.module_cache_size, compile);
+  run_mutex = cached.run_mutex;
+
+  return cached.mod;
+}
 
-  return mod;
+std::string TvmExecutionProvider::getModuleCacheKey(const std::string& subgraph_hash,
+                                                    const std::string& model_path,
+                                                    const TVMTensorShapes& input_shapes) const {
+  // everything the compilation depends on besides the subgraph itself
+  std::ostringstream key;
+  key << subgraph_hash << "|" << model_path << "|" << options_.executor << "|" << options_.target << "|"
+      << options_.target_host << "|" << options_.opt_level << "|" << options_.freeze_weights << "|"
+      << options_.to_nhwc << "|" << options_.tuning_file_path << "|" << options_.tuning_type;
+  for (const auto& shape : input_shapes) {
+    key << "|";
+    for (const auto dim : shape) {
+      key << dim << ",";
+    }
+  }
+  return key.str();
 }
 
 void TvmExecutionProvider::setInputShapesForFreezedNN(const GraphViewer& graph_viewer,
@@ -43,8 +43,13 @@ class TvmExecutionProvider : public IExecutionProvider {
  private:
   void printOptions();
   std::shared_ptr<TvmModule> compileModel(const std::string& func_name,
+                                          const std::string& subgraph_hash,
                                           const GraphViewer& graph_viewer,
-                                          InputsInfoMap& inputs_info);  // NOLINT
+                                          InputsInfoMap& inputs_info,           // NOLINT
+                                          std::shared_ptr<OrtMutex>& run_mutex);  // NOLINT
+  std::string getModuleCacheKey(const std::string& subgraph_hash,
+                                const std::string& model_path,
+                                const TVMTensorShapes& input_shapes) const;
   void setInputShapesForFreezedNN(const GraphViewer& graph_viewer,
                                   TVMTensorShapes& input_shapes,     // NOLINT
                                   InputsInfoMap& all_input_shapes);  // NOLINT
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "tvm_module_cache.h"
+
+namespace onnxruntime {
+namespace tvm {
+
+TVMModuleCache& TVMModuleCache::Instance() {
+  static TVMModuleCache cache;
+  return cache;
+}
+
+auto TVMModuleCache::GetOrCompile(const std::string& key,
+                                  size_t capacity,
+                                  const std::function<ModulePtr()>& compile_func) -> CachedModule {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+  }
+
+  CachedModule compiled{compile_func(), std::make_shared<OrtMutex>()};
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  // another session may have compiled the same module in the meantime
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+  }
+
+  entries_.emplace_front(key, compiled);
+  index_[key] = entries_.begin();
+  while (entries_.size() > capacity) {
+    // sessions using an evicted module keep it alive until they are released
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+
+  return compiled;
+}
+
+}  // namespace tvm
+}  // namespace onnxruntime
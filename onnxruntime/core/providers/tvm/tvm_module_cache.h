@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#ifndef TVM_MODULE_CACHE_H
+#define TVM_MODULE_CACHE_H
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "core/platform/ort_mutex.h"
+
+#include "tvm_common.h"
+
+namespace onnxruntime {
+namespace tvm {
+
+// Process wide cache of compiled TVM modules, so that sessions created for the same subgraph, target and input
+// shapes reuse the module instead of compiling it again. Keeps the least recently used modules up to the capacity.
+class TVMModuleCache {
+ public:
+  using ModulePtr = std::shared_ptr<TvmModule>;
+
+  struct CachedModule {
+    ModulePtr mod;
+    // the module keeps the inputs and outputs of a run, so runs of the sessions sharing it are serialized
+    std::shared_ptr<OrtMutex> run_mutex;
+  };
+
+  static TVMModuleCache& Instance();
+
+  // Returns the module cached for the key, or compiles it with compile_func and caches it.
+  // Compilation happens outside of the lock, so different modules can be compiled concurrently.
+  CachedModule GetOrCompile(const std::string& key,
+                            size_t capacity,
+                            const std::function<ModulePtr()>& compile_func);
+
+ private:
+  TVMModuleCache() = default;
+
+  using Entries = std::list<std::pair<std::string, CachedModule>>;
+
+  OrtMutex mutex_;
+  // most recently used first
+  Entries entries_;
+  std::unordered_map<std::string, Entries::iterator> index_;
+};
+
+}  // namespace tvm
+}  // namespace onnxruntime
+
+#endif  // TVM_MODULE_CACHE_H
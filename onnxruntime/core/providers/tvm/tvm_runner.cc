@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <utility>
+
 #include "core/graph/model.h"
 #include "core/framework/tensorprotoutils.h"
 
@@ -13,12 +15,17 @@ namespace tvm {
 TVMRunner::TVMRunner(const TvmEPOptions& options,
                      const std::shared_ptr<TvmModule>& mod,
                      const InputsInfoMap& inputs_info,
-                     const std::vector<DLTensor>& output_tensors) {
+                     const std::vector<DLTensor>& output_tensors,
+                     std::shared_ptr<OrtMutex> run_mutex) : run_mutex_(std::move(run_mutex)) {
   runner_ = getTVMRunnerImpl(mod, options, inputs_info, output_tensors);
 }
 
 common::Status TVMRunner::operator()(FunctionState state, const OrtApi* /*api*/, OrtKernelContext* context) {
   Ort::KernelContext ctx(context);
+  if (run_mutex_) {
+    std::lock_guard<OrtMutex> lock(*run_mutex_);
+    return runner_->run(ctx);
+  }
   return runner_->run(ctx);
 }
 
@@ -7,6 +7,8 @@
 #include <vector>
 #include <memory>
 
+#include "core/platform/ort_mutex.h"
+
 #include "tvm_runner_impl.h"
 
 namespace onnxruntime {
@@ -20,12 +22,15 @@ class TVMRunner {
   TVMRunner(const TvmEPOptions& options,
             const std::shared_ptr<TvmModule>& mod,
             const InputsInfoMap& inputs_info,
-            const std::vector<DLTensor>& output_tensor);
+            const std::vector<DLTensor>& output_tensor,
+            std::shared_ptr<OrtMutex> run_mutex = nullptr);
 
   common::Status operator()(FunctionState state, const OrtApi* api, OrtKernelContext* context);
 
  private:
   std::shared_ptr<RunnerImpl> runner_;
+  // set if the module is shared with other sessions through the module cache
+  std::shared_ptr<OrtMutex> run_mutex_;
 };
 
 }  // namespace tvm
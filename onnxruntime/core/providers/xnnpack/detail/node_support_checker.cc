@@ -20,6 +20,7 @@
 #include "core/providers/xnnpack/nn/max_pool.h"
 #include "core/providers/xnnpack/math/gemm.h"
 #include "core/providers/xnnpack/math/matmul.h"
+#include "core/providers/xnnpack/math/elementwise_binary.h"
 #include "core/providers/xnnpack/nn/average_pool.h"
 #include "core/providers/xnnpack/nn/resize.h"
 #include "core/providers/xnnpack/nn/softmax.h"
@@ -100,6 +101,10 @@ bool NodeSupportChecker::IsNodeSupported(const NodeUnit& nodeunit) {
       {"Resize", Resize::IsOnnxNodeSupported},
       {"Gemm", Gemm::IsOnnxNodeSupported},
       {"MatMul", MatMul::IsOnnxNodeSupported},
+      {"Add", ElementwiseBinary::IsOnnxNodeSupported},
+      {"Sub", ElementwiseBinary::IsOnnxNodeSupported},
+      {"Mul", ElementwiseBinary::IsOnnxNodeSupported},
+      {"Div", ElementwiseBinary::IsOnnxNodeSupported},
   };
 
   bool supported = false;
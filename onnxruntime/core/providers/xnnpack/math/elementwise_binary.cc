@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/math/elementwise_binary.h"
+
+#include <algorithm>
+#include <array>
+
+#include "core/framework/op_kernel.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+
+namespace {
+// numpy style broadcasting of the shapes of the inputs
+Status ComputeBroadcastOutputShape(const TensorShape& a_shape, const TensorShape& b_shape, TensorShape& y_shape) {
+  const size_t rank = std::max(a_shape.NumDimensions(), b_shape.NumDimensions());
+  TensorShapeVector y_dims(rank, 1);
+  for (size_t i = 0; i < rank; ++i) {
+    const int64_t a_dim = i < a_shape.NumDimensions() ? a_shape[a_shape.NumDimensions() - 1 - i] : 1;
+    const int64_t b_dim = i < b_shape.NumDimensions() ? b_shape[b_shape.NumDimensions() - 1 - i] : 1;
+    ORT_RETURN_IF_NOT(a_dim == b_dim || a_dim == 1 || b_dim == 1,
+                      "Can't broadcast shape ", a_shape, " with shape ", b_shape);
+    y_dims[rank - 1 - i] = a_dim == 1 ? b_dim : a_dim;
+  }
+  y_shape = TensorShape(y_dims);
+  return Status::OK();
+}
+
+std::array<size_t, XNN_MAX_TENSOR_DIMS> ToXnnShape(const TensorShape& shape) {
+  std::array<size_t, XNN_MAX_TENSOR_DIMS> dims{};
+  for (size_t i = 0; i < shape.NumDimensions(); ++i) {
+    dims[i] = static_cast<size_t>(shape[i]);
+  }
+  return dims;
+}
+}  // namespace
+
+bool ElementwiseBinary::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& /*graph*/) {
+  bool supported = false;
+  // use do {} while(false) so it's easier to set a breakpoint on the return
+  do {
+    // quantized Add/Mul are left to the CPU EP for now
+    if (node_unit.UnitType() == NodeUnit::Type::QDQGroup) {
+      break;
+    }
+
+    const auto& inputs = node_unit.Inputs();
+    if (inputs.size() != 2) {
+      break;
+    }
+
+    // we only support float currently, and the rank must be known and within the XNNPACK limit
+    bool inputs_supported = true;
+    for (const auto& input : inputs) {
+      const auto* type = input.node_arg.TypeAsProto();
+      const auto* shape = input.node_arg.Shape();
+      if (type == nullptr || type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+          shape == nullptr || shape->dim_size() > XNN_MAX_TENSOR_DIMS) {
+        inputs_supported = false;
+      }
+    }
+    if (!inputs_supported) {
+      break;
+    }
+
+    supported = true;
+  } while (false);
+
+  return supported;
+}
+
+ElementwiseBinary::ElementwiseBinary(const OpKernelInfo& info) : XnnpackKernel(info) {
+  const std::string& op_type = info.node().OpType();
+  const float output_min = -INFINITY;
+  const float output_max = INFINITY;
+  xnn_status status = xnn_status_invalid_state;
+  struct xnn_operator* p = nullptr;
+  if (op_type == "Add") {
+    op_kind_ = OpKind::kAdd;
+    status = xnn_create_add_nd_f32(output_min, output_max, 0, &p);
+  } else if (op_type == "Sub") {
+    op_kind_ = OpKind::kSub;
+    status = xnn_create_subtract_nd_f32(output_min, output_max, 0, &p);
+  } else if (op_type == "Mul") {
+    op_kind_ = OpKind::kMul;
+    status = xnn_create_multiply_nd_f32(output_min, output_max, 0, &p);
+  } else if (op_type == "Div") {
+    op_kind_ = OpKind::kDiv;
+    status = xnn_create_divide_nd_f32(output_min, output_max, 0, &p);
+  } else {
+    ORT_THROW("Unexpected op type ", op_type, " for the XNNPACK elementwise binary kernel");
+  }
+  ORT_ENFORCE(status == xnn_status_success, "xnn_create of ", op_type, " failed. Status:", status);
+  op0_.reset(p);
+}
+
+Status ElementwiseBinary::Compute(OpKernelContext* ctx) const {
+  const auto* A = ctx->Input<Tensor>(0);
+  const auto* B = ctx->Input<Tensor>(1);
+  const auto& a_shape = A->Shape();
+  const auto& b_shape = B->Shape();
+
+  TensorShape y_shape;
+  ORT_RETURN_IF_ERROR(ComputeBroadcastOutputShape(a_shape, b_shape, y_shape));
+  auto* Y = ctx->Output(0, y_shape);
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (y_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  pthreadpool_t t_pool = GetThreadPool();
+  const auto a_dims = ToXnnShape(a_shape);
+  const auto b_dims = ToXnnShape(b_shape);
+  xnn_status status = xnn_status_invalid_state;
+  switch (op_kind_) {
+    case OpKind::kAdd:
+      status = xnn_setup_add_nd_f32(op0_.get(), a_shape.NumDimensions(), a_dims.data(),
+                                    b_shape.NumDimensions(), b_dims.data(),
+                                    A->Data<float>(), B->Data<float>(), Y->MutableData<float>(), t_pool);
+      break;
+    case OpKind::kSub:
+      status = xnn_setup_subtract_nd_f32(op0_.get(), a_shape.NumDimensions(), a_dims.data(),
+                                         b_shape.NumDimensions(), b_dims.data(),
+                                         A->Data<float>(), B->Data<float>(), Y->MutableData<float>(), t_pool);
+      break;
+    case OpKind::kMul:
+      status = xnn_setup_multiply_nd_f32(op0_.get(), a_shape.NumDimensions(), a_dims.data(),
+                                         b_shape.NumDimensions(), b_dims.data(),
+                                         A->Data<float>(), B->Data<float>(), Y->MutableData<float>(), t_pool);
+      break;
+    case OpKind::kDiv:
+      status = xnn_setup_divide_nd_f32(op0_.get(), a_shape.NumDimensions(), a_dims.data(),
+                                       b_shape.NumDimensions(), b_dims.data(),
+                                       A->Data<float>(), B->Data<float>(), Y->MutableData<float>(), t_pool);
+      break;
+  }
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup of ", Node().OpType(), " returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+  return Status::OK();
+}
+
+#define REGISTER_ELEMENTWISE_BINARY_KERNEL(op_type)                                                              \
+  ONNX_OPERATOR_VERSIONED_KERNEL_EX(op_type, kOnnxDomain, 7, 12, kXnnpackExecutionProvider,                       \
+                                    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()), \
+                                    ElementwiseBinary);                                                           \
+  ONNX_OPERATOR_VERSIONED_KERNEL_EX(op_type, kOnnxDomain, 13, 13, kXnnpackExecutionProvider,                      \
+                                    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()), \
+                                    ElementwiseBinary);                                                           \
+  ONNX_OPERATOR_KERNEL_EX(op_type, kOnnxDomain, 14, kXnnpackExecutionProvider,                                    \
+                          KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),           \
+                          ElementwiseBinary);
+
+REGISTER_ELEMENTWISE_BINARY_KERNEL(Add)
+REGISTER_ELEMENTWISE_BINARY_KERNEL(Sub)
+REGISTER_ELEMENTWISE_BINARY_KERNEL(Mul)
+REGISTER_ELEMENTWISE_BINARY_KERNEL(Div)
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
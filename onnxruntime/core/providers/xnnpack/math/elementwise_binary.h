@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/xnnpack/xnnpack_kernel.h"
+#include "core/providers/xnnpack/detail/utils.h"
+
+namespace onnxruntime {
+class GraphViewer;
+namespace xnnpack {
+
+// Add, Sub, Mul and Div with multidirectional broadcasting.
+class ElementwiseBinary final : public XnnpackKernel {
+ public:
+  ElementwiseBinary(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+
+ private:
+  enum class OpKind : uint8_t {
+    kAdd,
+    kSub,
+    kMul,
+    kDiv,
+  };
+
+  OpKind op_kind_{OpKind::kAdd};
+  XnnpackOperator op0_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -65,6 +65,23 @@ class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 1, 12, MatMul);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, MatMul);
 
+#define ELEMENTWISE_BINARY_KERNEL_CLASS_NAMES(Op)                                                       \
+  class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 7, 12, Op);  \
+  class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, 13, Op); \
+  class ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 14, Op);
+
+ELEMENTWISE_BINARY_KERNEL_CLASS_NAMES(Add)
+ELEMENTWISE_BINARY_KERNEL_CLASS_NAMES(Sub)
+ELEMENTWISE_BINARY_KERNEL_CLASS_NAMES(Mul)
+ELEMENTWISE_BINARY_KERNEL_CLASS_NAMES(Div)
+
+#define ELEMENTWISE_BINARY_KERNEL_CREATE_INFOS(Op)                                                            \
+  BuildKernelCreateInfo<                                                                                      \
+      ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 7, 12, Op)>,           \
+  BuildKernelCreateInfo<                                                                                      \
+      ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, 13, Op)>,          \
+  BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 14, Op)>
+
 std::unique_ptr<KernelRegistry> RegisterKernels() {
   auto kernel_registry = std::make_unique<onnxruntime::KernelRegistry>();
 
@@ -99,6 +116,10 @@ std::unique_ptr<KernelRegistry> RegisterKernels() {
           ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 1, 12, MatMul)>,
       BuildKernelCreateInfo<
           ONNX_OPERATOR_KERNEL_CLASS_NAME(kXnnpackExecutionProvider, kOnnxDomain, 13, MatMul)>,
+      ELEMENTWISE_BINARY_KERNEL_CREATE_INFOS(Add),
+      ELEMENTWISE_BINARY_KERNEL_CREATE_INFOS(Sub),
+      ELEMENTWISE_BINARY_KERNEL_CREATE_INFOS(Mul),
+      ELEMENTWISE_BINARY_KERNEL_CREATE_INFOS(Div),
 
       //  quantization op
       KERNEL_CREATE_INFO_TYPED(10, uint8_t, QLinearConv),
@@ -5,6 +5,7 @@
 #include "core/common/logging/logging.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/tensor.h"
 #include "core/framework/utils.h"
 
 namespace onnxruntime {
@@ -87,7 +88,34 @@ common::Status IOBinding::BindOutput(const std::string& name, OrtDevice device)
   return BindOutputImpl(name, {}, device);
 }
 
-common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device) {
+common::Status IOBinding::BindOutput(const std::string& name, OutputAllocator allocator, OrtDevice device) {
+  if (!allocator) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "An allocator callback is required to bind output ", name);
+  }
+
+  // validate the value provided by the callback as the kernel will write to it directly
+  auto checked_allocator = [name, allocator = std::move(allocator)](const TensorShape& shape,
+                                                                    const OrtDevice& location,
+                                                                    OrtValue& ort_value, bool& allocated) -> Status {
+    ORT_RETURN_IF_ERROR(allocator(shape, location, ort_value, allocated));
+    if (allocated) {
+      ORT_RETURN_IF_NOT(ort_value.IsTensor(), "The allocator bound to output ", name, " did not provide a tensor");
+      const auto& tensor = ort_value.Get<Tensor>();
+      ORT_RETURN_IF_NOT(tensor.Shape() == shape, "The allocator bound to output ", name,
+                        " provided a tensor with shape ", tensor.Shape(), ". Expected ", shape);
+      ORT_RETURN_IF_NOT(tensor.Location().device == location, "The allocator bound to output ", name,
+                        " provided a tensor on ", tensor.Location().device.ToString(), ". Expected ",
+                        location.ToString());
+    }
+
+    return Status::OK();
+  };
+
+  return BindOutputImpl(name, {}, device, std::move(checked_allocator));
+}
+
+common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device,
+                                         OutputAllocator allocator) {
   auto it = mapped_output_names_.emplace(name, output_names_.size());
   size_t index = it.first->second;
   if (it.second) {
@@ -98,6 +126,12 @@ common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue
     outputs_[index] = ml_value;
     outputs_device_info_[index] = device;
   }
+
+  if (allocator) {
+    output_allocators_.insert_or_assign(index, std::move(allocator));
+  } else {
+    output_allocators_.erase(index);
+  }
   ORT_ENFORCE(mapped_output_names_.size() == output_names_.size(), "Size mismatch", mapped_output_names_.size(), "!=", output_names_.size());
 
   return Status::OK();
@@ -108,6 +142,7 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  output_allocators_.clear();
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
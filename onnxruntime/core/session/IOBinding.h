@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "core/framework/execution_provider.h"
+#include "core/framework/iexecutor.h"
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
 #include "core/framework/ort_value.h"
@@ -38,6 +39,13 @@ class SessionState;
  */
 class IOBinding {
  public:
+  /**
+   * Allocates a bound output once its shape is known. Called with the final shape and the device the output is
+   * produced on. To provide the buffer, initialize the OrtValue with a Tensor of that shape on that device and set
+   * `allocated` to true. Leave `allocated` false to have ORT allocate the output.
+   */
+  using OutputAllocator = IExecutor::CustomAllocator;
+
   /**
    * Call repeatedly to bind as many inputs as required.
    * If called again for the same name will replace an existing value.
@@ -71,6 +79,16 @@ class IOBinding {
    */
   common::Status BindOutput(const std::string& name, OrtDevice device = {});
 
+  /**
+   * Bind an output name to an allocator callback.
+   * The callback is invoked when the kernel producing the output requests it from OpKernelContext::Output, so the
+   * kernel writes directly into the buffer the callback provides. This allows zero-copy binding of outputs whose
+   * shape depends on the input data.
+   *
+   * @param device Device to allocate the output on if the callback does not allocate it. Default is CPU.
+   */
+  common::Status BindOutput(const std::string& name, OutputAllocator allocator, OrtDevice device = {});
+
   /**
    * This simply collects the outputs obtained after calling Run() inside the @param outputs.
    */
@@ -106,13 +124,18 @@ class IOBinding {
   std::unordered_map<std::string, size_t> mapped_output_names_;
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
+  // allocator callbacks by output index
+  std::unordered_map<size_t, OutputAllocator> output_allocators_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
   const std::vector<OrtDevice>& GetOutputsDeviceInfo() const;
 
+  const std::unordered_map<size_t, OutputAllocator>& GetOutputAllocators() const { return output_allocators_; }
+
   // The implementation for the BindOutput() overloads
-  common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
+  common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device,
+                                OutputAllocator allocator = {});
 };
 }  // namespace onnxruntime
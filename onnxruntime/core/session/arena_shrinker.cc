@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/arena_shrinker.h"
+
+#include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// number of intervals covering `duration_ms`, rounded up.
+uint64_t ToIntervals(uint64_t duration_ms, std::chrono::milliseconds interval) {
+  const auto interval_ms = static_cast<uint64_t>(interval.count());
+  return (duration_ms + interval_ms - 1) / interval_ms;
+}
+
+}  // namespace
+
+ArenaShrinker::ArenaShrinker(const Config& config, std::vector<AllocatorPtr> arenas,
+                             OrtThreadPoolParams thread_pool_params)
+    : config_(config), arenas_(std::move(arenas)) {
+  ORT_ENFORCE(config_.interval.count() > 0, "ArenaShrinker requires a positive interval. Got ",
+              config_.interval.count());
+
+  // one worker in addition to the thread counted for the caller, see AsyncRunQueue.
+  thread_pool_params.thread_pool_size = 2;
+  // the loop sleeps between evaluations, so spinning would only burn cycles.
+  thread_pool_params.allow_spinning = false;
+  thread_pool_params.auto_set_affinity = false;
+  thread_pool_params.affinity_str.clear();
+  thread_pool_params.dynamic_block_base_ = 0;
+
+  thread_pool_ = concurrency::CreateThreadPool(&Env::Default(), thread_pool_params,
+                                               concurrency::ThreadPoolType::INTER_OP);
+  ORT_ENFORCE(thread_pool_ != nullptr, "Failed to create the thread pool for arena shrinking.");
+
+  concurrency::ThreadPool::Schedule(thread_pool_.get(), [this]() { ShrinkLoop(); });
+}
+
+ArenaShrinker::~ArenaShrinker() {
+  {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    stop_ = true;
+    cv_.notify_all();
+    cv_.wait(lock, [this]() { return loop_done_; });
+  }
+
+  thread_pool_.reset();
+}
+
+Status ArenaShrinker::ParseConfig(const std::string& interval_ms, const std::string& idle_timeout_ms,
+                                  const std::string& high_water_mark_window_ms, const std::string& soft_limit_bytes,
+                                  Config& config, bool& enabled) {
+  enabled = false;
+  if (interval_ms.empty()) {
+    return Status::OK();
+  }
+
+  int64_t parsed_interval_ms = 0;
+  ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(interval_ms, parsed_interval_ms));
+  ORT_RETURN_IF_NOT(parsed_interval_ms >= 0, "Arena shrink interval must not be negative. Got ", parsed_interval_ms);
+  if (parsed_interval_ms == 0) {
+    return Status::OK();
+  }
+
+  Config parsed;
+  parsed.interval = std::chrono::milliseconds(parsed_interval_ms);
+
+  if (!idle_timeout_ms.empty()) {
+    uint64_t value = 0;
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(idle_timeout_ms, value));
+    parsed.policy.idle_intervals = ToIntervals(value, parsed.interval);
+  }
+
+  if (!high_water_mark_window_ms.empty()) {
+    uint64_t value = 0;
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(high_water_mark_window_ms, value));
+    parsed.policy.high_water_mark_intervals = static_cast<size_t>(ToIntervals(value, parsed.interval));
+  }
+
+  if (!soft_limit_bytes.empty()) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(soft_limit_bytes, parsed.policy.soft_limit_bytes));
+  }
+
+  config = parsed;
+  enabled = true;
+  return Status::OK();
+}
+
+void ArenaShrinker::ShrinkArenas() {
+  for (const auto& arena : arenas_) {
+    auto status = static_cast<BFCArena*>(arena.get())->ShrinkWithPolicy(config_.policy);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << "Failed to shrink the " << arena->Info().name << " arena: " << status.ErrorMessage();
+    }
+  }
+}
+
+void ArenaShrinker::ShrinkLoop() {
+  std::unique_lock<OrtMutex> lock(mutex_);
+  while (!stop_) {
+    const auto deadline = std::chrono::steady_clock::now() + config_.interval;
+    while (!stop_ && std::chrono::steady_clock::now() < deadline) {
+      cv_.wait_for(lock, deadline - std::chrono::steady_clock::now());
+    }
+
+    if (stop_) {
+      break;
+    }
+
+    lock.unlock();
+    ORT_TRY {
+      ShrinkArenas();
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        LOGS_DEFAULT(WARNING) << "Failed to shrink arenas: " << ex.what();
+      });
+    }
+    lock.lock();
+  }
+
+  loop_done_ = true;
+  cv_.notify_all();
+}
+
+}  // namespace onnxruntime
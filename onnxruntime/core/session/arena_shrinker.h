@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/framework/bfc_arena.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
+
+namespace onnxruntime {
+
+/**
+ * Periodically releases unused memory of a set of arenas according to a BFCArena::ShrinkPolicy.
+ *
+ * The policy is evaluated for every arena once per `interval` on a thread owned by the shrinker, so the memory is
+ * released off the Run path and without the caller having to configure "memory.enable_memory_arena_shrinkage" on
+ * every Run. Time based settings of the policy are expressed in intervals.
+ */
+class ArenaShrinker {
+ public:
+  struct Config {
+    // time between two evaluations of the policy. must be > 0.
+    std::chrono::milliseconds interval{0};
+    BFCArena::ShrinkPolicy policy;
+  };
+
+  /**
+   * `arenas` must be BFCArena instances. `thread_pool_params` provides the name, custom thread creation functions
+   * etc. for the thread of the shrinker. The size and spinning settings are overridden.
+   */
+  ArenaShrinker(const Config& config, std::vector<AllocatorPtr> arenas, OrtThreadPoolParams thread_pool_params);
+  ~ArenaShrinker();
+
+  /**
+   * Parse the configuration from the session config values.
+   * `enabled` is set to true if the values request background shrinking, in which case `config` is populated.
+   */
+  static Status ParseConfig(const std::string& interval_ms, const std::string& idle_timeout_ms,
+                            const std::string& high_water_mark_window_ms, const std::string& soft_limit_bytes,
+                            Config& config, bool& enabled);
+
+  // Evaluate the policy for every arena now.
+  void ShrinkArenas();
+
+  const Config& GetConfig() const { return config_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ArenaShrinker);
+
+  // Evaluates the policy once per interval until the shrinker is destroyed.
+  void ShrinkLoop();
+
+  const Config config_;
+  const std::vector<AllocatorPtr> arenas_;
+  std::unique_ptr<concurrency::ThreadPool> thread_pool_;
+
+  OrtMutex mutex_;
+  // signalled to stop the loop and when the loop exits.
+  OrtCondVar cv_;
+  // GUARDED_BY(mutex_)
+  bool stop_{false};
+  // GUARDED_BY(mutex_)
+  bool loop_done_{false};
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/async_run_queue.h"
+
+#include "core/common/parse_string.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+AsyncRunQueue::AsyncRunQueue(const Config& config, OrtThreadPoolParams thread_pool_params)
+    : config_(config) {
+  ORT_ENFORCE(config_.num_threads > 0, "AsyncRunQueue requires at least one thread. Got ", config_.num_threads);
+
+  // the thread pool counts the thread calling into it as one of its threads. nothing ever calls into the pool to
+  // help with the work here, so add one to get num_threads workers.
+  thread_pool_params.thread_pool_size = config_.num_threads + 1;
+  // the runners block in Run() or wait for work, so spinning would only burn cycles the intra-op threads could use.
+  thread_pool_params.allow_spinning = false;
+  thread_pool_params.auto_set_affinity = false;
+  thread_pool_params.affinity_str.clear();
+  thread_pool_params.dynamic_block_base_ = 0;
+
+  thread_pool_ = concurrency::CreateThreadPool(&Env::Default(), thread_pool_params,
+                                               concurrency::ThreadPoolType::INTER_OP);
+  ORT_ENFORCE(thread_pool_ != nullptr, "Failed to create the thread pool for RunAsync requests.");
+}
+
+AsyncRunQueue::~AsyncRunQueue() {
+  // wait for the runners to drain the queue before the thread pool is destroyed.
+  {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    runners_done_cv_.wait(lock, [this]() { return num_active_runners_ == 0; });
+  }
+
+  thread_pool_.reset();
+}
+
+Status AsyncRunQueue::ParseConfig(const std::string& num_threads, const std::string& max_queue_size,
+                                  Config& config, bool& enabled) {
+  enabled = false;
+  if (num_threads.empty()) {
+    return Status::OK();
+  }
+
+  Config parsed;
+  ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(num_threads, parsed.num_threads));
+  ORT_RETURN_IF_NOT(parsed.num_threads >= 0, "RunAsync number of threads must not be negative. Got ",
+                    parsed.num_threads);
+
+  if (!max_queue_size.empty()) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(max_queue_size, parsed.max_queue_size));
+  }
+
+  if (parsed.num_threads > 0) {
+    config = parsed;
+    enabled = true;
+  }
+
+  return Status::OK();
+}
+
+Status AsyncRunQueue::Submit(Task task) {
+  ORT_RETURN_IF_NOT(task, "RunAsync task must not be empty.");
+
+  bool start_runner = false;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (config_.max_queue_size != 0 && pending_.size() >= config_.max_queue_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "RunAsync queue is full. ", pending_.size(),
+                             " requests are waiting. Retry once earlier requests have completed.");
+    }
+
+    pending_.push_back(std::move(task));
+
+    // runners exit once the queue is empty, so every active runner is either executing a request or about to pick
+    // up the next one. start another one if the limit allows so the new request doesn't wait behind a busy runner.
+    if (num_active_runners_ < config_.num_threads) {
+      ++num_active_runners_;
+      start_runner = true;
+    }
+  }
+
+  if (start_runner) {
+    concurrency::ThreadPool::Schedule(thread_pool_.get(), [this]() { RunnerLoop(); });
+  }
+
+  return Status::OK();
+}
+
+size_t AsyncRunQueue::NumPending() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return pending_.size();
+}
+
+void AsyncRunQueue::RunnerLoop() {
+  for (;;) {
+    Task task;
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      if (pending_.empty()) {
+        if (--num_active_runners_ == 0) {
+          runners_done_cv_.notify_all();
+        }
+        return;
+      }
+
+      task = std::move(pending_.front());
+      pending_.pop_front();
+    }
+
+    // the task is expected to report failures through its own callback. anything escaping it must not take down
+    // the runner, as that would leave the remaining requests without a thread.
+    ORT_TRY {
+      task();
+    }
+    ORT_CATCH(...) {
+    }
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
+
+namespace onnxruntime {
+
+/**
+ * Bounded queue of RunAsync requests executed by a small set of threads owned by the queue.
+ *
+ * Requests are admitted into a queue and drained by at most `num_threads` runner tasks on a dedicated thread pool,
+ * so a pending request doesn't occupy a worker of the intra-op thread pool while it waits, and a request that is
+ * executing can use the complete intra-op thread pool for its kernels.
+ * Submit fails once `max_queue_size` requests are waiting, which lets the caller apply backpressure instead of
+ * growing the queue without limit.
+ *
+ * The destructor blocks until all admitted requests have been executed, so every admitted request is guaranteed to
+ * run (and invoke its callback) exactly once.
+ */
+class AsyncRunQueue {
+ public:
+  struct Config {
+    // number of threads executing requests. must be > 0.
+    int num_threads{0};
+    // maximum number of requests waiting for a thread. 0 means unbounded.
+    size_t max_queue_size{0};
+  };
+
+  using Task = std::function<void()>;
+
+  /**
+   * `thread_pool_params` provides the name, custom thread creation functions etc. for the threads of the queue.
+   * The size and spinning settings are overridden.
+   */
+  AsyncRunQueue(const Config& config, OrtThreadPoolParams thread_pool_params);
+  ~AsyncRunQueue();
+
+  /**
+   * Parse the configuration from the session config values.
+   * `enabled` is set to true if the values request dedicated threads, in which case `config` is populated.
+   */
+  static Status ParseConfig(const std::string& num_threads, const std::string& max_queue_size,
+                            Config& config, bool& enabled);
+
+  /**
+   * Admit `task` for execution on one of the threads of the queue.
+   * Returns an error without taking ownership of the task if the queue is full.
+   */
+  Status Submit(Task task);
+
+  // Number of admitted requests that have not started executing yet.
+  size_t NumPending() const;
+
+  const Config& GetConfig() const { return config_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncRunQueue);
+
+  // Executes tasks until the queue is empty.
+  void RunnerLoop();
+
+  const Config config_;
+  std::unique_ptr<concurrency::ThreadPool> thread_pool_;
+
+  mutable OrtMutex mutex_;
+  // signalled when the last runner exits.
+  OrtCondVar runners_done_cv_;
+  // GUARDED_BY(mutex_)
+  std::deque<Task> pending_;
+  // number of runner tasks scheduled on thread_pool_. GUARDED_BY(mutex_)
+  int num_active_runners_{0};
+};
+
+}  // namespace onnxruntime
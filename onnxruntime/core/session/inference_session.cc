@@ -11,13 +11,18 @@
 #include <thread>
 #include <queue>
 
+#include "core/common/cpuid_info.h"
 #include "core/common/denormal.h"
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/parallel_for_calibration.h"
 #include "core/common/parse_string.h"
 #include "core/common/path_string.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/ort_format_version.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/calibration_collector.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/feeds_fetches_manager.h"
@@ -27,15 +32,21 @@
 #include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/kernel_type_str_resolver_utils.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/roofline.h"
+#include "core/framework/shared_initializer_store.h"
+#include "core/framework/shared_weights_file.h"
 #include "core/framework/transform_layout_functions.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/optimizer/cast_precision_propagation.h"
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/layout_transformation/layout_transformation.h"
@@ -47,6 +58,7 @@
 #include "core/optimizer/transpose_optimization/ort_optimizer_utils.h"
 #include "core/platform/Barrier.h"
 #include "core/platform/ort_mutex.h"
+#include "core/platform/path_lib.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
@@ -60,6 +72,7 @@
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
+#include "core/session/optimized_model_cache.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/onnxruntime_run_options_config_keys.h"
 #include "core/util/protobuf_parsing_utils.h"
@@ -113,6 +126,19 @@ inline std::basic_string<T> GetCurrentTimeString() {
   return std::basic_string<T>(time_str);
 }
 
+// Describe the instruction set of the MLAS kernels selected for each kernel family as a JSON object,
+// so that profiles taken on different machines or with MLAS_DISPATCH_OVERRIDE can be compared.
+std::string GetMlasKernelDispatchJson() {
+  std::ostringstream json;
+  json << "{";
+  for (size_t family = 0; family < MlasKernelFamilyCount; family++) {
+    json << (family == 0 ? "" : ", ") << "\"" << MlasGetKernelFamilyName(static_cast<MLAS_KERNEL_FAMILY>(family))
+         << "\": \"" << MlasGetKernelFamilyIsa(static_cast<MLAS_KERNEL_FAMILY>(family)) << "\"";
+  }
+  json << "}";
+  return json.str();
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 
 static bool HasControlflowNodes(const Graph& graph) {
@@ -315,6 +341,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 #if !defined(ORT_MINIMAL_BUILD)
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   ORT_ENFORCE(graph_transformer_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps).IsOK());
+  graph_transformer_mgr_.SetProfiler(&session_profiler_);
 #endif
 
   bool set_denormal_as_zero =
@@ -352,6 +379,11 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinning, "0") == "1";
+        to.calibrate_parallel_for_costs =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpCalibrateParallelForCosts, "0") == "1" ||
+            !session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelForCalibrationFile, "").empty();
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -362,6 +394,10 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         if (session_options_.config_options.TryGetConfigEntry(kOrtSessionOptionsConfigIntraOpThreadAffinities, to.affinity_str)) {
           ORT_ENFORCE(!to.affinity_str.empty(), "Affinity string must not be empty");
         }
+        to.performance_cores_only =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpPerformanceCoresOnly, "0") == "1";
+        to.affinity_preset =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpThreadAffinityPreset, "");
         to.auto_set_affinity = to.thread_pool_size == 0 &&
                                session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                                to.affinity_str.empty();
@@ -390,6 +426,15 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.set_denormal_as_zero = set_denormal_as_zero;
         to.allow_spinning = allow_inter_op_spinning;
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
+        to.affinity_preset =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigInterOpThreadAffinityPreset, "");
+        // don't share the cores the intra op threads are bound to with the same preset
+        if (!to.affinity_preset.empty() && thread_pool_ &&
+            to.affinity_preset == session_options_.config_options.GetConfigOrDefault(
+                                      kOrtSessionOptionsConfigIntraOpThreadAffinityPreset, "") &&
+            !session_options_.config_options.GetConfigEntry(kOrtSessionOptionsConfigIntraOpThreadAffinities)) {
+          to.affinity_preset_reserved_cores = thread_pool_->NumThreads();
+        }
 
         // Set custom threading functions
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
@@ -416,7 +461,31 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
   }
 
+  const std::string calibration_file =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelForCalibrationFile, "");
+  if (!calibration_file.empty()) {
+    parallel_for_calibration_file_ = ToPathString(calibration_file);
+    size_t file_length = 0;
+    if (Env::Default().GetFileLength(parallel_for_calibration_file_.c_str(), file_length).IsOK()) {
+      auto status = concurrency::ParallelForCalibration::Instance().Load(parallel_for_calibration_file_);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Ignoring the parallel for calibration file: " << status.ErrorMessage();
+      }
+    }
+  }
+
   session_profiler_.Initialize(session_logger_);
+  profiling::ProfilerSamplingOptions sampling_options;
+  sampling_options.run_sample_rate = ParseStringWithClassicLocale<uint32_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingSampleRate, "0"));
+  sampling_options.run_sample_interval_ms = ParseStringWithClassicLocale<int64_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingSampleIntervalMs, "0"));
+  sampling_options.summary_flush_interval_ms = ParseStringWithClassicLocale<int64_t>(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingSummaryFlushIntervalMs,
+                                                         "0"));
+  if (sampling_options.run_sample_rate > 0 || sampling_options.run_sample_interval_ms > 0) {
+    session_profiler_.EnableSampling(sampling_options);
+  }
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
@@ -501,6 +570,47 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // complete pending RunAsync requests while the session is fully alive.
+  async_run_queue_.reset();
+  arena_shrinker_.reset();
+  for (const auto& arena : traced_arenas_) {
+    static_cast<BFCArena*>(arena.get())->SetAllocationTraceRecorder(nullptr);
+  }
+  allocation_trace_recorder_.reset();
+
+  if (!parallel_for_calibration_file_.empty()) {
+    auto status = concurrency::ParallelForCalibration::Instance().Save(parallel_for_calibration_file_);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save the parallel for calibration file: " << status.ErrorMessage();
+    }
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  const std::string tuning_results_file =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTuningResultsFile, "");
+  if (is_inited_ && !tuning_results_file.empty() &&
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTuningResultsFileReadOnly, "0") != "1") {
+    auto tuning_results = GetTuningResults();
+    tuning_results.erase(std::remove_if(tuning_results.begin(), tuning_results.end(),
+                                        [](const TuningResults& tr) { return tr.results.empty(); }),
+                         tuning_results.end());
+    if (!tuning_results.empty()) {
+      auto status = inference_session_utils::MergeIntoTuningResultsFile(ToPathString(tuning_results_file),
+                                                                        tuning_results);
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Failed to save the tuning results file: " << status.ErrorMessage();
+      }
+    }
+  }
+
+  if (calibration_collector_ && !calibration_collector_->OutputFile().empty()) {
+    auto status = calibration_collector_->Save(calibration_collector_->OutputFile());
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to save the quantization calibration file: " << status.ErrorMessage();
+    }
+  }
+#endif
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -691,10 +801,23 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   ORT_RETURN_IF_ERROR(
       kernel_type_str_resolver.SaveToOrtFormat(builder, fbs_kernel_type_str_resolver));
 
+  flatbuffers::Offset<fbs::ExecutionPlan> fbs_execution_plan;
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveExecutionPlanInOrtFormat,
+                                                         "0") == "1") {
+    const auto status = session_state_->SaveExecutionPlanToOrtFormat(builder, fbs_execution_plan);
+    if (status.Code() == common::NOT_IMPLEMENTED) {
+      LOGS(*session_logger_, WARNING) << "The execution plan is not saved in the ORT format model. "
+                                      << status.ErrorMessage();
+    } else {
+      ORT_RETURN_IF_ERROR(status);
+    }
+  }
+
   fbs::InferenceSessionBuilder sb(builder);
   sb.add_ort_version(ort_model_version);
   sb.add_model(fbs_model);
   sb.add_kernel_type_str_resolver(fbs_kernel_type_str_resolver);
+  sb.add_execution_plan(fbs_execution_plan);
   auto session = sb.Finish();
   builder.Finish(session, fbs::InferenceSessionIdentifier());
 
@@ -709,6 +832,81 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   return Status::OK();
 }
 
+void InferenceSession::LoadFromOptimizedModelCache() {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "");
+  // the hash is only there if the ONNX model was loaded from a file or from bytes
+  if (cache_dir.empty() || optimized_model_cache_model_hash_.empty()) {
+    return;
+  }
+
+  if (!session_options_.optimized_model_filepath.empty() || !session_options_.initializers_to_share_map.empty() ||
+      !session_options_.external_initializers.empty()) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache is not used with an optimized model file path, "
+                                 << "shared initializers or external initializers.";
+    return;
+  }
+
+  for (const auto& ep : execution_providers_) {
+    if (!optimized_model_cache::IsSupportedExecutionProvider(ep->Type())) {
+      LOGS(*session_logger_, INFO) << "The optimized model cache is not used with the " << ep->Type() << ".";
+      return;
+    }
+  }
+
+  const PathString cache_file = optimized_model_cache::GetCacheFilePath(
+      ToPathString(cache_dir), optimized_model_cache_model_hash_, session_options_, execution_providers_,
+      optimizers_to_disable_);
+  if (optimized_model_cache::CacheFileExists(cache_file)) {
+    // LoadOrtModel replaces the ONNX model, which is restored if the cache file can't be loaded
+    std::shared_ptr<onnxruntime::Model> onnx_model = model_;
+    const PathString onnx_model_location = model_location_;
+    {
+      std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+      is_model_loaded_ = false;
+    }
+
+    const Status status = LoadOrtModel(cache_file);
+    if (status.IsOK()) {
+      optimized_model_cache::TouchCacheFile(cache_file);
+      LOGS(*session_logger_, INFO) << "Loaded the optimized model from the cache file " << ToUTF8String(cache_file);
+      return;
+    }
+
+    LOGS(*session_logger_, WARNING) << "Failed to load the optimized model cache file " << ToUTF8String(cache_file)
+                                    << ". The model will be optimized and saved again. " << status.ErrorMessage();
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    model_ = std::move(onnx_model);
+    model_location_ = onnx_model_location;
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ort_format_model_mapped_bytes_.reset();
+    is_model_loaded_ = true;
+  }
+
+  optimized_model_cache_file_ = cache_file;
+}
+
+void InferenceSession::SaveToOptimizedModelCache() {
+  // the cache only speeds up later sessions, so failing to update it doesn't fail this one
+  Status status = optimized_model_cache::WriteCacheFile(
+      optimized_model_cache_file_, session_id_,
+      [this](const PathString& filepath) { return SaveToOrtFormat(filepath); });
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to save the optimized model cache file "
+                                    << ToUTF8String(optimized_model_cache_file_) << ": " << status.ErrorMessage();
+    return;
+  }
+
+  const auto max_size = ParseStringWithClassicLocale<uint64_t>(session_options_.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsOptimizedModelCacheMaxSizeInBytes, "0"));
+  if (max_size > 0) {
+    const PathString cache_dir = ToPathString(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, ""));
+    optimized_model_cache::EvictCacheFiles(cache_dir, max_size, optimized_model_cache_file_, *session_logger_);
+  }
+}
+
 common::Status InferenceSession::LoadWithLoader(std::function<common::Status(std::shared_ptr<Model>&)> loader,
                                                 const std::string& event_name) {
   Status status = Status::OK();
@@ -806,7 +1004,11 @@ common::Status InferenceSession::Load(const PathString& model_uri) {
                            "Invoke Load().");
   }
 
-  return LoadOnnxModel(model_uri);
+  ORT_RETURN_IF_ERROR(LoadOnnxModel(model_uri));
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "").empty()) {
+    ORT_RETURN_IF_ERROR(optimized_model_cache::HashModelFile(model_uri, optimized_model_cache_model_hash_));
+  }
+  return Status::OK();
 #else
   return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ONNX format model is not supported in this build.");
 #endif
@@ -858,7 +1060,11 @@ common::Status InferenceSession::Load(const void* model_data, int model_data_len
                                     ModelOptions(true, strict_shape_type_inference));
   };
 
-  return LoadWithLoader(loader, "model_loading_array");
+  ORT_RETURN_IF_ERROR(LoadWithLoader(loader, "model_loading_array"));
+  if (!session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "").empty()) {
+    optimized_model_cache_model_hash_ = optimized_model_cache::HashModelBytes(model_data, narrow<size_t>(model_data_len));
+  }
+  return Status::OK();
 #else
   return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ONNX format model is not supported in this build.");
 #endif
@@ -1046,9 +1252,19 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
   }
 
   // Do partitioning based on execution providers' capabilities.
-  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_);
+  TimePoint partitioning_start_time;
+  if (session_profiler_.IsEnabled()) {
+    partitioning_start_time = session_profiler_.Start();
+  }
+  const bool cost_aware_partitioning =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCostAwarePartitioning, "0") == "1";
+  GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, cost_aware_partitioning,
+                               GetCompileThreadPoolToUse());
   ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state_->GetMutableFuncMgr(), transform_layout_fn,
                                                        mode, debug_graph_fn));
+  if (session_profiler_.IsEnabled()) {
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_partitioning", partitioning_start_time);
+  }
 
   // apply Level2 and higher transformers.
   // we do not run Level 1 again as those transformers assume partitioning will run later to do node assignment.
@@ -1057,6 +1273,19 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
         graph_transformer_mgr_.ApplyTransformers(graph, static_cast<TransformerLevel>(i), *session_logger_));
   }
 
+  // Choose float or float16 for the regions of nodes that can run in either.
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableCastPrecisionPropagation, "0") ==
+      "1") {
+    InlinedHashSet<std::string> fp16_ops;
+    const std::string fp16_ops_config =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCastPrecisionPropagationFp16Ops, "");
+    for (const auto op_type : utils::SplitString(fp16_ops_config, ",")) {
+      fp16_ops.emplace(op_type);
+    }
+    CastPrecisionPropagation cast_precision_propagation{kernel_registry_manager_, std::move(fp16_ops)};
+    ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(cast_precision_propagation, *session_logger_, graph));
+  }
+
   // Insert cast node/s.
   {
     const InlinedVector<gsl::not_null<const KernelRegistry*>> kernel_regs =
@@ -1106,12 +1335,35 @@ static Status LoadOrtModelBytes(const PathString& model_uri,
   return Status::OK();
 }
 
+static Status MapOrtModelBytes(const PathString& model_uri,
+                               gsl::span<const uint8_t>& bytes,
+                               Env::MappedMemoryPtr& mapped_bytes) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_uri.c_str(), num_bytes));
+  ORT_RETURN_IF(num_bytes == 0, "Load model from ", ToUTF8String(model_uri), " failed. The file is empty.");
+
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(model_uri.c_str(), 0, num_bytes, mapped_bytes));
+  bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes.get()), num_bytes);
+
+  return Status::OK();
+}
+
 Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
-        ORT_RETURN_IF_ERROR(
-            LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+        const auto use_ort_model_bytes_directly =
+            GetSessionOptions().config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesDirectly,
+                                                                  "0") == "1";
+        if (use_ort_model_bytes_directly) {
+          // the mapped pages are shared with the other processes that map the file. the initializers can use them
+          // directly as the writer aligns their data.
+          ORT_RETURN_IF_ERROR(
+              MapOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_mapped_bytes_));
+        } else {
+          ORT_RETURN_IF_ERROR(
+              LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+        }
         return Status::OK();
       });
 }
@@ -1308,6 +1560,334 @@ static bool ModelHasFP16Inputs(const Graph& graph) {
   return false;
 }
 
+common::Status InferenceSession::AttachContentSharedInitializers(const onnxruntime::Graph& graph) {
+  SharedInitializerStore* store = environment_.GetSharedInitializerStore();
+  if (store == nullptr ||
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersByContent,
+                                                         "0") != "1") {
+    return Status::OK();
+  }
+
+  // hashing and comparing initializers smaller than this costs more than sharing them saves
+  constexpr size_t kMinSharedInitializerBytes = 1024;
+  size_t num_loaded = 0;
+  ORT_RETURN_IF_ERROR(store->GetOrAddInitializers(Env::Default(), model_location_, graph, kMinSharedInitializerBytes,
+                                                  content_shared_initializers_, num_loaded));
+  size_t num_used = 0;
+  for (const auto& entry : content_shared_initializers_) {
+    // initializers added by the user or mapped from the shared weights file take precedence
+    if (session_options_.initializers_to_share_map.emplace(entry.first, &entry.second).second) {
+      ++num_used;
+    }
+  }
+
+  LOGS(*session_logger_, INFO) << "Sharing " << num_used << " initializers by content, " << num_loaded
+                               << " of them already loaded by another session.";
+  return Status::OK();
+}
+
+common::Status InferenceSession::AttachSharedWeights(const onnxruntime::Graph& graph) {
+  const std::string file_path =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSharedWeightsFile, "");
+  if (file_path.empty()) {
+    return Status::OK();
+  }
+
+  const auto& env = Env::Default();
+  const PathString initializers_path = ToPathString(file_path);
+  std::shared_ptr<const SharedWeightsFile> initializers_file;
+  size_t file_length = 0;
+  if (!env.GetFileLength(initializers_path.c_str(), file_length).IsOK()) {
+    // the first process to get here writes the file. a sibling doing the same concurrently is fine as the file is
+    // published with a rename.
+    Status status = SharedWeightsFile::SaveInitializers(env, model_location_, graph, initializers_path);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to create the shared weights file " << file_path << ": "
+                                      << status.ErrorMessage();
+    }
+  }
+
+  Status status = SharedWeightsFile::Load(env, initializers_path, initializers_file);
+  if (status.IsOK()) {
+    ORT_RETURN_IF_ERROR(initializers_file->CreateInitializers(graph, shared_weights_initializers_));
+    size_t num_shared = 0;
+    for (const auto& entry : shared_weights_initializers_) {
+      // initializers added by the user take precedence
+      if (session_options_.initializers_to_share_map.emplace(entry.first, &entry.second).second) {
+        ++num_shared;
+      }
+    }
+
+    LOGS(*session_logger_, INFO) << "Using " << num_shared << " initializers mapped from the shared weights file "
+                                 << file_path;
+  } else {
+    LOGS(*session_logger_, WARNING) << "Not using the shared weights file " << file_path << ": "
+                                    << status.ErrorMessage();
+  }
+
+  const PathString prepacked_path = initializers_path + ToPathString(".prepacked");
+  std::shared_ptr<const SharedWeightsFile> prepacked_file;
+  if (prepacked_weights_container_ != nullptr &&
+      env.GetFileLength(prepacked_path.c_str(), file_length).IsOK()) {
+    status = SharedWeightsFile::Load(env, prepacked_path, prepacked_file);
+    if (status.IsOK()) {
+      std::lock_guard<OrtMutex> lock(prepacked_weights_container_->mutex_);
+      const size_t num_added = prepacked_file->AddPrepackedWeights(*prepacked_weights_container_);
+      LOGS(*session_logger_, INFO) << "Added " << num_added << " pre-packed weights mapped from "
+                                   << PathToUTF8String(prepacked_path);
+    } else {
+      LOGS(*session_logger_, WARNING) << "Not using the shared pre-packed weights file: " << status.ErrorMessage();
+    }
+  }
+
+  return Status::OK();
+}
+
+void InferenceSession::PublishSharedPrepackedWeights() {
+  const std::string file_path =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSharedWeightsFile, "");
+  if (file_path.empty() || prepacked_weights_container_ == nullptr) {
+    return;
+  }
+
+  const auto& env = Env::Default();
+  const PathString prepacked_path = ToPathString(file_path) + ToPathString(".prepacked");
+  size_t file_length = 0;
+  if (env.GetFileLength(prepacked_path.c_str(), file_length).IsOK()) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(prepacked_weights_container_->mutex_);
+  if (prepacked_weights_container_->GetNumberOfElements() == 0) {
+    return;
+  }
+
+  // this process keeps using its own copies. processes started later map the file.
+  Status status = SharedWeightsFile::SavePrepackedWeights(*prepacked_weights_container_, prepacked_path);
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to create the shared pre-packed weights file "
+                                    << PathToUTF8String(prepacked_path) << ": " << status.ErrorMessage();
+  }
+}
+
+// Identifies the model and the host the pre-packed weights are computed for, as the layout of the pre-packed weights
+// depends on the kernels and the instruction sets MLAS picks.
+static uint64_t ComputePrepackedWeightsCacheKey(const Graph& graph) {
+  std::ostringstream ss;
+  ss << ORT_VERSION << ";" << sizeof(void*);
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  for (bool feature : {cpuid_info.HasSSE3(), cpuid_info.HasSSE4_1(), cpuid_info.HasAVX(), cpuid_info.HasAVX2(),
+                       cpuid_info.HasAVX512f(), cpuid_info.HasAVX512Skylake(), cpuid_info.HasAVX512_BF16(),
+                       cpuid_info.HasAMX_BF16(), cpuid_info.HasF16C(), cpuid_info.HasArmNeonDot(),
+                       cpuid_info.HasFp16VectorAcceleration()}) {
+    ss << (feature ? '1' : '0');
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    ss << ";" << node.Domain() << ":" << node.OpType() << ":" << node.Name() << ":" << node.GetExecutionProviderType();
+  }
+
+  const std::string identity = ss.str();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(identity.data(), narrow<int>(identity.size()), 0, &hash);
+  return (static_cast<uint64_t>(hash[1]) << 32) | hash[0];
+}
+
+common::Status InferenceSession::AttachPrepackedWeightsCache(const onnxruntime::Graph& graph, bool saving_ort_format,
+                                                             bool loading_ort_format) {
+  const std::string cache_dir =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsCacheDir, "");
+  const bool save_with_ort_model =
+      saving_ort_format && !session_options_.optimized_model_filepath.empty() &&
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSavePrepackedWeightsWithOrtModel,
+                                                         "0") == "1";
+  const bool use_saved_with_ort_model = loading_ort_format && !model_location_.empty();
+  if (cache_dir.empty() && !save_with_ort_model && !use_saved_with_ort_model) {
+    return Status::OK();
+  }
+
+  std::ostringstream key;
+  key << std::hex << ComputePrepackedWeightsCacheKey(graph);
+  if (!cache_dir.empty()) {
+    prepacked_weights_cache_path_ = ConcatPathComponent(ToPathString(cache_dir),
+                                                        ToPathString("prepacked_weights_" + key.str() + ".bin"));
+  } else if (save_with_ort_model) {
+    prepacked_weights_cache_path_ = session_options_.optimized_model_filepath +
+                                    ToPathString("." + key.str() + ".prepacked");
+  } else {
+    // the file written next to the ORT format model is only used if it was written for the same nodes and host
+    prepacked_weights_cache_path_ = model_location_ + ToPathString("." + key.str() + ".prepacked");
+  }
+
+  const auto& env = Env::Default();
+  size_t file_length = 0;
+  const bool file_exists = env.GetFileLength(prepacked_weights_cache_path_.c_str(), file_length).IsOK();
+  if (cache_dir.empty() && !save_with_ort_model && !file_exists) {
+    prepacked_weights_cache_path_.clear();
+    return Status::OK();
+  }
+
+  prepacked_weights_cache_ = std::make_unique<PrepackedWeightsCache>();
+  if (file_exists) {
+    Status status = SharedWeightsFile::Load(env, prepacked_weights_cache_path_, prepacked_weights_cache_->file);
+    if (status.IsOK()) {
+      LOGS(*session_logger_, INFO) << "Using the pre-packed weights cache "
+                                   << PathToUTF8String(prepacked_weights_cache_path_) << " with "
+                                   << prepacked_weights_cache_->file->NumEntries() << " entries";
+    } else {
+      // the file is rewritten once the weights are pre-packed
+      LOGS(*session_logger_, WARNING) << "Not using the pre-packed weights cache: " << status.ErrorMessage();
+    }
+  }
+
+  // loading a model does not write next to it. the file is only rewritten when the model is saved again.
+  prepacked_weights_cache_read_only_ = cache_dir.empty() && !save_with_ort_model;
+
+  session_state_->SetPrepackedWeightsCache(prepacked_weights_cache_.get());
+  return Status::OK();
+}
+
+common::Status InferenceSession::Clone(const SessionOptions& session_options,
+                                       std::unique_ptr<InferenceSession>& clone) const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Only an initialized session can be cloned.");
+    }
+  }
+
+  // the execution plans of the shared session state were created for these settings
+  SessionOptions clone_options = session_options;
+  clone_options.execution_mode = session_options_.execution_mode;
+  clone_options.use_per_session_threads = session_options_.use_per_session_threads;
+
+  auto new_session = std::make_unique<InferenceSession>(clone_options, environment_, GetIntraOpThreadPoolToUse(),
+                                                        GetInterOpThreadPoolToUse());
+
+  for (const auto& ep : execution_providers_) {
+    ORT_RETURN_IF_ERROR(new_session->execution_providers_.Add(ep->Type(), ep));
+  }
+
+  new_session->model_location_ = model_location_;
+  new_session->model_ = model_;
+  new_session->session_state_ = session_state_;
+  new_session->model_metadata_ = model_metadata_;
+  new_session->required_inputs_ = required_inputs_;
+  new_session->input_def_map_ = input_def_map_;
+  new_session->output_def_list_ = output_def_list_;
+  new_session->is_concurrent_run_supported_ = is_concurrent_run_supported_;
+  new_session->cached_execution_provider_for_graph_replay_ = cached_execution_provider_for_graph_replay_;
+
+  ORT_RETURN_IF_ERROR(new_session->CreateRunQueues());
+
+  new_session->is_model_loaded_ = true;
+  new_session->is_inited_ = true;
+
+  LOGS(*session_logger_, INFO) << "Cloned the session as session " << new_session->session_id_;
+  clone = std::move(new_session);
+  return Status::OK();
+}
+
+Status InferenceSession::CreateRunQueues() {
+  {
+    RequestBatcher::Config batching_config;
+    bool enable_batching = false;
+    const auto& config_options = session_options_.config_options;
+    ORT_RETURN_IF_ERROR_SESSIONID_(RequestBatcher::ParseConfig(
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingMaxBatchSize, ""),
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingMaxWaitUs, ""),
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBatchingBatchAxis, ""),
+        batching_config, enable_batching));
+
+    if (enable_batching) {
+      LOGS(*session_logger_, INFO) << "Dynamic batching enabled. Max batch size: " << batching_config.max_batch_size
+                                   << " Max wait: " << batching_config.max_wait.count() << "us"
+                                   << " Batch axis: " << batching_config.batch_axis;
+      request_batcher_ = std::make_unique<RequestBatcher>(
+          batching_config, session_state_->GetAllocator(OrtDevice()),
+          [this](const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                 gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                 std::vector<OrtValue>* p_fetches) {
+            return RunImpl(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
+          });
+    }
+  }
+
+  {
+    AsyncRunQueue::Config async_run_config;
+    bool use_async_run_queue = false;
+    const auto& config_options = session_options_.config_options;
+    ORT_RETURN_IF_ERROR_SESSIONID_(AsyncRunQueue::ParseConfig(
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunAsyncNumThreads, ""),
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigRunAsyncMaxQueueSize, ""),
+        async_run_config, use_async_run_queue));
+
+    if (use_async_run_queue) {
+      LOGS(*session_logger_, INFO) << "RunAsync requests are executed by " << async_run_config.num_threads
+                                   << " dedicated thread(s). Max queue size: " << async_run_config.max_queue_size;
+      OrtThreadPoolParams to;
+      std::basic_stringstream<ORTCHAR_T> ss;
+      if (session_options_.intra_op_param.name) {
+        ss << session_options_.intra_op_param.name << ORT_TSTR("-");
+      }
+      ss << ORT_TSTR("session-") << session_id_ << ORT_TSTR("-run-async");
+      const auto async_run_thread_pool_name = ss.str();
+      to.name = async_run_thread_pool_name.c_str();
+      to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
+      to.custom_thread_creation_options = session_options_.custom_thread_creation_options;
+      to.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+      async_run_queue_ = std::make_unique<AsyncRunQueue>(async_run_config, to);
+    }
+  }
+
+  return Status::OK();
+}
+
+void InferenceSession::PublishPrepackedWeightsCache() {
+  if (prepacked_weights_cache_ == nullptr) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(prepacked_weights_cache_->mutex);
+  if (prepacked_weights_cache_->new_entries.empty()) {
+    return;
+  }
+
+  if (prepacked_weights_cache_read_only_) {
+    prepacked_weights_cache_->new_entries.clear();
+    return;
+  }
+
+  // keep the entries of the existing file that were not pre-packed again, e.g. those of other subgraphs
+  InlinedHashSet<std::string_view> names;
+  std::vector<const SharedWeightsFile::Entry*> entries;
+  for (const auto& entry : prepacked_weights_cache_->new_entries) {
+    if (names.insert(entry.name).second) {
+      entries.push_back(&entry);
+    }
+  }
+
+  if (prepacked_weights_cache_->file != nullptr) {
+    for (const auto& item : prepacked_weights_cache_->file->Entries()) {
+      if (names.insert(item.first).second) {
+        entries.push_back(&item.second);
+      }
+    }
+  }
+
+  Status status = SharedWeightsFile::SaveEntries(entries, prepacked_weights_cache_path_);
+  if (status.IsOK()) {
+    LOGS(*session_logger_, INFO) << "Wrote " << entries.size() << " pre-packed weights to "
+                                 << PathToUTF8String(prepacked_weights_cache_path_);
+  } else {
+    LOGS(*session_logger_, WARNING) << "Failed to write the pre-packed weights cache "
+                                    << PathToUTF8String(prepacked_weights_cache_path_) << ": " << status.ErrorMessage();
+  }
+
+  // the entries only describe buffers of the kernels, which are not needed once the file is written
+  prepacked_weights_cache_->new_entries.clear();
+}
+
 common::Status InferenceSession::AddPrePackedWeightsContainer(PrepackedWeightsContainer* prepacked_weights_container) {
   if (prepacked_weights_container == nullptr) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
@@ -1324,11 +1904,21 @@ common::Status InferenceSession::AddPrePackedWeightsContainer(PrepackedWeightsCo
   return Status::OK();
 }
 
+onnxruntime::concurrency::ThreadPool* InferenceSession::GetCompileThreadPoolToUse() const {
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableParallelCompilation,
+                                                         "0") == "1") {
+    return nullptr;
+  }
+
+  return GetIntraOpThreadPoolToUse();
+}
+
 namespace {
 Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
                                const ExecutionProviders& providers,
                                KernelRegistryManager& kernel_registry_manager,
-                               SessionState& session_state) {
+                               SessionState& session_state,
+                               concurrency::ThreadPool* compile_thread_pool) {
   layout_transformation::TransformLayoutFunction transform_layout_fn = nullptr;
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -1345,7 +1935,7 @@ Status PartitionOrtFormatModel(onnxruntime::Graph& graph,
   }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  GraphPartitioner partitioner(kernel_registry_manager, providers, false, compile_thread_pool);
   ORT_RETURN_IF_ERROR(partitioner.Partition(graph,
                                             session_state.GetMutableFuncMgr(),
                                             transform_layout_fn,
@@ -1421,6 +2011,11 @@ common::Status InferenceSession::Initialize() {
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
     }
 
+#if !defined(ORT_MINIMAL_BUILD)
+    // LoadOrtModel locks the session_mutex_ so we can't be holding it when we call this
+    LoadFromOptimizedModelCache();
+#endif
+
     // Verify that there are no external initializers in the graph if external data is disabled.
     onnxruntime::Graph& graph = model_->MainGraph();
 #ifdef DISABLE_EXTERNAL_INITIALIZERS
@@ -1438,6 +2033,26 @@ common::Status InferenceSession::Initialize() {
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      const auto& config_options = session_options_.config_options;
+      ORT_RETURN_IF_ERROR_SESSIONID_(HugePageCPUAllocator::ParseOptions(
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuAllocatorHugePages, ""),
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuAllocatorNumaNode, ""),
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpThreadAffinities, ""),
+          epi.allocator_options));
+      epi.enable_bf16_gemm = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuBf16Gemm, "0") == "1";
+      epi.enable_bf16_mixed_precision =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuBf16MixedPrecision, "0") == "1";
+      epi.enable_winograd_conv = config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuWinogradConv, "1") == "1";
+      epi.dynamic_quantize_matmul_per_row =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuDynamicQuantizeMatMulPerRow, "0") == "1";
+      epi.qattention_int8_core =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuQAttentionInt8Core, "0") == "1";
+      epi.enable_sparse24_gemm =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuSparse24Gemm, "0") == "1";
+      const std::string tree_ensemble_quantization =
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuTreeEnsembleQuantization, "0");
+      epi.quantize_tree_ensembles = tree_ensemble_quantization == "1" || tree_ensemble_quantization == "exact";
+      epi.tree_ensemble_exact_quantization = tree_ensemble_quantization == "exact";
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
       execution_providers_.SetCpuProviderWasImplicitlyAdded(true);
@@ -1458,6 +2073,20 @@ common::Status InferenceSession::Initialize() {
     session_activity_started_ = true;
 #endif
 
+    if (prepacked_weights_container_ == nullptr && environment_.GetSharedInitializerStore() != nullptr &&
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigShareInitializersByContent,
+                                                           "0") == "1") {
+      // share the pre-packed forms of the initializers shared by content as well
+      prepacked_weights_container_ = &environment_.GetSharedInitializerStore()->GetPrepackedWeightsContainer();
+    }
+
+    if (prepacked_weights_container_ == nullptr &&
+        !session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSharedWeightsFile, "").empty()) {
+      // pre-packed weights are only looked up in the shared weights file if they go through a container
+      owned_prepacked_weights_container_ = std::make_unique<PrepackedWeightsContainer>();
+      prepacked_weights_container_ = owned_prepacked_weights_container_.get();
+    }
+
     // now that we have all the execution providers, create the session state
     session_state_ = std::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1470,6 +2099,24 @@ common::Status InferenceSession::Initialize() {
         session_options_,
         prepacked_weights_container_);
 
+    if (!use_per_session_threads_) {
+      concurrency::ThreadPool::WorkShare work_share;
+      work_share.weight = ParseStringWithClassicLocale<int>(
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpWorkShareWeight, "1"));
+      work_share.min_threads = ParseStringWithClassicLocale<int>(
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpWorkShareMinThreads, "0"));
+      ORT_RETURN_IF_NOT(work_share.weight > 0 && work_share.min_threads >= 0,
+                        "Invalid intra-op work share: the weight must be positive and the minimum number of threads "
+                        "can't be negative.");
+      session_state_->SetIntraOpWorkShare(work_share);
+    }
+
+#if !defined(ORT_MINIMAL_BUILD)
+    ORT_RETURN_IF_ERROR_SESSIONID_(
+        CalibrationCollector::Create(session_options_.config_options, calibration_collector_));
+    session_state_->SetCalibrationCollector(calibration_collector_.get());
+#endif
+
     bool use_env_allocators =
         session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
     if (use_env_allocators) {
@@ -1500,9 +2147,14 @@ common::Status InferenceSession::Initialize() {
     ORT_RETURN_IF_ERROR_SESSIONID_(kernel_registry_manager_.RegisterKernels(execution_providers_));
 
     const bool loading_ort_format = !ort_format_model_bytes_.empty();
-    const bool saving_model = !session_options_.optimized_model_filepath.empty();
-    const bool saving_ort_format = [&]() {
-      if (saving_model) {
+#if !defined(ORT_MINIMAL_BUILD)
+    const bool saving_to_cache = !optimized_model_cache_file_.empty();
+#else
+    const bool saving_to_cache = false;
+#endif
+    const bool saving_model = !session_options_.optimized_model_filepath.empty() || saving_to_cache;
+    const bool saving_ort_format = saving_to_cache || [&]() {
+      if (!session_options_.optimized_model_filepath.empty()) {
         const std::string model_type = session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigSaveModelFormat, "");
         const bool has_explicit_type = !model_type.empty();
         return ((has_explicit_type && model_type == "ORT") ||
@@ -1577,7 +2229,14 @@ common::Status InferenceSession::Initialize() {
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, saving_ort_format));
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
+      TimePoint resolve_start_time;
+      if (session_profiler_.IsEnabled()) {
+        resolve_start_time = session_profiler_.Start();
+      }
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_resolve", resolve_start_time);
+      }
 
       // Currently CUDA graph is only considered by CUDA EP and TRT EP.
       //
@@ -1701,8 +2360,16 @@ common::Status InferenceSession::Initialize() {
                           "Loading anything other than ORT format models is not enabled in this build."));
 #endif  // !defined(ORT_MINIMAL_BUILD)
     } else {
+      TimePoint partitioning_start_time;
+      if (session_profiler_.IsEnabled()) {
+        partitioning_start_time = session_profiler_.Start();
+      }
       ORT_RETURN_IF_ERROR_SESSIONID_(PartitionOrtFormatModel(graph, execution_providers_, kernel_registry_manager_,
-                                                             *session_state_));
+                                                             *session_state_, GetCompileThreadPoolToUse()));
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_partitioning",
+                                                partitioning_start_time);
+      }
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
       const auto& cpu_ep = *execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
@@ -1711,14 +2378,35 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+    if (loading_ort_format) {
+      // the model bytes were verified when loading, and are kept alive until the end of Initialize
+      session_state_->SetSerializedExecutionPlan(
+          fbs::GetInferenceSession(ort_format_model_bytes_.data())->execution_plan());
+    }
+
+    ORT_RETURN_IF_ERROR_SESSIONID_(AttachSharedWeights(graph));
+    ORT_RETURN_IF_ERROR_SESSIONID_(AttachContentSharedInitializers(graph));
+    ORT_RETURN_IF_ERROR_SESSIONID_(AttachPrepackedWeightsCache(graph, saving_ort_format, loading_ort_format));
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
                                              !saving_model,
                                              saving_ort_format));
 
+    PublishSharedPrepackedWeights();
+    PublishPrepackedWeightsCache();
+
+#ifdef ORT_ENABLE_STREAM
+    const size_t device_stream_pool_size = ParseStringWithClassicLocale<size_t>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDeviceStreamPoolSize, "0"));
+    session_state_->FillDeviceStreamPool(device_stream_pool_size);
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD)
-    if (saving_model) {
+    if (saving_to_cache) {
+      SaveToOptimizedModelCache();
+    } else if (saving_model) {
       if (session_state_->GetFuncMgr().NumFuncs() > 0) {
         ORT_RETURN_IF_ERROR_SESSIONID_(
             ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -1762,16 +2450,93 @@ common::Status InferenceSession::Initialize() {
     if (found_tuning_results) {
       ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(tuning_results, /*error_on_invalid*/ false, /*auto_enable*/ true));
     }
+
+    const std::string tuning_results_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigTuningResultsFile, "");
+    if (!tuning_results_file.empty()) {
+      auto status = inference_session_utils::LoadTuningResultsFile(ToPathString(tuning_results_file), tuning_results);
+      if (status.IsOK()) {
+        // the file is shared by different devices and versions, only load the results the EPs can use
+        std::vector<TuningResults> usable_tuning_results;
+        for (auto& tr : tuning_results) {
+          const auto* provider = execution_providers_.Get(tr.ep);
+          const auto* tuning_ctx = provider != nullptr ? provider->GetTuningContext() : nullptr;
+          if (tuning_ctx != nullptr && tuning_ctx->GetTuningResultsValidator().ValidateAll(tr.validators).IsOK()) {
+            usable_tuning_results.push_back(std::move(tr));
+          }
+        }
+        ORT_RETURN_IF_ERROR_SESSIONID_(SetTuningResults(usable_tuning_results, /*error_on_invalid*/ false,
+                                                        /*auto_enable*/ true));
+      } else {
+        LOGS(*session_logger_, WARNING) << "Ignoring the tuning results file: " << status.ErrorMessage();
+      }
+    }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    ORT_RETURN_IF_ERROR_SESSIONID_(CreateRunQueues());
+
+    {
+      ArenaShrinker::Config arena_shrink_config;
+      bool use_arena_shrinker = false;
+      const auto& config_options = session_options_.config_options;
+      ORT_RETURN_IF_ERROR_SESSIONID_(ArenaShrinker::ParseConfig(
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigArenaShrinkIntervalMs, ""),
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigArenaShrinkIdleTimeoutMs, ""),
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigArenaShrinkHighWaterMarkWindowMs, ""),
+          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigArenaShrinkSoftLimitBytes, ""),
+          arena_shrink_config, use_arena_shrinker));
+
+      std::vector<AllocatorPtr> arenas;
+      if (use_arena_shrinker) {
+        for (const auto& entry : session_state_->GetAllocators()) {
+          if (entry.second->Info().alloc_type == OrtArenaAllocator) {
+            arenas.push_back(entry.second);
+          }
+        }
+      }
+
+      if (!arenas.empty()) {
+        LOGS(*session_logger_, INFO) << "Shrinking " << arenas.size() << " arena(s) every "
+                                     << arena_shrink_config.interval.count() << " ms.";
+        OrtThreadPoolParams to;
+        std::basic_stringstream<ORTCHAR_T> ss;
+        if (session_options_.intra_op_param.name) {
+          ss << session_options_.intra_op_param.name << ORT_TSTR("-");
+        }
+        ss << ORT_TSTR("session-") << session_id_ << ORT_TSTR("-arena-shrink");
+        const auto arena_shrink_thread_pool_name = ss.str();
+        to.name = arena_shrink_thread_pool_name.c_str();
+        to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
+        to.custom_thread_creation_options = session_options_.custom_thread_creation_options;
+        to.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+        arena_shrinker_ = std::make_unique<ArenaShrinker>(arena_shrink_config, std::move(arenas), to);
+      }
+    }
+
+    const std::string allocation_trace_file =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigAllocationTraceFile, "");
+    if (!allocation_trace_file.empty()) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(AllocationTraceRecorder::Create(allocation_trace_file,
+                                                                     allocation_trace_recorder_));
+      for (const auto& entry : session_state_->GetAllocators()) {
+        if (entry.second->Info().alloc_type == OrtArenaAllocator) {
+          static_cast<BFCArena*>(entry.second.get())->SetAllocationTraceRecorder(allocation_trace_recorder_.get());
+          traced_arenas_.push_back(entry.second);
+        }
+      }
+      LOGS(*session_logger_, INFO) << "Recording the allocations of " << traced_arenas_.size()
+                                   << " arena(s) into " << allocation_trace_file;
+    }
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+      ort_format_model_mapped_bytes_.reset();
     }
 
     // once the model is saved, we may remove unnecessary attributes for inference
@@ -1803,8 +2568,17 @@ common::Status InferenceSession::Initialize() {
     LOGS(*session_logger_, ERROR) << status.ErrorMessage();
   }
 
+  if (status.IsOK() &&
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingRoofline, "0") == "1") {
+    const MachinePeaks peaks = MeasureCpuPeaks(GetIntraOpThreadPoolToUse());
+    LOGS(*session_logger_, INFO) << "Measured CPU peaks for the roofline analysis: " << peaks.gflops_per_second
+                                 << " GFLOP/s, " << peaks.gbytes_per_second << " GB/s";
+    session_profiler_.EnableRoofline(peaks.gflops_per_second, peaks.gbytes_per_second);
+  }
+
   if (session_profiler_.IsEnabled()) {
-    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_initialization", tp);
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "session_initialization", tp,
+                                            {{"mlas_kernel_dispatch", GetMlasKernelDispatchJson()}});
   }
 
   if (status.IsOK()) {
@@ -1839,7 +2613,8 @@ const SessionOptions& InferenceSession::GetSessionOptions() const {
 }
 
 const DataTransferManager& InferenceSession::GetDataTransferManager() const {
-  return data_transfer_mgr_;
+  // a clone uses the data transfers of the session it was cloned from
+  return session_state_ != nullptr ? session_state_->GetDataTransferMgr() : data_transfer_mgr_;
 }
 
 common::Status InferenceSession::CheckShapes(const std::string& input_name, const TensorShape& input_shape,
@@ -2120,12 +2895,49 @@ struct ThreadPoolSpinningSwitch {
     }
   }
 };
+
+// Describes the shapes of the feeds, e.g. "input_ids:1,128;past:1,12,127,64;", so that an EP can keep one captured
+// graph per set of input shapes.
+std::string GetGraphCaptureKey(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds) {
+  std::string key;
+  for (size_t i = 0, end = std::min(feed_names.size(), feeds.size()); i < end; ++i) {
+    key.append(feed_names[i]).push_back(':');
+    if (feeds[i].IsTensor()) {
+      const auto dims = feeds[i].Get<Tensor>().Shape().GetDims();
+      for (size_t d = 0; d < dims.size(); ++d) {
+        if (d > 0) {
+          key.push_back(',');
+        }
+        key.append(std::to_string(dims[d]));
+      }
+    }
+    key.push_back(';');
+  }
+  return key;
+}
 }  // namespace
 
 Status InferenceSession::Run(const RunOptions& run_options,
                              gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
                              gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
                              const std::vector<OrtDevice>* p_fetches_device_info) {
+  const auto run_start = std::chrono::steady_clock::now();
+  Status status;
+  if (request_batcher_ != nullptr && p_fetches_device_info == nullptr && p_fetches != nullptr &&
+      request_batcher_->IsBatchable(feed_names, feeds, output_names, *p_fetches)) {
+    status = request_batcher_->Run(run_options, feed_names, feeds, output_names, *p_fetches);
+  } else {
+    status = RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info);
+  }
+  metrics_.RecordRun(std::chrono::steady_clock::now() - run_start, status.IsOK());
+  return status;
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options,
+                                 gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.Start();
@@ -2139,6 +2951,11 @@ Status InferenceSession::Run(const RunOptions& run_options,
   Status retval = Status::OK();
   const Env& env = Env::Default();
 
+  // Select the captured graph matching the input shapes of this run, for the EPs keeping one per set of shapes.
+  if (cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled()) {
+    cached_execution_provider_for_graph_replay_.SetGraphCaptureKey(GetGraphCaptureKey(feed_names, feeds));
+  }
+
   // Increment/decrement concurrent_num_runs_ and control
   // session threads spinning as configured. Do nothing for graph replay except the counter.
   const bool control_spinning = use_per_session_threads_ &&
@@ -2153,6 +2970,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
     LOGS(*session_logger_, INFO) << "Replaying the captured "
                                  << cached_execution_provider_for_graph_replay_.Type()
                                  << " CUDA Graph for this model with tag: " << run_options.run_tag;
+    metrics_.RecordGraphReplay();
     ORT_RETURN_IF_ERROR_SESSIONID_(cached_execution_provider_for_graph_replay_.ReplayGraph());
   } else {
     InlinedVector<IExecutionProvider*> exec_providers_to_stop;
@@ -2240,6 +3058,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
       DeviceStreamCollectionHolder device_stream_collection_holder(session_state_.get());
 #endif
 
+      const std::unordered_map<size_t, IExecutor::CustomAllocator> no_fetch_allocators;
       if (retval.IsOK()) {
         retval = utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
                                      session_options_.execution_mode,
@@ -2247,7 +3066,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
 #ifdef ORT_ENABLE_STREAM
                                      device_stream_collection_holder,
 #endif
-                                     run_logger);
+                                     run_logger,
+                                     p_fetch_allocators ? *p_fetch_allocators : no_fetch_allocators);
       }
 
       // info all execution providers InferenceSession:Run ended
@@ -2280,6 +3100,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
     if (!arenas_to_shrink.empty()) {
       ShrinkMemoryArenas(arenas_to_shrink);
     }
+
+    if (session_state_->LazyInitializersColdAfterRun()) {
+      session_state_->AdviseLazyInitializers(Env::MappedMemoryAdvice::kCold);
+    }
   }
 
   // keep track of telemetry
@@ -2291,6 +3115,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
     // send the telemetry
     env.GetTelemetryProvider().LogRuntimePerf(session_id_, telemetry_.total_runs_since_last_,
                                               telemetry_.total_run_duration_since_last_);
+    env.GetTelemetryProvider().LogSessionMetrics(session_id_, metrics_.ToJson(SampleMetricsGauges()));
     // reset counters
     telemetry_.time_sent_last_ = std::chrono::high_resolution_clock::now();
     telemetry_.total_runs_since_last_ = 0;
@@ -2315,7 +3140,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
   if (retval.IsOK() && cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
       !cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
     LOGS(*session_logger_, INFO) << "Start another run for necessary memory allocation or graph capture.";
-    ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
+    ORT_RETURN_IF_ERROR(RunImpl(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                                p_fetch_allocators));
   }
   return retval;
 }
@@ -2400,10 +3226,14 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
                                           void* user_data) {
   size_t num_fetches = fetch_names.size();
   auto* tp = GetIntraOpThreadPoolToUse();
-  if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "intra op thread pool must have at least one thread for RunAsync");
+  if (async_run_queue_ == nullptr && (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "intra op thread pool must have at least one thread for RunAsync, or dedicated threads "
+                           "must be configured with ", kOrtSessionOptionsConfigRunAsyncNumThreads);
   }
+  const auto submit_time = std::chrono::steady_clock::now();
   std::function<void()> run_fn = [=]() {
+    metrics_.RecordQueueTime(std::chrono::steady_clock::now() - submit_time);
     Status status = Status::OK();
     ORT_TRY {
       if (run_options) {
@@ -2423,6 +3253,13 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
     }
     callback(user_data, fetches.data(), status.IsOK() ? num_fetches : 0, ToOrtStatus(status));
   };  // run_fn
+
+  if (async_run_queue_ != nullptr) {
+    // the request waits in the queue rather than occupying an intra-op worker, and can use the complete intra-op
+    // thread pool once it executes.
+    return async_run_queue_->Submit(std::move(run_fn));
+  }
+
   concurrency::ThreadPool::Schedule(tp, run_fn);
   return Status::OK();
 }
@@ -2515,8 +3352,13 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  const auto& output_allocators = io_binding.GetOutputAllocators();
+  const auto run_start = std::chrono::steady_clock::now();
+  auto status = RunImpl(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+                        &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo(),
+                        output_allocators.empty() ? nullptr : &output_allocators);
+  metrics_.RecordRun(std::chrono::steady_clock::now() - run_start, status.IsOK());
+  return status;
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -2545,6 +3387,76 @@ void InferenceSession::StartProfiling(const logging::Logger* logger_ptr) {
   session_profiler_.StartProfiling(logger_ptr);
 }
 
+common::Status InferenceSession::GetAllocatorMetrics(std::string& metrics_json) const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session not initialized.");
+    }
+  }
+
+  std::ostringstream ss;
+  ss << "[";
+  bool first = true;
+  for (const auto& entry : session_state_->GetAllocators()) {
+    AllocatorMetrics metrics;
+    entry.second->GetMetrics(&metrics);
+    ss << (first ? "" : ",") << "{\"name\":\"" << entry.second->Info().name << "\",\"device\":\""
+       << entry.first.ToString() << "\",\"metrics\":" << metrics.ToJson() << "}";
+    first = false;
+  }
+  ss << "]";
+
+  metrics_json = ss.str();
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetMetrics(const std::string& format, std::string& metrics) const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    if (!is_inited_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session not initialized.");
+    }
+  }
+  if (format != "json" && format != "prometheus") {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unknown metrics format '", format,
+                           "'. Use 'json' or 'prometheus'.");
+  }
+
+  metrics = format == "json" ? metrics_.ToJson(SampleMetricsGauges()) : metrics_.ToPrometheus(SampleMetricsGauges());
+  return Status::OK();
+}
+
+SessionMetrics::Gauges InferenceSession::SampleMetricsGauges() const {
+  SessionMetrics::Gauges gauges;
+  gauges.session_id = session_id_;
+  gauges.concurrent_runs = current_num_runs_.load(std::memory_order_relaxed);
+  gauges.async_queue_length = async_run_queue_ != nullptr ? async_run_queue_->NumPending() : 0;
+  for (const auto& entry : session_state_->GetAllocators()) {
+    SessionMetrics::Gauges::Allocator allocator;
+    allocator.name = entry.second->Info().name;
+    allocator.device = entry.first.ToString();
+    entry.second->GetStats(&allocator.stats);
+    gauges.allocators.push_back(std::move(allocator));
+  }
+  concurrency::ThreadPool::GetBusyTime(GetIntraOpThreadPoolToUse(), gauges.intra_op_threads,
+                                       gauges.intra_op_busy_ns);
+  concurrency::ThreadPool::GetBusyTime(GetInterOpThreadPoolToUse(), gauges.inter_op_threads,
+                                       gauges.inter_op_busy_ns);
+  session_state_->GetMemoryPatternCacheStats(gauges.mem_pattern_cache_hits, gauges.mem_pattern_cache_misses);
+  return gauges;
+}
+
+common::Status InferenceSession::GetProfilingSummary(std::string& summary_json) {
+  if (!session_profiler_.IsEnabled() || !session_profiler_.IsSampling()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "The profiling summary is only available while profiling with sampling. See ",
+                           kOrtSessionOptionsConfigProfilingSampleRate, ".");
+  }
+  summary_json = session_profiler_.GetSummary();
+  return Status::OK();
+}
+
 std::string InferenceSession::EndProfiling() {
   if (is_model_loaded_) {
     if (session_profiler_.IsEnabled()) {
@@ -12,6 +12,7 @@
 #include "core/common/path_string.h"
 #include "core/common/profiler.h"
 #include "core/common/status.h"
+#include "core/framework/allocation_trace.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
@@ -24,7 +25,12 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include "core/framework/session_options.h"
+#include "core/session/arena_shrinker.h"
+#include "core/session/async_run_queue.h"
+#include "core/session/request_batcher.h"
+#include "core/session/session_metrics.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
@@ -300,6 +306,20 @@ class InferenceSession {
    */
   [[nodiscard]] common::Status Initialize();
 
+  /**
+   * Creates a session that runs the model of this initialized session without loading, optimizing, partitioning or
+   * pre-packing it again. The clone shares the graph, kernels, initializers, pre-packed weights, execution providers,
+   * allocators and thread pools of this session.
+   * The clone has its own logger, run statistics, profiler for the session level events, RunAsync threads and
+   * dynamic batching. Only the settings of session_options for those apply; the execution mode and the thread pools
+   * are those of this session.
+   * This session must outlive the clone.
+   * This API is thread-safe.
+   * @return OK if success
+   */
+  [[nodiscard]] common::Status Clone(const SessionOptions& session_options,
+                                     std::unique_ptr<InferenceSession>& clone) const;
+
   [[nodiscard]] common::Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
                                    gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
                                    std::vector<OrtValue>* p_fetches,
@@ -451,6 +471,29 @@ class InferenceSession {
     @return the name of the profile file.
     */
   std::string EndProfiling();
+
+  /**
+    * Collect the metrics of the allocators used by the session.
+    @param metrics_json Set to a JSON array with an object per allocator holding its name, device and metrics.
+           See AllocatorMetrics for the available metrics.
+    @return an error if the session is not initialized.
+    */
+  common::Status GetAllocatorMetrics(std::string& metrics_json) const;
+
+  /**
+    * Take a snapshot of the run counters of the session and of the usage of its arenas, thread pools and caches.
+    @param format "json" for a JSON object, or "prometheus" for the Prometheus text exposition format.
+    @param metrics Set to the snapshot. See SessionMetrics for the available metrics.
+    @return an error if the session is not initialized or the format is unknown.
+    */
+  common::Status GetMetrics(const std::string& format, std::string& metrics) const;
+
+  /**
+    * Get the summary of the events of the runs sampled by the profiler since the summary was last flushed.
+    @param summary_json Set to a JSON object with the statistics of each event, e.g. its count and p99 duration.
+    @return an error if the session isn't profiling with sampling.
+    */
+  common::Status GetProfilingSummary(std::string& summary_json);
   /**
     * Return the profiler to access its attributes
     @return the profiler object
@@ -482,6 +525,16 @@ class InferenceSession {
   }
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+   * Get the statistics collected for quantization calibration.
+   * @return nullptr if the "session.calibration.method" option isn't set or the session isn't initialized.
+   */
+  const CalibrationCollector* GetCalibrationCollector() const {
+    return calibration_collector_.get();
+  }
+#endif
+
   /**
    * Search registered execution providers for an allocator that has characteristics
    * specified within mem_info
@@ -560,6 +613,10 @@ class InferenceSession {
     }
   }
 
+  // The thread pool to compile the fused nodes of compiling EPs on during graph partitioning, or nullptr to compile
+  // them on the calling thread if "session.disable_parallel_compilation" is set.
+  onnxruntime::concurrency::ThreadPool* GetCompileThreadPoolToUse() const;
+
   /// convenience pointer to logger. should always be the same as session_state_.Logger();
   const logging::Logger* session_logger_;
 
@@ -596,6 +653,13 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const PathString& filepath) const;
+
+  // Loads the optimized model from the cache directory of kOrtSessionOptionsOptimizedModelCacheDir if it's there, or
+  // sets optimized_model_cache_file_ so Initialize saves the model there once it's optimized.
+  void LoadFromOptimizedModelCache();
+
+  // Saves the optimized model to optimized_model_cache_file_ and evicts the least recently used cached models.
+  void SaveToOptimizedModelCache();
 #endif
 
   /**
@@ -638,6 +702,44 @@ class InferenceSession {
 
   [[nodiscard]] common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms);
 
+  // Map the initializers and pre-packed weights in the files configured with "session.shared_weights_file",
+  // creating the initializers file if it does not exist. Called before the session state is finalized.
+  [[nodiscard]] common::Status AttachSharedWeights(const onnxruntime::Graph& graph);
+
+  // Share the initializers with the other sessions of the env by content if "session.share_initializers_by_content"
+  // is set. Called before the session state is finalized.
+  [[nodiscard]] common::Status AttachContentSharedInitializers(const onnxruntime::Graph& graph);
+
+  // Write the pre-packed weights to the file configured with "session.shared_weights_file" if it does not exist.
+  // Called after the session state is finalized.
+  void PublishSharedPrepackedWeights();
+
+  // Map the persistent cache of pre-packed weights in "session.prepacked_weights_cache_dir" for the model and host,
+  // or the pre-packed weights saved next to an ORT format model, see "session.save_prepacked_weights_with_ort_model".
+  // Called before the session state is finalized.
+  [[nodiscard]] common::Status AttachPrepackedWeightsCache(const onnxruntime::Graph& graph, bool saving_ort_format,
+                                                           bool loading_ort_format);
+
+  // Rewrite the persistent cache of pre-packed weights if weights had to be pre-packed.
+  // Called after the session state is finalized.
+  void PublishPrepackedWeightsCache();
+
+  // Sample the values of the metrics that are read from the session state rather than counted by metrics_.
+  SessionMetrics::Gauges SampleMetricsGauges() const;
+
+  // Create request_batcher_ and async_run_queue_ if they are configured. Called at the end of Initialize and Clone.
+  [[nodiscard]] common::Status CreateRunQueues();
+
+  // Execute a single Run call. Run() forwards to this directly, or via request_batcher_ when dynamic batching
+  // is enabled and the call can be merged with concurrent ones.
+  [[nodiscard]] common::Status RunImpl(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                                       gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                                       std::vector<OrtValue>* p_fetches,
+                                       const std::vector<OrtDevice>* p_fetches_device_info,
+                                       // optional allocators for fetches. key is index in fetches
+                                       const std::unordered_map<size_t, IExecutor::CustomAllocator>*
+                                           p_fetch_allocators = nullptr);
+
   template <typename T>
   void StartProfiling(const std::basic_string<T>& file_prefix);
 
@@ -691,15 +793,42 @@ class InferenceSession {
   MemoryProfiler memory_profiler_;
 #endif
 
-  // Immutable state for each op in the model. Shared by all executors.
+  // Container used to share pre-packed weights through "session.shared_weights_file" if the user did not provide
+  // one. Declared before session_state_ as the kernels reference the buffers it holds.
+  std::unique_ptr<PrepackedWeightsContainer> owned_prepacked_weights_container_;
+
+  // Persistent cache of pre-packed weights configured with "session.prepacked_weights_cache_dir" or saved next to
+  // an ORT format model. Declared before session_state_ as the kernels reference the buffers of its file.
+  std::unique_ptr<PrepackedWeightsCache> prepacked_weights_cache_;
+  PathString prepacked_weights_cache_path_;
+  // the weights pre-packed while loading an ORT format model are not written next to it
+  bool prepacked_weights_cache_read_only_{false};
+
+  // Initializers mapped from the file configured with "session.shared_weights_file".
+  // session_options_.initializers_to_share_map points to these values.
+  std::unordered_map<std::string, OrtValue> shared_weights_initializers_;
+
+  // Initializers shared by content with the other sessions of the env through "session.share_initializers_by_content".
+  // session_options_.initializers_to_share_map points to these values.
+  std::unordered_map<std::string, OrtValue> content_shared_initializers_;
+
+  // Immutable state for each op in the model. Shared by all executors, and by the clones of the session.
   // It has a dependency on execution_providers_.
-  std::unique_ptr<SessionState> session_state_;
+  std::shared_ptr<SessionState> session_state_;
 
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
   std::basic_string<ORTCHAR_T> thread_pool_name_;
   std::basic_string<ORTCHAR_T> inter_thread_pool_name_;
 
+  // File the measured costs of the parallel loops are saved to when the session is destroyed.
+  PathString parallel_for_calibration_file_;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Statistics of the tensors computed by the session for quantization calibration, if enabled.
+  std::unique_ptr<CalibrationCollector> calibration_collector_;
+#endif
+
   // This option allows to decrease CPU usage between infrequent
   // requests and forces any TP threads spinning stop immediately when the last of
   // concurrent ExecuteGraph() call returns.
@@ -818,8 +947,20 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // The mapped model file when an ORT format model is loaded from a path with "session.use_ort_model_bytes_directly"
+  // set to "1". ort_format_model_bytes_ points to it, and with "session.use_ort_model_bytes_for_initializers" the
+  // initializers do as well.
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
   bool using_ort_model_bytes_for_initializers_{false};
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // The hash of the ONNX model bytes when the optimized model cache is enabled, and the cache file to save the
+  // optimized model to when it isn't in the cache yet.
+  std::string optimized_model_cache_model_hash_;
+  PathString optimized_model_cache_file_;
+#endif
+
   // Container to store pre-packed weights to share between sessions.
   // The life-cycle of the cache itself is maintained by the user and the user will ensure
   // the cache is valid until any session reliant on it is still in scope.
@@ -846,6 +987,12 @@ class InferenceSession {
       return cached_execution_provider_for_graph_replay_ != nullptr && cached_execution_provider_for_graph_replay_->IsGraphCaptured();
     }
 
+    void SetGraphCaptureKey(const std::string& key) {
+      if (cached_execution_provider_for_graph_replay_) {
+        cached_execution_provider_for_graph_replay_->SetGraphCaptureKey(key);
+      }
+    }
+
     Status ReplayGraph() {
       ORT_ENFORCE(IsGraphCaptured());
       if (cached_execution_provider_for_graph_replay_) {
@@ -862,6 +1009,27 @@ class InferenceSession {
   };
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
+
+  // Merges concurrent Run calls into batched executions.
+  // Set during Initialize() if "session.dynamic_batching.max_batch_size" is configured.
+  std::unique_ptr<RequestBatcher> request_batcher_;
+
+  // Executes RunAsync requests on threads owned by the session instead of the intra-op thread pool.
+  // Set during Initialize() if "session.run_async.num_threads" is configured. Reset at the start of the destructor
+  // so that pending requests are drained while the rest of the session is still alive.
+  std::unique_ptr<AsyncRunQueue> async_run_queue_;
+
+  // Releases unused memory of the arenas of the session on a background thread.
+  // Set during Initialize() if "session.arena_shrink.interval_ms" is configured. Reset at the start of the destructor
+  // so that it doesn't access the arenas while they are being destroyed.
+  std::unique_ptr<ArenaShrinker> arena_shrinker_;
+
+  // Always on counters of the runs of the session, exported by GetMetrics.
+  SessionMetrics metrics_;
+
+  // records the events of the arenas in traced_arenas_ if "session.allocation_trace_file" is set
+  std::unique_ptr<AllocationTraceRecorder> allocation_trace_recorder_;
+  std::vector<AllocatorPtr> traced_arenas_;
 };
 
 struct SessionIOBinding {
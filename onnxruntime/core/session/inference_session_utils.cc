@@ -5,6 +5,11 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <filesystem>
+#include <fstream>
+
+#include "core/platform/env.h"
+
 namespace onnxruntime {
 
 //---------------------
@@ -110,6 +115,11 @@ void from_json(const json& j, TuningResults& trs) {
   j.at("validators").get_to(trs.validators);
 }
 
+// This function is called by nlohmann/json
+void to_json(json& j, const TuningResults& trs) {
+  j = json{{"ep", trs.ep}, {"results", trs.results}, {"validators", trs.validators}};
+}
+
 //---------------------------------------------------
 //--- end of session options related helpers ---
 //---------------------------------------------------
@@ -264,6 +274,74 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
   return Status::OK();
 }
 
+Status LoadTuningResultsFile(const PathString& path, std::vector<TuningResults>& results) {
+  results.clear();
+  std::ifstream file(path);
+  if (!file) {
+    return Status::OK();
+  }
+
+  Status status;
+  ORT_TRY {
+    results = json::parse(file).get<std::vector<TuningResults>>();
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Tuning results file ", PathToUTF8String(path),
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+  return status;
+}
+
+Status MergeIntoTuningResultsFile(const PathString& path, const std::vector<TuningResults>& results) {
+  // read the file again right before replacing it, to keep the results other processes merged in the meantime
+  std::vector<TuningResults> merged;
+  ORT_RETURN_IF_ERROR(LoadTuningResultsFile(path, merged));
+
+  for (const auto& tr : results) {
+    auto it = std::find_if(merged.begin(), merged.end(), [&tr](const TuningResults& existing) {
+      return existing.ep == tr.ep && existing.validators == tr.validators;
+    });
+    if (it == merged.end()) {
+      merged.push_back(tr);
+      continue;
+    }
+
+    for (const auto& [op_signature, kernel_map] : tr.results) {
+      auto& merged_kernel_map = it->results[op_signature];
+      for (const auto& [params_signature, kernel_id] : kernel_map) {
+        merged_kernel_map.emplace(params_signature, kernel_id);
+      }
+    }
+  }
+
+  // write a file next to the destination and rename it, so that readers never see a partially written file
+  const std::filesystem::path destination{path};
+  std::filesystem::path temporary{destination};
+  temporary += ORT_TSTR(".tmp") + ToPathString(std::to_string(Env::Default().GetSelfPid()));
+
+  Status status;
+  ORT_TRY {
+    {
+      std::ofstream file(temporary, std::ios::trunc);
+      ORT_RETURN_IF_NOT(file, "Failed to open ", temporary.string(), " for writing");
+      file << json(merged).dump(2);
+      ORT_RETURN_IF_NOT(file.good(), "Failed to write tuning results to ", temporary.string());
+    }
+    std::filesystem::rename(temporary, destination);
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      std::error_code ec;
+      std::filesystem::remove(temporary, ec);
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to replace tuning results file ", PathToUTF8String(path),
+                               ". Error message: ", e.what());
+    });
+  }
+  return status;
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
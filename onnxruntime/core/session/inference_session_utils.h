@@ -62,6 +62,13 @@ Status ParseTuningResultsFromModelMetadata(const onnxruntime::ModelMetadata& met
                                            /*out*/ std::vector<TuningResults>& results,
                                            /*out*/ bool& key_found);
 
+// Load the TuningResults stored in a tuning results file. A file that doesn't exist holds no results.
+Status LoadTuningResultsFile(const PathString& path, /*out*/ std::vector<TuningResults>& results);
+
+// Merge `results` into the TuningResults of a tuning results file and atomically replace the file. The results of
+// an entry of the file with the same EP and validators are kept when both have a kernel for the same params.
+Status MergeIntoTuningResultsFile(const PathString& path, const std::vector<TuningResults>& results);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -1364,6 +1364,52 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromSession, _In_ const OrtSession* sess,
+                    _In_ const OrtSessionOptions* options, _Outptr_ OrtSession** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::unique_ptr<onnxruntime::InferenceSession> clone;
+  *out = nullptr;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->Clone(options == nullptr ? onnxruntime::SessionOptions() : options->value,
+                                                 clone));
+  *out = reinterpret_cast<OrtSession*>(clone.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetAllocatorMetrics, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string metrics;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetAllocatorMetrics(metrics));
+  *out = StrDup(metrics, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetProfilingSummary, _In_ OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto* session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::string summary;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetProfilingSummary(summary));
+  *out = StrDup(summary, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetMetrics, _In_ const OrtSession* sess, _In_ const char* format,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  const auto* session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string metrics;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetMetrics(format, metrics));
+  *out = StrDup(metrics, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2230,6 +2276,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "max_power_of_two_extend_bytes") == 0) {
       cfg->max_power_of_two_extend_bytes = static_cast<int64_t>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "thread_cache_max_bytes") == 0) {
+      cfg->thread_cache_max_bytes = arena_config_values[i];
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2324,6 +2372,15 @@ ORT_API_STATUS_IMPL(OrtApis::SessionOptionsSetCustomCreateThreadFn, _Inout_ OrtS
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionOptionsSetIntraOpCustomScheduler, _Inout_ OrtSessionOptions* options,
+                    _In_ const OrtCustomScheduler* scheduler) {
+  API_IMPL_BEGIN
+  ORT_API_RETURN_IF_STATUS_NOT_OK(onnxruntime::concurrency::ValidateCustomScheduler(scheduler));
+  options->value.intra_op_param.custom_scheduler = *scheduler;
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionOptionsSetCustomThreadCreationOptions, _Inout_ OrtSessionOptions* options, _In_ void* ort_custom_thread_creation_options) {
   API_IMPL_BEGIN
   options->value.custom_thread_creation_options = ort_custom_thread_creation_options;
@@ -2715,6 +2772,13 @@ static constexpr OrtApi ort_api_1_to_16 = {
     // End of Version 16 - DO NOT MODIFY ABOVE (see above text for more information)
 
     &OrtApis::SessionOptionsAppendExecutionProvider_Hailo,
+    &OrtApis::SessionGetAllocatorMetrics,
+    &OrtApis::SetGlobalIntraOpPerformanceCoresOnly,
+    &OrtApis::SetGlobalIntraOpCustomScheduler,
+    &OrtApis::SessionOptionsSetIntraOpCustomScheduler,
+    &OrtApis::CreateSessionFromSession,
+    &OrtApis::SessionGetProfilingSummary,
+    &OrtApis::SessionGetMetrics,
 };
 
 // OrtApiBase can never change as there is no way to know what version of OrtApiBase is returned by OrtGetApiBase.
@@ -0,0 +1,264 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include "core/session/optimized_model_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/narrow.h"
+#include "core/framework/murmurhash3.h"
+#include "core/platform/env.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+namespace optimized_model_cache {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kCacheFileExtension = ".ort";
+constexpr const char* kTempFileExtension = ".tmp";
+
+// the length of the hex hash that names a cache file
+constexpr size_t kCacheFileStemLength = 32;
+
+// temporary files older than this are left by writers that didn't finish
+constexpr auto kStaleTempFileAge = std::chrono::hours(1);
+
+// the model bytes are hashed in chunks, as MurmurHash3 takes an int length
+constexpr size_t kHashChunkSize = size_t{1} << 24;
+
+// Hashes the hashes of the chunks of the bytes, which gives the same hash whether they're hashed at once or not.
+class ChunkedHasher {
+ public:
+  void AddChunk(const void* data, size_t size) {
+    uint32_t hash[4] = {0, 0, 0, 0};
+    MurmurHash3::x86_128(data, narrow<int>(size), 0, &hash);
+    chunk_hashes_.insert(chunk_hashes_.end(), std::begin(hash), std::end(hash));
+  }
+
+  std::string Finish() const {
+    uint32_t hash[4] = {0, 0, 0, 0};
+    MurmurHash3::x86_128(chunk_hashes_.data(), narrow<int>(chunk_hashes_.size() * sizeof(uint32_t)), 0, &hash);
+    return ToHex(hash);
+  }
+
+  static std::string ToHex(const uint32_t (&hash)[4]) {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint32_t h : hash) {
+      ss << std::setw(8) << h;
+    }
+    return ss.str();
+  }
+
+ private:
+  std::vector<uint32_t> chunk_hashes_;
+};
+
+bool IsCacheFileName(const fs::path& path) {
+  return path.extension() == kCacheFileExtension && path.stem().native().size() == kCacheFileStemLength;
+}
+
+bool IsTempFileName(const fs::path& path) {
+  return path.extension() == kTempFileExtension && IsCacheFileName(path.stem().stem());
+}
+
+}  // namespace
+
+std::string HashModelBytes(const void* data, size_t size) {
+  ChunkedHasher hasher;
+  const auto* bytes = static_cast<const char*>(data);
+  for (size_t offset = 0; offset == 0 || offset < size; offset += kHashChunkSize) {
+    hasher.AddChunk(bytes + offset, std::min(kHashChunkSize, size - offset));
+  }
+  return hasher.Finish();
+}
+
+Status HashModelFile(const PathString& model_uri, std::string& hash) {
+  std::ifstream stream(model_uri, std::ifstream::in | std::ifstream::binary);
+  ORT_RETURN_IF_NOT(stream, "Failed to open model file ", ToUTF8String(model_uri), " to hash it.");
+
+  ChunkedHasher hasher;
+  std::vector<char> chunk(kHashChunkSize);
+  for (size_t num_chunks = 0;; ++num_chunks) {
+    stream.read(chunk.data(), narrow<std::streamsize>(chunk.size()));
+    const auto chunk_size = narrow<size_t>(stream.gcount());
+    // like HashModelBytes, an empty model is one empty chunk and a full last chunk isn't followed by an empty one
+    if (chunk_size > 0 || num_chunks == 0) {
+      hasher.AddChunk(chunk.data(), chunk_size);
+    }
+    if (!stream) {
+      break;
+    }
+  }
+  ORT_RETURN_IF_NOT(stream.eof(), "Failed to read model file ", ToUTF8String(model_uri), " to hash it.");
+
+  hash = hasher.Finish();
+  return Status::OK();
+}
+
+bool IsSupportedExecutionProvider(const std::string& provider_type) {
+  return provider_type == kCpuExecutionProvider || provider_type == kCudaExecutionProvider ||
+         provider_type == kRocmExecutionProvider;
+}
+
+PathString GetCacheFilePath(const PathString& cache_dir, const std::string& model_hash,
+                            const SessionOptions& session_options, const ExecutionProviders& execution_providers,
+                            const InlinedHashSet<std::string>& optimizers_to_disable) {
+  // everything that changes the optimized graph, in a stable order
+  std::ostringstream ss;
+  ss << ORT_VERSION << ";" << sizeof(void*) << ";" << model_hash << ";"
+     << static_cast<int>(session_options.graph_optimization_level) << ";";
+
+  // the graph optimizations depend on the instruction sets, like the block size of the NCHWc layout
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  for (bool feature : {cpuid_info.HasSSE3(), cpuid_info.HasSSE4_1(), cpuid_info.HasAVX(), cpuid_info.HasAVX2(),
+                       cpuid_info.HasAVX512f(), cpuid_info.HasAVX512Skylake(), cpuid_info.HasAVX512_BF16(),
+                       cpuid_info.HasAMX_BF16(), cpuid_info.HasF16C(), cpuid_info.HasArmNeonDot(),
+                       cpuid_info.HasFp16VectorAcceleration()}) {
+    ss << (feature ? '1' : '0');
+  }
+
+  for (const auto& ep : execution_providers) {
+    ss << ";ep:" << ep->Type();
+    const auto provider_options = ep->GetProviderOptions();
+    for (const auto& option : std::map<std::string, std::string>(provider_options.begin(), provider_options.end())) {
+      ss << "," << option.first << "=" << option.second;
+    }
+  }
+
+  const auto& configurations = session_options.config_options.configurations;
+  for (const auto& config : std::map<std::string, std::string>(configurations.begin(), configurations.end())) {
+    // the cache options don't change the optimized graph
+    if (config.first != kOrtSessionOptionsOptimizedModelCacheDir &&
+        config.first != kOrtSessionOptionsOptimizedModelCacheMaxSizeInBytes) {
+      ss << ";config:" << config.first << "=" << config.second;
+    }
+  }
+
+  std::vector<std::string> disabled(optimizers_to_disable.begin(), optimizers_to_disable.end());
+  std::sort(disabled.begin(), disabled.end());
+  for (const auto& optimizer : disabled) {
+    ss << ";disabled:" << optimizer;
+  }
+
+  for (const auto& dim_override : session_options.free_dimension_overrides) {
+    ss << ";dim:" << static_cast<int>(dim_override.dim_identifer_type) << ":" << dim_override.dim_identifier << "="
+       << dim_override.dim_value;
+  }
+
+  const std::string key = ss.str();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(key.data(), narrow<int>(key.size()), 0, &hash);
+  return (fs::path(cache_dir) / (ChunkedHasher::ToHex(hash) + kCacheFileExtension)).native();
+}
+
+bool CacheFileExists(const PathString& cache_file) {
+  std::error_code ec;
+  return fs::is_regular_file(cache_file, ec);
+}
+
+void TouchCacheFile(const PathString& cache_file) {
+  std::error_code ec;
+  fs::last_write_time(cache_file, fs::file_time_type::clock::now(), ec);
+}
+
+Status WriteCacheFile(const PathString& cache_file, uint32_t writer_id,
+                      const std::function<Status(const PathString&)>& write_file) {
+  const fs::path path(cache_file);
+  std::error_code ec;
+  fs::create_directories(path.parent_path(), ec);
+  ORT_RETURN_IF(ec, "Failed to create the optimized model cache directory: ", ec.message());
+
+  // the writers of the same file are told apart by their process and their session
+  const fs::path temp_path = path.native() + ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + "_" +
+                                                          std::to_string(writer_id) + kTempFileExtension);
+  Status status = write_file(temp_path.native());
+  if (status.IsOK()) {
+    // replaces the file of another writer, which has the same contents
+    fs::rename(temp_path, path, ec);
+    if (ec) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename the optimized model cache file: ", ec.message());
+    }
+  }
+
+  if (!status.IsOK()) {
+    fs::remove(temp_path, ec);
+  }
+  return status;
+}
+
+void EvictCacheFiles(const PathString& cache_dir, uint64_t max_size, const PathString& keep_file,
+                     const logging::Logger& logger) {
+  struct CacheFile {
+    fs::path path;
+    uint64_t size;
+    fs::file_time_type last_used;
+  };
+
+  std::vector<CacheFile> files;
+  uint64_t total_size = 0;
+  const auto now = fs::file_time_type::clock::now();
+  std::error_code ec;
+  for (fs::directory_iterator it(cache_dir, ec), end; !ec && it != end; it.increment(ec)) {
+    const fs::path& path = it->path();
+    std::error_code file_ec;
+    const auto last_used = fs::last_write_time(path, file_ec);
+    if (file_ec) {
+      continue;
+    }
+
+    if (IsTempFileName(path.filename())) {
+      if (now - last_used > kStaleTempFileAge) {
+        fs::remove(path, file_ec);
+      }
+    } else if (IsCacheFileName(path.filename())) {
+      const uint64_t size = fs::file_size(path, file_ec);
+      if (!file_ec) {
+        total_size += size;
+        if (path != fs::path(keep_file)) {
+          files.push_back({path, size, last_used});
+        }
+      }
+    }
+  }
+
+  if (ec) {
+    LOGS(logger, WARNING) << "Failed to list the optimized model cache directory " << ToUTF8String(cache_dir)
+                          << ": " << ec.message();
+    return;
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const CacheFile& a, const CacheFile& b) { return a.last_used < b.last_used; });
+  for (const CacheFile& file : files) {
+    if (total_size <= max_size) {
+      break;
+    }
+
+    // another session may have removed it or be reading it, which is fine as it was opened before
+    std::error_code file_ec;
+    if (fs::remove(file.path, file_ec) || !file_ec) {
+      total_size -= file.size;
+      LOGS(logger, INFO) << "Evicted " << ToUTF8String(file.path.native()) << " from the optimized model cache.";
+    }
+  }
+}
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <functional>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/common/path_string.h"
+#include "core/framework/execution_providers.h"
+#include "core/framework/session_options.h"
+
+namespace onnxruntime {
+
+// The cache of optimized models enabled by the kOrtSessionOptionsOptimizedModelCacheDir session config option.
+// Each ORT format model in the directory is named after a hash of the ONNX model bytes and of everything in the
+// session configuration that changes the optimized graph.
+namespace optimized_model_cache {
+
+// Returns the hash of the bytes of an ONNX model as a hex string.
+std::string HashModelBytes(const void* data, size_t size);
+
+// Returns the hash of the bytes of an ONNX model file as a hex string.
+Status HashModelFile(const PathString& model_uri, std::string& hash);
+
+// Whether the optimized models of the EP can be cached. EPs that compile nodes can't be saved in an ORT format model
+// in a way that makes the session that saves it usable.
+bool IsSupportedExecutionProvider(const std::string& provider_type);
+
+// Returns the path of the cache file of the model with the given hash, optimized with the given configuration.
+PathString GetCacheFilePath(const PathString& cache_dir, const std::string& model_hash,
+                            const SessionOptions& session_options, const ExecutionProviders& execution_providers,
+                            const InlinedHashSet<std::string>& optimizers_to_disable);
+
+// Whether the cache file exists.
+bool CacheFileExists(const PathString& cache_file);
+
+// Marks the cache file as used now, so it is evicted after the files that were used earlier.
+void TouchCacheFile(const PathString& cache_file);
+
+// Creates the cache file by calling write_file with a temporary file in the cache directory and renaming it.
+// Concurrent writers of the same file each write their own temporary file, and readers never see a partial file.
+Status WriteCacheFile(const PathString& cache_file, uint32_t writer_id,
+                      const std::function<Status(const PathString&)>& write_file);
+
+// Removes the least recently used cache files of the directory until the others take at most max_size bytes.
+// keep_file is never removed. Temporary files left by writers that didn't finish are removed as well.
+void EvictCacheFiles(const PathString& cache_dir, uint64_t max_size, const PathString& keep_file,
+                     const logging::Logger& logger);
+
+}  // namespace optimized_model_cache
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
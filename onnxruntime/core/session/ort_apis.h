@@ -494,4 +494,18 @@ ORT_API_STATUS_IMPL(GetTensorRTProviderOptionsByName, _In_ const OrtTensorRTProv
 ORT_API_STATUS_IMPL(UpdateCUDAProviderOptionsWithValue, _Inout_ OrtCUDAProviderOptionsV2* cuda_options, _In_ const char* key, _In_ void* value);
 ORT_API_STATUS_IMPL(GetCUDAProviderOptionsByName, _In_ const OrtCUDAProviderOptionsV2* cuda_options, _In_ const char* key, _Outptr_ void** ptr);
 ORT_API_STATUS_IMPL(KernelContext_GetResource, _In_ const OrtKernelContext* context, _In_ int resource_version, _In_ int resource_id, _Outptr_ void** stream);
+
+ORT_API_STATUS_IMPL(SessionGetAllocatorMetrics, _In_ const OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(SetGlobalIntraOpPerformanceCoresOnly, _Inout_ OrtThreadingOptions* tp_options);
+ORT_API_STATUS_IMPL(SetGlobalIntraOpCustomScheduler, _Inout_ OrtThreadingOptions* tp_options,
+                    _In_ const OrtCustomScheduler* scheduler);
+ORT_API_STATUS_IMPL(SessionOptionsSetIntraOpCustomScheduler, _Inout_ OrtSessionOptions* options,
+                    _In_ const OrtCustomScheduler* scheduler);
+ORT_API_STATUS_IMPL(CreateSessionFromSession, _In_ const OrtSession* session, _In_ const OrtSessionOptions* options,
+                    _Outptr_ OrtSession** out);
+ORT_API_STATUS_IMPL(SessionGetProfilingSummary, _In_ OrtSession* sess, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(SessionGetMetrics, _In_ const OrtSession* sess, _In_ const char* format,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out);
 }  // namespace OrtApis
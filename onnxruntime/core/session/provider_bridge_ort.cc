@@ -1336,6 +1336,12 @@ OrtCUDAProviderOptionsV2 OrtCUDAProviderOptionsToOrtCUDAProviderOptionsV2(const
   cuda_options_converted.enable_cuda_graph = 0;
   cuda_options_converted.cudnn_conv1d_pad_to_nc1d = 0;
   cuda_options_converted.enable_skip_layer_norm_strict_mode = 0;
+  cuda_options_converted.pinned_staging_pool_max_bytes = 0;
+  cuda_options_converted.enable_cross_stream_buffer_reuse = 0;
+  cuda_options_converted.cuda_graph_max_captures = 0;
+  cuda_options_converted.use_cuda_mem_pool = 0;
+  cuda_options_converted.cuda_mem_pool_release_threshold = std::numeric_limits<size_t>::max();
+  cuda_options_converted.enable_profiling_kernel_metrics = 0;
 
   return cuda_options_converted;
 }
@@ -1409,6 +1415,8 @@ OrtTensorRTProviderOptionsV2 OrtTensorRTProviderOptionsToOrtTensorRTProviderOpti
   trt_options_converted.trt_profile_max_shapes = "";
   trt_options_converted.trt_profile_opt_shapes = "";
   trt_options_converted.trt_cuda_graph_enable = 0;
+  trt_options_converted.trt_profile_shapes_trace = "";
+  trt_options_converted.trt_num_auto_profiles = 3;
 
   return trt_options_converted;
 }
@@ -1820,6 +1828,8 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorRTProviderOptions, _Outptr_ OrtTensorRT
   options->trt_profile_max_shapes = nullptr;
   options->trt_profile_opt_shapes = nullptr;
   options->trt_cuda_graph_enable = false;
+  options->trt_profile_shapes_trace = nullptr;
+  options->trt_num_auto_profiles = 3;
   *out = options.release();
   return nullptr;
 #else
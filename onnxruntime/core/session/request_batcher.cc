@@ -0,0 +1,308 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/request_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Copy `num_elements` elements from `src` starting at element `src_offset` to `dst` starting at element
+// `dst_offset`. Both tensors must have the same element type.
+void CopyElements(const Tensor& src, size_t src_offset, Tensor& dst, size_t dst_offset, size_t num_elements) {
+  if (src.IsDataTypeString()) {
+    const auto* src_data = src.Data<std::string>() + src_offset;
+    auto* dst_data = dst.MutableData<std::string>() + dst_offset;
+    std::copy(src_data, src_data + num_elements, dst_data);
+  } else {
+    const size_t element_size = src.DataType()->Size();
+    memcpy(static_cast<uint8_t*>(dst.MutableDataRaw()) + dst_offset * element_size,
+           static_cast<const uint8_t*>(src.DataRaw()) + src_offset * element_size,
+           num_elements * element_size);
+  }
+}
+
+TensorShape WithBatchSize(const TensorShape& shape, size_t batch_axis, int64_t batch_size) {
+  TensorShape result(shape);
+  result[batch_axis] = batch_size;
+  return result;
+}
+
+}  // namespace
+
+RequestBatcher::RequestBatcher(const Config& config, AllocatorPtr cpu_allocator, ExecuteFn execute_fn)
+    : config_(config), cpu_allocator_(std::move(cpu_allocator)), execute_fn_(std::move(execute_fn)) {
+  ORT_ENFORCE(cpu_allocator_ != nullptr, "RequestBatcher requires a CPU allocator.");
+  ORT_ENFORCE(execute_fn_, "RequestBatcher requires an execute function.");
+}
+
+Status RequestBatcher::ParseConfig(const std::string& max_batch_size, const std::string& max_wait_us,
+                                   const std::string& batch_axis, Config& config, bool& enabled) {
+  enabled = false;
+  if (max_batch_size.empty()) {
+    return Status::OK();
+  }
+
+  Config parsed;
+  ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(max_batch_size, parsed.max_batch_size));
+
+  int64_t wait_us = parsed.max_wait.count();
+  if (!max_wait_us.empty()) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(max_wait_us, wait_us));
+    ORT_RETURN_IF_NOT(wait_us >= 0, "Dynamic batching max wait must not be negative. Got ", wait_us);
+  }
+  parsed.max_wait = std::chrono::microseconds(wait_us);
+
+  if (!batch_axis.empty()) {
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(batch_axis, parsed.batch_axis));
+  }
+
+  if (parsed.max_batch_size > 1) {
+    config = parsed;
+    enabled = true;
+  }
+
+  return Status::OK();
+}
+
+bool RequestBatcher::IsBatchable(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const std::string> output_names,
+                                 const std::vector<OrtValue>& fetches) const {
+  if (feeds.empty() || feed_names.size() != feeds.size() || output_names.empty()) {
+    return false;
+  }
+
+  // pre-allocated fetches point to user memory we can't write a slice of the batched output into
+  if (std::any_of(fetches.cbegin(), fetches.cend(), [](const OrtValue& fetch) { return fetch.IsAllocated(); })) {
+    return false;
+  }
+
+  int64_t batch_size = -1;
+  for (const auto& feed : feeds) {
+    if (!feed.IsTensor()) {
+      return false;
+    }
+
+    const auto& tensor = feed.Get<Tensor>();
+    if (tensor.Location().device.Type() != OrtDevice::CPU) {
+      return false;
+    }
+
+    const auto& shape = tensor.Shape();
+    if (shape.NumDimensions() <= config_.batch_axis) {
+      return false;
+    }
+
+    const int64_t feed_batch_size = shape[config_.batch_axis];
+    if (batch_size == -1) {
+      batch_size = feed_batch_size;
+    } else if (batch_size != feed_batch_size) {
+      return false;
+    }
+  }
+
+  return batch_size > 0 && batch_size < config_.max_batch_size;
+}
+
+void RequestBatcher::InitializeSignature(Batch& batch, const Request& request) const {
+  batch.feed_names.assign(request.feed_names.begin(), request.feed_names.end());
+  batch.output_names.assign(request.output_names.begin(), request.output_names.end());
+  batch.feed_types.reserve(request.feeds.size());
+  batch.feed_shapes.reserve(request.feeds.size());
+  for (const auto& feed : request.feeds) {
+    const auto& tensor = feed.Get<Tensor>();
+    batch.feed_types.push_back(tensor.DataType());
+    batch.feed_shapes.push_back(WithBatchSize(tensor.Shape(), config_.batch_axis, 0));
+  }
+}
+
+bool RequestBatcher::Matches(const Batch& batch, const Request& request) const {
+  if (batch.closed ||
+      !std::equal(batch.feed_names.cbegin(), batch.feed_names.cend(),
+                  request.feed_names.begin(), request.feed_names.end()) ||
+      !std::equal(batch.output_names.cbegin(), batch.output_names.cend(),
+                  request.output_names.begin(), request.output_names.end())) {
+    return false;
+  }
+
+  for (size_t i = 0, end = request.feeds.size(); i < end; ++i) {
+    const auto& tensor = request.feeds[i].Get<Tensor>();
+    const auto& shape = tensor.Shape();
+    const auto& expected_shape = batch.feed_shapes[i];
+    if (tensor.DataType() != batch.feed_types[i] || shape.NumDimensions() != expected_shape.NumDimensions()) {
+      return false;
+    }
+
+    for (size_t dim = 0, num_dims = shape.NumDimensions(); dim < num_dims; ++dim) {
+      if (dim != config_.batch_axis && shape[dim] != expected_shape[dim]) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+Status RequestBatcher::Run(const RunOptions& run_options, gsl::span<const std::string> feed_names,
+                           gsl::span<const OrtValue> feeds, gsl::span<const std::string> output_names,
+                           std::vector<OrtValue>& fetches) {
+  Request request{feed_names, feeds, output_names, &fetches,
+                  feeds[0].Get<Tensor>().Shape()[config_.batch_axis], Status::OK()};
+
+  std::shared_ptr<Batch> batch;
+  {
+    std::unique_lock<OrtMutex> lock(mutex_);
+
+    for (const auto& candidate : open_batches_) {
+      if (candidate->total_batch_size + request.batch_size <= config_.max_batch_size &&
+          Matches(*candidate, request)) {
+        batch = candidate;
+        break;
+      }
+    }
+
+    if (batch) {
+      // follower. the leader executes the batch on our behalf.
+      batch->requests.push_back(&request);
+      batch->total_batch_size += request.batch_size;
+      if (batch->total_batch_size >= config_.max_batch_size) {
+        batch->cv.notify_all();
+      }
+
+      batch->cv.wait(lock, [&batch]() { return batch->completed; });
+      return request.status;
+    }
+
+    // leader. wait for the batch to fill up or for the wait budget to run out.
+    batch = std::make_shared<Batch>();
+    InitializeSignature(*batch, request);
+    batch->requests.push_back(&request);
+    batch->total_batch_size = request.batch_size;
+    open_batches_.push_back(batch);
+
+    const auto deadline = std::chrono::steady_clock::now() + config_.max_wait;
+    while (batch->total_batch_size < config_.max_batch_size) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        break;
+      }
+
+      batch->cv.wait_for(lock, deadline - now);
+    }
+
+    batch->closed = true;
+    open_batches_.erase(std::find(open_batches_.begin(), open_batches_.end(), batch));
+  }
+
+  // the batch is closed so no other thread modifies it until we mark it as completed
+  Status status;
+  ORT_TRY {
+    status = ExecuteBatch(run_options, *batch);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "Exception during batched execution: ", ex.what());
+    });
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (!status.IsOK()) {
+      for (auto* batched_request : batch->requests) {
+        batched_request->status = status;
+      }
+    }
+
+    batch->completed = true;
+  }
+
+  batch->cv.notify_all();
+  return request.status;
+}
+
+Status RequestBatcher::ExecuteBatch(const RunOptions& run_options, Batch& batch) const {
+  if (batch.requests.size() == 1) {
+    // nothing to merge so run the request as is
+    auto& request = *batch.requests.front();
+    request.status = execute_fn_(run_options, request.feed_names, request.feeds, request.output_names,
+                                 request.fetches);
+    return request.status;
+  }
+
+  const size_t batch_axis = config_.batch_axis;
+  const int64_t total_batch_size = batch.total_batch_size;
+
+  std::vector<OrtValue> batched_feeds(batch.feed_names.size());
+  for (size_t i = 0, num_feeds = batched_feeds.size(); i < num_feeds; ++i) {
+    const TensorShape shape = WithBatchSize(batch.feed_shapes[i], batch_axis, total_batch_size);
+    Tensor::InitOrtValue(batch.feed_types[i], shape, cpu_allocator_, batched_feeds[i]);
+    auto& dst = *batched_feeds[i].GetMutable<Tensor>();
+
+    const auto outer = narrow<size_t>(shape.SizeToDimension(batch_axis));
+    const auto inner = narrow<size_t>(shape.SizeFromDimension(batch_axis + 1));
+    const auto dst_stride = narrow<size_t>(total_batch_size) * inner;
+
+    size_t batch_offset = 0;
+    for (const auto* request : batch.requests) {
+      const auto& src = request->feeds[i].Get<Tensor>();
+      const size_t block_size = narrow<size_t>(request->batch_size) * inner;
+      for (size_t o = 0; o < outer; ++o) {
+        CopyElements(src, o * block_size, dst, o * dst_stride + batch_offset * inner, block_size);
+      }
+
+      batch_offset += narrow<size_t>(request->batch_size);
+    }
+  }
+
+  std::vector<OrtValue> batched_fetches;
+  ORT_RETURN_IF_ERROR(execute_fn_(run_options, batch.feed_names, batched_feeds, batch.output_names,
+                                  &batched_fetches));
+
+  for (auto* request : batch.requests) {
+    request->fetches->clear();
+    request->fetches->resize(batch.output_names.size());
+  }
+
+  for (size_t i = 0, num_fetches = batched_fetches.size(); i < num_fetches; ++i) {
+    const auto& fetch = batched_fetches[i];
+    ORT_RETURN_IF_NOT(fetch.IsTensor() && fetch.Get<Tensor>().Location().device.Type() == OrtDevice::CPU,
+                      "Dynamic batching requires all outputs to be CPU tensors. Output '",
+                      batch.output_names[i], "' is not.");
+
+    const auto& src = fetch.Get<Tensor>();
+    const auto& shape = src.Shape();
+    ORT_RETURN_IF_NOT(shape.NumDimensions() > batch_axis && shape[batch_axis] == total_batch_size,
+                      "Dynamic batching requires all outputs to have the batch axis. Output '",
+                      batch.output_names[i], "' has shape ", shape, " for a batch of ", total_batch_size, ".");
+
+    const auto outer = narrow<size_t>(shape.SizeToDimension(batch_axis));
+    const auto inner = narrow<size_t>(shape.SizeFromDimension(batch_axis + 1));
+    const auto src_stride = narrow<size_t>(total_batch_size) * inner;
+
+    size_t batch_offset = 0;
+    for (auto* request : batch.requests) {
+      auto& request_fetch = (*request->fetches)[i];
+      Tensor::InitOrtValue(src.DataType(), WithBatchSize(shape, batch_axis, request->batch_size), cpu_allocator_,
+                           request_fetch);
+      auto& dst = *request_fetch.GetMutable<Tensor>();
+
+      const size_t block_size = narrow<size_t>(request->batch_size) * inner;
+      for (size_t o = 0; o < outer; ++o) {
+        CopyElements(src, o * src_stride + batch_offset * inner, dst, o * block_size, block_size);
+      }
+
+      batch_offset += narrow<size_t>(request->batch_size);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
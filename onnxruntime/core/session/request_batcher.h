@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Merges concurrent Run calls that use the same feeds/fetches signature into a single execution.
+ *
+ * The first caller of a new batch becomes the leader. It waits until either the batch is full or the wait budget
+ * has elapsed, concatenates the feeds of all callers along the batch axis, executes once, and slices the fetches
+ * back to the individual callers. Followers simply block until the leader has published their results, so no
+ * dedicated batching thread is needed.
+ *
+ * Only CPU tensor feeds are batched, and every fetch must carry the batch axis. Calls that don't qualify (see
+ * IsBatchable) should be executed directly by the caller.
+ */
+class RequestBatcher {
+ public:
+  struct Config {
+    // maximum sum of the batch dimension of merged requests. a value < 2 disables batching.
+    int64_t max_batch_size{0};
+    // how long the leader of a batch waits for more requests before executing.
+    std::chrono::microseconds max_wait{500};
+    // axis along which feeds are concatenated and fetches are split.
+    size_t batch_axis{0};
+  };
+
+  using ExecuteFn = std::function<Status(const RunOptions& run_options,
+                                         gsl::span<const std::string> feed_names,
+                                         gsl::span<const OrtValue> feeds,
+                                         gsl::span<const std::string> output_names,
+                                         std::vector<OrtValue>* p_fetches)>;
+
+  RequestBatcher(const Config& config, AllocatorPtr cpu_allocator, ExecuteFn execute_fn);
+
+  /**
+   * Parse the batching configuration from the session config values.
+   * `enabled` is set to true if the values request batching, in which case `config` is populated.
+   */
+  static Status ParseConfig(const std::string& max_batch_size, const std::string& max_wait_us,
+                            const std::string& batch_axis, Config& config, bool& enabled);
+
+  /**
+   * Check whether a Run call can take part in batching. Requires CPU tensor feeds that all share the same size for
+   * the batch axis, and no pre-allocated fetches.
+   */
+  bool IsBatchable(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                   gsl::span<const std::string> output_names, const std::vector<OrtValue>& fetches) const;
+
+  /**
+   * Execute the request as part of a batch. Blocks until the batch containing the request has completed.
+   * IsBatchable must have returned true for the request.
+   */
+  Status Run(const RunOptions& run_options, gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+             gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+  const Config& GetConfig() const { return config_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RequestBatcher);
+
+  struct Request {
+    gsl::span<const std::string> feed_names;
+    gsl::span<const OrtValue> feeds;
+    gsl::span<const std::string> output_names;
+    std::vector<OrtValue>* fetches;
+    int64_t batch_size;
+    Status status;
+  };
+
+  struct Batch {
+    // signature shared by all requests in the batch. the batch axis of each feed shape is set to 0.
+    std::vector<std::string> feed_names;
+    std::vector<std::string> output_names;
+    std::vector<MLDataType> feed_types;
+    std::vector<TensorShape> feed_shapes;
+
+    std::vector<Request*> requests;
+    int64_t total_batch_size{0};
+    bool closed{false};
+    bool completed{false};
+    OrtCondVar cv;
+  };
+
+  bool Matches(const Batch& batch, const Request& request) const;
+  void InitializeSignature(Batch& batch, const Request& request) const;
+
+  Status ExecuteBatch(const RunOptions& run_options, Batch& batch) const;
+
+  const Config config_;
+  AllocatorPtr cpu_allocator_;
+  ExecuteFn execute_fn_;
+
+  OrtMutex mutex_;
+  // batches that are still accepting requests. GUARDED_BY(mutex_)
+  std::vector<std::shared_ptr<Batch>> open_batches_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/session_metrics.h"
+
+#include <algorithm>
+#include <locale>
+#include <sstream>
+
+namespace onnxruntime {
+
+namespace {
+
+// Escapes a label value or JSON string. Both use backslash escapes for these characters.
+std::string Escape(const std::string& value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+    }
+  }
+  return escaped;
+}
+
+double Ratio(uint64_t hits, uint64_t misses) {
+  return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+}
+
+void HistogramToJson(std::ostream& os, const SessionMetrics::Histogram::Snapshot& snapshot) {
+  os << "{\"count\":" << snapshot.count << ",\"sum_seconds\":" << snapshot.sum_ns * 1e-9 << ",\"buckets\":[";
+  for (size_t i = 0; i < snapshot.buckets.size(); ++i) {
+    os << (i == 0 ? "" : ",") << snapshot.buckets[i];
+  }
+  os << "]}";
+}
+
+// Writes the HELP and TYPE lines of a metric.
+void Describe(std::ostream& os, const char* name, const char* type, const char* help) {
+  os << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+}
+
+void HistogramToPrometheus(std::ostream& os, const char* name, const char* help, const std::string& labels,
+                           const SessionMetrics::Histogram::Snapshot& snapshot) {
+  Describe(os, name, "histogram", help);
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i + 1 < snapshot.buckets.size(); ++i) {
+    cumulative += snapshot.buckets[i];
+    os << name << "_bucket{" << labels << ",le=\"" << SessionMetrics::Histogram::UpperBoundSeconds(i) << "\"} "
+       << cumulative << "\n";
+  }
+  os << name << "_bucket{" << labels << ",le=\"+Inf\"} " << snapshot.count << "\n"
+     << name << "_sum{" << labels << "} " << snapshot.sum_ns * 1e-9 << "\n"
+     << name << "_count{" << labels << "} " << snapshot.count << "\n";
+}
+
+}  // namespace
+
+void SessionMetrics::Histogram::Record(std::chrono::nanoseconds duration) {
+  const auto ns = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+  const uint64_t us = (ns + 999) / 1000;
+  size_t bucket = 0;
+  while (bucket < kNumBuckets - 1 && us > (uint64_t{1} << bucket)) {
+    ++bucket;
+  }
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+SessionMetrics::Histogram::Snapshot SessionMetrics::Histogram::Get() const {
+  Snapshot snapshot;
+  // the count is the sum of the buckets read, so that it is consistent with them even while runs are recorded
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    snapshot.count += snapshot.buckets[i];
+  }
+  snapshot.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+void SessionMetrics::RecordRun(std::chrono::nanoseconds latency, bool succeeded) {
+  runs_.fetch_add(1, std::memory_order_relaxed);
+  if (!succeeded) {
+    failed_runs_.fetch_add(1, std::memory_order_relaxed);
+  }
+  latency_.Record(latency);
+}
+
+double SessionMetrics::UptimeSeconds() const {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+}
+
+std::string SessionMetrics::ToJson(const Gauges& gauges) const {
+  const uint64_t runs = runs_.load(std::memory_order_relaxed);
+  const uint64_t graph_replays = graph_replays_.load(std::memory_order_relaxed);
+
+  std::ostringstream ss;
+  ss.imbue(std::locale::classic());
+  ss << "{\"session_id\":" << gauges.session_id
+     << ",\"uptime_seconds\":" << UptimeSeconds()
+     << ",\"runs\":" << runs
+     << ",\"failed_runs\":" << failed_runs_.load(std::memory_order_relaxed)
+     << ",\"concurrent_runs\":" << gauges.concurrent_runs
+     << ",\"async_queue_length\":" << gauges.async_queue_length
+     << ",\"latency\":";
+  HistogramToJson(ss, latency_.Get());
+  ss << ",\"queue_time\":";
+  HistogramToJson(ss, queue_time_.Get());
+  ss << ",\"cuda_graph\":{\"replays\":" << graph_replays
+     << ",\"hit_rate\":" << (runs == 0 ? 0.0 : static_cast<double>(graph_replays) / static_cast<double>(runs)) << "}"
+     << ",\"memory_pattern_cache\":{\"hits\":" << gauges.mem_pattern_cache_hits
+     << ",\"misses\":" << gauges.mem_pattern_cache_misses
+     << ",\"hit_rate\":" << Ratio(gauges.mem_pattern_cache_hits, gauges.mem_pattern_cache_misses) << "}"
+     << ",\"thread_pools\":{\"intra_op\":{\"threads\":" << gauges.intra_op_threads
+     << ",\"busy_seconds\":" << gauges.intra_op_busy_ns * 1e-9
+     << "},\"inter_op\":{\"threads\":" << gauges.inter_op_threads
+     << ",\"busy_seconds\":" << gauges.inter_op_busy_ns * 1e-9
+     << "}},\"allocators\":[";
+  bool first = true;
+  for (const auto& allocator : gauges.allocators) {
+    ss << (first ? "" : ",") << "{\"name\":\"" << Escape(allocator.name) << "\",\"device\":\""
+       << Escape(allocator.device) << "\",\"bytes_in_use\":" << allocator.stats.bytes_in_use
+       << ",\"total_allocated_bytes\":" << allocator.stats.total_allocated_bytes
+       << ",\"max_bytes_in_use\":" << allocator.stats.max_bytes_in_use
+       << ",\"num_allocs\":" << allocator.stats.num_allocs
+       << ",\"num_arena_extensions\":" << allocator.stats.num_arena_extensions << "}";
+    first = false;
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+std::string SessionMetrics::ToPrometheus(const Gauges& gauges) const {
+  std::ostringstream ss;
+  ss.imbue(std::locale::classic());
+  const std::string session = "session_id=\"" + std::to_string(gauges.session_id) + "\"";
+
+  Describe(ss, "ort_session_uptime_seconds", "gauge", "Time since the session was created.");
+  ss << "ort_session_uptime_seconds{" << session << "} " << UptimeSeconds() << "\n";
+  Describe(ss, "ort_session_runs_total", "counter", "Runs of the session.");
+  ss << "ort_session_runs_total{" << session << "} " << runs_.load(std::memory_order_relaxed) << "\n";
+  Describe(ss, "ort_session_failed_runs_total", "counter", "Runs of the session that returned an error.");
+  ss << "ort_session_failed_runs_total{" << session << "} " << failed_runs_.load(std::memory_order_relaxed) << "\n";
+  Describe(ss, "ort_session_concurrent_runs", "gauge", "Runs of the session in progress.");
+  ss << "ort_session_concurrent_runs{" << session << "} " << gauges.concurrent_runs << "\n";
+  Describe(ss, "ort_session_async_queue_length", "gauge", "RunAsync requests waiting for a dedicated thread.");
+  ss << "ort_session_async_queue_length{" << session << "} " << gauges.async_queue_length << "\n";
+  HistogramToPrometheus(ss, "ort_session_run_latency_seconds", "Latency of the runs of the session.", session,
+                        latency_.Get());
+  HistogramToPrometheus(ss, "ort_session_queue_time_seconds", "Time RunAsync requests waited before running.",
+                        session, queue_time_.Get());
+  Describe(ss, "ort_session_cuda_graph_replays_total", "counter", "Runs that replayed a captured CUDA graph.");
+  ss << "ort_session_cuda_graph_replays_total{" << session << "} " << graph_replays_.load(std::memory_order_relaxed)
+     << "\n";
+  Describe(ss, "ort_session_memory_pattern_cache_hits_total", "counter",
+           "Runs that found their memory pattern in the cache.");
+  ss << "ort_session_memory_pattern_cache_hits_total{" << session << "} " << gauges.mem_pattern_cache_hits << "\n";
+  Describe(ss, "ort_session_memory_pattern_cache_misses_total", "counter",
+           "Runs that did not find their memory pattern in the cache.");
+  ss << "ort_session_memory_pattern_cache_misses_total{" << session << "} " << gauges.mem_pattern_cache_misses
+     << "\n";
+
+  Describe(ss, "ort_session_thread_pool_threads", "gauge", "Threads of the thread pools of the session.");
+  ss << "ort_session_thread_pool_threads{" << session << ",pool=\"intra_op\"} " << gauges.intra_op_threads << "\n"
+     << "ort_session_thread_pool_threads{" << session << ",pool=\"inter_op\"} " << gauges.inter_op_threads << "\n";
+  Describe(ss, "ort_session_thread_pool_busy_seconds_total", "counter",
+           "Time the threads of the thread pools of the session spent running work.");
+  ss << "ort_session_thread_pool_busy_seconds_total{" << session << ",pool=\"intra_op\"} "
+     << gauges.intra_op_busy_ns * 1e-9 << "\n"
+     << "ort_session_thread_pool_busy_seconds_total{" << session << ",pool=\"inter_op\"} "
+     << gauges.inter_op_busy_ns * 1e-9 << "\n";
+
+  const auto allocator_labels = [&session](const Gauges::Allocator& allocator) {
+    return session + ",allocator=\"" + Escape(allocator.name) + "\",device=\"" + Escape(allocator.device) + "\"";
+  };
+  Describe(ss, "ort_session_allocator_bytes_in_use", "gauge", "Bytes in use of the allocators of the session.");
+  for (const auto& allocator : gauges.allocators) {
+    ss << "ort_session_allocator_bytes_in_use{" << allocator_labels(allocator) << "} "
+       << allocator.stats.bytes_in_use << "\n";
+  }
+  Describe(ss, "ort_session_allocator_bytes_allocated", "gauge",
+           "Bytes allocated from the device by the allocators of the session.");
+  for (const auto& allocator : gauges.allocators) {
+    ss << "ort_session_allocator_bytes_allocated{" << allocator_labels(allocator) << "} "
+       << allocator.stats.total_allocated_bytes << "\n";
+  }
+  Describe(ss, "ort_session_allocator_max_bytes_in_use", "gauge",
+           "Peak bytes in use of the allocators of the session.");
+  for (const auto& allocator : gauges.allocators) {
+    ss << "ort_session_allocator_max_bytes_in_use{" << allocator_labels(allocator) << "} "
+       << allocator.stats.max_bytes_in_use << "\n";
+  }
+  Describe(ss, "ort_session_allocator_allocations_total", "counter",
+           "Allocations served by the allocators of the session.");
+  for (const auto& allocator : gauges.allocators) {
+    ss << "ort_session_allocator_allocations_total{" << allocator_labels(allocator) << "} "
+       << allocator.stats.num_allocs << "\n";
+  }
+  return ss.str();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator_stats.h"
+
+namespace onnxruntime {
+
+/**
+ * Counters of the runs of a session that are cheap enough to be always on: a run updates a few relaxed atomics,
+ * without locking or allocating.
+ *
+ * The counters are cumulative since the session was created. Together with the values sampled from the session
+ * when a snapshot is taken (Gauges), they are exported as JSON or in the Prometheus text exposition format, so a
+ * monitoring agent can poll them and compute rates and quantiles.
+ */
+class SessionMetrics {
+ public:
+  // Histogram of durations. Bucket i < kNumBuckets - 1 counts the durations of at most 2^i microseconds that
+  // aren't counted by a lower bucket, the last bucket the longer ones.
+  class Histogram {
+   public:
+    static constexpr size_t kNumBuckets = 24;
+
+    struct Snapshot {
+      std::array<uint64_t, kNumBuckets> buckets{};
+      uint64_t count{0};
+      uint64_t sum_ns{0};
+    };
+
+    void Record(std::chrono::nanoseconds duration);
+    Snapshot Get() const;
+
+    // Upper bound of bucket i < kNumBuckets - 1 in seconds.
+    static double UpperBoundSeconds(size_t i) { return static_cast<double>(uint64_t{1} << i) * 1e-6; }
+
+   private:
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets_{};
+    std::atomic<uint64_t> sum_ns_{0};
+  };
+
+  // Values sampled from the session when a snapshot is taken.
+  struct Gauges {
+    struct Allocator {
+      std::string name;
+      std::string device;
+      AllocatorStats stats;
+    };
+
+    uint32_t session_id{0};
+    int concurrent_runs{0};
+    size_t async_queue_length{0};
+    std::vector<Allocator> allocators;
+    // Threads of the pools used by the session and the time they spent running work since the pool was created,
+    // which includes the work of other sessions for the global thread pools. The utilization of a pool over an
+    // interval is the increase of its busy time divided by the interval and its number of threads.
+    int intra_op_threads{0};
+    uint64_t intra_op_busy_ns{0};
+    int inter_op_threads{0};
+    uint64_t inter_op_busy_ns{0};
+    size_t mem_pattern_cache_hits{0};
+    size_t mem_pattern_cache_misses{0};
+  };
+
+  SessionMetrics() = default;
+
+  // A run of the session finished, successfully or not, after `latency`.
+  void RecordRun(std::chrono::nanoseconds latency, bool succeeded);
+
+  // A run submitted with RunAsync waited `queue_time` before starting.
+  void RecordQueueTime(std::chrono::nanoseconds queue_time) { queue_time_.Record(queue_time); }
+
+  // A run replayed a captured CUDA graph instead of executing the graph.
+  void RecordGraphReplay() { graph_replays_.fetch_add(1, std::memory_order_relaxed); }
+
+  std::string ToJson(const Gauges& gauges) const;
+
+  // Metrics named ort_session_*, labeled with the session id.
+  std::string ToPrometheus(const Gauges& gauges) const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionMetrics);
+
+  // Seconds since the metrics were created.
+  double UptimeSeconds() const;
+
+  const std::chrono::steady_clock::time_point start_time_{std::chrono::steady_clock::now()};
+  std::atomic<uint64_t> runs_{0};
+  std::atomic<uint64_t> failed_runs_{0};
+  std::atomic<uint64_t> graph_replays_{0};
+  Histogram latency_;
+  Histogram queue_time_;
+};
+
+}  // namespace onnxruntime
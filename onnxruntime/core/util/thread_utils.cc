@@ -4,12 +4,14 @@
 #include "core/util/thread_utils.h"
 
 #include <algorithm>
+#include <functional>
 
 #ifdef _WIN32
 #include <Windows.h>
 #endif
 #include <thread>
 #include "core/session/ort_apis.h"
+#include "core/framework/error_code_helper.h"
 #include "core/common/string_utils.h"
 #include "core/common/logging/logging.h"
 
@@ -71,9 +73,145 @@ static std::vector<LogicalProcessors> ReadThreadAffinityConfig(const std::string
 }
 #endif
 
+// Get the affinities of the physical cores that have none of their logical processors on an efficiency core.
+// Returns an empty vector if the CPU is not hybrid or the physical cores are unknown.
+static std::vector<LogicalProcessors> GetPerformanceCoreAffinities() {
+  const LogicalProcessors efficiency_processors = Env::Default().GetEfficiencyCoreProcessors();
+  if (efficiency_processors.empty()) {
+    return {};
+  }
+
+  std::vector<LogicalProcessors> performance_cores;
+  for (auto& core : Env::Default().GetDefaultThreadAffinities()) {
+    if (core.empty()) {
+      return {};
+    }
+
+    const bool is_efficiency_core = std::any_of(core.begin(), core.end(), [&](int processor) {
+      return std::find(efficiency_processors.begin(), efficiency_processors.end(), processor) !=
+             efficiency_processors.end();
+    });
+    if (!is_efficiency_core) {
+      performance_cores.push_back(std::move(core));
+    }
+  }
+
+  return performance_cores;
+}
+
+// Get the affinities of the cores selected by a ","-delimited list of presets, in the order of the cores.
+// See kOrtSessionOptionsConfigIntraOpThreadAffinityPreset. Returns an empty vector if the cores are unknown.
+static std::vector<LogicalProcessors> GetAffinityPresetCores(const std::string& presets) {
+  bool skip_smt = false;
+  bool one_socket = false;
+  bool performance_cores = false;
+  for (const auto& preset : utils::SplitString(presets, ",")) {
+    if (preset == "skip_smt") {
+      skip_smt = true;
+    } else if (preset == "one_socket") {
+      one_socket = true;
+    } else if (preset == "performance_cores") {
+      performance_cores = true;
+    } else {
+      ORT_ENFORCE(preset == "physical_cores", "Unknown thread affinity preset: ", preset);
+    }
+  }
+
+  const Env& env = Env::Default();
+  std::vector<LogicalProcessors> cores;
+  if (performance_cores) {
+    cores = GetPerformanceCoreAffinities();
+  }
+  if (cores.empty()) {
+    cores = env.GetDefaultThreadAffinities();
+  }
+  if (cores.empty() || cores.front().empty()) {
+    return {};
+  }
+
+  if (one_socket) {
+    std::function<int(const LogicalProcessors&)> get_socket = [&env](const LogicalProcessors& core) {
+      return env.GetCpuPackageOfProcessors(core);
+    };
+    if (get_socket(cores.front()) < 0) {
+      get_socket = [&env](const LogicalProcessors& core) { return env.GetNumaNodeOfProcessors(core); };
+    }
+
+    const int socket = get_socket(cores.front());
+    if (socket < 0) {
+      return {};
+    }
+    cores.erase(std::remove_if(cores.begin(), cores.end(),
+                               [&](const LogicalProcessors& core) { return get_socket(core) != socket; }),
+                cores.end());
+  }
+
+  if (skip_smt) {
+    for (auto& core : cores) {
+      core.resize(1);
+    }
+  }
+
+  return cores;
+}
+
 static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
+  if (options.custom_scheduler) {
+    // the threads belong to the scheduler, so the options about them don't apply
+    if (options.custom_scheduler->degree_of_parallelism <= 1) {
+      return nullptr;
+    }
+    to.set_denormal_as_zero = options.set_denormal_as_zero;
+    to.calibrate_parallel_for_costs = options.calibrate_parallel_for_costs;
+    to.dynamic_block_base_ = options.dynamic_block_base_;
+    to.custom_scheduler = options.custom_scheduler;
+    return std::make_unique<ThreadPool>(env, to, options.name, options.custom_scheduler->degree_of_parallelism,
+                                        false);
+  }
+
+  if (options.performance_cores_only && options.affinity_str.empty()) {
+    auto performance_cores = GetPerformanceCoreAffinities();
+    if (performance_cores.empty()) {
+      LOGS_DEFAULT(INFO) << "No hybrid CPU with known performance cores found, threads are not restricted to them";
+    } else if (options.thread_pool_size <= 0) {
+      options.thread_pool_size = static_cast<int>(performance_cores.size());
+      to.affinities = std::move(performance_cores);
+    } else if (static_cast<size_t>(options.thread_pool_size) <= performance_cores.size()) {
+      performance_cores.resize(options.thread_pool_size);
+      to.affinities = std::move(performance_cores);
+    } else {
+      LOGS_DEFAULT(WARNING) << "Thread pool size " << options.thread_pool_size << " exceeds the "
+                            << performance_cores.size() << " performance cores, threads are not restricted to them";
+    }
+  }
+
+  if (!options.affinity_preset.empty() && options.affinity_str.empty()) {
+    auto cores = GetAffinityPresetCores(options.affinity_preset);
+    // the calling thread runs on the first core, followed by the reserved cores
+    const size_t first_core = 1 + static_cast<size_t>(std::max(options.affinity_preset_reserved_cores, 0));
+    const size_t num_cores = cores.size() > first_core ? cores.size() - first_core : 0;
+    if (cores.empty()) {
+      LOGS_DEFAULT(INFO) << "The cores of thread affinity preset " << options.affinity_preset
+                         << " are unknown, threads are not bound to them";
+    } else if (options.thread_pool_size <= 0 || static_cast<size_t>(options.thread_pool_size) - 1 <= num_cores) {
+      if (options.thread_pool_size <= 0) {
+        options.thread_pool_size = static_cast<int>(num_cores) + 1;
+      }
+      // an empty affinity is the placeholder for the calling thread, dropped during threadpool creation
+      to.affinities.clear();
+      to.affinities.emplace_back();
+      for (size_t i = 0; i + 1 < static_cast<size_t>(options.thread_pool_size); ++i) {
+        to.affinities.push_back(std::move(cores[first_core + i]));
+      }
+    } else {
+      LOGS_DEFAULT(WARNING) << "Thread pool size " << options.thread_pool_size << " exceeds the " << num_cores
+                            << " available cores of thread affinity preset " << options.affinity_preset
+                            << ", threads are not bound to them";
+    }
+  }
+
   if (options.thread_pool_size <= 0) {  // default
     auto default_affinities = Env::Default().GetDefaultThreadAffinities();
     if (default_affinities.size() <= 1) {
@@ -110,6 +248,8 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   }
 
   to.set_denormal_as_zero = options.set_denormal_as_zero;
+  to.adaptive_spinning = options.adaptive_spinning;
+  to.calibrate_parallel_for_costs = options.calibrate_parallel_for_costs;
   // set custom thread management members
   to.custom_create_thread_fn = options.custom_create_thread_fn;
   to.custom_thread_creation_options = options.custom_thread_creation_options;
@@ -132,6 +272,15 @@ CreateThreadPool(Env* env, OrtThreadPoolParams options, ThreadPoolType tpool_typ
   return CreateThreadPoolHelper(env, options);
 }
 
+Status ValidateCustomScheduler(const OrtCustomScheduler* scheduler) {
+  ORT_RETURN_IF(scheduler == nullptr, "Received null OrtCustomScheduler");
+  ORT_RETURN_IF(scheduler->version == 0 || scheduler->version > ORT_API_VERSION,
+                "Unsupported OrtCustomScheduler version ", scheduler->version);
+  ORT_RETURN_IF(scheduler->RunTasks == nullptr || scheduler->Schedule == nullptr,
+                "OrtCustomScheduler must provide RunTasks and Schedule");
+  return Status::OK();
+}
+
 }  // namespace concurrency
 }  // namespace onnxruntime
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -183,6 +332,27 @@ ORT_API_STATUS_IMPL(SetGlobalDenormalAsZero, _Inout_ OrtThreadingOptions* tp_opt
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(SetGlobalIntraOpPerformanceCoresOnly, _Inout_ OrtThreadingOptions* tp_options) {
+  if (!tp_options) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
+  }
+  tp_options->intra_op_thread_pool_params.performance_cores_only = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(SetGlobalIntraOpCustomScheduler, _Inout_ OrtThreadingOptions* tp_options,
+                    _In_ const OrtCustomScheduler* scheduler) {
+  if (!tp_options) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
+  }
+  auto status = onnxruntime::concurrency::ValidateCustomScheduler(scheduler);
+  if (!status.IsOK()) {
+    return onnxruntime::ToOrtStatus(status);
+  }
+  tp_options->intra_op_thread_pool_params.custom_scheduler = *scheduler;
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(SetGlobalCustomCreateThreadFn, _Inout_ OrtThreadingOptions* tp_options, _In_ OrtCustomCreateThreadFn ort_custom_create_thread_fn) {
   if (!tp_options) {
     return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
@@ -5,6 +5,7 @@
 #include "core/platform/threadpool.h"
 #include "core/session/onnxruntime_c_api.h"
 #include <memory>
+#include <optional>
 #include <string>
 
 struct OrtThreadPoolParams {
@@ -21,6 +22,13 @@ struct OrtThreadPoolParams {
   // If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  // If it is true, the thread pool decides whether to spin from the observed gaps between work items and the
+  // observed wake-up latency of its threads. Takes precedence over allow_spinning.
+  bool adaptive_spinning = false;
+
+  // If it is true, the cost estimates of the parallel loops are replaced by their measured costs over time.
+  bool calibrate_parallel_for_costs = false;
+
   // It it is non-negative, thread pool will split a task by a decreasing block size
   // of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
@@ -42,10 +50,26 @@ struct OrtThreadPoolParams {
   // Set or unset denormal as zero
   bool set_denormal_as_zero = false;
 
+  // If it is true and affinity_str is empty, the threads are bound to the performance cores of a hybrid CPU,
+  // one per core. With thread_pool_size = 0, a thread is created per performance core.
+  // It has no effect on CPUs that aren't hybrid.
+  bool performance_cores_only = false;
+
+  // If it is not empty and affinity_str is empty, the threads are bound to the cores selected by this ","-delimited
+  // list of presets, see kOrtSessionOptionsConfigIntraOpThreadAffinityPreset.
+  std::string affinity_preset;
+
+  // Number of the cores selected by affinity_preset, after the one of the calling thread, that threads of another
+  // thread pool are bound to. The threads of this pool are bound to the cores after them.
+  int affinity_preset_reserved_cores = 0;
+
   // members to manage custom threads
   OrtCustomCreateThreadFn custom_create_thread_fn = nullptr;
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
+
+  // If set, the work of the thread pool runs on this scheduler instead of threads created by the pool.
+  std::optional<OrtCustomScheduler> custom_scheduler;
 };
 
 struct OrtThreadingOptions {
@@ -65,5 +89,8 @@ enum class ThreadPoolType : uint8_t {
 };
 std::unique_ptr<ThreadPool> CreateThreadPool(Env* env, OrtThreadPoolParams options,
                                              ThreadPoolType tpool_type);
+
+// Check that a scheduler passed through the C API can be used.
+Status ValidateCustomScheduler(const OrtCustomScheduler* scheduler);
 }  // namespace concurrency
 }  // namespace onnxruntime
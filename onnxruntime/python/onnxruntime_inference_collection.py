@@ -6,6 +6,7 @@ from __future__ import annotations
 
 import collections
 import collections.abc
+import json
 import os
 import typing
 import warnings
@@ -230,6 +231,35 @@ class Session:
                 return self._sess.run(output_names, input_feed, run_options)
             raise
 
+    def run_batch(self, output_names, input_feeds, run_options=None):
+        """
+        Compute the predictions of several requests concurrently, on the threads the session uses for
+        :meth:`run_async`, with the GIL released until all of them completed. A request that cannot be run
+        asynchronously, e.g. because the intra-op thread pool has a single thread, is run by the calling thread.
+
+        :param output_names: name of the outputs
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``, one per request, or a single
+            dictionary of arrays stacked along their first axis, which is split into requests of batch size 1.
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: list of the results of each request, in the order of the requests. The numpy arrays of CPU outputs
+            view the memory of the outputs without copying it and are read-only; use ``copy()`` to modify them.
+
+        ::
+
+            sess.run_batch([output_name], [{input_name: x0}, {input_name: x1}])
+        """
+        if isinstance(input_feeds, dict):
+            counts = {len(value) for value in input_feeds.values()}
+            if len(counts) != 1:
+                raise ValueError("The arrays of stacked input feeds must have the same first dimension.")
+            count = counts.pop()
+            input_feeds = [{name: value[i : i + 1] for name, value in input_feeds.items()} for i in range(count)]
+        for input_feed in input_feeds:
+            self._validate_input(list(input_feed.keys()))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        return self._sess.run_batch(output_names, input_feeds, run_options)
+
     def run_async(self, output_names, input_feed, callback, user_data, run_options=None):
         """
         Compute the predictions asynchronously in a separate cxx thread from ort intra-op threadpool.
@@ -319,6 +349,37 @@ class Session:
         """
         return self._sess.get_profiling_start_time_ns
 
+    def get_allocator_metrics(self):
+        """
+        Return the metrics of the allocators used by the session as a list with a dict per allocator,
+        holding its name, device and metrics such as the bytes in use, the chunks per arena bin and
+        histograms of the allocation sizes and lifetimes.
+        Cheap enough to be polled periodically while the session is running.
+        """
+        return json.loads(self._sess.get_allocator_metrics())
+
+    def get_profiling_summary(self):
+        """
+        Return the summary of the events of the runs sampled by the profiler as a dict, holding the number of
+        sampled runs and a list of events with their count, mean, p50, p99 and max durations in microseconds and
+        mean output size in bytes. Only available while profiling with the session config entry
+        "session.profiling_sample_rate" or "session.profiling_sample_interval_ms".
+        """
+        return json.loads(self._sess.get_profiling_summary())
+
+    def get_metrics(self, format="json"):
+        """
+        Return a snapshot of the metrics of the session, cumulative since it was created: the run count, histograms
+        of the run latency and of the time RunAsync requests waited, the CUDA graph replays, the memory pattern cache
+        hits and misses, the thread pool busy time and the bytes in use of each allocator.
+        The metrics are always collected and cheap to poll.
+
+        :param format: "json" to return a dict, or "prometheus" to return a string in the Prometheus text exposition
+            format that can be served to a scraper as is.
+        """
+        metrics = self._sess.get_metrics(format)
+        return json.loads(metrics) if format == "json" else metrics
+
     def io_binding(self):
         "Return an onnxruntime.IOBinding object`."
         return IOBinding(self)
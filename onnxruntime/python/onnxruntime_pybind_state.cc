@@ -54,6 +54,8 @@ namespace onnxruntime {
 
 #include <iterator>
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -163,6 +165,86 @@ void AsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtS
   }
 }
 
+// Counts down the requests of InferenceSession.run_batch as they complete.
+struct BatchRunLatch {
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t pending = 0;
+
+  void CountDown() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--pending == 0) {
+      cv.notify_all();
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this]() { return pending == 0; });
+  }
+};
+
+// One request of InferenceSession.run_batch, executed with RunAsync.
+struct BatchRunRequest {
+  std::vector<OrtValue> feeds;
+  std::vector<const OrtValue*> feeds_raw;
+  std::vector<const char*> feed_names_raw;
+  std::vector<OrtValue*> fetches_raw;  // will be released during destruction
+  std::string error_message;
+  bool failed = false;
+
+  BatchRunLatch* latch = nullptr;
+
+  BatchRunRequest() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BatchRunRequest);
+
+  ~BatchRunRequest() {
+    for (OrtValue* fetch : fetches_raw) {
+      delete fetch;
+    }
+  }
+};
+
+void BatchRunCallback(void* user_data, OrtValue** /*outputs*/, size_t /*num_outputs*/, OrtStatusPtr ort_status) {
+  auto* request = reinterpret_cast<BatchRunRequest*>(user_data);
+  Ort::Status status(ort_status);
+  if (!status.IsOK()) {
+    request->failed = true;
+    request->error_message = status.GetErrorMessage();
+  }
+  request->latch->CountDown();
+}
+
+// Returns a numpy array viewing the data of a CPU tensor without copying it. The array keeps the buffer alive through
+// a copy of the OrtValue, and is read-only because the buffer may be shared with the session, e.g. for an output that
+// is an initializer. Tensors of other devices and string tensors are copied.
+static py::object GetPyObjSharingTensor(const OrtValue& val) {
+  const Tensor& rtensor = val.Get<Tensor>();
+  const int numpy_type = OnnxRuntimeTensorToNumpyType(rtensor.DataType());
+  if (numpy_type == NPY_OBJECT || rtensor.Location().device.Type() != OrtDevice::CPU) {
+    return AddTensorAsPyObj(val, nullptr, nullptr);
+  }
+
+  std::vector<npy_intp> npy_dims;
+  const TensorShape& shape = rtensor.Shape();
+  for (size_t n = 0; n < shape.NumDimensions(); ++n) {
+    npy_dims.push_back(shape[n]);
+  }
+
+  py::capsule owner(new OrtValue(val), [](void* p) { delete reinterpret_cast<OrtValue*>(p); });
+  auto obj = py::reinterpret_steal<py::object>(PyArray_New(
+      &PyArray_Type, narrow<int>(shape.NumDimensions()), npy_dims.data(), numpy_type, nullptr,
+      const_cast<void*>(rtensor.DataRaw()), 0, NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_ALIGNED, nullptr));
+  if (!obj) {
+    throw py::error_already_set();
+  }
+  // steals the reference to the owner
+  if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(obj.ptr()), owner.release().ptr()) != 0) {
+    throw py::error_already_set();
+  }
+  return obj;
+}
+
 template <typename T>
 static py::object AddNonTensor(const OrtValue& val,
                                const DataTransferManager* /*data_transfer_manager*/,
@@ -437,15 +519,22 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
     const std::string& type,
     const ProviderOptionsMap& provider_options_map) {
   if (type == kCpuExecutionProvider) {
+    const auto& config_options = session_options.config_options;
+    HugePageCPUAllocator::Options allocator_options;
+    OrtPybindThrowIfError(HugePageCPUAllocator::ParseOptions(
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuAllocatorHugePages, ""),
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigCpuAllocatorNumaNode, ""),
+        config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpThreadAffinities, ""),
+        allocator_options));
     return onnxruntime::CPUProviderFactoryCreator::Create(
-               session_options.enable_cpu_mem_arena)
+               session_options.enable_cpu_mem_arena, allocator_options)
         ->CreateProvider();
   } else if (type == kTensorrtExecutionProvider) {
 #ifdef USE_TENSORRT
     // If the environment variable 'ORT_TENSORRT_UNAVAILABLE' exists, then we do not load TensorRT. This is set by _ld_preload for the manylinux case
     // as in that case, trying to load the library itself will result in a crash due to the way that auditwheel strips dependencies.
     if (Env::Default().GetEnvironmentVar("ORT_TENSORRT_UNAVAILABLE").empty()) {
-      std::string calibration_table, cache_path, lib_path, min_profile, max_profile, opt_profile;
+      std::string calibration_table, cache_path, lib_path, min_profile, max_profile, opt_profile, profile_trace;
       auto it = provider_options_map.find(type);
       if (it != provider_options_map.end()) {
         OrtTensorRTProviderOptionsV2 params{
@@ -481,7 +570,9 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             nullptr,
             nullptr,
             nullptr,
-            0};
+            0,
+            nullptr,
+            3};
         for (auto option : it->second) {
           if (option.first == "device_id") {
             if (!option.second.empty()) {
@@ -707,6 +798,19 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_cuda_graph_enable' should be 'True' or 'False'. Default value is 'False'.\n");
             }
+          } else if (option.first == "trt_profile_shapes_trace") {
+            if (!option.second.empty()) {
+              profile_trace = option.second;
+              params.trt_profile_shapes_trace = profile_trace.c_str();
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_profile_shapes_trace' should be a file path i.e. 'shapes.txt'.\n");
+            }
+          } else if (option.first == "trt_num_auto_profiles") {
+            if (!option.second.empty()) {
+              params.trt_num_auto_profiles = std::stoi(option.second);
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_num_auto_profiles' should be a number i.e. '3'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -907,7 +1011,10 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #endif
     const auto partitioning_stop_ops_list = session_options.config_options.GetConfigEntry(
         kOrtSessionOptionsConfigNnapiEpPartitioningStopOps);
-    return onnxruntime::NnapiProviderFactoryCreator::Create(0, partitioning_stop_ops_list)->CreateProvider();
+    const auto min_partition_size = session_options.config_options.GetConfigEntry(
+        kOrtSessionOptionsConfigNnapiEpMinPartitionSize);
+    return onnxruntime::NnapiProviderFactoryCreator::Create(0, partitioning_stop_ops_list, min_partition_size)
+        ->CreateProvider();
 #endif
   } else if (type == kRknpuExecutionProvider) {
 #ifdef USE_RKNPU
@@ -1242,7 +1349,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
 
   py::enum_<ExecutionOrder>(m, "ExecutionOrder")
       .value("DEFAULT", ExecutionOrder::DEFAULT)
-      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED);
+      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED)
+      .value("MEMORY_EFFICIENT", ExecutionOrder::MEMORY_EFFICIENT);
 
   py::enum_<OrtAllocatorType>(m, "OrtAllocatorType")
       .value("INVALID", OrtInvalidAllocator)
@@ -1298,6 +1406,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
             ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
           } else if (key == "max_power_of_two_extend_bytes") {
             ort_arena_cfg->max_power_of_two_extend_bytes = kvp.second.cast<int>();
+          } else if (key == "thread_cache_max_bytes") {
+            ort_arena_cfg->thread_cache_max_bytes = kvp.second.cast<size_t>();
           } else {
             ORT_THROW("Invalid OrtArenaCfg option: ", key);
           }
@@ -1309,7 +1419,8 @@ void addObjectMethods(py::module& m, ExecutionProviderRegistrationFn ep_registra
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
       .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
-      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes);
+      .def_readwrite("max_power_of_two_extend_bytes", &OrtArenaCfg::max_power_of_two_extend_bytes)
+      .def_readwrite("thread_cache_max_bytes", &OrtArenaCfg::thread_cache_max_bytes);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -1824,6 +1935,101 @@ including arg name, arg type (contains both type and shape).)pbdoc")
              }
              OrtPybindThrowIfError(status);
            })
+      .def("run_batch",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::vector<std::map<std::string, py::object>> pyfeeds_list, RunOptions* run_options = nullptr)
+               -> std::vector<std::vector<py::object>> {
+             auto px = sess->GetSessionHandle()->GetModelInputs();
+             if (!px.first.IsOK() || !px.second) {
+               throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+             }
+
+             std::vector<const char*> fetch_names_raw;
+             fetch_names_raw.reserve(output_names.size());
+             for (const auto& output_name : output_names) {
+               fetch_names_raw.push_back(output_name.c_str());
+             }
+
+             // the names of the feeds are owned by pyfeeds_list, which outlives the runs.
+             std::vector<std::unique_ptr<BatchRunRequest>> requests;
+             requests.reserve(pyfeeds_list.size());
+             for (const auto& pyfeeds : pyfeeds_list) {
+               auto request = std::make_unique<BatchRunRequest>();
+               request->feeds.reserve(pyfeeds.size());
+               for (const auto& feed : pyfeeds) {
+                 if (!feed.second.is(py::none())) {
+                   OrtValue ml_value;
+                   CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+                   ThrowIfPyErrOccured();
+                   request->feeds.push_back(ml_value);
+                   request->feed_names_raw.push_back(feed.first.c_str());
+                 }
+               }
+               for (const auto& feed : request->feeds) {
+                 request->feeds_raw.push_back(&feed);
+               }
+               request->fetches_raw.resize(output_names.size(), nullptr);
+               requests.push_back(std::move(request));
+             }
+
+             {
+               // release GIL while the requests run concurrently on the threads of the session.
+               py::gil_scoped_release release;
+               RunOptions default_run_options;
+               const RunOptions* options = run_options ? run_options : &default_run_options;
+               auto* session = sess->GetSessionHandle();
+
+               BatchRunLatch latch;
+               latch.pending = requests.size();
+               for (auto& request : requests) {
+                 request->latch = &latch;
+                 const auto feed_names = gsl::make_span(request->feed_names_raw);
+                 const auto feeds = gsl::make_span(request->feeds_raw);
+                 const auto fetch_names = gsl::make_span(fetch_names_raw);
+                 const auto fetches = gsl::make_span(request->fetches_raw);
+                 Status status = session->RunAsync(options, feed_names, feeds, fetch_names, fetches, BatchRunCallback,
+                                                   request.get());
+                 if (!status.IsOK()) {
+                   // the session cannot run it asynchronously, e.g. it has no thread to spare, so it is run here.
+                   status = session->Run(*options, feed_names, feeds, fetch_names, fetches);
+                   if (!status.IsOK()) {
+                     request->failed = true;
+                     request->error_message = status.ErrorMessage();
+                   }
+                   latch.CountDown();
+                 }
+               }
+               latch.Wait();
+             }
+
+             std::vector<std::vector<py::object>> results;
+             results.reserve(requests.size());
+             for (size_t i = 0; i < requests.size(); ++i) {
+               if (requests[i]->failed) {
+                 throw std::runtime_error("Request " + std::to_string(i) + " of the batch failed: " +
+                                          requests[i]->error_message);
+               }
+               std::vector<py::object> rfetch;
+               rfetch.reserve(output_names.size());
+               size_t pos = 0;
+               for (const OrtValue* fetch : requests[i]->fetches_raw) {
+                 if (fetch != nullptr && fetch->IsAllocated()) {
+                   if (fetch->IsTensor()) {
+                     rfetch.push_back(GetPyObjSharingTensor(*fetch));
+                   } else if (fetch->IsSparseTensor()) {
+                     rfetch.push_back(GetPyObjectFromSparseTensor(pos, *fetch, nullptr));
+                   } else {
+                     rfetch.push_back(AddNonTensorAsPyObj(*fetch, nullptr, nullptr));
+                   }
+                 } else {
+                   rfetch.push_back(py::none());
+                 }
+                 ++pos;
+               }
+               results.push_back(std::move(rfetch));
+             }
+             return results;
+           })
       /// This method accepts a dictionary of feeds (name -> OrtValue) and the list of output_names
       /// and returns a list of python objects representing OrtValues. Each name may represent either
       /// a Tensor, SparseTensor or a TensorSequence.
@@ -1860,6 +2066,23 @@ including arg name, arg type (contains both type and shape).)pbdoc")
       .def_property_readonly("get_profiling_start_time_ns", [](const PyInferenceSession* sess) -> uint64_t {
         return sess->GetSessionHandle()->GetProfiling().GetStartTimeNs();
       })
+      .def("get_allocator_metrics", [](const PyInferenceSession* sess) -> std::string {
+        std::string metrics;
+        OrtPybindThrowIfError(sess->GetSessionHandle()->GetAllocatorMetrics(metrics));
+        return metrics;
+      })
+      .def("get_profiling_summary", [](const PyInferenceSession* sess) -> std::string {
+        std::string summary;
+        OrtPybindThrowIfError(sess->GetSessionHandle()->GetProfilingSummary(summary));
+        return summary;
+      })
+      .def(
+          "get_metrics", [](const PyInferenceSession* sess, const std::string& format) -> std::string {
+            std::string metrics;
+            OrtPybindThrowIfError(sess->GetSessionHandle()->GetMetrics(format, metrics));
+            return metrics;
+          },
+          py::arg("format") = "json")
       .def(
           "get_providers", [](const PyInferenceSession* sess) -> const std::vector<std::string>& {
             return sess->GetSessionHandle()->GetRegisteredProviderTypes();
@@ -0,0 +1,325 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Replays an allocation trace recorded with the "session.allocation_trace_file" session config key against arenas
+// configured differently, and reports the memory each configuration reserves and how fragmented it gets:
+//   onnxruntime_allocation_replay --trace=<file> [--allocator=<name>] [--arena=<label>:<key>=<value>,...]...
+//                                 [--planner]
+// See README.md for the keys of an arena configuration.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/clog_sink.h"
+#include "core/framework/allocation_trace.h"
+#include "core/framework/bfc_arena.h"
+#include "core/framework/mem_pattern_planner.h"
+
+using namespace onnxruntime;
+
+namespace {
+
+// Hands out address ranges without backing them with memory, which the arena never touches, so traces of any device
+// can be replayed on the host. Tracks the bytes reserved from it.
+class ReplayDeviceAllocator : public IAllocator {
+ public:
+  ReplayDeviceAllocator() : IAllocator(OrtMemoryInfo("Replay", OrtAllocatorType::OrtDeviceAllocator)) {}
+
+  void* Alloc(size_t size) override {
+    constexpr size_t kPageSize = 4096;
+    void* p = reinterpret_cast<void*>(next_address_);
+    next_address_ += (size + kPageSize - 1) / kPageSize * kPageSize;
+    sizes_[p] = size;
+    reserved_bytes_ += size;
+    peak_reserved_bytes_ = std::max(peak_reserved_bytes_, reserved_bytes_);
+    return p;
+  }
+
+  void Free(void* p) override {
+    auto it = sizes_.find(p);
+    if (it != sizes_.end()) {
+      reserved_bytes_ -= it->second;
+      sizes_.erase(it);
+    }
+  }
+
+  size_t ReservedBytes() const { return reserved_bytes_; }
+  size_t PeakReservedBytes() const { return peak_reserved_bytes_; }
+
+ private:
+  uintptr_t next_address_{uintptr_t{1} << 44};
+  std::unordered_map<void*, size_t> sizes_;
+  size_t reserved_bytes_{0};
+  size_t peak_reserved_bytes_{0};
+};
+
+struct ArenaConfig {
+  std::string label;
+  OrtArenaCfg config;
+};
+
+struct ReplayResult {
+  size_t peak_reserved_bytes{0};
+  int64_t peak_bytes_in_use{0};
+  // 1 - largest free chunk / free bytes when the bytes in use peaked
+  double external_fragmentation_at_peak{0.0};
+  int64_t num_extensions{0};
+  size_t num_failed_allocations{0};
+};
+
+// Parse "<label>:<key>=<value>,..." over the configuration recorded in the trace.
+bool ParseArenaConfig(const std::string& spec, const OrtArenaCfg& recorded, ArenaConfig& arena_config) {
+  const auto colon = spec.find(':');
+  arena_config.label = spec.substr(0, colon);
+  arena_config.config = recorded;
+  if (colon == std::string::npos) {
+    return !arena_config.label.empty();
+  }
+
+  std::istringstream settings(spec.substr(colon + 1));
+  std::string setting;
+  OrtArenaCfg& config = arena_config.config;
+  while (std::getline(settings, setting, ',')) {
+    const auto equals = setting.find('=');
+    if (equals == std::string::npos) {
+      return false;
+    }
+    const std::string key = setting.substr(0, equals);
+    const std::string value = setting.substr(equals + 1);
+    if (key == "extend_strategy") {
+      if (value == "next_power_of_two") {
+        config.arena_extend_strategy = static_cast<int>(ArenaExtendStrategy::kNextPowerOfTwo);
+      } else if (value == "same_as_requested") {
+        config.arena_extend_strategy = static_cast<int>(ArenaExtendStrategy::kSameAsRequested);
+      } else {
+        return false;
+      }
+    } else if (key == "initial_chunk_size_bytes") {
+      config.initial_chunk_size_bytes = std::stoi(value);
+    } else if (key == "max_dead_bytes_per_chunk") {
+      config.max_dead_bytes_per_chunk = std::stoi(value);
+    } else if (key == "initial_growth_chunk_size_bytes") {
+      config.initial_growth_chunk_size_bytes = std::stoi(value);
+    } else if (key == "max_power_of_two_extend_bytes") {
+      config.max_power_of_two_extend_bytes = std::stoll(value);
+    } else if (key == "max_mem") {
+      config.max_mem = static_cast<size_t>(std::stoull(value));
+    } else if (key == "thread_cache_max_bytes") {
+      config.thread_cache_max_bytes = static_cast<size_t>(std::stoull(value));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+ReplayResult Replay(const AllocationTrace& trace, uint16_t allocator_id, const OrtArenaCfg& config) {
+  auto device_allocator = std::make_unique<ReplayDeviceAllocator>();
+  const ReplayDeviceAllocator& device = *device_allocator;
+  BFCArena arena(std::move(device_allocator), config.max_mem == 0 ? BFCArena::DEFAULT_MAX_MEM : config.max_mem,
+                 static_cast<ArenaExtendStrategy>(config.arena_extend_strategy), config.initial_chunk_size_bytes,
+                 config.max_dead_bytes_per_chunk, config.initial_growth_chunk_size_bytes,
+                 config.max_power_of_two_extend_bytes, config.thread_cache_max_bytes);
+
+  ReplayResult result;
+  // traced address -> replayed address
+  std::unordered_map<uint64_t, void*> addresses;
+  AllocatorStats stats;
+  for (const auto& event : trace.events) {
+    if (event.allocator_id != allocator_id) {
+      continue;
+    }
+
+    if (event.type == AllocationTraceEvent::Type::kFree) {
+      auto it = addresses.find(event.address);
+      if (it != addresses.end()) {
+        arena.Free(it->second);
+        addresses.erase(it);
+      }
+      continue;
+    }
+
+    void* p = nullptr;
+    ORT_TRY {
+      p = event.type == AllocationTraceEvent::Type::kReserve ? arena.Reserve(static_cast<size_t>(event.size))
+                                                             : arena.Alloc(static_cast<size_t>(event.size));
+    }
+    ORT_CATCH(const std::exception&) {
+      p = nullptr;
+    }
+    if (p == nullptr) {
+      ++result.num_failed_allocations;
+      continue;
+    }
+    addresses[event.address] = p;
+
+    arena.GetStats(&stats);
+    if (stats.bytes_in_use > result.peak_bytes_in_use) {
+      result.peak_bytes_in_use = stats.bytes_in_use;
+      AllocatorMetrics metrics;
+      arena.GetMetrics(&metrics);
+      int64_t free_bytes = 0;
+      for (const auto& bin : metrics.bins) {
+        free_bytes += bin.free_bytes;
+      }
+      result.external_fragmentation_at_peak =
+          free_bytes == 0 ? 0.0 : 1.0 - static_cast<double>(metrics.largest_free_chunk) / free_bytes;
+    }
+  }
+
+  arena.GetStats(&stats);
+  result.num_extensions = stats.num_arena_extensions;
+  result.peak_reserved_bytes = device.PeakReservedBytes();
+  return result;
+}
+
+// The peak of the memory patterns the planner would place the allocations of the trace at, as if it were a single
+// run, and the lower bound given by their lifetimes.
+void PlanPatterns(const AllocationTrace& trace, uint16_t allocator_id, size_t& online_peak, size_t& greedy_peak,
+                  size_t& lower_bound) {
+  constexpr size_t kAlignment = 256;
+  MemPatternPlanner online(false, MemPatternPlannerAlgorithm::kOnline);
+  MemPatternPlanner greedy(false, MemPatternPlannerAlgorithm::kGreedyBySize);
+  std::unordered_map<uint64_t, int> live_indices;
+  int next_index = 0;
+  for (const auto& event : trace.events) {
+    if (event.allocator_id != allocator_id) {
+      continue;
+    }
+    if (event.type == AllocationTraceEvent::Type::kFree) {
+      auto it = live_indices.find(event.address);
+      if (it != live_indices.end()) {
+        online.TraceFree(it->second);
+        greedy.TraceFree(it->second);
+        live_indices.erase(it);
+      }
+    } else {
+      const auto size = static_cast<size_t>((event.size + kAlignment - 1) / kAlignment * kAlignment);
+      online.TraceAllocation(next_index, size);
+      greedy.TraceAllocation(next_index, size);
+      live_indices[event.address] = next_index++;
+    }
+  }
+
+  online_peak = online.GenerateMemPattern().PeakSize();
+  const MemoryPattern greedy_pattern = greedy.GenerateMemPattern();
+  greedy_peak = greedy_pattern.PeakSize();
+  lower_bound = greedy_pattern.LowerBoundSize();
+}
+
+std::string FormatMB(double bytes) {
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(2) << bytes / (1024.0 * 1024.0);
+  return ss.str();
+}
+
+void Usage(const char* program) {
+  std::cerr << "Usage: " << program << " --trace=<file> [--allocator=<name>] "
+            << "[--arena=<label>:<key>=<value>,...]... [--planner]" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string trace_path;
+  std::string allocator_name;
+  std::vector<std::string> arena_specs;
+  bool plan_patterns = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg.rfind("--trace=", 0) == 0) {
+      trace_path = arg.substr(8);
+    } else if (arg.rfind("--allocator=", 0) == 0) {
+      allocator_name = arg.substr(12);
+    } else if (arg.rfind("--arena=", 0) == 0) {
+      arena_specs.push_back(arg.substr(8));
+    } else if (arg == "--planner") {
+      plan_patterns = true;
+    } else {
+      Usage(argv[0]);
+      return -1;
+    }
+  }
+  if (trace_path.empty()) {
+    Usage(argv[0]);
+    return -1;
+  }
+
+  // the arenas log through the default logger
+  logging::LoggingManager logging_manager(std::make_unique<logging::CLogSink>(), logging::Severity::kWARNING, false,
+                                          logging::LoggingManager::InstanceType::Default);
+
+  AllocationTrace trace;
+  auto status = AllocationTrace::Load(trace_path, trace);
+  if (!status.IsOK()) {
+    std::cerr << status.ErrorMessage() << std::endl;
+    return -1;
+  }
+
+  for (uint16_t id = 0; id < trace.allocators.size(); ++id) {
+    const auto& allocator = trace.allocators[id];
+    if (!allocator_name.empty() && allocator.name != allocator_name) {
+      continue;
+    }
+
+    std::vector<ArenaConfig> configs{{"recorded", allocator.config}};
+    if (arena_specs.empty()) {
+      ArenaConfig other_strategy{"same_as_requested", allocator.config};
+      if (allocator.config.arena_extend_strategy == static_cast<int>(ArenaExtendStrategy::kSameAsRequested)) {
+        other_strategy = {"next_power_of_two", allocator.config};
+        other_strategy.config.arena_extend_strategy = static_cast<int>(ArenaExtendStrategy::kNextPowerOfTwo);
+      } else {
+        other_strategy.config.arena_extend_strategy = static_cast<int>(ArenaExtendStrategy::kSameAsRequested);
+      }
+      configs.push_back(other_strategy);
+    }
+    for (const auto& spec : arena_specs) {
+      ArenaConfig config;
+      if (!ParseArenaConfig(spec, allocator.config, config)) {
+        std::cerr << "Invalid arena configuration: " << spec << std::endl;
+        return -1;
+      }
+      configs.push_back(config);
+    }
+
+    const auto num_events = std::count_if(trace.events.begin(), trace.events.end(),
+                                          [id](const AllocationTraceEvent& event) { return event.allocator_id == id; });
+    std::cout << "Allocator " << id << " '" << allocator.name << "': " << num_events << " events\n"
+              << std::left << std::setw(24) << "config" << std::right << std::setw(18) << "peak reserved MB"
+              << std::setw(16) << "peak in use MB" << std::setw(12) << "overhead" << std::setw(16)
+              << "ext. frag." << std::setw(12) << "extensions" << std::setw(10) << "failed" << "\n";
+    for (const auto& config : configs) {
+      const ReplayResult result = Replay(trace, id, config.config);
+      const double overhead = result.peak_bytes_in_use == 0
+                                  ? 0.0
+                                  : static_cast<double>(result.peak_reserved_bytes) / result.peak_bytes_in_use - 1.0;
+      std::cout << std::left << std::setw(24) << config.label << std::right << std::setw(18)
+                << FormatMB(static_cast<double>(result.peak_reserved_bytes)) << std::setw(16)
+                << FormatMB(static_cast<double>(result.peak_bytes_in_use)) << std::setw(11) << std::fixed
+                << std::setprecision(1) << overhead * 100.0 << "%" << std::setw(15)
+                << result.external_fragmentation_at_peak * 100.0 << "%" << std::setw(12) << result.num_extensions
+                << std::setw(10) << result.num_failed_allocations << "\n";
+    }
+
+    if (plan_patterns) {
+      size_t online_peak = 0;
+      size_t greedy_peak = 0;
+      size_t lower_bound = 0;
+      PlanPatterns(trace, id, online_peak, greedy_peak, lower_bound);
+      std::cout << "Memory patterns: online " << FormatMB(static_cast<double>(online_peak)) << " MB, greedy_by_size "
+                << FormatMB(static_cast<double>(greedy_peak)) << " MB, lower bound "
+                << FormatMB(static_cast<double>(lower_bound)) << " MB\n";
+    }
+    std::cout << std::endl;
+  }
+  return 0;
+}
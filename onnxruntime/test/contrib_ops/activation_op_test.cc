@@ -4,6 +4,7 @@
 #include "core/providers/cpu/activation/activations.h"
 #include "gtest/gtest.h"
 #include "core/common/cpuid_info.h"
+#include "test/common/tensor_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/cpu/activation/activation_op_test.h"
 #include <random>
@@ -147,5 +148,62 @@ TEST_F(ActivationOpTest, QuickGelu) {
   }
 }
 
+TEST(ElementwiseChainTest, BinaryAndActivationSteps) {
+  const std::vector<int64_t> dims{2, 3};
+  const std::vector<float> x{-2.f, -1.f, 0.f, 0.5f, 1.f, 3.f};
+  const std::vector<float> bias{1.f, 0.5f, -0.5f, 2.f, -1.f, 0.25f};
+  const float scale = 2.f;
+
+  // Tanh(scale - Relu(x + bias))
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    y[i] = std::tanh(scale - std::max(x[i] + bias[i], 0.f));
+  }
+
+  OpTester test("ElementwiseChain", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Relu", "Sub", "Tanh"});
+  test.AddAttribute<std::vector<int64_t>>("operand_first", {0, 0, 1, 0});
+  test.AddInput<float>("X", dims, x);
+  test.AddInput<float>("bias", dims, bias);
+  test.AddInput<float>("scale", {1}, {scale});
+  test.AddOutput<float>("Y", dims, y);
+  test.Run();
+}
+
+#if defined(USE_CUDA)
+TEST(ElementwiseChainTest, Float16OnCuda) {
+  const std::vector<int64_t> dims{2, 3};
+  const std::vector<float> x{-2.f, -1.f, 0.f, 0.5f, 1.f, 3.f};
+  const std::vector<float> scale{0.5f, 2.f, 1.f, -1.f, 0.25f, 1.5f};
+
+  // Softsign(Sigmoid(x) * scale) / 2
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    const float z = scale[i] / (1.f + std::exp(-x[i]));
+    y[i] = z / (1.f + std::abs(z)) / 2.f;
+  }
+
+  OpTester test("ElementwiseChain", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Sigmoid", "Mul", "Softsign", "Div"});
+  test.AddInput<MLFloat16>("X", dims, ToFloat16(x));
+  test.AddInput<MLFloat16>("scale", dims, ToFloat16(scale));
+  test.AddInput<MLFloat16>("divisor", {}, ToFloat16({2.f}));
+  test.AddOutput<MLFloat16>("Y", dims, ToFloat16(y), false, 0.f, 0.005f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+#endif
+
+TEST(ElementwiseChainTest, InvalidOperandShape) {
+  OpTester test("ElementwiseChain", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Sigmoid", "Sub"});
+  test.AddInput<float>("X", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("B", {2}, {1.f, 2.f});
+  test.AddOutput<float>("Y", {2, 2}, {0.f, 0.f, 0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "which is neither");
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1629,6 +1629,71 @@ TEST(AttentionTest, AttentionUnidirectionalAttentionMask) {
                    AttentionMaskType::MASK_2D_KEY_PADDING);
 }
 
+// The CPU kernel computes long sequences block by block with an online softmax.
+TEST(AttentionTest, AttentionUnidirectionalAttentionMaskLongSequence) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 520;
+  constexpr int hidden_size = 4;
+  constexpr int number_of_heads = 2;
+  constexpr int head_size = hidden_size / number_of_heads;
+
+  RandomValueGenerator random{123};
+  std::vector<int64_t> input_dims{batch_size, sequence_length, hidden_size};
+  std::vector<float> input_data = random.Uniform<float>(input_dims, -2.0f, 2.0f);
+
+  // Q, K and V are the input.
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size, 0.0f);
+  for (int i = 0; i < hidden_size; i++) {
+    for (int j = 0; j < 3; j++) {
+      weight_data[i * 3 * hidden_size + j * hidden_size + i] = 1.0f;
+    }
+  }
+  std::vector<float> bias_data(3 * hidden_size, 0.0f);
+
+  // The second batch has right padding.
+  std::vector<int32_t> mask_index_data(batch_size * sequence_length, 1);
+  std::fill(mask_index_data.begin() + sequence_length + 300, mask_index_data.end(), 0);
+
+  std::vector<float> output_data(batch_size * sequence_length * hidden_size);
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      auto head = [&](int s) { return input_data.data() + (b * sequence_length + s) * hidden_size + n * head_size; };
+      for (int s = 0; s < sequence_length; s++) {
+        std::vector<double> scores(s + 1);
+        double max_score = std::numeric_limits<double>::lowest();
+        for (int t = 0; t <= s; t++) {
+          double score = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            score += head(s)[h] * head(t)[h];
+          }
+          scores[t] = score * scale + (mask_index_data[b * sequence_length + t] ? 0.0 : -10000.0);
+          max_score = std::max(max_score, scores[t]);
+        }
+
+        double sum = 0.0;
+        std::vector<double> output(head_size, 0.0);
+        for (int t = 0; t <= s; t++) {
+          double p = std::exp(scores[t] - max_score);
+          sum += p;
+          for (int h = 0; h < head_size; h++) {
+            output[h] += p * head(t)[h];
+          }
+        }
+        float* dest = output_data.data() + (b * sequence_length + s) * hidden_size + n * head_size;
+        for (int h = 0; h < head_size; h++) {
+          dest[h] = static_cast<float>(output[h] / sum);
+        }
+      }
+    }
+  }
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads,
+                   false, true, false, 0, nullptr, nullptr, AttentionMaskType::MASK_2D_KEY_PADDING, 0, 0,
+                   false, true, true, true);
+}
+
 TEST(AttentionTest, AttentionWithNormFactor) {
   int batch_size = 2;
   int sequence_length = 2;
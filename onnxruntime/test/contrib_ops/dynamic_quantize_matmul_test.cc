@@ -3,6 +3,7 @@
 
 #include "core/common/span_utils.h"
 #include "core/framework/tensor.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/framework/test_utils.h"
@@ -12,6 +13,8 @@
 #include "core/util/qmath.h"
 
 #include <chrono>
+#include <cmath>
+#include <numeric>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -205,5 +208,94 @@ TEST(DynamicQuantizeMatMul, B_PerColumn_ND) {
   test_case({15, 14, 13}, {15, 13, 27}, {15, 1, 27});
 }
 
+// Checks DynamicQuantizeMatMul against a reference that quantizes A with a scale and zero point per row.
+template <typename T>
+void TestDynamicQuantizeMatMulPerRow(const std::vector<int64_t>& A_dims,
+                                     const std::vector<int64_t>& B_dims,
+                                     bool is_matrix_b_constant,
+                                     bool per_column,
+                                     bool has_bias) {
+  RandomValueGenerator random{};
+  const int64_t K = B_dims[0];
+  const int64_t N = B_dims[1];
+  const int64_t M = std::accumulate(A_dims.begin(), A_dims.end() - 1, int64_t{1}, std::multiplies<int64_t>());
+
+  // give the rows different ranges
+  std::vector<float> A_data = random.Uniform<float>(A_dims, -1.0f, 1.0f);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t k = 0; k < K; k++) {
+      A_data[m * K + k] *= static_cast<float>(m + 1);
+    }
+  }
+
+  std::vector<T> B_data;
+  std::vector<int> tmp_B_data = random.Uniform<int32_t>(B_dims, std::numeric_limits<T>::min(),
+                                                        std::numeric_limits<T>::max());
+  std::transform(tmp_B_data.begin(), tmp_B_data.end(), std::back_inserter(B_data), [](int32_t v) -> T {
+    return static_cast<T>(v);
+  });
+
+  const int64_t b_scale_zp_size = per_column ? N : 1;
+  std::vector<float> B_scale = random.Uniform<float>(AsSpan({b_scale_zp_size}), -0.1f, 0.1f);
+  std::vector<T> B_zero_point;
+  std::vector<int> tmp_B_zero_point = random.Uniform<int32_t>(AsSpan({b_scale_zp_size}),
+                                                              std::numeric_limits<T>::min(),
+                                                              std::numeric_limits<T>::max());
+  std::transform(tmp_B_zero_point.begin(), tmp_B_zero_point.end(), std::back_inserter(B_zero_point),
+                 [](int32_t v) -> T { return static_cast<T>(v); });
+  std::vector<float> Bias = random.Uniform<float>(AsSpan({N}), -0.1f, 0.1f);
+
+  std::vector<float> Y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    const float* row = A_data.data() + m * K;
+    const float min = std::min(0.0f, *std::min_element(row, row + K));
+    const float max = std::max(0.0f, *std::max_element(row, row + K));
+    const float a_scale = max == min ? 1.0f : (max - min) / 255.0f;
+    const float a_zp = std::nearbyint(std::max(0.0f, std::min(255.0f, -min / a_scale)));
+    for (int64_t n = 0; n < N; n++) {
+      const int64_t q = per_column ? n : 0;
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        const float a_quant = std::max(0.0f, std::min(255.0f, std::nearbyint(row[k] / a_scale) + a_zp));
+        sum += (static_cast<int32_t>(a_quant) - static_cast<int32_t>(a_zp)) *
+               (static_cast<int32_t>(B_data[k * N + n]) - static_cast<int32_t>(B_zero_point[q]));
+      }
+      Y_data[m * N + n] = static_cast<float>(sum) * a_scale * B_scale[q] + (has_bias ? Bias[n] : 0.0f);
+    }
+  }
+
+  std::vector<int64_t> Y_dims(A_dims);
+  Y_dims.back() = N;
+
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", A_dims, A_data);
+  test.AddInput<T>("B", B_dims, B_data, is_matrix_b_constant);
+  test.AddInput<float>("b_scale", {b_scale_zp_size}, B_scale, is_matrix_b_constant);
+  test.AddInput<T>("b_zero_point", {b_scale_zp_size}, B_zero_point, is_matrix_b_constant);
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, Bias);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+  test.AddOutput<float>("Y", Y_dims, Y_data);
+  // the reference applies the scales in a different order
+  test.SetOutputAbsErr("Y", 0.05f);
+
+  CPUExecutionProviderInfo info;
+  info.dynamic_quantize_matmul_per_row = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(DynamicQuantizeMatMul, PerRowQuantization) {
+  for (bool is_matrix_b_constant : {false, true}) {
+    TestDynamicQuantizeMatMulPerRow<uint8_t>({6, 64}, {64, 40}, is_matrix_b_constant, false, false);
+    TestDynamicQuantizeMatMulPerRow<uint8_t>({2, 3, 64}, {64, 40}, is_matrix_b_constant, true, true);
+    TestDynamicQuantizeMatMulPerRow<int8_t>({6, 64}, {64, 40}, is_matrix_b_constant, true, false);
+    TestDynamicQuantizeMatMulPerRow<int8_t>({2, 3, 64}, {64, 40}, is_matrix_b_constant, false, true);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
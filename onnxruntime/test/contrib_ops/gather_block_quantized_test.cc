@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Builds a random quantized table of N rows of K elements, and the dequantized rows gathered by `indices`.
+template <typename Tind>
+void RunGatherBlockQuantizedTest(int64_t bits, int64_t block_size, int64_t N, int64_t K,
+                                 const std::vector<int64_t>& indices_dims, const std::vector<Tind>& indices,
+                                 bool has_zero_points) {
+  const int64_t blocks_per_row = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size / 8 * bits;
+  const int64_t block_count = N * blocks_per_row;
+  const int max_q = (1 << bits) - 1;
+
+  RandomValueGenerator random{1234};
+  std::vector<int32_t> q_vals(random.Uniform<int32_t>(std::vector<int64_t>({N, K}), 0, max_q + 1));
+  std::vector<float> scales(random.Uniform<float>(std::vector<int64_t>({block_count}), 0.01f, 0.1f));
+  std::vector<int32_t> zp_vals(random.Uniform<int32_t>(std::vector<int64_t>({block_count}), 0, max_q + 1));
+
+  std::vector<uint8_t> data(block_count * blob_size, 0);
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t k = 0; k < K; k++) {
+      const auto q = static_cast<uint8_t>(q_vals[n * K + k]);
+      uint8_t* blob = data.data() + (n * blocks_per_row + k / block_size) * blob_size;
+      const int64_t i = k % block_size;
+      if (bits == 4) {
+        blob[i / 2] |= (i & 1) ? (q << 4) : q;
+      } else {
+        blob[i] = q;
+      }
+    }
+  }
+
+  std::vector<uint8_t> zero_points;
+  if (bits == 4) {
+    zero_points.resize((block_count + 1) / 2, 0);
+    for (int64_t i = 0; i < block_count; i++) {
+      zero_points[i / 2] |= static_cast<uint8_t>((i & 1) ? (zp_vals[i] << 4) : zp_vals[i]);
+    }
+  } else {
+    zero_points.assign(zp_vals.begin(), zp_vals.end());
+  }
+
+  std::vector<int64_t> output_dims = indices_dims;
+  output_dims.push_back(K);
+  std::vector<float> expected_vals;
+  for (Tind index : indices) {
+    const int64_t n = index < 0 ? index + N : index;
+    for (int64_t k = 0; k < K; k++) {
+      const int64_t block_idx = n * blocks_per_row + k / block_size;
+      const int32_t zp = has_zero_points ? zp_vals[block_idx] : (1 << (bits - 1));
+      expected_vals.push_back(scales[block_idx] * static_cast<float>(q_vals[n * K + k] - zp));
+    }
+  }
+
+  OpTester test("GatherBlockQuantized", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<uint8_t>("data", {N, blocks_per_row, blob_size}, data, true);
+  test.AddInput<Tind>("indices", indices_dims, indices);
+  test.AddInput<float>("scales", {block_count}, scales, true);
+  if (has_zero_points) {
+    test.AddInput<uint8_t>("zero_points", {static_cast<int64_t>(zero_points.size())}, zero_points, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+  test.AddOutput<float>("output", output_dims, expected_vals);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(GatherBlockQuantizedTest, Int4) {
+  RunGatherBlockQuantizedTest<int64_t>(4, 16, 9, 32, {4}, {0, 8, 3, 3}, true);
+  RunGatherBlockQuantizedTest<int64_t>(4, 32, 7, 20, {2, 3}, {6, -1, 2, -7, 0, 5}, true);
+  RunGatherBlockQuantizedTest<int32_t>(4, 16, 5, 37, {3}, {4, 1, -2}, false);
+}
+
+TEST(GatherBlockQuantizedTest, Int8) {
+  RunGatherBlockQuantizedTest<int64_t>(8, 16, 9, 48, {4}, {0, 8, 3, 3}, true);
+  RunGatherBlockQuantizedTest<int32_t>(8, 64, 6, 70, {2, 2}, {5, -6, 1, 1}, true);
+  RunGatherBlockQuantizedTest<int64_t>(8, 32, 3, 33, {2}, {2, -3}, false);
+}
+
+TEST(GatherBlockQuantizedTest, EmptyIndices) {
+  RunGatherBlockQuantizedTest<int64_t>(4, 16, 4, 16, {0}, {}, true);
+}
+
+TEST(GatherBlockQuantizedTest, IndexOutOfBounds) {
+  OpTester test("GatherBlockQuantized", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", int64_t{16});
+  test.AddAttribute<int64_t>("bits", int64_t{4});
+  test.AddAttribute<int64_t>("block_size", int64_t{16});
+  test.AddInput<uint8_t>("data", {2, 1, 8}, std::vector<uint8_t>(16, 0x88));
+  test.AddInput<int64_t>("indices", {1}, {2});
+  test.AddInput<float>("scales", {2}, {1.0f, 1.0f});
+  test.AddOutput<float>("output", {1, 16}, std::vector<float>(16, 0.0f));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds", {}, nullptr,
+           &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
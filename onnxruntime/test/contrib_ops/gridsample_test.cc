@@ -35,6 +35,50 @@ TEST(GridsampleContribOpTest, gridsample_default) {
   test.Run();
 }
 
+TEST(GridsampleContribOpTest, gridsample_batch_channels) {
+  // the sampling locations are shared by all the channels of a batch: every channel is a scaled copy of the
+  // gridsample_default image, so every output channel is the same scaled copy of its output
+  const std::vector<float> image = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f,
+                                   8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f};
+  const std::vector<float> grid = {
+      -1.0000f, -1.0000f, -0.6000f, -1.0000f, -0.2000f, -1.0000f, 0.2000f, -1.0000f,
+      0.6000f, -1.0000f, 1.0000f, -1.0000f, -1.0000f, -0.6000f, -0.6000f, -0.6000f,
+      -0.2000f, -0.6000f, 0.2000f, -0.6000f, 0.6000f, -0.6000f, 1.0000f, -0.6000f,
+      -1.0000f, -0.2000f, -0.6000f, -0.2000f, -0.2000f, -0.2000f, 0.2000f, -0.2000f,
+      0.6000f, -0.2000f, 1.0000f, -0.2000f, -1.0000f, 0.2000f, -0.6000f, 0.2000f,
+      -0.2000f, 0.2000f, 0.2000f, 0.2000f, 0.6000f, 0.2000f, 1.0000f, 0.2000f,
+      -1.0000f, 0.6000f, -0.6000f, 0.6000f, -0.2000f, 0.6000f, 0.2000f, 0.6000f,
+      0.6000f, 0.6000f, 1.0000f, 0.6000f, -1.0000f, 1.0000f, -0.6000f, 1.0000f,
+      -0.2000f, 1.0000f, 0.2000f, 1.0000f, 0.6000f, 1.0000f, 1.0000f, 1.0000f};
+  const std::vector<float> sampled = {
+      0.0000f, 0.1500f, 0.5500f, 0.9500f, 1.3500f, 0.7500f,
+      0.6000f, 1.5000f, 2.3000f, 3.1000f, 3.9000f, 2.1000f,
+      2.2000f, 4.7000f, 5.5000f, 6.3000f, 7.1000f, 3.7000f,
+      3.8000f, 7.9000f, 8.7000f, 9.5000f, 10.3000f, 5.3000f,
+      5.4000f, 11.1000f, 11.9000f, 12.7000f, 13.5000f, 6.9000f,
+      3.0000f, 6.1500f, 6.5500f, 6.9500f, 7.3500f, 3.7500f};
+  constexpr int64_t N = 2;
+  constexpr int64_t C = 3;
+  std::vector<float> X, Grid, Y;
+  for (int64_t n = 0; n < N; n++) {
+    Grid.insert(Grid.end(), grid.begin(), grid.end());
+    for (int64_t c = 0; c < C; c++) {
+      const float scale = static_cast<float>(n * C + c + 1);
+      for (float v : image) X.push_back(v * scale);
+      for (float v : sampled) Y.push_back(v * scale);
+    }
+  }
+
+  OpTester test("GridSample", 1, kMSDomain);
+  test.AddInput<float>("X", {N, C, 4, 4}, X);
+  test.AddInput<float>("Grid", {N, 6, 6, 2}, Grid);
+  test.AddAttribute("mode", "bilinear");
+  test.AddAttribute("padding_mode", "zeros");
+  test.AddAttribute("align_corners", static_cast<int64_t>(0));
+  test.AddOutput<float>("Y", {N, C, 6, 6}, Y);
+  test.Run();
+}
+
 TEST(GridsampleContribOpTest, gridsample_paddingmode_zeros) {
   OpTester test("GridSample", 1, kMSDomain);
   test.AddInput<float>("X", {1, 1, 3, 2}, {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
@@ -59,7 +59,8 @@ void QuantizeDequantize(std::vector<float>& raw_vals,
       tp.get());
 }
 
-void RunTest(int64_t M, int64_t N, int64_t K, int64_t block_size, bool has_zeropoint, bool use_float16) {
+void RunTest(int64_t M, int64_t N, int64_t K, int64_t block_size, bool has_zeropoint, bool use_float16,
+             int64_t accuracy_level = 0) {
   RandomValueGenerator random{1234};
   std::vector<float> input0_vals(random.Gaussian<float>(std::vector<int64_t>({M, K}), 0.0f, 0.25f));
   std::vector<float> input1_f_vals(random.Gaussian<float>(std::vector<int64_t>({K, N}), 0.0f, 0.25f));
@@ -101,6 +102,7 @@ void RunTest(int64_t M, int64_t N, int64_t K, int64_t block_size, bool has_zerop
   test.AddAttribute<int64_t>("N", N);
   test.AddAttribute<int64_t>("block_size", block_size);
   test.AddAttribute<int64_t>("bits", 4);
+  test.AddAttribute<int64_t>("accuracy_level", accuracy_level);
   if (use_float16) {
     test.AddInput<MLFloat16>("A", {M, K}, ToFloat16(input0_vals), false);
     test.AddInput<uint8_t>("B", {N, block_per_k, block_blob_size}, input1_vals, true);
@@ -124,6 +126,10 @@ void RunTest(int64_t M, int64_t N, int64_t K, int64_t block_size, bool has_zerop
     }
 
     test.AddOutput<float>("Y", {M, N}, expected_vals);
+    if (accuracy_level == 4) {
+      // A may be quantized to int8 blocks
+      test.SetOutputAbsErr("Y", 0.1f);
+    }
 
     test.Run();
   }
@@ -142,6 +148,19 @@ TEST(MatMulNBits, Float32) {
   }
 }
 
+TEST(MatMulNBits, Float32_AccuracyLevel4) {
+  for (auto M : {1, 2, 100}) {
+    for (auto N : {1, 32, 288}) {
+      for (auto K : {32, 128, 93, 1234}) {
+        for (auto block_size : {32, 64, 128}) {
+          RunTest(M, N, K, block_size, false, false, 4);
+          RunTest(M, N, K, block_size, true, false, 4);
+        }
+      }
+    }
+  }
+}
+
 #if defined(USE_CUDA)
 TEST(MatMulNBits, Float16) {
   for (auto M : {1, 2, 100}) {
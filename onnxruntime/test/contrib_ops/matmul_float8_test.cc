@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD) && !defined(DISABLE_FLOAT8_TYPES)
+
+#include "core/framework/float8.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+template <typename T>
+void RunMatMulFloat8Test(const std::vector<int64_t>& a_dims, int64_t N, bool per_column_scale, bool has_bias) {
+  const int64_t K = a_dims.back();
+  int64_t M = 1;
+  for (size_t i = 0; i + 1 < a_dims.size(); i++) {
+    M *= a_dims[i];
+  }
+
+  RandomValueGenerator random{1234};
+  std::vector<float> a_vals(random.Gaussian<float>(std::vector<int64_t>({M, K}), 0.0f, 0.25f));
+  std::vector<float> b_f_vals(random.Gaussian<float>(std::vector<int64_t>({K, N}), 0.0f, 1.0f));
+  std::vector<float> scale(random.Uniform<float>(std::vector<int64_t>({per_column_scale ? N : 1}), 0.01f, 0.1f));
+  std::vector<float> bias(random.Gaussian<float>(std::vector<int64_t>({N}), 0.0f, 0.5f));
+
+  std::vector<T> b_vals;
+  b_vals.reserve(b_f_vals.size());
+  for (float value : b_f_vals) {
+    b_vals.push_back(T(value, true));
+  }
+
+  std::vector<float> expected_vals(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_vals[m * K + k] * b_vals[k * N + n].ToFloat();
+      }
+      sum *= scale[per_column_scale ? n : 0];
+      expected_vals[m * N + n] = has_bias ? sum + bias[n] : sum;
+    }
+  }
+
+  std::vector<int64_t> y_dims(a_dims);
+  y_dims.back() = N;
+
+  OpTester test("MatMulFloat8", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddInput<float>("A", a_dims, a_vals);
+  test.AddInput<T>("B", {K, N}, b_vals, true);
+  if (per_column_scale) {
+    test.AddInput<float>("B_scale", {N}, scale, true);
+  } else {
+    test.AddInput<float>("B_scale", {}, scale, true);
+  }
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, bias, true);
+  } else {
+    test.AddOptionalInputEdge<float>();
+  }
+  test.AddOutput<float>("Y", y_dims, expected_vals);
+  test.SetOutputAbsErr("Y", 0.001f);
+  test.Run();
+}
+
+template <typename T>
+void RunMatMulFloat8Tests() {
+  for (auto M : {1, 2, 37}) {
+    for (auto N : {1, 32, 288}) {
+      for (auto K : {16, 93, 600}) {
+        RunMatMulFloat8Test<T>({M, K}, N, false, false);
+        RunMatMulFloat8Test<T>({M, K}, N, true, true);
+      }
+    }
+  }
+  RunMatMulFloat8Test<T>({2, 3, 64}, 130, true, false);
+  RunMatMulFloat8Test<T>({64, 300}, 8, false, true);
+}
+
+TEST(MatMulFloat8, Float8E4M3FN) {
+  RunMatMulFloat8Tests<Float8E4M3FN>();
+}
+
+TEST(MatMulFloat8, Float8E4M3FNUZ) {
+  RunMatMulFloat8Tests<Float8E4M3FNUZ>();
+}
+
+TEST(MatMulFloat8, Float8E5M2) {
+  RunMatMulFloat8Tests<Float8E5M2>();
+}
+
+TEST(MatMulFloat8, Float8E5M2FNUZ) {
+  RunMatMulFloat8Tests<Float8E5M2FNUZ>();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD) && !defined(DISABLE_FLOAT8_TYPES)
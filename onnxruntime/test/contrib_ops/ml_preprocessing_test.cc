@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(MLPreprocessingTest, ImputerScalerNormalizer) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<int64_t> dims{3, 2};
+  const std::vector<float> x{1.f, nan, nan, 4.f, 3.f, -2.f};
+  const std::vector<float> imputed{10.f, 20.f};
+  const std::vector<float> offsets{1.f, 2.f};
+  const std::vector<float> scales{0.5f, 2.f};
+
+  // Normalizer(L2)(Scaler(Imputer(x)))
+  std::vector<float> y(x.size());
+  for (size_t r = 0; r < 3; ++r) {
+    float sum = 0.f;
+    for (size_t f = 0; f < 2; ++f) {
+      const float value = std::isnan(x[r * 2 + f]) ? imputed[f] : x[r * 2 + f];
+      y[r * 2 + f] = (value - offsets[f]) * scales[f];
+      sum += y[r * 2 + f] * y[r * 2 + f];
+    }
+    for (size_t f = 0; f < 2; ++f) {
+      y[r * 2 + f] /= std::sqrt(sum);
+    }
+  }
+
+  OpTester test("MLPreprocessing", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("stages", {"Imputer", "Scaler", "Normalizer"});
+  test.AddAttribute<std::vector<int64_t>>("value_counts", {3, 4, 0});
+  test.AddAttribute<std::vector<float>>("values", {nan, 10.f, 20.f, 1.f, 2.f, 0.5f, 2.f});
+  test.AddAttribute<std::vector<std::string>>("norms", {"L2"});
+  test.AddInput<float>("X", dims, x);
+  test.AddOutput<float>("Y", dims, y);
+  test.Run();
+}
+
+TEST(MLPreprocessingTest, BroadcastScalerBinarizer) {
+  OpTester test("MLPreprocessing", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("stages", {"Scaler", "Binarizer"});
+  test.AddAttribute<std::vector<int64_t>>("value_counts", {2, 1});
+  test.AddAttribute<std::vector<float>>("values", {1.f, 2.f, 0.5f});
+  test.AddInput<float>("X", {4}, {0.f, 1.f, 1.5f, 3.f});
+  test.AddOutput<float>("Y", {4}, {0.f, 0.f, 1.f, 1.f});
+  test.Run();
+}
+
+TEST(MLPreprocessingTest, BinarizerNaN) {
+  OpTester test("MLPreprocessing", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("stages", {"Scaler", "Binarizer"});
+  test.AddAttribute<std::vector<int64_t>>("value_counts", {2, 1});
+  test.AddAttribute<std::vector<float>>("values", {0.f, 1.f, 0.5f});
+  test.AddInput<float>("X", {1, 2}, {std::numeric_limits<float>::quiet_NaN(), 1.f});
+  test.AddOutput<float>("Y", {1, 2}, {0.f, 1.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input data of a Binarizer stage is NaN");
+}
+
+TEST(MLPreprocessingTest, InvalidScalerSize) {
+  OpTester test("MLPreprocessing", 1, kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("stages", {"Scaler", "Normalizer"});
+  test.AddAttribute<std::vector<int64_t>>("value_counts", {4, 0});
+  test.AddAttribute<std::vector<float>>("values", {0.f, 0.f, 1.f, 1.f});
+  test.AddAttribute<std::vector<std::string>>("norms", {"MAX"});
+  test.AddInput<float>("X", {1, 3}, {1.f, 2.f, 3.f});
+  test.AddOutput<float>("Y", {1, 3}, {0.f, 0.f, 0.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Either both scale and offset can be of feature size");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
+
 #include "core/platform/env_var_utils.h"
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
@@ -579,6 +581,69 @@ TEST(MultiHeadAttentionTest, SelfAttention_WithPastAndPresent_NoMask_NoRelPosBia
   RunMultiHeadAttentionTests(data, /*disable_cpu=*/false, /*disable_cuda=*/true);
 }
 
+TEST(MultiHeadAttentionTest, CrossAttention_PastKVSharedByBeams) {
+  // The beams of a batch attend the same encoder output, so the CPU kernel accepts a key and value of shape
+  // (batch_size, N, L, H) for a query of shape (batch_size * num_beams, S, D).
+  if (nullptr == DefaultCpuExecutionProvider().get()) {
+    return;
+  }
+
+  constexpr int batch_size = 2;
+  constexpr int num_beams = 3;
+  constexpr int num_heads = 2;
+  constexpr int head_size = 4;
+  constexpr int hidden_size = num_heads * head_size;
+  constexpr int kv_sequence_length = 5;
+
+  std::vector<float> query(batch_size * num_beams * hidden_size);
+  for (size_t i = 0; i < query.size(); i++) {
+    query[i] = static_cast<float>(i % 7) * 0.25f - 0.75f;
+  }
+  std::vector<float> key(batch_size * num_heads * kv_sequence_length * head_size);
+  std::vector<float> value(key.size());
+  for (size_t i = 0; i < key.size(); i++) {
+    key[i] = static_cast<float>(i % 5) * 0.5f - 1.0f;
+    value[i] = static_cast<float>(i % 11) * 0.125f;
+  }
+
+  std::vector<float> output(query.size());
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (int b = 0; b < batch_size * num_beams; b++) {
+    for (int n = 0; n < num_heads; n++) {
+      const float* q = query.data() + b * hidden_size + n * head_size;
+      const size_t kv_offset = (static_cast<size_t>(b / num_beams) * num_heads + n) * kv_sequence_length * head_size;
+      std::vector<float> probs(kv_sequence_length);
+      float sum = 0.0f;
+      for (int l = 0; l < kv_sequence_length; l++) {
+        float dot = 0.0f;
+        for (int h = 0; h < head_size; h++) {
+          dot += q[h] * key[kv_offset + l * head_size + h];
+        }
+        probs[l] = std::exp(dot * scale);
+        sum += probs[l];
+      }
+      for (int h = 0; h < head_size; h++) {
+        float out = 0.0f;
+        for (int l = 0; l < kv_sequence_length; l++) {
+          out += probs[l] / sum * value[kv_offset + l * head_size + h];
+        }
+        output[b * hidden_size + n * head_size + h] = out;
+      }
+    }
+  }
+
+  OpTester tester("MultiHeadAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(num_heads));
+  tester.AddInput<float>("query", {batch_size * num_beams, 1, hidden_size}, query);
+  tester.AddInput<float>("key", {batch_size, num_heads, kv_sequence_length, head_size}, key);
+  tester.AddInput<float>("value", {batch_size, num_heads, kv_sequence_length, head_size}, value);
+  tester.AddOutput<float>("output", {batch_size * num_beams, 1, hidden_size}, output, /*sort*/ false, 0.0f, 1e-5f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 // This test is disabled since it is not used in Whisper anymore, and it fails in ROCm.
 TEST(MultiHeadAttentionTest, DISABLED_CrossAttention_WithPastPassedInDirectly_NoMask) {
   // Whisper decoder cross attention with past_kv in place of current KV and no present_kv
@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+struct PagedAttentionTestCase {
+  int batch_size = 2;
+  int num_heads = 2;
+  int kv_num_heads = 1;
+  int head_size = 4;
+  int num_blocks = 4;
+  int block_size = 2;
+  int max_blocks_per_sequence = 2;
+  // sequence 0 is in blocks 2 and 0, sequence 1 in blocks 3 and 1
+  std::vector<int32_t> block_tables = {2, 0, 3, 1};
+  std::vector<int32_t> seqlens = {3, 2};
+};
+
+int64_t CacheOffset(const PagedAttentionTestCase& c, int b, int token, int kv_head) {
+  const int block = c.block_tables[b * c.max_blocks_per_sequence + token / c.block_size];
+  return ((static_cast<int64_t>(block) * c.kv_num_heads + kv_head) * c.block_size + token % c.block_size) *
+         c.head_size;
+}
+
+// Appends the new token to the caches and attends to the tokens of each sequence.
+void ComputeReference(const PagedAttentionTestCase& c, const std::vector<float>& query,
+                      const std::vector<float>& key, const std::vector<float>& value,
+                      std::vector<float>& key_cache, std::vector<float>& value_cache, std::vector<float>& output) {
+  const float scale = 1.0f / std::sqrt(static_cast<float>(c.head_size));
+  const int group_size = c.num_heads / c.kv_num_heads;
+  output.assign(static_cast<size_t>(c.batch_size) * c.num_heads * c.head_size, 0.0f);
+  for (int b = 0; b < c.batch_size; ++b) {
+    const int sequence_length = c.seqlens[b];
+    for (int kv_head = 0; kv_head < c.kv_num_heads; ++kv_head) {
+      const int64_t offset = CacheOffset(c, b, sequence_length - 1, kv_head);
+      for (int d = 0; d < c.head_size; ++d) {
+        key_cache[offset + d] = key[(b * c.kv_num_heads + kv_head) * c.head_size + d];
+        value_cache[offset + d] = value[(b * c.kv_num_heads + kv_head) * c.head_size + d];
+      }
+    }
+
+    for (int head = 0; head < c.num_heads; ++head) {
+      const int kv_head = head / group_size;
+      const float* q = query.data() + (b * c.num_heads + head) * c.head_size;
+      std::vector<float> logits(sequence_length);
+      for (int t = 0; t < sequence_length; ++t) {
+        const float* k = key_cache.data() + CacheOffset(c, b, t, kv_head);
+        float dot = 0.0f;
+        for (int d = 0; d < c.head_size; ++d) {
+          dot += q[d] * k[d];
+        }
+        logits[t] = dot * scale;
+      }
+      const float max = *std::max_element(logits.begin(), logits.end());
+      float sum = 0.0f;
+      for (auto& logit : logits) {
+        logit = std::exp(logit - max);
+        sum += logit;
+      }
+      float* out = output.data() + (b * c.num_heads + head) * c.head_size;
+      for (int t = 0; t < sequence_length; ++t) {
+        const float* v = value_cache.data() + CacheOffset(c, b, t, kv_head);
+        for (int d = 0; d < c.head_size; ++d) {
+          out[d] += logits[t] / sum * v[d];
+        }
+      }
+    }
+  }
+}
+
+void RunPagedAttentionTest(bool use_float16) {
+  if (!HasCudaEnvironment(use_float16 ? 530 : 0)) {
+    return;
+  }
+
+  PagedAttentionTestCase c;
+  const int64_t hidden_size = c.num_heads * c.head_size;
+  const int64_t kv_hidden_size = c.kv_num_heads * c.head_size;
+  const size_t cache_size = static_cast<size_t>(c.num_blocks) * c.kv_num_heads * c.block_size * c.head_size;
+
+  std::vector<float> query = ValueRange<float>(static_cast<size_t>(c.batch_size * hidden_size), -0.5f, 0.0625f);
+  std::vector<float> key = ValueRange<float>(static_cast<size_t>(c.batch_size * kv_hidden_size), 0.25f, -0.0625f);
+  std::vector<float> value = ValueRange<float>(static_cast<size_t>(c.batch_size * kv_hidden_size), 1.0f, 0.125f);
+  std::vector<float> key_cache = ValueRange<float>(cache_size, -1.0f, 0.0625f);
+  std::vector<float> value_cache = ValueRange<float>(cache_size, 2.0f, -0.125f);
+
+  std::vector<float> key_cache_out = key_cache;
+  std::vector<float> value_cache_out = value_cache;
+  std::vector<float> output;
+  ComputeReference(c, query, key, value, key_cache_out, value_cache_out, output);
+
+  OpTester tester("PagedAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", c.num_heads);
+  tester.AddAttribute<int64_t>("kv_num_heads", c.kv_num_heads);
+
+  const std::vector<int64_t> query_dims = {c.batch_size, 1, hidden_size};
+  const std::vector<int64_t> kv_dims = {c.batch_size, 1, kv_hidden_size};
+  const std::vector<int64_t> cache_dims = {c.num_blocks, c.kv_num_heads, c.block_size, c.head_size};
+  if (use_float16) {
+    tester.AddInput<MLFloat16>("query", query_dims, ToFloat16(query));
+    tester.AddInput<MLFloat16>("key", kv_dims, ToFloat16(key));
+    tester.AddInput<MLFloat16>("value", kv_dims, ToFloat16(value));
+    tester.AddInput<MLFloat16>("key_cache", cache_dims, ToFloat16(key_cache));
+    tester.AddInput<MLFloat16>("value_cache", cache_dims, ToFloat16(value_cache));
+  } else {
+    tester.AddInput<float>("query", query_dims, query);
+    tester.AddInput<float>("key", kv_dims, key);
+    tester.AddInput<float>("value", kv_dims, value);
+    tester.AddInput<float>("key_cache", cache_dims, key_cache);
+    tester.AddInput<float>("value_cache", cache_dims, value_cache);
+  }
+  tester.AddInput<int32_t>("block_tables", {c.batch_size, c.max_blocks_per_sequence}, c.block_tables);
+  tester.AddInput<int32_t>("seqlens", {c.batch_size}, c.seqlens);
+
+  if (use_float16) {
+    tester.AddOutput<MLFloat16>("output", query_dims, ToFloat16(output));
+    tester.AddOutput<MLFloat16>("key_cache_out", cache_dims, ToFloat16(key_cache_out));
+    tester.AddOutput<MLFloat16>("value_cache_out", cache_dims, ToFloat16(value_cache_out));
+    tester.SetOutputAbsErr("output", 0.005f);
+  } else {
+    tester.AddOutput<float>("output", query_dims, output);
+    tester.AddOutput<float>("key_cache_out", cache_dims, key_cache_out);
+    tester.AddOutput<float>("value_cache_out", cache_dims, value_cache_out);
+  }
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(PagedAttentionTest, GroupedHeadsFloat) {
+  RunPagedAttentionTest(false);
+}
+
+TEST(PagedAttentionTest, GroupedHeadsFloat16) {
+  RunPagedAttentionTest(true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -95,6 +95,51 @@ TEST(QLinearLookupTableBasedOperatorTests, QLinearSigmoid_UInt8) {
   std::fesetround(origin_round_mode);
 }
 
+TEST(QLinearLookupTableBasedOperatorTests, QLinearGelu_Int8) {
+  auto run_test = [](bool scales_and_zp_are_initializers) {
+    OpTester test("QLinearGelu", 1, onnxruntime::kMSDomain);
+    float X_scale = 0.025f;
+    float Y_scale = 1.0f / 64.0f;
+    int8_t Y_zero_point = -100;
+
+    std::vector<int64_t> dims = {16};
+    test.AddInput<int8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, -128, -110, -108, -100, -16, -17, -18, -1});
+    test.AddInput<float>("X_scale", {}, {X_scale}, scales_and_zp_are_initializers);
+    test.AddOptionalInputEdge<int8_t>();  // optional "X_zero_point" using default value here
+    test.AddInput<float>("Y_scale", {}, {Y_scale}, scales_and_zp_are_initializers);
+    test.AddInput<int8_t>("Y_zero_point", {}, {Y_zero_point}, scales_and_zp_are_initializers);
+    test.AddOutput<int8_t>("Y", dims,
+                           {-100, -83, -82, -81, -79, 42, 44, 103, -100, -101, -101, -101, -109, -109, -109, -101});
+    auto origin_round_mode = std::fegetround();
+    std::fesetround(FE_TONEAREST);
+    test.Run();
+    std::fesetround(origin_round_mode);
+  };
+
+  run_test(false);
+  run_test(true);
+}
+
+TEST(QLinearLookupTableBasedOperatorTests, QLinearGelu_UInt8) {
+  OpTester test("QLinearGelu", 1, onnxruntime::kMSDomain);
+  float X_scale = 0.025f;
+  uint8_t X_zero_point = 128;
+  float Y_scale = 1.0f / 64.0f;
+  uint8_t Y_zero_point = 16;
+
+  std::vector<int64_t> dims = {16};
+  test.AddInput<uint8_t>("X", dims, {0, 16, 17, 18, 19, 90, 91, 127, 128, 136, 137, 138, 216, 217, 218, 255});
+  test.AddInput<float>("X_scale", {}, {X_scale});
+  test.AddInput<uint8_t>("X_zero_point", {}, {X_zero_point});
+  test.AddInput<float>("Y_scale", {}, {Y_scale});
+  test.AddInput<uint8_t>("Y_zero_point", {}, {Y_zero_point});
+  test.AddOutput<uint8_t>("Y", dims, {16, 16, 16, 15, 15, 6, 5, 15, 16, 23, 24, 26, 155, 157, 158, 219});
+  auto origin_round_mode = std::fegetround();
+  std::fesetround(FE_TONEAREST);
+  test.Run();
+  std::fesetround(origin_round_mode);
+}
+
 // NNAPI can only take 0 as Y_zero_point
 TEST(QLinearLookupTableBasedOperatorTests, QLinearSigmoid_UInt8_0_Y_ZP) {
   auto run_test = [](bool scales_and_zp_are_initializers) {
@@ -11,6 +11,7 @@
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/util/qmath.h"
 #include "core/quantization/quantization.h"
 
@@ -1104,5 +1105,77 @@ TEST(QAttentionTest, SharedPrepackedWeights) {
 }
 #endif
 
+// Compares the int8 attention core of the CPU execution provider with the float attention core.
+template <typename WeightT>
+void TestQAttentionInt8Core(int64_t batch, int64_t seq_len, int64_t hidden_size, int64_t head_number,
+                            bool is_unidirectional, bool has_mask) {
+  RandomValueGenerator random{};
+
+  std::vector<int64_t> input_dims{batch, seq_len, hidden_size};
+  std::vector<uint8_t> input_data = random.Gaussian<uint8_t>(input_dims, 128, 40, 0, 255);
+
+  constexpr WeightT weight_mean = std::is_signed_v<WeightT> ? 0 : 128;
+  std::vector<int64_t> weight_dims{hidden_size, 3 * hidden_size};
+  std::vector<WeightT> weight_data = random.Gaussian<WeightT>(weight_dims, weight_mean, 40,
+                                                              std::numeric_limits<WeightT>::min(),
+                                                              std::numeric_limits<WeightT>::max());
+
+  std::vector<int64_t> bias_dims{3 * hidden_size};
+  std::vector<float> bias_data = random.Gaussian<float>(bias_dims, 0.0f, 0.3f);
+
+  // the last quarter of the sequence of each batch is padding
+  std::vector<int32_t> mask_index_data(batch, static_cast<int32_t>(seq_len - seq_len / 4));
+
+  auto add_inputs = [&](OpTester& test) {
+    test.AddAttribute<int64_t>("num_heads", head_number);
+    if (is_unidirectional) {
+      test.AddAttribute<int64_t>("unidirectional", 1);
+    }
+    test.AddInput<uint8_t>("input", input_dims, input_data);
+    test.AddInput<WeightT>("weight", weight_dims, weight_data, true);
+    test.AddInput<float>("bias", bias_dims, bias_data);
+    test.AddInput<float>("input_scale", {1}, {0.01f});
+    test.AddInput<float>("weight_scale", {1}, {0.01f});
+    if (has_mask) {
+      test.AddInput<int32_t>("mask_index", {batch}, mask_index_data);
+    } else {
+      test.AddOptionalInputEdge<int32_t>();
+    }
+    test.AddInput<uint8_t>("input_zero_point", {1}, {128});
+    test.AddInput<WeightT>("weight_zero_point", {1}, {weight_mean});
+  };
+
+  // we'll compare the output of the float core with the int8 core
+  OpTester reference("QAttention", 1, onnxruntime::kMSDomain);
+  add_inputs(reference);
+  reference.AddOutput<float>("output", input_dims, std::vector<float>(batch * seq_len * hidden_size));
+  reference.SetCustomOutputVerifier([](const std::vector<OrtValue>&, const std::string&) {});
+  std::vector<std::unique_ptr<IExecutionProvider>> reference_execution_providers;
+  reference_execution_providers.push_back(DefaultCpuExecutionProvider());
+  reference.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &reference_execution_providers);
+  std::vector<OrtValue> reference_outputs = reference.GetFetches();
+  ASSERT_EQ(reference_outputs.size(), 1u);
+  const float* expected_data = reference_outputs[0].Get<Tensor>().Data<float>();
+
+  OpTester test("QAttention", 1, onnxruntime::kMSDomain);
+  add_inputs(test);
+  test.AddOutput<float>("output", input_dims, expected_data, static_cast<size_t>(batch * seq_len * hidden_size));
+  // Q, K and V are quantized per head and the probabilities have 8 bits
+  test.SetOutputAbsErr("output", 0.15f);
+
+  CPUExecutionProviderInfo info;
+  info.qattention_int8_core = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(QAttentionTest, Int8Core) {
+  TestQAttentionInt8Core<uint8_t>(2, 16, 64, 4, false, false);
+  TestQAttentionInt8Core<int8_t>(2, 16, 64, 4, false, true);
+  TestQAttentionInt8Core<int8_t>(1, 37, 48, 2, true, false);
+  TestQAttentionInt8Core<uint8_t>(3, 5, 96, 3, true, true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
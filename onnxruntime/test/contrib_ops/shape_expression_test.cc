@@ -0,0 +1,39 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ShapeExpressionTest, DimsAndArithmetic) {
+  // [Dim(0, 0), Dim(0, 1) / 8, Dim(1, 0) * 3 - 1]
+  OpTester test("ShapeExpression", 1, kMSDomain);
+  test.AddAttribute<std::vector<int64_t>>("program", {1, 0, 0, 6,
+                                                      1, 0, 1, 0, 8, 5, 6,
+                                                      1, 1, 0, 0, 3, 4, 0, 1, 3, 6});
+  test.AddInput<float>("X", {2, 16}, std::vector<float>(32, 0.f));
+  test.AddInput<int64_t>("Y", {5}, {1, 2, 3, 4, 5});
+  test.AddOutput<int64_t>("Z", {3}, {2, 2, 14});
+  test.Run();
+}
+
+TEST(ShapeExpressionTest, MissingAxis) {
+  OpTester test("ShapeExpression", 1, kMSDomain);
+  test.AddAttribute<std::vector<int64_t>>("program", {1, 0, 2, 6});
+  test.AddInput<float>("X", {2, 16}, std::vector<float>(32, 0.f));
+  test.AddOutput<int64_t>("Z", {1}, {0});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Input 0 of ShapeExpression has no axis 2");
+}
+
+TEST(ShapeExpressionTest, DivisionByZero) {
+  OpTester test("ShapeExpression", 1, kMSDomain);
+  test.AddAttribute<std::vector<int64_t>>("program", {1, 0, 0, 1, 0, 1, 5, 6});
+  test.AddInput<float>("X", {2, 0}, {});
+  test.AddOutput<int64_t>("Z", {1}, {0});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Division by zero in ShapeExpression");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -677,6 +677,30 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }  // namespace test
 
+TEST(ContribOpTest, TokenizerWithSeparators_SingleCharSeparatorsWithMarkersNC) {
+  // Separators that are all single chars, escaped or not, are split on without regex matching
+  std::vector<std::string> separators = {u8" ", u8"\\.", u8","};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, true, separators, 2);
+
+  std::vector<int64_t> dims{2, 2};
+  std::vector<std::string> input{u8"ab cd.e", u8"Абв,г  中文", u8"x", u8"hello,world.foo bar"};
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(6));
+  std::vector<std::string> output{
+      start_mark, u8"ab", u8"cd", end_mark, padval, padval,
+      start_mark, u8"Абв", u8"中文", end_mark, padval, padval,
+      start_mark, end_mark, padval, padval, padval, padval,
+      start_mark, u8"hello", u8"world", u8"foo", u8"bar", end_mark};
+
+  test.AddOutput<std::string>("Y", output_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerExpression_RegEx) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp(u8"a.");
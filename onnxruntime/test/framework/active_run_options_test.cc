@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/active_run_options.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ActiveRunOptionsTest, FindDuringScope) {
+  RunOptions run_options;
+  ASSERT_TRUE(run_options.config_options.AddConfigEntry("generation.stream_callback", "1").IsOK());
+
+  EXPECT_EQ(ActiveRunOptions::Find(run_options.terminate), nullptr);
+  {
+    ActiveRunOptions::Scope scope(run_options);
+    EXPECT_EQ(ActiveRunOptions::Find(run_options.terminate), &run_options);
+    {
+      // another Run call with the same run options
+      ActiveRunOptions::Scope nested_scope(run_options);
+      EXPECT_EQ(ActiveRunOptions::Find(run_options.terminate), &run_options);
+    }
+    EXPECT_EQ(ActiveRunOptions::Find(run_options.terminate), &run_options);
+  }
+  EXPECT_EQ(ActiveRunOptions::Find(run_options.terminate), nullptr);
+}
+
+TEST(ActiveRunOptionsTest, NoRunConfiguration) {
+  RunOptions run_options;
+  ActiveRunOptions::Scope scope(run_options);
+  EXPECT_EQ(ActiveRunOptions::Find(run_options.terminate), nullptr);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -113,15 +113,19 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, bool enable_larger_buffer_reuse = false)
+      : shape_map_(shape_map), enable_larger_buffer_reuse_(enable_larger_buffer_reuse) {}
 
   TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  bool GetEnableLargerBufferReuse() const override { return enable_larger_buffer_reuse_; }
+
  private:
   ShapeMap* shape_map_;
+  bool enable_larger_buffer_reuse_;
 };
 
 class ParallelPlannerTestContext : public SequentialPlannerTestContext {
@@ -148,6 +152,7 @@ class PlannerTest : public ::testing::Test {
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;               // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;          // a unary kernel with in-place
   std::unique_ptr<::onnxruntime::KernelDef> external_outputs_kernel_;  // an unary kernel with external outputs
+  std::unique_ptr<::onnxruntime::KernelDef> may_view_output_kernel_;   // an unary kernel with may_view_output
 #ifdef ENABLE_STRIDED_TENSORS
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_input_kernel_;   // an uinary kernel with may_strided_input
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_output_kernel_;  // an unary kernel with may_strided_output
@@ -164,6 +169,7 @@ class PlannerTest : public ::testing::Test {
   std::unique_ptr<SessionOptions> sess_options_;
   std::unique_ptr<SessionState> state_;
   ShapeMap shape_map_;
+  bool enable_larger_buffer_reuse_{false};
   std::optional<SequentialExecutionPlan> plan_;
 
  public:
@@ -177,6 +183,12 @@ class PlannerTest : public ::testing::Test {
         KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayInplace(0, 0).Build();
     external_outputs_kernel_ =
         KernelDefBuilder().SetName("Tanh").Provider(kCpuExecutionProvider).SinceVersion(1, 10).ExternalOutputs().Build();
+    may_view_output_kernel_ = KernelDefBuilder()
+                                  .SetName("Sigmoid")
+                                  .Provider(kCpuExecutionProvider)
+                                  .SinceVersion(1, 10)
+                                  .MayViewOutput(0, 0)
+                                  .Build();
 #ifdef ENABLE_STRIDED_TENSORS
     may_strided_input_kernel_ = KernelDefBuilder()
                                     .SetName("Abs")
@@ -238,6 +250,10 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*external_outputs_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddMayViewOutputNode(std::string& input, std::string& output) {
+    return AddNode(*may_view_output_kernel_, input, output);
+  }
+
 #ifdef ENABLE_STRIDED_TENSORS
   onnxruntime::Node* AddMayStridedInputNode(std::string& input, std::string& output) {
     return AddNode(*may_strided_input_kernel_, input, output);
@@ -305,7 +321,7 @@ class PlannerTest : public ::testing::Test {
     status = state_->FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, {}, remove_initializers);
 
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, enable_larger_buffer_reuse_);
     plan_.emplace();
 
     class MockStreamHandleRegsitry : public IStreamCommandHandleRegistry {
@@ -343,6 +359,12 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckIsView(const std::string& name, bool is_view) {
+    int id;
+    index(name, id);
+    EXPECT_EQ(plan_->allocation_plan[id].is_view, is_view) << "Error in view for " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // TODO: add the checker for new implementation of release plan
     //// create set and check equality
@@ -372,6 +394,11 @@ class PlannerTest : public ::testing::Test {
     ORT_THROW_IF_ERROR(sess_options_->config_options.AddConfigEntry(kNodePartitionConfigFile, config_file_path));
   }
   std::unique_ptr<::onnxruntime::KernelDef>& GetStdKernel() { return std_kernel_; }
+  void EnableLargerBufferReuse() {
+    ORT_THROW_IF_ERROR(sess_options_->config_options.AddConfigEntry(kOrtSessionOptionsConfigAllowLargerBufferReuse,
+                                                                    "1"));
+    enable_larger_buffer_reuse_ = true;
+  }
 #ifdef USE_CUDA
   void MemcpyToHostInCuda_TransposeInCudaAndCpu(const char* partitionConfigFile = nullptr) {
     std::unique_ptr<::onnxruntime::KernelDef> cudaKernel = KernelDefBuilder().SetName("MemcpyToHost").Provider(kCudaExecutionProvider).SetDefaultOutputMemoryType(OrtMemTypeCPUOutput).Build();
@@ -433,6 +460,54 @@ TEST_F(PlannerTest, ChainTest) {
   CheckFreed(3, {"W"});
 }
 
+// A freed buffer that is larger than an output is only reused if larger buffer reuse is enabled.
+TEST_F(PlannerTest, LargerBufferReuseTest) {
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  AddNormalNode(X1, X2);
+  AddNormalNode(X2, X3);
+  AddNormalNode(X3, X4);
+  AddNormalNode(X4, X5);
+
+  Shape large_shape{50, 100}, small_shape{25, 100}, tiny_shape{10, 100};
+  SetShape({{X1, &large_shape.value}, {X2, &large_shape.value}, {X3, &small_shape.value},
+            {X4, &tiny_shape.value}, {X5, &small_shape.value}});
+
+  EnableLargerBufferReuse();
+  CreatePlan();
+
+  // X4 reuses X2, the only freed buffer. X5 is a graph output and is always allocated.
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  int x2_index = -1, x4_index = -1;
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X2, x2_index));
+  ASSERT_STATUS_OK(GetState().GetOrtValueNameIdxMap().GetIdx(X4, x4_index));
+  EXPECT_EQ(GetPlan().allocation_plan[x4_index].reused_buffer, x2_index);
+}
+
+TEST_F(PlannerTest, NoLargerBufferReuseByDefaultTest) {
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  AddNormalNode(X1, X2);
+  AddNormalNode(X2, X3);
+  AddNormalNode(X3, X4);
+  AddNormalNode(X4, X5);
+
+  Shape large_shape{50, 100}, small_shape{25, 100}, tiny_shape{10, 100};
+  SetShape({{X1, &large_shape.value}, {X2, &large_shape.value}, {X3, &small_shape.value},
+            {X4, &tiny_shape.value}, {X5, &small_shape.value}});
+
+  CreatePlan();
+
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
 /* InputOutputTest: Test that:
 (a) All inputs are classified as kPreExisting,
 (b) All outer scope node args are classified as kPreExisting,
@@ -529,6 +604,43 @@ TEST_F(PlannerTest, ExternalOutputsTest) {
   CheckFreed(2, {X1});
 }
 
+// MayViewTest: Check that an output that may be a view shares the buffer of its input, and that the buffer isn't
+// reused in-place through the view.
+TEST_F(PlannerTest, MayViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5"), X6("X6");
+
+  // graph structure:
+  AddNormalNode(X1, X2);         // X2: temporary
+  AddMayViewOutputNode(X2, X3);  // X3: view of X2
+  AddInplaceNode(X3, X4);        // may-in-place operator on the view; X4: temporary
+  AddNormalNode(X4, X5);         // X5: output
+  AddMayViewOutputNode(X1, X6);  // view as graph output; X6: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}, {X6, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kReuse);
+  CheckIsView(X3, true);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckIsView(X4, false);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+  CheckAllocKind(X6, AllocKind::kAllocateOutput);
+  CheckIsView(X6, false);
+
+  int x2_index, x3_index;
+  index(X2, x2_index);
+  index(X3, x3_index);
+  EXPECT_EQ(GetPlan().allocation_plan[x3_index].reused_buffer, x2_index);
+}
+
 #ifdef ENABLE_STRIDED_TENSORS
 TEST_F(PlannerTest, MayStridedTest1) {
   // tensor variables:
@@ -1935,6 +2047,91 @@ TEST_F(PlannerTest, TestMultiStreamMismatchDevice) {
   status = sess.Initialize();
   ASSERT_TRUE(!status.IsOK());
 }
+
+// Two independent towers joined by an Add. With session.max_cpu_streams set, each tower gets its own CPU stream.
+TEST_F(PlannerTest, TestCriticalPathPartition) {
+  auto graph_partitioner = IGraphPartitioner::CreateGraphPartitioner(DefaultLoggingManager().DefaultLogger(),
+                                                                     PathString{}, 2);
+  ASSERT_TRUE(graph_partitioner && strcmp(graph_partitioner->Type(), "CriticalPathPartitioner") == 0);
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64L);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64L);
+
+  onnxruntime::Model model("towers", false, ModelMetaData(),
+                           PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 14}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& main_graph = model.MainGraph();
+  auto& graph_in = main_graph.GetOrCreateNodeArg("graph_in", &tensor_type);
+  auto& graph_out = main_graph.GetOrCreateNodeArg("graph_out", &tensor_type);
+
+  std::vector<NodeArg*> tower_outs;
+  for (int tower = 0; tower < 2; ++tower) {
+    NodeArg* tower_in = &graph_in;
+    for (int layer = 0; layer < 2; ++layer) {
+      const std::string prefix = "tower_" + std::to_string(tower) + "_" + std::to_string(layer);
+      ONNX_NAMESPACE::TensorProto weight;
+      weight.add_dims(64L);
+      weight.add_dims(64L);
+      weight.set_data_type(TensorProto_DataType_FLOAT);
+      weight.set_name(prefix + "_weight");
+      for (int i = 0; i < 64 * 64; ++i) weight.add_float_data(0.01f * tower);
+      main_graph.AddInitializedTensor(weight);
+
+      auto& weight_arg = main_graph.GetOrCreateNodeArg(prefix + "_weight", &tensor_type);
+      auto& matmul_out = main_graph.GetOrCreateNodeArg(prefix + "_matmul_out", &tensor_type);
+      auto& relu_out = main_graph.GetOrCreateNodeArg(prefix + "_relu_out", &tensor_type);
+      main_graph.AddNode(prefix + "_matmul", "MatMul", "", {tower_in, &weight_arg}, {&matmul_out});
+      main_graph.AddNode(prefix + "_relu", "Relu", "", {&matmul_out}, {&relu_out});
+      tower_in = &relu_out;
+    }
+    tower_outs.push_back(tower_in);
+  }
+  main_graph.AddNode("add", "Add", "", {tower_outs[0], tower_outs[1]}, {&graph_out});
+
+  main_graph.SetInputs({&graph_in});
+  main_graph.SetOutputs({&graph_out});
+  ASSERT_STATUS_OK(main_graph.Resolve());
+
+  std::string model_str;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_str));
+
+  SessionOptions so;
+  so.graph_optimization_level = TransformerLevel::Default;
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.inter_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMaxCpuStreams, "2"));
+  InferenceSession sess{so, GetEnvironment()};
+  ASSERT_STATUS_OK(sess.RegisterExecutionProvider(DefaultCpuExecutionProvider()));
+  std::stringstream sstr(model_str);
+  ASSERT_STATUS_OK(sess.Load(sstr));
+  ASSERT_STATUS_OK(sess.Initialize());
+
+  const auto& graph = sess.GetSessionState().GetGraphViewer();
+  const auto& exe_plan = sess.GetSessionState().GetExecutionPlan()->execution_plan;
+  ASSERT_EQ(exe_plan.size(), 2u);
+
+  // the nodes of a tower are on the same stream and the towers are on different streams
+  InlinedHashMap<std::string, size_t> node_streams;
+  for (size_t i = 0; i < exe_plan.size(); ++i) {
+    ASSERT_EQ(exe_plan[i]->device_.Type(), OrtDevice::CPU);
+    for (const auto& step : exe_plan[i]->steps_) {
+      if (strstr(typeid(*step).name(), "LaunchKernelStep") != nullptr) {
+        node_streams[graph.GetNode(step->GetNodeIndex())->Name()] = i;
+      }
+    }
+  }
+  ASSERT_EQ(node_streams.size(), 9u);
+  for (int tower = 0; tower < 2; ++tower) {
+    const std::string prefix = "tower_" + std::to_string(tower) + "_";
+    const size_t stream = node_streams[prefix + "0_matmul"];
+    EXPECT_EQ(node_streams[prefix + "0_relu"], stream);
+    EXPECT_EQ(node_streams[prefix + "1_matmul"], stream);
+    EXPECT_EQ(node_streams[prefix + "1_relu"], stream);
+  }
+  EXPECT_NE(node_streams["tower_0_0_matmul"], node_streams["tower_1_0_matmul"]);
+}
 #endif
 
 #if defined(USE_CUDA) && defined(ORT_ENABLE_STREAM)
@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/framework/allocator.h"
+#include "core/framework/huge_page_allocator.h"
 
+#include "test/util/include/asserts.h"
 #include "test_utils.h"
 #include "gtest/gtest.h"
 
@@ -109,5 +111,36 @@ TEST(AllocatorTest, TestOverflowChecks) {
   EXPECT_TRUE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size - (kAllocAlignment / num_elements), &size));
   EXPECT_FALSE(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements, element_size, &size));
 }
+TEST(AllocatorTest, HugePageCPUAllocatorParseOptions) {
+  HugePageCPUAllocator::Options options;
+  ASSERT_STATUS_OK(HugePageCPUAllocator::ParseOptions("", "", "", options));
+  EXPECT_TRUE(options.IsDefault());
+
+  ASSERT_STATUS_OK(HugePageCPUAllocator::ParseOptions("2", "1", "", options));
+  EXPECT_EQ(options.huge_pages, HugePageCPUAllocator::HugePages::kExplicit);
+  EXPECT_EQ(options.numa_node, 1);
+
+  ASSERT_STATUS_NOT_OK(HugePageCPUAllocator::ParseOptions("3", "", "", options));
+  ASSERT_STATUS_NOT_OK(HugePageCPUAllocator::ParseOptions("", "-2", "", options));
+  ASSERT_STATUS_NOT_OK(HugePageCPUAllocator::ParseOptions("", "auto", "2-1", options));
+}
+
+TEST(AllocatorTest, HugePageCPUAllocatorTest) {
+  HugePageCPUAllocator::Options options;
+  options.huge_pages = HugePageCPUAllocator::HugePages::kTransparent;
+  options.numa_node = 0;
+  HugePageCPUAllocator allocator(options);
+  ASSERT_STREQ(allocator.Info().name, CPU);
+
+  for (size_t size : {size_t{1024}, HugePageCPUAllocator::kHugePageSize, 3 * HugePageCPUAllocator::kHugePageSize + 1}) {
+    void* p = allocator.Alloc(size);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+    memset(p, -1, size);
+    EXPECT_EQ(static_cast<unsigned char*>(p)[size - 1], 0xFF);
+    allocator.Free(p);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <chrono>
+#include <thread>
+
+#include "core/session/arena_shrinker.h"
+#include "test/util/include/asserts.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(ArenaShrinkerTest, ParseConfig) {
+  ArenaShrinker::Config config;
+  bool enabled = true;
+  ASSERT_STATUS_OK(ArenaShrinker::ParseConfig("", "", "", "", config, enabled));
+  EXPECT_FALSE(enabled);
+
+  ASSERT_STATUS_OK(ArenaShrinker::ParseConfig("0", "1000", "", "", config, enabled));
+  EXPECT_FALSE(enabled);
+
+  ASSERT_STATUS_OK(ArenaShrinker::ParseConfig("100", "1050", "500", "4096", config, enabled));
+  EXPECT_TRUE(enabled);
+  EXPECT_EQ(config.interval.count(), 100);
+  EXPECT_EQ(config.policy.idle_intervals, 11u) << "durations are rounded up to whole intervals";
+  EXPECT_EQ(config.policy.high_water_mark_intervals, 5u);
+  EXPECT_EQ(config.policy.soft_limit_bytes, 4096u);
+
+  ASSERT_STATUS_NOT_OK(ArenaShrinker::ParseConfig("-1", "", "", "", config, enabled));
+  ASSERT_STATUS_NOT_OK(ArenaShrinker::ParseConfig("100", "soon", "", "", config, enabled));
+}
+
+TEST(ArenaShrinkerTest, ShrinksInBackground) {
+  auto arena = std::make_shared<BFCArena>(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30,
+                                          ArenaExtendStrategy::kSameAsRequested);
+  void* p1k = arena->Alloc(1024);
+  arena->Free(arena->Alloc(1024 * 1024));
+
+  ArenaShrinker::Config config;
+  config.interval = std::chrono::milliseconds(1);
+  config.policy.idle_intervals = 1;
+
+  AllocatorStats stats;
+  {
+    ArenaShrinker shrinker(config, {arena}, OrtThreadPoolParams{});
+    for (int i = 0; i < 1000; ++i) {
+      arena->GetStats(&stats);
+      if (stats.num_arena_shrinkages > 0) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+
+  EXPECT_EQ(stats.num_arena_shrinkages, 1);
+  EXPECT_EQ(stats.total_allocated_bytes, 1024);
+  arena->Free(p1k);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
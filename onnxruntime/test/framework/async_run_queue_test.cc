@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "core/session/async_run_queue.h"
+#include "test/util/include/asserts.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(AsyncRunQueueTest, ParseConfig) {
+  AsyncRunQueue::Config config;
+  bool enabled = true;
+  ASSERT_STATUS_OK(AsyncRunQueue::ParseConfig("", "", config, enabled));
+  EXPECT_FALSE(enabled);
+
+  ASSERT_STATUS_OK(AsyncRunQueue::ParseConfig("0", "", config, enabled));
+  EXPECT_FALSE(enabled);
+
+  ASSERT_STATUS_OK(AsyncRunQueue::ParseConfig("2", "16", config, enabled));
+  EXPECT_TRUE(enabled);
+  EXPECT_EQ(config.num_threads, 2);
+  EXPECT_EQ(config.max_queue_size, 16u);
+
+  ASSERT_STATUS_NOT_OK(AsyncRunQueue::ParseConfig("-1", "", config, enabled));
+  ASSERT_STATUS_NOT_OK(AsyncRunQueue::ParseConfig("two", "", config, enabled));
+}
+
+TEST(AsyncRunQueueTest, RunsTasksOffCallerThread) {
+  std::atomic<int> num_completed{0};
+  std::atomic<bool> ran_on_caller{false};
+  const auto caller_tid = std::this_thread::get_id();
+  constexpr int num_tasks = 64;
+
+  {
+    AsyncRunQueue queue(AsyncRunQueue::Config{2, 0}, OrtThreadPoolParams{});
+    for (int i = 0; i < num_tasks; ++i) {
+      ASSERT_STATUS_OK(queue.Submit([&]() {
+        if (std::this_thread::get_id() == caller_tid) {
+          ran_on_caller = true;
+        }
+        ++num_completed;
+      }));
+    }
+    // the destructor drains the queue
+  }
+
+  EXPECT_EQ(num_completed, num_tasks);
+  EXPECT_FALSE(ran_on_caller);
+}
+
+TEST(AsyncRunQueueTest, RejectsTasksWhenFull) {
+  std::atomic<bool> release{false};
+  std::atomic<bool> started{false};
+  std::atomic<int> num_completed{0};
+
+  {
+    AsyncRunQueue queue(AsyncRunQueue::Config{1, 2}, OrtThreadPoolParams{});
+
+    // occupy the only thread
+    ASSERT_STATUS_OK(queue.Submit([&]() {
+      started = true;
+      while (!release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      ++num_completed;
+    }));
+
+    while (!started) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ASSERT_STATUS_OK(queue.Submit([&]() { ++num_completed; }));
+    ASSERT_STATUS_OK(queue.Submit([&]() { ++num_completed; }));
+    EXPECT_EQ(queue.NumPending(), 2u);
+
+    // backpressure: the third waiting task is rejected
+    ASSERT_STATUS_NOT_OK(queue.Submit([&]() { ++num_completed; }));
+
+    release = true;
+  }
+
+  EXPECT_EQ(num_completed, 3);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
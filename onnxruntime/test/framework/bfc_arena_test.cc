@@ -2,11 +2,17 @@
 // Licensed under the MIT License.
 
 #include "core/framework/bfc_arena.h"
+#include "core/framework/allocation_trace.h"
 #include "core/framework/allocator_utils.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
 #include "core/framework/stream_handles.h"
+#include "test/util/include/asserts.h"
 
 namespace onnxruntime {
 namespace test {
@@ -287,6 +293,48 @@ TEST(BFCArenaTest, TestReserve) {
   EXPECT_EQ(stats.total_allocated_bytes, 1048576);
 }
 
+TEST(BFCArenaTest, TestAllocationTrace) {
+  const std::string trace_path = "bfc_arena_test_allocation_trace.bin";
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  {
+    std::unique_ptr<AllocationTraceRecorder> recorder;
+    ASSERT_STATUS_OK(AllocationTraceRecorder::Create(trace_path, recorder));
+    a.SetAllocationTraceRecorder(recorder.get());
+    void* p1 = a.Alloc(1000);
+    {
+      AllocationTraceNodeScope node_scope(7);
+      void* p2 = a.Reserve(1 << 20);
+      a.Free(p2);
+    }
+    a.Free(p1);
+    a.SetAllocationTraceRecorder(nullptr);
+    // not recorded
+    a.Free(a.Alloc(10));
+  }
+
+  AllocationTrace trace;
+  ASSERT_STATUS_OK(AllocationTrace::Load(trace_path, trace));
+  std::remove(trace_path.c_str());
+
+  ASSERT_EQ(trace.allocators.size(), 1u);
+  EXPECT_EQ(trace.allocators[0].config.arena_extend_strategy,
+            static_cast<int>(ArenaExtendStrategy::kSameAsRequested));
+  EXPECT_EQ(trace.allocators[0].config.max_mem, size_t{1} << 30);
+
+  using Type = AllocationTraceEvent::Type;
+  ASSERT_EQ(trace.events.size(), 4u);
+  EXPECT_EQ(trace.events[0].type, Type::kAlloc);
+  EXPECT_EQ(trace.events[0].size, 1000u);
+  EXPECT_EQ(trace.events[0].node_index, AllocationTraceEvent::kNoNode);
+  EXPECT_EQ(trace.events[1].type, Type::kReserve);
+  EXPECT_EQ(trace.events[1].node_index, 7u);
+  EXPECT_EQ(trace.events[2].type, Type::kFree);
+  EXPECT_EQ(trace.events[2].address, trace.events[1].address);
+  EXPECT_EQ(trace.events[3].type, Type::kFree);
+  EXPECT_EQ(trace.events[3].address, trace.events[0].address);
+  EXPECT_LE(trace.events[0].timestamp_ns, trace.events[3].timestamp_ns);
+}
+
 TEST(BFCArenaTest, TestShrink) {
   AllocatorStats stats;
   BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
@@ -303,6 +351,183 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestShrinkWithPolicy) {
+  constexpr int64_t k1M = 1024 * 1024;
+  AllocatorStats stats;
+
+  // idle regions are released after the configured number of intervals
+  {
+    BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+    void* p1k = a.Alloc(1024);
+    a.Free(a.Alloc(k1M));
+
+    BFCArena::ShrinkPolicy policy;
+    policy.idle_intervals = 2;
+    EXPECT_EQ(a.ShrinkWithPolicy(policy), Status::OK());
+    EXPECT_EQ(a.ShrinkWithPolicy(policy), Status::OK());
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.num_arena_shrinkages, 0) << "region has been idle for less than 2 intervals";
+
+    EXPECT_EQ(a.ShrinkWithPolicy(policy), Status::OK());
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.num_arena_shrinkages, 1);
+    EXPECT_EQ(stats.total_allocated_bytes, 1024) << "the first region is kept";
+    a.Free(p1k);
+  }
+
+  // the least recently used regions are released until the arena is within the soft limit
+  {
+    BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+    void* p1k = a.Alloc(1024);
+    void* p1M = a.Alloc(k1M);
+    void* p2M = a.Alloc(2 * k1M);
+    a.Free(p1M);
+    EXPECT_EQ(a.ShrinkWithPolicy(BFCArena::ShrinkPolicy{}), Status::OK());
+    a.Free(p2M);
+
+    BFCArena::ShrinkPolicy policy;
+    policy.soft_limit_bytes = static_cast<size_t>(5 * k1M / 2);
+    EXPECT_EQ(a.ShrinkWithPolicy(policy), Status::OK());
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.num_arena_shrinkages, 1);
+    EXPECT_EQ(stats.total_allocated_bytes, 2 * k1M + 1024) << "the region freed first is released";
+    a.Free(p1k);
+  }
+
+  // memory for the peak usage of the recent intervals is kept
+  {
+    BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+    void* p1k = a.Alloc(1024);
+    void* p1M = a.Alloc(k1M);
+    void* p2M = a.Alloc(2 * k1M);
+    a.Free(p1M);
+    a.Free(p2M);
+
+    BFCArena::ShrinkPolicy policy;
+    policy.high_water_mark_intervals = 2;
+    EXPECT_EQ(a.ShrinkWithPolicy(policy), Status::OK());
+    EXPECT_EQ(a.ShrinkWithPolicy(policy), Status::OK());
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.num_arena_shrinkages, 0) << "the peak of the last 2 intervals needs all regions";
+
+    EXPECT_EQ(a.ShrinkWithPolicy(policy), Status::OK());
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.num_arena_shrinkages, 2);
+    EXPECT_EQ(stats.total_allocated_bytes, 1024);
+    a.Free(p1k);
+  }
+}
+
+TEST(BFCArenaTest, TestMetrics) {
+  EXPECT_EQ(AllocatorMetrics::HistogramBucket(0), 0u);
+  EXPECT_EQ(AllocatorMetrics::HistogramBucket(1), 0u);
+  EXPECT_EQ(AllocatorMetrics::HistogramBucket(2), 1u);
+  EXPECT_EQ(AllocatorMetrics::HistogramBucket(1023), 9u);
+  EXPECT_EQ(AllocatorMetrics::HistogramBucket(1024), 10u);
+
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  void* p1k = a.Alloc(1024);
+  void* p4k = a.Alloc(4096);
+  a.Free(a.Alloc(1 << 20));
+
+  AllocatorMetrics metrics;
+  a.GetMetrics(&metrics);
+  EXPECT_EQ(metrics.stats.bytes_in_use, 1024 + 4096);
+  EXPECT_EQ(metrics.stats.total_allocated_bytes, 1024 + 4096 + (1 << 20));
+  EXPECT_EQ(metrics.largest_free_chunk, 1 << 20);
+  EXPECT_EQ(metrics.alloc_size_histogram[10], 1);
+  EXPECT_EQ(metrics.alloc_size_histogram[12], 1);
+  EXPECT_EQ(metrics.alloc_size_histogram[20], 1);
+
+  int64_t num_freed = 0;
+  for (int64_t count : metrics.lifetime_histogram) {
+    num_freed += count;
+  }
+  EXPECT_EQ(num_freed, 1);
+
+  int64_t chunks_in_use = 0;
+  int64_t free_bytes = 0;
+  for (const auto& bin : metrics.bins) {
+    chunks_in_use += bin.num_chunks_in_use;
+    free_bytes += bin.free_bytes;
+  }
+  EXPECT_EQ(chunks_in_use, 2);
+  EXPECT_EQ(free_bytes, 1 << 20);
+
+  const std::string json = metrics.ToJson();
+  EXPECT_NE(json.find("\"largest_free_chunk\":1048576"), std::string::npos) << json;
+
+  a.Free(p1k);
+  a.Free(p4k);
+}
+
+TEST(BFCArenaTest, TestThreadCache) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             4096);
+
+  // the first allocation refills the cache of the thread with a batch of 1KB chunks
+  void* p = a.Alloc(1000);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.num_allocs, 32);
+  EXPECT_GE(a.AllocatedSize(p), 1024u);
+
+  // freed chunks are handed out again without going to the arena
+  a.Free(p);
+  void* p2 = a.Alloc(1024);
+  EXPECT_EQ(p2, p);
+  a.Free(p2);
+
+  // larger allocations bypass the caches
+  void* large = a.Alloc(8192);
+  a.Free(large);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(a.Alloc(1000));
+  }
+  for (void* ptr : ptrs) {
+    a.Free(ptr);
+  }
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_misses, 4);
+  EXPECT_GT(stats.num_thread_cache_flushes, 0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&a, t]() {
+      std::vector<std::pair<char*, size_t>> live;
+      for (int i = 0; i < 1000; ++i) {
+        const size_t size = 1 + (static_cast<size_t>(i) * 37 + t * 101) % 4096;
+        char* ptr = static_cast<char*>(a.Alloc(size));
+        memset(ptr, t, size);
+        live.emplace_back(ptr, size);
+        if (live.size() > 8) {
+          for (size_t j = 0; j < live[0].second; ++j) {
+            ASSERT_EQ(live[0].first[j], static_cast<char>(t));
+          }
+          a.Free(live[0].first);
+          live.erase(live.begin());
+        }
+      }
+      for (auto& ptr : live) {
+        a.Free(ptr.first);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // shrinking returns the cached chunks to the arena first
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -410,6 +635,50 @@ TEST(StreamAwareArenaTest, TestSecureTheChunk) {
   a.Free(p2);
 }
 
+TEST(StreamAwareArenaTest, CrossStreamReuse) {
+  StreamAwareArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, true,
+                     ArenaExtendStrategy::kSameAsRequested);
+  OrtDevice tmp;
+  StreamMock stream1(tmp), stream2(tmp);
+  auto wait_fn = [](Stream&, synchronize::Notification&) {};
+  constexpr size_t kSize = 4096;
+
+  void* p1 = a.AllocOnStream(BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, &stream1, wait_fn);
+  a.Free(p1);
+
+  // without a wait function the chunk of stream1 can't be secured, so the arena is extended
+  void* p2 = a.AllocOnStream(kSize, &stream2, nullptr);
+  EXPECT_NE(p2, p1);
+  a.Free(p2);
+
+  // the chunks of the allocating stream are preferred
+  void* p3 = a.AllocOnStream(kSize, &stream1, wait_fn);
+  EXPECT_EQ(p3, p1);
+  void* p4 = a.AllocOnStream(kSize, &stream2, wait_fn);
+  EXPECT_EQ(p4, p2);
+
+  // the rest of stream1's chunk is split and the front is handed over to stream2
+  void* p5 = a.AllocOnStream(kSize, &stream2, wait_fn);
+  EXPECT_EQ(p5, static_cast<char*>(p1) + kSize);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_cross_stream_reuses, 1);
+  EXPECT_EQ(stats.num_arena_extensions, 2) << "stream2 shouldn't need more memory";
+
+  // the reused chunk belongs to stream2 now and isn't merged with the remainder that stays with stream1
+  a.Free(p5);
+  void* p6 = a.AllocOnStream(kSize, &stream2, nullptr);
+  EXPECT_EQ(p6, p5);
+  a.Free(p6);
+  void* p7 = a.AllocOnStream(kSize, &stream1, nullptr);
+  EXPECT_NE(p7, p5);
+
+  a.Free(p3);
+  a.Free(p4);
+  a.Free(p7);
+}
+
 TEST(BFCArenaTest, TestExtendStrategy) {
   int64_t extend_delta_bytes = 0;
   {
@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#if !defined(ORT_MINIMAL_BUILD)
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+#include "nlohmann/json.hpp"
+
+#include "core/framework/calibration_collector.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+void Collect(CalibrationCollector& collector, const std::string& name, const std::vector<float>& values) {
+  OrtValue value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0],
+                       {static_cast<int64_t>(values.size())}, values, &value);
+  collector.Collect(name, value);
+}
+
+}  // namespace
+
+TEST(CalibrationCollectorTest, Create) {
+  std::unique_ptr<CalibrationCollector> collector;
+  ConfigOptions config_options;
+  ASSERT_STATUS_OK(CalibrationCollector::Create(config_options, collector));
+  EXPECT_EQ(collector, nullptr);
+
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConfigCalibrationMethod, "histogram"));
+  ASSERT_STATUS_OK(CalibrationCollector::Create(config_options, collector));
+  ASSERT_NE(collector, nullptr);
+  EXPECT_EQ(collector->GetMethod(), CalibrationCollector::Method::Histogram);
+  EXPECT_TRUE(collector->OutputFile().empty());
+
+  ASSERT_STATUS_OK(config_options.AddConfigEntry(kOrtSessionOptionsConfigCalibrationNumBins, "0"));
+  ASSERT_STATUS_NOT_OK(CalibrationCollector::Create(config_options, collector));
+
+  ConfigOptions invalid_method;
+  ASSERT_STATUS_OK(invalid_method.AddConfigEntry(kOrtSessionOptionsConfigCalibrationMethod, "entropy"));
+  ASSERT_STATUS_NOT_OK(CalibrationCollector::Create(invalid_method, collector));
+}
+
+TEST(CalibrationCollectorTest, MinMax) {
+  CalibrationCollector collector(CalibrationCollector::Method::MinMax, 4);
+  Collect(collector, "x", {0.5f, -2.0f, 1.0f});
+  Collect(collector, "x", {3.0f, -1.0f});
+  Collect(collector, "y", {-4.0f});
+
+  const auto statistics = collector.GetStatistics();
+  ASSERT_EQ(statistics.size(), 2u);
+  EXPECT_EQ(statistics.at("x").min, -2.0f);
+  EXPECT_EQ(statistics.at("x").max, 3.0f);
+  EXPECT_TRUE(statistics.at("x").histogram.empty());
+  EXPECT_EQ(statistics.at("y").min, -4.0f);
+  EXPECT_EQ(statistics.at("y").max, -4.0f);
+}
+
+TEST(CalibrationCollectorTest, HistogramGrowsByWholeBins) {
+  CalibrationCollector collector(CalibrationCollector::Method::Histogram, 4);
+  Collect(collector, "x", {-1.0f, 0.0f, 0.5f, 1.0f});
+
+  auto statistics = collector.GetStatistics().at("x");
+  EXPECT_EQ(statistics.threshold, 1.0f);
+  EXPECT_EQ(statistics.histogram, (std::vector<uint64_t>{1, 0, 1, 2}));
+
+  // the bins keep their width of 0.5, two are added on each side
+  Collect(collector, "x", {2.0f});
+  statistics = collector.GetStatistics().at("x");
+  EXPECT_EQ(statistics.threshold, 2.0f);
+  EXPECT_EQ(statistics.histogram, (std::vector<uint64_t>{0, 0, 1, 0, 1, 2, 0, 1}));
+
+  // too many bins would be added, so the histogram is re-binned over the new range
+  Collect(collector, "x", {1000.0f});
+  statistics = collector.GetStatistics().at("x");
+  EXPECT_EQ(statistics.threshold, 1000.0f);
+  ASSERT_EQ(statistics.histogram.size(), 4u);
+  EXPECT_EQ(std::accumulate(statistics.histogram.begin(), statistics.histogram.end(), uint64_t{0}), 6u);
+  EXPECT_EQ(statistics.histogram[3], 1u);
+}
+
+TEST(CalibrationCollectorTest, HistogramCountsLeadingZeros) {
+  CalibrationCollector collector(CalibrationCollector::Method::Histogram, 4);
+  Collect(collector, "x", {0.0f, 0.0f, 0.0f});
+  EXPECT_TRUE(collector.GetStatistics().at("x").histogram.empty());
+
+  Collect(collector, "x", {1.0f});
+  const auto statistics = collector.GetStatistics().at("x");
+  EXPECT_EQ(statistics.histogram, (std::vector<uint64_t>{0, 0, 3, 1}));
+  EXPECT_EQ(statistics.pending_zeros, 0u);
+}
+
+TEST(CalibrationCollectorTest, CollectsSessionTensorsAndSaves) {
+  const PathString output_file = ORT_TSTR("calibration_collector_test_output.json");
+
+  SessionOptions so;
+  so.session_logid = "CalibrationCollectorTest.CollectsSessionTensorsAndSaves";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCalibrationMethod, "histogram"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCalibrationNumBins, "8"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigCalibrationOutputFile,
+                                                    PathToUTF8String(output_file).c_str()));
+
+  {
+    InferenceSession session{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load(ORT_TSTR("testdata/mul_1.onnx")));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    OrtValue x;
+    CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 2},
+                         {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &x);
+    NameMLValMap feeds{{"X", x}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, {"Y"}, &fetches));
+
+    const auto* collector = session.GetCalibrationCollector();
+    ASSERT_NE(collector, nullptr);
+    const auto statistics = collector->GetStatistics();
+    ASSERT_EQ(statistics.count("X"), 1u);
+    ASSERT_EQ(statistics.count("Y"), 1u);
+    EXPECT_EQ(statistics.at("X").min, 1.0f);
+    EXPECT_EQ(statistics.at("X").max, 6.0f);
+    EXPECT_EQ(statistics.at("Y").min, 1.0f);
+    EXPECT_EQ(statistics.at("Y").max, 36.0f);
+    EXPECT_EQ(statistics.at("Y").histogram.size(), 8u);
+  }
+
+  // the statistics are saved when the session is destroyed
+  std::ifstream file(output_file);
+  ASSERT_TRUE(file);
+  const auto contents = nlohmann::json::parse(file);
+  EXPECT_EQ(contents["method"], "histogram");
+  EXPECT_EQ(contents["tensors"]["Y"]["max"], 36.0f);
+  EXPECT_EQ(contents["tensors"]["Y"]["threshold"], 36.0f);
+  EXPECT_EQ(contents["tensors"]["Y"]["histogram"].size(), 8u);
+  file.close();
+  std::remove(PathToUTF8String(output_file).c_str());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // !defined(ORT_MINIMAL_BUILD)
@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/execution_providers.h"
+#include "core/optimizer/cast_precision_propagation.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/model.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "gtest/gtest.h"
+#include "test_utils.h"
+#include "test/test_environment.h"
+#include "test/util/include/asserts.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+typedef std::vector<onnxruntime::NodeArg*> ArgMap;
+
+namespace {
+
+void AddCastNode(Graph& graph, NodeArg& input, NodeArg& output, TensorProto_DataType to) {
+  Node& cast = graph.AddNode(graph.GenerateNodeName("cast"), "Cast", "", ArgMap{&input}, ArgMap{&output});
+  cast.AddAttribute("to", static_cast<int64_t>(to));
+}
+
+Status ApplyCastPrecisionPropagation(Graph& graph, bool& modified, InlinedHashSet<std::string> fp16_ops = {}) {
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  ExecutionProviders execution_providers;
+  ORT_RETURN_IF_ERROR(execution_providers.Add(kCpuExecutionProvider,
+                                              std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+  KernelRegistryManager registry_manager;
+  ORT_RETURN_IF_ERROR(registry_manager.RegisterKernels(execution_providers));
+
+  CastPrecisionPropagation transformer(registry_manager, std::move(fp16_ops));
+  return transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger());
+}
+
+int CountOpType(const Graph& graph, const std::string& op_type) {
+  int count = 0;
+  for (const auto& node : graph.Nodes()) {
+    count += node.OpType() == op_type ? 1 : 0;
+  }
+  return count;
+}
+
+}  // namespace
+
+// X(fp16) -> Cast -> Identity -> Transpose -> Cast -> Y(fp16) runs in float16 without the Casts
+TEST(CastPrecisionPropagationTest, RemovesCastsAroundValuePreservingOps) {
+  auto model = std::make_shared<onnxruntime::Model>("test", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model->MainGraph();
+
+  TypeProto float16_type;
+  float16_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  NodeArg x_def("X", &float16_type), a_def("A", &float_type), b_def("B", &float_type), c_def("C", &float_type),
+      y_def("Y", &float16_type);
+
+  AddCastNode(graph, x_def, a_def, TensorProto_DataType_FLOAT);
+  auto& identity = graph.AddNode("identity", "Identity", "", ArgMap{&a_def}, ArgMap{&b_def});
+  auto& transpose = graph.AddNode("transpose", "Transpose", "", ArgMap{&b_def}, ArgMap{&c_def});
+  AddCastNode(graph, c_def, y_def, TensorProto_DataType_FLOAT16);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  bool modified = false;
+  ASSERT_STATUS_OK(ApplyCastPrecisionPropagation(graph, modified));
+  EXPECT_TRUE(modified);
+
+  EXPECT_EQ(CountOpType(graph, "Cast"), 0);
+  EXPECT_EQ(identity.InputDefs()[0]->Name(), "X");
+  EXPECT_EQ(identity.OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT16);
+  EXPECT_EQ(transpose.OutputDefs()[0]->Name(), "Y");
+}
+
+// X(fp32) -> Cast -> Add(fp16 initializer) -> Cast -> Y(fp32) runs in float without the Casts
+TEST(CastPrecisionPropagationTest, MovesArithmeticToFloat) {
+  auto model = std::make_shared<onnxruntime::Model>("test", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model->MainGraph();
+
+  TypeProto float16_type;
+  float16_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  TensorProto bias;
+  bias.set_name("bias");
+  bias.set_data_type(TensorProto_DataType_FLOAT16);
+  bias.add_dims(2);
+  bias.add_int32_data(MLFloat16(1.5f).val);
+  bias.add_int32_data(MLFloat16(-2.f).val);
+  graph.AddInitializedTensor(bias);
+
+  NodeArg x_def("X", &float_type), a_def("A", &float16_type), bias_def("bias", &float16_type),
+      b_def("B", &float16_type), y_def("Y", &float_type);
+  AddCastNode(graph, x_def, a_def, TensorProto_DataType_FLOAT16);
+  auto& add = graph.AddNode("add", "Add", "", ArgMap{&a_def, &bias_def}, ArgMap{&b_def});
+  AddCastNode(graph, b_def, y_def, TensorProto_DataType_FLOAT);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  bool modified = false;
+  ASSERT_STATUS_OK(ApplyCastPrecisionPropagation(graph, modified));
+  EXPECT_TRUE(modified);
+
+  EXPECT_EQ(CountOpType(graph, "Cast"), 0);
+  EXPECT_EQ(add.InputDefs()[0]->Name(), "X");
+  EXPECT_EQ(add.OutputDefs()[0]->Name(), "Y");
+  const auto* converted_bias = graph_utils::GetConstantInitializer(graph, add.InputDefs()[1]->Name());
+  ASSERT_NE(converted_bias, nullptr);
+  EXPECT_EQ(converted_bias->data_type(), TensorProto_DataType_FLOAT);
+}
+
+// float Add stays in float unless float16 is allowed for it and the EP has a float16 kernel
+TEST(CastPrecisionPropagationTest, KeepsArithmeticInFloat) {
+  auto build = [](Graph& graph) {
+    TypeProto float16_type;
+    float16_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+    TypeProto float_type;
+    float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    auto& x_def = graph.GetOrCreateNodeArg("X", &float16_type);
+    auto& a_def = graph.GetOrCreateNodeArg("A", &float_type);
+    auto& b_def = graph.GetOrCreateNodeArg("B", &float_type);
+    auto& y_def = graph.GetOrCreateNodeArg("Y", &float16_type);
+    AddCastNode(graph, x_def, a_def, TensorProto_DataType_FLOAT);
+    graph.AddNode("add", "Add", "", ArgMap{&a_def, &a_def}, ArgMap{&b_def});
+    AddCastNode(graph, b_def, y_def, TensorProto_DataType_FLOAT16);
+    return graph.Resolve();
+  };
+
+  {
+    auto model = std::make_shared<onnxruntime::Model>("test", false, DefaultLoggingManager().DefaultLogger());
+    Graph& graph = model->MainGraph();
+    ASSERT_STATUS_OK(build(graph));
+
+    bool modified = false;
+    ASSERT_STATUS_OK(ApplyCastPrecisionPropagation(graph, modified));
+    EXPECT_FALSE(modified);
+    EXPECT_EQ(CountOpType(graph, "Cast"), 2);
+  }
+
+  {
+    auto model = std::make_shared<onnxruntime::Model>("test", false, DefaultLoggingManager().DefaultLogger());
+    Graph& graph = model->MainGraph();
+    ASSERT_STATUS_OK(build(graph));
+
+    bool modified = false;
+    ASSERT_STATUS_OK(ApplyCastPrecisionPropagation(graph, modified, {"Add"}));
+    // the CPU EP has no float16 Add kernel
+    EXPECT_FALSE(modified);
+    EXPECT_EQ(CountOpType(graph, "Cast"), 2);
+  }
+}
+
+// the float value is still a graph output, so it needs a Cast back, which still saves one Cast
+TEST(CastPrecisionPropagationTest, KeepsValuesReadInOriginalType) {
+  auto model = std::make_shared<onnxruntime::Model>("test", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model->MainGraph();
+
+  TypeProto float16_type;
+  float16_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT16);
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  NodeArg x_def("X", &float16_type), a_def("A", &float_type), b_def("B", &float_type), y_def("Y", &float16_type);
+
+  AddCastNode(graph, x_def, a_def, TensorProto_DataType_FLOAT);
+  auto& transpose = graph.AddNode("transpose", "Transpose", "", ArgMap{&a_def}, ArgMap{&b_def});
+  AddCastNode(graph, b_def, y_def, TensorProto_DataType_FLOAT16);
+  graph.SetOutputs({graph.GetNodeArg("Y"), graph.GetNodeArg("B")});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  bool modified = false;
+  ASSERT_STATUS_OK(ApplyCastPrecisionPropagation(graph, modified));
+  EXPECT_TRUE(modified);
+
+  ASSERT_EQ(CountOpType(graph, "Cast"), 1);
+  EXPECT_EQ(transpose.OutputDefs()[0]->Name(), "Y");
+  ASSERT_EQ(transpose.GetOutputEdgesCount(), 1u);
+  const Node& cast = *transpose.OutputNodesBegin();
+  EXPECT_EQ(cast.OpType(), "Cast");
+  EXPECT_EQ(cast.OutputDefs()[0]->Name(), "B");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
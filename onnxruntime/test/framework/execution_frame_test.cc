@@ -328,6 +328,40 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->PeakSize(), 2u * kAllocAlignment);  // each allocation is kAllocAlignment-byte aligned
   ASSERT_EQ(p->GetBlock(3)->offset_, 0u);
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
+
+  // the shape and block of each tensor are recorded as the patterns are specific to these input shapes
+  const auto* placement = pattern.GetRecordedPlacement(3);
+  ASSERT_NE(placement, nullptr);
+  ASSERT_EQ(placement->shape, TensorShape(std::vector<int64_t>{2, 2}));
+  ASSERT_EQ(placement->block.offset_, 0u);
+  placement = pattern.GetRecordedPlacement(4);
+  ASSERT_NE(placement, nullptr);
+  ASSERT_EQ(placement->shape, TensorShape(std::vector<int64_t>{2, 3}));
+  ASSERT_EQ(placement->block.offset_, kAllocAlignment);
+
+  // a run with the same input shapes places the tensors in the recorded blocks
+  ASSERT_STATUS_OK(state.UpdateMemoryPatternGroupCache(AsSpan({v1, v2, v3}), AsSpan({x1_idx, x2_idx, x3_idx}),
+                                                       std::move(pattern)));
+
+  std::vector<OrtValue> outputs2;
+  ExecutionFrame frame2(AsSpan({x1_idx, x2_idx, x3_idx}), AsSpan({v1, v2, v3}), AsSpan({t3_idx}), outputs2, {}, {},
+                        state);
+  ASSERT_FALSE(frame2.HasMemoryPatternPlanner());
+
+  OrtValue& mlvalue3_2 = *frame2.GetMutableNodeInputOrOutputMLValue(3);
+  OrtValue& mlvalue4_2 = *frame2.GetMutableNodeInputOrOutputMLValue(4);
+  ASSERT_STATUS_OK(frame2.AllocateMLValueTensorSelfOwnBuffer(mlvalue3_2, 3,
+                                                             DataTypeImpl::GetType<float>(),
+                                                             cpu_allocator->Info().device,
+                                                             TensorShape(std::vector<int64_t>{2, 2})));
+  ASSERT_STATUS_OK(frame2.AllocateMLValueTensorSelfOwnBuffer(mlvalue4_2, 4,
+                                                             DataTypeImpl::GetType<float>(),
+                                                             cpu_allocator->Info().device,
+                                                             TensorShape(std::vector<int64_t>{2, 3})));
+
+  const auto* data3 = static_cast<const char*>(mlvalue3_2.Get<Tensor>().DataRaw());
+  const auto* data4 = static_cast<const char*>(mlvalue4_2.Get<Tensor>().DataRaw());
+  ASSERT_EQ(static_cast<size_t>(data4 - data3), kAllocAlignment);
 }
 
 #ifdef ENABLE_TRAINING
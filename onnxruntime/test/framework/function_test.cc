@@ -530,5 +530,48 @@ TEST(FunctionTest, ConstantFoldingInSubGraph) {
   Check(code, "X", {1.0, 2.0, 3.0}, "Y", {3.0, 4.0, 5.0, 3.0, 4.0, 5.0, 3.0, 4.0, 5.0});
 }
 
+// The body of a context dependent function is built once per signature of the call sites, and each call site
+// inlines its own copy.
+TEST(FunctionTest, InlineContextDependentFunctions) {
+  const char* code = R"(
+    <ir_version: 8, opset_import: [ "" : 17 ]>
+    agraph (float[N, 4] X, float[4] S, double[N, 4] D, double[4] T) => (float[N, 4] Y, double[N, 4] Z)  {
+        Y1 = LayerNormalization <epsilon = 0.001> (X, S)
+        Y = LayerNormalization <epsilon = 0.001> (Y1, S)
+        Z = LayerNormalization <epsilon = 0.001> (D, T)
+    }
+  )";
+
+  ONNX_NAMESPACE::OnnxParser parser(code);
+  ONNX_NAMESPACE::ModelProto model_proto;
+  auto parse_status = parser.Parse(model_proto);
+  ASSERT_TRUE(parse_status.IsOK()) << parse_status.ErrorMessage();
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(std::move(model_proto), model, nullptr, DefaultLoggingManager().DefaultLogger()));
+  Graph& graph = model->MainGraph();
+
+  std::vector<NodeIndex> call_sites;
+  for (const auto& node : graph.Nodes()) {
+    call_sites.push_back(node.Index());
+  }
+
+  std::vector<int> inlined_node_counts;
+  for (NodeIndex call_site : call_sites) {
+    const int num_nodes = graph.NumberOfNodes();
+    ASSERT_STATUS_OK(graph.InlineFunction(*graph.GetNode(call_site)));
+    inlined_node_counts.push_back(graph.NumberOfNodes() - num_nodes + 1);
+  }
+
+  EXPECT_EQ(inlined_node_counts[0], inlined_node_counts[1]);
+  for (const auto& node : graph.Nodes()) {
+    EXPECT_NE(node.OpType(), "LayerNormalization");
+  }
+  EXPECT_EQ(graph.GetNodeArg("Y")->TypeAsProto()->tensor_type().elem_type(),
+            ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  EXPECT_EQ(graph.GetNodeArg("Z")->TypeAsProto()->tensor_type().elem_type(),
+            ONNX_NAMESPACE::TensorProto_DataType_DOUBLE);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -6,8 +6,10 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <filesystem>
 #include <functional>
 #include <iterator>
+#include <set>
 #include <thread>
 #include <fstream>
 
@@ -55,6 +57,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -397,6 +400,34 @@ TEST(InferenceSessionTests, NoTimeout) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, Clone) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.Clone";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+
+  SessionOptions clone_so;
+  clone_so.session_logid = "InferenceSessionTests.Clone.clone";
+  std::unique_ptr<InferenceSession> clone;
+  ASSERT_FALSE(session_object.Clone(clone_so, clone).IsOK());
+
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_STATUS_OK(session_object.Clone(clone_so, clone));
+  ASSERT_NE(clone, nullptr);
+  EXPECT_EQ(&clone->GetSessionState(), &session_object.GetSessionState());
+  EXPECT_EQ(clone->GetSessionOptions().session_logid, "InferenceSessionTests.Clone.clone");
+
+  RunOptions run_options;
+  RunModel(*clone, run_options);
+  RunModel(session_object, run_options);
+
+  // a clone can't load or initialize another model
+  EXPECT_FALSE(clone->Load(MODEL_URI).IsOK());
+  clone.reset();
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, OnlyExecutePathToFetches) {
   SessionOptions so;
 
@@ -490,6 +521,56 @@ TEST(InferenceSessionTests, TestModelSerialization) {
   ASSERT_TRUE(session_object_emptyValidation.Initialize().IsOK());
 }
 
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  const string test_model = "testdata/transform/abs-id-max.onnx";
+  TemporaryDirectory cache_dir(ORT_TSTR("optimized_model_cache_test"));
+
+  auto cache_files = [&]() {
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(cache_dir.Path())) {
+      files.push_back(entry.path());
+    }
+    return files;
+  };
+
+  // the first session optimizes the model and saves it, the second one loads it from the cache and doesn't run the
+  // graph transformers
+  auto run_session = [&](TransformerLevel level, const char* max_size, bool& transformer_invoked) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.OptimizedModelCache";
+    so.graph_optimization_level = level;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                      ToUTF8String(cache_dir.Path()).c_str()));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheMaxSizeInBytes, max_size));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    auto dummy_transformer_unique_ptr = std::make_unique<DummyGraphTransformer>("DummyTransformer");
+    const auto* dummy_transformer = dummy_transformer_unique_ptr.get();
+    ASSERT_STATUS_OK(session_object.RegisterGraphTransformer(std::move(dummy_transformer_unique_ptr)));
+    ASSERT_STATUS_OK(session_object.Load(test_model));
+    ASSERT_STATUS_OK(session_object.Initialize());
+    transformer_invoked = dummy_transformer->IsTransformerInvoked();
+    ASSERT_EQ(CountOpsInGraph(session_object.GetGraph())["Identity"], 0);
+  };
+
+  bool transformer_invoked = false;
+  run_session(TransformerLevel::Level1, "0", transformer_invoked);
+  ASSERT_TRUE(transformer_invoked);
+  const auto first_files = cache_files();
+  ASSERT_EQ(first_files.size(), 1u);
+  ASSERT_EQ(first_files[0].extension(), ".ort");
+
+  run_session(TransformerLevel::Level1, "0", transformer_invoked);
+  ASSERT_FALSE(transformer_invoked);
+  ASSERT_EQ(cache_files(), first_files);
+
+  // another optimization level is another cache file, which evicts the first one as they don't both fit
+  run_session(TransformerLevel::Level2, "1", transformer_invoked);
+  ASSERT_TRUE(transformer_invoked);
+  const auto second_files = cache_files();
+  ASSERT_EQ(second_files.size(), 1u);
+  ASSERT_NE(second_files[0], first_files[0]);
+}
+
 #ifdef ORT_RUN_EXTERNAL_ONNX_TESTS
 static bool Compare(const InputDefList& f_arg, const InputDefList& s_arg) {
   if (f_arg.size() != s_arg.size()) {
@@ -770,6 +851,141 @@ TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
     count++;
   }
 }
+
+TEST(InferenceSessionTests, CheckRunProfilerWithSampling) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerWithSampling";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_sampling_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingSampleRate, "2"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  // the kernels of 1 in 2 runs are profiled, while the runs themselves are all aggregated
+  std::string summary;
+  ASSERT_STATUS_OK(session_object.GetProfilingSummary(summary));
+  EXPECT_NE(summary.find(R"("sampled_runs" : 2,)"), std::string::npos) << summary;
+  EXPECT_NE(summary.find(R"("name" : "mul_1_kernel_time", "count" : 2,)"), std::string::npos) << summary;
+  EXPECT_NE(summary.find(R"("name" : "model_run", "count" : 4,)"), std::string::npos) << summary;
+  EXPECT_NE(summary.find("\"p99_us\""), std::string::npos) << summary;
+
+  std::string profile_file = session_object.EndProfiling();
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(profile, line)) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 1u);
+  EXPECT_NE(lines[0].find("mul_1_kernel_time"), std::string::npos);
+  EXPECT_FALSE(session_object.GetProfilingSummary(summary).IsOK());
+}
+
+TEST(InferenceSessionTests, GetMetrics) {
+  SessionOptions so;
+  so.session_logid = "GetMetrics";
+
+  InferenceSession session_object(so, GetEnvironment());
+  std::string metrics;
+  EXPECT_FALSE(session_object.GetMetrics("json", metrics).IsOK());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 3; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  ASSERT_STATUS_OK(session_object.GetMetrics("json", metrics));
+  EXPECT_NE(metrics.find(R"("runs":3,"failed_runs":0,)"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find(R"("latency":{"count":3,)"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find(R"("queue_time":{"count":0,)"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find(R"("memory_pattern_cache":{"hits":)"), std::string::npos) << metrics;
+  EXPECT_NE(metrics.find(R"("allocators":[{"name":")"), std::string::npos) << metrics;
+
+  ASSERT_STATUS_OK(session_object.GetMetrics("prometheus", metrics));
+  EXPECT_NE(metrics.find("# TYPE ort_session_runs_total counter\n"), std::string::npos) << metrics;
+  const auto count = metrics.find("ort_session_run_latency_seconds_count{session_id=");
+  ASSERT_NE(count, std::string::npos) << metrics;
+  EXPECT_EQ(metrics.substr(metrics.find('}', count), 4), "} 3\n") << metrics;
+
+  EXPECT_FALSE(session_object.GetMetrics("xml", metrics).IsOK());
+}
+
+TEST(InferenceSessionTests, CheckRunProfilerWithRoofline) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfilerWithRoofline";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_roofline_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigProfilingRoofline, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_TRUE(session_object.GetProfiling().IsRooflineEnabled());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  std::string roofline;
+  while (std::getline(profile, line)) {
+    if (line.find(R"("name" :"roofline")") != std::string::npos) {
+      roofline = line;
+    }
+  }
+
+  // the Mul nodes do one operation per output element, far fewer than the bytes they move
+  ASSERT_FALSE(roofline.empty());
+  EXPECT_NE(roofline.find("\"peak_gflops_per_s\""), std::string::npos) << roofline;
+  EXPECT_NE(roofline.find(R"({"name" : "mul_1", "op_type" : "Mul", "count" : 1,)"), std::string::npos) << roofline;
+  EXPECT_NE(roofline.find(R"({"op_type" : "Mul", "count" : )"), std::string::npos) << roofline;
+  EXPECT_NE(roofline.find(R"("bound" : "memory")"), std::string::npos) << roofline;
+}
+
+TEST(InferenceSessionTests, CheckProfilerRecordsInitializationPhases) {
+  SessionOptions so;
+
+  so.session_logid = "CheckProfilerRecordsInitializationPhases";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_initialization_test");
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  std::set<std::string> session_events;
+  while (std::getline(profile, line)) {
+    const auto name_pos = line.find(R"("name" :")");
+    if (line.find(R"("cat" : "Session")") != std::string::npos && name_pos != std::string::npos) {
+      const auto name_begin = name_pos + 9;
+      session_events.insert(line.substr(name_begin, line.find('"', name_begin) - name_begin));
+    }
+  }
+
+  for (const char* phase : {"model_loading_uri", "graph_partitioning", "graph_resolve",
+                            "session_state_execution_planning", "session_state_initializer_saving",
+                            "session_state_kernel_creation", "session_initialization"}) {
+    EXPECT_EQ(session_events.count(phase), 1u) << phase;
+  }
+}
 #endif  // __wasm__
 
 TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
@@ -1020,6 +1236,68 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingOutputAllocator) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto cpu_allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  std::vector<float> values_mul_x = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f};
+  OrtValue input_a, input_b;
+  CreateMLValue<float>(cpu_allocator, {3, 4}, values_mul_x, &input_a);
+  CreateMLValue<float>(cpu_allocator, {4, 3}, values_mul_x, &input_b);
+  ASSERT_STATUS_OK(io_binding->BindInput("A", input_a));
+  ASSERT_STATUS_OK(io_binding->BindInput("B", input_b));
+
+  // the output is written directly into the buffer provided once the shape is known
+  std::vector<float> user_buffer(16);
+  TensorShape requested_shape;
+  int num_calls = 0;
+  ASSERT_STATUS_OK(io_binding->BindOutput(
+      "Y", [&](const TensorShape& shape, const OrtDevice& device, OrtValue& value, bool& allocated) -> Status {
+        ++num_calls;
+        requested_shape = shape;
+        ORT_RETURN_IF_NOT(static_cast<size_t>(shape.Size()) <= user_buffer.size(), "buffer too small");
+        Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, user_buffer.data(),
+                             OrtMemoryInfo(CPU, OrtDeviceAllocator, device), value);
+        allocated = true;
+        return Status::OK();
+      }));
+
+  ASSERT_STATUS_OK(session_object.Run(*io_binding));
+
+  ASSERT_EQ(num_calls, 1);
+  ASSERT_EQ(requested_shape, TensorShape({3, 3}));
+  const auto& outputs = io_binding->GetOutputs();
+  ASSERT_EQ(outputs.size(), 1u);
+  ASSERT_EQ(outputs[0].Get<Tensor>().DataRaw(), user_buffer.data());
+  VerifyOutputs(outputs, {3, 3}, {42, 48, 54, 114, 136, 158, 186, 224, 262});
+
+  // a value that doesn't match the requested shape is rejected
+  io_binding->ClearOutputs();
+  ASSERT_STATUS_OK(io_binding->BindOutput(
+      "Y", [&](const TensorShape&, const OrtDevice& device, OrtValue& value, bool& allocated) -> Status {
+        Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({4, 4}), user_buffer.data(),
+                             OrtMemoryInfo(CPU, OrtDeviceAllocator, device), value);
+        allocated = true;
+        return Status::OK();
+      }));
+
+  auto status = session_object.Run(*io_binding);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("provided a tensor with shape"));
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
@@ -1106,6 +1384,43 @@ TEST(InferenceSessionTests, TestBindCudaSpecifyOutputDeviceOnCuda) {
                  &device /* specify output device */);
 }
 
+TEST(InferenceSessionTests, InputCopyStreams) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.InputCopyStreams";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseInputCopyStreams, "1"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+#ifdef USE_CUDA
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+#endif
+#ifdef USE_ROCM
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultRocmExecutionProvider()));
+#endif
+
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kGpuExecutionProvider);
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // both CPU inputs are copied on the input copy stream, and the MatMul waits for them
+  std::vector<float> values = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f};
+  OrtValue input_A;
+  OrtValue input_B;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {3, 4}, values, &input_A);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4, 3}, values, &input_B);
+  NameMLValMap feeds{{"A", input_A}, {"B", input_B}};
+
+  // the notifications of the copies are released at the end of a run, so the second run sets them again
+  for (int i = 0; i < 2; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"Y"}, &fetches));
+    VerifyOutputs(fetches, {3, 3}, {42, 48, 54, 114, 136, 158, 186, 224, 262});
+  }
+}
+
 #endif
 
 TEST(InferenceSessionTests, ModelWithoutOpset) {
@@ -1315,6 +1630,225 @@ TEST(ExecutionProviderTest, FunctionTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
+TEST(InferenceSessionTests, MemoizeNodesDependingOnSlowChangingInputs) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  // M = (X + Y) + Z, where X and Y rarely change
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  auto& z_arg = graph.GetOrCreateNodeArg("Z", &float_tensor);
+  auto& sum_arg = graph.GetOrCreateNodeArg("node_1_out_1", &float_tensor);
+  auto& m_arg = graph.GetOrCreateNodeArg("M", &float_tensor);
+  graph.AddNode("node_1", "Add", "node 1.", {&x_arg, &y_arg}, {&sum_arg});
+  graph.AddNode("node_2", "Add", "node 2.", {&sum_arg, &z_arg}, {&m_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_file_name = "memoization_test_graph.onnx";
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.MemoizeNodesDependingOnSlowChangingInputs";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigMemoizationInputs, "X,Y"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto* memoizer = session_object.GetSessionState().GetSubgraphMemoizer();
+  ASSERT_NE(memoizer, nullptr);
+  EXPECT_EQ(memoizer->NumMemoizedNodes(), 1u);
+  EXPECT_EQ(memoizer->NumCachedValues(), 1u);
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  std::vector<int64_t> dims = {3, 2};
+  auto run = [&](const std::vector<float>& x, const std::vector<float>& z, const std::vector<float>& expected_m) {
+    OrtValue ml_value_x;
+    OrtValue ml_value_y;
+    OrtValue ml_value_z;
+    CreateMLValue<float>(allocator, dims, x, &ml_value_x);
+    CreateMLValue<float>(allocator, dims, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f}, &ml_value_y);
+    CreateMLValue<float>(allocator, dims, z, &ml_value_z);
+    NameMLValMap feeds{{"X", ml_value_x}, {"Y", ml_value_y}, {"Z", ml_value_z}};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"M"}, &fetches));
+    VerifyOutputs(fetches, dims, expected_m);
+  };
+
+  const std::vector<float> values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const std::vector<float> other_values = {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f};
+  run(values, values, {3.0f, 5.0f, 7.0f, 9.0f, 11.0f, 13.0f});
+  EXPECT_EQ(memoizer->NumEntries(), 1u);
+
+  // only Z changed, so the sum of X and Y comes from the cache
+  run(values, other_values, {4.0f, 7.0f, 10.0f, 13.0f, 16.0f, 19.0f});
+  EXPECT_EQ(memoizer->NumEntries(), 1u);
+
+  // a new value of X adds an entry
+  run(other_values, values, {4.0f, 7.0f, 10.0f, 13.0f, 16.0f, 19.0f});
+  EXPECT_EQ(memoizer->NumEntries(), 2u);
+}
+
+TEST(InferenceSessionTests, TaskGraphExecution) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  // M = (X + Y) * (X + Z), where both sums can run at the same time
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& y_arg = graph.GetOrCreateNodeArg("Y", &float_tensor);
+  auto& z_arg = graph.GetOrCreateNodeArg("Z", &float_tensor);
+  auto& sum_1_arg = graph.GetOrCreateNodeArg("node_1_out_1", &float_tensor);
+  auto& sum_2_arg = graph.GetOrCreateNodeArg("node_2_out_1", &float_tensor);
+  auto& m_arg = graph.GetOrCreateNodeArg("M", &float_tensor);
+  graph.AddNode("node_1", "Add", "node 1.", {&x_arg, &y_arg}, {&sum_1_arg});
+  graph.AddNode("node_2", "Add", "node 2.", {&x_arg, &z_arg}, {&sum_2_arg});
+  graph.AddNode("node_3", "Mul", "node 3.", {&sum_1_arg, &sum_2_arg}, {&m_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+  std::string model_file_name = "task_graph_test_graph.onnx";
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TaskGraphExecution";
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigTaskGraphExecution, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_file_name));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto* task_graph = session_object.GetSessionState().GetTaskGraph();
+  ASSERT_NE(task_graph, nullptr);
+  EXPECT_EQ(task_graph->nodes.size(), 3u);
+  EXPECT_EQ(task_graph->roots.size(), 2u);
+
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  std::vector<int64_t> dims = {3, 2};
+  OrtValue ml_value_x;
+  OrtValue ml_value_y;
+  OrtValue ml_value_z;
+  CreateMLValue<float>(allocator, dims, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value_x);
+  CreateMLValue<float>(allocator, dims, {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f}, &ml_value_y);
+  CreateMLValue<float>(allocator, dims, {2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f}, &ml_value_z);
+  NameMLValMap feeds{{"X", ml_value_x}, {"Y", ml_value_y}, {"Z", ml_value_z}};
+
+  for (int i = 0; i < 10; ++i) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"M"}, &fetches));
+    VerifyOutputs(fetches, dims, {6.0f, 12.0f, 20.0f, 30.0f, 42.0f, 56.0f});
+  }
+}
+
+TEST(InferenceSessionTests, LazyExternalInitializers) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  // M = X * W, where W is stored in an external data file
+  ONNX_NAMESPACE::TensorProto w;
+  w.set_name("W");
+  w.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  w.add_dims(2);
+  w.add_dims(2);
+  for (float value : {1.0f, 0.0f, 0.0f, 2.0f}) {
+    w.add_float_data(value);
+  }
+  graph.AddInitializedTensor(w);
+
+  auto& x_arg = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& w_arg = graph.GetOrCreateNodeArg("W", &float_tensor);
+  auto& m_arg = graph.GetOrCreateNodeArg("M", &float_tensor);
+  graph.AddNode("node_1", "MatMul", "node 1.", {&x_arg, &w_arg}, {&m_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+  PathString model_file_name = ORT_TSTR("lazy_external_initializers_test_graph.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::SaveWithExternalInitializers(model, model_file_name,
+                                                                    "lazy_external_initializers_test_graph.bin", 0));
+
+  // "2" also marks the pages of W cold after each Run
+  for (const char* lazy : {"1", "2"}) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.LazyExternalInitializers";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigLazyExternalInitializers, lazy));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_file_name));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    // W is not pre-packed, so MatMul reads it from the mapped file
+    EXPECT_EQ(session_object.GetSessionState().GetConstantInitializedTensors().size(), 1u);
+
+    auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+    std::vector<int64_t> dims = {3, 2};
+    OrtValue ml_value_x;
+    CreateMLValue<float>(allocator, dims, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value_x);
+    NameMLValMap feeds{{"X", ml_value_x}};
+
+    for (int i = 0; i < 2; ++i) {
+      std::vector<OrtValue> fetches;
+      ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"M"}, &fetches));
+      VerifyOutputs(fetches, dims, {1.0f, 4.0f, 3.0f, 8.0f, 5.0f, 12.0f});
+    }
+  }
+}
+
+TEST(InferenceSessionTests, ExternalInitializersLoadConcurrency) {
+  onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+
+  // Y = X + W0 + W1 + ... + W7, where the Wi are stored in an external data file
+  NodeArg* sum_arg = &graph.GetOrCreateNodeArg("X", &float_tensor);
+  for (int i = 0; i < 8; ++i) {
+    const std::string index = std::to_string(i);
+    ONNX_NAMESPACE::TensorProto w;
+    w.set_name("W" + index);
+    w.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    w.add_dims(2);
+    w.add_float_data(static_cast<float>(i));
+    w.add_float_data(static_cast<float>(10 * i));
+    graph.AddInitializedTensor(w);
+
+    auto& w_arg = graph.GetOrCreateNodeArg(w.name(), &float_tensor);
+    auto& output_arg = graph.GetOrCreateNodeArg(i == 7 ? "Y" : "S" + index, &float_tensor);
+    graph.AddNode("add_" + index, "Add", "", {sum_arg, &w_arg}, {&output_arg});
+    sum_arg = &output_arg;
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+  PathString model_file_name = ORT_TSTR("external_initializers_load_concurrency_test_graph.onnx");
+  ASSERT_STATUS_OK(onnxruntime::Model::SaveWithExternalInitializers(
+      model, model_file_name, "external_initializers_load_concurrency_test_graph.bin", 0));
+
+  for (const char* concurrency : {"1", "4"}) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.ExternalInitializersLoadConcurrency";
+    so.intra_op_param.thread_pool_size = 4;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigExternalInitializersLoadConcurrency,
+                                                      concurrency));
+    InferenceSession session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_file_name));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+    std::vector<int64_t> dims = {2};
+    OrtValue ml_value_x;
+    CreateMLValue<float>(allocator, dims, {1.0f, 2.0f}, &ml_value_x);
+    NameMLValMap feeds{{"X", ml_value_x}};
+
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, {"Y"}, &fetches));
+    VerifyOutputs(fetches, dims, {29.0f, 282.0f});
+  }
+}
+
 TEST(ExecutionProviderTest, ShapeInferenceForFusedFunctionTest) {
   onnxruntime::Model model("graph_1", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
   auto& graph = model.MainGraph();
@@ -2439,6 +2973,32 @@ TEST(InferenceSessionTests, LoadModelWithEnvVarSetToUnsupportedVal) {
 #endif
 }
 
+TEST(InferenceSessionTests, MergeIntoTuningResultsFile) {
+  TemporaryDirectory tmp_dir(ORT_TSTR("tuning_results_file_test"));
+  const PathString path = (std::filesystem::path{tmp_dir.Path()} / ORT_TSTR("tuning_results.json")).native();
+
+  std::vector<TuningResults> loaded;
+  ASSERT_STATUS_OK(inference_session_utils::LoadTuningResultsFile(path, loaded));
+  ASSERT_TRUE(loaded.empty());
+
+  TuningResults device_a{"EP", {{"ORT_VERSION", "1"}, {"DEVICE_MODEL", "A"}}, {{"Gemm", {{"1_2_3", 0}}}}};
+  ASSERT_STATUS_OK(inference_session_utils::MergeIntoTuningResultsFile(path, {device_a}));
+
+  // the kernel already in the file for 1_2_3 is kept, the new params and the new device are added
+  TuningResults device_a_more = device_a;
+  device_a_more.results = {{"Gemm", {{"1_2_3", 5}, {"4_5_6", 1}}}, {"Softmax", {{"8", 2}}}};
+  TuningResults device_b{"EP", {{"ORT_VERSION", "1"}, {"DEVICE_MODEL", "B"}}, {{"Gemm", {{"1_2_3", 3}}}}};
+  ASSERT_STATUS_OK(inference_session_utils::MergeIntoTuningResultsFile(path, {device_a_more, device_b}));
+
+  ASSERT_STATUS_OK(inference_session_utils::LoadTuningResultsFile(path, loaded));
+  ASSERT_EQ(loaded.size(), 2u);
+  EXPECT_EQ(loaded[0].validators, device_a.validators);
+  EXPECT_EQ(loaded[0].results, (std::unordered_map<std::string, KernelMap>{{"Gemm", {{"1_2_3", 0}, {"4_5_6", 1}}},
+                                                                           {"Softmax", {{"8", 2}}}}));
+  EXPECT_EQ(loaded[1].validators, device_b.validators);
+  EXPECT_EQ(loaded[1].results, device_b.results);
+}
+
 // Global threadpool related tests
 // We test for 4 combinations
 class InferenceSessionTestGlobalThreadPools : public InferenceSessionWrapper {
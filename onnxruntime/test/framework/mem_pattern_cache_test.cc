@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+#include "core/framework/mem_pattern_planner.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+MemoryPatternGroup CreatePatternGroup(size_t size) {
+  MemPatternPlanner planner{/*using_counters*/ false};
+  planner.TraceAllocation(0, size);
+  MemoryPatternGroup group;
+  group.locations.push_back(OrtDevice());
+  group.patterns.push_back(planner.GenerateMemPattern());
+  return group;
+}
+}  // namespace
+
+TEST(MemoryPatternCacheTest, FindRequiresCoveringDims) {
+  MemoryPatternCache cache;
+  const std::vector<int64_t> dims{1, 300};
+  cache.Insert(1, CreatePatternGroup(300), dims);
+
+  EXPECT_NE(cache.Find(1), nullptr);
+  EXPECT_NE(cache.Find(1, std::vector<int64_t>{1, 200}), nullptr);
+  EXPECT_EQ(cache.Find(1, std::vector<int64_t>{1, 400}), nullptr);
+  EXPECT_EQ(cache.Find(2), nullptr);
+  EXPECT_EQ(cache.Hits(), 2u);
+  EXPECT_EQ(cache.Misses(), 2u);
+}
+
+TEST(MemoryPatternCacheTest, InsertReplacesWithCoveringPattern) {
+  MemoryPatternCache cache;
+  cache.Insert(1, CreatePatternGroup(300), std::vector<int64_t>{1, 300});
+
+  // not replaced if not requested
+  auto patterns = cache.Insert(1, CreatePatternGroup(500), std::vector<int64_t>{1, 500});
+  EXPECT_EQ(patterns->patterns[0].PeakSize(), 300u);
+
+  // not replaced if the new dims don't cover the existing ones
+  patterns = cache.Insert(1, CreatePatternGroup(200), std::vector<int64_t>{1, 200}, true);
+  EXPECT_EQ(patterns->patterns[0].PeakSize(), 300u);
+
+  patterns = cache.Insert(1, CreatePatternGroup(500), std::vector<int64_t>{1, 500}, true);
+  EXPECT_EQ(patterns->patterns[0].PeakSize(), 500u);
+  EXPECT_EQ(cache.Size(), 1u);
+  EXPECT_EQ(cache.TotalBytes(), 500u);
+}
+
+TEST(MemoryPatternCacheTest, EvictsLeastRecentlyUsed) {
+  MemoryPatternCache cache(/*max_bytes*/ 1000);
+  cache.Insert(1, CreatePatternGroup(400));
+  cache.Insert(2, CreatePatternGroup(400));
+
+  // make 1 the most recently used entry
+  auto held = cache.Find(1);
+  ASSERT_NE(held, nullptr);
+
+  cache.Insert(3, CreatePatternGroup(400));
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_NE(cache.Find(1), nullptr);
+  EXPECT_EQ(cache.Find(2), nullptr);
+  EXPECT_NE(cache.Find(3), nullptr);
+  EXPECT_LE(cache.TotalBytes(), 1000u);
+
+  // evicted entries stay valid for holders
+  cache.SetMaxBytes(100);
+  EXPECT_EQ(cache.Size(), 0u);
+  EXPECT_EQ(held->patterns[0].PeakSize(), 400u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -35,5 +35,30 @@ TEST(MemPatternPlannerTest, TraceAllocaitonTest) {
   EXPECT_EQ(pattern.GetBlock(5)->offset_, 1024u + 256u + 512u);
   EXPECT_EQ(pattern.GetBlock(6)->offset_, 1024u);
 }
+
+TEST(MemPatternPlannerTest, GreedyBySizeTest) {
+  // the freed block of 0 is too small for 2, so the online placement leaves a hole.
+  auto trace = [](MemPatternPlanner& planner) {
+    planner.TraceAllocation(0, 100);
+    planner.TraceAllocation(1, 100);
+    planner.TraceFree(0);
+    planner.TraceAllocation(2, 200);
+  };
+
+  MemPatternPlanner online_planner{false};
+  trace(online_planner);
+  auto pattern = online_planner.GenerateMemPattern();
+  EXPECT_EQ(pattern.PeakSize(), 400u);
+  EXPECT_EQ(pattern.LowerBoundSize(), 300u);
+
+  MemPatternPlanner greedy_planner{false, MemPatternPlannerAlgorithm::kGreedyBySize};
+  trace(greedy_planner);
+  pattern = greedy_planner.GenerateMemPattern();
+  EXPECT_EQ(pattern.PeakSize(), 300u);
+  EXPECT_EQ(pattern.LowerBoundSize(), 300u);
+  EXPECT_EQ(pattern.GetBlock(2)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(0)->offset_, 0u);
+  EXPECT_EQ(pattern.GetBlock(1)->offset_, 200u);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -448,6 +448,115 @@ TEST(TransformerTest, MemcpyTransformerTestImplicitInputConsumedOnMultipleDevice
   ASSERT_TRUE(op_count_map["MemcpyFromHost"] == 1);
 }
 
+TEST(TransformerTest, MemcpyTransformerTestDuplicateCopiesAreMerged) {
+  // In this test, the graph already has 2 copies of the same value to the provider (CUDA), e.g. because it was saved
+  // after optimization. We expect the second copy to be removed and its consumer to read the first copy.
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 7;
+  auto model = std::make_shared<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                                    domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                    DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float_type;
+  tensor_float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg i1_def("I1", &tensor_float_type),
+      o1_def("O1", &tensor_float_type),
+      c1_def("C1", &tensor_float_type),
+      c2_def("C2", &tensor_float_type),
+      o2_def("O2", &tensor_float_type),
+      o3_def("O3", &tensor_float_type);
+
+  auto& node1 = graph.AddNode("node1", "MatMul", "cpu operator1", ArgMap{&i1_def, &i1_def}, ArgMap{&o1_def});
+  node1.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  auto& copy1 = graph.AddNode("copy1", "MemcpyFromHost", "copy 1", ArgMap{&o1_def}, ArgMap{&c1_def});
+  copy1.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+  auto& copy2 = graph.AddNode("copy2", "MemcpyFromHost", "copy 2", ArgMap{&o1_def}, ArgMap{&c2_def});
+  copy2.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+  auto& node2 = graph.AddNode("node2", "MatMul", "gpu operator1", ArgMap{&c1_def, &c1_def}, ArgMap{&o2_def});
+  node2.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+  auto& node3 = graph.AddNode("node3", "MatMul", "gpu operator2", ArgMap{&c2_def, &c2_def}, ArgMap{&o3_def});
+  node3.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCudaExecutionProvider, DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+  KernelRegistryManager test_registry_manager;
+  ASSERT_STATUS_OK(test_registry_manager.RegisterKernels(execution_providers));
+
+  MemcpyTransformer transformer({onnxruntime::kCudaExecutionProvider}, test_registry_manager);
+
+  bool modified = false;
+  status = transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger());
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_TRUE(modified);
+
+  auto op_count_map = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_count_map["MemcpyFromHost"] == 1);
+  EXPECT_EQ(node2.InputDefs()[0], node3.InputDefs()[0]);
+}
+
+TEST(TransformerTest, MemcpyTransformerTestSmallInitializerCopyIsHoisted) {
+  // In this test, the graph already has a copy of a small initializer to the provider (CUDA). We expect the copy
+  // node to be replaced by an initializer, which session state copies to the provider device at initialization.
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 7;
+  auto model = std::make_shared<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                                    domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                    DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float_type;
+  tensor_float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg i1_def("I1", &tensor_float_type),
+      w_def("W", &tensor_float_type),
+      c1_def("C1", &tensor_float_type),
+      o1_def("O1", &tensor_float_type);
+
+  TensorProto w;
+  w.set_name("W");
+  w.set_data_type(TensorProto_DataType_FLOAT);
+  w.add_dims(2);
+  w.add_dims(2);
+  for (int i = 0; i < 4; ++i) {
+    w.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(w);
+
+  auto& copy1 = graph.AddNode("copy1", "MemcpyFromHost", "copy 1", ArgMap{&w_def}, ArgMap{&c1_def});
+  copy1.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+  auto& node1 = graph.AddNode("node1", "MatMul", "gpu operator1", ArgMap{&i1_def, &c1_def}, ArgMap{&o1_def});
+  node1.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCudaExecutionProvider, DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+  KernelRegistryManager test_registry_manager;
+  ASSERT_STATUS_OK(test_registry_manager.RegisterKernels(execution_providers));
+
+  MemcpyTransformer transformer({onnxruntime::kCudaExecutionProvider}, test_registry_manager);
+
+  bool modified = false;
+  status = transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger());
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_TRUE(modified);
+
+  auto op_count_map = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_count_map["MemcpyFromHost"] == 0);
+  const TensorProto* hoisted = nullptr;
+  EXPECT_TRUE(graph.GetInitializedTensor(node1.InputDefs()[1]->Name(), hoisted));
+}
+
 #endif
 
 }  // namespace test
@@ -5,6 +5,7 @@
 #include "core/framework/data_types.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/TensorSeq.h"
+#include "core/graph/graph_flatbuffers_utils.h"
 #include "core/graph/model.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/onnxruntime_cxx_api.h"
@@ -295,6 +296,165 @@ TEST(OrtModelOnlyTests, ValidateOrtFormatModelDoesNotRunOptimizersInFullBuild) {
   RunOrtModel(test_info);
 }
 
+// the raw data of the larger initializers is aligned, so a mapped model file can be used for them directly
+TEST(OrtModelOnlyTests, InitializerRawDataIsAligned) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.aligned_test_output.ort");
+  SaveAndCompareModels(ORT_TSTR("testdata/mnist.onnx"), ort_file);
+
+  size_t num_bytes = 0;
+  ASSERT_STATUS_OK(Env::Default().GetFileLength(ort_file, num_bytes));
+  std::vector<uint8_t> bytes(num_bytes);
+  std::ifstream bytes_stream(ort_file, std::ifstream::in | std::ifstream::binary);
+  bytes_stream.read(reinterpret_cast<char*>(bytes.data()), num_bytes);
+  ASSERT_TRUE(bytes_stream);
+
+  const auto* fbs_initializers = fbs::GetInferenceSession(bytes.data())->model()->graph()->initializers();
+  ASSERT_NE(fbs_initializers, nullptr);
+  size_t num_checked = 0;
+  for (const auto* fbs_tensor : *fbs_initializers) {
+    const auto* raw_data = fbs_tensor->raw_data();
+    if (raw_data != nullptr && raw_data->size() >= fbs::utils::kMinInitializerBytesForDirectUse) {
+      EXPECT_EQ((raw_data->Data() - bytes.data()) % fbs::utils::kInitializerRawDataAlignment, 0)
+          << fbs_tensor->name()->str();
+      ++num_checked;
+    }
+  }
+  EXPECT_GT(num_checked, 0u);
+
+  OrtModelTestInfo test_info;
+  test_info.model_filename = ort_file;
+  test_info.logid = "InitializerRawDataIsAligned";
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  test_info.disable_copy_ort_buffer = true;
+  test_info.use_buffer_for_initializers = true;
+
+  OrtValue ml_value;
+  std::vector<float> data(28 * 28, 0.0);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, data,
+                       &ml_value);
+  test_info.inputs.insert(std::make_pair("Input3", ml_value));
+
+  test_info.output_names = {"Plus214_Output_0"};
+  test_info.output_verifier = [](const std::vector<OrtValue>& fetches) {
+    const auto& output = fetches[0].Get<Tensor>();
+    ASSERT_TRUE(output.Shape().NumDimensions() == 2);
+  };
+
+  RunOrtModel(test_info);
+}
+
+#if !defined(ENABLE_TRAINING) && !defined(ENABLE_STRIDED_TENSORS) && !defined(ORT_MEMORY_PROFILE)
+TEST(OrtModelOnlyTests, SerializeExecutionPlanToOrtFormat) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.execution_plan.test_output.ort");
+
+  SessionOptions so;
+  so.session_logid = "SerializeExecutionPlanToOrtFormat";
+  so.optimized_model_filepath = ort_file;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveExecutionPlanInOrtFormat, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/mnist.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  EXPECT_FALSE(session_object.GetSessionState().IsExecutionPlanFromOrtFormat());
+
+  const auto load_ort_model = [&ort_file](const std::string& use_saved_plan) {
+    SessionOptions so2;
+    so2.session_logid = "LoadExecutionPlanFromOrtFormat";
+    ORT_THROW_IF_ERROR(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+    ORT_THROW_IF_ERROR(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseSavedExecutionPlan,
+                                                         use_saved_plan.c_str()));
+    auto session = std::make_unique<InferenceSessionWrapper>(so2, GetEnvironment());
+    ORT_THROW_IF_ERROR(session->Load(ort_file));
+    ORT_THROW_IF_ERROR(session->Initialize());
+    return session;
+  };
+
+  auto session_with_saved_plan = load_ort_model("1");
+  auto session_with_new_plan = load_ort_model("0");
+  EXPECT_TRUE(session_with_saved_plan->GetSessionState().IsExecutionPlanFromOrtFormat());
+  EXPECT_FALSE(session_with_new_plan->GetSessionState().IsExecutionPlanFromOrtFormat());
+
+  // the loaded plan must match the one the planner creates for the ORT format model
+  const auto& saved_plan = *session_with_saved_plan->GetSessionState().GetExecutionPlan();
+  const auto& new_plan = *session_with_new_plan->GetSessionState().GetExecutionPlan();
+  ASSERT_EQ(saved_plan.allocation_plan.size(), new_plan.allocation_plan.size());
+  for (size_t i = 0; i < saved_plan.allocation_plan.size(); ++i) {
+    const auto& saved = saved_plan.allocation_plan[i];
+    const auto& created = new_plan.allocation_plan[i];
+    EXPECT_EQ(saved.alloc_kind, created.alloc_kind) << "OrtValue " << i;
+    EXPECT_EQ(saved.reused_buffer, created.reused_buffer) << "OrtValue " << i;
+    EXPECT_EQ(saved.location, created.location) << "OrtValue " << i;
+    EXPECT_EQ(saved.program_counter.Starts(), created.program_counter.Starts()) << "OrtValue " << i;
+    EXPECT_EQ(saved.program_counter.Ends(), created.program_counter.Ends()) << "OrtValue " << i;
+  }
+
+  ASSERT_EQ(saved_plan.execution_plan.size(), new_plan.execution_plan.size());
+  for (size_t i = 0; i < saved_plan.execution_plan.size(); ++i) {
+    const auto& saved_steps = saved_plan.execution_plan[i]->steps_;
+    const auto& created_steps = new_plan.execution_plan[i]->steps_;
+    ASSERT_EQ(saved_steps.size(), created_steps.size());
+    for (size_t j = 0; j < saved_steps.size(); ++j) {
+      EXPECT_EQ(saved_steps[j]->GetType(), created_steps[j]->GetType());
+      EXPECT_EQ(saved_steps[j]->GetNodeIndex(), created_steps[j]->GetNodeIndex());
+    }
+  }
+
+  OrtValue ml_value;
+  std::vector<float> data(28 * 28, 0.0);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+  std::vector<OrtValue> saved_plan_fetches;
+  std::vector<OrtValue> new_plan_fetches;
+  ASSERT_STATUS_OK(session_with_saved_plan->Run(feeds, output_names, &saved_plan_fetches));
+  ASSERT_STATUS_OK(session_with_new_plan->Run(feeds, output_names, &new_plan_fetches));
+  ASSERT_EQ(saved_plan_fetches.size(), 1u);
+  const auto saved_plan_output = saved_plan_fetches[0].Get<Tensor>().DataAsSpan<float>();
+  const auto new_plan_output = new_plan_fetches[0].Get<Tensor>().DataAsSpan<float>();
+  EXPECT_EQ(std::vector<float>(saved_plan_output.begin(), saved_plan_output.end()),
+            std::vector<float>(new_plan_output.begin(), new_plan_output.end()));
+}
+#endif
+
+// the pre-packed MatMul weights written next to the ORT format model are restored instead of pre-packed on load
+TEST(OrtModelOnlyTests, SavePrepackedWeightsWithOrtFormatModel) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.prepacked_weights.test_output.ort");
+
+  SessionOptions so;
+  so.session_logid = "SavePrepackedWeightsWithOrtFormatModel";
+  so.optimized_model_filepath = ort_file;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigSavePrepackedWeightsWithOrtModel, "1"));
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/mnist.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  SessionOptions so2;
+  so2.session_logid = "LoadPrepackedWeightsWithOrtFormatModel";
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+  InferenceSessionWrapper session_object2{so2, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load(ort_file));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+  EXPECT_GT(session_object2.GetSessionState().GetRestoredPrePackedWeightCounter(), static_cast<size_t>(0));
+
+  OrtValue ml_value;
+  std::vector<float> data(28 * 28, 0.5f);
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<std::string> output_names{"Plus214_Output_0"};
+  std::vector<OrtValue> expected_fetches;
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, output_names, &expected_fetches));
+  ASSERT_STATUS_OK(session_object2.Run(feeds, output_names, &fetches));
+  ASSERT_EQ(fetches.size(), 1u);
+  const auto expected_output = expected_fetches[0].Get<Tensor>().DataAsSpan<float>();
+  const auto output = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  EXPECT_EQ(std::vector<float>(expected_output.begin(), expected_output.end()),
+            std::vector<float>(output.begin(), output.end()));
+}
+
 TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   const auto ort_file = ORT_TSTR("testdata/ort_github_issue_4031.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/ort_github_issue_4031.onnx"), ort_file);
@@ -557,6 +717,14 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBufferNoCopyInitializersUseBuffer)
   RunOrtModel(test_info);
 }
 
+// Load the model from a file path, mapping the file into memory, and use the mapped file for the initializers
+TEST(OrtModelOnlyTests, LoadOrtFormatModelMappedInitializersUseFile) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.disable_copy_ort_buffer = true;
+  test_info.use_buffer_for_initializers = true;
+  RunOrtModel(test_info);
+}
+
 // regression test for 2 issues covered by PR #17000 (internally reported issue).
 // 1) allocation planner broke in minimal build when subgraph had no nodes.
 // 2) usage of a sequence data type caused an exception due to IsSparseTensor() throwing
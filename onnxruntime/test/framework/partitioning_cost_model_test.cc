@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/partitioning_cost_model.h"
+
+#include "core/framework/kernel_def_builder.h"
+#include "core/framework/op_kernel.h"
+#include "core/graph/model.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "asserts.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Finds the same kernel, which takes and produces everything in device memory, for every node
+class TestKernelLookup : public IExecutionProvider::IKernelLookup {
+ public:
+  explicit TestKernelLookup(const std::string& provider_type)
+      : kernel_create_info_{KernelDefBuilder().SetName("Test").Provider(provider_type.c_str()).Build(), nullptr} {}
+
+  const KernelCreateInfo* LookUpKernel(const Node& /*node*/) const override { return &kernel_create_info_; }
+
+ private:
+  KernelCreateInfo kernel_create_info_;
+};
+
+// Builds a graph of X, Y -> Add -> op_types[0] -> ... -> Z, with the tensors of shape [1024]
+std::unique_ptr<Model> BuildChain(const std::vector<std::string>& op_types) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  auto model = std::make_unique<Model>("cost_model_test", false, ModelMetaData(), PathString(),
+                                       IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                       std::vector<FunctionProto>(), DefaultLoggingManager().DefaultLogger());
+  auto& graph = model->MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1024);
+
+  auto* x = &graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto* y = &graph.GetOrCreateNodeArg("Y", &float_tensor);
+  auto* current = &graph.GetOrCreateNodeArg("add_out", &float_tensor);
+  graph.AddNode("add", "Add", "", {x, y}, {current});
+  // the output of a MatMul of two vectors is a scalar
+  TypeProto float_scalar;
+  float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_scalar.mutable_tensor_type()->mutable_shape();
+
+  for (size_t i = 0; i < op_types.size(); ++i) {
+    const auto name = op_types[i] + "_" + std::to_string(i);
+    const bool is_matmul = op_types[i] == "MatMul";
+    auto* next = &graph.GetOrCreateNodeArg(i + 1 == op_types.size() ? "Z" : name + "_out",
+                                           is_matmul ? &float_scalar : &float_tensor);
+    if (is_matmul) {
+      graph.AddNode(name, op_types[i], "", {current, current}, {next});
+    } else {
+      graph.AddNode(name, op_types[i], "", {current}, {next});
+    }
+    current = next;
+  }
+  return model;
+}
+
+std::unordered_set<NodeIndex> GetNodesCheaperOnCpu(const Graph& graph) {
+  const GraphViewer graph_viewer(graph);
+  const TestKernelLookup kernel_lookup{"TestDeviceExecutionProvider"};
+  const TestKernelLookup cpu_kernel_lookup{kCpuExecutionProvider};
+  const auto& nodes = graph_viewer.GetNodesInTopologicalOrder();
+  return onnxruntime::GetNodesCheaperOnCpu(graph_viewer, kernel_lookup, cpu_kernel_lookup, nodes);
+}
+
+}  // namespace
+
+TEST(PartitioningCostModelTest, SmallIslandIsCheaperOnCpu) {
+  auto model = BuildChain({});
+  auto& graph = model->MainGraph();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // a single Add copies all of its inputs and its output
+  EXPECT_EQ(GetNodesCheaperOnCpu(graph).size(), 1u);
+}
+
+TEST(PartitioningCostModelTest, LargeIslandStaysOnDevice) {
+  auto model = BuildChain({"Relu", "Neg", "Abs", "Relu"});
+  auto& graph = model->MainGraph();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // the intermediate tensors of the chain are never copied
+  EXPECT_TRUE(GetNodesCheaperOnCpu(graph).empty());
+}
+
+TEST(PartitioningCostModelTest, ComputeBoundIslandStaysOnDevice) {
+  auto model = BuildChain({"MatMul"});
+  auto& graph = model->MainGraph();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  EXPECT_TRUE(GetNodesCheaperOnCpu(graph).empty());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <thread>
+
+#include "core/framework/tensor.h"
+#include "core/session/request_batcher.h"
+#include "test_utils.h"
+#include "test/util/include/asserts.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Doubles every element of the single input "X" and returns it as "Y". Counts the number of executions.
+RequestBatcher::ExecuteFn MakeDoublingExecuteFn(AllocatorPtr allocator, std::atomic<int>& num_executions) {
+  return [allocator, &num_executions](const RunOptions&, gsl::span<const std::string>, gsl::span<const OrtValue> feeds,
+                                      gsl::span<const std::string>, std::vector<OrtValue>* p_fetches) {
+    ++num_executions;
+    const auto& input = feeds[0].Get<Tensor>();
+    p_fetches->resize(1);
+    Tensor::InitOrtValue(input.DataType(), input.Shape(), allocator, (*p_fetches)[0]);
+    auto output = (*p_fetches)[0].GetMutable<Tensor>()->MutableDataAsSpan<float>();
+    auto input_data = input.DataAsSpan<float>();
+    for (size_t i = 0; i < input_data.size(); ++i) {
+      output[i] = input_data[i] * 2.f;
+    }
+
+    return Status::OK();
+  };
+}
+
+}  // namespace
+
+TEST(RequestBatcherTest, ParseConfig) {
+  RequestBatcher::Config config;
+  bool enabled = true;
+  ASSERT_STATUS_OK(RequestBatcher::ParseConfig("", "", "", config, enabled));
+  EXPECT_FALSE(enabled);
+
+  ASSERT_STATUS_OK(RequestBatcher::ParseConfig("1", "", "", config, enabled));
+  EXPECT_FALSE(enabled);
+
+  ASSERT_STATUS_OK(RequestBatcher::ParseConfig("8", "100", "1", config, enabled));
+  EXPECT_TRUE(enabled);
+  EXPECT_EQ(config.max_batch_size, 8);
+  EXPECT_EQ(config.max_wait.count(), 100);
+  EXPECT_EQ(config.batch_axis, 1u);
+
+  ASSERT_STATUS_NOT_OK(RequestBatcher::ParseConfig("8", "-1", "", config, enabled));
+  ASSERT_STATUS_NOT_OK(RequestBatcher::ParseConfig("eight", "", "", config, enabled));
+}
+
+TEST(RequestBatcherTest, IsBatchable) {
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  std::atomic<int> num_executions{0};
+  RequestBatcher::Config config;
+  config.max_batch_size = 4;
+  RequestBatcher batcher(config, allocator, MakeDoublingExecuteFn(allocator, num_executions));
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+
+  std::vector<OrtValue> feeds(1);
+  CreateMLValue<float>(allocator, {1, 3}, {1.f, 2.f, 3.f}, &feeds[0]);
+  std::vector<OrtValue> fetches;
+  EXPECT_TRUE(batcher.IsBatchable(feed_names, feeds, output_names, fetches));
+
+  // pre-allocated fetches are not supported
+  fetches.resize(1);
+  CreateMLValue<float>(allocator, {1, 3}, {0.f, 0.f, 0.f}, &fetches[0]);
+  EXPECT_FALSE(batcher.IsBatchable(feed_names, feeds, output_names, fetches));
+
+  // a request that fills the batch on its own gains nothing from batching
+  fetches.clear();
+  CreateMLValue<float>(allocator, {4, 1}, {1.f, 2.f, 3.f, 4.f}, &feeds[0]);
+  EXPECT_FALSE(batcher.IsBatchable(feed_names, feeds, output_names, fetches));
+
+  // scalars have no batch axis
+  CreateMLValue<float>(allocator, {}, {1.f}, &feeds[0]);
+  EXPECT_FALSE(batcher.IsBatchable(feed_names, feeds, output_names, fetches));
+}
+
+TEST(RequestBatcherTest, ConcurrentRequestsAreMerged) {
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  std::atomic<int> num_executions{0};
+
+  constexpr int kNumRequests = 4;
+  RequestBatcher::Config config;
+  config.max_batch_size = kNumRequests;
+  // long enough that the batch always fills up before the leader gives up waiting
+  config.max_wait = std::chrono::microseconds(10 * 1000 * 1000);
+  RequestBatcher batcher(config, allocator, MakeDoublingExecuteFn(allocator, num_executions));
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+
+  std::vector<std::vector<OrtValue>> feeds(kNumRequests, std::vector<OrtValue>(1));
+  std::vector<std::vector<OrtValue>> fetches(kNumRequests);
+  std::vector<Status> statuses(kNumRequests);
+  for (int i = 0; i < kNumRequests; ++i) {
+    const float value = static_cast<float>(i);
+    CreateMLValue<float>(allocator, {1, 2}, {value, value + 0.5f}, &feeds[i][0]);
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumRequests; ++i) {
+    threads.emplace_back([&, i]() {
+      statuses[i] = batcher.Run(RunOptions{}, feed_names, feeds[i], output_names, fetches[i]);
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_executions, 1);
+  for (int i = 0; i < kNumRequests; ++i) {
+    ASSERT_STATUS_OK(statuses[i]);
+    ASSERT_EQ(fetches[i].size(), 1u);
+    const auto& output = fetches[i][0].Get<Tensor>();
+    EXPECT_EQ(output.Shape(), TensorShape({1, 2}));
+    const float value = static_cast<float>(i);
+    EXPECT_EQ(output.Data<float>()[0], value * 2.f);
+    EXPECT_EQ(output.Data<float>()[1], (value + 0.5f) * 2.f);
+  }
+}
+
+TEST(RequestBatcherTest, SingleRequestRunsAfterWait) {
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  std::atomic<int> num_executions{0};
+
+  RequestBatcher::Config config;
+  config.max_batch_size = 8;
+  config.max_wait = std::chrono::microseconds(100);
+  RequestBatcher batcher(config, allocator, MakeDoublingExecuteFn(allocator, num_executions));
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> feeds(1);
+  CreateMLValue<float>(allocator, {2, 1}, {1.f, 2.f}, &feeds[0]);
+  std::vector<OrtValue> fetches;
+
+  ASSERT_STATUS_OK(batcher.Run(RunOptions{}, feed_names, feeds, output_names, fetches));
+  EXPECT_EQ(num_executions, 1);
+  const auto& output = fetches[0].Get<Tensor>();
+  EXPECT_EQ(output.Data<float>()[0], 2.f);
+  EXPECT_EQ(output.Data<float>()[1], 4.f);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
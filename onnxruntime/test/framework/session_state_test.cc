@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cstdio>
 #include <iostream>
 
 #include "asserts.h"
@@ -10,6 +11,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/session_state.h"
+#include "core/framework/shared_weights_file.h"
 #include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
@@ -380,8 +382,24 @@ class PrePackingTestOpKernel : public OpKernel {
     return Status::OK();
   }
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   gsl::span<const size_t> prepacked_buffer_sizes, int input_idx,
+                                   /*out*/ bool& used_cached_buffers) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+
+    used_cached_buffers = prepacked_buffers.size() == 1 && prepacked_buffer_sizes[0] == 8;
+    if (used_cached_buffers) {
+      weight_packed_ = std::move(prepacked_buffers[0]);
+    }
+
+    ++use_cached_pre_packed_weight_calls_count;
+    return Status::OK();
+  }
+
   int prepack_calls_count = 0;
   int store_pre_packed_weight_calls_count = 0;
+  int use_cached_pre_packed_weight_calls_count = 0;
   IAllocatorUniquePtr<void> weight_packed_;
 };
 
@@ -850,6 +868,174 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test3) {
   ASSERT_EQ(session_state_2.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
 }
 
+static void CreateGraphWithNodesSharingWeight(Graph& graph, int num_nodes) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& weight_arg = graph.GetOrCreateNodeArg("shared_weight", &type);
+  for (int i = 0; i < num_nodes; ++i) {
+    const std::string suffix = std::to_string(i);
+    auto& input_arg = graph.GetOrCreateNodeArg("input_" + suffix, &type);
+    auto& output_arg = graph.GetOrCreateNodeArg("output_" + suffix, &type);
+    graph.AddNode("node_" + suffix, "PrePackingTest", "node " + suffix, {&input_arg, &weight_arg}, {&output_arg});
+  }
+
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.add_float_data(1.0f);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("shared_weight");
+  graph.AddInitializedTensor(tensor);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK());
+}
+
+// Parallel kernel creation and pre-packing must share the pre-packed weights the same way the serial path does:
+// the first node in node order writes the weight into the container and every other node uses the cached one.
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, ParallelPrePackingIsDeterministic) {
+  constexpr int num_nodes = 32;
+
+  OrtThreadPoolParams to;
+  to.thread_pool_size = 4;
+  auto parallel_tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), to,
+                                                   concurrency::ThreadPoolType::INTRA_OP);
+
+  OrtMemoryInfo mem_info(CPU, OrtDeviceAllocator);
+  std::vector<float> float_data(1, 1);
+  auto value = std::make_unique<OrtValue>();
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape(std::vector<int64_t>{1}),
+                       reinterpret_cast<void*>(float_data.data()), mem_info, *value);
+
+  for (const char* disable_parallel : {"0", "1"}) {
+    SessionOptions sess_options;
+    sess_options.enable_mem_pattern = true;
+    sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+    sess_options.use_deterministic_compute = false;
+    sess_options.enable_mem_reuse = true;
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+    sess_options.config_options.configurations[kOrtSessionOptionsConfigDisableParallelKernelCreation] =
+        disable_parallel;
+    ASSERT_STATUS_OK(sess_options.AddInitializer("shared_weight", value.get()));
+
+    PrepackedWeightsContainer prepacked_weights_container;
+
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+
+    CreateGraphWithNodesSharingWeight(model.MainGraph(), num_nodes);
+    PlaceAllNodesToCPUEP(model.MainGraph());
+    SessionState session_state(model.MainGraph(),
+                               execution_providers,
+                               parallel_tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options,
+                               &prepacked_weights_container);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(num_nodes));
+    ASSERT_EQ(session_state.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(num_nodes - 1));
+    ASSERT_EQ(prepacked_weights_container.GetNumberOfElements(), static_cast<size_t>(1));
+
+    for (const auto& node : model.MainGraph().Nodes()) {
+      const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(node.Index()));
+      ASSERT_NE(kernel, nullptr);
+      ASSERT_EQ(kernel->prepack_calls_count, 1);
+      ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
+    }
+
+    // the shared initializer is no longer needed once every node pre-packed it
+    ASSERT_TRUE(session_state.GetConstantInitializedTensors().empty());
+  }
+}
+
+// Pre-packed weights written to the persistent cache are restored without calling PrePack() again
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, PersistentPrePackedWeightsCache) {
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = true;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+
+  const PathString cache_path = ORT_TSTR("test_prepacked_weights_cache.bin");
+  PrepackedWeightsCache cache_1;
+
+  // First session/model pre-packs the weight and collects it for the cache
+  Model model_1("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+
+  CreateSimpleGraph(model_1.MainGraph());
+  PlaceAllNodesToCPUEP(model_1.MainGraph());
+  SessionState session_state_1(model_1.MainGraph(),
+                               execution_providers,
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+  session_state_1.SetPrepackedWeightsCache(&cache_1);
+
+  ASSERT_STATUS_OK(session_state_1.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+  const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state_1.GetKernel(0));
+  ASSERT_EQ(session_state_1.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+  ASSERT_EQ(session_state_1.GetRestoredPrePackedWeightCounter(), static_cast<size_t>(0));
+  ASSERT_EQ(kernel->prepack_calls_count, 1);
+  ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 0);
+  ASSERT_EQ(cache_1.new_entries.size(), static_cast<size_t>(1));
+
+  const SharedWeightsFile::Entry* new_entry = &cache_1.new_entries[0];
+  ASSERT_STATUS_OK(SharedWeightsFile::SaveEntries(gsl::make_span(&new_entry, 1), cache_path));
+
+  // Second session/model restores the weight from the file
+  PrepackedWeightsCache cache_2;
+  ASSERT_STATUS_OK(SharedWeightsFile::Load(Env::Default(), cache_path, cache_2.file));
+
+  Model model_2("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+
+  CreateSimpleGraph(model_2.MainGraph());
+  PlaceAllNodesToCPUEP(model_2.MainGraph());
+  SessionState session_state_2(model_2.MainGraph(),
+                               execution_providers,
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler,
+                               sess_options);
+  session_state_2.SetPrepackedWeightsCache(&cache_2);
+
+  ASSERT_STATUS_OK(session_state_2.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager));
+
+  kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state_2.GetKernel(0));
+  ASSERT_EQ(session_state_2.GetNumberOfPrepacksCounter(), static_cast<size_t>(0));
+  ASSERT_EQ(session_state_2.GetRestoredPrePackedWeightCounter(), static_cast<size_t>(1));
+  ASSERT_EQ(kernel->prepack_calls_count, 0);
+  ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 1);
+  ASSERT_TRUE(cache_2.new_entries.empty());
+  EXPECT_EQ(reinterpret_cast<const float*>(kernel->weight_packed_.get())[0], 1.2345f);
+
+  // the initializer is released as if it had been pre-packed
+  ASSERT_TRUE(session_state_2.GetConstantInitializedTensors().empty());
+
+  cache_2.file.reset();
+  ASSERT_EQ(std::remove(PathToUTF8String(cache_path).c_str()), 0);
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include "core/framework/tensor.h"
+#include "core/graph/model.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "asserts.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Builds a graph with an initializer W of `values` feeding an Add
+std::unique_ptr<Model> BuildModel(const std::vector<float>& values) {
+  std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, 13}};
+  auto model = std::make_unique<Model>("shared_initializer_store_test", false, ModelMetaData(), PathString(),
+                                       IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                       std::vector<FunctionProto>(), DefaultLoggingManager().DefaultLogger());
+  auto& graph = model->MainGraph();
+
+  TensorProto w;
+  w.set_name("W");
+  w.set_data_type(TensorProto_DataType_FLOAT);
+  w.add_dims(static_cast<int64_t>(values.size()));
+  w.set_raw_data(values.data(), values.size() * sizeof(float));
+  graph.AddInitializedTensor(w);
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(static_cast<int64_t>(values.size()));
+  auto* x = &graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto* wa = &graph.GetOrCreateNodeArg("W", &float_tensor);
+  auto* y = &graph.GetOrCreateNodeArg("Y", &float_tensor);
+  graph.AddNode("add", "Add", "", {x, wa}, {y});
+  return model;
+}
+
+}  // namespace
+
+TEST(SharedInitializerStoreTest, EqualInitializersShareABuffer) {
+  SharedInitializerStore store;
+  const std::vector<float> values(1024, 1.5f);
+  auto model_1 = BuildModel(values);
+  auto model_2 = BuildModel(values);
+  ASSERT_STATUS_OK(model_1->MainGraph().Resolve());
+  ASSERT_STATUS_OK(model_2->MainGraph().Resolve());
+
+  std::unordered_map<std::string, OrtValue> initializers_1, initializers_2;
+  size_t num_shared = 0;
+  ASSERT_STATUS_OK(store.GetOrAddInitializers(Env::Default(), PathString(), model_1->MainGraph(), 0,
+                                              initializers_1, num_shared));
+  EXPECT_EQ(num_shared, 0u);
+  ASSERT_STATUS_OK(store.GetOrAddInitializers(Env::Default(), PathString(), model_2->MainGraph(), 0,
+                                              initializers_2, num_shared));
+  EXPECT_EQ(num_shared, 1u);
+
+  const auto& w_1 = initializers_1.at("W").Get<Tensor>();
+  const auto& w_2 = initializers_2.at("W").Get<Tensor>();
+  EXPECT_EQ(w_1.DataRaw(), w_2.DataRaw());
+  EXPECT_EQ(w_2.Data<float>()[1023], 1.5f);
+}
+
+TEST(SharedInitializerStoreTest, DifferentInitializersDontShare) {
+  SharedInitializerStore store;
+  std::vector<float> values(1024, 1.5f);
+  auto model_1 = BuildModel(values);
+  values[512] = 2.5f;
+  auto model_2 = BuildModel(values);
+  ASSERT_STATUS_OK(model_1->MainGraph().Resolve());
+  ASSERT_STATUS_OK(model_2->MainGraph().Resolve());
+
+  std::unordered_map<std::string, OrtValue> initializers_1, initializers_2;
+  size_t num_shared = 0;
+  ASSERT_STATUS_OK(store.GetOrAddInitializers(Env::Default(), PathString(), model_1->MainGraph(), 0,
+                                              initializers_1, num_shared));
+  ASSERT_STATUS_OK(store.GetOrAddInitializers(Env::Default(), PathString(), model_2->MainGraph(), 0,
+                                              initializers_2, num_shared));
+  EXPECT_EQ(num_shared, 0u);
+  EXPECT_NE(initializers_1.at("W").Get<Tensor>().DataRaw(), initializers_2.at("W").Get<Tensor>().DataRaw());
+}
+
+TEST(SharedInitializerStoreTest, SmallInitializersAreSkipped) {
+  SharedInitializerStore store;
+  auto model = BuildModel(std::vector<float>(16, 1.5f));
+  ASSERT_STATUS_OK(model->MainGraph().Resolve());
+
+  std::unordered_map<std::string, OrtValue> initializers;
+  size_t num_shared = 0;
+  ASSERT_STATUS_OK(store.GetOrAddInitializers(Env::Default(), PathString(), model->MainGraph(), 1024,
+                                              initializers, num_shared));
+  EXPECT_TRUE(initializers.empty());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -1154,6 +1154,123 @@ TEST_F(GraphTest, GraphConstruction_PriorityBasedTopologicalSort_MultiLayerRecom
   }
 }
 
+TEST_F(GraphTest, GraphConstruction_MemoryEfficientTopologicalSort) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  /*
+                          |
+                  node_0 (Identity)
+                      /      \
+        expand_a (Identity)  expand_b (Identity)
+                    |         |
+        reduce_a (Identity)  reduce_b (Identity)
+                      \       /
+                      node_5 (Merge)
+                          |
+  The outputs of expand_a and expand_b are large, so each branch is completed before the other one starts.
+  */
+
+  TypeProto small_tensor;
+  small_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  small_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto large_tensor;
+  large_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  large_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1024);
+
+  auto& input_arg0 = graph.GetOrCreateNodeArg("node_0_in_1", &small_tensor);
+  auto& output_arg0 = graph.GetOrCreateNodeArg("node_0_out_1", &small_tensor);
+  auto& expand_a_out = graph.GetOrCreateNodeArg("expand_a_out_1", &large_tensor);
+  auto& expand_b_out = graph.GetOrCreateNodeArg("expand_b_out_1", &large_tensor);
+  auto& reduce_a_out = graph.GetOrCreateNodeArg("reduce_a_out_1", &small_tensor);
+  auto& reduce_b_out = graph.GetOrCreateNodeArg("reduce_b_out_1", &small_tensor);
+  auto& output_arg5 = graph.GetOrCreateNodeArg("node_5_out_1", &small_tensor);
+
+  graph.AddNode("node_0", "Identity_Fake", "node 0", {&input_arg0}, {&output_arg0});
+  graph.AddNode("expand_a", "Identity_Fake", "expand a", {&output_arg0}, {&expand_a_out});
+  graph.AddNode("expand_b", "Identity_Fake", "expand b", {&output_arg0}, {&expand_b_out});
+  graph.AddNode("reduce_a", "Identity_Fake", "reduce a", {&expand_a_out}, {&reduce_a_out});
+  graph.AddNode("reduce_b", "Identity_Fake", "reduce b", {&expand_b_out}, {&reduce_b_out});
+  graph.AddNode("node_5", "Merge_Fake", "node 5", {&reduce_a_out, &reduce_b_out}, {&output_arg5});
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  GraphViewer graph_viewer(graph);
+
+  auto& order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  const std::vector<std::string> expected_order =
+      {"node_0", "expand_a", "reduce_a", "expand_b", "reduce_b", "node_5"};
+  ASSERT_EQ(order.size(), expected_order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    auto node = graph.GetNode(order[i]);
+    EXPECT_TRUE(node->Name() == expected_order[i]) << "Memory efficient execution order is wrong.";
+  }
+}
+
+TEST_F(GraphTest, GraphConstruction_MemoryEfficientTopologicalSortLookahead) {
+  Model model("graph_1", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  /*
+                          |
+                  node_0 (Identity)
+                          |
+                  node_l (Identity)
+                  /       |       \
+     node_b (Identity)    |     node_t (Identity)
+                  \       |        |
+                  node_m (Merge)  node_c (Identity)
+                          \       /
+                        node_5 (Merge)
+                            |
+  The output of node_l is large and the outputs of node_b and node_c are medium. node_t grows the live tensors less
+  than node_b, but node_b makes node_m ready, which frees the output of node_b. Running node_b and node_m before
+  node_c keeps only one medium tensor alive next to the large one.
+  */
+
+  auto make_tensor = [](int64_t size) {
+    TypeProto tensor;
+    tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+    tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(size);
+    return tensor;
+  };
+  const TypeProto tiny_tensor = make_tensor(1);
+  const TypeProto small_tensor = make_tensor(2);
+  const TypeProto medium_tensor = make_tensor(384);
+  const TypeProto medium_large_tensor = make_tensor(512);
+  const TypeProto large_tensor = make_tensor(1024);
+
+  auto& input_arg0 = graph.GetOrCreateNodeArg("node_0_in_1", &tiny_tensor);
+  auto& output_arg0 = graph.GetOrCreateNodeArg("node_0_out_1", &tiny_tensor);
+  auto& l_out = graph.GetOrCreateNodeArg("node_l_out_1", &large_tensor);
+  auto& b_out = graph.GetOrCreateNodeArg("node_b_out_1", &medium_large_tensor);
+  auto& m_out = graph.GetOrCreateNodeArg("node_m_out_1", &tiny_tensor);
+  auto& t_out = graph.GetOrCreateNodeArg("node_t_out_1", &small_tensor);
+  auto& c_out = graph.GetOrCreateNodeArg("node_c_out_1", &medium_tensor);
+  auto& output_arg5 = graph.GetOrCreateNodeArg("node_5_out_1", &tiny_tensor);
+
+  graph.AddNode("node_0", "Identity_Fake", "node 0", {&input_arg0}, {&output_arg0});
+  graph.AddNode("node_l", "Identity_Fake", "node l", {&output_arg0}, {&l_out});
+  graph.AddNode("node_b", "Identity_Fake", "node b", {&l_out}, {&b_out});
+  graph.AddNode("node_m", "Merge_Fake", "node m", {&l_out, &b_out}, {&m_out});
+  graph.AddNode("node_t", "Identity_Fake", "node t", {&l_out}, {&t_out});
+  graph.AddNode("node_c", "Identity_Fake", "node c", {&t_out}, {&c_out});
+  graph.AddNode("node_5", "Merge_Fake", "node 5", {&m_out, &c_out}, {&output_arg5});
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  GraphViewer graph_viewer(graph);
+
+  auto& order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  const std::vector<std::string> expected_order =
+      {"node_0", "node_l", "node_b", "node_m", "node_t", "node_c", "node_5"};
+  ASSERT_EQ(order.size(), expected_order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    auto node = graph.GetNode(order[i]);
+    EXPECT_TRUE(node->Name() == expected_order[i]) << "Memory efficient execution order is wrong.";
+  }
+}
+
 TEST_F(GraphTest, GraphConstruction_CheckGraphInputOutputOrderMaintained) {
   Model model("graph_1", false, *logger_);
   auto& graph = model.MainGraph();
@@ -1509,6 +1626,62 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                                         "[ShapeInferenceError] try harder"));
 }
 
+// Resolve only runs type and shape inference on the nodes that changed since the previous Resolve
+TEST_F(GraphTest, IncrementalTypeInference) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& a = graph.GetOrCreateNodeArg("A", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("B", nullptr);
+  graph.AddNode("abs", "Abs", "", {&x}, {&a});
+  auto& transpose = graph.AddNode("transpose", "Transpose", "", {&a}, {&b});
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_NE(b.Shape(), nullptr);
+  EXPECT_EQ(b.Shape()->dim(0).dim_value(), 3);
+
+  // tracked changes: the shape of A is inferred again, and then the shape of B
+  a.ClearShape();
+  b.ClearShape();
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_NE(b.Shape(), nullptr);
+  EXPECT_EQ(b.Shape()->dim(0).dim_value(), 3);
+
+  const std::vector<int64_t> perm{0, 1};
+  transpose.AddAttribute("perm", perm);
+  b.ClearShape();
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_NE(b.Shape(), nullptr);
+  EXPECT_EQ(b.Shape()->dim(0).dim_value(), 2);
+
+  // an untracked change is not seen by the incremental inference, but by the verification and the full inference
+  const_cast<NodeArgInfo&>(b.ToProto()).mutable_type()->mutable_tensor_type()->clear_shape();
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  EXPECT_EQ(b.Shape(), nullptr);
+
+  Graph::ResolveOptions options;
+  options.full_type_inference = true;
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve(options));
+  ASSERT_NE(b.Shape(), nullptr);
+  EXPECT_EQ(b.Shape()->dim(0).dim_value(), 2);
+
+  const_cast<NodeArgInfo&>(b.ToProto()).mutable_type()->mutable_tensor_type()->clear_shape();
+  options = {};
+  options.verify_incremental_type_inference = true;
+  graph.SetGraphResolveNeeded();
+  auto status = graph.Resolve(options);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), testing::HasSubstr("changed output B of node (transpose)"));
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
@@ -2119,6 +2292,52 @@ TEST_F(GraphTest, ConstantsBecomeInitializersAndInputs) {
   ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
 }
 
+// the tensor of a Constant node is moved into the initializer, which is named after the output of the node
+TEST_F(GraphTest, ConstantNodeTensorMovesToInitializer) {
+  ModelProto m;
+  m.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  ImportOpset(m, "", 13);
+  GraphProto* g = m.mutable_graph();
+  g->set_name("test");
+
+  NodeProto* constant_node = g->add_node();
+  constant_node->set_op_type("Constant");
+  constant_node->set_name("constant");
+  constant_node->add_output("c");
+  AttributeProto* attr = constant_node->add_attribute();
+  attr->set_name("value");
+  attr->set_type(AttributeProto_AttributeType_TENSOR);
+  TensorProto* t = attr->mutable_t();
+  t->set_name("value_name");
+  t->set_data_type(TensorProto_DataType_FLOAT);
+  t->add_dims(3);
+  const std::vector<float> values{1.f, 2.f, 3.f};
+  t->set_raw_data(values.data(), values.size() * sizeof(float));
+
+  NodeProto* identity_node = g->add_node();
+  identity_node->set_op_type("Identity");
+  identity_node->set_name("identity");
+  identity_node->add_input("c");
+  identity_node->add_output("y");
+
+  ValueInfoProto* output = g->add_output();
+  output->set_name("y");
+  SetTypeAndShape(output->mutable_type()->mutable_tensor_type(), TensorProto_DataType_FLOAT, {3});
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(std::move(m), model, nullptr, *logger_));
+  const Graph& graph = model->MainGraph();
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+
+  const TensorProto* initializer = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("c", initializer));
+  EXPECT_EQ(initializer->name(), "c");
+  ASSERT_EQ(initializer->dims_size(), 1);
+  EXPECT_EQ(initializer->dims(0), 3);
+  EXPECT_EQ(initializer->raw_data(), std::string(reinterpret_cast<const char*>(values.data()),
+                                                 values.size() * sizeof(float)));
+}
+
 TEST_F(GraphTest, SubgraphOutputIsOuterScopeValue) {
   std::shared_ptr<Model> model;
   common::Status st = Model::Load(ORT_TSTR("./testdata/ort_github_issue_11536.onnx"), model, nullptr, *logger_);
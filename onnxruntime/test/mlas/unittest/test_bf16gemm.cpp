@@ -0,0 +1,207 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_bf16gemm.cpp
+
+Abstract:
+
+    Tests for MLAS bfloat16 GEMM.
+
+--*/
+
+#ifndef ORT_MINIMAL_BUILD
+
+#include "test_util.h"
+
+inline bool
+CloseEnough(float actual, float expected) {
+  if (std::isnan(actual)) {
+    return std::isnan(expected);
+  }
+  float diff = std::abs(actual - expected);
+  float top = std::max(std::abs(actual), std::abs(expected));
+  float ratio = 0;
+  if (top > 0.0001) {
+    ratio = diff / top;
+  }
+  return ratio < 0.005;
+}
+
+/**
+ * @brief Test class for bfloat16 GEMM
+ *        The test buffers hold small integers, which are exact in bfloat16,
+ *        so the results match a fp32 reference.
+ */
+template <bool Threaded>
+class MlasBf16GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceGemm(size_t M,
+                     size_t N,
+                     size_t K,
+                     const float* A,
+                     const float* B,
+                     size_t ldb,
+                     bool TransB,
+                     const float* Bias,
+                     float* C) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = Bias == nullptr ? 0.0f : Bias[n];
+        for (size_t k = 0; k < K; k++) {
+          sum += A[m * K + k] * (TransB ? B[n * ldb + k] : B[k * ldb + n]);
+        }
+        C[m * N + n] += sum;
+      }
+    }
+  }
+
+ public:
+  MlasBf16GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, bool TransB, bool withBias, bool ZeroMode) {
+    const float* A = BufferA.GetBuffer(K * M);
+    const float* B = BufferB.GetBuffer(N * K);
+    const size_t ldb = TransB ? K : N;
+
+    const float* Bias = nullptr;
+    if (withBias) {
+      Bias = BufferBias.GetBuffer(N);
+    }
+
+    const auto fill = [ZeroMode](float* start, size_t size) {
+      std::fill_n(start, size, ZeroMode ? -1.0f : 3.0f);
+    };
+    float* C = BufferC.GetFilledBuffer(N * M, fill);
+    float* CReference = BufferCReference.GetFilledBuffer(N * M, [](float* start, size_t size) {
+      std::fill_n(start, size, 3.0f);
+    });
+    if (ZeroMode) {
+      std::fill_n(CReference, N * M, 0.0f);
+    }
+
+    void* PackedB = BufferBPacked.GetBuffer(MlasBf16GemmPackBSize(N, K), true);
+    MlasBf16GemmConvertPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb, PackedB);
+
+    MLAS_BF16_GEMM_DATA_PARAMS params;
+    params.A = A;
+    params.lda = K;
+    params.B = PackedB;
+    params.Bias = Bias;
+    params.C = C;
+    params.ldc = N;
+    params.ZeroMode = ZeroMode;
+    MlasBf16GemmBatch(M, N, K, 1, &params, threadpool_);
+
+    ReferenceGemm(M, N, K, A, B, ldb, TransB, Bias, CReference);
+
+    size_t f = 0;
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++, f++) {
+        ASSERT_TRUE(CloseEnough(C[f], CReference[f]))
+            << "Expected: " << CReference[f] << " Actual: " << C[f] << "@[" << m << "x" << n << "], "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", TransB=" << TransB << ", ZeroMode=" << ZeroMode;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("Bf16Gemm") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+};
+
+//
+// Short Execute() test helper to register each test separately by all parameters.
+//
+template <bool Threaded>
+class Bf16GemmShortExecuteTest : public MlasTestFixture<MlasBf16GemmTest<Threaded>> {
+ public:
+  explicit Bf16GemmShortExecuteTest(size_t M, size_t N, size_t K, bool TransB, bool hasBias, bool ZeroMode)
+      : M_(M), N_(N), K_(K), TransB_(TransB), hasBias_(hasBias), ZeroMode_(ZeroMode) {}
+
+  void TestBody() override {
+    MlasTestFixture<MlasBf16GemmTest<Threaded>>::mlas_tester->Test(M_, N_, K_, TransB_, hasBias_, ZeroMode_);
+  }
+
+  static size_t RegisterSingleTest(size_t M, size_t N, size_t K, bool TransB, bool hasBias, bool ZeroMode) {
+    std::stringstream ss;
+    ss << "/M" << M << "xN" << N << "xK" << K << "/"
+       << "TransB" << TransB << "/"
+       << "hasBias" << hasBias << "/"
+       << "ZeroMode" << ZeroMode;
+    auto test_name = ss.str();
+
+    testing::RegisterTest(
+        MlasBf16GemmTest<Threaded>::GetTestSuiteName(),
+        test_name.c_str(),
+        nullptr,
+        test_name.c_str(),
+        __FILE__,
+        __LINE__,
+        // Important to use the fixture type as the return type here.
+        [=]() -> MlasTestFixture<MlasBf16GemmTest<Threaded>>* {
+          return new Bf16GemmShortExecuteTest<Threaded>(M, N, K, TransB, hasBias, ZeroMode);
+        });
+
+    return 1;
+  }
+
+  static size_t RegisterShortExecuteTests() {
+    size_t test_registered = 0;
+
+    for (size_t b = 1; b < 16; b++) {
+      test_registered += RegisterSingleTest(b, b, b, false, false, true);
+      test_registered += RegisterSingleTest(b, b, b, true, true, false);
+    }
+    for (size_t b = 16; b <= 256; b <<= 1) {
+      test_registered += RegisterSingleTest(b, b, b, false, true, true);
+      test_registered += RegisterSingleTest(b, b, b, true, false, false);
+    }
+    for (size_t b = 1; b < 96; b += 5) {
+      test_registered += RegisterSingleTest(1, b, 32, false, true, true);
+      test_registered += RegisterSingleTest(17, 32, b, true, false, true);
+      test_registered += RegisterSingleTest(3, b, b, false, false, false);
+    }
+    test_registered += RegisterSingleTest(43, 500, 401, false, true, true);
+    test_registered += RegisterSingleTest(160, 130, 67, true, true, false);
+
+    return test_registered;
+  }
+
+ private:
+  size_t M_, N_, K_;
+  bool TransB_, hasBias_, ZeroMode_;
+};
+
+template <>
+MlasBf16GemmTest<false>* MlasTestFixture<MlasBf16GemmTest<false>>::mlas_tester(nullptr);
+template <>
+MlasBf16GemmTest<true>* MlasTestFixture<MlasBf16GemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  if (!MlasBf16GemmSupported()) {
+    return false;
+  }
+  if (is_short_execute) {
+    return Bf16GemmShortExecuteTest<false>::RegisterShortExecuteTests() +
+               Bf16GemmShortExecuteTest<true>::RegisterShortExecuteTests() >
+           0;
+  }
+  return false;
+});
+
+#endif  // ORT_MINIMAL_BUILD
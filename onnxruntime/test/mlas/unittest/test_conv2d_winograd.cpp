@@ -0,0 +1,142 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_conv2d_winograd.cpp
+
+Abstract:
+
+    Tests for the MLAS Winograd F(4x4, 3x3) convolution.
+
+--*/
+
+#include "test_util.h"
+
+class MlasConv2DWinogradTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferWorking;
+  std::vector<uint8_t> PackedFilter;
+
+  static void Fill(float* start, size_t size, float scale) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 13) % 17) - 8) * scale;
+    }
+  }
+
+ public:
+  void Test(size_t BatchCount,
+            size_t GroupCount,
+            size_t InputChannels,
+            size_t InputHeight,
+            size_t InputWidth,
+            size_t FilterCount,
+            size_t Padding,
+            float Beta) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+    const size_t InputSize = InputHeight * InputWidth;
+    const size_t OutputSize = OutputHeight * OutputWidth;
+
+    const size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputSize;
+
+    float* Input = BufferInput.GetBuffer(BatchCount * GroupCount * InputChannels * InputSize);
+    Fill(Input, BatchCount * GroupCount * InputChannels * InputSize, 0.125f);
+    float* Filter = BufferFilter.GetBuffer(GroupCount * FilterCount * InputChannels * 9);
+    Fill(Filter, GroupCount * FilterCount * InputChannels * 9, 0.0625f);
+    float* Bias = BufferBias.GetBuffer(GroupCount * FilterCount);
+    Fill(Bias, GroupCount * FilterCount, 0.5f);
+    float* Output = BufferOutput.GetBuffer(OutputElements);
+    Fill(Output, OutputElements, 1.0f);
+    std::vector<float> Addend(Output, Output + OutputElements);
+
+    PackedFilter.resize(MlasConvWinogradPackWSize(GroupCount, FilterCount, InputChannels));
+    MlasConvWinogradPackW(GroupCount, FilterCount, InputChannels, Filter, PackedFilter.data());
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t PaddingShape[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape, DilationShape,
+                    PaddingShape, StrideShape, OutputShape, FilterCount, &Activation, &WorkingBufferSize, Beta,
+                    GetMlasThreadPool(), PackedFilter.data());
+
+    ASSERT_EQ(Parameters.Algorithm, MlasConvAlgorithmWinograd);
+
+    MlasConv(&Parameters, Input, Filter, Bias, BufferWorking.GetBuffer(WorkingBufferSize), Output,
+             GetMlasThreadPool());
+
+    for (size_t n = 0; n < BatchCount; n++) {
+      for (size_t g = 0; g < GroupCount; g++) {
+        const float* input = Input + (n * GroupCount + g) * InputChannels * InputSize;
+        for (size_t f = 0; f < FilterCount; f++) {
+          const float* filter = Filter + (g * FilterCount + f) * InputChannels * 9;
+          const size_t output_offset = ((n * GroupCount + g) * FilterCount + f) * OutputSize;
+          for (size_t oh = 0; oh < OutputHeight; oh++) {
+            for (size_t ow = 0; ow < OutputWidth; ow++) {
+              double expected = Bias[g * FilterCount + f] + Beta * Addend[output_offset + oh * OutputWidth + ow];
+              double magnitude = 0.0;
+              for (size_t c = 0; c < InputChannels; c++) {
+                for (size_t kh = 0; kh < 3; kh++) {
+                  for (size_t kw = 0; kw < 3; kw++) {
+                    const size_t ih = oh + kh - Padding;
+                    const size_t iw = ow + kw - Padding;
+                    if (ih < InputHeight && iw < InputWidth) {
+                      const double product = double(input[c * InputSize + ih * InputWidth + iw]) *
+                                             double(filter[(c * 3 + kh) * 3 + kw]);
+                      expected += product;
+                      magnitude += std::abs(product);
+                    }
+                  }
+                }
+              }
+              // The transforms scale the rounding errors of the products by up to about 100
+              ASSERT_NEAR(Output[output_offset + oh * OutputWidth + ow], expected, 1e-5 * (1.0 + magnitude))
+                  << "B" << BatchCount << "/G" << GroupCount << "/Cpg" << InputChannels << "/Fpg" << FilterCount
+                  << "/H" << InputHeight << "/W" << InputWidth << "/Pad" << Padding << " @[" << f << ","
+                  << oh << "," << ow << "]";
+            }
+          }
+        }
+      }
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Conv2dWinograd");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    Test(1, 1, 16, 8, 8, 16, 1, 0.0f);
+    Test(1, 1, 17, 13, 9, 20, 1, 0.0f);
+    Test(2, 1, 16, 6, 6, 32, 0, 1.0f);
+    Test(1, 2, 24, 11, 14, 16, 1, 0.0f);
+    Test(1, 1, 64, 56, 56, 64, 1, 0.0f);
+    Test(1, 1, 128, 7, 7, 256, 1, 0.0f);
+  }
+};
+
+template <>
+MlasConv2DWinogradTest* MlasTestFixture<MlasConv2DWinogradTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasConv2DWinogradTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,111 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_dispatch.cpp
+
+Abstract:
+
+    Tests for the MLAS kernel dispatch introspection and override.
+
+--*/
+
+#include "test_util.h"
+
+#include <cstring>
+
+class MlasDispatchTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+  static constexpr const char* BaselineIsa = "sse2";
+#elif defined(MLAS_TARGET_ARM64)
+  static constexpr const char* BaselineIsa = "neon";
+#else
+  static constexpr const char* BaselineIsa = "baseline";
+#endif
+
+  static std::vector<std::string> GetFamilyIsas() {
+    std::vector<std::string> isas;
+    for (size_t f = 0; f < MlasKernelFamilyCount; f++) {
+      isas.push_back(MlasGetKernelFamilyIsa(MLAS_KERNEL_FAMILY(f)));
+    }
+    return isas;
+  }
+
+  void Sgemm(size_t M, size_t N, size_t K, float* C) {
+    const float* A = BufferA.GetBuffer(M * K);
+    const float* B = BufferB.GetBuffer(K * N);
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K, B, N, 0.0f, C, N, GetMlasThreadPool());
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Dispatch");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    const std::vector<std::string> default_isas = GetFamilyIsas();
+
+    for (size_t f = 0; f < MlasKernelFamilyCount; f++) {
+      ASSERT_STRNE(MlasGetKernelFamilyName(MLAS_KERNEL_FAMILY(f)), "unknown");
+    }
+
+    ASSERT_FALSE(MlasSetKernelDispatchOverride("sgemm"));
+    ASSERT_FALSE(MlasSetKernelDispatchOverride("sgemm=unknown"));
+    ASSERT_FALSE(MlasSetKernelDispatchOverride(("unknown=" + std::string(BaselineIsa)).c_str()));
+    ASSERT_EQ(GetFamilyIsas(), default_isas);
+
+    constexpr size_t M = 5, N = 37, K = 29;
+    float* CReference = BufferCReference.GetBuffer(M * N);
+    float* C = BufferC.GetBuffer(M * N);
+    Sgemm(M, N, K, CReference);
+
+    ASSERT_TRUE(MlasSetKernelDispatchOverride(("*=" + std::string(BaselineIsa)).c_str()));
+
+    for (size_t f = 0; f < MlasKernelFamilyCount; f++) {
+      const char* isa = MlasGetKernelFamilyIsa(MLAS_KERNEL_FAMILY(f));
+      ASSERT_TRUE(std::strcmp(isa, BaselineIsa) == 0 || std::strcmp(isa, "none") == 0)
+          << MlasGetKernelFamilyName(MLAS_KERNEL_FAMILY(f)) << " selected " << isa;
+    }
+
+    Sgemm(M, N, K, C);
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_NEAR(C[i], CReference[i], 1e-3f * std::max(1.0f, std::abs(CReference[i]))) << " @" << i;
+    }
+
+    //
+    // A limit of one family leaves the selection of the other families.
+    //
+
+    ASSERT_TRUE(MlasSetKernelDispatchOverride(("sgemm=" + std::string(BaselineIsa)).c_str()));
+
+    std::vector<std::string> isas = GetFamilyIsas();
+    ASSERT_EQ(isas[MlasKernelFamilySgemm], BaselineIsa);
+    isas[MlasKernelFamilySgemm] = default_isas[MlasKernelFamilySgemm];
+    ASSERT_EQ(isas, default_isas);
+
+    ASSERT_TRUE(MlasSetKernelDispatchOverride(nullptr));
+    ASSERT_EQ(GetFamilyIsas(), default_isas);
+  }
+};
+
+template <>
+MlasDispatchTest* MlasTestFixture<MlasDispatchTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasDispatchTest>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -70,6 +70,9 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 3072, 768, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
+    // many small products, as the per head products of attention
+    test_registered += RegisterTestTransposeABProduct(64, 64, 128, 24, 1.0f, 0.0f);
+    test_registered += RegisterTestTransposeABProduct(7, 33, 16, 40, 1.0f, 0.0f);
     return test_registered;
   }
 
@@ -0,0 +1,130 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_layernorm.cpp
+
+Abstract:
+
+    Tests for the MLAS layer normalization.
+
+--*/
+
+#include "test_util.h"
+
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferGamma;
+  MatrixGuardBuffer<float> BufferBeta;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferSkipOutput;
+  MatrixGuardBuffer<float> BufferMean;
+  MatrixGuardBuffer<float> BufferInvStdDev;
+
+  static void Fill(float* start, size_t size, float offset) {
+    for (size_t i = 0; i < size; i++) {
+      start[i] = float(int((i * 13) % 17) - 8) * 0.25f + offset;
+    }
+  }
+
+ public:
+  void Test(size_t Rows, size_t Columns, size_t SkipRowCount, bool withBias, bool withBeta, bool Simplified) {
+    float* Input = BufferInput.GetBuffer(Rows * Columns);
+    Fill(Input, Rows * Columns, 3.0f);
+    const float* Skip = nullptr;
+    if (SkipRowCount != 0) {
+      float* skip = BufferSkip.GetBuffer(SkipRowCount * Columns);
+      Fill(skip, SkipRowCount * Columns, -1.0f);
+      Skip = skip;
+    }
+    float* Bias = withBias ? BufferBias.GetBuffer(Columns) : nullptr;
+    float* Gamma = BufferGamma.GetBuffer(Columns);
+    float* Beta = withBeta ? BufferBeta.GetBuffer(Columns) : nullptr;
+    float* Output = BufferOutput.GetBuffer(Rows * Columns);
+    float* SkipOutput = BufferSkipOutput.GetBuffer(Rows * Columns);
+    float* Mean = BufferMean.GetBuffer(Rows);
+    float* InvStdDev = BufferInvStdDev.GetBuffer(Rows);
+
+    MLAS_LAYER_NORM_PARAMS Params;
+    Params.Input = Input;
+    Params.Skip = Skip;
+    Params.SkipRowCount = SkipRowCount;
+    Params.Bias = Bias;
+    Params.Gamma = Gamma;
+    Params.Beta = Beta;
+    Params.Output = Output;
+    Params.SkipOutput = SkipOutput;
+    Params.Mean = Mean;
+    Params.InvStdDev = InvStdDev;
+    Params.Epsilon = 1e-5f;
+    Params.Simplified = Simplified;
+
+    MlasLayerNormalization(&Params, Rows, Columns, GetMlasThreadPool());
+
+    std::vector<double> x(Columns);
+
+    for (size_t r = 0; r < Rows; r++) {
+      double sum = 0.0;
+      for (size_t c = 0; c < Columns; c++) {
+        x[c] = Input[r * Columns + c];
+        if (Skip != nullptr) {
+          x[c] += Skip[(r % SkipRowCount) * Columns + c];
+        }
+        if (Bias != nullptr) {
+          x[c] += Bias[c];
+        }
+        sum += x[c];
+        ASSERT_EQ(SkipOutput[r * Columns + c], float(x[c])) << "@[" << r << "x" << c << "]";
+      }
+
+      const double mean = Simplified ? 0.0 : sum / Columns;
+      double variance = 0.0;
+      for (size_t c = 0; c < Columns; c++) {
+        variance += (x[c] - mean) * (x[c] - mean);
+      }
+      const double inv_std_dev = 1.0 / std::sqrt(variance / Columns + 1e-5);
+
+      ASSERT_NEAR(Mean[r], mean, 1e-4) << "@" << r;
+      ASSERT_NEAR(InvStdDev[r], inv_std_dev, 1e-4 * inv_std_dev) << "@" << r;
+
+      for (size_t c = 0; c < Columns; c++) {
+        double expected = (x[c] - mean) * inv_std_dev * Gamma[c];
+        if (Beta != nullptr && !Simplified) {
+          expected += Beta[c];
+        }
+        ASSERT_NEAR(Output[r * Columns + c], expected, 1e-4 * (1.0 + std::abs(expected)))
+            << "@[" << r << "x" << c << "], Rows=" << Rows << ", Columns=" << Columns;
+      }
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("LayerNorm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Columns = 1; Columns < 200; Columns += 7) {
+      Test(3, Columns, 0, false, true, false);
+      Test(4, Columns, 2, true, true, false);
+      Test(5, Columns, 5, true, false, true);
+    }
+    Test(128, 768, 128, true, true, false);
+    Test(64, 1024, 1, false, true, true);
+  }
+};
+
+template <>
+MlasLayerNormTest* MlasTestFixture<MlasLayerNormTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasLayerNormTest>::RegisterShortExecute() : 0;
+});
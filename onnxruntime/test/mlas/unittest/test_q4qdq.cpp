@@ -57,6 +57,9 @@ class MlasQ4dqTest : public MlasTestBase {
   MatrixGuardBuffer<float> FpOutBuf;
   MatrixGuardBuffer<float> SgemmPackBuf;
   MatrixGuardBuffer<float> SgemmPackRefBuf;
+  MatrixGuardBuffer<uint8_t> QuantDataBuf;
+  MatrixGuardBuffer<float> ScalesBuf;
+  MatrixGuardBuffer<uint8_t> ZeroPointsBuf;
 
   void Test(size_t N, size_t K, MLAS_BLK_QUANT_TYPE qtype) {
     float* Input = FpInputBuf.GetBuffer(N * K, true);
@@ -111,6 +114,48 @@ class MlasQ4dqTest : public MlasTestBase {
 #endif  // x64
   }
 
+  /* Test MlasQ4GemmPackBQuantized, packing B quantized with another block size without quantizing it again */
+  void TestPackQuantized(size_t N, size_t K, size_t BlockSize, bool HasZeroPoints, MLAS_BLK_QUANT_TYPE qtype) {
+    const size_t BlockCountK = (K + BlockSize - 1) / BlockSize;
+    uint8_t* QuantData = QuantDataBuf.GetBuffer(N * BlockCountK * BlockSize / 2, true);
+    float* Scales = ScalesBuf.GetBuffer(N * BlockCountK, true);
+    uint8_t* ZeroPoints = HasZeroPoints ? ZeroPointsBuf.GetBuffer((N * BlockCountK + 1) / 2, true) : nullptr;
+
+    for (size_t i = 0; i < N * BlockCountK * BlockSize / 2; i++) {
+      QuantData[i] = static_cast<uint8_t>((i * 37 + 11) & 0xFF);
+    }
+    for (size_t i = 0; i < N * BlockCountK; i++) {
+      Scales[i] = 0.125f * static_cast<float>(i % 7 + 1);
+    }
+    if (HasZeroPoints) {
+      for (size_t i = 0; i < (N * BlockCountK + 1) / 2; i++) {
+        ZeroPoints[i] = static_cast<uint8_t>((i * 13 + 5) & 0xFF);
+      }
+    }
+
+    size_t qsize = MlasQ4GemmPackBSize(qtype, N, K);
+    uint8_t* Packed = PackedBuf.GetBuffer(qsize, true);
+    float* Output = FpOutBuf.GetBuffer(N * K, true);
+
+    MlasQ4GemmPackBQuantized(qtype, Packed, QuantData, Scales, ZeroPoints, N, K, BlockSize);
+    MlasQ4GemmUnPackB(qtype, Output, Packed, N, K, N);
+
+    for (size_t n = 0; n < N; n++) {
+      for (size_t k = 0; k < K; k++) {
+        const size_t block = n * BlockCountK + k / BlockSize;
+        const size_t index = n * BlockCountK * BlockSize + k;
+        const int q = (QuantData[index / 2] >> ((index & 1) * 4)) & 0x0F;
+        int zp = 8;
+        if (HasZeroPoints) {
+          zp = (ZeroPoints[block / 2] >> ((block & 1) * 4)) & 0x0F;
+        }
+        const float expected = (q - zp) * Scales[block];
+        ASSERT_EQ(Output[k * N + n], expected) << ", n=" << n << ", k=" << k << ", [" << N << "x" << K
+                                               << "] BlockSize: " << BlockSize << " QType: " << qtype;
+      }
+    }
+  }
+
  public:
   static const char* GetTestSuiteName() {
     static const std::string suite_name("Q4DQ");
@@ -136,6 +181,14 @@ class MlasQ4dqTest : public MlasTestBase {
     Test(static_cast<size_t>(4 * 20) + 3, static_cast<size_t>(32 * 15) + 17, BlkQ4Sym);
     Test(static_cast<size_t>(4 * 20) + 3, static_cast<size_t>(32 * 15) + 17, BlkQ4Sym64);
     Test(static_cast<size_t>(4 * 20) + 3, static_cast<size_t>(32 * 15) + 17, BlkQ4Sym128);
+
+    TestPackQuantized(3, 52, 32, false, BlkQ4Sym);
+    TestPackQuantized(3, 52, 32, true, BlkQ4Zp8);
+    TestPackQuantized(5, 93, 64, false, BlkQ4Sym64);
+    TestPackQuantized(5, 93, 64, true, BlkQ4Zp8);
+    TestPackQuantized(7, 300, 128, false, BlkQ4Sym128);
+    TestPackQuantized(7, 300, 128, true, BlkQ4Zp8);
+    TestPackQuantized(7, 300, 256, false, BlkQ4Zp8);
   }
 
   MlasQ4dqTest() = default;
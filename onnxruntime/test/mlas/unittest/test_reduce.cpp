@@ -0,0 +1,115 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_reduce.cpp
+
+Abstract:
+
+    Tests for the MLAS row and column reductions.
+
+--*/
+
+#include "test_util.h"
+
+/**
+ * @brief Test class for the row and column reductions
+ *        The buffers hold small integers, so the sums are exact and are
+ *        compared to a scalar reference.
+ */
+template <MLAS_REDUCE_KIND Kind>
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  static float Identity() {
+    return Kind == MlasReduceMaximum ? -std::numeric_limits<float>::infinity() : 0.0f;
+  }
+
+  static float Update(float Accumulator, float Value) {
+    switch (Kind) {
+      case MlasReduceSum:
+        return Accumulator + Value;
+      case MlasReduceSumSquare:
+        return Accumulator + Value * Value;
+      default:
+        return std::max(Accumulator, Value);
+    }
+  }
+
+ public:
+  void Test(size_t Rows, size_t Columns, size_t ld, bool ReduceColumns) {
+    const float* Input = BufferInput.GetFilledBuffer(Rows * ld, [](float* start, size_t size) {
+      for (size_t i = 0; i < size; i++) {
+        start[i] = float(int((i * 7) % 23) - 11);
+      }
+    });
+    const size_t OutputCount = ReduceColumns ? Columns : Rows;
+    float* Output = BufferOutput.GetBuffer(OutputCount);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputCount);
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      OutputReference[o] = Identity();
+    }
+    for (size_t r = 0; r < Rows; r++) {
+      for (size_t c = 0; c < Columns; c++) {
+        float& Accumulator = OutputReference[ReduceColumns ? c : r];
+        Accumulator = Update(Accumulator, Input[r * ld + c]);
+      }
+    }
+
+    if (ReduceColumns) {
+      MlasReduceColumns(Kind, Input, ld, Output, Rows, Columns);
+    } else {
+      MlasReduceRows(Kind, Input, ld, Output, Rows, Columns);
+    }
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      ASSERT_EQ(Output[o], OutputReference[o])
+          << "@" << o << ", Rows=" << Rows << ", Columns=" << Columns << ", ld=" << ld
+          << ", ReduceColumns=" << ReduceColumns;
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("Reduce") +
+                                          (Kind == MlasReduceSum ? "_Sum" : Kind == MlasReduceSumSquare ? "_SumSquare"
+                                                                                                         : "_Maximum");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Columns = 1; Columns < 160; Columns += 3) {
+      Test(5, Columns, Columns, false);
+      Test(5, Columns, Columns + 7, false);
+      Test(5, Columns, Columns, true);
+      Test(9, Columns, Columns + 7, true);
+    }
+    Test(1, 4096, 4096, false);
+    Test(300, 1, 1, true);
+    Test(64, 3001, 3001, true);
+  }
+};
+
+template <>
+MlasReduceTest<MlasReduceSum>* MlasTestFixture<MlasReduceTest<MlasReduceSum>>::mlas_tester(nullptr);
+template <>
+MlasReduceTest<MlasReduceSumSquare>* MlasTestFixture<MlasReduceTest<MlasReduceSumSquare>>::mlas_tester(nullptr);
+template <>
+MlasReduceTest<MlasReduceMaximum>* MlasTestFixture<MlasReduceTest<MlasReduceMaximum>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasReduceTest<MlasReduceSum>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasReduceTest<MlasReduceSumSquare>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasReduceTest<MlasReduceMaximum>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,237 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sgemm_epilogue.cpp
+
+Abstract:
+
+    Tests for the bias, activation and addend epilogue of MLAS SGEMM.
+
+--*/
+
+#include "test_util.h"
+
+/**
+ * @brief Test class for the SGEMM epilogue
+ *        The result is compared to a reference GEMM followed by the bias,
+ *        the activation and the addend.
+ */
+template <bool Packed, bool Threaded>
+class MlasSgemmEpilogueTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferAddend;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceGemm(size_t M,
+                     size_t N,
+                     size_t K,
+                     bool TransA,
+                     bool TransB,
+                     const float* A,
+                     const float* B,
+                     float beta,
+                     const MLAS_SGEMM_EPILOGUE& Epilogue,
+                     float* C) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = beta == 0.0f ? 0.0f : beta * C[m * N + n];
+        for (size_t k = 0; k < K; k++) {
+          sum += (TransA ? A[k * M + m] : A[m * K + k]) * (TransB ? B[n * K + k] : B[k * N + n]);
+        }
+        if (Epilogue.Bias != nullptr) {
+          sum += Epilogue.Bias[n];
+        }
+        C[m * N + n] = sum;
+      }
+    }
+
+    if (Epilogue.Activation != nullptr) {
+      MlasActivation(Epilogue.Activation, C, nullptr, M, N, N);
+    }
+
+    if (Epilogue.Addend != nullptr) {
+      for (size_t f = 0; f < M * N; f++) {
+        C[f] += Epilogue.Addend[f];
+      }
+    }
+  }
+
+ public:
+  MlasSgemmEpilogueTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, bool TransA, bool TransB, float beta,
+            bool withBias, MLAS_ACTIVATION_KIND ActivationKind, bool withAddend) {
+    // Center the values around zero so that the activations clip. The
+    // results are small integers, which are exact.
+    const auto fill = [](float* start, size_t size) {
+      for (size_t i = 0; i < size; i++) {
+        start[i] = float(int(i % 31) - 15);
+      }
+    };
+    const float* A = BufferA.GetFilledBuffer(K * M, fill);
+    const float* B = BufferB.GetFilledBuffer(N * K, [](float* start, size_t size) {
+      for (size_t i = 0; i < size; i++) {
+        start[i] = float(int(i % 7) - 3);
+      }
+    });
+    float* C = BufferC.GetFilledBuffer(N * M, fill);
+    float* CReference = BufferCReference.GetFilledBuffer(N * M, fill);
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.LeakyRelu.alpha = 0.25f;
+
+    MLAS_SGEMM_EPILOGUE Epilogue;
+    Epilogue.Bias = withBias ? BufferBias.GetFilledBuffer(N, fill) : nullptr;
+    Epilogue.Activation = ActivationKind == MlasIdentityActivation ? nullptr : &Activation;
+    Epilogue.Addend = withAddend ? BufferAddend.GetFilledBuffer(N * M, fill) : nullptr;
+    Epilogue.ldaddend = N;
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = TransA ? M : K;
+    Data.C = C;
+    Data.ldc = N;
+    Data.beta = beta;
+    Data.Epilogue = &Epilogue;
+
+    if (Packed) {
+      void* PackedB = BufferBPacked.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B, TransB ? K : N, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.BIsPacked = true;
+    } else {
+      Data.B = B;
+      Data.ldb = TransB ? K : N;
+    }
+
+    MlasGemmBatch(TransA ? CblasTrans : CblasNoTrans, TransB ? CblasTrans : CblasNoTrans, M, N, K, &Data, 1, threadpool_);
+
+    ReferenceGemm(M, N, K, TransA, TransB, A, B, beta, Epilogue, CReference);
+
+    size_t f = 0;
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++, f++) {
+        ASSERT_EQ(C[f], CReference[f])
+            << "Expected: " << CReference[f] << " Actual: " << C[f] << "@[" << m << "x" << n << "], "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", TransA=" << TransA << ", TransB=" << TransB
+            << ", Activation=" << ActivationKind;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("SgemmEpilogue") +
+                                    (Packed ? "_Packed" : "_NoPack") +
+                                    (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+};
+
+//
+// Short Execute() test helper to register each test separately by all parameters.
+//
+template <bool Packed, bool Threaded>
+class SgemmEpilogueShortExecuteTest : public MlasTestFixture<MlasSgemmEpilogueTest<Packed, Threaded>> {
+ public:
+  explicit SgemmEpilogueShortExecuteTest(size_t M, size_t N, size_t K, bool TransA, bool TransB, float beta,
+                                         bool hasBias, MLAS_ACTIVATION_KIND ActivationKind, bool hasAddend)
+      : M_(M), N_(N), K_(K), TransA_(TransA), TransB_(TransB), beta_(beta), hasBias_(hasBias), ActivationKind_(ActivationKind), hasAddend_(hasAddend) {}
+
+  void TestBody() override {
+    MlasTestFixture<MlasSgemmEpilogueTest<Packed, Threaded>>::mlas_tester->Test(
+        M_, N_, K_, TransA_, TransB_, beta_, hasBias_, ActivationKind_, hasAddend_);
+  }
+
+  static size_t RegisterSingleTest(size_t M, size_t N, size_t K, bool TransA, bool TransB, float beta,
+                                   bool hasBias, MLAS_ACTIVATION_KIND ActivationKind, bool hasAddend) {
+    std::stringstream ss;
+    ss << "/M" << M << "xN" << N << "xK" << K << "/"
+       << "TransA" << TransA << "/"
+       << "TransB" << TransB << "/"
+       << "beta" << beta << "/"
+       << "hasBias" << hasBias << "/"
+       << "Activation" << ActivationKind << "/"
+       << "hasAddend" << hasAddend;
+    auto test_name = ss.str();
+
+    testing::RegisterTest(
+        MlasSgemmEpilogueTest<Packed, Threaded>::GetTestSuiteName(),
+        test_name.c_str(),
+        nullptr,
+        test_name.c_str(),
+        __FILE__,
+        __LINE__,
+        // Important to use the fixture type as the return type here.
+        [=]() -> MlasTestFixture<MlasSgemmEpilogueTest<Packed, Threaded>>* {
+          return new SgemmEpilogueShortExecuteTest<Packed, Threaded>(
+              M, N, K, TransA, TransB, beta, hasBias, ActivationKind, hasAddend);
+        });
+
+    return 1;
+  }
+
+  static size_t RegisterShortExecuteTests() {
+    size_t test_registered = 0;
+
+    for (size_t b = 1; b < 16; b++) {
+      test_registered += RegisterSingleTest(b, b, b, false, false, 0.0f, true, MlasIdentityActivation, false);
+      test_registered += RegisterSingleTest(b, b, b, false, true, 1.0f, false, MlasReluActivation, true);
+      test_registered += RegisterSingleTest(b, b, b, true, false, 0.5f, true, MlasLeakyReluActivation, true);
+    }
+    for (size_t b = 16; b <= 256; b <<= 1) {
+      test_registered += RegisterSingleTest(b, b, b, false, false, 0.0f, true, MlasReluActivation, false);
+      test_registered += RegisterSingleTest(b, b, b, true, true, 1.0f, true, MlasIdentityActivation, true);
+    }
+    for (size_t b = 1; b < 96; b += 5) {
+      test_registered += RegisterSingleTest(1, b, 32, false, false, 0.0f, true, MlasLeakyReluActivation, true);
+      test_registered += RegisterSingleTest(b, 1, 32, false, true, 0.0f, true, MlasReluActivation, false);
+      test_registered += RegisterSingleTest(17, 32, b, false, false, 1.0f, false, MlasIdentityActivation, true);
+    }
+    test_registered += RegisterSingleTest(43, 500, 401, false, false, 0.0f, true, MlasReluActivation, true);
+    test_registered += RegisterSingleTest(160, 130, 0, false, true, 0.5f, true, MlasLeakyReluActivation, true);
+    test_registered += RegisterSingleTest(160, 130, 600, true, false, 0.0f, true, MlasReluActivation, true);
+
+    return test_registered;
+  }
+
+ private:
+  size_t M_, N_, K_;
+  bool TransA_, TransB_;
+  float beta_;
+  bool hasBias_;
+  MLAS_ACTIVATION_KIND ActivationKind_;
+  bool hasAddend_;
+};
+
+template <>
+MlasSgemmEpilogueTest<false, false>* MlasTestFixture<MlasSgemmEpilogueTest<false, false>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<false, true>* MlasTestFixture<MlasSgemmEpilogueTest<false, true>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<true, false>* MlasTestFixture<MlasSgemmEpilogueTest<true, false>>::mlas_tester(nullptr);
+template <>
+MlasSgemmEpilogueTest<true, true>* MlasTestFixture<MlasSgemmEpilogueTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  if (is_short_execute) {
+    return SgemmEpilogueShortExecuteTest<false, false>::RegisterShortExecuteTests() +
+               SgemmEpilogueShortExecuteTest<false, true>::RegisterShortExecuteTests() +
+               SgemmEpilogueShortExecuteTest<true, false>::RegisterShortExecuteTests() +
+               SgemmEpilogueShortExecuteTest<true, true>::RegisterShortExecuteTests() >
+           0;
+  }
+  return false;
+});
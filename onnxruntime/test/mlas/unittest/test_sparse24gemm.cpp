@@ -0,0 +1,245 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_sparse24gemm.cpp
+
+Abstract:
+
+    Tests for MLAS 2:4 structured sparse GEMM.
+
+--*/
+
+#ifndef ORT_MINIMAL_BUILD
+
+#include "test_util.h"
+
+inline bool
+CloseEnough(float actual, float expected) {
+  if (std::isnan(actual)) {
+    return std::isnan(expected);
+  }
+  float diff = std::abs(actual - expected);
+  float top = std::max(std::abs(actual), std::abs(expected));
+  float ratio = 0;
+  if (top > 0.0001) {
+    ratio = diff / top;
+  }
+  return ratio < 0.0001;
+}
+
+/**
+ * @brief Test class for 2:4 structured sparse GEMM
+ *        B keeps at most two values of each column in every group of 4
+ *        rows, varying which ones, and the results match a dense reference.
+ */
+template <bool Threaded>
+class MlasSparse24GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MLAS_THREADPOOL* threadpool_;
+
+  void ReferenceGemm(size_t M,
+                     size_t N,
+                     size_t K,
+                     const float* A,
+                     const float* B,
+                     size_t ldb,
+                     bool TransB,
+                     const float* Bias,
+                     float* C) {
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float sum = Bias == nullptr ? 0.0f : Bias[n];
+        for (size_t k = 0; k < K; k++) {
+          sum += A[m * K + k] * (TransB ? B[n * ldb + k] : B[k * ldb + n]);
+        }
+        C[m * N + n] += sum;
+      }
+    }
+  }
+
+ public:
+  MlasSparse24GemmTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void Test(size_t M, size_t N, size_t K, bool TransB, bool withBias, bool ZeroMode) {
+    const float* A = BufferA.GetBuffer(K * M);
+    float* B = BufferB.GetBuffer(N * K);
+    const size_t ldb = TransB ? K : N;
+
+    // prune B to 2:4, the last group of rows may keep fewer values
+    for (size_t k = 0; k < K; k++) {
+      for (size_t n = 0; n < N; n++) {
+        if ((k + n) % 4 == n % 3 || (k + 2 * n) % 4 == 1) {
+          (TransB ? B[n * ldb + k] : B[k * ldb + n]) = 0.0f;
+        }
+      }
+    }
+    for (size_t k0 = 0; k0 < K; k0 += 4) {
+      for (size_t n = 0; n < N; n++) {
+        size_t NonZeros = 0;
+        for (size_t k = k0; k < std::min(K, k0 + 4); k++) {
+          float& b = TransB ? B[n * ldb + k] : B[k * ldb + n];
+          if (b != 0.0f && ++NonZeros > 2) {
+            b = 0.0f;
+          }
+        }
+      }
+    }
+    ASSERT_TRUE(MlasSparse24GemmIsSparse(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb));
+
+    const float* Bias = nullptr;
+    if (withBias) {
+      Bias = BufferBias.GetBuffer(N);
+    }
+
+    const auto fill = [ZeroMode](float* start, size_t size) {
+      std::fill_n(start, size, ZeroMode ? -1.0f : 3.0f);
+    };
+    float* C = BufferC.GetFilledBuffer(N * M, fill);
+    float* CReference = BufferCReference.GetFilledBuffer(N * M, [](float* start, size_t size) {
+      std::fill_n(start, size, 3.0f);
+    });
+    if (ZeroMode) {
+      std::fill_n(CReference, N * M, 0.0f);
+    }
+
+    void* PackedB = BufferBPacked.GetBuffer(MlasSparse24GemmPackBSize(N, K), true);
+    MlasSparse24GemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B, ldb, PackedB);
+
+    MLAS_SPARSE24_GEMM_DATA_PARAMS params;
+    params.A = A;
+    params.lda = K;
+    params.B = PackedB;
+    params.Bias = Bias;
+    params.C = C;
+    params.ldc = N;
+    params.ZeroMode = ZeroMode;
+    MlasSparse24GemmBatch(M, N, K, 1, &params, threadpool_);
+
+    ReferenceGemm(M, N, K, A, B, ldb, TransB, Bias, CReference);
+
+    size_t f = 0;
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++, f++) {
+        ASSERT_TRUE(CloseEnough(C[f], CReference[f]))
+            << "Expected: " << CReference[f] << " Actual: " << C[f] << "@[" << m << "x" << n << "], "
+            << "M=" << M << ", N=" << N << ", K=" << K << ", TransB=" << TransB << ", ZeroMode=" << ZeroMode;
+      }
+    }
+  }
+
+  void TestIsSparse() {
+    std::vector<float> B(4 * 3, 0.0f);
+    B[0 * 3 + 1] = 1.0f;
+    B[2 * 3 + 1] = 2.0f;
+    EXPECT_TRUE(MlasSparse24GemmIsSparse(CblasNoTrans, 3, 4, B.data(), 3));
+    B[3 * 3 + 1] = 3.0f;
+    EXPECT_FALSE(MlasSparse24GemmIsSparse(CblasNoTrans, 3, 4, B.data(), 3));
+    // the rows of the group are the columns of the transposed B
+    EXPECT_TRUE(MlasSparse24GemmIsSparse(CblasTrans, 4, 3, B.data(), 3));
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static std::string suite_name = std::string("Sparse24Gemm") + (Threaded ? "_Threaded" : "_SingleThread");
+    return suite_name.c_str();
+  }
+};
+
+//
+// Short Execute() test helper to register each test separately by all parameters.
+//
+template <bool Threaded>
+class Sparse24GemmShortExecuteTest : public MlasTestFixture<MlasSparse24GemmTest<Threaded>> {
+ public:
+  explicit Sparse24GemmShortExecuteTest(size_t M, size_t N, size_t K, bool TransB, bool hasBias, bool ZeroMode)
+      : M_(M), N_(N), K_(K), TransB_(TransB), hasBias_(hasBias), ZeroMode_(ZeroMode) {}
+
+  void TestBody() override {
+    if (M_ == 0) {
+      MlasTestFixture<MlasSparse24GemmTest<Threaded>>::mlas_tester->TestIsSparse();
+      return;
+    }
+    MlasTestFixture<MlasSparse24GemmTest<Threaded>>::mlas_tester->Test(M_, N_, K_, TransB_, hasBias_, ZeroMode_);
+  }
+
+  static size_t RegisterSingleTest(size_t M, size_t N, size_t K, bool TransB, bool hasBias, bool ZeroMode) {
+    std::stringstream ss;
+    if (M == 0) {
+      ss << "IsSparse";
+    } else {
+      ss << "/M" << M << "xN" << N << "xK" << K << "/"
+         << "TransB" << TransB << "/"
+         << "hasBias" << hasBias << "/"
+         << "ZeroMode" << ZeroMode;
+    }
+    auto test_name = ss.str();
+
+    testing::RegisterTest(
+        MlasSparse24GemmTest<Threaded>::GetTestSuiteName(),
+        test_name.c_str(),
+        nullptr,
+        test_name.c_str(),
+        __FILE__,
+        __LINE__,
+        // Important to use the fixture type as the return type here.
+        [=]() -> MlasTestFixture<MlasSparse24GemmTest<Threaded>>* {
+          return new Sparse24GemmShortExecuteTest<Threaded>(M, N, K, TransB, hasBias, ZeroMode);
+        });
+
+    return 1;
+  }
+
+  static size_t RegisterShortExecuteTests() {
+    size_t test_registered = 0;
+
+    test_registered += RegisterSingleTest(0, 0, 0, false, false, false);
+    for (size_t b = 1; b < 16; b++) {
+      test_registered += RegisterSingleTest(b, b, b, false, false, true);
+      test_registered += RegisterSingleTest(b, b, b, true, true, false);
+    }
+    for (size_t b = 16; b <= 256; b <<= 1) {
+      test_registered += RegisterSingleTest(b, b, b, false, true, true);
+      test_registered += RegisterSingleTest(b, b, b, true, false, false);
+    }
+    for (size_t b = 1; b < 96; b += 5) {
+      test_registered += RegisterSingleTest(1, b, 32, false, true, true);
+      test_registered += RegisterSingleTest(17, 32, b, true, false, true);
+      test_registered += RegisterSingleTest(3, b, b, false, false, false);
+    }
+    test_registered += RegisterSingleTest(43, 500, 401, false, true, true);
+    test_registered += RegisterSingleTest(160, 130, 67, true, true, false);
+
+    return test_registered;
+  }
+
+ private:
+  size_t M_, N_, K_;
+  bool TransB_, hasBias_, ZeroMode_;
+};
+
+template <>
+MlasSparse24GemmTest<false>* MlasTestFixture<MlasSparse24GemmTest<false>>::mlas_tester(nullptr);
+template <>
+MlasSparse24GemmTest<true>* MlasTestFixture<MlasSparse24GemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  if (is_short_execute) {
+    return Sparse24GemmShortExecuteTest<false>::RegisterShortExecuteTests() +
+               Sparse24GemmShortExecuteTest<true>::RegisterShortExecuteTests() >
+           0;
+  }
+  return false;
+});
+
+#endif  // ORT_MINIMAL_BUILD
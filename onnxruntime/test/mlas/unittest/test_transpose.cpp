@@ -45,12 +45,120 @@ class MlasTransposeTest : public MlasTestBase {
   }
 };
 
+template <typename ElementType>
+class MlasTransposeNDTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<ElementType> BufferInput;
+  MatrixGuardBuffer<ElementType> BufferOutput;
+  MatrixGuardBuffer<ElementType> BufferOutputReference;
+
+  void
+  Test(const std::vector<size_t>& Shape, const std::vector<size_t>& Permutation) {
+    const size_t Rank = Shape.size();
+    size_t Count = 1;
+    for (size_t dim : Shape) {
+      Count *= dim;
+    }
+
+    ElementType* Input = BufferInput.GetBuffer(Count);
+    ElementType* Output = BufferOutput.GetBuffer(Count);
+    ElementType* OutputReference = BufferOutputReference.GetBuffer(Count);
+
+    for (size_t i = 0; i < Count; i++) {
+      Input[i] = ElementType(i * 2654435761u);
+    }
+
+    MlasTransposeND(Input, Output, sizeof(ElementType), Shape.data(), Permutation.data(), Rank, GetMlasThreadPool());
+    ReferenceTransposeND(Input, OutputReference, Shape, Permutation);
+
+    ASSERT_EQ(memcmp(Output, OutputReference, Count * sizeof(ElementType)), 0) << " [" << Format(Shape) << "] perm ["
+                                                                                   << Format(Permutation) << "]";
+  }
+
+  void ReferenceTransposeND(const ElementType* Input, ElementType* Output, const std::vector<size_t>& Shape,
+                            const std::vector<size_t>& Permutation) {
+    const size_t Rank = Shape.size();
+    std::vector<size_t> InputStrides(Rank, 1);
+    for (size_t i = Rank - 1; i > 0; i--) {
+      InputStrides[i - 1] = InputStrides[i] * Shape[i];
+    }
+
+    size_t Count = 1;
+    for (size_t dim : Shape) {
+      Count *= dim;
+    }
+
+    for (size_t o = 0; o < Count; o++) {
+      size_t remainder = o;
+      size_t offset = 0;
+      for (size_t i = Rank; i > 0; i--) {
+        const size_t dim = Shape[Permutation[i - 1]];
+        offset += (remainder % dim) * InputStrides[Permutation[i - 1]];
+        remainder /= dim;
+      }
+      Output[o] = Input[offset];
+    }
+  }
+
+  static std::string Format(const std::vector<size_t>& Values) {
+    std::string s;
+    for (size_t v : Values) {
+      s += (s.empty() ? "" : ",") + std::to_string(v);
+    }
+    return s;
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name = std::string("TransposeND_Size") + std::to_string(int(sizeof(ElementType)));
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    // NCHW to NHWC and back.
+    Test({2, 3, 5, 7}, {0, 2, 3, 1});
+    Test({2, 67, 9, 11}, {0, 2, 3, 1});
+    Test({3, 5, 7, 67}, {0, 3, 1, 2});
+    // Attention head reorders.
+    Test({2, 13, 4, 8}, {0, 2, 1, 3});
+    Test({2, 13, 4, 8}, {0, 2, 3, 1});
+    // Axes of size one and axes that merge.
+    Test({1, 70, 1, 130}, {3, 2, 1, 0});
+    Test({4, 1, 6, 5, 3}, {2, 3, 0, 1, 4});
+    Test({4, 6, 5, 3}, {0, 1, 2, 3});
+
+    std::vector<size_t> Permutation(5);
+    for (size_t i = 0; i < Permutation.size(); i++) {
+      Permutation[i] = i;
+    }
+    do {
+      Test({3, 1, 5, 2, 9}, Permutation);
+    } while (std::next_permutation(Permutation.begin(), Permutation.end()));
+
+    for (size_t m = 1; m <= 80; m += 13) {
+      for (size_t n = 1; n <= 80; n += 11) {
+        Test({m, n}, {1, 0});
+        Test({3, m, n}, {0, 2, 1});
+        Test({m, 2, n}, {2, 1, 0});
+      }
+    }
+  }
+};
+
 template <>
 MlasTransposeTest<uint32_t>* MlasTestFixture<MlasTransposeTest<uint32_t>>::mlas_tester(nullptr);
 template <>
 MlasTransposeTest<uint16_t>* MlasTestFixture<MlasTransposeTest<uint16_t>>::mlas_tester(nullptr);
 template <>
 MlasTransposeTest<uint8_t>* MlasTestFixture<MlasTransposeTest<uint8_t>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNDTest<uint64_t>* MlasTestFixture<MlasTransposeNDTest<uint64_t>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNDTest<uint32_t>* MlasTestFixture<MlasTransposeNDTest<uint32_t>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNDTest<uint16_t>* MlasTestFixture<MlasTransposeNDTest<uint16_t>>::mlas_tester(nullptr);
+template <>
+MlasTransposeNDTest<uint8_t>* MlasTestFixture<MlasTransposeNDTest<uint8_t>>::mlas_tester(nullptr);
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
   size_t count = 0;
@@ -58,6 +166,10 @@ static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_exe
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint32_t>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint16_t>>::RegisterShortExecute();
     count += MlasDirectShortExecuteTests<MlasTransposeTest<uint8_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNDTest<uint64_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNDTest<uint32_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNDTest<uint16_t>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasTransposeNDTest<uint8_t>>::RegisterShortExecute();
   }
   return count;
 });
@@ -0,0 +1,117 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    test_treetraverse.cpp
+
+Abstract:
+
+    Tests for the MLAS compiled decision tree traversal.
+
+--*/
+
+#include "test_util.h"
+
+class MlasTreeTraverseTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<int32_t> BufferLeaves;
+
+  std::vector<int32_t> FeatureIds;
+  std::vector<float> Thresholds;
+  std::vector<int32_t> Children;
+
+  static float Value(size_t i) {
+    // one value in 11 is missing, the others hit the thresholds now and then
+    return (i * 7) % 11 == 3 ? std::numeric_limits<float>::quiet_NaN() : float(int((i * 13) % 9) - 4) * 0.5f;
+  }
+
+  // Builds a complete tree of the given depth whose leaves lead back to themselves.
+  void BuildTree(size_t Depth, size_t Features) {
+    FeatureIds.clear();
+    Thresholds.clear();
+    Children.clear();
+    const size_t Nodes = (size_t(2) << Depth) - 1;
+    const size_t FirstLeaf = (size_t(1) << Depth) - 1;
+    for (size_t i = 0; i < Nodes; i++) {
+      const bool IsLeaf = i >= FirstLeaf;
+      const auto FeatureId = int32_t((i * 5 + Depth) % Features);
+      FeatureIds.push_back(IsLeaf ? 0 : (i % 3 == 1 ? ~FeatureId : FeatureId));
+      Thresholds.push_back(float(int(i % 7) - 3) * 0.5f);
+      Children.push_back(IsLeaf ? int32_t(i) : int32_t(2 * i + 1));
+      Children.push_back(IsLeaf ? int32_t(i) : int32_t(2 * i + 2));
+    }
+  }
+
+  static bool Compare(MLAS_TREE_NODE_MODE Mode, float Value, float Threshold) {
+    switch (Mode) {
+      case MlasTreeNodeLeq:
+        return Value <= Threshold;
+      case MlasTreeNodeLt:
+        return Value < Threshold;
+      case MlasTreeNodeGte:
+        return Value >= Threshold;
+      case MlasTreeNodeGt:
+        return Value > Threshold;
+      case MlasTreeNodeEq:
+        return Value == Threshold;
+      default:
+        return Value != Threshold;
+    }
+  }
+
+ public:
+  void Test(MLAS_TREE_NODE_MODE Mode, size_t Depth, size_t Features, size_t Stride, size_t Rows) {
+    BuildTree(Depth, Features);
+
+    const size_t InputSize = (Rows - 1) * Stride + Features;
+    float* Input = BufferInput.GetBuffer(InputSize);
+    for (size_t i = 0; i < InputSize; i++) {
+      Input[i] = Value(i);
+    }
+    int32_t* Leaves = BufferLeaves.GetBuffer(Rows);
+
+    MlasTreeTraverse(Mode, FeatureIds.data(), Thresholds.data(), Children.data(), 0, Depth, Input, Stride, Rows,
+                     Leaves);
+
+    for (size_t r = 0; r < Rows; r++) {
+      const float* Row = Input + r * Stride;
+      int32_t Node = 0;
+      for (size_t d = 0; d < Depth; d++) {
+        const bool MissingTrack = FeatureIds[Node] < 0;
+        const float x = Row[MissingTrack ? ~FeatureIds[Node] : FeatureIds[Node]];
+        const bool IsTrue = Compare(Mode, x, Thresholds[Node]) || (MissingTrack && std::isnan(x));
+        Node = Children[2 * Node + (IsTrue ? 1 : 0)];
+      }
+      ASSERT_EQ(Leaves[r], Node) << "@" << r << ", Mode=" << Mode << ", Depth=" << Depth << ", Rows=" << Rows;
+    }
+  }
+
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("TreeTraverse");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (int Mode = MlasTreeNodeLeq; Mode <= MlasTreeNodeNeq; Mode++) {
+      for (size_t Rows = 1; Rows < 40; Rows += 3) {
+        Test(MLAS_TREE_NODE_MODE(Mode), 1, 3, 3, Rows);
+        Test(MLAS_TREE_NODE_MODE(Mode), 6, 10, 12, Rows);
+      }
+      Test(MLAS_TREE_NODE_MODE(Mode), 4, 5, 0, 1);
+      Test(MLAS_TREE_NODE_MODE(Mode), 10, 50, 50, 1000);
+    }
+  }
+};
+
+template <>
+MlasTreeTraverseTest* MlasTestFixture<MlasTreeTraverseTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  // no long execute needed
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasTreeTraverseTest>::RegisterShortExecute() : 0;
+});
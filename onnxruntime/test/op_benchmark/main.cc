@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks single operators over the shapes and types of a spec file, reporting time, bytes/s and FLOP/s, and
+// optionally comparing the times against a baseline saved by a previous run:
+//   onnxruntime_op_benchmark --spec=ops.json [--save_baseline=baseline.json] [--baseline=baseline.json]
+//                            [--tolerance=0.1] [--intra_op_num_threads=N] [google benchmark flags]
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/clog_sink.h"
+#include "core/session/environment.h"
+#include "test/op_benchmark/op_benchmark_spec.h"
+#include "test/op_benchmark/op_runner.h"
+
+using json = nlohmann::json;
+using namespace onnxruntime;
+using namespace onnxruntime::test::op_benchmark;
+
+namespace {
+
+struct Options {
+  std::string spec_path;
+  std::string baseline_path;
+  std::string save_baseline_path;
+  double tolerance{0.1};
+  int intra_op_num_threads{1};
+};
+
+struct Measurement {
+  double time_ns{0.0};
+  double bytes_per_second{0.0};
+  double flops_per_second{0.0};
+};
+
+// Remove the flags of this program from the arguments, leaving the unrecognized ones.
+bool ParseOptions(int& argc, char** argv, Options& options) {
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto value_of = [&arg](const std::string& flag, std::string& value) {
+      if (arg.rfind(flag, 0) != 0) {
+        return false;
+      }
+      value = arg.substr(flag.size());
+      return true;
+    };
+    std::string value;
+    if (value_of("--spec=", value)) {
+      options.spec_path = value;
+    } else if (value_of("--baseline=", value)) {
+      options.baseline_path = value;
+    } else if (value_of("--save_baseline=", value)) {
+      options.save_baseline_path = value;
+    } else if (value_of("--tolerance=", value)) {
+      options.tolerance = std::stod(value);
+    } else if (value_of("--intra_op_num_threads=", value)) {
+      options.intra_op_num_threads = std::stoi(value);
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+  return !options.spec_path.empty() && options.tolerance >= 0.0 && options.intra_op_num_threads >= 0;
+}
+
+// Reports to the console and keeps the measurement of each case for the baseline.
+class BaselineReporter : public benchmark::ConsoleReporter {
+ public:
+  void ReportRuns(const std::vector<Run>& runs) override {
+    for (const auto& run : runs) {
+      if (run.run_type != Run::RT_Iteration || run.error_occurred) {
+        continue;
+      }
+      Measurement& measurement = measurements_[run.benchmark_name()];
+      measurement.time_ns = run.GetAdjustedRealTime() * 1e9 / benchmark::GetTimeUnitMultiplier(run.time_unit);
+      const auto bytes = run.counters.find("bytes_per_second");
+      measurement.bytes_per_second = bytes == run.counters.end() ? 0.0 : bytes->second.value;
+      const auto flops = run.counters.find("FLOP/s");
+      measurement.flops_per_second = flops == run.counters.end() ? 0.0 : flops->second.value;
+    }
+    ConsoleReporter::ReportRuns(runs);
+  }
+
+  const std::map<std::string, Measurement>& Measurements() const { return measurements_; }
+
+ private:
+  std::map<std::string, Measurement> measurements_;
+};
+
+bool SaveBaseline(const std::string& path, const std::map<std::string, Measurement>& measurements) {
+  json benchmarks = json::object();
+  for (const auto& [name, measurement] : measurements) {
+    benchmarks[name] = {{"time_ns", measurement.time_ns},
+                        {"bytes_per_second", measurement.bytes_per_second},
+                        {"flops_per_second", measurement.flops_per_second}};
+  }
+  std::ofstream file(path);
+  file << std::setw(2) << json{{"benchmarks", benchmarks}} << std::endl;
+  return file.good();
+}
+
+// Print the cases slower than their baseline by more than the tolerance, and return whether there is any.
+bool CompareWithBaseline(const std::string& path, double tolerance,
+                         const std::map<std::string, Measurement>& measurements) {
+  std::ifstream file(path);
+  if (!file.good()) {
+    std::cerr << "Failed to open the baseline " << path << std::endl;
+    return true;
+  }
+  const json baseline = json::parse(file, nullptr, /*allow_exceptions*/ false);
+  if (!baseline.is_object() || !baseline.contains("benchmarks")) {
+    std::cerr << "Invalid baseline " << path << std::endl;
+    return true;
+  }
+
+  bool regressed = false;
+  size_t compared = 0;
+  const json& baseline_benchmarks = baseline["benchmarks"];
+  std::cout << "\nComparison with the baseline " << path << " (tolerance " << tolerance * 100.0 << "%):\n";
+  for (const auto& [name, measurement] : measurements) {
+    if (!baseline_benchmarks.contains(name)) {
+      std::cout << "  " << name << ": not in the baseline\n";
+      continue;
+    }
+    const double baseline_ns = baseline_benchmarks[name].value("time_ns", 0.0);
+    if (baseline_ns <= 0.0) {
+      continue;
+    }
+    ++compared;
+    const double ratio = measurement.time_ns / baseline_ns;
+    if (ratio > 1.0 + tolerance) {
+      regressed = true;
+      std::cout << "  REGRESSION " << name << ": " << std::fixed << std::setprecision(1) << measurement.time_ns
+                << " ns vs " << baseline_ns << " ns (+" << (ratio - 1.0) * 100.0 << "%)\n";
+    } else if (ratio < 1.0 - tolerance) {
+      std::cout << "  improvement " << name << ": " << std::fixed << std::setprecision(1) << measurement.time_ns
+                << " ns vs " << baseline_ns << " ns (" << (ratio - 1.0) * 100.0 << "%)\n";
+    }
+  }
+  std::cout << "  " << compared << " cases compared, " << (regressed ? "regressions found" : "no regression")
+            << std::endl;
+  return regressed;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::cerr << "Usage: " << argv[0] << " --spec=<spec.json> [--baseline=<baseline.json>] "
+              << "[--save_baseline=<baseline.json>] [--tolerance=<fraction>] [--intra_op_num_threads=<n>] "
+              << "[benchmark flags]" << std::endl;
+    return -1;
+  }
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    return -1;
+
+  std::unique_ptr<Environment> env;
+  auto status = Environment::Create(
+      std::make_unique<logging::LoggingManager>(std::make_unique<logging::CLogSink>(), logging::Severity::kWARNING,
+                                                false, logging::LoggingManager::InstanceType::Default),
+      env);
+  if (!status.IsOK()) {
+    std::cerr << "Failed to create the environment: " << status.ErrorMessage() << std::endl;
+    return -1;
+  }
+
+  std::vector<OpBenchmarkCase> cases;
+  status = LoadOpBenchmarkSpec(options.spec_path, cases);
+  if (!status.IsOK()) {
+    std::cerr << status.ErrorMessage() << std::endl;
+    return -1;
+  }
+
+  for (const auto& op_case : cases) {
+    ::benchmark::RegisterBenchmark(op_case.name.c_str(), [&op_case, &env, &options](benchmark::State& state) {
+      // created for each run of the benchmark so the memory of a single case is held at a time
+      std::unique_ptr<OpRunner> runner;
+      auto create_status = OpRunner::Create(op_case, *env, options.intra_op_num_threads, runner);
+      if (!create_status.IsOK()) {
+        state.SkipWithError(create_status.ErrorMessage().c_str());
+        return;
+      }
+      for (auto _ : state) {
+        auto run_status = runner->Run();
+        if (!run_status.IsOK()) {
+          state.SkipWithError(run_status.ErrorMessage().c_str());
+          break;
+        }
+      }
+      state.SetBytesProcessed(static_cast<int64_t>(runner->Bytes() * static_cast<double>(state.iterations())));
+      state.counters["FLOP/s"] = benchmark::Counter(runner->Flops(), benchmark::Counter::kIsIterationInvariantRate,
+                                                    benchmark::Counter::kIs1000);
+    })
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+  }
+
+  BaselineReporter reporter;
+  ::benchmark::RunSpecifiedBenchmarks(&reporter);
+
+  if (!options.save_baseline_path.empty() && !SaveBaseline(options.save_baseline_path, reporter.Measurements())) {
+    std::cerr << "Failed to save the baseline " << options.save_baseline_path << std::endl;
+    return -1;
+  }
+  if (!options.baseline_path.empty() &&
+      CompareWithBaseline(options.baseline_path, options.tolerance, reporter.Measurements())) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,209 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/op_benchmark/op_benchmark_spec.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+#include "nlohmann/json.hpp"
+
+#include "core/common/common.h"
+#include "core/graph/node_attr_utils.h"
+
+using json = nlohmann::json;
+
+namespace onnxruntime {
+namespace test {
+namespace op_benchmark {
+
+namespace {
+
+using ParamValues = std::map<std::string, json>;
+
+Status ParseElementType(const std::string& name, ONNXTensorElementDataType& type) {
+  static const std::unordered_map<std::string, ONNXTensorElementDataType> types = {
+      {"float", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+      {"float16", ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16},
+      {"bfloat16", ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16},
+      {"double", ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE},
+      {"int8", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8},
+      {"uint8", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8},
+      {"int16", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16},
+      {"uint16", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16},
+      {"int32", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32},
+      {"uint32", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32},
+      {"int64", ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64},
+      {"uint64", ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64},
+      {"bool", ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL},
+  };
+  auto it = types.find(name);
+  ORT_RETURN_IF(it == types.end(), "Unsupported element type: ", name);
+  type = it->second;
+  return Status::OK();
+}
+
+// Replace a string naming a parameter by the value of the parameter.
+const json& Substitute(const json& value, const ParamValues& params) {
+  if (value.is_string()) {
+    auto it = params.find(value.get<std::string>());
+    if (it != params.end()) {
+      return it->second;
+    }
+  }
+  return value;
+}
+
+Status ParseInput(const json& input, const ParamValues& params, InputSpec& spec) {
+  if (input.is_null()) {
+    spec.is_present = false;
+    return Status::OK();
+  }
+  ORT_RETURN_IF_NOT(input.is_object(), "An input must be an object or null: ", input.dump());
+
+  const json& type = Substitute(input.value("type", json("float")), params);
+  ORT_RETURN_IF_NOT(type.is_string(), "The type of an input must be a string: ", type.dump());
+  ORT_RETURN_IF_ERROR(ParseElementType(type.get<std::string>(), spec.type));
+
+  const json shape = input.value("shape", json::array());
+  ORT_RETURN_IF_NOT(shape.is_array(), "The shape of an input must be an array: ", shape.dump());
+  for (const auto& dim : shape) {
+    const json& dim_value = Substitute(dim, params);
+    ORT_RETURN_IF_NOT(dim_value.is_number_integer(), "Unknown dimension or parameter: ", dim.dump());
+    spec.shape.push_back(dim_value.get<int64_t>());
+  }
+
+  spec.min_value = Substitute(input.value("min", json(spec.min_value)), params).get<double>();
+  spec.max_value = Substitute(input.value("max", json(spec.max_value)), params).get<double>();
+  ORT_RETURN_IF(spec.min_value > spec.max_value, "The min of an input is greater than its max: ", input.dump());
+  spec.is_constant = input.value("constant", false);
+  return Status::OK();
+}
+
+Status ParseAttribute(const std::string& name, const json& value, NodeAttributes& attributes) {
+  ONNX_NAMESPACE::AttributeProto attribute;
+  if (value.is_number_integer()) {
+    attribute = utils::MakeAttribute(name, value.get<int64_t>());
+  } else if (value.is_number()) {
+    attribute = utils::MakeAttribute(name, value.get<float>());
+  } else if (value.is_string()) {
+    attribute = utils::MakeAttribute(name, value.get<std::string>());
+  } else if (value.is_array() && !value.empty() && value.front().is_number_integer()) {
+    const auto values = value.get<std::vector<int64_t>>();
+    attribute = utils::MakeAttribute(name, gsl::make_span(values));
+  } else if (value.is_array() && !value.empty() && value.front().is_number()) {
+    const auto values = value.get<std::vector<float>>();
+    attribute = utils::MakeAttribute(name, gsl::make_span(values));
+  } else if (value.is_array() && !value.empty() && value.front().is_string()) {
+    const auto values = value.get<std::vector<std::string>>();
+    attribute = utils::MakeAttribute(name, gsl::make_span(values));
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported value of attribute ", name, ": ", value.dump());
+  }
+  utils::SetNodeAttribute(std::move(attribute), attributes);
+  return Status::OK();
+}
+
+// The parameter values of a case, in the order of the parameter names so the names are stable.
+std::string MakeCaseName(const std::string& name, const std::string& provider, const ParamValues& params) {
+  std::ostringstream case_name;
+  case_name << name << "/" << provider;
+  for (const auto& [param, value] : params) {
+    case_name << "/" << param << "=" << (value.is_string() ? value.get<std::string>() : value.dump());
+  }
+  return case_name.str();
+}
+
+Status ExpandBenchmark(const json& benchmark, int onnx_opset, std::vector<OpBenchmarkCase>& cases) {
+  ORT_RETURN_IF_NOT(benchmark.is_object() && benchmark.contains("op"), "A benchmark must have an op: ",
+                    benchmark.dump());
+  const auto op_type = benchmark["op"].get<std::string>();
+  const auto name = benchmark.value("name", op_type);
+  const auto providers = benchmark.value("providers", std::vector<std::string>{"cpu"});
+  const json inputs = benchmark.value("inputs", json::array());
+  const json attributes = benchmark.value("attributes", json::object());
+  ORT_RETURN_IF_NOT(inputs.is_array() && attributes.is_object(), "Invalid inputs or attributes in benchmark ", name);
+
+  std::vector<std::pair<std::string, std::vector<json>>> param_values;
+  for (const auto& [param, values] : benchmark.value("params", json::object()).items()) {
+    ORT_RETURN_IF_NOT(values.is_array() && !values.empty(), "Parameter ", param, " of benchmark ", name,
+                      " must have a non-empty array of values");
+    param_values.emplace_back(param, std::vector<json>(values.begin(), values.end()));
+  }
+
+  NodeAttributes node_attributes;
+  for (const auto& [attribute, value] : attributes.items()) {
+    ORT_RETURN_IF_ERROR(ParseAttribute(attribute, value, node_attributes));
+  }
+
+  // iterate the product of the parameter values like an odometer
+  std::vector<size_t> indices(param_values.size(), 0);
+  for (;;) {
+    ParamValues params;
+    for (size_t i = 0; i < param_values.size(); ++i) {
+      params.emplace(param_values[i].first, param_values[i].second[indices[i]]);
+    }
+
+    for (const auto& provider : providers) {
+      OpBenchmarkCase op_case;
+      op_case.name = MakeCaseName(name, provider, params);
+      op_case.op_type = op_type;
+      op_case.domain = benchmark.value("domain", std::string{});
+      op_case.onnx_opset = onnx_opset;
+      op_case.domain_version = benchmark.value("version", 1);
+      op_case.provider = provider;
+      op_case.num_outputs = benchmark.value("outputs", size_t{1});
+      op_case.attributes = node_attributes;
+      for (const auto& input : inputs) {
+        InputSpec input_spec;
+        ORT_RETURN_IF_ERROR(ParseInput(input, params, input_spec));
+        op_case.inputs.push_back(std::move(input_spec));
+      }
+      cases.push_back(std::move(op_case));
+    }
+
+    size_t i = 0;
+    for (; i < indices.size(); ++i) {
+      if (++indices[i] < param_values[i].second.size()) {
+        break;
+      }
+      indices[i] = 0;
+    }
+    if (i == indices.size()) {
+      break;
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status LoadOpBenchmarkSpec(const std::string& path, std::vector<OpBenchmarkCase>& cases) {
+  std::ifstream file(path);
+  ORT_RETURN_IF_NOT(file.good(), "Failed to open the spec file ", path);
+
+  ORT_TRY {
+    const json spec = json::parse(file);
+    const int onnx_opset = spec.value("opset", 17);
+    ORT_RETURN_IF_NOT(spec.contains("benchmarks") && spec["benchmarks"].is_array(),
+                      "The spec file must have an array of benchmarks: ", path);
+    for (const auto& benchmark : spec["benchmarks"]) {
+      ORT_RETURN_IF_ERROR(ExpandBenchmark(benchmark, onnx_opset, cases));
+    }
+  }
+  ORT_CATCH(const json::exception& ex) {
+    Status status;
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the spec file ", path, ": ",
+                               ex.what());
+    });
+    return status;
+  }
+  return Status::OK();
+}
+
+}  // namespace op_benchmark
+}  // namespace test
+}  // namespace onnxruntime
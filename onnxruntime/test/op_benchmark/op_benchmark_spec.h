@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/status.h"
+#include "core/graph/basic_types.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+namespace test {
+namespace op_benchmark {
+
+// An input of the operator, filled with values drawn uniformly from [min_value, max_value].
+struct InputSpec {
+  bool is_present{true};  // false for an omitted optional input
+  ONNXTensorElementDataType type{ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT};
+  std::vector<int64_t> shape;
+  double min_value{0.0};
+  double max_value{1.0};
+  // constant inputs are initializers of the node, which the kernel may pre-pack
+  bool is_constant{false};
+};
+
+// One configuration of an operator to benchmark, with the parameters of its spec substituted.
+struct OpBenchmarkCase {
+  // unique, made of the benchmark name, the provider and the parameter values, e.g. MatMul/cpu/K=768/M=1/N=768
+  std::string name;
+  std::string op_type;
+  std::string domain;
+  int onnx_opset{17};
+  int domain_version{1};  // the opset of the domain of the operator when it is not ONNX
+  std::string provider;
+  std::vector<InputSpec> inputs;
+  size_t num_outputs{1};
+  NodeAttributes attributes;
+};
+
+// Load a spec file and expand each of its benchmarks over its providers and the product of its parameter values.
+// The file is JSON:
+// {
+//   "opset": 17,
+//   "benchmarks": [
+//     {
+//       "name": "MatMul",             // optional, defaults to the op
+//       "op": "MatMul",
+//       "domain": "",                 // optional, "com.microsoft" for the contrib ops
+//       "version": 1,                 // optional, the opset of a domain other than ONNX
+//       "providers": ["cpu", "cuda"], // optional, defaults to cpu
+//       "params": {"M": [1, 128], "K": [768], "N": [768, 3072], "T": ["float", "float16"]},
+//       "inputs": [
+//         {"type": "T", "shape": ["M", "K"], "min": -1, "max": 1},
+//         {"type": "T", "shape": ["K", "N"], "constant": true},
+//         null                        // an omitted optional input
+//       ],
+//       "outputs": 1,
+//       "attributes": {"alpha": 1.0, "axes": [0, 1], "mode": "linear"}
+//     }
+//   ]
+// }
+// A string in a shape or a type names a parameter whose value is substituted.
+Status LoadOpBenchmarkSpec(const std::string& path, std::vector<OpBenchmarkCase>& cases);
+
+}  // namespace op_benchmark
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,365 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/op_benchmark/op_runner.h"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/data_types.h"
+#include "core/framework/float16.h"
+#include "core/framework/op_kernel.h"
+#include "core/framework/roofline.h"
+#include "core/framework/tensor.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/model.h"
+#include "core/optimizer/optimizer_execution_frame.h"
+#include "core/platform/env.h"
+#include "core/session/environment.h"
+#include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
+#include "core/util/thread_utils.h"
+#include "test/util/include/default_providers.h"
+
+namespace onnxruntime {
+namespace test {
+namespace op_benchmark {
+
+namespace {
+
+template <typename T>
+void FillUniform(Tensor& tensor, double min_value, double max_value, std::mt19937& generator) {
+  std::uniform_real_distribution<double> distribution(min_value, max_value);
+  for (auto& value : tensor.MutableDataAsSpan<T>()) {
+    value = static_cast<T>(distribution(generator));
+  }
+}
+
+template <typename T>
+void FillUniformHalf(Tensor& tensor, double min_value, double max_value, std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(static_cast<float>(min_value), static_cast<float>(max_value));
+  for (auto& value : tensor.MutableDataAsSpan<T>()) {
+    value = T(distribution(generator));
+  }
+}
+
+Status FillRandom(Tensor& tensor, const InputSpec& spec, std::mt19937& generator) {
+  const double min_value = spec.min_value;
+  const double max_value = spec.max_value;
+  switch (spec.type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      FillUniform<float>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      FillUniform<double>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      FillUniformHalf<MLFloat16>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      FillUniformHalf<BFloat16>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+      FillUniform<int8_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      FillUniform<uint8_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+      FillUniform<int16_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      FillUniform<uint16_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      FillUniform<int32_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      FillUniform<uint32_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      FillUniform<int64_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      FillUniform<uint64_t>(tensor, min_value, max_value, generator);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL: {
+      std::bernoulli_distribution distribution(0.5);
+      for (auto& value : tensor.MutableDataAsSpan<bool>()) {
+        value = distribution(generator);
+      }
+      break;
+    }
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported input element type ", spec.type);
+  }
+  return Status::OK();
+}
+
+// The single node model of a case. The constant inputs are initializers and the others graph inputs, both named
+// input_<index>, so the values of the inputs can be bound by name.
+class OpModel {
+ public:
+  Status Build(const OpBenchmarkCase& op_case, const logging::Logger& logger) {
+    std::unordered_map<std::string, int> domain_to_version{{kOnnxDomain, op_case.onnx_opset}};
+    if (!op_case.domain.empty() && op_case.domain != kOnnxDomain) {
+      domain_to_version[op_case.domain] = op_case.domain_version;
+    }
+    model_ = std::make_unique<Model>("op_benchmark", false, ModelMetaData(), PathString(),
+                                     IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                     std::vector<ONNX_NAMESPACE::FunctionProto>(), logger);
+    Graph& graph = model_->MainGraph();
+
+    auto allocator = std::make_shared<CPUAllocator>();
+    std::mt19937 generator(static_cast<unsigned>(std::hash<std::string>{}(op_case.name)));
+    std::vector<NodeArg*> input_args;
+    std::vector<const NodeArg*> graph_inputs;
+    input_values_.resize(op_case.inputs.size());
+    for (size_t i = 0; i < op_case.inputs.size(); ++i) {
+      const InputSpec& spec = op_case.inputs[i];
+      if (!spec.is_present) {
+        input_args.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+        continue;
+      }
+
+      const std::string name = "input_" + std::to_string(i);
+      Tensor::InitOrtValue(DataTypeImpl::TensorTypeFromONNXEnum(spec.type)->GetElementType(),
+                           TensorShape(spec.shape), allocator, input_values_[i]);
+      ORT_RETURN_IF_ERROR(FillRandom(*input_values_[i].GetMutable<Tensor>(), spec, generator));
+
+      ONNX_NAMESPACE::TypeProto type;
+      type.mutable_tensor_type()->set_elem_type(spec.type);
+      for (int64_t dim : spec.shape) {
+        type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+      }
+      NodeArg& arg = graph.GetOrCreateNodeArg(name, &type);
+      input_args.push_back(&arg);
+      if (spec.is_constant) {
+        graph.AddInitializedTensor(utils::TensorToTensorProto(input_values_[i].Get<Tensor>(), name));
+      } else {
+        graph_inputs.push_back(&arg);
+        input_names_.push_back(name);
+      }
+    }
+
+    std::vector<NodeArg*> output_args;
+    for (size_t i = 0; i < op_case.num_outputs; ++i) {
+      output_names_.push_back("output_" + std::to_string(i));
+      output_args.push_back(&graph.GetOrCreateNodeArg(output_names_.back(), nullptr));
+    }
+
+    node_ = &graph.AddNode("node", op_case.op_type, "", input_args, output_args, &op_case.attributes,
+                           op_case.domain);
+    graph.SetInputs(graph_inputs);
+    graph.SetOutputs(std::vector<const NodeArg*>(output_args.begin(), output_args.end()));
+    return graph.Resolve();
+  }
+
+  Model& GetModel() { return *model_; }
+  Node& GetNode() { return *node_; }
+  // the values of the inputs, empty for the absent ones
+  const std::vector<OrtValue>& InputValues() const { return input_values_; }
+  // the names of the graph inputs, i.e. of the inputs which are not constant
+  const std::vector<std::string>& InputNames() const { return input_names_; }
+  const std::vector<std::string>& OutputNames() const { return output_names_; }
+
+  // The operations and bytes of a run of the node with the given outputs.
+  void Measure(const std::vector<OrtValue>& outputs, double& flops, double& bytes) const {
+    std::vector<const Tensor*> inputs;
+    bytes = 0.0;
+    for (const auto& value : input_values_) {
+      inputs.push_back(value.IsAllocated() ? &value.Get<Tensor>() : nullptr);
+      bytes += value.IsAllocated() ? static_cast<double>(value.Get<Tensor>().SizeInBytes()) : 0.0;
+    }
+    std::vector<const Tensor*> output_tensors;
+    for (const auto& value : outputs) {
+      const bool is_tensor = value.IsAllocated() && value.IsTensor();
+      output_tensors.push_back(is_tensor ? &value.Get<Tensor>() : nullptr);
+      bytes += is_tensor ? static_cast<double>(value.Get<Tensor>().SizeInBytes()) : 0.0;
+    }
+    flops = EstimateNodeFlops(*node_, inputs, output_tensors);
+  }
+
+ private:
+  std::unique_ptr<Model> model_;
+  Node* node_{nullptr};
+  std::vector<OrtValue> input_values_;
+  std::vector<std::string> input_names_;
+  std::vector<std::string> output_names_;
+};
+
+// Invokes the CPU kernel of the node directly in an execution frame, the way constant folding does.
+class KernelOpRunner : public OpRunner {
+ public:
+  Status Init(const OpBenchmarkCase& op_case, int intra_op_num_threads) {
+    const auto& logger = logging::LoggingManager::DefaultLogger();
+    ORT_RETURN_IF_ERROR(model_.Build(op_case, logger));
+    Node& node = model_.GetNode();
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+
+    execution_provider_ = DefaultCpuExecutionProvider(/*enable_arena*/ false);
+    std::unordered_map<std::string, OrtValue> constant_inputs;
+    std::unordered_map<std::string, OrtValue> all_inputs;
+    for (size_t i = 0; i < op_case.inputs.size(); ++i) {
+      if (!op_case.inputs[i].is_present) {
+        continue;
+      }
+      const std::string& name = node.InputDefs()[i]->Name();
+      all_inputs.emplace(name, model_.InputValues()[i]);
+      if (op_case.inputs[i].is_constant) {
+        constant_inputs.emplace(name, model_.InputValues()[i]);
+      }
+    }
+
+    // The kernel only sees the constant inputs as initializers, like in a session, while the frame it runs in
+    // provides all of them. Both are built from the same node so their value indices match.
+    const std::vector<const Node*> nodes{&node};
+    kernel_info_ = std::make_unique<OptimizerExecutionFrame::Info>(nodes, constant_inputs, Path(),
+                                                                   *execution_provider_, is_sparse_initializer_);
+    frame_info_ = std::make_unique<OptimizerExecutionFrame::Info>(nodes, all_inputs, Path(), *execution_provider_,
+                                                                  is_sparse_initializer_);
+    kernel_ = kernel_info_->CreateKernel(&node);
+    ORT_RETURN_IF(kernel_ == nullptr, "No CPU kernel for ", op_case.op_type, " in the domain '", op_case.domain,
+                  "' with these input types");
+
+    // Pre-pack the constant inputs as the session state would, so the measured Compute() uses the packed weights.
+    // The kernel is only const to the optimizers, which never pre-pack.
+    auto& kernel = const_cast<OpKernel&>(*kernel_);
+    for (size_t i = 0; i < op_case.inputs.size(); ++i) {
+      if (op_case.inputs[i].is_present && op_case.inputs[i].is_constant) {
+        bool is_packed = false;
+        ORT_RETURN_IF_ERROR(kernel.PrePack(model_.InputValues()[i].Get<Tensor>(), static_cast<int>(i),
+                                           frame_info_->GetAllocator(), is_packed, nullptr));
+      }
+    }
+
+    OrtThreadPoolParams thread_pool_params;
+    thread_pool_params.thread_pool_size = intra_op_num_threads;
+    thread_pool_ = concurrency::CreateThreadPool(&Env::Default(), thread_pool_params,
+                                                 concurrency::ThreadPoolType::INTRA_OP);
+
+    std::vector<int> fetch_mlvalue_idxs;
+    for (const auto* output : node.OutputDefs()) {
+      fetch_mlvalue_idxs.push_back(frame_info_->GetMLValueIndex(output->Name()));
+    }
+    // the frame keeps the outputs of a run, whose buffers are reused by the next one as the shapes do not change
+    frame_ = std::make_unique<OptimizerExecutionFrame>(*frame_info_, fetch_mlvalue_idxs);
+
+    ORT_RETURN_IF_ERROR(Run());
+    std::vector<OrtValue> outputs;
+    ORT_RETURN_IF_ERROR(frame_->GetOutputs(outputs));
+    model_.Measure(outputs, flops_, bytes_);
+    return Status::OK();
+  }
+
+  Status Run() override {
+    OpKernelContext context(frame_.get(), kernel_.get(), /*stream*/ nullptr, thread_pool_.get(),
+                            logging::LoggingManager::DefaultLogger());
+    return kernel_->Compute(&context);
+  }
+
+ private:
+  OpModel model_;
+  std::unique_ptr<IExecutionProvider> execution_provider_;
+  // referenced by the frame infos
+  std::function<bool(const std::string&)> is_sparse_initializer_{[](const std::string&) { return false; }};
+  std::unique_ptr<OptimizerExecutionFrame::Info> kernel_info_;
+  std::unique_ptr<OptimizerExecutionFrame::Info> frame_info_;
+  std::unique_ptr<const OpKernel> kernel_;
+  std::unique_ptr<concurrency::ThreadPool> thread_pool_;
+  std::unique_ptr<OptimizerExecutionFrame> frame_;
+};
+
+std::unique_ptr<IExecutionProvider> CreateExecutionProvider(const std::string& provider) {
+  if (provider == "cuda") {
+    return DefaultCudaExecutionProvider();
+  }
+  if (provider == "rocm") {
+    return DefaultRocmExecutionProvider();
+  }
+  if (provider == "dnnl") {
+    return DefaultDnnlExecutionProvider();
+  }
+  if (provider == "xnnpack") {
+    return DefaultXnnpackExecutionProvider();
+  }
+  if (provider == "dml") {
+    return DefaultDmlExecutionProvider();
+  }
+  return nullptr;
+}
+
+// Runs a session of the single node on another EP. The inputs are copied to the device once when they are bound and
+// the outputs stay on the device, so a run measures the execution of the node and the overhead of the session.
+class SessionOpRunner : public OpRunner {
+ public:
+  Status Init(const OpBenchmarkCase& op_case, const Environment& env, int intra_op_num_threads) {
+    auto execution_provider = CreateExecutionProvider(op_case.provider);
+    ORT_RETURN_IF(execution_provider == nullptr, "The execution provider ", op_case.provider,
+                  " is unknown or not enabled in this build");
+    const OrtDevice device = execution_provider->GetOrtDeviceByMemType(OrtMemTypeDefault);
+
+    const auto& logger = logging::LoggingManager::DefaultLogger();
+    ORT_RETURN_IF_ERROR(model_.Build(op_case, logger));
+    std::string model_data;
+    ORT_RETURN_IF_NOT(model_.GetModel().ToProto().SerializeToString(&model_data), "Failed to serialize the model");
+
+    SessionOptions session_options;
+    session_options.session_logid = op_case.name;
+    session_options.intra_op_param.thread_pool_size = intra_op_num_threads;
+    session_ = std::make_unique<InferenceSession>(session_options, env);
+    ORT_RETURN_IF_ERROR(session_->RegisterExecutionProvider(std::move(execution_provider)));
+    ORT_RETURN_IF_ERROR(session_->Load(model_data.data(), static_cast<int>(model_data.size())));
+    ORT_RETURN_IF_ERROR(session_->Initialize());
+
+    ORT_RETURN_IF_ERROR(session_->NewIOBinding(&io_binding_));
+    size_t input_name_index = 0;
+    for (size_t i = 0; i < op_case.inputs.size(); ++i) {
+      if (op_case.inputs[i].is_present && !op_case.inputs[i].is_constant) {
+        ORT_RETURN_IF_ERROR(io_binding_->BindInput(model_.InputNames()[input_name_index++],
+                                                   model_.InputValues()[i]));
+      }
+    }
+    for (const auto& name : model_.OutputNames()) {
+      ORT_RETURN_IF_ERROR(io_binding_->BindOutput(name, device));
+    }
+
+    ORT_RETURN_IF_ERROR(Run());
+    model_.Measure(io_binding_->GetOutputs(), flops_, bytes_);
+    return Status::OK();
+  }
+
+  Status Run() override {
+    ORT_RETURN_IF_ERROR(session_->Run(run_options_, *io_binding_));
+    return io_binding_->SynchronizeOutputs();
+  }
+
+ private:
+  OpModel model_;
+  RunOptions run_options_;
+  std::unique_ptr<InferenceSession> session_;
+  std::unique_ptr<IOBinding> io_binding_;
+};
+
+}  // namespace
+
+Status OpRunner::Create(const OpBenchmarkCase& op_case, const Environment& env, int intra_op_num_threads,
+                        std::unique_ptr<OpRunner>& runner) {
+  if (op_case.provider == "cpu") {
+    auto kernel_runner = std::make_unique<KernelOpRunner>();
+    ORT_RETURN_IF_ERROR(kernel_runner->Init(op_case, intra_op_num_threads));
+    runner = std::move(kernel_runner);
+  } else {
+    auto session_runner = std::make_unique<SessionOpRunner>();
+    ORT_RETURN_IF_ERROR(session_runner->Init(op_case, env, intra_op_num_threads));
+    runner = std::move(session_runner);
+  }
+  return Status::OK();
+}
+
+}  // namespace op_benchmark
+}  // namespace test
+}  // namespace onnxruntime
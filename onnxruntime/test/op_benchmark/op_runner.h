@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+
+#include "core/common/status.h"
+#include "test/op_benchmark/op_benchmark_spec.h"
+
+namespace onnxruntime {
+class Environment;
+
+namespace test {
+namespace op_benchmark {
+
+// Runs a single operator over the inputs of a benchmark case. The inputs are generated once, so Run() only measures
+// the execution of the operator.
+class OpRunner {
+ public:
+  // Create the runner for the provider of the case. On the CPU EP the kernel is created and invoked directly, with
+  // its constant inputs pre-packed, so nothing but its Compute() is measured. Other EPs run a session of the single
+  // node, with the inputs bound on the device of the EP.
+  static Status Create(const OpBenchmarkCase& op_case, const Environment& env, int intra_op_num_threads,
+                       std::unique_ptr<OpRunner>& runner);
+
+  virtual ~OpRunner() = default;
+
+  virtual Status Run() = 0;
+
+  // The operations and the bytes of the inputs and outputs of a run, known after the first run.
+  double Flops() const { return flops_; }
+  double Bytes() const { return bytes_; }
+
+ protected:
+  OpRunner() = default;
+
+  double flops_{0.0};
+  double bytes_{0.0};
+};
+
+}  // namespace op_benchmark
+}  // namespace test
+}  // namespace onnxruntime
@@ -35,8 +35,10 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
+#include "core/optimizer/gather_block_quantization.h"
 #include "core/optimizer/gather_fusion.h"
 #include "core/optimizer/gelu_approximation.h"
 #include "core/optimizer/gelu_fusion.h"
@@ -50,10 +52,12 @@
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/isinf_reducesum_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/ml_preprocessing_fusion.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
 #include "core/optimizer/propagate_cast_ops.h"
@@ -61,9 +65,12 @@
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/shape_expression_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_sharding.h"
 #include "core/optimizer/unsqueeze_elimination.h"
 #include "core/optimizer/utils.h"
+#include "core/optimizer/zipmap_columnar.h"
 #include "core/platform/env.h"
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -665,6 +672,96 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, LoopInvariantCodeMotion) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  TypeProto int64_scalar_type;
+  int64_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto bool_scalar_type;
+  bool_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar_type.mutable_tensor_type()->mutable_shape();
+
+  auto create_body = [&](GraphProto& graph_proto) {
+    // state_out = state_in + (outer_value * outer_value + local_constant), where only the last Add depends on the
+    // iteration
+    Model model("LoopInvariantCodeMotion_body", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+    auto& graph = model.MainGraph();
+
+    TensorProto local_constant;
+    local_constant.set_name("local_constant");
+    local_constant.add_dims(1);
+    local_constant.add_float_data(1.f);
+    local_constant.set_data_type(TensorProto_DataType_FLOAT);
+    graph.AddInitializedTensor(local_constant);
+
+    auto& iter_num = graph.GetOrCreateNodeArg("iter_num", &int64_scalar_type);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar_type);
+    auto& state_in = graph.GetOrCreateNodeArg("state_in", &float_tensor_type);
+    auto& outer_value = graph.GetOrCreateNodeArg("outer_value", &float_tensor_type);
+    graph.AddOuterScopeNodeArg("outer_value");
+    auto& local_constant_arg = graph.GetOrCreateNodeArg("local_constant", &float_tensor_type);
+    auto& squared = graph.GetOrCreateNodeArg("squared", &float_tensor_type);
+    auto& shifted = graph.GetOrCreateNodeArg("shifted", &float_tensor_type);
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar_type);
+    auto& state_out = graph.GetOrCreateNodeArg("state_out", &float_tensor_type);
+
+    graph.AddNode("square", "Mul", "", {&outer_value, &outer_value}, {&squared});
+    graph.AddNode("shift", "Add", "", {&squared, &local_constant_arg}, {&shifted});
+    graph.AddNode("accumulate", "Add", "", {&state_in, &shifted}, {&state_out});
+    graph.AddNode("forward_cond", "Identity", "", {&cond_in}, {&cond_out});
+
+    graph.SetInputs({&iter_num, &cond_in, &state_in});
+    graph.SetOutputs({&cond_out, &state_out});
+    ASSERT_STATUS_OK(graph.Resolve());
+    graph_proto = graph.ToGraphProto();
+  };
+
+  Model model("LoopInvariantCodeMotion_main_graph", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  // the main graph computes outer_value * outer_value as well
+  auto& outer_value = graph.GetOrCreateNodeArg("outer_value", &float_tensor_type);
+  auto& main_squared = graph.GetOrCreateNodeArg("main_squared", &float_tensor_type);
+  auto& main_out = graph.GetOrCreateNodeArg("main_out", &float_tensor_type);
+  graph.AddNode("main_square", "Mul", "", {&outer_value, &outer_value}, {&main_squared});
+  graph.AddNode("main_identity", "Identity", "", {&main_squared}, {&main_out});
+
+  auto& max_trip_count = graph.GetOrCreateNodeArg("max_trip_count", &int64_scalar_type);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_scalar_type);
+  auto& state = graph.GetOrCreateNodeArg("state", &float_tensor_type);
+  auto& loop_out = graph.GetOrCreateNodeArg("loop_out", &float_tensor_type);
+  auto& loop_node = graph.AddNode("loop", "Loop", "", {&max_trip_count, &cond, &state}, {&loop_out});
+
+  GraphProto body;
+  create_body(body);
+  loop_node.AddAttribute("body", body);
+
+  graph.SetOutputs({&main_out, &loop_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopInvariantCodeMotion>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<CommonSubexpressionElimination>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  // both invariant nodes are moved, and the moved Mul is merged with the Mul of the main graph
+  auto op_to_count = CountOpsInGraph(graph, false);
+  ASSERT_EQ(op_to_count["Mul"], 1);
+  ASSERT_EQ(op_to_count["Add"], 1);
+
+  const Graph& body_graph = *graph.GetNode(loop_node.Index())->GetGraphAttribute("body");
+  op_to_count = CountOpsInGraph(body_graph);
+  ASSERT_EQ(op_to_count["Mul"], 0);
+  ASSERT_EQ(op_to_count["Add"], 1);
+  ASSERT_EQ(op_to_count["Identity"], 1);
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -1153,6 +1250,49 @@ TEST_F(GraphTransformationTests, FuseCudaConvAdd) {
   ASSERT_TRUE(op_to_count["Add"] == 1);  // Add remains, no transform applied to the graph
 }
 
+// Conv->Add->QuickGelu will be transformed to FusedConv, whose CUDA kernel applies the activation after adding the
+// bias and the Add input
+TEST_F(GraphTransformationTests, FuseCudaConvAddQuickGelu) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 4, 8, 8}, -1.f, 1.f);
+    auto* weights_arg = builder.MakeInitializer<float>({4, 4, 3, 3}, -1.f, 1.f);
+    auto* bias_arg = builder.MakeInitializer<float>({4}, -1.f, 1.f);
+    auto* residual_arg = builder.MakeInput<float>({1, 4, 8, 8}, -1.f, 1.f);
+    auto* conv_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddNode("Conv", {input_arg, weights_arg, bias_arg}, {conv_out})
+        .AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Add", {conv_out, residual_arg}, {add_out});
+    builder.AddNode("QuickGelu", {add_out}, {output_arg}, kMSDomain).AddAttribute("alpha", 1.f);
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCudaExecutionProvider);
+    }
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedConv"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.QuickGelu"] == 0);
+    for (auto& node : graph.Nodes()) {
+      TEST_RETURN_IF_NOT(node.InputDefs().size() == 4);
+      TEST_RETURN_IF_NOT(node.GetAttributes().at("activation").s() == "QuickGelu");
+      const auto& activation_params = node.GetAttributes().at("activation_params");
+      TEST_RETURN_IF_NOT(activation_params.floats_size() == 1 && activation_params.floats(0) == 1.f);
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::make_unique<ConvActivationFusion>(),
+                                        TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+}
+
 #endif
 
 #if !defined(DISABLE_CONTRIB_OPS)
@@ -4294,6 +4434,408 @@ TEST_F(GraphTransformationTests, QuickGelu) {
   }
 }
 
+TEST_F(GraphTransformationTests, ElementwiseChainFusion) {
+  // Add -> Relu -> Mul -> Sigmoid, with a same-shape operand and a single element operand given first
+  {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{2, 3, 4}});
+      auto* bias_arg = builder.MakeInitializer<float>({2, 3, 4}, -1.f, 1.f);
+      auto* scale_arg = builder.MakeInitializer<float>({1}, {0.5f});
+      auto* add_out = builder.MakeIntermediate();
+      auto* relu_out = builder.MakeIntermediate();
+      auto* mul_out = builder.MakeIntermediate();
+      auto* sigmoid_out = builder.MakeOutput();
+
+      builder.AddNode("Add", {input_arg, bias_arg}, {add_out});
+      builder.AddNode("Relu", {add_out}, {relu_out});
+      builder.AddNode("Mul", {scale_arg, relu_out}, {mul_out});
+      builder.AddNode("Sigmoid", {mul_out}, {sigmoid_out});
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count.size() == 1);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.ElementwiseChain"] == 1);
+      for (auto& node : graph.Nodes()) {
+        auto& attrs = node.GetAttributes();
+        TEST_RETURN_IF_NOT(node.InputDefs().size() == 3);
+        TEST_RETURN_IF_NOT(attrs.at("ops").strings_size() == 4);
+        TEST_RETURN_IF_NOT(attrs.at("ops").strings(2) == "Mul");
+        TEST_RETURN_IF_NOT(attrs.at("operand_first").ints(0) == 0);
+        TEST_RETURN_IF_NOT(attrs.at("operand_first").ints(2) == 1);
+      }
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<ElementwiseChainFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+
+  // an operand that broadcasts along the last dim ends the chain
+  {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{2, 3, 4}});
+      auto* bias_arg = builder.MakeInitializer<float>({4}, -1.f, 1.f);
+      auto* relu_out = builder.MakeIntermediate();
+      auto* tanh_out = builder.MakeIntermediate();
+      auto* add_out = builder.MakeOutput();
+
+      builder.AddNode("Relu", {input_arg}, {relu_out});
+      builder.AddNode("Tanh", {relu_out}, {tanh_out});
+      builder.AddNode("Add", {tanh_out, bias_arg}, {add_out});
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["com.microsoft.ElementwiseChain"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["Relu"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Tanh"] == 0);
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<ElementwiseChainFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+  }
+}
+
+TEST_F(GraphTransformationTests, GatherBlockQuantization) {
+  // the table of two Gathers along axis 0 is quantized once, a Gather along axis 1 and a small table are left as is
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({64, 40}, -1.f, 1.f);
+    auto* small_table_arg = builder.MakeInitializer<float>({4, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({3}, {0, 63, -1});
+    auto* other_indices_arg = builder.MakeInput<int32_t>({2, 2}, {1, 2, 3, 0});
+    auto* out_0 = builder.MakeOutput();
+    auto* out_1 = builder.MakeOutput();
+    auto* out_2 = builder.MakeOutput();
+    auto* out_3 = builder.MakeOutput();
+
+    builder.AddNode("Gather", {table_arg, indices_arg}, {out_0});
+    builder.AddNode("Gather", {table_arg, other_indices_arg}, {out_1});
+    builder.AddNode("Gather", {table_arg, other_indices_arg}, {out_2}).AddAttribute("axis", int64_t{1});
+    builder.AddNode("Gather", {small_table_arg, other_indices_arg}, {out_3});
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.GatherBlockQuantized"] == 2);
+    TEST_RETURN_IF_NOT(op_to_count["Gather"] == 2);
+
+    std::string quantized_table_name;
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() != "GatherBlockQuantized") {
+        continue;
+      }
+
+      auto& attrs = node.GetAttributes();
+      TEST_RETURN_IF_NOT(attrs.at("K").i() == 40);
+      TEST_RETURN_IF_NOT(attrs.at("bits").i() == 4);
+      TEST_RETURN_IF_NOT(attrs.at("block_size").i() == 16);
+      TEST_RETURN_IF_NOT(node.InputDefs().size() == 4);
+      TEST_RETURN_IF_NOT(quantized_table_name.empty() || quantized_table_name == node.InputDefs()[0]->Name());
+      quantized_table_name = node.InputDefs()[0]->Name();
+
+      // 64 rows of 3 blocks of 16 elements, the last one padded
+      const auto* data = graph_utils::GetConstantInitializer(graph, node.InputDefs()[0]->Name());
+      const auto* scales = graph_utils::GetConstantInitializer(graph, node.InputDefs()[2]->Name());
+      const auto* zero_points = graph_utils::GetConstantInitializer(graph, node.InputDefs()[3]->Name());
+      TEST_RETURN_IF_NOT(data != nullptr && scales != nullptr && zero_points != nullptr);
+      TEST_RETURN_IF_NOT(data->dims_size() == 3 && data->dims(0) == 64 && data->dims(1) == 3 && data->dims(2) == 8);
+      TEST_RETURN_IF_NOT(scales->dims(0) == 64 * 3);
+      TEST_RETURN_IF_NOT(zero_points->dims(0) == 64 * 3 / 2);
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<GatherBlockQuantization>(4, 16, 64);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, TensorParallelSharding) {
+  // weights whose element i * cols + j is i * 100 + j
+  auto make_weights = [](int64_t rows, int64_t cols) {
+    std::vector<float> data;
+    for (int64_t i = 0; i < rows; i++) {
+      for (int64_t j = 0; j < cols; j++) {
+        data.push_back(static_cast<float>(i * 100 + j));
+      }
+    }
+    return data;
+  };
+
+  // an MLP block and an Attention block, and a MatMul whose output isn't used by another MatMul
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 4, 8}, -1.f, 1.f);
+    auto* w1_arg = builder.MakeInitializer<float>({8, 16}, make_weights(8, 16));
+    auto* b1_arg = builder.MakeInitializer<float>({16}, make_weights(1, 16));
+    auto* w2_arg = builder.MakeInitializer<float>({16, 8}, make_weights(16, 8));
+    auto* qkv_weights_arg = builder.MakeInitializer<float>({8, 24}, make_weights(8, 24));
+    auto* qkv_bias_arg = builder.MakeInitializer<float>({24}, make_weights(1, 24));
+    auto* wo_arg = builder.MakeInitializer<float>({8, 8}, make_weights(8, 8));
+    auto* w3_arg = builder.MakeInitializer<float>({8, 8}, -1.f, 1.f);
+    auto* matmul1_out = builder.MakeIntermediate();
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* mlp_out = builder.MakeIntermediate();
+    auto* attention_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* other_output_arg = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input_arg, w1_arg}, {matmul1_out});
+    builder.AddNode("Add", {b1_arg, matmul1_out}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("MatMul", {relu_out, w2_arg}, {mlp_out});
+    builder.AddNode("Attention", {mlp_out, qkv_weights_arg, qkv_bias_arg}, {attention_out}, kMSDomain)
+        .AddAttribute("num_heads", int64_t{4});
+    builder.AddNode("MatMul", {attention_out, wo_arg}, {output_arg});
+    builder.AddNode("MatMul", {input_arg, w3_arg}, {other_output_arg});
+  };
+
+  auto get_initializer = [](Graph& graph, const Node& node, int index) {
+    return Initializer{*graph_utils::GetConstantInitializer(graph, node.InputDefs()[index]->Name()),
+                       graph.ModelPath()};
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.AllReduce"] == 2);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 4);
+
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "Add") {
+        // columns 8 to 15 of rank 1
+        auto b1 = get_initializer(graph, node, 0);
+        TEST_RETURN_IF_NOT(b1.dims().size() == 1 && b1.dims()[0] == 8);
+        TEST_RETURN_IF_NOT(b1.data<float>()[0] == 8.f);
+      } else if (node.OpType() == "Attention") {
+        // heads 2 and 3 of Q, K and V
+        TEST_RETURN_IF_NOT(node.GetAttributes().at("num_heads").i() == 2);
+        auto qkv_weights = get_initializer(graph, node, 1);
+        TEST_RETURN_IF_NOT(qkv_weights.dims()[0] == 8 && qkv_weights.dims()[1] == 12);
+        const float* data = qkv_weights.data<float>();
+        TEST_RETURN_IF_NOT(data[0] == 4.f && data[4] == 12.f && data[8] == 20.f && data[12] == 104.f);
+        auto qkv_bias = get_initializer(graph, node, 2);
+        TEST_RETURN_IF_NOT(qkv_bias.dims()[0] == 12 && qkv_bias.data<float>()[11] == 23.f);
+      } else if (node.OpType() == "MatMul") {
+        auto weights = get_initializer(graph, node, 1);
+        const int64_t rows = weights.dims()[0];
+        const int64_t cols = weights.dims()[1];
+        const float first = weights.data<float>()[0];
+        if (graph.NodeProducesGraphOutput(node)) {
+          TEST_RETURN_IF_NOT(rows == 8 && cols == 8);
+        } else if (node.GetOutputEdgesCount() == 1 && node.OutputNodesBegin()->OpType() == "AllReduce") {
+          // rows 8 to 15 of W2, or rows 4 to 7 of the output weights of Attention
+          TEST_RETURN_IF_NOT((rows == 8 && cols == 8 && first == 800.f) || (rows == 4 && cols == 8 && first == 400.f));
+        } else {
+          TEST_RETURN_IF_NOT(rows == 8 && cols == 8 && first == 8.f);
+        }
+      }
+    }
+    return Status::OK();
+  };
+
+  std::unique_ptr<GraphTransformer> transformer = std::make_unique<TensorParallelSharding>(1, 2);
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, ZipMapColumnar) {
+  Model model("ZipMapColumnar", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 14}, {kMLDomain, 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto probabilities_type;
+  probabilities_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  probabilities_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  probabilities_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto make_map_type = [](TensorProto_DataType key_type) {
+    TypeProto map_type;
+    auto* map = map_type.mutable_sequence_type()->mutable_elem_type()->mutable_map_type();
+    map->set_key_type(key_type);
+    map->mutable_value_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    return map_type;
+  };
+  TypeProto string_map_type = make_map_type(TensorProto_DataType_STRING);
+  TypeProto int64_map_type = make_map_type(TensorProto_DataType_INT64);
+
+  // the ZipMap of a graph output is replaced, the one feeding another node is left as is
+  auto& input = graph.GetOrCreateNodeArg("input", &probabilities_type);
+  auto& string_output = graph.GetOrCreateNodeArg("string_output", &string_map_type);
+  auto& int64_output = graph.GetOrCreateNodeArg("int64_output", &int64_map_type);
+  auto& inner_map = graph.GetOrCreateNodeArg("inner_map", &string_map_type);
+  auto& inner_output = graph.GetOrCreateNodeArg("inner_output", &string_map_type);
+
+  graph.AddNode("zipmap_strings", "ZipMap", "", {&input}, {&string_output}, nullptr, kMLDomain)
+      .AddAttribute("classlabels_strings", std::vector<std::string>{"a", "b", "c"});
+  graph.AddNode("zipmap_int64s", "ZipMap", "", {&input}, {&int64_output}, nullptr, kMLDomain)
+      .AddAttribute("classlabels_int64s", std::vector<int64_t>{7, 8, 9});
+  graph.AddNode("zipmap_inner", "ZipMap", "", {&input}, {&inner_map}, nullptr, kMLDomain)
+      .AddAttribute("classlabels_strings", std::vector<std::string>{"a", "b", "c"});
+  graph.AddNode("identity", "Identity", "", {&inner_map}, {&inner_output});
+  graph.SetOutputs({&string_output, &int64_output, &inner_output});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<ZipMapColumnar>(), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.ZipMap"], 1);
+  ASSERT_EQ(op_to_count["Identity"], 3);
+
+  const auto& outputs = graph.GetOutputs();
+  ASSERT_EQ(outputs.size(), 5u);
+  ASSERT_EQ(outputs[0]->Name(), "string_output");
+  ASSERT_EQ(outputs[1]->Name(), "int64_output");
+  ASSERT_EQ(outputs[2]->Name(), "inner_output");
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT_TRUE(utils::HasTensorType(*outputs[i]->TypeAsProto()));
+    ASSERT_EQ(outputs[i]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT);
+    ASSERT_EQ(outputs[i]->Shape()->dim(1).dim_value(), 3);
+  }
+
+  ASSERT_EQ(outputs[3]->Name(), "string_output_labels");
+  const auto* string_labels = graph_utils::GetConstantInitializer(graph, outputs[3]->Name());
+  ASSERT_NE(string_labels, nullptr);
+  ASSERT_EQ(string_labels->data_type(), TensorProto_DataType_STRING);
+  ASSERT_EQ(std::vector<std::string>(string_labels->string_data().begin(), string_labels->string_data().end()),
+            (std::vector<std::string>{"a", "b", "c"}));
+
+  ASSERT_EQ(outputs[4]->Name(), "int64_output_labels");
+  const auto* int64_labels = graph_utils::GetConstantInitializer(graph, outputs[4]->Name());
+  ASSERT_NE(int64_labels, nullptr);
+  ASSERT_EQ(int64_labels->data_type(), TensorProto_DataType_INT64);
+  ASSERT_EQ(std::vector<int64_t>(int64_labels->int64_data().begin(), int64_labels->int64_data().end()),
+            (std::vector<int64_t>{7, 8, 9}));
+}
+
+TEST_F(GraphTransformationTests, MLPreprocessingFusion) {
+  Model model("MLPreprocessingFusion", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 14}, {kMLDomain, 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto features_type;
+  features_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  features_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  features_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  // Imputer -> Scaler -> Normalizer is fused, the Scaler feeding the LinearRegressor is folded into it
+  auto& input = graph.GetOrCreateNodeArg("input", &features_type);
+  auto& imputed = graph.GetOrCreateNodeArg("imputed", nullptr);
+  auto& scaled = graph.GetOrCreateNodeArg("scaled", nullptr);
+  auto& normalized = graph.GetOrCreateNodeArg("normalized", nullptr);
+  auto& regressor_input = graph.GetOrCreateNodeArg("regressor_input", nullptr);
+  auto& prediction = graph.GetOrCreateNodeArg("prediction", nullptr);
+
+  Node& imputer = graph.AddNode("imputer", "Imputer", "", {&input}, {&imputed}, nullptr, kMLDomain);
+  imputer.AddAttribute("imputed_value_floats", std::vector<float>{1.f, 2.f, 3.f});
+  imputer.AddAttribute("replaced_value_float", 0.f);
+  Node& scaler = graph.AddNode("scaler", "Scaler", "", {&imputed}, {&scaled}, nullptr, kMLDomain);
+  scaler.AddAttribute("offset", std::vector<float>{0.5f});
+  scaler.AddAttribute("scale", std::vector<float>{4.f});
+  graph.AddNode("normalizer", "Normalizer", "", {&scaled}, {&normalized}, nullptr, kMLDomain)
+      .AddAttribute("norm", std::string("L1"));
+
+  Node& regressor_scaler = graph.AddNode("regressor_scaler", "Scaler", "", {&input}, {&regressor_input}, nullptr,
+                                         kMLDomain);
+  regressor_scaler.AddAttribute("offset", std::vector<float>{1.f, 2.f, 3.f});
+  regressor_scaler.AddAttribute("scale", std::vector<float>{2.f, 0.5f, 1.f});
+  Node& regressor = graph.AddNode("regressor", "LinearRegressor", "", {&regressor_input}, {&prediction}, nullptr,
+                                  kMLDomain);
+  regressor.AddAttribute("coefficients", std::vector<float>{1.f, 2.f, 3.f});
+  regressor.AddAttribute("intercepts", std::vector<float>{0.5f});
+  regressor.AddAttribute("targets", int64_t{1});
+
+  graph.SetOutputs({&normalized, &prediction});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<MLPreprocessingFusion>(),
+                                                     TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  auto op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Imputer"], 0);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Scaler"], 0);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Normalizer"], 0);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.LinearRegressor"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.MLPreprocessing"], 1);
+
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "MLPreprocessing") {
+      ASSERT_EQ(node.InputDefs()[0]->Name(), "input");
+      ASSERT_EQ(node.OutputDefs()[0]->Name(), "normalized");
+      const auto& attrs = node.GetAttributes();
+      ASSERT_EQ(std::vector<std::string>(attrs.at("stages").strings().begin(), attrs.at("stages").strings().end()),
+                (std::vector<std::string>{"Imputer", "Scaler", "Normalizer"}));
+      ASSERT_EQ(std::vector<int64_t>(attrs.at("value_counts").ints().begin(), attrs.at("value_counts").ints().end()),
+                (std::vector<int64_t>{4, 2, 0}));
+      ASSERT_EQ(std::vector<float>(attrs.at("values").floats().begin(), attrs.at("values").floats().end()),
+                (std::vector<float>{0.f, 1.f, 2.f, 3.f, 0.5f, 4.f}));
+      ASSERT_EQ(attrs.at("norms").strings(0), "L1");
+    } else {
+      ASSERT_EQ(node.OpType(), "LinearRegressor");
+      ASSERT_EQ(node.InputDefs()[0]->Name(), "input");
+      const auto& attrs = node.GetAttributes();
+      ASSERT_EQ(std::vector<float>(attrs.at("coefficients").floats().begin(), attrs.at("coefficients").floats().end()),
+                (std::vector<float>{2.f, 1.f, 3.f}));
+      // 0.5 - (1 * 1 * 2 + 2 * 2 * 0.5 + 3 * 3 * 1)
+      ASSERT_EQ(attrs.at("intercepts").floats(0), -12.5f);
+    }
+  }
+}
+
+TEST_F(GraphTransformationTests, ShapeExpressionFusion) {
+  // Reshape(x, Concat(Unsqueeze(Gather(Shape(x), 0) * 4), [8])) of x with shape [N, 4, 8]
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input = builder.MakeSymbolicInput<float>({std::string("N"), int64_t{4}, int64_t{8}});
+    auto* shape = builder.MakeIntermediate();
+    auto* dim = builder.MakeIntermediate();
+    auto* scaled_dim = builder.MakeIntermediate();
+    auto* unsqueezed = builder.MakeIntermediate();
+    auto* new_shape = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Shape", {input}, {shape});
+    builder.AddNode("Gather", {shape, builder.MakeScalarInitializer<int64_t>(0)}, {dim});
+    builder.AddNode("Mul", {dim, builder.MakeScalarInitializer<int64_t>(4)}, {scaled_dim});
+    builder.AddNode("Unsqueeze", {scaled_dim, builder.MakeInitializer<int64_t>({1}, {0})}, {unsqueezed});
+    builder.AddNode("Concat", {unsqueezed, builder.MakeInitializer<int64_t>({1}, {8})}, {new_shape})
+        .AddAttribute("axis", int64_t{0});
+    builder.AddNode("Reshape", {input, new_shape}, {output});
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["Shape"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Gather"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Mul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Unsqueeze"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Concat"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Reshape"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.ShapeExpression"] == 1);
+
+    for (const Node& node : graph.Nodes()) {
+      if (node.OpType() == "ShapeExpression") {
+        const auto& program = node.GetAttributes().at("program").ints();
+        // Dim(0, 0) * 4, then 8
+        TEST_RETURN_IF_NOT((std::vector<int64_t>(program.begin(), program.end()) ==
+                            std::vector<int64_t>{1, 0, 0, 0, 4, 4, 6, 0, 8, 6}));
+        TEST_RETURN_IF_NOT(node.InputDefs().size() == 1);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<ShapeExpressionFusion>(),
+                                        TransformerLevel::Level2, 1, nullptr, post_graph_checker));
+}
+
 struct BiasSoftmaxFusionTester {
   std::shared_ptr<Model> p_model_;
   Status model_load_;
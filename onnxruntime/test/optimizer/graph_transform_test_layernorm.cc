@@ -429,6 +429,55 @@ TEST_F(GraphTransformationTests, SimplifiedLayerNormFusionTest) {
   }
 }
 
+// RMSNorm as x * rsqrt(mean(x^2) + epsilon) * scale, with rsqrt exported as Reciprocal(Sqrt) or Div(1, Sqrt).
+TEST_F(GraphTransformationTests, SimplifiedLayerNormFusionWithReciprocalTest) {
+  auto test_case = [&](bool use_reciprocal) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* data_arg = builder.MakeInput<float>({2, 4, 8});
+      auto* pow_initializer = builder.MakeInitializer<float>({}, {2.0f});
+      auto* add_initializer = builder.MakeInitializer<float>({}, {1e-6f});
+      auto* weight_initializer = builder.MakeInitializer<float>({8}, std::vector<float>(8, 0.5f));
+      auto* pow_out = builder.MakeIntermediate();
+      auto* reduce_mean_out = builder.MakeIntermediate();
+      auto* add_out = builder.MakeIntermediate();
+      auto* sqrt_out = builder.MakeIntermediate();
+      auto* reciprocal_out = builder.MakeIntermediate();
+      auto* normalize_out = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Pow", {data_arg, pow_initializer}, {pow_out});
+      builder.AddNode("ReduceMean", {pow_out}, {reduce_mean_out}).AddAttribute("axes", std::vector<int64_t>{-1});
+      builder.AddNode("Add", {reduce_mean_out, add_initializer}, {add_out});
+      builder.AddNode("Sqrt", {add_out}, {sqrt_out});
+      if (use_reciprocal) {
+        builder.AddNode("Reciprocal", {sqrt_out}, {reciprocal_out});
+      } else {
+        builder.AddNode("Div", {builder.MakeInitializer<float>({}, {1.0f}), sqrt_out}, {reciprocal_out});
+      }
+      builder.AddNode("Mul", {data_arg, reciprocal_out}, {normalize_out});
+      builder.AddNode("Mul", {weight_initializer, normalize_out}, {output_arg});
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["SimplifiedLayerNormalization"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["Pow"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Sqrt"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Reciprocal"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Div"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Mul"] == 0);
+      return Status::OK();
+    };
+
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                          std::make_unique<SimplifiedLayerNormFusion>(), TransformerLevel::Level2, 1,
+                                          nullptr, post_graph_checker));
+  };
+
+  test_case(true);
+  test_case(false);
+}
+
 // If EP is non-GPU EP or unknown, the sub-graph will be not fused because CPU impl for SimplifiedLayerNormalization
 // doesn't support input and scale having different data types.
 TEST_F(GraphTransformationTests, SimplifiedLayerNormWithCastsFusionTest) {
@@ -6,6 +6,7 @@
 #include "core/mlas/inc/mlas.h"
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/compare_ortvalue.h"
 #include "test/test_environment.h"
 #include "test/framework/test_utils.h"
@@ -167,7 +168,7 @@ struct NchwcTestHelper {
 
 void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& build_test_case,
                           const std::function<void(InferenceSessionWrapper& session)>& check_nchwc_graph,
-                          int opset_version = 13) {
+                          int opset_version = 13, bool enable_cost_model = false) {
   // Ignore the test if NCHWc is not supported by the platform.
   if (MlasNchwcGetBlockSize() <= 1) {
     return;
@@ -190,6 +191,9 @@ void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& bu
     SessionOptions session_options;
     session_options.graph_optimization_level = level;
     session_options.session_logid = "NchwcOptimizerTests";
+    if (enable_cost_model) {
+      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableNchwcCostModel, "1"));
+    }
     InferenceSessionWrapper session{session_options, GetEnvironment()};
     ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
     ASSERT_STATUS_OK(session.Initialize());
@@ -303,6 +307,33 @@ TEST(NchwcOptimizerTests, ConvNchwc) {
   }
 }
 
+TEST(NchwcOptimizerTests, ConvCostModel) {
+  // an isolated pointwise convolution saves less than the reorders of its input and output cost, a 3x3 one doesn't
+  auto test_case = [&](int64_t kernel_size, bool expect_nchwc) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
+      auto* output_arg = helper.MakeOutput();
+
+      auto& conv_node = helper.AddConvNode(input_arg, output_arg, {32, 32, kernel_size, kernel_size});
+      const int64_t pad = kernel_size / 2;
+      conv_node.AddAttribute("pads", std::vector<int64_t>{pad, pad, pad, pad});
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], expect_nchwc ? 1 : 0);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], expect_nchwc ? 1 : 0);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], expect_nchwc ? 1 : 0);
+      EXPECT_EQ(op_to_count["Conv"], expect_nchwc ? 0 : 1);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph, 13, true);
+  };
+
+  test_case(1, false);
+  test_case(3, true);
+}
+
 TEST(NchwcOptimizerTests, ConvNchwcGrouped) {
   auto test_case = [&](const std::string& activation_op_type) {
     auto build_test_case = [&](NchwcTestHelper& helper) {
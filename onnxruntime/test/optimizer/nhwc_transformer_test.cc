@@ -675,6 +675,36 @@ TEST(NhwcTransformerTests, ConvAveragePoolFp16) {
                     TransformerLevel::Level3);
 }
 
+TEST(NhwcTransformerTests, ConvInstanceNormFp16) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<MLFloat16>({2, 23, 13, 13}, MLFloat16(-1.5f), MLFloat16(1.5f));
+    auto* conv1_output_arg = builder.MakeIntermediate();
+    auto* norm_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    auto* conv1_weight_arg = builder.MakeInitializer<MLFloat16>({30, 23, 3, 3}, MLFloat16(-1.5f), MLFloat16(1.5f));
+    auto* conv2_weight_arg = builder.MakeInitializer<MLFloat16>({16, 30, 3, 3}, MLFloat16(-1.5f), MLFloat16(1.5f));
+    auto* scale_arg = builder.MakeInitializer<MLFloat16>({30}, MLFloat16(0.5f), MLFloat16(1.5f));
+    auto* bias_arg = builder.MakeInitializer<MLFloat16>({30}, MLFloat16(-0.5f), MLFloat16(0.5f));
+
+    Node& conv1_node = builder.AddConvNode(input_arg, conv1_weight_arg, conv1_output_arg);
+    conv1_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("InstanceNormalization", {conv1_output_arg, scale_arg, bias_arg}, {norm_output_arg});
+    builder.AddConvNode(norm_output_arg, conv2_weight_arg, output_arg);
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcFusedConv"], 2);
+    EXPECT_EQ(op_to_count["com.ms.internal.nhwc.InstanceNormalization"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3);
+}
+
 #endif  // MLAS_F16VEC_INTRINSICS_SUPPORTED
 
 #endif  // DISABLE_CONTRIB_OPS
@@ -1453,12 +1453,13 @@ TEST(QDQTransformerTests, ConvRelu) {
         EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
         EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
       } else {
-        EXPECT_EQ(op_to_count["QLinearConv"], 0);
+        // the Relu is fused into the requantization of the QLinearConv
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearConv"], 1);
         EXPECT_EQ(op_to_count["Conv"], 0);
         EXPECT_EQ(op_to_count["Relu"], 0);
-        EXPECT_EQ(op_to_count["com.microsoft.FusedConv"], 1);
-        EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
-        EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+        EXPECT_EQ(op_to_count["com.microsoft.FusedConv"], 0);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
       }
     };
 
@@ -1473,6 +1474,60 @@ TEST(QDQTransformerTests, ConvRelu) {
   test_case({1, 22, 11, 13, 15}, {30, 22, 5, 3, 3}, false);
 }
 
+TEST(QDQTransformerTests, ConvAddRelu) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       bool has_relu) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      auto* weight = builder.MakeInitializer<uint8_t>(weights_shape, 0, 255);
+
+      // add QDQ + Conv
+      auto* dq_w_output = builder.MakeIntermediate();
+      auto* conv_output = builder.MakeIntermediate();
+      auto* dq_conv_output = AddQDQNodePair<uint8_t>(builder, input_arg, .004f, 129);
+      builder.AddDequantizeLinearNode<uint8_t>(weight, .003f, 118, dq_w_output);
+      Node& conv_node = builder.AddConvNode(dq_conv_output, dq_w_output, conv_output);
+      const int64_t pad = weights_shape[2] / 2;
+      conv_node.AddAttribute("pads", std::vector<int64_t>{pad, pad, pad, pad});
+
+      // add QDQ + Add of the residual input, which has the shape of the Conv output
+      auto* residual_arg = builder.MakeInput<float>({input_shape[0], weights_shape[0], input_shape[2], input_shape[3]},
+                                                    -1.f, 1.f);
+      auto* dq_residual_output = AddQDQNodePair<uint8_t>(builder, residual_arg, .005f, 127);
+      auto* dq_sum_output = AddQDQNodePair<uint8_t>(builder, conv_output, .006f, 125);
+      auto* add_output = builder.MakeIntermediate();
+      builder.AddNode("Add", {dq_sum_output, dq_residual_output}, {add_output});
+
+      if (has_relu) {
+        auto* relu_output = builder.MakeIntermediate();
+        builder.AddNode("Relu", {add_output}, {relu_output});
+        add_output = relu_output;
+      }
+
+      // add Q
+      builder.AddQuantizeLinearNode<uint8_t>(add_output, .0071f, 3, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearConv"], 1);
+      EXPECT_EQ(op_to_count["QLinearConv"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearAdd"], 0);
+      EXPECT_EQ(op_to_count["Add"], 0);
+      EXPECT_EQ(op_to_count["Relu"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2);
+  };
+
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3}, false);
+  test_case({1, 23, 13, 13}, {30, 23, 3, 3}, true);
+  test_case({2, 8, 9, 7}, {16, 8, 1, 1}, true);
+}
+
 TEST(QDQTransformerTests, ConvAveragePoolReshape_UInt8) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape) {
     auto build_test_case = [&](ModelTestBuilder& builder) {
@@ -1847,6 +1902,138 @@ TEST(QDQTransformerTests, Sigmoid_U8S8) {
   QDQTransformerSigmoidTests<uint8_t, int8_t>();
 }
 
+template <typename InputType, typename OutputType>
+void QDQTransformerGeluTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -3.f, 3.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + Gelu
+      auto* dq_output = AddQDQNodePair<InputType>(builder, input_arg, .025f, 7);
+      auto* gelu_output = builder.MakeIntermediate();
+      builder.AddNode("Gelu", {dq_output}, {gelu_output}, kMSDomain);
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<OutputType>(gelu_output,
+                                                .0125f,
+                                                std::numeric_limits<OutputType>::max() / 2,
+                                                q_output);
+      builder.AddDequantizeLinearNode<OutputType>(q_output,
+                                                  .0125f,
+                                                  std::numeric_limits<OutputType>::max() / 2,
+                                                  output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      if constexpr (std::is_same<InputType, OutputType>::value) {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 1);
+        EXPECT_EQ(op_to_count["com.microsoft.Gelu"], 0);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 0);
+        EXPECT_EQ(op_to_count["com.microsoft.Gelu"], 1);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+      }
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 12, 37});
+  test_case({1, 23, 13, 13});
+}
+
+TEST(QDQTransformerTests, Gelu_S8S8) {
+  QDQTransformerGeluTests<int8_t, int8_t>();
+}
+
+TEST(QDQTransformerTests, Gelu_U8U8) {
+  QDQTransformerGeluTests<uint8_t, uint8_t>();
+}
+
+TEST(QDQTransformerTests, Gelu_U8S8) {
+  QDQTransformerGeluTests<uint8_t, int8_t>();
+}
+
+template <typename InputType, typename WeightType>
+void QDQTransformerAttentionTests(bool per_column_weights) {
+  constexpr int64_t batch_size = 2;
+  constexpr int64_t sequence_length = 4;
+  constexpr int64_t hidden_size = 8;
+  constexpr int64_t num_heads = 2;
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({batch_size, sequence_length, hidden_size}, -1.f, 1.f);
+    auto* output_arg = builder.MakeOutput();
+
+    auto* dq_input = AddQDQNodePair<InputType>(builder, input_arg, .008f, std::numeric_limits<InputType>::max() / 2);
+
+    auto* weights = builder.MakeInitializer<WeightType>({hidden_size, 3 * hidden_size},
+                                                        std::numeric_limits<WeightType>::min() / 2,
+                                                        std::numeric_limits<WeightType>::max() / 2);
+    auto* dq_weights = builder.MakeIntermediate();
+    if (per_column_weights) {
+      auto* weight_scales = builder.MakeInitializer<float>({3 * hidden_size}, .005f, .01f);
+      auto* weight_zero_points = builder.MakeInitializer<WeightType>({3 * hidden_size},
+                                                                     std::vector<WeightType>(3 * hidden_size, 0));
+      builder.AddNode("DequantizeLinear", {weights, weight_scales, weight_zero_points}, {dq_weights});
+    } else {
+      builder.AddDequantizeLinearNode<WeightType>(weights, .008f, 0, dq_weights);
+    }
+
+    auto* bias = builder.MakeInitializer<float>({3 * hidden_size}, -.1f, .1f);
+    Node& attention_node = builder.AddNode("Attention", {dq_input, dq_weights, bias}, {output_arg}, kMSDomain);
+    attention_node.AddAttribute("num_heads", num_heads);
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    if constexpr (std::is_same<InputType, uint8_t>::value) {
+      EXPECT_EQ(op_to_count["com.microsoft.QAttention"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.Attention"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+    } else {
+      // the CPU QAttention kernel only takes a uint8 input
+      EXPECT_EQ(op_to_count["com.microsoft.QAttention"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.Attention"], 1);
+    }
+  };
+
+  TransformerTester(build_test_case,
+                    check_graph,
+                    TransformerLevel::Level1,
+                    TransformerLevel::Level2,
+                    12 /*opset_version*/,
+                    0.01 /*per_sample_tolerance*/,
+                    0.01 /*relative_per_sample_tolerance*/,
+                    std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+}
+
+TEST(QDQTransformerTests, Attention_U8U8) {
+  QDQTransformerAttentionTests<uint8_t, uint8_t>(false);
+}
+
+TEST(QDQTransformerTests, Attention_U8S8) {
+  QDQTransformerAttentionTests<uint8_t, int8_t>(false);
+  QDQTransformerAttentionTests<uint8_t, int8_t>(true);
+}
+
+TEST(QDQTransformerTests, Attention_S8S8) {
+  QDQTransformerAttentionTests<int8_t, int8_t>(false);
+}
+
 TEST(QDQTransformerTests, ConvTranspose_QBackward) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape, const std::vector<int64_t>& perms) {
     auto build_test_case = [&](ModelTestBuilder& builder) {
@@ -6,6 +6,7 @@
 #include "gtest/gtest.h"
 
 #include "asserts.h"
+#include "core/graph/graph_utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
 #include "core/optimizer/graph_transformer.h"
@@ -20,6 +21,53 @@ using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+namespace {
+
+// Removes an Identity node only when its consumer isn't an Identity node, so a chain of them is removed from the
+// last one back, against the top-down order of the traversal.
+class RemoveLastIdentity : public RewriteRule {
+ public:
+  RemoveLastIdentity() noexcept : RewriteRule("RemoveLastIdentity") {}
+
+  std::vector<std::string> TargetOpTypes() const noexcept override {
+    return {"Identity"};
+  }
+
+ private:
+  bool SatisfyCondition(const Graph& graph, const Node& node, const logging::Logger& logger) const override {
+    return node.GetOutputEdgesCount() == 1 && node.OutputNodesBegin()->OpType() != "Identity" &&
+           graph_utils::CanRemoveNode(graph, node, logger);
+  }
+
+  Status Apply(Graph& graph, Node& node, RewriteRuleEffect& rule_effect,
+               const logging::Logger& /*logger*/) const override {
+    if (graph_utils::RemoveNode(graph, node)) {
+      rule_effect = RewriteRuleEffect::kRemovedCurrentNode;
+    }
+    return Status::OK();
+  }
+};
+
+// Reports that it modified the graph on its first num_modifications invocations.
+class CountingGraphTransformer : public GraphTransformer {
+ public:
+  CountingGraphTransformer(const std::string& name, int num_modifications) noexcept
+      : GraphTransformer(name), num_modifications_(num_modifications) {}
+
+  int NumInvocations() const { return num_invocations_; }
+
+ private:
+  const int num_modifications_;
+  mutable int num_invocations_ = 0;
+
+  Status ApplyImpl(Graph& /*graph*/, bool& modified, int /*graph_level*/, const logging::Logger&) const override {
+    modified = num_invocations_++ < num_modifications_;
+    return Status::OK();
+  }
+};
+
+}  // namespace
+
 TEST(RuleBasedGraphTransformerTest, TestCompatibleProviders) {
   auto model_uri = ORT_TSTR("testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx");
 
@@ -71,5 +119,57 @@ TEST(RuleBasedGraphTransformerTest, TestSettingStepsInGraphTransformerManager) {
   ASSERT_STATUS_OK(graph_transformation_mgr.GetSteps(steps_queried));
   ASSERT_EQ(steps_queried, static_cast<unsigned>(10));
 }
+
+TEST(RuleBasedGraphTransformerTest, RevisitsNodesAroundRewrites) {
+  // X -> Relu -> Identity -> Identity -> Identity -> Relu -> Y
+  Model model("RevisitsNodesAroundRewrites", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  std::vector<NodeArg*> args;
+  for (int i = 0; i < 6; ++i) {
+    args.push_back(&graph.GetOrCreateNodeArg("t" + std::to_string(i), &float_tensor));
+  }
+  graph.AddNode("relu0", "Relu", "", {args[0]}, {args[1]});
+  for (int i = 1; i < 4; ++i) {
+    graph.AddNode("identity" + std::to_string(i), "Identity", "", {args[i]}, {args[i + 1]});
+  }
+  graph.AddNode("relu1", "Relu", "", {args[4]}, {args[5]});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  RuleBasedGraphTransformer transformer("IncrementalTransformer");
+  ASSERT_STATUS_OK(transformer.Register(std::make_unique<RemoveLastIdentity>()));
+
+  // the top-down traversal only removes the last Identity node, the others are removed when their consumer is
+  // revisited after the rewrite, within the same application of the transformer
+  bool modified = false;
+  ASSERT_STATUS_OK(transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()));
+  ASSERT_TRUE(modified);
+  ASSERT_EQ(CountOpsInGraph(graph)["Identity"], 0);
+  ASSERT_EQ(CountOpsInGraph(graph)["Relu"], 2);
+}
+
+TEST(RuleBasedGraphTransformerTest, SkipsTransformersOnUnchangedGraph) {
+  Model model("SkipsTransformersOnUnchangedGraph", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+
+  auto modifying_transformer = std::make_unique<CountingGraphTransformer>("ModifyingTransformer", 2);
+  const auto* modifying_transformer_ptr = modifying_transformer.get();
+  auto no_op_transformer = std::make_unique<CountingGraphTransformer>("NoOpTransformer", 0);
+  const auto* no_op_transformer_ptr = no_op_transformer.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(modifying_transformer), TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(no_op_transformer), TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                              DefaultLoggingManager().DefaultLogger()));
+
+  // the modifying transformer runs until it stops modifying the graph, the no-op transformer is skipped in the
+  // last step, as the graph hasn't changed since its previous invocation
+  ASSERT_EQ(modifying_transformer_ptr->NumInvocations(), 3);
+  ASSERT_EQ(no_op_transformer_ptr->NumInvocations(), 2);
+}
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
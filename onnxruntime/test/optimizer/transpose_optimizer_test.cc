@@ -4365,6 +4365,181 @@ TEST(TransposeOptimizerTests, TestOmitIdentityTranspose) {
 //      transpose optimizer multiple times to ensure it completes in level 1.
 // either of those changes would have fixed the issue.
 // see https://github.com/microsoft/onnxruntime/issues/9671 for more details.
+TEST(TransposeOptimizerTests, TestGatherScalarIndices) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{2, 4, 6, 5}}, {2, 4, 6, 5}, 0.0, 1.0);
+    auto* const_1 = builder.MakeInitializer<int64_t>({}, {2});
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* gather_1_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    auto& gather_1 = builder.AddNode("Gather", {transpose_1_out_0, const_1}, {gather_1_out_0});
+    gather_1.AddAttribute("axis", (int64_t)1);
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    // Gathering the channel moved to axis 1 is gathering the last axis of the input. The remaining axes keep their
+    // order, so no Transpose is left.
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 0);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {15, 18});
+}
+
+TEST(TransposeOptimizerTests, TestGather1DIndices) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{2, 4, 6, 5}}, {2, 4, 6, 5}, 0.0, 1.0);
+    auto* const_1 = builder.MakeInitializer<int64_t>({2}, {0, 3});
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* gather_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    auto& gather_1 = builder.AddNode("Gather", {transpose_1_out_0, const_1}, {gather_1_out_0});
+    gather_1.AddAttribute("axis", (int64_t)2);
+    auto& transpose_2 = builder.AddNode("Transpose", {gather_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 0);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {15, 18});
+}
+
+TEST(TransposeOptimizerTests, TestLayerNormalization) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{2, 4, 6, 8}}, {2, 4, 6, 8}, 0.0, 1.0);
+    auto* scale = builder.MakeInitializer<float>({8}, 0.5, 1.5);
+    auto* bias = builder.MakeInitializer<float>({8}, -1.0, 1.0);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* layer_norm_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+    auto& layer_norm_1 = builder.AddNode("LayerNormalization", {transpose_1_out_0, scale, bias},
+                                         {layer_norm_1_out_0});
+    layer_norm_1.AddAttribute("axis", (int64_t)-1);
+    auto& transpose_2 = builder.AddNode("Transpose", {layer_norm_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 0);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {18});
+}
+
+TEST(TransposeOptimizerTests, TestLayerNormalizationMovesNormalizedAxis) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{2, 8, 4, 6}}, {2, 8, 4, 6}, 0.0, 1.0);
+    auto* scale = builder.MakeInitializer<float>({8}, 0.5, 1.5);
+    auto* bias = builder.MakeInitializer<float>({8}, -1.0, 1.0);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* layer_norm_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 2, 3, 1});
+    auto& layer_norm_1 = builder.AddNode("LayerNormalization", {transpose_1_out_0, scale, bias},
+                                         {layer_norm_1_out_0});
+    layer_norm_1.AddAttribute("axis", (int64_t)-1);
+    auto& transpose_2 = builder.AddNode("Transpose", {layer_norm_1_out_0}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    // The normalized channel axis is not last without the Transpose, so both Transposes remain.
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 8);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {18});
+}
+
+TEST(TransposeOptimizerTests, TestEinsum) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = MakeInput<float>(builder, {{3, 4}}, {3, 4}, 0.0, 1.0);
+    auto* input1_arg = MakeInput<float>(builder, {{3, 5}}, {3, 5}, 0.0, 1.0);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* einsum_1_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    auto& einsum_1 = builder.AddNode("Einsum", {transpose_1_out_0, input1_arg}, {einsum_1_out_0});
+    einsum_1.AddAttribute("equation", "ij, jk -> ik");
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 0);
+    for (const auto& node : session.GetGraph().Nodes()) {
+      if (node.OpType() == "Einsum") {
+        EXPECT_EQ(node.GetAttributes().at("equation").s(), "ji,jk->ik");
+      }
+    }
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {15, 18});
+}
+
+TEST(TransposeOptimizerTests, TestDontPushIntoLargerTensor) {
+  auto build_test_case_1 = [&](ModelTestBuilder& builder) {
+    auto* input0_arg = builder.MakeInput<float>({2, 2, 1, 2}, 0.0, 1.0);
+    auto* input1_arg = builder.MakeInput<float>({2, 2, 1, 2}, 0.0, 1.0);
+    auto* input2_arg = builder.MakeInput<float>({1, 1, 1, 64}, 0.0, 1.0);
+    auto* transpose_1_out_0 = builder.MakeIntermediate();
+    auto* transpose_2_out_0 = builder.MakeIntermediate();
+    auto* sum_1_out_0 = builder.MakeOutput();
+
+    auto& transpose_1 = builder.AddNode("Transpose", {input0_arg}, {transpose_1_out_0});
+    transpose_1.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    auto& transpose_2 = builder.AddNode("Transpose", {input1_arg}, {transpose_2_out_0});
+    transpose_2.AddAttribute("perm", std::vector<int64_t>{0, 3, 1, 2});
+    builder.AddNode("Sum", {transpose_1_out_0, transpose_2_out_0, input2_arg}, {sum_1_out_0});
+  };
+
+  auto check_optimized_graph_1 = [&](InferenceSessionWrapper& session) {
+    // Fewer transposed dims after the push (cost 6 -> 5), but 16 transposed elements would become 64 + 512.
+    int transpose_cost = EstimateTransposeCost(session.GetGraph());
+    EXPECT_EQ(transpose_cost, 6);
+  };
+
+  TransformerTester(build_test_case_1,
+                    check_optimized_graph_1,
+                    TransformerLevel::Default,
+                    TransformerLevel::Level1,
+                    /*opset_version*/ {15, 18});
+}
+
 TEST(TransposeOptimizerTests, RegressionTest_GitHubIssue9671) {
   auto model_uri = ORT_TSTR("testdata/gh_issue_9671.onnx");
 
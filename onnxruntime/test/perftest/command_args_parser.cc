@@ -4,7 +4,10 @@
 #include "command_args_parser.h"
 
 #include <string.h>
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <vector>
 
 // Windows Specific
 #ifdef _WIN32
@@ -27,8 +30,12 @@ namespace perftest {
   printf(
       "perf_test [options...] model_path [result_file]\n"
       "Options:\n"
-      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration' or 'times'.\n"
+      "\t-m [test_mode]: Specifies the test mode. Value could be 'duration', 'times', 'open_loop' or 'init'.\n"
       "\t\tProvide 'duration' to run the test for a fix duration, and 'times' to repeated for a certain times. \n"
+      "\t\tProvide 'open_loop' to send requests at the rate given by -Q for the duration given by -t, \n"
+      "\t\tindependently of how fast they complete, and report the latency from the time each request was due.\n"
+      "\t\tProvide 'init' to create the session as many times as given by -r and report the time of each phase of its\n"
+      "\t\tinitialization, from the session profiler, and the peak working set.\n"
       "\t-M: Disable memory pattern.\n"
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
@@ -38,7 +45,18 @@ namespace perftest {
       "Default:'cpu'.\n"
       "\t-b [tf|ort]: backend to use. Default:ort\n"
       "\t-r [repeated_times]: Specifies the repeated times if running in 'times' test mode.Default:1000.\n"
-      "\t-t [seconds_to_run]: Specifies the seconds to run for 'duration' mode. Default:600.\n"
+      "\t-t [seconds_to_run]: Specifies the seconds to run for 'duration' mode, or for each rate in 'open_loop' mode. Default:600.\n"
+      "\t-Q [qps|start:end:step]: Specifies the requests per second to send in 'open_loop' mode, which it implies.\n"
+      "\t\tWith start:end:step the rate is swept from start to end and the knee of the latency curve is reported.\n"
+      "\t\tThe number of requests in flight is bounded by -c.\n"
+      "\t-a [poisson|constant]: Specifies the arrival process of the requests in 'open_loop' mode. Default:poisson.\n"
+      "\t-w [warmup_seconds]: Specifies the seconds to run before measuring. Default:0 (a single run).\n"
+      "\t-g [free_dimension_sweep]: Runs the test once for each value of a named free dimension of generated inputs (implies -I).\n"
+      "\t\tSyntax is [dimension_name:v1,v2,...] or [dimension_name:start:end[:step]]. Repeat to sweep the product of several.\n"
+      "\t-j [sweep_result_file]: Writes the latency and throughput of each point of a sweep to a file, as JSON if it ends with .json\n"
+      "\t\tand CSV otherwise. Default: CSV to the standard output.\n"
+      "\t-n [model_path]: Adds a model to benchmark concurrently with the first one in the same process, sharing the env\n"
+      "\t\tand global thread pools sized by -x and -y. Repeat for more models.\n"
       "\t-p [profile_file]: Specifies the profile name to enable profiling and dump the profile data to the file.\n"
       "\t-s: Show statistics result, like P75, P90. If no result_file provided this defaults to on.\n"
       "\t-S: Given random seed, to produce the same input data. This defaults to -1(no initialize).\n"
@@ -136,9 +154,97 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
   return true;
 }
 
+// Parses "name:v1,v2,..." or "name:start:end[:step]".
+static bool ParseDimensionSweep(RunConfig& run_config) {
+  const std::string sweep_str = ToUTF8String(optarg);
+  std::vector<std::string> tokens;
+  size_t begin = 0;
+  while (true) {
+    const size_t end = sweep_str.find(':', begin);
+    tokens.push_back(sweep_str.substr(begin, end == std::string::npos ? end : end - begin));
+    if (end == std::string::npos) {
+      break;
+    }
+    begin = end + 1;
+  }
+  if (tokens.size() < 2 || tokens.size() > 4 || tokens[0].empty()) {
+    return false;
+  }
+
+  std::vector<int64_t> values;
+  ORT_TRY {
+    if (tokens.size() == 2) {
+      size_t value_begin = 0;
+      while (true) {
+        const size_t value_end = tokens[1].find(',', value_begin);
+        values.push_back(std::stoll(tokens[1].substr(
+            value_begin, value_end == std::string::npos ? value_end : value_end - value_begin)));
+        if (value_end == std::string::npos) {
+          break;
+        }
+        value_begin = value_end + 1;
+      }
+    } else {
+      const int64_t start = std::stoll(tokens[1]);
+      const int64_t end = std::stoll(tokens[2]);
+      const int64_t step = tokens.size() == 4 ? std::stoll(tokens[3]) : 1;
+      if (step <= 0 || end < start) {
+        return false;
+      }
+      for (int64_t value = start; value <= end; value += step) {
+        values.push_back(value);
+      }
+    }
+  }
+  ORT_CATCH(...) {
+    return false;
+  }
+  if (std::any_of(values.begin(), values.end(), [](int64_t value) { return value <= 0; })) {
+    return false;
+  }
+  run_config.free_dim_sweeps.emplace_back(tokens[0], std::move(values));
+  return true;
+}
+
+// Parses "qps" or "start:end:step".
+static bool ParseQps(RunConfig& run_config) {
+  const std::string qps_str = ToUTF8String(optarg);
+  double values[3] = {0.0, 0.0, 0.0};
+  size_t num_values = 0;
+  size_t begin = 0;
+  while (num_values < 3) {
+    const size_t end = qps_str.find(':', begin);
+    ORT_TRY {
+      size_t parsed = 0;
+      const std::string value_str = qps_str.substr(begin, end == std::string::npos ? end : end - begin);
+      values[num_values++] = std::stod(value_str, &parsed);
+      if (parsed != value_str.size()) {
+        return false;
+      }
+    }
+    ORT_CATCH(...) {
+      return false;
+    }
+    if (end == std::string::npos) {
+      break;
+    }
+    begin = end + 1;
+  }
+  if ((num_values != 1 && num_values != 3) || values[0] <= 0.0) {
+    return false;
+  }
+  if (num_values == 3 && (values[1] < values[0] || values[2] <= 0.0)) {
+    return false;
+  }
+  run_config.target_qps = values[0];
+  run_config.qps_sweep_end = num_values == 3 ? values[1] : values[0];
+  run_config.qps_sweep_step = values[2];
+  return true;
+}
+
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:AMPIDZvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:Q:a:w:g:j:n:AMPIDZvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -163,10 +269,44 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
           test_config.run_config.test_mode = TestMode::kFixDurationMode;
         } else if (!CompareCString(optarg, ORT_TSTR("times"))) {
           test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("open_loop"))) {
+          test_config.run_config.test_mode = TestMode::kOpenLoopMode;
+        } else if (!CompareCString(optarg, ORT_TSTR("init"))) {
+          test_config.run_config.test_mode = TestMode::kSessionInitializationMode;
+        } else {
+          return false;
+        }
+        break;
+      case 'Q':
+        if (!ParseQps(test_config.run_config)) {
+          return false;
+        }
+        test_config.run_config.test_mode = TestMode::kOpenLoopMode;
+        break;
+      case 'a':
+        if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kPoisson;
+        } else if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kConstant;
         } else {
           return false;
         }
         break;
+      case 'w':
+        test_config.run_config.warmup_seconds = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
+        break;
+      case 'g':
+        if (!ParseDimensionSweep(test_config.run_config)) {
+          return false;
+        }
+        test_config.run_config.generate_model_input_binding = true;
+        break;
+      case 'j':
+        test_config.run_config.sweep_result_file = optarg;
+        break;
+      case 'n':
+        test_config.model_info.concurrent_model_file_paths.emplace_back(optarg);
+        break;
       case 'b':
         test_config.backend = optarg;
         break;
@@ -224,14 +364,20 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
         if (test_config.run_config.repeated_times <= 0) {
           return false;
         }
-        test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        // -r is also the number of sessions created by the session initialization mode
+        if (test_config.run_config.test_mode != TestMode::kSessionInitializationMode) {
+          test_config.run_config.test_mode = TestMode::KFixRepeatedTimesMode;
+        }
         break;
       case 't':
         test_config.run_config.duration_in_seconds = static_cast<size_t>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         if (test_config.run_config.repeated_times <= 0) {
           return false;
         }
-        test_config.run_config.test_mode = TestMode::kFixDurationMode;
+        // -t is also the duration of each step of the open loop mode
+        if (test_config.run_config.test_mode != TestMode::kOpenLoopMode) {
+          test_config.run_config.test_mode = TestMode::kFixDurationMode;
+        }
         break;
       case 's':
         test_config.run_config.f_dump_statistics = true;
@@ -341,6 +487,11 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
   test_config.model_info.model_file_path = argv[0];
 
+  if (test_config.run_config.test_mode == TestMode::kOpenLoopMode && test_config.run_config.target_qps <= 0.0) {
+    fprintf(stderr, "the 'open_loop' test mode requires a request rate (-Q)\n");
+    return false;
+  }
+
   return true;
 }
 
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+namespace onnxruntime {
+namespace perftest {
+
+// A histogram of latencies in microseconds in the style of HdrHistogram. Values below 2^kPrecisionBits are counted
+// exactly, larger ones in buckets spanning 1/2^(kPrecisionBits - 1) of their power of 2, so every value is recorded
+// within 1% of its magnitude with a fixed memory footprint.
+class LatencyHistogram {
+ public:
+  LatencyHistogram() : counts_(kNumBuckets, 0) {}
+
+  void Record(uint64_t value_us) {
+    ++counts_[GetBucket(value_us)];
+    ++total_count_;
+    sum_ += static_cast<double>(value_us);
+    max_ = std::max(max_, value_us);
+  }
+
+  uint64_t TotalCount() const { return total_count_; }
+
+  double Mean() const { return total_count_ == 0 ? 0.0 : sum_ / static_cast<double>(total_count_); }
+
+  uint64_t Max() const { return max_; }
+
+  // The largest value counted in the bucket of the given percentile, in [0, 100].
+  uint64_t ValueAtPercentile(double percentile) const {
+    const uint64_t rank = GetRank(percentile);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < counts_.size(); ++bucket) {
+      seen += counts_[bucket];
+      if (seen >= rank && seen > 0) {
+        return std::min(GetBucketHighestValue(bucket), max_);
+      }
+    }
+    return max_;
+  }
+
+  // Write the percentile distribution in milliseconds in the format of HdrHistogram's
+  // outputPercentileDistribution, so it can be plotted with the HdrHistogram tools. The percentiles reported get
+  // closer to 100 with ticks_per_half_distance steps per halving of the distance to 100.
+  void PrintPercentileDistribution(std::ostream& os, int ticks_per_half_distance = 5) const {
+    os << std::setw(12) << "Value" << " " << std::setw(14) << "Percentile" << " " << std::setw(10) << "TotalCount"
+       << " " << std::setw(14) << "1/(1-Percentile)" << "\n\n";
+    const auto print_line = [&os](double value_ms, double percentile, uint64_t count) {
+      os << std::fixed << std::setw(12) << std::setprecision(3) << value_ms << " " << std::setw(14)
+         << std::setprecision(12) << percentile / 100.0 << " " << std::setw(10) << count << " ";
+      if (percentile < 100.0) {
+        os << std::setw(14) << std::setprecision(2) << 1.0 / (1.0 - percentile / 100.0) << "\n";
+      } else {
+        os << std::setw(14) << "inf" << "\n";
+      }
+    };
+
+    uint64_t seen = 0;
+    double percentile = 0.0;
+    for (size_t bucket = 0; bucket < counts_.size() && seen < total_count_; ++bucket) {
+      if (counts_[bucket] == 0) {
+        continue;
+      }
+      seen += counts_[bucket];
+      const double value_ms = static_cast<double>(std::min(GetBucketHighestValue(bucket), max_)) / 1000.0;
+      while (seen < total_count_ && seen >= GetRank(percentile)) {
+        print_line(value_ms, percentile, seen);
+        const double half_distance = std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - percentile))) + 1.0);
+        percentile += 100.0 / (ticks_per_half_distance * half_distance);
+      }
+    }
+    if (total_count_ > 0) {
+      print_line(static_cast<double>(max_) / 1000.0, 100.0, total_count_);
+    }
+
+    os << std::fixed << std::setprecision(3) << "#[Mean    = " << std::setw(12) << Mean() / 1000.0
+       << ", Max         = " << std::setw(12) << static_cast<double>(max_) / 1000.0 << "]\n"
+       << "#[Total count    = " << std::setw(12) << total_count_ << "]" << std::endl;
+    os.unsetf(std::ios_base::floatfield);
+  }
+
+ private:
+  static constexpr int kPrecisionBits = 8;
+  static constexpr uint64_t kExactValues = uint64_t{1} << kPrecisionBits;
+  static constexpr uint64_t kBucketsPerPowerOf2 = kExactValues / 2;
+  static constexpr size_t kNumBuckets = static_cast<size_t>(kExactValues + (64 - kPrecisionBits) * kBucketsPerPowerOf2);
+
+  static size_t GetBucket(uint64_t value) {
+    if (value < kExactValues) {
+      return static_cast<size_t>(value);
+    }
+    int log2 = kPrecisionBits;
+    while ((value >> (log2 + 1)) != 0) {
+      ++log2;
+    }
+    // the kPrecisionBits most significant bits of the value
+    const uint64_t top_bits = value >> (log2 - kPrecisionBits + 1);
+    return static_cast<size_t>(kExactValues + (log2 - kPrecisionBits) * kBucketsPerPowerOf2 +
+                               (top_bits - kBucketsPerPowerOf2));
+  }
+
+  static uint64_t GetBucketHighestValue(size_t bucket) {
+    if (bucket < kExactValues) {
+      return bucket;
+    }
+    const uint64_t offset = bucket - kExactValues;
+    const int shift = static_cast<int>(offset / kBucketsPerPowerOf2) + 1;
+    const uint64_t top_bits = kBucketsPerPowerOf2 + offset % kBucketsPerPowerOf2;
+    return ((top_bits + 1) << shift) - 1;
+  }
+
+  uint64_t GetRank(double percentile) const {
+    const auto rank = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_count_)));
+    return std::max<uint64_t>(rank, 1);
+  }
+
+  std::vector<uint64_t> counts_;
+  uint64_t total_count_{0};
+  double sum_{0.0};
+  uint64_t max_{0};
+};
+
+}  // namespace perftest
+}  // namespace onnxruntime
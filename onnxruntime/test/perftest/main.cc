@@ -3,7 +3,10 @@
 
 // onnxruntime dependencies
 #include <core/session/onnxruntime_c_api.h>
+#include <memory>
 #include <random>
+#include <thread>
+#include <vector>
 #include "command_args_parser.h"
 #include "performance_runner.h"
 #include <google/protobuf/stubs/common.h>
@@ -22,6 +25,12 @@ int real_main(int argc, char* argv[]) {
     perftest::CommandLineParser::ShowUsage();
     return -1;
   }
+  // models run concurrently share the env's thread pools, to reproduce how they interfere when co-located
+  std::vector<std::basic_string<ORTCHAR_T>> model_paths{test_config.model_info.model_file_path};
+  model_paths.insert(model_paths.end(), test_config.model_info.concurrent_model_file_paths.begin(),
+                     test_config.model_info.concurrent_model_file_paths.end());
+  test_config.run_config.use_global_thread_pools = model_paths.size() > 1;
+
   Ort::Env env{nullptr};
   {
     bool failed = false;
@@ -29,7 +38,21 @@ int real_main(int argc, char* argv[]) {
       OrtLoggingLevel logging_level = test_config.run_config.f_verbose
                                           ? ORT_LOGGING_LEVEL_VERBOSE
                                           : ORT_LOGGING_LEVEL_WARNING;
-      env = Ort::Env(logging_level, "Default");
+      if (test_config.run_config.use_global_thread_pools) {
+        Ort::ThreadingOptions threading_options;
+        if (test_config.run_config.intra_op_num_threads > 0) {
+          threading_options.SetGlobalIntraOpNumThreads(test_config.run_config.intra_op_num_threads);
+        }
+        if (test_config.run_config.inter_op_num_threads > 0) {
+          threading_options.SetGlobalInterOpNumThreads(test_config.run_config.inter_op_num_threads);
+        }
+        if (test_config.run_config.disable_spinning) {
+          threading_options.SetGlobalSpinControl(0);
+        }
+        env = Ort::Env(threading_options, logging_level, "Default");
+      } else {
+        env = Ort::Env(logging_level, "Default");
+      }
     }
     ORT_CATCH(const Ort::Exception& e) {
       ORT_HANDLE_EXCEPTION([&]() {
@@ -42,14 +65,47 @@ int real_main(int argc, char* argv[]) {
       return -1;
   }
   std::random_device rd;
-  perftest::PerformanceRunner perf_runner(env, test_config, rd);
-  auto status = perf_runner.Run();
-  if (!status.IsOK()) {
-    printf("Run failed:%s\n", status.ErrorMessage().c_str());
-    return -1;
+  std::vector<std::unique_ptr<perftest::PerformanceRunner>> perf_runners;
+  for (const auto& model_path : model_paths) {
+    perftest::PerformanceTestConfig model_config = test_config;
+    model_config.model_info.model_file_path = model_path;
+    perf_runners.push_back(std::make_unique<perftest::PerformanceRunner>(env, model_config, rd));
+  }
+
+  std::vector<Status> statuses(perf_runners.size());
+  if (perf_runners.size() == 1) {
+    statuses[0] = perf_runners[0]->Run();
+  } else {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < perf_runners.size(); ++i) {
+      threads.emplace_back([&perf_runners, &statuses, i]() { statuses[i] = perf_runners[i]->Run(); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  for (const auto& status : statuses) {
+    if (!status.IsOK()) {
+      printf("Run failed:%s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+  }
+
+  std::vector<perftest::SweepPointResult> sweep_results;
+  for (const auto& perf_runner : perf_runners) {
+    perf_runner->SerializeResult();
+    const auto& runner_sweep_results = perf_runner->GetSweepResults();
+    sweep_results.insert(sweep_results.end(), runner_sweep_results.begin(), runner_sweep_results.end());
   }
 
-  perf_runner.SerializeResult();
+  if (!test_config.run_config.free_dim_sweeps.empty()) {
+    auto status = perftest::WriteSweepResults(test_config.run_config.sweep_result_file, test_config.run_config,
+                                              sweep_results);
+    if (!status.IsOK()) {
+      printf("Writing the sweep results failed:%s\n", status.ErrorMessage().c_str());
+      return -1;
+    }
+  }
 
   return 0;
 }
@@ -409,6 +409,8 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     tensorrt_options.trt_profile_max_shapes = trt_profile_max_shapes.c_str();
     tensorrt_options.trt_profile_opt_shapes = trt_profile_opt_shapes.c_str();
     tensorrt_options.trt_cuda_graph_enable = trt_cuda_graph_enable;
+    tensorrt_options.trt_profile_shapes_trace = nullptr;
+    tensorrt_options.trt_num_auto_profiles = 3;
 
     session_options.AppendExecutionProvider_TensorRT_V2(tensorrt_options);
 
@@ -759,6 +761,10 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
     session_options.DisableMemPattern();
   session_options.SetExecutionMode(performance_test_config.run_config.execution_mode);
 
+  if (performance_test_config.run_config.use_global_thread_pools) {
+    session_options.DisablePerSessionThreads();
+  }
+
   if (performance_test_config.run_config.intra_op_num_threads > 0) {
     fprintf(stdout, "Setting intra_op_num_threads to %d\n", performance_test_config.run_config.intra_op_num_threads);
     session_options.SetIntraOpNumThreads(performance_test_config.run_config.intra_op_num_threads);
@@ -913,7 +919,8 @@ static void InitializeTensorWithSeed(int32_t seed, Ort::Value& tensor) {
 #undef CASE_FOR_TYPE
 }
 
-bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData(int32_t seed) {
+bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData(
+    int32_t seed, const std::unordered_map<std::string, int64_t>& free_dim_values) {
   // iterate over all input nodes
   for (size_t i = 0; i < static_cast<size_t>(input_length_); i++) {
     Ort::TypeInfo type_info = session_.GetInputTypeInfo(i);
@@ -921,11 +928,14 @@ bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData(int32_t seed) {
     if (type_info.GetONNXType() == ONNX_TYPE_TENSOR) {
       auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
       std::vector<int64_t> input_node_dim = tensor_info.GetShape();
+      std::vector<const char*> dim_names(input_node_dim.size(), nullptr);
+      tensor_info.GetSymbolicDimensions(dim_names.data(), dim_names.size());
 
       // free dimensions are treated as 1 if not overriden
-      for (int64_t& dim : input_node_dim) {
-        if (dim == -1) {
-          dim = 1;
+      for (size_t d = 0; d < input_node_dim.size(); ++d) {
+        if (input_node_dim[d] == -1) {
+          auto value = dim_names[d] != nullptr ? free_dim_values.find(dim_names[d]) : free_dim_values.end();
+          input_node_dim[d] = value != free_dim_values.end() ? value->second : 1;
         }
       }
 
@@ -939,5 +949,23 @@ bool OnnxRuntimeTestSession::PopulateGeneratedInputTestData(int32_t seed) {
   return true;
 }
 
+std::unordered_set<std::string> OnnxRuntimeTestSession::GetInputFreeDimensionNames() const {
+  std::unordered_set<std::string> names;
+  for (size_t i = 0; i < static_cast<size_t>(input_length_); i++) {
+    Ort::TypeInfo type_info = session_.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() == ONNX_TYPE_TENSOR) {
+      auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+      std::vector<const char*> dim_names(tensor_info.GetDimensionsCount(), nullptr);
+      tensor_info.GetSymbolicDimensions(dim_names.data(), dim_names.size());
+      for (const char* name : dim_names) {
+        if (name != nullptr && name[0] != '\0') {
+          names.insert(name);
+        }
+      }
+    }
+  }
+  return names;
+}
+
 }  // namespace perftest
 }  // namespace onnxruntime
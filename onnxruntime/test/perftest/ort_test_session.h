@@ -4,6 +4,9 @@
 #pragma once
 #include <core/session/onnxruntime_cxx_api.h>
 #include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include "test_configuration.h"
 #include "test_session.h"
 class TestModelInfo;
@@ -25,7 +28,18 @@ class OnnxRuntimeTestSession : public TestSession {
     test_inputs_[test_data_id][input_id] = std::move(value);
   }
 
-  bool PopulateGeneratedInputTestData(int32_t seed);
+  // Generates the inputs, with the free dimensions named in free_dim_values set to their value and the others to 1.
+  bool PopulateGeneratedInputTestData(int32_t seed,
+                                      const std::unordered_map<std::string, int64_t>& free_dim_values = {});
+
+  // The names of the free dimensions of the tensor inputs.
+  std::unordered_set<std::string> GetInputFreeDimensionNames() const;
+
+  // Ends profiling and returns the name of the profile file.
+  std::string EndProfiling() {
+    Ort::AllocatorWithDefaultOptions allocator;
+    return session_.EndProfilingAllocated(allocator).get();
+  }
 
   ~OnnxRuntimeTestSession() = default;
 
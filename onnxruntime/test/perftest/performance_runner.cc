@@ -7,7 +7,15 @@
 #endif
 
 #include "performance_runner.h"
+#include <deque>
+#include <iomanip>
+#include <cstdio>
 #include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -116,30 +124,31 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
 }
 
 Status PerformanceRunner::Run() {
+  // only creates sessions, so needs no input data
+  if (performance_test_config_.run_config.test_mode == TestMode::kSessionInitializationMode) {
+    return SessionInitializationTest();
+  }
+
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
 
+  if (!performance_test_config_.run_config.free_dim_sweeps.empty()) {
+    return SweepTest();
+  }
+
   // warm up
   initial_inference_result_.start = std::chrono::high_resolution_clock::now();
   ORT_RETURN_IF_ERROR(RunOneIteration<true>());
   initial_inference_result_.end = std::chrono::high_resolution_clock::now();
+  ORT_RETURN_IF_ERROR(Warmup());
 
   // TODO: start profiling
   // if (!performance_test_config_.run_config.profile_file.empty())
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
-  }
+  ORT_RETURN_IF_ERROR(RunTest());
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
   performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
@@ -152,17 +161,195 @@ Status PerformanceRunner::Run() {
       std::chrono::duration_cast<std::chrono::milliseconds>(initial_inference_result_.end - initial_inference_result_.start).count();
   std::chrono::duration<double> inference_duration = performance_result_.end - performance_result_.start;
 
-  std::cout << "Session creation time cost: " << session_create_duration.count() << " s\n"
-            << "First inference time cost: " << first_inference_duration << " ms\n"
-            << "Total inference time cost: " << performance_result_.total_time_cost << " s\n"  // sum of time taken by each request
-            << "Total inference requests: " << performance_result_.time_costs.size() << "\n"
-            << "Average inference time cost: " << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms\n"
-            // Time between start and end of run. Less than Total time cost when running requests in parallel.
-            << "Total inference run time: " << inference_duration.count() << " s\n"
-            << "Number of inferences per second: " << performance_result_.time_costs.size() / inference_duration.count() << " \n"
-            << "Avg CPU usage: " << performance_result_.average_CPU_usage << " %\n"
-            << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
-            << std::endl;
+  // written at once so that the summaries of models run concurrently do not interleave
+  std::ostringstream summary;
+  if (!performance_test_config_.model_info.concurrent_model_file_paths.empty()) {
+    summary << "Model: " << ToUTF8String(performance_test_config_.model_info.model_file_path) << "\n";
+  }
+  summary << "Session creation time cost: " << session_create_duration.count() << " s\n"
+          << "First inference time cost: " << first_inference_duration << " ms\n"
+          << "Total inference time cost: " << performance_result_.total_time_cost << " s\n"  // sum of time taken by each request
+          << "Total inference requests: " << performance_result_.time_costs.size() << "\n"
+          << "Average inference time cost: " << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms\n"
+          // Time between start and end of run. Less than Total time cost when running requests in parallel.
+          << "Total inference run time: " << inference_duration.count() << " s\n"
+          << "Number of inferences per second: " << performance_result_.time_costs.size() / inference_duration.count() << " \n"
+          << "Avg CPU usage: " << performance_result_.average_CPU_usage << " %\n"
+          << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes\n";
+  std::cout << summary.str() << std::flush;
+
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunTest() {
+  switch (performance_test_config_.run_config.test_mode) {
+    case TestMode::kFixDurationMode:
+      return FixDurationTest();
+    case TestMode::KFixRepeatedTimesMode:
+      return RepeatedTimesTest();
+    case TestMode::kOpenLoopMode:
+      return OpenLoopTest();
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  }
+}
+
+Status PerformanceRunner::SweepTest() {
+  const auto& run_config = performance_test_config_.run_config;
+  auto* ort_session = static_cast<OnnxRuntimeTestSession*>(session_.get());
+  const std::string model_path = ToUTF8String(performance_test_config_.model_info.model_file_path);
+
+  // dimensions the model does not have would only repeat the same runs
+  const auto model_free_dims = ort_session->GetInputFreeDimensionNames();
+  std::vector<const std::pair<std::string, std::vector<int64_t>>*> sweeps;
+  for (const auto& sweep : run_config.free_dim_sweeps) {
+    if (model_free_dims.count(sweep.first) != 0) {
+      sweeps.push_back(&sweep);
+    } else {
+      std::cout << model_path << " has no free dimension named " << sweep.first << ", it is not swept." << std::endl;
+    }
+  }
+
+  performance_result_.start = std::chrono::high_resolution_clock::now();
+  std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
+
+  // iterate over the product of the swept values, the last dimension varying fastest
+  std::vector<size_t> indices(sweeps.size(), 0);
+  while (true) {
+    SweepPointResult point;
+    point.model_path = model_path;
+    std::unordered_map<std::string, int64_t> free_dim_values;
+    for (size_t i = 0; i < sweeps.size(); ++i) {
+      const int64_t value = sweeps[i]->second[indices[i]];
+      free_dim_values[sweeps[i]->first] = value;
+      point.free_dims.emplace_back(sweeps[i]->first, value);
+    }
+
+    if (!ort_session->PopulateGeneratedInputTestData(run_config.random_seed_for_input_data, free_dim_values)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to generate the inputs of ", model_path);
+    }
+    ORT_RETURN_IF_ERROR(RunOneIteration<true>());
+    ORT_RETURN_IF_ERROR(Warmup());
+
+    // the duration mode stops on total_time_cost so every point starts from 0
+    const size_t first_run = performance_result_.time_costs.size();
+    const double total_time_cost = performance_result_.total_time_cost;
+    performance_result_.total_time_cost = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    ORT_RETURN_IF_ERROR(RunTest());
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+    performance_result_.total_time_cost += total_time_cost;
+
+    std::vector<double> latencies(performance_result_.time_costs.begin() + first_run,
+                                  performance_result_.time_costs.end());
+    point.num_runs = latencies.size();
+    if (!latencies.empty()) {
+      std::sort(latencies.begin(), latencies.end());
+      const size_t total = latencies.size();
+      point.throughput = total / duration.count();
+      point.mean_latency = std::accumulate(latencies.begin(), latencies.end(), 0.0) / total;
+      point.p50_latency = latencies[static_cast<size_t>(total * 0.5)];
+      point.p90_latency = latencies[static_cast<size_t>(total * 0.9)];
+      point.p99_latency = latencies[static_cast<size_t>(total * 0.99)];
+    }
+
+    std::ostringstream line;
+    line << model_path;
+    for (const auto& dim : point.free_dims) {
+      line << " " << dim.first << "=" << dim.second;
+    }
+    line << ": Runs: " << point.num_runs << ", Throughput: " << point.throughput << " runs/s"
+         << ", Average Latency: " << point.mean_latency * 1000 << " ms"
+         << ", P50 Latency: " << point.p50_latency * 1000 << " ms"
+         << ", P90 Latency: " << point.p90_latency * 1000 << " ms"
+         << ", P99 Latency: " << point.p99_latency * 1000 << " ms\n";
+    std::cout << line.str() << std::flush;
+    sweep_results_.push_back(std::move(point));
+
+    size_t dim = sweeps.size();
+    while (dim > 0 && ++indices[dim - 1] == sweeps[dim - 1]->second.size()) {
+      indices[--dim] = 0;
+    }
+    if (dim == 0) {
+      break;
+    }
+  }
+
+  performance_result_.end = std::chrono::high_resolution_clock::now();
+  performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
+  performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
+  return Status::OK();
+}
+
+static std::string EscapeJsonString(const std::string& str) {
+  std::string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+Status WriteSweepResults(const std::basic_string<ORTCHAR_T>& path, const RunConfig& run_config,
+                         const std::vector<SweepPointResult>& results) {
+  std::ofstream outfile;
+  if (!path.empty()) {
+    outfile.open(path, std::ofstream::out | std::ofstream::trunc);
+    if (!outfile.good()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to open the sweep result file ", ToUTF8String(path));
+    }
+  }
+  std::ostream& os = path.empty() ? std::cout : outfile;
+
+  // the value of a swept dimension at a point, or -1 if the model has no such dimension
+  const auto get_dim = [](const SweepPointResult& point, const std::string& name) -> int64_t {
+    for (const auto& dim : point.free_dims) {
+      if (dim.first == name) {
+        return dim.second;
+      }
+    }
+    return -1;
+  };
+
+  if (HasExtensionOf(path, ORT_TSTR("json"))) {
+    os << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const auto& point = results[i];
+      os << "  {\"model\": \"" << EscapeJsonString(point.model_path) << "\", \"free_dims\": {";
+      for (size_t d = 0; d < point.free_dims.size(); ++d) {
+        os << (d == 0 ? "" : ", ") << "\"" << EscapeJsonString(point.free_dims[d].first) << "\": "
+           << point.free_dims[d].second;
+      }
+      os << "}, \"runs\": " << point.num_runs
+         << ", \"throughput_per_s\": " << point.throughput
+         << ", \"mean_ms\": " << point.mean_latency * 1000
+         << ", \"p50_ms\": " << point.p50_latency * 1000
+         << ", \"p90_ms\": " << point.p90_latency * 1000
+         << ", \"p99_ms\": " << point.p99_latency * 1000 << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "]" << std::endl;
+  } else {
+    os << "model";
+    for (const auto& sweep : run_config.free_dim_sweeps) {
+      os << "," << sweep.first;
+    }
+    os << ",runs,throughput_per_s,mean_ms,p50_ms,p90_ms,p99_ms\n";
+    for (const auto& point : results) {
+      os << point.model_path;
+      for (const auto& sweep : run_config.free_dim_sweeps) {
+        const int64_t value = get_dim(point, sweep.first);
+        os << ",";
+        if (value >= 0) {
+          os << value;
+        }
+      }
+      os << "," << point.num_runs << "," << point.throughput << "," << point.mean_latency * 1000 << ","
+         << point.p50_latency * 1000 << "," << point.p90_latency * 1000 << "," << point.p99_latency * 1000 << "\n";
+    }
+    os << std::flush;
+  }
 
   return Status::OK();
 }
@@ -254,6 +441,195 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::Warmup() {
+  const auto& run_config = performance_test_config_.run_config;
+  if (run_config.warmup_seconds == 0) {
+    return Status::OK();
+  }
+
+  if (run_config.test_mode == TestMode::kOpenLoopMode) {
+    OpenLoopResult result;
+    return RunOpenLoop(run_config.target_qps, static_cast<double>(run_config.warmup_seconds), nullptr, result);
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> duration_seconds(0);
+  while (duration_seconds.count() < run_config.warmup_seconds) {
+    ORT_RETURN_IF_ERROR(RunOneIteration<true>());
+    duration_seconds = std::chrono::high_resolution_clock::now() - start;
+  }
+  return Status::OK();
+}
+
+Status PerformanceRunner::RunOpenLoop(double target_qps, double duration_in_seconds, LatencyHistogram* histogram,
+                                      OpenLoopResult& result) {
+  using Clock = std::chrono::steady_clock;
+  const auto& run_config = performance_test_config_.run_config;
+
+  // requests which are due, by the time they were due at
+  std::deque<Clock::time_point> pending;
+  bool dispatch_done = false;
+  size_t num_completed = 0;
+  Status status = Status::OK();
+  OrtMutex m;
+  OrtCondVar cv;
+
+  std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
+  const auto start = Clock::now();
+  auto last_completion = start;
+
+  // one thread per request in flight, each taking the oldest pending request
+  auto tpool = std::make_unique<DefaultThreadPoolType>(run_config.concurrent_session_runs);
+  for (size_t i = 0; i != run_config.concurrent_session_runs; ++i) {
+    tpool->Schedule([this, histogram, &pending, &dispatch_done, &num_completed, &status, &last_completion, &m,
+                     &cv]() {
+      while (true) {
+        Clock::time_point due;
+        {
+          std::unique_lock<OrtMutex> lock(m);
+          cv.wait(lock, [&pending, &dispatch_done]() { return dispatch_done || !pending.empty(); });
+          if (pending.empty()) {
+            return;
+          }
+          due = pending.front();
+          pending.pop_front();
+        }
+
+        auto run_status = Status::OK();
+        ORT_TRY {
+          session_->Run();
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            run_status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOpenLoop caught exception: ",
+                                         ex.what());
+          });
+        }
+        const auto completion = Clock::now();
+
+        {
+          std::lock_guard<OrtMutex> lock(m);
+          if (!run_status.IsOK()) {
+            if (status.IsOK()) {
+              status = run_status;
+            }
+            continue;
+          }
+          ++num_completed;
+          last_completion = std::max(last_completion, completion);
+        }
+
+        if (histogram != nullptr) {
+          const std::chrono::duration<double> latency = completion - due;
+          std::lock_guard<OrtMutex> guard(results_mutex_);
+          histogram->Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+          performance_result_.time_costs.emplace_back(latency.count());
+          performance_result_.total_time_cost += latency.count();
+        }
+      }
+    });
+  }
+
+  // Dispatch the requests on schedule. A request is due at its scheduled time even if every thread is busy, so the
+  // time it waits for one is part of its latency.
+  std::mt19937 engine(run_config.random_seed_for_input_data >= 0
+                          ? static_cast<std::mt19937::result_type>(run_config.random_seed_for_input_data)
+                          : std::random_device{}());
+  std::exponential_distribution<double> poisson_interval(target_qps);
+  const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration_in_seconds));
+  auto next = start;
+  while (next < end) {
+    std::this_thread::sleep_until(next);
+    {
+      std::lock_guard<OrtMutex> lock(m);
+      pending.push_back(next);
+    }
+    cv.notify_one();
+    ++result.num_requests;
+
+    const double interval_seconds = run_config.arrival_process == ArrivalProcess::kPoisson
+                                        ? poisson_interval(engine)
+                                        : 1.0 / target_qps;
+    next += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval_seconds));
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(m);
+    dispatch_done = true;
+  }
+  cv.notify_all();
+  // the destructor waits for the threads to drain the pending requests
+  tpool.reset();
+
+  const std::chrono::duration<double> elapsed = std::max(last_completion, end) - start;
+  result.achieved_qps = num_completed / elapsed.count();
+  result.average_CPU_usage = p_ICPUUsage->GetUsage();
+  return status;
+}
+
+Status PerformanceRunner::OpenLoopTest() {
+  const auto& run_config = performance_test_config_.run_config;
+  const bool is_sweep = run_config.qps_sweep_step > 0.0;
+
+  struct Step {
+    double target_qps;
+    OpenLoopResult result;
+    uint64_t p99_us;
+  };
+  std::vector<Step> steps;
+
+  for (size_t i = 0;; ++i) {
+    const double target_qps = run_config.target_qps + i * run_config.qps_sweep_step;
+    if (i > 0 && (!is_sweep || target_qps > run_config.qps_sweep_end * (1.0 + 1e-9))) {
+      break;
+    }
+
+    LatencyHistogram histogram;
+    OpenLoopResult result;
+    ORT_RETURN_IF_ERROR(RunOpenLoop(target_qps, static_cast<double>(run_config.duration_in_seconds), &histogram,
+                                    result));
+    steps.push_back({target_qps, result, histogram.ValueAtPercentile(99.0)});
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "Target: " << target_qps << " requests/s"
+              << ", Achieved: " << result.achieved_qps << " requests/s"
+              << ", Requests: " << result.num_requests
+              << ", P50 Latency: " << histogram.ValueAtPercentile(50.0) / 1000.0 << " ms"
+              << ", P99 Latency: " << histogram.ValueAtPercentile(99.0) / 1000.0 << " ms"
+              << ", P999 Latency: " << histogram.ValueAtPercentile(99.9) / 1000.0 << " ms"
+              << ", Avg CPU usage: " << result.average_CPU_usage << " %" << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+    if (!is_sweep || run_config.f_verbose) {
+      histogram.PrintPercentileDistribution(std::cout);
+    }
+
+    // past saturation the queue only grows, so higher rates tell nothing more
+    if (is_sweep && result.achieved_qps < 0.9 * target_qps) {
+      std::cout << "Stopping the sweep: the achieved rate is below 90% of the target." << std::endl;
+      break;
+    }
+  }
+
+  if (is_sweep) {
+    // the knee is the highest rate that is sustained without the tail latency growing far beyond its unloaded value
+    const Step* knee = nullptr;
+    for (const auto& step : steps) {
+      if (step.result.achieved_qps < 0.95 * step.target_qps || step.p99_us > 2 * steps.front().p99_us) {
+        break;
+      }
+      knee = &step;
+    }
+    if (knee != nullptr) {
+      std::cout << "Latency knee: " << knee->target_qps << " requests/s with P99 Latency "
+                << knee->p99_us / 1000.0 << " ms" << std::endl;
+    } else {
+      std::cout << "Latency knee: not found, the first rate already saturates the session." << std::endl;
+    }
+  }
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
@@ -292,7 +668,8 @@ static std::unique_ptr<TestSession> CreateSession(Ort::Env& env, std::random_dev
 }
 
 PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd)
-    : performance_test_config_(test_config),
+    : env_(env),
+      performance_test_config_(test_config),
       test_model_info_(CreateModelInfo(test_config)) {
   session_create_start_ = std::chrono::high_resolution_clock::now();
   session_ = CreateSession(env, rd, test_config, *test_model_info_);
@@ -301,6 +678,112 @@ PerformanceRunner::PerformanceRunner(Ort::Env& env, const PerformanceTestConfig&
 
 PerformanceRunner::~PerformanceRunner() = default;
 
+// Adds the duration in microseconds of each session event of a profile written by onnxruntime to durations.
+static bool AccumulateSessionEventDurations(const std::string& profile_file,
+                                            std::map<std::string, double>& durations) {
+  std::ifstream profile(profile_file);
+  if (!profile.good()) {
+    return false;
+  }
+
+  // the profiler writes one event per line
+  static const std::string kSessionCategory = R"("cat" : "Session")";
+  static const std::string kDuration = R"("dur" :)";
+  static const std::string kName = R"("name" :")";
+  std::string line;
+  while (std::getline(profile, line)) {
+    const size_t duration_pos = line.find(kDuration);
+    const size_t name_pos = line.find(kName);
+    if (line.find(kSessionCategory) == std::string::npos || duration_pos == std::string::npos ||
+        name_pos == std::string::npos) {
+      continue;
+    }
+    const size_t name_begin = name_pos + kName.size();
+    const size_t name_end = line.find('"', name_begin);
+    if (name_end != std::string::npos) {
+      durations[line.substr(name_begin, name_end - name_begin)] +=
+          std::strtod(line.c_str() + duration_pos + kDuration.size(), nullptr);
+    }
+  }
+  return true;
+}
+
+Status PerformanceRunner::SessionInitializationTest() {
+  if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "the 'init' test mode requires the ort backend.");
+  }
+
+  // the time of each phase is read from the profile of the session, which is removed unless one was requested
+  PerformanceTestConfig test_config = performance_test_config_;
+  const bool keep_profiles = !test_config.run_config.profile_file.empty();
+  if (!keep_profiles) {
+    test_config.run_config.profile_file = ORT_TSTR("onnxruntime_perf_test_init");
+  }
+
+  // the process peak after the session created by the constructor, which was the first one
+  const size_t first_peak_workingset_size = utils::GetPeakWorkingSetSize();
+  const std::chrono::duration<double> first_session_create_duration = session_create_end_ - session_create_start_;
+
+  std::random_device rd;
+  std::map<std::string, double> phase_durations;
+  performance_result_.start = std::chrono::high_resolution_clock::now();
+  std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
+  for (size_t i = 0; i < test_config.run_config.repeated_times; ++i) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    std::unique_ptr<TestSession> session = CreateSession(env_, rd, test_config, *test_model_info_);
+    const std::chrono::duration<double> duration_seconds = std::chrono::high_resolution_clock::now() - start;
+    performance_result_.time_costs.emplace_back(duration_seconds.count());
+    performance_result_.total_time_cost += duration_seconds.count();
+
+    const std::string profile_file = static_cast<OnnxRuntimeTestSession*>(session.get())->EndProfiling();
+    if (!AccumulateSessionEventDurations(profile_file, phase_durations)) {
+      std::cerr << "failed to read the session profile '" << profile_file << "'.\n";
+    }
+    if (!keep_profiles) {
+      std::remove(profile_file.c_str());
+    }
+
+    if (test_config.run_config.f_verbose) {
+      std::cout << "iteration:" << i + 1 << ","
+                << "session_creation_time_cost:" << duration_seconds.count() << std::endl;
+    }
+  }
+  performance_result_.end = std::chrono::high_resolution_clock::now();
+  performance_result_.average_CPU_usage = p_ICPUUsage->GetUsage();
+  performance_result_.peak_workingset_size = utils::GetPeakWorkingSetSize();
+
+  const size_t num_sessions = performance_result_.time_costs.size();
+  std::vector<double> sorted_time = performance_result_.time_costs;
+  std::sort(sorted_time.begin(), sorted_time.end());
+  const double average_time = performance_result_.total_time_cost / num_sessions;
+
+  std::ostringstream summary;
+  summary << "First session creation time cost: " << first_session_create_duration.count() << " s\n"
+          << "Session creations: " << num_sessions << "\n"
+          << "Average session creation time cost: " << average_time * 1000 << " ms\n"
+          << "Min session creation time cost: " << sorted_time.front() * 1000 << " ms\n"
+          << "P50 session creation time cost: " << sorted_time[static_cast<size_t>(num_sessions * 0.5)] * 1000
+          << " ms\n"
+          << "P90 session creation time cost: " << sorted_time[static_cast<size_t>(num_sessions * 0.9)] * 1000
+          << " ms\n"
+          << "Max session creation time cost: " << sorted_time.back() * 1000 << " ms\n"
+          << "Peak working set size after the first session creation: " << first_peak_workingset_size << " bytes\n"
+          << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes\n";
+
+  // phases nest, e.g. the graph transformers run within session_initialization, so their shares do not add up
+  std::vector<std::pair<std::string, double>> phases(phase_durations.begin(), phase_durations.end());
+  std::sort(phases.begin(), phases.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+  summary << "Average time of each initialization phase:\n";
+  for (const auto& phase : phases) {
+    const double phase_ms = phase.second / num_sessions / 1000.0;
+    summary << "  " << phase.first << ": " << phase_ms << " ms (" << phase_ms / (average_time * 1000) * 100
+            << " % of session creation)\n";
+  }
+  std::cout << summary.str() << std::flush;
+
+  return Status::OK();
+}
+
 bool PerformanceRunner::Initialize() {
   std::basic_string<PATH_CHAR_TYPE> test_case_dir;
   auto st = GetDirNameFromFilePath(performance_test_config_.model_info.model_file_path, test_case_dir);
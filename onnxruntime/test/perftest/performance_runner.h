@@ -10,6 +10,7 @@
 #include <iostream>
 #include <random>
 #include <chrono>
+#include <utility>
 // onnxruntime dependencies
 #include <core/common/common.h>
 #include <core/common/status.h>
@@ -17,6 +18,7 @@
 #include <core/platform/ort_mutex.h>
 #include <core/session/onnxruntime_cxx_api.h>
 #include "test_configuration.h"
+#include "latency_histogram.h"
 #include "heap_buffer.h"
 #include "test_session.h"
 #include "OrtValueList.h"
@@ -39,6 +41,23 @@ struct PerformanceResult {
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
 };
 
+// The result of running the test at one point of a free dimension sweep.
+struct SweepPointResult {
+  std::string model_path;
+  std::vector<std::pair<std::string, int64_t>> free_dims;
+  size_t num_runs{0};
+  double throughput{0};  // runs per second
+  double mean_latency{0};  // seconds
+  double p50_latency{0};
+  double p90_latency{0};
+  double p99_latency{0};
+};
+
+// Writes the sweep results as a matrix with a column for each swept dimension, as JSON if path ends with .json and
+// CSV otherwise. An empty path writes CSV to the standard output.
+Status WriteSweepResults(const std::basic_string<ORTCHAR_T>& path, const RunConfig& run_config,
+                         const std::vector<SweepPointResult>& results);
+
 class PerformanceRunner {
  public:
   PerformanceRunner(Ort::Env& env, const PerformanceTestConfig& test_config, std::random_device& rd);
@@ -48,6 +67,8 @@ class PerformanceRunner {
 
   inline const PerformanceResult& GetResult() const { return performance_result_; }
 
+  inline const std::vector<SweepPointResult>& GetSweepResults() const { return sweep_results_; }
+
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
@@ -88,6 +109,22 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status Warmup();
+
+  // Sends requests at the given rate for the given duration, regardless of how long earlier requests take, so
+  // that the latency includes the time a request waited behind slower ones. Measured latencies go to histogram
+  // and to performance_result_ unless histogram is null.
+  struct OpenLoopResult {
+    size_t num_requests{0};
+    double achieved_qps{0.0};
+    short average_CPU_usage{0};
+  };
+  Status RunOpenLoop(double target_qps, double duration_in_seconds, LatencyHistogram* histogram,
+                     OpenLoopResult& result);
+  Status OpenLoopTest();
+  Status RunTest();
+  Status SweepTest();
+  Status SessionInitializationTest();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -104,6 +141,7 @@ class PerformanceRunner {
   }
 
  private:
+  Ort::Env& env_;
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_start_;
   std::chrono::time_point<std::chrono::high_resolution_clock> session_create_end_;
   PerformanceResult initial_inference_result_;
@@ -113,6 +151,7 @@ class PerformanceRunner {
   std::unique_ptr<TestSession> session_;
   onnxruntime::test::HeapBuffer b_;
   std::unique_ptr<ITestCase> test_case_;
+  std::vector<SweepPointResult> sweep_results_;
 
   OrtMutex results_mutex_;
 };
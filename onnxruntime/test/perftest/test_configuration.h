@@ -6,6 +6,8 @@
 #include <map>
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -15,7 +17,15 @@ namespace perftest {
 
 enum class TestMode : std::uint8_t {
   kFixDurationMode = 0,
-  KFixRepeatedTimesMode
+  KFixRepeatedTimesMode,
+  kOpenLoopMode,
+  kSessionInitializationMode
+};
+
+// How the open loop mode spaces the requests it sends.
+enum class ArrivalProcess : std::uint8_t {
+  kPoisson = 0,
+  kConstant
 };
 
 enum class Platform : std::uint8_t {
@@ -28,6 +38,8 @@ struct ModelInfo {
   std::basic_string<ORTCHAR_T> model_file_path;
   std::basic_string<ORTCHAR_T> input_file_path;
   std::basic_string<ORTCHAR_T> result_file_path;
+  // models benchmarked concurrently with model_file_path, sharing the env and its thread pools
+  std::vector<std::basic_string<ORTCHAR_T>> concurrent_model_file_paths;
 };
 
 struct MachineConfig {
@@ -41,6 +53,12 @@ struct RunConfig {
   size_t repeated_times{1000};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // open loop mode: the request rate of the first step, and the last rate and increment of an optional sweep
+  double target_qps{0.0};
+  double qps_sweep_end{0.0};
+  double qps_sweep_step{0.0};
+  ArrivalProcess arrival_process{ArrivalProcess::kPoisson};
+  size_t warmup_seconds{0};
   bool f_dump_statistics{false};
   int random_seed_for_input_data{-1};
   bool f_verbose{false};
@@ -61,6 +79,11 @@ struct RunConfig {
   std::string intra_op_thread_affinities;
   bool disable_spinning = false;
   bool disable_spinning_between_run = false;
+  // free dimensions of the generated inputs to sweep, by name, and the values they take
+  std::vector<std::pair<std::string, std::vector<int64_t>>> free_dim_sweeps;
+  // the file the latency and throughput matrix of a sweep is written to, as JSON if it ends with .json, else CSV
+  std::basic_string<ORTCHAR_T> sweep_result_file;
+  bool use_global_thread_pools = false;
 };
 
 struct PerformanceTestConfig {
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/platform/threadpool.h"
+#include "core/common/parallel_for_calibration.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
 #include "core/util/thread_utils.h"
@@ -12,8 +13,15 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <memory>
+#include <chrono>
 #include <functional>
+#include <future>
+#include <set>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -229,6 +237,37 @@ void TestStagedMultiLoopSections(const std::string& name, int num_threads, int n
   }
 }
 
+// Test parallel sections and loops nested in the loops of a parallel
+// section, as run by the kernels of control-flow subgraphs.
+void TestNestedParallelSections(const std::string& name, int num_threads, int num_loops) {
+  for (int rep = 0; rep < 5; rep++) {
+    constexpr int num_outer_tasks = 4;
+    constexpr int num_inner_tasks = 256;
+    auto test_data = CreateTestData(num_outer_tasks * num_inner_tasks);
+    CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+      ThreadPool::ParallelSection ps(tp);
+      for (int l = 0; l < num_loops; l++) {
+        ThreadPool::TrySimpleParallelFor(tp, num_outer_tasks, [&](std::ptrdiff_t outer) {
+          // a nested section with several loops, then a nested loop outside of it
+          {
+            ThreadPool::ParallelSection nested_ps(tp);
+            ThreadPool::TrySimpleParallelFor(tp, num_inner_tasks / 2, [&](std::ptrdiff_t inner) {
+              IncrementElement(*test_data, outer * num_inner_tasks + inner);
+            });
+            ThreadPool::TrySimpleParallelFor(tp, num_inner_tasks / 2, [&](std::ptrdiff_t inner) {
+              IncrementElement(*test_data, outer * num_inner_tasks + num_inner_tasks / 2 + inner);
+            });
+          }
+          ThreadPool::TrySimpleParallelFor(tp, num_inner_tasks, [&](std::ptrdiff_t inner) {
+            IncrementElement(*test_data, outer * num_inner_tasks + inner);
+          });
+        });
+      }
+    });
+    ValidateTestData(*test_data, 2 * num_loops);
+  }
+}
+
 }  // namespace
 
 namespace onnxruntime {
@@ -510,6 +549,227 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestNestedParallelSections_4Thread_10Loop) {
+  TestNestedParallelSections("TestNestedParallelSections_4Thread_10Loop", 4, 10);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelSections_8Thread_10Loop) {
+  TestNestedParallelSections("TestNestedParallelSections_8Thread_10Loop", 8, 10);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(ThreadPoolTest, TestProfilingStats) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4, false);
+  ThreadPool::StartProfiling(tp.get());
+  auto test_data = CreateTestData(1000);
+  ThreadPool::TryParallelFor(tp.get(), 1000, 1000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (auto i = first; i < last; i++) {
+      IncrementElement(*test_data, i);
+    }
+  });
+  ValidateTestData(*test_data);
+  const std::string stats = ThreadPool::StopProfiling(tp.get());
+  for (const char* stat : {"\"num_tasks\": ", "\"MaxWait\": ", "\"num_steal\": ", "\"num_spin_wake\": ",
+                           "\"num_block\": "}) {
+    ASSERT_NE(stats.find(stat), std::string::npos) << stat << " missing in " << stats;
+  }
+  ASSERT_EQ(stats.find("\"num_tasks\": 0,"), std::string::npos) << stats;
+}
+#endif
+
+TEST(ThreadPoolTest, TestAdaptiveSpinPolicy) {
+  concurrency::AdaptiveSpinPolicy policy;
+  policy.RecordWakeLatency(50);
+
+  // gaps shorter than the wake-up latency: spin for at most the latency
+  for (int i = 0; i < 100; i++) {
+    policy.RecordIdleGap(5);
+  }
+  ASSERT_GT(policy.SpinLimitMicros(), 0u);
+  ASSERT_LE(policy.SpinLimitMicros(), 100u);
+
+  // once most gaps are long: block right away
+  for (int i = 0; i < 1000; i++) {
+    policy.RecordIdleGap(10000);
+  }
+  ASSERT_EQ(policy.SpinLimitMicros(), 0u);
+
+  // and spin again when the gaps get short again
+  for (int i = 0; i < 1000; i++) {
+    policy.RecordIdleGap(1);
+  }
+  ASSERT_GT(policy.SpinLimitMicros(), 0u);
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.adaptive_spinning = true;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 4, false);
+  for (int run = 0; run < 10; run++) {
+    auto test_data = CreateTestData(1000);
+    ThreadPool::TryParallelFor(tp.get(), 1000, 1000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (auto i = first; i < last; i++) {
+        IncrementElement(*test_data, i);
+      }
+    });
+    ValidateTestData(*test_data);
+    std::this_thread::sleep_for(std::chrono::milliseconds(run % 2 == 0 ? 0 : 2));
+  }
+}
+
+TEST(ThreadPoolTest, TestParallelForCalibration) {
+  ParallelForCalibration calibration;
+  const TensorOpCost estimate{0, 0, 1.0};
+  for (uint32_t i = 0; i < ParallelForCalibration::kMinSamples; i++) {
+    ASSERT_EQ(calibration.GetCost("call_site", estimate).compute_cycles, 1.0);
+    ASSERT_TRUE(calibration.ShouldSample("call_site"));
+    calibration.RecordSample("call_site", 100, 10000);
+  }
+
+  // 100ns per unit once there are enough samples
+  const auto calibrated = calibration.GetCost("call_site", estimate);
+  ASSERT_GT(calibrated.compute_cycles, 1.0);
+  ASSERT_EQ(calibration.GetCost("other_call_site", estimate).compute_cycles, 1.0);
+
+  // only some of the later calls are timed
+  int num_sampled = 0;
+  for (uint32_t i = 0; i < ParallelForCalibration::kSampleInterval; i++) {
+    num_sampled += calibration.ShouldSample("call_site") ? 1 : 0;
+  }
+  ASSERT_EQ(num_sampled, 1);
+
+  const onnxruntime::PathString path = ORT_TSTR("parallel_for_calibration_test.txt");
+  ASSERT_TRUE(calibration.Save(path).IsOK());
+  ParallelForCalibration loaded;
+  ASSERT_TRUE(loaded.Load(path).IsOK());
+  std::remove(onnxruntime::PathToUTF8String(path).c_str());
+  ASSERT_DOUBLE_EQ(loaded.GetCost("call_site", estimate).compute_cycles, calibrated.compute_cycles);
+}
+
+TEST(ThreadPoolTest, TestCalibratedParallelFor) {
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.calibrate_parallel_for_costs = true;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 4, false);
+  for (int run = 0; run < 40; run++) {
+    auto test_data = CreateTestData(1000);
+    ThreadPool::TryParallelFor(tp.get(), 1000, 1000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (auto i = first; i < last; i++) {
+        IncrementElement(*test_data, i);
+      }
+    });
+    ValidateTestData(*test_data);
+  }
+}
+
+TEST(ThreadPoolTest, TestWorkShare) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr, 4, false);
+  ASSERT_EQ(tp->NumThreads() + 1, 4);
+
+  auto count_threads_used = [&]() {
+    onnxruntime::OrtMutex mutex;
+    std::set<std::thread::id> thread_ids;
+    ThreadPool::TrySimpleParallelFor(tp.get(), 64, [&](std::ptrdiff_t) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      std::lock_guard<onnxruntime::OrtMutex> lock(mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    });
+    return thread_ids.size();
+  };
+
+  // another session with 3 times the weight takes 3 of the 4 threads
+  std::promise<void> other_started;
+  std::promise<void> done;
+  std::thread other([&]() {
+    ThreadPool::WorkShareScope scope(tp.get(), ThreadPool::WorkShare{3, 0});
+    other_started.set_value();
+    done.get_future().wait();
+  });
+  other_started.get_future().wait();
+
+  {
+    ThreadPool::WorkShareScope scope(tp.get(), ThreadPool::WorkShare{1, 0});
+    ASSERT_EQ(count_threads_used(), 1u);
+
+    // nested scopes of the same pool have no effect
+    ThreadPool::WorkShareScope nested_scope(tp.get(), ThreadPool::WorkShare{3, 0});
+    ASSERT_EQ(count_threads_used(), 1u);
+  }
+
+  {
+    ThreadPool::WorkShareScope scope(tp.get(), ThreadPool::WorkShare{1, 2});
+    ASSERT_LE(count_threads_used(), 2u);
+  }
+
+  done.set_value();
+  other.join();
+}
+
+namespace {
+
+// Scheduler running each batch of tasks on new threads, counting the tasks it runs.
+struct TestScheduler {
+  std::atomic<size_t> num_tasks{0};
+  std::vector<std::thread> scheduled_threads;
+
+  static void RunTasks(void* state, OrtCustomSchedulerTaskFn task_fn, void* ort_task_param, size_t num_tasks) {
+    auto& scheduler = *static_cast<TestScheduler*>(state);
+    scheduler.num_tasks += num_tasks;
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_tasks; i++) {
+      threads.emplace_back(task_fn, ort_task_param, i);
+    }
+    task_fn(ort_task_param, 0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  static void Schedule(void* state, OrtCustomSchedulerTaskFn task_fn, void* ort_task_param) {
+    auto& scheduler = *static_cast<TestScheduler*>(state);
+    ++scheduler.num_tasks;
+    scheduler.scheduled_threads.emplace_back(task_fn, ort_task_param, 0);
+  }
+};
+
+}  // namespace
+
+TEST(ThreadPoolTest, TestCustomScheduler) {
+  TestScheduler test_scheduler;
+  OrtCustomScheduler scheduler{};
+  scheduler.version = ORT_API_VERSION;
+  scheduler.scheduler_state = &test_scheduler;
+  scheduler.degree_of_parallelism = 4;
+  scheduler.RunTasks = TestScheduler::RunTasks;
+  scheduler.Schedule = TestScheduler::Schedule;
+  ASSERT_TRUE(onnxruntime::concurrency::ValidateCustomScheduler(&scheduler).IsOK());
+
+  OrtThreadPoolParams params;
+  params.custom_scheduler = scheduler;
+  auto tp = onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(), params,
+                                                       onnxruntime::concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(tp, nullptr);
+  ASSERT_EQ(tp->NumThreads(), 3);
+
+  auto test_data = CreateTestData(1000);
+  ThreadPool::TryParallelFor(tp.get(), 1000, 1000.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (auto i = first; i < last; i++) {
+      IncrementElement(*test_data, i);
+    }
+  });
+  ValidateTestData(*test_data);
+  ASSERT_GT(test_scheduler.num_tasks, 1u);
+
+  std::promise<void> scheduled;
+  ThreadPool::Schedule(tp.get(), [&]() { scheduled.set_value(); });
+  scheduled.get_future().wait();
+  for (auto& thread : test_scheduler.scheduled_threads) {
+    thread.join();
+  }
+
+  scheduler.RunTasks = nullptr;
+  ASSERT_FALSE(onnxruntime::concurrency::ValidateCustomScheduler(&scheduler).IsOK());
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
@@ -613,6 +873,58 @@ TEST(ThreadPoolTest, TestAffinityStringWellShaped) {
   }
 }
 
+TEST(ThreadPoolTest, TestPerformanceCoresOnly) {
+  OrtThreadPoolParams tp_params;
+  tp_params.performance_cores_only = true;
+  auto default_tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                  tp_params,
+                                                  concurrency::ThreadPoolType::INTRA_OP);
+  const auto efficiency_processors = Env::Default().GetEfficiencyCoreProcessors();
+  if (efficiency_processors.empty() && default_tp) {
+    // not a hybrid cpu, a thread is created per physical core as usual
+    ASSERT_EQ(default_tp->NumThreads() + 1, static_cast<int>(Env::Default().GetDefaultThreadAffinities().size()));
+  }
+
+  // an explicit thread pool size is kept whether or not there are enough performance cores
+  tp_params.thread_pool_size = 3;
+  auto non_default_tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                      tp_params,
+                                                      concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(non_default_tp, nullptr);
+  ASSERT_EQ(non_default_tp->NumThreads(), 2);
+}
+
+TEST(ThreadPoolTest, TestAffinityPreset) {
+  const auto cores = Env::Default().GetDefaultThreadAffinities();
+  if (cores.size() < 4 || cores.front().empty()) {
+    return;
+  }
+
+  OrtThreadPoolParams tp_params;
+  tp_params.affinity_preset = "physical_cores,skip_smt";
+  auto default_tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                  tp_params,
+                                                  concurrency::ThreadPoolType::INTRA_OP);
+  ASSERT_NE(default_tp, nullptr);
+  ASSERT_EQ(default_tp->NumThreads() + 1, static_cast<int>(cores.size()));
+
+  // the cores reserved for another pool are skipped
+  tp_params.affinity_preset_reserved_cores = 2;
+  auto reserved_tp = concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                   tp_params,
+                                                   concurrency::ThreadPoolType::INTER_OP);
+  ASSERT_NE(reserved_tp, nullptr);
+  ASSERT_EQ(reserved_tp->NumThreads() + 3, static_cast<int>(cores.size()));
+
+#ifndef ORT_NO_EXCEPTIONS
+  tp_params.affinity_preset = "physical_cores,unknown";
+  ASSERT_THROW(concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                             tp_params,
+                                             concurrency::ThreadPoolType::INTRA_OP),
+               std::exception);
+#endif
+}
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestDefaultAffinity) {
   test::CpuGroup cpu_group = {{0, 1},
@@ -19,6 +19,8 @@
 #include "test/providers/provider_test_utils.h"
 #endif  // !(ORT_MINIMAL_BUILD)
 
+#include <filesystem>
+
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -167,6 +169,41 @@ TEST(CoreMLExecutionProviderTest, ShapeThenSliceAndGather) {
 #endif
 }
 
+#if defined(__APPLE__)
+TEST(CoreMLExecutionProviderTest, CompiledModelCache) {
+  const auto model_file_name = ORT_TSTR("testdata/shape_then_slice_and_gather.onnx");
+  const auto cache_dir = std::filesystem::temp_directory_path() / "ort_coreml_compiled_model_cache_test";
+  std::filesystem::remove_all(cache_dir);
+
+  RandomValueGenerator gen{1234};
+  std::vector<int64_t> X_shape = {5, 3, 4, 1, 2};
+  std::vector<float> X_data = gen.Uniform<float>(X_shape, 0.0f, 1.0f);
+  OrtValue X = CreateInputOrtValueOnCPU<float>(X_shape, X_data);
+
+  const auto num_cached_models = [&cache_dir]() {
+    return std::distance(std::filesystem::directory_iterator(cache_dir), std::filesystem::directory_iterator{});
+  };
+
+  // the first session compiles and caches the model, the second one loads it from the cache
+  for (int i = 0; i < 2; ++i) {
+    RunAndVerifyOutputsWithEP(model_file_name, CurrentTestName(),
+                              std::make_unique<CoreMLExecutionProvider>(s_coreml_flags, cache_dir.string()),
+                              {{"X", X}},
+                              EPVerificationParams{ExpectedEPNodeAssignment::All});
+    ASSERT_EQ(num_cached_models(), 1);
+  }
+
+  // a model compiled with different flags is cached separately
+  RunAndVerifyOutputsWithEP(model_file_name, CurrentTestName(),
+                            std::make_unique<CoreMLExecutionProvider>(COREML_FLAG_USE_NONE, cache_dir.string()),
+                            {{"X", X}},
+                            EPVerificationParams{ExpectedEPNodeAssignment::All});
+  ASSERT_EQ(num_cached_models(), 2);
+
+  std::filesystem::remove_all(cache_dir);
+}
+#endif
+
 #endif  // !(ORT_MINIMAL_BUILD)
 
 TEST(CoreMLExecutionProviderTest, TestOrtFormatModel) {
@@ -247,5 +247,67 @@ TEST(CumSumTest, _1DTestdouble_WithInt64Axis) {
   test.AddOutput<double>("y", {5}, {1., 3., 6., 10., 15.});
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _1DTestLongAxis) {
+  // long enough for the scan to be split into blocks across threads
+  constexpr int64_t dim = 100003;
+  std::vector<int64_t> x(dim);
+  for (int64_t i = 0; i < dim; ++i) {
+    x[i] = i % 7 - 3;
+  }
+
+  for (int64_t exclusive = 0; exclusive <= 1; ++exclusive) {
+    for (int64_t reverse = 0; reverse <= 1; ++reverse) {
+      std::vector<int64_t> y(dim);
+      int64_t sum = 0;
+      for (int64_t k = 0; k < dim; ++k) {
+        const int64_t i = reverse ? dim - 1 - k : k;
+        if (exclusive) {
+          y[i] = sum;
+          sum += x[i];
+        } else {
+          sum += x[i];
+          y[i] = sum;
+        }
+      }
+
+      OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+      test.AddAttribute<int64_t>("exclusive", exclusive);
+      test.AddAttribute<int64_t>("reverse", reverse);
+      test.AddInput<int64_t>("x", {dim}, x);
+      test.AddInput<int32_t>("axis", {}, {0});
+      test.AddOutput<int64_t>("y", {dim}, y);
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+    }
+  }
+}
+TEST(CumSumTest, _3DTestMiddleAxisManyLanes) {
+  constexpr int64_t outer = 3;
+  constexpr int64_t dim = 17;
+  constexpr int64_t inner = 65;
+  std::vector<float> x(outer * dim * inner);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<float>(i % 11);
+  }
+
+  std::vector<float> y(x.size());
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t i = 0; i < inner; ++i) {
+      float sum = 0.f;
+      for (int64_t j = dim - 1; j >= 0; --j) {
+        const int64_t index = (o * dim + j) * inner + i;
+        y[index] = sum;
+        sum += x[index];
+      }
+    }
+  }
+
+  OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+  test.AddAttribute<int64_t>("exclusive", 1);
+  test.AddAttribute<int64_t>("reverse", 1);
+  test.AddInput<float>("x", {outer, dim, inner}, x);
+  test.AddInput<int32_t>("axis", {}, {1});
+  test.AddOutput<float>("y", {outer, dim, inner}, y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
 }  // namespace test
 }  // namespace onnxruntime
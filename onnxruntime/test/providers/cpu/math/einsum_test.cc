@@ -245,6 +245,39 @@ TEST(Einsum, ExplicitEinsumAsBatchedMatmul) {
   test.Run();
 }
 
+TEST(Einsum, ExplicitEinsumAsBatchedMatmulTransposeB_Attention) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "bhqd,bhkd->bhqk");
+  test.AddInput<float>("x", {1, 2, 3, 4}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f,
+                                           13.f, 14.f, 15.f, 16.f, 17.f, 18.f, 19.f, 20.f, 21.f, 22.f, 23.f, 24.f});
+  test.AddInput<float>("y", {1, 2, 2, 4}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f,
+                                           13.f, 14.f, 15.f, 16.f});
+  test.AddOutput<float>("o", {1, 2, 3, 2}, {30.f, 70.f, 70.f, 174.f, 110.f, 278.f,
+                                            614.f, 846.f, 782.f, 1078.f, 950.f, 1310.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsBatchedMatmulTransposeB_Attention_double) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "...qd,...kd->...qk");
+  test.AddInput<double>("x", {1, 2, 3, 4}, {1., 2., 3., 4., 5., 6., 7., 8., 9., 10., 11., 12.,
+                                            13., 14., 15., 16., 17., 18., 19., 20., 21., 22., 23., 24.});
+  test.AddInput<double>("y", {1, 2, 2, 4}, {1., 2., 3., 4., 5., 6., 7., 8., 9., 10., 11., 12.,
+                                            13., 14., 15., 16.});
+  test.AddOutput<double>("o", {1, 2, 3, 2}, {30., 70., 70., 174., 110., 278.,
+                                             614., 846., 782., 1078., 950., 1310.});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsBatchedMatmulOutputTransposed) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "bij,bjk->bki");
+  test.AddInput<float>("x", {2, 2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddInput<float>("y", {2, 3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddOutput<float>("o", {2, 2, 2}, {22.f, 49.f, 28.f, 64.f, 220.f, 301.f, 244.f, 334.f});
+  test.Run();
+}
+
 TEST(Einsum, ExplicitEinsumAsBatchedMatmulWithBroadcasting_0) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
   test.AddAttribute<std::string>("equation", "...ij,...jk->...ik");
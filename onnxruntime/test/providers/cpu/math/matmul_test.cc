@@ -8,6 +8,7 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "default_providers.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 
 namespace onnxruntime {
 namespace test {
@@ -292,8 +293,91 @@ TEST(MathOpTest, MatMul_bfloat16) {
 }
 #endif
 
+// The inputs are small integers, which bfloat16 represents exactly, so the bfloat16 mixed precision MatMul is exact
+// on processors that support it, and so is the fp32 MatMul it falls back to elsewhere.
+TEST(MathOpTest, MatMulBf16MixedPrecision) {
+  constexpr int64_t M = 20, K = 24, N = 17;
+
+  auto run_test = [&](int64_t a_batch, int64_t b_batch) {
+    const int64_t batch = std::max(a_batch, b_batch);
+    std::vector<float> a_vals(a_batch * M * K);
+    for (size_t i = 0; i < a_vals.size(); i++) {
+      a_vals[i] = static_cast<float>(static_cast<int>(i * 7 % 9) - 4);
+    }
+    std::vector<float> b_vals(b_batch * K * N);
+    for (size_t i = 0; i < b_vals.size(); i++) {
+      b_vals[i] = static_cast<float>(static_cast<int>(i * 5 % 7) - 3);
+    }
+
+    std::vector<float> expected_vals(batch * M * N, 0.0f);
+    for (int64_t b = 0; b < batch; b++) {
+      const float* a = a_vals.data() + (a_batch == 1 ? 0 : b) * M * K;
+      const float* b_mat = b_vals.data() + (b_batch == 1 ? 0 : b) * K * N;
+      for (int64_t m = 0; m < M; m++) {
+        for (int64_t n = 0; n < N; n++) {
+          for (int64_t k = 0; k < K; k++) {
+            expected_vals[(b * M + m) * N + n] += a[m * K + k] * b_mat[k * N + n];
+          }
+        }
+      }
+    }
+
+    OpTester test("MatMul", 13);
+    test.AddInput<float>("A", {a_batch, M, K}, a_vals);
+    test.AddInput<float>("B", {b_batch, K, N}, b_vals);
+    test.AddOutput<float>("Y", {batch, M, N}, expected_vals);
+
+    CPUExecutionProviderInfo info;
+    info.enable_bf16_mixed_precision = true;
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+
+  run_test(3, 3);
+  run_test(3, 1);
+  run_test(1, 2);
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
+TEST(MathOpTest, MatMulSparse24Initializer) {
+  constexpr int64_t M = 5, K = 22, N = 19;
+
+  RandomValueGenerator random{1234};
+  std::vector<float> a_vals(random.Gaussian<float>(std::vector<int64_t>({M, K}), 0.0f, 1.0f));
+  std::vector<float> b_vals(random.Gaussian<float>(std::vector<int64_t>({K, N}), 0.0f, 1.0f));
+  // keep two values of each column in every group of 4 rows
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      if ((k + n) % 4 >= 2) {
+        b_vals[k * N + n] = 0.0f;
+      }
+    }
+  }
+
+  std::vector<float> expected_vals(M * N, 0.0f);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        expected_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<float>("A", {M, K}, a_vals);
+  test.AddInput<float>("B", {K, N}, b_vals, true);
+  test.AddOutput<float>("Y", {M, N}, expected_vals);
+  test.SetOutputAbsErr("Y", 0.0001f);
+
+  CPUExecutionProviderInfo info;
+  info.enable_sparse24_gemm = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(MathOpTest, MatMulSharedPrepackedWeights) {
   OpTester test("MatMul");
 
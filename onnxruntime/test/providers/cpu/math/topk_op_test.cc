@@ -792,6 +792,43 @@ TEST(TopKOperator, BigArrayBigTopKSorted_double) {
   RunTest(11, 9000, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, 0, 1, 1);
 }
 
+// test path where the top k of long float rows is selected by radix, with duplicated, negative and signed zero
+// values so the ties are broken on the index
+static void top_k_radix_select(int64_t largest, int64_t sorted) {
+  constexpr int64_t rows = 2;
+  constexpr int64_t cols = 2048;
+  constexpr int64_t k = 700;
+
+  std::vector<float> input_vals(rows * cols);
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    const int64_t v = (i * 7919) % 37 - 18;
+    input_vals[i] = v == 0 ? (i % 2 ? -0.0f : 0.0f) : static_cast<float>(v) * 0.25f;
+  }
+
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t r = 0; r < rows; ++r) {
+    const float* row = input_vals.data() + r * cols;
+    std::vector<int64_t> order(cols);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return largest ? row[a] > row[b] : row[a] < row[b];
+    });
+    for (int64_t i = 0; i < k; ++i) {
+      expected_vals.push_back(row[order[i]]);
+      expected_indices.push_back(order[i]);
+    }
+  }
+
+  RunTest(11, k, input_vals, {rows, cols}, expected_vals, expected_indices, {rows, k}, false, -1, largest, sorted);
+}
+
+TEST(TopKOperator, RadixSelect) {
+  top_k_radix_select(1, 1);
+  top_k_radix_select(0, 1);  // smallest
+  top_k_radix_select(1, 0);  // unsorted
+}
+
 template <typename T>
 static void top_3_all_same(int opset_version, int64_t largest = 1) {
   // whether it's largest or smallest we should pick the first instance/s of a number if there are multiple
@@ -43,5 +43,38 @@ TEST(CategoryMapper, IntToString) {
 
   RunTest(dims, input, output);
 }
+
+TEST(CategoryMapper, LargeVocabulary) {
+  // the last of duplicated categories wins
+  std::vector<std::string> categories;
+  std::vector<int64_t> indexes;
+  for (int64_t i = 0; i < 5000; ++i) {
+    categories.push_back("cat" + std::to_string(i));
+    indexes.push_back(i + 1);
+  }
+  categories.push_back("cat3");
+  indexes.push_back(-3);
+
+  std::vector<std::string> input;
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < 20000; ++i) {
+    const int64_t k = (i * 7919) % 6000;
+    input.push_back("cat" + std::to_string(k));
+    output.push_back(k == 3 ? -3 : (k < 5000 ? k + 1 : 99));
+  }
+
+  OpTester test("CategoryMapper", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("cats_strings", categories);
+  test.AddAttribute("cats_int64s", indexes);
+
+  test.AddAttribute("default_string", "default");
+  test.AddAttribute<int64_t>("default_int64", 99);
+
+  test.AddInput<std::string>("X", {20000}, input);
+  test.AddOutput<int64_t>("Y", {20000}, output);
+
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
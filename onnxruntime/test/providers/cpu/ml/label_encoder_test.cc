@@ -231,5 +231,39 @@ TEST(LabelEncoder, FloatToFloatOpset2) {
   test.Run();
 }
 
+TEST(LabelEncoder, StringToIntLargeVocabularyOpset2) {
+  // enough keys and inputs for the table to grow and the lookups to be split across threads,
+  // the first of duplicated keys wins
+  std::vector<std::string> keys;
+  std::vector<std::int64_t> values;
+  for (int64_t i = 0; i < 5000; ++i) {
+    keys.push_back("key" + std::to_string(i));
+    values.push_back(i * 3);
+  }
+  keys.push_back("key7");
+  values.push_back(-7);
+  keys.push_back("");
+  values.push_back(-1);
+
+  std::vector<std::string> input;
+  std::vector<std::int64_t> output;
+  for (int64_t i = 0; i < 20000; ++i) {
+    const int64_t k = (i * 7919) % 6000;
+    input.push_back(k == 5999 ? "" : "key" + std::to_string(k));
+    output.push_back(k == 5999 ? -1 : (k < 5000 ? k * 3 : 42));
+  }
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_strings", keys);
+  test.AddAttribute("values_int64s", values);
+  test.AddAttribute("default_int64", (std::int64_t)42);
+
+  test.AddInput<std::string>("X", {20000}, input);
+  test.AddOutput<std::int64_t>("Y", {20000}, output);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
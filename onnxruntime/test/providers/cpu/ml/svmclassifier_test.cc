@@ -263,5 +263,78 @@ TEST(MLOpTest, SVMClassifierLinear) {
   test.Run();
 }
 
+// Enough rows and classes for the kernels and the scores of the classifiers to be computed as gemms over all of them.
+TEST(MLOpTest, SVMClassifierSVCManyRows) {
+  OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+  constexpr int64_t n_rows = 600;
+  constexpr int64_t n_features = 4;
+  constexpr int64_t n_classes = 3;
+  const std::vector<int64_t> vectors_per_class = {2, 3, 1};
+  const std::vector<int64_t> starting_vector = {0, 2, 5};
+  constexpr int64_t n_vectors = 6;
+  constexpr float gamma = 0.3f;
+
+  std::vector<float> support_vectors;
+  for (int64_t k = 0; k < n_vectors * n_features; ++k) {
+    support_vectors.push_back(static_cast<float>((k * 7) % 11 - 5) * 0.25f);
+  }
+  // rho decides the votes, the kernels change the scores by less than 0.4
+  std::vector<float> coefficients;
+  for (int64_t k = 0; k < (n_classes - 1) * n_vectors; ++k) {
+    coefficients.push_back(static_cast<float>((k * 5) % 9 - 4) * 0.025f);
+  }
+  const std::vector<float> rho = {0.5f, -0.5f, 0.5f};
+  std::vector<float> X;
+  for (int64_t k = 0; k < n_rows * n_features; ++k) {
+    X.push_back(static_cast<float>((k * 13) % 17 - 8) * 0.2f);
+  }
+
+  std::vector<int64_t> predictions;
+  std::vector<float> scores;
+  for (int64_t r = 0; r < n_rows; ++r) {
+    std::vector<double> kernels;
+    for (int64_t v = 0; v < n_vectors; ++v) {
+      double sum = 0;
+      for (int64_t f = 0; f < n_features; ++f) {
+        const double d = X[r * n_features + f] - support_vectors[v * n_features + f];
+        sum += d * d;
+      }
+      kernels.push_back(std::exp(-gamma * sum));
+    }
+    std::vector<int64_t> votes(n_classes, 0);
+    size_t classifier = 0;
+    for (int64_t i = 0; i < n_classes - 1; ++i) {
+      for (int64_t j = i + 1; j < n_classes; ++j, ++classifier) {
+        double score = rho[classifier];
+        for (int64_t v = 0; v < vectors_per_class[i]; ++v) {
+          score += coefficients[(j - 1) * n_vectors + starting_vector[i] + v] * kernels[starting_vector[i] + v];
+        }
+        for (int64_t v = 0; v < vectors_per_class[j]; ++v) {
+          score += coefficients[i * n_vectors + starting_vector[j] + v] * kernels[starting_vector[j] + v];
+        }
+        scores.push_back(static_cast<float>(score));
+        ++votes[score > 0 ? i : j];
+      }
+    }
+    predictions.push_back(std::max_element(votes.begin(), votes.end()) - votes.begin());
+  }
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("vectors_per_class", vectors_per_class);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", std::vector<float>{gamma, 0.f, 3.f});
+  test.AddAttribute("classlabels_ints", std::vector<int64_t>{0, 1, 2});
+
+  test.AddInput<float>("X", {n_rows, n_features}, X);
+  test.AddOutput<int64_t>("Y", {n_rows}, predictions);
+  test.AddOutput<float>("Z", {n_rows, n_classes}, scores);
+  test.SetOutputAbsErr("Z", 0.0001f);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
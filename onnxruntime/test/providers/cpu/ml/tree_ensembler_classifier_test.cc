@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 
 namespace onnxruntime {
 namespace test {
@@ -367,5 +368,110 @@ TEST(MLOpTest, TreeEnsembleClassifierBinaryProbabilities) {
   test.Run();
 }
 
+// 24 complete trees of depth 3 on 3 features, enough shallow trees to be evaluated with QuickScorer, or with the
+// quantized trees if ep_info sets it. Node i of tree t tests feature (i + t) % 3 and has the children 2i+1 (true)
+// and 2i+2.
+void RunManyShallowTreesClassifierTest(const CPUExecutionProviderInfo* ep_info) {
+  constexpr int64_t n_trees = 24;
+  constexpr int64_t n_inner_nodes = 7;
+  constexpr int64_t n_features = 3;
+  constexpr int64_t n_classes = 3;
+  constexpr int64_t n_rows = 10;
+  auto threshold = [](int64_t t, int64_t i) { return static_cast<float>((i * 3 + t * 5) % 7 - 3) * 0.5f; };
+  auto missing_track = [](int64_t t, int64_t i) { return (i * 2 + t) % 5 == 0; };
+  auto class_weight = [](int64_t t, int64_t leaf, int64_t c) {
+    return 0.25f * static_cast<float>((leaf + 3 * c + t) % 5);
+  };
+
+  for (const std::string mode : {"BRANCH_LT", "BRANCH_GTE"}) {
+    OpTester test("TreeEnsembleClassifier", 3, onnxruntime::kMLDomain);
+    std::vector<int64_t> treeids, nodeids, featureids, lefts, rights, missing_tracks;
+    std::vector<float> thresholds;
+    std::vector<std::string> modes;
+    std::vector<int64_t> class_treeids, class_nodeids, class_ids;
+    std::vector<float> class_weights;
+    for (int64_t t = 0; t < n_trees; ++t) {
+      for (int64_t i = 0; i < 2 * n_inner_nodes + 1; ++i) {
+        const bool is_leaf = i >= n_inner_nodes;
+        treeids.push_back(t);
+        nodeids.push_back(i);
+        featureids.push_back(is_leaf ? 0 : (i + t) % n_features);
+        thresholds.push_back(is_leaf ? 0.f : threshold(t, i));
+        modes.push_back(is_leaf ? "LEAF" : mode);
+        lefts.push_back(is_leaf ? 0 : 2 * i + 1);
+        rights.push_back(is_leaf ? 0 : 2 * i + 2);
+        missing_tracks.push_back(!is_leaf && missing_track(t, i) ? 1 : 0);
+        for (int64_t c = 0; is_leaf && c < n_classes; ++c) {
+          class_treeids.push_back(t);
+          class_nodeids.push_back(i);
+          class_ids.push_back(c);
+          class_weights.push_back(class_weight(t, i - n_inner_nodes, c));
+        }
+      }
+    }
+
+    std::vector<float> X;
+    for (int64_t k = 0; k < n_rows * n_features; ++k) {
+      X.push_back(k % 8 == 6 ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>((k * 5) % 9 - 4) * 0.5f);
+    }
+    std::vector<int64_t> labels;
+    std::vector<float> scores;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      std::vector<float> row_scores(n_classes, 0.f);
+      for (int64_t t = 0; t < n_trees; ++t) {
+        int64_t i = 0;
+        while (i < n_inner_nodes) {
+          const float val = X[r * n_features + (i + t) % n_features];
+          const bool is_true = (mode == "BRANCH_LT" ? val < threshold(t, i) : val >= threshold(t, i)) ||
+                               (std::isnan(val) && missing_track(t, i));
+          i = is_true ? 2 * i + 1 : 2 * i + 2;
+        }
+        for (int64_t c = 0; c < n_classes; ++c) {
+          row_scores[c] += class_weight(t, i - n_inner_nodes, c);
+        }
+      }
+      labels.push_back(std::max_element(row_scores.begin(), row_scores.end()) - row_scores.begin());
+      scores.insert(scores.end(), row_scores.begin(), row_scores.end());
+    }
+
+    test.AddAttribute("nodes_truenodeids", lefts);
+    test.AddAttribute("nodes_falsenodeids", rights);
+    test.AddAttribute("nodes_treeids", treeids);
+    test.AddAttribute("nodes_nodeids", nodeids);
+    test.AddAttribute("nodes_featureids", featureids);
+    test.AddAttribute("nodes_values", thresholds);
+    test.AddAttribute("nodes_modes", modes);
+    test.AddAttribute("nodes_missing_value_tracks_true", missing_tracks);
+    test.AddAttribute("class_treeids", class_treeids);
+    test.AddAttribute("class_nodeids", class_nodeids);
+    test.AddAttribute("class_ids", class_ids);
+    test.AddAttribute("class_weights", class_weights);
+    test.AddAttribute("classlabels_int64s", std::vector<int64_t>{0, 1, 2});
+
+    test.AddInput<float>("X", {n_rows, n_features}, X);
+    test.AddOutput<int64_t>("Y", {n_rows}, labels);
+    test.AddOutput<float>("Z", {n_rows, n_classes}, scores);
+    if (ep_info == nullptr) {
+      test.Run();
+      continue;
+    }
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(std::make_unique<CPUExecutionProvider>(*ep_info));
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
+TEST(MLOpTest, TreeEnsembleClassifierManyShallowTrees) {
+  RunManyShallowTreesClassifierTest(nullptr);
+}
+
+TEST(MLOpTest, TreeEnsembleClassifierQuantized) {
+  // the weights are multiples of 0.25, exact in fp16
+  CPUExecutionProviderInfo info;
+  info.quantize_tree_ensembles = true;
+  info.tree_ensemble_exact_quantization = true;
+  RunManyShallowTreesClassifierTest(&info);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
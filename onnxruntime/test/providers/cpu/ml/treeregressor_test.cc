@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 
 namespace onnxruntime {
 namespace test {
@@ -760,5 +761,207 @@ TEST(MLOpTest, TreeRegressorTrueNodeBeforeNode) {
   test.Run();
 }
 
+// A chain of 40 nodes, deeper than the trees compiled for the branch free traversal, next to a compiled tree of
+// one node. The rows are more than a multiple of the rows traversed together.
+TEST(MLOpTest, TreeRegressorDeepAndShallowTrees) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+
+  constexpr int64_t chain_length = 40;
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids;
+  std::vector<float> nodes_values;
+  std::vector<std::string> nodes_modes;
+  std::vector<int64_t> target_treeids, target_nodeids;
+  std::vector<float> target_weights;
+  auto add_node = [&](int64_t tree_id, int64_t node_id, int64_t feature_id, float value, bool is_leaf,
+                      int64_t true_id, int64_t false_id) {
+    nodes_treeids.push_back(tree_id);
+    nodes_nodeids.push_back(node_id);
+    nodes_featureids.push_back(is_leaf ? 0 : feature_id);
+    nodes_values.push_back(is_leaf ? 0.f : value);
+    nodes_modes.push_back(is_leaf ? "LEAF" : "BRANCH_LEQ");
+    nodes_truenodeids.push_back(true_id);
+    nodes_falsenodeids.push_back(false_id);
+  };
+  auto add_leaf = [&](int64_t tree_id, int64_t node_id, float weight) {
+    add_node(tree_id, node_id, 0, 0.f, true, 0, 0);
+    target_treeids.push_back(tree_id);
+    target_nodeids.push_back(node_id);
+    target_weights.push_back(weight);
+  };
+
+  // node 2k tests x[0] <= k + 0.5 and leads to the leaf 2k + 1 of weight k
+  for (int64_t k = 0; k < chain_length; ++k) {
+    add_node(0, 2 * k, 0, static_cast<float>(k) + 0.5f, false, 2 * k + 1, 2 * k + 2);
+    add_leaf(0, 2 * k + 1, static_cast<float>(k));
+  }
+  add_leaf(0, 2 * chain_length, static_cast<float>(chain_length));
+
+  add_node(1, 0, 1, 0.f, false, 1, 2);
+  add_leaf(1, 1, 100.f);
+  add_leaf(1, 2, 200.f);
+
+  test.AddAttribute("nodes_truenodeids", nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", nodes_treeids);
+  test.AddAttribute("nodes_nodeids", nodes_nodeids);
+  test.AddAttribute("nodes_featureids", nodes_featureids);
+  test.AddAttribute("nodes_values", nodes_values);
+  test.AddAttribute("nodes_modes", nodes_modes);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", std::vector<int64_t>(target_nodeids.size(), 0));
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", static_cast<int64_t>(1));
+
+  const std::vector<float> x0 = {-1.f, 0.7f, 3.2f, 17.f, 38.9f, 39.2f, 50.f, 0.5f, 12.4f};
+  std::vector<float> X, Y;
+  for (size_t i = 0; i < x0.size(); ++i) {
+    const float x1 = (i % 2) ? 1.f : -1.f;
+    X.push_back(x0[i]);
+    X.push_back(x1);
+    const float chain_weight =
+        std::min(static_cast<float>(chain_length), std::max(0.f, std::ceil(x0[i] - 0.5f)));
+    Y.push_back(chain_weight + (x1 <= 0.f ? 100.f : 200.f));
+  }
+  test.AddInput<float>("X", {static_cast<int64_t>(x0.size()), 2}, X);
+  test.AddOutput<float>("Y", {static_cast<int64_t>(x0.size()), 1}, Y);
+  test.Run();
+}
+
+// Builds 24 complete trees of depth 3 on 3 features, enough shallow trees to be evaluated with QuickScorer, with
+// missing values tracked to the true branch of some nodes. Node i of tree t has the children 2i+1 (true) and 2i+2.
+struct ManyShallowTrees {
+  static constexpr int64_t kTrees = 24;
+  static constexpr int64_t kInnerNodes = 7;
+  static constexpr int64_t kFeatures = 3;
+
+  std::vector<int64_t> nodes_treeids, nodes_nodeids, nodes_featureids, nodes_truenodeids, nodes_falsenodeids,
+      nodes_missing_value_tracks_true;
+  std::vector<float> nodes_values;
+  std::vector<std::string> nodes_modes;
+
+  static int64_t Feature(int64_t t, int64_t i) { return (i + t) % kFeatures; }
+  static float Threshold(int64_t t, int64_t i) { return static_cast<float>((i * 5 + t * 3) % 7 - 3) * 0.5f; }
+  static bool MissingTrack(int64_t t, int64_t i) { return (i + t) % 4 == 0; }
+
+  explicit ManyShallowTrees(const std::string& mode) {
+    for (int64_t t = 0; t < kTrees; ++t) {
+      for (int64_t i = 0; i < 2 * kInnerNodes + 1; ++i) {
+        const bool is_leaf = i >= kInnerNodes;
+        nodes_treeids.push_back(t);
+        nodes_nodeids.push_back(i);
+        nodes_featureids.push_back(is_leaf ? 0 : Feature(t, i));
+        nodes_values.push_back(is_leaf ? 0.f : Threshold(t, i));
+        nodes_modes.push_back(is_leaf ? "LEAF" : mode);
+        nodes_truenodeids.push_back(is_leaf ? 0 : 2 * i + 1);
+        nodes_falsenodeids.push_back(is_leaf ? 0 : 2 * i + 2);
+        nodes_missing_value_tracks_true.push_back(!is_leaf && MissingTrack(t, i) ? 1 : 0);
+      }
+    }
+  }
+
+  // Returns the index of the leaf of tree t reached by x, from 0 to 7.
+  static int64_t Leaf(const std::string& mode, int64_t t, const float* x) {
+    int64_t i = 0;
+    while (i < kInnerNodes) {
+      const float val = x[Feature(t, i)];
+      const float threshold = Threshold(t, i);
+      bool is_true = mode == "BRANCH_LEQ"  ? val <= threshold
+                     : mode == "BRANCH_LT" ? val < threshold
+                     : mode == "BRANCH_GTE" ? val >= threshold
+                                            : val > threshold;
+      is_true = is_true || (std::isnan(val) && MissingTrack(t, i));
+      i = is_true ? 2 * i + 1 : 2 * i + 2;
+    }
+    return i - kInnerNodes;
+  }
+
+  // Rows on the grid of the thresholds, some of them missing.
+  static std::vector<float> Inputs(int64_t n_rows) {
+    std::vector<float> X;
+    for (int64_t k = 0; k < n_rows * kFeatures; ++k) {
+      X.push_back(k % 7 == 5 ? std::numeric_limits<float>::quiet_NaN() : static_cast<float>((k * 4) % 9 - 4) * 0.5f);
+    }
+    return X;
+  }
+};
+
+// Runs the trees on the CPU execution provider created from ep_info if it isn't null, weight_step is added to the
+// weights of each tree after the first one.
+void RunManyShallowTreesRegressorTest(const std::string& mode, const CPUExecutionProviderInfo* ep_info = nullptr,
+                                      float weight_step = 0.f) {
+  OpTester test("TreeEnsembleRegressor", 3, onnxruntime::kMLDomain);
+  ManyShallowTrees trees(mode);
+
+  std::vector<int64_t> target_treeids, target_nodeids;
+  std::vector<float> target_weights;
+  for (int64_t t = 0; t < ManyShallowTrees::kTrees; ++t) {
+    for (int64_t leaf = 0; leaf <= ManyShallowTrees::kInnerNodes; ++leaf) {
+      target_treeids.push_back(t);
+      target_nodeids.push_back(ManyShallowTrees::kInnerNodes + leaf);
+      target_weights.push_back(static_cast<float>(t % 5) + 0.25f * static_cast<float>(leaf) +
+                               weight_step * static_cast<float>(t));
+    }
+  }
+
+  constexpr int64_t n_rows = 12;
+  const std::vector<float> X = ManyShallowTrees::Inputs(n_rows);
+  std::vector<float> Y;
+  for (int64_t r = 0; r < n_rows; ++r) {
+    float y = 0.f;
+    for (int64_t t = 0; t < ManyShallowTrees::kTrees; ++t) {
+      const int64_t leaf = ManyShallowTrees::Leaf(mode, t, X.data() + r * ManyShallowTrees::kFeatures);
+      y += static_cast<float>(t % 5) + 0.25f * static_cast<float>(leaf) + weight_step * static_cast<float>(t);
+    }
+    Y.push_back(y);
+  }
+
+  test.AddAttribute("nodes_truenodeids", trees.nodes_truenodeids);
+  test.AddAttribute("nodes_falsenodeids", trees.nodes_falsenodeids);
+  test.AddAttribute("nodes_treeids", trees.nodes_treeids);
+  test.AddAttribute("nodes_nodeids", trees.nodes_nodeids);
+  test.AddAttribute("nodes_featureids", trees.nodes_featureids);
+  test.AddAttribute("nodes_values", trees.nodes_values);
+  test.AddAttribute("nodes_modes", trees.nodes_modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", trees.nodes_missing_value_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", std::vector<int64_t>(target_nodeids.size(), 0));
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", static_cast<int64_t>(1));
+
+  test.AddInput<float>("X", {n_rows, ManyShallowTrees::kFeatures}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+  if (ep_info == nullptr) {
+    test.Run();
+    return;
+  }
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(*ep_info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(MLOpTest, TreeRegressorManyShallowTrees) {
+  RunManyShallowTreesRegressorTest("BRANCH_LEQ");
+  RunManyShallowTreesRegressorTest("BRANCH_LT");
+  RunManyShallowTreesRegressorTest("BRANCH_GTE");
+  RunManyShallowTreesRegressorTest("BRANCH_GT");
+}
+
+TEST(MLOpTest, TreeRegressorQuantized) {
+  // the weights are multiples of 0.25, exact in fp16
+  CPUExecutionProviderInfo info;
+  info.quantize_tree_ensembles = true;
+  RunManyShallowTreesRegressorTest("BRANCH_LEQ", &info);
+  RunManyShallowTreesRegressorTest("BRANCH_LT", &info);
+  RunManyShallowTreesRegressorTest("BRANCH_GTE", &info);
+  RunManyShallowTreesRegressorTest("BRANCH_GT", &info);
+
+  // fp16 can't represent the weights, the exact quantization keeps them in float
+  info.tree_ensemble_exact_quantization = true;
+  RunManyShallowTreesRegressorTest("BRANCH_LEQ", &info, 0.1f);
+  RunManyShallowTreesRegressorTest("BRANCH_GT", &info, 0.1f);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
 namespace onnxruntime {
@@ -736,5 +737,71 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// The inputs are small integers, which bfloat16 represents exactly, so the bfloat16 mixed precision Conv is exact on
+// processors that support it, and so is the fp32 Conv it falls back to elsewhere.
+static void TestConvBf16MixedPrecision(int64_t group, int64_t kernel, int64_t pad) {
+  constexpr int64_t N = 2, C = 32, M = 32, H = 7, W = 6;
+  const int64_t C_group = C / group, M_group = M / group;
+  const int64_t H_out = H + 2 * pad - kernel + 1, W_out = W + 2 * pad - kernel + 1;
+
+  vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(static_cast<int>(i * 7 % 5) - 2);
+  }
+  vector<float> weights(M * C_group * kernel * kernel);
+  for (size_t i = 0; i < weights.size(); i++) {
+    weights[i] = static_cast<float>(static_cast<int>(i * 3 % 7) - 3);
+  }
+  vector<float> B(M);
+  for (size_t i = 0; i < B.size(); i++) {
+    B[i] = static_cast<float>(i % 4) - 1.5f;
+  }
+
+  vector<float> expected_vals;
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t m = 0; m < M; m++) {
+      const int64_t g = m / M_group;
+      for (int64_t oh = 0; oh < H_out; oh++) {
+        for (int64_t ow = 0; ow < W_out; ow++) {
+          float sum = B[m];
+          for (int64_t c = 0; c < C_group; c++) {
+            for (int64_t kh = 0; kh < kernel; kh++) {
+              for (int64_t kw = 0; kw < kernel; kw++) {
+                const int64_t ih = oh + kh - pad, iw = ow + kw - pad;
+                if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                  sum += X[((n * C + g * C_group + c) * H + ih) * W + iw] *
+                         weights[((m * C_group + c) * kernel + kh) * kernel + kw];
+                }
+              }
+            }
+          }
+          expected_vals.push_back(sum);
+        }
+      }
+    }
+  }
+
+  OpTester test("Conv", 11);
+  test.AddAttribute("group", group);
+  test.AddAttribute("kernel_shape", vector<int64_t>{kernel, kernel});
+  test.AddAttribute("pads", vector<int64_t>{pad, pad, pad, pad});
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("W", {M, C_group, kernel, kernel}, weights, true);
+  test.AddInput<float>("B", {M}, B, true);
+  test.AddOutput<float>("Y", {N, M, H_out, W_out}, expected_vals);
+
+  CPUExecutionProviderInfo info;
+  info.enable_bf16_mixed_precision = true;
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(std::make_unique<CPUExecutionProvider>(info));
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(ConvTest, Conv2D_Bf16MixedPrecision) {
+  TestConvBf16MixedPrecision(1, 3, 1);
+  TestConvBf16MixedPrecision(2, 3, 1);
+  TestConvBf16MixedPrecision(1, 1, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
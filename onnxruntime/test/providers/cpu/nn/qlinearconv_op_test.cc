@@ -288,6 +288,12 @@ class QLinearConvOpTester {
   int64_t groups_{0};
   float output_scale_{1.0f};
   ActType output_zero_point_{0};
+  QuantizedTensor<ActType> Sum_;
+  float sum_output_scale_{1.0f};
+  ActType sum_output_zero_point_{0};
+  std::string activation_;
+  std::vector<float> activation_params_;
+  bool channels_last_{false};
 
   static size_t ShapeSize(const std::vector<int64_t>& shape) {
     return static_cast<size_t>(std::accumulate(shape.cbegin(), shape.cend(), 1LL, std::multiplies<int64_t>()));
@@ -462,14 +468,84 @@ class QLinearConvOpTester {
     }
   }
 
+  static ActType QuantizeBound(float value, float scale, int32_t zero_point) {
+    const float q = std::nearbyintf(value / scale) + static_cast<float>(zero_point);
+    return static_cast<ActType>(std::clamp(q, static_cast<float>(std::numeric_limits<ActType>::min()),
+                                           static_cast<float>(std::numeric_limits<ActType>::max())));
+  }
+
+  // Adds the sum to the requantized output and applies the activation, as the com.microsoft QLinearConv does.
+  void ApplyFusedEpilogue(std::vector<ActType>& Y_data) {
+    const bool has_sum = !Sum_.data_.empty();
+    const float out_scale = has_sum ? sum_output_scale_ : output_scale_;
+    const int32_t out_zero_point = has_sum ? sum_output_zero_point_ : output_zero_point_;
+
+    ActType lower = std::numeric_limits<ActType>::min();
+    ActType upper = std::numeric_limits<ActType>::max();
+    if (activation_ == "Relu") {
+      lower = static_cast<ActType>(out_zero_point);
+    } else if (activation_ == "Clip") {
+      lower = QuantizeBound(activation_params_[0], out_scale, out_zero_point);
+      upper = QuantizeBound(activation_params_[1], out_scale, out_zero_point);
+    }
+
+    for (size_t n = 0; n < Y_data.size(); n++) {
+      int32_t value = Y_data[n];
+      if (has_sum) {
+        const float y = output_scale_ * static_cast<float>(value - static_cast<int32_t>(output_zero_point_));
+        const float s = Sum_.scale_[0] * static_cast<float>(static_cast<int32_t>(Sum_.data_[n]) - Sum_.zero_point_);
+        const float q = std::nearbyintf((y + s) / out_scale) + static_cast<float>(out_zero_point);
+        value = static_cast<int32_t>(std::clamp(q, static_cast<float>(std::numeric_limits<ActType>::min()),
+                                                static_cast<float>(std::numeric_limits<ActType>::max())));
+      }
+      Y_data[n] = std::clamp(static_cast<ActType>(value), lower, upper);
+    }
+  }
+
+  // Reorders a tensor from NCHW to NHWC, along with its shape.
+  template <typename T>
+  static void ToChannelsLast(std::vector<T>& data, std::vector<int64_t>& shape) {
+    const int64_t batch_count = shape[0];
+    const int64_t channels = shape[1];
+    const int64_t image_size = std::accumulate(shape.cbegin() + 2, shape.cend(), 1LL, std::multiplies<int64_t>());
+    std::vector<T> nhwc(data.size());
+    for (int64_t n = 0; n < batch_count; n++) {
+      for (int64_t c = 0; c < channels; c++) {
+        for (int64_t i = 0; i < image_size; i++) {
+          nhwc[(n * image_size + i) * channels + c] = data[(n * channels + c) * image_size + i];
+        }
+      }
+    }
+    data = std::move(nhwc);
+    shape.erase(shape.begin() + 1);
+    shape.push_back(channels);
+  }
+
   void Run(bool all_input_initializer_except_x) {
-    OpTester test("QLinearConv", 10);
+    const bool is_fused = !activation_.empty() || !Sum_.data_.empty() || channels_last_;
+    OpTester test("QLinearConv", is_fused ? 1 : 10, is_fused ? onnxruntime::kMSDomain : onnxruntime::kOnnxDomain);
 
     std::vector<ActType> Y_data;
     std::vector<int64_t> Y_shape;
     ComputeExpectedOutput(Y_data, Y_shape);
+    if (!activation_.empty() || !Sum_.data_.empty()) {
+      ORT_ENFORCE(Sum_.data_.empty() || Sum_.shape_ == Y_shape);
+      ApplyFusedEpilogue(Y_data);
+    }
+
+    std::vector<ActType> X_data(X_.data_);
+    std::vector<int64_t> X_shape(X_.shape_);
+    std::vector<ActType> Sum_data(Sum_.data_);
+    std::vector<int64_t> Sum_shape(Sum_.shape_);
+    if (channels_last_) {
+      ToChannelsLast(X_data, X_shape);
+      ToChannelsLast(Y_data, Y_shape);
+      if (!Sum_data.empty()) {
+        ToChannelsLast(Sum_data, Sum_shape);
+      }
+    }
 
-    test.AddInput<ActType>("x", X_.shape_, X_.data_);
+    test.AddInput<ActType>("x", X_shape, X_data);
     test.AddInput<float>("x_scale", {}, X_.scale_, all_input_initializer_except_x);
     test.AddInput<ActType>("x_zero_point", {}, {X_.zero_point_}, all_input_initializer_except_x);
 
@@ -484,6 +560,16 @@ class QLinearConvOpTester {
     if (!B_.empty()) {
       const std::vector<int64_t> B_shape{static_cast<int64_t>(B_.size())};
       test.AddInput<int32_t>("b", B_shape, B_, all_input_initializer_except_x);
+    } else if (!Sum_data.empty()) {
+      test.AddOptionalInputEdge<int32_t>();
+    }
+
+    if (!Sum_data.empty()) {
+      test.AddInput<ActType>("sum", Sum_shape, Sum_data);
+      test.AddInput<float>("sum_scale", {}, Sum_.scale_, all_input_initializer_except_x);
+      test.AddInput<ActType>("sum_zero_point", {}, {Sum_.zero_point_}, all_input_initializer_except_x);
+      test.AddInput<float>("out_scale", {}, {sum_output_scale_}, all_input_initializer_except_x);
+      test.AddInput<ActType>("out_zero_point", {}, {sum_output_zero_point_}, all_input_initializer_except_x);
     }
 
     float abs_error = 0.0f;
@@ -517,8 +603,24 @@ class QLinearConvOpTester {
     if (groups_ > 0) {
       test.AddAttribute("group", groups_);
     }
+    if (channels_last_) {
+      test.AddAttribute("channels_last", static_cast<int64_t>(1));
+    }
+    if (!activation_.empty()) {
+      test.AddAttribute("activation", activation_);
+      if (!activation_params_.empty()) {
+        test.AddAttribute("activation_params", activation_params_);
+      }
+    }
 
-    test.Run(OpTester::ExpectResult::kExpectSuccess, "");
+    if (is_fused) {
+      // the com.microsoft QLinearConv only has a CPU kernel
+      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    } else {
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "");
+    }
   }
 
  public:
@@ -574,6 +676,27 @@ class QLinearConvOpTester {
     output_zero_point_ = output_zero_point;
   }
 
+  // Adds a random tensor of the output shape to the output, requantized with the given scale and zero point.
+  void GenerateRandomSum(float scale, ActType zero_point, float output_scale, ActType output_zero_point) {
+    std::vector<ActType> Y_data;
+    std::vector<int64_t> Y_shape;
+    ComputeExpectedOutput(Y_data, Y_shape);
+    GenerateRandom(Sum_, Y_shape, scale, zero_point,
+                   std::numeric_limits<ActType>::min(),
+                   std::numeric_limits<ActType>::max());
+    sum_output_scale_ = output_scale;
+    sum_output_zero_point_ = output_zero_point;
+  }
+
+  void SetActivation(const std::string& activation, const std::vector<float>& activation_params = {}) {
+    activation_ = activation;
+    activation_params_ = activation_params;
+  }
+
+  void SetChannelsLast() {
+    channels_last_ = true;
+  }
+
   void Run() {
     for (bool all_input_initializer_except_x : std::initializer_list<bool>{false, true}) {
       Run(all_input_initializer_except_x);
@@ -1520,6 +1643,66 @@ TEST(QLinearConvTest, Conv2D_S8S8_Depthwise_Kernelsize_PerChannel) {
   TestQLinearConv2dDepthwiseKernelsizePerChannel<int8_t, int8_t>();
 }
 
+// The sum and output scales are chosen so the sum is requantized exactly, whatever the rounding of the MLAS kernel.
+template <typename ActType, typename FilterType>
+void TestQLinearConvFusedEpilogue(bool channels_last) {
+  // pointwise, generic and depthwise convolutions
+  struct ConvShape {
+    std::vector<int64_t> input_shape;
+    std::vector<int64_t> weight_shape;
+    int64_t groups;
+  };
+  for (const auto& conv_shape : std::initializer_list<ConvShape>{{{2, 16, 7, 7}, {24, 16, 1, 1}, 1},
+                                                                  {{1, 8, 9, 9}, {17, 8, 3, 3}, 1},
+                                                                  {{1, 32, 11, 11}, {32, 1, 3, 3}, 32}}) {
+    for (int with_sum : std::initializer_list<int>{0, 1}) {
+      for (const auto& activation : std::initializer_list<std::pair<std::string, std::vector<float>>>{
+               {"", {}}, {"Relu", {}}, {"Clip", {-3.f, 6.f}}}) {
+        if (!with_sum && activation.first.empty() && !channels_last) {
+          continue;
+        }
+        QLinearConvOpTester<ActType, FilterType> test;
+        test.GenerateRandomInput(conv_shape.input_shape, .05f, 4);
+        test.GenerateRandomWeights(conv_shape.weight_shape, .125f, 0);
+        test.GenerateRandomBias();
+        test.SetPads({1, 1, 1, 1});
+        test.SetGroups(conv_shape.groups);
+        test.SetOutputScaleAndZeroPoint(.5f, 10);
+        if (with_sum) {
+          test.GenerateRandomSum(1.f, 6, .5f, 14);
+        }
+        if (!activation.first.empty()) {
+          test.SetActivation(activation.first, activation.second);
+        }
+        if (channels_last) {
+          test.SetChannelsLast();
+        }
+        test.Run();
+      }
+    }
+  }
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_FusedEpilogue) {
+  TestQLinearConvFusedEpilogue<uint8_t, int8_t>(false);
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_FusedEpilogue_ChannelsLast) {
+  TestQLinearConvFusedEpilogue<uint8_t, int8_t>(true);
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_FusedEpilogue) {
+  TestQLinearConvFusedEpilogue<int8_t, int8_t>(false);
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_FusedEpilogue_ChannelsLast) {
+  TestQLinearConvFusedEpilogue<int8_t, int8_t>(true);
+}
+
+TEST(QLinearConvTest, Conv2D_U8U8_FusedEpilogue_ChannelsLast) {
+  TestQLinearConvFusedEpilogue<uint8_t, uint8_t>(true);
+}
+
 #ifndef ENABLE_TRAINING
 // Prepacking is disabled in full training build so no need to test the feature in a training build.
 TEST(QLinearConvTest, SharedPrepackedWeights) {
@@ -689,6 +689,35 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5_2rows) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, String_TFIDFWeights_UniAndBigrams_Skip5_ManyRows) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=5, Min=1, Max=2, weights specified, string, enough rows to split them across threads
+  InitTestAttr(test, "TFIDF", 1, 2, 5,
+               {0, 4},
+               {0, 1, 2, 3, 4, 5, 6},                       // 7 output indexes
+               {2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 3.0f, 2.0f},  // weights
+               {},
+               {"two", "three", "five", "four",                     // 1-grams
+                "five", "six", "seven", "eight", "six", "seven"});  // bi-grams
+
+  const std::vector<std::string> rows{"one", "one", "three", "three", "three", "seven",
+                                      "eight", "six", "seven", "five", "six", "eight"};
+  const std::vector<float> row_outputs{0.f, 6.f, 0.f, 0.f, 0.f, 0.f, 0.f,
+                                       0.f, 0.f, 2.f, 0.f, 2.f, 3.f, 2.f};
+  constexpr int64_t kRows = 512;
+  std::vector<std::string> input;
+  std::vector<float> output;
+  for (int64_t r = 0; r < kRows; ++r) {
+    input.insert(input.end(), rows.begin() + (r % 2) * 6, rows.begin() + (r % 2 + 1) * 6);
+    output.insert(output.end(), row_outputs.begin() + (r % 2) * 7, row_outputs.begin() + (r % 2 + 1) * 7);
+  }
+
+  test.AddInput<std::string>("T", {kRows, 6}, input);
+  test.AddOutput<float>("Y", {kRows, 7}, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 // This test runs the inference 100 times to test the improvement
 // It enables profiling while running inference multiple times.
 // So we can manually inspect the profiling output
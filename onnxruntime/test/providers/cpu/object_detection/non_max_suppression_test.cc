@@ -363,6 +363,39 @@ TEST(NonMaxSuppressionOpTest, BigIntMaxOutputBoxesPerClass) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyOverlappingBoxes_TwoClasses) {
+  // boxes 0-79 are the same box, boxes 80-99 don't overlap any other box.
+  // in class 0 all the same boxes come first, so the boxes after them have to be visited to select ten.
+  constexpr int64_t num_boxes = 100;
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    const float y = i < 80 ? 0.0f : 10.0f + 2.0f * i;
+    boxes.insert(boxes.end(), {y, 0.0f, y + 1.0f, 1.0f});
+    scores.push_back(i < 80 ? 0.9f : 0.8f - 0.01f * (i - 80));
+  }
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    scores.push_back(i < 80 ? 0.1f : 0.5f + 0.01f * (i - 80));
+  }
+
+  std::vector<int64_t> selected_indices{0L, 0L, 0L};
+  for (int64_t i = 80; i < 89; ++i) {
+    selected_indices.insert(selected_indices.end(), {0L, 0L, i});
+  }
+  for (int64_t i = 99; i >= 90; --i) {
+    selected_indices.insert(selected_indices.end(), {0L, 1L, i});
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {1, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {1, 2, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {10L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {20, 3}, selected_indices);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   OpTester test("NonMaxSuppression", 11, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -143,5 +143,26 @@ TEST(SequenceOpsTest, ConcatFromSequence_Concat_ScalarInputs) {
            {kDmlExecutionProvider});
 }
 
+TEST(SequenceOpsTest, ConcatFromSequence_Concat_Axis0_ManyInputs) {
+  // leading axis concatenation, which copies the inputs end to end
+  OpTester test("ConcatFromSequence", 11);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddAttribute<int64_t>("new_axis", 0);  // concat mode
+  SeqTensors<float> input;
+  std::vector<float> expected;
+  for (int i = 0; i < 16; ++i) {
+    const int64_t rows = i % 3;  // includes empty inputs
+    std::vector<float> values;
+    for (int64_t j = 0; j < rows * 3; ++j) {
+      values.push_back(static_cast<float>(i * 100 + j));
+    }
+    expected.insert(expected.end(), values.begin(), values.end());
+    input.AddTensor({rows, 3}, values);
+  }
+  test.AddSeqInput("S", input);
+  test.AddOutput<float>("I", {static_cast<int64_t>(expected.size() / 3), 3}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <functional>
 #include <vector>
 
@@ -83,6 +84,41 @@ TEST(SignalOpsTest, DFTFloat_inverse) {
   test.Run();
 }
 
+// Tests a batch of real signals of an even length that is not a power of 2 against a naive DFT.
+static void TestRealEvenDFTFloat(bool onesided) {
+  OpTester test("DFT", kMinOpsetVersion);
+
+  constexpr int64_t batch_size = 3;
+  constexpr int64_t signal_length = 12;
+  const int64_t output_length = onesided ? (signal_length >> 1) + 1 : signal_length;
+
+  RandomValueGenerator random(GetTestRandomSeed());
+  vector<float> input = random.Uniform<float>({batch_size, signal_length, 1}, -10.f, 10.f);
+  vector<float> expected_output;
+  for (int64_t b = 0; b < batch_size; b++) {
+    for (int64_t k = 0; k < output_length; k++) {
+      double real = 0, imag = 0;
+      for (int64_t n = 0; n < signal_length; n++) {
+        const double angle = -2 * M_PI * static_cast<double>(n * k) / signal_length;
+        real += input[b * signal_length + n] * std::cos(angle);
+        imag += input[b * signal_length + n] * std::sin(angle);
+      }
+      expected_output.push_back(static_cast<float>(real));
+      expected_output.push_back(static_cast<float>(imag));
+    }
+  }
+
+  test.AddInput<float>("input", {batch_size, signal_length, 1}, input);
+  test.AddAttribute<int64_t>("onesided", static_cast<int64_t>(onesided));
+  test.AddOutput<float>("output", {batch_size, output_length, 2}, expected_output);
+  test.SetOutputAbsErr("output", 0.0002f);
+  test.Run();
+}
+
+TEST(SignalOpsTest, DFTFloat_real_even) { TestRealEvenDFTFloat(false); }
+
+TEST(SignalOpsTest, DFTFloat_real_even_onesided) { TestRealEvenDFTFloat(true); }
+
 // Tests that FFT(FFT(x), inverse=true) == x
 static void TestDFTInvertible(bool complex) {
   // TODO: test dft_length
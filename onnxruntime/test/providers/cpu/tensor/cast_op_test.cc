@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <type_traits>
 
 #include "boost/mp11.hpp"
@@ -158,6 +159,33 @@ TEST(CastOpTest, NonStringTypes) {
       CastNonStringTester{});
 }
 
+// Large enough to be split across threads and to leave a tail for the vectorized conversions, with values from the
+// float 16 denormals to the largest half precision values.
+TEST(CastOpTest, LargeFloat16Tensors) {
+  constexpr size_t size = 10007;
+  std::vector<float> float_values(size);
+  for (size_t i = 0; i < size; ++i) {
+    float_values[i] = std::ldexp(static_cast<float>(i % 97) - 48.25f, static_cast<int>(i % 40) - 30);
+  }
+  const std::vector<int64_t> dims{static_cast<int64_t>(size)};
+
+  const auto half_values = CastedValues<float, MLFloat16>(gsl::make_span(float_values));
+  const auto bfloat16_values = CastedValues<float, BFloat16>(gsl::make_span(float_values));
+
+  TestCastOp<float, MLFloat16>(gsl::make_span(float_values), gsl::make_span(half_values), dims);
+  TestCastOp<float, BFloat16>(gsl::make_span(float_values), gsl::make_span(bfloat16_values), dims);
+  TestCastOp<MLFloat16, float>(gsl::make_span(half_values),
+                               gsl::make_span(CastedValues<MLFloat16, float>(gsl::make_span(half_values))), dims);
+  TestCastOp<BFloat16, float>(gsl::make_span(bfloat16_values),
+                              gsl::make_span(CastedValues<BFloat16, float>(gsl::make_span(bfloat16_values))), dims);
+  TestCastOp<MLFloat16, BFloat16>(gsl::make_span(half_values),
+                                  gsl::make_span(CastedValues<MLFloat16, BFloat16>(gsl::make_span(half_values))),
+                                  dims);
+  TestCastOp<MLFloat16, int32_t>(gsl::make_span(half_values),
+                                 gsl::make_span(CastedValues<MLFloat16, int32_t>(gsl::make_span(half_values))),
+                                 dims);
+}
+
 TEST(CastOpTest, FromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   const std::vector<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
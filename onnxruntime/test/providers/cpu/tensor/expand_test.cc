@@ -168,6 +168,17 @@ TEST(ExpandOpTest, Expand_2x2x1x2x1_float) {
 }
 
 #ifndef USE_TENSORRT
+TEST(ExpandOpTest, Expand_2x1x3x1_alternating_float) {
+  // repeated and copied dims alternate, with a repeated innermost dim
+  OpTester test("Expand", 8);
+  test.AddInput<float>("data_0", {2, 1, 3, 1}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int64_t>("data_1", {4}, {2, 2, 3, 2});
+  test.AddOutput<float>("result", {2, 2, 3, 2},
+                        {1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f, 1.0f, 1.0f, 2.0f, 2.0f, 3.0f, 3.0f,
+                         4.0f, 4.0f, 5.0f, 5.0f, 6.0f, 6.0f, 4.0f, 4.0f, 5.0f, 5.0f, 6.0f, 6.0f});
+  test.Run();
+}
+
 TEST(ExpandOpTest, Expand_scalar_float) {
   OpTester test("Expand", 8);
   test.AddInput<float>("data_0", {}, {3.0f});
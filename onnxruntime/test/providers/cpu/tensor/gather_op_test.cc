@@ -369,6 +369,32 @@ TEST(GatherOpTest, Gather_perf) {
   test.Run();
 }
 
+// Embedding style lookups, covering the slice sizes copied with a fixed size and the generic copy
+TEST(GatherOpTest, Gather_axis0_embedding_lookup) {
+  constexpr int64_t vocab_size = 10;
+  const std::vector<int64_t> indices{3, 0, -1, 9, 3, -10, 5};
+
+  for (int64_t embedding_size : {1, 2, 3, 4, 5, 8, 12, 16, 17}) {
+    std::vector<float> data(vocab_size * embedding_size);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<float>(i);
+    }
+
+    std::vector<float> output;
+    for (int64_t index : indices) {
+      const int64_t row = index < 0 ? index + vocab_size : index;
+      output.insert(output.end(), data.begin() + row * embedding_size, data.begin() + (row + 1) * embedding_size);
+    }
+
+    OpTester test("Gather");
+    test.AddAttribute<int64_t>("axis", 0LL);
+    test.AddInput<float>("data", {vocab_size, embedding_size}, data);
+    test.AddInput<int64_t>("indices", {static_cast<int64_t>(indices.size())}, indices);
+    test.AddOutput<float>("output", {static_cast<int64_t>(indices.size()), embedding_size}, output);
+    test.Run();
+  }
+}
+
 TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   OpTester test("Gather", 11);
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -118,6 +118,9 @@ void RunTestWrapper() {
   RunTest<T>({2, 3, 2, 3, 2}, {2, 1, 2, 1, 2});
   RunTest<T>({2, 3, 2, 3, 2}, {2, 1, 2, 1, 2}, true);
 
+  // Tile3D_AllAxes
+  RunTest<T>({3, 2, 1}, {2, 3, 4});
+
   // Tile1DWithOneRepeats
   RunTest<T>({2, 1, 3}, {1, 1, 1});
   RunTest<T>({2, 1, 3}, {1, 1, 1}, true);
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <map>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -394,5 +397,46 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+TEST(Unique, Flatten_LargeInput) {
+  // large enough for the hash tables to be built in parallel partitions
+  constexpr int64_t size = 100000;
+  std::vector<int64_t> X(size);
+  for (int64_t i = 0; i < size; ++i) {
+    X[i] = (i * 7919) % 30011 - 15000;
+  }
+
+  for (bool sorted : {false, true}) {
+    std::map<int64_t, int64_t> first_index;
+    std::map<int64_t, int64_t> value_counts;
+    std::vector<int64_t> Y;
+    for (int64_t i = 0; i < size; ++i) {
+      if (first_index.emplace(X[i], i).second) {
+        Y.push_back(X[i]);
+      }
+      ++value_counts[X[i]];
+    }
+    if (sorted) {
+      std::sort(Y.begin(), Y.end());
+    }
+
+    std::map<int64_t, int64_t> output_index;
+    std::vector<int64_t> indices;
+    std::vector<int64_t> counts;
+    for (size_t i = 0; i < Y.size(); ++i) {
+      output_index[Y[i]] = static_cast<int64_t>(i);
+      indices.push_back(first_index[Y[i]]);
+      counts.push_back(value_counts[Y[i]]);
+    }
+    std::vector<int64_t> inverse_indices;
+    for (int64_t x : X) {
+      inverse_indices.push_back(output_index[x]);
+    }
+
+    const int64_t num_unique = static_cast<int64_t>(Y.size());
+    RunUniqueTest<int64_t>({size}, X, nullptr, sorted, {num_unique}, Y, {num_unique}, indices,
+                           {size}, inverse_indices, {num_unique}, counts);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -146,5 +146,46 @@ TEST(WhereOpTest, BroadcastWithScalar) {
   test.Run();
 }
 
+TEST(WhereOpTest, BroadcastRowAndScalars) {
+  // a condition broadcast over the rows, as when building an attention mask, large enough to be split across threads
+  constexpr int64_t rows = 64;
+  constexpr int64_t columns = 257;
+  // OpTester doesn't support std::vector<bool>
+  auto condition = std::make_unique<bool[]>(columns);
+  for (int64_t j = 0; j < columns; ++j) {
+    condition[j] = j % 3 != 0;
+  }
+
+  std::vector<float> X(rows * columns);
+  std::vector<float> scalar_output(rows * columns);
+  std::vector<float> row_output(rows * columns);
+  for (int64_t i = 0; i < rows; ++i) {
+    for (int64_t j = 0; j < columns; ++j) {
+      X[i * columns + j] = static_cast<float>(i - j);
+      scalar_output[i * columns + j] = condition[j] ? 0.0f : -std::numeric_limits<float>::infinity();
+      row_output[i * columns + j] = condition[j] ? X[i * columns + j] : -0.0f;
+    }
+  }
+
+  {
+    OpTester test{kOpName, kOpVersion};
+    test.AddInput<bool>("condition", {1, columns}, condition.get(), columns);
+    test.AddInput<float>("X", {}, {0.0f});
+    test.AddInput<float>("Y", {1}, {-std::numeric_limits<float>::infinity()});
+    test.AddOutput<float>("output", {1, columns},
+                          std::vector<float>(scalar_output.begin(), scalar_output.begin() + columns));
+    test.Run();
+  }
+
+  {
+    OpTester test{kOpName, kOpVersion};
+    test.AddInput<bool>("condition", {columns}, condition.get(), columns);
+    test.AddInput<float>("X", {rows, columns}, X);
+    test.AddInput<float>("Y", {}, {-0.0f});
+    test.AddOutput<float>("output", {rows, columns}, row_output);
+    test.Run();
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
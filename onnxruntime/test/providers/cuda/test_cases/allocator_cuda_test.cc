@@ -5,6 +5,7 @@
 #include "gtest/gtest.h"
 #include "cuda_runtime.h"
 #include "core/framework/allocator.h"
+#include "core/framework/stream_handles.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_common.h"
 
@@ -113,5 +114,52 @@ TEST(AllocatorTest, CUDAAllocatorFallbackTest) {
   auto last_error = cudaGetLastError();
   EXPECT_EQ(last_error, cudaSuccess) << "Last error should be cleared if handled gracefully";
 }
+TEST(AllocatorTest, CUDAMemPoolAllocatorTest) {
+  OrtDevice::DeviceId cuda_device_id = 0;
+  CUDA_CALL_THROW(cudaSetDevice(cuda_device_id));
+
+  AllocatorCreationInfo mem_pool_memory_info(
+      [](OrtDevice::DeviceId id) { return std::make_unique<CUDAMemPoolAllocator>(id, CUDA, 1 << 20); },
+      cuda_device_id, false);
+  auto allocator = CreateAllocator(mem_pool_memory_info);
+  EXPECT_EQ(allocator->Info().alloc_type, OrtDeviceAllocator);
+  EXPECT_TRUE(allocator->IsStreamOrdered());
+
+  const size_t size = 1024;
+  std::vector<int> host(size / sizeof(int), -1);
+  std::vector<int> host_copy(host.size(), 0);
+
+  // allocated without a stream, usable on any stream
+  void* p = allocator->Alloc(size);
+  ASSERT_NE(p, nullptr);
+  CUDA_CALL_THROW(cudaMemcpy(p, host.data(), size, cudaMemcpyHostToDevice));
+  CUDA_CALL_THROW(cudaMemcpy(host_copy.data(), p, size, cudaMemcpyDeviceToHost));
+  EXPECT_EQ(host_copy, host);
+
+  cudaStream_t cuda_stream;
+  CUDA_CALL_THROW(cudaStreamCreateWithFlags(&cuda_stream, cudaStreamNonBlocking));
+  Stream stream(cuda_stream, allocator->Info().device);
+
+  // allocated and freed in the order of the work on the stream
+  void* q = allocator->AllocOnStream(size, &stream);
+  ASSERT_NE(q, nullptr);
+  AllocatorStats stats;
+  allocator->GetStats(&stats);
+  EXPECT_EQ(stats.num_allocs, 2);
+  EXPECT_EQ(stats.bytes_in_use, static_cast<int64_t>(2 * size));
+
+  CUDA_CALL_THROW(cudaMemcpyAsync(q, p, size, cudaMemcpyDeviceToDevice, cuda_stream));
+  std::fill(host_copy.begin(), host_copy.end(), 0);
+  CUDA_CALL_THROW(cudaMemcpyAsync(host_copy.data(), q, size, cudaMemcpyDeviceToHost, cuda_stream));
+  allocator->Free(q);
+  CUDA_CALL_THROW(cudaStreamSynchronize(cuda_stream));
+  EXPECT_EQ(host_copy, host);
+
+  allocator->Free(p);
+  allocator->GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  CUDA_CALL_THROW(cudaStreamDestroy(cuda_stream));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
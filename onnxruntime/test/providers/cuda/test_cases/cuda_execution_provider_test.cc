@@ -82,6 +82,40 @@ TEST(TestDeferredRelease, WithoutArena) {
   ORT_THROW_IF_ERROR(ep.OnRunEnd(true));
 }
 
+TEST(TestCudaGraph, CapturePerGraphCaptureKey) {
+  CUDAExecutionProviderInfo info;
+  info.enable_cuda_graph = true;
+  info.cuda_graph_max_captures = 2;
+  CUDAExecutionProvider ep(info);
+
+  // the regular runs needed before the capture, then the run capturing the (empty) graph
+  auto run_until_captured = [&ep]() {
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_FALSE(ep.IsGraphCaptured());
+      ORT_THROW_IF_ERROR(ep.OnRunStart());
+      ORT_THROW_IF_ERROR(ep.OnRunEnd(true));
+    }
+    ASSERT_TRUE(ep.IsGraphCaptured());
+  };
+
+  ep.SetGraphCaptureKey("X:1,8;");
+  run_until_captured();
+  ep.SetGraphCaptureKey("X:2,8;");
+  run_until_captured();
+
+  ep.SetGraphCaptureKey("X:1,8;");
+  ASSERT_TRUE(ep.IsGraphCaptured());
+  ORT_THROW_IF_ERROR(ep.ReplayGraph());
+
+  // evicts the least recently used graph, i.e. the one for "X:2,8;"
+  ep.SetGraphCaptureKey("X:4,8;");
+  run_until_captured();
+  ep.SetGraphCaptureKey("X:1,8;");
+  ASSERT_TRUE(ep.IsGraphCaptured());
+  ep.SetGraphCaptureKey("X:2,8;");
+  ASSERT_FALSE(ep.IsGraphCaptured());
+}
+
 }  // namespace test
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "core/providers/cuda/cuda_pinned_staging_pool.h"
+#include "core/providers/cuda/shared_inc/cuda_call.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace test {
+
+TEST(CudaPinnedStagingPoolTest, ReusesBuffers) {
+  constexpr size_t kMinSize = CudaPinnedStagingPool::kMinBufferSize;
+  auto pool = std::make_shared<CudaPinnedStagingPool>(4 * kMinSize);
+
+  EXPECT_EQ(pool->Acquire(0), nullptr);
+  EXPECT_EQ(pool->Acquire(8 * kMinSize), nullptr);
+
+  void* buffer = pool->Acquire(100);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(pool->NumBytesAllocated(), kMinSize);
+
+  // sizes in the same bucket get the same buffer back
+  pool->Release(buffer);
+  EXPECT_EQ(pool->Acquire(kMinSize), buffer);
+
+  // a second buffer is allocated while the first is in use
+  void* other_buffer = pool->Acquire(kMinSize);
+  ASSERT_NE(other_buffer, nullptr);
+  EXPECT_NE(other_buffer, buffer);
+  EXPECT_EQ(pool->NumBytesAllocated(), 2 * kMinSize);
+
+  // there is no room for a larger buffer while both are in use
+  EXPECT_EQ(pool->Acquire(3 * kMinSize), nullptr);
+
+  // unused buffers are freed to make room
+  pool->Release(buffer);
+  pool->Release(other_buffer);
+  void* large_buffer = pool->Acquire(3 * kMinSize);
+  ASSERT_NE(large_buffer, nullptr);
+  EXPECT_EQ(pool->NumBytesAllocated(), 4 * kMinSize);
+  pool->Release(large_buffer);
+}
+
+TEST(CudaPinnedStagingPoolTest, ReleaseOnStream) {
+  constexpr size_t kMinSize = CudaPinnedStagingPool::kMinBufferSize;
+  auto pool = std::make_shared<CudaPinnedStagingPool>(kMinSize);
+
+  cudaStream_t stream;
+  CUDA_CALL_THROW(cudaStreamCreate(&stream));
+
+  void* buffer = pool->Acquire(kMinSize);
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_TRUE(pool->ReleaseOnStream(buffer, stream).IsOK());
+  CUDA_CALL_THROW(cudaStreamSynchronize(stream));
+
+  // the buffer is available again once the stream has reached the release
+  EXPECT_EQ(pool->Acquire(kMinSize), buffer);
+  pool->Release(buffer);
+
+  CUDA_CALL_THROW(cudaStreamDestroy(stream));
+}
+
+}  // namespace test
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #if !defined(REDUCED_OPS_BUILD)  // may not work with excluded op kernel implementations
 
+#include <atomic>
+
 #include "core/common/logging/logging.h"
 #include "core/common/span_utils.h"
 #include "core/framework/utils.h"
@@ -471,6 +473,66 @@ TEST(InternalTestingEP, TestOrtModelWithCompileFailure) {
     ASSERT_STATUS_NOT_OK(session.Initialize());
   }
 }
+
+#if !defined(ORT_MINIMAL_BUILD)
+// A custom InternalTestingEP extension that supports concurrent calls to Compile, and records how it was called
+class ConcurrentCompileTestExecutionProvider : public InternalTestingExecutionProvider {
+ public:
+  ConcurrentCompileTestExecutionProvider(const std::unordered_set<std::string>& supported_ops,
+                                         std::atomic<int>& num_compile_calls, std::atomic<size_t>& max_fused_nodes)
+      : InternalTestingExecutionProvider(supported_ops),
+        num_compile_calls_(num_compile_calls),
+        max_fused_nodes_(max_fused_nodes) {}
+
+  bool ConcurrentCompileSupported() const override { return true; }
+
+  Status Compile(const std::vector<FusedNodeAndGraph>& fused_nodes,
+                 std::vector<NodeComputeInfo>& node_compute_funcs) override {
+    ++num_compile_calls_;
+    size_t max_fused_nodes = max_fused_nodes_;
+    while (fused_nodes.size() > max_fused_nodes &&
+           !max_fused_nodes_.compare_exchange_weak(max_fused_nodes, fused_nodes.size())) {
+    }
+
+    // the base implementation doesn't update any state of the EP so it can be called concurrently
+    return InternalTestingExecutionProvider::Compile(fused_nodes, node_compute_funcs);
+  }
+
+ private:
+  std::atomic<int>& num_compile_calls_;
+  std::atomic<size_t>& max_fused_nodes_;
+};
+
+TEST(InternalTestingEP, TestParallelCompilation) {
+  // the 2 Conv nodes of mnist are separated by Relu and MaxPool, so they are compiled as 2 fused nodes
+  const std::unordered_set<std::string> supported_ops{"Conv"};
+
+  auto test = [&](bool disable_parallel_compilation, int expected_compile_calls, size_t expected_max_fused_nodes) {
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = 2;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDisableParallelCompilation,
+                                                      disable_parallel_compilation ? "1" : "0"));
+
+    std::atomic<int> num_compile_calls{0};
+    std::atomic<size_t> max_fused_nodes{0};
+    InferenceSessionWrapper session(so, GetEnvironment());
+    ASSERT_STATUS_OK(session.RegisterExecutionProvider(
+        std::make_unique<ConcurrentCompileTestExecutionProvider>(supported_ops, num_compile_calls, max_fused_nodes)));
+    ASSERT_STATUS_OK(session.Load(ORT_MODEL_FOLDER "mnist.onnx"));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    EXPECT_EQ(num_compile_calls, expected_compile_calls);
+    EXPECT_EQ(max_fused_nodes, expected_max_fused_nodes);
+    ExecuteMnist(session, true);
+  };
+
+  // one call per fused node on the intra-op thread pool
+  test(false, 2, 1);
+  // one call with all the fused nodes
+  test(true, 1, 2);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 }  // namespace test
 }  // namespace onnxruntime
 
@@ -563,6 +563,21 @@ TEST(NnapiExecutionProviderTest, ActivationOutsideOfPartition) {
                                    << "Exactly one node should have been taken by the NNAPI EP"; });
 }
 
+// test that NNAPI EP leaves partitions smaller than the minimum partition size to the CPU EP
+TEST(NnapiExecutionProviderTest, MinPartitionSize) {
+  constexpr auto* model_file_name = ORT_TSTR("testdata/mnist.basic.ort");
+  // stop NNAPI partitioning at Relu so the only NNAPI partition is the first Conv
+  const auto nnapi_partitioning_stop_ops = "Relu";
+  TestModelLoad(
+      model_file_name, std::make_unique<NnapiExecutionProvider>(0, nnapi_partitioning_stop_ops, "1"),
+      [](const Graph& graph) { ASSERT_EQ(CountAssignedNodes(graph, kNnapiExecutionProvider), 1)
+                                   << "The partition of one Conv should have been taken by the NNAPI EP"; });
+  TestModelLoad(
+      model_file_name, std::make_unique<NnapiExecutionProvider>(0, nnapi_partitioning_stop_ops, "2"),
+      [](const Graph& graph) { ASSERT_EQ(CountAssignedNodes(graph, kNnapiExecutionProvider), 0)
+                                   << "The partition of one Conv should have been left to the CPU EP"; });
+}
+
 }  // namespace test
 }  // namespace onnxruntime
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -395,6 +395,48 @@ TEST(TensorrtExecutionProviderTest, TRTModelIdGeneratorUsingModelHashing) {
   ASSERT_EQ(model_hash, model_hash3) << "model 1&3 are same models and they have same hash, no matter where they are loaded";
 }
 
+TEST(TensorrtExecutionProviderTest, GenerateProfileShapesFromTrace) {
+  const std::string trace_file = "trt_profile_shapes_trace.txt";
+  {
+    std::ofstream trace(trace_file);
+    trace << "X:1x8,Y:1x8\n"
+          << "X:1x64,Y:1x64\n"
+          << "X:1x16,Y:1x16\n"
+          << "X:1x128,Y:1x128\n"
+          << "X:1x32,Y:1x32\n"
+          << "X:1x256,Y:1x256\n";
+  }
+
+  std::unordered_map<std::string, std::vector<std::vector<int64_t>>> min_shapes, max_shapes, opt_shapes;
+  ASSERT_TRUE(GenerateProfileShapesFromTrace(trace_file, 2, min_shapes, max_shapes, opt_shapes));
+  ASSERT_TRUE(ValidateProfileShapes(min_shapes, max_shapes, opt_shapes));
+  ASSERT_EQ(GetNumProfiles(min_shapes), 2);
+
+  // the observations sorted by size are split into [8, 16, 32] and [64, 128, 256]
+  const std::vector<std::vector<int64_t>> expected_min{{1, 8}, {1, 64}};
+  const std::vector<std::vector<int64_t>> expected_max{{1, 32}, {1, 256}};
+  const std::vector<std::vector<int64_t>> expected_opt{{1, 16}, {1, 128}};
+  for (const auto& input_name : {"X", "Y"}) {
+    ASSERT_EQ(min_shapes[input_name], expected_min);
+    ASSERT_EQ(max_shapes[input_name], expected_max);
+    ASSERT_EQ(opt_shapes[input_name], expected_opt);
+  }
+
+  // more profiles than observations generates one profile per observation
+  ASSERT_TRUE(GenerateProfileShapesFromTrace(trace_file, 10, min_shapes, max_shapes, opt_shapes));
+  ASSERT_EQ(GetNumProfiles(min_shapes), 6);
+
+  // observations with different inputs are rejected
+  {
+    std::ofstream trace(trace_file, std::ios::app);
+    trace << "X:1x8\n";
+  }
+  ASSERT_FALSE(GenerateProfileShapesFromTrace(trace_file, 2, min_shapes, max_shapes, opt_shapes));
+  ASSERT_FALSE(GenerateProfileShapesFromTrace("non_existent_trace.txt", 2, min_shapes, max_shapes, opt_shapes));
+
+  std::remove(trace_file.c_str());
+}
+
 TEST(TensorrtExecutionProviderTest, TRTPluginsCustomOpTest) {
   std::string model_name = "testdata/trt_plugin_custom_op_test.onnx";
   SessionOptions so;
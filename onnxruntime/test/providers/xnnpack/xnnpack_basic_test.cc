@@ -374,6 +374,20 @@ TEST(XnnpackEP, TestSoftMax_axisLast) {
                {ExpectedEPNodeAssignment::All});
 }
 
+TEST(XnnpackEP, TestElementwiseBinary_Broadcast) {
+  for (const char* op_type : {"Add", "Sub", "Mul", "Div"}) {
+    auto modelCreater = [op_type](ModelTestBuilder& builder) {
+      auto* input_a = builder.MakeInput<float>({2, 3, 4}, 1.f, 10.f);
+      auto* input_b = builder.MakeInput<float>({3, 1}, 1.f, 10.f);
+      auto* output_arg = builder.MakeOutput();
+      builder.AddNode(op_type, {input_a, input_b}, {output_arg});
+    };
+    RunModelTest(modelCreater,
+                 "xnnpack_test_graph_elementwise_binary",
+                 {ExpectedEPNodeAssignment::All});
+  }
+}
+
 TEST(XnnpackEP, TestQDQSoftMax_axisLast) {
   RunModelTest(BuildQDQSoftMaxTestCase<uint8_t, uint8_t>(
                    {1, 2, 3, 5} /* input_shape */,
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 #include <iostream>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <atomic>
@@ -2629,6 +2630,48 @@ TEST(CApiTest, TestSharingOfInitializerAndItsPrepackedVersion) {
                     nullptr);
 }
 
+TEST(CApiTest, TestSharedWeightsFile) {
+  const std::string shared_weights_file = "test_shared_weights_file.bin";
+  const std::string shared_prepacked_weights_file = shared_weights_file + ".prepacked";
+  std::remove(shared_weights_file.c_str());
+  std::remove(shared_prepacked_weights_file.c_str());
+
+  Ort::MemoryInfo mem_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  float x_values[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const int64_t x_shape[] = {3, 2};
+  Ort::Value x = Ort::Value::CreateTensor<float>(mem_info, x_values, 6, x_shape, 2);
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  auto run = [&](Ort::Session& session) {
+    auto outputs = session.Run(Ort::RunOptions{nullptr}, input_names, &x, 1, output_names, 1);
+    const auto count = outputs[0].GetTensorTypeAndShapeInfo().GetElementCount();
+    const float* y = outputs[0].GetTensorData<float>();
+    return std::vector<float>(y, y + count);
+  };
+
+  Ort::Session reference_session(*ort_env, MATMUL_MODEL_URI, Ort::SessionOptions{});
+  const auto expected = run(reference_session);
+
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry(kOrtSessionOptionsConfigSharedWeightsFile, shared_weights_file.c_str());
+
+  // the first session writes the files, the second one maps them
+  {
+    Ort::Session session(*ort_env, MATMUL_MODEL_URI, session_options);
+    EXPECT_EQ(run(session), expected);
+  }
+  ASSERT_TRUE(std::ifstream(shared_weights_file).good());
+
+  {
+    Ort::Session session(*ort_env, MATMUL_MODEL_URI, session_options);
+    EXPECT_EQ(run(session), expected);
+  }
+
+  std::remove(shared_weights_file.c_str());
+  std::remove(shared_prepacked_weights_file.c_str());
+}
+
 #ifndef ORT_NO_RTTI
 TEST(CApiTest, TestIncorrectInputTypeToModel_Tensors) {
   // simple inference test
@@ -3426,6 +3469,45 @@ TEST(CApiTest, RunAsync) {
   EXPECT_EQ(atomic_wait.load(), true);
 }
 
+TEST(CApiTest, RunAsyncDedicatedThreads) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(1);  // supported as the requests don't run on the intra op thread pool
+  session_options.AddConfigEntry(kOrtSessionOptionsConfigRunAsyncNumThreads, "1");
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  const char* input_names[] = {"X"};
+  float x_value[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  int64_t x_dim[] = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+  Ort::Value input_tensors[1] = {
+      Ort::Value::CreateTensor<float>(memory_info, x_value, 6, x_dim, 2),
+  };
+
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+  Ort::Value output_values[1] = {Ort::Value{nullptr}};
+
+  atomic_wait.store(false);
+  EXPECT_NO_THROW(session.RunAsync(run_options,
+                                   input_names,
+                                   input_tensors,
+                                   1,
+                                   output_names,
+                                   output_values,
+                                   1,
+                                   CallbackSucceed,
+                                   &caller_tid));
+
+  std::chrono::duration<double, std::milli> dur{100};
+  // timeout in about 10 secs
+  for (int i = 0; i < 100 && !atomic_wait.load(); ++i) {
+    std::this_thread::sleep_for(dur);
+  }
+
+  EXPECT_EQ(atomic_wait.load(), true);
+}
+
 void CallbackFail(void*, OrtValue**, size_t, OrtStatusPtr) {
   EXPECT_TRUE(false);  // the callback is not supposed to be invoked
 }
@@ -378,6 +378,75 @@ int OrtRun(OrtSession* session,
   return status_code;
 }
 
+OrtIoBinding* OrtCreateBinding(OrtSession* session) {
+  OrtIoBinding* binding = nullptr;
+  int error_code = CHECK_STATUS(CreateIoBinding, session, &binding);
+  return (error_code == ORT_OK) ? binding : nullptr;
+}
+
+int OrtBindInput(OrtIoBinding* io_binding, const char* name, OrtValue* input) {
+  return CHECK_STATUS(BindInput, io_binding, name, input);
+}
+
+int OrtBindOutput(OrtIoBinding* io_binding, const char* name, OrtValue* output) {
+  if (output != nullptr) {
+    return CHECK_STATUS(BindOutput, io_binding, name, output);
+  }
+
+  OrtMemoryInfo* memory_info = nullptr;
+  RETURN_ERROR_CODE_IF_ERROR(CreateCpuMemoryInfo, OrtDeviceAllocator, OrtMemTypeDefault, &memory_info);
+  REGISTER_AUTO_RELEASE_HANDLE(MemoryInfo, memory_info);
+  return CHECK_STATUS(BindOutputToDevice, io_binding, name, memory_info);
+}
+
+void OrtClearBoundOutputs(OrtIoBinding* io_binding) {
+  Ort::GetApi().ClearBoundOutputs(io_binding);
+}
+
+void OrtReleaseBinding(OrtIoBinding* io_binding) {
+  Ort::GetApi().ReleaseIoBinding(io_binding);
+}
+
+int OrtRunWithBinding(OrtSession* session,
+                      OrtIoBinding* io_binding,
+                      size_t output_count,
+                      ort_tensor_handle_t* outputs,
+                      OrtRunOptions* run_options) {
+#if defined(USE_JSEP)
+  EM_ASM({ Module["jsepRunPromise"] = new Promise(function(r) { Module.jsepRunPromiseResolve = r; }); });
+#endif
+  auto status_code = CHECK_STATUS(RunWithBinding, session, run_options, io_binding);
+#if defined(USE_JSEP)
+  EM_ASM({ Module.jsepRunPromiseResolve($0); }, status_code);
+#endif
+  if (status_code != ORT_OK) {
+    return status_code;
+  }
+
+  OrtAllocator* allocator = nullptr;
+  RETURN_ERROR_CODE_IF_ERROR(GetAllocatorWithDefaultOptions, &allocator);
+
+  OrtValue** bound_outputs = nullptr;
+  size_t bound_output_count = 0;
+  RETURN_ERROR_CODE_IF_ERROR(GetBoundOutputValues, io_binding, allocator, &bound_outputs, &bound_output_count);
+  REGISTER_AUTO_RELEASE_BUFFER(OrtValue*, bound_outputs, allocator);
+
+  if (bound_output_count != output_count) {
+    for (size_t i = 0; i < bound_output_count; i++) {
+      Ort::GetApi().ReleaseValue(bound_outputs[i]);
+    }
+    return CheckStatus(Ort::GetApi().CreateStatus(
+        ORT_INVALID_ARGUMENT, ("Expected " + std::to_string(output_count) + " outputs but " +
+                               std::to_string(bound_output_count) + " are bound.")
+                                  .c_str()));
+  }
+
+  for (size_t i = 0; i < output_count; i++) {
+    outputs[i] = bound_outputs[i];
+  }
+  return ORT_OK;
+}
+
 char* OrtEndProfiling(ort_session_handle_t session) {
   OrtAllocator* allocator = nullptr;
   RETURN_NULLPTR_IF_ERROR(GetAllocatorWithDefaultOptions, &allocator);
@@ -24,6 +24,9 @@ using ort_run_options_handle_t = OrtRunOptions*;
 struct OrtValue;
 using ort_tensor_handle_t = OrtValue*;
 
+struct OrtIoBinding;
+using ort_io_binding_handle_t = OrtIoBinding*;
+
 extern "C" {
 
 /**
@@ -215,6 +218,64 @@ int EMSCRIPTEN_KEEPALIVE OrtRun(ort_session_handle_t session,
                                 ort_tensor_handle_t* outputs,
                                 ort_run_options_handle_t run_options);
 
+/**
+ * create an instance of ORT IO binding.
+ * the inputs and outputs bound to it are kept across runs, so that tensors created by OrtCreateTensor() over buffers
+ * in the wasm heap can be reused by every run without being passed again.
+ * @param session handle of the specified session
+ * @returns an IO binding handle. Caller must release it after use by calling OrtReleaseBinding().
+ */
+ort_io_binding_handle_t EMSCRIPTEN_KEEPALIVE OrtCreateBinding(ort_session_handle_t session);
+
+/**
+ * bind an input tensor.
+ * @param io_binding handle of the IO binding
+ * @param name name of the input
+ * @param input handle of the input tensor. the tensor is referenced by the binding, so the caller may release it.
+ * @returns ORT error code. If not zero, call OrtGetLastError() to get detailed error message.
+ */
+int EMSCRIPTEN_KEEPALIVE OrtBindInput(ort_io_binding_handle_t io_binding,
+                                      const char* name,
+                                      ort_tensor_handle_t input);
+
+/**
+ * bind an output.
+ * @param io_binding handle of the IO binding
+ * @param name name of the output
+ * @param output handle of a preallocated tensor the output is written into, typically created by OrtCreateTensor()
+ *               over a buffer in the wasm heap. If null, the output is allocated by ORT on CPU at each run.
+ * @returns ORT error code. If not zero, call OrtGetLastError() to get detailed error message.
+ */
+int EMSCRIPTEN_KEEPALIVE OrtBindOutput(ort_io_binding_handle_t io_binding,
+                                       const char* name,
+                                       ort_tensor_handle_t output);
+
+/**
+ * clear the outputs bound to the specified IO binding.
+ */
+void EMSCRIPTEN_KEEPALIVE OrtClearBoundOutputs(ort_io_binding_handle_t io_binding);
+
+/**
+ * release the specified IO binding.
+ */
+void EMSCRIPTEN_KEEPALIVE OrtReleaseBinding(ort_io_binding_handle_t io_binding);
+
+/**
+ * inference the model with the inputs and outputs of the specified IO binding.
+ * @param session handle of the specified session
+ * @param io_binding handle of the IO binding
+ * @param output_count the number of outputs bound to the IO binding
+ * @param outputs [out] an array of (output_count) element(s) to accept the output tensors, in the order they were
+ *                bound. The tensors of preallocated outputs share the bound buffers, so OrtGetTensorData() returns
+ *                a pointer into them. Caller must release the tensors after use by calling OrtReleaseTensor().
+ * @returns ORT error code. If not zero, call OrtGetLastError() to get detailed error message.
+ */
+int EMSCRIPTEN_KEEPALIVE OrtRunWithBinding(ort_session_handle_t session,
+                                           ort_io_binding_handle_t io_binding,
+                                           size_t output_count,
+                                           ort_tensor_handle_t* outputs,
+                                           ort_run_options_handle_t run_options);
+
 /**
  * end profiling.
  * @param session handle of the specified session
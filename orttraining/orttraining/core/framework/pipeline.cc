@@ -87,17 +87,23 @@ const PipelineTask& PipelineSlot::GetFrontAction() const {
 }
 
 PipelineScheduler::PipelineScheduler() : num_stages_(0),
+                                         num_ranks_(0),
                                          num_batches_(0) {}
 
 PipelineScheduler::PipelineScheduler(
     int num_batches,
     const int num_stages,
-    const std::vector<int>& stage_id_to_rank_id_map) : num_stages_(num_stages),
-                                                       num_batches_(num_batches),
-                                                       stage_id_to_rank_id_map_(stage_id_to_rank_id_map) {
+    const std::vector<int>& stage_id_to_rank_id_map,
+    const int num_virtual_stages_per_rank) : num_stages_(num_stages * num_virtual_stages_per_rank),
+                                             num_ranks_(num_stages),
+                                             num_batches_(num_batches),
+                                             stage_id_to_rank_id_map_(stage_id_to_rank_id_map) {
   if (stage_id_to_rank_id_map.size() != static_cast<size_t>(num_stages)) {
     throw std::invalid_argument("stage_id_to_rank_id_map should contain the MPI ranks from the first to the last pipeline stages");
   }
+  if (num_virtual_stages_per_rank < 1 || (num_virtual_stages_per_rank > 1 && num_stages < 2)) {
+    throw std::invalid_argument("Interleaved pipeline schedule needs at least 2 stages and 1 virtual stage per rank.");
+  }
 
   CreateComputeSchedule();
 
@@ -157,6 +163,24 @@ std::vector<int> PipelineSlot::GetRecordedEvent() const {
   return recorded_events_;
 }
 
+bool PipelineScheduler::IsRankComputing(const int t, const int stage) const {
+  for (int s = GetRankIndex(stage); s < num_stages_; s += num_ranks_) {
+    if (!compute_table_.at(t).at(s).IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PipelineScheduler::IsRankCommutingForOtherStage(const int t, const int stage) const {
+  for (int s = GetRankIndex(stage); s < num_stages_; s += num_ranks_) {
+    if (s != stage && compute_commute_table_.at(t).at(s).HasCommute()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::ostream& operator<<(std::ostream& stream, PipelineScheduler const& schedule) {
   // print something from v to str, e.g: Str << v.getX();
   stream << "-------------View of Compute Schedule-------------" << std::endl;
@@ -186,9 +210,10 @@ std::vector<int> PipelineScheduler::FindForwardComputeTime(const std::vector<int
   std::vector<int> forward_time(num_stages_, 0);
 
   for (int s = 0; s < num_stages_; ++s) {
+    bool is_found = false;
     for (int t = previous_forward_time.at(s); t < static_cast<int>(compute_table_.size()); ++t) {
-      if (!compute_table_.at(t).at(s).IsEmpty()) {
-        // One slot cannot be occupied by two batches.
+      if (IsRankComputing(t, s)) {
+        // One rank cannot compute two batches, or two stages, in one slot.
         continue;
       }
 
@@ -206,9 +231,14 @@ std::vector<int> PipelineScheduler::FindForwardComputeTime(const std::vector<int
 
       // For batch_id, its forward happens at time t on the s-th stage.
       forward_time.at(s) = t;
+      is_found = true;
 
       break;
     }
+
+    if (!is_found) {
+      throw std::runtime_error("No time slot is found for a forward compute in pipeline schedule.");
+    }
   }
 
   return forward_time;
@@ -222,8 +252,9 @@ std::vector<int> PipelineScheduler::FindBackwardComputeTime(const std::vector<in
   // For a specific batch, the last stage has the earliest backward computation.
   // Thus, the first loop reversely scans stages.
   for (int s = num_stages_ - 1; s > -1; --s) {
+    bool is_found = false;
     for (int t = forward_time.at(s) + 1; t < static_cast<int>(compute_table_.size()); ++t) {
-      if (!compute_table_.at(t).at(s).IsEmpty()) {
+      if (IsRankComputing(t, s)) {
         continue;
       }
 
@@ -236,8 +267,13 @@ std::vector<int> PipelineScheduler::FindBackwardComputeTime(const std::vector<in
       }
 
       backward_time.at(s) = t;
+      is_found = true;
       break;
     }
+
+    if (!is_found) {
+      throw std::runtime_error("No time slot is found for a backward compute in pipeline schedule.");
+    }
   }
   return backward_time;
 }
@@ -268,6 +304,13 @@ int PipelineScheduler::FindSendRecvTime(const int upstream_compute_time, const i
       }
     }
 
+    // In interleaved schedules, a rank communicates for one of its stages at a time. Otherwise, the
+    // Send's and Recv's of one slot could form a cycle over the ranks and wait for each other.
+    if (is_good_time && (IsRankCommutingForOtherStage(full_t, stage) ||
+                         IsRankCommutingForOtherStage(full_t, upstream_stage))) {
+      is_good_time = false;
+    }
+
     if (!is_good_time) {
       continue;
     }
@@ -333,7 +376,13 @@ void PipelineScheduler::CreateFullSchedule() {
       const PipelineTask::Pass send_pass = upstream_action.IsForward() ? PipelineTask::Pass::Forward : PipelineTask::Pass::Backward;
 
       // Find a time index to insert send-recv pair in the schedule with compute and commute actions.
-      const int good_time = FindSendRecvTime(upstream_compute_time, upstream_s, s);
+      int good_time = FindSendRecvTime(upstream_compute_time, upstream_s, s);
+      if (good_time < 0) {
+        // The commute slots before this compute are taken by other ranks' stages in interleaved schedules,
+        // so we append one more slot for commute.
+        compute_commute_table_.push_back(std::vector<PipelineSlot>(num_stages_));
+        good_time = static_cast<int>(compute_commute_table_.size()) - 1;
+      }
 
       // Add Send and Recv to compute-commute schedule.
       // Send from upstream_s-th stage.
@@ -374,35 +423,37 @@ void PipelineScheduler::MapStageIdToMpiRank() {
         // task.this_rank=0 means this stage is the first pipeline stage.
         // If data parallel is enabled, we may have multiple pipeline parallel groups.
         // The code below maps stage ID to MPI's world rank.
-        task.this_rank = stage_id_to_rank_id_map_.at(task.this_rank);
+        task.this_rank = stage_id_to_rank_id_map_.at(GetRankIndex(task.this_rank));
 
         // Similarly, we do the mapping for peer's rank to know which process to communicate with
         // in runtime.
-        task.peer_rank = stage_id_to_rank_id_map_.at(task.peer_rank);
+        task.peer_rank = stage_id_to_rank_id_map_.at(GetRankIndex(task.peer_rank));
       }
     }
   }
 }
 
 void PipelineScheduler::InsertEvents(std::vector<std::vector<PipelineSlot>>& schedule, const size_t num_events_per_slot, const std::vector<int> initial_events) {
-  std::vector<std::vector<int>> last_recorded_events(num_stages_, initial_events);
+  // Events are chained per rank, so that the stages of a rank are ordered too in interleaved schedules.
+  std::vector<std::vector<int>> last_recorded_events(num_ranks_, initial_events);
 
   for (int t = 0; static_cast<size_t>(t) < schedule.size(); ++t) {
     for (int s = 0; s < num_stages_; ++s) {
       if (schedule.at(t).at(s).IsEmpty()) {
         continue;
       }
-      schedule.at(t).at(s).SetWaitedEvent(last_recorded_events.at(s));
+      const int r = GetRankIndex(s);
+      schedule.at(t).at(s).SetWaitedEvent(last_recorded_events.at(r));
 
       // Create new recorded events. Their indexes should be greater than those of previous events.
-      const auto max_event = std::max_element(last_recorded_events.at(s).begin(), last_recorded_events.at(s).end());
+      const auto max_event = std::max_element(last_recorded_events.at(r).begin(), last_recorded_events.at(r).end());
       std::vector<int> new_recorded_events;
       for (int i = 0; static_cast<size_t>(i) < num_events_per_slot; ++i) {
         new_recorded_events.push_back(*max_event + i + 1);
       }
 
       schedule.at(t).at(s).SetRecordedEvent(new_recorded_events);
-      last_recorded_events.at(s) = schedule.at(t).at(s).GetRecordedEvent();
+      last_recorded_events.at(r) = schedule.at(t).at(s).GetRecordedEvent();
     }
   }
 }
@@ -438,7 +489,9 @@ void PipelineScheduler::InsertBackwardCompute(const int batch_id, const std::vec
 
 void PipelineScheduler::CreateComputeSchedule() {
   // Expand table to accomonadate the new batch.
-  const int compute_max_time = 2 * num_stages_ + 2 * (num_batches_ - 1);
+  // Each rank computes num_stages_ / num_ranks_ stages of every batch, so the batches after the first one
+  // take that many forward and backward slots.
+  const int compute_max_time = 2 * num_stages_ + 2 * (num_stages_ / num_ranks_) * (num_batches_ - 1);
 
   compute_table_.resize(compute_max_time, std::vector<PipelineSlot>(num_stages_));
   compute_batch_count_.resize(compute_max_time);
@@ -145,12 +145,19 @@ class PipelineSlot {
 class PipelineScheduler {
  public:
   PipelineScheduler();
-  PipelineScheduler(const int num_batches, const int num_stages, const std::vector<int>& stage_id_to_rank_id_map);
+  // num_virtual_stages_per_rank > 1 creates an interleaved schedule. The model is split into
+  // num_stages * num_virtual_stages_per_rank stages, and stage s runs on rank stage_id_to_rank_id_map[s % num_stages],
+  // so that each rank computes several non-adjacent model chunks and the pipeline bubble shrinks accordingly.
+  // The stage IDs passed to the getters below are those virtual stage IDs.
+  PipelineScheduler(const int num_batches, const int num_stages, const std::vector<int>& stage_id_to_rank_id_map,
+                    const int num_virtual_stages_per_rank = 1);
 
   // Number of time steps.
   size_t GetScheduleSize() const { return compute_commute_table_.size(); }
-  // Number of stages.
+  // Number of stages, including the virtual stages of interleaved schedules.
   size_t GetStageSize() const { return num_stages_; }
+  // Number of ranks the stages run on.
+  size_t GetRankSize() const { return num_ranks_; }
   std::vector<PipelineSlot> GetSchedule(const int stage_id) const {
     std::vector<PipelineSlot> commute_slots;
     for (int t = 0; static_cast<size_t>(t) < GetScheduleSize(); ++t) {
@@ -197,6 +204,12 @@ class PipelineScheduler {
   // i-th returned element is the time of batch_id's backward at stage i.
   // forward_time[s] is the forward time for the given batch on stage s.
   std::vector<int> FindBackwardComputeTime(const std::vector<int> forward_time) const;
+  // Index in stage_id_to_rank_id_map_ of the rank running stage.
+  int GetRankIndex(const int stage) const { return stage % num_ranks_; }
+  // Whether the rank of stage computes at time t in compute-only schedule.
+  bool IsRankComputing(const int t, const int stage) const;
+  // Whether the rank of stage communicates for another stage at time t in compute-commute schedule.
+  bool IsRankCommutingForOtherStage(const int t, const int stage) const;
   void CreateComputeSchedule();
   void InsertEvents(std::vector<std::vector<PipelineSlot>>& schedule, const size_t num_events_per_slot, const std::vector<int> initial_events);
   void CreateFullSchedule();
@@ -210,8 +223,10 @@ class PipelineScheduler {
   // Wrapper over TryGetEvent. It returns -1 when the specified action is not found.
   int GetEventOrDefault(const bool is_waited_event, const int batch_id, const int stage_id, const PipelineTask::Pass pass, const PipelineTask::Type type) const;
 
-  // Number of pipeline stages.
+  // Number of pipeline stages, including virtual stages.
   int num_stages_;
+  // Number of ranks running the stages. It's num_stages_ unless the schedule is interleaved.
+  int num_ranks_;
   // Number of micro-batches.
   int num_batches_;
   // Compute-only pipeline schedule as a 2-D table. table_[i][j] is the computation happening in
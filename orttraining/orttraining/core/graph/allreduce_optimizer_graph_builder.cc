@@ -3,6 +3,12 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_viewer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -19,7 +25,8 @@ static bool IsNcclAvailable() {
 static Status AddNcclAllReduceForGradients(
     std::vector<ArgDef>& gradient_argdefs,
     std::vector<ArgDef>& input_gradient_argdef,
-    GraphAugmenter::GraphDefs& graph_defs) {
+    GraphAugmenter::GraphDefs& graph_defs,
+    const std::string& node_name = "NcclAllReduce") {
   std::vector<ArgDef> allreduce_outputs(gradient_argdefs.size());
   for (size_t i = 0; i < gradient_argdefs.size(); i++) {
     TypeProto* allreduced_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
@@ -35,12 +42,81 @@ static Status AddNcclAllReduceForGradients(
                                   allreduce_outputs,
                                   {ONNX_NAMESPACE::MakeAttribute("group_type",
                                                                  static_cast<int64_t>(WorkerGroupType::DataParallel))},
-                                  "NcclAllReduce")});
+                                  node_name)});
 
   gradient_argdefs = allreduce_outputs;
   return Status::OK();
 }
 
+static int64_t GetAllReduceElementSize(ONNX_NAMESPACE::TensorProto_DataType allreduce_data_type) {
+  switch (allreduce_data_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      return 2;
+    default:
+      return 4;
+  }
+}
+
+// Splits the gradients into buckets of at most bucket_size_bytes each (a gradient larger than that gets a bucket of
+// its own), in the order the backward pass produces them. The gradients of the last layers come first, so the
+// allreduce of the first bucket only waits for the end of the backward pass of those layers and its communication
+// overlaps with the computation of the remaining gradients.
+static std::vector<std::vector<size_t>> GetGradientBuckets(
+    const Graph& graph,
+    const std::vector<std::string>& gradient_names,
+    const std::vector<ArgDef>& gradient_argdefs,
+    const int64_t element_size,
+    const int64_t bucket_size_bytes) {
+  if (bucket_size_bytes <= 0) {
+    std::vector<size_t> all_gradients(gradient_argdefs.size());
+    std::iota(all_gradients.begin(), all_gradients.end(), size_t{0});
+    return {all_gradients};
+  }
+
+  GraphViewer graph_viewer(graph);
+  std::unordered_map<NodeIndex, size_t> topological_positions;
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    topological_positions[node_topology_list[i]] = i;
+  }
+
+  // gradients without a producer, e.g. graph inputs, are never waited for and go last
+  std::vector<size_t> production_positions(gradient_names.size(), std::numeric_limits<size_t>::max());
+  for (size_t i = 0; i < gradient_names.size(); ++i) {
+    const Node* producer = graph.GetProducerNode(gradient_names[i]);
+    if (producer != nullptr) {
+      production_positions[i] = topological_positions[producer->Index()];
+    }
+  }
+
+  std::vector<size_t> production_order(gradient_argdefs.size());
+  std::iota(production_order.begin(), production_order.end(), size_t{0});
+  std::stable_sort(production_order.begin(), production_order.end(), [&production_positions](size_t a, size_t b) {
+    return production_positions[a] < production_positions[b];
+  });
+
+  std::vector<std::vector<size_t>> buckets;
+  int64_t current_bucket_bytes = 0;
+  for (size_t i : production_order) {
+    ORT_ENFORCE(gradient_argdefs[i].type_proto != nullptr);
+    const auto& gradient_shape_proto = gradient_argdefs[i].type_proto->tensor_type().shape();
+    const TensorShape gradient_shape = utils::GetTensorShapeFromTensorShapeProto(gradient_shape_proto);
+    // a gradient of unknown size does not count towards the size of its bucket
+    const int64_t gradient_bytes = std::max<int64_t>(gradient_shape.Size(), 0) * element_size;
+
+    if (buckets.empty() || current_bucket_bytes + gradient_bytes > bucket_size_bytes) {
+      if (buckets.empty() || !buckets.back().empty()) {
+        buckets.emplace_back();
+      }
+      current_bucket_bytes = 0;
+    }
+    buckets.back().push_back(i);
+    current_bucket_bytes += gradient_bytes;
+  }
+  return buckets;
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -74,16 +150,38 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
     return graph.GenerateNodeArgName(base_name);
   };
 
-  // add gradient scaling
-  std::vector<ArgDef> output_gradient_argdef;
+  // add gradient scaling and allreduce
   const auto total_num_accumulations =
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
-
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  const auto allreduce_data_type = opt_graph_config_.AllReduceDataType();
+
+  // Each bucket gets its own scaling and allreduce, so that they only depend on the gradients of the bucket.
+  const auto buckets = GetGradientBuckets(
+      graph, gradient_names_, gradient_argdefs,
+      GetAllReduceElementSize(allreduce_data_type),
+      opt_graph_config_.allreduce_bucket_size_bytes);
+  for (size_t bucket_index = 0; bucket_index < buckets.size(); ++bucket_index) {
+    const auto& bucket = buckets[bucket_index];
+    std::vector<ArgDef> bucket_gradient_argdefs;
+    bucket_gradient_argdefs.reserve(bucket.size());
+    for (size_t i : bucket) {
+      bucket_gradient_argdefs.push_back(gradient_argdefs[i]);
+    }
+
+    std::vector<ArgDef> output_gradient_argdef;
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, bucket_gradient_argdefs,
+                                                output_gradient_argdef, graph_defs, allreduce_data_type));
+
+    const std::string allreduce_node_name =
+        buckets.size() == 1 ? "NcclAllReduce" : "NcclAllReduce_bucket_" + std::to_string(bucket_index);
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(bucket_gradient_argdefs, output_gradient_argdef, graph_defs,
+                                                     allreduce_node_name));
+    for (size_t j = 0; j < bucket.size(); ++j) {
+      gradient_argdefs[bucket[j]] = bucket_gradient_argdefs[j];
+    }
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
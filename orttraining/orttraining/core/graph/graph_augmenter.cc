@@ -77,6 +77,9 @@ Status GraphAugmenter::AugmentGraph(Graph& graph,
     if (node_def.priority != 0) {
       n.SetPriority(node_def.priority);
     }
+    if (!node_def.execution_provider_type.empty()) {
+      n.SetExecutionProviderType(node_def.execution_provider_type);
+    }
   }
 
   // Add new inputs to the graph.
@@ -104,6 +104,8 @@ struct NodeDef {
   NodeAttributes attributes;
   std::string name;
   int priority;
+  // Execution provider to run the node on, empty to let graph partitioning assign it.
+  std::string execution_provider_type{};
 };
 
 /** GraphAugmenter is a stateless class to add new elements into a Graph.
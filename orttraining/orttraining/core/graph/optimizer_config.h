@@ -29,19 +29,23 @@ enum class MixedPrecisionDataType {
   BF16,
 };
 
-// Configuration for the DeepSpeed ZeRO technique.  Currently only the stage
-// setting is supported, and only with stages 0 (disabled) and 1 (optimizer
-// state partitioning).
+// Configuration for the DeepSpeed ZeRO technique.  Currently only stages 0
+// (disabled) and 1 (optimizer state partitioning) are supported.
+// With offload_optimizer_state, the optimizer nodes of stage 1 run on the CPU
+// execution provider, so that the partitioned optimizer states and weights
+// are kept in CPU memory.  Only fp32 training is supported with offload, as
+// the CPU optimizer kernels do not update mixed precision weights.
 
 struct ZeROConfig {
   // Default configuration
   ZeROConfig() {
   }
 
-  ZeROConfig(int s) : stage(s) {
+  ZeROConfig(int s, bool offload = false) : stage(s), offload_optimizer_state(offload) {
   }
 
   int stage{0};
+  bool offload_optimizer_state{false};
 };
 
 // configuration per optimizer node
@@ -73,6 +77,8 @@ struct OptimizerGraphConfig {
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
   AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
   bool enable_grad_norm_clip{true};
+  // upper bound of the bytes of gradients reduced by one allreduce, 0 reduces all gradients at once
+  int64_t allreduce_bucket_size_bytes{0};
 
   NameMLValMap shared_optimizer_states{};  // initial states for shared params, eg. 'Step' for lamb
 
@@ -436,6 +436,9 @@ ZeROOptimizerGraphBuilder::ZeROOptimizerGraphBuilder(
   ORT_ENFORCE(opt_graph_config.data_parallel_group_size > 1, "ZeRO optimizer graph builder can only be used for distributed training.");
   ORT_ENFORCE(opt_graph_config.use_nccl, "Distributed training with ZeRO is only supported with NCCL.");
   ORT_ENFORCE(IsNcclAvailable(), "Distributed training with NCCL is not supported, as NCCL is not enabled in this build.");
+  ORT_ENFORCE(!opt_graph_config.deepspeed_zero.offload_optimizer_state ||
+                  (!opt_graph_config.use_mixed_precision && !opt_graph_config.allreduce_in_mixed_precision_type),
+              "ZeRO optimizer state offload is only supported for fp32 training.");
 }
 
 Status ZeROOptimizerGraphBuilder::BuildInternal(
@@ -485,6 +488,7 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
   }
 
   // add weight update
+  const size_t num_node_defs_before_update = graph_defs.NodeDefs().size();
   ORT_RETURN_IF_ERROR(AddDirectWeightUpdate(
       opt_builder_registry_, weight_argdefs, gradient_argdefs,
       &global_grad_norm_argdef,
@@ -492,6 +496,15 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
       opt_configs_, graph_defs,
       optimizer_state_initializer_names));
 
+  // run the weight update on CPU, so that the optimizer states and the weight partitions only consumed by it are
+  // allocated in CPU memory. The session inserts the copies of the gradients and the updated weights.
+  if (opt_graph_config_.deepspeed_zero.offload_optimizer_state) {
+    auto& node_defs = graph_defs.NodeDefs();
+    for (size_t i = num_node_defs_before_update; i < node_defs.size(); ++i) {
+      node_defs[i].execution_provider_type = kCpuExecutionProvider;
+    }
+  }
+
   // add Allgather for weights
   ORT_RETURN_IF_ERROR(AddNcclAllGatherForWeights(weight_argdefs, graph_defs));
 
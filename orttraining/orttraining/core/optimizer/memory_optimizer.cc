@@ -52,6 +52,74 @@ static size_t GetElementSize(const ONNX_NAMESPACE::DataType& tensor_type) {
   return elt_type->Size();
 }
 
+// Returns the number of elements of the node arg, or -1 if its shape is not static.
+int64_t GetStaticElementCount(const NodeArg& arg) {
+  const ONNX_NAMESPACE::TensorShapeProto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return -1;
+  }
+
+  int64_t count = 1;
+  for (int dim_index = 0; dim_index < shape->dim_size(); dim_index++) {
+    const auto& dim = shape->dim(dim_index);
+    if (!utils::HasDimValue(dim)) {
+      return -1;
+    }
+    count *= dim.dim_value();
+  }
+  return count;
+}
+
+// Returns the size in bytes of the node arg, or -1 if its shape or type is not static.
+int64_t GetStaticSizeInBytes(const NodeArg& arg) {
+  const int64_t count = GetStaticElementCount(arg);
+  if (count < 0 || arg.TypeAsProto() == nullptr || !arg.TypeAsProto()->has_tensor_type() ||
+      arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return -1;
+  }
+  return count * static_cast<int64_t>(GetElementSize(arg.Type()));
+}
+
+// Returns a rough estimate of the FLOPs to compute the node, or -1 if its shapes are not static.
+int64_t EstimateFlops(const Node& node) {
+  const std::string& op_type = node.OpType();
+  if (op_type == "Reshape" || op_type == "Squeeze" || op_type == "Unsqueeze") {
+    return 0;
+  }
+
+  const int64_t output_count = GetStaticElementCount(*node.OutputDefs()[0]);
+  if (output_count < 0) {
+    return -1;
+  }
+
+  if (op_type == "MatMul" || op_type == "FusedMatMul") {
+    const ONNX_NAMESPACE::TensorShapeProto* a_shape = node.InputDefs()[0]->Shape();
+    if (a_shape == nullptr || a_shape->dim_size() == 0) {
+      return -1;
+    }
+    // The reduced dimension is the last one of A, or the second to last one if A is transposed.
+    int reduced_dim_index = a_shape->dim_size() - 1;
+    const auto trans_a = node.GetAttributes().find("transA");
+    if (trans_a != node.GetAttributes().end() && trans_a->second.i() != 0 && a_shape->dim_size() > 1) {
+      reduced_dim_index = a_shape->dim_size() - 2;
+    }
+    const auto& reduced_dim = a_shape->dim(reduced_dim_index);
+    return utils::HasDimValue(reduced_dim) ? 2 * output_count * reduced_dim.dim_value() : -1;
+  }
+
+  if (op_type == "Softmax" || op_type == "BiasSoftmax" || op_type == "BiasSoftmaxDropout") {
+    // max, subtract, exp, sum and divide per element.
+    return 5 * output_count;
+  }
+
+  if (op_type == "Gelu" || op_type == "FastGelu" || op_type == "BiasGelu") {
+    // The erf or tanh approximation takes several operations per element.
+    return 8 * output_count;
+  }
+
+  return output_count;
+}
+
 // TODO(pengwa): extend this function to be more general.
 float InputOutputSizeRatio(const Node* node) {
   if (node->OpType().compare("Cast") == 0) {
@@ -73,7 +141,8 @@ float InputOutputSizeRatio(const Node* node) {
 }  // namespace
 
 Status MemoryOptimizer::ParseConfigFromString(const std::string& enable_memory_optimizer,
-                                              const std::string& level) {
+                                              const std::string& level,
+                                              const std::string& recompute_memory_budget) {
   optimizer_config_ = enable_memory_optimizer;
   if (!enable_memory_optimizer.empty()) {
     const auto user_config_strs = utils::SplitString(enable_memory_optimizer, ",");
@@ -104,6 +173,15 @@ Status MemoryOptimizer::ParseConfigFromString(const std::string& enable_memory_o
                     "Invalid probe level specified: ", level);
   recompute_probe_level_ = static_cast<ProbeLevel>(probe_level);
 
+  if (!recompute_memory_budget.empty()) {
+    int64_t budget = -1;
+    auto result = std::from_chars(recompute_memory_budget.data(),
+                                  recompute_memory_budget.data() + recompute_memory_budget.size(), budget);
+    ORT_RETURN_IF_NOT(result.ec == std::errc() && budget >= 0,
+                      "Invalid recompute memory budget specified: ", recompute_memory_budget);
+    recompute_memory_budget_bytes_ = budget;
+  }
+
   return Status::OK();
 }
 
@@ -219,6 +297,11 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
 
   subgraph_desc.skip_count += 1;
 
+  if (subgraph_stores.IsSubGraphInstanceSelectedForBudget(node)) {
+    user_config = UserConfig{OptimizationType::Recompute, -1};
+    skip_count = 0;
+  }
+
   if (user_config.type != OptimizationType::None && subgraph_desc.skip_count > skip_count) {
     subgraph_desc.applied_count += 1;
     Node* replacement_node_ptr = nullptr;
@@ -327,6 +410,10 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
     }
   }
 
+  if (recompute_memory_budget_bytes_ >= 0) {
+    SelectRecomputeSubgraphsForMemoryBudget(candidate_output_args_map, recompute_subgraph_stores, logger);
+  }
+
   // The second pass - apply the transformation.
   // Iterate through the nodes in reversed topological order and find the subgraph that can be alleviated.
   // The reason we do reversed topological order is that we want the later layers' recompute nodes can be appended
@@ -421,6 +508,9 @@ void MemoryOptimizer::PrintSummary(const SubGraphStores& recompute_stores,
         freq_info = " (requested_count=" + std::to_string(subgraph_it->second.user_optimizer_config.requested_count) +
                     ", actual applied_count=" +
                     std::to_string(subgraph_it->second.applied_count) + ")";
+      else if (subgraph_it->second.applied_count > 0)
+        freq_info = " (recomputed for memory budget, applied_count=" +
+                    std::to_string(subgraph_it->second.applied_count) + ")";
       summary << "\tSubgraph: " << subgraph_it->first << "\n"
               << "\t\tOptimizationType: "
               << UserConfigToString(subgraph_it->second.user_optimizer_config) << freq_info << "\n"
@@ -707,6 +797,97 @@ void MemoryOptimizer::CheckNodeForRecompute(const Node& node,
   return;
 }
 
+void MemoryOptimizer::SelectRecomputeSubgraphsForMemoryBudget(const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                                                  candidate_output_args_map,
+                                                              SubGraphStores& subgraph_stores,
+                                                              const logging::Logger& logger) const {
+  int64_t stashed_bytes = 0;
+  size_t unknown_size_count = 0;
+  for (const auto& [node, output_indices] : candidate_output_args_map) {
+    for (size_t output_index : output_indices) {
+      const int64_t size = GetStaticSizeInBytes(*node->OutputDefs()[output_index]);
+      if (size < 0) {
+        unknown_size_count++;
+      } else {
+        stashed_bytes += size;
+      }
+    }
+  }
+
+  const int64_t bytes_to_save = stashed_bytes - recompute_memory_budget_bytes_;
+  LOGS(logger, INFO) << "Recompute memory budget: " << recompute_memory_budget_bytes_ << " bytes, stashed activations: "
+                     << stashed_bytes << " bytes (" << unknown_size_count << " activations of unknown size not counted)";
+  if (bytes_to_save <= 0) {
+    return;
+  }
+
+  struct Candidate {
+    const Node* node;
+    int64_t saved_bytes;
+    int64_t flops;
+  };
+
+  InlinedVector<Candidate> candidates;
+  for (const auto& [node, instance_info] : subgraph_stores._optimization_target_graphs_) {
+    // User configs take precedence over the budget.
+    if (subgraph_stores.subgraph_descs.at(instance_info.second).user_optimizer_config.type != OptimizationType::None) {
+      continue;
+    }
+
+    int64_t saved_bytes = 0;
+    for (size_t output_index : candidate_output_args_map.at(node)) {
+      const int64_t size = GetStaticSizeInBytes(*node->OutputDefs()[output_index]);
+      saved_bytes = (size < 0 || saved_bytes < 0) ? -1 : saved_bytes + size;
+    }
+
+    int64_t flops = 0;
+    for (const Node* subgraph_node : instance_info.first) {
+      const int64_t node_flops = EstimateFlops(*subgraph_node);
+      flops = (node_flops < 0 || flops < 0) ? -1 : flops + node_flops;
+    }
+
+    if (saved_bytes <= 0 || flops < 0) {
+      LOGS(logger, VERBOSE) << "Node " << node->Name() << "(" << node->OpType() << ") is not selected for memory "
+                            << "budget, as its saved memory or recompute FLOPs cannot be estimated.";
+      continue;
+    }
+    candidates.push_back(Candidate{node, saved_bytes, flops});
+  }
+
+  // Cheapest recompute per saved byte first. The node index breaks ties, so that the selection is deterministic.
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& lhs, const Candidate& rhs) {
+    const double lhs_cost = static_cast<double>(lhs.flops) / static_cast<double>(lhs.saved_bytes);
+    const double rhs_cost = static_cast<double>(rhs.flops) / static_cast<double>(rhs.saved_bytes);
+    if (lhs_cost != rhs_cost) {
+      return lhs_cost < rhs_cost;
+    }
+    return lhs.node->Index() < rhs.node->Index();
+  });
+
+  int64_t saved_bytes = 0;
+  int64_t extra_flops = 0;
+  for (const Candidate& candidate : candidates) {
+    if (saved_bytes >= bytes_to_save) {
+      break;
+    }
+    subgraph_stores.SelectSubGraphInstanceForBudget(candidate.node);
+    saved_bytes += candidate.saved_bytes;
+    extra_flops += candidate.flops;
+    LOGS(logger, INFO) << "Node " << candidate.node->Name() << "(" << candidate.node->OpType() << ") is selected to "
+                       << "recompute subgraph " << subgraph_stores._optimization_target_graphs_.at(candidate.node).second
+                       << " for memory budget, saving " << candidate.saved_bytes << " bytes with "
+                       << candidate.flops << " extra FLOPs";
+  }
+
+  if (saved_bytes >= bytes_to_save) {
+    LOGS(logger, INFO) << "Recompute for memory budget saves " << saved_bytes << " bytes with " << extra_flops
+                       << " extra FLOPs per step.";
+  } else {
+    LOGS(logger, WARNING) << "Recompute for memory budget saves " << saved_bytes << " of the " << bytes_to_save
+                          << " bytes needed with " << extra_flops << " extra FLOPs per step, the budget cannot be met.";
+  }
+}
+
 Status MemoryOptimizer::CreateRecomputeGraph(Graph& graph,
                                              const InlinedVector<const Node*>& nodes_in_topological_order,
                                              Node*& new_output_node_ptr) const {
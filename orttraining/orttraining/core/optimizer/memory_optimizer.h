@@ -136,12 +136,23 @@ class MemoryOptimizer : public GraphTransformer {
       return _optimization_target_graphs_[node];
     }
 
+    void SelectSubGraphInstanceForBudget(const Node* node) {
+      ORT_ENFORCE(ContainsSubGraphInstance(node));
+      _budget_selected_nodes_.insert(node);
+    }
+
+    bool IsSubGraphInstanceSelectedForBudget(const Node* node) const {
+      return _budget_selected_nodes_.find(node) != _budget_selected_nodes_.end();
+    }
+
     /***********************************
     ** subgraph instance section ends **
     ***********************************/
 
     InlinedHashMap<std::string /*subgraph_representative_str*/, SubGraphDesc> subgraph_descs;
     InlinedHashMap<const Node*, GraphInstanceInfo> _optimization_target_graphs_;
+    // Subgraph instances selected to recompute by the memory budget, among those without user config.
+    InlinedHashSet<const Node*> _budget_selected_nodes_;
   };
 
   /**
@@ -153,10 +164,17 @@ class MemoryOptimizer : public GraphTransformer {
   };
 
  public:
-  MemoryOptimizer(const std::string& enable_memory_optimizer, const std::string& level)
+  /**
+   * @param enable_memory_optimizer User configs of subgraph patterns to optimize.
+   * @param level Probe level of recomputable subgraphs.
+   * @param recompute_memory_budget Budget in bytes for the stashed activations. If not empty, the subgraphs without
+   *  user config are recomputed as needed to fit the budget, see SelectRecomputeSubgraphsForMemoryBudget.
+   */
+  MemoryOptimizer(const std::string& enable_memory_optimizer, const std::string& level,
+                  const std::string& recompute_memory_budget = "")
       : GraphTransformer("MemoryOptimizer") {
     // Parse user defined configs.
-    ORT_ENFORCE(ParseConfigFromString(enable_memory_optimizer, level).IsOK());
+    ORT_ENFORCE(ParseConfigFromString(enable_memory_optimizer, level, recompute_memory_budget).IsOK());
 
     RegisterAllowedRecomputeOps();
   }
@@ -166,7 +184,8 @@ class MemoryOptimizer : public GraphTransformer {
   bool ShouldOnlyApplyOnce() const override { return true; }
 
  private:
-  Status ParseConfigFromString(const std::string& enable_memory_optimizer, const std::string& level);
+  Status ParseConfigFromString(const std::string& enable_memory_optimizer, const std::string& level,
+                               const std::string& recompute_memory_budget);
 
   /**
    * @brief Prepare info including activation usage, node usage in fw and bw.
@@ -307,6 +326,24 @@ class MemoryOptimizer : public GraphTransformer {
                              bool compromise_stashed_activation,
                              bool& can_compromise_stashed_activation) const;
 
+  /**
+   * @brief Select the recomputable subgraphs without user config to recompute, so that the stashed activations fit
+   * the memory budget with the least extra compute.
+   *
+   * The size of the stashed activations and the FLOPs to recompute the subgraphs are estimated from static shapes,
+   * and subgraphs are selected greedily by their FLOPs per saved byte. Activations and subgraphs whose shapes are not
+   * static are not counted, nor selected.
+   *
+   * @param candidate_output_args_map A map from node to its candidate activations, which are consumed by both fw and
+   *  bw ops.
+   * @param subgraph_stores A store of the found subgraphs, where the selected subgraph instances are marked.
+   * @param logger Logger.
+   */
+  void SelectRecomputeSubgraphsForMemoryBudget(const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                                   candidate_output_args_map,
+                                               SubGraphStores& subgraph_stores,
+                                               const logging::Logger& logger) const;
+
   /**
    * @brief Duplicate nodes to create a recompute subgraph.
    *
@@ -329,6 +366,8 @@ class MemoryOptimizer : public GraphTransformer {
   InlinedHashMap<std::string, UserConfig> pattern_subgraph_to_user_optimizer_config_map_;
   std::string optimizer_config_;
   ProbeLevel recompute_probe_level_;
+  // Budget in bytes for the stashed activations, -1 if not set.
+  int64_t recompute_memory_budget_bytes_{-1};
 };
 
 }  // namespace onnxruntime
@@ -54,6 +54,10 @@ Status SetupOptimizerParams(
     std::unordered_map<std::string, std::string>& weight_name_map_after_graph_transform) {
   ORT_RETURN_IF_NOT(config.optimizer_config.has_value(), "config.optimizer_config.has_value() was false");
   const auto& optimizer_config = config.optimizer_config.value();
+  // The fp32 weights stay the master weights of the optimizer, only the moments can be kept in fp16.
+  ORT_RETURN_IF(optimizer_config.use_mixed_precision_moments && config.mixed_precision_config.has_value() &&
+                    config.mixed_precision_config.value().mixed_precision_type != MixedPrecisionDataType::FP16,
+                "Mixed precision moments are only supported with FP16 mixed precision.");
 
   // This is the mapping from the new weight name to the original weight name
   // It is required to look up the optimizer config for the original weight
@@ -122,6 +126,7 @@ Status SetupOptimizerParams(
   opt_graph_config.adasum_reduction_type = optimizer_config.adasum_reduction_type;
   opt_graph_config.enable_grad_norm_clip = optimizer_config.enable_grad_norm_clip;
   opt_graph_config.deepspeed_zero = optimizer_config.deepspeed_zero;
+  opt_graph_config.allreduce_bucket_size_bytes = optimizer_config.allreduce_bucket_size_bytes;
 
   // check if shared initial optimizer states have been provided
   const auto optim_state_it = init_optimizer_states.find(onnxruntime::training::SHARED_OPTIMIZER_STATES_KEY);
@@ -192,6 +192,8 @@ class TrainingSession : public InferenceSession {
       AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
       // Whether to enable gradient clipping.
       bool enable_grad_norm_clip{true};
+      // The maximum bytes of gradients per NCCL allreduce, 0 reduces all gradients with one allreduce.
+      int64_t allreduce_bucket_size_bytes{0};
     };
     // The optimizer configuration.
     // If not provided, no optimizer is added.
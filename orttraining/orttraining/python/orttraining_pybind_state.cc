@@ -135,6 +135,8 @@ struct TrainingParameters {
   bool use_fp16_moments = false;
 
   bool use_mixed_precision = false;
+  // bf16 instead of fp16 mixed precision, which trains without loss scaling
+  bool use_bf16 = false;
   bool allreduce_post_accumulation = false;
   float loss_scale = 0.0f;
   int world_rank = 0;
@@ -147,6 +149,8 @@ struct TrainingParameters {
   int pipeline_parallel_size = 1;
   int num_pipeline_micro_batches = 1;
   int deepspeed_zero_stage = 0;
+  bool deepspeed_zero_offload_optimizer_state = false;
+  int64_t allreduce_bucket_size_bytes = 0;
   bool enable_grad_norm_clip = true;
   bool set_gradients_as_graph_outputs = false;
   bool use_memory_efficient_gradient = false;
@@ -256,6 +260,9 @@ TrainingConfigurationResult ConfigureSessionForTraining(
   if (parameters.use_mixed_precision) {
     training::PipelineTrainingSession::TrainingConfiguration::MixedPrecisionConfiguration mp{};
     mp.use_mixed_precision_initializers = true;
+    if (parameters.use_bf16) {
+      mp.mixed_precision_type = training::MixedPrecisionDataType::BF16;
+    }
 
     config.mixed_precision_config = mp;
   }
@@ -340,8 +347,10 @@ TrainingConfigurationResult ConfigureSessionForTraining(
     // eventually we will have one all reduce kernel and let opt to have
     // an allreduce_post_accumulation option and remove the use_nccl option.
     opt.use_nccl = parameters.allreduce_post_accumulation;
-    opt.deepspeed_zero = onnxruntime::training::ZeROConfig(parameters.deepspeed_zero_stage);
+    opt.deepspeed_zero = onnxruntime::training::ZeROConfig(parameters.deepspeed_zero_stage,
+                                                                parameters.deepspeed_zero_offload_optimizer_state);
     opt.enable_grad_norm_clip = parameters.enable_grad_norm_clip;
+    opt.allreduce_bucket_size_bytes = parameters.allreduce_bucket_size_bytes;
 
     // TODO reduction types
     if (parameters.enable_adasum) {
@@ -471,6 +480,7 @@ void addObjectMethodsForTraining(py::module& m, ExecutionProviderRegistrationFn
       .def_readwrite("sliced_axes", &TrainingParameters::sliced_axes)
       .def_readwrite("use_fp16_moments", &TrainingParameters::use_fp16_moments)
       .def_readwrite("use_mixed_precision", &TrainingParameters::use_mixed_precision)
+      .def_readwrite("use_bf16", &TrainingParameters::use_bf16)
       .def_readwrite("allreduce_post_accumulation", &TrainingParameters::allreduce_post_accumulation)
       .def_readwrite("loss_scale", &TrainingParameters::loss_scale)
       .def_readwrite("world_rank", &TrainingParameters::world_rank)
@@ -482,6 +492,9 @@ void addObjectMethodsForTraining(py::module& m, ExecutionProviderRegistrationFn
       .def_readwrite("num_pipeline_micro_batches", &TrainingParameters::num_pipeline_micro_batches)
       .def_readwrite("gradient_accumulation_steps", &TrainingParameters::gradient_accumulation_steps)
       .def_readwrite("deepspeed_zero_stage", &TrainingParameters::deepspeed_zero_stage)
+      .def_readwrite("deepspeed_zero_offload_optimizer_state",
+                     &TrainingParameters::deepspeed_zero_offload_optimizer_state)
+      .def_readwrite("allreduce_bucket_size_bytes", &TrainingParameters::allreduce_bucket_size_bytes)
       .def_readwrite("enable_grad_norm_clip", &TrainingParameters::enable_grad_norm_clip)
       .def_readwrite("set_gradients_as_graph_outputs", &TrainingParameters::set_gradients_as_graph_outputs)
       .def_readwrite("use_memory_efficient_gradient", &TrainingParameters::use_memory_efficient_gradient)
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+
 #include "gtest/gtest.h"
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/framework/distributed_run_context.h"
@@ -112,5 +114,41 @@ TEST(Pipeline, ScheduleB5S3) {
   TestPipelineScheduler(num_batches, num_stages, baseline_events);
 }
 
+TEST(Pipeline, InterleavedScheduleB4S2V2) {
+  constexpr int num_batches = 4;
+  constexpr int num_ranks = 2;
+  constexpr int num_virtual_stages_per_rank = 2;
+  const std::vector<int> ranks{3, 5};
+  onnxruntime::training::pipeline::PipelineScheduler schedule(num_batches, num_ranks, ranks,
+                                                              num_virtual_stages_per_rank);
+  ASSERT_EQ(schedule.GetStageSize(), static_cast<size_t>(num_ranks * num_virtual_stages_per_rank));
+  ASSERT_EQ(schedule.GetRankSize(), static_cast<size_t>(num_ranks));
+
+  for (int r = 0; r < num_ranks; ++r) {
+    // Events are chained over all stages of a rank, so no two computations of a rank record the same event.
+    std::vector<int> recorded_events;
+    for (int s = r; s < num_ranks * num_virtual_stages_per_rank; s += num_ranks) {
+      for (int b = 0; b < num_batches; ++b) {
+        const auto forward_compute_record = schedule.GetForwardComputeRecordedEvent(b, s);
+        const auto backward_compute_record = schedule.GetBackwardComputeRecordedEvent(b, s);
+        EXPECT_GT(forward_compute_record, schedule.GetForwardComputeWaitedEvent(b, s)) << " batch " << b << " stage " << s;
+        EXPECT_GT(backward_compute_record, forward_compute_record) << " batch " << b << " stage " << s;
+        recorded_events.push_back(forward_compute_record);
+        recorded_events.push_back(backward_compute_record);
+      }
+
+      // Send and Recv of stage s run on its rank, and talk to the ranks of the adjacent stages.
+      for (auto slot : schedule.GetSchedule(s)) {
+        for (const auto& task : slot.GetTasks()) {
+          EXPECT_EQ(task.this_rank, ranks[r]) << " stage " << s;
+          EXPECT_EQ(task.peer_rank, ranks[1 - r]) << " stage " << s;
+        }
+      }
+    }
+    std::sort(recorded_events.begin(), recorded_events.end());
+    EXPECT_EQ(std::adjacent_find(recorded_events.begin(), recorded_events.end()), recorded_events.end()) << " rank " << r;
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
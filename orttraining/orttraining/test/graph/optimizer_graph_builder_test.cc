@@ -276,10 +276,14 @@ static void TestDefaultOptimizerGraphBuilder(OptimizerGraphConfig config, Graph&
     ASSERT_GT(opt_graph_outputs.count(OptimizerOutputKey::GradientAccumulation), 0);
   }
 
-  // verify mixed precision operations exist
+  // verify mixed precision operations exist, bf16 has no loss scaling to check the gradients for
   if (config.use_mixed_precision) {
     ASSERT_GT(GetOpCount(op_counts, k_gradient_norm_op_name), 0);
-    ASSERT_GT(GetOpCount(op_counts, k_is_all_finite_op_name), 0);
+    if (config.mixed_precision_type == MixedPrecisionDataType::FP16) {
+      ASSERT_GT(GetOpCount(op_counts, k_is_all_finite_op_name), 0);
+    } else {
+      ASSERT_EQ(GetOpCount(op_counts, k_is_all_finite_op_name), 0);
+    }
   }
 
   // verify optimizers exist
@@ -321,6 +325,14 @@ TEST_F(OptimizerGraphBuilderTest, Default_WithGradientAccumulation_WithMixedPrec
   TestDefaultOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Default_NoGradientAccumulation_WithBF16MixedPrecision) {
+  OptimizerGraphConfig config;
+  config.gradient_accumulation_steps = 1;
+  config.use_mixed_precision = true;
+  config.mixed_precision_type = MixedPrecisionDataType::BF16;
+  TestDefaultOptimizerGraphBuilder(config, graph_);
+}
+
 #if defined(ORT_USE_NCCL)
 static void TestAllreduceOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
@@ -478,6 +490,19 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_BucketedGradients) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  // smaller than any gradient, so that each gradient is reduced by an allreduce of its own
+  config.allreduce_bucket_size_bytes = 1;
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_unscale_op_name), k_weight_names.size());
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
@@ -511,6 +536,15 @@ static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& gr
 
   // verify optimizers exist
   ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), k_weight_names.size());
+
+  // verify offloaded optimizers run on CPU
+  if (config.deepspeed_zero.offload_optimizer_state) {
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() == k_adam_optimizer_op_name) {
+        ASSERT_EQ(node.GetExecutionProviderType(), kCpuExecutionProvider);
+      }
+    }
+  }
 }
 
 TEST_F(OptimizerGraphBuilderTest, ZeRO_NoGradientAccumulation_NoMixedPrecision) {
@@ -555,6 +589,16 @@ TEST_F(OptimizerGraphBuilderTest, ZeRO_WithGradientAccumulation_WithMixedPrecisi
   TestZeROOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, ZeRO_OffloadOptimizerState_NoMixedPrecision) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{1, true};
+  config.gradient_accumulation_steps = 1;
+  config.use_mixed_precision = false;
+  TestZeROOptimizerGraphBuilder(config, graph_);
+}
+
 #endif  // ORT_USE_NCCL
 
 }  // namespace test
@@ -26,6 +26,7 @@
 #include "test/capturing_sink.h"
 #include "test/test_environment.h"
 #include "test/util/include/asserts.h"
+#include "orttraining/core/graph/recompute_graph_utils.h"
 #include "orttraining/core/optimizer/memory_optimizer.h"
 
 using namespace std;
@@ -143,5 +144,51 @@ TEST(MemoryOptimizerTests, TileRecompute) {
   ASSERT_EQ(query_layer_grad_node->Priority(), static_cast<int>(ExecutionPriority::DEFAULT));
 }
 
+// Builds X -> Gelu -> YieldOp -> Mul, where the Gelu output of 8x16 floats is stashed for the Mul in backward.
+static void BuildStashedGeluGraph(Graph& graph) {
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+
+  auto& input_x = graph.GetOrCreateNodeArg("X", &tensor_type);
+  auto& gelu_out = graph.GetOrCreateNodeArg("gelu_out", &tensor_type);
+  auto& gelu_out_grad = graph.GetOrCreateNodeArg("gelu_out_grad", &tensor_type);
+  auto& output_z = graph.GetOrCreateNodeArg("Z", &tensor_type);
+
+  graph.AddNode("gelu", "Gelu", "", {&input_x}, {&gelu_out}, nullptr, kMSDomain);
+  NodeAttributes yield_attributes;
+  yield_attributes["full_shape_outputs"] = ONNX_NAMESPACE::MakeAttribute("full_shape_outputs",
+                                                                         std::vector<int64_t>{0});
+  graph.AddNode("yield", "YieldOp", "", {&gelu_out}, {&gelu_out_grad}, &yield_attributes, kMSDomain);
+  graph.AddNode("mul", "Mul", "", {&gelu_out_grad, &gelu_out}, {&output_z});
+}
+
+TEST(MemoryOptimizerTests, GeluRecomputeForMemoryBudget) {
+  const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
+
+  // The stashed Gelu output takes 8 * 16 * 4 bytes, so it is recomputed for a smaller budget only.
+  for (const auto& [budget, expected_gelu_count] : std::vector<std::pair<std::string, int>>{{"0", 2}, {"512", 1}}) {
+    Model model("GeluRecomputeForMemoryBudget", true, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{"", 14}, {"com.microsoft", 1}}, {}, *logger);
+    Graph& graph = model.MainGraph();
+    BuildStashedGeluGraph(graph);
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<MemoryOptimizer>("", "0", budget), TransformerLevel::Level3));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_EQ(op_to_count["com.microsoft.Gelu"], expected_gelu_count) << "budget " << budget;
+    if (expected_gelu_count == 2) {
+      const Node* mul_node = graph.GetProducerNode("Z");
+      ASSERT_NE(mul_node, nullptr);
+      ASSERT_EQ(mul_node->InputDefs()[1]->Name(), graph_utils::RecomputeName("gelu_out"));
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -435,4 +436,64 @@ TEST(CheckpointApiTest, SaveCustomPropertyAsCheckpoint_ThenLoad_CPU) {
   std::string restored_s_data = restored_property_bag.GetProperty<std::string>(s_property_name);
   ASSERT_EQ(s_data, restored_s_data);
 }
+
+/**
+ * Save a checkpoint in the background while the states are updated,
+ * Then load it into ORT, compare with the values at the time of the save.
+ */
+TEST(CheckpointApiTest, SaveCheckpointAsync_UpdateStates_ThenLoad_CPU) {
+  /// Phase 1 - Test Preparation
+  /// Prepare the data and dest folder for saving checkpoint.
+  const std::vector<int64_t> fc1_weight_shape{500, 784};
+
+  onnxruntime::training::test::training_api::SyntheticDataLoader data_loader;
+  auto sample = onnxruntime::training::test::training_api::SyntheticSampleBatch();
+  sample.AddFloatInput(fc1_weight_shape);
+  data_loader.AddSyntheticSampleBatch(std::move(sample));
+
+  std::vector<Ort::Value> all_weights_values;
+  data_loader.GetNextSampleBatch(all_weights_values);
+  ASSERT_EQ(all_weights_values.size(), 1);
+
+  CheckpointState checkpoint_state;
+  auto param = std::make_shared<Parameter>("fc1.weight", *all_weights_values[0], true /*is_trainable*/);
+  checkpoint_state.module_checkpoint_state.named_parameters.insert({"fc1.weight", param});
+  const Tensor& weight_tensor = param->Data().Get<Tensor>();
+  const std::vector<float> expected_weight(weight_tensor.Data<float>(),
+                                           weight_tensor.Data<float>() + weight_tensor.Shape().Size());
+
+  int64_t i_data = 400;
+  std::string i_property_name("dataset_epoch_index");
+  checkpoint_state.property_bag.AddProperty(i_property_name, i_data);
+
+  // Remove the temporary directory if it already exists.
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+
+  /// Phase 2 - Call save checkpoint async API, and update the states while it is saved.
+  PathString checkpoint_path{
+      ConcatPathComponent(tmp_dir.Path(), ORT_TSTR("e2e_ckpt_save_async_cpu"))};
+  std::unique_ptr<CheckpointSaveHandle> handle;
+  ASSERT_STATUS_OK(SaveCheckpointAsync(checkpoint_state, checkpoint_path, false, handle));
+  ASSERT_NE(handle, nullptr);
+
+  Tensor* mutable_weight_tensor = param->Data().GetMutable<Tensor>();
+  std::fill_n(mutable_weight_tensor->MutableData<float>(), mutable_weight_tensor->Shape().Size(), 0.0f);
+  checkpoint_state.property_bag.AddProperty(i_property_name, i_data + 1);
+
+  ASSERT_STATUS_OK(handle->Wait());
+  ASSERT_TRUE(handle->IsDone());
+
+  /// Phase 3 - Load the checkpoint and compare with the states at the time of the save.
+  CheckpointState checkpoint_state_to_load;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, checkpoint_state_to_load));
+  const auto& restored_params = checkpoint_state_to_load.module_checkpoint_state.named_parameters;
+  ASSERT_EQ(restored_params.size(), 1);
+  const Tensor& restored_tensor = restored_params.at("fc1.weight")->Data().Get<Tensor>();
+  ASSERT_EQ(restored_tensor.Shape(), weight_tensor.Shape());
+  const std::vector<float> restored_weight(restored_tensor.Data<float>(),
+                                           restored_tensor.Data<float>() + restored_tensor.Shape().Size());
+  ASSERT_EQ(restored_weight, expected_weight);
+  ASSERT_EQ(checkpoint_state_to_load.property_bag.GetProperty<int64_t>(i_property_name), i_data);
+}
 }  // namespace onnxruntime::training::test
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <fstream>
 
 #include "gtest/gtest.h"
@@ -361,6 +362,63 @@ TEST(AdamWTest, HFAdamWMultipleWeightsStrictTest_Loop10Steps) {
   HFAdamWMultipleWeightsTestLoop10Steps(true);
 }
 
+// Many small weights and one weight larger than the chunks the CPU kernel splits the weights into, checked against a
+// reference implementation of the Torch AdamW update.
+TEST(AdamWTest, TorchAdamWManyWeightsTest_Loop3Steps) {
+  const size_t total_step = 3;
+  const float lr = 1e-03f, alpha = 0.9f, beta = 0.999f, epsilon = 1e-8f, weight_decay = 1e-2f;
+
+  std::unordered_map<std::string, VectorInt64> weight_name_shape_mapping = {{"big.weight", {3, 5000}}};
+  for (int i = 0; i < 20; ++i) {
+    weight_name_shape_mapping["small" + std::to_string(i) + ".bias"] = {7};
+  }
+
+  WeightDictType named_weights, named_gradients, named_momentum1s, named_momentum2s;
+  int seed = 0;
+  for (const auto& [name, shape] : weight_name_shape_mapping) {
+    const size_t size = static_cast<size_t>(shape.size() == 2 ? shape[0] * shape[1] : shape[0]);
+    std::vector<float> weight(size), momentum1(size, 0.f), momentum2(size, 0.f);
+    for (size_t i = 0; i < size; ++i) {
+      weight[i] = std::sin(static_cast<float>(seed + i));
+    }
+    named_weights[name].push_back(weight);
+    named_momentum1s[name].push_back(momentum1);
+    named_momentum2s[name].push_back(momentum2);
+
+    for (size_t step = 1; step <= total_step; ++step) {
+      std::vector<float> gradient(size);
+      for (size_t i = 0; i < size; ++i) {
+        gradient[i] = std::cos(static_cast<float>(seed + i * step));
+      }
+
+      const double alpha_correction = 1.0 - std::pow(alpha, step);
+      const double beta_correction = 1.0 - std::pow(beta, step);
+      for (size_t i = 0; i < size; ++i) {
+        weight[i] = static_cast<float>(weight[i] - weight[i] * lr * weight_decay);
+        momentum1[i] = static_cast<float>(alpha * momentum1[i] + (1.0 - alpha) * gradient[i]);
+        momentum2[i] = static_cast<float>(beta * momentum2[i] + (1.0 - beta) * gradient[i] * gradient[i]);
+        const double denom = std::sqrt(momentum2[i] / beta_correction) + epsilon;
+        weight[i] = static_cast<float>(weight[i] - lr * momentum1[i] / (alpha_correction * denom));
+      }
+
+      named_gradients[name].push_back(gradient);
+      named_weights[name].push_back(weight);
+      named_momentum1s[name].push_back(momentum1);
+      named_momentum2s[name].push_back(momentum2);
+    }
+    seed += 17;
+  }
+
+  AdamWTestLoop([]() -> std::unique_ptr<IExecutionProvider> { return DefaultCpuExecutionProvider(); },
+                true, total_step, lr, alpha, beta, epsilon, weight_decay,
+                static_cast<int64_t>(0),  // adam_mode
+                static_cast<int64_t>(1),  // correct_bias
+                named_weights, named_gradients,
+                named_momentum1s, named_momentum2s,
+                weight_name_shape_mapping,
+                {1e-4f, 1e-5f}, {1e-3f, 1e-6f}, {1e-2f, 1e-7f});
+}
+
 }  // namespace
 
 }  // namespace optimizer
@@ -3,6 +3,8 @@
 
 #include "orttraining/training_api/checkpoint.h"
 
+#include <filesystem>
+
 #include "core/flatbuffers/checkpoint_version.h"
 #include "core/flatbuffers/schema/ort_training_checkpoint.fbs.h"
 #include "core/framework/framework_common.h"
@@ -64,6 +66,45 @@ Status FlatbufferTensorFromOrtValue(
   return Status::OK();
 }
 
+/**
+ * @brief Get the cpu allocator owning the tensors created by the checkpoint functions.
+ */
+AllocatorPtr GetCpuAllocator() {
+  static CPUExecutionProviderInfo info;
+  static CPUExecutionProvider cpu_provider(info);
+  static AllocatorPtr cpu_allocator = cpu_provider.CreatePreferredAllocators()[0];
+  return cpu_allocator;
+}
+
+/**
+ * @brief Copy a tensor OrtValue to a new OrtValue owning a cpu tensor.
+ *
+ * @param src OrtValue to copy.
+ * @param data_transfer_manager Data transfer manager to copy the tensor if it is not on cpu.
+ * @param dst OrtValue to be populated.
+ * @return Status of the operation.
+ */
+Status CopyToCpuOrtValue(const OrtValue& src, const DataTransferManager* data_transfer_manager, OrtValue& dst) {
+  ORT_RETURN_IF_NOT(src.IsTensor(), "Only tensor OrtValues can be saved to a checkpoint.");
+  const onnxruntime::Tensor& src_tensor = src.Get<onnxruntime::Tensor>();
+  onnxruntime::Tensor::InitOrtValue(src_tensor.DataType(), src_tensor.Shape(), GetCpuAllocator(), dst);
+  onnxruntime::Tensor& dst_tensor = *dst.GetMutable<onnxruntime::Tensor>();
+
+  if (src_tensor.Location().device.Type() == OrtDevice::CPU) {
+    if (src_tensor.IsDataTypeString()) {
+      std::copy_n(src_tensor.Data<std::string>(), src_tensor.Shape().Size(), dst_tensor.MutableData<std::string>());
+    } else {
+      memcpy(dst_tensor.MutableDataRaw(), src_tensor.DataRaw(), src_tensor.SizeInBytes());
+    }
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_NOT(data_transfer_manager,
+                    "Cannot save OrtValue to a checkpoint. Expected: A valid data transfer manager. ",
+                    "Actual: nullptr.");
+  return data_transfer_manager->CopyTensor(src_tensor, dst_tensor);
+}
+
 /**
  * @brief Create OrtValue object from flatbuffer tensor
  *
@@ -77,9 +118,7 @@ Status OrtValueFromFlatbufferTensor(const fbs::Tensor& fbs_tensor,
   // The assumption is that the flatbuffer buffer will be destructed once the checkpoint has been loaded.
   // And so, we must allocate a buffer where the tensor data can be copied using the cpu allocator.
   // This buffer is owned by the OrtValue.
-  static CPUExecutionProviderInfo info;
-  static CPUExecutionProvider cpu_provider(info);
-  AllocatorPtr cpu_allocator = cpu_provider.CreatePreferredAllocators()[0];
+  AllocatorPtr cpu_allocator = GetCpuAllocator();
 
   std::unique_ptr<Tensor> ort_tensor = std::make_unique<Tensor>();
   ORT_RETURN_IF_ERROR(fbs::utils::LoadOrtTensorOrtFormat(fbs_tensor, cpu_allocator, tensor_name, *ort_tensor));
@@ -153,11 +192,68 @@ namespace save {
  *
  */
 Status ToFile(const PathString& checkpoint_path, flatbuffers::FlatBufferBuilder& builder) {
-  std::ofstream file(checkpoint_path, std::ios::binary);
-  const uint8_t* buf = builder.GetBufferPointer();
-  int size = builder.GetSize();
-  file.write(reinterpret_cast<const char*>(buf), size);
-  ORT_RETURN_IF_NOT(file, "Failed to save checkpoint to file: ", ToUTF8String(checkpoint_path));
+  // The checkpoint is written to a temporary file that replaces the checkpoint file once complete, so that a crash
+  // while saving leaves the previous checkpoint intact.
+  const std::filesystem::path path{checkpoint_path};
+  std::filesystem::path temp_path{path};
+  temp_path += ORT_TSTR(".tmp");
+
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    const uint8_t* buf = builder.GetBufferPointer();
+    const auto size = static_cast<std::streamsize>(builder.GetSize());
+    file.write(reinterpret_cast<const char*>(buf), size);
+    file.flush();
+    ORT_RETURN_IF_NOT(file, "Failed to save checkpoint to file: ", ToUTF8String(checkpoint_path));
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, path, error);
+  ORT_RETURN_IF(error, "Failed to save checkpoint to file: ", ToUTF8String(checkpoint_path), ". ", error.message());
+
+  return Status::OK();
+}
+
+/**
+ * @brief Copy the states to be saved to a checkpoint state owning cpu copies of them, that the training can update
+ *        while the copy is saved.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param include_optimizer_state Whether to copy the optimizer state.
+ * @param snapshot Checkpoint state to be populated.
+ * @return Status of the operation.
+ */
+Status SnapshotCheckpointState(const CheckpointState& state, const bool include_optimizer_state,
+                               CheckpointState& snapshot) {
+  const ModuleCheckpointState& module_state = state.module_checkpoint_state;
+  for (const auto& [name, param] : module_state.named_parameters) {
+    OrtValue data;
+    ORT_RETURN_IF_ERROR(CopyToCpuOrtValue(param->Data(), module_state.train_session_data_transfer_mgr, data));
+    snapshot.module_checkpoint_state.named_parameters.emplace(
+        name, std::make_shared<Parameter>(name, data, param->RequiresGrad()));
+  }
+  snapshot.module_checkpoint_state.train_session_data_transfer_mgr = nullptr;
+
+  if (include_optimizer_state) {
+    const OptimizerCheckpointState& optimizer_state = state.optimizer_checkpoint_state;
+    for (const auto& [group_name, group_state] : optimizer_state.group_named_optimizer_states) {
+      auto group_snapshot = std::make_shared<GroupOptimizerState>();
+      group_snapshot->step = group_state->step;
+      group_snapshot->initial_lr = group_state->initial_lr;
+      group_snapshot->learning_rate = group_state->learning_rate;
+      for (const auto& [param_name, momentums] : group_state->param_named_optimizer_states) {
+        ParameterOptimizerState& momentums_snapshot = group_snapshot->param_named_optimizer_states[param_name];
+        for (const auto& [momentum_name, momentum] : momentums) {
+          ORT_RETURN_IF_ERROR(CopyToCpuOrtValue(momentum, optimizer_state.optimizer_session_data_transfer_mgr,
+                                                momentums_snapshot[momentum_name]));
+        }
+      }
+      snapshot.optimizer_checkpoint_state.group_named_optimizer_states.emplace(group_name, std::move(group_snapshot));
+    }
+  }
+  snapshot.optimizer_checkpoint_state.optimizer_session_data_transfer_mgr = nullptr;
+
+  snapshot.property_bag = state.property_bag;
 
   return Status::OK();
 }
@@ -734,6 +830,40 @@ Status SaveCheckpoint(const CheckpointState& states, const PathString& checkpoin
   return save::FromCheckpointState(states, checkpoint_path, include_optimizer_state);
 }
 
+CheckpointSaveHandle::CheckpointSaveHandle(std::future<Status> result) : result_{std::move(result)} {}
+
+CheckpointSaveHandle::~CheckpointSaveHandle() {
+  if (result_.valid()) {
+    result_.wait();
+  }
+}
+
+bool CheckpointSaveHandle::IsDone() const {
+  return !result_.valid() || result_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+Status CheckpointSaveHandle::Wait() {
+  if (result_.valid()) {
+    status_ = result_.get();
+  }
+  return status_;
+}
+
+Status SaveCheckpointAsync(const CheckpointState& states, const PathString& checkpoint_path,
+                           const bool include_optimizer_state, std::unique_ptr<CheckpointSaveHandle>& handle) {
+  ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
+
+  auto snapshot = std::make_shared<CheckpointState>();
+  ORT_RETURN_IF_ERROR(save::SnapshotCheckpointState(states, include_optimizer_state, *snapshot));
+
+  handle.reset(new CheckpointSaveHandle(std::async(
+      std::launch::async, [snapshot = std::move(snapshot), checkpoint_path, include_optimizer_state]() {
+        return save::FromCheckpointState(*snapshot, checkpoint_path, include_optimizer_state);
+      })));
+
+  return Status::OK();
+}
+
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   ORT_RETURN_IF_NOT(FLATBUFFERS_LITTLEENDIAN, "ORT training checkpoint format only supports little-endian machines");
 
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <future>
+#include <memory>
+
 #include "core/platform/path_lib.h"
 #include "orttraining/training_api/checkpoint_property.h"
 #include "orttraining/training_api/module.h"
@@ -42,6 +45,54 @@ struct CheckpointState {
 Status SaveCheckpoint(const CheckpointState& state, const PathString& checkpoint_path,
                       const bool include_optimizer_state);
 
+/**
+ * @brief Handle of a checkpoint being saved by SaveCheckpointAsync.
+ * Destroying the handle waits for the checkpoint to be saved.
+ */
+class CheckpointSaveHandle {
+ public:
+  ~CheckpointSaveHandle();
+
+  /**
+   * @brief Whether the checkpoint has been saved, or failed to be saved.
+   */
+  bool IsDone() const;
+
+  /**
+   * @brief Wait for the checkpoint to be saved.
+   * @return Status of the save.
+   */
+  Status Wait();
+
+ private:
+  explicit CheckpointSaveHandle(std::future<Status> result);
+
+  friend Status SaveCheckpointAsync(const CheckpointState& state, const PathString& checkpoint_path,
+                                    const bool include_optimizer_state,
+                                    std::unique_ptr<CheckpointSaveHandle>& handle);
+
+  std::future<Status> result_;
+  Status status_;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CheckpointSaveHandle);
+};
+
+/**
+ * @brief Save training states as ORT checkpoint in the background.
+ * The states are copied to cpu memory before returning, so that training can resume and update them immediately,
+ * and the copy is serialized and written to the checkpoint file by a background thread.
+ * The checkpoint file is replaced once completely written, so that it remains a valid checkpoint if the process
+ * terminates while saving.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param checkpoint_path file where checkpoint is saved.
+ * @param include_optimizer_state Whether to include optimizer state in the checkpoint.
+ * @param handle Handle to wait for the checkpoint to be saved and get the status of the save.
+ * @return Status of copying the states.
+ */
+Status SaveCheckpointAsync(const CheckpointState& state, const PathString& checkpoint_path,
+                           const bool include_optimizer_state, std::unique_ptr<CheckpointSaveHandle>& handle);
+
 #if !defined(ORT_MINIMAL_BUILD)
 /**
  * @brief Save ONNX initializers as ORT checkpoint.
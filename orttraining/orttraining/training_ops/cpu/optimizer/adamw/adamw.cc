@@ -9,6 +9,10 @@
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/util/math_cpuonly.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -89,47 +93,63 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("S_MOMENT", DataTypeImpl::AllFixedSizeSequenceTensorTypes()),
     AdamWOptimizer<float>);
 
+namespace {
+
+// Elements of the flattened weights updated by one task. The weights are split into chunks small enough for the
+// weight, gradient and momentums of a chunk to stay in cache across the passes of the update, so that the update
+// reads and writes each of them from memory once, and many small weights are updated by a single task.
+constexpr size_t kChunkSize = 4096;
+
+struct WeightChunk {
+  size_t weight_index;
+  size_t offset;
+  size_t count;
+};
+
+}  // namespace
+
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode0(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float alpha_correction, float beta_correction) const {
+void AdamWOptimizer<T>::AdamWComputeMode0(T* weight_data, const T* gradient_data, T* momentums_1_data,
+                                          T* momentums_2_data, size_t count, float lr, float alpha_correction,
+                                          float beta_correction) const {
+  EigenVectorArrayMap<T> weight(weight_data, count);
+  ConstEigenVectorArrayMap<T> gradient(gradient_data, count);
+  EigenVectorArrayMap<T> momentums_1(momentums_1_data, count);
+  EigenVectorArrayMap<T> momentums_2(momentums_2_data, count);
+
   // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (MakeEigenArrayMap<T>(weight) * lr * weight_decay_);
+  weight = weight - (weight * lr * weight_decay_);
 
   // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
+  momentums_1 = alpha_ * momentums_1 + (1.f - alpha_) * gradient;
 
   // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+  momentums_2 = beta_ * momentums_2 + (1.f - beta_) * gradient * gradient;
 
   // Compute the new weight.
-  auto denom = (MakeEigenArrayMap<T>(momentums_2) / beta_correction).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr * MakeEigenArrayMap<T>(momentums_1)) / (alpha_correction * denom);
-
-  return Status::OK();
+  auto denom = (momentums_2 / beta_correction).sqrt() + epsilon_;
+  weight = weight - (lr * momentums_1) / (alpha_correction * denom);
 }
 
 template <typename T>
-Status AdamWOptimizer<T>::AdamWComputeMode1(Tensor& weight, Tensor& gradient, Tensor& momentums_1, Tensor& momentums_2,
-                                            float lr, float lr_corrected) const {
+void AdamWOptimizer<T>::AdamWComputeMode1(T* weight_data, const T* gradient_data, T* momentums_1_data,
+                                          T* momentums_2_data, size_t count, float lr, float lr_corrected) const {
+  EigenVectorArrayMap<T> weight(weight_data, count);
+  ConstEigenVectorArrayMap<T> gradient(gradient_data, count);
+  EigenVectorArrayMap<T> momentums_1(momentums_1_data, count);
+  EigenVectorArrayMap<T> momentums_2(momentums_2_data, count);
+
   // Compute exponentially-averaged historical gradient.
-  MakeEigenArrayMap<T>(momentums_1) = alpha_ * MakeEigenArrayMap<T>(momentums_1) +
-                                      (1.f - alpha_) * MakeEigenArrayMap<T>(gradient);
+  momentums_1 = alpha_ * momentums_1 + (1.f - alpha_) * gradient;
 
   // Compute exponentially-averaged historical squared gradient.
-  MakeEigenArrayMap<T>(momentums_2) = beta_ * MakeEigenArrayMap<T>(momentums_2) +
-                                      (1.f - beta_) * MakeEigenArrayMap<T>(gradient) * MakeEigenArrayMap<T>(gradient);
+  momentums_2 = beta_ * momentums_2 + (1.f - beta_) * gradient * gradient;
 
-  auto denom = MakeEigenArrayMap<T>(momentums_2).sqrt() + epsilon_;
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) -
-                                 (lr_corrected * MakeEigenArrayMap<T>(momentums_1) / denom);
+  auto denom = momentums_2.sqrt() + epsilon_;
+  weight = weight - (lr_corrected * momentums_1 / denom);
 
   // Perform weight decay.
-  MakeEigenArrayMap<T>(weight) = MakeEigenArrayMap<T>(weight) - (lr * weight_decay_ * MakeEigenArrayMap<T>(weight));
-
-  return Status::OK();
+  weight = weight - (lr * weight_decay_ * weight);
 }
 
 template <typename T>
@@ -165,23 +185,40 @@ Status AdamWOptimizer<T>::Compute(OpKernelContext* ctx) const {
     //         bias correction is applied on learning rate, then use lr_corrected for subsequent computations.
     //         weight decay is applied after weight is updated.
 
+    // All of the weights are updated in one parallel pass over their chunks, like the multi-tensor apply of the
+    // CUDA kernel, rather than one weight at a time.
+    std::vector<WeightChunk> chunks;
     for (size_t weight_index = 0; weight_index < p.num_of_weights; ++weight_index) {
-      Tensor& weight = const_cast<Tensor&>(p.weights->Get(weight_index));
-      Tensor& gradient = const_cast<Tensor&>(p.gradients->Get(weight_index));
-      Tensor& momentums_1 = const_cast<Tensor&>(p.momentums_1->Get(weight_index));
-      Tensor& momentums_2 = const_cast<Tensor&>(p.momentums_2->Get(weight_index));
-
-      if (adam_mode_ == 0) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, lr, alpha_correction, beta_correction));
-      } else if (adam_mode_ == 1) {
-        ORT_RETURN_IF_ERROR(
-            AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, lr, lr_corrected));
-      } else {
-        ORT_THROW("Unsupported Adamw optimizer mode.");
+      const auto size = static_cast<size_t>(p.grouped_tensor_sizes[weight_index]);
+      for (size_t offset = 0; offset < size; offset += kChunkSize) {
+        chunks.push_back({weight_index, offset, std::min(kChunkSize, size - offset)});
       }
     }
 
+    // per chunk: the weight, gradient and momentums are read, the weight and momentums are written, and the weight
+    // decay, momentums and weight update take a few operations per element.
+    const TensorOpCost cost{static_cast<double>(kChunkSize * 4 * sizeof(T)),
+                            static_cast<double>(kChunkSize * 3 * sizeof(T)), static_cast<double>(kChunkSize * 16)};
+    concurrency::ThreadPool::TryParallelFor(
+        ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(chunks.size()), cost,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t chunk_index = begin; chunk_index != end; ++chunk_index) {
+            const WeightChunk& chunk = chunks[chunk_index];
+            const auto& pointers = p.grouped_tensor_pointers[chunk.weight_index];
+            T* weight = static_cast<T*>(pointers[0]) + chunk.offset;
+            const T* gradient = static_cast<const T*>(pointers[1]) + chunk.offset;
+            T* momentums_1 = static_cast<T*>(pointers[2]) + chunk.offset;
+            T* momentums_2 = static_cast<T*>(pointers[3]) + chunk.offset;
+
+            if (adam_mode_ == 0) {
+              AdamWComputeMode0(weight, gradient, momentums_1, momentums_2, chunk.count, lr, alpha_correction,
+                                beta_correction);
+            } else {
+              AdamWComputeMode1(weight, gradient, momentums_1, momentums_2, chunk.count, lr, lr_corrected);
+            }
+          }
+        });
+
     *updated_flag_ptr = true;
   } else {
     *updated_flag_ptr = false;